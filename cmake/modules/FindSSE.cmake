@@ -23,6 +23,7 @@
 #endif()
 
 include(CheckCSourceRuns)
+include(CheckCSourceCompiles)
 
 option(ENABLE_SSE    "Enable compile-time SSE4.1 support." ON)
 option(ENABLE_AVX    "Enable compile-time AVX support."    ON)
@@ -163,7 +164,7 @@ if (ENABLE_SSE)
         #
         if (CMAKE_COMPILER_IS_GNUCC OR (CMAKE_C_COMPILER_ID MATCHES "Clang") OR (CMAKE_CXX_COMPILER_ID MATCHES "Clang"))
             set(CMAKE_REQUIRED_FLAGS "-mavx512f -mavx512cd -mavx512bw -mavx512dq -DLV_HAVE_AVX512")
-            check_c_source_runs("
+            set(AVX512_TEST_SOURCE "
           #include <immintrin.h>
           int main()
           {
@@ -181,11 +182,18 @@ if (ENABLE_SSE)
               }
             }
             return 0;
-          }"
-                    HAVE_AVX512)
+          }")
+            if (ENABLE_SIMD_DISPATCH)
+                # The AVX512 kernels are selected at run time, the build host does not need to support them
+                check_c_source_compiles("${AVX512_TEST_SOURCE}" HAVE_AVX512)
+            else (ENABLE_SIMD_DISPATCH)
+                check_c_source_runs("${AVX512_TEST_SOURCE}" HAVE_AVX512)
+            endif (ENABLE_SIMD_DISPATCH)
         endif()
 
-        if (HAVE_AVX512)
+        if (HAVE_AVX512 AND ENABLE_SIMD_DISPATCH)
+            message(STATUS "AVX512 kernels are enabled - selected at run time if the CPU supports them")
+        elseif (HAVE_AVX512)
             message(STATUS "AVX512 is enabled - target CPU must support it")
         endif()
     elseif (${GCC_ARCH} MATCHES "native" AND CMAKE_CXX_COMPILER_ID MATCHES "GNU")
@@ -0,0 +1,223 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Pre-generates the FFTW wisdom of the DFT plans the eNodeB and gNodeB create for every bandwidth they can be
+ * configured with, so that cell setup and reconfiguration load them instead of measuring them. The wisdom is saved to
+ * the file srsran_dft_wisdom_export() writes, which every srsRAN process loads at start-up.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+static const uint32_t lte_nof_prb[] = {6, 15, 25, 50, 75, 100};
+
+static bool     skip_lte       = false;
+static bool     skip_nr        = false;
+static uint32_t max_nr_nof_prb = SRSRAN_MAX_PRB_NR;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [LNp]\n", prog);
+  printf("\t-L skip LTE bandwidths\n");
+  printf("\t-N skip NR bandwidths\n");
+  printf("\t-p maximum NR number of PRB [Default %d]\n", max_nr_nof_prb);
+  printf("\t-v srsran_verbose\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "LNpv")) != -1) {
+    switch (opt) {
+      case 'L':
+        skip_lte = true;
+        break;
+      case 'N':
+        skip_nr = true;
+        break;
+      case 'p':
+        max_nr_nof_prb = SRSRAN_MIN((uint32_t)strtol(argv[optind], NULL, 10), SRSRAN_MAX_PRB_NR);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/* Plans the OFDM modulator and the demodulators, with and without DFT window offset, of a carrier */
+static int plan_ofdm(uint32_t nof_prb, uint32_t symbol_sz, srsran_cp_t cp, bool keep_dc)
+{
+  // Receivers are configured either without DFT window offset or with half of the cyclic prefix
+  const float rx_window_offsets[] = {0.0f, 0.5f};
+
+  int               ret  = SRSRAN_ERROR;
+  cf_t*             time = srsran_vec_cf_malloc(SRSRAN_SF_LEN(symbol_sz));
+  cf_t*             grid = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(nof_prb, cp));
+  srsran_ofdm_cfg_t cfg  = {};
+  cfg.nof_prb            = nof_prb;
+  cfg.symbol_sz          = symbol_sz;
+  cfg.cp                 = cp;
+  cfg.keep_dc            = keep_dc;
+
+  if (time == NULL || grid == NULL) {
+    goto clean_exit;
+  }
+
+  srsran_ofdm_t ifft = {};
+  cfg.in_buffer      = grid;
+  cfg.out_buffer     = time;
+  if (srsran_ofdm_tx_init_cfg(&ifft, &cfg) < SRSRAN_SUCCESS) {
+    ERROR("Error planning OFDM modulator for %d PRB", nof_prb);
+    goto clean_exit;
+  }
+  srsran_ofdm_tx_free(&ifft);
+
+  for (uint32_t i = 0; i < sizeof(rx_window_offsets) / sizeof(rx_window_offsets[0]); i++) {
+    srsran_ofdm_t fft    = {};
+    cfg.in_buffer        = time;
+    cfg.out_buffer       = grid;
+    cfg.rx_window_offset = rx_window_offsets[i];
+    if (srsran_ofdm_rx_init_cfg(&fft, &cfg) < SRSRAN_SUCCESS) {
+      ERROR("Error planning OFDM demodulator for %d PRB", nof_prb);
+      goto clean_exit;
+    }
+    srsran_ofdm_rx_free(&fft);
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (time) {
+    free(time);
+  }
+  if (grid) {
+    free(grid);
+  }
+  return ret;
+}
+
+/* Plans the PRACH generator and detector DFTs of a carrier, the PRACH workers of both the LTE and NR cells only support
+ * LTE bandwidths */
+static int plan_prach(uint32_t nof_prb, uint32_t symbol_sz, bool is_nr)
+{
+  srsran_prach_t     prach = {};
+  srsran_prach_cfg_t cfg   = {};
+  cfg.is_nr                = is_nr;
+
+  if (srsran_prach_init(&prach, symbol_sz) < SRSRAN_SUCCESS) {
+    ERROR("Error planning PRACH for %d PRB", nof_prb);
+    return SRSRAN_ERROR;
+  }
+
+  int ret = srsran_prach_set_cfg(&prach, &cfg, nof_prb);
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error planning PRACH for %d PRB", nof_prb);
+  }
+
+  srsran_prach_free(&prach);
+  return ret;
+}
+
+static int plan_lte(void)
+{
+  for (uint32_t standard = 0; standard < 2; standard++) {
+    srsran_use_standard_symbol_size(standard != 0);
+
+    for (uint32_t i = 0; i < sizeof(lte_nof_prb) / sizeof(lte_nof_prb[0]); i++) {
+      uint32_t nof_prb   = lte_nof_prb[i];
+      uint32_t symbol_sz = (uint32_t)srsran_symbol_sz(nof_prb);
+
+      printf("LTE %3d PRB, symbol size %4d%s\n", nof_prb, symbol_sz, standard ? " (standard)" : "");
+      if (plan_ofdm(nof_prb, symbol_sz, SRSRAN_CP_NORM, false) < SRSRAN_SUCCESS ||
+          plan_ofdm(nof_prb, symbol_sz, SRSRAN_CP_EXT, false) < SRSRAN_SUCCESS ||
+          plan_prach(nof_prb, symbol_sz, false) < SRSRAN_SUCCESS ||
+          plan_prach(nof_prb, symbol_sz, true) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+  srsran_use_standard_symbol_size(false);
+
+  // SC-FDMA transform precoding plans every allowed number of PRB at once
+  srsran_dft_precoding_t precoding = {};
+  if (srsran_dft_precoding_init_rx(&precoding, SRSRAN_MAX_PRB) < SRSRAN_SUCCESS) {
+    ERROR("Error planning transform precoding");
+    return SRSRAN_ERROR;
+  }
+  srsran_dft_precoding_free(&precoding);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int plan_nr(void)
+{
+  uint32_t last_symbol_sz = 0;
+
+  // The symbol size only steps up at a few bandwidths, the plans do not depend on the number of PRB otherwise
+  for (uint32_t nof_prb = 1; nof_prb <= max_nr_nof_prb; nof_prb++) {
+    uint32_t symbol_sz = srsran_min_symbol_sz_rb(nof_prb);
+    if (symbol_sz == 0 || symbol_sz == last_symbol_sz) {
+      continue;
+    }
+    last_symbol_sz = symbol_sz;
+
+    printf("NR  %3d PRB, symbol size %4d\n", nof_prb, symbol_sz);
+    if (plan_ofdm(nof_prb, symbol_sz, SRSRAN_CP_NORM, true) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  struct timeval t[3];
+
+  parse_args(argc, argv);
+
+  gettimeofday(&t[1], NULL);
+  if (!skip_lte && plan_lte() < SRSRAN_SUCCESS) {
+    exit(-1);
+  }
+  if (!skip_nr && plan_nr() < SRSRAN_SUCCESS) {
+    exit(-1);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  if (srsran_dft_wisdom_export() < SRSRAN_SUCCESS) {
+    ERROR("Error saving FFTW wisdom");
+    exit(-1);
+  }
+
+  printf("Planned in %.1f s, wisdom saved\n", (double)t[0].tv_sec + (double)t[0].tv_usec * 1e-6);
+  exit(0);
+}
@@ -22,10 +22,14 @@
 #ifndef SRSRAN_ACCUMULATORS_H
 #define SRSRAN_ACCUMULATORS_H
 
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace srsran {
@@ -169,6 +173,82 @@ private:
   T coeff;
 };
 
+namespace detail {
+
+/// Index of the calling thread among the threads that updated a snapshot_accumulator, assigned at its first update
+inline uint32_t accumulator_thread_index()
+{
+  static std::atomic<uint32_t> next_index{0};
+  thread_local uint32_t        index = next_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+} // namespace detail
+
+/**
+ * Metrics updated by realtime threads without locks, and periodically collected by a reader thread.
+ * Each writer thread owns a pair of buffers of T and updates the active one in place. The reader swaps the active
+ * buffer of all threads, waits for the writers that were still updating the previous buffers, merges them with
+ * T::operator+= and resets them for the next period. The writers never wait for the reader.
+ * The threads beyond the first MaxThreads share one pair of buffers protected by a mutex.
+ */
+template <typename T, size_t MaxThreads = 8>
+class snapshot_accumulator
+{
+public:
+  /// Applies f(T&) to the accumulated metrics of the calling thread
+  template <typename F>
+  void update(F&& f)
+  {
+    uint32_t idx = detail::accumulator_thread_index();
+    if (idx >= MaxThreads) {
+      std::lock_guard<std::mutex> lock(shared_mutex);
+      f(shared_bufs[epoch.load(std::memory_order_relaxed) & 1]);
+      return;
+    }
+
+    // Announce the buffer being updated, and retry if the reader swapped the buffers in the meantime
+    slot_t&  s = slots[idx];
+    uint64_t e;
+    do {
+      e = epoch.load();
+      s.writing.store(e + 1);
+    } while (epoch.load() != e);
+    f(s.bufs[e & 1]);
+    s.writing.store(0, std::memory_order_release);
+  }
+
+  /// Returns the metrics accumulated by all threads since the previous snapshot. Only one thread may call it
+  T snapshot()
+  {
+    uint64_t old = epoch.fetch_add(1);
+    T        result{};
+    for (slot_t& s : slots) {
+      while (s.writing.load(std::memory_order_acquire) == old + 1) {
+        std::this_thread::yield();
+      }
+      result += s.bufs[old & 1];
+      s.bufs[old & 1] = T{};
+    }
+    std::lock_guard<std::mutex> lock(shared_mutex);
+    result += shared_bufs[old & 1];
+    shared_bufs[old & 1] = T{};
+    return result;
+  }
+
+private:
+  struct slot_t {
+    // Epoch + 1 of the buffer being updated by the owner thread, or 0
+    std::atomic<uint64_t> writing{0};
+    std::array<T, 2>      bufs = {};
+  };
+
+  std::atomic<uint64_t>          epoch{0};
+  std::array<slot_t, MaxThreads> slots;
+  std::mutex                     shared_mutex;
+  std::array<T, 2>               shared_bufs = {};
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_ACCUMULATORS_H
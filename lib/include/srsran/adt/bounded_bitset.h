@@ -218,14 +218,17 @@ public:
   bounded_bitset<N, reversed>& fill(size_t startpos, size_t endpos, bool value = true)
   {
     assert_range_bounds_(startpos, endpos);
-    // NOTE: can be optimized
-    if (value) {
-      for (size_t i = startpos; i < endpos; ++i) {
-        set_(i);
-      }
-    } else {
-      for (size_t i = startpos; i < endpos; ++i) {
-        reset_(i);
+    if (startpos == endpos) {
+      return *this;
+    }
+    size_t startbit = reversed ? size() - endpos : startpos;
+    size_t endbit   = reversed ? size() - startpos : endpos;
+    for (size_t i = startbit / bits_per_word; i <= (endbit - 1) / bits_per_word; ++i) {
+      word_t mask = range_mask_(i, startbit, endbit);
+      if (value) {
+        buffer[i] |= mask;
+      } else {
+        buffer[i] &= ~mask;
       }
     }
     return *this;
@@ -273,9 +276,13 @@ public:
   {
     assert_within_bounds_(start, false);
     assert_within_bounds_(stop, false);
-    // NOTE: can be optimized
-    for (size_t i = start; i < stop; ++i) {
-      if (test_(i)) {
+    if (start >= stop) {
+      return false;
+    }
+    size_t startbit = reversed ? size() - stop : start;
+    size_t endbit   = reversed ? size() - start : stop;
+    for (size_t i = startbit / bits_per_word; i <= (endbit - 1) / bits_per_word; ++i) {
+      if ((buffer[i] & range_mask_(i, startbit, endbit)) != static_cast<word_t>(0)) {
         return true;
       }
     }
@@ -288,13 +295,16 @@ public:
   {
     size_t result = 0;
     for (size_t i = 0; i < nof_words_(); i++) {
-      //      result += __builtin_popcountl(buffer[i]);
+#ifdef __GNUC__
+      result += __builtin_popcountll(buffer[i]);
+#else
       // Note: use an "int" for count triggers popcount optimization if SSE instructions are enabled.
       int c = 0;
       for (word_t w = buffer[i]; w > 0; c++) {
         w &= w - 1;
       }
       result += c;
+#endif
     }
     return result;
   }
@@ -457,6 +467,19 @@ private:
 
   static word_t maskbit(size_t pos) noexcept { return (static_cast<word_t>(1)) << (pos % bits_per_word); }
 
+  /// Bits of the word i that fall within the bit index range [startbit, endbit)
+  static word_t range_mask_(size_t i, size_t startbit, size_t endbit) noexcept
+  {
+    word_t mask = ~static_cast<word_t>(0);
+    if (i == startbit / bits_per_word) {
+      mask &= mask_lsb_zeros<word_t>(startbit % bits_per_word);
+    }
+    if (i == (endbit - 1) / bits_per_word) {
+      mask &= mask_lsb_ones<word_t>((endbit - 1) % bits_per_word + 1);
+    }
+    return mask;
+  }
+
   static size_t max_nof_words_() noexcept { return (N - 1) / bits_per_word + 1; }
 
   int find_last_(size_t startpos, size_t endpos, bool value) const noexcept
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_FLAT_HASH_MAP_H
+#define SRSRAN_FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Hash map with unsigned integer keys, stored in a single array with open addressing and linear probing.
+ * The array is kept at most half full, so a lookup reads one or two contiguous slots in the common case.
+ * Erased slots are filled by shifting back the following entries of the probe sequence, so no tombstones are left.
+ * Pointers to the values are invalidated by insert_or_assign() and erase().
+ */
+template <typename K, typename T>
+class flat_hash_map
+{
+  static_assert(std::is_integral<K>::value and std::is_unsigned<K>::value, "Map key must be an unsigned integer");
+
+  struct slot_t {
+    bool present = false;
+    K    key     = 0;
+    T    value   = {};
+  };
+
+public:
+  using key_type    = K;
+  using mapped_type = T;
+
+  explicit flat_hash_map(size_t initial_capacity = 16) { slots.resize(round_capacity(initial_capacity)); }
+
+  size_t size() const { return nof_elems; }
+  bool   empty() const { return nof_elems == 0; }
+  size_t capacity() const { return slots.size(); }
+
+  bool contains(K key) const { return find(key) != nullptr; }
+
+  T* find(K key)
+  {
+    for (size_t idx = home(key);; idx = next(idx)) {
+      slot_t& s = slots[idx];
+      if (not s.present) {
+        return nullptr;
+      }
+      if (s.key == key) {
+        return &s.value;
+      }
+    }
+  }
+  const T* find(K key) const { return const_cast<flat_hash_map<K, T>*>(this)->find(key); }
+
+  /// Inserts the value, or replaces the value already stored for the key
+  T& insert_or_assign(K key, T value)
+  {
+    if (2 * (nof_elems + 1) > slots.size()) {
+      rehash(2 * slots.size());
+    }
+    size_t idx = home(key);
+    for (; slots[idx].present; idx = next(idx)) {
+      if (slots[idx].key == key) {
+        slots[idx].value = std::move(value);
+        return slots[idx].value;
+      }
+    }
+    slots[idx].present = true;
+    slots[idx].key     = key;
+    slots[idx].value   = std::move(value);
+    nof_elems++;
+    return slots[idx].value;
+  }
+
+  bool erase(K key)
+  {
+    size_t idx = home(key);
+    for (; slots[idx].present and slots[idx].key != key; idx = next(idx)) {
+    }
+    if (not slots[idx].present) {
+      return false;
+    }
+    // Move back the entries that would not be found anymore through the emptied slot
+    for (size_t hole = idx, cur = next(idx);; cur = next(cur)) {
+      if (not slots[cur].present) {
+        slots[hole] = slot_t{};
+        break;
+      }
+      size_t cur_home = home(slots[cur].key);
+      if (((cur - cur_home) & mask()) >= ((cur - hole) & mask())) {
+        slots[hole] = std::move(slots[cur]);
+        hole        = cur;
+      }
+    }
+    nof_elems--;
+    return true;
+  }
+
+  void clear()
+  {
+    slots.assign(slots.size(), slot_t{});
+    nof_elems = 0;
+  }
+
+  void reserve(size_t nof_elems_)
+  {
+    if (2 * nof_elems_ > slots.size()) {
+      rehash(round_capacity(2 * nof_elems_));
+    }
+  }
+
+private:
+  static size_t round_capacity(size_t n)
+  {
+    size_t cap = 2;
+    while (cap < n) {
+      cap *= 2;
+    }
+    return cap;
+  }
+
+  size_t mask() const { return slots.size() - 1; }
+  size_t next(size_t idx) const { return (idx + 1) & mask(); }
+  // Fibonacci hashing, so that keys differing only in their high or low bits spread over the array
+  size_t home(K key) const { return (static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ULL >> 32) & mask(); }
+
+  void rehash(size_t new_capacity)
+  {
+    std::vector<slot_t> old_slots(new_capacity);
+    old_slots.swap(slots);
+    nof_elems = 0;
+    for (slot_t& s : old_slots) {
+      if (s.present) {
+        insert_or_assign(s.key, std::move(s.value));
+      }
+    }
+  }
+
+  std::vector<slot_t> slots;
+  size_t              nof_elems = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_FLAT_HASH_MAP_H
@@ -23,6 +23,7 @@
 #define SRSRAN_MOVE_CALLBACK_H
 
 #include "detail/type_storage.h"
+#include "pool/fixed_size_pool.h"
 #include "srsran/support/srsran_assert.h"
 #include <cstddef>
 #include <cstdint>
@@ -44,6 +45,11 @@ namespace srsran {
 //! Size of the buffer used by "move_callback<R(Args...)>" to store functors without calling "new"
 constexpr size_t default_move_callback_buffer_size = 32;
 
+//! Size of the memory pool blocks used by "move_callback<R(Args...)>" to store functors that do not fit its buffer.
+//! Only functors larger than this size, or allocated when the pool is depleted, are stored via "new"
+constexpr size_t move_callback_pool_block_size = 512;
+constexpr size_t move_callback_pool_capacity   = 4096;
+
 template <class Signature, size_t Capacity = default_move_callback_buffer_size, bool ForbidAlloc = false>
 class move_callback;
 
@@ -108,11 +114,45 @@ public:
   bool is_in_small_buffer() const final { return false; }
 };
 
+using callback_pool_t = concurrent_fixed_memory_pool<move_callback_pool_block_size>;
+
+//! move/call/destroy operations for when the functor is stored in a block of the callback memory pool
+template <typename FunT, typename R, typename... Args>
+class pool_table_t : public oper_table_t<R, Args...>
+{
+public:
+  constexpr pool_table_t() = default;
+  R    call(void* src, Args... args) const final { return (**static_cast<FunT**>(src))(std::forward<Args>(args)...); }
+  void move(void* src, void* dest) const final
+  {
+    *static_cast<FunT**>(dest) = *static_cast<FunT**>(src);
+    *static_cast<FunT**>(src)  = nullptr;
+  }
+  void dtor(void* src) const final
+  {
+    FunT* f = *static_cast<FunT**>(src);
+    if (f != nullptr) {
+      f->~FunT();
+      callback_pool_t::get_instance(move_callback_pool_capacity)->deallocate_node(f);
+    }
+  }
+  bool is_in_small_buffer() const final { return false; }
+};
+
+//! Allocates a memory pool block for a functor of the given size. Returns nullptr if the functor has to go to the heap
+inline void* allocate_callback_block(size_t sz)
+{
+  if (sz > move_callback_pool_block_size) {
+    return nullptr;
+  }
+  return callback_pool_t::get_instance(move_callback_pool_capacity)->allocate_node(sz);
+}
+
 //! Metafunction to check if a type is an instantiation of move_callback<R(Args...)>
 template <class>
 struct is_move_callback : std::false_type {};
-template <class Sig, size_t Capacity>
-struct is_move_callback<move_callback<Sig, Capacity> > : std::true_type {};
+template <class Sig, size_t Capacity, bool ForbidAlloc>
+struct is_move_callback<move_callback<Sig, Capacity, ForbidAlloc> > : std::true_type {};
 
 //! metafunctions to enable different ctor implementations depending on whether the callback fits the small buffer
 template <typename T, size_t Cap, typename FunT = typename std::decay<T>::type>
@@ -145,7 +185,8 @@ public:
     ::new (&buffer) FunT(std::forward<T>(function));
   }
 
-  //! Called when T capture does not fit the move_callback buffer
+  //! Called when T capture does not fit the move_callback buffer. The functor is stored in a memory pool block if it
+  //! fits one, and in the heap otherwise
   template <typename T, task_details::enable_if_big_capture<T, capacity> = true>
   move_callback(T&& function)
   {
@@ -153,6 +194,14 @@ public:
         not ForbidAlloc,
         "Failed to store provided callback in std::move_callback specialization that forbids heap allocations.");
     using FunT = typename std::decay<T>::type;
+    static_assert(alignof(FunT) <= alignof(detail::max_alignment_t), "Functor alignment not supported");
+    void* block = task_details::allocate_callback_block(sizeof(FunT));
+    if (block != nullptr) {
+      static const task_details::pool_table_t<FunT, R, Args...> pool_oper_table{};
+      oper_ptr = &pool_oper_table;
+      ptr      = static_cast<void*>(new (block) FunT{std::forward<T>(function)});
+      return;
+    }
     static const task_details::heap_table_t<FunT, R, Args...> heap_oper_table{};
     oper_ptr = &heap_oper_table;
     ptr      = static_cast<void*>(new FunT{std::forward<T>(function)});
@@ -180,6 +229,13 @@ public:
   bool is_empty() const { return oper_ptr == &empty_table; }
   bool is_in_small_buffer() const { return oper_ptr->is_in_small_buffer(); }
 
+  //! Checks at compile time that a functor is stored in the move_callback buffer, e.g. for tasks in the packet path
+  template <typename T>
+  static constexpr bool fits_small_buffer()
+  {
+    return sizeof(typename std::decay<T>::type) <= capacity;
+  }
+
 private:
   union {
     mutable storage_t buffer;
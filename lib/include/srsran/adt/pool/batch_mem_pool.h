@@ -23,6 +23,7 @@
 #define SRSRAN_BATCH_MEM_POOL_H
 
 #include "memblock_cache.h"
+#include "pool_metrics.h"
 #include "pool_utils.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/support/srsran_assert.h"
@@ -127,7 +128,9 @@ public:
                   sz,
                   grow_pool.get_node_max_size());
     std::lock_guard<std::mutex> lock(state->mutex);
-    void*                       node = grow_pool.allocate_node();
+    bool                        cache_hit = grow_pool.cache_size() > 0;
+    void*                       node      = grow_pool.allocate_node();
+    counters.on_allocate(cache_hit);
 
     if (grow_pool.size() < batch_threshold) {
       allocate_batch_in_background_nolock();
@@ -139,6 +142,7 @@ public:
   {
     std::lock_guard<std::mutex> lock(state->mutex);
     grow_pool.deallocate_node(p);
+    counters.on_deallocate();
   }
 
   void allocate_batch()
@@ -154,6 +158,12 @@ public:
     return grow_pool.cache_size();
   }
 
+  pool_metrics_t get_metrics(const char* name) const
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return counters.get_metrics(name, grow_pool.size());
+  }
+
 private:
   void allocate_batch_in_background_nolock()
   {
@@ -186,6 +196,7 @@ private:
   std::shared_ptr<detached_pool_state> state;
 
   growing_batch_mem_pool grow_pool;
+  pool_usage_counters    counters;
 };
 
 } // namespace srsran
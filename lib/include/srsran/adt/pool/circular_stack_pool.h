@@ -77,6 +77,7 @@ public:
       void* block = central_cache.allocate_node(central_cache.get_node_max_size());
       if (block == nullptr) {
         logger.warning("Failed to allocate memory block from central cache");
+        nof_alloc_failures.fetch_add(1, std::memory_order_relaxed);
         return nullptr;
       }
       elem.key   = key;
@@ -85,6 +86,7 @@ public:
     void* ptr = elem.alloc.allocate(size, alignment);
     if (ptr == nullptr) {
       logger.warning("No space left in memory block with key=%zd of circular stack pool", key);
+      nof_alloc_failures.fetch_add(1, std::memory_order_relaxed);
     } else {
       elem.count++;
     }
@@ -110,10 +112,19 @@ public:
 
   size_t cache_size() const { return central_cache.cache_size(); }
 
+  /// Occupancy of the memory blocks of the stacks. The failures are the allocations that did not fit a stack.
+  pool_metrics_t get_metrics(const char* name) const
+  {
+    pool_metrics_t m     = central_cache.get_metrics(name);
+    m.nof_alloc_failures = nof_alloc_failures.load(std::memory_order_relaxed);
+    return m;
+  }
+
 private:
   srsran::circular_array<mem_block_elem_t, NofStacks> pools;
   srsran::background_mem_pool                         central_cache;
   srslog::basic_logger&                               logger;
+  std::atomic<uint64_t>                               nof_alloc_failures{0};
 };
 
 template <typename T, size_t N, typename... Args>
@@ -23,6 +23,7 @@
 #define SRSRAN_FIXED_SIZE_POOL_H
 
 #include "memblock_cache.h"
+#include "pool_metrics.h"
 #include "srsran/adt/circular_buffer.h"
 #include <thread>
 
@@ -97,23 +98,28 @@ public:
     srsran_assert(sz <= ObjSize, "Allocated node size=%zd exceeds max object size=%zd", sz, ObjSize);
     worker_ctxt* worker_ctxt = get_worker_cache();
 
-    void* node = worker_ctxt->cache.try_pop();
+    void* node      = worker_ctxt->cache.try_pop();
+    bool  cache_hit = node != nullptr;
     if (node == nullptr) {
       // fill the thread local cache enough for this and next allocations
       std::array<void*, batch_steal_size> popped_blocks;
       size_t                              n = central_mem_cache.try_pop(popped_blocks);
       for (size_t i = 0; i < n; ++i) {
-        new (popped_blocks[i]) obj_storage_t();
+        // default-initialized, value-initializing would zero the whole block on every refill
+        new (popped_blocks[i]) obj_storage_t;
         worker_ctxt->cache.push(static_cast<void*>(popped_blocks[i]));
       }
       node = worker_ctxt->cache.try_pop();
     }
 
-#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
     if (node == nullptr) {
+      counters.on_alloc_failure();
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
       print_error("Error allocating buffer in pool of ObjSize=%zd", ObjSize);
-    }
 #endif
+      return nullptr;
+    }
+    counters.on_allocate(cache_hit);
     return node;
   }
 
@@ -134,6 +140,7 @@ public:
 
     // push to local memory block cache
     worker_ctxt->cache.push(static_cast<void*>(p));
+    counters.on_deallocate();
 
     if (worker_ctxt->cache.size() >= local_growth_thres) {
       // if local cache reached max capacity, send half of the blocks to central cache
@@ -141,6 +148,8 @@ public:
     }
   }
 
+  pool_metrics_t get_metrics(const char* name) const { return counters.get_metrics(name, allocated_blocks.size()); }
+
   void enable_logger(bool enabled)
   {
     if (enabled) {
@@ -197,6 +206,7 @@ private:
 
   size_t                local_growth_thres = 0;
   srslog::basic_logger* logger             = nullptr;
+  pool_usage_counters   counters;
 
   concurrent_free_memblock_list                central_mem_cache;
   std::mutex                                   mutex;
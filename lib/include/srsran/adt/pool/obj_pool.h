@@ -102,17 +102,22 @@ public:
   }
 
   size_t cache_size() const { return cache.size(); }
+  size_t size() const { return allocated.size() * objs_per_batch; }
+
+  pool_metrics_t get_metrics(const char* name) const final { return counters.get_metrics(name, size()); }
 
 private:
   friend class background_obj_pool<T>;
 
   T* do_allocate()
   {
-    if (cache.empty()) {
+    bool cache_hit = not cache.empty();
+    if (not cache_hit) {
       allocate_batch();
     }
     void* top = cache.top();
     cache.pop();
+    counters.on_allocate(cache_hit);
     return static_cast<T*>(top);
   }
 
@@ -121,6 +126,7 @@ private:
     recycle_oper(*payload_ptr);
     void* header_ptr = cache.get_node_header(static_cast<void*>(payload_ptr));
     cache.push(header_ptr);
+    counters.on_deallocate();
   }
 
   // args
@@ -128,8 +134,9 @@ private:
   init_mem_oper_t init_oper;
   recycle_oper_t  recycle_oper;
 
-  memblock_stack     allocated;
-  memblock_node_list cache;
+  memblock_stack      allocated;
+  memblock_node_list  cache;
+  pool_usage_counters counters;
 };
 
 /**
@@ -173,6 +180,12 @@ public:
 
   size_t cache_size() const { return grow_pool.cache_size(); }
 
+  pool_metrics_t get_metrics(const char* name) const final
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return grow_pool.get_metrics(name);
+  }
+
 private:
   T* do_allocate()
   {
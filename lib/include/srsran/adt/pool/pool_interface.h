@@ -22,6 +22,7 @@
 #ifndef SRSRAN_POOL_INTERFACE_H
 #define SRSRAN_POOL_INTERFACE_H
 
+#include "pool_metrics.h"
 #include "srsran/adt/move_callback.h"
 
 namespace srsran {
@@ -47,6 +48,8 @@ public:
 
   virtual ~obj_pool_itf()           = default;
   virtual unique_pool_ptr<T> make() = 0;
+  /// Occupancy of the pool, reported under the given name
+  virtual pool_metrics_t get_metrics(const char* name) const = 0;
 };
 
 /// Allocate object in memory pool
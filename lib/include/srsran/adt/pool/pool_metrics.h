@@ -0,0 +1,88 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_POOL_METRICS_H
+#define SRSRAN_POOL_METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace srsran {
+
+/// Occupancy of a memory or object pool.
+struct pool_metrics_t {
+  std::string name;
+  /// Number of blocks owned by the pool, both free and in use.
+  size_t capacity = 0;
+  size_t in_use   = 0;
+  /// Maximum number of blocks in use at the same time since the pool was created.
+  size_t   high_water         = 0;
+  uint64_t nof_allocs         = 0;
+  uint64_t nof_alloc_failures = 0;
+  /// Number of allocations served without going through the slow path of the pool, i.e. from the thread-local cache
+  /// of concurrent pools or without a synchronous batch allocation in growing pools.
+  uint64_t nof_cache_hits = 0;
+};
+
+/// Usage counters of a pool. They are relaxed atomics, so the pools can update them outside of their locks, and they
+/// can be read from the metrics thread at any time.
+class pool_usage_counters
+{
+public:
+  void on_allocate(bool cache_hit)
+  {
+    size_t cur = in_use.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_t hw  = high_water.load(std::memory_order_relaxed);
+    while (cur > hw and not high_water.compare_exchange_weak(hw, cur, std::memory_order_relaxed)) {
+    }
+    nof_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (cache_hit) {
+      nof_cache_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  void on_alloc_failure() { nof_alloc_failures.fetch_add(1, std::memory_order_relaxed); }
+  void on_deallocate() { in_use.fetch_sub(1, std::memory_order_relaxed); }
+
+  pool_metrics_t get_metrics(const char* name, size_t capacity) const
+  {
+    pool_metrics_t m;
+    m.name               = name;
+    m.capacity           = capacity;
+    m.in_use             = in_use.load(std::memory_order_relaxed);
+    m.high_water         = high_water.load(std::memory_order_relaxed);
+    m.nof_allocs         = nof_allocs.load(std::memory_order_relaxed);
+    m.nof_alloc_failures = nof_alloc_failures.load(std::memory_order_relaxed);
+    m.nof_cache_hits     = nof_cache_hits.load(std::memory_order_relaxed);
+    return m;
+  }
+
+private:
+  std::atomic<size_t>   in_use{0};
+  std::atomic<size_t>   high_water{0};
+  std::atomic<uint64_t> nof_allocs{0};
+  std::atomic<uint64_t> nof_alloc_failures{0};
+  std::atomic<uint64_t> nof_cache_hits{0};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_POOL_METRICS_H
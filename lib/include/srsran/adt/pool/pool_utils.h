@@ -22,7 +22,8 @@
 #ifndef SRSRAN_POOL_UTILS_H
 #define SRSRAN_POOL_UTILS_H
 
-#include "../move_callback.h"
+#include "../detail/type_storage.h"
+#include "srsran/support/srsran_assert.h"
 #include <memory>
 
 namespace srsran {
@@ -29,7 +29,9 @@
 #include <cmath>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace asn1 {
 
@@ -184,6 +186,83 @@ public:
   SRSASN_CODE align_bytes_zero();
 };
 
+/*********************
+   decode arena
+*********************/
+
+/**
+ * Monotonic memory region for the dyn_array and copy_ptr members of decoded messages. While a decode_arena_scope is
+ * active in a thread, these members are allocated in its arena instead of the heap, and the memory is only released
+ * by reset() or the destruction of the arena, for the whole message at once.
+ * The decoded message must be destroyed before the arena is reset or destroyed. Its copies made after the scope
+ * ended are allocated in the heap, so only the unpack() call should be inside the scope.
+ */
+class decode_arena
+{
+public:
+  explicit decode_arena(size_t chunk_size_ = 16384) : chunk_size(chunk_size_) {}
+  decode_arena(const decode_arena&)            = delete;
+  decode_arena& operator=(const decode_arena&) = delete;
+
+  void* allocate(size_t sz, size_t align);
+  /// Releases all the allocations. The first chunk is kept for the next message
+  void   reset();
+  size_t nof_chunks() const { return chunks.size(); }
+
+private:
+  size_t                                 chunk_size;
+  std::vector<std::unique_ptr<uint8_t[]> > chunks;
+  std::vector<size_t>                    chunk_sizes;
+  size_t                                 offset = 0;
+};
+
+/// Makes the ASN.1 types allocate their members in the arena, in the calling thread and while in scope
+class decode_arena_scope
+{
+public:
+  explicit decode_arena_scope(decode_arena& arena);
+  decode_arena_scope(const decode_arena_scope&)            = delete;
+  decode_arena_scope& operator=(const decode_arena_scope&) = delete;
+  ~decode_arena_scope();
+
+private:
+  decode_arena* prev;
+};
+
+namespace detail {
+
+/// Arena of the active decode_arena_scope of the calling thread, or nullptr
+decode_arena* current_decode_arena();
+
+template <typename T>
+T* new_array(uint32_t n, bool& in_arena)
+{
+  decode_arena* arena = current_decode_arena();
+  in_arena            = arena != nullptr;
+  if (not in_arena) {
+    return new T[n];
+  }
+  T* p = static_cast<T*>(arena->allocate(sizeof(T) * n, alignof(T)));
+  for (uint32_t i = 0; i < n; ++i) {
+    new (&p[i]) T;
+  }
+  return p;
+}
+
+template <typename T>
+void delete_array(T* p, uint32_t n, bool in_arena)
+{
+  if (not in_arena) {
+    delete[] p;
+    return;
+  }
+  for (uint32_t i = 0; i < n; ++i) {
+    p[i].~T();
+  }
+}
+
+} // namespace detail
+
 /*********************
   function helpers
 *********************/
@@ -195,15 +274,17 @@ public:
   using iterator       = T*;
   using const_iterator = const T*;
 
-  dyn_array() = default;
-  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size) { data_ = new T[size_]; }
+  dyn_array() : cap_(0), in_arena_(false) {}
+  explicit dyn_array(uint32_t new_size) : size_(new_size), cap_(new_size), in_arena_(false)
+  {
+    data_ = alloc_(size_);
+  }
   dyn_array(const dyn_array<T>& other) : dyn_array(&other[0], other.size_) {}
-  dyn_array(const T* ptr, uint32_t nof_items)
+  dyn_array(const T* ptr, uint32_t nof_items) : cap_(nof_items), in_arena_(false)
   {
     size_ = nof_items;
-    cap_  = nof_items;
     if (ptr != NULL) {
-      data_ = new T[cap_];
+      data_ = alloc_(cap_);
       std::copy(ptr, ptr + size_, data_);
     } else {
       data_ = NULL;
@@ -212,7 +293,7 @@ public:
   ~dyn_array()
   {
     if (data_ != NULL) {
-      delete[] data_;
+      detail::delete_array(data_, cap_, in_arena_);
     }
   }
   uint32_t      size() const { return size_; }
@@ -238,10 +319,12 @@ public:
       return;
     }
 
-    T* old_data = data_;
-    cap_        = new_size > new_cap ? new_size : new_cap;
+    T*       old_data     = data_;
+    uint32_t old_cap      = cap_;
+    bool     old_in_arena = in_arena_;
+    cap_                  = new_size > new_cap ? new_size : new_cap;
     if (cap_ > 0) {
-      data_ = new T[cap_];
+      data_ = alloc_(cap_);
       if (old_data != NULL) {
         srsran_assert(cap_ > size_, "Old size larger than new capacity in dyn_array\n");
         std::copy(&old_data[0], &old_data[size_], data_);
@@ -251,7 +334,7 @@ public:
     }
     size_ = new_size;
     if (old_data != NULL) {
-      delete[] old_data;
+      detail::delete_array(old_data, old_cap, old_in_arena);
     }
   }
   iterator erase(iterator it)
@@ -286,9 +369,19 @@ public:
   const_iterator end() const { return &data_[size()]; }
 
 private:
+  T* alloc_(uint32_t n)
+  {
+    bool in_arena;
+    T*   p    = detail::new_array<T>(n, in_arena);
+    in_arena_ = in_arena;
+    return p;
+  }
+
   T*       data_ = nullptr;
   uint32_t size_ = 0;
-  uint32_t cap_  = 0;
+  // The arena flag is packed with the capacity to keep the size of the decoded messages
+  uint32_t cap_ : 31;
+  uint32_t in_arena_ : 1;
 };
 
 template <class T, uint32_t MAX_N>
@@ -1167,12 +1260,12 @@ public:
   copy_ptr() : ptr(nullptr) {}
   explicit copy_ptr(T* ptr_) : ptr(ptr_) {}
   copy_ptr(copy_ptr<T>&& other) noexcept : ptr(other.ptr) { other.ptr = nullptr; }
-  copy_ptr(const copy_ptr<T>& other) { ptr = (other.ptr == nullptr) ? nullptr : new T(*other.ptr); }
+  copy_ptr(const copy_ptr<T>& other) { ptr = (other.ptr == nullptr) ? nullptr : new T(*other.get()); }
   ~copy_ptr() { destroy_(); }
   copy_ptr<T>& operator=(const copy_ptr<T>& other)
   {
     if (this != &other) {
-      reset((other.ptr == nullptr) ? nullptr : new T(*other.ptr));
+      reset((other.ptr == nullptr) ? nullptr : new T(*other.get()));
     }
     return *this;
   }
@@ -1184,17 +1277,22 @@ public:
     }
     return *this;
   }
-  bool     operator==(const copy_ptr<T>& other) const { return *ptr == *other; }
-  T*       operator->() { return ptr; }
-  const T* operator->() const { return ptr; }
-  T&       operator*() { return *ptr; }       // like pointers, don't call this if ptr==NULL
-  const T& operator*() const { return *ptr; } // like pointers, don't call this if ptr==NULL
-  T*       get() { return ptr; }
-  const T* get() const { return ptr; }
+  bool     operator==(const copy_ptr<T>& other) const { return *get() == *other; }
+  T*       operator->() { return get(); }
+  const T* operator->() const { return get(); }
+  T&       operator*() { return *get(); }       // like pointers, don't call this if ptr==NULL
+  const T& operator*() const { return *get(); } // like pointers, don't call this if ptr==NULL
+  T*       get() { return untag_(ptr); }
+  const T* get() const { return untag_(ptr); }
   T*       release()
   {
-    T* ret = ptr;
-    ptr    = nullptr;
+    T* ret = get();
+    if (is_in_arena_()) {
+      // The caller owns the returned object, so it has to be moved to the heap
+      ret = new T(std::move(*ret));
+      destroy_();
+    }
+    ptr = nullptr;
     return ret;
   }
   void reset(T* ptr_ = nullptr)
@@ -1204,18 +1302,32 @@ public:
   }
   void set_present(bool flag = true)
   {
-    if (flag) {
-      reset(new T());
-    } else {
+    if (not flag) {
       reset();
+      return;
     }
+    decode_arena* arena = detail::current_decode_arena();
+    if (arena == nullptr) {
+      reset(new T());
+      return;
+    }
+    // The objects of the arena are tagged in the lowest bit of the pointer, which is aligned to at least 2 bytes
+    T* p = new (arena->allocate(sizeof(T), std::max<size_t>(alignof(T), 2))) T();
+    reset(reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(p) | 1u));
   }
-  bool is_present() const { return get() != nullptr; }
+  bool is_present() const { return ptr != nullptr; }
 
 private:
-  void destroy_()
+  static T* untag_(T* p) { return reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(p) & ~uintptr_t(1)); }
+  bool      is_in_arena_() const { return (reinterpret_cast<uintptr_t>(ptr) & 1u) != 0; }
+  void      destroy_()
   {
-    if (ptr != NULL) {
+    if (ptr == NULL) {
+      return;
+    }
+    if (is_in_arena_()) {
+      get()->~T();
+    } else {
       delete ptr;
     }
   }
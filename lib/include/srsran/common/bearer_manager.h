@@ -151,6 +151,8 @@ public:
   using radio_bearer_t = srsran::detail::ue_bearer_manager_impl::radio_bearer_t;
 
   enb_bearer_manager();
+  enb_bearer_manager(const enb_bearer_manager&) = delete;
+  enb_bearer_manager& operator=(const enb_bearer_manager&) = delete;
   ~enb_bearer_manager();
 
   /// Multi-user interface (see comments above)
@@ -163,7 +165,8 @@ public:
   bool           set_five_qi(uint16_t rnti, uint32_t eps_bearer_id, uint16_t five_qi);
 
 private:
-  srslog::basic_logger& logger;
+  mutable pthread_rwlock_t rwlock = {}; /// RW lock to protect access from the RRC and user-plane threads
+  srslog::basic_logger&    logger;
 
   std::unordered_map<uint16_t, srsran::detail::ue_bearer_manager_impl> users_map;
 };
@@ -71,6 +71,8 @@ public:
       free_list.push_back(b);
     }
     capacity = nof_buffers;
+    // sorted, so that deallocate() finds the buffers of this pool with a binary search
+    std::sort(pool.begin(), pool.end());
   }
 
   ~buffer_pool()
@@ -148,7 +150,7 @@ public:
   {
     bool ret = false;
     pthread_mutex_lock(&mutex);
-    if (std::find(pool.cbegin(), pool.cend(), b) != pool.cend()) {
+    if (std::binary_search(pool.cbegin(), pool.cend(), b)) {
       free_list.push_back(b);
       ret = true;
     }
@@ -166,8 +168,11 @@ private:
   uint32_t               capacity;
 };
 
-/// Type of global byte buffer pool
-using byte_buffer_pool = concurrent_fixed_memory_pool<sizeof(byte_buffer_t)>;
+/// Type of global byte buffer pool. Its blocks also hold the header that tells the pool of a byte buffer
+using byte_buffer_pool = concurrent_fixed_memory_pool<sizeof(byte_buffer_t) + alignof(detail::max_alignment_t)>;
+
+/// Appends the occupancy of the global byte buffer pools, one entry per size class
+void get_byte_buffer_pool_metrics(std::vector<pool_metrics_t>& metrics);
 
 /// Function used to generate unique byte buffers
 inline unique_byte_buffer_t make_byte_buffer() noexcept
@@ -180,6 +185,10 @@ inline unique_byte_buffer_t make_byte_buffer(uint32_t size, uint8_t value) noexc
   return std::unique_ptr<byte_buffer_t>(new (std::nothrow) byte_buffer_t(size, value));
 }
 
+/// Function used to generate a byte buffer from the pool of the smallest size class that fits payload_len bytes, plus
+/// the trailers of the lower layers. The buffer has less headroom and tailroom than those of make_byte_buffer()
+unique_byte_buffer_t make_sized_byte_buffer(uint32_t payload_len, const char* debug_ctxt = nullptr) noexcept;
+
 inline unique_byte_buffer_t make_byte_buffer(const char* debug_ctxt) noexcept
 {
   std::unique_ptr<byte_buffer_t> buffer(new (std::nothrow) byte_buffer_t());
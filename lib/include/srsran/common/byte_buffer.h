@@ -24,6 +24,8 @@
 
 #include "common.h"
 #include "srsran/adt/span.h"
+#include "srsran/common/pkt_trace.h"
+#include "srsran/common/tsc_clock.h"
 #include <chrono>
 #include <cstdint>
 
@@ -48,23 +50,23 @@ struct buffer_latency_calc {
     if (!timestamp_is_set) {
       return std::chrono::microseconds{0};
     }
-    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - tp);
+    return std::chrono::duration_cast<std::chrono::microseconds>(tsc_clock::now() - tp);
 #else
     return std::chrono::microseconds{0};
 #endif
   }
 
-  std::chrono::high_resolution_clock::time_point get_timestamp() const { return tp; }
+  tsc_clock::time_point get_timestamp() const { return tp; }
 
   void set_timestamp()
   {
 #ifdef ENABLE_TIMESTAMP
-    tp               = std::chrono::high_resolution_clock::now();
+    tp               = tsc_clock::now();
     timestamp_is_set = true;
 #endif
   }
 
-  void set_timestamp(std::chrono::high_resolution_clock::time_point tp_)
+  void set_timestamp(tsc_clock::time_point tp_)
   {
 #ifdef ENABLE_TIMESTAMP
     tp               = tp_;
@@ -74,17 +76,39 @@ struct buffer_latency_calc {
 
 private:
 #ifdef ENABLE_TIMESTAMP
-  std::chrono::high_resolution_clock::time_point tp;
-  bool                                           timestamp_is_set = false;
+  tsc_clock::time_point tp;
+  bool                  timestamp_is_set = false;
 #endif
 };
 
+/******************************************************************************
+ * Byte buffer size classes
+ *
+ * The pooled byte buffers are taken from one of three pools, depending on
+ * the size of the payload they are created for. The buffers of the smaller
+ * classes have less headroom and tailroom than the default byte buffer, but
+ * the same interface.
+ *****************************************************************************/
+
+enum class byte_buffer_size_class_t : uint8_t { small, medium, large };
+
+#define SRSRAN_SMALL_BUFFER_HEADROOM 128
+#define SRSRAN_SMALL_BUFFER_SIZE_BYTES (SRSRAN_SMALL_BUFFER_HEADROOM + 256)
+#define SRSRAN_MEDIUM_BUFFER_HEADROOM 256
+#define SRSRAN_MEDIUM_BUFFER_SIZE_BYTES (SRSRAN_MEDIUM_BUFFER_HEADROOM + 2048)
+// Tailroom kept free by the sized buffers for the trailers added by the lower layers, e.g. the PDCP MAC-I
+#define SRSRAN_SIZED_BUFFER_TRAILER_MARGIN 32
+
+class byte_buffer_t;
+using unique_byte_buffer_t = std::unique_ptr<byte_buffer_t>;
+
 /******************************************************************************
  * Byte buffer
  *
  * Generic byte buffer with headroom to accommodate packet headers and custom
- * copy constructors & assignment operators for quick copying. Byte buffer
- * holds a next pointer to support linked lists.
+ * copy constructors & assignment operators for quick copying.
+ * The buffers allocated by make_sized_byte_buffer() only own the first
+ * buffer_len bytes of the buffer array, which is therefore the last member.
  *****************************************************************************/
 class byte_buffer_t
 {
@@ -93,8 +117,7 @@ public:
   using const_iterator = const uint8_t*;
 
   uint32_t N_bytes = 0;
-  uint8_t  buffer[SRSRAN_MAX_BUFFER_SIZE_BYTES];
-  uint8_t* msg = nullptr;
+  uint8_t* msg     = nullptr;
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
   char debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN];
 #endif
@@ -102,33 +125,47 @@ public:
   struct buffer_metadata_t {
     uint32_t            pdcp_sn = 0;
     buffer_latency_calc tp;
+    pkt_trace_t         trace; ///< Per layer timestamps of the sampled DL packets
   } md;
 
+private:
+  uint32_t buffer_len   = SRSRAN_MAX_BUFFER_SIZE_BYTES;
+  uint32_t headroom_len = SRSRAN_BUFFER_HEADER_OFFSET;
+
+public:
+  uint8_t buffer[SRSRAN_MAX_BUFFER_SIZE_BYTES];
+
   byte_buffer_t() : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET])
   {
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
     bzero(debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
 #endif
   }
-  explicit byte_buffer_t(uint32_t size) : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET]), N_bytes(size)
+  explicit byte_buffer_t(uint32_t size) : N_bytes(size), msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET])
   {
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
     bzero(debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
 #endif
   }
   byte_buffer_t(uint32_t size, uint8_t val) : byte_buffer_t(size) { std::fill(msg, msg + N_bytes, val); }
-  byte_buffer_t(const byte_buffer_t& buf) : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET]), md(buf.md), N_bytes(buf.N_bytes)
+  byte_buffer_t(const byte_buffer_t& buf) : N_bytes(buf.N_bytes), msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET]), md(buf.md)
   {
     // copy actual contents
     memcpy(msg, buf.msg, N_bytes);
   }
 
+  // The contents of a larger buffer must fit in the buffer_len bytes of this buffer
   byte_buffer_t& operator=(const byte_buffer_t& buf)
   {
     // avoid self assignment
     if (&buf == this)
       return *this;
-    msg     = &buffer[buf.msg - &(*buf.buffer)];
+    uint32_t headroom = buf.msg - buf.buffer;
+    if (headroom + buf.N_bytes > buffer_len) {
+      // keep the default headroom of this buffer, if the one of buf is larger
+      headroom = headroom_len;
+    }
+    msg     = &buffer[headroom];
     N_bytes = buf.N_bytes;
     md      = buf.md;
     memcpy(msg, buf.msg, N_bytes);
@@ -137,20 +174,20 @@ public:
 
   void clear()
   {
-    msg     = &buffer[SRSRAN_BUFFER_HEADER_OFFSET];
+    msg     = &buffer[headroom_len];
     N_bytes = 0;
     md      = {};
   }
   uint32_t get_headroom() { return msg - buffer; }
   // Returns the remaining space from what is reported to be the length of msg
-  uint32_t                  get_tailroom() const { return (sizeof(buffer) - (msg - buffer) - N_bytes); }
+  uint32_t                  get_tailroom() const { return (buffer_len - (msg - buffer) - N_bytes); }
   std::chrono::microseconds get_latency_us() const { return md.tp.get_latency_us(); }
 
-  std::chrono::high_resolution_clock::time_point get_timestamp() const { return md.tp.get_timestamp(); }
+  tsc_clock::time_point get_timestamp() const { return md.tp.get_timestamp(); }
 
   void set_timestamp() { md.tp.set_timestamp(); }
 
-  void set_timestamp(std::chrono::high_resolution_clock::time_point tp_) { md.tp.set_timestamp(tp_); }
+  void set_timestamp(tsc_clock::time_point tp_) { md.tp.set_timestamp(tp_); }
 
   void append_bytes(uint8_t* buf, uint32_t size)
   {
@@ -174,6 +211,23 @@ public:
   void* operator new[](size_t sz) = delete;
   void  operator delete(void* ptr);
   void  operator delete[](void* ptr) = delete;
+
+  /// Bytes of a pool block taken by a byte buffer that owns the first buffer_len_ bytes of the buffer array
+  static constexpr size_t block_size(uint32_t buffer_len_)
+  {
+    return sizeof(byte_buffer_t) - SRSRAN_MAX_BUFFER_SIZE_BYTES + buffer_len_;
+  }
+
+private:
+  friend unique_byte_buffer_t make_sized_byte_buffer(uint32_t payload_len, const char* debug_ctxt) noexcept;
+
+  byte_buffer_t(uint32_t buffer_len_, uint32_t headroom_len_, bool) :
+    msg(&buffer[headroom_len_]), buffer_len(buffer_len_), headroom_len(headroom_len_)
+  {
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
+    bzero(debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
+#endif
+  }
 };
 
 struct bit_buffer_t {
@@ -208,8 +262,6 @@ struct bit_buffer_t {
   uint32_t get_headroom() { return msg - buffer; }
 };
 
-using unique_byte_buffer_t = std::unique_ptr<byte_buffer_t>;
-
 ///
 /// Utilities to create a span out of a byte_buffer.
 ///
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_BYTE_BUFFER_IOVEC_H
+#define SRSRAN_BYTE_BUFFER_IOVEC_H
+
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/common/byte_buffer.h"
+#include <cstring>
+
+namespace srsran {
+
+/**
+ * Scatter-gather list of byte segments that live in pool buffers. The list owns the buffers that were handed over
+ * with their last segment, so the layer that builds a PDU can release its SDUs while their bytes are still pending.
+ * The bytes are only copied once, when the list is linearized into the destination buffer
+ * @tparam MAX_SEGS maximum number of segments of the list
+ */
+template <std::size_t MAX_SEGS>
+class byte_buffer_iovec
+{
+public:
+  struct segment_t {
+    const uint8_t* ptr;
+    uint32_t       len;
+  };
+
+  bool     full() const { return segments.size() == segments.capacity(); }
+  bool     empty() const { return segments.empty(); }
+  size_t   size() const { return segments.size(); }
+  uint32_t length() const { return nof_bytes; }
+
+  const segment_t& operator[](size_t idx) const { return segments[idx]; }
+
+  /// Appends a segment of a buffer that outlives the linearization of the list
+  void append(const uint8_t* ptr, uint32_t len)
+  {
+    srsran_assert(not full(), "The iovec is full");
+    segments.push_back(segment_t{ptr, len});
+    nof_bytes += len;
+  }
+
+  /// Appends the first len bytes of buf, and keeps buf alive until the list is cleared
+  void append(unique_byte_buffer_t buf, uint32_t len)
+  {
+    append(buf->msg, len);
+    buffers.push_back(std::move(buf));
+  }
+
+  /// Copies the segments into dst, which must have space for length() bytes. Returns the number of bytes written
+  uint32_t linearize(uint8_t* dst) const
+  {
+    for (const segment_t& seg : segments) {
+      memcpy(dst, seg.ptr, seg.len);
+      dst += seg.len;
+    }
+    return nof_bytes;
+  }
+
+  /// Removes the segments and releases the owned buffers back to the pool
+  void clear()
+  {
+    segments.clear();
+    buffers.clear();
+    nof_bytes = 0;
+  }
+
+private:
+  bounded_vector<segment_t, MAX_SEGS>            segments;
+  bounded_vector<unique_byte_buffer_t, MAX_SEGS> buffers;
+  uint32_t                                       nof_bytes = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_BYTE_BUFFER_IOVEC_H
@@ -62,6 +62,10 @@ struct rf_args_t {
   std::string device_args;
   std::string time_adv_nsamples;
   std::string continuous_tx;
+  bool        rx_dc_correction; // Removes the DC offset of the received samples on the host
+  bool        rx_iq_correction; // Compensates the IQ imbalance of the received samples on the host
+  bool        rx_digital_agc;   // Scales the received samples with a fast digital gain control on the host
+  uint32_t    tx_coalesce_max_sf; // Maximum number of consecutive subframes merged in a single send, 0 disables it
 
   std::array<rf_args_band_t, SRSRAN_MAX_CARRIERS> ch_rx_bands;
   std::array<rf_args_band_t, SRSRAN_MAX_CARRIERS> ch_tx_bands;
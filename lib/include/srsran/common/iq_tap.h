@@ -0,0 +1,126 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_IQ_TAP_H
+#define SRSRAN_IQ_TAP_H
+
+#include "srsran/adt/span.h"
+#include "srsran/common/threads.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Runtime capture of the subframe buffers exchanged with the radio.
+ *
+ * The PHY workers copy each buffer into a pre-allocated ring of fixed-size slots, which takes no system call. A
+ * background thread writes the slots to the samples file, with O_DIRECT when the file system supports it so that the
+ * capture does not fill the page cache. For every buffer it appends a line to the index, <filename>.csv, with the TTI,
+ * the direction, the carrier, the port, the sample format, the offset in the samples file, the length and the RNTIs
+ * scheduled in the subframe. Each buffer takes a whole slot, rounded up to 4 KiB blocks, in the samples file.
+ * When the writer falls behind, the buffers that find the ring full are dropped and counted; the workers never wait.
+ */
+class iq_tap : public thread
+{
+public:
+  enum class direction_t { rx, tx };
+
+  /// Maximum number of RNTIs recorded per buffer, the rest are not written to the index
+  static const uint32_t max_nof_rntis = 32;
+
+  iq_tap() : thread("IQ_TAP") {}
+  ~iq_tap() override;
+  iq_tap(const iq_tap&) = delete;
+  iq_tap& operator=(const iq_tap&) = delete;
+
+  /**
+   * Creates the samples file and its index, allocates a ring of nof_slots buffers of up to max_buffer_bytes each and
+   * starts the writer thread. Returns false if the files or the ring could not be created.
+   */
+  bool start(const std::string& filename, uint32_t nof_slots, uint32_t max_buffer_bytes);
+
+  /// Writes the buffers still in the ring, stops the writer thread and closes the files
+  void stop();
+
+  bool is_running() const { return running; }
+
+  /**
+   * Copies a buffer of nof_bytes into the ring. Returns false if the capture is not running, the buffer is larger than
+   * a slot or the ring is full.
+   */
+  bool push(direction_t                  dir,
+            uint32_t                     tti,
+            uint32_t                     cc_idx,
+            uint32_t                     port_idx,
+            bool                         sc16,
+            const void*                  samples,
+            uint32_t                     nof_bytes,
+            srsran::span<const uint16_t> rntis);
+
+  uint64_t nof_dropped() const;
+
+private:
+  enum class slot_state_t { free, writing, ready };
+
+  struct slot_t {
+    slot_state_t                        state     = slot_state_t::free;
+    direction_t                         dir       = direction_t::rx;
+    uint32_t                            tti       = 0;
+    uint32_t                            cc_idx    = 0;
+    uint32_t                            port_idx  = 0;
+    bool                                sc16      = false;
+    uint32_t                            nof_bytes = 0;
+    uint32_t                            nof_rntis = 0;
+    std::array<uint16_t, max_nof_rntis> rntis     = {};
+  };
+
+  void run_thread() override;
+  bool write_slots(uint64_t first, uint32_t count);
+  void write_index(const slot_t& slot, uint64_t offset);
+  void release_ring();
+
+  std::vector<slot_t>     slots;
+  uint8_t*                ring      = nullptr;
+  size_t                  ring_len  = 0;
+  size_t                  slot_len  = 0;
+  int                     fd        = -1;
+  FILE*                   index     = nullptr;
+  uint64_t                file_pos  = 0;
+  mutable std::mutex      mutex;
+  std::condition_variable cvar;
+  // Slots are claimed in order by the workers, [rd_idx, wr_idx) are being copied or waiting to be written
+  uint64_t rd_idx   = 0;
+  uint64_t wr_idx   = 0;
+  uint64_t dropped  = 0;
+  bool     stopping = false;
+
+  std::atomic<bool> running = {false};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_IQ_TAP_H
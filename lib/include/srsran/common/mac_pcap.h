@@ -36,7 +36,7 @@ public:
   uint32_t close();
 
 private:
-  void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  void write_records(srsran::span<const uint8_t> records) override;
 
   FILE*       pcap_file = nullptr;
   uint32_t    dlt       = 0; // The DLT used for the PCAP file
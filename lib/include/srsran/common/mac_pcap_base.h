@@ -26,6 +26,7 @@
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_capture_ring.h"
 #include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
 #include <mutex>
@@ -49,6 +50,11 @@ public:
 
   void set_ue_id(uint16_t ue_id);
 
+  /// Maximum number of bytes captured per PDU, including the MAC context. 0 captures the whole PDUs
+  void set_snaplen(uint32_t snaplen);
+  /// Captures one PDU of every sampling_rate PDUs
+  void set_sampling(uint32_t sampling_rate);
+
   // EUTRA
   void
   write_ul_crnti(uint8_t* pdu, uint32_t pdu_len_bytes, uint16_t crnti, uint32_t reTX, uint32_t tti, uint8_t cc_idx);
@@ -97,23 +103,19 @@ public:
   // clang-format on
 
 protected:
-  typedef struct {
-    // Different PCAP context for both RATs
-    srsran::srsran_rat_t  rat;
-    MAC_Context_Info_t    context;
-    mac_nr_context_info_t context_nr;
-    unique_byte_buffer_t  pdu;
-  } pcap_pdu_t;
-
-  virtual void write_pdu(pcap_pdu_t& pdu) = 0;
+  /// Bytes of the capture ring filled by the PHY workers and flushed by the writer thread
+  static const size_t capture_ring_size = 16 * 1024 * 1024;
+
+  /// Writes a block of whole records, each made of the PCAP record header, the UDP/MAC context header and the PDU
+  virtual void write_records(srsran::span<const uint8_t> records) = 0;
   void         run_thread() final;
 
-  std::mutex                              mutex;
-  srslog::basic_logger&                   logger;
-  std::atomic<bool>                       running = {false};
-  static_blocking_queue<pcap_pdu_t, 1024> queue;
-  uint16_t                                ue_id                = 0;
-  int                                     emergency_handler_id = -1;
+  std::mutex            mutex;
+  srslog::basic_logger& logger;
+  std::atomic<bool>     running = {false};
+  pcap_capture_ring     ring;
+  uint16_t              ue_id                = 0;
+  int                   emergency_handler_id = -1;
 
 private:
   void pack_and_queue(uint8_t* payload,
@@ -134,6 +136,10 @@ private:
                          uint8_t  harqid,
                          uint8_t  direction,
                          uint8_t  rnti_type);
+  bool sample_pdu();
+
+  std::atomic<uint32_t> sampling_rate  = {1};
+  std::atomic<uint32_t> sampling_count = {0};
 };
 
 } // namespace srsran
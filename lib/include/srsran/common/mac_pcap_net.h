@@ -41,9 +41,12 @@ public:
   uint32_t close();
 
 private:
-  void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
-  void write_mac_lte_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
-  void write_mac_nr_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  /// Maximum number of datagrams sent with one sendmmsg() call
+  static const unsigned max_send_batch = 64;
+  /// Length of the UDP header that precedes the MAC context in the records of the capture ring
+  static const uint32_t dummy_udp_header_len = 8;
+
+  void write_records(srsran::span<const uint8_t> records) override;
 
   srsran::unique_socket socket;
   struct sockaddr_in    client_addr;
@@ -29,12 +29,15 @@
 #define SRSRAN_MULTIQUEUE_H
 
 #include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/detail/type_storage.h"
 #include "srsran/adt/move_callback.h"
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <queue>
+#include <thread>
 #include <vector>
 
 namespace srsran {
@@ -46,6 +49,8 @@ namespace srsran {
  * are pushed to these ports.
  * Each port provides a thread-safe push(...) / try_push(...) interface to enqueue messages
  * The class will pop from the several created ports in a round-robin fashion.
+ * The ports are lock-free rings, and the consumer waiting for new messages is only woken up by the producers when
+ * it is idle.
  * The popping() interface is not safe-thread. That means, that it is expected that only one thread will
  * be popping tasks.
  * @tparam myobj message type
@@ -53,52 +58,61 @@ namespace srsran {
 template <typename myobj>
 class multiqueue_handler
 {
+  /**
+   * Bounded MPSC ring based on the sequence numbers of D. Vyukov's bounded queue. The producers reserve a slot with
+   * a CAS on the enqueue position, and publish the object with the slot sequence number. Only the full queue case
+   * blocks the producers. The consumer does not take any lock shared with the producers.
+   */
   class input_port_impl
   {
+    struct slot_t {
+      std::atomic<size_t>         seq{0};
+      detail::type_storage<myobj> obj;
+    };
+
   public:
-    input_port_impl(uint32_t cap, multiqueue_handler<myobj>* parent_) : buffer(cap), parent(parent_) {}
+    input_port_impl(uint32_t cap, multiqueue_handler<myobj>* parent_) :
+      parent(parent_), cap_(cap), slots(new slot_t[cap])
+    {
+      for (size_t i = 0; i < cap_; ++i) {
+        slots[i].seq.store(i, std::memory_order_relaxed);
+      }
+    }
     input_port_impl(const input_port_impl&) = delete;
     input_port_impl(input_port_impl&&)      = delete;
     input_port_impl& operator=(const input_port_impl&) = delete;
     input_port_impl& operator=(input_port_impl&&) = delete;
     ~input_port_impl() { deactivate_blocking(); }
 
-    size_t capacity() const { return buffer.max_size(); }
+    size_t capacity() const { return cap_; }
     size_t size() const
     {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return buffer.size();
-    }
-    bool active() const
-    {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return active_;
+      size_t head = dequeue_pos.load();
+      size_t tail = enqueue_pos.load();
+      return tail > head ? std::min(tail - head, cap_) : 0;
     }
+    bool active() const { return active_.load(std::memory_order_acquire); }
     void set_active(bool val)
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (val == active_) {
-        // no-op
+      if (active_.exchange(val) == val or val) {
         return;
       }
-      active_ = val;
-
-      if (not active_) {
-        buffer.clear();
-        lock.unlock();
-        // unlock blocked pushing threads
-        cv_full.notify_all();
-      }
+      // unlock blocked pushing threads
+      std::lock_guard<std::mutex> lock(full_mutex);
+      cv_full.notify_all();
     }
 
     void deactivate_blocking()
     {
       set_active(false);
 
-      // wait for all the pushers to unlock
-      std::unique_lock<std::mutex> lock(q_mutex);
-      while (nof_waiting > 0) {
-        cv_exit.wait(lock);
+      // wait for all the pushers to exit, and drop the objects left
+      while (nof_pushing.load() > 0) {
+        std::this_thread::yield();
+      }
+      std::lock_guard<std::mutex> lock(pop_mutex);
+      myobj                       obj;
+      while (pop_(obj)) {
       }
     }
 
@@ -120,65 +134,103 @@ class multiqueue_handler
 
     bool try_pop(myobj& obj)
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      return pop_(lock, obj);
+      std::lock_guard<std::mutex> lock(pop_mutex);
+      return active() and pop_(obj);
     }
 
     bool try_pop(myobj& obj, bool& try_lock_success)
     {
-      std::unique_lock<std::mutex> lock(q_mutex, std::try_to_lock);
+      // The lock is only contended by a thread deactivating the port
+      std::unique_lock<std::mutex> lock(pop_mutex, std::try_to_lock);
       try_lock_success = lock.owns_lock();
-      return try_lock_success ? pop_(lock, obj) : false;
+      return try_lock_success and active() and pop_(obj);
     }
 
   private:
     template <typename T>
     bool push_(T* o, bool blocking) noexcept
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (not blocking) {
-        // non-blocking case
-        if (not active_ or buffer.full()) {
-          return false;
+      nof_pushing++;
+      bool ret = false;
+      while (active()) {
+        if (try_enqueue_(o)) {
+          ret = true;
+          break;
         }
-      } else {
-        // blocking case
-        while (active_ and buffer.full()) {
-          nof_waiting++;
+        if (not blocking) {
+          break;
+        }
+        // blocking case, wait for the consumer to pop
+        std::unique_lock<std::mutex> lock(full_mutex);
+        nof_waiting++;
+        while (active() and size() >= cap_) {
           cv_full.wait(lock);
-          nof_waiting--;
         }
-        if (not active_) {
-          lock.unlock();
-          cv_exit.notify_one();
+        nof_waiting--;
+      }
+      if (ret) {
+        parent->notify_push();
+      }
+      // the port may be destroyed from here on
+      nof_pushing--;
+      return ret;
+    }
+
+    template <typename T>
+    bool try_enqueue_(T* o)
+    {
+      size_t  pos = enqueue_pos.load(std::memory_order_relaxed);
+      slot_t* slot;
+      while (true) {
+        slot         = &slots[pos % cap_];
+        size_t   seq = slot->seq.load(std::memory_order_acquire);
+        intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (dif == 0) {
+          if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (dif < 0) {
+          // full
           return false;
+        } else {
+          pos = enqueue_pos.load(std::memory_order_relaxed);
         }
       }
-      buffer.push(std::forward<T>(*o));
+      slot->obj.emplace(std::forward<T>(*o));
+      slot->seq.store(pos + 1, std::memory_order_release);
       return true;
     }
 
-    bool pop_(std::unique_lock<std::mutex>& lock, myobj& obj)
+    // Called by the consumer, or by the deactivating thread, with the pop_mutex locked
+    bool pop_(myobj& obj)
     {
-      if (buffer.empty()) {
+      size_t  pos  = dequeue_pos.load(std::memory_order_relaxed);
+      slot_t& slot = slots[pos % cap_];
+      if (slot.seq.load(std::memory_order_acquire) != pos + 1) {
+        // empty, or the next object is still being written
         return false;
       }
-      obj = std::move(buffer.top());
-      buffer.pop();
-      if (nof_waiting > 0) {
-        lock.unlock();
+      obj = std::move(slot.obj.get());
+      slot.obj.destroy();
+      slot.seq.store(pos + cap_, std::memory_order_release);
+      dequeue_pos.store(pos + 1);
+      if (nof_waiting.load() > 0) {
+        std::lock_guard<std::mutex> lock(full_mutex);
         cv_full.notify_one();
       }
       return true;
     }
 
     multiqueue_handler<myobj>* parent = nullptr;
-
-    mutable std::mutex                 q_mutex;
-    srsran::dyn_circular_buffer<myobj> buffer;
-    std::condition_variable            cv_full, cv_exit;
-    bool                               active_     = true;
-    int                                nof_waiting = 0;
+    const size_t               cap_;
+    std::unique_ptr<slot_t[]>  slots;
+    std::atomic<size_t>        enqueue_pos{0};
+    std::atomic<size_t>        dequeue_pos{0};
+    std::atomic<bool>          active_{true};
+    std::atomic<int>           nof_pushing{0};
+    std::atomic<int>           nof_waiting{0};
+    std::mutex                 pop_mutex, full_mutex;
+    std::condition_variable    cv_full;
   };
 
 public:
@@ -234,6 +286,10 @@ public:
       // signal deactivation to pushing threads in a non-blocking way
       q.set_active(false);
     }
+    {
+      std::lock_guard<std::mutex> wakeup_lock(wakeup_mutex);
+      cv_not_empty.notify_all();
+    }
     while (consumer_state) {
       cv_exit.wait(lock);
     }
@@ -286,23 +342,34 @@ public:
     return count;
   }
 
-  bool wait_pop(myobj* value)
+  bool wait_pop(myobj* value) { return wait_pop(value, 1) == 1; }
+
+  /**
+   * Blocks until there is at least one object to pop, and pops up to max_n objects, in round-robin from the queues
+   * @return The number of objects popped, 0 if the multiqueue was stopped
+   */
+  size_t wait_pop(myobj* values, size_t max_n)
   {
     std::unique_lock<std::mutex> lock(mutex);
     consumer_state = true;
     while (running) {
-      if (round_robin_pop_(value)) {
+      uint64_t nof_pushes_seen = nof_pushes.load();
+      size_t   n               = 0;
+      while (n < max_n and round_robin_pop_(&values[n])) {
+        ++n;
+      }
+      if (n > 0) {
         consumer_state = false;
-        return true;
+        return n;
       }
       lock.unlock();
-      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      wait_push_(nof_pushes_seen);
       lock.lock();
     }
     consumer_state = false;
     lock.unlock();
     cv_exit.notify_one();
-    return false;
+    return 0;
   }
 
   bool try_pop(myobj* value)
@@ -312,6 +379,26 @@ public:
   }
 
 private:
+  // Called by the producers after every push. The consumer is only woken up if it is waiting
+  void notify_push()
+  {
+    nof_pushes++;
+    if (consumer_waiting.load()) {
+      std::lock_guard<std::mutex> lock(wakeup_mutex);
+      cv_not_empty.notify_one();
+    }
+  }
+
+  void wait_push_(uint64_t nof_pushes_seen)
+  {
+    std::unique_lock<std::mutex> lock(wakeup_mutex);
+    consumer_waiting = true;
+    while (running and nof_pushes.load() == nof_pushes_seen) {
+      cv_not_empty.wait(lock);
+    }
+    consumer_waiting = false;
+  }
+
   bool round_robin_pop_(myobj* value)
   {
     // Round-robin for all queues
@@ -327,7 +414,7 @@ private:
         return true;
       }
       if (not try_lock_success) {
-        // restart RR search, as there was a collision with a producer
+        // restart RR search, as there was a collision with a thread deactivating a queue
         count = 0;
       }
     }
@@ -337,9 +424,16 @@ private:
   mutable std::mutex          mutex;
   std::condition_variable     cv_exit;
   uint32_t                    spin_idx = 0;
-  bool                        running = true, consumer_state = false;
+  std::atomic<bool>           running{true};
+  bool                        consumer_state = false;
   std::deque<input_port_impl> queues;
   uint32_t                    default_capacity = 0;
+
+  // Wake-up of the consumer
+  std::mutex              wakeup_mutex;
+  std::condition_variable cv_not_empty;
+  std::atomic<uint64_t>   nof_pushes{0};
+  std::atomic<bool>       consumer_waiting{false};
 };
 
 template <typename T>
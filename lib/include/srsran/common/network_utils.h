@@ -35,6 +35,7 @@
 #include <netinet/udp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 namespace srsran {
 
@@ -60,6 +61,21 @@ bool bind_addr(int fd, const sockaddr_in& addr_in);
 bool bind_addr(int fd, const char* bind_addr_str, int port, sockaddr_in* addr_result = nullptr);
 bool connect_to(int fd, const char* dest_addr_str, int dest_port, sockaddr_in* dest_sockaddr = nullptr);
 
+// UDP segmentation offload
+/// Maximum number of datagrams passed to a single send_datagrams() call
+const uint32_t max_send_datagrams = 64;
+bool           udp_gso_supported(int fd);
+bool           enable_udp_gro(int fd);
+/// Size of the datagrams coalesced by UDP GRO in a received message, or the message length if not coalesced
+uint32_t get_udp_gro_size(msghdr* msg, uint32_t msg_len);
+/**
+ * Sends the datagrams with sendmmsg(). When gso is set, the runs of datagrams with the same destination and size,
+ * where only the last one may be shorter, are sent as a single UDP GSO message. If the kernel rejects the GSO
+ * messages, gso is cleared and the datagrams are sent one by one
+ * @return number of datagrams sent
+ */
+uint32_t send_datagrams(int fd, const iovec* bufs, const sockaddr_in* addrs, uint32_t nof_datagrams, bool& gso);
+
 } // namespace net_utils
 
 /**
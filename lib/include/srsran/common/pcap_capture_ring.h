@@ -0,0 +1,105 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PCAP_CAPTURE_RING_H
+#define SRSRAN_PCAP_CAPTURE_RING_H
+
+#include "srsran/adt/span.h"
+#include "srsran/common/pcap.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace srsran {
+
+/**
+ * Pre-allocated byte ring that stores complete PCAP records (record header, protocol header and payload), so that
+ * the writer thread can flush the pending records with one write per contiguous block.
+ * The ring is allocated by init(), on huge pages when the system provides them. Records are never split at the end of the
+ * ring; when a record does not fit in the remaining bytes, it is stored at the start of the ring instead.
+ * Any number of threads may push records; a single writer thread consumes them.
+ */
+class pcap_capture_ring
+{
+public:
+  explicit pcap_capture_ring(size_t flush_threshold_bytes = 256 * 1024) : flush_threshold(flush_threshold_bytes) {}
+  ~pcap_capture_ring();
+  pcap_capture_ring(const pcap_capture_ring&) = delete;
+  pcap_capture_ring& operator=(const pcap_capture_ring&) = delete;
+
+  /**
+   * Allocates the ring, or keeps the current one if it has the same capacity, and discards the stored records so that
+   * the ring can be used for a new capture. Returns false if the memory could not be allocated.
+   */
+  bool init(size_t capacity_bytes);
+
+  size_t capacity() const { return cap; }
+
+  /// Maximum number of bytes stored per record, after the record header. Longer packets are truncated. 0 keeps all
+  void set_snaplen(uint32_t snaplen_);
+
+  /**
+   * Stores a record made of the protocol header and the payload, prefixed by the PCAP record header with the current
+   * time. Returns false if the record was dropped because the ring is full.
+   */
+  bool push(const uint8_t* hdr, uint32_t hdr_len, const uint8_t* payload, uint32_t payload_len);
+
+  /**
+   * Waits until the pending bytes reach the flush threshold, the timeout expires or stop() is called, and returns the
+   * oldest contiguous block of whole records. The block stays valid until it is released.
+   */
+  span<const uint8_t> wait_block(std::chrono::milliseconds timeout);
+
+  /// Returns the oldest contiguous block of whole records without waiting
+  span<const uint8_t> front_block();
+
+  /// Releases the bytes at the start of the block returned by wait_block() or front_block()
+  void release(size_t nof_bytes);
+
+  /// Wakes up the writer waiting in wait_block(). The ring keeps accepting records
+  void stop();
+
+  uint64_t nof_dropped() const;
+
+private:
+  span<const uint8_t> front_block_unlocked() const;
+
+  uint8_t*                buffer          = nullptr;
+  size_t                  cap             = 0;
+  size_t                  alloc_len       = 0;
+  size_t                  flush_threshold = 0;
+  uint32_t                snaplen         = 0;
+  mutable std::mutex      mutex;
+  std::condition_variable cvar;
+  // Records are stored in [rpos, wpos) or, once the writer went back to the start of the ring, in [rpos, end) and
+  // [0, wpos)
+  size_t   rpos     = 0;
+  size_t   wpos     = 0;
+  size_t   end      = 0;
+  bool     wrapped  = false;
+  size_t   pending  = 0;
+  bool     stopping = false;
+  uint64_t dropped  = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PCAP_CAPTURE_RING_H
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PKT_TRACE_H
+#define SRSRAN_PKT_TRACE_H
+
+#include "srsran/common/tsc_clock.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace srsran {
+
+/// Layer boundaries at which a sampled DL packet is timestamped, in the order the packet crosses them
+enum class pkt_trace_point : uint8_t {
+  gtpu_rx,  ///< GTPU PDU received from the core
+  pdcp_tx,  ///< SDU handed to PDCP
+  rlc_tx,   ///< PDCP PDU handed to RLC
+  rlc_read, ///< First byte of the SDU read by the MAC to assemble a PDU
+  nof_points
+};
+
+/// Sets the packet trace sampling, 1 in every "period" packets is traced. A period of 0 disables the tracing
+void pkt_trace_set_period(uint32_t period);
+
+namespace detail {
+
+/// Returns true if the next packet has to be traced
+bool pkt_trace_sample();
+
+} // namespace detail
+
+/// Timestamps of a DL packet at each layer boundary. It travels in the metadata of the packet buffer
+struct pkt_trace_t {
+  constexpr static size_t nof_points = (size_t)pkt_trace_point::nof_points;
+
+  bool                                          sampled = false;
+  std::array<tsc_clock::time_point, nof_points> tp      = {};
+
+  /// Decides if the packet is traced and, if so, timestamps its arrival
+  void start()
+  {
+    sampled = detail::pkt_trace_sample();
+    stamp(pkt_trace_point::gtpu_rx);
+  }
+
+  void stamp(pkt_trace_point point)
+  {
+    if (sampled) {
+      tp[(size_t)point] = tsc_clock::now();
+    }
+  }
+
+  /// Time between two trace points in microseconds
+  int64_t interval_us(pkt_trace_point from, pkt_trace_point to) const
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(tp[(size_t)to] - tp[(size_t)from]).count();
+  }
+};
+
+/// Histogram of a latency in microseconds with logarithmic bins. Bin 0 counts the values below 1 us, bin i the values
+/// in [2^(i-1), 2^i) us and the last bin the values beyond.
+struct pkt_latency_hist_t {
+  constexpr static uint32_t nof_bins = 22;
+
+  std::array<uint32_t, nof_bins> bins     = {};
+  uint32_t                       count    = 0;
+  int64_t                        max_us   = 0;
+  int64_t                        total_us = 0;
+
+  void add(int64_t value_us)
+  {
+    uint32_t bin = 0;
+    if (value_us > 0) {
+      bin = 64 - __builtin_clzll((uint64_t)value_us);
+    }
+    bins[std::min(bin, nof_bins - 1)]++;
+    max_us = std::max(max_us, value_us);
+    total_us += value_us;
+    count++;
+  }
+  static int64_t bin_lower_us(uint32_t bin) { return bin == 0 ? 0 : (int64_t)1 << (bin - 1); }
+};
+
+/// Latency breakdown of the sampled DL packets of a bearer
+struct pkt_latency_metrics_t {
+  pkt_latency_hist_t gtpu;      ///< From GTPU reception until PDCP, i.e. tunnel lookup and the up thread queue
+  pkt_latency_hist_t pdcp;      ///< PDCP processing, including the ciphering workers
+  pkt_latency_hist_t rlc_queue; ///< Wait in the RLC queue until the scheduler allocates the bearer
+  pkt_latency_hist_t total;     ///< From GTPU reception until the MAC PDU assembly
+
+  void add(const pkt_trace_t& trace)
+  {
+    gtpu.add(trace.interval_us(pkt_trace_point::gtpu_rx, pkt_trace_point::pdcp_tx));
+    pdcp.add(trace.interval_us(pkt_trace_point::pdcp_tx, pkt_trace_point::rlc_tx));
+    rlc_queue.add(trace.interval_us(pkt_trace_point::rlc_tx, pkt_trace_point::rlc_read));
+    total.add(trace.interval_us(pkt_trace_point::gtpu_rx, pkt_trace_point::rlc_read));
+  }
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PKT_TRACE_H
@@ -39,8 +39,8 @@
 #include <string.h>
 
 typedef struct {
-  uint32_t* lfsr;
-  uint32_t* fsm;
+  uint32_t lfsr[16];
+  uint32_t fsm[3];
 } S3G_STATE;
 
 /* Initialization.
@@ -27,6 +27,7 @@
  *****************************************************************************/
 
 #include "srsran/common/common.h"
+#include "srsran/common/ssl.h"
 #include "srsran/srslog/srslog.h"
 
 #include <vector>
@@ -272,6 +273,29 @@ uint8_t security_128_eia2(const uint8_t* key,
                           uint32_t       msg_len,
                           uint8_t*       mac);
 
+/// AES-128 key schedule of a EEA2/EIA2 key and its CMAC subkeys (RFC 4493 Section 2.3), derived once per key. It
+/// is not copyable, since the key schedule may point into its own storage
+struct security_128_aes_ctx_t {
+  aes_context ctx    = {};
+  uint8_t     k1[16] = {};
+  uint8_t     k2[16] = {};
+
+  security_128_aes_ctx_t()                              = default;
+  security_128_aes_ctx_t(const security_128_aes_ctx_t&) = delete;
+  security_128_aes_ctx_t& operator=(const security_128_aes_ctx_t&) = delete;
+};
+
+void security_128_aes_set_key(security_128_aes_ctx_t& aes, const uint8_t* key);
+
+/// EIA2 with a cached key schedule. The message is processed in place of being copied after the COUNT/BEARER header
+uint8_t security_128_eia2(security_128_aes_ctx_t& aes,
+                          uint32_t                count,
+                          uint32_t                bearer,
+                          uint8_t                 direction,
+                          const uint8_t*          msg,
+                          uint32_t                msg_len,
+                          uint8_t*                mac);
+
 uint8_t security_128_eia3(const uint8_t* key,
                           uint32_t       count,
                           uint32_t       bearer,
@@ -301,6 +325,15 @@ uint8_t security_128_eea2(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out);
 
+/// EEA2 with a cached key schedule. msg and msg_out may be the same buffer
+uint8_t security_128_eea2(security_128_aes_ctx_t& aes,
+                          uint32_t                count,
+                          uint8_t                 bearer,
+                          uint8_t                 direction,
+                          const uint8_t*          msg,
+                          uint32_t                msg_len,
+                          uint8_t*                msg_out);
+
 uint8_t security_128_eea3(uint8_t* key,
                           uint32_t count,
                           uint8_t  bearer,
@@ -323,6 +356,21 @@ security_milenage_f2345(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_t* res, ui
 
 uint8_t security_milenage_f5_star(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_t* ak);
 
+/**
+ * Milenage f1 and f2345 for the generation of an authentication vector. k_ctx holds the AES round keys of K, so that
+ * they are computed once per subscriber with aes_setkey_enc(), and the AES output TEMP is shared by f1 and f2345.
+ */
+uint8_t security_milenage_f12345(aes_context* k_ctx,
+                                 uint8_t*     opc,
+                                 uint8_t*     rand,
+                                 uint8_t*     sqn,
+                                 uint8_t*     amf,
+                                 uint8_t*     mac_a,
+                                 uint8_t*     res,
+                                 uint8_t*     ck,
+                                 uint8_t*     ik,
+                                 uint8_t*     ak);
+
 int security_xor_f2345(uint8_t* k, uint8_t* rand, uint8_t* res, uint8_t* ck, uint8_t* ik, uint8_t* ak);
 int security_xor_f1(uint8_t* k, uint8_t* rand, uint8_t* sqn, uint8_t* amf, uint8_t* mac_a);
 
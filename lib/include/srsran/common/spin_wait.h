@@ -0,0 +1,62 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SPIN_WAIT_H
+#define SRSRAN_SPIN_WAIT_H
+
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace srsran {
+
+/// Tells the CPU that the calling thread is busy-polling, so that it saves power and frees resources for its sibling
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * Busy-polls a condition until it holds or the deadline passes. It is used before sleeping on a condition variable
+ * where the wake-up latency of the sleeping thread matters more than the CPU it burns
+ * @return true if the condition holds
+ */
+template <typename Predicate>
+bool spin_until(const Predicate& pred, std::chrono::steady_clock::time_point deadline)
+{
+  while (not pred()) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+    cpu_relax();
+  }
+  return true;
+}
+
+} // namespace srsran
+
+#endif // SRSRAN_SPIN_WAIT_H
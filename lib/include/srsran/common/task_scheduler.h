@@ -81,14 +81,16 @@ public:
   //  CAUTION: This is a blocking call
   bool run_next_task()
   {
-    srsran::move_task_t task{};
-    if (external_tasks.wait_pop(&task)) {
-      task();
+    size_t n = external_tasks.wait_pop(task_batch.data(), task_batch.size());
+    for (size_t i = 0; i < n; ++i) {
+      task_batch[i]();
+      task_batch[i] = {};
       run_all_internal_tasks();
-      return true;
     }
-    run_all_internal_tasks();
-    return false;
+    if (n == 0) {
+      run_all_internal_tasks();
+    }
+    return n > 0;
   }
 
   //! Processes the next task in the multiqueue if it exists.
@@ -114,11 +116,16 @@ private:
     }
   }
 
+  // Maximum number of tasks popped from the multiqueue at once
+  static const size_t max_task_batch = 16;
+
   srsran::task_multiqueue   external_tasks;
   srsran::task_queue_handle background_queue; ///< Queue for handling the outcomes of tasks run in the background
   srsran::timer_handler     timers;
   srsran::dyn_blocking_queue<srsran::move_task_t>
       internal_tasks; ///< enqueues stack tasks from within main thread. Avoids locking
+
+  std::array<srsran::move_task_t, max_task_batch> task_batch;
 };
 
 //! Task scheduler handle given to classes/functions running within the main control thread
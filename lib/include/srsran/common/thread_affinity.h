@@ -0,0 +1,118 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         thread_affinity.h
+ *  Description:  CPU core and NUMA node placement of the real-time threads.
+ *                Every thread class is assigned a core list and a memory
+ *                node at start-up, each thread applies the placement of its
+ *                class to itself once it runs.
+ *****************************************************************************/
+
+#ifndef SRSRAN_THREAD_AFFINITY_H
+#define SRSRAN_THREAD_AFFINITY_H
+
+#include <sched.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+enum class thread_class_t { txrx, phy_worker, prach_worker, stack, gtpu, log, nof_classes };
+
+const char* to_string(thread_class_t cls);
+
+/// Number of NUMA nodes a thread class can be placed on, as many as bits in the node mask passed to the kernel
+constexpr int max_nof_numa_nodes = sizeof(unsigned long) * 8;
+
+struct thread_affinity_t {
+  std::vector<uint32_t> cores;          ///< CPU cores the threads may run on, empty leaves them to the kernel
+  int                   numa_node = -1; ///< Preferred memory node of the threads, -1 keeps the default policy
+  uint32_t              spin_us   = 0;  ///< Time the threads busy-poll a handoff before sleeping, 0 sleeps at once
+
+  bool empty() const { return cores.empty() && numa_node < 0; }
+};
+
+/**
+ * Parses a core list in the format of taskset and the kernel isolcpus option, e.g. "2-5,8". An empty string is a
+ * valid empty list
+ * @return false if the string is malformed
+ */
+bool parse_core_list(const std::string& str, std::vector<uint32_t>& cores);
+
+/// Sets the placement of a thread class, it must be called before the threads of the class are started
+void set_thread_affinity(thread_class_t cls, const thread_affinity_t& affinity);
+
+/**
+ * Sets the placement of a thread class from a core list string, a memory node and a busy-poll time, as read from the
+ * configuration
+ * @return false if the core list is malformed or the memory node is not below max_nof_numa_nodes
+ */
+bool set_thread_affinity(thread_class_t cls, const std::string& cores, int numa_node, uint32_t spin_us = 0);
+
+const thread_affinity_t& get_thread_affinity(thread_class_t cls);
+
+/**
+ * Pins the calling thread to the cores of its class and makes its allocations prefer the memory node of the class
+ * @return false if the placement could not be applied
+ */
+bool apply_thread_affinity(thread_class_t cls);
+
+/**
+ * Makes the allocations of the calling thread prefer the memory node of a thread class during its lifetime. It is used
+ * where the buffers of a worker are allocated by the thread that creates it rather than by the worker itself
+ */
+class scoped_numa_policy
+{
+public:
+  explicit scoped_numa_policy(thread_class_t cls);
+  ~scoped_numa_policy();
+
+  scoped_numa_policy(const scoped_numa_policy&) = delete;
+  scoped_numa_policy& operator=(const scoped_numa_policy&) = delete;
+
+private:
+  bool active = false;
+};
+
+/**
+ * Applies the placement of a thread class to the calling thread during its lifetime, so that the threads it creates
+ * inherit it. It is used for the threads that are not created through srsran::thread, such as the log backend
+ */
+class scoped_thread_affinity
+{
+public:
+  explicit scoped_thread_affinity(thread_class_t cls);
+  ~scoped_thread_affinity();
+
+  scoped_thread_affinity(const scoped_thread_affinity&) = delete;
+  scoped_thread_affinity& operator=(const scoped_thread_affinity&) = delete;
+
+private:
+  bool               restore_cores = false;
+  cpu_set_t          saved_cores   = {};
+  scoped_numa_policy numa;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_THREAD_AFFINITY_H
@@ -31,9 +31,13 @@
 
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/move_callback.h"
+#include "srsran/common/thread_affinity.h"
 #include "srsran/srslog/srslog.h"
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -49,6 +53,21 @@ namespace srsran {
 class thread_pool
 {
 public:
+  using task_t = srsran::move_callback<void()>;
+
+  /// Sub-tasks pushed by a worker, which any idle worker of the pool can take while the owner keeps working
+  class task_group
+  {
+  public:
+    task_group()                  = default;
+    task_group(const task_group&) = delete;
+    task_group& operator=(const task_group&) = delete;
+
+  private:
+    friend class thread_pool;
+    uint32_t pending = 0;
+  };
+
   class worker : public thread
   {
   public:
@@ -62,6 +81,11 @@ public:
   protected:
     virtual void work_imp() = 0;
 
+    /// Queues a sub-task of the current work, it can be taken by any idle worker or by wait_tasks()
+    void push_task(task_group& group, task_t&& task);
+    /// Runs queued sub-tasks, of this or other workers, until all the sub-tasks of the group have finished
+    void wait_tasks(task_group& group);
+
   private:
     uint32_t          my_id     = 0;
     thread_pool*      my_parent = nullptr;
@@ -85,12 +109,41 @@ public:
   uint32_t    get_nof_workers();
   std::string get_id();
 
+  /// Sets the class whose CPU cores, NUMA node and busy-poll time the workers apply, it must be called before
+  /// init_worker()
+  void set_thread_class(thread_class_t cls)
+  {
+    thread_class = cls;
+    spin_time    = std::chrono::microseconds(get_thread_affinity(cls).spin_us);
+  }
+
+  void push_task(task_group& group, task_t&& task);
+  void wait_tasks(task_group& group);
+
+  /**
+   * @brief Parks or wakes workers so that the active ones are busy the target fraction of the time. The load is
+   * measured since the previous call, the workers are woken at once and parked one at a time
+   * @param min_workers Minimum number of active workers
+   * @param target_load Target busy fraction of each active worker, between 0 and 1
+   * @return The number of active workers
+   */
+  uint32_t autoscale(uint32_t min_workers, float target_load);
+
 private:
   bool find_finished_worker(uint32_t tti, uint32_t* id);
+  bool run_pending_task(std::unique_lock<std::mutex>& lock, task_group* group);
+  void wake_worker(uint32_t id);
 
-  typedef enum { STOP, IDLE, START_WORK, WORKER_READY, WORKING } worker_status;
+  // Workers running a sub-task of another worker are HELPING, so that wait_worker() only picks truly idle ones
+  typedef enum { STOP, IDLE, START_WORK, WORKER_READY, WORKING, HELPING } worker_status;
+
+  struct pending_task_t {
+    task_group* group;
+    task_t      task;
+  };
 
   std::string                          id; // id is prepended to every worker
+  thread_class_t                       thread_class = thread_class_t::nof_classes;
   std::vector<worker*>                 workers     = {};
   uint32_t                             nof_workers = 0;
   uint32_t                             max_workers = 0;
@@ -99,13 +152,43 @@ private:
   std::mutex                           mutex_queue = {};
   std::vector<worker_status>           status      = {};
   std::vector<std::condition_variable> cvar_worker = {};
+  std::vector<std::atomic<uint32_t>>   wake_seq; // Bumped on every wake-up of a worker, which it can busy-poll
+  std::chrono::microseconds            spin_time{0}; // Time an idle worker busy-polls before sleeping
+  std::deque<pending_task_t>           tasks       = {};
+  std::condition_variable              cvar_tasks  = {};
+
+  // Load measurement for autoscale(), the workers above the active limit are parked: they are neither picked by
+  // wait_worker() nor help with the sub-tasks
+  using load_clock = std::chrono::steady_clock;
+  uint32_t                            active_workers    = UINT32_MAX;
+  std::vector<load_clock::time_point> work_start        = {};
+  load_clock::duration                busy_time         = {};
+  load_clock::time_point              load_window_start = load_clock::now();
 };
 
+/// Priority of the tasks of a task_thread_pool. The low priority tasks are only run when there are no normal ones, and
+/// they never occupy all the workers of a pool with more than one worker, so long jobs do not delay the short ones
+enum class task_priority { normal, low };
+
+/**
+ * Pool of workers that run the pushed tasks. Each worker has its own queue per priority, so concurrent pushes lock
+ * different queues. The tasks are pushed round-robin to the workers, or to the own queue of the worker when pushed
+ * from a task of the pool, and the idle workers steal the tasks queued in the other workers.
+ * With a single worker, the tasks of each priority run in FIFO order.
+ */
 class task_thread_pool
 {
   using task_t                             = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
   static constexpr uint32_t max_task_shift = 14;
   static constexpr uint32_t max_task_num   = 1u << max_task_shift;
+  static constexpr uint32_t max_workers    = 32;
+  // The max_task_num tasks of each priority are split over the queues of the workers, so a single worker pool queues
+  // up to max_task_num tasks per priority. Queues added by set_nof_workers get the share of the new size, thus the
+  // total capacity only grows
+  static constexpr uint32_t queue_capacity(uint32_t nof_workers)
+  {
+    return (max_task_num + nof_workers - 1) / nof_workers;
+  }
 
 public:
   task_thread_pool(uint32_t nof_workers = 1, bool start_deferred = false, int32_t prio_ = -1, uint32_t mask_ = 255);
@@ -119,11 +202,21 @@ public:
   void start(int32_t prio_ = -1, uint32_t mask_ = 255);
   void set_nof_workers(uint32_t nof_workers);
 
-  void     push_task(task_t&& task);
+  void     push_task(task_t&& task, task_priority priority = task_priority::normal);
   uint32_t nof_pending_tasks() const;
-  size_t   nof_workers() const { return workers.size(); }
+  size_t   nof_workers() const { return nof_queues; }
 
 private:
+  struct task_queue_t {
+    explicit task_queue_t(uint32_t capacity) :
+      tasks{dyn_circular_buffer<task_t>(capacity), dyn_circular_buffer<task_t>(capacity)}
+    {}
+
+    std::mutex                  mutex;
+    dyn_circular_buffer<task_t> tasks[2];
+    std::atomic<uint32_t>       nof_tasks{0};
+  };
+
   class worker_t : public thread
   {
   public:
@@ -135,22 +228,31 @@ private:
     void run_thread() override;
 
   private:
-    bool wait_task(task_t* task);
+    bool wait_task(task_t* task, task_priority* priority);
 
     task_thread_pool* parent  = nullptr;
     uint32_t          id_     = 0;
     bool              running = false;
   };
 
+  bool try_pop(uint32_t queue_idx, task_priority priority, task_t* task);
+  bool try_pop_any(uint32_t first_queue_idx, task_t* task, task_priority* priority);
+  void wake_worker();
+
   int32_t               prio = -1;
   uint32_t              mask = 255;
   srslog::basic_logger& logger;
 
-  srsran::dyn_circular_buffer<task_t>     pending_tasks;
-  std::vector<std::unique_ptr<worker_t> > workers;
-  mutable std::mutex                      queue_mutex;
-  std::condition_variable                 cv_empty;
-  bool                                    running = false;
+  std::array<std::unique_ptr<task_queue_t>, max_workers> queues;
+  std::atomic<uint32_t>                                  nof_queues{0};
+  std::atomic<uint32_t>                                  next_queue{0};
+  std::atomic<uint32_t>                                  nof_pending{0};
+  std::atomic<uint32_t>                                  nof_running_low{0};
+  std::atomic<uint32_t>                                  nof_sleeping{0};
+  std::vector<std::unique_ptr<worker_t> >                workers;
+  mutable std::mutex                                     queue_mutex;
+  std::condition_variable                                cv_empty;
+  std::atomic<bool>                                      running{false};
 };
 
 /// Class used to create a single worker with an input task queue with a single reader
@@ -189,6 +291,9 @@ private:
 
 srsran::task_thread_pool& get_background_workers();
 
+/// Pool for the PDCP ciphering of the user plane. It is only started by the stacks that offload the ciphering
+srsran::task_thread_pool& get_crypto_workers();
+
 } // namespace srsran
 
 #endif // SRSRAN_THREAD_POOL_H
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_TIME_PROF_H
 #define SRSRAN_TIME_PROF_H
 
+#include "srsran/common/tsc_clock.h"
 #include "srsran/srslog/srslog.h"
 #include <chrono>
 #include <mutex>
@@ -38,13 +39,13 @@ namespace srsran {
 class tprof_measure
 {
 public:
-  using tpoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+  using tpoint = tsc_clock::time_point;
 
   tprof_measure() = default;
-  void                     start() { t1 = std::chrono::high_resolution_clock::now(); }
+  void                     start() { t1 = tsc_clock::now(); }
   std::chrono::nanoseconds stop()
   {
-    auto t2 = std::chrono::high_resolution_clock::now();
+    auto t2 = tsc_clock::now();
     return std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1);
   }
 
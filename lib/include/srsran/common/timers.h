@@ -56,20 +56,28 @@ public:
  *   This deque will only grow in size. Erased timers are just tagged in the deque as empty, and can be reused for the
  *   creation of new timers. To avoid unnecessary runtime allocations, the user can set an initial capacity.
  * - free_list - intrusive forward linked list to keep track of the empty timers and speed up new timer creation.
- * - A large circular vector of size WHEEL_SIZE which works as a time wheel, storing and circularly indexing the
- *   currently running timers by their respective timeout value.
- *   For a number of running timers N, and uniform distribution of timeout values, the step_all() complexity
- *   should be O(N/WHEEL_SIZE). Thus, the performance should improve with a larger WHEEL_SIZE, at the expense of more
- *   used memory.
+ * - time_wheel - hierarchical time wheel, storing the currently running timers by their respective timeout value.
+ *   Level 0 has WHEEL_SIZE slots of one tic each. Each of the NOF_LEVELS upper levels has LEVEL_SIZE slots, each slot
+ *   covering the whole span of the level below. Timers closer to the timeout than WHEEL_SIZE tics are placed in
+ *   level 0, the others in the first level whose span fits the time left. When the level 0 index wraps around, the
+ *   current slot of the level above is cascaded down, re-inserting its timers in the lower levels.
+ *   Each timer stores the slot it is in, so run() and stop() are O(1). step_all() only visits the timers that expire,
+ *   plus the cascaded ones, and each timer is cascaded at most NOF_LEVELS times. Thus, its cost does not depend on
+ *   the number of long timers running.
  */
 class timer_handler
 {
   using tic_diff_t                      = uint32_t;
   using tic_t                           = uint32_t;
   constexpr static uint32_t INVALID_ID  = std::numeric_limits<uint32_t>::max();
-  constexpr static size_t   WHEEL_SHIFT = 16U;
+  constexpr static size_t   WHEEL_SHIFT = 8U;
   constexpr static size_t   WHEEL_SIZE  = 1U << WHEEL_SHIFT;
   constexpr static size_t   WHEEL_MASK  = WHEEL_SIZE - 1U;
+  constexpr static size_t   LEVEL_SHIFT = 6U;
+  constexpr static size_t   LEVEL_SIZE  = 1U << LEVEL_SHIFT;
+  constexpr static size_t   LEVEL_MASK  = LEVEL_SIZE - 1U;
+  constexpr static size_t   NOF_LEVELS  = 4U; ///< the levels cover the whole 32-bit tic range
+  constexpr static size_t   EXPIRY_POS  = WHEEL_SIZE + NOF_LEVELS * LEVEL_SIZE; ///< timers whose callback is pending
 
   constexpr static uint64_t   STOPPED_FLAG       = 0U;
   constexpr static uint64_t   RUNNING_FLAG       = static_cast<uint64_t>(1U) << 63U;
@@ -91,6 +99,7 @@ class timer_handler
     timer_handler& parent;
     // writes protected by backend lock
     bool                                  allocated = false;
+    size_t                                wheel_pos = 0;
     std::atomic<uint64_t>                 state{0}; ///< read can be without lock, thus writes must be atomic
     srsran::move_callback<void(uint32_t)> callback;
 
@@ -234,7 +243,7 @@ public:
 
   explicit timer_handler(uint32_t capacity = 64)
   {
-    time_wheel.resize(WHEEL_SIZE);
+    time_wheel.resize(EXPIRY_POS + 1);
     // Pre-reserve timers
     while (timer_list.size() < capacity) {
       timer_list.emplace_back(*this, timer_list.size());
@@ -250,25 +259,33 @@ public:
   {
     std::unique_lock<std::mutex> lock(mutex);
     uint32_t                     cur_time_local = cur_time.load(std::memory_order_relaxed) + 1;
-    auto&                        wheel_list     = time_wheel[cur_time_local & WHEEL_MASK];
+    cascade_(cur_time_local);
+
+    // Move the expiring timers out of the wheel. Timers run from the callbacks are inserted from the next tic onwards
+    auto& wheel_list  = time_wheel[cur_time_local & WHEEL_MASK];
+    auto& expiry_list = time_wheel[EXPIRY_POS];
+    while (not wheel_list.empty()) {
+      timer_impl& timer = wheel_list.front();
+      wheel_list.pop(&timer);
+      expiry_list.push_front(&timer);
+      timer.wheel_pos = EXPIRY_POS;
+    }
+    wheel_tic = cur_time_local + 1;
 
-    for (auto it = wheel_list.begin(); it != wheel_list.end();) {
-      timer_impl& timer = timer_list[it->id];
-      ++it;
-      if (decode_timeout(timer.state.load(std::memory_order_relaxed)) == cur_time_local) {
-        // stop timer (callback has to see the timer has already expired)
-        stop_timer_(timer, true);
+    while (not expiry_list.empty()) {
+      timer_impl& timer = expiry_list.front();
+      // stop timer (callback has to see the timer has already expired)
+      stop_timer_(timer, true);
 
-        // Call callback if configured
-        if (not timer.callback.is_empty()) {
-          // unlock mutex. It can happen that the callback tries to run a timer too
-          lock.unlock();
+      // Call callback if configured
+      if (not timer.callback.is_empty()) {
+        // unlock mutex. It can happen that the callback tries to run or stop a timer too
+        lock.unlock();
 
-          timer.callback(timer.id);
+        timer.callback(timer.id);
 
-          // Lock again to keep protecting the wheel
-          lock.lock();
-        }
+        // Lock again to keep protecting the wheel
+        lock.lock();
       }
     }
 
@@ -313,7 +330,7 @@ public:
     timer.run();
   }
 
-  // useful for testing
+  // useful for testing. Size of the level 0 of the wheel
   static size_t get_wheel_size() { return WHEEL_SIZE; }
 
 private:
@@ -355,28 +372,58 @@ private:
     uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
     duration_                = duration_ == 0 ? decode_duration(timer_old_state) : duration_;
     uint32_t new_timeout     = cur_time.load(std::memory_order_relaxed) + duration_;
-    size_t   new_wheel_pos   = new_timeout & WHEEL_MASK;
-
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    bool     was_running = decode_is_running(timer_old_state);
-    if (was_running and (old_timeout & WHEEL_MASK) == new_wheel_pos) {
-      // If no change in timer wheel position. Just update absolute timeout
-      timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
-      return;
-    }
 
     // Stop timer if it was running, removing it from wheel in the process
-    if (was_running) {
-      time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
+    if (decode_is_running(timer_old_state)) {
+      time_wheel[timer.wheel_pos].pop(&timer);
       nof_timers_running_--;
     }
 
     // Insert timer in wheel
-    time_wheel[new_wheel_pos].push_front(&timer);
     timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
+    insert_timer_(timer, new_timeout);
     nof_timers_running_++;
   }
 
+  /// Inserts the timer in the wheel slot for the given timeout, relative to the next tic whose slot is not processed
+  void insert_timer_(timer_impl& timer, tic_t timeout)
+  {
+    tic_diff_t time_left = timeout - wheel_tic;
+    size_t     pos       = wheel_tic & WHEEL_MASK;
+    if (static_cast<int32_t>(time_left) < 0) {
+      // timeout is the tic being processed (run from a callback). Expire it in the next tic
+    } else if (time_left < WHEEL_SIZE) {
+      pos = timeout & WHEEL_MASK;
+    } else {
+      size_t level = 1;
+      while (level < NOF_LEVELS and time_left >= (static_cast<uint64_t>(1U) << (WHEEL_SHIFT + level * LEVEL_SHIFT))) {
+        level++;
+      }
+      size_t shift = WHEEL_SHIFT + (level - 1) * LEVEL_SHIFT;
+      pos          = WHEEL_SIZE + (level - 1) * LEVEL_SIZE + ((timeout >> shift) & LEVEL_MASK);
+    }
+    time_wheel[pos].push_front(&timer);
+    timer.wheel_pos = pos;
+  }
+
+  /// Re-inserts the timers of the upper level slots that start at the given tic in the lower levels
+  void cascade_(tic_t tic)
+  {
+    for (size_t level = 1; level <= NOF_LEVELS; ++level) {
+      size_t shift = WHEEL_SHIFT + (level - 1) * LEVEL_SHIFT;
+      if ((tic & ((static_cast<uint64_t>(1U) << shift) - 1U)) != 0) {
+        // the lower level index did not wrap around
+        break;
+      }
+      auto& slot_list = time_wheel[WHEEL_SIZE + (level - 1) * LEVEL_SIZE + ((tic >> shift) & LEVEL_MASK)];
+      while (not slot_list.empty()) {
+        timer_impl& timer = slot_list.front();
+        slot_list.pop(&timer);
+        insert_timer_(timer, decode_timeout(timer.state.load(std::memory_order_relaxed)));
+      }
+    }
+  }
+
   /// called when user manually stops timer (as an alternative to expiry)
   void stop_timer_(timer_impl& timer, bool expiry)
   {
@@ -387,7 +434,7 @@ private:
 
     // If already running, need to disconnect it from previous wheel
     uint32_t old_timeout = decode_timeout(timer_old_state);
-    time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
+    time_wheel[timer.wheel_pos].pop(&timer);
     uint64_t new_state =
         encode_state(expiry ? EXPIRED_FLAG : STOPPED_FLAG, decode_duration(timer_old_state), old_timeout);
     timer.state.store(new_state, std::memory_order_relaxed);
@@ -395,6 +442,7 @@ private:
   }
 
   std::atomic<tic_t> cur_time{0};
+  tic_t              wheel_tic = 1; ///< next tic whose level 0 slot is processed. Protected by mutex
   size_t             nof_timers_running_ = 0, nof_free_timers = 0;
   // using a deque to maintain reference validity on emplace_back. Also, this deque will only grow.
   std::deque<timer_impl>                                         timer_list;
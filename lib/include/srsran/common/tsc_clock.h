@@ -0,0 +1,99 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_TSC_CLOCK_H
+#define SRSRAN_TSC_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace srsran {
+
+/**
+ * Monotonic clock that reads the CPU timestamp counter (TSC on x86, CNTVCT on ARMv8). Reading the counter is much
+ * cheaper than the clock_gettime() call of std::chrono::steady_clock and high_resolution_clock, so the clock can be
+ * used to timestamp every packet.
+ * The counter frequency is calibrated against std::chrono::steady_clock at the first use, and the time points start
+ * from the steady_clock time of the calibration. The clock is meant for measuring intervals, it is not kept in sync
+ * with steady_clock afterwards. When the CPU has no invariant counter, the clock falls back to steady_clock.
+ */
+class tsc_clock
+{
+public:
+  using duration                  = std::chrono::nanoseconds;
+  using rep                       = duration::rep;
+  using period                    = duration::period;
+  using time_point                = std::chrono::time_point<tsc_clock>;
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept
+  {
+    const calibration_t& cal = get_calibration();
+    if (cal.counter_hz == 0) {
+      return time_point{std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch())};
+    }
+    uint64_t ticks = read_counter() - cal.base_ticks;
+    uint64_t ns    = static_cast<uint64_t>((static_cast<unsigned __int128>(ticks) * cal.ns_mult) >> ns_mult_shift);
+    return time_point{duration{cal.base_ns + static_cast<rep>(ns)}};
+  }
+
+  /// Frequency of the counter in Hz, or 0 if the clock falls back to steady_clock
+  static uint64_t counter_frequency_hz() noexcept { return get_calibration().counter_hz; }
+
+private:
+  // Nanoseconds per counter tick, in fixed point
+  static const uint32_t ns_mult_shift = 32;
+
+  struct calibration_t {
+    uint64_t counter_hz = 0;
+    uint64_t ns_mult    = 0;
+    uint64_t base_ticks = 0;
+    rep      base_ns    = 0;
+  };
+
+  static const calibration_t& get_calibration() noexcept
+  {
+    static const calibration_t cal = calibrate();
+    return cal;
+  }
+  static calibration_t calibrate() noexcept;
+
+  static uint64_t read_counter() noexcept
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return 0;
+#endif
+  }
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_TSC_CLOCK_H
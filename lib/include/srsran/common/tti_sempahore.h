@@ -19,7 +19,11 @@
  *
  */
 
+#include "srsran/common/spin_wait.h"
+#include "srsran/common/thread_affinity.h"
 #include <assert.h>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <inttypes.h>
@@ -34,6 +38,7 @@ namespace srsran {
  * Implements priority semaphore based on a FIFO queue wait . This class enqueues T type element identifiers (method
  * push) and waits until the enqueued object is the first (method wait). The first element is released by method
  * release. The method release_all waits for all the elements to be released.
+ * The waiting threads may busy-poll the releases for the spin time of their thread class before sleeping.
  *
  * @tparam T Object identifier type
  */
@@ -41,13 +46,23 @@ template <class T>
 class tti_semaphore
 {
 private:
-  std::mutex              mutex; ///< Used for scope mutexes
-  std::condition_variable cvar;  ///< Used for notifying element identifier releases
-  std::deque<T>           fifo;  ///< Queue to keep order
+  std::mutex                mutex;           ///< Used for scope mutexes
+  std::condition_variable   cvar;            ///< Used for notifying element identifier releases
+  std::deque<T>             fifo;            ///< Queue to keep order
+  std::atomic<uint32_t>     nof_releases{0}; ///< Counts the releases, so that the waiting threads can busy-poll them
+  std::chrono::microseconds spin_time{0};    ///< Time a waiting thread busy-polls before sleeping
 
 public:
   tti_semaphore() = default;
 
+  /**
+   * Sets the thread class of the waiting threads, whose busy-poll time the waits apply. It must be called before the
+   * first wait
+   *
+   * @param cls the thread class
+   */
+  void set_thread_class(thread_class_t cls) { spin_time = std::chrono::microseconds(get_thread_affinity(cls).spin_us); }
+
   /**
    * Waits for the first element of the queue match the element identifier provided.
    *
@@ -57,8 +72,22 @@ public:
   {
     std::unique_lock<std::mutex> lock(mutex);
 
+    std::chrono::steady_clock::time_point spin_deadline = {};
+    if (spin_time.count() > 0) {
+      spin_deadline = std::chrono::steady_clock::now() + spin_time;
+    }
+
     // While the FIFO is not empty and the front ID does not match the provided element identifier, keep waiting
     while (not fifo.empty() and fifo.front() != id) {
+      // Busy-poll the releases until the deadline, the predicate is checked again with the mutex locked
+      if (spin_time.count() > 0 and std::chrono::steady_clock::now() < spin_deadline) {
+        uint32_t seen = nof_releases.load(std::memory_order_relaxed);
+        lock.unlock();
+        spin_until([this, seen]() { return nof_releases.load(std::memory_order_acquire) != seen; }, spin_deadline);
+        lock.lock();
+        continue;
+      }
+
       // Wait for a release
       cvar.wait(lock);
     }
@@ -90,6 +119,7 @@ public:
     }
 
     // Notify release
+    nof_releases.fetch_add(1, std::memory_order_release);
     cvar.notify_all();
   }
 
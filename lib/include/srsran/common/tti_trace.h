@@ -0,0 +1,109 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_TTI_TRACE_H
+#define SRSRAN_TTI_TRACE_H
+
+#include "srsran/common/tsc_clock.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace srsran {
+
+/// Events recorded by the TTI tracer. The names and argument names written to the trace are listed in tti_trace.cc
+enum class tti_trace_event : uint16_t {
+  txrx_run,
+  sf_worker_work,
+  cc_worker_ul,
+  cc_worker_dl_data,
+  cc_worker_dl_ctrl,
+  mac_get_dl_sched,
+  mac_get_ul_sched,
+  radio_rx,
+  radio_tx,
+  nof_events
+};
+
+const char* to_string(tti_trace_event event);
+
+/// Binary record of one traced interval
+struct tti_trace_record {
+  int64_t         start_ns;
+  uint32_t        duration_ns;
+  uint32_t        arg;
+  tti_trace_event event;
+};
+
+namespace detail {
+
+extern std::atomic<bool> tti_trace_enabled;
+
+void tti_trace_push(tti_trace_event event, uint32_t arg, tsc_clock::time_point start, tsc_clock::time_point end);
+
+} // namespace detail
+
+/**
+ * Starts the tracer. Each thread records its events in its own buffer of nof_records_per_thread records, created at
+ * the first event of the thread. The buffers work as flight recorders: once full, the oldest records are overwritten.
+ */
+void tti_trace_init(size_t nof_records_per_thread);
+
+/// Stops recording the events. The recorded events are kept until the next call to tti_trace_init()
+void tti_trace_stop();
+
+/**
+ * Writes the recorded events in the Chrome trace event JSON format, which is loaded by Perfetto and chrome://tracing.
+ * The traced threads must not record events during the export, so the tracer is stopped first.
+ * Returns false if the file could not be written.
+ */
+bool tti_trace_write_chrome_json(const std::string& filename);
+
+/// Traces the interval between the construction and the destruction of the object, while the tracer is enabled
+class tti_trace_scope
+{
+public:
+  tti_trace_scope(tti_trace_event event_, uint32_t arg_) : event(event_), arg(arg_)
+  {
+    if (detail::tti_trace_enabled.load(std::memory_order_relaxed)) {
+      active = true;
+      start  = tsc_clock::now();
+    }
+  }
+  tti_trace_scope(const tti_trace_scope&) = delete;
+  tti_trace_scope& operator=(const tti_trace_scope&) = delete;
+  ~tti_trace_scope()
+  {
+    if (active) {
+      detail::tti_trace_push(event, arg, start, tsc_clock::now());
+    }
+  }
+
+private:
+  tti_trace_event       event;
+  uint32_t              arg;
+  bool                  active = false;
+  tsc_clock::time_point start;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_TTI_TRACE_H
@@ -34,6 +34,7 @@ struct gtpu_args_t {
   std::string embms_m1u_if_addr;
   bool        embms_enable                 = false;
   uint32_t    indirect_tunnel_timeout_msec = 0;
+  uint32_t    nof_rx_sockets               = 1; ///< Number of S1U sockets sharing the GTPU port with SO_REUSEPORT
 };
 
 // GTPU interface for PDCP
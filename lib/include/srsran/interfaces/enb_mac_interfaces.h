@@ -33,8 +33,11 @@ struct mac_args_t {
   sched_interface::sched_args_t sched;
   int                           lcid_padding;
   uint32_t                      nof_prealloc_ues; ///< Number of UE resources to pre-allocate at eNB startup
+  uint32_t                      max_nof_ues;      ///< Maximum number of connected UEs, 0 for the size of the UE tables
   uint32_t                      max_nof_kos;
   int                           rlf_min_ul_snr_estim;
+  bool                          sched_thread; ///< Schedule in a dedicated thread started once the UL feedback is complete
+  std::string                   sched_record_filename; ///< Records the scheduler inputs to this file, if not empty
 };
 
 /* Interface PHY -> MAC */
@@ -50,6 +53,10 @@ public:
     srsran_dci_dl_t         dci                          = {};
     uint8_t*                data[SRSRAN_MAX_TB]          = {};
     srsran_softbuffer_tx_t* softbuffer_tx[SRSRAN_MAX_TB] = {};
+    uint16_t                sps_crnti                    = SRSRAN_INVALID_RNTI; ///< Set for the SPS grants
+    bool                    needs_pdcch                  = true;  ///< false for the DL SPS occasions
+    bool                    has_pdsch                    = true;  ///< false for the DL SPS releases
+    int                     n1_pucch_an                  = -1;    ///< Persistent ACK resource of the DL SPS occasions
   };
 
   /**
@@ -80,6 +87,7 @@ public:
     uint32_t                current_tx_nb;
     uint8_t*                data;
     bool                    needs_pdcch;
+    uint16_t                sps_crnti; ///< SPS C-RNTI of the UL SPS grants, SRSRAN_INVALID_RNTI otherwise
     srsran_softbuffer_rx_t* softbuffer_rx;
   } ul_sched_grant_t;
 
@@ -215,6 +223,13 @@ public:
                        bool     crc_res,
                        uint32_t ul_nof_prbs) = 0;
 
+  /**
+   * Indicates that the UL feedback of the TTI preceding tti_tx_dl by TX_ENB_DELAY has been delivered. The MAC can start
+   * computing the scheduling of tti_tx_dl while the PHY prepares the subframe, get_dl_sched() picks up the result.
+   * @param tti_tx_dl the DL transmission TTI that get_dl_sched() will be called for
+   */
+  virtual void start_dl_sched(uint32_t tti_tx_dl) {}
+
   virtual int  get_dl_sched(uint32_t tti, dl_sched_list_t& dl_sched_res)                = 0;
   virtual int  get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res) = 0;
   virtual int  get_ul_sched(uint32_t tti, ul_sched_list_t& ul_sched_res)                = 0;
@@ -251,6 +266,15 @@ public:
   virtual int  bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, mac_lc_ch_cfg_t* cfg) = 0;
   virtual int  bearer_ue_rem(uint16_t rnti, uint32_t lc_id)                       = 0;
   virtual void phy_config_enabled(uint16_t rnti, bool enabled)                    = 0;
+
+  /**
+   * Admission feedback for a new GBR bearer, based on the GBR load of the UE PCell
+   * @param gbr_dl requested DL guaranteed bit rate in kB/s
+   * @param gbr_ul requested UL guaranteed bit rate in kB/s
+   * @return true if the cell can carry the bearer on top of the GBR bearers already configured
+   */
+  virtual bool admit_gbr_bearer(uint16_t rnti, uint32_t gbr_dl, uint32_t gbr_ul) = 0;
+
   virtual void write_mcch(const srsran::sib2_mbms_t* sib2_,
                           const srsran::sib13_t*     sib13_,
                           const srsran::mcch_msg_t*  mcch_,
@@ -262,6 +286,13 @@ public:
    * @return value of the allocated C-RNTI
    */
   virtual uint16_t reserve_new_crnti(const sched_interface::ue_cfg_t& ue_cfg) = 0;
+
+  /**
+   * Allocate a SPS C-RNTI for a user. The SPS C-RNTIs are allocated above the C-RNTI range, and are released with the
+   * user
+   * @return value of the SPS C-RNTI of the user, SRSRAN_INVALID_RNTI if there is none left
+   */
+  virtual uint16_t reserve_sps_crnti(uint16_t rnti) = 0;
 };
 
 // Combined interface for PHY to access stack (MAC and RRC)
@@ -22,11 +22,19 @@
 #ifndef SRSRAN_ENB_RLC_INTERFACES_H
 #define SRSRAN_ENB_RLC_INTERFACES_H
 
+#include "srsran/adt/span.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 
 namespace srsenb {
 
+/// RLC PDU carried by a received MAC PDU
+struct rlc_rx_pdu_t {
+  uint32_t lcid;
+  uint8_t* payload;
+  uint32_t nof_bytes;
+};
+
 // RLC interface for MAC
 class rlc_interface_mac
 {
@@ -38,6 +46,10 @@ public:
   /* MAC calls RLC to push an RLC PDU. This function is called from an independent MAC thread.
    * PDU gets placed into the buffer and higher layer thread gets notified. */
   virtual void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) = 0;
+
+  /* MAC calls RLC to push all the RLC PDUs of a MAC PDU in a single call. The PDUs are read in place from the
+   * MAC PDU buffer. */
+  virtual void write_pdus(uint16_t rnti, srsran::span<const rlc_rx_pdu_t> pdus) = 0;
 };
 
 // RLC interface for PDCP
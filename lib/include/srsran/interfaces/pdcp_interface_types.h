@@ -126,6 +126,21 @@ enum class pdcp_discard_timer_t {
   infinity = -1
 };
 
+// ROHC config, taken from the headerCompression field of PDCP-Config (TS 36.331 version 15.2.2)
+struct pdcp_rohc_config_t {
+  bool     enabled     = false;
+  uint16_t max_cid     = 15;
+  bool     profile_rtp = false; // Profile 0x0001, RTP/UDP/IP
+  bool     profile_udp = false; // Profile 0x0002, UDP/IP
+
+  bool operator==(const pdcp_rohc_config_t& other) const
+  {
+    return enabled == other.enabled and max_cid == other.max_cid and profile_rtp == other.profile_rtp and
+           profile_udp == other.profile_udp;
+  }
+  bool operator!=(const pdcp_rohc_config_t& other) const { return not(*this == other); }
+};
+
 class pdcp_config_t
 {
 public:
@@ -164,15 +179,14 @@ public:
 
   bool status_report_required = false;
 
-  // TODO: Support the following configurations
-  // bool do_rohc;
+  pdcp_rohc_config_t rohc = {};
 
   bool operator==(const pdcp_config_t& other) const
   {
     return bearer_id == other.bearer_id and rb_type == other.rb_type and tx_direction == other.tx_direction and
            rx_direction == other.rx_direction and sn_len == other.sn_len and hdr_len_bytes == other.hdr_len_bytes and
            t_reordering == other.t_reordering and discard_timer == other.discard_timer and rat == other.rat and
-           status_report_required == other.status_report_required;
+           status_report_required == other.status_report_required and rohc == other.rohc;
   }
   bool operator!=(const pdcp_config_t& other) const { return not(*this == other); }
 
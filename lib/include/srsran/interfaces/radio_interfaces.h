@@ -58,6 +58,7 @@ public:
   virtual uint32_t size()                                                                                         = 0;
   virtual void     set_nof_samples(uint32_t n)                                                                    = 0;
   virtual uint32_t get_nof_samples() const                                                                        = 0;
+  virtual bool     is_sc16() const                                                                                = 0;
 };
 
 /**
@@ -23,6 +23,7 @@
 #define SRSRAN_RLC_INTERFACE_TYPES_H
 
 #include "srsran/interfaces/rrc_interface_types.h"
+#include "srsran/upper/codel.h"
 
 /***************************
  *      RLC Config
@@ -172,9 +173,17 @@ public:
   rlc_um_config_t    um;
   rlc_um_nr_config_t um_nr;
   uint32_t           tx_queue_length;
+  codel_config_t     tx_aqm; // CoDel on the Tx SDU queue, disabled by default
 
   rlc_config_t() :
-    rat(srsran_rat_t::lte), rlc_mode(rlc_mode_t::tm), am(), am_nr(), um(), um_nr(), tx_queue_length(RLC_TX_QUEUE_LEN){};
+    rat(srsran_rat_t::lte),
+    rlc_mode(rlc_mode_t::tm),
+    am(),
+    am_nr(),
+    um(),
+    um_nr(),
+    tx_queue_length(RLC_TX_QUEUE_LEN),
+    tx_aqm(){};
 
   // Factory for MCH
   static rlc_config_t mch_config()
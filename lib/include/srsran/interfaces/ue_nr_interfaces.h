@@ -28,6 +28,7 @@
 #include <array>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace srsue {
 
@@ -218,6 +219,9 @@ struct phy_args_nr_t {
   double                 srate_hz              = 23.04e6;
   uint32_t               nof_phy_threads       = 3;
   uint32_t               worker_cpu_mask       = 0;
+  bool                   worker_autoscale      = false; ///< Parks the PHY threads the measured load does not need
+  uint32_t               worker_min_threads    = 1;     ///< Minimum number of active PHY threads when autoscaling
+  float                  worker_target_load    = 0.7f;  ///< Target busy fraction of each active PHY thread
   int                    slot_recv_thread_prio = 0; /// Specifies the slot receive thread priority, RT by default
   int                    workers_thread_prio   = 2; /// Specifies the workers thread priority, RT by default
   srsran::phy_log_args_t log                   = {};
@@ -226,6 +230,7 @@ struct phy_args_nr_t {
   std::set<uint32_t>     fixed_sr              = {1};
   uint32_t               fix_wideband_cqi      = 15; ///< Set to a non-zero value for fixing the wide-band CQI report
   bool                   store_pdsch_ko        = false;
+  uint32_t               max_nof_ssb_search    = 1; ///< Maximum SSB frequencies searched within the same capture
   float                  trs_epre_ema_alpha    = 0.1f; ///< EPRE measurement exponential average alpha
   float                  trs_rsrp_ema_alpha    = 0.1f; ///< RSRP measurement exponential average alpha
   float                  trs_sinr_ema_alpha    = 0.1f; ///< SINR measurement exponential average alpha
@@ -318,6 +323,7 @@ public:
   struct cell_search_args_t {
     double                      center_freq_hz;
     double                      ssb_freq_hz;
+    std::vector<double>         ssb_freq_hz_list; ///< Other SSB frequencies searched within the same capture
     srsran_subcarrier_spacing_t ssb_scs;
     srsran_ssb_pattern_t        ssb_pattern;
     srsran_duplex_mode_t        duplex_mode;
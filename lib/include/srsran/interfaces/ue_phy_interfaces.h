@@ -59,11 +59,15 @@ struct phy_args_t {
   float dl_freq = -1.0f;
   float ul_freq = -1.0f;
 
-  bool     ul_pwr_ctrl_en  = false;
-  float    prach_gain      = -1;
-  uint32_t pdsch_max_its   = 8;
-  bool     meas_evm        = false;
-  uint32_t nof_phy_threads = 3;
+  bool     ul_pwr_ctrl_en        = false;
+  float    prach_gain            = -1;
+  uint32_t pdsch_max_its         = 8;
+  bool     meas_evm              = false;
+  uint32_t nof_phy_threads       = 3;
+  uint32_t pdsch_decoder_threads = 0; // PDSCH helper threads per PHY thread, 0 decodes in the worker
+  bool     worker_autoscale      = false; // Parks the PHY threads that the measured load does not need
+  uint32_t worker_min_threads    = 1;     // Minimum number of active PHY threads when autoscaling
+  float    worker_target_load    = 0.7f;  // Target busy fraction of each active PHY thread when autoscaling
 
   int worker_cpu_mask   = -1;
   int sync_cpu_affinity = -1;
@@ -95,6 +99,8 @@ struct phy_args_t {
   bool        estimator_fil_auto           = false;
   float       estimator_fil_stddev         = 1.0f;
   uint32_t    estimator_fil_order          = 4;
+  uint32_t    chest_meas_period            = 0;
+  float       chest_meas_ema_coeff         = 0.1f;
   float       snr_to_cqi_offset            = 0.0f;
   std::string sss_algorithm                = "full";
   float       rx_gain_offset               = 62;
@@ -105,7 +111,9 @@ struct phy_args_t {
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
 
-  bool nr_store_pdsch_ko = false;
+  bool     nr_store_pdsch_ko           = false;
+  uint32_t nr_cell_search_max_nof_ssb = 1;
+  uint32_t nr_pdcch_polar_list_size   = 0;
 
   float    in_sync_rsrp_dbm_th    = -130.0f;
   float    in_sync_snr_db_th      = 1.0f;
@@ -33,6 +33,7 @@
 namespace srsran {
 
 class mac_sch_pdu_nr;
+class read_pdu_interface;
 
 class mac_sch_subpdu_nr
 {
@@ -110,7 +111,7 @@ public:
   uint64_t                                       get_ue_con_res_id_ce_packed();
 
   // setters
-  void set_sdu(const uint32_t lcid_, const uint8_t* payload_, const uint32_t len_);
+  void set_sdu(const uint32_t lcid_, const uint8_t* payload_, const uint32_t len_, bool long_len_field = false);
   void set_padding(const uint32_t len_);
   void set_c_rnti(const uint16_t crnti_);
   void set_se_phr(const uint8_t phr_, const uint8_t pcmax_);
@@ -215,6 +216,9 @@ public:
   // Add SDU or CEs to PDU
   // All functions will return SRSRAN_SUCCESS on success, and SRSRAN_ERROR otherwise
   uint32_t add_sdu(const uint32_t lcid_, const uint8_t* payload_, const uint32_t len_);
+  /// Reads an SDU of up to max_sdu_len bytes from sdu_itf straight into the PDU buffer, after its subheader.
+  /// Returns the SDU length, 0 if sdu_itf has nothing to transmit, or SRSRAN_ERROR if the SDU does not fit
+  int add_sdu(const uint32_t lcid_, const uint32_t max_sdu_len, read_pdu_interface* sdu_itf);
   uint32_t add_crnti_ce(const uint16_t crnti_);
   uint32_t add_se_phr_ce(const uint8_t phr_, const uint8_t pcmax_);
   uint32_t add_sbsr_ce(const mac_sch_subpdu_nr::lcg_bsr_t bsr_);
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_PDU_H
 #define SRSRAN_PDU_H
 
+#include "srsran/adt/bounded_vector.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/srslog/srslog.h"
 #include <sstream>
@@ -332,6 +333,7 @@ public:
 
   bool read_subheader(uint8_t** ptr);
   void read_payload(uint8_t** ptr);
+  void init_rx_ce(uint32_t lcid_, uint8_t* payload_, uint32_t nof_bytes_);
 
   uint32_t get_sdu_lcid();
   uint32_t get_payload_size();
@@ -406,6 +408,35 @@ public:
   void            to_string(fmt::memory_buffer& buffer);
 };
 
+/// Location of a subPDU inside a received UL-SCH MAC PDU
+struct ul_sch_subpdu_t {
+  uint32_t lcid;
+  uint32_t offset; ///< Offset of the payload from the start of the MAC PDU
+  uint32_t nof_bytes;
+};
+
+/**
+ * Fast-path parser of UL-SCH MAC PDUs. It decodes the subheaders in a single pass over the header octets, without the
+ * sch_subh objects of sch_pdu, and stores the location of the SDUs and of the MAC CEs of the PDU. The padding
+ * subPDUs are skipped
+ */
+class ul_sch_pdu_parser
+{
+public:
+  static const uint32_t MAX_SUBPDUS = 20;
+  using subpdu_list_t               = bounded_vector<ul_sch_subpdu_t, MAX_SUBPDUS>;
+
+  /// @return SRSRAN_ERROR if the PDU is corrupted, in which case neither SDUs nor CEs are stored
+  int parse(const uint8_t* ptr, uint32_t pdu_len);
+
+  const subpdu_list_t& sdus() const { return sdu_list; }
+  const subpdu_list_t& ces() const { return ce_list; }
+
+private:
+  subpdu_list_t sdu_list;
+  subpdu_list_t ce_list;
+};
+
 class rar_subh : public subh<rar_subh>
 {
 public:
@@ -22,16 +22,20 @@
 #ifndef SRSRAN_PDU_QUEUE_H
 #define SRSRAN_PDU_QUEUE_H
 
-#include "srsran/adt/circular_buffer.h"
-#include "srsran/common/block_queue.h"
-#include "srsran/common/buffer_pool.h"
-#include "srsran/common/timers.h"
 #include "srsran/mac/pdu.h"
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <memory>
 
 /* Logical Channel Demultiplexing and MAC CE dissassemble */
 
 namespace srsran {
 
+/**
+ * Hands the PDU buffers decoded by the PHY workers over to the stack thread. Any thread may request, push and
+ * deallocate buffers, and one thread processes the pushed PDUs. The free buffers and the pushed PDUs are kept in
+ * lock-free rings, so that the PHY workers never wait on the stack thread.
+ */
 class pdu_queue
 {
 public:
@@ -42,15 +46,17 @@ public:
     virtual void process_pdu(uint8_t* buff, uint32_t len, channel_t channel, int ul_nof_prbs = -1) = 0;
   };
 
-  pdu_queue(srslog::basic_logger& logger) : pool(DEFAULT_POOL_SIZE), callback(NULL), logger(logger) {}
+  pdu_queue(srslog::basic_logger& logger);
   void init(process_callback* callback);
 
   uint8_t* request(uint32_t len);
   void     deallocate(const uint8_t* pdu);
   void     push(const uint8_t* ptr, uint32_t len, channel_t channel = DCH, int ul_nof_prbs = -1);
 
+  /// Processes all the PDUs pushed so far, in push order. Only one thread may call it
   bool process_pdus();
 
+  /// Drops the pushed PDUs that were not processed yet
   void reset();
 
 private:
@@ -62,16 +68,33 @@ private:
     uint32_t  len;
     channel_t channel;
     int       grant_nof_prbs;
-#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
-    char debug_name[128];
-#endif
-
   } pdu_t;
 
-  buffer_pool<pdu_t>                               pool;
-  static_blocking_queue<pdu_t*, DEFAULT_POOL_SIZE> pdu_q;
+  /// Bounded MPMC ring of PDU buffers, with the sequence numbers of D. Vyukov's bounded queue
+  class pdu_ring
+  {
+  public:
+    pdu_ring();
+    bool try_push(pdu_t* pdu);
+    bool try_pop(pdu_t*& pdu);
+
+  private:
+    struct cell_t {
+      std::atomic<size_t> seq;
+      pdu_t*              pdu;
+    };
+    std::unique_ptr<cell_t[]> cells;
+    std::atomic<size_t>       enqueue_pos{0};
+    std::atomic<size_t>       dequeue_pos{0};
+  };
+
+  pdu_t* to_pdu(const uint8_t* ptr);
+
+  std::unique_ptr<pdu_t[]> pool;
+  pdu_ring                 free_pdus;
+  pdu_ring                 pdu_q;
 
-  process_callback*     callback;
+  process_callback*     callback = nullptr;
   srslog::basic_logger& logger;
 };
 
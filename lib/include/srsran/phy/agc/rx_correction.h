@@ -0,0 +1,106 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+/**********************************************************************************************
+ *  File:         rx_correction.h
+ *
+ *  Description:  Receiver front-end impairment correction
+ *                Removes the DC offset, compensates the IQ gain and phase imbalance and applies
+ *                a fast digital gain control to the received baseband samples. The DC and the
+ *                imbalance are estimated blindly from the first and second order moments of the
+ *                signal, averaged over the calls. The three corrections are applied with a single
+ *                widely linear transform, out = a * in + b * conj(in) + c, in one pass.
+ *
+ *  Reference:
+ *********************************************************************************************/
+
+#ifndef SRSRAN_RX_CORRECTION_H
+#define SRSRAN_RX_CORRECTION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "srsran/config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SRSRAN_RX_CORRECTION_DEFAULT_ALPHA (0.05f)        /* Moments averaging coefficient, per call */
+#define SRSRAN_RX_CORRECTION_DEFAULT_AGC_TARGET (0.1f)    /* Output RMS target */
+#define SRSRAN_RX_CORRECTION_DEFAULT_AGC_ALPHA (0.3f)     /* Digital gain averaging coefficient, per call */
+#define SRSRAN_RX_CORRECTION_DEFAULT_AGC_MAX_GAIN (40.0f) /* Maximum digital gain magnitude in dB */
+
+typedef struct SRSRAN_API {
+  bool  dc_enable;       ///< Removes the DC offset
+  bool  iq_enable;       ///< Compensates the IQ gain and phase imbalance
+  bool  agc_enable;      ///< Scales the output to the AGC target
+  float alpha;           ///< DC and imbalance estimates averaging coefficient, per call
+  float agc_target;      ///< Output RMS target
+  float agc_alpha;       ///< Digital gain averaging coefficient, per call
+  float agc_max_gain_db; ///< The digital gain is limited to +/- this value
+} srsran_rx_correction_cfg_t;
+
+typedef struct SRSRAN_API {
+  srsran_rx_correction_cfg_t cfg;
+  bool                       isfirst;
+  cf_t                       mean;    ///< Average of in
+  float                      pwr;     ///< Average of |in|^2
+  cf_t                       sqr;     ///< Average of in^2, it carries the IQ imbalance
+  float                      gain_db; ///< Current digital gain
+} srsran_rx_correction_t;
+
+/**
+ * @brief Initialises the correction with the default parameters if cfg is NULL
+ * @param q Object pointer
+ * @param cfg Configuration, the fields not set (zero) take the default values
+ * @return SRSRAN_SUCCESS if no error, SRSRAN_ERROR_INVALID_INPUTS otherwise
+ */
+SRSRAN_API int srsran_rx_correction_init(srsran_rx_correction_t* q, const srsran_rx_correction_cfg_t* cfg);
+
+/**
+ * @brief Drops the estimates, e.g. after retuning or changing the analog gain
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_rx_correction_reset(srsran_rx_correction_t* q);
+
+/**
+ * @brief Updates the estimates with a block of samples and corrects it. The operation can be in-place
+ * @param q Object pointer
+ * @param in Received samples
+ * @param out Corrected samples
+ * @param nsamples Number of samples
+ */
+SRSRAN_API void srsran_rx_correction_run(srsran_rx_correction_t* q, const cf_t* in, cf_t* out, uint32_t nsamples);
+
+/**
+ * @brief Gets the current digital gain
+ * @param q Object pointer
+ * @return The gain in dB, 0 if the AGC is disabled
+ */
+SRSRAN_API float srsran_rx_correction_get_gain_db(const srsran_rx_correction_t* q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_RX_CORRECTION_H
@@ -27,6 +27,7 @@
 #include "srsran/phy/dft/dft.h"
 
 #define CFR_EMA_INIT_AVG_PWR 0.1
+#define CFR_PC_DEFAULT_NOF_ITER 2
 
 /**
  * @brief CFR manual threshold or PAPR limiting with CMA or EMA power averaging
@@ -39,6 +40,15 @@ typedef enum SRSRAN_API {
   SRSRAN_CFR_NOF_MODES
 } srsran_cfr_mode_t;
 
+/**
+ * @brief CFR peak reduction algorithm
+ */
+typedef enum SRSRAN_API {
+  SRSRAN_CFR_ALGO_CLIP_FILTER = 0, ///< Clips the symbol and removes the out of band regrowth with an FFT filter
+  SRSRAN_CFR_ALGO_PEAK_CANCEL,     ///< Subtracts a precomputed in-band pulse at every peak above the threshold
+  SRSRAN_CFR_ALGO_INVALID
+} srsran_cfr_algo_t;
+
 /**
  * @brief CFR module configuration arguments
  */
@@ -51,6 +61,11 @@ typedef struct SRSRAN_API {
   float    alpha;     ///< Alpha parameter of the clipping algorithm
   bool     dc_sc;     ///< Take into account the DC subcarrier for the filter BW
 
+  // SRSRAN_CFR_ALGO_PEAK_CANCEL parameters
+  srsran_cfr_algo_t algo;         ///< Peak reduction algorithm
+  uint32_t          pc_pulse_len; ///< Half length of the windowed cancellation pulse, 0 uses the whole symbol
+  uint32_t          pc_nof_iter;  ///< Number of detection and cancellation passes, CFR_PC_DEFAULT_NOF_ITER if 0
+
   // SRSRAN_CFR_THR_MANUAL mode parameters
   float manual_thr; ///< Fixed threshold used in SRSRAN_CFR_THR_MANUAL mode
 
@@ -73,6 +88,13 @@ typedef struct SRSRAN_API {
   float* abs_buffer_out; ///< Store the output absolute value
   cf_t*  peak_buffer;
 
+  // Peak cancellation buffers, used with SRSRAN_CFR_ALGO_PEAK_CANCEL
+  cf_t*     pc_pulse;        ///< Cancellation pulse of pc_pulse_sz samples, its peak is at pc_pulse_offset
+  uint32_t  pc_pulse_sz;     ///< Cancellation pulse length
+  uint32_t  pc_pulse_offset; ///< Position of the pulse peak
+  uint32_t* peak_idx;        ///< Position of every detected peak
+  cf_t*     peak_coeff;      ///< Cancellation weight of every detected peak
+
   float pwr_avg_in;  ///< store the avg. input power with MA or EMA averaging
   float pwr_avg_out; ///< store the avg. output power with MA or EMA averaging
 
@@ -136,4 +158,14 @@ SRSRAN_API int srsran_cfr_set_papr(srsran_cfr_t* q, float papr);
  */
 SRSRAN_API srsran_cfr_mode_t srsran_cfr_str2mode(const char* mode_str);
 
+/**
+ * @brief Converts a string representing a CFR algorithm from the config files into srsran_cfr_algo_t type
+ *
+ * @param[in]  algo_str   the cfr.algo string coming from the config file
+ * @return SRSRAN_CFR_ALGO_CLIP_FILTER if algo_str is empty,
+ * SRSRAN_CFR_ALGO_INVALID if algo_str is not recognised,
+ * otherwise it returns the corresponding srsran_cfr_algo_t value.
+ */
+SRSRAN_API srsran_cfr_algo_t srsran_cfr_str2algo(const char* algo_str);
+
 #endif // SRSRAN_CFR_H
@@ -112,6 +112,8 @@ typedef struct SRSRAN_API {
   float noise_estimate[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
   float sync_err[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
   float cfo;
+  bool     meas_init;  ///< The averaged measurements hold a value, cleared when the cell changes
+  uint32_t meas_count; ///< Number of lightweight measurements, it rotates the measured pilot symbol
 
   /* Use PSS for noise estimation in LS linear interpolation mode */
   cf_t pss_signal[SRSRAN_PSS_LEN];
@@ -133,6 +135,13 @@ typedef struct SRSRAN_API {
   uint32_t cfo_estimate_sf_mask;
   bool     sync_error_enable;
 
+  /* Lightweight measurements: RSRP, RSSI and noise are measured every meas_period subframes, RSSI and noise on one
+   * pilot symbol, and averaged. meas_full forces a measurement on all the symbols (e.g. a CQI is reported). 0 disables
+   * them */
+  uint32_t meas_period;
+  float    meas_ema_coeff;
+  bool     meas_full;
+
 } srsran_chest_dl_cfg_t;
 
 SRSRAN_API int srsran_chest_dl_init(srsran_chest_dl_t* q, uint32_t max_prb, uint32_t nof_rx_antennas);
@@ -78,6 +78,10 @@ typedef struct SRSRAN_API {
 
   srsran_interp_linsrsran_vec_t lin_vec_sl;
 
+  // PSSCH DMRS are only generated again when the configuration they depend on changes
+  bool                  pssch_dmrs_valid;
+  srsran_chest_sl_cfg_t pssch_dmrs_cfg;
+
   bool  sync_error_enable;
   bool  rsrp_enable;
   float sync_err;
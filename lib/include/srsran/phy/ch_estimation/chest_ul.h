@@ -45,6 +45,13 @@
 #include "srsran/phy/phch/pusch_cfg.h"
 #include "srsran/phy/resampling/interp.h"
 
+// Frequency Wiener filter of the PUSCH estimates, the filter spans 2 * HALF_LEN + 1 sub-carriers so that it fits 1 PRB
+#define SRSRAN_CHEST_UL_WIENER_HALF_LEN 5
+#define SRSRAN_CHEST_UL_WIENER_LEN (2 * SRSRAN_CHEST_UL_WIENER_HALF_LEN + 1)
+#define SRSRAN_CHEST_UL_WIENER_SNR_MIN_DB (-10)
+#define SRSRAN_CHEST_UL_WIENER_SNR_STEP_DB (2)
+#define SRSRAN_CHEST_UL_WIENER_NOF_SNR_BINS (21)
+
 typedef struct SRSRAN_API {
   cf_t*    ce;
   uint32_t nof_re;
@@ -71,7 +78,6 @@ typedef struct {
   bool                          srs_signal_configured;
 
   cf_t* pilot_estimates;
-  cf_t* pilot_estimates_tmp[4];
   cf_t* pilot_recv_signal;
   cf_t* pilot_known_signal;
   cf_t* tmp_noise;
@@ -85,6 +91,11 @@ typedef struct {
 
   srsran_interp_linsrsran_vec_t srsran_interp_linvec;
 
+  // Wiener filters for each SNR bin, computed in set_cell. Row p < HALF_LEN filters the sub-carrier at distance p from
+  // the allocation edge, row HALF_LEN the inner sub-carriers
+  float wiener_filter[SRSRAN_CHEST_UL_WIENER_NOF_SNR_BINS][SRSRAN_CHEST_UL_WIENER_HALF_LEN + 1]
+                     [SRSRAN_CHEST_UL_WIENER_LEN];
+
 } srsran_chest_ul_t;
 
 SRSRAN_API int srsran_chest_ul_init(srsran_chest_ul_t* q, uint32_t max_prb);
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**********************************************************************************************
+ *  File:         chest_ul_srs_batch.h
+ *
+ *  Description:  Measurement of the SRS of all the UEs that sound in a subframe.
+ *                The UEs that share comb, bandwidth and frequency position are extracted and
+ *                de-modulated once, then separated by their cyclic shift with a joint least
+ *                squares fit every 8 comb subcarriers. The fit residual gives the noise estimate
+ *                of the group.
+ *
+ *  Reference:    3GPP TS 36.211 version 10.0.0 Release 10 Sec. 5.5.3
+ *********************************************************************************************/
+
+#ifndef SRSRAN_CHEST_UL_SRS_BATCH_H
+#define SRSRAN_CHEST_UL_SRS_BATCH_H
+
+#include "srsran/config.h"
+#include "srsran/phy/ch_estimation/refsignal_ul.h"
+#include "srsran/phy/common/phy_common.h"
+
+#define SRSRAN_SRS_NOF_CSHIFT 8
+
+typedef struct SRSRAN_API {
+  float snr_db;
+  float ta_us;
+} srsran_chest_ul_srs_meas_t;
+
+typedef struct SRSRAN_API {
+  srsran_cell_t         cell;
+  srsran_refsignal_ul_t signal;
+  uint32_t              max_ues;
+  uint32_t              max_M_sc;
+
+  uint32_t* k0;    // First subcarrier of the SRS of each UE
+  uint32_t* M_sc;  // Number of SRS subcarriers of each UE
+  bool*     done;  // The UE has already been measured with its group
+  cf_t*     recv;  // Received comb of the group
+  cf_t*     base;  // Base sequence of the group, without cyclic shift
+  cf_t*     y;     // Received comb de-modulated by the base sequence
+  cf_t*     z;     // De-modulated comb after removing a cyclic shift
+  cf_t*     ramp[SRSRAN_SRS_NOF_CSHIFT];
+  cf_t*     H[SRSRAN_SRS_NOF_CSHIFT]; // Channel of each cyclic shift, one sample every 8 comb subcarriers
+} srsran_chest_ul_srs_batch_t;
+
+SRSRAN_API int srsran_chest_ul_srs_batch_init(srsran_chest_ul_srs_batch_t* q, uint32_t max_ues);
+
+SRSRAN_API void srsran_chest_ul_srs_batch_free(srsran_chest_ul_srs_batch_t* q);
+
+SRSRAN_API int srsran_chest_ul_srs_batch_set_cell(srsran_chest_ul_srs_batch_t* q, srsran_cell_t cell);
+
+/* Measures the SNR and time alignment of the nof_ues SRS configurations in cfg, which must all be transmitted in the
+ * subframe sf. The results are written in meas, in the same order as cfg. Returns SRSRAN_SUCCESS or an error code. */
+SRSRAN_API int srsran_chest_ul_srs_batch_estimate(srsran_chest_ul_srs_batch_t*       q,
+                                                  srsran_ul_sf_cfg_t*                sf,
+                                                  srsran_refsignal_srs_cfg_t*        cfg,
+                                                  uint32_t                           nof_ues,
+                                                  srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
+                                                  cf_t*                              input,
+                                                  srsran_chest_ul_srs_meas_t*        meas);
+
+#endif // SRSRAN_CHEST_UL_SRS_BATCH_H
@@ -60,6 +60,11 @@ typedef struct {
 
   float* filter; ///< Smoothing filter
 
+  uint32_t sequence_nof_slots; ///< Number of slots per frame in the sequence table
+  uint32_t sequence_len;       ///< Number of pilots per symbol in the sequence table, the carrier type 1 pilots
+  cf_t*    sequence[2];        ///< Sequences of the carrier PCI for each n_SCID, indexed by slot, symbol and pilot
+  cf_t*    sequence_temp;      ///< Sequence of a single symbol, for scrambling identities other than the carrier PCI
+
   srsran_csi_trs_measurements_t csi; ///< Last estimated channel state information
 } srsran_dmrs_sch_t;
 
@@ -44,11 +44,17 @@
 #define SRSRAN_REFSIGNAL_PILOT_IDX_MBSFN(i, l, cell) ((6 * cell.nof_prb * (l) + (i)))
 
 /** Cell-Specific Reference Signal */
+/* Copies the 2 * nof_prb pilots of one OFDM symbol, starting at the frequency index fidx, to or from the RE */
+typedef void (*srsran_refsignal_cs_put_l_t)(const cf_t* pilots, cf_t* symbol, uint32_t fidx, uint32_t nof_prb);
+typedef void (*srsran_refsignal_cs_get_l_t)(const cf_t* symbol, cf_t* pilots, uint32_t fidx, uint32_t nof_prb);
+
 typedef struct SRSRAN_API {
-  srsran_cell_t cell;
-  cf_t*         pilots[2][SRSRAN_NOF_SF_X_FRAME]; // Saves the reference signal per subframe for ports 0,1 and ports 2,3
-  srsran_sf_t   type;
-  uint16_t      mbsfn_area_id;
+  srsran_cell_t               cell;
+  cf_t* pilots[2][SRSRAN_NOF_SF_X_FRAME]; // Saves the reference signal per subframe for ports 0,1 and ports 2,3
+  srsran_sf_t                 type;
+  uint16_t                    mbsfn_area_id;
+  srsran_refsignal_cs_put_l_t put_l; // Selected in srsran_refsignal_cs_set_cell() for the cell bandwidth
+  srsran_refsignal_cs_get_l_t get_l;
 } srsran_refsignal_t;
 
 SRSRAN_API int srsran_refsignal_cs_init(srsran_refsignal_t* q, uint32_t max_prb);
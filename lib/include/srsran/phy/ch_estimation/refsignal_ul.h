@@ -190,4 +190,7 @@ SRSRAN_API uint32_t srsran_refsignal_srs_rb_L_cs(uint32_t bw_cfg, uint32_t nof_p
 
 SRSRAN_API uint32_t srsran_refsignal_srs_M_sc(srsran_refsignal_ul_t* q, srsran_refsignal_srs_cfg_t* cfg);
 
+/* Returns the first subcarrier of the SRS of a UE in the given TTI, including the transmission comb */
+SRSRAN_API uint32_t srsran_refsignal_srs_k0(srsran_refsignal_ul_t* q, srsran_refsignal_srs_cfg_t* cfg, uint32_t tti);
+
 #endif // SRSRAN_REFSIGNAL_UL_H
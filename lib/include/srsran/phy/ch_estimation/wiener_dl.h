@@ -90,6 +90,7 @@ typedef struct {
     cf_t m[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_REF];
     cf_t v[SRSRAN_WIENER_DL_MIN_REF * SRSRAN_WIENER_DL_MIN_REF];
   } invRH;
+  cf_t invRH_t[SRSRAN_WIENER_DL_MIN_REF][SRSRAN_WIENER_DL_MIN_REF]; // Transposed inverse, for row-wise dot products
   cf_t hH1[SRSRAN_WIENER_DL_MIN_RE][SRSRAN_WIENER_DL_MIN_REF];
   cf_t hH2[SRSRAN_WIENER_DL_MIN_RE][SRSRAN_WIENER_DL_MIN_REF];
 
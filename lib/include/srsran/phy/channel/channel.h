@@ -29,8 +29,12 @@
 #include "rlf.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace srsran {
 
@@ -39,7 +43,8 @@ class channel
 public:
   struct args_t {
     // General
-    bool enable = false;
+    bool     enable      = false;
+    uint32_t nof_threads = 0; ///< Fading and delay worker threads, 0 runs every channel in the calling thread
 
     // AWGN options
     bool  awgn_enable            = false;
@@ -77,17 +82,33 @@ public:
 
 private:
   srslog::basic_logger&    logger;
-  float                    hst_init_phase              = 0.0f;
-  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS] = {};
-  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]  = {};
-  srsran_channel_awgn_t*   awgn                        = nullptr;
-  srsran_channel_hst_t*    hst                         = nullptr;
-  srsran_channel_rlf_t*    rlf                         = nullptr;
-  cf_t*                    buffer_in                   = nullptr;
-  cf_t*                    buffer_out                  = nullptr;
-  uint32_t                 nof_channels                = 0;
-  uint32_t                 current_srate               = 0;
-  args_t                   args                        = {};
+  float                    hst_init_phase                  = 0.0f;
+  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS]     = {};
+  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]      = {};
+  srsran_channel_awgn_t*   awgn                            = nullptr;
+  srsran_channel_hst_t*    hst                             = nullptr;
+  srsran_channel_rlf_t*    rlf                             = nullptr;
+  cf_t*                    buffer_in[SRSRAN_MAX_CHANNELS]  = {};
+  cf_t*                    buffer_out[SRSRAN_MAX_CHANNELS] = {};
+  uint32_t                 nof_channels                    = 0;
+  uint32_t                 current_srate                   = 0;
+  args_t                   args                            = {};
+
+  // Worker threads, every worker runs the fading and delay of the channels i with i % nof_workers equal to its index
+  std::vector<std::thread> workers;
+  std::mutex               workers_mutex;
+  std::condition_variable  workers_start_cvar;
+  std::condition_variable  workers_done_cvar;
+  uint32_t                 nof_workers                     = 0;
+  uint32_t                 workers_job                     = 0; ///< Incremented for every run, it wakes up the workers
+  uint32_t                 workers_pending                 = 0; ///< Number of workers still running the current job
+  bool                     workers_quit                    = false;
+  bool                     job_active[SRSRAN_MAX_CHANNELS] = {}; ///< Channels of the current job
+  uint32_t                 job_len                         = 0;
+  srsran_timestamp_t       job_time                        = {};
+
+  void run_fading_delay(uint32_t i, uint32_t len, const srsran_timestamp_t& t);
+  void worker_loop(uint32_t worker_idx);
 };
 
 typedef std::unique_ptr<channel> channel_ptr;
@@ -202,6 +202,9 @@ typedef enum SRSRAN_API {
 /// Maximum number of TDD uplink-downlink subframe configurations.
 #define SRSRAN_MAX_TDD_SF_CONFIGS (7u)
 
+/// Maximum size M of a TDD downlink association set.
+#define SRSRAN_MAX_TDD_DL_ASSOCIATION_SET_SIZE (9u)
+
 /// Configuration fields for operating in TDD mode.
 typedef struct SRSRAN_API {
   /// Uplink-downlink configuration, valid range is [0,SRSRAN_MAX_TDD_SF_CONFIGS[.
@@ -424,6 +427,18 @@ SRSRAN_API uint32_t srsran_sfidx_tdd_nof_dw(srsran_tdd_config_t tdd_config);
 
 SRSRAN_API uint32_t srsran_tdd_nof_harq(srsran_tdd_config_t tdd_config);
 
+/**
+ * Returns the downlink association set of a subframe, the values k such that the HARQ-ACK of the PDSCH in subframe n-k
+ * is transmitted in subframe n.
+ * Check TS 36.213 v10.3.0 Table 10.1.3.1-1.
+ *
+ * @param tdd_config TDD configuration.
+ * @param sf_idx Subframe number n, must be in range [0,SRSRAN_NOF_SF_X_FRAME[.
+ * @param k Destination of the k values, it must hold SRSRAN_MAX_TDD_DL_ASSOCIATION_SET_SIZE values.
+ * @return Returns the size M of the set, 0 if the subframe carries no HARQ-ACK.
+ */
+SRSRAN_API uint32_t srsran_tdd_dl_association_set(srsran_tdd_config_t tdd_config, uint32_t sf_idx, uint32_t* k);
+
 SRSRAN_API uint32_t srsran_sfidx_tdd_nof_dw_slot(srsran_tdd_config_t tdd_config, uint32_t slot, srsran_cp_t cp);
 
 SRSRAN_API bool srsran_sfidx_isvalid(uint32_t sf_idx);
@@ -55,6 +55,13 @@ void srsran_sequence_state_apply_bit(srsran_sequence_state_t* s, const uint8_t*
 
 SRSRAN_API void srsran_sequence_state_advance(srsran_sequence_state_t* s, uint32_t length);
 
+/**
+ * Applies the sequence to MSB-first packed bits. Consecutive calls continue the same sequence as long as every call
+ * but the last one processes a multiple of 8 bits.
+ */
+SRSRAN_API void
+srsran_sequence_state_apply_packed(srsran_sequence_state_t* s, const uint8_t* in, uint8_t* out, uint32_t length);
+
 typedef struct SRSRAN_API {
   uint8_t* c;
   uint8_t* c_bytes;
@@ -91,6 +98,8 @@ SRSRAN_API int srsran_sequence_phich(srsran_sequence_t* seq, uint32_t nslot, uin
 
 SRSRAN_API int srsran_sequence_pdcch(srsran_sequence_t* seq, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
+SRSRAN_API uint32_t srsran_sequence_pdsch_seed(uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id);
+
 SRSRAN_API int
 srsran_sequence_pdsch(srsran_sequence_t* seq, uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
@@ -82,6 +82,22 @@ SRSRAN_API int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
                                       int                idist,
                                       int                odist);
 
+/* Plans nof_batches groups of how_many transforms, the groups being batch_idist/batch_odist samples apart, so that
+ * a single srsran_dft_run_guru_c() call transforms them all */
+SRSRAN_API int srsran_dft_plan_guru_batch_c(srsran_dft_plan_t* plan,
+                                            int                dft_points,
+                                            srsran_dft_dir_t   dir,
+                                            cf_t*              in_buffer,
+                                            cf_t*              out_buffer,
+                                            int                istride,
+                                            int                ostride,
+                                            int                how_many,
+                                            int                idist,
+                                            int                odist,
+                                            int                nof_batches,
+                                            int                batch_idist,
+                                            int                batch_odist);
+
 SRSRAN_API int srsran_dft_plan_r(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir);
 
 SRSRAN_API int srsran_dft_replan(srsran_dft_plan_t* plan, const int new_dft_points);
@@ -102,6 +118,11 @@ SRSRAN_API int srsran_dft_replan_r(srsran_dft_plan_t* plan, int new_dft_points);
 
 SRSRAN_API void srsran_dft_plan_free(srsran_dft_plan_t* plan);
 
+/* Saves the wisdom of all the plans created so far, so that later processes do not measure them again. It is also
+ * saved when the process exits. The file is $HOME/.srsran_fftwisdom, unless the SRSRAN_FFTW_WISDOM environment
+ * variable gives another path. */
+SRSRAN_API int srsran_dft_wisdom_export(void);
+
 /* Set options */
 
 SRSRAN_API void srsran_dft_plan_set_mirror(srsran_dft_plan_t* plan, bool val);
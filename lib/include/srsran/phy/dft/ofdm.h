@@ -72,6 +72,7 @@ typedef struct SRSRAN_API {
   srsran_ofdm_cfg_t cfg;
   srsran_dft_plan_t fft_plan;
   srsran_dft_plan_t fft_plan_sf[2];
+  srsran_dft_plan_t fft_plan_batch; ///< Guru DFT of all the symbols of a subframe, unused if it could not be planned
   uint32_t          max_prb;
   uint32_t          nof_symbols;
   uint32_t          nof_guards;
@@ -130,6 +131,19 @@ SRSRAN_API void srsran_ofdm_rx_sf(srsran_ofdm_t* q);
 
 SRSRAN_API void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output);
 
+/**
+ * @brief Demodulates a subframe received as interleaved 16 bit IQ samples (sc16), as srsran_ofdm_rx_sf() does with the
+ * samples in the input buffer
+ *
+ * The conversion to floating point is fused with the cyclic prefix removal: only the samples read by the DFT are
+ * converted into the input buffer, which is used as DFT input and does not hold the whole subframe afterwards.
+ *
+ * @param q OFDM receiver object
+ * @param input Subframe samples, 2 * SRSRAN_SF_LEN(symbol_sz) integers
+ * @param scale Integer value of a unit amplitude, e.g. SRSRAN_RF_SC16_FULL_SCALE
+ */
+SRSRAN_API void srsran_ofdm_rx_sf_sc16(srsran_ofdm_t* q, const int16_t* input, float scale);
+
 SRSRAN_API int
 srsran_ofdm_tx_init(srsran_ofdm_t* q, srsran_cp_t cp_type, cf_t* in_buffer, cf_t* out_buffer, uint32_t nof_prb);
 
@@ -140,6 +154,37 @@ SRSRAN_API void srsran_ofdm_tx_free(srsran_ofdm_t* q);
 
 SRSRAN_API void srsran_ofdm_tx_sf(srsran_ofdm_t* q);
 
+/**
+ * @brief Modulates a subframe as srsran_ofdm_tx_sf() does and writes it as interleaved 16 bit IQ samples (sc16)
+ *
+ * @param q OFDM transmitter object
+ * @param output Subframe samples, 2 * SRSRAN_SF_LEN(symbol_sz) integers. It can alias the output buffer
+ * @param scale Integer value of a unit amplitude
+ */
+SRSRAN_API void srsran_ofdm_tx_sf_sc16(srsran_ofdm_t* q, int16_t* output, float scale);
+
+/**
+ * @brief Modulates a single OFDM symbol of the subframe in the input buffer and writes its samples, including the cyclic
+ * prefix, in the output buffer, at the same place srsran_ofdm_tx_sf() would
+ *
+ * It only reads the resource elements of the given symbol, so it can be called as soon as they are mapped, without
+ * waiting for the rest of the subframe. Modulating every symbol of the subframe, in any order, produces the same output
+ * as srsran_ofdm_tx_sf().
+ *
+ * @attention MBSFN subframes are not supported
+ *
+ * @param q OFDM transmitter object
+ * @param symbol_idx OFDM symbol index within the subframe
+ * @return SRSRAN_SUCCESS if the symbol is modulated, SRSRAN_ERROR_INVALID_INPUTS otherwise
+ */
+SRSRAN_API int srsran_ofdm_tx_symbol(srsran_ofdm_t* q, uint32_t symbol_idx);
+
+/**
+ * @brief Returns the offset, in samples from the start of the subframe, of the cyclic prefix of an OFDM symbol. The
+ * number of symbols of the subframe gives the subframe length
+ */
+SRSRAN_API uint32_t srsran_ofdm_get_symbol_offset(const srsran_ofdm_t* q, uint32_t symbol_idx);
+
 SRSRAN_API int srsran_ofdm_set_freq_shift(srsran_ofdm_t* q, float freq_shift);
 
 SRSRAN_API void srsran_ofdm_set_normalize(srsran_ofdm_t* q, bool normalize_enable);
@@ -67,10 +67,15 @@ typedef struct SRSRAN_API {
   srsran_cfr_cfg_t cfr_config;
 
   cf_t*         sf_symbols[SRSRAN_MAX_PORTS];
+  cf_t*         base_symbols[SRSRAN_MAX_PORTS]; ///< CRS, PSS and SSS of each port, one grid for each subframe index
   cf_t*         out_buffer[SRSRAN_MAX_PORTS];
   srsran_ofdm_t ifft[SRSRAN_MAX_PORTS];
   srsran_ofdm_t ifft_mbsfn;
 
+  bool     sparse_tx;                       ///< Generates the symbols without channels other than CRS without IFFT
+  uint32_t busy_symbols;                    ///< Bitmap of the subframe symbols a channel other than CRS is mapped to
+  cf_t*    crs_signal_td[SRSRAN_MAX_PORTS]; ///< Time domain CRS of each port, one subframe for each subframe index
+
   srsran_pbch_t   pbch;
   srsran_pcfich_t pcfich;
   srsran_regs_t   regs;
@@ -106,16 +111,53 @@ SRSRAN_API int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell);
 
 SRSRAN_API int srsran_enb_dl_set_cfr(srsran_enb_dl_t* q, const srsran_cfr_cfg_t* cfr);
 
+/**
+ * @brief Enables or disables the sparse transmission. When it is enabled, only the symbols a channel other than CRS is
+ * mapped to are modulated; the CRS-only symbols are copied from a time domain signal precomputed for each subframe
+ * index and the empty symbols are zeroed. The output is the same, it only saves CPU in lightly loaded cells.
+ *
+ * @attention The grid shall only be written through the srsran_enb_dl_put_*() functions. MBSFN subframes and CFR are
+ * always fully modulated
+ *
+ * @param q eNb DL object, with the cell already set
+ * @param enable True enables the sparse transmission
+ * @return SRSRAN_SUCCESS if successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_enb_dl_set_sparse_tx(srsran_enb_dl_t* q, bool enable);
+
 SRSRAN_API bool srsran_enb_dl_location_is_common_ncce(srsran_enb_dl_t* q, const srsran_dci_location_t* loc);
 
 SRSRAN_API void srsran_enb_dl_put_base(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf);
 
+/* Same as srsran_enb_dl_put_base() in two steps, the base signals do not depend on the CFI the MAC selects */
+SRSRAN_API void srsran_enb_dl_put_base_signals(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf);
+
+SRSRAN_API void srsran_enb_dl_put_cfi(srsran_enb_dl_t* q, uint32_t cfi);
+
 SRSRAN_API void srsran_enb_dl_put_phich(srsran_enb_dl_t* q, srsran_phich_grant_t* grant, bool ack);
 
+/* Puts all the ACK/NACKs of the subframe, each PHICH group is scrambled, precoded and mapped once */
+SRSRAN_API int
+srsran_enb_dl_put_phich_batch(srsran_enb_dl_t* q, srsran_phich_grant_t* grants, const uint8_t* acks, uint32_t nof_acks);
+
 SRSRAN_API int srsran_enb_dl_put_pdcch_dl(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, srsran_dci_dl_t* dci_dl);
 
 SRSRAN_API int srsran_enb_dl_put_pdcch_ul(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, srsran_dci_ul_t* dci_ul);
 
+/* Packs a DCI for srsran_enb_dl_put_pdcch_batch() */
+SRSRAN_API int srsran_enb_dl_pack_pdcch_dl(srsran_enb_dl_t*  q,
+                                          srsran_dci_cfg_t* dci_cfg,
+                                          srsran_dci_dl_t*  dci_dl,
+                                          srsran_dci_msg_t* msg);
+
+SRSRAN_API int srsran_enb_dl_pack_pdcch_ul(srsran_enb_dl_t*  q,
+                                          srsran_dci_cfg_t* dci_cfg,
+                                          srsran_dci_ul_t*  dci_ul,
+                                          srsran_dci_msg_t* msg);
+
+/* Puts a list of packed DCIs, the used part of the control region is encoded in one pass */
+SRSRAN_API int srsran_enb_dl_put_pdcch_batch(srsran_enb_dl_t* q, srsran_dci_msg_t* msgs, uint32_t nof_msgs);
+
 SRSRAN_API int
 srsran_enb_dl_put_pdsch(srsran_enb_dl_t* q, srsran_pdsch_cfg_t* pdsch, uint8_t* data[SRSRAN_MAX_CODEWORDS]);
 
@@ -123,6 +165,14 @@ SRSRAN_API int srsran_enb_dl_put_pmch(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmc
 
 SRSRAN_API void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q);
 
+/**
+ * @brief Generates the time domain signal of a single antenna port, including its CFR. The ports are independent, so
+ * they can be generated in parallel. MBSFN subframes are generated by the port 0 alone.
+ * @param q eNb DL object
+ * @param port_idx Antenna port index
+ */
+SRSRAN_API void srsran_enb_dl_gen_signal_port(srsran_enb_dl_t* q, uint32_t port_idx);
+
 SRSRAN_API bool srsran_enb_dl_gen_cqi_periodic(const srsran_cell_t*   cell,
                                                const srsran_dl_cfg_t* dl_cfg,
                                                uint32_t               tti,
@@ -73,8 +73,14 @@ SRSRAN_API int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
                                       srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
                                       srsran_refsignal_srs_cfg_t*        srs_cfg);
 
+/* Drops the state kept for a RNTI, e.g. the cached PUSCH scrambling sequences. Call it when the RNTI is released */
+SRSRAN_API void srsran_enb_ul_rem_rnti(srsran_enb_ul_t* q, uint16_t rnti);
+
 SRSRAN_API void srsran_enb_ul_fft(srsran_enb_ul_t* q);
 
+/* Demodulates a subframe of interleaved 16 bit IQ samples, see srsran_ofdm_rx_sf_sc16() */
+SRSRAN_API void srsran_enb_ul_fft_sc16(srsran_enb_ul_t* q, const int16_t* input, float scale);
+
 SRSRAN_API int srsran_enb_ul_get_pucch(srsran_enb_ul_t*    q,
                                        srsran_ul_sf_cfg_t* ul_sf,
                                        srsran_pucch_cfg_t* cfg,
@@ -85,4 +91,12 @@ SRSRAN_API int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                                        srsran_pusch_cfg_t* cfg,
                                        srsran_pusch_res_t* res);
 
+/* Decodes the PUSCH from the resource grid demodulated by another object, srsran_enb_ul_fft() is not needed. Objects
+ * sharing the same grid can decode different grants of the subframe in parallel */
+SRSRAN_API int srsran_enb_ul_get_pusch_grid(srsran_enb_ul_t*    q,
+                                            srsran_ul_sf_cfg_t* ul_sf,
+                                            srsran_pusch_cfg_t* cfg,
+                                            cf_t*               sf_symbols,
+                                            srsran_pusch_res_t* res);
+
 #endif // SRSRAN_ENB_UL_H
@@ -47,11 +47,14 @@ typedef struct SRSRAN_API {
   int (*decode)(void*, uint8_t*, uint8_t*, uint32_t);
   int (*decode_s)(void*, uint16_t*, uint8_t*, uint32_t);
   int (*decode_f)(void*, float*, uint8_t*, uint32_t);
+  int (*decode_batch_s)(void*, uint16_t* const*, uint8_t* const*, uint32_t, uint32_t);
   void (*free)(void*);
   uint8_t*  tmp;
   uint16_t* tmp_s;
   uint8_t*  symbols_uc;
   uint16_t* symbols_us;
+  void*     ptr_batch;
+  uint16_t* symbols_batch;
 } srsran_viterbi_t;
 
 SRSRAN_API int srsran_viterbi_init(srsran_viterbi_t*     q,
@@ -68,6 +71,23 @@ SRSRAN_API void srsran_viterbi_free(srsran_viterbi_t* q);
 
 SRSRAN_API int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data, uint32_t frame_length);
 
+/**
+ * Decodes several frames of the same length with real-valued symbols. Where the SIMD implementation supports it, the
+ * frames are decoded together, one per register lane; otherwise they are decoded one after the other. Each frame
+ * decodes to the same bits as with srsran_viterbi_decode_f().
+ * @param q Viterbi decoder object
+ * @param symbols Pointers to the symbols of each frame
+ * @param data Pointers to the decoded bits of each frame
+ * @param nof_frames Number of frames
+ * @param frame_length Number of bits in every frame
+ * @return SRSRAN_SUCCESS if the frames are decoded, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_viterbi_decode_batch_f(srsran_viterbi_t* q,
+                                             float* const*     symbols,
+                                             uint8_t* const*   data,
+                                             uint32_t          nof_frames,
+                                             uint32_t          frame_length);
+
 SRSRAN_API int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data, uint32_t frame_length);
 
 SRSRAN_API int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols, uint8_t* data, uint32_t frame_length);
@@ -38,6 +38,8 @@
 
 typedef struct SRSRAN_API {
   uint64_t table[256];
+  uint32_t table8[8][256]; ///< Slicing-by-8 tables, with the CRC left-aligned to 32 bits
+  uint64_t fold[4];        ///< Carry-less multiplication folding constants
   int      polynom;
   int      order;
   uint64_t crcinit;
@@ -80,6 +82,9 @@ static inline uint64_t srsran_crc_checksum_get(srsran_crc_t* h)
 
 SRSRAN_API uint32_t srsran_crc_checksum_byte(srsran_crc_t* h, const uint8_t* data, int len);
 
+/* Same as calling srsran_crc_checksum_put_byte() for each of the nbytes bytes of data */
+SRSRAN_API void srsran_crc_checksum_put_bytes(srsran_crc_t* h, const uint8_t* data, uint32_t nbytes);
+
 SRSRAN_API uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len);
 
 SRSRAN_API bool srsran_crc_match_byte(srsran_crc_t* h, uint8_t* data, int len);
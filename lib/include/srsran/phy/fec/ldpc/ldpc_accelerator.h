@@ -0,0 +1,123 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file ldpc_accelerator.h
+ * \brief Declaration of the LDPC lookaside decoding interface.
+ *
+ * A lookaside accelerator decodes code blocks outside the calling thread: code block operations are enqueued in a
+ * queue of the accelerator, which processes them asynchronously, and are dequeued once completed. The interface
+ * follows the enqueue/dequeue model of hardware FEC devices, so that a device driver only needs to provide a
+ * srsran_ldpc_accelerator_dev_t. A software device, decoding in a worker thread per queue, is provided as reference.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#ifndef SRSRAN_LDPC_ACCELERATOR_H
+#define SRSRAN_LDPC_ACCELERATOR_H
+
+#include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/ldpc/base_graph.h"
+#include "srsran/phy/fec/ldpc/ldpc_decoder.h"
+
+/*!
+ * \brief Maximum number of operations in flight in a queue of the software accelerator.
+ */
+#define SRSRAN_LDPC_ACCELERATOR_SW_QUEUE_SIZE 64
+
+/*!
+ * \brief Describes the decoding of a code block.
+ */
+typedef struct {
+  srsran_basegraph_t bg;             /*!< \brief Base graph of the code block. */
+  uint16_t           ls;             /*!< \brief Lifting size of the code block. */
+  const int8_t*      llr;            /*!< \brief Rate dematched 8-bit LLRs. */
+  uint32_t           cdwd_rm_length; /*!< \brief Number of LLRs after rate dematching. */
+  srsran_crc_t*      crc;            /*!< \brief Early stop CRC, NULL to disable. */
+  uint8_t*           message;        /*!< \brief Decoded (unpacked) message. */
+  int nof_iter; /*!< \brief Result: used iterations, 0 if the CRC did not match, -1 if the decoding failed. */
+} srsran_ldpc_accelerator_op_t;
+
+/*!
+ * \brief Describes a queue of an LDPC accelerator. A queue must be used by one thread only.
+ */
+typedef struct SRSRAN_API {
+  void* ptr; /*!< \brief Queue state of the backend. */
+
+  int (*enqueue)(void*, srsran_ldpc_accelerator_op_t* const*, uint32_t); /*!< \brief Submits operations, returns the
+                                                                         number of accepted operations or -1. */
+  int (*dequeue)(void*, srsran_ldpc_accelerator_op_t**, uint32_t); /*!< \brief Non-blocking retrieval of completed
+                                                                   operations, returns their number or -1. */
+  void (*free)(void*); /*!< \brief Pointer to a "destructor". */
+} srsran_ldpc_accelerator_t;
+
+/*!
+ * \brief Describes an LDPC accelerator device, from which every decoder opens its own queue.
+ */
+typedef struct SRSRAN_API {
+  void* ptr; /*!< \brief Device state of the backend. */
+
+  int (*open_queue)(void*, srsran_ldpc_accelerator_t*); /*!< \brief Pointer to the queue "constructor". */
+  void (*free)(void*);                                   /*!< \brief Pointer to a "destructor". */
+} srsran_ldpc_accelerator_dev_t;
+
+/*!
+ * Opens a queue of an LDPC accelerator device.
+ * \param[in] dev A pointer to the accelerator device.
+ * \param[out] q A pointer to the queue.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_ldpc_accelerator_open(const srsran_ldpc_accelerator_dev_t* dev, srsran_ldpc_accelerator_t* q);
+
+/*!
+ * Closes a queue of an LDPC accelerator device. All its operations must have been dequeued.
+ * \param[in] q A pointer to the queue.
+ */
+SRSRAN_API void srsran_ldpc_accelerator_close(srsran_ldpc_accelerator_t* q);
+
+/*!
+ * Decodes several code blocks with an accelerator queue and waits until all of them are completed.
+ * \param[in] q A pointer to the accelerator queue.
+ * \param[in,out] ops The code block operations, their results are written in srsran_ldpc_accelerator_op_t::nof_iter.
+ * \param[in] nof_ops The number of code blocks.
+ * \return An integer: 0 if all the code blocks were decoded, -1 otherwise.
+ */
+SRSRAN_API int
+srsran_ldpc_accelerator_decode(srsran_ldpc_accelerator_t* q, srsran_ldpc_accelerator_op_t* ops, uint32_t nof_ops);
+
+/*!
+ * Initializes the software LDPC accelerator device. Each queue opened from it decodes in its own thread with the
+ * decoders described by args (the base graph and lifting size fields are ignored).
+ * \param[out] dev A pointer to the accelerator device.
+ * \param[in] args LDPC decoder configuration arguments.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_ldpc_accelerator_sw_init(srsran_ldpc_accelerator_dev_t*    dev,
+                                               const srsran_ldpc_decoder_args_t* args);
+
+/*!
+ * Frees an LDPC accelerator device. The queues opened from it must be closed first.
+ * \param[in] dev A pointer to the accelerator device.
+ */
+SRSRAN_API void srsran_ldpc_accelerator_dev_free(srsran_ldpc_accelerator_dev_t* dev);
+
+#endif // SRSRAN_LDPC_ACCELERATOR_H
@@ -35,6 +35,11 @@
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/fec/ldpc/base_graph.h"
 
+/*!
+ * \brief Maximum number of code blocks decoded at once by srsran_ldpc_decoder_decode_batch().
+ */
+#define SRSRAN_LDPC_DECODER_MAX_BATCH 16
+
 /*!
  * \brief Types of LDPC decoder.
  */
@@ -99,6 +104,17 @@ typedef struct SRSRAN_API {
                   uint8_t*,
                   uint32_t,
                   srsran_crc_t*); /*!< \brief Pointer to the decoding function (16-bit version). */
+
+  void*    batch_ptr;  /*!< \brief Registers used by the batched decoder, NULL if not available. */
+  uint32_t batch_size; /*!< \brief Number of code blocks the batched decoder processes at once. */
+
+  int (*decode_batch_c)(void*,
+                        const int8_t* const*,
+                        uint8_t* const*,
+                        const uint32_t*,
+                        srsran_crc_t*,
+                        int*,
+                        uint32_t); /*!< \brief Pointer to the batched decoding function (8-bit version). */
 } srsran_ldpc_decoder_t;
 
 /*!
@@ -179,4 +195,27 @@ SRSRAN_API int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
                                                 uint32_t               cdwd_rm_length,
                                                 srsran_crc_t*          crc);
 
+/*!
+ * Decodes several code blocks with 8-bit integer-valued LLRs. All the code blocks share the base graph and lifting
+ * size of the decoder. When the decoder supports it (AVX2 and AVX512 decoders with lifting size up to 16), up to
+ * \ref srsran_ldpc_decoder_t::batch_size code blocks are interleaved in the SIMD lanes and decoded together.
+ * Otherwise, the code blocks are decoded one after the other.
+ * \param[in] q A pointer to the LDPC decoder (a srsran_ldpc_decoder_t structure
+ *    instance) that carries out the decoding.
+ * \param[in] llrs The LLRs of each code block.
+ * \param[out] messages The messages (uncoded bits) resulting from the decoding of each code block.
+ * \param[in] cdwd_rm_length The number of bits forming each codeword (after rate matching).
+ * \param[in,out] crc Code-block CRC object for early stop. Set for NULL to disable check
+ * \param[out] nof_iter For each code block, the number of used iterations, 0 if CRC is provided and did not match.
+ * \param[in] nof_cb The number of code blocks to decode.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_ldpc_decoder_decode_batch(srsran_ldpc_decoder_t* q,
+                                                const int8_t* const*   llrs,
+                                                uint8_t* const*        messages,
+                                                const uint32_t*        cdwd_rm_length,
+                                                srsran_crc_t*          crc,
+                                                int*                   nof_iter,
+                                                uint32_t               nof_cb);
+
 #endif // SRSRAN_LDPCDECODER_H
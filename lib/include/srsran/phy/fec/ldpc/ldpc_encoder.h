@@ -42,9 +42,9 @@ typedef enum SRSRAN_API {
 #if LV_HAVE_AVX2
   SRSRAN_LDPC_ENCODER_AVX2, /*!< \brief SIMD-optimized encoder. */
 #endif                      // LV_HAVE_AVX2
-#if LV_HAVE_AVX512
+#if LV_HAVE_AVX512 || SRSRAN_SIMD_DISPATCH_AVX512
   SRSRAN_LDPC_ENCODER_AVX512, /*!< \brief SIMD-optimized encoder. */
-#endif                        // LV_HAVE_AVX512
+#endif                        // LV_HAVE_AVX512 || SRSRAN_SIMD_DISPATCH_AVX512
 } srsran_ldpc_encoder_type_t;
 
 /*!
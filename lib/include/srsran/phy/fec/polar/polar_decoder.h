@@ -37,6 +37,11 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+/*!
+ * \brief Maximum number of candidates returned by a list decoder.
+ */
+#define SRSRAN_POLAR_DECODER_MAX_LIST_SIZE 8
+
 /*!
  * Lists the different types of polar decoder.
  */
@@ -45,15 +50,20 @@ typedef enum SRSRAN_API {
   SRSRAN_POLAR_DECODER_SSC_S = 1, /*!< \brief Fixed-point (16 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C = 2, /*!< \brief Fixed-point (8 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C_AVX2 =
-      3 /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+      3, /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+  SRSRAN_POLAR_DECODER_SCL4_C_AVX2 =
+      4, /*!< \brief Fixed-point (8 bit, avx2) Successive Cancellation List (SCL) decoder with 4 paths. */
+  SRSRAN_POLAR_DECODER_SCL8_C_AVX2 =
+      5 /*!< \brief Fixed-point (8 bit, avx2) Successive Cancellation List (SCL) decoder with 8 paths. */
 } srsran_polar_decoder_type_t;
 
 /*!
  * \brief Describes a polar decoder.
  */
 typedef struct SRSRAN_API {
-  void*   ptr;  /*!< \brief Pointer to the actual polar decoder structure. */
-  uint8_t nMax; /*!< \brief Maximum \f$log_2(code_size)\f$. */
+  void*   ptr;       /*!< \brief Pointer to the actual polar decoder structure. */
+  uint8_t nMax;      /*!< \brief Maximum \f$log_2(code_size)\f$. */
+  uint8_t list_size; /*!< \brief Number of candidates provided by the decoder, 1 for SSC decoders. */
   int (*decode_f)(void*           ptr,
                   const float*    symbols,
                   uint8_t*        data_decoded,
@@ -72,7 +82,14 @@ typedef struct SRSRAN_API {
                   const uint8_t   n,
                   const uint16_t* frozen_set,
                   const uint16_t  frozen_set_size); /*!< \brief Pointer to the decoder function (8-bit version). */
-  void (*free)(void*);                             /*!< \brief Pointer to a "destructor". */
+  int (*decode_batch_c)(void*                ptr,
+                        const int8_t* const* symbols,
+                        uint8_t* const*      data_decoded,
+                        uint32_t             nof_cw,
+                        const uint8_t        n,
+                        const uint16_t*      frozen_set,
+                        const uint16_t       frozen_set_size); /*!< \brief Batch decoder (8-bit), NULL if SSC. */
+  void (*free)(void*);                                       /*!< \brief Pointer to a "destructor". */
 } srsran_polar_decoder_t;
 
 /*!
@@ -145,4 +162,44 @@ SRSRAN_API int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
                                              const uint16_t*         frozen_set,
                                              const uint16_t          frozen_set_size);
 
+/*!
+ * Decodes the input (int8_t) codeword and provides the most likely candidates, sorted by decreasing likelihood, so
+ * that the caller can select the one passing the CRC. SSC decoders provide a single candidate.
+ * \param[in] q A pointer to the desired polar decoder.
+ * \param[in] input_llr The decoder LLR input vector.
+ * \param[out] data_decoded The decoder output candidates, one after the other. It must have room for
+ * q->list_size vectors of \f$2^{code\_size\_log}\f$ bits.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vector.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return The number of candidates if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_polar_decoder_decode_list_c(srsran_polar_decoder_t* q,
+                                                  const int8_t*           input_llr,
+                                                  uint8_t*                data_decoded,
+                                                  const uint8_t           code_size_log,
+                                                  const uint16_t*         frozen_set,
+                                                  const uint16_t          frozen_set_size);
+
+/*!
+ * Decodes several (int8_t) codewords with the same size and frozen set in one call, such as PDCCH candidates that
+ * share aggregation level and DCI size. SC-list decoders process the paths of several codewords with the same
+ * vector instructions. Every codeword gets its candidates as in srsran_polar_decoder_decode_list_c().
+ * \param[in] q A pointer to the desired polar decoder.
+ * \param[in] input_llr The decoder LLR input vector of every codeword.
+ * \param[out] data_decoded The decoder output candidates of every codeword.
+ * \param[in] nof_cw The number of codewords.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vectors.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return The number of candidates per codeword if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_polar_decoder_decode_batch_c(srsran_polar_decoder_t* q,
+                                                   const int8_t* const*    input_llr,
+                                                   uint8_t* const*         data_decoded,
+                                                   uint32_t                nof_cw,
+                                                   const uint8_t           code_size_log,
+                                                   const uint16_t*         frozen_set,
+                                                   const uint16_t          frozen_set_size);
+
 #endif // SRSRAN_POLARDECODER_H
@@ -42,6 +42,7 @@ typedef struct SRSRAN_API {
   uint32_t  max_cb;
   uint32_t  max_cb_size;
   int16_t** buffer_f;
+  int8_t**  buffer_c; ///< 8-bit soft bits, allocated instead of buffer_f by srsran_softbuffer_rx_init_guru_c()
   uint8_t** data;
   bool*     cb_crc;
   bool      tb_crc;
@@ -51,6 +52,8 @@ typedef struct SRSRAN_API {
   uint32_t  max_cb;
   uint32_t  max_cb_size;
   uint8_t** buffer_b;
+  bool*     cb_encoded;  ///< buffer_b[i] holds code block i of the last encoded transport block, reused by its retx
+  uint32_t  encoded_tbs; ///< Size of the last encoded transport block
 } srsran_softbuffer_tx_t;
 
 #define SOFTBUFFER_SIZE 18600
@@ -67,6 +70,31 @@ SRSRAN_API int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof
  */
 SRSRAN_API int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
 
+/**
+ * @brief Initialises Rx soft-buffer for a number of code blocks and their size, storing the soft bits in 8-bit
+ * @note Intended for LDPC (NR) decoding, which saturates the combined soft bits to 7 bits. It halves the memory
+ * footprint of srsran_softbuffer_rx_init_guru()
+ * @param q The Rx soft-buffer pointer
+ * @param max_cb The maximum number of code blocks to allocate
+ * @param max_cb_size The code block size to allocate
+ * @return It returns SRSRAN_SUCCESS if it allocates the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int srsran_softbuffer_rx_init_guru_c(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
+
+/**
+ * @brief Initialises Rx soft-buffer for a number of code blocks and their size without allocating the code block soft
+ * bits. The caller attaches 16-bit buffers of max_cb_size soft bits to buffer_f (i.e. from a shared pool) before the
+ * soft-buffer is used
+ * @note srsran_softbuffer_rx_free() frees the attached buffers, so buffers owned by the caller shall be detached first
+ * @param q The Rx soft-buffer pointer
+ * @param max_cb The maximum number of code blocks
+ * @param max_cb_size The code block size
+ * @return It returns SRSRAN_SUCCESS if it allocates the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int srsran_softbuffer_rx_init_lazy(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
+
 SRSRAN_API void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* p);
 
 SRSRAN_API void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs);
@@ -96,6 +124,19 @@ SRSRAN_API int srsran_softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t nof
  */
 SRSRAN_API int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, uint32_t max_cb_size);
 
+/**
+ * @brief Initialises Tx soft-buffer for a number of code blocks and their size without allocating the code block
+ * buffers. The caller attaches buffers of max_cb_size bytes to buffer_b (i.e. from a shared pool) before the soft-buffer
+ * is used
+ * @note srsran_softbuffer_tx_free() frees the attached buffers, so buffers owned by the caller shall be detached first
+ * @param q The Tx soft-buffer pointer
+ * @param max_cb The maximum number of code blocks
+ * @param max_cb_size The code block size
+ * @return It returns SRSRAN_SUCCESS if it allocates the soft-buffer successfully, otherwise it returns SRSRAN_ERROR
+ * code
+ */
+SRSRAN_API int srsran_softbuffer_tx_init_lazy(srsran_softbuffer_tx_t* q, uint32_t max_cb, uint32_t max_cb_size);
+
 SRSRAN_API void srsran_softbuffer_tx_reset(srsran_softbuffer_tx_t* p);
 
 SRSRAN_API void srsran_softbuffer_tx_reset_tbs(srsran_softbuffer_tx_t* q, uint32_t tbs);
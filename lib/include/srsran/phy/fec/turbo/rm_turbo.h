@@ -41,6 +41,10 @@
 #define SRSRAN_TX_NULL 100
 #endif
 
+/* Fields of the input LUT entries of srsran_rm_turbo_rx_lut_gather() */
+#define SRSRAN_RM_TURBO_RX_LUT_NEG (1U << 31U)
+#define SRSRAN_RM_TURBO_RX_LUT_IDX_MASK (SRSRAN_RM_TURBO_RX_LUT_NEG - 1U)
+
 #include "srsran/config.h"
 
 SRSRAN_API int srsran_rm_turbo_tx(uint8_t* w_buff,
@@ -64,6 +68,17 @@ SRSRAN_API int srsran_rm_turbo_tx_lut(uint8_t* w_buff,
                                       uint32_t w_offset,
                                       uint32_t rv_idx);
 
+/* The two halves of srsran_rm_turbo_tx_lut(): sub-block interleaving of an encoded code block into the circular
+ * buffer w_buff, and bit selection of one redundancy version from it. */
+SRSRAN_API int srsran_rm_turbo_tx_lut_interleave(uint8_t* w_buff, uint8_t* systematic, uint8_t* parity, uint32_t cb_idx);
+
+SRSRAN_API int srsran_rm_turbo_tx_lut_select(uint8_t* w_buff,
+                                             uint8_t* output,
+                                             uint32_t cb_idx,
+                                             uint32_t out_len,
+                                             uint32_t w_offset,
+                                             uint32_t rv_idx);
+
 SRSRAN_API int srsran_rm_turbo_rx(float*   w_buff,
                                   uint32_t buff_len,
                                   float*   input,
@@ -83,6 +98,26 @@ SRSRAN_API int srsran_rm_turbo_rx_lut_(int16_t* input,
                                        uint32_t rv_idx,
                                        bool     enable_input_tdec);
 
+/**
+ * Undoes rate matching like srsran_rm_turbo_rx_lut(), but the i-th rate matched LLR is read from
+ * input[input_lut[i] & SRSRAN_RM_TURBO_RX_LUT_IDX_MASK] and negated if SRSRAN_RM_TURBO_RX_LUT_NEG is set in
+ * input_lut[i]. This lets the caller descramble and deinterleave the input in the same pass.
+ *
+ * @param[in] input LLRs in transmission order
+ * @param[in] input_lut Position and sign of each of the in_len rate matched LLRs
+ * @param[out] output Output buffer of size 3*srsran_cbsegm_cbsize(cb_idx)+12, LLRs are accumulated to it
+ * @param[in] in_len Number of rate matched LLRs
+ * @param[in] cb_idx Code block table index
+ * @param[in] rv_idx Redundancy Version from DCI control message
+ * @return Error code
+ */
+SRSRAN_API int srsran_rm_turbo_rx_lut_gather(const int16_t*  input,
+                                             const uint32_t* input_lut,
+                                             int16_t*        output,
+                                             uint32_t        in_len,
+                                             uint32_t        cb_idx,
+                                             uint32_t        rv_idx);
+
 SRSRAN_API int
 srsran_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len, uint32_t cb_idx, uint32_t rv_idx);
 
@@ -47,4 +47,16 @@ SRSRAN_API int srsran_tc_interl_init(srsran_tc_interl_t* h, uint32_t max_long_cb
 
 SRSRAN_API void srsran_tc_interl_free(srsran_tc_interl_t* h);
 
+/*!
+ * @brief Gets the process-wide read-only interleavers of all the LTE code block sizes for the given window (1, 8, 16 or
+ * 32 subblocks), indexed as srsran_cbsegm_cbindex(). They are generated on the first call and shared by reference count.
+ * @return A table of SRSRAN_NOF_TC_CB_SIZES interleavers, NULL on error
+ */
+SRSRAN_API const srsran_tc_interl_t* srsran_tc_interl_LTE_shared_get(uint32_t interl_win);
+
+/*!
+ * @brief Releases a table obtained with srsran_tc_interl_LTE_shared_get(), it is freed with the last reference.
+ */
+SRSRAN_API void srsran_tc_interl_LTE_shared_put(uint32_t interl_win);
+
 #endif // SRSRAN_TC_INTERL_H
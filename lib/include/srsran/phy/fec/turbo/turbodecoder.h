@@ -56,7 +56,7 @@
 #undef LLR_IS_16BIT
 
 #define SRSRAN_TDEC_NOF_AUTO_MODES_8 2
-#define SRSRAN_TDEC_NOF_AUTO_MODES_16 3
+#define SRSRAN_TDEC_NOF_AUTO_MODES_16 4
 
 typedef enum { SRSRAN_TDEC_8, SRSRAN_TDEC_16 } srsran_tdec_llr_type_t;
 
@@ -85,13 +85,13 @@ typedef struct SRSRAN_API {
 
   srsran_tdec_impl_type_t dec_type;
 
-  srsran_tdec_llr_type_t current_llr_type;
-  uint32_t               current_dec;
-  uint32_t               current_long_cb;
-  uint32_t               current_inter_idx;
-  int                    current_cbidx;
-  srsran_tc_interl_t     interleaver[4][SRSRAN_NOF_TC_CB_SIZES];
-  int                    n_iter;
+  srsran_tdec_llr_type_t    current_llr_type;
+  uint32_t                  current_dec;
+  uint32_t                  current_long_cb;
+  uint32_t                  current_inter_idx;
+  int                       current_cbidx;
+  const srsran_tc_interl_t* interleaver[4]; ///< Shared by all the decoders, see srsran_tc_interl_LTE_shared_get()
+  int                       n_iter;
 } srsran_tdec_t;
 
 SRSRAN_API int srsran_tdec_init(srsran_tdec_t* h, uint32_t max_long_cb);
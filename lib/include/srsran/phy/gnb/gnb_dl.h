@@ -74,6 +74,14 @@ SRSRAN_API int srsran_gnb_dl_base_zero(srsran_gnb_dl_t* q);
 
 SRSRAN_API void srsran_gnb_dl_gen_signal(srsran_gnb_dl_t* q);
 
+/**
+ * @brief Generates the baseband signal of a group of consecutive OFDM symbols of the slot, so that the symbols whose
+ * resource elements are already mapped can be modulated while the rest of the slot is encoded. Generating every
+ * symbol of the slot gives the same signal as srsran_gnb_dl_gen_signal()
+ * @return SRSRAN_SUCCESS if the symbols are generated, SRSRAN_ERROR_INVALID_INPUTS otherwise
+ */
+SRSRAN_API int srsran_gnb_dl_gen_symbols(srsran_gnb_dl_t* q, uint32_t first_symbol, uint32_t nof_symbols);
+
 SRSRAN_API int srsran_gnb_dl_add_ssb(srsran_gnb_dl_t* q, const srsran_pbch_msg_nr_t* pbch_msg, uint32_t sf_idx);
 
 SRSRAN_API int
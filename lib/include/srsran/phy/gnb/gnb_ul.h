@@ -47,6 +47,11 @@ typedef struct SRSRAN_API {
   srsran_chest_dl_res_t chest_pusch;
   srsran_chest_ul_res_t chest_pucch;
   float                 pusch_min_snr_dB; ///< Minimum measured DMRS SNR, below this threshold PUSCH is not decoded
+
+  // The PUCCH candidates of a UE that share a resource, such as with and without SR, reuse its channel estimate
+  bool                         pucch_chest_valid; ///< chest_pucch holds an estimate of the current slot
+  srsran_pucch_nr_resource_t   pucch_chest_resource;
+  srsran_pucch_nr_common_cfg_t pucch_chest_cfg;
 } srsran_gnb_ul_t;
 
 SRSRAN_API int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args_t* args);
@@ -63,6 +68,12 @@ SRSRAN_API int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
                                        const srsran_sch_grant_nr_t* grant,
                                        srsran_pusch_res_nr_t*       data);
 
+/**
+ * @brief Completes the decoding of the PUSCH transmissions got with srsran_gnb_ul_get_pusch(). The transport blocks of
+ * a single small code block are decoded here together when the PUSCH arguments defer them
+ */
+SRSRAN_API int srsran_gnb_ul_flush_pusch(srsran_gnb_ul_t* q);
+
 SRSRAN_API int srsran_gnb_ul_get_pucch(srsran_gnb_ul_t*                    q,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_pucch_nr_common_cfg_t* cfg,
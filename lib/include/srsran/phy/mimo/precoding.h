@@ -49,6 +49,11 @@ SRSRAN_API int srsran_precoding_diversity(cf_t* x[SRSRAN_MAX_LAYERS],
                                           int   nof_symbols,
                                           float scaling);
 
+/* Transmit diversity layer mapping and precoding in a single pass, from the nof_symbols symbols of the codeword d. The
+ * output is the same as srsran_layermap_diversity() followed by srsran_precoding_diversity() */
+SRSRAN_API int
+srsran_precoding_diversity_cw(const cf_t* d, cf_t* y[SRSRAN_MAX_PORTS], int nof_ports, int nof_symbols, float scaling);
+
 SRSRAN_API int srsran_precoding_cdd(cf_t* x[SRSRAN_MAX_LAYERS],
                                     cf_t* y[SRSRAN_MAX_PORTS],
                                     int   nof_layers,
@@ -97,6 +102,27 @@ SRSRAN_API int srsran_predecoding_diversity_multi(cf_t*  y[SRSRAN_MAX_PORTS],
 
 SRSRAN_API void srsran_predecoding_set_mimo_decoder(srsran_mimo_decoder_t _mimo_decoder);
 
+/* MMSE equalizer x = inv(H' x H + No) x H' x y of up to 4 NR layers received on nof_rxant >= nof_layers antennas. The
+ * channel of layer l at antenna r is h[l][r], the RE are equalized in groups of the SIMD width. x can be the same
+ * buffers as y */
+SRSRAN_API int srsran_predecoding_mmse_nr(cf_t*    y[SRSRAN_MAX_PORTS],
+                                          cf_t*    h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                          cf_t*    x[SRSRAN_MAX_LAYERS],
+                                          uint32_t nof_rxant,
+                                          uint32_t nof_layers,
+                                          uint32_t nof_re,
+                                          float    noise_estimate);
+
+/* Interference rejection combining (IRC) equalizer x = inv(H' x inv(R) x H + I) x H' x inv(R) x y, R is the
+ * interference plus noise covariance between the rx antennas, common to all the RE (e.g. measured in a PRB group) */
+SRSRAN_API int srsran_predecoding_irc_nr(cf_t*      y[SRSRAN_MAX_PORTS],
+                                         cf_t*      h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                         cf_t*      x[SRSRAN_MAX_LAYERS],
+                                         uint32_t   nof_rxant,
+                                         uint32_t   nof_layers,
+                                         uint32_t   nof_re,
+                                         const cf_t R[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS]);
+
 SRSRAN_API int srsran_predecoding_type(cf_t*              y[SRSRAN_MAX_PORTS],
                                        cf_t*              h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
                                        cf_t*              x[SRSRAN_MAX_LAYERS],
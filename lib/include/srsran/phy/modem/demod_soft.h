@@ -23,7 +23,7 @@
  *  File:         demod_soft.h
  *
  *  Description:  Soft demodulator.
- *                Supports BPSK, QPSK, 16QAM and 64QAM.
+ *                Supports BPSK, QPSK, 16QAM, 64QAM and 256QAM.
  *
  *  Reference:    3GPP TS 36.211 version 10.0.0 Release 10 Sec. 7.1
  *****************************************************************************/
@@ -42,4 +42,19 @@ SRSRAN_API int srsran_demod_soft_demodulate_s(srsran_mod_t modulation, const cf_
 
 SRSRAN_API int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols, int8_t* llr, int nsymbols);
 
+/* Same as srsran_demod_soft_demodulate_b(), the LLR of every symbol are weighted by its csi (e.g. the normalized
+ * post-equalization SINR) in the same pass, 256QAM has a fused SIMD implementation. A NULL csi weights all by one */
+SRSRAN_API int srsran_demod_soft_demodulate_csi_b(srsran_mod_t modulation,
+                                                  const cf_t*  symbols,
+                                                  const float* csi,
+                                                  int8_t*      llr,
+                                                  int          nsymbols);
+
+/* Same as srsran_demod_soft_demodulate_csi_b() with 16 bit LLR */
+SRSRAN_API int srsran_demod_soft_demodulate_csi_s(srsran_mod_t modulation,
+                                                  const cf_t*  symbols,
+                                                  const float* csi,
+                                                  short*       llr,
+                                                  int          nsymbols);
+
 #endif // SRSRAN_DEMOD_SOFT_H
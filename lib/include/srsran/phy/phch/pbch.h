@@ -66,8 +66,11 @@ typedef struct SRSRAN_API {
   float*   temp;
   float    rm_f[SRSRAN_BCH_ENCODED_LEN];
   uint8_t* rm_b;
+  uint8_t* rm_b_tx; ///< Scrambled bits of the transmitted radio frame, rm_b keeps the payload encoding
   uint8_t  data[SRSRAN_BCH_PAYLOADCRC_LEN];
   uint8_t  data_enc[SRSRAN_BCH_ENCODED_LEN];
+  uint8_t  encoded_payload[SRSRAN_BCH_PAYLOAD_LEN]; ///< Payload encoded in rm_b, it changes every 4 radio frames
+  bool     encoded_payload_valid;
 
   uint32_t frame_idx;
 
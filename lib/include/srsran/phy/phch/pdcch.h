@@ -47,6 +47,9 @@
 
 typedef enum SRSRAN_API { SEARCH_UE, SEARCH_COMMON } srsran_pdcch_search_mode_t;
 
+/* Maximum number of DCI candidates de-rate matched at once by srsran_pdcch_decode_msg_batch() */
+#define SRSRAN_PDCCH_MAX_BATCH 32
+
 /* PDCCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -65,6 +68,7 @@ typedef struct SRSRAN_API {
   cf_t*    d;
   uint8_t* e;
   float    rm_f[3 * (SRSRAN_DCI_MAX_BITS + 16)];
+  float*   rm_f_batch;
   float*   llr;
 
   /* tx & rx objects */
@@ -93,6 +97,14 @@ SRSRAN_API int srsran_pdcch_encode(srsran_pdcch_t*     q,
                                    srsran_dci_msg_t*   msg,
                                    cf_t*               sf_symbols[SRSRAN_MAX_PORTS]);
 
+/* Encodes all the DCI messages of a subframe. The used span of the control region is scrambled, modulated and precoded
+ * in one pass, and each run of consecutive used CCEs is mapped with a single call. Invalid messages are skipped */
+SRSRAN_API int srsran_pdcch_encode_batch(srsran_pdcch_t*     q,
+                                         srsran_dl_sf_cfg_t* sf,
+                                         srsran_dci_msg_t*   msgs,
+                                         uint32_t            nof_msgs,
+                                         cf_t*               sf_symbols[SRSRAN_MAX_PORTS]);
+
 /* Decoding functions: Extract the LLRs and save them in the srsran_pdcch_t object */
 
 SRSRAN_API int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
@@ -104,6 +116,23 @@ SRSRAN_API int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
 SRSRAN_API int
 srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg);
 
+/**
+ * @brief Decodes several DCI candidates after calling srsran_pdcch_extract_llr(). The result of every candidate is the
+ * same as calling srsran_pdcch_decode_msg() on it, but candidates with the same payload size share the Viterbi
+ * decoder SIMD lanes.
+ * @param q PDCCH object
+ * @param sf Subframe configuration
+ * @param dci_cfg DCI configuration
+ * @param msg Candidates, the location and format of each must be set
+ * @param nof_msg Number of candidates
+ * @return SRSRAN_SUCCESS if the candidates are decoded, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_pdcch_decode_msg_batch(srsran_pdcch_t*     q,
+                                             srsran_dl_sf_cfg_t* sf,
+                                             srsran_dci_cfg_t*   dci_cfg,
+                                             srsran_dci_msg_t*   msg,
+                                             uint32_t            nof_msg);
+
 /**
  * @brief Computes decoded DCI correlation. It encodes the given DCI message and compares it with the received LLRs
  * @param q PDCCH object
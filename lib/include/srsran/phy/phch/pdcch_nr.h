@@ -45,9 +45,10 @@
  * @brief PDCCH configuration initialization arguments
  */
 typedef struct {
-  bool disable_simd;
-  bool measure_evm;
-  bool measure_time;
+  bool     disable_simd;
+  bool     measure_evm;
+  bool     measure_time;
+  uint32_t polar_list_size; ///< Set to 4 or 8 for SC-list decoding with CRC-aided selection (requires SIMD)
 } srsran_pdcch_nr_args_t;
 
 /**
@@ -62,10 +63,13 @@ typedef struct SRSRAN_API {
   srsran_carrier_nr_t    carrier;
   srsran_coreset_t       coreset;
   srsran_crc_t           crc24c;
-  uint8_t*               c;         // Message bits with attached CRC
-  uint8_t*               d;         // encoded bits
-  uint8_t*               f;         // bits at the Rate matching output
-  uint8_t*               allocated; // Allocated polar bit buffer, encoder input, decoder output
+  uint8_t*               c;               // Message bits with attached CRC
+  uint8_t*               d;               // encoded bits
+  uint8_t*               f;               // bits at the Rate matching output
+  uint8_t*               allocated;       // Allocated polar bit buffer, encoder input, decoder output
+  int8_t*                llr_batch;       // Descrambled LLR of the candidates decoded in a batch
+  int8_t*                d_batch;         // Un-rate-matched LLR of the candidates decoded in a batch
+  uint8_t*               allocated_batch; // Decoder output of the candidates decoded in a batch
   cf_t*                  symbols;
   srsran_modem_table_t   modem_table;
   srsran_evm_buffer_t*   evm_buffer;
@@ -154,6 +158,58 @@ SRSRAN_API int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
                                       srsran_dci_msg_nr_t*    dci_msg,
                                       srsran_pdcch_nr_res_t*  res);
 
+/**
+ * @brief Extracts, equalises and demodulates a PDCCH candidate. The resulting LLR do not depend on the DCI size, RNTI
+ * or scrambling, so they can be decoded several times with srsran_pdcch_nr_decode_llr()
+ *
+ * @param[in,out] q provides PDCCH encoder/decoder object
+ * @param[in] slot_symbols provides slot resource grid
+ * @param[in] ce provides channel estimated resource elements
+ * @param[in] location provides the candidate location
+ * @param[out] llr Provides the 2 * SRSRAN_PDCCH_MAX_RE LLR buffer, 2 LLR per RE of the candidate are written
+ * @param[out] evm Provides the measured EVM, NAN if it is not configured
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_pdcch_nr_demodulate(srsran_pdcch_nr_t*           q,
+                                          cf_t*                        slot_symbols,
+                                          srsran_dmrs_pdcch_ce_t*      ce,
+                                          const srsran_dci_location_t* location,
+                                          int8_t*                      llr,
+                                          float*                       evm);
+
+/**
+ * @brief Decodes a DCI from the LLR of its candidate given by srsran_pdcch_nr_demodulate()
+ *
+ * @param[in,out] q provides PDCCH encoder/decoder object
+ * @param[in] llr provides the candidate LLR, they are not modified
+ * @param[in,out] dci_msg Provides with the DCI message location, RNTI, RNTI type and so on. Also, the message data
+ * buffer
+ * @param[out] res Provides the PDCCH result information, but the EVM
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_pdcch_nr_decode_llr(srsran_pdcch_nr_t*     q,
+                                          const int8_t*          llr,
+                                          srsran_dci_msg_nr_t*   dci_msg,
+                                          srsran_pdcch_nr_res_t* res);
+
+/**
+ * @brief Decodes several DCI from the LLR of their candidates, such as the candidates of a search space with the same
+ * DCI size and aggregation level. The polar decoder decodes them in a single batch.
+ *
+ * @param[in,out] q provides PDCCH encoder/decoder object
+ * @param[in] llr provides the LLR of every candidate, they are not modified
+ * @param[in,out] dci_msg Provides the DCI message of every candidate, they must have the same DCI size and aggregation
+ * level
+ * @param[out] res Provides the PDCCH result information of every candidate, but the EVM
+ * @param[in] nof_msg Number of DCI messages, up to SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_pdcch_nr_decode_llr_batch(srsran_pdcch_nr_t*     q,
+                                                const int8_t* const*   llr,
+                                                srsran_dci_msg_nr_t*   dci_msg,
+                                                srsran_pdcch_nr_res_t* res,
+                                                uint32_t               nof_msg);
+
 /**
  * @brief Stringifies NR PDCCH decoding information from the latest encoded/decoded transmission
  *
@@ -43,6 +43,7 @@
 #include "srsran/phy/phch/regs.h"
 #include "srsran/phy/phch/sch.h"
 #include "srsran/phy/scrambling/scrambling.h"
+#include "srsran/phy/scrambling/scrambling_cache.h"
 
 /* PDSCH object */
 typedef struct SRSRAN_API {
@@ -65,6 +66,8 @@ typedef struct SRSRAN_API {
 
   float* csi[SRSRAN_MAX_CODEWORDS]; /* Channel Strengh Indicator */
 
+  uint16_t* re_mask; /* Non PDSCH RE of every subframe, slot, symbol and PRB of the cell, bit k for subcarrier k */
+
   /* tx & rx objects */
   srsran_modem_table_t mod[SRSRAN_MOD_NITEMS];
 
@@ -76,6 +79,10 @@ typedef struct SRSRAN_API {
 
   void* coworker_ptr;
 
+  // Scrambling sequences of the decoded RNTIs, only for UE. They are fetched before the coworker starts
+  srsran_scrambling_cache_t scrambling_cache;
+  const uint8_t*            scrambling_seq[SRSRAN_MAX_CODEWORDS];
+
 } srsran_pdsch_t;
 
 typedef struct {
@@ -118,6 +118,15 @@ SRSRAN_API int srsran_phich_encode(srsran_phich_t*         q,
                                    uint8_t                 ack,
                                    cf_t*                   sf_symbols[SRSRAN_MAX_PORTS]);
 
+/* Encodes all the ACK/NACKs of a subframe. The ACK/NACKs of each PHICH group are combined before the scrambling, the
+ * precoding and the mapping, which are done once per group */
+SRSRAN_API int srsran_phich_encode_batch(srsran_phich_t*                q,
+                                         srsran_dl_sf_cfg_t*            sf,
+                                         const srsran_phich_resource_t* resources,
+                                         const uint8_t*                 acks,
+                                         uint32_t                       nof_acks,
+                                         cf_t*                          sf_symbols[SRSRAN_MAX_PORTS]);
+
 SRSRAN_API void srsran_phich_reset(srsran_phich_t* q, cf_t* slot_symbols[SRSRAN_MAX_PORTS]);
 
 SRSRAN_API uint32_t srsran_phich_ngroups(srsran_phich_t* q);
@@ -43,6 +43,9 @@
 #include "srsran/phy/phch/regs.h"
 #include "srsran/phy/phch/sch.h"
 #include "srsran/phy/scrambling/scrambling.h"
+
+#define SRSRAN_PMCH_CACHE_LEN 4
+
 typedef struct {
   srsran_sequence_t seq[SRSRAN_NOF_SF_X_FRAME];
 } srsran_pmch_seq_t;
@@ -52,6 +55,17 @@ typedef struct SRSRAN_API {
   uint16_t           area_id;
 } srsran_pmch_cfg_t;
 
+/* Rate matched codeword of a transmitted MCH payload, before scrambling */
+typedef struct {
+  bool     valid;
+  uint32_t tbs;
+  uint32_t nof_bits;
+  uint32_t mod;
+  uint32_t last_used;
+  uint8_t* data;
+  uint8_t* e;
+} srsran_pmch_cache_t;
+
 /* PMCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -76,6 +90,10 @@ typedef struct SRSRAN_API {
 
   srsran_sch_t dl_sch;
 
+  // MCCH and broadcast MTCH content repeats, identical payloads skip the turbo encoder
+  srsran_pmch_cache_t cache[SRSRAN_PMCH_CACHE_LEN];
+  uint32_t            cache_tick;
+
 } srsran_pmch_t;
 
 SRSRAN_API int srsran_pmch_init(srsran_pmch_t* q, uint32_t max_prb, uint32_t nof_rx_antennas);
@@ -102,6 +102,11 @@ typedef struct SRSRAN_API {
   srsran_dft_plan_t zc_fft;
   srsran_dft_plan_t zc_ifft;
 
+  // Correlation of every root sequence with the received bins, transformed by a single batched IFFT
+  cf_t*             corr_spec_batch;
+  cf_t*             corr_batch;
+  srsran_dft_plan_t zc_ifft_batch;
+
   cf_t* signal_fft;
   float detect_factor;
 
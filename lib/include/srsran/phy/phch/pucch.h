@@ -74,6 +74,9 @@ typedef struct SRSRAN_API {
   uint32_t n_cs_cell[SRSRAN_NSLOTS_X_FRAME][SRSRAN_CP_NORM_NSYMB];
   uint32_t f_gh[SRSRAN_NSLOTS_X_FRAME];
 
+  // Normalised 12-point DFT matrix, each row holds the twiddles of one frequency bin for Format 3 detection
+  cf_t dft_nre[SRSRAN_NRE][SRSRAN_NRE];
+
   cf_t* z;
   cf_t* z_tmp;
   cf_t* ce;
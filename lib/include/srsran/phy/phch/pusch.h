@@ -44,6 +44,7 @@
 #include "srsran/phy/phch/regs.h"
 #include "srsran/phy/phch/sch.h"
 #include "srsran/phy/scrambling/scrambling.h"
+#include "srsran/phy/scrambling/scrambling_cache.h"
 
 /* PUSCH object */
 typedef struct SRSRAN_API {
@@ -73,6 +74,9 @@ typedef struct SRSRAN_API {
   // EVM buffer
   srsran_evm_buffer_t* evm_buffer;
 
+  // Scrambling sequences of the decoded RNTIs, only for eNb
+  srsran_scrambling_cache_t scrambling_cache;
+
 } srsran_pusch_t;
 
 typedef struct SRSRAN_API {
@@ -98,6 +102,11 @@ SRSRAN_API void srsran_pusch_free(srsran_pusch_t* q);
 /* These functions modify the state of the object and may take some time */
 SRSRAN_API int srsran_pusch_set_cell(srsran_pusch_t* q, srsran_cell_t cell);
 
+/**
+ * @brief Drops the cached scrambling sequences of a RNTI, it shall be called when the RNTI is released
+ */
+SRSRAN_API void srsran_pusch_rem_rnti(srsran_pusch_t* q, uint16_t rnti);
+
 /**
  * Asserts PUSCH grant attributes are in range
  * @param grant Pointer to PUSCH grant
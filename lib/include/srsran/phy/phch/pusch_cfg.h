@@ -83,6 +83,8 @@ typedef struct SRSRAN_API {
   bool meas_ta_en;
   bool meas_evm_en;
 
+  bool chest_wiener_en; ///< Smooths the channel estimates with the SNR-selected Wiener filter instead of the 3-tap one
+
 } srsran_pusch_cfg_t;
 
 #endif // SRSRAN_PUSCH_CFG_H
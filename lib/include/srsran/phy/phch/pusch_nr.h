@@ -115,6 +115,12 @@ SRSRAN_API int srsran_pusch_nr_decode(srsran_pusch_nr_t*           q,
                                       cf_t*                        sf_symbols[SRSRAN_MAX_PORTS],
                                       srsran_pusch_res_nr_t*       data);
 
+/**
+ * @brief Decodes the UL-SCH transport blocks deferred by srsran_pusch_nr_decode() when the SCH arguments set
+ * defer_small_cb. See srsran_sch_nr_decode_flush()
+ */
+SRSRAN_API int srsran_pusch_nr_decode_flush(srsran_pusch_nr_t* q);
+
 SRSRAN_API uint32_t srsran_pusch_nr_rx_info(const srsran_pusch_nr_t*     q,
                                             const srsran_sch_cfg_nr_t*   cfg,
                                             const srsran_sch_grant_nr_t* grant,
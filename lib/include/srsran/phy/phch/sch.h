@@ -56,6 +56,9 @@ typedef struct SRSRAN_API {
 
   bool llr_is_8bit;
 
+  /* Stops decoding a code block when its hard decisions do not change between half-iterations */
+  bool early_stop_stable;
+
   /* buffers */
   uint8_t*         cb_in;
   uint8_t*         parity_bits;
@@ -71,6 +74,9 @@ typedef struct SRSRAN_API {
 
   srsran_uci_cqi_pusch_t uci_cqi;
 
+  /* Optional helper threads for decoding the code blocks of a transport block in parallel */
+  void* cb_workers;
+
 } srsran_sch_t;
 
 SRSRAN_API int srsran_sch_init(srsran_sch_t* q);
@@ -81,6 +87,17 @@ SRSRAN_API void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations)
 
 SRSRAN_API float srsran_sch_last_noi(srsran_sch_t* q);
 
+/**
+ * @brief Enables the parallel decoding of the code blocks of a transport block. It spawns nof_workers helper threads,
+ * each one with its own turbo decoder, which decode the code blocks together with the calling thread. Setting
+ * nof_workers to 0 disables the parallel decoding.
+ *
+ * @param q SCH object
+ * @param nof_workers Number of helper threads
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_sch_enable_cb_workers(srsran_sch_t* q, uint32_t nof_workers);
+
 SRSRAN_API int srsran_dlsch_encode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, uint8_t* data, uint8_t* e_bits);
 
 SRSRAN_API int srsran_dlsch_encode2(srsran_sch_t*       q,
@@ -90,6 +107,19 @@ SRSRAN_API int srsran_dlsch_encode2(srsran_sch_t*       q,
                                     int                 codeword_idx,
                                     uint32_t            nof_layers);
 
+/**
+ * Same as srsran_dlsch_encode2() but the e-bits are also scrambled with the sequence of the given seed (see
+ * srsran_sequence_pdsch_seed()), one code block at a time while they are still in cache, so they can be modulated right
+ * away.
+ */
+SRSRAN_API int srsran_dlsch_encode2_scrambled(srsran_sch_t*       q,
+                                              srsran_pdsch_cfg_t* cfg,
+                                              uint8_t*            data,
+                                              uint8_t*            e_bits,
+                                              int                 codeword_idx,
+                                              uint32_t            nof_layers,
+                                              uint32_t            seed);
+
 SRSRAN_API int srsran_dlsch_decode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, int16_t* e_bits, uint8_t* data);
 
 SRSRAN_API int srsran_dlsch_decode2(srsran_sch_t*       q,
@@ -114,6 +144,19 @@ SRSRAN_API int srsran_ulsch_decode(srsran_sch_t*       q,
                                    uint8_t*            data,
                                    srsran_uci_value_t* uci_data);
 
+/**
+ * Same as srsran_ulsch_decode() but the LLRs in q_bits are still scrambled with the unpacked sequence c_seq. Instead of
+ * running the descrambling, channel deinterleaving and rate dematching over the whole buffer one after the other, every
+ * code block gathers its bits straight from q_bits into the soft-buffer. Only the CQI bits are written to g_bits.
+ */
+SRSRAN_API int srsran_ulsch_decode_scrambled(srsran_sch_t*       q,
+                                             srsran_pusch_cfg_t* cfg,
+                                             int16_t*            q_bits,
+                                             int16_t*            g_bits,
+                                             uint8_t*            c_seq,
+                                             uint8_t*            data,
+                                             srsran_uci_value_t* uci_data);
+
 SRSRAN_API float srsran_sch_beta_cqi(uint32_t I_cqi);
 
 SRSRAN_API float srsran_sch_beta_ack(uint32_t I_harq);
@@ -33,6 +33,7 @@
 #include "srsran/config.h"
 #include "srsran/phy/common/phy_common_nr.h"
 #include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/ldpc/ldpc_accelerator.h"
 #include "srsran/phy/fec/ldpc/ldpc_decoder.h"
 #include "srsran/phy/fec/ldpc/ldpc_encoder.h"
 #include "srsran/phy/fec/ldpc/ldpc_rm.h"
@@ -76,16 +77,28 @@ typedef struct SRSRAN_API {
   /// LDPC Rate matcher
   srsran_ldpc_rm_t tx_rm;
   srsran_ldpc_rm_t rx_rm;
+
+  /// Optional helper threads decoding the code blocks of a transport block in parallel
+  void* cb_workers;
+
+  /// Optional lookaside LDPC accelerator queue, unused if its pointer is NULL
+  srsran_ldpc_accelerator_t accelerator;
+
+  /// Optional queue of transport blocks decoded together by srsran_sch_nr_decode_flush()
+  void* pending_tbs;
 } srsran_sch_nr_t;
 
 /**
  * @brief SCH encoder and decoder initialization arguments
  */
 typedef struct SRSRAN_API {
-  bool     disable_simd;
-  bool     decoder_use_flooded;
-  float    decoder_scaling_factor;
-  uint32_t max_nof_iter; ///< Maximum number of LDPC iterations
+  bool                                 disable_simd;
+  bool                                 decoder_use_flooded;
+  float                                decoder_scaling_factor;
+  uint32_t                             max_nof_iter;   ///< Maximum number of LDPC iterations
+  uint32_t                             nof_cb_workers; ///< Number of helper threads decoding code blocks in parallel
+  const srsran_ldpc_accelerator_dev_t* accelerator;    ///< Lookaside LDPC decoding device, NULL decodes in the CPU
+  bool                                 defer_small_cb; ///< Decode the small code blocks at srsran_sch_nr_decode_flush()
 } srsran_sch_nr_args_t;
 
 /**
@@ -165,6 +178,11 @@ SRSRAN_API int srsran_sch_nr_set_carrier(srsran_sch_nr_t* q, const srsran_carrie
  */
 SRSRAN_API void srsran_sch_nr_free(srsran_sch_nr_t* q);
 
+/**
+ * @brief Encodes a DL-SCH transport block
+ * @remark The circular buffers stay in the Tx soft-buffer, retransmissions with RV other than 0 of the same transport
+ * block only run the bit selection over them. In such case the data is ignored and it can be NULL
+ */
 SRSRAN_API int srsran_dlsch_nr_encode(srsran_sch_nr_t*        q,
                                       const srsran_sch_cfg_t* cfg,
                                       const srsran_sch_tb_t*  tb,
@@ -189,6 +207,20 @@ SRSRAN_API int srsran_ulsch_nr_decode(srsran_sch_nr_t*        q,
                                       int8_t*                 e_bits,
                                       srsran_sch_tb_res_nr_t* res);
 
+/**
+ * @brief Decodes the transport blocks queued by the previous srsran_dlsch_nr_decode() and srsran_ulsch_nr_decode()
+ * calls
+ *
+ * With srsran_sch_nr_args_t::defer_small_cb, the transport blocks made of a single code block with a lifting size the
+ * batch decoder takes are only rate dematched by the decode calls. Their code blocks are decoded together here, so that
+ * the small code blocks of several transport blocks of a slot share the SIMD lanes. The result structures and payloads
+ * passed to the decode calls must stay valid until then.
+ *
+ * @param q SCH object
+ * @return SRSRAN_SUCCESS if all the queued transport blocks were decoded, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_sch_nr_decode_flush(srsran_sch_nr_t* q);
+
 SRSRAN_API int
 srsran_sch_nr_tb_info(const srsran_sch_tb_t* tb, const srsran_sch_tb_res_nr_t* res, char* str, uint32_t str_len);
 
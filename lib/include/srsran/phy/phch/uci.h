@@ -84,6 +84,14 @@ SRSRAN_API int srsran_uci_encode_cqi_pusch(srsran_uci_cqi_pusch_t* q,
                                            uint32_t                Q_prime_ri,
                                            uint8_t*                q_bits);
 
+/**
+ * Number of coded symbols carrying CQI/PMI over PUSCH, as computed by srsran_uci_decode_cqi_pusch()
+ */
+SRSRAN_API uint32_t srsran_uci_cqi_pusch_Q_prime(srsran_pusch_cfg_t* cfg,
+                                                 uint32_t            cqi_len,
+                                                 float               beta,
+                                                 uint32_t            Q_prime_ri);
+
 SRSRAN_API int srsran_uci_decode_cqi_pusch(srsran_uci_cqi_pusch_t* q,
                                            srsran_pusch_cfg_t*     cfg,
                                            int16_t*                q_bits,
@@ -123,6 +131,22 @@ SRSRAN_API int srsran_uci_decode_ack_ri(srsran_pusch_cfg_t* cfg,
                                         uint32_t            nof_bits,
                                         bool                is_ri);
 
+/**
+ * Same as srsran_uci_decode_ack_ri() but the LLRs in q_bits have not been descrambled yet. They are descrambled with
+ * c_seq as they are read, q_bits is left untouched.
+ */
+SRSRAN_API int srsran_uci_decode_ack_ri_scrambled(srsran_pusch_cfg_t* cfg,
+                                                  int16_t*            q_bits,
+                                                  uint8_t*            c_seq,
+                                                  float               beta,
+                                                  uint32_t            H_prime_total,
+                                                  uint32_t            O_cqi,
+                                                  srsran_uci_bit_t*   ack_ri_bits,
+                                                  uint8_t*            data,
+                                                  bool*               valid,
+                                                  uint32_t            nof_bits,
+                                                  bool                is_ri);
+
 /**
  * Calculates the maximum number of coded symbols used by CQI-UCI over PUSCH
  */
@@ -0,0 +1,180 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         resample_poly.h
+ *
+ *  Description:  Polyphase rational resampler and polyphase DFT channelizer.
+ *
+ *                The resampler changes the sampling rate by interp/decim, e.g.
+ *                3/4 from 30.72 to 23.04 Msps, with a Kaiser windowed sinc
+ *                prototype split in interp branches. Only the branch of every
+ *                output sample is computed.
+ *
+ *                The channelizer splits a signal in nof_channels adjacent
+ *                channels, critically sampled at srate / nof_channels. Channel
+ *                k is centred at k * srate / nof_channels, the upper half of
+ *                the channels are the negative frequencies.
+ *
+ *                Both keep their filter state between calls, so a stream can be
+ *                processed in blocks of any size.
+ *
+ *  Reference:    fred harris, Multirate Signal Processing for Communication
+ *                Systems, chapters 7 and 9.
+ *****************************************************************************/
+
+#ifndef SRSRAN_RESAMPLE_POLY_H
+#define SRSRAN_RESAMPLE_POLY_H
+
+#include <stdint.h>
+
+#include "srsran/config.h"
+#include "srsran/phy/dft/dft.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SRSRAN_RESAMPLE_POLY_DEFAULT_TAPS 32
+
+/**
+ * @brief Polyphase rational resampler internal buffers
+ */
+typedef struct {
+  uint32_t interp;         ///< Interpolation factor, reduced with the decimation factor
+  uint32_t decim;          ///< Decimation factor, reduced with the interpolation factor
+  uint32_t taps_per_phase; ///< Number of coefficients of every polyphase branch
+  uint32_t phase;          ///< Branch of the next output sample, inputs produce no output until it is below interp
+  float*   taps;           ///< interp branches of taps_per_phase coefficients, time reversed
+  cf_t*    history;        ///< Last taps_per_phase - 1 input samples followed by the block being processed
+} srsran_resample_poly_t;
+
+/**
+ * @brief Polyphase DFT channelizer internal buffers and subcomponents
+ */
+typedef struct {
+  uint32_t          nof_channels;    ///< Number of channels and decimation factor
+  uint32_t          taps_per_branch; ///< Number of coefficients of every polyphase branch
+  float*            taps;            ///< nof_channels branches of taps_per_branch coefficients, time reversed
+  cf_t**            branches;        ///< Last taps_per_branch - 1 samples of every branch followed by the current block
+  cf_t*             dft_in;          ///< Branch filter outputs
+  cf_t*             dft_out;         ///< Channel samples
+  srsran_dft_plan_t ifft;            ///< Backward DFT across the branches
+} srsran_channelizer_t;
+
+/**
+ * Initialises a polyphase resampler that changes the sampling rate by interp/decim.
+ * @param q Object pointer
+ * @param interp Interpolation factor, e.g. the output sampling rate in Hz
+ * @param decim Decimation factor, e.g. the input sampling rate in Hz
+ * @param taps_per_phase Number of coefficients of every branch, SRSRAN_RESAMPLE_POLY_DEFAULT_TAPS if 0
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int
+srsran_resample_poly_init(srsran_resample_poly_t* q, uint32_t interp, uint32_t decim, uint32_t taps_per_phase);
+
+/**
+ * @brief Resets the filter state, the next input sample is the first of a new stream
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resample_poly_reset(srsran_resample_poly_t* q);
+
+/**
+ * @brief Gets the number of output samples the next call to srsran_resample_poly_run() produces from nof_in samples
+ * @note It is exactly nof_in * interp / decim when nof_in is a multiple of decim
+ * @param q Object pointer
+ * @param nof_in Number of input samples
+ * @return The number of output samples
+ */
+SRSRAN_API uint32_t srsran_resample_poly_get_nof_out(const srsran_resample_poly_t* q, uint32_t nof_in);
+
+/**
+ * @brief Gets the minimum number of input samples for the next call to srsran_resample_poly_run() to produce at least
+ * nof_out samples
+ * @param q Object pointer
+ * @param nof_out Number of output samples
+ * @return The number of input samples
+ */
+SRSRAN_API uint32_t srsran_resample_poly_get_nof_in(const srsran_resample_poly_t* q, uint32_t nof_out);
+
+/**
+ * @brief Gets the group delay of the resampler
+ * @param q Object pointer
+ * @return The delay in output samples
+ */
+SRSRAN_API float srsran_resample_poly_get_delay(const srsran_resample_poly_t* q);
+
+/**
+ * @brief Resamples a block of a stream
+ *
+ * @note Setting the input to NULL is equivalent of feeding zeroes
+ * @note Setting the output to NULL is equivalent of dropping output samples
+ *
+ * @param q Object pointer
+ * @param input Input samples
+ * @param output Output samples, srsran_resample_poly_get_nof_out() of them
+ * @param nof_in Number of input samples
+ * @return The number of output samples, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_resample_poly_run(srsran_resample_poly_t* q, const cf_t* input, cf_t* output, uint32_t nof_in);
+
+/**
+ * Frees the resampler buffers
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resample_poly_free(srsran_resample_poly_t* q);
+
+/**
+ * Initialises a channelizer of nof_channels channels.
+ * @param q Object pointer
+ * @param nof_channels Number of channels
+ * @param taps_per_branch Number of coefficients of every branch, SRSRAN_RESAMPLE_POLY_DEFAULT_TAPS if 0
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_channelizer_init(srsran_channelizer_t* q, uint32_t nof_channels, uint32_t taps_per_branch);
+
+/**
+ * @brief Resets the filter state, the next input sample is the first of a new stream
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_channelizer_reset(srsran_channelizer_t* q);
+
+/**
+ * @brief Splits a block of a stream in channels
+ * @param q Object pointer
+ * @param input Input samples
+ * @param output nof_channels buffers of nof_in / nof_channels samples
+ * @param nof_in Number of input samples, it must be a multiple of nof_channels
+ * @return The number of samples of every channel, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_channelizer_run(srsran_channelizer_t* q, const cf_t* input, cf_t** output, uint32_t nof_in);
+
+/**
+ * Frees the channelizer buffers and subcomponents
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_channelizer_free(srsran_channelizer_t* q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_RESAMPLE_POLY_H
@@ -51,11 +51,15 @@ typedef struct {
   float           tx_rx_gain_offset;
 } srsran_rf_t;
 
+/* Integer value of a unit amplitude sample in the sc16 format */
+#define SRSRAN_RF_SC16_FULL_SCALE 32767.0f
+
 typedef struct {
   double min_tx_gain;
   double max_tx_gain;
   double min_rx_gain;
   double max_rx_gain;
+  bool   sc16; ///< The sample buffers hold interleaved 16 bit IQ samples instead of cf_t
 } srsran_rf_info_t;
 
 typedef struct {
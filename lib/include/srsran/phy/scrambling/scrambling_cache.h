@@ -0,0 +1,131 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         scrambling_cache.h
+ *
+ *  Description:  Cache of the PDSCH/PUSCH scrambling sequences of a cell.
+ *
+ *                The sequence only depends on the RNTI, the codeword, the
+ *                subframe and the cell, so it is generated once, packed, the
+ *                first time a (RNTI, subframe, codeword) is used and kept until
+ *                the RNTI is removed. The appliers expand the packed bits into
+ *                sign masks in registers, avoiding the Gold sequence generator
+ *                in the per-subframe path.
+ *
+ *                The cache is not thread safe, every PDSCH/PUSCH object owns one.
+ *
+ *  Reference:    3GPP TS 36.211 version 10.0.0 Release 10 Sec. 5.3.1, 6.3.1
+ *****************************************************************************/
+
+#ifndef SRSRAN_SCRAMBLING_CACHE_H
+#define SRSRAN_SCRAMBLING_CACHE_H
+
+#include "srsran/config.h"
+#include "srsran/phy/common/phy_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SRSRAN_SCRAMBLING_CACHE_NOF_USERS 64
+
+/**
+ * @brief Sequences of one RNTI, NULL until the first use
+ */
+typedef struct SRSRAN_API {
+  uint16_t rnti;                                                   ///< 0 if the slot is free, it is not a valid C-RNTI
+  uint8_t* seq[SRSRAN_NOF_SF_X_FRAME][SRSRAN_MAX_CODEWORDS];       ///< Packed sequences, MSB first
+  uint32_t nof_bytes[SRSRAN_NOF_SF_X_FRAME][SRSRAN_MAX_CODEWORDS]; ///< Generated length, it grows on demand
+} srsran_scrambling_cache_user_t;
+
+/**
+ * @brief Open addressing table of users, linear probing from rnti % SRSRAN_SCRAMBLING_CACHE_NOF_USERS
+ */
+typedef struct SRSRAN_API {
+  uint32_t                       cell_id;
+  uint32_t                       max_bits; ///< Longest sequence that can be cached, in bits
+  srsran_scrambling_cache_user_t users[SRSRAN_SCRAMBLING_CACHE_NOF_USERS];
+} srsran_scrambling_cache_t;
+
+/**
+ * @brief Initialises an empty cache
+ * @param q Object pointer
+ * @param max_bits Maximum number of bits to scramble, e.g. SRSRAN_MAX_PRB * 12 * 12 * 8 for 256QAM
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_scrambling_cache_init(srsran_scrambling_cache_t* q, uint32_t max_bits);
+
+/**
+ * @brief Sets the physical cell identifier, the cached sequences are dropped if it changes
+ * @param q Object pointer
+ * @param cell_id Physical cell identifier
+ */
+SRSRAN_API void srsran_scrambling_cache_set_cell(srsran_scrambling_cache_t* q, uint32_t cell_id);
+
+/**
+ * @brief Gets the packed sequence of a RNTI, generating it if it was not cached
+ * @param q Object pointer
+ * @param rnti Radio network temporary identifier
+ * @param sf_idx Subframe index within the radio frame
+ * @param cw_idx Codeword index, 0 for PUSCH
+ * @param nof_bits Number of bits the caller is going to scramble
+ * @return The packed sequence, NULL if it cannot be cached (e.g. the table is full) and shall be generated on the fly
+ */
+SRSRAN_API const uint8_t* srsran_scrambling_cache_get(srsran_scrambling_cache_t* q,
+                                                      uint16_t                   rnti,
+                                                      uint32_t                   sf_idx,
+                                                      uint32_t                   cw_idx,
+                                                      uint32_t                   nof_bits);
+
+/**
+ * @brief Drops the sequences of a RNTI, it shall be called when the RNTI is released
+ * @param q Object pointer
+ * @param rnti Radio network temporary identifier
+ */
+SRSRAN_API void srsran_scrambling_cache_rem_rnti(srsran_scrambling_cache_t* q, uint16_t rnti);
+
+/**
+ * @brief Frees all the cached sequences
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_scrambling_cache_free(srsran_scrambling_cache_t* q);
+
+/**
+ * @brief Scrambles 8 bit soft bits, out[i] = -in[i] where the sequence bit is 1. The operation can be in-place
+ */
+SRSRAN_API void srsran_scrambling_packed_apply_c(const uint8_t* seq, const int8_t* in, int8_t* out, uint32_t len);
+
+/**
+ * @brief Scrambles 16 bit soft bits, out[i] = -in[i] where the sequence bit is 1. The operation can be in-place
+ */
+SRSRAN_API void srsran_scrambling_packed_apply_s(const uint8_t* seq, const int16_t* in, int16_t* out, uint32_t len);
+
+/**
+ * @brief Scrambles len packed bits, MSB first. The operation can be in-place
+ */
+SRSRAN_API void srsran_scrambling_packed_apply_bytes(const uint8_t* seq, const uint8_t* in, uint8_t* out, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_SCRAMBLING_CACHE_H
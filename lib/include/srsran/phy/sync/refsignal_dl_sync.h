@@ -52,6 +52,17 @@ SRSRAN_API void srsran_refsignal_dl_sync_free(srsran_refsignal_dl_sync_t* q);
 
 SRSRAN_API int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples);
 
+/**
+ * Same as srsran_refsignal_dl_sync_run() for a cell whose timing is already known. The correlation peak is only
+ * searched within +/- window samples of peak_idx_hint, the start of a frame of the cell in the buffer. The cell is
+ * reported as not found if the peak falls on the edge of the window, so that the caller can run a full search.
+ */
+SRSRAN_API int srsran_refsignal_dl_sync_track(srsran_refsignal_dl_sync_t* q,
+                                              cf_t*                       buffer,
+                                              uint32_t                    nsamples,
+                                              uint32_t                    peak_idx_hint,
+                                              uint32_t                    window);
+
 SRSRAN_API void srsran_refsignal_dl_sync_measure_sf(srsran_refsignal_dl_sync_t* q,
                                                     cf_t*                       buffer,
                                                     uint32_t                    sf_idx,
@@ -97,6 +97,7 @@ typedef struct SRSRAN_API {
   uint32_t symbol_sz;     ///< Current SSB symbol size (for the given base-band sampling rate)
   uint32_t corr_sz;       ///< Correlation size
   uint32_t corr_window;   ///< Correlation window length
+  int32_t  corr_f_offset; ///< Frequency offset the PSS correlation sequences were generated for
   uint32_t ssb_sz;        ///< SSB size in samples at the configured sampling rate
   int32_t  f_offset;      ///< SSB integer frequency offset (multiple of SCS) between DC and the SSB center
   uint32_t cp_sz;         ///< CP length for the given symbol size
@@ -118,6 +119,10 @@ typedef struct SRSRAN_API {
   cf_t* tmp_corr;                     ///< Temporal correlation frequency domain buffer
   cf_t* sf_buffer;                    ///< subframe buffer
   cf_t* pss_seq[SRSRAN_NOF_NID_2_NR]; ///< Possible frequency domain PSS for find
+
+  /// Signals independent of the PBCH payload, reused while the cell, half radio frame and SSB index do not change
+  cf_t     sync_grid[SRSRAN_SSB_NOF_RE]; ///< PSS, SSS and PBCH DMRS
+  uint32_t sync_grid_key;                ///< Cell, half radio frame and SSB index of sync_grid, 0 if not generated
 } srsran_ssb_t;
 
 /**
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         ue_cell_search_wb.h
+ *
+ *  Description:  Wideband LTE cell search.
+ *
+ *                Searches PSS/SSS on many carriers from a single wideband
+ *                capture. The capture is transformed once with a DFT, the band
+ *                around every candidate carrier is cut from the spectrum and
+ *                brought back to time at SRSRAN_CS_SAMP_FREQ, and the
+ *                sub-bands are searched in parallel worker threads.
+ *
+ *                The capture must last a whole number of 1.92 MHz samples,
+ *                e.g. 10 ms, and include at least one PSS and its SSS.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_UE_CELL_SEARCH_WB_H
+#define SRSRAN_UE_CELL_SEARCH_WB_H
+
+#include <stdbool.h>
+
+#include "srsran/config.h"
+#include "srsran/phy/dft/dft.h"
+#include "srsran/phy/ue/ue_cell_search.h"
+
+#define SRSRAN_CS_WB_DEFAULT_THRESHOLD 3.0f
+
+typedef struct SRSRAN_API {
+  double   srate_hz;    ///< Sampling rate of the wideband capture
+  uint32_t nof_samples; ///< Number of samples of the capture, nof_samples * 1.92 MHz / srate_hz must be an integer
+  uint32_t nof_threads; ///< Number of worker threads, 0 searches in the calling thread
+  float    threshold;   ///< PSS peak to side-lobe ratio threshold, SRSRAN_CS_WB_DEFAULT_THRESHOLD if 0
+} srsran_ue_cellsearch_wb_args_t;
+
+typedef struct SRSRAN_API {
+  double                        freq_offset_hz; ///< Carrier frequency relative to the capture centre frequency
+  bool                          found;          ///< A cell was detected on the carrier
+  srsran_ue_cellsearch_result_t cell;           ///< Strongest cell of the carrier, valid only if found
+} srsran_ue_cellsearch_wb_result_t;
+
+typedef struct SRSRAN_API {
+  srsran_ue_cellsearch_wb_args_t args;
+  uint32_t                       nof_sb_samples; ///< Number of samples of every sub-band, at SRSRAN_CS_SAMP_FREQ
+  srsran_dft_plan_t              fft;
+  cf_t*                          spectrum;
+
+  void*    workers;
+  uint32_t nof_workers;
+} srsran_ue_cellsearch_wb_t;
+
+SRSRAN_API int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t* q, const srsran_ue_cellsearch_wb_args_t* args);
+
+SRSRAN_API void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q);
+
+/**
+ * @brief Searches cells on nof_carriers carriers of a wideband capture
+ * @param q Wideband cell search object
+ * @param samples Capture of args.nof_samples samples
+ * @param freq_offsets_hz Carrier frequencies relative to the capture centre frequency, every carrier must fit in the
+ * captured bandwidth
+ * @param nof_carriers Number of carriers
+ * @param results One result per carrier, in the same order
+ * @return The number of carriers with a detected cell, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ue_cellsearch_wb_run(srsran_ue_cellsearch_wb_t*        q,
+                                           const cf_t*                       samples,
+                                           const double*                     freq_offsets_hz,
+                                           uint32_t                          nof_carriers,
+                                           srsran_ue_cellsearch_wb_result_t* results);
+
+#endif // SRSRAN_UE_CELL_SEARCH_WB_H
@@ -54,6 +54,19 @@ typedef struct SRSRAN_API {
   uint32_t                    nof_bits;
 } srsran_ue_dl_nr_pdcch_info_t;
 
+/**
+ * @brief PDCCH candidate location measured in the current slot. Its DMRS measurement and demodulated LLR do not depend
+ * on the DCI size, search space or RNTI, so they are shared by all the blind decoding attempts on the location
+ */
+typedef struct SRSRAN_API {
+  uint32_t                    coreset_id;
+  srsran_dci_location_t       location;
+  srsran_dmrs_pdcch_measure_t measure;
+  bool                        detected; ///< The DMRS passed the EPRE and correlation thresholds
+  float                       evm;
+  int8_t*                     llr; ///< Demodulated LLR, only valid if the candidate is detected
+} srsran_ue_dl_nr_pdcch_candidate_t;
+
 typedef struct SRSRAN_API {
   uint32_t max_prb;
   uint32_t nof_rx_antennas;
@@ -74,6 +87,11 @@ typedef struct SRSRAN_API {
   srsran_pdcch_nr_t             pdcch;
   srsran_dmrs_pdcch_ce_t*       pdcch_ce;
 
+  /// Candidate locations measured since the last FFT, the last entry is a scratch one used if all the others are taken
+  srsran_ue_dl_nr_pdcch_candidate_t pdcch_candidates[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR + 1];
+  uint32_t                          pdcch_candidates_count;
+  int8_t*                           pdcch_llr;
+
   /// Store Blind-search information from all possible candidate locations for debug purposes
   srsran_ue_dl_nr_pdcch_info_t pdcch_info[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
   uint32_t                     pdcch_info_count;
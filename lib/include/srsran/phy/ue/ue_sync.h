@@ -126,6 +126,7 @@ typedef struct SRSRAN_API {
   bool  cfo_correct_enable_track;
   bool  cfo_correct_enable_find;
   float cfo_current_value;
+  cf_t  cfo_phase; ///< Oscillator phase carried between consecutive CFO corrections
   float cfo_loop_bw_pss;
   float cfo_loop_bw_ref;
   float cfo_pss_min;
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file bfp.h
+ * @brief Block floating point compression of frequency-domain IQ, as used by the O-RAN 7.2x fronthaul (O-RAN WG4
+ * CUS-plane specification, annex A.1.2)
+ *
+ * Each PRB is compressed independently: the 24 I and Q values of its 12 resource elements share one 4 bit exponent,
+ * sent in the low nibble of the udCompParam byte, followed by the 24 mantissas of iq_width bits packed MSB first.
+ */
+
+#ifndef SRSRAN_BFP_H
+#define SRSRAN_BFP_H
+
+#include "srsran/phy/common/phy_common.h"
+
+/**
+ * @brief Minimum and maximum mantissa width in bits
+ */
+#define SRSRAN_BFP_MIN_IQ_WIDTH 1
+#define SRSRAN_BFP_MAX_IQ_WIDTH 16
+
+/**
+ * @brief Number of bytes of a compressed PRB, including its udCompParam byte
+ * @param iq_width Mantissa width in bits
+ */
+#define SRSRAN_BFP_PRB_BYTES(iq_width) (1 + (2 * SRSRAN_NRE * (iq_width) + 7) / 8)
+
+/**
+ * @brief Compresses nof_prb PRBs of resource elements
+ * @param symbols Resource elements, 12 per PRB
+ * @param scale Factor applied to the resource elements before they are rounded to 16 bit integers
+ * @param nof_prb Number of PRB
+ * @param iq_width Mantissa width in bits
+ * @param[out] buffer Compressed PRBs, SRSRAN_BFP_PRB_BYTES(iq_width) bytes each
+ * @return The number of bytes written if successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int
+srsran_bfp_compress(const cf_t* symbols, float scale, uint32_t nof_prb, uint32_t iq_width, uint8_t* buffer);
+
+/**
+ * @brief Decompresses nof_prb PRBs of resource elements
+ * @param buffer Compressed PRBs, SRSRAN_BFP_PRB_BYTES(iq_width) bytes each
+ * @param scale Factor the resource elements were compressed with, the 16 bit integers are divided by it
+ * @param nof_prb Number of PRB
+ * @param iq_width Mantissa width in bits
+ * @param[out] symbols Resource elements, 12 per PRB
+ * @return The number of bytes read if successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int
+srsran_bfp_decompress(const uint8_t* buffer, float scale, uint32_t nof_prb, uint32_t iq_width, cf_t* symbols);
+
+#endif // SRSRAN_BFP_H
@@ -45,6 +45,7 @@ typedef struct {
   uint16_t* byte_idx;
   uint8_t*  bit_mask;
   uint8_t   n_128;
+  uint32_t  nof_input_bytes;
 } srsran_bit_interleaver_t;
 
 SRSRAN_API void srsran_bit_interleaver_init(srsran_bit_interleaver_t* q, uint16_t* interleaver, uint32_t nof_bits);
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         cpu_features.h
+ *
+ *  Description:  Run-time detection of the SIMD extensions of the host CPU. The features are read once from CPUID
+ *                (and XGETBV, so that only register sets saved by the OS are reported) and cached for the lifetime
+ *                of the process. They are used to select, at run time, the kernels built with
+ *                ENABLE_SIMD_DISPATCH for an instruction set above the compile-time baseline.
+ *****************************************************************************/
+
+#ifndef SRSRAN_CPU_FEATURES_H
+#define SRSRAN_CPU_FEATURES_H
+
+#include "srsran/config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum SRSRAN_API {
+  SRSRAN_CPU_SSE41  = (1U << 0),
+  SRSRAN_CPU_AVX    = (1U << 1),
+  SRSRAN_CPU_AVX2   = (1U << 2),
+  SRSRAN_CPU_FMA    = (1U << 3),
+  SRSRAN_CPU_AVX512 = (1U << 4), // AVX512F, AVX512CD, AVX512BW and AVX512DQ, as used by the LV_HAVE_AVX512 kernels
+  SRSRAN_CPU_NEON   = (1U << 5),
+} srsran_cpu_feature_t;
+
+/* Returns the srsran_cpu_feature_t flags supported by the host CPU */
+SRSRAN_API uint32_t srsran_cpu_features(void);
+
+/* Returns true if the host CPU supports all the given srsran_cpu_feature_t flags */
+SRSRAN_API bool srsran_cpu_has(uint32_t features);
+
+/* Writes the names of the supported features, separated by spaces, and returns the number of characters written */
+SRSRAN_API int srsran_cpu_features_string(char* str, uint32_t str_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_CPU_FEATURES_H
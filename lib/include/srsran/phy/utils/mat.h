@@ -67,6 +67,22 @@ SRSRAN_API void srsran_mat_2x2_mmse_csi_gen(cf_t   y0,
 
 SRSRAN_API int srsran_mat_2x2_cn(cf_t h00, cf_t h01, cf_t h10, cf_t h11, float* cn);
 
+/* Maximum order of the batched Hermitian matrix inversion */
+#define SRSRAN_MAT_HERM_MAX_N 4
+
+/* Generic implementation for the inversion of an N x N Hermitian positive definite matrix (N <= 4) by Gauss-Jordan
+ * elimination without pivoting. The matrix a is overwritten */
+SRSRAN_API void srsran_mat_hermitian_inv_gen(cf_t     a[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N],
+                                             cf_t     r[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N],
+                                             uint32_t N);
+
+/* Inverts nof_re N x N Hermitian positive definite matrices (N <= 4) stored as arrays of elements, a[i][j][k] is the
+ * element (i, j) of the k-th matrix. SIMD registers carry the same element of consecutive matrices */
+SRSRAN_API int srsran_mat_hermitian_inv_soa(cf_t*    a[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N],
+                                            cf_t*    r[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N],
+                                            uint32_t N,
+                                            uint32_t nof_re);
+
 #ifdef LV_HAVE_SSE
 
 /* SSE implementation for complex reciprocal */
@@ -203,6 +219,42 @@ static inline void srsran_mat_2x2_mmse_simd(simd_cf_t  y0,
   srsran_mat_2x2_mmse_csi_simd(y0, y1, h00, h01, h10, h11, x0, x1, &csi0, &csi1, noise_estimate, norm);
 }
 
+/* SIMD implementation of srsran_mat_hermitian_inv_gen, every lane inverts a different matrix. The matrix a is
+ * overwritten */
+static inline void srsran_mat_hermitian_inv_simd(simd_cf_t a[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N],
+                                                 simd_cf_t r[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N],
+                                                 uint32_t  N)
+{
+  for (uint32_t i = 0; i < N; i++) {
+    for (uint32_t j = 0; j < N; j++) {
+      r[i][j] = (i == j) ? srsran_simd_cf_set1(1.0f) : srsran_simd_cf_zero();
+    }
+  }
+
+  for (uint32_t k = 0; k < N; k++) {
+    // The pivots of a Hermitian matrix are real, refine the approximate reciprocal with a Newton step
+    simd_f_t d   = srsran_simd_cf_re(a[k][k]);
+    simd_f_t rcp = srsran_simd_f_rcp(d);
+    rcp          = srsran_simd_f_mul(rcp, srsran_simd_f_sub(srsran_simd_f_set1(2.0f), srsran_simd_f_mul(d, rcp)));
+
+    for (uint32_t j = 0; j < N; j++) {
+      a[k][j] = srsran_simd_cf_mul(a[k][j], rcp);
+      r[k][j] = srsran_simd_cf_mul(r[k][j], rcp);
+    }
+
+    for (uint32_t i = 0; i < N; i++) {
+      if (i == k) {
+        continue;
+      }
+      simd_cf_t f = a[i][k];
+      for (uint32_t j = 0; j < N; j++) {
+        a[i][j] = srsran_simd_cf_sub(a[i][j], srsran_simd_cf_prod(f, a[k][j]));
+        r[i][j] = srsran_simd_cf_sub(r[i][j], srsran_simd_cf_prod(f, r[k][j]));
+      }
+    }
+  }
+}
+
 #endif /* SRSRAN_SIMD_CF_SIZE != 0 */
 
 typedef struct {
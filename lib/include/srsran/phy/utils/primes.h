@@ -28,15 +28,15 @@
 /**
  * @brief Finds the smallest prime number greater than n
  * @param[in] n Provide the number
- * @return A prime number below 1193, SRSRAN_ERROR code otherwise
+ * @return A prime number up to 3301, SRSRAN_ERROR code otherwise
  */
 SRSRAN_API int srsran_prime_greater_than(uint32_t n);
 
 /**
  * @brief Finds the biggest prime number lesser than n
- * @attention the maximum prime number it can return is 1193
+ * @attention the maximum prime number it can return is 3301
  * @param[in] n Provide the number
- * @return A prime number below 1193, SRSRAN_ERROR code otherwise
+ * @return A prime number up to 3301, SRSRAN_ERROR code otherwise
  */
 SRSRAN_API int srsran_prime_lower_than(uint32_t n);
 
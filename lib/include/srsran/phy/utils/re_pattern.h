@@ -75,6 +75,57 @@ SRSRAN_API int srsran_re_pattern_to_symbol_mask(const srsran_re_pattern_t* patte
  */
 SRSRAN_API int srsran_re_pattern_list_to_symbol_mask(const srsran_re_pattern_list_t* list, uint32_t l, bool* mask);
 
+/**
+ * @brief Calculates the pattern mask for an entire symbol from a RE pattern, one 12 bit word per RB where bit k is
+ * subcarrier k. It is the compact form of srsran_re_pattern_to_symbol_mask()
+ * @param pattern Provides the pattern
+ * @param l OFDM symbol index
+ * @param[out] rb_mask RB mask vector, the pattern is OR-ed into it
+ * @return SRSRAN_SUCCESS if the mask is computed successfully, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_re_pattern_to_rb_mask(const srsran_re_pattern_t* pattern, uint32_t l, uint16_t* rb_mask);
+
+/**
+ * @brief Calculates the RB mask for an entire symbol from a RE pattern list, see srsran_re_pattern_to_rb_mask()
+ * @param list Provides a list of patterns
+ * @param l OFDM symbol index
+ * @param[out] rb_mask RB mask vector, the patterns are OR-ed into it
+ * @return SRSRAN_SUCCESS if the mask is computed successfully, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_re_pattern_list_to_rb_mask(const srsran_re_pattern_list_t* list, uint32_t l, uint16_t* rb_mask);
+
+/**
+ * @brief Maps consecutive symbols into the RE of the allocated RB of a resource grid symbol, skipping the RE set in the
+ * RB mask. Runs of RB without masked RE are copied at once
+ * @param symbols Provides the symbols to map
+ * @param[out] grid Resource grid symbol, the masked RE are not written
+ * @param prb_mask Indicates the allocated RB
+ * @param rb_mask Masked RE of every RB, see srsran_re_pattern_to_rb_mask()
+ * @param nof_prb Number of RB of the symbol
+ * @return The number of mapped symbols
+ */
+SRSRAN_API uint32_t srsran_re_pattern_symbol_put(const cf_t*     symbols,
+                                                 cf_t*           grid,
+                                                 const bool*     prb_mask,
+                                                 const uint16_t* rb_mask,
+                                                 uint32_t        nof_prb);
+
+/**
+ * @brief Extracts the RE of the allocated RB of a resource grid symbol skipping the RE set in the RB mask, it is the
+ * inverse of srsran_re_pattern_symbol_put()
+ * @param grid Resource grid symbol
+ * @param[out] symbols Extracted symbols
+ * @param prb_mask Indicates the allocated RB
+ * @param rb_mask Masked RE of every RB, see srsran_re_pattern_to_rb_mask()
+ * @param nof_prb Number of RB of the symbol
+ * @return The number of extracted symbols
+ */
+SRSRAN_API uint32_t srsran_re_pattern_symbol_get(const cf_t*     grid,
+                                                 cf_t*           symbols,
+                                                 const bool*     prb_mask,
+                                                 const uint16_t* rb_mask,
+                                                 uint32_t        nof_prb);
+
 /**
  * @brief Merges a pattern into the pattern list, it either merges subcarrier or symbol mask or simply appends a new
  * pattern
@@ -27,6 +27,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+typedef struct srsran_ringbuffer_spsc_s srsran_ringbuffer_spsc_t;
+
 typedef struct {
   uint8_t*        buffer;
   bool            active;
@@ -37,6 +39,8 @@ typedef struct {
   pthread_mutex_t mutex;
   pthread_cond_t  write_cvar;
   pthread_cond_t  read_cvar;
+
+  srsran_ringbuffer_spsc_t* spsc; ///< Lock-free state, NULL unless initialised with srsran_ringbuffer_init_spsc()
 } srsran_ringbuffer_t;
 
 #ifdef __cplusplus
@@ -45,6 +49,21 @@ extern "C" {
 
 SRSRAN_API int srsran_ringbuffer_init(srsran_ringbuffer_t* q, int capacity);
 
+/**
+ * @brief Initialises the ring buffer for exactly one writer thread and one reader thread.
+ *
+ * Reads and writes do not lock: the write and read positions are atomic and sit on separate cache lines, and a thread
+ * only sleeps on a futex when the buffer is empty (reader) or full (writer). When possible, the buffer is mapped twice
+ * back to back so that every read and write is contiguous, also across the end of the buffer.
+ *
+ * Reset and resize shall only be called while neither side is reading or writing.
+ *
+ * @param q Object pointer
+ * @param capacity Capacity in bytes
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_ringbuffer_init_spsc(srsran_ringbuffer_t* q, int capacity);
+
 SRSRAN_API void srsran_ringbuffer_free(srsran_ringbuffer_t* q);
 
 SRSRAN_API void srsran_ringbuffer_reset(srsran_ringbuffer_t* q);
@@ -445,6 +445,50 @@ static inline simd_f_t srsran_simd_f_swap(simd_f_t a)
 #endif /* LV_HAVE_AVX512 */
 }
 
+/* Interleave the 64-bit elements (complex values) of a and b, taken from the lower half of both vectors */
+static inline simd_f_t srsran_simd_f_interleave_low(simd_f_t a, simd_f_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return (__m512)_mm512_permutex2var_pd((__m512d)a, _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), (__m512d)b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  __m256d lo = _mm256_unpacklo_pd((__m256d)a, (__m256d)b);
+  __m256d hi = _mm256_unpackhi_pd((__m256d)a, (__m256d)b);
+  return (__m256)_mm256_permute2f128_pd(lo, hi, 0x20);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return (__m128)_mm_unpacklo_pd((__m128d)a, (__m128d)b);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vcombine_f32(vget_low_f32(a), vget_low_f32(b));
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+/* Interleave the 64-bit elements (complex values) of a and b, taken from the upper half of both vectors */
+static inline simd_f_t srsran_simd_f_interleave_high(simd_f_t a, simd_f_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return (__m512)_mm512_permutex2var_pd((__m512d)a, _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15), (__m512d)b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  __m256d lo = _mm256_unpacklo_pd((__m256d)a, (__m256d)b);
+  __m256d hi = _mm256_unpackhi_pd((__m256d)a, (__m256d)b);
+  return (__m256)_mm256_permute2f128_pd(lo, hi, 0x31);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return (__m128)_mm_unpackhi_pd((__m128d)a, (__m128d)b);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vcombine_f32(vget_high_f32(a), vget_high_f32(b));
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
 static inline simd_f_t srsran_simd_f_hadd(simd_f_t a, simd_f_t b)
 {
 #ifdef LV_HAVE_AVX512
@@ -1885,6 +1929,26 @@ static inline simd_s_t srsran_simd_convert_2f_s(simd_f_t a, simd_f_t b)
 #endif /* LV_HAVE_AVX512 */
 }
 
+/* Loads SRSRAN_SIMD_F_SIZE 16-bit integers and converts them to floating point */
+static inline simd_f_t srsran_simd_convert_loadu_s_f(const int16_t* ptr)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i*)ptr)));
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)ptr)));
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)ptr)));
+#else
+#ifdef HAVE_NEON
+  return vcvtq_f32_s32(vmovl_s16(vld1_s16(ptr)));
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
 #endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_C16_SIZE */
 
 #if SRSRAN_SIMD_B_SIZE
@@ -2020,6 +2084,82 @@ static inline simd_b_t srsran_simd_b_sub(simd_b_t a, simd_b_t b)
 #endif /* LV_HAVE_AVX512 */
 }
 
+static inline simd_b_t srsran_simd_b_set1(int8_t x)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_set1_epi8(x);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_set1_epi8(x);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return _mm_set1_epi8(x);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vdupq_n_s8(x);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_b_t srsran_simd_b_add(simd_b_t a, simd_b_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_adds_epi8(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_adds_epi8(a, b);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return _mm_adds_epi8(a, b);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vqaddq_s8(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_b_t srsran_simd_b_min(simd_b_t a, simd_b_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_min_epi8(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_min_epi8(a, b);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return _mm_min_epi8(a, b);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vminq_s8(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_b_t srsran_simd_b_max(simd_b_t a, simd_b_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_max_epi8(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_max_epi8(a, b);
+#else /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  return _mm_max_epi8(a, b);
+#else /* LV_HAVE_SSE */
+#ifdef HAVE_NEON
+  return vmaxq_s8(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
 static inline simd_b_t srsran_simd_b_neg(simd_b_t a, simd_b_t b)
 {
 #ifdef LV_HAVE_AVX512
@@ -124,6 +124,14 @@ SRSRAN_API void srsran_vec_xor_bbb(const uint8_t* x, const uint8_t* y, uint8_t*
 SRSRAN_API float srsran_vec_acc_ff(const float* x, const uint32_t len);
 SRSRAN_API cf_t  srsran_vec_acc_cc(const cf_t* x, const uint32_t len);
 
+/*!
+ * @brief Backs the buffers allocated afterwards with transparent huge pages. Buffers of at least a huge page are aligned
+ * to it and advised to the kernel, and the heap is no longer trimmed so that the small ones stay in collapsible
+ * regions. Meant to be called once at start-up, the memory keeps following the NUMA policy of the allocating thread.
+ * @return false if huge pages were requested but are not supported by the platform
+ */
+SRSRAN_API bool srsran_vec_set_hugepages(bool enable);
+
 SRSRAN_API void* srsran_vec_malloc(uint32_t size);
 SRSRAN_API cf_t*  srsran_vec_cf_malloc(uint32_t size);
 SRSRAN_API float* srsran_vec_f_malloc(uint32_t size);
@@ -174,6 +182,10 @@ SRSRAN_API void srsran_vec_sum_fff(const float* x, const float* y, float* z, con
 SRSRAN_API void srsran_vec_sum_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len);
 SRSRAN_API void srsran_vec_sum_sss(const int16_t* x, const int16_t* y, int16_t* z, const uint32_t len);
 
+/* sum two vectors saturating the result to [-limit, limit], z=min(max(x+y, -limit), limit) */
+SRSRAN_API void
+srsran_vec_sum_sat_bbb(const int8_t* x, const int8_t* y, int8_t* z, const int8_t limit, const uint32_t len);
+
 /* substract two vectors z=x-y */
 SRSRAN_API void srsran_vec_sub_fff(const float* x, const float* y, float* z, const uint32_t len);
 SRSRAN_API void srsran_vec_sub_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len);
@@ -369,6 +381,13 @@ SRSRAN_API cf_t srsran_vec_gen_sine(cf_t amplitude, float freq, cf_t* z, int len
 
 SRSRAN_API void srsran_vec_apply_cfo(const cf_t* x, float cfo, cf_t* z, int len);
 
+/*!
+ * @brief Applies a frequency offset starting at the given oscillator phase, so that consecutive buffers can be
+ * corrected with a continuous phase. The oscillator is renormalized periodically to avoid amplitude drift.
+ * @return The oscillator phase for the sample following the last one
+ */
+SRSRAN_API cf_t srsran_vec_apply_cfo_phase(const cf_t* x, float cfo, cf_t phase, cf_t* z, int len);
+
 SRSRAN_API float srsran_vec_estimate_frequency(const cf_t* x, int len);
 
 /*!
@@ -40,6 +40,8 @@ SRSRAN_API void srsran_vec_sub_sss_simd(const int16_t* x, const int16_t* y, int1
 
 SRSRAN_API void srsran_vec_sub_bbb_simd(const int8_t* x, const int8_t* y, int8_t* z, int len);
 
+SRSRAN_API void srsran_vec_sum_sat_bbb_simd(const int8_t* x, const int8_t* y, int8_t* z, int8_t limit, int len);
+
 SRSRAN_API float srsran_vec_acc_ff_simd(const float* x, int len);
 
 SRSRAN_API cf_t srsran_vec_acc_cc_simd(const cf_t* x, int len);
@@ -104,6 +106,8 @@ SRSRAN_API cf_t srsran_vec_dot_prod_conj_ccc_simd(const cf_t* x, const cf_t* y,
 
 SRSRAN_API cf_t srsran_vec_dot_prod_ccc_simd(const cf_t* x, const cf_t* y, const int len);
 
+SRSRAN_API cf_t srsran_vec_dot_prod_cfc_simd(const cf_t* x, const float* y, const int len);
+
 #ifdef ENABLE_C16
 SRSRAN_API c16_t srsran_vec_dot_prod_ccc_c16i_simd(const c16_t* x, const c16_t* y, const int len);
 #endif /* ENABLE_C16 */
@@ -136,6 +140,8 @@ SRSRAN_API cf_t srsran_vec_gen_sine_simd(cf_t amplitude, float freq, cf_t* z, in
 
 SRSRAN_API void srsran_vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t* z, int len);
 
+SRSRAN_API cf_t srsran_vec_apply_cfo_phase_simd(const cf_t* x, float cfo, cf_t phase, cf_t* z, int len);
+
 SRSRAN_API float srsran_vec_estimate_frequency_simd(const cf_t* x, int len);
 
 /* SIMD Find Max functions */
@@ -24,14 +24,19 @@
 #include "rf_buffer.h"
 #include "rf_timestamp.h"
 #include "srsran/common/interfaces_common.h"
+#include "srsran/common/threads.h"
 #include "srsran/interfaces/radio_interfaces.h"
+#include "srsran/phy/agc/rx_correction.h"
+#include "srsran/phy/resampling/resample_poly.h"
 #include "srsran/phy/resampling/resampler.h"
 #include "srsran/phy/rf/rf.h"
 #include "srsran/radio/radio_base.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
 
+#include <condition_variable>
 #include <list>
+#include <memory>
 #include <string>
 
 #ifndef SRSRAN_RADIO_H
@@ -95,9 +100,43 @@ public:
   static void rf_msg_callback(void* arg, srsran_rf_error_t error);
 
 private:
+  /**
+   * Receives one RF device in a dedicated thread. With several devices, rx_now() receives them concurrently and waits
+   * for all of them, so the reception takes as long as the slowest device instead of the sum of all of them.
+   */
+  class rx_dev_thread final : public srsran::thread
+  {
+  public:
+    rx_dev_thread(radio* parent_, uint32_t device_idx_);
+    ~rx_dev_thread() final;
+
+    /// Starts receiving the buffer in the thread, the buffer and the timestamp shall be valid until wait_rx() returns
+    void start_rx(const rf_buffer_interface& buffer, srsran_timestamp_t* rxd_time);
+
+    /// Waits for the reception started by start_rx() to finish and returns its result
+    bool wait_rx();
+
+    /// Stops the thread, it shall not be receiving
+    void stop();
+
+  private:
+    void run_thread() override;
+
+    radio*                     parent     = nullptr;
+    uint32_t                   device_idx = 0;
+    std::mutex                 mutex;
+    std::condition_variable    cvar;
+    const rf_buffer_interface* rx_buffer = nullptr; ///< Pending reception, nullptr while idle
+    srsran_timestamp_t*        rx_time   = nullptr;
+    bool                       rx_done   = false;
+    bool                       rx_result = false;
+    bool                       running   = false;
+  };
+
   std::vector<srsran_rf_t>                                rf_devices  = {};
   std::vector<srsran_rf_info_t>                           rf_info     = {};
   std::vector<int32_t>                                    rx_offset_n = {};
+  std::vector<std::unique_ptr<rx_dev_thread> >            rx_threads  = {}; ///< One per device except the first
   rf_metrics_t                                            rf_metrics  = {};
   std::mutex                                              metrics_mutex;
   srslog::basic_logger&                                   logger = srslog::fetch_basic_logger("RF", false);
@@ -110,7 +149,34 @@ private:
   std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      rx_buffer;
   std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> interpolators = {};
   std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators    = {};
+  std::array<srsran_resample_poly_t, SRSRAN_MAX_CHANNELS> tx_resamplers = {}; ///< Non integer ratio interpolators
+  std::array<srsran_resample_poly_t, SRSRAN_MAX_CHANNELS> rx_resamplers = {}; ///< Non integer ratio decimators
   std::atomic<bool> decimator_busy = {false}; ///< Indicates the decimator is changing the rate
+  std::array<srsran_rx_correction_t, SRSRAN_MAX_CHANNELS> rx_corrections = {}; ///< Front-end impairments correction
+  bool              rx_correction_enable        = false;
+  std::atomic<bool> rx_correction_reset_pending = {false}; ///< The estimates are dropped after retuning
+
+  /**
+   * Transmission staged for a device. Consecutive buffers are appended while they are far enough from their deadline
+   * and sent together, with the timestamp and the start of burst flag of the first one
+   */
+  struct tx_coalesce_t {
+    std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS> buffers        = {};
+    uint32_t                                           nof_samples    = 0;
+    uint32_t                                           nof_buffers    = 0;
+    srsran_timestamp_t                                 tx_time        = {};
+    bool                                               start_of_burst = false;
+  };
+  std::vector<tx_coalesce_t> tx_coalesce;
+  uint32_t                   tx_coalesce_max_sf = 0;
+  std::atomic<double>        rx_time_now        = {0.0}; ///< Time of the last received sample, 0 if none
+
+  /// Expected timestamp of the next reception of a device, for detecting discontinuities in the received stream
+  struct rx_next_time_t {
+    srsran_timestamp_t time  = {};
+    double             srate = 0.0; ///< Sampling rate the time was calculated with, 0 if not known
+  };
+  std::vector<rx_next_time_t> rx_next_time;
 
   rf_timestamp_t    end_of_burst_time = {};
   std::atomic<bool> is_start_of_burst{false};
@@ -120,6 +186,7 @@ private:
   bool              tx_adv_negative    = false;
   bool              is_initialized     = false;
   bool              radio_is_streaming = false;
+  bool              rx_align_pending   = false; // Aligns the devices in the first reception after starting to stream
   bool              continuous_tx      = false;
   double            freq_offset        = 0.0;
   double            cur_tx_srate       = 0.0;
@@ -137,6 +204,10 @@ private:
                                                             ///< buffers
   constexpr static double tx_max_gap_zeros = 4e-3; ///< Maximum transmission gap to fill with zeros, otherwise the burst
                                                    ///< shall be stopped
+  constexpr static double rx_align_max_sec = 10e-3; ///< Maximum device misalignment to correct, larger ones are
+                                                    ///< reported since the devices are not synchronised
+  constexpr static double tx_coalesce_margin_sec = 1e-3; ///< Minimum time to deadline left to the staged samples when
+                                                         ///< they are sent
 
   // Define default values for known radios
   constexpr static int    uhd_default_tx_adv_samples    = 98;
@@ -198,6 +269,53 @@ private:
   // private unprotected tx_end implementation
   void tx_end_nolock();
 
+  /**
+   * Helper method for sending the mapped buffers of a device. If the coalescing is enabled, the buffers are staged and
+   * sent with the following ones, unless the deadline of the staged samples is too close
+   *
+   * @param device_idx Device index
+   * @param radio_buffers Physical channel buffers of the device
+   * @param nof_samples Number of samples to transmit
+   * @param tx_time Timestamp of the first sample
+   * @return it returns true if the transmission was successful, otherwise it returns false
+   */
+  bool tx_dev_send(const uint32_t&           device_idx,
+                   void**                    radio_buffers,
+                   uint32_t                  nof_samples,
+                   const srsran_timestamp_t& tx_time);
+
+  /**
+   * Helper method for handing samples to a device, it records the call duration and the time to deadline
+   *
+   * @param device_idx Device index
+   * @param radio_buffers Physical channel buffers of the device
+   * @param nof_samples Number of samples to transmit
+   * @param tx_time Timestamp of the first sample
+   * @param start_of_burst Indicates the samples start a burst
+   * @return it returns true if the transmission was successful, otherwise it returns false
+   */
+  bool tx_dev_send_timed(const uint32_t&           device_idx,
+                         void**                    radio_buffers,
+                         uint32_t                  nof_samples,
+                         const srsran_timestamp_t& tx_time,
+                         bool                      start_of_burst);
+
+  /**
+   * Helper method for sending the staged samples of a device, if any
+   *
+   * @param device_idx Device index
+   * @return it returns true if the transmission was successful, otherwise it returns false
+   */
+  bool tx_coalesce_flush(const uint32_t& device_idx);
+
+  /**
+   * Helper method for calculating the time left until the first staged sample of a device shall be transmitted
+   *
+   * @param device_idx Device index
+   * @return The time in seconds, 0 if the current time is not known
+   */
+  double tx_coalesce_margin(const uint32_t& device_idx);
+
   /**
    * Helper method for receiving over a single RF device. This function maps automatically the logical receive buffers
    * to the physical RF buffers for the given device.
@@ -209,6 +327,14 @@ private:
    */
   bool rx_dev(const uint32_t& device_idx, const rf_buffer_interface& buffer, srsran_timestamp_t* rxd_time);
 
+  /**
+   * Helper method for aligning the devices after starting the reception. The devices that are behind the newest device
+   * timestamp discard the difference through their Rx offset.
+   *
+   * @param rxd_time Receive time of every device
+   */
+  void align_rx_devices(rf_timestamp_interface& rxd_time);
+
   /**
    * Helper method for mapping logical channels into physical radio buffers.
    *
@@ -224,6 +350,17 @@ private:
                     uint32_t                   sample_offset,
                     const rf_buffer_interface& buffer,
                     void*                      radio_buffers[SRSRAN_MAX_CHANNELS]);
+
+  /**
+   * Helper method for setting a polyphase resampler for a non integer sampling rate ratio. It keeps the resampler state
+   * if the ratio does not change.
+   *
+   * @param q Resampler
+   * @param out_srate Output sampling rate
+   * @param in_srate Input sampling rate
+   * @return It returns true if the resampler is ready, otherwise it returns false.
+   */
+  bool set_resampler(srsran_resample_poly_t& q, double out_srate, double in_srate);
   bool start_agc(bool tx_gain_same_rx = false);
   void set_tx_adv(int nsamples);
   void set_tx_adv_neg(bool tx_adv_is_neg);
@@ -22,13 +22,62 @@
 #ifndef SRSRAN_RADIO_METRICS_H
 #define SRSRAN_RADIO_METRICS_H
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
 namespace srsran {
 
+/// Fixed width histogram of a time measured in microseconds. Values below MIN_US count in the first bin and values
+/// beyond the last bin count in the last one.
+template <int32_t MIN_US, int32_t BIN_US>
+struct rf_time_hist_t {
+  constexpr static uint32_t nof_bins = 16;
+  constexpr static int32_t  min_us   = MIN_US;
+  constexpr static int32_t  bin_us   = BIN_US;
+
+  std::array<uint32_t, nof_bins> bins     = {};
+  uint32_t                       count    = 0;
+  int64_t                        max_us   = INT64_MIN;
+  int64_t                        total_us = 0;
+
+  void add(int64_t value_us)
+  {
+    int64_t bin = (value_us - min_us) / bin_us;
+    bins[std::min(std::max(bin, (int64_t)0), (int64_t)nof_bins - 1)]++;
+    max_us = std::max(max_us, value_us);
+    total_us += value_us;
+    count++;
+  }
+  static int32_t bin_lower_us(uint32_t bin) { return min_us + (int32_t)bin * bin_us; }
+};
+
+/// Duration of the receive and send calls
+using rf_call_hist_t = rf_time_hist_t<0, 125>;
+
+/// Time left until the first sample of a transmission is due, when it is handed to the device. Negative values are
+/// late samples
+using rf_deadline_hist_t = rf_time_hist_t<-1000, 250>;
+
+/// RF health of a single device over a metrics period
+struct rf_dev_metrics_t {
+  rf_call_hist_t     rx_call;            ///< Receive call durations
+  rf_call_hist_t     tx_call;            ///< Send call durations
+  rf_deadline_hist_t tx_deadline;        ///< Time to deadline of every send
+  uint32_t           rx_gaps        = 0; ///< Receive timestamp discontinuities, e.g. samples dropped by an overflow
+  int64_t            rx_gap_samples = 0; ///< Samples missing (positive) or repeated (negative) in the discontinuities
+  uint32_t           tx_gaps        = 0; ///< Transmission gaps filled with zeros or closing the burst
+  uint32_t           tx_overlaps    = 0; ///< Transmissions overlapping the previous one, the overlap is discarded
+  uint32_t           tx_staged_max  = 0; ///< Maximum number of samples held by the transmission coalescing
+};
+
 typedef struct {
-  uint32_t rf_o;
-  uint32_t rf_u;
-  uint32_t rf_l;
-  bool     rf_error;
+  uint32_t                      rf_o;
+  uint32_t                      rf_u;
+  uint32_t                      rf_l;
+  bool                          rf_error;
+  std::vector<rf_dev_metrics_t> dev; ///< Health of each RF device
 } rf_metrics_t;
 
 } // namespace srsran
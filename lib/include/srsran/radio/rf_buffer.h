@@ -107,6 +107,7 @@ public:
     for (int i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
       this->sample_buffer[i] = other.sample_buffer[i];
     }
+    this->sc16 = other.sc16;
     return *this;
   }
 
@@ -125,6 +126,9 @@ public:
   {
     if (sample_buffer.at(channel_idx) == nullptr) {
       sample_buffer.at(channel_idx) = ptr;
+    } else if (ptr != nullptr and sc16) {
+      int16_t* dst = (int16_t*)sample_buffer.at(channel_idx);
+      srsran_vec_sum_sss((int16_t*)ptr, dst, dst, 2 * nof_samples);
     } else if (ptr != nullptr) {
       srsran_vec_sum_ccc(ptr, sample_buffer.at(channel_idx), sample_buffer.at(channel_idx), nof_samples);
     }
@@ -135,8 +139,9 @@ public:
   }
   void set_combine(const rf_buffer_interface& other)
   {
-    // Take the other number of samples always
+    // Take the other number of samples and sample format always
     set_nof_samples(other.get_nof_samples());
+    set_sc16(other.is_sc16());
     for (uint32_t ch = 0; ch < SRSRAN_MAX_CHANNELS; ch++) {
       set_combine(ch, other.get(ch));
     }
@@ -146,12 +151,20 @@ public:
   uint32_t size() override { return nof_subframes * SRSRAN_SF_LEN_MAX; }
   void     set_nof_samples(uint32_t n) override { nof_samples = n; }
   uint32_t get_nof_samples() const override { return nof_samples; }
+  /**
+   * Sets the sample format of the buffers. The sc16 buffers hold interleaved 16 bit IQ samples, half the size of cf_t,
+   * and are passed to the RF device without conversion. They cannot be resampled
+   * @param sc16_ true for sc16 samples, false for cf_t samples
+   */
+  void set_sc16(bool sc16_) { sc16 = sc16_; }
+  bool is_sc16() const override { return sc16; }
 
 private:
   std::array<cf_t*, SRSRAN_MAX_CHANNELS> sample_buffer = {};
   bool                                   allocated     = false;
   uint32_t                               nof_subframes = 0;
   uint32_t                               nof_samples   = 0;
+  bool                                   sc16          = false;
   void                                   free_all()
   {
     for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
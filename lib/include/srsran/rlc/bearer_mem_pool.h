@@ -22,6 +22,7 @@
 #ifndef SRSRAN_BEARER_MEM_POOL_H
 #define SRSRAN_BEARER_MEM_POOL_H
 
+#include "srsran/adt/pool/pool_metrics.h"
 #include <cstddef>
 
 namespace srsran {
@@ -31,6 +32,8 @@ void  reserve_rlc_memblocks(size_t nof_blocks);
 void* allocate_rlc_bearer(std::size_t size);
 void  deallocate_rlc_bearer(void* p);
 
+pool_metrics_t get_rlc_bearer_pool_metrics();
+
 } // namespace srsran
 
 #endif // SRSRAN_BEARER_MEM_POOL_H
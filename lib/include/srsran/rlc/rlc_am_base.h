@@ -28,6 +28,7 @@
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/rlc/rlc_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <pthread.h>
@@ -74,7 +75,11 @@ public:
 
   void stop() final;
 
-  void empty_queue() final { tx_base->empty_queue(); }
+  void empty_queue() final
+  {
+    tx_base->empty_queue();
+    tx_base->invalidate_buffer_state();
+  }
 
   rlc_mode_t get_mode() final { return rlc_mode_t::am; }
 
@@ -122,6 +127,9 @@ protected:
   std::mutex           metrics_mutex;
   rlc_bearer_metrics_t metrics = {};
 
+  // Adds a sampled SDU to the latency breakdown when its transmission starts
+  void trace_tx_sdu(byte_buffer_t& sdu);
+
   srsue::rrc_interface_rlc*  rrc  = nullptr;
   srsue::pdcp_interface_rlc* pdcp = nullptr;
 
@@ -148,22 +156,40 @@ public:
 
     void set_bsr_callback(bsr_callback_t callback);
 
+    /// Marks the cached buffer state as outdated. With force_report, the next buffer state is reported to the BSR
+    /// callback even if it did not change, e.g. because the MAC has deducted the bytes of the PDU it just read
+    void invalidate_buffer_state(bool force_report = false);
+    /// Gets the buffer state without the Tx mutex. Returns false if it must be recomputed under the Tx mutex
+    bool get_cached_buffer_state(uint32_t& n_bytes_newtx, uint32_t& n_bytes_prio) const;
+    /// Caches the buffer state computed under the Tx mutex and reports it to the BSR callback if it changed
+    void update_buffer_state(uint32_t lcid, uint32_t n_bytes_newtx, uint32_t n_bytes_prio);
+
     int              write_sdu(unique_byte_buffer_t sdu);
+    /// Disables the Tx. Once it returns, write_sdu() no longer stores SDUs in the queue
+    void             disable_tx();
     bool             sdu_queue_is_full();
     virtual void     discard_sdu(uint32_t pdcp_sn);
     virtual uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes) = 0;
 
-    bool                  tx_enabled = false;
+    std::atomic<bool>     tx_enabled = {false};
     byte_buffer_pool*     pool       = nullptr;
     srslog::basic_logger& logger;
     std::string           rb_name;
 
     bsr_callback_t bsr_callback;
 
-    // Tx SDU buffers
+    // Buffer state of the last computation. It is recomputed only after the Tx or Rx state has changed
+    std::atomic<bool>     buffer_state_dirty        = {true};
+    std::atomic<bool>     buffer_state_force_report = {true};
+    std::atomic<uint32_t> buffer_state_newtx        = {0};
+    std::atomic<uint32_t> buffer_state_prio         = {0};
+
+    // Tx SDU buffers. The queue has its own lock, so the SDUs are written and discarded without the Tx mutex
     byte_buffer_queue tx_sdu_queue;
+    // Serializes the SDU writes with the disabling of the Tx. It is never held while the PDUs are built
+    std::mutex sdu_mutex;
 
-    // Mutexes
+    // Mutex of the Tx window, the retx queue and the timers, held while the PDUs are built
     std::mutex mutex;
   };
 
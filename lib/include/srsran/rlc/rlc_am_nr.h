@@ -22,6 +22,8 @@
 #ifndef SRSRAN_RLC_AM_NR_H
 #define SRSRAN_RLC_AM_NR_H
 
+#include "srsran/adt/bounded_bitset.h"
+#include "srsran/adt/intrusive_list.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/timers.h"
@@ -80,17 +82,158 @@ struct rlc_am_nr_tx_state_t {
   uint32_t byte_without_poll;
 };
 
+/// Segment of a SDU in the Tx window. The segments are allocated from the rlc_am_nr_tx_segment_pool of the bearer
+struct rlc_am_nr_tx_segment : public intrusive_forward_list_element<> {
+  uint32_t so          = 0;
+  uint32_t payload_len = 0;
+};
+
+/// Fixed pool of the segments of the SDUs in the Tx window, so that the segmentation does not allocate memory
+class rlc_am_nr_tx_segment_pool
+{
+public:
+  const static size_t MAX_POOL_SIZE = 16384;
+
+  rlc_am_nr_tx_segment_pool()
+  {
+    for (rlc_am_nr_tx_segment& s : segments) {
+      free_list.push_front(&s);
+    }
+  }
+  rlc_am_nr_tx_segment_pool(const rlc_am_nr_tx_segment_pool&) = delete;
+  rlc_am_nr_tx_segment_pool(rlc_am_nr_tx_segment_pool&&)      = delete;
+  rlc_am_nr_tx_segment_pool& operator=(const rlc_am_nr_tx_segment_pool&) = delete;
+  rlc_am_nr_tx_segment_pool& operator=(rlc_am_nr_tx_segment_pool&&) = delete;
+
+  size_t nof_free_segments() const { return nof_free; }
+
+  /// Returns nullptr if all the segments are in use
+  rlc_am_nr_tx_segment* allocate(uint32_t so, uint32_t payload_len)
+  {
+    if (free_list.empty()) {
+      return nullptr;
+    }
+    rlc_am_nr_tx_segment* s = free_list.pop_front();
+    s->next_node            = nullptr;
+    s->so                   = so;
+    s->payload_len          = payload_len;
+    nof_free--;
+    return s;
+  }
+  void deallocate(rlc_am_nr_tx_segment* s)
+  {
+    free_list.push_front(s);
+    nof_free++;
+  }
+
+private:
+  intrusive_forward_list<rlc_am_nr_tx_segment>    free_list;
+  size_t                                          nof_free = MAX_POOL_SIZE;
+  std::array<rlc_am_nr_tx_segment, MAX_POOL_SIZE> segments;
+};
+
+/// Segments of a SDU in the Tx window, sorted by SO. They span the bytes of the SDU that have been transmitted
+class rlc_am_nr_tx_segment_list
+{
+  using list_t = intrusive_forward_list<rlc_am_nr_tx_segment>;
+
+public:
+  using iterator       = list_t::iterator;
+  using const_iterator = list_t::const_iterator;
+
+  rlc_am_nr_tx_segment_list() = default;
+  rlc_am_nr_tx_segment_list(const rlc_am_nr_tx_segment_list&) = delete;
+  rlc_am_nr_tx_segment_list(rlc_am_nr_tx_segment_list&& other) noexcept :
+    pool(other.pool), list(std::move(other.list)), tail(other.tail)
+  {
+    other.tail = nullptr;
+  }
+  rlc_am_nr_tx_segment_list& operator=(const rlc_am_nr_tx_segment_list&) = delete;
+  rlc_am_nr_tx_segment_list& operator                                    =(rlc_am_nr_tx_segment_list&& other) noexcept
+  {
+    if (this != &other) {
+      clear();
+      pool       = other.pool;
+      list       = std::move(other.list);
+      tail       = other.tail;
+      other.tail = nullptr;
+    }
+    return *this;
+  }
+  ~rlc_am_nr_tx_segment_list() { clear(); }
+
+  bool                        empty() const { return list.empty(); }
+  const rlc_am_nr_tx_segment& back() const { return *tail; }
+
+  /// Appends the segment [so, so + payload_len). Returns false if the pool has no free segments
+  bool push_back(rlc_am_nr_tx_segment_pool& pool_, uint32_t so, uint32_t payload_len)
+  {
+    rlc_am_nr_tx_segment* s = pool_.allocate(so, payload_len);
+    if (s == nullptr) {
+      return false;
+    }
+    pool = &pool_;
+    if (tail == nullptr) {
+      list.push_front(s);
+    } else {
+      tail->next_node = s;
+    }
+    tail = s;
+    return true;
+  }
+
+  /// Splits the segment that starts at "so" after its first "first_len" bytes. Returns false if there is no such
+  /// segment or no free segment in the pool
+  bool split(uint32_t so, uint32_t first_len)
+  {
+    for (rlc_am_nr_tx_segment& seg : list) {
+      if (seg.so != so) {
+        continue;
+      }
+      if (first_len >= seg.payload_len) {
+        return false;
+      }
+      rlc_am_nr_tx_segment* second = pool->allocate(so + first_len, seg.payload_len - first_len);
+      if (second == nullptr) {
+        return false;
+      }
+      second->next_node = seg.next_node;
+      seg.next_node     = second;
+      seg.payload_len   = first_len;
+      if (tail == &seg) {
+        tail = second;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  void clear()
+  {
+    while (not list.empty()) {
+      pool->deallocate(list.pop_front());
+    }
+    tail = nullptr;
+  }
+
+  iterator       begin() { return list.begin(); }
+  iterator       end() { return list.end(); }
+  const_iterator begin() const { return list.begin(); }
+  const_iterator end() const { return list.end(); }
+
+private:
+  rlc_am_nr_tx_segment_pool* pool = nullptr;
+  list_t                     list;
+  rlc_am_nr_tx_segment*      tail = nullptr;
+};
+
 struct rlc_amd_tx_pdu_nr {
-  const uint32_t         rlc_sn     = INVALID_RLC_SN;
-  uint32_t               pdcp_sn    = INVALID_RLC_SN;
-  rlc_am_nr_pdu_header_t header     = {};
-  unique_byte_buffer_t   sdu_buf    = nullptr;
-  uint32_t               retx_count = RETX_COUNT_NOT_STARTED;
-  struct pdu_segment {
-    uint32_t so          = 0;
-    uint32_t payload_len = 0;
-  };
-  std::list<pdu_segment> segment_list;
+  const uint32_t            rlc_sn     = INVALID_RLC_SN;
+  uint32_t                  pdcp_sn    = INVALID_RLC_SN;
+  rlc_am_nr_pdu_header_t    header     = {};
+  unique_byte_buffer_t      sdu_buf    = nullptr;
+  uint32_t                  retx_count = RETX_COUNT_NOT_STARTED;
+  rlc_am_nr_tx_segment_list segment_list;
   explicit rlc_amd_tx_pdu_nr(uint32_t sn) : rlc_sn(sn) {}
 };
 
@@ -161,6 +304,8 @@ private:
    * Ref: 3GPP TS 38.322 version 16.2.0 Section 7.1
    ***************************************************************************/
   struct rlc_am_nr_tx_state_t                              st = {};
+  // Declared before the Tx window, which returns its segments to the pool when destroyed
+  rlc_am_nr_tx_segment_pool                                segment_pool;
   std::unique_ptr<rlc_ringbuffer_base<rlc_amd_tx_pdu_nr> > tx_window;
 
   // Queues, buffers and container
@@ -260,6 +405,15 @@ public:
    */
   void update_segment_inventory(rlc_amd_rx_sdu_nr_t& rx_sdu) const;
 
+  /**
+   * @brief find_not_fully_received Finds the first SDU of the RX window that has not been fully received
+   * @param sn_start First SN of the search
+   * @param sn_end SN after the last SN of the search
+   * @return The first SN in [sn_start, sn_end) whose SDU is missing or incomplete, or sn_end if there is none
+   */
+  uint32_t find_not_fully_received(uint32_t sn_start, uint32_t sn_end) const;
+  void     mark_fully_received(uint32_t sn, bool value);
+
   // Metrics
   uint32_t get_sdu_rx_latency_ms() final;
   uint32_t get_rx_buffered_bytes() final;
@@ -281,6 +435,8 @@ private:
 
   // RX Window
   std::unique_ptr<rlc_ringbuffer_base<rlc_amd_rx_sdu_nr_t> > rx_window;
+  // SDUs of the RX window that are fully received, indexed by SN modulo the window size
+  bounded_bitset<am_window_size(rlc_am_nr_sn_size_t::size18bits)> rx_window_fully_received;
 
   // Mutexes
   std::mutex mutex;
@@ -23,6 +23,7 @@
 #define SRSRAN_RLC_METRICS_H
 
 #include "srsran/common/common.h"
+#include "srsran/common/pkt_trace.h"
 #include <iostream>
 
 namespace srsran {
@@ -45,6 +46,9 @@ typedef struct {
 
   // misc metrics
   uint32_t rx_buffered_bytes; //< sum of payload of PDUs buffered in rx_window
+
+  // Latency breakdown of the sampled DL SDUs, up to the MAC PDU assembly
+  pkt_latency_metrics_t tx_pkt_latency;
 } rlc_bearer_metrics_t;
 
 typedef struct {
@@ -122,11 +122,15 @@ protected:
     srsran::rolling_average<double> mean_pdu_latency_us;
 #endif
 
-    virtual uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes) = 0;
+    /// Builds a PDU of up to nof_bytes directly in the MAC payload
+    virtual uint32_t pack_data_pdu(uint8_t* payload, uint32_t nof_bytes) = 0;
 
     // helper functions
     virtual void debug_state() = 0;
     virtual void reset()       = 0;
+
+    // Adds a sampled SDU to the latency breakdown of the bearer when its transmission starts
+    void trace_tx_sdu(byte_buffer_t& sdu);
   };
 
   // Receiver sub-class base
@@ -23,6 +23,7 @@
 #define SRSRAN_RLC_UM_LTE_H
 
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_iovec.h"
 #include "srsran/common/common.h"
 #include "srsran/rlc/rlc_um_base.h"
 #include "srsran/upper/byte_buffer_queue.h"
@@ -57,13 +58,16 @@ private:
     rlc_um_lte_tx(rlc_um_base* parent_);
 
     bool     configure(const rlc_config_t& cfg, std::string rb_name);
-    uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
+    uint32_t pack_data_pdu(uint8_t* payload, uint32_t nof_bytes);
     void     discard_sdu(uint32_t discard_sn);
     uint32_t get_buffer_state();
     bool     sdu_queue_is_full();
 
   private:
+    static const uint32_t max_sdus_per_pdu = 128;
+
     void reset();
+    void add_sdu_segment(uint32_t to_move);
 
     /****************************************************************************
      * State variables and counters
@@ -71,6 +75,9 @@ private:
      ***************************************************************************/
     uint32_t vt_us = 0; // Send state. SN to be assigned for next PDU.
 
+    // SDU segments of the PDU being built
+    byte_buffer_iovec<max_sdus_per_pdu> tx_segments;
+
     // Metrics
     void debug_state();
   };
@@ -128,6 +135,8 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
                                  rlc_umd_sn_size_t     sn_size,
                                  rlc_umd_pdu_header_t* header);
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu);
+/// Writes the header at the start of payload. Returns the header length
+uint32_t rlc_um_write_data_pdu_header(const rlc_umd_pdu_header_t& header, uint8_t* payload);
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header);
 bool     rlc_um_start_aligned(uint8_t fi);
@@ -22,9 +22,12 @@
 #ifndef SRSRAN_RLC_UM_NR_H
 #define SRSRAN_RLC_UM_NR_H
 
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/adt/interval.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/interfaces/ue_interfaces.h"
+#include "srsran/rlc/rlc_am_data_structs.h"
 #include "srsran/rlc/rlc_um_base.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include <map>
@@ -39,6 +42,28 @@ typedef struct {
   unique_byte_buffer_t   buf;
 } rlc_umd_pdu_nr_t;
 
+// SDU under reassembly. The SDU buffer is reserved with the first received segment and every segment is copied in
+// place at its SO, so there is neither a buffer per segment nor a final copy to coalesce them.
+struct rlc_umd_sdu_nr_t {
+  // Received byte ranges, sorted and merged. Segments received in order extend the first range, so only the gaps left
+  // by segments received out of order take more ranges.
+  constexpr static uint32_t max_ranges = 4;
+
+  uint32_t                                                     rlc_sn           = 0;
+  uint32_t                                                     total_sdu_length = 0; ///< Known with the last segment
+  unique_byte_buffer_t                                         sdu;
+  srsran::bounded_vector<srsran::interval<uint32_t>, max_ranges> ranges;
+
+  rlc_umd_sdu_nr_t() = default;
+  explicit rlc_umd_sdu_nr_t(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
+
+  bool fully_received() const
+  {
+    return total_sdu_length > 0 and ranges.size() == 1 and ranges[0].start() == 0 and
+           ranges[0].stop() == total_sdu_length;
+  }
+};
+
 class rlc_um_nr : public rlc_um_base
 {
 public:
@@ -61,7 +86,7 @@ private:
     rlc_um_nr_tx(rlc_um_base* parent_);
 
     bool     configure(const rlc_config_t& cfg, std::string rb_name);
-    uint32_t build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes);
+    uint32_t pack_data_pdu(uint8_t* payload, uint32_t nof_bytes);
     void     discard_sdu(uint32_t discard_sn);
     uint32_t get_buffer_state();
 
@@ -105,7 +130,9 @@ private:
     unique_byte_buffer_t
     rlc_um_nr_strip_pdu_header(const rlc_um_nr_pdu_header_t& header, const uint8_t* payload, const uint32_t nof_bytes);
 
+    bool place_segment(const rlc_um_nr_pdu_header_t& header, const uint8_t* payload, const uint32_t nof_bytes);
     void handle_rx_buffer_update(const uint32_t sn);
+    void discard_sn_range(uint32_t first_sn, uint32_t end_sn, bool count_lost);
 
     uint32_t RX_Next_Reassembly = 0; // the earliest SN that is still considered for reassembly
     uint32_t RX_Timer_Trigger   = 0; // the SN following the SN which triggered t-Reassembly
@@ -115,16 +142,8 @@ private:
     uint32_t UM_Window_Size = 0;
     uint32_t mod            = 0; // Rx counter modulus
 
-    // Rx window
-    typedef struct {
-      std::map<uint32_t, rlc_umd_pdu_nr_t> segments; // Map of segments with SO as key
-      unique_byte_buffer_t                 sdu;
-      uint32_t                             next_expected_so;
-      uint32_t                             total_sdu_length;
-    } rlc_umd_pdu_segments_nr_t;
-    std::map<uint32_t, rlc_umd_pdu_segments_nr_t> rx_window;
-
-    void update_total_sdu_length(rlc_umd_pdu_segments_nr_t& pdu_segments, const rlc_umd_pdu_nr_t& rx_pdu);
+    // Rx window, one slot per SN of the reassembly window
+    std::unique_ptr<rlc_ringbuffer_base<rlc_umd_sdu_nr_t> > rx_window;
 
     // TS 38.322 Sec. 7.3
     srsran::timer_handler::unique_timer reassembly_timer; // to detect loss of RLC PDUs at lower layers
@@ -151,6 +170,8 @@ uint32_t rlc_um_nr_read_data_pdu_header(const uint8_t*            payload,
                                         rlc_um_nr_pdu_header_t*   header);
 
 uint32_t rlc_um_nr_write_data_pdu_header(const rlc_um_nr_pdu_header_t& header, byte_buffer_t* pdu);
+/// Writes the header at the start of payload. Returns the header length
+uint32_t rlc_um_nr_write_data_pdu_header(const rlc_um_nr_pdu_header_t& header, uint8_t* payload);
 
 uint32_t rlc_um_nr_packed_length(const rlc_um_nr_pdu_header_t& header);
 
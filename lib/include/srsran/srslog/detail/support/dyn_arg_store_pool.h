@@ -24,6 +24,9 @@
 
 #include "srsran/srslog/bundled/fmt/printf.h"
 #include "srsran/srslog/detail/support/backend_capacity.h"
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace srslog {
 
@@ -32,52 +35,84 @@ namespace detail {
 /// Keeps a pool of dynamic_format_arg_store objects. The main reason for this class is that the arg store objects are
 /// implemented with std::vectors, so we want to avoid allocating memory each time we create a new object. Instead,
 /// reserve memory for each vector during initialization and recycle the objects.
+/// The free objects are kept in a lock-free bounded ring, so that the logging threads do not contend on a mutex.
 class dyn_arg_store_pool
 {
+  using arg_store_t = fmt::dynamic_format_arg_store<fmt::printf_context>;
+
+  struct cell_t {
+    std::atomic<size_t> seq;
+    arg_store_t*        store;
+  };
+
 public:
-  dyn_arg_store_pool()
+  dyn_arg_store_pool() : pool(SRSLOG_QUEUE_CAPACITY), cells(new cell_t[SRSLOG_QUEUE_CAPACITY])
   {
-    pool.resize(SRSLOG_QUEUE_CAPACITY);
-    for (auto& elem : pool) {
+    for (size_t i = 0; i != SRSLOG_QUEUE_CAPACITY; ++i) {
       // Reserve for 10 normal and 2 named arguments.
-      elem.reserve(10, 2);
-    }
-    free_list.reserve(SRSLOG_QUEUE_CAPACITY);
-    for (auto& elem : pool) {
-      free_list.push_back(&elem);
+      pool[i].reserve(10, 2);
+      cells[i].seq.store(i + 1, std::memory_order_relaxed);
+      cells[i].store = &pool[i];
     }
+    enqueue_pos.store(SRSLOG_QUEUE_CAPACITY, std::memory_order_relaxed);
   }
 
   /// Returns a pointer to a free dyn arg store object, otherwise returns nullptr.
-  fmt::dynamic_format_arg_store<fmt::printf_context>* alloc()
+  arg_store_t* alloc()
   {
-    scoped_lock lock(m);
-    if (free_list.empty()) {
-      return nullptr;
+    size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell_t&  cell = cells[pos % SRSLOG_QUEUE_CAPACITY];
+      size_t   seq  = cell.seq.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          arg_store_t* p = cell.store;
+          cell.seq.store(pos + SRSLOG_QUEUE_CAPACITY, std::memory_order_release);
+          return p;
+        }
+      } else if (diff < 0) {
+        // Pool is empty.
+        return nullptr;
+      } else {
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
     }
-
-    auto* p = free_list.back();
-    free_list.pop_back();
-
-    return p;
   }
 
   /// Deallocate the given dyn arg store object returning it to the pool.
-  void dealloc(fmt::dynamic_format_arg_store<fmt::printf_context>* p)
+  void dealloc(arg_store_t* p)
   {
     if (!p) {
       return;
     }
 
     p->clear();
-    scoped_lock lock(m);
-    free_list.push_back(p);
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell_t&  cell = cells[pos % SRSLOG_QUEUE_CAPACITY];
+      size_t   seq  = cell.seq.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.store = p;
+          cell.seq.store(pos + 1, std::memory_order_release);
+          return;
+        }
+      } else if (diff < 0) {
+        // Only reachable if an object is deallocated twice.
+        return;
+      } else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
   }
 
 private:
-  std::vector<fmt::dynamic_format_arg_store<fmt::printf_context> > pool;
-  std::vector<fmt::dynamic_format_arg_store<fmt::printf_context>*> free_list;
-  mutable mutex                                                    m;
+  std::vector<arg_store_t>  pool;
+  std::unique_ptr<cell_t[]> cells;
+  std::atomic<size_t>       enqueue_pos{0};
+  std::atomic<size_t>       dequeue_pos{0};
 };
 
 } // namespace detail
@@ -25,89 +25,252 @@
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/srslog/detail/support/backend_capacity.h"
 #include "srsran/srslog/detail/support/thread_utils.h"
+#include <array>
+#include <atomic>
+#include <memory>
 
 namespace srslog {
 
 namespace detail {
 
-//: TODO: this is a temp work queue.
-
-/// Thread safe generic data type work queue.
+/// Thread safe generic data type work queue, with many producers and a single consumer.
+/// Each producer thread gets its own single producer single consumer ring, so producers never contend with each
+/// other nor take a lock. The consumer serves the rings in turn, thus the elements of one producer are popped in
+/// order, but there is no ordering between elements of different producers. The ring of a thread that exits is
+/// reused by the next thread that registers.
+/// Rings only hold capacity / 8 elements each, to bound the memory of many producers. When the ring of a thread is
+/// full, or all rings are taken, the thread spills into a shared queue of the full capacity protected by a mutex, so
+/// a single thread can still queue at least capacity elements before any of them is discarded. A spilling thread
+/// keeps using the shared queue until all its spilled elements are popped, and the consumer pops the ring of a
+/// thread before its spilled elements, which keeps the per thread order.
 template <typename T, size_t capacity = SRSLOG_QUEUE_CAPACITY>
 class work_queue
 {
-  srsran::dyn_circular_buffer<T> queue;
-  mutable mutex                  m;
-  static constexpr size_t        threshold = capacity * 0.98;
+  static constexpr size_t max_producers = 64;
+  static constexpr size_t ring_capacity = (capacity / 8) < 16 ? 16 : (capacity / 8);
+  static constexpr size_t threshold     = capacity * 0.98;
+  /// Maximum number of consecutive pops from the same producer ring.
+  static constexpr size_t max_batch = 64;
+
+  /// Ring written by a single producer thread at a time, and read by the consumer.
+  class producer_ring
+  {
+  public:
+    producer_ring() : slots(ring_capacity) {}
+
+    bool push(T&& value)
+    {
+      size_t t = tail.load(std::memory_order_relaxed);
+      if (t - head.load(std::memory_order_acquire) == slots.size()) {
+        return false;
+      }
+      slots[t % slots.size()] = std::move(value);
+      tail.store(t + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool try_pop(T& value)
+    {
+      size_t h = head.load(std::memory_order_relaxed);
+      if (h == tail.load(std::memory_order_acquire)) {
+        return false;
+      }
+      value = std::move(slots[h % slots.size()]);
+      head.store(h + 1, std::memory_order_release);
+      return true;
+    }
+
+    size_t size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+
+    /// Set while a producer thread owns this ring.
+    std::atomic<bool> in_use{true};
+    /// Number of elements of the owner thread waiting in the shared queue.
+    std::atomic<size_t> nof_spilled{0};
+
+  private:
+    std::vector<T> slots;
+    // Keep the producer and consumer indexes in different cache lines.
+    char                pad0[64];
+    std::atomic<size_t> head{0};
+    char                pad1[64];
+    std::atomic<size_t> tail{0};
+  };
+
+  /// Rings registered by the calling thread, released when the thread exits.
+  struct producer_cache {
+    struct entry_t {
+      uint64_t                       queue_id;
+      std::shared_ptr<producer_ring> ring;
+    };
+    std::vector<entry_t> entries;
+
+    ~producer_cache()
+    {
+      for (auto& e : entries) {
+        e.ring->in_use.store(false, std::memory_order_release);
+      }
+    }
+  };
+
+  static uint64_t next_queue_id()
+  {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+  }
 
 public:
-  work_queue() : queue(capacity) {}
+  work_queue() : queue_id(next_queue_id()), shared_queue(capacity) {}
 
   work_queue(const work_queue&) = delete;
   work_queue& operator=(const work_queue&) = delete;
 
   /// Inserts a new element into the back of the queue. Returns false when the
   /// queue is full, otherwise true.
-  bool push(const T& value)
-  {
-    m.lock();
-    // Discard the new element if we reach the maximum capacity.
-    if (queue.full()) {
-      m.unlock();
-      return false;
-    }
-    queue.push(value);
-    m.unlock();
-
-    return true;
-  }
+  bool push(const T& value) { return push(T(value)); }
 
   /// Inserts a new element into the back of the queue. Returns false when the
   /// queue is full, otherwise true.
   bool push(T&& value)
   {
-    m.lock();
+    producer_ring* ring = get_producer_ring();
+    if (ring != nullptr and ring->nof_spilled.load(std::memory_order_acquire) == 0 and ring->push(std::move(value))) {
+      return true;
+    }
+
+    scoped_lock lock(m);
     // Discard the new element if we reach the maximum capacity.
-    if (queue.full()) {
-      m.unlock();
+    if (shared_queue.full()) {
       return false;
     }
-    queue.push(std::move(value));
-    m.unlock();
-
+    if (ring != nullptr) {
+      ring->nof_spilled.fetch_add(1, std::memory_order_relaxed);
+    }
+    shared_queue.push(shared_entry{std::move(value), ring});
     return true;
   }
 
   /// Extracts the top most element from the queue if it exists.
   /// Returns a pair with a bool indicating if the pop has been successful.
+  /// NOTE: Only one thread may pop elements.
   std::pair<bool, T> try_pop()
   {
-    m.lock();
+    std::pair<bool, T> item{false, T()};
 
-    if (queue.empty()) {
-      m.unlock();
-      return {false, T()};
+    // Index nof_rings stands for the shared queue. The current ring is visited twice, in case its batch was over.
+    size_t nof_rings = nof_producers.load(std::memory_order_acquire);
+    for (size_t i = 0; i <= nof_rings + 1; ++i) {
+      if (cur_ring > nof_rings) {
+        cur_ring = 0;
+      }
+      if (batch_count < max_batch and pop_from(cur_ring, nof_rings, item.second)) {
+        batch_count++;
+        item.first = true;
+        return item;
+      }
+      cur_ring++;
+      batch_count = 0;
     }
+    return item;
+  }
 
-    // Here we have been woken up normally.
-    T Item = std::move(queue.top());
-    queue.pop();
+  /// Capacity of the shared queue, elements get discarded when it is full.
+  size_t get_capacity() const { return capacity; }
 
-    m.unlock();
+  /// Capacity of the ring of each producer thread, before it spills into the shared queue.
+  size_t get_ring_capacity() const { return ring_capacity; }
 
-    return {true, std::move(Item)};
+  /// Number of elements in the queue. It may be outdated as soon as it is returned.
+  size_t size() const
+  {
+    size_t nof_rings = nof_producers.load(std::memory_order_acquire);
+    size_t count     = 0;
+    for (size_t i = 0; i < nof_rings; ++i) {
+      count += rings[i]->size();
+    }
+    scoped_lock lock(m);
+    return count + shared_queue.size();
   }
 
-  /// Capacity of the queue.
-  size_t get_capacity() const { return capacity; }
-
   /// Returns true when the queue is almost full, otherwise returns false.
   bool is_almost_full() const
   {
     scoped_lock lock(m);
+    return shared_queue.size() > threshold;
+  }
+
+private:
+  bool pop_from(size_t idx, size_t nof_rings, T& value)
+  {
+    if (idx < nof_rings) {
+      return rings[idx]->try_pop(value);
+    }
+    scoped_lock lock(m);
+    if (shared_queue.empty()) {
+      return false;
+    }
+    producer_ring* owner = shared_queue.top().owner;
+    // The ring of the owner only holds elements older than the spilled ones, serve them first.
+    if (owner != nullptr and owner->try_pop(value)) {
+      return true;
+    }
+    value = std::move(shared_queue.top().value);
+    shared_queue.pop();
+    if (owner != nullptr) {
+      owner->nof_spilled.fetch_sub(1, std::memory_order_release);
+    }
+    return true;
+  }
 
-    return queue.size() > threshold;
+  /// Returns the ring of the calling thread, registering it on the first call. Returns nullptr when all rings are
+  /// taken.
+  producer_ring* get_producer_ring()
+  {
+    thread_local producer_cache cache;
+    for (auto& e : cache.entries) {
+      if (e.queue_id == queue_id) {
+        return e.ring.get();
+      }
+    }
+
+    std::shared_ptr<producer_ring> ring;
+    {
+      scoped_lock lock(registration_mutex);
+      size_t      nof_rings = nof_producers.load(std::memory_order_relaxed);
+      // Reuse the ring of a thread that has exited.
+      for (size_t i = 0; i < nof_rings and ring == nullptr; ++i) {
+        bool expected = false;
+        if (rings[i]->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+          ring = rings[i];
+        }
+      }
+      if (ring == nullptr) {
+        if (nof_rings == max_producers) {
+          return nullptr;
+        }
+        ring             = std::make_shared<producer_ring>();
+        rings[nof_rings] = ring;
+        nof_producers.store(nof_rings + 1, std::memory_order_release);
+      }
+    }
+    cache.entries.push_back({queue_id, ring});
+    return ring.get();
   }
+
+  /// Element of the shared queue, along with the ring of the thread that spilled it, if any.
+  struct shared_entry {
+    T              value;
+    producer_ring* owner = nullptr;
+  };
+
+  const uint64_t                                            queue_id;
+  std::array<std::shared_ptr<producer_ring>, max_producers> rings;
+  std::atomic<size_t>                                       nof_producers{0};
+  mutex                                                     registration_mutex;
+  srsran::dyn_circular_buffer<shared_entry>                 shared_queue;
+  mutable mutex                                             m;
+  // Consumer state.
+  size_t cur_ring    = 0;
+  size_t batch_count = 0;
 };
 
 } // namespace detail
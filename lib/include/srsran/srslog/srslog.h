@@ -25,6 +25,7 @@
 #include "srsran/srslog/detail/support/any.h"
 #include "srsran/srslog/logger.h"
 #include "srsran/srslog/shared_types.h"
+#include <chrono>
 
 namespace srslog {
 
@@ -195,6 +196,19 @@ sink& fetch_file_sink(const std::string&             path,
                       bool                           force_flush = false,
                       std::unique_ptr<log_formatter> f           = get_default_log_formatter());
 
+/// Returns an instance of a sink that writes into a file in the specified path
+/// from a helper thread, so that the backend thread never blocks on file IO.
+/// Specifying a max_size value different to zero will make the sink create a
+/// new file each time the current file exceeds this value. The units of
+/// max_size are bytes.
+/// Specifying a rotation_period value different to zero will make the sink
+/// create a new file each time the current file gets older than this value.
+/// NOTE: Any '#' characters in the path will get removed.
+sink& fetch_async_file_sink(const std::string&             path,
+                            size_t                         max_size        = 0,
+                            std::chrono::seconds           rotation_period = std::chrono::seconds(0),
+                            std::unique_ptr<log_formatter> f               = get_default_log_formatter());
+
 /// Returns an instance of a sink that writes into syslog
 /// preamble: The string  prepended to every message, If ident is "", the program name is used.
 /// log_local: custom unused facilities that syslog provides which can be used by the user
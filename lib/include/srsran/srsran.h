@@ -48,6 +48,7 @@ extern "C" {
 
 #include "srsran/phy/ch_estimation/chest_dl.h"
 #include "srsran/phy/ch_estimation/chest_ul.h"
+#include "srsran/phy/ch_estimation/chest_ul_srs_batch.h"
 #include "srsran/phy/ch_estimation/csi_rs.h"
 #include "srsran/phy/ch_estimation/dmrs_pdcch.h"
 #include "srsran/phy/ch_estimation/dmrs_sch.h"
@@ -58,6 +59,7 @@ extern "C" {
 #include "srsran/phy/resampling/decim.h"
 #include "srsran/phy/resampling/interp.h"
 #include "srsran/phy/resampling/resample_arb.h"
+#include "srsran/phy/resampling/resample_poly.h"
 
 #include "srsran/phy/channel/ch_awgn.h"
 
@@ -119,6 +121,7 @@ extern "C" {
 #include "srsran/phy/phch/uci_nr.h"
 
 #include "srsran/phy/ue/ue_cell_search.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
 #include "srsran/phy/ue/ue_dl.h"
 #include "srsran/phy/ue/ue_dl_nr.h"
 #include "srsran/phy/ue/ue_mib.h"
@@ -133,6 +136,7 @@ extern "C" {
 #include "srsran/phy/gnb/gnb_ul.h"
 
 #include "srsran/phy/scrambling/scrambling.h"
+#include "srsran/phy/scrambling/scrambling_cache.h"
 
 #include "srsran/phy/sync/cfo.h"
 #include "srsran/phy/sync/cp.h"
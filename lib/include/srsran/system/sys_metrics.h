@@ -27,7 +27,23 @@
 
 namespace srsran {
 
-constexpr uint32_t metrics_max_supported_cpu = 32u;
+constexpr uint32_t metrics_max_supported_cpu     = 32u;
+constexpr uint32_t metrics_max_supported_threads = 64u;
+
+/// Metrics of a single thread of the process, measured over the last metrics period.
+struct sys_thread_metrics_t {
+  /// Thread name as set with pthread_setname_np, truncated by the kernel to 15 characters.
+  std::array<char, 16> name = {};
+  uint32_t             tid  = 0;
+  /// CPU usage in % of a single core.
+  float cpu_usage = 0.f;
+  /// Number of times the thread gave up the CPU, e.g. to wait on a lock or on I/O.
+  uint32_t voluntary_ctxt_switches = 0;
+  /// Number of times the thread was preempted.
+  uint32_t nonvoluntary_ctxt_switches = 0;
+  /// Time the thread spent runnable but waiting in a run queue, in microseconds.
+  uint64_t runqueue_delay_us = 0;
+};
 
 /// Metrics of cpu usage, memory consumption and number of thread used by the process.
 struct sys_metrics_t {
@@ -39,6 +55,9 @@ struct sys_metrics_t {
   float                                        system_mem            = 0.f;
   uint32_t                                     cpu_count             = 0;
   std::array<float, metrics_max_supported_cpu> cpu_load              = {};
+  /// Per thread metrics, only the first nof_threads entries are valid.
+  uint32_t                                                        nof_threads = 0;
+  std::array<sys_thread_metrics_t, metrics_max_supported_threads> threads     = {};
 };
 
 } // namespace srsran
@@ -25,6 +25,7 @@
 #include "srsran/srslog/logger.h"
 #include "srsran/system/sys_metrics.h"
 #include <chrono>
+#include <map>
 #include <string>
 
 namespace srsran {
@@ -65,6 +66,16 @@ class sys_metrics_processor
   };
 
 public:
+  /// Cumulative counters of a thread, read from /proc/self/task/[tid]/.
+  struct thread_stats_info {
+    std::string name;
+    uint32_t    utime                      = 0;
+    uint32_t    stime                      = 0;
+    uint64_t    runqueue_delay_ns          = 0;
+    uint32_t    voluntary_ctxt_switches    = 0;
+    uint32_t    nonvoluntary_ctxt_switches = 0;
+  };
+
   explicit sys_metrics_processor(srslog::basic_logger& logger);
   /// Measures and returns the system metrics.
   sys_metrics_t get_metrics();
@@ -83,6 +94,10 @@ private:
   /// elapsed since the last cpu metrics measurement.
   void calculate_cpu_metrics(sys_metrics_t& metrics, float delta_time_in_seconds);
 
+  /// Calculates the per thread metrics and stores them in the given metrics. delta_time_in_seconds is the number of
+  /// seconds elapsed since the last measurement.
+  void calculate_thread_metrics(sys_metrics_t& metrics, float delta_time_in_seconds);
+
   /// Returns the cpu metrics from the given line.
   cpu_metrics_t read_cpu_idle_from_line(const std::string& line) const;
 
@@ -90,6 +105,7 @@ private:
   srslog::basic_logger&                              logger;
   proc_stats_info                                    last_query                                 = {};
   cpu_metrics_t                                      last_cpu_thread[metrics_max_supported_cpu] = {};
+  std::map<uint32_t, thread_stats_info>              last_thread_query;
   std::chrono::time_point<std::chrono::steady_clock> last_query_time = std::chrono::steady_clock::now();
 };
 
@@ -34,6 +34,7 @@
 #include "srsran/common/block_queue.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
+#include "srsran/upper/codel.h"
 #include <functional>
 #include <pthread.h>
 
@@ -53,7 +54,18 @@ public:
     return queue.try_push(std::move(msg));
   }
 
-  unique_byte_buffer_t read() { return queue.pop_blocking(); }
+  unique_byte_buffer_t read()
+  {
+    unique_byte_buffer_t msg = queue.pop_blocking();
+    if (aqm.is_enabled()) {
+      // Drop the SDUs that waited too long, as long as there is another SDU to return in their place
+      codel::clock_t::time_point now = codel::clock_t::now();
+      while (msg != nullptr and aqm.should_drop(now, msg->get_latency_us(), unread_bytes) and queue.try_pop(msg)) {
+        nof_aqm_drops++;
+      }
+    }
+    return msg;
+  }
 
   bool try_read(unique_byte_buffer_t* msg) { return queue.try_pop(*msg); }
 
@@ -63,6 +75,10 @@ public:
 
   uint32_t size_bytes() { return unread_bytes; }
 
+  // Active queue management of the SDUs returned by read(), disabled by default
+  void     set_aqm(const codel_config_t& cfg) { aqm.configure(cfg); }
+  uint32_t get_nof_aqm_drops() const { return nof_aqm_drops; }
+
   uint32_t size_tail_bytes()
   {
     uint32_t size_next = 0;
@@ -121,6 +137,9 @@ private:
   std::atomic<uint32_t> unread_bytes = {0};
   std::atomic<uint32_t> n_sdus       = {0};
 
+  codel    aqm;
+  uint32_t nof_aqm_drops = 0;
+
 public:
   dyn_blocking_queue<unique_byte_buffer_t, push_callback, pop_callback> queue;
 };
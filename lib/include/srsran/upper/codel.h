@@ -0,0 +1,136 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_CODEL_H
+#define SRSRAN_CODEL_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace srsran {
+
+struct codel_config_t {
+  bool     enabled     = false;
+  uint32_t target_ms   = 5;   // Acceptable standing queue delay
+  uint32_t interval_ms = 100; // Time the delay may stay above the target before dropping, in the order of one RTT
+};
+
+/****************************************************************************
+ * CoDel active queue management
+ * Ref: IETF RFC 8289
+ *
+ * Decides at dequeue time whether the head of a queue must be dropped, from
+ * the time the packet has spent in the queue. The state is updated once per
+ * dequeued packet, so the cost is constant per packet. Not thread-safe, it
+ * must be called by the single reader of the queue.
+ ***************************************************************************/
+class codel
+{
+public:
+  using clock_t = std::chrono::steady_clock;
+
+  // Bytes below which the queue is never dropped from, to keep the link busy
+  static const uint32_t min_queue_bytes = 1500;
+
+  void configure(const codel_config_t& cfg_)
+  {
+    cfg      = cfg_;
+    target   = std::chrono::milliseconds(cfg.target_ms);
+    interval = std::chrono::milliseconds(cfg.interval_ms);
+    reset();
+  }
+
+  void reset()
+  {
+    dropping         = false;
+    count            = 0;
+    last_count       = 0;
+    first_above_time = {};
+    drop_next        = {};
+  }
+
+  bool is_enabled() const { return cfg.enabled; }
+
+  /**
+   * Called for each dequeued packet with the time it spent in the queue and the bytes still queued behind it.
+   * Returns true if the packet must be dropped and the next one dequeued instead
+   */
+  bool should_drop(clock_t::time_point now, std::chrono::microseconds sojourn, uint32_t bytes_left)
+  {
+    bool ok_to_drop = delay_above_target(now, sojourn, bytes_left);
+    if (dropping) {
+      if (not ok_to_drop) {
+        dropping = false;
+        return false;
+      }
+      if (now < drop_next) {
+        return false;
+      }
+      count++;
+      drop_next = control_law(drop_next);
+      return true;
+    }
+    if (not ok_to_drop) {
+      return false;
+    }
+    // Enter the dropping state. Start from the drop rate of the last cycle if it ended recently
+    dropping       = true;
+    uint32_t delta = count - last_count;
+    count          = (delta > 1 and now - drop_next < 16 * interval) ? delta : 1;
+    drop_next      = control_law(now);
+    last_count     = count;
+    return true;
+  }
+
+private:
+  bool delay_above_target(clock_t::time_point now, std::chrono::microseconds sojourn, uint32_t bytes_left)
+  {
+    if (sojourn < target or bytes_left <= min_queue_bytes) {
+      first_above_time = {};
+      return false;
+    }
+    if (first_above_time == clock_t::time_point{}) {
+      first_above_time = now + interval;
+      return false;
+    }
+    return now >= first_above_time;
+  }
+
+  clock_t::time_point control_law(clock_t::time_point t) const
+  {
+    return t + std::chrono::duration_cast<clock_t::duration>(interval / std::sqrt(static_cast<double>(count)));
+  }
+
+  codel_config_t            cfg      = {};
+  std::chrono::microseconds target   = std::chrono::milliseconds(5);
+  std::chrono::microseconds interval = std::chrono::milliseconds(100);
+
+  bool                dropping         = false;
+  uint32_t            count            = 0;
+  uint32_t            last_count       = 0;
+  clock_t::time_point first_above_time = {};
+  clock_t::time_point drop_next        = {};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_CODEL_H
@@ -25,6 +25,7 @@
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
 #include "srsran/srslog/srslog.h"
+#include <array>
 #include <stdint.h>
 
 namespace srsran {
@@ -83,10 +84,18 @@ struct gtpu_header_t {
   std::vector<uint8_t> ext_buffer;
 };
 
+// G-PDU header without optional fields, precomputed for a tunnel. Only the length is written for each PDU
+using gtpu_gpdu_header_template_t = std::array<uint8_t, GTPU_BASE_HEADER_LEN>;
+
 bool gtpu_read_header(srsran::byte_buffer_t* pdu, gtpu_header_t* header, srslog::basic_logger& logger);
 bool gtpu_write_header(gtpu_header_t* header, srsran::byte_buffer_t* pdu, srslog::basic_logger& logger);
 void gtpu_ntoa(fmt::memory_buffer& buffer, uint32_t addr);
 
+gtpu_gpdu_header_template_t gtpu_make_gpdu_header_template(uint32_t teid);
+bool                        gtpu_write_gpdu_header(const gtpu_gpdu_header_template_t& hdr,
+                                                   srsran::byte_buffer_t*             pdu,
+                                                   srslog::basic_logger&              logger);
+
 inline bool gtpu_supported_flags_check(gtpu_header_t* header, srslog::basic_logger& logger)
 {
   // flags
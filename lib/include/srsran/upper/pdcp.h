@@ -40,6 +40,7 @@ public:
 
   // Stack interface
   bool is_lcid_enabled(uint32_t lcid);
+  void set_tx_crypto_offload(bool enable) { tx_crypto_offload = enable; }
 
   // RRC interface
   void reestablish() override;
@@ -72,7 +73,7 @@ public:
   void notify_failure(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) override;
 
   // eNB-only methods
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint32_t lcid);
+  std::vector<srsran::unique_byte_buffer_t> get_buffered_pdus(uint32_t lcid);
 
   // Metrics
   void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
@@ -85,6 +86,9 @@ private:
   srsran::task_sched_handle  task_sched;
   srslog::basic_logger&      logger;
 
+  // Cipher the TX PDUs of the LTE DRBs added from now on in get_crypto_workers()
+  bool tx_crypto_offload = false;
+
   using pdcp_map_t = std::map<uint16_t, std::unique_ptr<pdcp_entity_base> >;
   pdcp_map_t pdcp_array, pdcp_array_mrb;
 
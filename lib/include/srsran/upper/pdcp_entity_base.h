@@ -129,7 +129,8 @@ public:
   virtual void get_bearer_state(pdcp_lte_state_t* state)                     = 0;
   virtual void set_bearer_state(const pdcp_lte_state_t& state, bool set_fmc) = 0;
 
-  virtual std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() = 0;
+  // Hands over the SDUs not yet acknowledged by the lower layers, in COUNT order, e.g. for forwarding at handover
+  virtual std::vector<srsran::unique_byte_buffer_t> get_buffered_pdus() = 0;
 
   virtual void send_status_report() = 0;
 
@@ -168,6 +169,9 @@ protected:
   std::string   rb_name;
 
   srsran::as_security_config_t sec_cfg = {};
+  // AES key schedules of the EEA2/EIA2 keys of this bearer, derived when the security is configured
+  srsran::security_128_aes_ctx_t aes_enc_ctx;
+  srsran::security_128_aes_ctx_t aes_int_ctx;
 
   // Security functions
   void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
@@ -29,6 +29,9 @@
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/upper/pdcp_entity_base.h"
+#include "srsran/upper/pdcp_rohc.h"
+#include <deque>
+#include <memory>
 
 namespace srsue {
 
@@ -39,10 +42,15 @@ class rlc_interface_pdcp;
 
 namespace srsran {
 
+/// Stores the SDUs not yet acknowledged by the RLC. All SDUs of a bearer share the same discard timeout, so they
+/// expire in arrival order: a single bearer timer walks a ring of (SN, deadline) pairs and reports the expired SNs
+/// through the discard callback in batches.
 class undelivered_sdus_queue
 {
 public:
-  explicit undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod);
+  undelivered_sdus_queue(srsran::task_sched_handle             task_sched,
+                         uint32_t                              sn_mod,
+                         srsran::move_callback<void(uint32_t)> discard_callback_);
 
   bool            empty() const { return count == 0; }
   bool            is_full() const { return count >= capacity; }
@@ -53,13 +61,10 @@ public:
     assert(sn != invalid_sn && "provided PDCP SN is invalid");
     return sdus[sn].sdu != nullptr and sdus[sn].sdu->md.pdcp_sn == sn;
   }
-  // Getter for the number of discard timers. Used for debugging.
+  // Getter for the number of SDUs with a pending discard. Used for debugging.
   size_t nof_discard_timers() const;
 
-  bool add_sdu(uint32_t                              sn,
-               const srsran::unique_byte_buffer_t&   sdu,
-               uint32_t                              discard_timeout,
-               srsran::move_callback<void(uint32_t)> callback);
+  bool add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu, uint32_t discard_timeout);
 
   unique_byte_buffer_t& operator[](uint32_t sn)
   {
@@ -77,7 +82,8 @@ public:
 
   uint32_t get_lms() const { return lms; }
 
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_sdus();
+  // Moves the stored SDUs out of the queue, in COUNT order, and empties the queue
+  std::vector<srsran::unique_byte_buffer_t> release_buffered_sdus();
 
 private:
   const static uint32_t capacity   = 4096;
@@ -88,14 +94,30 @@ private:
 
   struct sdu_data {
     srsran::unique_byte_buffer_t sdu;
-    srsran::unique_timer         discard_timer;
+    bool                         discard_pending  = false;
+    uint32_t                     discard_deadline = 0;
   };
+  struct discard_entry {
+    uint32_t sn;
+    uint32_t deadline;
+  };
+
+  // Time in ms of the discard ring. It only advances while the discard timer runs, i.e. while the ring is not empty
+  uint32_t discard_clock() const;
+  void     handle_discard_timer_expiry();
+  void     clear_discard_ring();
 
   uint32_t                                   count = 0;
   uint32_t                                   bytes = 0;
   uint32_t                                   fms   = 0; // SN of the first missing PDCP SDU
   uint32_t                                   lms   = 0;
   srsran::circular_array<sdu_data, capacity> sdus;
+
+  // Discard ring, ordered by deadline. Entries of delivered SDUs are dropped lazily once they reach the front
+  srsran::move_callback<void(uint32_t)> discard_callback;
+  srsran::unique_timer                  discard_timer;
+  uint32_t                              discard_epoch = 0; // discard_clock() value when discard_timer was started
+  std::deque<discard_entry>             discard_ring;
 };
 
 /****************************************************************************
@@ -139,7 +161,7 @@ public:
   bool store_sdu(uint32_t tx_count, const unique_byte_buffer_t& pdu);
 
   // Getter for unacknowledged PDUs. Used for handover
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() override;
+  std::vector<srsran::unique_byte_buffer_t> get_buffered_pdus() override;
 
   // Status report helper(s)
   void send_status_report() override;
@@ -155,6 +177,10 @@ public:
 
   size_t nof_discard_timers() const { return undelivered_sdus != nullptr ? undelivered_sdus->nof_discard_timers() : 0; }
 
+  // Cipher the DRB PDUs in get_crypto_workers(). The PDUs are passed to the RLC in TX order once ciphered
+  void   set_tx_crypto_offload(bool enable) { tx_crypto_offload = enable; }
+  size_t nof_pending_tx_crypto_pdus() const { return tx_crypto_jobs.size(); }
+
 private:
   srsue::rlc_interface_pdcp* rlc = nullptr;
   srsue::rrc_interface_pdcp* rrc = nullptr;
@@ -172,8 +198,8 @@ private:
   void handle_um_drb_pdu(srsran::unique_byte_buffer_t pdu);
   void handle_am_drb_pdu(srsran::unique_byte_buffer_t pdu);
 
-  // Discard callback (discardTimer)
-  class discard_callback;
+  // Discard timer expiry (discardTimer)
+  void discard_sdu(uint32_t discard_sn);
 
   // Tx info queue
   uint32_t                                maximum_allocated_sns_window = 2048;
@@ -185,6 +211,27 @@ private:
   std::vector<uint32_t> rx_counts_info; // Keeps the RX_COUNT for generation of the stauts report
   void                  update_rx_counts_queue(uint32_t rx_count);
 
+  // Header compression of the DRBs, if configured
+  pdcp_rohc rohc;
+
+  // Offloaded TX ciphering. Each job keeps a reference to the keys it was created with, so that the workers never
+  // read the security config of the entity
+  struct tx_crypto_ctx_t;
+  struct tx_crypto_job_t {
+    srsran::unique_byte_buffer_t pdu;
+    bool                         done = false;
+  };
+  bool                              tx_crypto_offload   = false;
+  uint32_t                          tx_crypto_first_job = 0; // Job ID of the front of tx_crypto_jobs
+  std::deque<tx_crypto_job_t>       tx_crypto_jobs;
+  std::shared_ptr<tx_crypto_ctx_t>  tx_crypto_ctx;
+  std::shared_ptr<pdcp_entity_lte*> tx_crypto_owner; // Nulled on destruction, to drop the late results
+
+  bool offload_tx_ciphering();
+  void push_tx_crypto_job(srsran::unique_byte_buffer_t pdu, uint32_t tx_count);
+  void handle_tx_crypto_result(uint32_t job_id, srsran::unique_byte_buffer_t pdu);
+  void clear_tx_crypto_jobs();
+
   /*
    * Helper function to see if an SN is larger
    */
@@ -202,21 +249,5 @@ private:
   }
 };
 
-// Discard callback (discardTimer)
-class pdcp_entity_lte::discard_callback
-{
-public:
-  discard_callback(pdcp_entity_lte* parent_, uint32_t sn_)
-  {
-    parent     = parent_;
-    discard_sn = sn_;
-  };
-  void operator()(uint32_t timer_id);
-
-private:
-  pdcp_entity_lte* parent;
-  uint32_t         discard_sn;
-};
-
 } // namespace srsran
 #endif // SRSRAN_PDCP_ENTITY_LTE_H
@@ -23,6 +23,7 @@
 #define SRSRAN_PDCP_ENTITY_NR_H
 
 #include "pdcp_entity_base.h"
+#include "srsran/adt/bounded_bitset.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/interfaces_common.h"
@@ -33,8 +34,39 @@
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/interfaces/ue_rlc_interfaces.h"
 #include <map>
+#include <vector>
 
 namespace srsran {
+
+/****************************************************************************
+ * NR PDCP reception buffer
+ * Stores the PDUs waiting for reordering, directly indexed by COUNT modulo the
+ * window size. The stored COUNTs are within [RX_DELIV, RX_DELIV + Window_Size)
+ ***************************************************************************/
+class pdcp_nr_reorder_buffer
+{
+public:
+  static const uint32_t max_window_size = 1U << 17; // Window size of 18 bit SNs
+
+  /// Sets the window size and drops all the stored PDUs
+  void resize(uint32_t window_size);
+  void clear();
+
+  bool   contains(uint32_t count) const { return nof_pdus > 0 and occupied.test(count & (buffer.size() - 1)); }
+  size_t size() const { return nof_pdus; }
+
+  void                 insert(uint32_t count, unique_byte_buffer_t pdu);
+  unique_byte_buffer_t pop(uint32_t count);
+
+  /// Returns the first stored COUNT in [count_start, count_end), or count_end if there is none
+  uint32_t find_first(uint32_t count_start, uint32_t count_end) const;
+
+private:
+  std::vector<unique_byte_buffer_t> buffer;
+  bounded_bitset<max_window_size>   occupied;
+  size_t                            nof_pdus = 0;
+};
+
 /****************************************************************************
  * NR PDCP Entity
  * PDCP entity for 5G NR
@@ -68,7 +100,7 @@ public:
   pdcp_bearer_metrics_t get_metrics() override;
   void                  reset_metrics() override;
 
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() override { return {}; }
+  std::vector<srsran::unique_byte_buffer_t> get_buffered_pdus() override { return {}; }
 
   // State variable getters (useful for testing)
   uint32_t nof_discard_timers() { return discard_timers_map.size(); }
@@ -99,8 +131,8 @@ private:
   uint32_t window_size = 0;
 
   // Reordering Queue / Timers
-  std::map<uint32_t, unique_byte_buffer_t> reorder_queue;
-  timer_handler::unique_timer              reordering_timer;
+  pdcp_nr_reorder_buffer      reorder_queue;
+  timer_handler::unique_timer reordering_timer;
 
   // Pass to Upper Layers Helper function
   void deliver_all_consecutive_counts();
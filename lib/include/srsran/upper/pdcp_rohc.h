@@ -0,0 +1,131 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PDCP_ROHC_H
+#define SRSRAN_PDCP_ROHC_H
+
+#include "srsran/common/byte_buffer.h"
+#include "srsran/interfaces/pdcp_interface_types.h"
+#include "srsran/srslog/logger.h"
+#include <array>
+
+namespace srsran {
+
+/****************************************************************************
+ * ROHC header compression
+ * Ref: IETF RFC 3095, unidirectional mode
+ *
+ * Profiles 0x0000 (uncompressed), 0x0001 (RTP/UDP/IPv4) and 0x0002
+ * (UDP/IPv4), with small CIDs. The compressor sends IR packets when a
+ * context is created or a field changes, and UO-0/UOR-2 packets otherwise.
+ * The packets are compressed and decompressed in place, in the headroom of
+ * the byte buffer, with the contexts kept in fixed tables.
+ ***************************************************************************/
+
+enum class rohc_profile_t : uint8_t { uncompressed = 0x00, rtp = 0x01, udp = 0x02 };
+
+// Fields of the IPv4/UDP/RTP headers kept in a context
+struct rohc_fields_t {
+  // IPv4
+  uint8_t  tos   = 0;
+  uint8_t  ttl   = 0;
+  uint16_t ip_id = 0;
+  bool     df    = false;
+  uint32_t saddr = 0;
+  uint32_t daddr = 0;
+  // UDP
+  uint16_t sport    = 0;
+  uint16_t dport    = 0;
+  uint16_t udp_csum = 0;
+  // RTP. For profile 0x0002, sn is the SN generated by the compressor
+  uint8_t  rtp_flags = 0; // V, P, X and CC
+  bool     m         = false;
+  uint8_t  pt        = 0;
+  uint16_t sn        = 0;
+  uint32_t ts        = 0;
+  uint32_t ssrc      = 0;
+};
+
+struct rohc_context_t {
+  bool           active  = false;
+  rohc_profile_t profile = rohc_profile_t::uncompressed;
+  rohc_fields_t  ref     = {}; // Fields of the last packet sent/decompressed
+
+  bool     rnd          = false; // IP-ID sent in every packet
+  uint16_t ip_id_offset = 0;     // IP-ID minus SN, when not random
+  uint32_t ts_stride    = 0;     // 0 if not known by the decompressor
+  uint32_t ts_offset    = 0;
+
+  // Compressor state
+  uint32_t last_use   = 0; // For the replacement of the least recently used context
+  uint32_t nof_ir     = 0; // IR packets still to send for the last change of the context
+  uint32_t nof_repeat = 0; // UOR-2 packets still to send for the last TS jump
+  uint32_t since_ir   = 0; // Packets sent since the last IR, for the periodic refresh
+};
+
+class pdcp_rohc
+{
+public:
+  // RFC 3095 small CIDs, 0..15. CID 0 is used by the uncompressed profile
+  static const uint32_t max_contexts = 16;
+  // Size of the largest ROHC header, the uncompressed headers of profile 0x0001 are 40 bytes
+  static const uint32_t max_hdr_len = 64;
+
+  explicit pdcp_rohc(srslog::basic_logger& logger_) : logger(logger_) {}
+
+  void configure(const pdcp_rohc_config_t& cfg_);
+  void reset();
+
+  // Replaces the headers of the IP packet with a ROHC header. Returns false if the buffer has not enough headroom
+  bool compress(byte_buffer_t* sdu);
+  // Restores the headers of the IP packet. Returns false if the packet must be discarded
+  bool decompress(byte_buffer_t* pdu);
+
+private:
+  srslog::basic_logger& logger;
+  pdcp_rohc_config_t    cfg = {};
+
+  uint32_t                                 nof_compressed = 0;
+  std::array<rohc_context_t, max_contexts> tx_contexts;
+  std::array<rohc_context_t, max_contexts> rx_contexts;
+
+  uint32_t get_tx_cid(rohc_profile_t profile, const rohc_fields_t& fields);
+  uint32_t compress_uncompressed(const uint8_t* pkt, uint32_t len, uint8_t* out);
+  uint32_t compress_flow(uint32_t cid, rohc_fields_t& f, const uint8_t* orig_hdr, uint32_t orig_len, uint8_t* out);
+  uint32_t write_ir(uint32_t cid, const rohc_context_t& ctx, const rohc_fields_t& f, uint8_t* out);
+
+  bool decompress_ir(uint32_t       cid,
+                     const uint8_t* pkt,
+                     uint32_t       len,
+                     uint8_t*       hdr,
+                     uint32_t&      hdr_len,
+                     uint32_t&      rohc_len);
+  bool decompress_uo(rohc_context_t& ctx,
+                     const uint8_t*  pkt,
+                     uint32_t        len,
+                     uint8_t*        hdr,
+                     uint32_t&       hdr_len,
+                     uint32_t&       rohc_len);
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PDCP_ROHC_H
@@ -46,6 +46,52 @@ void assert_choice_type(uint32_t val, uint32_t choice_id)
   }
 }
 
+/************************
+      decode arena
+************************/
+
+void* decode_arena::allocate(size_t sz, size_t align)
+{
+  // Start a new chunk when the allocation does not fit in the current one. Big allocations get their own chunk.
+  // The chunks are allocated by operator new[], so their start is aligned for any fundamental type
+  offset = (offset + align - 1) & ~(align - 1);
+  if (chunks.empty() or offset + sz > chunk_sizes.back()) {
+    size_t new_size = std::max(chunk_size, sz);
+    chunks.emplace_back(new uint8_t[new_size]);
+    chunk_sizes.push_back(new_size);
+    offset = 0;
+  }
+  void* p = chunks.back().get() + offset;
+  offset += sz;
+  return p;
+}
+
+void decode_arena::reset()
+{
+  if (chunks.size() > 1) {
+    chunks.resize(1);
+    chunk_sizes.resize(1);
+  }
+  offset = 0;
+}
+
+static thread_local decode_arena* thread_decode_arena = nullptr;
+
+decode_arena_scope::decode_arena_scope(decode_arena& arena) : prev(thread_decode_arena)
+{
+  thread_decode_arena = &arena;
+}
+
+decode_arena_scope::~decode_arena_scope()
+{
+  thread_decode_arena = prev;
+}
+
+decode_arena* detail::current_decode_arena()
+{
+  return thread_decode_arena;
+}
+
 /************************
      error handling
 ************************/
@@ -144,34 +190,50 @@ int bit_ref_impl<Ptr>::distance_bytes_end() const
   return ((int)(max_ptr - ptr)) - ((offset) ? 1 : 0);
 }
 
+/// Reads n_bytes (<= 8) from buf as a big-endian word
+static uint64_t load_be(const uint8_t* buf, uint32_t n_bytes)
+{
+  uint64_t w = 0;
+  for (uint32_t i = 0; i < n_bytes; ++i) {
+    w = (w << 8u) | buf[i];
+  }
+  return w;
+}
+
+/// Writes the n_bytes (<= 8) most significant bytes of w to buf
+static void store_be(uint8_t* buf, uint64_t w, uint32_t n_bytes)
+{
+  for (uint32_t i = 0; i < n_bytes; ++i) {
+    buf[i] = static_cast<uint8_t>(w >> (56u - 8u * i));
+  }
+}
+
 SRSASN_CODE bit_ref::pack(uint64_t val, uint32_t n_bits)
 {
   if (n_bits >= 64) {
     log_error("This method only supports packing up to 64 bits");
     return SRSASN_ERROR_ENCODE_FAIL;
   }
-  uint64_t mask;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("pack: Buffer size limit was achieved");
-      return SRSASN_ERROR_ENCODE_FAIL;
-    }
-    mask             = ((1ul << n_bits) - 1ul);
-    val              = val & mask;
-    uint8_t keepmask = ((uint8_t)-1) - (uint8_t)((1u << (8u - offset)) - 1u);
-    if ((uint32_t)(8 - offset) > n_bits) {
-      auto bit = static_cast<uint8_t>(val << (8u - offset - n_bits));
-      *ptr     = ((*ptr) & keepmask) + bit;
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto bit = static_cast<uint8_t>(val >> (n_bits - 8u + offset));
-      *ptr     = (*ptr & keepmask) + bit;
-      n_bits -= (8 - offset);
-      offset = 0;
-      ptr++;
-    }
+  if (n_bits == 0) {
+    return SRSASN_SUCCESS;
+  }
+  uint32_t total_bits = offset + n_bits;
+  if (total_bits > 64) {
+    // The bits do not fit in one word with the bits already in the current byte
+    HANDLE_CODE(pack(val >> 32u, n_bits - 32));
+    return pack(val & 0xffffffffu, 32);
   }
+  uint32_t n_bytes = (total_bits + 7) / 8;
+  if (ptr + n_bytes > max_ptr) {
+    log_error("pack: Buffer size limit was achieved");
+    return SRSASN_ERROR_ENCODE_FAIL;
+  }
+  // The bits of the current byte before the offset are kept, and the unused bits of the last byte are zeroed
+  uint64_t keep = offset == 0 ? 0 : static_cast<uint64_t>(*ptr >> (8u - offset)) << (64u - offset);
+  uint64_t w    = keep | ((val & ((1ul << n_bits) - 1ul)) << (64u - total_bits));
+  store_be(ptr, w, n_bytes);
+  ptr += total_bits / 8;
+  offset = total_bits % 8;
   return SRSASN_SUCCESS;
 }
 
@@ -182,25 +244,29 @@ SRSASN_CODE unpack_bits(T& val, Ptr& ptr, uint8_t& offset, const uint8_t* max_pt
     log_error("This method only supports unpacking up to %d bits", (int)sizeof(T) * 8);
     return SRSASN_ERROR_DECODE_FAIL;
   }
-  val = 0;
-  while (n_bits > 0) {
-    if (ptr >= max_ptr) {
-      log_error("unpack_bits: Buffer size limit was achieved");
-      return SRSASN_ERROR_DECODE_FAIL;
-    }
-    if ((uint32_t)(8 - offset) > n_bits) {
-      uint8_t mask = (uint8_t)(1u << (8u - offset)) - (uint8_t)(1u << (8u - offset - n_bits));
-      val += ((uint32_t)((*ptr) & mask)) >> (8u - offset - n_bits);
-      offset += n_bits;
-      n_bits = 0;
-    } else {
-      auto mask = static_cast<uint8_t>((1u << (8u - offset)) - 1u);
-      val += static_cast<T>((*ptr) & mask) << (n_bits - 8 + offset);
-      n_bits -= 8 - offset;
-      offset = 0;
-      ptr++;
-    }
+  if (n_bits == 0) {
+    val = 0;
+    return SRSASN_SUCCESS;
+  }
+  uint32_t total_bits = offset + n_bits;
+  if (total_bits > 64) {
+    // Only reachable with 64-bit values. The bits are read in two words
+    uint64_t msb, lsb;
+    HANDLE_CODE(unpack_bits(msb, ptr, offset, max_ptr, n_bits - 32));
+    HANDLE_CODE(unpack_bits(lsb, ptr, offset, max_ptr, 32));
+    val = static_cast<T>((msb << 32u) | lsb);
+    return SRSASN_SUCCESS;
   }
+  uint32_t n_bytes = (total_bits + 7) / 8;
+  if (ptr + n_bytes > max_ptr) {
+    log_error("unpack_bits: Buffer size limit was achieved");
+    return SRSASN_ERROR_DECODE_FAIL;
+  }
+  uint64_t w    = load_be(ptr, n_bytes) >> (8 * n_bytes - total_bits);
+  uint64_t mask = n_bits == 64 ? std::numeric_limits<uint64_t>::max() : (1ul << n_bits) - 1ul;
+  val           = static_cast<T>(w & mask);
+  ptr += total_bits / 8;
+  offset = total_bits % 8;
   return SRSASN_SUCCESS;
 }
 
@@ -260,9 +326,16 @@ SRSASN_CODE bit_ref_impl<Ptr>::unpack_bytes(uint8_t* buf, uint32_t n_bytes)
       log_error("unpack_bytes (unaligned): Buffer size limit was achieved");
       return SRSASN_ERROR_DECODE_FAIL;
     }
-    for (uint32_t i = 0; i < n_bytes; ++i) {
-      HANDLE_CODE(unpack(buf[i], 8));
+    // Each output byte straddles two input bytes. The bounds were checked above, so words are read while they fit
+    uint32_t lshift = offset, rshift = 8u - offset, i = 0;
+    for (; i + 8 <= n_bytes; i += 8) {
+      uint64_t w = (load_be(ptr + i, 8) << lshift) | (ptr[i + 8] >> rshift);
+      store_be(buf + i, w, 8);
+    }
+    for (; i < n_bytes; ++i) {
+      buf[i] = static_cast<uint8_t>((ptr[i] << lshift) | (ptr[i + 1] >> rshift));
     }
+    ptr += n_bytes;
   }
   return SRSASN_SUCCESS;
 }
@@ -323,9 +396,21 @@ SRSASN_CODE bit_ref::pack_bytes(const uint8_t* buf, uint32_t n_bytes)
     memcpy(ptr, buf, n_bytes);
     ptr += n_bytes;
   } else {
-    for (uint32_t i = 0; i < n_bytes; ++i) {
-      pack(buf[i], 8);
+    // The bits of the current byte before the offset are kept, and the unused bits of the last byte are zeroed
+    uint32_t lshift = 8u - offset, rshift = offset;
+    uint8_t  prev   = static_cast<uint8_t>(*ptr >> lshift);
+    uint32_t i      = 0;
+    for (; i + 8 <= n_bytes; i += 8) {
+      uint64_t w = load_be(buf + i, 8);
+      store_be(ptr + i, (static_cast<uint64_t>(prev) << (56u + lshift)) | (w >> rshift), 8);
+      prev = static_cast<uint8_t>(w);
+    }
+    for (; i < n_bytes; ++i) {
+      ptr[i] = static_cast<uint8_t>((prev << lshift) | (buf[i] >> rshift));
+      prev   = buf[i];
     }
+    ptr[n_bytes] = static_cast<uint8_t>(prev << lshift);
+    ptr += n_bytes;
   }
   return SRSASN_SUCCESS;
 }
@@ -34,6 +34,7 @@
 #include <cpuid.h>
 #define X86_CPUID_BASIC_LEAF 1
 #define X86_CPUID_ADVANCED_LEAF 7
+#define X86_XCR0_ZMM 0xe6
 #endif
 
 #define MAX_CMD_LEN (64)
@@ -58,7 +59,8 @@ static __inline int __get_cpuid_count_redef(unsigned int  __leaf,
 const char* x86_get_isa()
 {
   int          ret       = 0;
-  int          has_sse42 = 0, has_avx = 0, has_avx2 = 0;
+  int          has_sse42 = 0, has_avx = 0, has_avx2 = 0, has_avx512 = 0;
+  int          has_zmm_state = 0;
   unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
 
   // query basic features
@@ -68,6 +70,13 @@ const char* x86_get_isa()
     has_sse42 = ecx & bit_SSE4_2;
 #endif
     has_avx   = ecx & bit_AVX;
+
+    // AVX512 registers are only usable if the OS saves them on context switches
+    if (ecx & bit_OSXSAVE) {
+      unsigned int xcr0_lo = 0, xcr0_hi = 0;
+      __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+      has_zmm_state = (xcr0_lo & X86_XCR0_ZMM) == X86_XCR0_ZMM;
+    }
   }
 
   // query advanced features
@@ -75,10 +84,16 @@ const char* x86_get_isa()
   ret = __get_cpuid_count_redef(X86_CPUID_ADVANCED_LEAF, 0, &eax, &ebx, &ecx, &edx);
   if (ret) {
     has_avx2 = ebx & bit_AVX2;
+#ifdef bit_AVX512F
+    const unsigned int avx512_bits = bit_AVX512F | bit_AVX512CD | bit_AVX512BW | bit_AVX512DQ;
+    has_avx512                     = has_zmm_state && (ebx & avx512_bits) == avx512_bits;
+#endif
   }
 #endif
 
-  if (has_avx2) {
+  if (has_avx512) {
+    return "avx512";
+  } else if (has_avx2) {
     return "avx2";
   } else if (has_avx) {
     return "avx";
@@ -115,8 +130,17 @@ int main(int argc, char* argv[])
 #endif
 
   // execute command with same argument
-  if (execvp(cmd, &argv[0]) == -1) {
-    fprintf(stderr, "%s: %s\n", cmd, strerror(errno));
-    exit(errno);
+  execvp(cmd, &argv[0]);
+
+#ifndef IS_ARM
+  // AVX512 builds are optional, fall back to the AVX2 one
+  if (errno == ENOENT && strcmp(x86_get_isa(), "avx512") == 0) {
+    snprintf(cmd, MAX_CMD_LEN, "%s-%s", argv[0], "avx2");
+    execvp(cmd, &argv[0]);
   }
+#endif
+
+  // execvp() only returns on error
+  fprintf(stderr, "%s: %s\n", cmd, strerror(errno));
+  exit(errno);
 }
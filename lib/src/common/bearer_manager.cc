@@ -130,12 +130,19 @@ void ue_bearer_manager::reset()
 
 namespace srsenb {
 
-enb_bearer_manager::enb_bearer_manager() : logger(srslog::fetch_basic_logger("STCK", false)) {}
+enb_bearer_manager::enb_bearer_manager() : logger(srslog::fetch_basic_logger("STCK", false))
+{
+  pthread_rwlock_init(&rwlock, nullptr);
+}
 
-enb_bearer_manager::~enb_bearer_manager() {}
+enb_bearer_manager::~enb_bearer_manager()
+{
+  pthread_rwlock_destroy(&rwlock);
+}
 
 void enb_bearer_manager::add_eps_bearer(uint16_t rnti, uint8_t eps_bearer_id, srsran::srsran_rat_t rat, uint32_t lcid)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   auto user_it = users_map.find(rnti);
   if (user_it == users_map.end()) {
     // add empty bearer map
@@ -161,6 +168,7 @@ void enb_bearer_manager::add_eps_bearer(uint16_t rnti, uint8_t eps_bearer_id, sr
 
 void enb_bearer_manager::remove_eps_bearer(uint16_t rnti, uint8_t eps_bearer_id)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   auto user_it = users_map.find(rnti);
   if (user_it == users_map.end()) {
     logger.info("Bearers: No EPS bearer registered for rnti=0x%x", rnti);
@@ -176,6 +184,7 @@ void enb_bearer_manager::remove_eps_bearer(uint16_t rnti, uint8_t eps_bearer_id)
 
 void enb_bearer_manager::rem_user(uint16_t rnti)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   auto user_it = users_map.find(rnti);
   if (user_it == users_map.end()) {
     logger.info("Bearers: No EPS bearer registered for rnti=0x%x", rnti);
@@ -188,6 +197,7 @@ void enb_bearer_manager::rem_user(uint16_t rnti)
 
 bool enb_bearer_manager::has_active_radio_bearer(uint16_t rnti, uint32_t eps_bearer_id)
 {
+  srsran::rwlock_read_guard rw_lock(rwlock);
   auto user_it = users_map.find(rnti);
   if (user_it == users_map.end()) {
     return false;
@@ -197,6 +207,7 @@ bool enb_bearer_manager::has_active_radio_bearer(uint16_t rnti, uint32_t eps_bea
 
 enb_bearer_manager::radio_bearer_t enb_bearer_manager::get_lcid_bearer(uint16_t rnti, uint32_t lcid) const
 {
+  srsran::rwlock_read_guard rw_lock(rwlock);
   auto user_it = users_map.find(rnti);
   if (user_it == users_map.end()) {
     return srsran::detail::ue_bearer_manager_impl::invalid_rb;
@@ -206,6 +217,7 @@ enb_bearer_manager::radio_bearer_t enb_bearer_manager::get_lcid_bearer(uint16_t
 
 enb_bearer_manager::radio_bearer_t enb_bearer_manager::get_radio_bearer(uint16_t rnti, uint32_t eps_bearer_id)
 {
+  srsran::rwlock_read_guard rw_lock(rwlock);
   auto user_it = users_map.find(rnti);
   if (user_it == users_map.end()) {
     return srsran::detail::ue_bearer_manager_impl::invalid_rb;
@@ -215,6 +227,7 @@ enb_bearer_manager::radio_bearer_t enb_bearer_manager::get_radio_bearer(uint16_t
 
 bool enb_bearer_manager::set_five_qi(uint16_t rnti, uint32_t eps_bearer_id, uint16_t five_qi)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   auto user_it = users_map.find(rnti);
   if (user_it == users_map.end()) {
     return false;
@@ -24,16 +24,56 @@
 
 namespace srsran {
 
+namespace {
+
+/// Every pooled byte buffer is preceded by this header, so that operator delete finds the pool of the buffer
+struct alignas(detail::max_alignment_t) pool_block_header_t {
+  byte_buffer_size_class_t size_class;
+};
+
+const size_t pool_header_len = sizeof(pool_block_header_t);
+
+using small_byte_buffer_pool =
+    concurrent_fixed_memory_pool<pool_header_len + byte_buffer_t::block_size(SRSRAN_SMALL_BUFFER_SIZE_BYTES)>;
+using medium_byte_buffer_pool =
+    concurrent_fixed_memory_pool<pool_header_len + byte_buffer_t::block_size(SRSRAN_MEDIUM_BUFFER_SIZE_BYTES)>;
+
+static_assert(byte_buffer_pool::BLOCK_SIZE >= pool_header_len + sizeof(byte_buffer_t),
+              "The byte buffer pool blocks do not fit a byte buffer");
+
+void* allocate_block(byte_buffer_size_class_t size_class)
+{
+  void* block = nullptr;
+  switch (size_class) {
+    case byte_buffer_size_class_t::small:
+      block = small_byte_buffer_pool::get_instance()->allocate_node(small_byte_buffer_pool::BLOCK_SIZE);
+      break;
+    case byte_buffer_size_class_t::medium:
+      block = medium_byte_buffer_pool::get_instance()->allocate_node(medium_byte_buffer_pool::BLOCK_SIZE);
+      break;
+    case byte_buffer_size_class_t::large:
+      block = byte_buffer_pool::get_instance()->allocate_node(byte_buffer_pool::BLOCK_SIZE);
+      break;
+  }
+  if (block == nullptr) {
+    return nullptr;
+  }
+  new (block) pool_block_header_t{size_class};
+  return static_cast<uint8_t*>(block) + pool_header_len;
+}
+
+} // namespace
+
 void* byte_buffer_t::operator new(size_t sz, const std::nothrow_t& nothrow_value) noexcept
 {
   assert(sz == sizeof(byte_buffer_t));
-  return byte_buffer_pool::get_instance()->allocate_node(sz);
+  return allocate_block(byte_buffer_size_class_t::large);
 }
 
 void* byte_buffer_t::operator new(size_t sz)
 {
   assert(sz == sizeof(byte_buffer_t));
-  void* ptr = byte_buffer_pool::get_instance()->allocate_node(sz);
+  void* ptr = allocate_block(byte_buffer_size_class_t::large);
   if (ptr == nullptr) {
     throw std::bad_alloc();
   }
@@ -42,7 +82,53 @@ void* byte_buffer_t::operator new(size_t sz)
 
 void byte_buffer_t::operator delete(void* ptr)
 {
-  byte_buffer_pool::get_instance()->deallocate_node(ptr);
+  void* block = static_cast<uint8_t*>(ptr) - pool_header_len;
+  switch (static_cast<pool_block_header_t*>(block)->size_class) {
+    case byte_buffer_size_class_t::small:
+      small_byte_buffer_pool::get_instance()->deallocate_node(block);
+      break;
+    case byte_buffer_size_class_t::medium:
+      medium_byte_buffer_pool::get_instance()->deallocate_node(block);
+      break;
+    case byte_buffer_size_class_t::large:
+      byte_buffer_pool::get_instance()->deallocate_node(block);
+      break;
+  }
+}
+
+void get_byte_buffer_pool_metrics(std::vector<pool_metrics_t>& metrics)
+{
+  metrics.push_back(small_byte_buffer_pool::get_instance()->get_metrics("byte_buffer_small"));
+  metrics.push_back(medium_byte_buffer_pool::get_instance()->get_metrics("byte_buffer_medium"));
+  metrics.push_back(byte_buffer_pool::get_instance()->get_metrics("byte_buffer_large"));
+}
+
+unique_byte_buffer_t make_sized_byte_buffer(uint32_t payload_len, const char* debug_ctxt) noexcept
+{
+  byte_buffer_size_class_t size_class   = byte_buffer_size_class_t::large;
+  uint32_t                 buffer_len   = SRSRAN_MAX_BUFFER_SIZE_BYTES;
+  uint32_t                 headroom_len = SRSRAN_BUFFER_HEADER_OFFSET;
+  if (payload_len + SRSRAN_SIZED_BUFFER_TRAILER_MARGIN <=
+      SRSRAN_SMALL_BUFFER_SIZE_BYTES - SRSRAN_SMALL_BUFFER_HEADROOM) {
+    size_class   = byte_buffer_size_class_t::small;
+    buffer_len   = SRSRAN_SMALL_BUFFER_SIZE_BYTES;
+    headroom_len = SRSRAN_SMALL_BUFFER_HEADROOM;
+  } else if (payload_len + SRSRAN_SIZED_BUFFER_TRAILER_MARGIN <=
+             SRSRAN_MEDIUM_BUFFER_SIZE_BYTES - SRSRAN_MEDIUM_BUFFER_HEADROOM) {
+    size_class   = byte_buffer_size_class_t::medium;
+    buffer_len   = SRSRAN_MEDIUM_BUFFER_SIZE_BYTES;
+    headroom_len = SRSRAN_MEDIUM_BUFFER_HEADROOM;
+  }
+
+  void* ptr = allocate_block(size_class);
+  if (ptr == nullptr) {
+    if (debug_ctxt != nullptr) {
+      srslog::fetch_basic_logger("POOL").error(
+          "Failed to allocate byte buffer of %d bytes in %s", payload_len, debug_ctxt);
+    }
+    return nullptr;
+  }
+  return unique_byte_buffer_t(::new (ptr) byte_buffer_t(buffer_len, headroom_len, true));
 }
 
 } // namespace srsran
@@ -0,0 +1,256 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/iq_tap.h"
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace srsran {
+
+// O_DIRECT transfers must be aligned to the logical block size of the device, 4 KiB covers all of them
+static const size_t iq_tap_block_size = 4096;
+
+iq_tap::~iq_tap()
+{
+  stop();
+}
+
+bool iq_tap::start(const std::string& filename, uint32_t nof_slots, uint32_t max_buffer_bytes)
+{
+  if (running or nof_slots == 0) {
+    return false;
+  }
+
+  // Bypass the page cache when the file system allows it, tmpfs for instance rejects O_DIRECT
+  fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+  if (fd < 0 and errno == EINVAL) {
+    fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  }
+  if (fd < 0) {
+    return false;
+  }
+  index = fopen((filename + ".csv").c_str(), "w");
+  if (index == nullptr) {
+    stop();
+    return false;
+  }
+  fprintf(index, "tti,direction,cc,port,format,offset,nof_bytes,rntis\n");
+
+  // The slots are allocated together, the mapping is page aligned as O_DIRECT requires
+  slot_len  = (max_buffer_bytes + iq_tap_block_size - 1) / iq_tap_block_size * iq_tap_block_size;
+  ring_len  = slot_len * nof_slots;
+  void* ptr = mmap(nullptr, ring_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+  if (ptr == MAP_FAILED) {
+    ring_len = 0;
+    stop();
+    return false;
+  }
+  ring = static_cast<uint8_t*>(ptr);
+  slots.assign(nof_slots, slot_t{});
+
+  rd_idx   = 0;
+  wr_idx   = 0;
+  dropped  = 0;
+  file_pos = 0;
+  stopping = false;
+  running  = true;
+  if (not thread::start()) {
+    running = false;
+    stop();
+    return false;
+  }
+  return true;
+}
+
+void iq_tap::stop()
+{
+  if (running) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    cvar.notify_one();
+    wait_thread_finish();
+    running = false;
+  }
+
+  if (index != nullptr) {
+    fclose(index);
+    index = nullptr;
+  }
+  if (fd >= 0) {
+    close(fd);
+    fd = -1;
+  }
+  release_ring();
+}
+
+void iq_tap::release_ring()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (ring != nullptr) {
+    munmap(ring, ring_len);
+    ring = nullptr;
+  }
+  ring_len = 0;
+  slots.clear();
+}
+
+bool iq_tap::push(direction_t                  dir,
+                  uint32_t                     tti,
+                  uint32_t                     cc_idx,
+                  uint32_t                     port_idx,
+                  bool                         sc16,
+                  const void*                  samples,
+                  uint32_t                     nof_bytes,
+                  srsran::span<const uint16_t> rntis)
+{
+  if (not running or nof_bytes > slot_len) {
+    return false;
+  }
+
+  // Claim the next slot, the copy is done without holding the lock
+  slot_t*  slot = nullptr;
+  uint8_t* dst  = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopping or wr_idx - rd_idx >= slots.size()) {
+      dropped++;
+      return false;
+    }
+    size_t pos  = wr_idx % slots.size();
+    slot        = &slots[pos];
+    dst         = ring + pos * slot_len;
+    slot->state = slot_state_t::writing;
+    wr_idx++;
+  }
+
+  memcpy(dst, samples, nof_bytes);
+  slot->dir       = dir;
+  slot->tti       = tti;
+  slot->cc_idx    = cc_idx;
+  slot->port_idx  = port_idx;
+  slot->sc16      = sc16;
+  slot->nof_bytes = nof_bytes;
+  slot->nof_rntis = std::min(static_cast<uint32_t>(rntis.size()), max_nof_rntis);
+  std::copy(rntis.begin(), rntis.begin() + slot->nof_rntis, slot->rntis.begin());
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    slot->state = slot_state_t::ready;
+  }
+  cvar.notify_one();
+  return true;
+}
+
+uint64_t iq_tap::nof_dropped() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return dropped;
+}
+
+void iq_tap::run_thread()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    cvar.wait(lock, [this]() {
+      return (rd_idx < wr_idx and slots[rd_idx % slots.size()].state == slot_state_t::ready) or
+             (stopping and rd_idx == wr_idx);
+    });
+    if (rd_idx == wr_idx) {
+      break;
+    }
+
+    // Write the ready slots that are contiguous in the ring with a single call
+    uint64_t first = rd_idx;
+    uint32_t count = 0;
+    while (first + count < wr_idx and slots[(first + count) % slots.size()].state == slot_state_t::ready and
+           (first % slots.size()) + count < slots.size()) {
+      count++;
+    }
+
+    lock.unlock();
+    bool ok = write_slots(first, count);
+    lock.lock();
+
+    for (uint32_t i = 0; i < count; i++) {
+      slots[(first + i) % slots.size()].state = slot_state_t::free;
+    }
+    rd_idx += count;
+    if (not ok) {
+      // Keep draining the ring so that the workers are not blocked, the rest of the capture is lost
+      dropped += count;
+    }
+  }
+}
+
+bool iq_tap::write_slots(uint64_t first, uint32_t count)
+{
+  uint8_t* block = ring + (first % slots.size()) * slot_len;
+
+  // Clear the padding up to the end of each slot, so that no stale samples end up in the file
+  for (uint32_t i = 0; i < count; i++) {
+    const slot_t& slot = slots[(first + i) % slots.size()];
+    memset(block + i * slot_len + slot.nof_bytes, 0, slot_len - slot.nof_bytes);
+  }
+
+  size_t len     = count * slot_len;
+  size_t written = 0;
+  while (written < len) {
+    ssize_t n = write(fd, block + written, len - written);
+    if (n < 0 and errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    written += n;
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    write_index(slots[(first + i) % slots.size()], file_pos + i * slot_len);
+  }
+  file_pos += len;
+  return true;
+}
+
+void iq_tap::write_index(const slot_t& slot, uint64_t offset)
+{
+  fprintf(index,
+          "%u,%s,%u,%u,%s,%lu,%u,",
+          slot.tti,
+          slot.dir == direction_t::rx ? "rx" : "tx",
+          slot.cc_idx,
+          slot.port_idx,
+          slot.sc16 ? "sc16" : "fc32",
+          (unsigned long)offset,
+          slot.nof_bytes);
+  for (uint32_t i = 0; i < slot.nof_rntis; i++) {
+    fprintf(index, i == 0 ? "0x%x" : ";0x%x", slot.rntis[i]);
+  }
+  fprintf(index, "\n");
+}
+
+} // namespace srsran
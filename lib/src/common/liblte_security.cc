@@ -21,6 +21,7 @@
 #include "srsran/common/ssl.h"
 #include "srsran/common/zuc.h"
 
+#include <algorithm>
 #include <arpa/inet.h>
 
 /*******************************************************************************
@@ -784,10 +785,19 @@ LIBLTE_ERROR_ENUM liblte_security_128_eia3(const uint8* key,
 
     zuc_generate_keystream(&zuc_state, L, ks);
 
+    // T is the XOR of the keystream words starting at the set bits of msg. The words of each 32 bits of msg are read
+    // from a 64-bit window of the keystream, instead of being rebuilt bit by bit
     uint32_t T = 0;
-    for (uint32_t i = 0; i < msg_len; i++) {
-      if (GET_BIT(msg, i)) {
-        T ^= GET_WORD(ks, i);
+    for (uint32_t w = 0; w * 32 < msg_len; w++) {
+      uint64_t win    = ((uint64_t)ks[w] << 32U) | ks[w + 1];
+      uint32_t nbits  = std::min(msg_len - w * 32, 32U);
+      uint32_t m_word = 0;
+      for (uint32_t j = 0; j < (nbits + 7) / 8; j++) {
+        m_word |= (uint32_t)msg[w * 4 + j] << (24 - 8 * j);
+      }
+      for (uint32_t b = 0; b < nbits; b++) {
+        uint32_t bit = (m_word >> (31 - b)) & 0x1;
+        T ^= (uint32_t)(win >> (32 - b)) & (0 - bit);
       }
     }
 
@@ -39,6 +39,11 @@ uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_)
     return SRSRAN_ERROR;
   }
 
+  if (not ring.init(capture_ring_size)) {
+    logger.error("Couldn't allocate the PCAP capture ring for %s", filename_.c_str());
+    return SRSRAN_ERROR;
+  }
+
   // set UDP DLT
   dlt       = UDP_DLT;
   pcap_file = DLT_PCAP_Open(dlt, filename_.c_str());
@@ -66,9 +71,8 @@ uint32_t mac_pcap::close()
     }
 
     // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+    running = false;
+    ring.stop();
   }
 
   wait_thread_finish();
@@ -84,20 +88,11 @@ uint32_t mac_pcap::close()
   return SRSRAN_SUCCESS;
 }
 
-void mac_pcap::write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu)
+void mac_pcap::write_records(srsran::span<const uint8_t> records)
 {
-  if (pdu.pdu != nullptr) {
-    switch (pdu.rat) {
-      case srsran_rat_t::lte:
-        LTE_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      case srsran_rat_t::nr:
-        NR_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context_nr, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      default:
-        logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
-    }
+  if (fwrite(records.data(), 1, records.size(), pcap_file) != records.size()) {
+    logger.error("Error writing %zd B to PCAP file %s", records.size(), filename.c_str());
   }
 }
 
-} // namespace srsran
\ No newline at end of file
+} // namespace srsran
@@ -23,6 +23,7 @@
 #include "srsran/config.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/support/emergency_handlers.h"
+#include <algorithm>
 #include <stdint.h>
 
 namespace srsran {
@@ -57,26 +58,43 @@ void mac_pcap_base::set_ue_id(uint16_t ue_id_)
   ue_id = ue_id_;
 }
 
+void mac_pcap_base::set_snaplen(uint32_t snaplen)
+{
+  ring.set_snaplen(snaplen);
+}
+
+void mac_pcap_base::set_sampling(uint32_t sampling_rate_)
+{
+  sampling_rate = std::max(sampling_rate_, 1u);
+}
+
+bool mac_pcap_base::sample_pdu()
+{
+  uint32_t rate = sampling_rate.load(std::memory_order_relaxed);
+  return rate == 1 or sampling_count.fetch_add(1, std::memory_order_relaxed) % rate == 0;
+}
+
 void mac_pcap_base::run_thread()
 {
-  // blocking write until stopped
+  // write the records in large blocks until stopped
   while (running) {
-    pcap_pdu_t pdu = queue.pop_blocking();
-    {
+    srsran::span<const uint8_t> block = ring.wait_block(std::chrono::milliseconds(100));
+    if (not block.empty()) {
       std::lock_guard<std::mutex> lock(mutex);
-      write_pdu(pdu);
+      write_records(block);
+      ring.release(block.size());
     }
   }
 
-  // write remainder of queue
-  pcap_pdu_t pdu = {};
-  while (queue.try_pop(pdu)) {
+  // write remainder of the ring
+  for (srsran::span<const uint8_t> block = ring.front_block(); not block.empty(); block = ring.front_block()) {
     std::lock_guard<std::mutex> lock(mutex);
-    write_pdu(pdu);
+    write_records(block);
+    ring.release(block.size());
   }
 }
 
-// Function called from PHY worker context, locking not needed as PDU queue is thread-safe
+// Function called from PHY worker context, locking not needed as the capture ring is thread-safe
 void mac_pcap_base::pack_and_queue(uint8_t* payload,
                                    uint32_t payload_len,
                                    uint16_t ue_id,
@@ -88,36 +106,29 @@ void mac_pcap_base::pack_and_queue(uint8_t* payload,
                                    uint8_t  direction,
                                    uint8_t  rnti_type)
 {
-  if (running && payload != nullptr) {
-    pcap_pdu_t pdu             = {};
-    pdu.rat                    = srsran::srsran_rat_t::lte;
-    pdu.context.radioType      = FDD_RADIO;
-    pdu.context.direction      = direction;
-    pdu.context.rntiType       = rnti_type;
-    pdu.context.rnti           = crnti;
-    pdu.context.ueid           = ue_id;
-    pdu.context.isRetx         = (uint8_t)reTX;
-    pdu.context.crcStatusOK    = crc_ok;
-    pdu.context.cc_idx         = cc_idx;
-    pdu.context.sysFrameNumber = (uint16_t)(tti / 10);
-    pdu.context.subFrameNumber = (uint16_t)(tti % 10);
-
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
-        logger.warning("Dropping PDU (%d B) in PCAP. Write queue full.", payload_len);
-      }
-    } else {
-      logger.warning("Dropping PDU in PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
+  if (running && payload != nullptr && sample_pdu()) {
+    MAC_Context_Info_t context = {};
+    context.radioType          = FDD_RADIO;
+    context.direction          = direction;
+    context.rntiType           = rnti_type;
+    context.rnti               = crnti;
+    context.ueid               = ue_id;
+    context.isRetx             = (uint8_t)reTX;
+    context.crcStatusOK        = crc_ok;
+    context.cc_idx             = cc_idx;
+    context.sysFrameNumber     = (uint16_t)(tti / 10);
+    context.subFrameNumber     = (uint16_t)(tti % 10);
+
+    // the header is packed on the stack, so the PDU is only copied once, into the capture ring
+    uint8_t  hdr[PCAP_CONTEXT_HEADER_MAX];
+    uint32_t hdr_len = LTE_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(&context, payload_len, hdr);
+    if (not ring.push(hdr, hdr_len, payload, payload_len)) {
+      logger.warning("Dropping PDU (%d B) in PCAP. Write queue full.", payload_len);
     }
   }
 }
 
-// Function called from PHY worker context, locking not needed as PDU queue is thread-safe
+// Function called from PHY worker context, locking not needed as the capture ring is thread-safe
 void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
                                       uint32_t payload_len,
                                       uint32_t tti,
@@ -127,29 +138,21 @@ void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
                                       uint8_t  direction,
                                       uint8_t  rnti_type)
 {
-  if (running && payload != nullptr) {
-    pcap_pdu_t pdu                     = {};
-    pdu.rat                            = srsran_rat_t::nr;
-    pdu.context_nr.radioType           = FDD_RADIO;
-    pdu.context_nr.direction           = direction;
-    pdu.context_nr.rntiType            = rnti_type;
-    pdu.context_nr.rnti                = crnti;
-    pdu.context_nr.ueid                = ue_id;
-    pdu.context_nr.harqid              = harqid;
-    pdu.context_nr.system_frame_number = tti / 10;
-    pdu.context_nr.sub_frame_number    = tti % 10;
-
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
-      if (not queue.try_push(std::move(pdu))) {
-        logger.warning("Dropping PDU (%d B) in NR PCAP. Write queue full.", payload_len);
-      }
-    } else {
-      logger.warning("Dropping PDU in NR PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
+  if (running && payload != nullptr && sample_pdu()) {
+    mac_nr_context_info_t context = {};
+    context.radioType             = FDD_RADIO;
+    context.direction             = direction;
+    context.rntiType              = rnti_type;
+    context.rnti                  = crnti;
+    context.ueid                  = ue_id;
+    context.harqid                = harqid;
+    context.system_frame_number   = tti / 10;
+    context.sub_frame_number      = tti % 10;
+
+    uint8_t  hdr[PCAP_CONTEXT_HEADER_MAX];
+    uint32_t hdr_len = NR_PCAP_PACK_MAC_UDP_HEADER_TO_BUFFER(&context, payload_len, hdr);
+    if (not ring.push(hdr, hdr_len, payload, payload_len)) {
+      logger.warning("Dropping PDU (%d B) in NR PCAP. Write queue full.", payload_len);
     }
   }
 }
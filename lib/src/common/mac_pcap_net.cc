@@ -20,6 +20,8 @@
  */
 
 #include "srsran/common/mac_pcap_net.h"
+#include <array>
+#include <sys/socket.h>
 
 namespace srsran {
 
@@ -42,6 +44,11 @@ uint32_t mac_pcap_net::open(std::string client_ip_addr_,
     return SRSRAN_ERROR;
   }
 
+  if (not ring.init(capture_ring_size)) {
+    logger.error("Couldn't allocate the PCAP capture ring for %s", bind_addr_str.c_str());
+    return SRSRAN_ERROR;
+  }
+
   if (not socket.open_socket(
           net_utils::addr_family::ipv4, net_utils::socket_type::datagram, net_utils::protocol_type::UDP)) {
     logger.error("Couldn't open socket %s to write PCAP", bind_addr_str.c_str());
@@ -63,8 +70,8 @@ uint32_t mac_pcap_net::open(std::string client_ip_addr_,
     logger.error("Invalid client_ip_addr: %s", client_ip_addr_.c_str());
     return SRSRAN_ERROR;
   }
-  running                     = true;
-  ue_id                       = ue_id_;
+  running = true;
+  ue_id   = ue_id_;
   // start writer thread
   start();
 
@@ -80,9 +87,8 @@ uint32_t mac_pcap_net::close()
     }
 
     // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+    running = false;
+    ring.stop();
   }
 
   wait_thread_finish();
@@ -95,87 +101,44 @@ uint32_t mac_pcap_net::close()
   return SRSRAN_SUCCESS;
 }
 
-void mac_pcap_net::write_pdu(pcap_pdu_t& pdu)
+void mac_pcap_net::write_records(srsran::span<const uint8_t> records)
 {
-  if (pdu.pdu != nullptr && socket.is_open()) {
-    switch (pdu.rat) {
-      case srsran_rat_t::lte:
-        write_mac_lte_pdu_to_net(pdu);
-        break;
-      case srsran_rat_t::nr:
-        write_mac_nr_pdu_to_net(pdu);
-        break;
-      default:
-        logger.error("Error writing PDU to PCAP socket. Unsupported RAT selected.");
-    }
-  }
-}
-
-void mac_pcap_net::write_mac_lte_pdu_to_net(pcap_pdu_t& pdu)
-{
-  int      bytes_sent;
-  uint32_t offset = 0;
-  uint8_t  buffer[PCAP_CONTEXT_HEADER_MAX];
-
-  // MAC_LTE_START_STRING for UDP heuristics
-  memcpy(buffer + offset, MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
-  offset += strlen(MAC_LTE_START_STRING);
-
-  offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
-
-  if (pdu.pdu.get()->get_headroom() < offset) {
-    logger.error("PDU headroom is to small for adding context buffer");
+  if (not socket.is_open()) {
     return;
   }
 
-  pdu.pdu.get()->msg -= offset;
-  memcpy(pdu.pdu.get()->msg, buffer, offset);
-  pdu.pdu.get()->N_bytes += offset;
-
-  bytes_sent = sendto(socket.get_socket(),
-                      pdu.pdu.get()->msg,
-                      pdu.pdu.get()->N_bytes,
-                      0,
-                      (const struct sockaddr*)&client_addr,
-                      sizeof(client_addr));
+  // The UDP datagrams carry the MAC context and the PDU of each record, without the PCAP record and UDP headers
+  std::array<struct mmsghdr, max_send_batch> msgs   = {};
+  std::array<struct iovec, max_send_batch>   iovs   = {};
+  size_t                                     offset = 0;
+  while (offset < records.size()) {
+    unsigned nof_msgs = 0;
+    while (nof_msgs < max_send_batch and offset < records.size()) {
+      pcaprec_hdr_t rec_hdr;
+      memcpy(&rec_hdr, records.data() + offset, sizeof(rec_hdr));
+      const uint8_t* rec_data = records.data() + offset + sizeof(rec_hdr);
+      offset += sizeof(rec_hdr) + rec_hdr.incl_len;
+      if (rec_hdr.incl_len <= dummy_udp_header_len) {
+        continue;
+      }
+
+      iovs[nof_msgs].iov_base            = const_cast<uint8_t*>(rec_data + dummy_udp_header_len);
+      iovs[nof_msgs].iov_len             = rec_hdr.incl_len - dummy_udp_header_len;
+      msgs[nof_msgs].msg_hdr.msg_name    = &client_addr;
+      msgs[nof_msgs].msg_hdr.msg_namelen = sizeof(client_addr);
+      msgs[nof_msgs].msg_hdr.msg_iov     = &iovs[nof_msgs];
+      msgs[nof_msgs].msg_hdr.msg_iovlen  = 1;
+      nof_msgs++;
+    }
+    if (nof_msgs == 0) {
+      continue;
+    }
 
-  if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
-    logger.error(
-        "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+    int nof_sent = sendmmsg(socket.get_socket(), msgs.data(), nof_msgs, 0);
+    if (nof_sent != (int)nof_msgs) {
+      logger.error("Sending UDP packets mismatches %d != %d (err %s)", nof_sent, nof_msgs, strerror(errno));
+    }
   }
 }
 
-void mac_pcap_net::write_mac_nr_pdu_to_net(pcap_pdu_t& pdu)
-{
-  int      bytes_sent;
-  uint32_t offset = 0;
-  uint8_t  buffer[PCAP_CONTEXT_HEADER_MAX];
-
-  // MAC_LTE_START_STRING for UDP heuristics
-  memcpy(buffer + offset, MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
-  offset += strlen(MAC_LTE_START_STRING);
-
-  offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context_nr, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
-
-  if (pdu.pdu.get()->get_headroom() < offset) {
-    logger.error("PDU headroom is to small for adding context buffer");
-    return;
-  }
-
-  pdu.pdu.get()->msg -= offset;
-  memcpy(pdu.pdu.get()->msg, buffer, offset);
-  pdu.pdu.get()->N_bytes += offset;
-
-  bytes_sent = sendto(socket.get_socket(),
-                      pdu.pdu.get()->msg,
-                      pdu.pdu.get()->N_bytes,
-                      0,
-                      (const struct sockaddr*)&client_addr,
-                      sizeof(client_addr));
-
-  if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
-    logger.error(
-        "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
-  }
-}
-} // namespace srsran
\ No newline at end of file
+} // namespace srsran
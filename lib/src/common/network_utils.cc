@@ -20,7 +20,9 @@
  */
 
 #include "srsran/common/network_utils.h"
+#include "srsran/common/thread_affinity.h"
 
+#include <array>
 #include <netinet/sctp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -305,6 +307,116 @@ bool sctp_set_init_msg_opts(int fd, int init_max_attempts, int max_init_timeo)
   }
   return true;
 }
+
+bool udp_gso_supported(int fd)
+{
+  int       gso_size = 0;
+  socklen_t len      = sizeof(gso_size);
+  return getsockopt(fd, SOL_UDP, UDP_SEGMENT, &gso_size, &len) == 0;
+}
+
+bool enable_udp_gro(int fd)
+{
+  int enable = 1;
+  if (setsockopt(fd, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) < 0) {
+    srslog::fetch_basic_logger(LOGSERVICE).info("UDP GRO not supported. Socket=%d", fd);
+    return false;
+  }
+  return true;
+}
+
+uint32_t get_udp_gro_size(msghdr* msg, uint32_t msg_len)
+{
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_UDP and cmsg->cmsg_type == UDP_GRO) {
+      int gso_size = 0;
+      memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+      return gso_size > 0 ? gso_size : msg_len;
+    }
+  }
+  return msg_len;
+}
+
+uint32_t send_datagrams(int fd, const iovec* bufs, const sockaddr_in* addrs, uint32_t nof_datagrams, bool& gso)
+{
+  // Limits of the kernel for a single GSO message
+  const uint32_t max_gso_segments = 64;
+  const uint32_t max_gso_len      = 65507;
+
+  union gso_cmsg_t {
+    char    buf[CMSG_SPACE(sizeof(uint16_t))];
+    cmsghdr align;
+  };
+  std::array<mmsghdr, max_send_datagrams>    msgs;
+  std::array<gso_cmsg_t, max_send_datagrams> cmsgs;
+  std::array<uint32_t, max_send_datagrams>   msg_nof_datagrams;
+
+  nof_datagrams = std::min(nof_datagrams, max_send_datagrams);
+
+  uint32_t nof_msgs = 0;
+  for (uint32_t i = 0; i < nof_datagrams;) {
+    // Extend the message with the following datagrams of the same size and destination
+    uint32_t n   = 1;
+    uint32_t len = bufs[i].iov_len;
+    if (gso) {
+      for (; i + n < nof_datagrams and n < max_gso_segments and len + bufs[i + n].iov_len <= max_gso_len; ++n) {
+        if (addrs[i + n].sin_addr.s_addr != addrs[i].sin_addr.s_addr or addrs[i + n].sin_port != addrs[i].sin_port or
+            bufs[i + n].iov_len > bufs[i].iov_len) {
+          break;
+        }
+        len += bufs[i + n].iov_len;
+        if (bufs[i + n].iov_len < bufs[i].iov_len) {
+          // A shorter datagram ends the GSO message
+          ++n;
+          break;
+        }
+      }
+    }
+    mmsghdr& m            = msgs[nof_msgs];
+    m                     = {};
+    m.msg_hdr.msg_name    = const_cast<sockaddr_in*>(&addrs[i]);
+    m.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    m.msg_hdr.msg_iov     = const_cast<iovec*>(&bufs[i]);
+    m.msg_hdr.msg_iovlen  = n;
+    if (n > 1) {
+      m.msg_hdr.msg_control    = cmsgs[nof_msgs].buf;
+      m.msg_hdr.msg_controllen = sizeof(cmsgs[nof_msgs].buf);
+      cmsghdr* cmsg            = CMSG_FIRSTHDR(&m.msg_hdr);
+      cmsg->cmsg_level         = SOL_UDP;
+      cmsg->cmsg_type          = UDP_SEGMENT;
+      cmsg->cmsg_len           = CMSG_LEN(sizeof(uint16_t));
+      uint16_t gso_size        = bufs[i].iov_len;
+      memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+    }
+    msg_nof_datagrams[nof_msgs++] = n;
+    i += n;
+  }
+
+  // sendmmsg() may send only part of the batch
+  uint32_t nof_sent      = 0;
+  uint32_t nof_sent_msgs = 0;
+  while (nof_sent_msgs < nof_msgs) {
+    int ret = sendmmsg(fd, &msgs[nof_sent_msgs], nof_msgs - nof_sent_msgs, 0);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (gso and msgs[nof_sent_msgs].msg_hdr.msg_iovlen > 1) {
+        srslog::fetch_basic_logger(LOGSERVICE)
+            .warning("UDP GSO rejected (%s). Sending the datagrams one by one. Socket=%d", strerror(errno), fd);
+        gso = false;
+        return nof_sent + send_datagrams(fd, &bufs[nof_sent], &addrs[nof_sent], nof_datagrams - nof_sent, gso);
+      }
+      srslog::fetch_basic_logger(LOGSERVICE).error("Error sending datagrams: %s. Socket=%d", strerror(errno), fd);
+      break;
+    }
+    for (int i = 0; i < ret; ++i) {
+      nof_sent += msg_nof_datagrams[nof_sent_msgs++];
+    }
+  }
+  return nof_sent;
+}
+
 } // namespace net_utils
 
 /********************************************
@@ -400,6 +512,8 @@ socket_manager::socket_manager() : thread("RXsockets"), socket_manager_itf(srslo
   // register control pipe fd
   int fd = pipe(pipefd);
   srsran_assert(fd != -1, "Failed to open control pipe");
+  // Set before the thread starts, so that a stop() right after the construction waits for the thread
+  running = true;
   start(thread_prio);
 }
 
@@ -513,7 +627,7 @@ socket_manager::remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max
 
 void socket_manager::run_thread()
 {
-  running = true;
+  apply_thread_affinity(thread_class_t::gtpu);
   fd_set total_fd_set, read_fd_set;
   FD_ZERO(&total_fd_set);
   int max_fd = 0;
@@ -650,27 +764,50 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 
 /**
  * Description: Functor for the case the received data is
- * in the form of unique_byte_buffer, and a recvfrom(...) call is used
+ * in the form of unique_byte_buffer, and a recvmmsg(...) call is used to read all the pending datagrams at once
  */
 class recvfrom_pdu_task
 {
 public:
   using callback_t = recvfrom_callback_t;
+  /// Maximum number of datagrams read by a single recvmmsg() call
+  static const uint32_t max_batch_size = 32;
+
   explicit recvfrom_pdu_task(srslog::basic_logger& logger, srsran::task_queue_handle& queue_, callback_t func_) :
     logger(logger), queue(queue_), func(std::move(func_))
   {}
 
   bool operator()(int fd)
   {
-    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-    if (pdu == nullptr) {
+    // The buffers handed to the queue in the previous call are replaced with new ones from the pool
+    std::array<struct mmsghdr, max_batch_size> msgs;
+    std::array<struct iovec, max_batch_size>   iovs;
+    std::array<sockaddr_in, max_batch_size>    froms;
+    uint32_t                                   nof_bufs = 0;
+    for (; nof_bufs < max_batch_size; ++nof_bufs) {
+      srsran::unique_byte_buffer_t& pdu = pdus[nof_bufs];
+      if (pdu == nullptr) {
+        pdu = srsran::make_byte_buffer();
+        if (pdu == nullptr) {
+          break;
+        }
+      }
+      iovs[nof_bufs].iov_base            = pdu->msg;
+      iovs[nof_bufs].iov_len             = pdu->get_tailroom();
+      froms[nof_bufs]                    = {};
+      msgs[nof_bufs]                     = {};
+      msgs[nof_bufs].msg_hdr.msg_name    = &froms[nof_bufs];
+      msgs[nof_bufs].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      msgs[nof_bufs].msg_hdr.msg_iov     = &iovs[nof_bufs];
+      msgs[nof_bufs].msg_hdr.msg_iovlen  = 1;
+    }
+    if (nof_bufs == 0) {
       logger.error("Unable to allocate byte buffer");
       return true;
     }
-    sockaddr_in from    = {};
-    socklen_t   fromlen = sizeof(from);
 
-    ssize_t n_recv = recvfrom(fd, pdu->msg, pdu->get_tailroom(), 0, (struct sockaddr*)&from, &fromlen);
+    // The socket has data, so only the datagrams after the first one may be missing
+    int n_recv = recvmmsg(fd, msgs.data(), nof_bufs, MSG_DONTWAIT, nullptr);
     if (n_recv == -1 and errno != EAGAIN) {
       logger.error("Error reading from socket: %s", strerror(errno));
       return true;
@@ -680,19 +817,22 @@ public:
       return true;
     }
 
-    pdu->N_bytes = static_cast<uint32_t>(n_recv);
-
-    // Defer handling of received packet to provided queue
-    queue.push(
-        std::bind([this, from](srsran::unique_byte_buffer_t& sdu) { func(std::move(sdu), from); }, std::move(pdu)));
+    // Defer handling of received packets to provided queue
+    for (int i = 0; i < n_recv; ++i) {
+      pdus[i]->N_bytes = msgs[i].msg_len;
+      sockaddr_in from = froms[i];
+      queue.push(std::bind(
+          [this, from](srsran::unique_byte_buffer_t& sdu) { func(std::move(sdu), from); }, std::move(pdus[i])));
+    }
 
     return true;
   }
 
 private:
-  srslog::basic_logger&      logger;
-  srsran::task_queue_handle& queue;
-  callback_t                 func;
+  srslog::basic_logger&                                    logger;
+  srsran::task_queue_handle&                               queue;
+  callback_t                                               func;
+  std::array<srsran::unique_byte_buffer_t, max_batch_size> pdus;
 };
 
 socket_manager_itf::recv_callback_t
@@ -0,0 +1,189 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap_capture_ring.h"
+#include <algorithm>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+
+namespace srsran {
+
+static const size_t huge_page_size = 2 * 1024 * 1024;
+
+pcap_capture_ring::~pcap_capture_ring()
+{
+  if (buffer != nullptr) {
+    munmap(buffer, alloc_len);
+  }
+}
+
+bool pcap_capture_ring::init(size_t capacity_bytes)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  rpos     = 0;
+  wpos     = 0;
+  wrapped  = false;
+  pending  = 0;
+  stopping = false;
+  dropped  = 0;
+  if (buffer != nullptr and cap == capacity_bytes) {
+    end = cap;
+    return true;
+  }
+
+  if (buffer != nullptr) {
+    munmap(buffer, alloc_len);
+    buffer = nullptr;
+  }
+  cap = 0;
+  end = 0;
+
+  // Round the allocation to whole huge pages, and fall back to regular pages if no huge pages are reserved
+  alloc_len = (capacity_bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+  void* ptr =
+      mmap(nullptr, alloc_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+  if (ptr == MAP_FAILED) {
+    ptr = mmap(nullptr, alloc_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (ptr != MAP_FAILED) {
+      madvise(ptr, alloc_len, MADV_HUGEPAGE);
+    }
+  }
+  if (ptr == MAP_FAILED) {
+    alloc_len = 0;
+    return false;
+  }
+  buffer = static_cast<uint8_t*>(ptr);
+  cap    = capacity_bytes;
+  end    = cap;
+  return true;
+}
+
+void pcap_capture_ring::set_snaplen(uint32_t snaplen_)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  snaplen = snaplen_;
+}
+
+bool pcap_capture_ring::push(const uint8_t* hdr, uint32_t hdr_len, const uint8_t* payload, uint32_t payload_len)
+{
+  uint32_t orig_len = hdr_len + payload_len;
+
+  pcaprec_hdr_t  rec_hdr;
+  struct timeval t;
+  gettimeofday(&t, nullptr);
+  rec_hdr.ts_sec   = t.tv_sec;
+  rec_hdr.ts_usec  = t.tv_usec;
+  rec_hdr.orig_len = orig_len;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  rec_hdr.incl_len = (snaplen > 0 and orig_len > snaplen) ? snaplen : orig_len;
+  size_t rec_len   = sizeof(pcaprec_hdr_t) + rec_hdr.incl_len;
+
+  // Find room for the whole record, going back to the start of the ring if it does not fit before the end
+  if (not wrapped and rpos == wpos) {
+    // The ring is empty, restart from its beginning
+    rpos = 0;
+    wpos = 0;
+  }
+  size_t pos = wpos;
+  if (not wrapped) {
+    if (cap - wpos < rec_len) {
+      if (rpos < rec_len) {
+        dropped++;
+        return false;
+      }
+      end     = wpos;
+      pos     = 0;
+      wrapped = true;
+    }
+  } else if (rpos - wpos < rec_len) {
+    dropped++;
+    return false;
+  }
+
+  uint8_t* dst = buffer + pos;
+  memcpy(dst, &rec_hdr, sizeof(pcaprec_hdr_t));
+  dst += sizeof(pcaprec_hdr_t);
+  uint32_t nof_hdr = std::min(hdr_len, rec_hdr.incl_len);
+  memcpy(dst, hdr, nof_hdr);
+  memcpy(dst + nof_hdr, payload, rec_hdr.incl_len - nof_hdr);
+  wpos = pos + rec_len;
+
+  // Wake the writer only once per block, it otherwise picks the records at its next timeout
+  bool notify = pending < flush_threshold and pending + rec_len >= flush_threshold;
+  pending += rec_len;
+  lock.unlock();
+  if (notify) {
+    cvar.notify_one();
+  }
+  return true;
+}
+
+span<const uint8_t> pcap_capture_ring::wait_block(std::chrono::milliseconds timeout)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  cvar.wait_for(lock, timeout, [this]() { return stopping or pending >= flush_threshold; });
+  return front_block_unlocked();
+}
+
+span<const uint8_t> pcap_capture_ring::front_block()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return front_block_unlocked();
+}
+
+span<const uint8_t> pcap_capture_ring::front_block_unlocked() const
+{
+  if (wrapped) {
+    return {buffer + rpos, end - rpos};
+  }
+  return {buffer + rpos, wpos - rpos};
+}
+
+void pcap_capture_ring::release(size_t nof_bytes)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  rpos += nof_bytes;
+  pending -= nof_bytes;
+  if (wrapped and rpos == end) {
+    rpos    = 0;
+    end     = cap;
+    wrapped = false;
+  }
+}
+
+void pcap_capture_ring::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  cvar.notify_one();
+}
+
+uint64_t pcap_capture_ring::nof_dropped() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return dropped;
+}
+
+} // namespace srsran
@@ -0,0 +1,48 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pkt_trace.h"
+#include <atomic>
+
+namespace srsran {
+
+namespace {
+
+std::atomic<uint32_t> trace_period{0};
+std::atomic<uint32_t> nof_packets{0};
+
+} // namespace
+
+void pkt_trace_set_period(uint32_t period)
+{
+  trace_period.store(period, std::memory_order_relaxed);
+}
+
+bool detail::pkt_trace_sample()
+{
+  uint32_t period = trace_period.load(std::memory_order_relaxed);
+  if (period == 0) {
+    return false;
+  }
+  return nof_packets.fetch_add(1, std::memory_order_relaxed) % period == 0;
+}
+
+} // namespace srsran
@@ -160,6 +160,34 @@ void s3g_deinitialize(S3G_STATE* state);
 *********************************************************************/
 void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
 
+/*********************************************************************
+    Name: s3g_tables_t
+
+    Description: Lookup tables of MUL_alpha, DIV_alpha and of the
+                 S-Boxes S1 and S2 combined with their MixColumn, so
+                 that the LFSR and the FSM are clocked with word
+                 operations. They are built once from the definitions
+                 of the specification.
+
+    Document Reference: Specification of the 3GPP Confidentiality and
+                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
+                            Section 3.3 and Section 3.4
+*********************************************************************/
+namespace {
+
+struct s3g_tables_t {
+  uint32_t mul_alpha[256];
+  uint32_t div_alpha[256];
+  uint32_t s1[4][256];
+  uint32_t s2[4][256];
+
+  s3g_tables_t();
+};
+
+const s3g_tables_t& s3g_tables();
+
+} // namespace
+
 /*********************************************************************
     Name: s3g_mul_x
 
@@ -235,21 +263,8 @@ uint32_t s3g_div_alpha(uint8_t c)
 *********************************************************************/
 uint32_t s3g_s1(uint32_t w)
 {
-  uint8_t r0 = 0, r1 = 0, r2 = 0, r3 = 0;
-  uint8_t srw0 = S[(uint8_t)((w >> 24) & 0xff)];
-  uint8_t srw1 = S[(uint8_t)((w >> 16) & 0xff)];
-  uint8_t srw2 = S[(uint8_t)((w >> 8) & 0xff)];
-  uint8_t srw3 = S[(uint8_t)((w)&0xff)];
-
-  r0 = ((s3g_mul_x(srw0, 0x1b)) ^ (srw1) ^ (srw2) ^ ((s3g_mul_x(srw3, 0x1b)) ^ srw3));
-
-  r1 = (((s3g_mul_x(srw0, 0x1b)) ^ srw0) ^ (s3g_mul_x(srw1, 0x1b)) ^ (srw2) ^ (srw3));
-
-  r2 = ((srw0) ^ ((s3g_mul_x(srw1, 0x1b)) ^ srw1) ^ (s3g_mul_x(srw2, 0x1b)) ^ (srw3));
-
-  r3 = ((srw0) ^ (srw1) ^ ((s3g_mul_x(srw2, 0x1b)) ^ srw2) ^ (s3g_mul_x(srw3, 0x1b)));
-
-  return ((((uint32_t)r0) << 24) | (((uint32_t)r1) << 16) | (((uint32_t)r2) << 8) | (((uint32_t)r3)));
+  const s3g_tables_t& t = s3g_tables();
+  return t.s1[0][(w >> 24) & 0xff] ^ t.s1[1][(w >> 16) & 0xff] ^ t.s1[2][(w >> 8) & 0xff] ^ t.s1[3][w & 0xff];
 }
 
 /*********************************************************************
@@ -263,23 +278,50 @@ uint32_t s3g_s1(uint32_t w)
 *********************************************************************/
 uint32_t s3g_s2(uint32_t w)
 {
-  uint8_t r0 = 0, r1 = 0, r2 = 0, r3 = 0;
-  uint8_t sqw0 = SQ[(uint8_t)((w >> 24) & 0xff)];
-  uint8_t sqw1 = SQ[(uint8_t)((w >> 16) & 0xff)];
-  uint8_t sqw2 = SQ[(uint8_t)((w >> 8) & 0xff)];
-  uint8_t sqw3 = SQ[(uint8_t)((w)&0xff)];
+  const s3g_tables_t& t = s3g_tables();
+  return t.s2[0][(w >> 24) & 0xff] ^ t.s2[1][(w >> 16) & 0xff] ^ t.s2[2][(w >> 8) & 0xff] ^ t.s2[3][w & 0xff];
+}
 
-  r0 = ((s3g_mul_x(sqw0, 0x69)) ^ (sqw1) ^ (sqw2) ^ ((s3g_mul_x(sqw3, 0x69)) ^ sqw3));
+/*********************************************************************
+    Name: s3g_tables_t
 
-  r1 = (((s3g_mul_x(sqw0, 0x69)) ^ sqw0) ^ (s3g_mul_x(sqw1, 0x69)) ^ (sqw2) ^ (sqw3));
+    Description: Each S-Box table entry is the contribution of one
+                 input byte to the output word, i.e. the MixColumn of
+                 the S-Box output placed at the position of that byte.
+*********************************************************************/
+namespace {
 
-  r2 = ((sqw0) ^ ((s3g_mul_x(sqw1, 0x69)) ^ sqw1) ^ (s3g_mul_x(sqw2, 0x69)) ^ (sqw3));
+void s3g_fill_mix_column(uint32_t t[4][256], const uint8_t sbox[256], uint8_t c)
+{
+  for (uint32_t x = 0; x < 256; x++) {
+    uint32_t v  = sbox[x];
+    uint32_t v2 = s3g_mul_x(sbox[x], c);
+    uint32_t v3 = v2 ^ v;
+    t[0][x]     = (v2 << 24) | (v3 << 16) | (v << 8) | v;
+    t[1][x]     = (v << 24) | (v2 << 16) | (v3 << 8) | v;
+    t[2][x]     = (v << 24) | (v << 16) | (v2 << 8) | v3;
+    t[3][x]     = (v3 << 24) | (v << 16) | (v << 8) | v2;
+  }
+}
 
-  r3 = ((sqw0) ^ (sqw1) ^ ((s3g_mul_x(sqw2, 0x69)) ^ sqw2) ^ (s3g_mul_x(sqw3, 0x69)));
+s3g_tables_t::s3g_tables_t()
+{
+  for (uint32_t c = 0; c < 256; c++) {
+    mul_alpha[c] = s3g_mul_alpha(c);
+    div_alpha[c] = s3g_div_alpha(c);
+  }
+  s3g_fill_mix_column(s1, S, 0x1b);
+  s3g_fill_mix_column(s2, SQ, 0x69);
+}
 
-  return ((((uint32_t)r0) << 24) | (((uint32_t)r1) << 16) | (((uint32_t)r2) << 8) | (((uint32_t)r3)));
+const s3g_tables_t& s3g_tables()
+{
+  static const s3g_tables_t tables;
+  return tables;
 }
 
+} // namespace
+
 /*********************************************************************
     Name: s3g_clock_lfsr
 
@@ -291,14 +333,11 @@ uint32_t s3g_s2(uint32_t w)
 *********************************************************************/
 void s3g_clock_lfsr(S3G_STATE* state, uint32_t f)
 {
-  uint32_t v = (((state->lfsr[0] << 8) & 0xffffff00) ^ (s3g_mul_alpha((uint8_t)((state->lfsr[0] >> 24) & 0xff))) ^
-                (state->lfsr[2]) ^ ((state->lfsr[11] >> 8) & 0x00ffffff) ^
-                (s3g_div_alpha((uint8_t)((state->lfsr[11]) & 0xff))) ^ (f));
-  uint8_t  i;
+  const s3g_tables_t& t = s3g_tables();
+  uint32_t            v = ((state->lfsr[0] << 8) & 0xffffff00) ^ t.mul_alpha[(state->lfsr[0] >> 24) & 0xff] ^
+               state->lfsr[2] ^ ((state->lfsr[11] >> 8) & 0x00ffffff) ^ t.div_alpha[state->lfsr[11] & 0xff] ^ f;
 
-  for (i = 0; i < 15; i++) {
-    state->lfsr[i] = state->lfsr[i + 1];
-  }
+  memmove(&state->lfsr[0], &state->lfsr[1], 15 * sizeof(uint32_t));
   state->lfsr[15] = v;
 }
 
@@ -337,9 +376,6 @@ void s3g_initialize(S3G_STATE* state, uint32_t k[4], uint32_t iv[4])
   uint8_t  i = 0;
   uint32_t f = 0x0;
 
-  state->lfsr = (uint32_t*)calloc(16, sizeof(uint32_t));
-  state->fsm  = (uint32_t*)calloc(3, sizeof(uint32_t));
-
   state->lfsr[15] = k[3] ^ iv[0];
   state->lfsr[14] = k[2];
   state->lfsr[13] = k[1];
@@ -377,8 +413,7 @@ void s3g_initialize(S3G_STATE* state, uint32_t k[4], uint32_t iv[4])
 *********************************************************************/
 void s3g_deinitialize(S3G_STATE* state)
 {
-  free(state->lfsr);
-  free(state->fsm);
+  // The state is kept in place, there is nothing to release
 }
 
 /*********************************************************************
@@ -454,9 +489,34 @@ uint64_t s3g_MUL64(uint64_t V, uint64_t P, uint64_t c)
   uint64_t result = 0;
   int      i      = 0;
 
+  // V * x^i is obtained from V * x^(i-1), instead of being recomputed for each bit of P
   for (i = 0; i < 64; i++) {
     if ((P >> i) & 0x1)
-      result ^= s3g_MUL64xPOW(V, i, c);
+      result ^= V;
+    V = s3g_MUL64x(V, c);
+  }
+  return result;
+}
+
+/* MUL64 table.
+ * Input P: a 64-bit input.
+ * Input c: a 64-bit input.
+ * Output table: P * x^i for i in 0..63.
+ * The multiplications by the same P, i.e. all the blocks of one MAC, reduce to 64 XORs with this table.
+ */
+static void s3g_MUL64_table(uint64_t P, uint64_t c, uint64_t table[64])
+{
+  for (int i = 0; i < 64; i++) {
+    table[i] = P;
+    P        = s3g_MUL64x(P, c);
+  }
+}
+
+static uint64_t s3g_MUL64_with_table(uint64_t V, const uint64_t table[64])
+{
+  uint64_t result = 0;
+  for (int i = 0; i < 64; i++) {
+    result ^= table[i] & (0 - ((V >> i) & 0x1));
   }
   return result;
 }
@@ -483,15 +543,16 @@ uint8_t mask8bit(int n)
  */
 uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir, uint8_t* data, uint64_t length)
 {
-  uint32_t       K[4], IV[4], z[5];
-  uint32_t       i        = 0, D;
-  static uint8_t MAC_I[4] = {0, 0, 0, 0}; /* static memory for the result */
-  uint64_t       EVAL;
-  uint64_t       V;
-  uint64_t       P;
-  uint64_t       Q;
-  uint64_t       c;
-  S3G_STATE      state, *state_ptr;
+  uint32_t                    K[4], IV[4], z[5];
+  uint32_t                    i        = 0, D;
+  static thread_local uint8_t MAC_I[4] = {0, 0, 0, 0}; /* static memory for the result, one per thread */
+  uint64_t                    EVAL;
+  uint64_t                    V;
+  uint64_t                    P;
+  uint64_t                    P_table[64];
+  uint64_t                    Q;
+  uint64_t                    c;
+  S3G_STATE                   state, *state_ptr;
 
   uint64_t M_D_2;
   int      rem_bits = 0;
@@ -524,12 +585,14 @@ uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir
   EVAL = 0;
   c    = 0x1b;
 
+  s3g_MUL64_table(P, c, P_table);
+
   /* for 0 <= i <= D-3 */
   for (i = 0; i < D - 2; i++) {
     V    = EVAL ^ ((uint64_t)data[8 * i] << 56 | (uint64_t)data[8 * i + 1] << 48 | (uint64_t)data[8 * i + 2] << 40 |
                 (uint64_t)data[8 * i + 3] << 32 | (uint64_t)data[8 * i + 4] << 24 | (uint64_t)data[8 * i + 5] << 16 |
                 (uint64_t)data[8 * i + 6] << 8 | (uint64_t)data[8 * i + 7]);
-    EVAL = s3g_MUL64(V, P, c);
+    EVAL = s3g_MUL64_with_table(V, P_table);
   }
 
   /* for D-2 */
@@ -548,7 +611,7 @@ uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir
     M_D_2 |= (uint64_t)(data[8 * (D - 2) + i] & mask8bit(rem_bits)) << (8 * (7 - i));
 
   V    = EVAL ^ M_D_2;
-  EVAL = s3g_MUL64(V, P, c);
+  EVAL = s3g_MUL64_with_table(V, P_table);
 
   /* for D-1 */
   EVAL ^= length;
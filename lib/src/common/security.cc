@@ -25,6 +25,7 @@
 #include "srsran/common/s3g.h"
 #include "srsran/common/ssl.h"
 #include "srsran/config.h"
+#include <algorithm>
 #include <arpa/inet.h>
 
 #define FC_EPS_K_ASME_DERIVATION 0x10
@@ -830,6 +831,74 @@ uint8_t security_128_eia2(const uint8_t* key,
   return liblte_security_128_eia2(key, count, bearer, direction, msg, msg_len, mac);
 }
 
+void security_128_aes_set_key(security_128_aes_ctx_t& aes, const uint8_t* key)
+{
+  uint8_t const_zero[16] = {};
+  uint8_t L[16];
+  aes_setkey_enc(&aes.ctx, key, 128);
+  aes_crypt_ecb(&aes.ctx, AES_ENCRYPT, const_zero, L);
+
+  // K1 = L << 1 and K2 = K1 << 1, with the reduction by the constant Rb
+  for (uint32_t i = 0; i < 15; i++) {
+    aes.k1[i] = (L[i] << 1U) | (L[i + 1] >> 7U);
+  }
+  aes.k1[15] = (L[15] << 1U) ^ ((L[0] & 0x80U) ? 0x87U : 0U);
+  for (uint32_t i = 0; i < 15; i++) {
+    aes.k2[i] = (aes.k1[i] << 1U) | (aes.k1[i + 1] >> 7U);
+  }
+  aes.k2[15] = (aes.k1[15] << 1U) ^ ((aes.k1[0] & 0x80U) ? 0x87U : 0U);
+}
+
+uint8_t security_128_eia2(security_128_aes_ctx_t& aes,
+                          uint32_t                count,
+                          uint32_t                bearer,
+                          uint8_t                 direction,
+                          const uint8_t*          msg,
+                          uint32_t                msg_len,
+                          uint8_t*                mac)
+{
+  if (msg == nullptr or mac == nullptr) {
+    return SRSRAN_ERROR;
+  }
+
+  // M = COUNT | BEARER | DIRECTION | 26 zero bits | msg (TS 33.401 Annex B.2.3)
+  uint32_t m_len    = msg_len + 8;
+  uint32_t nof_blks = (m_len + 15) / 16;
+  uint8_t  T[16]    = {};
+  for (uint32_t i = 0; i < nof_blks; i++) {
+    uint8_t  blk[16] = {};
+    uint32_t blk_len = std::min(m_len - i * 16, 16U);
+    if (i == 0) {
+      blk[0] = (count >> 24U) & 0xFFU;
+      blk[1] = (count >> 16U) & 0xFFU;
+      blk[2] = (count >> 8U) & 0xFFU;
+      blk[3] = count & 0xFFU;
+      blk[4] = (bearer << 3U) | (direction << 2U);
+      memcpy(&blk[8], msg, blk_len - 8);
+    } else {
+      memcpy(blk, &msg[i * 16 - 8], blk_len);
+    }
+    if (i == nof_blks - 1) {
+      // The last block is XORed with K1 if complete, or padded with 10..0 and XORed with K2 otherwise
+      const uint8_t* k = aes.k1;
+      if (blk_len < 16) {
+        blk[blk_len] = 0x80;
+        k            = aes.k2;
+      }
+      for (uint32_t j = 0; j < 16; j++) {
+        blk[j] ^= k[j];
+      }
+    }
+    for (uint32_t j = 0; j < 16; j++) {
+      blk[j] ^= T[j];
+    }
+    aes_crypt_ecb(&aes.ctx, AES_ENCRYPT, blk, T);
+  }
+
+  memcpy(mac, T, 4);
+  return SRSRAN_SUCCESS;
+}
+
 uint8_t security_128_eia3(const uint8_t* key,
                           uint32_t       count,
                           uint32_t       bearer,
@@ -874,6 +943,34 @@ uint8_t security_128_eea2(uint8_t* key,
   return liblte_security_encryption_eea2(key, count, bearer, direction, msg, msg_len * 8, msg_out);
 }
 
+uint8_t security_128_eea2(security_128_aes_ctx_t& aes,
+                          uint32_t                count,
+                          uint8_t                 bearer,
+                          uint8_t                 direction,
+                          const uint8_t*          msg,
+                          uint32_t                msg_len,
+                          uint8_t*                msg_out)
+{
+  if (msg == nullptr or msg_out == nullptr) {
+    return SRSRAN_ERROR;
+  }
+
+  uint8_t stream_blk[16] = {};
+  uint8_t nonce_cnt[16]  = {};
+  size_t  nc_off         = 0;
+  nonce_cnt[0]           = (count >> 24U) & 0xFFU;
+  nonce_cnt[1]           = (count >> 16U) & 0xFFU;
+  nonce_cnt[2]           = (count >> 8U) & 0xFFU;
+  nonce_cnt[3]           = count & 0xFFU;
+  nonce_cnt[4]           = ((bearer & 0x1FU) << 3U) | ((direction & 0x01U) << 2U);
+
+  // The CTR mode reads each input byte before writing it, so it can cipher in place
+  if (aes_crypt_ctr(&aes.ctx, msg_len, &nc_off, nonce_cnt, stream_blk, msg, msg_out) != 0) {
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
 uint8_t security_128_eea3(uint8_t* key,
                           uint32_t count,
                           uint8_t  bearer,
@@ -914,6 +1011,88 @@ uint8_t security_milenage_f5_star(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_
   return liblte_security_milenage_f5_star(k, op, rand, ak);
 }
 
+uint8_t security_milenage_f12345(aes_context* k_ctx,
+                                 uint8_t*     opc,
+                                 uint8_t*     rand,
+                                 uint8_t*     sqn,
+                                 uint8_t*     amf,
+                                 uint8_t*     mac_a,
+                                 uint8_t*     res,
+                                 uint8_t*     ck,
+                                 uint8_t*     ik,
+                                 uint8_t*     ak)
+{
+  if (k_ctx == nullptr || opc == nullptr || rand == nullptr || sqn == nullptr || amf == nullptr || mac_a == nullptr ||
+      res == nullptr || ck == nullptr || ik == nullptr || ak == nullptr) {
+    return SRSRAN_ERROR;
+  }
+  uint8_t temp[16];
+  uint8_t input[16];
+  uint8_t out[16];
+
+  // TEMP = E[RAND xor OPc]K
+  for (uint32_t i = 0; i < 16; i++) {
+    input[i] = rand[i] ^ opc[i];
+  }
+  aes_crypt_ecb(k_ctx, AES_ENCRYPT, input, temp);
+
+  // f1: OUT1 = E[TEMP xor rot(IN1 xor OPc, r1) xor c1]K xor OPc, with IN1 = SQN || AMF || SQN || AMF and r1 = 64
+  uint8_t in1[16];
+  for (uint32_t i = 0; i < 6; i++) {
+    in1[i]     = sqn[i];
+    in1[i + 8] = sqn[i];
+  }
+  for (uint32_t i = 0; i < 2; i++) {
+    in1[i + 6]  = amf[i];
+    in1[i + 14] = amf[i];
+  }
+  for (uint32_t i = 0; i < 16; i++) {
+    input[(i + 8) % 16] = in1[i] ^ opc[i];
+  }
+  for (uint32_t i = 0; i < 16; i++) {
+    input[i] ^= temp[i];
+  }
+  aes_crypt_ecb(k_ctx, AES_ENCRYPT, input, out);
+  for (uint32_t i = 0; i < 8; i++) {
+    mac_a[i] = out[i] ^ opc[i];
+  }
+
+  // f2 and f5: OUT2 = E[rot(TEMP xor OPc, r2) xor c2]K xor OPc, with r2 = 0
+  for (uint32_t i = 0; i < 16; i++) {
+    input[i] = temp[i] ^ opc[i];
+  }
+  input[15] ^= 1;
+  aes_crypt_ecb(k_ctx, AES_ENCRYPT, input, out);
+  for (uint32_t i = 0; i < 8; i++) {
+    res[i] = out[i + 8] ^ opc[i + 8];
+  }
+  for (uint32_t i = 0; i < 6; i++) {
+    ak[i] = out[i] ^ opc[i];
+  }
+
+  // f3: OUT3 = E[rot(TEMP xor OPc, r3) xor c3]K xor OPc, with r3 = 32
+  for (uint32_t i = 0; i < 16; i++) {
+    input[(i + 12) % 16] = temp[i] ^ opc[i];
+  }
+  input[15] ^= 2;
+  aes_crypt_ecb(k_ctx, AES_ENCRYPT, input, out);
+  for (uint32_t i = 0; i < 16; i++) {
+    ck[i] = out[i] ^ opc[i];
+  }
+
+  // f4: OUT4 = E[rot(TEMP xor OPc, r4) xor c4]K xor OPc, with r4 = 64
+  for (uint32_t i = 0; i < 16; i++) {
+    input[(i + 8) % 16] = temp[i] ^ opc[i];
+  }
+  input[15] ^= 4;
+  aes_crypt_ecb(k_ctx, AES_ENCRYPT, input, out);
+  for (uint32_t i = 0; i < 16; i++) {
+    ik[i] = out[i] ^ opc[i];
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int security_xor_f2345(uint8_t* k, uint8_t* rand, uint8_t* res, uint8_t* ck, uint8_t* ik, uint8_t* ak)
 {
   uint8_t xdout[16];
@@ -118,6 +118,9 @@ int main(int argc, char** argv)
 {
   int ret = SRSRAN_SUCCESS;
 
+  // Optional busy-poll time of the workers handoff, in microseconds
+  uint32_t spin_us = (argc > 1) ? (uint32_t)strtoul(argv[1], nullptr, 10) : 0;
+
   // Simulation Constants
   const uint32_t  nof_workers        = FDD_HARQ_DELAY_UL_MS;
   const uint32_t  nof_tti            = 10240;
@@ -129,6 +132,12 @@ int main(int argc, char** argv)
   std::vector<std::unique_ptr<dummy_worker> > workers;
   srsran::tti_semaphore<uint32_t>             tti_semaphore;
 
+  srsran::thread_affinity_t affinity = {};
+  affinity.spin_us                   = spin_us;
+  srsran::set_thread_affinity(srsran::thread_class_t::phy_worker, affinity);
+  pool.set_thread_class(srsran::thread_class_t::phy_worker);
+  tti_semaphore.set_thread_class(srsran::thread_class_t::phy_worker);
+
   // Loggers.
   auto& radio_logger = srslog::fetch_basic_logger("radio", false);
   radio_logger.set_level(srslog::basic_levels::none);
@@ -0,0 +1,184 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/thread_affinity.h"
+#include "srsran/srslog/srslog.h"
+#include <algorithm>
+#include <array>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace srsran {
+
+static std::array<thread_affinity_t, (size_t)thread_class_t::nof_classes> thread_affinities;
+
+const char* to_string(thread_class_t cls)
+{
+  static const char* names[] = {"txrx", "phy_worker", "prach_worker", "stack", "gtpu", "log"};
+  return (cls < thread_class_t::nof_classes) ? names[(size_t)cls] : "unknown";
+}
+
+bool parse_core_list(const std::string& str, std::vector<uint32_t>& cores)
+{
+  cores.clear();
+
+  size_t pos = 0;
+  while (pos < str.size()) {
+    size_t      end   = std::min(str.find(',', pos), str.size());
+    std::string range = str.substr(pos, end - pos);
+    pos               = end + 1;
+
+    char*         next  = nullptr;
+    unsigned long first = strtoul(range.c_str(), &next, 10);
+    unsigned long last  = first;
+    if (next == range.c_str()) {
+      return false;
+    }
+    if (*next == '-') {
+      const char* last_str = next + 1;
+      last                 = strtoul(last_str, &next, 10);
+      if (next == last_str || last < first) {
+        return false;
+      }
+    }
+    if (*next != '\0' || last >= CPU_SETSIZE) {
+      return false;
+    }
+
+    for (unsigned long core = first; core <= last; core++) {
+      cores.push_back((uint32_t)core);
+    }
+  }
+
+  return true;
+}
+
+void set_thread_affinity(thread_class_t cls, const thread_affinity_t& affinity)
+{
+  if (cls < thread_class_t::nof_classes) {
+    thread_affinities[(size_t)cls] = affinity;
+  }
+}
+
+bool set_thread_affinity(thread_class_t cls, const std::string& cores, int numa_node, uint32_t spin_us)
+{
+  thread_affinity_t affinity = {};
+  if (numa_node >= max_nof_numa_nodes or not parse_core_list(cores, affinity.cores)) {
+    return false;
+  }
+  affinity.numa_node = numa_node;
+  affinity.spin_us   = spin_us;
+  set_thread_affinity(cls, affinity);
+  return true;
+}
+
+const thread_affinity_t& get_thread_affinity(thread_class_t cls)
+{
+  static const thread_affinity_t none = {};
+  return (cls < thread_class_t::nof_classes) ? thread_affinities[(size_t)cls] : none;
+}
+
+/// Sets the memory policy of the calling thread, a negative node restores the default policy
+static bool set_numa_policy(int node)
+{
+  if (node >= max_nof_numa_nodes) {
+    return false;
+  }
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+  unsigned long nodemask = 1UL << (uint32_t)node;
+  long          ret      = (node < 0) ? syscall(SYS_set_mempolicy, MPOL_DEFAULT, NULL, 0)
+                                      : syscall(SYS_set_mempolicy, MPOL_PREFERRED, &nodemask, sizeof(nodemask) * 8);
+  return ret == 0;
+#else
+  return node < 0;
+#endif
+}
+
+static bool set_cores(const std::vector<uint32_t>& cores)
+{
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (uint32_t core : cores) {
+    CPU_SET(core, &cpuset);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0;
+}
+
+bool apply_thread_affinity(thread_class_t cls)
+{
+  const thread_affinity_t& affinity = get_thread_affinity(cls);
+  srslog::basic_logger&    logger   = srslog::fetch_basic_logger("COMN");
+  bool                     ret      = true;
+
+  if (not affinity.cores.empty() && not set_cores(affinity.cores)) {
+    logger.warning("Could not pin %s thread to its %zd cores", to_string(cls), affinity.cores.size());
+    ret = false;
+  }
+
+  if (affinity.numa_node >= 0 && not set_numa_policy(affinity.numa_node)) {
+    logger.warning("Could not set NUMA node %d for %s thread", affinity.numa_node, to_string(cls));
+    ret = false;
+  }
+
+  return ret;
+}
+
+scoped_numa_policy::scoped_numa_policy(thread_class_t cls)
+{
+  int node = get_thread_affinity(cls).numa_node;
+  active   = node >= 0 && set_numa_policy(node);
+}
+
+scoped_numa_policy::~scoped_numa_policy()
+{
+  if (active) {
+    set_numa_policy(-1);
+  }
+}
+
+scoped_thread_affinity::scoped_thread_affinity(thread_class_t cls) : numa(cls)
+{
+  const thread_affinity_t& affinity = get_thread_affinity(cls);
+  if (affinity.cores.empty()) {
+    return;
+  }
+
+  if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &saved_cores) != 0) {
+    return;
+  }
+  restore_cores = set_cores(affinity.cores);
+}
+
+scoped_thread_affinity::~scoped_thread_affinity()
+{
+  if (restore_cores) {
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &saved_cores);
+  }
+}
+
+} // namespace srsran
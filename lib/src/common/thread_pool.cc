@@ -20,9 +20,11 @@
  */
 
 #include "srsran/common/thread_pool.h"
+#include "srsran/common/spin_wait.h"
 #include "srsran/srslog/srslog.h"
 #include <assert.h>
 #include <chrono>
+#include <cmath>
 #include <stdio.h>
 
 #define DEBUG 0
@@ -51,6 +53,7 @@ void thread_pool::worker::setup(uint32_t id, thread_pool* parent, uint32_t prio,
 void thread_pool::worker::run_thread()
 {
   set_name(my_parent->get_id() + std::string("WORKER") + std::to_string(my_id));
+  apply_thread_affinity(my_parent->thread_class);
   while (running.load(std::memory_order_relaxed)) {
     wait_to_start();
     if (running.load(std::memory_order_relaxed)) {
@@ -71,7 +74,13 @@ uint32_t thread_pool::worker::get_id()
 }
 
 thread_pool::thread_pool(uint32_t max_workers_, std::string id_) :
-  workers(max_workers_), max_workers(max_workers_), status(max_workers_), cvar_worker(max_workers_), id(id_)
+  workers(max_workers_),
+  max_workers(max_workers_),
+  status(max_workers_),
+  cvar_worker(max_workers_),
+  wake_seq(max_workers_),
+  work_start(max_workers_),
+  id(id_)
 {
   for (uint32_t i = 0; i < max_workers; i++) {
     workers[i] = NULL;
@@ -108,7 +117,7 @@ void thread_pool::stop()
         debug_thread("stop(): stopping %d\n", i);
         workers[i]->stop();
         status[i] = STOP;
-        cvar_worker[i].notify_all();
+        wake_worker(i);
         cvar_queue.notify_all();
       }
     }
@@ -132,11 +141,38 @@ void thread_pool::worker::wait_to_start()
 
   debug_thread("wait_to_start() id=%d, status=%d, enter\n", my_id, my_parent->status[my_id]);
 
+  // The worker busy-polls its wake-ups until the deadline, so that it does not pay the futex wake-up of the TTI start
+  load_clock::time_point spin_deadline = {};
+  if (my_parent->spin_time.count() > 0) {
+    spin_deadline = load_clock::now() + my_parent->spin_time;
+  }
+
   while (my_parent->status[my_id] != START_WORK && my_parent->status[my_id] != STOP) {
+    // Help the busy workers with their queued sub-tasks while waiting, unless the worker is parked
+    if (my_parent->status[my_id] == IDLE && !my_parent->tasks.empty() && my_id < my_parent->active_workers) {
+      my_parent->status[my_id] = HELPING;
+      load_clock::time_point help_start = load_clock::now();
+      my_parent->run_pending_task(lock, nullptr);
+      my_parent->busy_time += load_clock::now() - help_start;
+      if (my_parent->status[my_id] == HELPING) {
+        my_parent->status[my_id] = IDLE;
+        my_parent->cvar_queue.notify_all();
+      }
+      continue;
+    }
+    if (my_parent->spin_time.count() > 0 && load_clock::now() < spin_deadline) {
+      std::atomic<uint32_t>& seq  = my_parent->wake_seq[my_id];
+      uint32_t               seen = seq.load(std::memory_order_relaxed);
+      lock.unlock();
+      spin_until([&seq, seen]() { return seq.load(std::memory_order_acquire) != seen; }, spin_deadline);
+      lock.lock();
+      continue;
+    }
     my_parent->cvar_worker[my_id].wait(lock);
   }
   if (my_parent->status[my_id] != STOP) {
-    my_parent->status[my_id] = WORKING;
+    my_parent->status[my_id]     = WORKING;
+    my_parent->work_start[my_id] = load_clock::now();
   }
 
   debug_thread("wait_to_start() id=%d, status=%d, exit\n", my_id, my_parent->status[my_id]);
@@ -145,6 +181,9 @@ void thread_pool::worker::wait_to_start()
 void thread_pool::worker::finished()
 {
   std::lock_guard<std::mutex> lock(my_parent->mutex_queue);
+  if (my_parent->status[my_id] == WORKING) {
+    my_parent->busy_time += load_clock::now() - my_parent->work_start[my_id];
+  }
   if (my_parent->status[my_id] != STOP) {
     my_parent->status[my_id] = IDLE;
     my_parent->cvar_worker[my_id].notify_all();
@@ -158,9 +197,73 @@ bool thread_pool::worker::is_stopped() const
   return my_parent->status[my_id] == STOP;
 }
 
-bool thread_pool::find_finished_worker(uint32_t tti, uint32_t* id)
+void thread_pool::worker::push_task(task_group& group, task_t&& task)
 {
+  my_parent->push_task(group, std::move(task));
+}
+
+void thread_pool::worker::wait_tasks(task_group& group)
+{
+  my_parent->wait_tasks(group);
+}
+
+void thread_pool::push_task(task_group& group, task_t&& task)
+{
+  std::lock_guard<std::mutex> lock(mutex_queue);
+  group.pending++;
+  tasks.push_back(pending_task_t{&group, std::move(task)});
+
+  // Wake up the idle workers, the ones that do not find a task go back to sleep
   for (uint32_t i = 0; i < nof_workers; i++) {
+    if (status[i] == IDLE) {
+      wake_worker(i);
+    }
+  }
+}
+
+void thread_pool::wait_tasks(task_group& group)
+{
+  std::unique_lock<std::mutex> lock(mutex_queue);
+  while (group.pending > 0) {
+    // Sub-tasks of the group nobody has taken yet are run by the waiting worker itself. It does not take the ones of
+    // other workers, so that its own work is not delayed
+    if (!run_pending_task(lock, &group)) {
+      cvar_tasks.wait(lock);
+    }
+  }
+}
+
+bool thread_pool::run_pending_task(std::unique_lock<std::mutex>& lock, task_group* group)
+{
+  auto it = tasks.begin();
+  while (it != tasks.end() && group != nullptr && it->group != group) {
+    ++it;
+  }
+  if (it == tasks.end()) {
+    return false;
+  }
+  pending_task_t t = std::move(*it);
+  tasks.erase(it);
+
+  lock.unlock();
+  t.task();
+  lock.lock();
+
+  t.group->pending--;
+  cvar_tasks.notify_all();
+  return true;
+}
+
+/// Must be called with the queue mutex locked
+void thread_pool::wake_worker(uint32_t id)
+{
+  wake_seq[id].fetch_add(1, std::memory_order_release);
+  cvar_worker[id].notify_all();
+}
+
+bool thread_pool::find_finished_worker(uint32_t tti, uint32_t* id)
+{
+  for (uint32_t i = 0; i < std::min(nof_workers, active_workers); i++) {
     if (status[i] == IDLE) {
       *id = i;
       return true;
@@ -233,7 +336,7 @@ void thread_pool::start_worker(uint32_t id)
     debug_thread("start_worker() id=%d, status=%d\n", id, status[id]);
     if (status[id] != STOP) {
       status[id] = START_WORK;
-      cvar_worker[id].notify_all();
+      wake_worker(id);
       cvar_queue.notify_all();
     }
   }
@@ -267,14 +370,49 @@ std::string thread_pool::get_id()
   return id;
 }
 
+uint32_t thread_pool::autoscale(uint32_t min_workers, float target_load)
+{
+  std::lock_guard<std::mutex> lock(mutex_queue);
+
+  // Average number of busy workers since the previous call
+  load_clock::time_point now     = load_clock::now();
+  double              elapsed = std::chrono::duration<double>(now - load_window_start).count();
+  double              busy    = std::chrono::duration<double>(busy_time).count();
+  load_window_start           = now;
+  busy_time                   = {};
+
+  uint32_t current = std::min(nof_workers, active_workers);
+  if (elapsed <= 0.0 || target_load <= 0.0f) {
+    return current;
+  }
+
+  // Wake as many workers as needed at once, but park them one at a time in case the load comes back
+  uint32_t needed = (uint32_t)std::ceil(busy / elapsed / target_load);
+  needed          = std::max(needed, std::max(current, 1U) - 1);
+  needed          = std::min(std::max(needed, std::max(min_workers, 1U)), nof_workers);
+
+  active_workers = needed;
+  return active_workers;
+}
+
 /**************************************************************************
  *  task_thread_pool - uses a queue to enqueue callables, that start
  *  once a worker is available
  *************************************************************************/
 
+constexpr uint32_t task_thread_pool::max_workers;
+
+// Worker of a task_thread_pool running in the calling thread, if any
+static thread_local const void* current_task_pool   = nullptr;
+static thread_local uint32_t    current_task_worker = 0;
+
 task_thread_pool::task_thread_pool(uint32_t nof_workers, bool start_deferred, int32_t prio_, uint32_t mask_) :
-  logger(srslog::fetch_basic_logger("POOL")), pending_tasks(max_task_num), workers(std::max(1u, nof_workers))
+  logger(srslog::fetch_basic_logger("POOL")), workers(std::min(std::max(1u, nof_workers), max_workers))
 {
+  for (uint32_t i = 0; i < workers.size(); ++i) {
+    queues[i].reset(new task_queue_t(queue_capacity(workers.size())));
+  }
+  nof_queues = workers.size();
   if (not start_deferred) {
     start(prio_, mask_);
   }
@@ -292,8 +430,17 @@ void task_thread_pool::set_nof_workers(uint32_t nof_workers)
     logger.error("Reducing the number of workers dynamically not supported");
     return;
   }
+  if (nof_workers > max_workers) {
+    logger.warning("Limiting the number of workers to %u", max_workers);
+    nof_workers = max_workers;
+  }
   uint32_t old_size = workers.size();
   workers.resize(nof_workers);
+  // The queues are published before the workers that pop them, and are never removed
+  for (uint32_t i = old_size; i < nof_workers; ++i) {
+    queues[i].reset(new task_queue_t(queue_capacity(nof_workers)));
+  }
+  nof_queues = nof_workers;
   if (running) {
     for (uint32_t i = old_size; i < nof_workers; ++i) {
       workers[i].reset(new worker_t(this, i));
@@ -338,23 +485,94 @@ void task_thread_pool::stop()
   }
 }
 
-void task_thread_pool::push_task(task_t&& task)
+void task_thread_pool::push_task(task_t&& task, task_priority priority)
 {
-  {
-    std::lock_guard<std::mutex> lock(queue_mutex);
-    if (pending_tasks.full()) {
-      logger.error("Cannot push anymore tasks into the queue, maximum size is %u", uint32_t(max_task_num));
-      return;
+  uint32_t n = nof_queues.load(std::memory_order_acquire);
+
+  // Tasks pushed by a worker of this pool are kept in its queue, the other ones are spread over the workers
+  uint32_t first = current_task_pool == this ? current_task_worker : next_queue.fetch_add(1, std::memory_order_relaxed);
+  for (uint32_t i = 0; i < n; ++i) {
+    task_queue_t&               q = *queues[(first + i) % n];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    dyn_circular_buffer<task_t>& tasks = q.tasks[(size_t)priority];
+    if (tasks.full()) {
+      continue;
     }
-    pending_tasks.push(std::move(task));
+    tasks.push(std::move(task));
+    q.nof_tasks.fetch_add(1, std::memory_order_relaxed);
+    nof_pending.fetch_add(1);
+    wake_worker();
+    return;
+  }
+  uint32_t max_size = 0;
+  for (uint32_t i = 0; i < n; ++i) {
+    max_size += queues[i]->tasks[(size_t)priority].max_size();
+  }
+  logger.error("Cannot push anymore tasks into the queue, maximum size is %u", max_size);
+}
+
+void task_thread_pool::wake_worker()
+{
+  // Pairs with the increment of nof_sleeping before a worker checks nof_pending and waits
+  if (nof_sleeping.load() > 0) {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    cv_empty.notify_one();
   }
-  cv_empty.notify_one();
 }
 
 uint32_t task_thread_pool::nof_pending_tasks() const
 {
-  std::lock_guard<std::mutex> lock(queue_mutex);
-  return pending_tasks.size();
+  return nof_pending.load(std::memory_order_relaxed);
+}
+
+bool task_thread_pool::try_pop(uint32_t queue_idx, task_priority priority, task_t* task)
+{
+  task_queue_t& q = *queues[queue_idx];
+  if (q.nof_tasks.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex>  lock(q.mutex);
+  dyn_circular_buffer<task_t>& tasks = q.tasks[(size_t)priority];
+  if (tasks.empty()) {
+    return false;
+  }
+  if (task) {
+    *task = std::move(tasks.top());
+  }
+  tasks.pop();
+  q.nof_tasks.fetch_sub(1, std::memory_order_relaxed);
+  nof_pending.fetch_sub(1);
+  return true;
+}
+
+bool task_thread_pool::try_pop_any(uint32_t first_queue_idx, task_t* task, task_priority* priority)
+{
+  uint32_t n = nof_queues.load(std::memory_order_acquire);
+
+  // The normal tasks of all the queues go first, starting by the own queue of the worker
+  for (uint32_t i = 0; i < n; ++i) {
+    if (try_pop((first_queue_idx + i) % n, task_priority::normal, task)) {
+      *priority = task_priority::normal;
+      return true;
+    }
+  }
+
+  // A worker is always kept available for the normal tasks
+  uint32_t max_running_low = std::max(1u, n - 1);
+  uint32_t nof_low         = nof_running_low.load();
+  do {
+    if (nof_low >= max_running_low) {
+      return false;
+    }
+  } while (not nof_running_low.compare_exchange_weak(nof_low, nof_low + 1));
+  for (uint32_t i = 0; i < n; ++i) {
+    if (try_pop((first_queue_idx + i) % n, task_priority::low, task)) {
+      *priority = task_priority::low;
+      return true;
+    }
+  }
+  nof_running_low.fetch_sub(1);
+  return false;
 }
 
 task_thread_pool::worker_t::worker_t(srsran::task_thread_pool* parent_, uint32_t my_id) :
@@ -372,28 +590,43 @@ void task_thread_pool::worker_t::stop()
   wait_thread_finish();
 }
 
-bool task_thread_pool::worker_t::wait_task(task_t* task)
+bool task_thread_pool::worker_t::wait_task(task_t* task, task_priority* priority)
 {
-  std::unique_lock<std::mutex> lock(parent->queue_mutex);
-  while (parent->running and parent->pending_tasks.empty()) {
-    parent->cv_empty.wait(lock);
-  }
-  if (not parent->running) {
-    return false;
-  }
-  if (task) {
-    *task = std::move(parent->pending_tasks.top());
+  while (parent->running) {
+    if (parent->try_pop_any(id_, task, priority)) {
+      return true;
+    }
+
+    // Sleep until a task is pushed. The pending low priority tasks that cannot run yet are waited for with a timeout
+    std::unique_lock<std::mutex> lock(parent->queue_mutex);
+    parent->nof_sleeping.fetch_add(1);
+    if (parent->running and parent->nof_pending.load() == 0) {
+      parent->cv_empty.wait(lock);
+    } else if (parent->running and parent->nof_running_low.load() > 0) {
+      parent->cv_empty.wait_for(lock, std::chrono::milliseconds(1));
+    }
+    parent->nof_sleeping.fetch_sub(1);
   }
-  parent->pending_tasks.pop();
-  return true;
+  return false;
 }
 
 void task_thread_pool::worker_t::run_thread()
 {
+  current_task_pool   = parent;
+  current_task_worker = id_;
+
   // main loop
-  task_t task;
-  while (wait_task(&task)) {
+  task_t        task;
+  task_priority priority;
+  while (wait_task(&task, &priority)) {
     task();
+    if (priority == task_priority::low) {
+      // Another low priority task may be waiting for this worker slot
+      parent->nof_running_low.fetch_sub(1);
+      if (parent->nof_pending.load() > 0) {
+        parent->wake_worker();
+      }
+    }
   }
 
   // on exit, notify pool class
@@ -477,4 +710,11 @@ task_thread_pool& get_background_workers()
   return background_workers;
 }
 
+// Global thread pool for the PDCP ciphering, started on demand
+task_thread_pool& get_crypto_workers()
+{
+  static task_thread_pool crypto_workers(1, true);
+  return crypto_workers;
+}
+
 } // namespace srsran
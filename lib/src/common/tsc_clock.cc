@@ -0,0 +1,98 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/tsc_clock.h"
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+using namespace srsran;
+
+namespace {
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// The TSC runs at a constant rate in all C-states and frequencies, see CPUID.80000007H:EDX[8]
+bool has_invariant_counter()
+{
+  unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+  return (edx & (1U << 8U)) != 0;
+}
+
+#elif defined(__aarch64__)
+
+// The generic timer always runs at a constant rate
+bool has_invariant_counter()
+{
+  return true;
+}
+
+#else
+
+bool has_invariant_counter()
+{
+  return false;
+}
+
+#endif
+
+} // namespace
+
+constexpr bool tsc_clock::is_steady;
+
+tsc_clock::calibration_t tsc_clock::calibrate() noexcept
+{
+  calibration_t cal;
+  if (not has_invariant_counter()) {
+    return cal;
+  }
+
+  using std::chrono::steady_clock;
+  std::chrono::nanoseconds t0 = steady_clock::now().time_since_epoch();
+  uint64_t                 c0 = read_counter();
+#if defined(__aarch64__)
+  uint64_t hz;
+  asm volatile("mrs %0, cntfrq_el0" : "=r"(hz));
+  cal.counter_hz = hz;
+#else
+  // Count the ticks of an interval of steady_clock
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  std::chrono::nanoseconds t1 = steady_clock::now().time_since_epoch();
+  uint64_t                 c1 = read_counter();
+  if (c1 <= c0 or t1 <= t0) {
+    return cal;
+  }
+  cal.counter_hz = static_cast<uint64_t>(static_cast<double>(c1 - c0) * 1e9 / (t1 - t0).count());
+#endif
+  if (cal.counter_hz == 0) {
+    return cal;
+  }
+  cal.ns_mult = static_cast<uint64_t>((static_cast<unsigned __int128>(1000000000ULL) << ns_mult_shift) /
+                                      cal.counter_hz);
+  cal.base_ticks = c0;
+  cal.base_ns    = t0.count();
+  return cal;
+}
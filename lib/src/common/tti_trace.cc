@@ -0,0 +1,169 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/tti_trace.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace srsran {
+
+namespace {
+
+struct event_info_t {
+  const char* name;
+  const char* arg_name;
+};
+
+const event_info_t event_info[] = {{"txrx_run", "tti"},
+                                   {"sf_worker_work", "tti_rx"},
+                                   {"cc_worker_ul", "tti_rx"},
+                                   {"cc_worker_dl_data", "tti_tx_dl"},
+                                   {"cc_worker_dl_ctrl", "tti_tx_dl"},
+                                   {"mac_get_dl_sched", "tti_tx_dl"},
+                                   {"mac_get_ul_sched", "tti_tx_ul"},
+                                   {"radio_rx", "nof_samples"},
+                                   {"radio_tx", "nof_samples"}};
+static_assert(sizeof(event_info) / sizeof(event_info[0]) == static_cast<size_t>(tti_trace_event::nof_events),
+              "Missing names of the TTI trace events");
+
+// Records of one thread. Only the owner thread writes the records, the export reads them once the tracer is stopped
+struct thread_buffer_t {
+  std::vector<tti_trace_record> records;
+  uint64_t                      nof_pushed = 0;
+  long                          tid        = 0;
+  char                          name[16]   = {};
+};
+
+std::mutex                                    registry_mutex;
+std::vector<std::unique_ptr<thread_buffer_t>> registry;
+size_t                                        records_per_thread = 0;
+
+thread_buffer_t* register_thread()
+{
+  std::unique_ptr<thread_buffer_t> buf(new thread_buffer_t);
+  buf->tid = syscall(SYS_gettid);
+  if (pthread_getname_np(pthread_self(), buf->name, sizeof(buf->name)) != 0) {
+    buf->name[0] = '\0';
+  }
+
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  buf->records.resize(records_per_thread);
+  registry.push_back(std::move(buf));
+  return registry.back().get();
+}
+
+} // namespace
+
+std::atomic<bool> detail::tti_trace_enabled{false};
+
+const char* to_string(tti_trace_event event)
+{
+  if (event >= tti_trace_event::nof_events) {
+    return "unknown";
+  }
+  return event_info[static_cast<size_t>(event)].name;
+}
+
+void detail::tti_trace_push(tti_trace_event event, uint32_t arg, tsc_clock::time_point start, tsc_clock::time_point end)
+{
+  static thread_local thread_buffer_t* buf = register_thread();
+  if (buf->records.empty()) {
+    return;
+  }
+
+  tti_trace_record& rec = buf->records[buf->nof_pushed % buf->records.size()];
+  rec.start_ns          = start.time_since_epoch().count();
+  rec.duration_ns       = static_cast<uint32_t>((end - start).count());
+  rec.arg               = arg;
+  rec.event             = event;
+  buf->nof_pushed++;
+}
+
+void tti_trace_init(size_t nof_records_per_thread)
+{
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  records_per_thread = nof_records_per_thread;
+  for (auto& buf : registry) {
+    buf->records.assign(records_per_thread, {});
+    buf->nof_pushed = 0;
+  }
+  detail::tti_trace_enabled.store(true, std::memory_order_relaxed);
+}
+
+void tti_trace_stop()
+{
+  detail::tti_trace_enabled.store(false, std::memory_order_relaxed);
+}
+
+bool tti_trace_write_chrome_json(const std::string& filename)
+{
+  tti_trace_stop();
+
+  FILE* f = fopen(filename.c_str(), "w");
+  if (f == nullptr) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  const char* sep = "";
+  for (const auto& buf : registry) {
+    fprintf(f,
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%ld,\"args\":{\"name\":\"%s\"}}",
+            sep,
+            buf->tid,
+            buf->name);
+    sep = ",\n";
+
+    // Once the buffer has wrapped around, the oldest record is the next one to be overwritten
+    size_t   cap   = buf->records.size();
+    uint64_t count = std::min<uint64_t>(buf->nof_pushed, cap);
+    for (uint64_t i = buf->nof_pushed - count; i < buf->nof_pushed; ++i) {
+      const tti_trace_record& rec  = buf->records[i % cap];
+      const event_info_t&     info = event_info[static_cast<size_t>(rec.event)];
+      fprintf(f,
+              "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%ld,\"ts\":%" PRId64 ".%03" PRId64
+              ",\"dur\":%" PRIu32 ".%03" PRIu32 ",\"args\":{\"%s\":%" PRIu32 "}}",
+              sep,
+              info.name,
+              buf->tid,
+              rec.start_ns / 1000,
+              rec.start_ns % 1000,
+              rec.duration_ns / 1000,
+              rec.duration_ns % 1000,
+              info.arg_name,
+              rec.arg);
+    }
+  }
+  fprintf(f, "\n]}\n");
+
+  bool ok = ferror(f) == 0;
+  return fclose(f) == 0 and ok;
+}
+
+} // namespace srsran
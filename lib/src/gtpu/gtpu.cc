@@ -194,6 +194,31 @@ bool gtpu_read_header(srsran::byte_buffer_t* pdu, gtpu_header_t* header, srslog:
   return true;
 }
 
+gtpu_gpdu_header_template_t gtpu_make_gpdu_header_template(uint32_t teid)
+{
+  gtpu_gpdu_header_template_t hdr = {};
+  hdr[0]                          = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+  hdr[1]                          = GTPU_MSG_DATA_PDU;
+  uint32_to_uint8(teid, &hdr[4]);
+  return hdr;
+}
+
+bool gtpu_write_gpdu_header(const gtpu_gpdu_header_template_t& hdr,
+                            srsran::byte_buffer_t*             pdu,
+                            srslog::basic_logger&              logger)
+{
+  if (pdu->get_headroom() < GTPU_BASE_HEADER_LEN) {
+    logger.error("gtpu_write_gpdu_header - No room in PDU for header");
+    return false;
+  }
+  uint16_t length = pdu->N_bytes;
+  pdu->msg -= GTPU_BASE_HEADER_LEN;
+  pdu->N_bytes += GTPU_BASE_HEADER_LEN;
+  memcpy(pdu->msg, hdr.data(), GTPU_BASE_HEADER_LEN);
+  uint16_to_uint8(length, &pdu->msg[2]);
+  return true;
+}
+
 // Helper function to return a string from IPv4 address for easy printing
 void gtpu_ntoa(fmt::memory_buffer& buffer, uint32_t addr)
 {
@@ -20,6 +20,7 @@
  */
 
 #include "srsran/mac/mac_sch_pdu_nr.h"
+#include "srsran/common/interfaces_common.h"
 
 namespace srsran {
 
@@ -105,7 +106,7 @@ int32_t mac_sch_subpdu_nr::read_subheader(const uint8_t* ptr)
   return header_length;
 }
 
-void mac_sch_subpdu_nr::set_sdu(const uint32_t lcid_, const uint8_t* payload_, const uint32_t len_)
+void mac_sch_subpdu_nr::set_sdu(const uint32_t lcid_, const uint8_t* payload_, const uint32_t len_, bool long_len_field)
 {
   // Use CCCH_SIZE_48 when SDU len fits
   lcid = (lcid_ == CCCH_SIZE_64 && len_ == sizeof_ce(CCCH_SIZE_48, true)) ? CCCH_SIZE_48 : lcid_;
@@ -120,7 +121,8 @@ void mac_sch_subpdu_nr::set_sdu(const uint32_t lcid_, const uint8_t* payload_, c
     }
   }
 
-  if (sdu_length >= MAC_SUBHEADER_LEN_THRESHOLD) {
+  // The 16-bit L field can also be used by the short SDUs
+  if (sdu_length >= MAC_SUBHEADER_LEN_THRESHOLD or (long_len_field and not is_ul_ccch())) {
     F_bit = true;
     header_length += 1;
   }
@@ -206,9 +208,11 @@ uint32_t mac_sch_subpdu_nr::write_subpdu(const uint8_t* start_)
     logger->error("Error while packing PDU. Unsupported header length (%d)", header_length);
   }
 
-  // copy SDU payload
+  // copy SDU payload, unless it was written in place
   if (sdu) {
-    memcpy(ptr, sdu.ptr(), sdu_length);
+    if (sdu.ptr() != ptr) {
+      memcpy(ptr, sdu.ptr(), sdu_length);
+    }
   } else {
     // clear memory
     memset(ptr, 0, sdu_length);
@@ -572,6 +576,34 @@ uint32_t mac_sch_pdu_nr::add_sdu(const uint32_t lcid_, const uint8_t* payload_,
   return add_sudpdu(sch_pdu);
 }
 
+int mac_sch_pdu_nr::add_sdu(const uint32_t lcid_, const uint32_t max_sdu_len, read_pdu_interface* sdu_itf)
+{
+  // The L field size is selected before reading the SDU, so that the SDU is written in its final position
+  if (remaining_len <= 2) {
+    return SRSRAN_ERROR;
+  }
+  uint32_t header_size    = size_header_sdu(lcid_, std::min(max_sdu_len, remaining_len - 2));
+  bool     long_len_field = header_size == 3;
+  uint32_t sdu_space      = std::min(max_sdu_len, remaining_len - header_size);
+  uint8_t* sdu_ptr        = buffer->msg + buffer->N_bytes + header_size;
+
+  uint32_t sdu_len = sdu_itf->read_pdu(lcid_, sdu_ptr, sdu_space);
+  if (sdu_len == 0) {
+    return 0;
+  }
+  if (sdu_len > sdu_space) {
+    logger.error("SDU of %d B exceeds the space in PDU (%d B)", sdu_len, sdu_space);
+    return SRSRAN_ERROR;
+  }
+
+  mac_sch_subpdu_nr sch_pdu(this);
+  sch_pdu.set_sdu(lcid_, sdu_ptr, sdu_len, long_len_field);
+  if (add_sudpdu(sch_pdu) != SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  return sdu_len;
+}
+
 uint32_t mac_sch_pdu_nr::add_crnti_ce(const uint16_t crnti)
 {
   mac_sch_subpdu_nr ce(this);
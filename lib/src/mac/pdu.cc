@@ -239,6 +239,69 @@ void sch_pdu::parse_packet(uint8_t* ptr)
   }
 }
 
+int ul_sch_pdu_parser::parse(const uint8_t* ptr, uint32_t pdu_len)
+{
+  sdu_list.clear();
+  ce_list.clear();
+
+  // Decode the subheaders. The payload offsets are relative to the end of the MAC header until its length is known
+  uint32_t         hdr_len     = 0;
+  uint32_t         payload_len = 0;
+  bool             e_bit       = true;
+  ul_sch_subpdu_t* last        = nullptr;
+  while (e_bit and hdr_len < pdu_len) {
+    uint8_t         octet  = ptr[hdr_len++];
+    ul_sch_subpdu_t subpdu = {octet & 0x1fU, payload_len, 0};
+    e_bit                  = (octet & 0x20U) != 0;
+    bool sdu               = is_sdu(static_cast<ul_sch_lcid>(subpdu.lcid));
+    if (not sdu) {
+      subpdu.nof_bytes = ce_size(static_cast<ul_sch_lcid>(subpdu.lcid));
+    } else if (e_bit) {
+      // F bit and 7-bit or 15-bit L field
+      bool f_bit = hdr_len < pdu_len and (ptr[hdr_len] & 0x80U) != 0;
+      if (hdr_len + (f_bit ? 2 : 1) > pdu_len) {
+        break;
+      }
+      subpdu.nof_bytes = ptr[hdr_len++] & 0x7fU;
+      if (f_bit) {
+        subpdu.nof_bytes = (subpdu.nof_bytes << 8U) | ptr[hdr_len++];
+      }
+    }
+    payload_len += subpdu.nof_bytes;
+
+    if (subpdu.lcid == (uint32_t)ul_sch_lcid::PADDING) {
+      last = nullptr;
+      continue;
+    }
+    subpdu_list_t& list = sdu ? sdu_list : ce_list;
+    if (list.full()) {
+      sdu_list.clear();
+      ce_list.clear();
+      return SRSRAN_ERROR;
+    }
+    list.push_back(subpdu);
+    last = &list.back();
+  }
+  if (e_bit or hdr_len + payload_len > pdu_len) {
+    // Either all bytes were consumed by the subheaders or the payloads exceed the PDU length
+    sdu_list.clear();
+    ce_list.clear();
+    return SRSRAN_ERROR;
+  }
+
+  // The last subPDU has no L field and takes the remaining bytes of the PDU
+  if (last != nullptr) {
+    last->nof_bytes += pdu_len - hdr_len - payload_len;
+  }
+  for (ul_sch_subpdu_t& subpdu : sdu_list) {
+    subpdu.offset += hdr_len;
+  }
+  for (ul_sch_subpdu_t& subpdu : ce_list) {
+    subpdu.offset += hdr_len;
+  }
+  return SRSRAN_SUCCESS;
+}
+
 uint8_t* sch_pdu::write_packet()
 {
   return write_packet(srslog::fetch_basic_logger("MAC"));
@@ -906,6 +969,15 @@ void sch_subh::read_payload(uint8_t** ptr)
   *ptr += nof_bytes;
 }
 
+void sch_subh::init_rx_ce(uint32_t lcid_, uint8_t* payload_, uint32_t nof_bytes_)
+{
+  type      = SCH_SUBH_TYPE;
+  lcid      = lcid_;
+  payload   = payload_;
+  nof_bytes = nof_bytes_;
+  F_bit     = false;
+}
+
 void sch_subh::to_string(fmt::memory_buffer& buffer)
 {
   if (is_sdu()) {
@@ -25,11 +25,80 @@
 
 namespace srsran {
 
+pdu_queue::pdu_ring::pdu_ring() : cells(new cell_t[DEFAULT_POOL_SIZE])
+{
+  for (size_t i = 0; i < DEFAULT_POOL_SIZE; ++i) {
+    cells[i].seq.store(i, std::memory_order_relaxed);
+    cells[i].pdu = nullptr;
+  }
+}
+
+bool pdu_queue::pdu_ring::try_push(pdu_t* pdu)
+{
+  size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+  while (true) {
+    cell_t&  cell = cells[pos % DEFAULT_POOL_SIZE];
+    size_t   seq  = cell.seq.load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        cell.pdu = pdu;
+        cell.seq.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // ring is full
+      return false;
+    } else {
+      pos = enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool pdu_queue::pdu_ring::try_pop(pdu_t*& pdu)
+{
+  size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+  while (true) {
+    cell_t&  cell = cells[pos % DEFAULT_POOL_SIZE];
+    size_t   seq  = cell.seq.load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+    if (diff == 0) {
+      if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        pdu = cell.pdu;
+        cell.seq.store(pos + DEFAULT_POOL_SIZE, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // ring is empty
+      return false;
+    } else {
+      pos = dequeue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+pdu_queue::pdu_queue(srslog::basic_logger& logger) : pool(new pdu_t[DEFAULT_POOL_SIZE]), logger(logger)
+{
+  for (uint32_t i = 0; i < DEFAULT_POOL_SIZE; ++i) {
+    free_pdus.try_push(&pool[i]);
+  }
+}
+
 void pdu_queue::init(process_callback* callback_)
 {
   callback = callback_;
 }
 
+pdu_queue::pdu_t* pdu_queue::to_pdu(const uint8_t* ptr)
+{
+  // The PDU payload is the first member of pdu_t, check that the pointer is the payload of a buffer of this pool
+  uintptr_t offset = reinterpret_cast<uintptr_t>(ptr) - reinterpret_cast<uintptr_t>(pool.get());
+  if (ptr == nullptr or offset >= DEFAULT_POOL_SIZE * sizeof(pdu_t) or offset % sizeof(pdu_t) != 0) {
+    return nullptr;
+  }
+  return &pool[offset / sizeof(pdu_t)];
+}
+
 uint8_t* pdu_queue::request(uint32_t len)
 {
   if (len > MAX_PDU_LEN) {
@@ -37,12 +106,8 @@ uint8_t* pdu_queue::request(uint32_t len)
     return NULL;
   }
   // This function must be non-blocking. In case we run out of buffers, it shall handle the error properly
-  pdu_t* pdu = pool.allocate("pdu_queue::request", false);
-  if (pdu) {
-    if ((void*)pdu->ptr != (void*)pdu) {
-      ERROR("Fatal error in memory alignment in struct pdu_queue::pdu_t");
-      exit(-1);
-    }
+  pdu_t* pdu = nullptr;
+  if (free_pdus.try_pop(pdu)) {
     return pdu->ptr;
   } else {
     logger.error("Not enough buffers for MAC PDU");
@@ -51,9 +116,10 @@ uint8_t* pdu_queue::request(uint32_t len)
   }
 }
 
-void pdu_queue::deallocate(const uint8_t* pdu)
+void pdu_queue::deallocate(const uint8_t* ptr)
 {
-  if (!pool.deallocate((pdu_t*)pdu)) {
+  pdu_t* pdu = to_pdu(ptr);
+  if (pdu == nullptr or not free_pdus.try_push(pdu)) {
     logger.warning("Error deallocating from buffer pool in deallocate(): buffer not created in this pool.");
   }
 }
@@ -64,16 +130,17 @@ void pdu_queue::deallocate(const uint8_t* pdu)
  */
 void pdu_queue::push(const uint8_t* ptr, uint32_t len, channel_t channel, int grant_nof_prbs)
 {
-  if (ptr) {
-    pdu_t* pdu          = (pdu_t*)ptr;
+  pdu_t* pdu = to_pdu(ptr);
+  if (pdu != nullptr) {
     pdu->len            = len;
     pdu->channel        = channel;
     pdu->grant_nof_prbs = grant_nof_prbs;
     if (!pdu_q.try_push(pdu)) {
       logger.warning("Error pushing pdu: queue is full");
+      deallocate(ptr);
     }
   } else {
-    logger.warning("Error pushing pdu: ptr is empty");
+    logger.warning("Error pushing pdu: ptr is empty or not from this pool");
   }
 }
 
@@ -100,7 +167,7 @@ void pdu_queue::reset()
 {
   pdu_t* pdu;
   while (pdu_q.try_pop(pdu)) {
-    // nop
+    deallocate(pdu->ptr);
   }
 }
 
@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsran/common/interfaces_common.h"
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/common/test_common.h"
@@ -455,6 +456,68 @@ int mac_dl_sch_pdu_unpack_test9()
   return SRSRAN_SUCCESS;
 }
 
+/// Writes a fixed number of bytes with a pattern, like RLC does when it builds a PDU
+class dummy_rlc_reader : public read_pdu_interface
+{
+public:
+  explicit dummy_rlc_reader(uint32_t nof_bytes_) : nof_bytes(nof_bytes_) {}
+  uint32_t read_pdu(uint32_t lcid, uint8_t* payload, uint32_t requested_bytes) override
+  {
+    uint32_t len = std::min(nof_bytes, requested_bytes);
+    for (uint32_t i = 0; i < len; i++) {
+      payload[i] = i % 256;
+    }
+    return len;
+  }
+
+private:
+  uint32_t nof_bytes;
+};
+
+int mac_dl_sch_pdu_inplace_pack_test10()
+{
+  // MAC PDU with a 300 B SDU and a 10 B SDU that RLC writes in place. The second SDU keeps the 16-bit L field that
+  // was selected before reading it
+  byte_buffer_t          tx_buffer;
+  srsran::mac_sch_pdu_nr tx_pdu;
+  tx_pdu.init_tx(&tx_buffer, 1024);
+
+  dummy_rlc_reader long_sdu(300), short_sdu(10), no_sdu(0);
+  TESTASSERT(tx_pdu.add_sdu(4, 300, &long_sdu) == 300);
+  TESTASSERT(tx_pdu.add_sdu(5, 600, &short_sdu) == 10);
+  TESTASSERT(tx_pdu.add_sdu(6, 600, &no_sdu) == 0);
+  TESTASSERT(tx_pdu.get_remaing_len() == 1024 - 303 - 13);
+  tx_pdu.pack();
+  TESTASSERT(tx_buffer.N_bytes == 1024);
+
+  srsran::mac_sch_pdu_nr rx_pdu;
+  rx_pdu.unpack(tx_buffer.msg, tx_buffer.N_bytes);
+  TESTASSERT(rx_pdu.get_num_subpdus() == 3);
+  TESTASSERT(rx_pdu.get_subpdu(0).get_lcid() == 4);
+  TESTASSERT(rx_pdu.get_subpdu(0).get_sdu_length() == 300);
+  TESTASSERT(rx_pdu.get_subpdu(1).get_lcid() == 5);
+  TESTASSERT(rx_pdu.get_subpdu(1).get_sdu_length() == 10);
+  for (uint32_t i = 0; i < 300; i++) {
+    TESTASSERT(rx_pdu.get_subpdu(0).get_sdu()[i] == i % 256);
+  }
+  for (uint32_t i = 0; i < 10; i++) {
+    TESTASSERT(rx_pdu.get_subpdu(1).get_sdu()[i] == i);
+  }
+
+  // Small grants use the 8-bit L field
+  byte_buffer_t small_buffer;
+  tx_pdu.init_tx(&small_buffer, 100);
+  TESTASSERT(tx_pdu.add_sdu(4, 98, &long_sdu) == 98);
+  TESTASSERT(tx_pdu.get_remaing_len() == 0);
+  TESTASSERT(small_buffer.N_bytes == 100);
+
+  if (pcap_handle) {
+    pcap_handle->write_dl_crnti_nr(tx_buffer.msg, tx_buffer.N_bytes, PCAP_CRNTI, true, PCAP_TTI);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int mac_ul_sch_pdu_unpack_test1()
 {
   // UL-SCH MAC PDU with fixed-size CE and DL-SCH subheader with 16-bit length field
@@ -948,6 +1011,11 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
+  if (mac_dl_sch_pdu_inplace_pack_test10()) {
+    fprintf(stderr, "mac_dl_sch_pdu_inplace_pack_test10() failed.\n");
+    return SRSRAN_ERROR;
+  }
+
   if (mac_ul_sch_pdu_unpack_test1()) {
     fprintf(stderr, "mac_ul_sch_pdu_unpack_test1() failed.\n");
     return SRSRAN_ERROR;
@@ -0,0 +1,160 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/common/test_common.h"
+#include "srsran/mac/pdu_queue.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint32_t pool_size = 128;
+
+/// Checks that the PDUs of every producer are processed in push order
+class pdu_checker : public srsran::pdu_queue::process_callback
+{
+public:
+  explicit pdu_checker(srsran::pdu_queue& q_) : q(q_) {}
+
+  void process_pdu(uint8_t* buff, uint32_t len, srsran::pdu_queue::channel_t channel, int ul_nof_prbs) override
+  {
+    uint32_t producer = buff[0];
+    uint32_t count    = buff[1] | (buff[2] << 8u) | (buff[3] << 16u);
+    TESTASSERT(producer < next_count.size());
+    TESTASSERT(count == next_count[producer]);
+    TESTASSERT(len == 4 + count % 100);
+    TESTASSERT(channel == srsran::pdu_queue::DCH);
+    next_count[producer]++;
+    nof_processed++;
+    q.deallocate(buff);
+    in_flight--;
+  }
+
+  srsran::pdu_queue&    q;
+  std::vector<uint32_t> next_count    = std::vector<uint32_t>(4, 0);
+  uint32_t              nof_processed = 0;
+  std::atomic<uint32_t> in_flight{0};
+};
+
+} // namespace
+
+int test_pdu_queue_handoff()
+{
+  srsran::pdu_queue q(srslog::fetch_basic_logger("MAC"));
+  pdu_checker       checker(q);
+  q.init(&checker);
+
+  const uint32_t           nof_producers = 4;
+  const uint32_t           nof_pdus      = 20000;
+  std::atomic<bool>        producers_done{false};
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&q, &checker, p]() {
+      for (uint32_t i = 0; i < nof_pdus; i++) {
+        // keep below the pool size, like the HARQ processes do
+        while (checker.in_flight.fetch_add(1) >= 16) {
+          checker.in_flight--;
+          std::this_thread::yield();
+        }
+        uint8_t* pdu = q.request(4 + i % 100);
+        TESTASSERT(pdu != nullptr);
+        pdu[0] = p;
+        pdu[1] = i & 0xffu;
+        pdu[2] = (i >> 8u) & 0xffu;
+        pdu[3] = (i >> 16u) & 0xffu;
+        q.push(pdu, 4 + i % 100);
+      }
+    });
+  }
+  std::thread consumer([&q, &producers_done]() {
+    while (not producers_done) {
+      q.process_pdus();
+    }
+    q.process_pdus();
+  });
+
+  for (auto& t : producers) {
+    t.join();
+  }
+  producers_done = true;
+  consumer.join();
+  TESTASSERT(checker.nof_processed == nof_producers * nof_pdus);
+
+  // All the buffers are back in the pool
+  std::vector<uint8_t*> pdus;
+  for (uint32_t i = 0; i < pool_size; ++i) {
+    pdus.push_back(q.request(10));
+    TESTASSERT(pdus.back() != nullptr);
+  }
+  for (uint8_t* pdu : pdus) {
+    q.deallocate(pdu);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_pdu_queue_reset()
+{
+  srsran::pdu_queue q(srslog::fetch_basic_logger("MAC"));
+  pdu_checker       checker(q);
+  q.init(&checker);
+
+  // Fill the pool with pushed PDUs
+  for (uint32_t i = 0; i < pool_size; ++i) {
+    uint8_t* pdu = q.request(10);
+    TESTASSERT(pdu != nullptr);
+    q.push(pdu, 10);
+  }
+  TESTASSERT(q.request(10) == nullptr);
+
+  // Buffers that are not from the pool are rejected
+  uint8_t other[16] = {};
+  q.push(other, sizeof(other));
+  q.deallocate(other);
+
+  // The dropped PDUs are not processed, and their buffers are free again
+  q.reset();
+  TESTASSERT(not q.process_pdus());
+  TESTASSERT(checker.nof_processed == 0);
+  for (uint32_t i = 0; i < pool_size; ++i) {
+    TESTASSERT(q.request(10) != nullptr);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  auto& mac_logger = srslog::fetch_basic_logger("MAC", false);
+  mac_logger.set_level(srslog::basic_levels::none);
+
+  // Start the log backend.
+  srslog::init();
+
+  TESTASSERT(test_pdu_queue_handoff() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdu_queue_reset() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
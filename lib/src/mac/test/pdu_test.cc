@@ -1141,6 +1141,76 @@ int mac_sch_pdu_unpack_test4()
   return SRSRAN_SUCCESS;
 }
 
+// Unpacking of UL-SCH PDU with the fast-path parser, which must find the same subPDUs as sch_pdu
+int mac_ul_sch_pdu_parser_test1()
+{
+  // Padding, Long BSR, SDU with 7-bit L, SDU with 15-bit L and last SDU without L
+  static uint8_t tv[300] = {0x3f, 0x3e, 0x24, 0x05, 0x23, 0x80, 0xc8, 0x01};
+  const uint32_t hdr_len = 8;
+  for (uint32_t i = hdr_len; i < sizeof(tv); ++i) {
+    tv[i] = i;
+  }
+
+  srsran::ul_sch_pdu_parser parser;
+  TESTASSERT(parser.parse(tv, sizeof(tv)) == SRSRAN_SUCCESS);
+  TESTASSERT(parser.ces().size() == 1);
+  TESTASSERT(parser.ces()[0].lcid == (uint32_t)srsran::ul_sch_lcid::LONG_BSR);
+  TESTASSERT(parser.ces()[0].offset == hdr_len);
+  TESTASSERT(parser.ces()[0].nof_bytes == 3);
+  TESTASSERT(parser.sdus().size() == 3);
+
+  srsran::sch_pdu pdu(20, srslog::fetch_basic_logger("MAC"));
+  pdu.init_rx(sizeof(tv), true);
+  pdu.parse_packet(tv);
+  uint32_t sdu_idx = 0;
+  while (pdu.next()) {
+    if (pdu.get()->is_sdu()) {
+      TESTASSERT(sdu_idx < parser.sdus().size());
+      const srsran::ul_sch_subpdu_t& sdu = parser.sdus()[sdu_idx++];
+      TESTASSERT(sdu.lcid == pdu.get()->get_sdu_lcid());
+      TESTASSERT(sdu.nof_bytes == pdu.get()->get_payload_size());
+      TESTASSERT(tv + sdu.offset == pdu.get()->get_sdu_ptr());
+    }
+  }
+  TESTASSERT(sdu_idx == 3);
+  TESTASSERT(parser.sdus()[1].nof_bytes == 200);
+  TESTASSERT(parser.sdus()[2].nof_bytes == sizeof(tv) - hdr_len - 3 - 5 - 200);
+
+  // The CE is processed from a sch_subh
+  srsran::sch_subh ce;
+  ce.init_rx_ce(parser.ces()[0].lcid, tv + parser.ces()[0].offset, parser.ces()[0].nof_bytes);
+  TESTASSERT(ce.ul_sch_ce_type() == srsran::ul_sch_lcid::LONG_BSR);
+
+  return SRSRAN_SUCCESS;
+}
+
+// Corrupted UL-SCH PDUs are rejected by the fast-path parser
+int mac_ul_sch_pdu_parser_test2()
+{
+  srsran::ul_sch_pdu_parser parser;
+
+  // Only padding subheaders that indicate another subheader
+  static uint8_t tv1[] = {0x3f, 0x3f};
+  TESTASSERT(parser.parse(tv1, sizeof(tv1)) == SRSRAN_ERROR);
+  TESTASSERT(parser.sdus().empty() and parser.ces().empty());
+
+  // The SDU length exceeds the PDU length
+  static uint8_t tv2[] = {0x3f, 0x3f, 0x21, 0x3f, 0x03, 0x00, 0x04, 0x00, 0x04};
+  TESTASSERT(parser.parse(tv2, sizeof(tv2)) == SRSRAN_ERROR);
+  TESTASSERT(parser.sdus().empty() and parser.ces().empty());
+
+  // The L field is cut by the end of the PDU
+  static uint8_t tv3[] = {0x3a, 0x23, 0x80};
+  TESTASSERT(parser.parse(tv3, sizeof(tv3)) == SRSRAN_ERROR);
+
+  // Only padding
+  static uint8_t tv4[] = {0x1f, 0x00, 0x00};
+  TESTASSERT(parser.parse(tv4, sizeof(tv4)) == SRSRAN_SUCCESS);
+  TESTASSERT(parser.sdus().empty() and parser.ces().empty());
+
+  return SRSRAN_SUCCESS;
+}
+
 int mac_slsch_pdu_unpack_test1()
 {
   // SL-SCH PDU captures from UXM 5G CV2X
@@ -1199,6 +1269,9 @@ int main(int argc, char** argv)
   TESTASSERT(mac_sch_pdu_unpack_test3() == SRSRAN_SUCCESS);
   TESTASSERT(mac_sch_pdu_unpack_test4() == SRSRAN_SUCCESS);
 
+  TESTASSERT(mac_ul_sch_pdu_parser_test1() == SRSRAN_SUCCESS);
+  TESTASSERT(mac_ul_sch_pdu_parser_test2() == SRSRAN_SUCCESS);
+
   TESTASSERT(mac_slsch_pdu_unpack_test1() == SRSRAN_SUCCESS);
 
   return SRSRAN_SUCCESS;
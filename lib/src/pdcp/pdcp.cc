@@ -95,6 +95,7 @@ bool pdcp::is_lcid_enabled(uint32_t lcid)
 void pdcp::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu, int sn)
 {
   if (valid_lcid(lcid)) {
+    sdu->md.trace.stamp(pkt_trace_point::pdcp_tx);
     pdcp_array.at(lcid)->write_sdu(std::move(sdu), sn);
   } else {
     logger.warning("LCID %d doesn't exist. Deallocating SDU", lcid);
@@ -118,7 +119,9 @@ int pdcp::add_bearer(uint32_t lcid, const pdcp_config_t& cfg)
 
   // For now we create an pdcp entity lte for nr due to it's maturity
   if (cfg.rat == srsran::srsran_rat_t::lte) {
-    entity.reset(new pdcp_entity_lte{rlc, rrc, gw, task_sched, logger, lcid});
+    std::unique_ptr<pdcp_entity_lte> lte_entity(new pdcp_entity_lte{rlc, rrc, gw, task_sched, logger, lcid});
+    lte_entity->set_tx_crypto_offload(tx_crypto_offload);
+    entity = std::move(lte_entity);
   } else if (cfg.rat == srsran::srsran_rat_t::nr) {
     entity.reset(new pdcp_entity_nr{rlc, rrc, gw, task_sched, logger, lcid});
   }
@@ -274,7 +277,7 @@ bool pdcp::set_bearer_state(uint32_t lcid, const srsran::pdcp_lte_state_t& state
   return true;
 }
 
-std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint32_t lcid)
+std::vector<srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint32_t lcid)
 {
   if (not valid_lcid(lcid)) {
     return {};
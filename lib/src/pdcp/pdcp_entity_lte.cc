@@ -23,12 +23,25 @@
 #include "srsran/common/int_helpers.h"
 #include "srsran/common/security.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/ue_gw_interfaces.h"
 #include "srsran/interfaces/ue_rlc_interfaces.h"
 #include <bitset>
 
 namespace srsran {
 
+// Copy of the user plane ciphering config, shared by the TX crypto jobs that use it
+struct pdcp_entity_lte::tx_crypto_ctx_t {
+  CIPHERING_ALGORITHM_ID_ENUM       cipher_algo;
+  as_key_t                          k_up_enc;
+  security_128_aes_ctx_t            aes_ctx;
+  uint8_t                           bearer_id;
+  security_direction_t              direction;
+  uint32_t                          hdr_len_bytes;
+  task_sched_handle                 task_sched{nullptr};
+  std::shared_ptr<pdcp_entity_lte*> owner;
+};
+
 /****************************************************************************
  * PDCP Entity LTE class
  ***************************************************************************/
@@ -39,7 +52,12 @@ pdcp_entity_lte::pdcp_entity_lte(srsue::rlc_interface_pdcp* rlc_,
                                  srsran::task_sched_handle  task_sched_,
                                  srslog::basic_logger&      logger,
                                  uint32_t                   lcid_) :
-  pdcp_entity_base(task_sched_, logger), rlc(rlc_), rrc(rrc_), gw(gw_)
+  pdcp_entity_base(task_sched_, logger),
+  rlc(rlc_),
+  rrc(rrc_),
+  gw(gw_),
+  rohc(logger),
+  tx_crypto_owner(std::make_shared<pdcp_entity_lte*>(this))
 {
   // Initial state
   integrity_direction  = DIRECTION_NONE;
@@ -56,6 +74,7 @@ pdcp_entity_lte::pdcp_entity_lte(srsue::rlc_interface_pdcp* rlc_,
 pdcp_entity_lte::~pdcp_entity_lte()
 {
   reset();
+  *tx_crypto_owner = nullptr;
 }
 
 bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
@@ -98,12 +117,23 @@ bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
               maximum_pdcp_sn,
               static_cast<uint32_t>(cfg.discard_timer));
   logger.info("Status Report Required: %s", cfg.status_report_required ? "True" : "False");
+  if (cfg.rohc.enabled) {
+    logger.info("ROHC MAX_CID: %d, profiles: RTP=%s, UDP=%s",
+                cfg.rohc.max_cid,
+                cfg.rohc.profile_rtp ? "True" : "False",
+                cfg.rohc.profile_udp ? "True" : "False");
+  }
 
   if (is_drb() and not rlc->rb_is_um(lcid)) {
-    undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(new undelivered_sdus_queue(task_sched, maximum_pdcp_sn));
+    undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(new undelivered_sdus_queue(
+        task_sched, maximum_pdcp_sn + 1, [this](uint32_t discard_sn) { discard_sdu(discard_sn); }));
     rx_counts_info.reserve(reordering_window);
   }
 
+  if (is_drb() and cfg.rohc.enabled) {
+    rohc.configure(cfg.rohc);
+  }
+
   // Check supported config
   if (!check_valid_config()) {
     srsran::console("Warning: Invalid PDCP config.\n");
@@ -131,6 +161,11 @@ void pdcp_entity_lte::reestablish()
   } else {
     // Sending the status report will be triggered by the RRC if required
   }
+
+  // Restart the header compression in IR state
+  if (is_drb() and cfg.rohc.enabled) {
+    rohc.reset();
+  }
 }
 
 // Used to stop/pause the entity (called on RRC conn release)
@@ -140,6 +175,7 @@ void pdcp_entity_lte::reset()
     logger.debug("Reset %s", rb_name.c_str());
   }
   active = false;
+  clear_tx_crypto_jobs();
 }
 
 // GW/RRC interface
@@ -182,6 +218,13 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
       return;
     }
   }
+
+  // Compress the headers. The stored copy keeps them, to be compressed with the new contexts after a reestablishment
+  if (is_drb() and cfg.rohc.enabled and not rohc.compress(sdu.get())) {
+    logger.error("Could not compress SDU headers. Discarding SN=%d", used_sn);
+    return;
+  }
+
   // check for pending security config in transmit direction
   if (enable_security_tx_sn != -1 && enable_security_tx_sn == static_cast<int32_t>(tx_count)) {
     enable_integrity(DIRECTION_TX);
@@ -202,7 +245,9 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     append_mac(sdu, mac);
   }
 
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
+  bool do_encryption = encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX;
+  bool async_cipher  = do_encryption and offload_tx_ciphering();
+  if (do_encryption and not async_cipher) {
     cipher_encrypt(
         &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
   }
@@ -234,9 +279,106 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
   if (rlc->rb_is_um(lcid)) {
     metrics.num_tx_acked_bytes = metrics.num_tx_pdu_bytes;
   }
+  if (async_cipher) {
+    push_tx_crypto_job(std::move(sdu), tx_count);
+    return;
+  }
+  if (not tx_crypto_jobs.empty()) {
+    // Keep the TX order with the PDUs that are still being ciphered
+    tx_crypto_jobs.push_back(tx_crypto_job_t{std::move(sdu), true});
+    return;
+  }
   rlc->write_sdu(lcid, std::move(sdu));
 }
 
+/****************************************************************************
+ * Offloaded TX ciphering
+ ***************************************************************************/
+bool pdcp_entity_lte::offload_tx_ciphering()
+{
+  if (not tx_crypto_offload or not is_drb() or sec_cfg.cipher_algo == CIPHERING_ALGORITHM_ID_EEA0) {
+    return false;
+  }
+  // A job never sees a key change, so a new context is made when the security is reconfigured
+  if (tx_crypto_ctx == nullptr or tx_crypto_ctx->cipher_algo != sec_cfg.cipher_algo or
+      tx_crypto_ctx->k_up_enc != sec_cfg.k_up_enc or tx_crypto_ctx->bearer_id != cfg.bearer_id or
+      tx_crypto_ctx->direction != cfg.tx_direction) {
+    tx_crypto_ctx                = std::make_shared<tx_crypto_ctx_t>();
+    tx_crypto_ctx->cipher_algo   = sec_cfg.cipher_algo;
+    tx_crypto_ctx->k_up_enc      = sec_cfg.k_up_enc;
+    tx_crypto_ctx->bearer_id     = cfg.bearer_id;
+    tx_crypto_ctx->direction     = cfg.tx_direction;
+    tx_crypto_ctx->hdr_len_bytes = cfg.hdr_len_bytes;
+    tx_crypto_ctx->task_sched    = task_sched;
+    tx_crypto_ctx->owner         = tx_crypto_owner;
+    if (sec_cfg.cipher_algo == CIPHERING_ALGORITHM_ID_128_EEA2) {
+      security_128_aes_set_key(tx_crypto_ctx->aes_ctx, &tx_crypto_ctx->k_up_enc[16]);
+    }
+  }
+  return true;
+}
+
+void pdcp_entity_lte::push_tx_crypto_job(unique_byte_buffer_t pdu, uint32_t tx_count)
+{
+  uint32_t job_id = tx_crypto_first_job + tx_crypto_jobs.size();
+  tx_crypto_jobs.push_back(tx_crypto_job_t{nullptr, false});
+
+  std::shared_ptr<tx_crypto_ctx_t> ctx = tx_crypto_ctx;
+  get_crypto_workers().push_task([ctx, job_id, tx_count, pdu = std::move(pdu)]() mutable {
+    uint8_t* msg     = &pdu->msg[ctx->hdr_len_bytes];
+    uint32_t msg_len = pdu->N_bytes - ctx->hdr_len_bytes;
+    uint8_t  bearer  = ctx->bearer_id - 1;
+    uint8_t  ct_tmp[PDCP_MAX_SDU_SIZE];
+    switch (ctx->cipher_algo) {
+      case CIPHERING_ALGORITHM_ID_128_EEA1:
+        security_128_eea1(&ctx->k_up_enc[16], tx_count, bearer, ctx->direction, msg, msg_len, ct_tmp);
+        memcpy(msg, ct_tmp, msg_len);
+        break;
+      case CIPHERING_ALGORITHM_ID_128_EEA2:
+        security_128_eea2(ctx->aes_ctx, tx_count, bearer, ctx->direction, msg, msg_len, msg);
+        break;
+      case CIPHERING_ALGORITHM_ID_128_EEA3:
+        security_128_eea3(&ctx->k_up_enc[16], tx_count, bearer, ctx->direction, msg, msg_len, ct_tmp);
+        memcpy(msg, ct_tmp, msg_len);
+        break;
+      default:
+        break;
+    }
+    // The result is handled by the stack thread, which owns the entity
+    task_sched_handle sched = ctx->task_sched;
+    sched.notify_background_task_result([ctx, job_id, pdu = std::move(pdu)]() mutable {
+      if (*ctx->owner != nullptr) {
+        (*ctx->owner)->handle_tx_crypto_result(job_id, std::move(pdu));
+      }
+    });
+  });
+}
+
+void pdcp_entity_lte::handle_tx_crypto_result(uint32_t job_id, unique_byte_buffer_t pdu)
+{
+  uint32_t idx = job_id - tx_crypto_first_job;
+  if (idx >= tx_crypto_jobs.size()) {
+    // The jobs were dropped by a reset of the entity
+    return;
+  }
+  tx_crypto_jobs[idx].pdu  = std::move(pdu);
+  tx_crypto_jobs[idx].done = true;
+
+  // Pass the ciphered PDUs to the RLC up to the first one still in the workers
+  while (not tx_crypto_jobs.empty() and tx_crypto_jobs.front().done) {
+    unique_byte_buffer_t front = std::move(tx_crypto_jobs.front().pdu);
+    tx_crypto_jobs.pop_front();
+    tx_crypto_first_job++;
+    rlc->write_sdu(lcid, std::move(front));
+  }
+}
+
+void pdcp_entity_lte::clear_tx_crypto_jobs()
+{
+  tx_crypto_first_job += tx_crypto_jobs.size();
+  tx_crypto_jobs.clear();
+}
+
 // RLC interface
 void pdcp_entity_lte::write_pdu(unique_byte_buffer_t pdu)
 {
@@ -389,6 +531,11 @@ void pdcp_entity_lte::handle_um_drb_pdu(srsran::unique_byte_buffer_t pdu)
     st.rx_hfn++;
   }
 
+  if (cfg.rohc.enabled and not rohc.decompress(pdu.get())) {
+    logger.info("Discarding SN=%d, the headers could not be decompressed", sn);
+    return;
+  }
+
   // Pass to upper layers
   gw->write_pdu(lcid, std::move(pdu));
 }
@@ -453,6 +600,11 @@ void pdcp_entity_lte::handle_am_drb_pdu(srsran::unique_byte_buffer_t pdu)
   // Store Rx SN/COUNT
   update_rx_counts_queue(count);
 
+  if (cfg.rohc.enabled and not rohc.decompress(pdu.get())) {
+    logger.info("Discarding SN=%d, the headers could not be decompressed", sn);
+    return;
+  }
+
   // Pass to upper layers
   gw->write_pdu(lcid, std::move(pdu));
 }
@@ -717,10 +869,9 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
     }
   }
 
-  // Copy PDU contents into queue and start discard timer
-  uint32_t         discard_timeout = static_cast<uint32_t>(cfg.discard_timer);
-  discard_callback discard_fnc(this, sn);
-  bool             ret = undelivered_sdus->add_sdu(sn, sdu, discard_timeout, discard_fnc);
+  // Copy PDU contents into queue and schedule its discard
+  uint32_t discard_timeout = static_cast<uint32_t>(cfg.discard_timer);
+  bool     ret             = undelivered_sdus->add_sdu(sn, sdu, discard_timeout);
   if (ret and discard_timeout > 0) {
     logger.debug("Discard Timer set for SN %u. Timeout: %ums", sn, discard_timeout);
   }
@@ -730,20 +881,20 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
 /****************************************************************************
  * Discard functionality
  ***************************************************************************/
-// Discard Timer Callback (discardTimer)
-void pdcp_entity_lte::discard_callback::operator()(uint32_t timer_id)
+// Discard Timer expiry (discardTimer)
+void pdcp_entity_lte::discard_sdu(uint32_t discard_sn)
 {
-  parent->logger.info("Discard timer for SN=%d expired", discard_sn);
+  logger.info("Discard timer for SN=%d expired", discard_sn);
 
   // Notify the RLC of the discard. It's the RLC to actually discard, if no segment was transmitted yet.
-  parent->rlc->discard_sdu(parent->lcid, discard_sn);
+  rlc->discard_sdu(lcid, discard_sn);
 
   // Discard PDU if unacknowledged
-  if (parent->undelivered_sdus->has_sdu(discard_sn)) {
-    parent->logger.debug("Removed undelivered PDU with TX_COUNT=%d", discard_sn);
-    parent->undelivered_sdus->clear_sdu(discard_sn);
+  if (undelivered_sdus->has_sdu(discard_sn)) {
+    logger.debug("Removed undelivered PDU with TX_COUNT=%d", discard_sn);
+    undelivered_sdus->clear_sdu(discard_sn);
   } else {
-    parent->logger.debug("Could not find PDU to discard. TX_COUNT=%d", discard_sn);
+    logger.debug("Could not find PDU to discard. TX_COUNT=%d", discard_sn);
   }
 }
 
@@ -768,9 +919,8 @@ void pdcp_entity_lte::notify_delivery(const pdcp_sn_vector_t& pdcp_sns)
     } else {
       // Metrics
       auto& sdu = (*undelivered_sdus)[sn];
-      tx_pdu_ack_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
-                                     std::chrono::high_resolution_clock::now() - sdu->get_timestamp())
-                                     .count());
+      tx_pdu_ack_latency_ms.push(
+          std::chrono::duration_cast<std::chrono::milliseconds>(sdu->get_latency_us()).count());
       metrics.num_tx_acked_bytes += sdu->N_bytes;
       metrics.num_tx_buffered_pdus_bytes -= sdu->N_bytes;
 
@@ -840,14 +990,14 @@ void pdcp_entity_lte::set_bearer_state(const pdcp_lte_state_t& state, bool set_f
   }
 }
 
-std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp_entity_lte::get_buffered_pdus()
+std::vector<srsran::unique_byte_buffer_t> pdcp_entity_lte::get_buffered_pdus()
 {
   if (undelivered_sdus == nullptr) {
     logger.error("Buffered PDUs being requested for non-AM DRB");
-    return std::map<uint32_t, srsran::unique_byte_buffer_t>{};
+    return std::vector<srsran::unique_byte_buffer_t>{};
   }
   logger.info("Buffered PDUs requested, buffer_size=%zu", undelivered_sdus->size());
-  return undelivered_sdus->get_buffered_sdus();
+  return undelivered_sdus->release_buffered_sdus();
 }
 
 /****************************************************************************
@@ -873,17 +1023,13 @@ void pdcp_entity_lte::reset_metrics()
 /****************************************************************************
  * Undelivered SDUs queue helpers
  ***************************************************************************/
-undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod) : sn_mod(sn_mod)
-{
-  for (auto& e : sdus) {
-    e.discard_timer = task_sched.get_unique_timer();
-  }
-}
+undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle             task_sched,
+                                               uint32_t                              sn_mod,
+                                               srsran::move_callback<void(uint32_t)> discard_callback_) :
+  sn_mod(sn_mod), discard_callback(std::move(discard_callback_)), discard_timer(task_sched.get_unique_timer())
+{}
 
-bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
-                                     const srsran::unique_byte_buffer_t&   sdu,
-                                     uint32_t                              discard_timeout,
-                                     srsran::move_callback<void(uint32_t)> callback)
+bool undelivered_sdus_queue::add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu, uint32_t discard_timeout)
 {
   assert(not has_sdu(sn) && "Cannot add repeated SNs");
 
@@ -922,8 +1068,15 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
   sdus[sn].sdu->N_bytes    = sdu->N_bytes;
   memcpy(sdus[sn].sdu->msg, sdu->msg, sdu->N_bytes);
   if (discard_timeout > 0) {
-    sdus[sn].discard_timer.set(discard_timeout, std::move(callback));
-    sdus[sn].discard_timer.run();
+    // The timeout is the same for all SDUs of the bearer, so the ring stays ordered by deadline
+    uint32_t deadline = discard_clock() + discard_timeout;
+    discard_ring.push_back(discard_entry{sn, deadline});
+    sdus[sn].discard_pending  = true;
+    sdus[sn].discard_deadline = deadline;
+    if (not discard_timer.is_running()) {
+      discard_timer.set(discard_timeout, [this](uint32_t tid) { handle_discard_timer_expiry(); });
+      discard_timer.run();
+    }
   }
   sdus[sn].sdu->set_timestamp(); // Metrics
   bytes += sdu->N_bytes;
@@ -937,7 +1090,7 @@ bool undelivered_sdus_queue::clear_sdu(uint32_t sn)
   }
   count--;
   bytes -= sdus[sn].sdu->N_bytes;
-  sdus[sn].discard_timer.stop();
+  sdus[sn].discard_pending = false;
   sdus[sn].sdu.reset();
   // Find next FMS, if necessary
   if (sn == fms) {
@@ -952,16 +1105,53 @@ void undelivered_sdus_queue::clear()
   bytes = 0;
   fms   = 0;
   for (uint32_t sn = 0; sn < capacity; sn++) {
-    sdus[sn].discard_timer.stop();
+    sdus[sn].discard_pending = false;
     sdus[sn].sdu.reset();
   }
+  clear_discard_ring();
 }
 
 size_t undelivered_sdus_queue::nof_discard_timers() const
 {
-  return std::count_if(sdus.begin(), sdus.end(), [](const sdu_data& s) {
-    return s.sdu != nullptr and s.discard_timer.is_valid() and s.discard_timer.is_running();
-  });
+  return std::count_if(
+      sdus.begin(), sdus.end(), [](const sdu_data& s) { return s.sdu != nullptr and s.discard_pending; });
+}
+
+uint32_t undelivered_sdus_queue::discard_clock() const
+{
+  return discard_epoch + (discard_timer.is_running() ? discard_timer.time_elapsed() : 0);
+}
+
+void undelivered_sdus_queue::handle_discard_timer_expiry()
+{
+  // The timer expired at the deadline of the front of the ring
+  uint32_t now = discard_epoch + discard_timer.duration();
+
+  // Drain all the expired SDUs. Entries of SDUs already delivered, or whose SN was reused since, are skipped
+  while (not discard_ring.empty() and static_cast<int32_t>(discard_ring.front().deadline - now) <= 0) {
+    discard_entry e = discard_ring.front();
+    discard_ring.pop_front();
+    if (sdus[e.sn].sdu != nullptr and sdus[e.sn].discard_pending and sdus[e.sn].discard_deadline == e.deadline) {
+      sdus[e.sn].discard_pending = false;
+      discard_callback(e.sn);
+    }
+  }
+
+  if (discard_ring.empty()) {
+    discard_epoch = now;
+    return;
+  }
+  // Timers run from their own callback only count from the next tic, hence the one tic offset
+  discard_epoch = now - 1;
+  discard_timer.set(discard_ring.front().deadline - now + 1);
+  discard_timer.run();
+}
+
+void undelivered_sdus_queue::clear_discard_ring()
+{
+  discard_timer.stop();
+  discard_ring.clear();
+  discard_epoch = 0;
 }
 
 void undelivered_sdus_queue::update_fms()
@@ -997,21 +1187,20 @@ void undelivered_sdus_queue::update_lms(uint32_t sn)
   }
 }
 
-std::map<uint32_t, srsran::unique_byte_buffer_t> undelivered_sdus_queue::get_buffered_sdus()
+std::vector<srsran::unique_byte_buffer_t> undelivered_sdus_queue::release_buffered_sdus()
 {
-  std::map<uint32_t, srsran::unique_byte_buffer_t> fwd_sdus;
-  for (auto& sdu : sdus) {
-    if (sdu.sdu != nullptr) {
-      // TODO: Find ways to avoid deep copy
-      srsran::unique_byte_buffer_t fwd_sdu = make_byte_buffer();
-      if (fwd_sdu != nullptr) {
-        *fwd_sdu = *sdu.sdu;
-        fwd_sdus.emplace(sdu.sdu->md.pdcp_sn, std::move(fwd_sdu));
-      } else {
-        srslog::fetch_basic_logger("PDCP").warning("Can't allocate buffer to forward buffered SDUs.");
-      }
+  std::vector<srsran::unique_byte_buffer_t> fwd_sdus;
+  fwd_sdus.reserve(count);
+  // Walk the SN space from the FMS, so that the SDUs come out in COUNT order also across the SN wrap-around
+  for (uint32_t i = 0, sn = fms; i < capacity and fwd_sdus.size() < count; ++i, sn = increment_sn(sn)) {
+    if (has_sdu(sn)) {
+      sdus[sn].discard_pending = false;
+      fwd_sdus.push_back(std::move(sdus[sn].sdu));
     }
   }
+  count = 0;
+  bytes = 0;
+  clear_discard_ring();
   return fwd_sdus;
 }
 
@@ -55,6 +55,7 @@ bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
   cfg         = cnfg_;
   rb_name     = cfg.get_rb_name();
   window_size = 1 << (cfg.sn_len - 1);
+  reorder_queue.resize(window_size);
 
   rlc_mode = rlc->rb_is_um(lcid) ? rlc_mode_t::UM : rlc_mode_t::AM;
 
@@ -286,13 +287,13 @@ void pdcp_entity_nr::write_pdu(unique_byte_buffer_t pdu)
   }
 
   // Check if PDU has been received
-  if (reorder_queue.find(rcvd_count) != reorder_queue.end()) {
+  if (reorder_queue.contains(rcvd_count)) {
     logger.debug("Duplicate PDU, dropping");
     return; // PDU already present, drop.
   }
 
   // Store PDU in reception buffer
-  reorder_queue[rcvd_count] = std::move(pdu);
+  reorder_queue.insert(rcvd_count, std::move(pdu));
 
   // Update RX_NEXT
   if (rcvd_count >= rx_next) {
@@ -347,10 +348,8 @@ void pdcp_entity_nr::notify_failure(const pdcp_sn_vector_t& pdcp_sns)
 // Update RX_NEXT after submitting to higher layers
 void pdcp_entity_nr::deliver_all_consecutive_counts()
 {
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = reorder_queue.begin();
-       it != reorder_queue.end() && it->first == rx_deliv;
-       reorder_queue.erase(it++)) {
-    logger.debug("Delivering SDU with RCVD_COUNT %u", it->first);
+  while (reorder_queue.contains(rx_deliv)) {
+    logger.debug("Delivering SDU with RCVD_COUNT %u", rx_deliv);
 
     // Check RX_DELIV overflow
     if (rx_overflow) {
@@ -362,7 +361,7 @@ void pdcp_entity_nr::deliver_all_consecutive_counts()
     }
 
     // Pass PDCP SDU to the next layers
-    pass_to_upper_layers(std::move(it->second));
+    pass_to_upper_layers(reorder_queue.pop(rx_deliv));
 
     // Update RX_DELIV
     rx_deliv = rx_deliv + 1;
@@ -379,11 +378,11 @@ void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
       "Reordering timer expired. RX_REORD=%u, re-order queue size=%ld", parent->rx_reord, parent->reorder_queue.size());
 
   // Deliver all PDCP SDU(s) with associated COUNT value(s) < RX_REORD
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = parent->reorder_queue.begin();
-       it != parent->reorder_queue.end() && it->first < parent->rx_reord;
-       parent->reorder_queue.erase(it++)) {
+  for (uint32_t count = parent->reorder_queue.find_first(parent->rx_deliv, parent->rx_reord);
+       count != parent->rx_reord;
+       count = parent->reorder_queue.find_first(count + 1, parent->rx_reord)) {
     // Deliver to upper layers
-    parent->pass_to_upper_layers(std::move(it->second));
+    parent->pass_to_upper_layers(parent->reorder_queue.pop(count));
   }
 
   // Update RX_DELIV to the first PDCP SDU not delivered to the upper layers
@@ -436,4 +435,66 @@ void pdcp_entity_nr::reset_metrics()
   metrics = {};
 }
 
+/*
+ * Reception buffer
+ */
+void pdcp_nr_reorder_buffer::resize(uint32_t window_size)
+{
+  srsran_assert(window_size <= max_window_size and (window_size & (window_size - 1)) == 0,
+                "Invalid PDCP window size %d",
+                window_size);
+  clear();
+  buffer.resize(window_size);
+  occupied.resize(window_size);
+}
+
+void pdcp_nr_reorder_buffer::clear()
+{
+  for (unique_byte_buffer_t& pdu : buffer) {
+    pdu = nullptr;
+  }
+  occupied.reset();
+  nof_pdus = 0;
+}
+
+void pdcp_nr_reorder_buffer::insert(uint32_t count, unique_byte_buffer_t pdu)
+{
+  uint32_t idx = count & (buffer.size() - 1);
+  buffer[idx]  = std::move(pdu);
+  occupied.set(idx);
+  nof_pdus++;
+}
+
+unique_byte_buffer_t pdcp_nr_reorder_buffer::pop(uint32_t count)
+{
+  uint32_t idx = count & (buffer.size() - 1);
+  occupied.reset(idx);
+  nof_pdus--;
+  return std::move(buffer[idx]);
+}
+
+uint32_t pdcp_nr_reorder_buffer::find_first(uint32_t count_start, uint32_t count_end) const
+{
+  if (nof_pdus == 0 or count_start >= count_end) {
+    return count_end;
+  }
+  // All stored COUNTs lie within one window
+  uint32_t nof_counts = std::min(count_end - count_start, (uint32_t)buffer.size());
+  uint32_t idx        = count_start & (buffer.size() - 1);
+
+  // The searched range may wrap around the end of the bitmap
+  uint32_t len1 = std::min(nof_counts, (uint32_t)buffer.size() - idx);
+  int      pos  = occupied.find_lowest(idx, idx + len1);
+  if (pos >= 0) {
+    return count_start + (pos - idx);
+  }
+  if (len1 < nof_counts) {
+    pos = occupied.find_lowest(0, nof_counts - len1);
+    if (pos >= 0) {
+      return count_start + len1 + pos;
+    }
+  }
+  return count_end;
+}
+
 } // namespace srsran
@@ -0,0 +1,721 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/upper/pdcp_rohc.h"
+#include <algorithm>
+#include <cstring>
+
+namespace srsran {
+
+static const uint32_t ipv4_hdr_len = 20;
+static const uint32_t udp_hdr_len  = 8;
+static const uint32_t rtp_hdr_len  = 12;
+
+// Optimistic approach of the unidirectional mode (RFC 3095 5.3.1.1.1)
+static const uint32_t nof_ir_repetitions   = 3;
+static const uint32_t nof_uor2_repetitions = 3;
+static const uint32_t ir_refresh_period    = 256;
+
+static const uint32_t max_ts_stride = (1u << 29) - 1; // Largest SDVL value
+
+/****************************************************************************
+ * Helpers
+ ***************************************************************************/
+
+static uint16_t get_u16(const uint8_t* p)
+{
+  return (p[0] << 8) | p[1];
+}
+
+static uint32_t get_u32(const uint8_t* p)
+{
+  return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static uint32_t put_u16(uint8_t* p, uint16_t value)
+{
+  p[0] = value >> 8;
+  p[1] = value & 0xff;
+  return 2;
+}
+
+static uint32_t put_u32(uint8_t* p, uint32_t value)
+{
+  put_u16(p, value >> 16);
+  put_u16(&p[2], value & 0xffff);
+  return 4;
+}
+
+// Reflected CRC of the ROHC headers (RFC 3095 5.9). The register of the CRC-3 and CRC-7 fits in the low bits
+static uint8_t rohc_crc(const uint8_t* data, uint32_t len, uint8_t crc, uint8_t poly)
+{
+  for (uint32_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (uint32_t b = 0; b < 8; ++b) {
+      crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+    }
+  }
+  return crc;
+}
+
+static uint8_t rohc_crc3(const uint8_t* data, uint32_t len)
+{
+  return rohc_crc(data, len, 0x07, 0x06);
+}
+
+static uint8_t rohc_crc7(const uint8_t* data, uint32_t len)
+{
+  return rohc_crc(data, len, 0x7f, 0x79);
+}
+
+// CRC-8 of the IR header, computed with the CRC field set to zero
+static uint8_t rohc_crc8(const uint8_t* data, uint32_t len, uint32_t crc_pos)
+{
+  const uint8_t zero = 0;
+  uint8_t       crc  = rohc_crc(data, crc_pos, 0xff, 0xe0);
+  crc                = rohc_crc(&zero, 1, crc, 0xe0);
+  return rohc_crc(&data[crc_pos + 1], len - crc_pos - 1, crc, 0xe0);
+}
+
+// W-LSB decoding, with the interpretation interval [ref - p, ref - p + 2^k - 1] (RFC 3095 4.5.1)
+static uint32_t lsb_decode(uint32_t ref, uint32_t lsb, uint32_t k, uint32_t p, uint32_t mask)
+{
+  uint32_t low = (ref - p) & mask;
+  return (low + ((lsb - low) & ((1u << k) - 1))) & mask;
+}
+
+static bool lsb_fits(uint32_t ref, uint32_t value, uint32_t k, uint32_t p, uint32_t mask)
+{
+  return lsb_decode(ref, value & ((1u << k) - 1), k, p, mask) == value;
+}
+
+static uint16_t ipv4_checksum(const uint8_t* hdr)
+{
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < ipv4_hdr_len; i += 2) {
+    sum += get_u16(&hdr[i]);
+  }
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  return ~sum & 0xffff;
+}
+
+// Self-describing variable-length values (RFC 3095 4.5.6), up to 29 bits
+static uint32_t write_sdvl(uint8_t* p, uint32_t value)
+{
+  if (value < (1u << 7)) {
+    p[0] = value;
+    return 1;
+  }
+  if (value < (1u << 14)) {
+    p[0] = 0x80 | (value >> 8);
+    p[1] = value & 0xff;
+    return 2;
+  }
+  if (value < (1u << 21)) {
+    p[0] = 0xc0 | (value >> 16);
+    put_u16(&p[1], value & 0xffff);
+    return 3;
+  }
+  put_u32(p, 0xe0000000 | value);
+  return 4;
+}
+
+static uint32_t read_sdvl(const uint8_t* p, uint32_t len, uint32_t& value)
+{
+  if (len < 1) {
+    return 0;
+  }
+  if ((p[0] & 0x80) == 0) {
+    value = p[0];
+    return 1;
+  }
+  if ((p[0] & 0xc0) == 0x80 and len >= 2) {
+    value = get_u16(p) & 0x3fff;
+    return 2;
+  }
+  if ((p[0] & 0xe0) == 0xc0 and len >= 3) {
+    value = ((p[0] & 0x1f) << 16) | get_u16(&p[1]);
+    return 3;
+  }
+  if ((p[0] & 0xe0) == 0xe0 and len >= 4) {
+    value = get_u32(p) & 0x1fffffff;
+    return 4;
+  }
+  return 0;
+}
+
+static uint32_t get_hdr_len(rohc_profile_t profile)
+{
+  switch (profile) {
+    case rohc_profile_t::rtp:
+      return ipv4_hdr_len + udp_hdr_len + rtp_hdr_len;
+    case rohc_profile_t::udp:
+      return ipv4_hdr_len + udp_hdr_len;
+    default:
+      return 0;
+  }
+}
+
+// Gets the profile of an IP packet and the fields of its headers
+static rohc_profile_t parse_headers(const uint8_t* pkt, uint32_t len, const pdcp_rohc_config_t& cfg, rohc_fields_t& f)
+{
+  // Only IPv4 without options and fragmentation, with a checksum that can be rebuilt
+  if (len < ipv4_hdr_len + udp_hdr_len or pkt[0] != 0x45 or get_u16(&pkt[2]) != len or pkt[9] != 17 or
+      (get_u16(&pkt[6]) & 0xbfff) != 0 or ipv4_checksum(pkt) != 0 or get_u16(&pkt[24]) != len - ipv4_hdr_len) {
+    return rohc_profile_t::uncompressed;
+  }
+  f.tos      = pkt[1];
+  f.ip_id    = get_u16(&pkt[4]);
+  f.df       = (pkt[6] & 0x40) != 0;
+  f.ttl      = pkt[8];
+  f.saddr    = get_u32(&pkt[12]);
+  f.daddr    = get_u32(&pkt[16]);
+  f.sport    = get_u16(&pkt[20]);
+  f.dport    = get_u16(&pkt[22]);
+  f.udp_csum = get_u16(&pkt[26]);
+
+  // RTP version 2 without extension and CSRCs. The payload types 72-76 are RTCP
+  const uint8_t* rtp = &pkt[ipv4_hdr_len + udp_hdr_len];
+  if (cfg.profile_rtp and len >= get_hdr_len(rohc_profile_t::rtp) and (rtp[0] & 0xdf) == 0x80 and
+      ((rtp[1] & 0x7f) < 72 or (rtp[1] & 0x7f) > 76)) {
+    f.rtp_flags = rtp[0];
+    f.m         = (rtp[1] & 0x80) != 0;
+    f.pt        = rtp[1] & 0x7f;
+    f.sn        = get_u16(&rtp[2]);
+    f.ts        = get_u32(&rtp[4]);
+    f.ssrc      = get_u32(&rtp[8]);
+    return rohc_profile_t::rtp;
+  }
+  return cfg.profile_udp ? rohc_profile_t::udp : rohc_profile_t::uncompressed;
+}
+
+// Rebuilds the uncompressed headers. The lengths and the IPv4 checksum are inferred
+static uint32_t write_headers(rohc_profile_t profile, const rohc_fields_t& f, uint32_t payload_len, uint8_t* out)
+{
+  uint32_t hdr_len = get_hdr_len(profile);
+  uint32_t ip_len  = hdr_len + payload_len;
+
+  out[0] = 0x45;
+  out[1] = f.tos;
+  put_u16(&out[2], ip_len);
+  put_u16(&out[4], f.ip_id);
+  put_u16(&out[6], f.df ? 0x4000 : 0);
+  out[8] = f.ttl;
+  out[9] = 17;
+  put_u16(&out[10], 0);
+  put_u32(&out[12], f.saddr);
+  put_u32(&out[16], f.daddr);
+  put_u16(&out[10], ipv4_checksum(out));
+
+  put_u16(&out[20], f.sport);
+  put_u16(&out[22], f.dport);
+  put_u16(&out[24], ip_len - ipv4_hdr_len);
+  put_u16(&out[26], f.udp_csum);
+
+  if (profile == rohc_profile_t::rtp) {
+    uint8_t* rtp = &out[ipv4_hdr_len + udp_hdr_len];
+    rtp[0]       = f.rtp_flags;
+    rtp[1]       = (f.m ? 0x80 : 0) | f.pt;
+    put_u16(&rtp[2], f.sn);
+    put_u32(&rtp[4], f.ts);
+    put_u32(&rtp[8], f.ssrc);
+  }
+  return hdr_len;
+}
+
+static bool is_same_flow(rohc_profile_t profile, const rohc_fields_t& a, const rohc_fields_t& b)
+{
+  return a.saddr == b.saddr and a.daddr == b.daddr and a.sport == b.sport and a.dport == b.dport and
+         (profile != rohc_profile_t::rtp or a.ssrc == b.ssrc);
+}
+
+// Replaces the first old_len bytes of the buffer with the new header, using the headroom if it is longer
+static bool replace_header(byte_buffer_t* buf, uint32_t old_len, const uint8_t* hdr, uint32_t new_len)
+{
+  if (new_len > old_len and new_len - old_len > buf->get_headroom()) {
+    return false;
+  }
+  buf->msg += old_len;
+  buf->msg -= new_len;
+  buf->N_bytes = buf->N_bytes - old_len + new_len;
+  memcpy(buf->msg, hdr, new_len);
+  return true;
+}
+
+/****************************************************************************
+ * Configuration
+ ***************************************************************************/
+
+void pdcp_rohc::configure(const pdcp_rohc_config_t& cfg_)
+{
+  cfg         = cfg_;
+  cfg.max_cid = std::max<uint16_t>(1, std::min<uint16_t>(cfg.max_cid, max_contexts - 1));
+  reset();
+}
+
+// Contexts are reset on reestablishment, restarting in IR state (TS 36.323 5.2)
+void pdcp_rohc::reset()
+{
+  tx_contexts.fill({});
+  rx_contexts.fill({});
+  nof_compressed = 0;
+}
+
+/****************************************************************************
+ * Compressor
+ ***************************************************************************/
+
+bool pdcp_rohc::compress(byte_buffer_t* sdu)
+{
+  rohc_fields_t  fields  = {};
+  rohc_profile_t profile = parse_headers(sdu->msg, sdu->N_bytes, cfg, fields);
+  uint8_t        hdr[max_hdr_len];
+  uint32_t       hdr_len = 0;
+  uint32_t       old_len = 0;
+
+  if (profile == rohc_profile_t::uncompressed) {
+    hdr_len = compress_uncompressed(sdu->msg, sdu->N_bytes, hdr);
+  } else {
+    old_len = get_hdr_len(profile);
+    hdr_len = compress_flow(get_tx_cid(profile, fields), fields, sdu->msg, old_len, hdr);
+  }
+
+  if (not replace_header(sdu, old_len, hdr, hdr_len)) {
+    logger.error("Not enough headroom for the ROHC header of %d B", hdr_len);
+    return false;
+  }
+  return true;
+}
+
+uint32_t pdcp_rohc::get_tx_cid(rohc_profile_t profile, const rohc_fields_t& fields)
+{
+  // Look for the context of the flow, or a free one or the least recently used one otherwise
+  uint32_t new_cid = 0;
+  for (uint32_t cid = 1; cid <= cfg.max_cid; ++cid) {
+    const rohc_context_t& ctx = tx_contexts[cid];
+    if (ctx.active and ctx.profile == profile and is_same_flow(profile, ctx.ref, fields)) {
+      return cid;
+    }
+    if (new_cid == 0 or (tx_contexts[new_cid].active and
+                         (not ctx.active or ctx.last_use < tx_contexts[new_cid].last_use))) {
+      new_cid = cid;
+    }
+  }
+  tx_contexts[new_cid]         = {};
+  tx_contexts[new_cid].profile = profile;
+  return new_cid;
+}
+
+// Profile 0x0000 (RFC 3095 5.10). Uses CID 0, where the Normal packets are the IP packets themselves
+uint32_t pdcp_rohc::compress_uncompressed(const uint8_t* pkt, uint32_t len, uint8_t* out)
+{
+  rohc_context_t& ctx = tx_contexts[0];
+  // The first octet of a Normal packet must not be taken as a ROHC packet type
+  bool is_ir = not ctx.active or ctx.nof_ir > 0 or ctx.since_ir >= ir_refresh_period or len == 0 or
+               (pkt[0] & 0xe0) == 0xe0;
+  if (not ctx.active) {
+    ctx.active  = true;
+    ctx.profile = rohc_profile_t::uncompressed;
+    ctx.nof_ir  = nof_ir_repetitions;
+  }
+  ctx.since_ir++;
+  if (not is_ir) {
+    return 0;
+  }
+  ctx.since_ir = 0;
+  ctx.nof_ir   = ctx.nof_ir > 0 ? ctx.nof_ir - 1 : 0;
+
+  out[0] = 0xfc;
+  out[1] = (uint8_t)rohc_profile_t::uncompressed;
+  out[2] = 0;
+  out[2] = rohc_crc8(out, 3, 2);
+  return 3;
+}
+
+uint32_t
+pdcp_rohc::compress_flow(uint32_t cid, rohc_fields_t& f, const uint8_t* orig_hdr, uint32_t orig_len, uint8_t* out)
+{
+  rohc_context_t&      ctx = tx_contexts[cid];
+  const rohc_fields_t& ref = ctx.ref;
+  bool                 rtp = ctx.profile == rohc_profile_t::rtp;
+
+  if (not rtp) {
+    // Profile 0x0002 numbers the packets of the flow
+    f.sn = ctx.active ? ref.sn + 1 : 0;
+  }
+  uint16_t delta_sn = f.sn - ref.sn;
+
+  // Changes of the fields that are only sent in the IR packets
+  bool on_stride = not rtp or (ctx.ts_stride != 0 and (f.ts - ctx.ts_offset) % ctx.ts_stride == 0);
+  bool changed   = not ctx.active or not on_stride or f.tos != ref.tos or f.ttl != ref.ttl or f.df != ref.df or
+                 (f.udp_csum == 0) != (ref.udp_csum == 0) or f.rtp_flags != ref.rtp_flags or f.pt != ref.pt or
+                 (not ctx.rnd and (uint16_t)(f.ip_id - f.sn) != ctx.ip_id_offset);
+  if (changed) {
+    ctx.nof_ir = std::max(ctx.nof_ir, nof_ir_repetitions);
+  }
+
+  enum { ir, uo0, uor2 } type = ir;
+  uint32_t ts_scaled          = 0;
+  if (ctx.nof_ir == 0 and ctx.since_ir < ir_refresh_period) {
+    if (not rtp) {
+      type = lsb_fits(ref.sn, f.sn, 4, 1, 0xffff) ? uo0 : ir;
+    } else {
+      ts_scaled           = (f.ts - ctx.ts_offset) / ctx.ts_stride;
+      uint32_t ref_scaled = (ref.ts - ctx.ts_offset) / ctx.ts_stride;
+      if (ts_scaled - ref_scaled != (uint32_t)(int32_t)(int16_t)delta_sn) {
+        // The TS is no longer inferred from the SN. Repeat it in case the first UOR-2 is lost
+        ctx.nof_repeat = nof_uor2_repetitions;
+      }
+      if (not f.m and ctx.nof_repeat == 0 and lsb_fits(ref.sn, f.sn, 4, 1, 0xffff)) {
+        type = uo0;
+      } else if (lsb_fits(ref.sn, f.sn, 6, 1, 0xffff) and lsb_fits(ref_scaled, ts_scaled, 5, 7, 0xffffffff)) {
+        type           = uor2;
+        ctx.nof_repeat = ctx.nof_repeat > 0 ? ctx.nof_repeat - 1 : 0;
+      } else {
+        ctx.nof_ir = nof_ir_repetitions;
+      }
+    }
+  }
+
+  uint32_t n = 0;
+  if (type == ir) {
+    // Update the context with the fields sent in the dynamic chain
+    if (rtp and not on_stride) {
+      uint32_t stride = f.ts - ref.ts;
+      ctx.ts_stride   = (ctx.active and delta_sn == 1 and stride <= max_ts_stride) ? stride : 0;
+      ctx.ts_offset   = ctx.ts_stride != 0 ? f.ts % ctx.ts_stride : 0;
+    }
+    ctx.rnd          = ctx.active and (uint16_t)(f.ip_id - ref.ip_id) != delta_sn;
+    ctx.ip_id_offset = f.ip_id - f.sn;
+    ctx.nof_ir       = ctx.nof_ir > 0 ? ctx.nof_ir - 1 : 0;
+    ctx.nof_repeat   = 0;
+    ctx.since_ir     = 0;
+    n                = write_ir(cid, ctx, f, out);
+  } else {
+    if (cid != 0) {
+      out[n++] = 0xe0 | cid;
+    }
+    // The CRC covers the original headers
+    if (type == uo0) {
+      out[n++] = ((f.sn & 0x0f) << 3) | rohc_crc3(orig_hdr, orig_len);
+    } else {
+      out[n++] = 0xc0 | (ts_scaled & 0x1f);
+      out[n++] = (f.m ? 0x80 : 0) | (f.sn & 0x3f);
+      out[n++] = rohc_crc7(orig_hdr, orig_len);
+    }
+    if (ctx.rnd) {
+      n += put_u16(&out[n], f.ip_id);
+    }
+    if (f.udp_csum != 0) {
+      n += put_u16(&out[n], f.udp_csum);
+    }
+  }
+
+  ctx.active   = true;
+  ctx.ref      = f;
+  ctx.last_use = ++nof_compressed;
+  ctx.since_ir++;
+  return n;
+}
+
+// IR packet with the static and dynamic chains (RFC 3095 5.7.7 and 5.7.7.3-5.7.7.6)
+uint32_t pdcp_rohc::write_ir(uint32_t cid, const rohc_context_t& ctx, const rohc_fields_t& f, uint8_t* out)
+{
+  bool     rtp = ctx.profile == rohc_profile_t::rtp;
+  uint32_t n   = 0;
+  if (cid != 0) {
+    out[n++] = 0xe0 | cid;
+  }
+  out[n++]         = 0xfd;
+  out[n++]         = (uint8_t)ctx.profile;
+  uint32_t crc_pos = n;
+  out[n++]         = 0;
+
+  // Static chain
+  out[n++] = 0x40;
+  out[n++] = 17;
+  n += put_u32(&out[n], f.saddr);
+  n += put_u32(&out[n], f.daddr);
+  n += put_u16(&out[n], f.sport);
+  n += put_u16(&out[n], f.dport);
+  if (rtp) {
+    n += put_u32(&out[n], f.ssrc);
+  }
+
+  // Dynamic chain, with the IP-ID in network byte order and no extension headers or CSRCs
+  out[n++] = f.tos;
+  out[n++] = f.ttl;
+  n += put_u16(&out[n], f.ip_id);
+  out[n++] = (f.df ? 0x80 : 0) | (ctx.rnd ? 0x40 : 0) | 0x20;
+  out[n++] = 0;
+  n += put_u16(&out[n], f.udp_csum);
+  if (rtp) {
+    bool rx  = ctx.ts_stride != 0;
+    out[n++] = (f.rtp_flags & 0xef) | (rx ? 0x10 : 0);
+    out[n++] = (f.m ? 0x80 : 0) | f.pt;
+    n += put_u16(&out[n], f.sn);
+    n += put_u32(&out[n], f.ts);
+    out[n++] = 0;
+    if (rx) {
+      // Mode U, with the TS_STRIDE
+      out[n++] = 0x05;
+      n += write_sdvl(&out[n], ctx.ts_stride);
+    }
+  } else {
+    n += put_u16(&out[n], f.sn);
+  }
+
+  out[crc_pos] = rohc_crc8(out, n, crc_pos);
+  return n;
+}
+
+/****************************************************************************
+ * Decompressor
+ ***************************************************************************/
+
+bool pdcp_rohc::decompress(byte_buffer_t* pdu)
+{
+  const uint8_t* pkt   = pdu->msg;
+  uint32_t       len   = pdu->N_bytes;
+  uint32_t       start = 0;
+  while (start < len and pkt[start] == 0xe0) {
+    // Padding
+    start++;
+  }
+  uint32_t pos = start;
+  uint32_t cid = 0;
+  if (pos < len and (pkt[pos] & 0xf0) == 0xe0) {
+    cid = pkt[pos++] & 0x0f;
+  }
+  if (pos >= len) {
+    logger.warning("Dropping ROHC packet without header");
+    return false;
+  }
+  if (cid > cfg.max_cid) {
+    logger.warning("Dropping ROHC packet with CID=%d, larger than MAX_CID=%d", cid, cfg.max_cid);
+    return false;
+  }
+
+  rohc_context_t& ctx     = rx_contexts[cid];
+  uint8_t         type    = pkt[pos];
+  uint8_t         hdr[max_hdr_len];
+  uint32_t        hdr_len  = 0;
+  uint32_t        rohc_len = 0;
+  if ((type & 0xfe) == 0xfc) {
+    if (not decompress_ir(cid, &pkt[start], len - start, hdr, hdr_len, rohc_len)) {
+      return false;
+    }
+    rohc_len += start;
+  } else if ((type & 0xe0) == 0xe0) {
+    // Feedback, IR-DYN and segments are not used by the U-mode compressor
+    logger.warning("Dropping unsupported ROHC packet type 0x%x, CID=%d", type, cid);
+    return false;
+  } else if (not ctx.active) {
+    logger.warning("Dropping ROHC packet of CID=%d without context", cid);
+    return false;
+  } else if (ctx.profile == rohc_profile_t::uncompressed) {
+    // Normal packet
+    rohc_len = pos;
+  } else if (not decompress_uo(ctx, &pkt[pos], len - pos, hdr, hdr_len, rohc_len)) {
+    logger.warning("Dropping ROHC packet of CID=%d that could not be decompressed", cid);
+    return false;
+  } else {
+    rohc_len += pos;
+  }
+
+  return replace_header(pdu, rohc_len, hdr, hdr_len);
+}
+
+bool pdcp_rohc::decompress_ir(uint32_t       cid,
+                              const uint8_t* pkt,
+                              uint32_t       len,
+                              uint8_t*       hdr,
+                              uint32_t&      hdr_len,
+                              uint32_t&      rohc_len)
+{
+  uint32_t n = cid != 0 ? 1 : 0;
+  if (len < n + 3) {
+    logger.warning("Dropping truncated ROHC IR packet");
+    return false;
+  }
+  bool           has_dyn = (pkt[n] & 0x01) != 0;
+  rohc_profile_t profile = (rohc_profile_t)pkt[n + 1];
+  uint32_t       crc_pos = n + 2;
+  n += 3;
+
+  rohc_context_t ctx = {};
+  rohc_fields_t& f   = ctx.ref;
+  ctx.profile        = profile;
+  if (profile == rohc_profile_t::uncompressed) {
+    if (rohc_crc8(pkt, n, crc_pos) != pkt[crc_pos]) {
+      logger.warning("Dropping ROHC IR packet of CID=%d with wrong CRC", cid);
+      return false;
+    }
+    ctx.active       = true;
+    rx_contexts[cid] = ctx;
+    hdr_len          = 0;
+    rohc_len         = n;
+    return true;
+  }
+
+  bool rtp = profile == rohc_profile_t::rtp;
+  if (not has_dyn or (rtp and not cfg.profile_rtp) or (profile == rohc_profile_t::udp and not cfg.profile_udp) or
+      (not rtp and profile != rohc_profile_t::udp)) {
+    logger.warning("Dropping ROHC IR packet of CID=%d with unsupported profile 0x%x", cid, (uint8_t)profile);
+    return false;
+  }
+
+  // Static and dynamic chains, up to the end of the fixed size part of the RTP dynamic chain
+  uint32_t min_len = n + 10 + 4 + 6 + 2 + (rtp ? 4 + 10 : 2);
+  if (len < min_len or pkt[n] != 0x40 or pkt[n + 1] != 17) {
+    logger.warning("Dropping ROHC IR packet of CID=%d with unsupported static chain", cid);
+    return false;
+  }
+  f.saddr = get_u32(&pkt[n + 2]);
+  f.daddr = get_u32(&pkt[n + 6]);
+  f.sport = get_u16(&pkt[n + 10]);
+  f.dport = get_u16(&pkt[n + 12]);
+  n += 14;
+  if (rtp) {
+    f.ssrc = get_u32(&pkt[n]);
+    n += 4;
+  }
+
+  f.tos   = pkt[n];
+  f.ttl   = pkt[n + 1];
+  f.ip_id = get_u16(&pkt[n + 2]);
+  f.df    = (pkt[n + 4] & 0x80) != 0;
+  ctx.rnd = (pkt[n + 4] & 0x40) != 0;
+  if ((pkt[n + 4] & 0x20) == 0 or pkt[n + 5] != 0) {
+    logger.warning("Dropping ROHC IR packet of CID=%d with unsupported IPv4 dynamic chain", cid);
+    return false;
+  }
+  f.udp_csum = get_u16(&pkt[n + 6]);
+  n += 8;
+
+  if (rtp) {
+    bool rx     = (pkt[n] & 0x10) != 0;
+    f.rtp_flags = pkt[n] & 0xef;
+    f.m         = (pkt[n + 1] & 0x80) != 0;
+    f.pt        = pkt[n + 1] & 0x7f;
+    f.sn        = get_u16(&pkt[n + 2]);
+    f.ts        = get_u32(&pkt[n + 4]);
+    if ((f.rtp_flags & 0xcf) != 0x80 or pkt[n + 8] != 0) {
+      logger.warning("Dropping ROHC IR packet of CID=%d with unsupported RTP dynamic chain", cid);
+      return false;
+    }
+    n += 9;
+    if (rx) {
+      // Only the TS_STRIDE is supported, without TIME_STRIDE or extension
+      uint32_t nof_bytes = 0;
+      if (n >= len or (pkt[n] & 0x1e) != 0x04 or (pkt[n] & 0x01) == 0 or
+          (nof_bytes = read_sdvl(&pkt[n + 1], len - n - 1, ctx.ts_stride)) == 0) {
+        logger.warning("Dropping ROHC IR packet of CID=%d with unsupported RTP flags", cid);
+        return false;
+      }
+      n += 1 + nof_bytes;
+    }
+  } else {
+    f.sn = get_u16(&pkt[n]);
+    n += 2;
+  }
+
+  if (rohc_crc8(pkt, n, crc_pos) != pkt[crc_pos]) {
+    logger.warning("Dropping ROHC IR packet of CID=%d with wrong CRC", cid);
+    return false;
+  }
+
+  ctx.active       = true;
+  ctx.ip_id_offset = f.ip_id - f.sn;
+  ctx.ts_offset    = ctx.ts_stride != 0 ? f.ts % ctx.ts_stride : 0;
+  rx_contexts[cid] = ctx;
+  hdr_len          = write_headers(profile, f, len - n, hdr);
+  rohc_len         = n;
+  return true;
+}
+
+// UO-0 and UOR-2 packets (RFC 3095 5.7.1 and 5.7.4), without extension
+bool pdcp_rohc::decompress_uo(rohc_context_t& ctx,
+                              const uint8_t*  pkt,
+                              uint32_t        len,
+                              uint8_t*        hdr,
+                              uint32_t&       hdr_len,
+                              uint32_t&       rohc_len)
+{
+  const rohc_fields_t& ref = ctx.ref;
+  rohc_fields_t        f   = ref;
+  bool                 rtp = ctx.profile == rohc_profile_t::rtp;
+  if (rtp and ctx.ts_stride == 0) {
+    return false;
+  }
+  uint32_t ref_scaled = rtp ? (ref.ts - ctx.ts_offset) / ctx.ts_stride : 0;
+  uint32_t ts_scaled  = 0;
+  uint8_t  crc        = 0;
+  bool     is_uo0     = (pkt[0] & 0x80) == 0;
+  uint32_t n          = 0;
+
+  if (is_uo0) {
+    f.sn      = lsb_decode(ref.sn, (pkt[0] >> 3) & 0x0f, 4, 1, 0xffff);
+    f.m       = false;
+    ts_scaled = ref_scaled + (int16_t)(uint16_t)(f.sn - ref.sn);
+    crc       = pkt[0] & 0x07;
+    n         = 1;
+  } else {
+    if ((pkt[0] & 0xe0) != 0xc0 or not rtp or len < 3 or (pkt[2] & 0x80) != 0) {
+      return false;
+    }
+    ts_scaled = lsb_decode(ref_scaled, pkt[0] & 0x1f, 5, 7, 0xffffffff);
+    f.m       = (pkt[1] & 0x80) != 0;
+    f.sn      = lsb_decode(ref.sn, pkt[1] & 0x3f, 6, 1, 0xffff);
+    crc       = pkt[2] & 0x7f;
+    n         = 3;
+  }
+  if (rtp) {
+    f.ts = ts_scaled * ctx.ts_stride + ctx.ts_offset;
+  }
+
+  uint32_t tail_len = (ctx.rnd ? 2 : 0) + (ref.udp_csum != 0 ? 2 : 0);
+  if (len < n + tail_len) {
+    return false;
+  }
+  if (ctx.rnd) {
+    f.ip_id = get_u16(&pkt[n]);
+    n += 2;
+  } else {
+    f.ip_id = f.sn + ctx.ip_id_offset;
+  }
+  if (ref.udp_csum != 0) {
+    f.udp_csum = get_u16(&pkt[n]);
+    n += 2;
+  }
+
+  hdr_len = write_headers(ctx.profile, f, len - n, hdr);
+  if (crc != (is_uo0 ? rohc_crc3(hdr, hdr_len) : rohc_crc7(hdr, hdr_len))) {
+    return false;
+  }
+  ctx.ref  = f;
+  rohc_len = n;
+  return true;
+}
+
+} // namespace srsran
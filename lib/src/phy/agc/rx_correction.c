@@ -0,0 +1,170 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include <complex.h>
+#include <math.h>
+#include <string.h>
+
+#include "srsran/phy/agc/rx_correction.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+
+int srsran_rx_correction_init(srsran_rx_correction_t* q, const srsran_rx_correction_cfg_t* cfg)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  memset(q, 0, sizeof(srsran_rx_correction_t));
+
+  if (cfg != NULL) {
+    q->cfg = *cfg;
+  }
+
+  if (!isnormal(q->cfg.alpha)) {
+    q->cfg.alpha = SRSRAN_RX_CORRECTION_DEFAULT_ALPHA;
+  }
+  if (!isnormal(q->cfg.agc_target)) {
+    q->cfg.agc_target = SRSRAN_RX_CORRECTION_DEFAULT_AGC_TARGET;
+  }
+  if (!isnormal(q->cfg.agc_alpha)) {
+    q->cfg.agc_alpha = SRSRAN_RX_CORRECTION_DEFAULT_AGC_ALPHA;
+  }
+  if (!isnormal(q->cfg.agc_max_gain_db)) {
+    q->cfg.agc_max_gain_db = SRSRAN_RX_CORRECTION_DEFAULT_AGC_MAX_GAIN;
+  }
+
+  if (q->cfg.alpha > 1.0f || q->cfg.agc_alpha > 1.0f || q->cfg.alpha < 0.0f || q->cfg.agc_alpha < 0.0f) {
+    ERROR("Invalid RX correction averaging coefficients (%f, %f)", q->cfg.alpha, q->cfg.agc_alpha);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  srsran_rx_correction_reset(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_rx_correction_reset(srsran_rx_correction_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+  q->isfirst = true;
+  q->mean    = 0.0f;
+  q->pwr     = 0.0f;
+  q->sqr     = 0.0f;
+  q->gain_db = 0.0f;
+}
+
+/* Widely linear transform z = a * x + b * conj(x) + c */
+static void rx_correction_apply(const cf_t* x, cf_t a, cf_t b, cf_t c, cf_t* z, uint32_t len)
+{
+  uint32_t i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  const simd_cf_t a_vec = srsran_simd_cf_set1(a);
+  const simd_cf_t b_vec = srsran_simd_cf_set1(b);
+  const simd_cf_t c_vec = srsran_simd_cf_set1(c);
+
+  for (; i + SRSRAN_SIMD_CF_SIZE < len + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t in  = srsran_simd_cfi_loadu(&x[i]);
+    simd_cf_t out = srsran_simd_cf_add(srsran_simd_cf_prod(a_vec, in), c_vec);
+    out           = srsran_simd_cf_add(out, srsran_simd_cf_prod(b_vec, srsran_simd_cf_conj(in)));
+    srsran_simd_cfi_storeu(&z[i], out);
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; i < len; i++) {
+    z[i] = a * x[i] + b * conjf(x[i]) + c;
+  }
+}
+
+void srsran_rx_correction_run(srsran_rx_correction_t* q, const cf_t* in, cf_t* out, uint32_t nsamples)
+{
+  if (q == NULL || in == NULL || out == NULL || nsamples == 0) {
+    return;
+  }
+
+  if (!q->cfg.dc_enable && !q->cfg.iq_enable && !q->cfg.agc_enable) {
+    if (in != out) {
+      srsran_vec_cf_copy(out, in, nsamples);
+    }
+    return;
+  }
+
+  // Update the moments with the block, the first block initialises them
+  cf_t  mean  = srsran_vec_acc_cc(in, nsamples) / (float)nsamples;
+  float pwr   = srsran_vec_avg_power_cf(in, nsamples);
+  cf_t  sqr   = srsran_vec_dot_prod_ccc(in, in, nsamples) / (float)nsamples;
+  float alpha = q->isfirst ? 1.0f : q->cfg.alpha;
+  q->mean += alpha * (mean - q->mean);
+  q->pwr += alpha * (pwr - q->pwr);
+  q->sqr += alpha * (sqr - q->sqr);
+
+  // Centre the moments around the DC that is going to be removed
+  cf_t  dc      = q->cfg.dc_enable ? q->mean : 0.0f;
+  float pwr_c   = q->pwr - (__real__ dc * __real__ dc + __imag__ dc * __imag__ dc);
+  cf_t  sqr_c   = q->sqr - dc * dc;
+  float pwr_i   = (pwr_c + __real__ sqr_c) / 2.0f; // E[I^2]
+  float pwr_q   = (pwr_c - __real__ sqr_c) / 2.0f; // E[Q^2]
+  float corr    = __imag__ sqr_c / 2.0f;           // E[IQ]
+  float pwr_out = pwr_c;                           // Output power with unitary gain
+
+  // The Q branch is orthogonalised against I and scaled to the I power:
+  //   Q' = g * (Q - k * I), with k = E[IQ] / E[I^2] and g = sqrt(E[I^2] / E[(Q - k * I)^2])
+  float k = 0.0f;
+  float g = 1.0f;
+  if (q->cfg.iq_enable && isnormal(pwr_i)) {
+    float pwr_q1 = pwr_q - corr * corr / pwr_i;
+    if (isnormal(pwr_q1) && pwr_q1 > 0.0f) {
+      k      = corr / pwr_i;
+      g      = sqrtf(pwr_i / pwr_q1);
+      pwr_out = 2.0f * pwr_i;
+    }
+  }
+
+  // Digital gain towards the target RMS
+  if (q->cfg.agc_enable && isnormal(pwr_out) && pwr_out > 0.0f) {
+    float target_db = srsran_convert_power_to_dB(q->cfg.agc_target * q->cfg.agc_target / pwr_out);
+    target_db       = SRSRAN_MAX(-q->cfg.agc_max_gain_db, SRSRAN_MIN(q->cfg.agc_max_gain_db, target_db));
+    q->gain_db += (q->isfirst ? 1.0f : q->cfg.agc_alpha) * (target_db - q->gain_db);
+  }
+  float gain = srsran_convert_dB_to_amplitude(q->gain_db);
+
+  q->isfirst = false;
+
+  // out = G * (I + j * g * (Q - k * I)) expressed over y = in - dc and conj(y)
+  cf_t a = gain / 2.0f * (1.0f + g - _Complex_I * g * k);
+  cf_t b = gain / 2.0f * (1.0f - g - _Complex_I * g * k);
+  cf_t c = -(a * dc + b * conjf(dc));
+
+  rx_correction_apply(in, a, b, c, out, nsamples);
+}
+
+float srsran_rx_correction_get_gain_db(const srsran_rx_correction_t* q)
+{
+  if (q == NULL) {
+    return 0.0f;
+  }
+  return q->gain_db;
+}
@@ -0,0 +1,152 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/phy/agc/rx_correction.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static uint32_t nof_samples = 1920;
+static uint32_t nof_blocks  = 100;
+static float    iq_gain     = 1.2f;  // Q to I amplitude ratio
+static float    iq_phase    = 10.0f; // Q phase error in degrees
+static float    dc_offset   = 0.05f; // Relative to the signal RMS
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nbgpd]\n", prog);
+  printf("\t-n Number of samples per block [Default %d]\n", nof_samples);
+  printf("\t-b Number of blocks [Default %d]\n", nof_blocks);
+  printf("\t-g IQ gain imbalance [Default %.2f]\n", iq_gain);
+  printf("\t-p IQ phase imbalance in degrees [Default %.1f]\n", iq_phase);
+  printf("\t-d DC offset relative to the signal RMS [Default %.2f]\n", dc_offset);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nbgpd")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_samples = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'b':
+        nof_blocks = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'g':
+        iq_gain = strtof(argv[optind], NULL);
+        break;
+      case 'p':
+        iq_phase = strtof(argv[optind], NULL);
+        break;
+      case 'd':
+        dc_offset = strtof(argv[optind], NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srsran_random_t        random_gen = srsran_random_init(0x1234);
+  srsran_rx_correction_t q          = {};
+  int                    ret        = SRSRAN_ERROR;
+  cf_t*                  tx         = srsran_vec_cf_malloc(nof_samples);
+  cf_t*                  rx         = srsran_vec_cf_malloc(nof_samples);
+  cf_t*                  err        = srsran_vec_cf_malloc(nof_samples);
+  if (!tx || !rx || !err) {
+    goto clean;
+  }
+
+  srsran_rx_correction_cfg_t cfg = {};
+  cfg.dc_enable                  = true;
+  cfg.iq_enable                  = true;
+  cfg.agc_enable                 = true;
+  if (srsran_rx_correction_init(&q, &cfg) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating RX correction");
+    goto clean;
+  }
+
+  // Weak front-end signal, far from the AGC target
+  float amplitude = 0.002f;
+  float phase     = iq_phase * (float)M_PI / 180.0f;
+  cf_t  dc        = amplitude * dc_offset * (1.0f + 0.5f * _Complex_I);
+
+  float evm_db  = 0.0f;
+  float rms_out = 0.0f;
+  for (uint32_t b = 0; b < nof_blocks; b++) {
+    // Proper signal, with uncorrelated I and Q of the same power
+    srsran_random_uniform_complex_dist_vector(random_gen, tx, nof_samples, -1.0f, +1.0f);
+
+    for (uint32_t i = 0; i < nof_samples; i++) {
+      // I / Q branches with amplitude and phase imbalance plus DC
+      float i_rx = __real__ tx[i];
+      float q_rx = iq_gain * (__imag__ tx[i] * cosf(phase) - __real__ tx[i] * sinf(phase));
+      rx[i]      = amplitude * (i_rx + _Complex_I * q_rx) + dc;
+    }
+
+    srsran_rx_correction_run(&q, rx, rx, nof_samples);
+
+    // Compare with the transmitted signal scaled by the digital and the front-end gain
+    float gain = srsran_convert_dB_to_amplitude(srsran_rx_correction_get_gain_db(&q)) * amplitude;
+    srsran_vec_sc_prod_cfc(tx, gain, tx, nof_samples);
+    srsran_vec_sub_ccc(rx, tx, err, nof_samples);
+    evm_db  = srsran_convert_power_to_dB(srsran_vec_avg_power_cf(err, nof_samples) /
+                                        srsran_vec_avg_power_cf(tx, nof_samples));
+    rms_out = sqrtf(srsran_vec_avg_power_cf(rx, nof_samples));
+  }
+
+  printf("Test iq_gain=%.2f; iq_phase=%.1f; dc=%.2f; gain=%.1f dB; rms=%.3f; error=%.1f dB; ",
+         iq_gain,
+         iq_phase,
+         dc_offset,
+         srsran_rx_correction_get_gain_db(&q),
+         rms_out,
+         evm_db);
+
+  // The residual impairments shall be 30 dB below the signal and the output shall reach the AGC target
+  float rms_err_db = srsran_convert_amplitude_to_dB(rms_out / SRSRAN_RX_CORRECTION_DEFAULT_AGC_TARGET);
+  if (evm_db > -30.0f || fabsf(rms_err_db) > 0.5f) {
+    printf("Failed\n");
+    goto clean;
+  }
+  printf("Passed\n");
+
+  ret = SRSRAN_SUCCESS;
+
+clean:
+  srsran_random_free(random_gen);
+  free(tx);
+  free(rx);
+  free(err);
+
+  return ret;
+}
@@ -21,6 +21,7 @@
 
 #include "srsran/phy/cfr/cfr.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 // Uncomment this to use a literal implementation of the CFR algorithm
@@ -29,7 +30,11 @@
 // Uncomment this to filter by zeroing the FFT bins instead of applying a frequency window
 #define CFR_LPF_WITH_ZEROS
 
+// Number of SIMD registers checked at once when looking for samples above the threshold
+#define CFR_PC_DETECT_BLOCK 4
+
 static inline float cfr_symb_peak(float* in_abs, int len);
+static void         cfr_peak_cancel(srsran_cfr_t* q, const cf_t* in, cf_t* out, float beta);
 
 void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
 {
@@ -77,7 +82,9 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
   }
 
   // Clipping algorithm
-  if (isnormal(beta)) {
+  if (isnormal(beta) && q->cfg.algo == SRSRAN_CFR_ALGO_PEAK_CANCEL) {
+    cfr_peak_cancel(q, in, out, beta);
+  } else if (isnormal(beta)) {
 #ifdef CFR_PEAK_EXTRACTION
     srsran_vec_cf_zero(q->peak_buffer, symbol_sz);
     cf_t clip_thr = 0;
@@ -150,6 +157,188 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
   }
 }
 
+/* Appends to q->peak_idx the largest sample of every run of consecutive samples above thr in [start, end) */
+static inline uint32_t cfr_detect_peaks_range(srsran_cfr_t* q,
+                                              const float*  in_abs,
+                                              float         thr,
+                                              uint32_t      start,
+                                              uint32_t      end,
+                                              uint32_t      nof_peaks,
+                                              bool*         in_peak)
+{
+  for (uint32_t i = start; i < end; i++) {
+    if (in_abs[i] > thr) {
+      if (!*in_peak) {
+        q->peak_idx[nof_peaks++] = i;
+        *in_peak                 = true;
+      } else if (in_abs[i] > in_abs[q->peak_idx[nof_peaks - 1]]) {
+        q->peak_idx[nof_peaks - 1] = i;
+      }
+    } else {
+      *in_peak = false;
+    }
+  }
+  return nof_peaks;
+}
+
+/* Finds the peaks of the symbol above thr, only the blocks with a sample above it are scanned one by one */
+static uint32_t cfr_detect_peaks(srsran_cfr_t* q, const float* in_abs, float thr)
+{
+  const uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t       nof_peaks = 0;
+  bool           in_peak   = false;
+  uint32_t       i         = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+  const uint32_t block = CFR_PC_DETECT_BLOCK * SRSRAN_SIMD_F_SIZE;
+  float          lanes[SRSRAN_SIMD_F_SIZE];
+  for (; i + block <= symbol_sz; i += block) {
+    simd_f_t _max = srsran_simd_f_load(&in_abs[i]);
+    for (uint32_t j = SRSRAN_SIMD_F_SIZE; j < block; j += SRSRAN_SIMD_F_SIZE) {
+      simd_f_t _x = srsran_simd_f_load(&in_abs[i + j]);
+      _max        = srsran_simd_f_select(_max, _x, srsran_simd_f_max(_x, _max));
+    }
+    srsran_simd_f_storeu(lanes, _max);
+
+    bool above = false;
+    for (uint32_t k = 0; k < SRSRAN_SIMD_F_SIZE; k++) {
+      above |= lanes[k] > thr;
+    }
+
+    if (above) {
+      nof_peaks = cfr_detect_peaks_range(q, in_abs, thr, i, i + block, nof_peaks, &in_peak);
+    } else {
+      in_peak = false;
+    }
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
+
+  return cfr_detect_peaks_range(q, in_abs, thr, i, symbol_sz, nof_peaks, &in_peak);
+}
+
+/* Subtracts the pulse weighted by coeff from len samples of out */
+static inline void cfr_sub_pulse(cf_t* out, const cf_t* pulse, cf_t coeff, uint32_t len)
+{
+  uint32_t i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t _c = srsran_simd_cf_set1(coeff);
+  for (; i + SRSRAN_SIMD_CF_SIZE <= len; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t _p = srsran_simd_cfi_loadu(&pulse[i]);
+    simd_cf_t _o = srsran_simd_cfi_loadu(&out[i]);
+    srsran_simd_cfi_storeu(&out[i], srsran_simd_cf_sub(_o, srsran_simd_cf_prod(_p, _c)));
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; i < len; i++) {
+    out[i] -= coeff * pulse[i];
+  }
+}
+
+/* Reduces every peak above beta by subtracting the cancellation pulse centred on it. The symbol is periodic, so the
+ * pulses wrap around its edges */
+static void cfr_peak_cancel(srsran_cfr_t* q, const cf_t* in, cf_t* out, float beta)
+{
+  const uint32_t symbol_sz = q->cfg.symbol_sz;
+  const uint32_t nof_iter  = q->cfg.pc_nof_iter ? q->cfg.pc_nof_iter : CFR_PC_DEFAULT_NOF_ITER;
+  float*         in_abs    = q->abs_buffer_in;
+
+  if (in != out) {
+    srsran_vec_cf_copy(out, in, symbol_sz);
+  }
+
+  for (uint32_t iter = 0; iter < nof_iter; iter++) {
+    // The absolute value of the input is already available for the first pass
+    if (iter > 0) {
+      srsran_vec_abs_cf(out, in_abs, symbol_sz);
+    }
+
+    uint32_t nof_peaks = cfr_detect_peaks(q, in_abs, beta);
+    if (nof_peaks == 0) {
+      break;
+    }
+
+    // Compute every weight before cancelling, as the pulses of nearby peaks overlap
+    for (uint32_t k = 0; k < nof_peaks; k++) {
+      uint32_t idx     = q->peak_idx[k];
+      q->peak_coeff[k] = q->cfg.alpha * (1.0f - beta / in_abs[idx]) * out[idx];
+    }
+
+    for (uint32_t k = 0; k < nof_peaks; k++) {
+      uint32_t start = (q->peak_idx[k] + symbol_sz - q->pc_pulse_offset) % symbol_sz;
+      uint32_t first = SRSRAN_MIN(q->pc_pulse_sz, symbol_sz - start);
+      cfr_sub_pulse(&out[start], q->pc_pulse, q->peak_coeff[k], first);
+      if (first < q->pc_pulse_sz) {
+        cfr_sub_pulse(out, &q->pc_pulse[first], q->peak_coeff[k], q->pc_pulse_sz - first);
+      }
+    }
+  }
+}
+
+/* Precomputes the cancellation pulse from the LPF impulse response, normalised to a unit peak. The whole symbol has
+ * no out of band emission, a shorter pulse is Hann windowed to limit its leakage */
+static int cfr_pc_init(srsran_cfr_t* q)
+{
+  const uint32_t symbol_sz = q->cfg.symbol_sz;
+  const uint32_t half_len  = q->cfg.pc_pulse_len;
+  const bool     truncated = half_len > 0 && 2 * half_len + 1 < symbol_sz;
+
+  q->pc_pulse_sz     = truncated ? 2 * half_len + 1 : symbol_sz;
+  q->pc_pulse_offset = truncated ? half_len : symbol_sz / 2;
+
+  if (q->pc_pulse) {
+    free(q->pc_pulse);
+  }
+  q->pc_pulse = srsran_vec_cf_malloc(q->pc_pulse_sz);
+  if (!q->pc_pulse) {
+    ERROR("Error allocating pc_pulse");
+    return SRSRAN_ERROR;
+  }
+
+  // There is at most one peak every two samples
+  if (q->peak_idx) {
+    free(q->peak_idx);
+  }
+  q->peak_idx = srsran_vec_u32_malloc(symbol_sz / 2 + 1);
+  if (!q->peak_idx) {
+    ERROR("Error allocating peak_idx");
+    return SRSRAN_ERROR;
+  }
+
+  if (q->peak_coeff) {
+    free(q->peak_coeff);
+  }
+  q->peak_coeff = srsran_vec_cf_malloc(symbol_sz / 2 + 1);
+  if (!q->peak_coeff) {
+    ERROR("Error allocating peak_coeff");
+    return SRSRAN_ERROR;
+  }
+
+  // Impulse response of the LPF, its peak is the first sample
+  for (uint32_t i = 0; i < symbol_sz; i++) {
+    q->peak_buffer[i] = q->lpf_spectrum[i];
+  }
+  srsran_dft_run_c(&q->ifft_plan, q->peak_buffer, q->peak_buffer);
+
+  if (!isnormal(__real__ q->peak_buffer[0])) {
+    ERROR("Invalid cancellation pulse");
+    return SRSRAN_ERROR;
+  }
+  cf_t norm = 1.0f / q->peak_buffer[0];
+
+  for (uint32_t i = 0; i < q->pc_pulse_sz; i++) {
+    float w = 1.0f;
+    if (truncated) {
+      w = 0.5f * (1.0f + cosf((float)M_PI * ((float)i - (float)half_len) / (float)(half_len + 1)));
+    }
+    q->pc_pulse[i] = w * norm * q->peak_buffer[(i + symbol_sz - q->pc_pulse_offset) % symbol_sz];
+  }
+
+  srsran_vec_cf_zero(q->peak_buffer, symbol_sz);
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
 {
   int ret = SRSRAN_ERROR;
@@ -166,6 +355,10 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
     ERROR("Error, invalid CFR mode");
     goto clean_exit;
   }
+  if (cfg->algo >= SRSRAN_CFR_ALGO_INVALID) {
+    ERROR("Error, invalid CFR algorithm");
+    goto clean_exit;
+  }
   if (cfg->cfr_mode == SRSRAN_CFR_THR_MANUAL && cfg->manual_thr <= 0) {
     ERROR("Error, invalid configuration for manual threshold");
     goto clean_exit;
@@ -289,6 +482,10 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
   srsran_dft_plan_set_norm(&q->fft_plan, true);
   srsran_dft_plan_set_norm(&q->ifft_plan, true);
 
+  if (q->cfg.algo == SRSRAN_CFR_ALGO_PEAK_CANCEL && cfr_pc_init(q) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
   srsran_vec_cf_zero(q->peak_buffer, q->cfg.symbol_sz);
   srsran_vec_f_zero(q->abs_buffer_in, q->cfg.symbol_sz);
   srsran_vec_f_zero(q->abs_buffer_out, q->cfg.symbol_sz);
@@ -318,6 +515,15 @@ void srsran_cfr_free(srsran_cfr_t* q)
     if (q->lpf_spectrum) {
       free(q->lpf_spectrum);
     }
+    if (q->pc_pulse) {
+      free(q->pc_pulse);
+    }
+    if (q->peak_idx) {
+      free(q->peak_idx);
+    }
+    if (q->peak_coeff) {
+      free(q->peak_coeff);
+    }
     SRSRAN_MEM_ZERO(q, srsran_cfr_t, 1);
   }
 }
@@ -337,6 +543,9 @@ bool srsran_cfr_params_valid(srsran_cfr_cfg_t* cfr_conf)
   if (cfr_conf->cfr_mode == SRSRAN_CFR_THR_INVALID) {
     return false;
   }
+  if (cfr_conf->algo >= SRSRAN_CFR_ALGO_INVALID) {
+    return false;
+  }
   if (cfr_conf->alpha < 0 || cfr_conf->alpha > 1) {
     return false;
   }
@@ -400,3 +609,20 @@ srsran_cfr_mode_t srsran_cfr_str2mode(const char* mode_str)
   }
   return ret;
 }
+
+srsran_cfr_algo_t srsran_cfr_str2algo(const char* algo_str)
+{
+  srsran_cfr_algo_t ret;
+  if (strcmp(algo_str, "")) {
+    if (!strcmp(algo_str, "clip_filter")) {
+      ret = SRSRAN_CFR_ALGO_CLIP_FILTER;
+    } else if (!strcmp(algo_str, "peak_cancel")) {
+      ret = SRSRAN_CFR_ALGO_PEAK_CANCEL;
+    } else {
+      ret = SRSRAN_CFR_ALGO_INVALID; // algo_str is not recognised
+    }
+  } else {
+    ret = SRSRAN_CFR_ALGO_CLIP_FILTER; // algo_str is empty, keep the default algorithm
+  }
+  return ret;
+}
@@ -33,6 +33,7 @@
 
 // Default CFR type
 static char* cfr_mode_str = "manual";
+static char* cfr_algo_str = "clip_filter";
 
 static int               nof_prb         = -1;
 static srsran_cp_t       cp              = SRSRAN_CP_NORM;
@@ -44,6 +45,8 @@ static bool              dc_empty        = true;
 static float             thr_manual      = 1.5f;
 static float             max_papr_db     = 8.0f;
 static float             ema_alpha       = (float)1 / (float)SRSRAN_CP_NORM_NSYMB;
+static uint32_t          pc_pulse_len    = 0;
+static float             min_acpr_att_db = -MAX_ACPR_DB;
 
 static uint32_t force_symbol_sz = 0;
 static double   elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
@@ -71,12 +74,15 @@ static void usage(char* prog)
   printf("\t-t CFR manual threshold: [Default %.2f]\n", thr_manual);
   printf("\t-p CFR Max PAPR in dB (auto modes): [Default %.2f]\n", max_papr_db);
   printf("\t-E Power avg EMA alpha (EMA mode): [Default %.2f]\n", ema_alpha);
+  printf("\t-P CFR algorithm: clip_filter, peak_cancel [Default %s]\n", cfr_algo_str);
+  printf("\t-L Peak cancellation pulse half length, 0 for the whole symbol: [Default %d]\n", pc_pulse_len);
+  printf("\t-A Minimum output ACPR attenuation in dB: [Default %.1f]\n", min_acpr_att_db);
 }
 
 static int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "NnerfmatdpE")) != -1) {
+  while ((opt = getopt(argc, argv, "NnerfmatdpEPLA")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -111,6 +117,15 @@ static int parse_args(int argc, char** argv)
       case 'E':
         ema_alpha = strtof(argv[optind], NULL);
         break;
+      case 'P':
+        cfr_algo_str = argv[optind];
+        break;
+      case 'L':
+        pc_pulse_len = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'A':
+        min_acpr_att_db = strtof(argv[optind], NULL);
+        break;
       default:
         usage(argv[0]);
         return SRSRAN_ERROR;
@@ -151,6 +166,12 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
+  srsran_cfr_algo_t cfr_algo = srsran_cfr_str2algo(cfr_algo_str);
+  if (cfr_algo == SRSRAN_CFR_ALGO_INVALID) {
+    ERROR("CFR algorithm is not recognised");
+    goto clean_exit;
+  }
+
   if (nof_prb == -1) {
     nof_prb = 6;
     max_prb = SRSRAN_MAX_PRB;
@@ -192,6 +213,8 @@ int main(int argc, char** argv)
     cfr_tx_cfg.manual_thr       = thr_manual;
     cfr_tx_cfg.ema_alpha        = ema_alpha;
     cfr_tx_cfg.dc_sc            = dc_empty;
+    cfr_tx_cfg.algo             = cfr_algo;
+    cfr_tx_cfg.pc_pulse_len     = pc_pulse_len;
 
     if (!srsran_cfr_params_valid(&cfr_tx_cfg)) {
       ERROR("Invalid CFR configuration");
@@ -284,7 +307,7 @@ int main(int argc, char** argv)
     acpr_buff = NULL;
 
     ++nof_prb;
-    if (acpr_out_dB > MAX_ACPR_DB) {
+    if (acpr_out_dB > -min_acpr_att_db) {
       printf("ACPR too large \n");
       goto clean_exit;
     }
@@ -282,8 +282,9 @@ int srsran_chest_dl_set_cell(srsran_chest_dl_t* q, srsran_cell_t cell)
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
   if (q != NULL && srsran_cell_isvalid(&cell)) {
     if (q->cell.id != cell.id || q->cell.nof_prb == 0) {
-      q->cell = cell;
-      ret     = srsran_refsignal_cs_set_cell(&q->csr_refs, cell);
+      q->cell      = cell;
+      q->meas_init = false;
+      ret          = srsran_refsignal_cs_set_cell(&q->csr_refs, cell);
       if (ret != SRSRAN_SUCCESS) {
         ERROR("Error initializing CSR signal (%d)", ret);
         return SRSRAN_ERROR;
@@ -321,8 +322,33 @@ int srsran_chest_dl_set_cell(srsran_chest_dl_t* q, srsran_cell_t cell)
   return ret;
 }
 
-/* Uses the difference between the averaged and non-averaged pilot estimates */
-static float estimate_noise_pilots(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* sf, uint32_t port_id)
+/* Measurements done in a subframe, only the subset ones are averaged */
+typedef enum {
+  CHEST_DL_MEAS_FULL = 0,
+  CHEST_DL_MEAS_SUBSET,
+  CHEST_DL_MEAS_SKIP,
+} chest_dl_meas_t;
+
+static chest_dl_meas_t chest_dl_meas_mode(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_chest_dl_cfg_t* cfg)
+{
+  if (cfg->meas_period == 0 || cfg->meas_full || !q->meas_init || sf->sf_type == SRSRAN_SF_MBSFN) {
+    return CHEST_DL_MEAS_FULL;
+  }
+  return (sf->tti % cfg->meas_period == 0) ? CHEST_DL_MEAS_SUBSET : CHEST_DL_MEAS_SKIP;
+}
+
+static void chest_dl_meas_set(srsran_chest_dl_cfg_t* cfg, chest_dl_meas_t mode, float* meas, float value)
+{
+  if (mode == CHEST_DL_MEAS_SUBSET) {
+    *meas = SRSRAN_VEC_SAFE_EMA(value, *meas, cfg->meas_ema_coeff);
+  } else if (mode == CHEST_DL_MEAS_FULL) {
+    *meas = value;
+  }
+}
+
+/* Uses the difference between the averaged and non-averaged pilot estimates, the subset only uses one of the pilot
+ * symbols with both neighbours */
+static float estimate_noise_pilots(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* sf, uint32_t port_id, bool subset)
 {
   srsran_sf_t ch_mode   = sf->sf_type;
   const float weight    = 1.0f;
@@ -360,7 +386,9 @@ static float estimate_noise_pilots(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* sf,
   }
 
   // Compares surrounding pilots in time/frequency. It requires at least 3 symbols with pilots.
-  for (int i = 1; i < nsymbols - 1; i++) {
+  uint32_t i_start = subset ? 1 + q->meas_count % (nsymbols - 2) : 1;
+  uint32_t i_end   = subset ? i_start + 1 : nsymbols - 1;
+  for (int i = i_start; i < i_end; i++) {
     // Calculate previous and next symbol indexes offset
     uint32_t offset = ((fidx < 3) ^ (i & 1)) ? 0 : 1;
 
@@ -599,17 +627,19 @@ static void average_pilots(srsran_chest_dl_t*     q,
   }
 }
 
-static float chest_dl_rssi(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* sf, cf_t* input, uint32_t port_id)
+static float chest_dl_rssi(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* sf, cf_t* input, uint32_t port_id, bool subset)
 {
   uint32_t l;
 
   float    rssi     = 0;
   uint32_t nsymbols = srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id);
-  for (l = 0; l < nsymbols; l++) {
+  uint32_t l_start  = subset ? q->meas_count % nsymbols : 0;
+  uint32_t l_end    = subset ? l_start + 1 : nsymbols;
+  for (l = l_start; l < l_end; l++) {
     cf_t* tmp = &input[srsran_refsignal_cs_nsymbol(l, q->cell.cp, port_id) * q->cell.nof_prb * SRSRAN_NRE];
     rssi += srsran_vec_dot_prod_conj_ccc(tmp, tmp, q->cell.nof_prb * SRSRAN_NRE);
   }
-  return rssi / nsymbols;
+  return rssi / (l_end - l_start);
 }
 
 // CFO estimation algorithm taken from "Carrier Frequency Synchronization in the
@@ -642,6 +672,7 @@ static float chest_estimate_cfo(srsran_chest_dl_t* q)
 static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
                                         srsran_dl_sf_cfg_t*    sf,
                                         srsran_chest_dl_cfg_t* cfg,
+                                        chest_dl_meas_t        meas,
                                         cf_t*                  input,
                                         cf_t*                  ce,
                                         uint32_t               port_id,
@@ -662,7 +693,10 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
       ERROR("Warning: REFS noise estimation algorithm not supported in MBSFN subframes");
     }
 
-    q->noise_estimate[rxant_id][port_id] = estimate_noise_pilots(q, sf, port_id);
+    if (meas != CHEST_DL_MEAS_SKIP) {
+      float noise = estimate_noise_pilots(q, sf, port_id, meas == CHEST_DL_MEAS_SUBSET);
+      chest_dl_meas_set(cfg, meas, &q->noise_estimate[rxant_id][port_id], noise);
+    }
   }
 
   if (q->wiener_dl && ch_mode == SRSRAN_SF_NORM && cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_WIENER) {
@@ -806,6 +840,7 @@ chest_dl_estimate_correct_sync_error(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* s
 static int estimate_port(srsran_chest_dl_t*     q,
                          srsran_dl_sf_cfg_t*    sf,
                          srsran_chest_dl_cfg_t* cfg,
+                         chest_dl_meas_t        meas,
                          cf_t*                  input,
                          cf_t*                  ce,
                          uint32_t               port_id,
@@ -821,14 +856,18 @@ static int estimate_port(srsran_chest_dl_t*     q,
       q->pilot_recv_signal, q->csr_refs.pilots[port_id / 2][sf->tti % 10], q->pilot_estimates, npilots);
 
   /* Compute RSRP for the channel estimates in this port */
-  if (cfg->rsrp_neighbour) {
-    double energy                   = cabsf(srsran_vec_acc_cc(q->pilot_estimates, npilots) / npilots);
-    q->rsrp_corr[rxant_id][port_id] = energy * energy;
+  if (meas != CHEST_DL_MEAS_SKIP) {
+    if (cfg->rsrp_neighbour) {
+      double energy = cabsf(srsran_vec_acc_cc(q->pilot_estimates, npilots) / npilots);
+      chest_dl_meas_set(cfg, meas, &q->rsrp_corr[rxant_id][port_id], energy * energy);
+    }
+    float rsrp = srsran_vec_avg_power_cf(q->pilot_recv_signal, npilots);
+    float rssi = chest_dl_rssi(q, sf, input, port_id, meas == CHEST_DL_MEAS_SUBSET);
+    chest_dl_meas_set(cfg, meas, &q->rsrp[rxant_id][port_id], rsrp);
+    chest_dl_meas_set(cfg, meas, &q->rssi[rxant_id][port_id], rssi);
   }
-  q->rsrp[rxant_id][port_id] = srsran_vec_avg_power_cf(q->pilot_recv_signal, npilots);
-  q->rssi[rxant_id][port_id] = chest_dl_rssi(q, sf, input, port_id);
 
-  chest_interpolate_noise_est(q, sf, cfg, input, ce, port_id, rxant_id);
+  chest_interpolate_noise_est(q, sf, cfg, meas, input, ce, port_id, rxant_id);
 
   return 0;
 }
@@ -859,7 +898,7 @@ static int estimate_port_mbsfn(srsran_chest_dl_t*     q,
                            &q->pilot_estimates[(2 * q->cell.nof_prb)],
                            SRSRAN_REFSIGNAL_NUM_SF_MBSFN(q->cell.nof_prb, port_id) - (2 * q->cell.nof_prb));
 
-  chest_interpolate_noise_est(q, sf, cfg, input, ce, port_id, rxant_id);
+  chest_interpolate_noise_est(q, sf, cfg, CHEST_DL_MEAS_FULL, input, ce, port_id, rxant_id);
 
   return 0;
 }
@@ -1002,6 +1041,8 @@ int srsran_chest_dl_estimate_cfg(srsran_chest_dl_t*     q,
                                  cf_t*                  input[SRSRAN_MAX_PORTS],
                                  srsran_chest_dl_res_t* res)
 {
+  chest_dl_meas_t meas = chest_dl_meas_mode(q, sf, cfg);
+
   for (uint32_t rxant_id = 0; rxant_id < q->nof_rx_antennas; rxant_id++) {
     // Estimate and correct synchronization error if enabled
     if (cfg->sync_error_enable) {
@@ -1014,12 +1055,16 @@ int srsran_chest_dl_estimate_cfg(srsran_chest_dl_t*     q,
           return SRSRAN_ERROR;
         }
       } else {
-        if (estimate_port(q, sf, cfg, input[rxant_id], res->ce[port_id][rxant_id], port_id, rxant_id)) {
+        if (estimate_port(q, sf, cfg, meas, input[rxant_id], res->ce[port_id][rxant_id], port_id, rxant_id)) {
           return SRSRAN_ERROR;
         }
       }
     }
   }
+  q->meas_init = true;
+  if (meas == CHEST_DL_MEAS_SUBSET) {
+    q->meas_count++;
+  }
 
   fill_res(q, res);
 
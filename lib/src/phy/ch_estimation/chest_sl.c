@@ -441,9 +441,8 @@ static void interpolate_pilots_sl_pscch(srsran_chest_sl_t* q)
 static void chest_sl_pscch_ls_estimate(srsran_chest_sl_t* q, cf_t* sf_buffer)
 {
   // Get Pilot Estimates
-  // Use the known DMRS signal to compute least-squares estimates
-  srsran_vec_cf_zero(q->ce, q->sf_n_re);
-
+  // Use the known DMRS signal to compute least-squares estimates. Only the candidate band is written and read back,
+  // so the rest of the subframe is left untouched when scanning a full resource pool.
   uint32_t dmrs_idx = 0;
   for (uint32_t i = 0; i < srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp); i++) {
     if (srsran_pscch_is_symbol(SRSRAN_SIDELINK_DMRS_SYMBOL, q->cell.tm, i, q->cell.cp)) {
@@ -812,7 +811,6 @@ static void chest_sl_pssch_ls_estimate(srsran_chest_sl_t* q, cf_t* sf_buffer)
   int      dmrs_idx = 0;
   uint32_t k        = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
 
-  srsran_vec_cf_zero(q->ce, q->sf_n_re);
   for (int i = 0; i < srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp); i++) {
     if (srsran_pssch_is_symbol(SRSRAN_SIDELINK_DMRS_SYMBOL, q->cell.tm, i, q->cell.cp)) {
       if (q->cell.tm == SRSRAN_SIDELINK_TM1 || q->cell.tm == SRSRAN_SIDELINK_TM2) {
@@ -883,6 +881,45 @@ static void get_subband_noise(srsran_chest_sl_t* q, uint32_t k_start, uint32_t k
   }
 }
 
+/* Subcarrier bands [k_start, k_end) occupied by the current allocation. A PSSCH in transmission mode 1 and 2 may be
+ * split between the two ends of the resource pool.
+ */
+static uint32_t chest_sl_get_bands(srsran_chest_sl_t* q, uint32_t k_start[2], uint32_t k_end[2])
+{
+  switch (q->channel) {
+    case SRSRAN_SIDELINK_PSBCH:
+      k_start[0] = q->cell.nof_prb * SRSRAN_NRE / 2 - 36;
+      k_end[0]   = k_start[0] + q->M_sc_rs;
+      return 1;
+    case SRSRAN_SIDELINK_PSCCH:
+      k_start[0] = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
+      k_end[0]   = k_start[0] + q->M_sc_rs;
+      return 1;
+    case SRSRAN_SIDELINK_PSSCH:
+      if ((q->cell.tm == SRSRAN_SIDELINK_TM1 || q->cell.tm == SRSRAN_SIDELINK_TM2) &&
+          q->chest_sl_cfg.nof_prb > q->sl_comm_resource_pool.prb_num) {
+        // First band
+        k_start[0] = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
+        k_end[0]   = k_start[0] + q->sl_comm_resource_pool.prb_num * SRSRAN_NRE;
+
+        // Second band
+        if ((q->sl_comm_resource_pool.prb_num * 2) >
+            (q->sl_comm_resource_pool.prb_end - q->sl_comm_resource_pool.prb_start + 1)) {
+          k_start[1] = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num + 1) * SRSRAN_NRE;
+        } else {
+          k_start[1] = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
+        }
+        k_end[1] = k_start[1] + (q->chest_sl_cfg.nof_prb - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
+        return 2;
+      }
+      k_start[0] = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
+      k_end[0]   = (q->chest_sl_cfg.nof_prb + q->chest_sl_cfg.prb_start_idx) * SRSRAN_NRE;
+      return 1;
+    default:
+      return 0;
+  }
+}
+
 float srsran_chest_sl_estimate_noise(srsran_chest_sl_t* q)
 {
   uint32_t sf_nsymbols = srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp);
@@ -891,54 +928,22 @@ float srsran_chest_sl_estimate_noise(srsran_chest_sl_t* q)
     return SRSRAN_ERROR;
   }
 
-  srsran_vec_cf_zero(q->ce_average, q->sf_n_re);
-  q->noise_estimated = 0.0;
-
-  uint32_t k_start = 0;
-  uint32_t k_end   = 0;
+  uint32_t k_start[2] = {};
+  uint32_t k_end[2]   = {};
+  uint32_t nof_bands  = chest_sl_get_bands(q, k_start, k_end);
+  if (nof_bands == 0) {
+    ERROR("Invalid Sidelink channel");
+    return SRSRAN_ERROR;
+  }
 
-  switch (q->channel) {
-    case SRSRAN_SIDELINK_PSBCH:
-      k_start = q->cell.nof_prb * SRSRAN_NRE / 2 - 36;
-      k_end   = k_start + q->M_sc_rs;
-      get_subband_noise(q, k_start, k_end, sf_nsymbols);
-      break;
-    case SRSRAN_SIDELINK_PSCCH:
-      k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-      k_end   = k_start + q->M_sc_rs;
-      get_subband_noise(q, k_start, k_end, sf_nsymbols);
-      break;
-    case SRSRAN_SIDELINK_PSSCH:
-      if (q->cell.tm == SRSRAN_SIDELINK_TM1 || q->cell.tm == SRSRAN_SIDELINK_TM2) {
-        if (q->chest_sl_cfg.nof_prb <= q->sl_comm_resource_pool.prb_num) {
-          k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-          k_end   = (q->chest_sl_cfg.nof_prb + q->chest_sl_cfg.prb_start_idx) * SRSRAN_NRE;
-          get_subband_noise(q, k_start, k_end, sf_nsymbols);
-        } else {
-          // First band
-          k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-          k_end   = k_start + q->sl_comm_resource_pool.prb_num * SRSRAN_NRE;
-          get_subband_noise(q, k_start, k_end, sf_nsymbols);
+  // The PSBCH is equalized over the whole subframe, the other channels only inside the allocated bands
+  if (q->channel == SRSRAN_SIDELINK_PSBCH) {
+    srsran_vec_cf_zero(q->ce_average, q->sf_n_re);
+  }
 
-          // Second band
-          if ((q->sl_comm_resource_pool.prb_num * 2) >
-              (q->sl_comm_resource_pool.prb_end - q->sl_comm_resource_pool.prb_start + 1)) {
-            k_start = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num + 1) * SRSRAN_NRE;
-          } else {
-            k_start = (q->sl_comm_resource_pool.prb_end + 1 - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
-          }
-          k_end = k_start + (q->chest_sl_cfg.nof_prb - q->sl_comm_resource_pool.prb_num) * SRSRAN_NRE;
-          get_subband_noise(q, k_start, k_end, sf_nsymbols);
-        }
-      } else if (q->cell.tm == SRSRAN_SIDELINK_TM3 || q->cell.tm == SRSRAN_SIDELINK_TM4) {
-        k_start = q->chest_sl_cfg.prb_start_idx * SRSRAN_NRE;
-        k_end   = (q->chest_sl_cfg.nof_prb + q->chest_sl_cfg.prb_start_idx) * SRSRAN_NRE;
-        get_subband_noise(q, k_start, k_end, sf_nsymbols);
-      }
-      break;
-    default:
-      ERROR("Invalid Sidelink channel");
-      return SRSRAN_ERROR;
+  q->noise_estimated = 0.0;
+  for (uint32_t b = 0; b < nof_bands; b++) {
+    get_subband_noise(q, k_start[b], k_end[b], sf_nsymbols);
   }
   q->noise_estimated = q->noise_estimated / (float)sf_nsymbols;
   return q->noise_estimated;
@@ -1046,7 +1051,8 @@ int srsran_chest_sl_set_cell(srsran_chest_sl_t* q, srsran_cell_sl_t cell)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
   if (q != NULL) {
-    q->cell = cell;
+    q->cell             = cell;
+    q->pssch_dmrs_valid = false;
     if (q->channel == SRSRAN_SIDELINK_PSBCH) {
       if (chest_sl_psbch_gen(q) != SRSRAN_SUCCESS) {
         return SRSRAN_ERROR;
@@ -1057,16 +1063,34 @@ int srsran_chest_sl_set_cell(srsran_chest_sl_t* q, srsran_cell_sl_t cell)
   return ret;
 }
 
+// The PSSCH DMRS depend on N_x_id, the allocation length and, in transmission mode 3 and 4, the subframe index
+static bool chest_sl_pssch_dmrs_is_cached(srsran_chest_sl_t* q)
+{
+  const srsran_chest_sl_cfg_t* a = &q->pssch_dmrs_cfg;
+  const srsran_chest_sl_cfg_t* b = &q->chest_sl_cfg;
+
+  if (!q->pssch_dmrs_valid || a->N_x_id != b->N_x_id || a->nof_prb != b->nof_prb) {
+    return false;
+  }
+  if (q->cell.tm >= SRSRAN_SIDELINK_TM3 && (a->sf_idx % 10) != (b->sf_idx % 10)) {
+    return false;
+  }
+  return true;
+}
+
 int srsran_chest_sl_set_cfg(srsran_chest_sl_t* q, srsran_chest_sl_cfg_t chest_sl_cfg)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
   if (q != NULL) {
     q->chest_sl_cfg = chest_sl_cfg;
 
-    if (q->channel == SRSRAN_SIDELINK_PSSCH) {
+    if (q->channel == SRSRAN_SIDELINK_PSSCH && !chest_sl_pssch_dmrs_is_cached(q)) {
       if (chest_sl_pssch_gen(q) != SRSRAN_SUCCESS) {
+        q->pssch_dmrs_valid = false;
         return SRSRAN_ERROR;
       }
+      q->pssch_dmrs_valid = true;
+      q->pssch_dmrs_cfg   = chest_sl_cfg;
     }
     ret = SRSRAN_SUCCESS;
   }
@@ -1129,8 +1153,30 @@ void srsran_chest_sl_ls_equalize(srsran_chest_sl_t* q, cf_t* sf_buffer, cf_t* eq
 {
   srsran_chest_sl_estimate_noise(q);
 
-  // Perform channel equalization
-  srsran_predecoding_single(sf_buffer, q->ce_average, equalized_sf_buffer, NULL, q->sf_n_re, 1.0, q->noise_estimated);
+  // The PSBCH band is not PRB aligned, so it is equalized in a single pass over the subframe
+  if (q->channel == SRSRAN_SIDELINK_PSBCH) {
+    srsran_predecoding_single(sf_buffer, q->ce_average, equalized_sf_buffer, NULL, q->sf_n_re, 1.0, q->noise_estimated);
+    return;
+  }
+
+  // Perform channel equalization on the allocated bands only, so the cost of a PSCCH candidate does not scale with the
+  // cell bandwidth. Bands start at a PRB boundary, which keeps the SIMD equalizer aligned.
+  uint32_t sf_nsymbols = srsran_sl_get_num_symbols(q->cell.tm, q->cell.cp);
+  uint32_t k_start[2]  = {};
+  uint32_t k_end[2]    = {};
+  uint32_t nof_bands   = chest_sl_get_bands(q, k_start, k_end);
+  for (uint32_t l = 0; l < sf_nsymbols; l++) {
+    for (uint32_t b = 0; b < nof_bands; b++) {
+      uint32_t re_idx = k_start[b] + l * q->cell.nof_prb * SRSRAN_NRE;
+      srsran_predecoding_single(&sf_buffer[re_idx],
+                                &q->ce_average[re_idx],
+                                &equalized_sf_buffer[re_idx],
+                                NULL,
+                                k_end[b] - k_start[b],
+                                1.0,
+                                q->noise_estimated);
+    }
+  }
 }
 
 void srsran_chest_sl_ls_estimate_equalize(srsran_chest_sl_t* q, cf_t* sf_buffer, cf_t* equalized_sf_buffer)
@@ -40,6 +40,9 @@
 #define MAX_REFS_SYM (max_prb * SRSRAN_NRE)
 #define MAX_REFS_SF (max_prb * SRSRAN_NRE * 2) // 2 reference symbols per subframe
 
+// Delay spread assumed by the Wiener filter, the cyclic prefix length
+#define WIENER_DELAY_SPREAD_S(CP) (SRSRAN_CP_ISNORM(CP) ? 4.69e-6 : 16.67e-6)
+
 /** 3GPP LTE Downlink channel estimator and equalizer.
  * Estimates the channel in the resource elements transmitting references and interpolates for the rest
  * of the resource grid.
@@ -65,13 +68,6 @@ int srsran_chest_ul_init(srsran_chest_ul_t* q, uint32_t max_prb)
       perror("malloc");
       goto clean_exit;
     }
-    for (int i = 0; i < 4; i++) {
-      q->pilot_estimates_tmp[i] = srsran_vec_cf_malloc(MAX_REFS_SF);
-      if (!q->pilot_estimates_tmp[i]) {
-        perror("malloc");
-        goto clean_exit;
-      }
-    }
     q->pilot_recv_signal = srsran_vec_cf_malloc(MAX_REFS_SF + 1);
     if (!q->pilot_recv_signal) {
       perror("malloc");
@@ -121,11 +117,6 @@ void srsran_chest_ul_free(srsran_chest_ul_t* q)
   if (q->pilot_estimates) {
     free(q->pilot_estimates);
   }
-  for (int i = 0; i < 4; i++) {
-    if (q->pilot_estimates_tmp[i]) {
-      free(q->pilot_estimates_tmp[i]);
-    }
-  }
   if (q->pilot_recv_signal) {
     free(q->pilot_recv_signal);
   }
@@ -161,6 +152,77 @@ void srsran_chest_ul_res_free(srsran_chest_ul_res_t* q)
   }
 }
 
+/* Solves the symmetric positive definite system A * x = b, of size n, in place with a Cholesky decomposition. A is
+ * stored row-major and its lower triangle is overwritten with the Cholesky factor */
+static void wiener_cholesky_solve(double* A, double* b, uint32_t n)
+{
+  for (uint32_t j = 0; j < n; j++) {
+    double d = A[j * n + j];
+    for (uint32_t k = 0; k < j; k++) {
+      d -= A[j * n + k] * A[j * n + k];
+    }
+    A[j * n + j] = sqrt(d);
+    for (uint32_t i = j + 1; i < n; i++) {
+      double v = A[i * n + j];
+      for (uint32_t k = 0; k < j; k++) {
+        v -= A[i * n + k] * A[j * n + k];
+      }
+      A[i * n + j] = v / A[j * n + j];
+    }
+  }
+
+  // Forward and backward substitution
+  for (uint32_t i = 0; i < n; i++) {
+    for (uint32_t k = 0; k < i; k++) {
+      b[i] -= A[i * n + k] * b[k];
+    }
+    b[i] /= A[i * n + i];
+  }
+  for (int i = (int)n - 1; i >= 0; i--) {
+    for (uint32_t k = i + 1; k < n; k++) {
+      b[i] -= A[k * n + i] * b[k];
+    }
+    b[i] /= A[i * n + i];
+  }
+}
+
+/* Computes the Wiener filters of every SNR bin for a uniform power delay profile spanning the cyclic prefix, which
+ * gives the real frequency correlation r(k) = sinc(k * df * tau) between sub-carriers k apart */
+static void wiener_filter_gen(srsran_chest_ul_t* q)
+{
+  const uint32_t M   = SRSRAN_CHEST_UL_WIENER_HALF_LEN;
+  double         tau = WIENER_DELAY_SPREAD_S(q->cell.cp) * 15e3;
+  double         r[SRSRAN_CHEST_UL_WIENER_LEN];
+  double         A[SRSRAN_CHEST_UL_WIENER_LEN * SRSRAN_CHEST_UL_WIENER_LEN];
+  double         b[SRSRAN_CHEST_UL_WIENER_LEN];
+
+  for (uint32_t k = 0; k < SRSRAN_CHEST_UL_WIENER_LEN; k++) {
+    double x = M_PI * k * tau;
+    r[k]     = (k == 0) ? 1.0 : sin(x) / x;
+  }
+
+  for (uint32_t bin = 0; bin < SRSRAN_CHEST_UL_WIENER_NOF_SNR_BINS; bin++) {
+    int    snr_db = SRSRAN_CHEST_UL_WIENER_SNR_MIN_DB + (int)bin * SRSRAN_CHEST_UL_WIENER_SNR_STEP_DB;
+    double noise  = pow(10.0, -snr_db / 10.0);
+
+    // The sub-carrier at distance p from the edge is filtered with the p sub-carriers before it and the M after it
+    for (uint32_t p = 0; p <= M; p++) {
+      uint32_t n = p + M + 1;
+      for (uint32_t i = 0; i < n; i++) {
+        for (uint32_t j = 0; j < n; j++) {
+          A[i * n + j] = r[abs((int)i - (int)j)] + ((i == j) ? noise : 0.0);
+        }
+        b[i] = r[abs((int)i - (int)p)];
+      }
+      wiener_cholesky_solve(A, b, n);
+
+      for (uint32_t i = 0; i < SRSRAN_CHEST_UL_WIENER_LEN; i++) {
+        q->wiener_filter[bin][p][i] = (i < n) ? (float)b[i] : 0.0f;
+      }
+    }
+  }
+}
+
 int srsran_chest_ul_set_cell(srsran_chest_ul_t* q, srsran_cell_t cell)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -177,6 +239,8 @@ int srsran_chest_ul_set_cell(srsran_chest_ul_t* q, srsran_cell_t cell)
         ERROR("Error initializing vector interpolator");
         return SRSRAN_ERROR;
       }
+
+      wiener_filter_gen(q);
     }
     ret = SRSRAN_SUCCESS;
   }
@@ -275,6 +339,52 @@ average_pilots(srsran_chest_ul_t* q, cf_t* input, cf_t* ce, uint32_t nslots, uin
   }
 }
 
+/* Filters the estimates of each slot with the Wiener filter of the measured SNR. The inner sub-carriers are filtered
+ * one tap at a time over the whole allocation, the sub-carriers closer than HALF_LEN to the edges use the truncated
+ * filters, mirrored at the upper edge */
+static void wiener_pilots(srsran_chest_ul_t* q,
+                          cf_t*              input,
+                          cf_t*              ce,
+                          uint32_t           nslots,
+                          uint32_t           nrefs,
+                          uint32_t           n_prb[2],
+                          float              snr)
+{
+  const uint32_t M = SRSRAN_CHEST_UL_WIENER_HALF_LEN;
+
+  // A noiseless or unmeasured SNR selects the highest bin
+  int bin = SRSRAN_CHEST_UL_WIENER_NOF_SNR_BINS - 1;
+  if (isfinite(snr)) {
+    float snr_db = srsran_convert_power_to_dB(SRSRAN_MAX(snr, FLT_MIN));
+    bin          = (int)roundf((snr_db - SRSRAN_CHEST_UL_WIENER_SNR_MIN_DB) / SRSRAN_CHEST_UL_WIENER_SNR_STEP_DB);
+    bin          = SRSRAN_MAX(0, SRSRAN_MIN(bin, SRSRAN_CHEST_UL_WIENER_NOF_SNR_BINS - 1));
+  }
+
+  const float* inner = q->wiener_filter[bin][M];
+  for (uint32_t i = 0; i < nslots; i++) {
+    cf_t* x = &input[i * nrefs];
+    cf_t* y = &ce[SRSRAN_REFSIGNAL_UL_L(i, q->cell.cp) * q->cell.nof_prb * SRSRAN_NRE + n_prb[i] * SRSRAN_NRE];
+
+    srsran_vec_sc_prod_cfc(x, inner[0], &y[M], nrefs - 2 * M);
+    for (uint32_t k = 1; k < SRSRAN_CHEST_UL_WIENER_LEN; k++) {
+      srsran_vec_sc_prod_cfc(&x[k], inner[k], q->tmp_noise, nrefs - 2 * M);
+      srsran_vec_sum_ccc(q->tmp_noise, &y[M], &y[M], nrefs - 2 * M);
+    }
+
+    for (uint32_t p = 0; p < M; p++) {
+      const float* w  = q->wiener_filter[bin][p];
+      cf_t         lo = 0.0f;
+      cf_t         hi = 0.0f;
+      for (uint32_t k = 0; k < p + M + 1; k++) {
+        lo += x[k] * w[k];
+        hi += x[nrefs - 1 - k] * w[k];
+      }
+      y[p]             = lo;
+      y[nrefs - 1 - p] = hi;
+    }
+  }
+}
+
 /**
  * Generic PUSCH and DMRS channel estimation. It assumes q->pilot_estimates has been populated with the Least Square
  * Estimates
@@ -284,6 +394,7 @@ average_pilots(srsran_chest_ul_t* q, cf_t* input, cf_t* ce, uint32_t nslots, uin
  * @param nrefs_sym number of reference resource elements per symbols (depends on configuration)
  * @param stride sub-carrier distance between reference signal resource elements (1 for DMRS, 2 for SRS)
  * @param meas_ta_en enables or disables the Time Alignment error measurement
+ * @param wiener_en filters the estimates with the Wiener filter of the measured SNR after the noise is estimated
  * @param write_estimates Write channel estimation in res, (true for DMRS and false for SRS)
  * @param n_prb Resource block start for the grant, set to zero for Sounding Reference Signals
  * @param res UL channel estimation result
@@ -293,6 +404,7 @@ static void chest_ul_estimate(srsran_chest_ul_t*     q,
                               uint32_t               nrefs_sym,
                               uint32_t               stride,
                               bool                   meas_ta_en,
+                              bool                   wiener_en,
                               bool                   write_estimates,
                               uint32_t               n_prb[SRSRAN_NOF_SLOTS_PER_SF],
                               srsran_chest_ul_res_t* res)
@@ -334,12 +446,18 @@ static void chest_ul_estimate(srsran_chest_ul_t*     q,
     if (q->smooth_filter_len > 0) {
       average_pilots(q, q->pilot_estimates, res->ce, nslots, nrefs_sym, n_prb);
 
+      // If averaging, compute noise from difference between received and averaged estimates
+      res->noise_estimate = estimate_noise_pilots(q, res->ce, nslots, nrefs_sym, n_prb);
+
+      // Replace the 3-tap estimates by the Wiener ones, the noise is still measured with the calibrated 3-tap filter
+      if (wiener_en) {
+        float epre = srsran_vec_avg_power_cf(q->pilot_recv_signal, nslots * nrefs_sym);
+        wiener_pilots(q, q->pilot_estimates, res->ce, nslots, nrefs_sym, n_prb, epre / res->noise_estimate - 1.0f);
+      }
+
       if (write_estimates) {
         interpolate_pilots(q, res->ce, nslots, nrefs_sym, n_prb);
       }
-
-      // If averaging, compute noise from difference between received and averaged estimates
-      res->noise_estimate = estimate_noise_pilots(q, res->ce, nslots, nrefs_sym, n_prb);
     } else {
       // Copy estimates to CE vector without averaging
       for (int i = 0; i < nslots; i++) {
@@ -412,7 +530,8 @@ int srsran_chest_ul_estimate_pusch(srsran_chest_ul_t*     q,
                            nrefs_sf);
 
   // Estimate
-  chest_ul_estimate(q, SRSRAN_NOF_SLOTS_PER_SF, nrefs_sym, 1, cfg->meas_ta_en, true, cfg->grant.n_prb, res);
+  chest_ul_estimate(
+      q, SRSRAN_NOF_SLOTS_PER_SF, nrefs_sym, 1, cfg->meas_ta_en, cfg->chest_wiener_en, true, cfg->grant.n_prb, res);
 
   return 0;
 }
@@ -472,18 +591,36 @@ int srsran_chest_ul_estimate_pucch(srsran_chest_ul_t*     q,
       m = 4;
     }
 
+    // The ACK bits only modulate the second DMRS symbol of each slot, so the estimates are computed once for d(10) = 1
+    // and every hypothesis is evaluated from the sums of the unmodulated and the modulated symbols
+    cfg->pucch2_drs_bits[0] = 0;
+    cfg->pucch2_drs_bits[1] = 0;
+    srsran_refsignal_dmrs_pucch_gen(&q->dmrs_signal, sf, cfg, q->pilot_known_signal);
+    srsran_vec_prod_conj_ccc(q->pilot_recv_signal, q->pilot_known_signal, q->pilot_estimates, nrefs_sf);
+
+    cf_t acc_fixed = 0.0f;
+    cf_t acc_mod   = 0.0f;
+    for (int ns = 0; ns < SRSRAN_NOF_SLOTS_PER_SF; ns++) {
+      acc_fixed += srsran_vec_acc_cc(&q->pilot_estimates[ns * n_rs * SRSRAN_NRE], SRSRAN_NRE);
+      acc_mod += srsran_vec_acc_cc(&q->pilot_estimates[(ns * n_rs + 1) * SRSRAN_NRE], SRSRAN_NRE);
+    }
+
+    cf_t z_max = 1.0f;
     for (int i = 0; i < m; i++) {
-      cfg->pucch2_drs_bits[0] = i % 2;
-      cfg->pucch2_drs_bits[1] = i / 2;
-      srsran_refsignal_dmrs_pucch_gen(&q->dmrs_signal, sf, cfg, q->pilot_known_signal);
-      srsran_vec_prod_conj_ccc(q->pilot_recv_signal, q->pilot_known_signal, q->pilot_estimates_tmp[i], nrefs_sf);
-      float x = cabsf(srsran_vec_acc_cc(q->pilot_estimates_tmp[i], nrefs_sf));
+      uint8_t drs_bits[2] = {i % 2, i / 2};
+      cf_t    z_m_1       = 1.0f;
+      srsran_pucch_format2ab_mod_bits(cfg->format, drs_bits, &z_m_1);
+      float x = cabsf(acc_fixed + conjf(z_m_1) * acc_mod);
       if (x >= max) {
         max   = x;
         i_max = i;
+        z_max = z_m_1;
       }
     }
-    memcpy(q->pilot_estimates, q->pilot_estimates_tmp[i_max], nrefs_sf * sizeof(cf_t));
+    for (int ns = 0; ns < SRSRAN_NOF_SLOTS_PER_SF; ns++) {
+      cf_t* ce_mod = &q->pilot_estimates[(ns * n_rs + 1) * SRSRAN_NRE];
+      srsran_vec_sc_prod_ccc(ce_mod, conjf(z_max), ce_mod, SRSRAN_NRE);
+    }
     cfg->pucch2_drs_bits[0] = i_max % 2;
     cfg->pucch2_drs_bits[1] = i_max / 2;
 
@@ -620,7 +757,7 @@ int srsran_chest_ul_estimate_srs(srsran_chest_ul_t*                 q,
 
   // Estimate
   uint32_t n_prb[2] = {};
-  chest_ul_estimate(q, 1, n_srs_re, 1, true, false, n_prb, res);
+  chest_ul_estimate(q, 1, n_srs_re, 1, true, false, false, n_prb, res);
 
   return SRSRAN_SUCCESS;
 }
@@ -0,0 +1,357 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <strings.h>
+
+#include "srsran/phy/ch_estimation/chest_ul_srs_batch.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+// Number of comb subcarriers despread into one channel sample. A cyclic shift is a phase ramp of period 8 along the
+// comb, so the sum of 8 consecutive subcarriers cancels the UEs of the other cyclic shifts.
+#define SRS_DESPREAD_LEN SRSRAN_SRS_NOF_CSHIFT
+
+// Subcarrier spacing between two despread channel samples, the comb takes every other subcarrier
+#define SRS_DESPREAD_STRIDE (2 * SRS_DESPREAD_LEN)
+
+int srsran_chest_ul_srs_batch_init(srsran_chest_ul_srs_batch_t* q, uint32_t max_ues)
+{
+  if (q == NULL || max_ues == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  bzero(q, sizeof(srsran_chest_ul_srs_batch_t));
+
+  q->max_ues  = max_ues;
+  q->max_M_sc = SRSRAN_MAX_PRB * SRSRAN_NRE / 2;
+
+  q->k0   = srsran_vec_u32_malloc(max_ues);
+  q->M_sc = srsran_vec_u32_malloc(max_ues);
+  q->done = SRSRAN_MEM_ALLOC(bool, max_ues);
+  q->recv = srsran_vec_cf_malloc(q->max_M_sc);
+  q->base = srsran_vec_cf_malloc(2 * q->max_M_sc);
+  q->y    = srsran_vec_cf_malloc(q->max_M_sc);
+  q->z    = srsran_vec_cf_malloc(q->max_M_sc);
+  if (!q->k0 || !q->M_sc || !q->done || !q->recv || !q->base || !q->y || !q->z) {
+    srsran_chest_ul_srs_batch_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t cs = 0; cs < SRSRAN_SRS_NOF_CSHIFT; cs++) {
+    q->ramp[cs] = srsran_vec_cf_malloc(q->max_M_sc);
+    q->H[cs]    = srsran_vec_cf_malloc(q->max_M_sc / SRS_DESPREAD_LEN);
+    if (!q->ramp[cs] || !q->H[cs]) {
+      srsran_chest_ul_srs_batch_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    // Removes the cyclic shift alpha = 2 * pi * cs / 8 of 36.211 Sec. 5.5.3.1
+    for (uint32_t n = 0; n < q->max_M_sc; n++) {
+      q->ramp[cs][n] = cexpf(-I * 2.0f * (float)M_PI * (float)((cs * n) % SRSRAN_SRS_NOF_CSHIFT) / 8.0f);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_chest_ul_srs_batch_free(srsran_chest_ul_srs_batch_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+  if (q->k0) {
+    free(q->k0);
+  }
+  if (q->M_sc) {
+    free(q->M_sc);
+  }
+  if (q->done) {
+    free(q->done);
+  }
+  if (q->recv) {
+    free(q->recv);
+  }
+  if (q->base) {
+    free(q->base);
+  }
+  if (q->y) {
+    free(q->y);
+  }
+  if (q->z) {
+    free(q->z);
+  }
+  for (uint32_t cs = 0; cs < SRSRAN_SRS_NOF_CSHIFT; cs++) {
+    if (q->ramp[cs]) {
+      free(q->ramp[cs]);
+    }
+    if (q->H[cs]) {
+      free(q->H[cs]);
+    }
+  }
+  bzero(q, sizeof(srsran_chest_ul_srs_batch_t));
+}
+
+int srsran_chest_ul_srs_batch_set_cell(srsran_chest_ul_srs_batch_t* q, srsran_cell_t cell)
+{
+  if (q == NULL || !srsran_cell_isvalid(&cell)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (cell.id != q->cell.id || q->cell.nof_prb == 0) {
+    q->cell = cell;
+    if (srsran_refsignal_ul_set_cell(&q->signal, cell) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// Inverts the n x n hermitian matrix a into a_inv by Gauss-Jordan elimination. Returns false if it is singular
+static bool srs_batch_invert(cf_t a[SRSRAN_SRS_NOF_CSHIFT][SRSRAN_SRS_NOF_CSHIFT],
+                             cf_t a_inv[SRSRAN_SRS_NOF_CSHIFT][SRSRAN_SRS_NOF_CSHIFT],
+                             uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++) {
+    for (uint32_t j = 0; j < n; j++) {
+      a_inv[i][j] = (i == j) ? 1.0f : 0.0f;
+    }
+  }
+
+  for (uint32_t col = 0; col < n; col++) {
+    // Partial pivoting
+    uint32_t pivot = col;
+    for (uint32_t i = col + 1; i < n; i++) {
+      if (cabsf(a[i][col]) > cabsf(a[pivot][col])) {
+        pivot = i;
+      }
+    }
+    if (!isnormal(cabsf(a[pivot][col]))) {
+      return false;
+    }
+    for (uint32_t j = 0; j < n; j++) {
+      cf_t tmp        = a[col][j];
+      a[col][j]       = a[pivot][j];
+      a[pivot][j]     = tmp;
+      tmp             = a_inv[col][j];
+      a_inv[col][j]   = a_inv[pivot][j];
+      a_inv[pivot][j] = tmp;
+    }
+
+    cf_t norm = 1.0f / a[col][col];
+    for (uint32_t j = 0; j < n; j++) {
+      a[col][j] *= norm;
+      a_inv[col][j] *= norm;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+      if (i != col) {
+        cf_t factor = a[i][col];
+        for (uint32_t j = 0; j < n; j++) {
+          a[i][j] -= factor * a[col][j];
+          a_inv[i][j] -= factor * a_inv[col][j];
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Measures the group of UEs that share the SRS resource of UE idx, which has not been measured yet
+static int srs_batch_estimate_group(srsran_chest_ul_srs_batch_t*       q,
+                                    srsran_ul_sf_cfg_t*                sf,
+                                    srsran_refsignal_srs_cfg_t*        cfg,
+                                    uint32_t                           nof_ues,
+                                    uint32_t                           idx,
+                                    srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
+                                    cf_t*                              input,
+                                    srsran_chest_ul_srs_meas_t*        meas)
+{
+  uint32_t M_sc        = q->M_sc[idx];
+  uint32_t nof_samples = M_sc / SRS_DESPREAD_LEN;
+
+  // Extract the comb once for all the UEs of the group
+  if (srsran_refsignal_srs_get(&q->signal, &cfg[idx], sf->tti, q->recv, input) != SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // All the UEs of the group share the base sequence, they only differ in the cyclic shift
+  srsran_refsignal_srs_cfg_t base_cfg = cfg[idx];
+  base_cfg.n_srs                      = 0;
+  if (srsran_refsignal_srs_gen(&q->signal, &base_cfg, pusch_cfg, sf->tti % SRSRAN_NOF_SF_X_FRAME, q->base) !=
+      SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  srsran_vec_prod_conj_ccc(q->recv, q->base, q->y, M_sc);
+
+  // Cyclic shifts used in the group
+  uint32_t cs_list[SRSRAN_SRS_NOF_CSHIFT] = {};
+  uint32_t nof_cs                         = 0;
+  for (uint32_t j = idx; j < nof_ues; j++) {
+    if (q->done[j] || q->k0[j] != q->k0[idx] || q->M_sc[j] != M_sc) {
+      continue;
+    }
+    uint32_t cs    = cfg[j].n_srs % SRSRAN_SRS_NOF_CSHIFT;
+    bool     found = false;
+    for (uint32_t u = 0; u < nof_cs; u++) {
+      found |= (cs_list[u] == cs);
+    }
+    if (!found) {
+      cs_list[nof_cs++] = cs;
+    }
+  }
+
+  // First pass, the sum of 8 subcarriers after removing the cyclic shift gives a coarse channel sample whose phase
+  // slope is the time misalignment of the UE
+  cf_t  w[SRSRAN_SRS_NOF_CSHIFT][SRS_DESPREAD_LEN] = {};
+  float slope[SRSRAN_SRS_NOF_CSHIFT]               = {};
+  for (uint32_t u = 0; u < nof_cs; u++) {
+    cf_t* H = q->H[cs_list[u]];
+    srsran_vec_prod_ccc(q->y, q->ramp[cs_list[u]], q->z, M_sc);
+    for (uint32_t i = 0; i < nof_samples; i++) {
+      H[i] = srsran_vec_acc_cc(&q->z[i * SRS_DESPREAD_LEN], SRS_DESPREAD_LEN);
+    }
+    slope[u] = (nof_samples > 1) ? srsran_vec_estimate_frequency(H, nof_samples) / SRS_DESPREAD_LEN : 0.0f;
+    if (!isnormal(slope[u])) {
+      slope[u] = 0.0f;
+    }
+
+    // Conjugated signature of the UE within a block, cyclic shift and time misalignment. The estimated frequency is
+    // the phase progression with opposite sign.
+    for (uint32_t n = 0; n < SRS_DESPREAD_LEN; n++) {
+      w[u][n] = q->ramp[cs_list[u]][n] * cexpf(I * 2.0f * (float)M_PI * slope[u] * (float)n);
+    }
+  }
+
+  // With a time misalignment the signatures are no longer orthogonal, so the UEs leak into each other and into the
+  // unused cyclic shifts. Fit all the UEs of the group jointly in each block by least squares instead.
+  cf_t gram[SRSRAN_SRS_NOF_CSHIFT][SRSRAN_SRS_NOF_CSHIFT]     = {};
+  cf_t gram_inv[SRSRAN_SRS_NOF_CSHIFT][SRSRAN_SRS_NOF_CSHIFT] = {};
+  for (uint32_t u = 0; u < nof_cs; u++) {
+    for (uint32_t v = 0; v < nof_cs; v++) {
+      gram[u][v] = srsran_vec_dot_prod_conj_ccc(w[u], w[v], SRS_DESPREAD_LEN);
+    }
+  }
+  if (!srs_batch_invert(gram, gram_inv, nof_cs)) {
+    return SRSRAN_ERROR;
+  }
+
+  float residual = 0.0f;
+  for (uint32_t i = 0; i < nof_samples; i++) {
+    const cf_t* y_b                      = &q->y[i * SRS_DESPREAD_LEN];
+    cf_t        h[SRSRAN_SRS_NOF_CSHIFT] = {};
+    for (uint32_t u = 0; u < nof_cs; u++) {
+      h[u] = srsran_vec_dot_prod_ccc(y_b, w[u], SRS_DESPREAD_LEN);
+    }
+
+    // The channel of each UE in the block replaces its coarse sample, the projection leaves the noise as residual
+    float fitted = 0.0f;
+    for (uint32_t u = 0; u < nof_cs; u++) {
+      cf_t c = 0.0f;
+      for (uint32_t v = 0; v < nof_cs; v++) {
+        c += gram_inv[u][v] * h[v];
+      }
+      q->H[cs_list[u]][i] = c;
+      fitted += crealf(conjf(h[u]) * c);
+    }
+    residual += SRS_DESPREAD_LEN * srsran_vec_avg_power_cf(y_b, SRS_DESPREAD_LEN) - fitted;
+  }
+
+  // Noise power per subcarrier. When the eight cyclic shifts are in use, there is no degree of freedom left in the
+  // block, so the noise is taken from the difference between consecutive channel samples instead.
+  float noise_power = INFINITY;
+  if (nof_cs < SRSRAN_SRS_NOF_CSHIFT) {
+    noise_power = residual / (float)(nof_samples * (SRS_DESPREAD_LEN - nof_cs));
+  } else {
+    for (uint32_t u = 0; u < nof_cs && nof_samples > 1; u++) {
+      cf_t* H        = q->H[cs_list[u]];
+      cf_t  rotation = cexpf(-I * 2.0f * (float)M_PI * slope[u] * SRS_DESPREAD_LEN);
+      srsran_vec_sc_prod_ccc(H, rotation, q->z, nof_samples - 1);
+      srsran_vec_sub_ccc(&H[1], q->z, q->z, nof_samples - 1);
+      noise_power = SRSRAN_MIN(noise_power,
+                               srsran_vec_avg_power_cf(q->z, nof_samples - 1) / (2.0f * crealf(gram_inv[u][u])));
+    }
+  }
+  if (!isnormal(noise_power)) {
+    noise_power = FLT_MIN;
+  }
+
+  for (uint32_t j = idx; j < nof_ues; j++) {
+    if (q->done[j] || q->k0[j] != q->k0[idx] || q->M_sc[j] != M_sc) {
+      continue;
+    }
+    uint32_t u = 0;
+    while (cs_list[u] != cfg[j].n_srs % SRSRAN_SRS_NOF_CSHIFT) {
+      u++;
+    }
+    cf_t* H = q->H[cs_list[u]];
+
+    // The fitted channel is per subcarrier, remove the noise that leaks into it
+    float signal_power = srsran_vec_avg_power_cf(H, nof_samples) - noise_power * crealf(gram_inv[u][u]);
+    meas[j].snr_db     = srsran_convert_power_to_dB(SRSRAN_MAX(signal_power / noise_power, FLT_MIN));
+
+    // Time alignment error from the phase slope between channel samples, rounded to one tenth of micro-second
+    float ta_err = 0.0f;
+    if (nof_samples > 1) {
+      ta_err = srsran_vec_estimate_frequency(H, nof_samples) / SRS_DESPREAD_STRIDE / 15e3f * 1e6f;
+    }
+    meas[j].ta_us = isnormal(ta_err) ? roundf(ta_err * 10.0f) / 10.0f : 0.0f;
+
+    q->done[j] = true;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_chest_ul_srs_batch_estimate(srsran_chest_ul_srs_batch_t*       q,
+                                       srsran_ul_sf_cfg_t*                sf,
+                                       srsran_refsignal_srs_cfg_t*        cfg,
+                                       uint32_t                           nof_ues,
+                                       srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
+                                       cf_t*                              input,
+                                       srsran_chest_ul_srs_meas_t*        meas)
+{
+  if (q == NULL || sf == NULL || cfg == NULL || pusch_cfg == NULL || input == NULL || meas == NULL ||
+      nof_ues > q->max_ues) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    q->k0[i]   = srsran_refsignal_srs_k0(&q->signal, &cfg[i], sf->tti);
+    q->M_sc[i] = srsran_refsignal_srs_M_sc(&q->signal, &cfg[i]);
+    q->done[i] = false;
+    if (q->M_sc[i] == 0 || q->M_sc[i] > q->max_M_sc || q->M_sc[i] % SRS_DESPREAD_LEN != 0) {
+      ERROR("Invalid SRS bandwidth of %d subcarriers", q->M_sc[i]);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    if (q->done[i]) {
+      continue;
+    }
+    if (srs_batch_estimate_group(q, sf, cfg, nof_ues, i, pusch_cfg, input, meas) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
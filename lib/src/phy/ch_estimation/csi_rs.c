@@ -26,6 +26,11 @@
 #include <complex.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif /* LV_HAVE_AVX2 */
 
 /**
  * @brief Maximum number of subcarriers occupied by a CSI-RS resource as defined in TS 38.211 Table 7.4.1.5.3-1
@@ -568,10 +573,69 @@ typedef struct {
   uint32_t nof_re;   ///< Total number of resource elements
 } csi_rs_nzp_resource_measure_t;
 
+/**
+ * @brief Grid offsets of the RE of a CSI-RS resource within an OFDM symbol. They only depend on the frequency domain
+ * allocation, so they are computed once and reused for all the symbols of the resource, and for the following resources
+ * of the set with the same allocation
+ */
+typedef struct {
+  uint32_t k_list[CSI_RS_MAX_SUBC_PRB];
+  uint32_t nof_k;
+  uint32_t rb_begin;
+  uint32_t rb_end;
+  uint32_t rb_stride;
+  uint32_t count; ///< Number of RE, 0 until the offsets are computed
+  int32_t  idx[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
+} csi_rs_re_idx_t;
+
+static void csi_rs_re_idx_update(csi_rs_re_idx_t* q,
+                                 const uint32_t*  k_list,
+                                 uint32_t         nof_k,
+                                 uint32_t         rb_begin,
+                                 uint32_t         rb_end,
+                                 uint32_t         rb_stride)
+{
+  // Same allocation as the previous resource
+  if (q->count != 0 && q->nof_k == nof_k && q->rb_begin == rb_begin && q->rb_end == rb_end &&
+      q->rb_stride == rb_stride && memcmp(q->k_list, k_list, sizeof(uint32_t) * nof_k) == 0) {
+    return;
+  }
+
+  memcpy(q->k_list, k_list, sizeof(uint32_t) * nof_k);
+  q->nof_k     = nof_k;
+  q->rb_begin  = rb_begin;
+  q->rb_end    = rb_end;
+  q->rb_stride = rb_stride;
+  q->count     = 0;
+  for (uint32_t n = rb_begin; n < rb_end; n += rb_stride) {
+    for (uint32_t k_idx = 0; k_idx < nof_k; k_idx++) {
+      q->idx[q->count++] = (int32_t)(SRSRAN_NRE * n + k_list[k_idx]);
+    }
+  }
+}
+
+static void csi_rs_re_extract(const csi_rs_re_idx_t* q, const cf_t* symbol, cf_t* re)
+{
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX2
+  // Each complex RE is gathered as a double, 4 RE per gather
+  for (; i + 4 <= q->count; i += 4) {
+    __m128i idx = _mm_loadu_si128((const __m128i*)&q->idx[i]);
+    _mm256_storeu_pd((double*)&re[i], _mm256_i32gather_pd((const double*)symbol, idx, sizeof(cf_t)));
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < q->count; i++) {
+    re[i] = symbol[q->idx[i]];
+  }
+}
+
 static int csi_rs_nzp_measure_resource(const srsran_carrier_nr_t*          carrier,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_csi_rs_nzp_resource_t* resource,
                                        const cf_t*                         grid,
+                                       csi_rs_re_idx_t*                    re_idx,
                                        csi_rs_nzp_resource_measure_t*      measure)
 {
   // Force CDM group to 0
@@ -610,6 +674,14 @@ static int csi_rs_nzp_measure_resource(const srsran_carrier_nr_t*          carri
   // Calculate ideal number of RE per symbol
   uint32_t nof_re = csi_rs_count(resource->resource_mapping.density, rb_end - rb_begin);
 
+  // Verify RE count matches the expected number of RE
+  csi_rs_re_idx_update(re_idx, k_list, (uint32_t)nof_k, rb_begin, rb_end, rb_stride);
+  uint32_t count_re = re_idx->count;
+  if (count_re == 0 || count_re != nof_re) {
+    ERROR("Unmatched number of RE (%d != %d)", count_re, nof_re);
+    return SRSRAN_ERROR;
+  }
+
   // Accumulators
   float epre_acc  = 0.0f;
   cf_t  corr_acc  = 0.0f;
@@ -632,24 +704,10 @@ static int csi_rs_nzp_measure_resource(const srsran_carrier_nr_t*          carri
     srsran_sequence_state_advance(&sequence_state, 2 * csi_rs_count(resource->resource_mapping.density, rb_begin));
 
     // Temporal Least Square Estimates
-    cf_t     lse[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
-    uint32_t count_re = 0;
+    cf_t lse[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
 
     // Extract RE
-    for (uint32_t n = rb_begin; n < rb_end; n += rb_stride) {
-      for (uint32_t k_idx = 0; k_idx < nof_k; k_idx++) {
-        // Calculate sub-carrier index k
-        uint32_t k = SRSRAN_NRE * n + k_list[k_idx];
-
-        lse[count_re++] = grid[l * SRSRAN_NRE * carrier->nof_prb + k];
-      }
-    }
-
-    // Verify RE count matches the expected number of RE
-    if (count_re == 0 || count_re != nof_re) {
-      ERROR("Unmatched number of RE (%d != %d)", count_re, nof_re);
-      return SRSRAN_ERROR;
-    }
+    csi_rs_re_extract(re_idx, &grid[l * SRSRAN_NRE * carrier->nof_prb], lse);
 
     // Compute LSE
     cf_t r[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
@@ -689,6 +747,10 @@ static int csi_rs_nzp_measure_set(const srsran_carrier_nr_t*     carrier,
 {
   uint32_t count = 0;
 
+  // RE offsets shared by the resources of the set with the same frequency allocation, such as the TRS
+  csi_rs_re_idx_t re_idx;
+  re_idx.count = 0;
+
   // Iterate all resources in set
   for (uint32_t i = 0; i < set->count; i++) {
     // Skip resource
@@ -697,7 +759,8 @@ static int csi_rs_nzp_measure_set(const srsran_carrier_nr_t*     carrier,
     }
 
     // Perform measurement
-    if (csi_rs_nzp_measure_resource(carrier, slot_cfg, &set->data[i], grid, &measurements[count]) < SRSRAN_SUCCESS) {
+    if (csi_rs_nzp_measure_resource(carrier, slot_cfg, &set->data[i], grid, &re_idx, &measurements[count]) <
+        SRSRAN_SUCCESS) {
       ERROR("Error measuring NZP-CSI-RS resource");
       return SRSRAN_ERROR;
     }
@@ -718,7 +781,9 @@ int srsran_csi_rs_nzp_measure(const srsran_carrier_nr_t*          carrier,
   }
 
   csi_rs_nzp_resource_measure_t m = {};
-  if (csi_rs_nzp_measure_resource(carrier, slot_cfg, resource, grid, &m) < SRSRAN_SUCCESS) {
+  csi_rs_re_idx_t               re_idx;
+  re_idx.count = 0;
+  if (csi_rs_nzp_measure_resource(carrier, slot_cfg, resource, grid, &re_idx, &m) < SRSRAN_SUCCESS) {
     ERROR("Error measuring NZP-CSI-RS resource");
     return SRSRAN_ERROR;
   }
@@ -923,6 +988,7 @@ static int csi_rs_zp_measure_resource(const srsran_carrier_nr_t*         carrier
                                       const srsran_slot_cfg_t*           slot_cfg,
                                       const srsran_csi_rs_zp_resource_t* resource,
                                       const cf_t*                        grid,
+                                      csi_rs_re_idx_t*                   re_idx,
                                       csi_rs_zp_resource_measure_t*      measure)
 {
   // Force CDM group to 0
@@ -961,6 +1027,14 @@ static int csi_rs_zp_measure_resource(const srsran_carrier_nr_t*         carrier
   // Calculate ideal number of RE per symbol
   uint32_t nof_re = csi_rs_count(resource->resource_mapping.density, rb_end - rb_begin);
 
+  // Verify RE count matches the expected number of RE
+  csi_rs_re_idx_update(re_idx, k_list, (uint32_t)nof_k, rb_begin, rb_end, rb_stride);
+  uint32_t count_re = re_idx->count;
+  if (count_re == 0 || count_re != nof_re) {
+    ERROR("Unmatched number of RE (%d != %d)", count_re, nof_re);
+    return SRSRAN_ERROR;
+  }
+
   // Accumulators
   float epre_acc = 0.0f;
 
@@ -973,24 +1047,10 @@ static int csi_rs_zp_measure_resource(const srsran_carrier_nr_t*         carrier
     uint32_t l = l_list[l_idx];
 
     // Temporal Least Square Estimates
-    cf_t     temp[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
-    uint32_t count_re = 0;
+    cf_t temp[CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR];
 
     // Extract RE
-    for (uint32_t n = rb_begin; n < rb_end; n += rb_stride) {
-      for (uint32_t k_idx = 0; k_idx < nof_k; k_idx++) {
-        // Calculate sub-carrier index k
-        uint32_t k = SRSRAN_NRE * n + k_list[k_idx];
-
-        temp[count_re++] = grid[l * SRSRAN_NRE * carrier->nof_prb + k];
-      }
-    }
-
-    // Verify RE count matches the expected number of RE
-    if (count_re == 0 || count_re != nof_re) {
-      ERROR("Unmatched number of RE (%d != %d)", count_re, nof_re);
-      return SRSRAN_ERROR;
-    }
+    csi_rs_re_extract(re_idx, &grid[l * SRSRAN_NRE * carrier->nof_prb], temp);
 
     // Compute EPRE
     epre_acc += srsran_vec_avg_power_cf(temp, count_re);
@@ -1013,6 +1073,10 @@ static int csi_rs_zp_measure_set(const srsran_carrier_nr_t*    carrier,
 {
   uint32_t count = 0;
 
+  // RE offsets shared by the resources of the set with the same frequency allocation
+  csi_rs_re_idx_t re_idx;
+  re_idx.count = 0;
+
   // Iterate all resources in set
   for (uint32_t i = 0; i < set->count; i++) {
     // Skip resource
@@ -1021,7 +1085,8 @@ static int csi_rs_zp_measure_set(const srsran_carrier_nr_t*    carrier,
     }
 
     // Perform measurement
-    if (csi_rs_zp_measure_resource(carrier, slot_cfg, &set->data[i], grid, &measurements[count]) < SRSRAN_SUCCESS) {
+    if (csi_rs_zp_measure_resource(carrier, slot_cfg, &set->data[i], grid, &re_idx, &measurements[count]) <
+        SRSRAN_SUCCESS) {
       ERROR("Error measuring NZP-CSI-RS resource");
       return SRSRAN_ERROR;
     }
@@ -100,15 +100,14 @@ srsran_dmrs_get_pilots_type2(uint32_t start_prb, uint32_t nof_prb, uint32_t delt
   return count;
 }
 
-static uint32_t srsran_dmrs_get_lse(srsran_dmrs_sch_t*       q,
-                                    srsran_sequence_state_t* sequence_state,
-                                    srsran_dmrs_sch_type_t   dmrs_type,
-                                    uint32_t                 start_prb,
-                                    uint32_t                 nof_prb,
-                                    uint32_t                 delta,
-                                    float                    amplitude,
-                                    const cf_t*              symbols,
-                                    cf_t*                    least_square_estimates)
+static uint32_t srsran_dmrs_get_lse(const cf_t*            sequence,
+                                    srsran_dmrs_sch_type_t dmrs_type,
+                                    uint32_t               start_prb,
+                                    uint32_t               nof_prb,
+                                    uint32_t               delta,
+                                    float                  scale,
+                                    const cf_t*            symbols,
+                                    cf_t*                  least_square_estimates)
 {
   uint32_t count = 0;
 
@@ -123,11 +122,11 @@ static uint32_t srsran_dmrs_get_lse(srsran_dmrs_sch_t*       q,
       ERROR("Unknown DMRS type.");
   }
 
-  // Generate sequence for the given pilots
-  srsran_sequence_state_gen_f(sequence_state, amplitude, (float*)q->temp, count * 2);
-
   // Calculate least square estimates
-  srsran_vec_prod_conj_ccc(least_square_estimates, q->temp, least_square_estimates, count);
+  srsran_vec_prod_conj_ccc(least_square_estimates, sequence, least_square_estimates, count);
+  if (scale != 1.0f) {
+    srsran_vec_sc_prod_cfc(least_square_estimates, scale, least_square_estimates, count);
+  }
 
   return count;
 }
@@ -164,19 +163,19 @@ srsran_dmrs_put_pilots_type2(uint32_t start_prb, uint32_t nof_prb, uint32_t delt
   return count;
 }
 
-static uint32_t srsran_dmrs_put_pilots(srsran_dmrs_sch_t*       q,
-                                       srsran_sequence_state_t* sequence_state,
-                                       srsran_dmrs_sch_type_t   dmrs_type,
-                                       uint32_t                 start_prb,
-                                       uint32_t                 nof_prb,
-                                       uint32_t                 delta,
-                                       float                    amplitude,
-                                       cf_t*                    symbols)
+static uint32_t srsran_dmrs_put_pilots(srsran_dmrs_sch_t*     q,
+                                       const cf_t*            sequence,
+                                       srsran_dmrs_sch_type_t dmrs_type,
+                                       uint32_t               start_prb,
+                                       uint32_t               nof_prb,
+                                       uint32_t               delta,
+                                       float                  scale,
+                                       cf_t*                  symbols)
 {
   uint32_t count = (dmrs_type == srsran_dmrs_sch_type_1) ? nof_prb * 6 : nof_prb * 4;
 
-  // Generate sequence for the given pilots
-  srsran_sequence_state_gen_f(sequence_state, amplitude, (float*)q->temp, count * 2);
+  // Scale the sequence for the given pilots
+  srsran_vec_sc_prod_cfc(sequence, scale, q->temp, count);
 
   switch (dmrs_type) {
     case srsran_dmrs_sch_type_1:
@@ -195,14 +194,14 @@ static uint32_t srsran_dmrs_put_pilots(srsran_dmrs_sch_t*       q,
 static int srsran_dmrs_sch_put_symbol(srsran_dmrs_sch_t*           q,
                                       const srsran_sch_cfg_nr_t*   pdsch_cfg,
                                       const srsran_sch_grant_nr_t* grant,
-                                      uint32_t                     cinit,
+                                      const cf_t*                  sequence,
                                       uint32_t                     delta,
                                       cf_t*                        symbols)
 {
-  // Get signal amplitude
-  float amplitude = M_SQRT1_2;
+  // Get signal amplitude, the sequence is generated with amplitude 1/sqrt(2)
+  float scale = 1.0f;
   if (isnormal(grant->beta_dmrs)) {
-    amplitude *= grant->beta_dmrs;
+    scale = grant->beta_dmrs;
   }
 
   const srsran_dmrs_sch_cfg_t* dmrs_cfg         = &pdsch_cfg->dmrs;
@@ -211,10 +210,7 @@ static int srsran_dmrs_sch_put_symbol(srsran_dmrs_sch_t*           q,
   uint32_t                     prb_skip         = 0; // Number of PRB to skip
   uint32_t                     nof_pilots_x_prb = dmrs_cfg->type == srsran_dmrs_sch_type_1 ? 6 : 4;
   uint32_t                     pilot_count      = 0;
-
-  // Initialise sequence
-  srsran_sequence_state_t sequence_state = {};
-  srsran_sequence_state_init(&sequence_state, cinit);
+  uint32_t                     sequence_idx     = 0; // Index of the next sequence pilot
 
   // Iterate over PRBs
   for (uint32_t prb_idx = 0; prb_idx < q->carrier.nof_prb; prb_idx++) {
@@ -227,7 +223,7 @@ static int srsran_dmrs_sch_put_symbol(srsran_dmrs_sch_t*           q,
 
         // ... discard unused pilots and reset counter unless the PDSCH transmission carries SIB
         prb_skip = SRSRAN_MAX(0, (int)prb_skip - (int)dmrs_cfg->reference_point_k_rb);
-        srsran_sequence_state_advance(&sequence_state, prb_skip * nof_pilots_x_prb * 2);
+        sequence_idx += prb_skip * nof_pilots_x_prb;
         prb_skip = 0;
       }
       prb_count++;
@@ -244,16 +240,17 @@ static int srsran_dmrs_sch_put_symbol(srsran_dmrs_sch_t*           q,
     }
 
     // Get contiguous pilots
-    pilot_count +=
-        srsran_dmrs_put_pilots(q, &sequence_state, dmrs_cfg->type, prb_start, prb_count, delta, amplitude, symbols);
+    pilot_count += srsran_dmrs_put_pilots(
+        q, &sequence[sequence_idx], dmrs_cfg->type, prb_start, prb_count, delta, scale, symbols);
+    sequence_idx += prb_count * nof_pilots_x_prb;
 
     // Reset counter
     prb_count = 0;
   }
 
   if (prb_count > 0) {
-    pilot_count +=
-        srsran_dmrs_put_pilots(q, &sequence_state, dmrs_cfg->type, prb_start, prb_count, delta, amplitude, symbols);
+    pilot_count += srsran_dmrs_put_pilots(
+        q, &sequence[sequence_idx], dmrs_cfg->type, prb_start, prb_count, delta, scale, symbols);
   }
 
   return pilot_count;
@@ -509,17 +506,14 @@ int srsran_dmrs_sch_get_N_prb(const srsran_dmrs_sch_cfg_t* dmrs_cfg, const srsra
   return nof_sc * ret;
 }
 
-static uint32_t srsran_dmrs_sch_seed(const srsran_carrier_nr_t*   carrier,
+static uint32_t srsran_dmrs_sch_n_id(const srsran_carrier_nr_t*   carrier,
                                      const srsran_sch_cfg_nr_t*   cfg,
-                                     const srsran_sch_grant_nr_t* grant,
-                                     uint32_t                     slot_idx,
-                                     uint32_t                     symbol_idx)
+                                     const srsran_sch_grant_nr_t* grant)
 {
   const srsran_dmrs_sch_cfg_t* dmrs_cfg = &cfg->dmrs;
 
   // Calculate scrambling IDs
-  uint32_t n_id   = carrier->pci;
-  uint32_t n_scid = (grant->n_scid) ? 1 : 0;
+  uint32_t n_id = carrier->pci;
   if (!grant->n_scid && dmrs_cfg->scrambling_id0_present) {
     // n_scid = 0 and ID0 present
     n_id = dmrs_cfg->scrambling_id0;
@@ -528,10 +522,87 @@ static uint32_t srsran_dmrs_sch_seed(const srsran_carrier_nr_t*   carrier,
     n_id = dmrs_cfg->scrambling_id1;
   }
 
+  return n_id;
+}
+
+static uint32_t srsran_dmrs_sch_seed(uint32_t n_id, uint32_t n_scid, uint32_t slot_idx, uint32_t symbol_idx)
+{
   return SRSRAN_SEQUENCE_MOD((((SRSRAN_NSYMB_PER_SLOT_NR * slot_idx + symbol_idx + 1UL) * (2UL * n_id + 1UL)) << 17UL) +
                              (2UL * n_id + n_scid));
 }
 
+/**
+ * @brief Gets the DMRS sequence of a symbol, with amplitude 1/sqrt(2), starting at the first pilot of the carrier.
+ * Sequences scrambled with the carrier PCI are read from the table generated in set_carrier, the others are generated
+ * in sequence_temp
+ */
+static const cf_t* srsran_dmrs_sch_get_sequence(srsran_dmrs_sch_t*           q,
+                                                const srsran_sch_cfg_nr_t*   cfg,
+                                                const srsran_sch_grant_nr_t* grant,
+                                                uint32_t                     slot_idx,
+                                                uint32_t                     symbol_idx)
+{
+  uint32_t n_id   = srsran_dmrs_sch_n_id(&q->carrier, cfg, grant);
+  uint32_t n_scid = (grant->n_scid) ? 1 : 0;
+
+  if (n_id == q->carrier.pci && q->sequence[n_scid] != NULL && slot_idx < q->sequence_nof_slots) {
+    return &q->sequence[n_scid][(slot_idx * SRSRAN_NSYMB_PER_SLOT_NR + symbol_idx) * q->sequence_len];
+  }
+
+  srsran_sequence_state_t sequence_state = {};
+  srsran_sequence_state_init(&sequence_state, srsran_dmrs_sch_seed(n_id, n_scid, slot_idx, symbol_idx));
+  srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2, (float*)q->sequence_temp, q->sequence_len * 2);
+
+  return q->sequence_temp;
+}
+
+/**
+ * @brief Generates the DMRS sequences of the carrier PCI for every slot of the frame, symbol and n_SCID
+ */
+static int dmrs_sch_sequence_gen(srsran_dmrs_sch_t* q)
+{
+  uint32_t nof_slots = SRSRAN_NSLOTS_PER_FRAME_NR(q->carrier.scs);
+  uint32_t len       = q->carrier.nof_prb * 6; // Type 1 DMRS has the most pilots per PRB
+
+  if (q->sequence_temp == NULL || len > q->sequence_len) {
+    if (q->sequence_temp) {
+      free(q->sequence_temp);
+    }
+    q->sequence_temp = srsran_vec_cf_malloc(len);
+    if (q->sequence_temp == NULL) {
+      ERROR("malloc");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  for (uint32_t n_scid = 0; n_scid < 2; n_scid++) {
+    if (q->sequence[n_scid] != NULL) {
+      free(q->sequence[n_scid]);
+    }
+    q->sequence[n_scid] = srsran_vec_cf_malloc(nof_slots * SRSRAN_NSYMB_PER_SLOT_NR * len);
+    if (q->sequence[n_scid] == NULL) {
+      ERROR("malloc");
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t slot_idx = 0; slot_idx < nof_slots; slot_idx++) {
+      for (uint32_t l = 0; l < SRSRAN_NSYMB_PER_SLOT_NR; l++) {
+        srsran_sequence_state_t sequence_state = {};
+        srsran_sequence_state_init(&sequence_state, srsran_dmrs_sch_seed(q->carrier.pci, n_scid, slot_idx, l));
+        srsran_sequence_state_gen_f(&sequence_state,
+                                    M_SQRT1_2,
+                                    (float*)&q->sequence[n_scid][(slot_idx * SRSRAN_NSYMB_PER_SLOT_NR + l) * len],
+                                    len * 2);
+      }
+    }
+  }
+
+  q->sequence_nof_slots = nof_slots;
+  q->sequence_len       = len;
+
+  return SRSRAN_SUCCESS;
+}
+
 static int dmrs_sch_alloc(srsran_dmrs_sch_t* q, uint32_t max_nof_prb)
 {
   bool max_nof_prb_changed = q->max_nof_prb < max_nof_prb;
@@ -630,12 +701,24 @@ void srsran_dmrs_sch_free(srsran_dmrs_sch_t* q)
   if (q->filter) {
     free(q->filter);
   }
+  for (uint32_t n_scid = 0; n_scid < 2; n_scid++) {
+    if (q->sequence[n_scid]) {
+      free(q->sequence[n_scid]);
+    }
+  }
+  if (q->sequence_temp) {
+    free(q->sequence_temp);
+  }
 
   SRSRAN_MEM_ZERO(q, srsran_dmrs_sch_t, 1);
 }
 
 int srsran_dmrs_sch_set_carrier(srsran_dmrs_sch_t* q, const srsran_carrier_nr_t* carrier)
 {
+  // The sequences only need to be generated again if any of their parameters changes
+  bool sequence_changed = q->sequence[0] == NULL || q->carrier.pci != carrier->pci ||
+                          q->carrier.nof_prb != carrier->nof_prb || q->carrier.scs != carrier->scs;
+
   // Set carrier
   q->carrier = *carrier;
 
@@ -643,6 +726,10 @@ int srsran_dmrs_sch_set_carrier(srsran_dmrs_sch_t* q, const srsran_carrier_nr_t*
     return SRSRAN_ERROR;
   }
 
+  if (sequence_changed && dmrs_sch_sequence_gen(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -671,9 +758,9 @@ int srsran_dmrs_sch_put_sf(srsran_dmrs_sch_t*           q,
   for (uint32_t i = 0; i < nof_symbols; i++) {
     uint32_t l        = symbols[i];                                        // Symbol index inside the slot
     uint32_t slot_idx = SRSRAN_SLOT_NR_MOD(q->carrier.scs, slot_cfg->idx); // Slot index in the frame
-    uint32_t cinit    = srsran_dmrs_sch_seed(&q->carrier, pdsch_cfg, grant, slot_idx, l);
+    const cf_t* sequence = srsran_dmrs_sch_get_sequence(q, pdsch_cfg, grant, slot_idx, l);
 
-    srsran_dmrs_sch_put_symbol(q, pdsch_cfg, grant, cinit, delta, &sf_symbols[symbol_sz * l]);
+    srsran_dmrs_sch_put_symbol(q, pdsch_cfg, grant, sequence, delta, &sf_symbols[symbol_sz * l]);
   }
 
   return SRSRAN_SUCCESS;
@@ -682,15 +769,15 @@ int srsran_dmrs_sch_put_sf(srsran_dmrs_sch_t*           q,
 static int srsran_dmrs_sch_get_symbol(srsran_dmrs_sch_t*           q,
                                       const srsran_sch_cfg_nr_t*   pdsch_cfg,
                                       const srsran_sch_grant_nr_t* grant,
-                                      uint32_t                     cinit,
+                                      const cf_t*                  sequence,
                                       uint32_t                     delta,
                                       const cf_t*                  symbols,
                                       cf_t*                        least_square_estimates)
 {
-  // Get signal amplitude
-  float amplitude = M_SQRT1_2;
+  // Get signal amplitude, the sequence is generated with amplitude 1/sqrt(2)
+  float scale = 1.0f;
   if (isnormal(grant->beta_dmrs)) {
-    amplitude /= grant->beta_dmrs;
+    scale /= grant->beta_dmrs;
   }
 
   const srsran_dmrs_sch_cfg_t* dmrs_cfg = &pdsch_cfg->dmrs;
@@ -700,10 +787,7 @@ static int srsran_dmrs_sch_get_symbol(srsran_dmrs_sch_t*           q,
   uint32_t prb_skip         = 0; // Number of PRB to skip
   uint32_t nof_pilots_x_prb = dmrs_cfg->type == srsran_dmrs_sch_type_1 ? 6 : 4;
   uint32_t pilot_count      = 0;
-
-  // Initialise sequence
-  srsran_sequence_state_t sequence_state = {};
-  srsran_sequence_state_init(&sequence_state, cinit);
+  uint32_t sequence_idx     = 0; // Index of the next sequence pilot
 
   // Iterate over PRBs
   for (uint32_t prb_idx = 0; prb_idx < q->carrier.nof_prb; prb_idx++) {
@@ -716,7 +800,7 @@ static int srsran_dmrs_sch_get_symbol(srsran_dmrs_sch_t*           q,
 
         // ... discard unused pilots and reset counter unless the PDSCH transmission carries SIB
         prb_skip = SRSRAN_MAX(0, (int)prb_skip - (int)dmrs_cfg->reference_point_k_rb);
-        srsran_sequence_state_advance(&sequence_state, prb_skip * nof_pilots_x_prb * 2);
+        sequence_idx += prb_skip * nof_pilots_x_prb;
         prb_skip = 0;
       }
       prb_count++;
@@ -733,28 +817,27 @@ static int srsran_dmrs_sch_get_symbol(srsran_dmrs_sch_t*           q,
     }
 
     // Get contiguous pilots
-    pilot_count += srsran_dmrs_get_lse(q,
-                                       &sequence_state,
+    pilot_count += srsran_dmrs_get_lse(&sequence[sequence_idx],
                                        dmrs_cfg->type,
                                        prb_start,
                                        prb_count,
                                        delta,
-                                       amplitude,
+                                       scale,
                                        symbols,
                                        &least_square_estimates[pilot_count]);
+    sequence_idx += prb_count * nof_pilots_x_prb;
 
     // Reset counter
     prb_count = 0;
   }
 
   if (prb_count > 0) {
-    pilot_count += srsran_dmrs_get_lse(q,
-                                       &sequence_state,
+    pilot_count += srsran_dmrs_get_lse(&sequence[sequence_idx],
                                        dmrs_cfg->type,
                                        prb_start,
                                        prb_count,
                                        delta,
-                                       amplitude,
+                                       scale,
                                        symbols,
                                        &least_square_estimates[pilot_count]);
   }
@@ -801,10 +884,11 @@ int srsran_dmrs_sch_estimate(srsran_dmrs_sch_t*           q,
   for (uint32_t i = 0; i < nof_symbols; i++) {
     uint32_t l = symbols[i]; // Symbol index inside the slot
 
-    uint32_t cinit = srsran_dmrs_sch_seed(&q->carrier, cfg, grant, SRSRAN_SLOT_NR_MOD(q->carrier.scs, slot->idx), l);
+    const cf_t* sequence =
+        srsran_dmrs_sch_get_sequence(q, cfg, grant, SRSRAN_SLOT_NR_MOD(q->carrier.scs, slot->idx), l);
 
     nof_pilots_x_symbol = srsran_dmrs_sch_get_symbol(
-        q, cfg, grant, cinit, delta, &sf_symbols[symbol_sz * l], &q->pilot_estimates[nof_pilots_x_symbol * i]);
+        q, cfg, grant, sequence, delta, &sf_symbols[symbol_sz * l], &q->pilot_estimates[nof_pilots_x_symbol * i]);
 
     if (nof_pilots_x_symbol == 0) {
       ERROR("Error, no pilots extracted (i=%d, l=%d)", i, l);
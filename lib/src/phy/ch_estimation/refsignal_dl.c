@@ -32,6 +32,58 @@
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
+/* Pilot copies of one OFDM symbol, 1 reference every 6 RE. The specializations have the number of PRB as a compile time
+ * constant, so the loops have fixed bounds and are unrolled and vectorized for the common bandwidths */
+static void refsignal_cs_put_l(const cf_t* pilots, cf_t* symbol, uint32_t fidx, uint32_t nof_prb)
+{
+  for (uint32_t i = 0; i < 2 * nof_prb; i++) {
+    symbol[fidx + i * SRSRAN_NRE / 2] = pilots[i];
+  }
+}
+
+static void refsignal_cs_get_l_prb(const cf_t* symbol, cf_t* pilots, uint32_t fidx, uint32_t nof_prb)
+{
+  for (uint32_t i = 0; i < 2 * nof_prb; i++) {
+    pilots[i] = symbol[fidx + i * SRSRAN_NRE / 2];
+  }
+}
+
+#define REFSIGNAL_CS_COPY_L(NOF_PRB)                                                                                   \
+  static void refsignal_cs_put_l_##NOF_PRB(const cf_t* pilots, cf_t* symbol, uint32_t fidx, uint32_t nof_prb)          \
+  {                                                                                                                    \
+    refsignal_cs_put_l(pilots, symbol, fidx, NOF_PRB);                                                                 \
+  }                                                                                                                    \
+  static void refsignal_cs_get_l_##NOF_PRB(const cf_t* symbol, cf_t* pilots, uint32_t fidx, uint32_t nof_prb)          \
+  {                                                                                                                    \
+    refsignal_cs_get_l_prb(symbol, pilots, fidx, NOF_PRB);                                                             \
+  }
+
+REFSIGNAL_CS_COPY_L(25)
+REFSIGNAL_CS_COPY_L(50)
+REFSIGNAL_CS_COPY_L(100)
+
+static void refsignal_cs_set_copy(srsran_refsignal_t* q)
+{
+  switch (q->cell.nof_prb) {
+    case 25:
+      q->put_l = refsignal_cs_put_l_25;
+      q->get_l = refsignal_cs_get_l_25;
+      break;
+    case 50:
+      q->put_l = refsignal_cs_put_l_50;
+      q->get_l = refsignal_cs_get_l_50;
+      break;
+    case 100:
+      q->put_l = refsignal_cs_put_l_100;
+      q->get_l = refsignal_cs_get_l_100;
+      break;
+    default:
+      q->put_l = refsignal_cs_put_l;
+      q->get_l = refsignal_cs_get_l_prb;
+      break;
+  }
+}
+
 /** Allocates memory for the 20 slots in a subframe
  */
 int srsran_refsignal_cs_init(srsran_refsignal_t* q, uint32_t max_prb)
@@ -41,6 +93,7 @@ int srsran_refsignal_cs_init(srsran_refsignal_t* q, uint32_t max_prb)
   if (q != NULL) {
     ret = SRSRAN_ERROR;
     bzero(q, sizeof(srsran_refsignal_t));
+    refsignal_cs_set_copy(q);
     for (int p = 0; p < 2; p++) {
       for (int i = 0; i < SRSRAN_NOF_SF_X_FRAME; i++) {
         q->pilots[p][i] = srsran_vec_cf_malloc(SRSRAN_REFSIGNAL_MAX_NUM_SF(max_prb));
@@ -112,6 +165,7 @@ int srsran_refsignal_cs_set_cell(srsran_refsignal_t* q, srsran_cell_t cell)
       }
       srsran_sequence_free(&seq);
     }
+    refsignal_cs_set_copy(q);
     ret = SRSRAN_SUCCESS;
   }
   return ret;
@@ -267,7 +321,7 @@ inline uint32_t srsran_refsignal_cs_nsymbol(uint32_t l, srsran_cp_t cp, uint32_t
 /* Maps a reference signal initialized with srsran_refsignal_cs_init() into an array of subframe symbols */
 int srsran_refsignal_cs_put_sf(srsran_refsignal_t* q, srsran_dl_sf_cfg_t* sf, uint32_t port_id, cf_t* sf_symbols)
 {
-  uint32_t i, l;
+  uint32_t l;
   uint32_t fidx;
 
   if (q != NULL && port_id < SRSRAN_MAX_PORTS && sf_symbols != NULL) {
@@ -276,10 +330,10 @@ int srsran_refsignal_cs_put_sf(srsran_refsignal_t* q, srsran_dl_sf_cfg_t* sf, ui
       uint32_t nsymbol = srsran_refsignal_cs_nsymbol(l, q->cell.cp, port_id);
       /* Compute offset frequency index */
       fidx = ((srsran_refsignal_cs_v(port_id, l) + (q->cell.id % 6)) % 6);
-      for (i = 0; i < 2 * q->cell.nof_prb; i++) {
-        sf_symbols[SRSRAN_RE_IDX(q->cell.nof_prb, nsymbol, fidx)] = pilots[SRSRAN_REFSIGNAL_PILOT_IDX(i, l, q->cell)];
-        fidx += SRSRAN_NRE / 2; // 1 reference every 6 RE
-      }
+      q->put_l(&pilots[SRSRAN_REFSIGNAL_PILOT_IDX(0, l, q->cell)],
+               &sf_symbols[SRSRAN_RE_IDX(q->cell.nof_prb, nsymbol, 0)],
+               fidx,
+               q->cell.nof_prb);
     }
     return SRSRAN_SUCCESS;
   } else {
@@ -294,18 +348,15 @@ int srsran_refsignal_cs_get_sf(srsran_refsignal_t* q,
                                cf_t*               sf_symbols,
                                cf_t*               pilots)
 {
-  uint32_t i, l;
-  uint32_t fidx;
-
   if (q != NULL && pilots != NULL && sf_symbols != NULL) {
-    for (l = 0; l < srsran_refsignal_cs_nof_symbols(q, sf, port_id); l++) {
+    for (uint32_t l = 0; l < srsran_refsignal_cs_nof_symbols(q, sf, port_id); l++) {
       uint32_t nsymbol = srsran_refsignal_cs_nsymbol(l, q->cell.cp, port_id);
       /* Compute offset frequency index */
-      fidx = srsran_refsignal_cs_fidx(q->cell, l, port_id, 0);
-      for (i = 0; i < 2 * q->cell.nof_prb; i++) {
-        pilots[SRSRAN_REFSIGNAL_PILOT_IDX(i, l, q->cell)] = sf_symbols[SRSRAN_RE_IDX(q->cell.nof_prb, nsymbol, fidx)];
-        fidx += SRSRAN_NRE / 2; // 2 references per PRB
-      }
+      uint32_t fidx = srsran_refsignal_cs_fidx(q->cell, l, port_id, 0);
+      q->get_l(&sf_symbols[SRSRAN_RE_IDX(q->cell.nof_prb, nsymbol, 0)],
+               &pilots[SRSRAN_REFSIGNAL_PILOT_IDX(0, l, q->cell)],
+               fidx,
+               q->cell.nof_prb);
     }
     return SRSRAN_SUCCESS;
   } else {
@@ -428,6 +479,7 @@ int srsran_refsignal_mbsfn_init(srsran_refsignal_t* q, uint32_t max_prb)
   if (q != NULL) {
     ret = SRSRAN_ERROR;
     bzero(q, sizeof(srsran_refsignal_t));
+    refsignal_cs_set_copy(q);
 
     q->type = SRSRAN_SF_MBSFN;
 
@@ -829,6 +829,11 @@ uint32_t srsran_refsignal_srs_M_sc(srsran_refsignal_ul_t* q, srsran_refsignal_sr
   return m_srs_b[srsbwtable_idx(q->cell.nof_prb)][cfg->B][cfg->bw_cfg] * SRSRAN_NRE / 2;
 }
 
+uint32_t srsran_refsignal_srs_k0(srsran_refsignal_ul_t* q, srsran_refsignal_srs_cfg_t* cfg, uint32_t tti)
+{
+  return srs_k0_ue(cfg, q->cell.nof_prb, tti);
+}
+
 int srsran_refsignal_srs_pregen(srsran_refsignal_ul_t*             q,
                                 srsran_refsignal_srs_pregen_t*     pregen,
                                 srsran_refsignal_srs_cfg_t*        cfg,
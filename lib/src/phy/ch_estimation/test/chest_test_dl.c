@@ -213,6 +213,32 @@ int main(int argc, char** argv)
         goto do_exit;
       }
 
+      // The lightweight measurements shall track the full ones, the signal is the same in every radio frame
+      srsran_chest_dl_cfg_t light_cfg = {};
+      light_cfg.meas_period           = 3;
+      light_cfg.meas_ema_coeff        = 0.1f;
+      light_cfg.meas_full             = true;
+      srsran_chest_dl_res_t light_res = res;
+      gettimeofday(&t[1], NULL);
+      for (int k = 0; k < 100; k++) {
+        srsran_dl_sf_cfg_t light_sf = sf_cfg;
+        light_sf.tti                = sf_cfg.tti + SRSRAN_NOF_SF_X_FRAME * k;
+        srsran_chest_dl_estimate_cfg(&est, &light_sf, &light_cfg, input_m, &light_res);
+        light_cfg.meas_full = false;
+      }
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      printf("CHEST-LIGHT: %f us\n", (float)t[0].tv_usec / 100);
+
+      if (fabsf(light_res.rsrp_dbm - res.rsrp_dbm) > 1.0f || fabsf(light_res.rssi_dbm - res.rssi_dbm) > 1.0f) {
+        ERROR("Lightweight measurements RSRP=%+.1f RSSI=%+.1f dBm do not match RSRP=%+.1f RSSI=%+.1f dBm",
+              light_res.rsrp_dbm,
+              light_res.rssi_dbm,
+              res.rsrp_dbm,
+              res.rssi_dbm);
+        goto do_exit;
+      }
+
       if (fmatlab) {
         fprintf(fmatlab, "input=");
         srsran_vec_fprint_c(fmatlab, input, num_re);
@@ -0,0 +1,168 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/srsran.h"
+#include "srsran/support/srsran_test.h"
+#include <complex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <unistd.h>
+
+static srsran_cell_t cell = {25,             // nof_prb
+                             1,              // nof_ports
+                             1,              // cell_id
+                             SRSRAN_CP_NORM, // cyclic prefix
+                             SRSRAN_PHICH_NORM,
+                             SRSRAN_PHICH_R_1, // PHICH length
+                             SRSRAN_FDD};
+
+static srsran_refsignal_dmrs_pusch_cfg_t dmrs_pusch_cfg = {};
+
+static float snr_db = 20.0f;
+
+#define CHEST_TEST_SRS_BATCH_SNR_DB_TOLERANCE 3.0f
+#define CHEST_TEST_SRS_BATCH_TA_US_TOLERANCE 0.3f
+
+// Three UEs share the comb 0 with different cyclic shifts and a fourth UE sounds alone in the comb 1
+#define NOF_UES 4
+static const uint32_t ue_k_tc[NOF_UES]  = {0, 0, 0, 1};
+static const uint32_t ue_n_srs[NOF_UES] = {0, 3, 5, 2};
+static const float    ue_ta_us[NOF_UES] = {0.0f, 0.5f, -0.5f, 1.0f};
+
+void usage(char* prog)
+{
+  printf("Usage: %s [rcsv]\n", prog);
+
+  printf("\t-r nof_prb [Default %d]\n", cell.nof_prb);
+  printf("\t-c cell_id [Default %d]\n", cell.id);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr_db);
+
+  printf("\t-v increase verbosity\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "rcsv")) != -1) {
+    switch (opt) {
+      case 'r':
+        cell.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        cell.id = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  srsran_refsignal_ul_t       refsignal_ul = {};
+  srsran_chest_ul_srs_batch_t batch        = {};
+  srsran_channel_awgn_t       channel      = {};
+  srsran_ul_sf_cfg_t          ul_sf_cfg    = {};
+  srsran_refsignal_srs_cfg_t  srs_cfg[NOF_UES];
+  srsran_chest_ul_srs_meas_t  meas[NOF_UES];
+
+  parse_args(argc, argv);
+
+  uint32_t sf_size    = SRSRAN_SF_LEN_RE(cell.nof_prb, cell.cp);
+  cf_t*    sf_symbols = srsran_vec_cf_malloc(sf_size);
+  cf_t*    r_srs      = srsran_vec_cf_malloc(2 * SRSRAN_MAX_PRB * SRSRAN_NRE);
+  cf_t*    comb       = srsran_vec_cf_malloc(SRSRAN_MAX_PRB * SRSRAN_NRE);
+  TESTASSERT(sf_symbols != NULL && r_srs != NULL && comb != NULL);
+
+  TESTASSERT(srsran_refsignal_ul_set_cell(&refsignal_ul, cell) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_chest_ul_srs_batch_init(&batch, NOF_UES) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_chest_ul_srs_batch_set_cell(&batch, cell) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_channel_awgn_init(&channel, 123456789) == SRSRAN_SUCCESS);
+  srsran_channel_awgn_set_n0(&channel, -snr_db);
+
+  // Widest cell-specific SRS bandwidth that fits in the cell
+  uint32_t bw_cfg = 0;
+  while (srsran_refsignal_srs_rb_L_cs(bw_cfg, cell.nof_prb) > cell.nof_prb && bw_cfg < 7) {
+    bw_cfg++;
+  }
+
+  srsran_vec_cf_zero(sf_symbols, sf_size);
+
+  for (uint32_t i = 0; i < NOF_UES; i++) {
+    // Full bandwidth SRS in every subframe
+    srs_cfg[i]                 = (srsran_refsignal_srs_cfg_t){};
+    srs_cfg[i].configured      = true;
+    srs_cfg[i].subframe_config = 0;
+    srs_cfg[i].bw_cfg          = bw_cfg;
+    srs_cfg[i].I_srs           = 0;
+    srs_cfg[i].k_tc            = ue_k_tc[i];
+    srs_cfg[i].n_srs           = ue_n_srs[i];
+    TESTASSERT(srsran_refsignal_srs_send_cs(srs_cfg[i].subframe_config, ul_sf_cfg.tti) == 1);
+
+    TESTASSERT(srsran_refsignal_srs_gen(&refsignal_ul, &srs_cfg[i], &dmrs_pusch_cfg, ul_sf_cfg.tti, r_srs) ==
+               SRSRAN_SUCCESS);
+
+    // A delay is a negative phase slope in frequency, the comb subcarriers are 30 kHz apart
+    uint32_t M_sc = srsran_refsignal_srs_M_sc(&refsignal_ul, &srs_cfg[i]);
+    srsran_vec_apply_cfo(r_srs, -30e3f * ue_ta_us[i] * 1e-6f, r_srs, M_sc);
+
+    // Add the UE to the UEs already in its comb
+    TESTASSERT(srsran_refsignal_srs_get(&refsignal_ul, &srs_cfg[i], ul_sf_cfg.tti, comb, sf_symbols) ==
+               SRSRAN_SUCCESS);
+    srsran_vec_sum_ccc(comb, r_srs, comb, M_sc);
+    TESTASSERT(srsran_refsignal_srs_put(&refsignal_ul, &srs_cfg[i], ul_sf_cfg.tti, comb, sf_symbols) ==
+               SRSRAN_SUCCESS);
+  }
+
+  srsran_channel_awgn_run_c(&channel, sf_symbols, sf_symbols, sf_size);
+
+  TESTASSERT(srsran_chest_ul_srs_batch_estimate(
+                 &batch, &ul_sf_cfg, srs_cfg, NOF_UES, &dmrs_pusch_cfg, sf_symbols, meas) == SRSRAN_SUCCESS);
+
+  for (uint32_t i = 0; i < NOF_UES; i++) {
+    INFO("RESULTS: ue=%d; k_tc=%d; n_srs=%d; snr_db=%+.1f; ta_us=%+.1f;",
+         i,
+         srs_cfg[i].k_tc,
+         srs_cfg[i].n_srs,
+         meas[i].snr_db,
+         meas[i].ta_us);
+    TESTASSERT(fabsf(meas[i].snr_db - snr_db) < CHEST_TEST_SRS_BATCH_SNR_DB_TOLERANCE);
+    TESTASSERT(fabsf(meas[i].ta_us - ue_ta_us[i]) < CHEST_TEST_SRS_BATCH_TA_US_TOLERANCE);
+  }
+
+  srsran_chest_ul_srs_batch_free(&batch);
+  srsran_channel_awgn_free(&channel);
+  free(sf_symbols);
+  free(r_srs);
+  free(comb);
+
+  printf("OK\n");
+
+  return SRSRAN_SUCCESS;
+}
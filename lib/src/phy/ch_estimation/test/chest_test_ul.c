@@ -39,6 +39,7 @@ srsran_cell_t cell = {
 };
 
 char* output_matlab = NULL;
+bool  wiener_en     = false;
 
 void usage(char* prog)
 {
@@ -46,6 +47,7 @@ void usage(char* prog)
 
   printf("\t-r nof_prb [Default %d]\n", cell.nof_prb);
   printf("\t-e extended cyclic prefix [Default normal]\n");
+  printf("\t-w smooth the estimates with the Wiener filter [Default %s]\n", wiener_en ? "yes" : "no");
 
   printf("\t-c cell_id (1000 tests all). [Default %d]\n", cell.id);
 
@@ -56,7 +58,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "recov")) != -1) {
+  while ((opt = getopt(argc, argv, "recovw")) != -1) {
     switch (opt) {
       case 'r':
         cell.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -70,6 +72,9 @@ void parse_args(int argc, char** argv)
       case 'o':
         output_matlab = argv[optind];
         break;
+      case 'w':
+        wiener_en = true;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -203,6 +208,7 @@ int main(int argc, char** argv)
                   cfg.grant.n_prb_tilde[0] = 0;
                   cfg.grant.n_prb_tilde[1] = 0;
                   cfg.grant.n_dmrs         = cshift_dmrs;
+                  cfg.chest_wiener_en      = wiener_en;
 
                   srsran_ul_sf_cfg_t ul_sf;
                   ZERO_OBJECT(ul_sf);
@@ -532,16 +532,6 @@ static void estimate_wiener(srsran_wiener_dl_t* q,
   }
 }
 
-inline static cf_t _cmul(cf_t a, cf_t b)
-{
-  cf_t ret = 0;
-
-  __real__ ret = __real__ a * __real__ b - __imag__ a * __imag__ b;
-  __imag__ ret = __real__ a * __imag__ b + __imag__ a * __real__ b;
-
-  return ret;
-}
-
 static void
 srsran_wiener_dl_run_symbol_1_8(srsran_wiener_dl_t* q, srsran_wiener_dl_state_t* state, cf_t* pilots, float snr_lin)
 {
@@ -734,15 +724,18 @@ static void srsran_wiener_dl_run_symbol_5_12(srsran_wiener_dl_t*       q,
         }
       }
 
+      // Transpose the inverse so that every Wiener coefficient is a SIMD dot product between two rows
+      for (uint32_t i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
+        for (uint32_t k = 0; k < SRSRAN_WIENER_DL_MIN_REF; k++) {
+          q->invRH_t[k][i] = q->invRH.m[i][k];
+        }
+      }
+
       // Compute Wiener matrices
       for (uint32_t dim1 = 0; dim1 < SRSRAN_WIENER_DL_MIN_RE; dim1++) {
         for (uint32_t dim2 = 0; dim2 < SRSRAN_WIENER_DL_MIN_REF; dim2++) {
-          q->wm1[dim1][dim2] = 0;
-          q->wm2[dim1][dim2] = 0;
-          for (int i = 0; i < SRSRAN_WIENER_DL_MIN_REF; i++) {
-            q->wm1[dim1][dim2] += _cmul(q->hH1[dim1][i], q->invRH.m[i][dim2]);
-            q->wm2[dim1][dim2] += _cmul(q->hH2[dim1][i], q->invRH.m[i][dim2]);
-          }
+          q->wm1[dim1][dim2] = _srsran_vec_dot_prod_ccc_simd(q->hH1[dim1], q->invRH_t[dim2], SRSRAN_WIENER_DL_MIN_REF);
+          q->wm2[dim1][dim2] = _srsran_vec_dot_prod_ccc_simd(q->hH2[dim1], q->invRH_t[dim2], SRSRAN_WIENER_DL_MIN_REF);
         }
       }
       q->wm_computed = true;
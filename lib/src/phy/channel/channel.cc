@@ -43,11 +43,14 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
   // Copy args
   args = channel_args;
 
-  // Allocate internal buffers
-  buffer_in  = srsran_vec_cf_malloc(buffer_size);
-  buffer_out = srsran_vec_cf_malloc(buffer_size);
-  if (!buffer_out || !buffer_in) {
-    ret = SRSRAN_ERROR;
+  // Allocate internal buffers, every channel needs its own when they are processed in parallel
+  uint32_t nof_buffers = channel_args.nof_threads > 0 ? SRSRAN_MAX(_nof_channels, 1) : 1;
+  for (uint32_t i = 0; i < nof_buffers; i++) {
+    buffer_in[i]  = srsran_vec_cf_malloc(buffer_size);
+    buffer_out[i] = srsran_vec_cf_malloc(buffer_size);
+    if (!buffer_out[i] || !buffer_in[i]) {
+      ret = SRSRAN_ERROR;
+    }
   }
 
   nof_channels = _nof_channels;
@@ -94,6 +97,14 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
     srsran_channel_rlf_init(rlf, channel_args.rlf_t_on_ms, channel_args.rlf_t_off_ms);
   }
 
+  // Create fading and delay workers
+  if (channel_args.nof_threads > 0 && ret == SRSRAN_SUCCESS) {
+    nof_workers = SRSRAN_MIN(channel_args.nof_threads, nof_channels);
+    for (uint32_t i = 0; i < nof_workers; i++) {
+      workers.emplace_back(&channel::worker_loop, this, i);
+    }
+  }
+
   if (ret != SRSRAN_SUCCESS) {
     fprintf(stderr, "Error: Creating channel\n\n");
   }
@@ -101,12 +112,24 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
 
 channel::~channel()
 {
-  if (buffer_in) {
-    free(buffer_in);
+  // Stop workers
+  {
+    std::lock_guard<std::mutex> lock(workers_mutex);
+    workers_quit = true;
+  }
+  workers_start_cvar.notify_all();
+  for (std::thread& w : workers) {
+    w.join();
   }
 
-  if (buffer_out) {
-    free(buffer_out);
+  for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
+    if (buffer_in[i]) {
+      free(buffer_in[i]);
+    }
+
+    if (buffer_out[i]) {
+      free(buffer_out[i]);
+    }
   }
 
   if (awgn) {
@@ -147,6 +170,52 @@ static inline cf_t local_cexpf(float phase)
 }
 }
 
+void channel::run_fading_delay(uint32_t i, uint32_t len, const srsran_timestamp_t& t)
+{
+  cf_t* buf_in  = buffer_in[nof_workers > 0 ? i : 0];
+  cf_t* buf_out = buffer_out[nof_workers > 0 ? i : 0];
+
+  if (fading[i]) {
+    srsran_channel_fading_execute(fading[i], buf_in, buf_out, len, t.full_secs + t.frac_secs);
+    srsran_vec_cf_copy(buf_in, buf_out, len);
+  }
+
+  if (delay[i]) {
+    srsran_channel_delay_execute(delay[i], buf_in, buf_out, len, &t);
+    srsran_vec_cf_copy(buf_in, buf_out, len);
+  }
+}
+
+void channel::worker_loop(uint32_t worker_idx)
+{
+  uint32_t                     job = 0;
+  std::unique_lock<std::mutex> lock(workers_mutex);
+
+  while (true) {
+    workers_start_cvar.wait(lock, [this, &job] { return workers_quit or workers_job != job; });
+    if (workers_quit) {
+      return;
+    }
+    job = workers_job;
+
+    uint32_t           len = job_len;
+    srsran_timestamp_t t   = job_time;
+    lock.unlock();
+
+    for (uint32_t i = worker_idx; i < nof_channels; i += nof_workers) {
+      if (job_active[i]) {
+        run_fading_delay(i, len, t);
+      }
+    }
+
+    lock.lock();
+    workers_pending--;
+    if (workers_pending == 0) {
+      workers_done_cvar.notify_one();
+    }
+  }
+}
+
 void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
                   cf_t*                     out[SRSRAN_MAX_CHANNELS],
                   uint32_t                  len,
@@ -157,8 +226,10 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
     return;
   }
 
-  // For each channel
+  // For each channel, the models shared by all the channels run in order
   for (uint32_t i = 0; i < nof_channels; i++) {
+    job_active[i] = false;
+
     // Skip iteration if any buffer is null
     if (in[i] == nullptr || out[i] == nullptr) {
       continue;
@@ -172,36 +243,63 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
       continue;
     }
 
+    cf_t* buf_in  = buffer_in[nof_workers > 0 ? i : 0];
+    cf_t* buf_out = buffer_out[nof_workers > 0 ? i : 0];
+
     // Copy input buffer
-    srsran_vec_cf_copy(buffer_in, in[i], len);
+    srsran_vec_cf_copy(buf_in, in[i], len);
 
     if (hst) {
-      srsran_channel_hst_execute(hst, buffer_in, buffer_out, len, &t);
-      srsran_vec_sc_prod_ccc(buffer_out, local_cexpf(hst_init_phase), buffer_in, len);
+      srsran_channel_hst_execute(hst, buf_in, buf_out, len, &t);
+      srsran_vec_sc_prod_ccc(buf_out, local_cexpf(hst_init_phase), buf_in, len);
     }
 
     if (awgn) {
-      srsran_channel_awgn_run_c(awgn, buffer_in, buffer_out, len);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+      srsran_channel_awgn_run_c(awgn, buf_in, buf_out, len);
+      srsran_vec_cf_copy(buf_in, buf_out, len);
     }
 
-    if (fading[i]) {
-      srsran_channel_fading_execute(fading[i], buffer_in, buffer_out, len, t.full_secs + t.frac_secs);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
-    }
+    job_active[i] = true;
 
-    if (delay[i]) {
-      srsran_channel_delay_execute(delay[i], buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+    // Without workers, finish the channel before the next one reuses the buffers
+    if (nof_workers == 0) {
+      run_fading_delay(i, len, t);
+
+      if (rlf) {
+        srsran_channel_rlf_execute(rlf, buf_in, buf_out, len, &t);
+        srsran_vec_cf_copy(buf_in, buf_out, len);
+      }
+
+      // Copy output buffer
+      srsran_vec_cf_copy(out[i], buf_in, len);
     }
+  }
 
-    if (rlf) {
-      srsran_channel_rlf_execute(rlf, buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  // The fading and the delay of every channel are independent, run them in the workers
+  if (nof_workers > 0) {
+    {
+      std::unique_lock<std::mutex> lock(workers_mutex);
+      job_len         = len;
+      job_time        = t;
+      workers_pending = nof_workers;
+      workers_job++;
+      workers_start_cvar.notify_all();
+      workers_done_cvar.wait(lock, [this] { return workers_pending == 0; });
     }
 
-    // Copy output buffer
-    srsran_vec_cf_copy(out[i], buffer_in, len);
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      if (not job_active[i]) {
+        continue;
+      }
+
+      if (rlf) {
+        srsran_channel_rlf_execute(rlf, buffer_in[i], buffer_out[i], len, &t);
+        srsran_vec_cf_copy(buffer_in[i], buffer_out[i], len);
+      }
+
+      // Copy output buffer
+      srsran_vec_cf_copy(out[i], buffer_in[i], len);
+    }
   }
 
   if (hst) {
@@ -21,6 +21,7 @@
 
 #include "srsran/phy/channel/fading.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include <math.h>
 #include <stdio.h>
@@ -89,7 +90,7 @@ static inline __m128 _sine(const float* table, __m128 arg)
       _mm_round_ps(_mm_mul_ps(arg, _mm_set1_ps(1.0f / (2.0f * (float)M_PI))), (_MM_FROUND_TO_ZERO + _MM_FROUND_NO_EXC));
   __m128  argmod   = _mm_sub_ps(arg, _mm_mul_ps(turns, _mm_set1_ps(2.0f * (float)M_PI)));
   __m128  indexps  = _mm_mul_ps(argmod, _mm_set1_ps(1024.0f / (2.0f * (float)M_PI)));
-  __m128i indexi32 = _mm_abs_epi32(_mm_cvtps_epi32(indexps));
+  __m128i indexi32 = _mm_and_si128(_mm_cvtps_epi32(indexps), _mm_set1_epi32(1023)); // Rounding can reach 1024
   _mm_store_si128((__m128i*)idx, indexi32);
 
   for (int i = 0; i < 4; i++) {
@@ -107,27 +108,24 @@ static inline __m128 _cosine(float* table, __m128 arg)
 }
 #endif /*LV_HAVE_SSE*/
 
-static inline cf_t
-get_doppler_dispersion(srsran_channel_fading_t* q, float t, float F_d, float* alpha, float* a, float* b)
+static inline cf_t get_doppler_dispersion(srsran_channel_fading_t* q, float t, float* w, float* a, float* b)
 {
 #ifdef LV_HAVE_SSE
   const float recN   = 1.0f / sqrtf(SRSRAN_CHANNEL_FADING_NTERMS);
   cf_t        ret    = 0;
   __m128      _reacc = _mm_setzero_ps();
   __m128      _imacc = _mm_setzero_ps();
-  __m128      _arg   = _mm_set1_ps((float)M_PI * F_d);
   __m128      _t     = _mm_set1_ps(t);
-  __m128      _arg_  = (_mm_mul_ps(_arg, _t));
 
   for (int i = 0; i < SRSRAN_CHANNEL_FADING_NTERMS; i += 4) {
-    __m128 _alpha = _mm_loadu_ps(&alpha[i]);
-    __m128 _a     = _mm_loadu_ps(&a[i]);
-    __m128 _b     = _mm_loadu_ps(&b[i]);
-    __m128 _arg1  = _mm_mul_ps(_arg_, _cosine(q->sin_table, _alpha));
-    __m128 _re    = _cosine(q->sin_table, _mm_add_ps(_arg1, _a));
-    __m128 _im    = _sine(q->sin_table, _mm_add_ps(_arg1, _b));
-    _reacc        = _mm_add_ps(_reacc, _re);
-    _imacc        = _mm_add_ps(_imacc, _im);
+    __m128 _w    = _mm_loadu_ps(&w[i]);
+    __m128 _a    = _mm_loadu_ps(&a[i]);
+    __m128 _b    = _mm_loadu_ps(&b[i]);
+    __m128 _arg1 = _mm_mul_ps(_w, _t);
+    __m128 _re   = _cosine(q->sin_table, _mm_add_ps(_arg1, _a));
+    __m128 _im   = _sine(q->sin_table, _mm_add_ps(_arg1, _b));
+    _reacc       = _mm_add_ps(_reacc, _re);
+    _imacc       = _mm_add_ps(_imacc, _im);
   }
 
   __m128 _tmp = _mm_hadd_ps(_reacc, _imacc);
@@ -144,7 +142,7 @@ get_doppler_dispersion(srsran_channel_fading_t* q, float t, float F_d, float* al
   cf_t        r    = 0;
 
   for (uint32_t i = 0; i < SRSRAN_CHANNEL_FADING_NTERMS; i++) {
-    float arg = (float)M_PI * F_d * cosf(alpha[i]) * t;
+    float arg = w[i] * t;
     __real__ r += cosf(arg + a[i]);
     __imag__ r += sinf(arg + b[i]);
   }
@@ -153,6 +151,25 @@ get_doppler_dispersion(srsran_channel_fading_t* q, float t, float F_d, float* al
 #endif /*LV_HAVE_SSE*/
 }
 
+/* Accumulates the tap frequency response h_tap weighted by a into h_freq */
+static inline void accumulate_tap(const cf_t* h_tap, cf_t a, cf_t* h_freq, uint32_t N)
+{
+  uint32_t i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t _a = srsran_simd_cf_set1(a);
+  for (; i + SRSRAN_SIMD_CF_SIZE <= N; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t _h = srsran_simd_cfi_loadu(&h_tap[i]);
+    simd_cf_t _z = srsran_simd_cfi_loadu(&h_freq[i]);
+    srsran_simd_cfi_storeu(&h_freq[i], srsran_simd_cf_add(_z, srsran_simd_cf_prod(_h, _a)));
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; i < N; i++) {
+    h_freq[i] += a * h_tap[i];
+  }
+}
+
 static inline void generate_tap(float delay_ns, float power_db, float srate, cf_t* buf, uint32_t N, uint32_t path_delay)
 {
   float amplitude = srsran_convert_dB_to_power(power_db);
@@ -160,6 +177,13 @@ static inline void generate_tap(float delay_ns, float power_db, float srate, cf_
   cf_t  a0        = amplitude / N;
 
   srsran_vec_gen_sine(a0, -O, buf, N);
+
+  // Shift the response once, so the taps do not need to be shifted when they are combined
+  for (uint32_t k = 0; k < N / 2; k++) {
+    cf_t tmp       = buf[k];
+    buf[k]         = buf[k + N / 2];
+    buf[k + N / 2] = tmp;
+  }
 }
 
 static inline void generate_taps(srsran_channel_fading_t* q, float time)
@@ -167,19 +191,14 @@ static inline void generate_taps(srsran_channel_fading_t* q, float time)
   // Generate taps
   for (int i = 0; i < nof_taps[q->model]; i++) {
     // Compute phase for the doppler dispersion
-    cf_t a = get_doppler_dispersion(q, time, q->doppler, q->coeff_alpha[i], q->coeff_a[i], q->coeff_b[i]);
+    cf_t a = get_doppler_dispersion(q, time, q->coeff_w[i], q->coeff_a[i], q->coeff_b[i]);
 
     if (i) {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(q->h_tap[i], a, q->temp, q->N);
-
-      // Add to frequency response, shifts FFT at same time
-      srsran_vec_sum_ccc(q->h_freq, &q->temp[q->N / 2], q->h_freq, q->N / 2);
-      srsran_vec_sum_ccc(&q->h_freq[q->N / 2], q->temp, &q->h_freq[q->N / 2], q->N / 2);
+      // Add to frequency response
+      accumulate_tap(q->h_tap[i], a, q->h_freq, q->N);
     } else {
       // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][q->N / 2], a, q->h_freq, q->N / 2);
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][0], a, &q->h_freq[q->N / 2], q->N / 2);
+      srsran_vec_sc_prod_ccc(q->h_tap[i], a, q->h_freq, q->N);
     }
   }
   // at this stage, q->h_freq should contain the frequency response
@@ -242,6 +261,7 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
         q->coeff_a[i][j]     = srsran_random_uniform_real_dist(random, 0, 2.0f * (float)M_PI);
         q->coeff_b[i][j]     = srsran_random_uniform_real_dist(random, 0, 2.0f * (float)M_PI);
         q->coeff_alpha[i][j] = ((float)M_PI * ((float)i - (float)0.5f)) / (2.0f * nof_taps[q->model]);
+        q->coeff_w[i][j]     = (float)M_PI * q->doppler * cosf(q->coeff_alpha[i][j]);
       }
 
       // Allocate tap frequency response
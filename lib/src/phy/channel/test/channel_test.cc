@@ -0,0 +1,160 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/channel/channel.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <sys/time.h>
+#include <unistd.h>
+
+static uint32_t    nof_channels = 4;
+static uint32_t    nof_threads  = 2;
+static uint32_t    srate_hz     = 23040000;
+static uint32_t    nof_sf       = 5;
+static std::string model        = "epa5";
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [cmstT]\n", prog);
+  printf("\t-c Number of channels [Default %d]\n", nof_channels);
+  printf("\t-m Fading model [Default %s]\n", model.c_str());
+  printf("\t-s Sampling rate in Hz [Default %d]\n", srate_hz);
+  printf("\t-t Number of worker threads [Default %d]\n", nof_threads);
+  printf("\t-T Simulation time in subframes [Default %d]\n", nof_sf);
+}
+
+static int parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "cmstT")) != -1) {
+    switch (opt) {
+      case 'c':
+        nof_channels = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 'm':
+        model = argv[optind];
+        break;
+      case 's':
+        srate_hz = (uint32_t)strtof(argv[optind], nullptr);
+        break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      case 'T':
+        nof_sf = (uint32_t)strtol(argv[optind], nullptr, 10);
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/* Runs nof_sf subframes through an emulator and returns the time it took in microseconds */
+static uint64_t run_channel(const srsran::channel::args_t&   args,
+                            std::vector<std::vector<cf_t> >& input,
+                            std::vector<std::vector<cf_t> >& output)
+{
+  srsran::channel channel(args, nof_channels, srslog::fetch_basic_logger("CHAN", false));
+  channel.set_srate(srate_hz);
+
+  uint32_t           sf_len = srate_hz / 1000;
+  srsran_timestamp_t ts     = {};
+  struct timeval     t[3]   = {};
+  uint64_t           usec   = 0;
+
+  for (uint32_t sf = 0; sf < nof_sf; sf++) {
+    cf_t* in[SRSRAN_MAX_CHANNELS]  = {};
+    cf_t* out[SRSRAN_MAX_CHANNELS] = {};
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      in[i]  = &input[i][sf * sf_len];
+      out[i] = &output[i][sf * sf_len];
+    }
+
+    gettimeofday(&t[1], nullptr);
+    channel.run(in, out, sf_len, ts);
+    gettimeofday(&t[2], nullptr);
+    get_time_interval(t);
+    usec += t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+    srsran_timestamp_add(&ts, 0, 0.001);
+  }
+
+  return usec;
+}
+
+int main(int argc, char** argv)
+{
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS || nof_channels > SRSRAN_MAX_CHANNELS) {
+    return SRSRAN_ERROR;
+  }
+
+  srslog::init();
+
+  uint32_t                        nof_samples = nof_sf * srate_hz / 1000;
+  std::vector<std::vector<cf_t> > input(nof_channels, std::vector<cf_t>(nof_samples));
+  std::vector<std::vector<cf_t> > output_serial(nof_channels, std::vector<cf_t>(nof_samples));
+  std::vector<std::vector<cf_t> > output_parallel(nof_channels, std::vector<cf_t>(nof_samples));
+  srsran_random_t                 random_gen = srsran_random_init(0x1234);
+
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    srsran_random_uniform_complex_dist_vector(random_gen, input[i].data(), nof_samples, -1.0f, +1.0f);
+  }
+  srsran_random_free(random_gen);
+
+  // Every model but the fading and the delay is shared among the channels
+  srsran::channel::args_t args = {};
+  args.enable                  = true;
+  args.awgn_enable             = true;
+  args.awgn_snr_dB             = 20.0f;
+  args.fading_enable           = true;
+  args.fading_model            = model;
+  args.delay_enable            = true;
+
+  args.nof_threads     = 0;
+  uint64_t serial_us   = run_channel(args, input, output_serial);
+  args.nof_threads     = nof_threads;
+  uint64_t parallel_us = run_channel(args, input, output_parallel);
+
+  // The workers only change where the channels run, the output shall be the same
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    if (memcmp(output_serial[i].data(), output_parallel[i].data(), sizeof(cf_t) * nof_samples) != 0) {
+      ERROR("Channel %d output differs with %d worker threads", i, nof_threads);
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  printf("Test model=%s; channels=%d; srate_hz=%d; serial %.1f Msps; %d threads %.1f Msps; %s\n",
+         model.c_str(),
+         nof_channels,
+         srate_hz,
+         (double)nof_samples * nof_channels / SRSRAN_MAX(serial_us, 1),
+         nof_threads,
+         (double)nof_samples * nof_channels / SRSRAN_MAX(parallel_us, 1),
+         ret == SRSRAN_SUCCESS ? "Passed" : "Failed");
+
+  srslog::flush();
+
+  return ret;
+}
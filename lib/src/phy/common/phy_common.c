@@ -181,6 +181,43 @@ uint32_t srsran_tdd_nof_harq(srsran_tdd_config_t tdd_config)
   return tdd_nof_harq[tdd_config.sf_config];
 }
 
+typedef struct {
+  uint32_t M;
+  uint32_t K[SRSRAN_MAX_TDD_DL_ASSOCIATION_SET_SIZE];
+} tdd_das_t;
+
+// Downlink association set index, TS 36.213 Table 10.1.3.1-1
+static const tdd_das_t tdd_das[SRSRAN_MAX_TDD_SF_CONFIGS][SRSRAN_NOF_SF_X_FRAME] = {
+    {{0, {}}, {0, {}}, {1, {6}}, {0, {}}, {1, {4}}, {0, {}}, {0, {}}, {1, {6}}, {0, {}}, {1, {4}}},
+    {{0, {}}, {0, {}}, {2, {7, 6}}, {1, {4}}, {0, {}}, {0, {}}, {0, {}}, {2, {7, 6}}, {1, {4}}, {0, {}}},
+    {{0, {}}, {0, {}}, {4, {8, 7, 4, 6}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}, {4, {8, 7, 4, 6}}, {0, {}}, {0, {}}},
+    {{0, {}}, {0, {}}, {3, {7, 6, 11}}, {2, {6, 5}}, {2, {5, 4}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}},
+    {{0, {}}, {0, {}}, {4, {12, 8, 7, 11}}, {4, {6, 5, 4, 7}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}},
+    {{0, {}},
+     {0, {}},
+     {9, {13, 12, 9, 8, 7, 5, 4, 11, 6}},
+     {0, {}},
+     {0, {}},
+     {0, {}},
+     {0, {}},
+     {0, {}},
+     {0, {}},
+     {0, {}}},
+    {{0, {}}, {0, {}}, {1, {7}}, {1, {7}}, {1, {5}}, {0, {}}, {0, {}}, {1, {7}}, {1, {7}}, {0, {}}}};
+
+uint32_t srsran_tdd_dl_association_set(srsran_tdd_config_t tdd_config, uint32_t sf_idx, uint32_t* k)
+{
+  if (tdd_config.sf_config >= SRSRAN_MAX_TDD_SF_CONFIGS || sf_idx >= SRSRAN_NOF_SF_X_FRAME || k == NULL) {
+    return 0;
+  }
+
+  const tdd_das_t* das = &tdd_das[tdd_config.sf_config][sf_idx];
+  for (uint32_t i = 0; i < das->M; i++) {
+    k[i] = das->K[i];
+  }
+  return das->M;
+}
+
 bool srsran_sfidx_isvalid(uint32_t sf_idx)
 {
   if (sf_idx <= SRSRAN_NOF_SF_X_FRAME) {
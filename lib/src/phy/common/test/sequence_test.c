@@ -23,6 +23,7 @@
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
 
 #define Nc 1600
 #define MAX_SEQ_LEN (256 * 1024)
@@ -173,6 +174,19 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
     ret = SRSRAN_ERROR;
   }
 
+  // Test packed XOR split in chunks of whole bytes, not aligned to the parallel generation
+  srsran_sequence_state_t sequence_state = {};
+  srsran_sequence_state_init(&sequence_state, seed);
+  for (uint32_t i = 0; i < length; i += 200) {
+    srsran_sequence_state_apply_packed(
+        &sequence_state, &ones_packed[i / 8], &c_packed[i / 8], SRSRAN_MIN(200, length - i));
+  }
+
+  if (memcmp(c_packed_gold, c_packed, (length + 7) / 8) != 0) {
+    ERROR("Unmatched c_packed state");
+    ret = SRSRAN_ERROR;
+  }
+
   if (memcmp(c, c_unpacked, length) != 0) {
     ERROR("Unmatched c_unpacked");
     ret = SRSRAN_ERROR;
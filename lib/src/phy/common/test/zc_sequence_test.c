@@ -0,0 +1,184 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/common/phy_common_nr.h"
+#include "srsran/phy/common/zc_sequence.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/primes.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <math.h>
+
+// Maximum error between the generated sequences and the double precision reference
+#define MAX_ERROR 2e-4
+
+// NR sequence lengths are multiples of half a PRB
+#define NR_STEP (SRSRAN_NRE / 2)
+#define MAX_M_ZC (SRSRAN_MAX_PRB_NR * SRSRAN_NRE)
+
+static cf_t           sequence[MAX_M_ZC];
+static cf_t           base[MAX_M_ZC];
+static double         ref_arg[MAX_M_ZC];
+static double complex ref_base[MAX_M_ZC];
+
+/* Base sequence argument of the lengths of 3 PRB or more (TS 36.211 Section 5.5.1.1 and TS 38.211 Section 5.2.2.1).
+ * As in the direct generation, the argument is rounded to single precision before the complex exponential */
+static void reference_arg_mprb(uint32_t M_zc, uint32_t u, uint32_t v)
+{
+  float N_zc  = (float)srsran_prime_lower_than(M_zc);
+  float q_hat = N_zc * (u + 1) / 31;
+  float q     = (((uint32_t)(2 * q_hat)) % 2 == 0) ? q_hat + 0.5 + v : q_hat + 0.5 - v;
+  q           = (float)(uint32_t)q;
+
+  for (uint32_t n = 0; n < M_zc; n++) {
+    float m    = (float)(n % (uint32_t)N_zc);
+    ref_arg[n] = (float)(-M_PI * q * m * (m + 1) / N_zc);
+  }
+}
+
+// Maximum error of a sequence against the reference base sequence rotated by alpha
+static double max_error(const cf_t* x, double alpha, uint32_t M_zc)
+{
+  double err = 0.0;
+  for (uint32_t n = 0; n < M_zc; n++) {
+    double complex ref = (alpha == 0.0) ? ref_base[n] : ref_base[n] * cexp(I * alpha * n);
+    err                = fmax(err, cabs((double complex)x[n] - ref));
+  }
+  return err;
+}
+
+/* Checks the cached sequences of a group, base sequence and length against their direct generation, with and without
+ * cyclic shift. The direct generation is evaluated in double precision from the argument of the long base sequences,
+ * or from the phases of the short ones (taken from the phi tables), which must be odd multiples of pi/4 */
+static int test_sequence(bool nr, uint32_t u, uint32_t v, uint32_t M_zc)
+{
+  // Alternate the cyclic shift among the 11 non-zero ones
+  float alpha = (float)(2.0 * M_PI * (1 + (u + v + M_zc) % 11) / 12.0);
+
+  // The first generation fills the cache, the shifted one reads from it
+  int ret = nr ? srsran_zc_sequence_generate_nr(u, v, 0.0f, M_zc / NR_STEP, 1, base)
+               : srsran_zc_sequence_generate_lte(u, v, 0.0f, M_zc / SRSRAN_NRE, base);
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error generating %s sequence u=%d v=%d M_zc=%d", nr ? "NR" : "LTE", u, v, M_zc);
+    return SRSRAN_ERROR;
+  }
+
+  if (M_zc >= 3 * SRSRAN_NRE) {
+    reference_arg_mprb(M_zc, u, v);
+  } else {
+    for (uint32_t n = 0; n < M_zc; n++) {
+      double phi = carg(base[n]) / M_PI_4;
+      if (fabs(phi - round(phi)) > MAX_ERROR || ((int)lround(phi)) % 2 == 0) {
+        ERROR("Invalid phase %f pi/4 of %s sequence u=%d M_zc=%d n=%d", phi, nr ? "NR" : "LTE", u, M_zc, n);
+        return SRSRAN_ERROR;
+      }
+      ref_arg[n] = M_PI_4 * round(phi);
+    }
+  }
+
+  for (uint32_t n = 0; n < M_zc; n++) {
+    ref_base[n] = cexp(I * ref_arg[n]);
+  }
+
+  double err = max_error(base, 0.0, M_zc);
+  if (err > MAX_ERROR) {
+    ERROR("Base %s sequence u=%d v=%d M_zc=%d error %e", nr ? "NR" : "LTE", u, v, M_zc, err);
+    return SRSRAN_ERROR;
+  }
+
+  ret = nr ? srsran_zc_sequence_generate_nr(u, v, alpha, M_zc / NR_STEP, 1, sequence)
+           : srsran_zc_sequence_generate_lte(u, v, alpha, M_zc / SRSRAN_NRE, sequence);
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error generating %s sequence u=%d v=%d M_zc=%d", nr ? "NR" : "LTE", u, v, M_zc);
+    return SRSRAN_ERROR;
+  }
+
+  err = max_error(sequence, alpha, M_zc);
+  if (err > MAX_ERROR) {
+    ERROR("Shifted %s sequence u=%d v=%d M_zc=%d alpha=%f error %e", nr ? "NR" : "LTE", u, v, M_zc, alpha, err);
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// The short base sequences of the 30 groups are all different
+static int test_short_groups(bool nr, uint32_t M_zc)
+{
+  static cf_t groups[SRSRAN_ZC_SEQUENCE_NOF_GROUPS][2 * SRSRAN_NRE];
+
+  for (uint32_t u = 0; u < SRSRAN_ZC_SEQUENCE_NOF_GROUPS; u++) {
+    int ret = nr ? srsran_zc_sequence_generate_nr(u, 0, 0.0f, M_zc / NR_STEP, 1, groups[u])
+                 : srsran_zc_sequence_generate_lte(u, 0, 0.0f, M_zc / SRSRAN_NRE, groups[u]);
+    if (ret < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    for (uint32_t w = 0; w < u; w++) {
+      float diff = 0.0f;
+      for (uint32_t n = 0; n < M_zc; n++) {
+        diff = SRSRAN_MAX(diff, cabsf(groups[u][n] - groups[w][n]));
+      }
+      if (diff < MAX_ERROR) {
+        ERROR("%s sequences of groups %d and %d are equal for M_zc=%d", nr ? "NR" : "LTE", w, u, M_zc);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  // LTE, every length up to the maximum number of PRB
+  for (uint32_t M_zc = SRSRAN_NRE; M_zc <= SRSRAN_MAX_PRB * SRSRAN_NRE; M_zc += SRSRAN_NRE) {
+    if (M_zc < 3 * SRSRAN_NRE && test_short_groups(false, M_zc) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    for (uint32_t u = 0; u < SRSRAN_ZC_SEQUENCE_NOF_GROUPS; u++) {
+      for (uint32_t v = 0; v < SRSRAN_ZC_SEQUENCE_NOF_BASE; v++) {
+        if (test_sequence(false, u, v, M_zc) < SRSRAN_SUCCESS) {
+          return SRSRAN_ERROR;
+        }
+      }
+    }
+  }
+
+  // NR, every length in half PRB steps, skipping 30 subcarriers which is not a valid length
+  for (uint32_t M_zc = NR_STEP; M_zc <= MAX_M_ZC; M_zc += NR_STEP) {
+    if (M_zc == 5 * NR_STEP) {
+      continue;
+    }
+    if (M_zc < 3 * SRSRAN_NRE && test_short_groups(true, M_zc) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    for (uint32_t u = 0; u < SRSRAN_ZC_SEQUENCE_NOF_GROUPS; u++) {
+      for (uint32_t v = 0; v < SRSRAN_ZC_SEQUENCE_NOF_BASE; v++) {
+        if (test_sequence(true, u, v, M_zc) < SRSRAN_SUCCESS) {
+          return SRSRAN_ERROR;
+        }
+      }
+    }
+  }
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
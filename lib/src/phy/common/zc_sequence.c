@@ -21,11 +21,13 @@
 
 #include "srsran/phy/common/zc_sequence.h"
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/common/phy_common_nr.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/primes.h"
 #include "srsran/phy/utils/vector.h"
 #include <assert.h>
 #include <complex.h>
+#include <pthread.h>
 
 #define NOF_ZC_SEQ 30
 
@@ -283,6 +285,63 @@ static void zc_sequence_generate(uint32_t M_zc, float alpha, const cf_t* tmp_arg
   }
 }
 
+/************************************************
+ *
+ *  BASE SEQUENCE CACHE
+ *
+ ************************************************/
+
+// NR sequence lengths are multiples of half a PRB, the cache is indexed in half PRB steps
+#define ZC_SEQUENCE_NR_STEP (SRSRAN_NRE / 2)
+#define ZC_SEQUENCE_NR_MAX_IDX ((SRSRAN_MAX_PRB_NR * SRSRAN_NRE) / ZC_SEQUENCE_NR_STEP)
+
+/* Base sequences (alpha = 0) for every group, base sequence and length used so far. They are generated the first time
+ * they are requested and kept for the lifetime of the process, so hopping UL reference signals only apply the cyclic
+ * shift at runtime */
+static cf_t* zc_sequence_cache_lte[SRSRAN_ZC_SEQUENCE_NOF_GROUPS][SRSRAN_ZC_SEQUENCE_NOF_BASE][SRSRAN_MAX_PRB + 1];
+static cf_t* zc_sequence_cache_nr[SRSRAN_ZC_SEQUENCE_NOF_GROUPS][SRSRAN_ZC_SEQUENCE_NOF_BASE][ZC_SEQUENCE_NR_MAX_IDX + 1];
+static pthread_mutex_t zc_sequence_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static const cf_t* zc_sequence_cache_get(cf_t** entry,
+                                         uint32_t M_zc,
+                                         uint32_t u,
+                                         uint32_t v,
+                                         int (*r_uv_arg)(uint32_t, uint32_t, uint32_t, cf_t*))
+{
+  cf_t* base = __atomic_load_n(entry, __ATOMIC_ACQUIRE);
+  if (base != NULL) {
+    return base;
+  }
+
+  pthread_mutex_lock(&zc_sequence_cache_mutex);
+  base = *entry;
+  if (base == NULL) {
+    base = srsran_vec_cf_malloc(M_zc);
+    if (base != NULL) {
+      if (r_uv_arg(M_zc, u, v, base) < SRSRAN_SUCCESS) {
+        free(base);
+        base = NULL;
+      } else {
+        zc_sequence_generate(M_zc, 0.0f, base, base);
+        __atomic_store_n(entry, base, __ATOMIC_RELEASE);
+      }
+    }
+  }
+  pthread_mutex_unlock(&zc_sequence_cache_mutex);
+
+  return base;
+}
+
+// Applies the cyclic shift alpha to a cached base sequence
+static void zc_sequence_cyclic_shift(const cf_t* base, float alpha, uint32_t M_zc, cf_t* sequence)
+{
+  if (alpha == 0.0f) {
+    srsran_vec_cf_copy(sequence, base, M_zc);
+  } else {
+    srsran_vec_apply_cfo(base, alpha / (2.0f * (float)M_PI), sequence, (int)M_zc);
+  }
+}
+
 int srsran_zc_sequence_generate_lte(uint32_t u, uint32_t v, float alpha, uint32_t nof_prb, cf_t* sequence)
 {
   // Check inputs
@@ -299,6 +358,17 @@ int srsran_zc_sequence_generate_lte(uint32_t u, uint32_t v, float alpha, uint32_
   // Calculate number of samples
   uint32_t M_zc = nof_prb * SRSRAN_NRE;
 
+  // Use the cached base sequence
+  if (nof_prb > 0 && nof_prb <= SRSRAN_MAX_PRB) {
+    const cf_t* base =
+        zc_sequence_cache_get(&zc_sequence_cache_lte[u][v][nof_prb], M_zc, u, v, zc_sequence_lte_r_uv_arg);
+    if (base == NULL) {
+      return SRSRAN_ERROR;
+    }
+    zc_sequence_cyclic_shift(base, alpha, M_zc, sequence);
+    return SRSRAN_SUCCESS;
+  }
+
   // Calculate argument
   if (zc_sequence_lte_r_uv_arg(M_zc, u, v, sequence) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -326,6 +396,17 @@ int srsran_zc_sequence_generate_nr(uint32_t u, uint32_t v, float alpha, uint32_t
   // Calculate number of samples
   uint32_t M_zc = (m * SRSRAN_NRE) >> delta;
 
+  // Use the cached base sequence
+  if (M_zc > 0 && M_zc % ZC_SEQUENCE_NR_STEP == 0 && M_zc / ZC_SEQUENCE_NR_STEP <= ZC_SEQUENCE_NR_MAX_IDX) {
+    const cf_t* base = zc_sequence_cache_get(
+        &zc_sequence_cache_nr[u][v][M_zc / ZC_SEQUENCE_NR_STEP], M_zc, u, v, zc_sequence_nr_r_uv_arg);
+    if (base == NULL) {
+      return SRSRAN_ERROR;
+    }
+    zc_sequence_cyclic_shift(base, alpha, M_zc, sequence);
+    return SRSRAN_SUCCESS;
+  }
+
   // Calculate argument
   if (zc_sequence_nr_r_uv_arg(M_zc, u, v, sequence) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
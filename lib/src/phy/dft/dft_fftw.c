@@ -35,8 +35,16 @@
 
 #define FFTW_WISDOM_FILE "%s/.srsran_fftwisdom"
 
+#define FFTW_WISDOM_ENV "SRSRAN_FFTW_WISDOM"
+
 static int get_fftw_wisdom_file(char* full_path, uint32_t n)
 {
+  // The environment variable, if set, points to the wisdom file shared by all the processes of a deployment
+  const char* env_path = getenv(FFTW_WISDOM_ENV);
+  if (env_path != NULL && env_path[0] != '\0') {
+    return snprintf(full_path, n, "%s", env_path);
+  }
+
   const char* homedir = NULL;
   if ((homedir = getenv("HOME")) == NULL) {
     homedir = getpwuid(getuid())->pw_dir;
@@ -81,29 +89,39 @@ __attribute__((constructor)) static void srsran_dft_load()
 #endif
 }
 
-// This function is called in the ending of any executable where it is linked
-__attribute__((destructor)) void srsran_dft_exit()
+int srsran_dft_wisdom_export(void)
 {
 #ifdef FFTW_WISDOM_FILE
   char full_path[256];
   get_fftw_wisdom_file(full_path, sizeof(full_path));
   FILE* fd = fopen(full_path, "w");
   if (fd == NULL) {
-    return;
+    return SRSRAN_ERROR;
   }
   if (lockf(fileno(fd), F_LOCK, 0) == -1) {
     perror("lockf()");
     fclose(fd);
-    return;
+    return SRSRAN_ERROR;
   }
+  pthread_mutex_lock(&fft_mutex);
   fftwf_export_wisdom_to_file(fd);
+  pthread_mutex_unlock(&fft_mutex);
   if (lockf(fileno(fd), F_ULOCK, 0) == -1) {
     perror("u-lockf()");
     fclose(fd);
-    return;
+    return SRSRAN_ERROR;
   }
   fclose(fd);
+  return SRSRAN_SUCCESS;
+#else
+  return SRSRAN_ERROR;
 #endif
+}
+
+// This function is called in the ending of any executable where it is linked
+__attribute__((destructor)) void srsran_dft_exit()
+{
+  srsran_dft_wisdom_export();
   fftwf_cleanup();
 }
 
@@ -198,25 +216,23 @@ int srsran_dft_replan_c(srsran_dft_plan_t* plan, const int new_dft_points)
   return 0;
 }
 
-int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
-                           const int          dft_points,
-                           srsran_dft_dir_t   dir,
-                           cf_t*              in_buffer,
-                           cf_t*              out_buffer,
-                           int                istride,
-                           int                ostride,
-                           int                how_many,
-                           int                idist,
-                           int                odist)
+static int dft_plan_guru_(srsran_dft_plan_t* plan,
+                          const int          dft_points,
+                          srsran_dft_dir_t   dir,
+                          cf_t*              in_buffer,
+                          cf_t*              out_buffer,
+                          int                istride,
+                          int                ostride,
+                          int                howmany_rank,
+                          const fftwf_iodim* howmany_dims)
 {
   int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
 
-  const fftwf_iodim iodim        = {dft_points, istride, ostride};
-  const fftwf_iodim howmany_dims = {how_many, idist, odist};
+  const fftwf_iodim iodim = {dft_points, istride, ostride};
 
   pthread_mutex_lock(&fft_mutex);
 
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  plan->p = fftwf_plan_guru_dft(1, &iodim, howmany_rank, howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -237,6 +253,42 @@ int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
   return 0;
 }
 
+int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
+                           const int          dft_points,
+                           srsran_dft_dir_t   dir,
+                           cf_t*              in_buffer,
+                           cf_t*              out_buffer,
+                           int                istride,
+                           int                ostride,
+                           int                how_many,
+                           int                idist,
+                           int                odist)
+{
+  const fftwf_iodim howmany_dims = {how_many, idist, odist};
+
+  return dft_plan_guru_(plan, dft_points, dir, in_buffer, out_buffer, istride, ostride, 1, &howmany_dims);
+}
+
+int srsran_dft_plan_guru_batch_c(srsran_dft_plan_t* plan,
+                                 const int          dft_points,
+                                 srsran_dft_dir_t   dir,
+                                 cf_t*              in_buffer,
+                                 cf_t*              out_buffer,
+                                 int                istride,
+                                 int                ostride,
+                                 int                how_many,
+                                 int                idist,
+                                 int                odist,
+                                 int                nof_batches,
+                                 int                batch_idist,
+                                 int                batch_odist)
+{
+  // The outer dimension goes first, as in a row-major array
+  const fftwf_iodim howmany_dims[2] = {{nof_batches, batch_idist, batch_odist}, {how_many, idist, odist}};
+
+  return dft_plan_guru_(plan, dft_points, dir, in_buffer, out_buffer, istride, ostride, 2, howmany_dims);
+}
+
 int srsran_dft_plan_c(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_dir_t dir)
 {
   allocate(plan, sizeof(fftwf_complex), sizeof(fftwf_complex), dft_points);
@@ -375,6 +427,12 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
   fftwf_execute(plan->p);
   if (plan->norm) {
     norm = 1.0 / sqrtf(plan->size);
+
+    // Without dB conversion nor reordering, the normalization writes the output directly
+    if (!plan->db && !(plan->mirror && plan->forward)) {
+      srsran_vec_sc_prod_cfc(f_out, norm, out, plan->size);
+      return;
+    }
     srsran_vec_sc_prod_cfc(f_out, norm, f_out, plan->size);
   }
   if (plan->db) {
@@ -158,15 +158,6 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
     }
   }
 
-  // Zero temporal and input buffers always
-  srsran_vec_cf_zero(q->tmp, q->sf_sz);
-
-  if (dir == SRSRAN_DFT_BACKWARD) {
-    srsran_vec_cf_zero(in_buffer, SRSRAN_SF_LEN_RE(nof_prb, cp));
-  } else {
-    srsran_vec_cf_zero(in_buffer, q->sf_sz);
-  }
-
   for (int slot = 0; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
     // If Guru DFT was allocated, free
     if (q->fft_plan_sf[slot].size) {
@@ -204,6 +195,56 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
       }
     }
   }
+
+  // Transforming both slots in a single call halves the number of DFT executions per subframe. Slots start slot_sz
+  // samples apart, so they can be described as a second dimension of the Guru plan. If the backend cannot plan it, the
+  // per-slot plans are used instead.
+  if (q->fft_plan_batch.size) {
+    srsran_dft_plan_free(&q->fft_plan_batch);
+  }
+  int batch_err;
+  if (dir == SRSRAN_DFT_FORWARD) {
+    batch_err = srsran_dft_plan_guru_batch_c(&q->fft_plan_batch,
+                                             symbol_sz,
+                                             dir,
+                                             in_buffer + cp1 - q->window_offset_n,
+                                             q->tmp,
+                                             1,
+                                             1,
+                                             SRSRAN_CP_NSYMB(cp),
+                                             symbol_sz + cp2,
+                                             symbol_sz,
+                                             SRSRAN_NOF_SLOTS_PER_SF,
+                                             q->slot_sz,
+                                             SRSRAN_CP_NSYMB(cp) * symbol_sz);
+  } else {
+    batch_err = srsran_dft_plan_guru_batch_c(&q->fft_plan_batch,
+                                             symbol_sz,
+                                             dir,
+                                             q->tmp,
+                                             out_buffer + cp1,
+                                             1,
+                                             1,
+                                             SRSRAN_CP_NSYMB(cp),
+                                             symbol_sz,
+                                             symbol_sz + cp2,
+                                             SRSRAN_NOF_SLOTS_PER_SF,
+                                             SRSRAN_CP_NSYMB(cp) * symbol_sz,
+                                             q->slot_sz);
+  }
+  if (batch_err) {
+    INFO("Guru subframe DFT plan not available, using one plan per slot");
+    SRSRAN_MEM_ZERO(&q->fft_plan_batch, srsran_dft_plan_t, 1);
+  }
+
+  // Zero temporal and input buffers always, planning may have used them
+  srsran_vec_cf_zero(q->tmp, q->sf_sz);
+
+  if (dir == SRSRAN_DFT_BACKWARD) {
+    srsran_vec_cf_zero(in_buffer, SRSRAN_SF_LEN_RE(nof_prb, cp));
+  } else {
+    srsran_vec_cf_zero(in_buffer, q->sf_sz);
+  }
 #endif
 
   srsran_dft_plan_set_mirror(&q->fft_plan, true);
@@ -253,6 +294,9 @@ void srsran_ofdm_free_(srsran_ofdm_t* q)
       srsran_dft_plan_free(&q->fft_plan_sf[slot]);
     }
   }
+  if (q->fft_plan_batch.init_size) {
+    srsran_dft_plan_free(&q->fft_plan_batch);
+  }
 #endif
 
   if (q->tmp) {
@@ -468,6 +512,42 @@ void srsran_ofdm_rx_slot_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+/* Turns the DFT of an OFDM symbol, in natural order, into its resource elements: applies the DFT window offset
+ * correction, shifts the spectrum, removes the guards and applies the normalization and phase compensation.
+ */
+static void ofdm_rx_symbol_post(srsran_ofdm_t* q, uint32_t symbol_idx, cf_t* tmp, cf_t* output)
+{
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t nof_re    = q->nof_re;
+  float    norm      = 1.0f / sqrtf(q->fft_plan.size);
+  uint32_t dc        = (q->fft_plan.dc) ? 1 : 0;
+
+  // Apply frequency domain window offset
+  if (q->window_offset_n) {
+    srsran_vec_prod_ccc(tmp, q->window_offset_buffer, tmp, symbol_sz);
+  }
+
+  // Perform FFT shift
+  memcpy(output, tmp + symbol_sz - nof_re / 2, sizeof(cf_t) * nof_re / 2);
+  memcpy(output + nof_re / 2, &tmp[dc], sizeof(cf_t) * nof_re / 2);
+
+  // Normalize output
+  if (isnormal(q->cfg.phase_compensation_hz)) {
+    // Get phase compensation
+    cf_t phase_compensation = conjf(q->phase_compensation[symbol_idx]);
+
+    // Apply normalization
+    if (q->fft_plan.norm) {
+      phase_compensation *= norm;
+    }
+
+    // Apply correction
+    srsran_vec_sc_prod_ccc(output, phase_compensation, output, nof_re);
+  } else if (q->fft_plan.norm) {
+    srsran_vec_sc_prod_cfc(output, norm, output, nof_re);
+  }
+}
+
 /* Transforms input samples into output OFDM symbols.
  * Performs FFT on a each symbol and removes CP.
  */
@@ -481,37 +561,12 @@ static void ofdm_rx_slot(srsran_ofdm_t* q, int slot_in_sf)
   uint32_t nof_re = q->nof_re;
   cf_t* output = q->cfg.out_buffer + slot_in_sf * nof_re * nof_symbols;
   uint32_t symbol_sz = q->cfg.symbol_sz;
-  float norm = 1.0f / sqrtf(q->fft_plan.size);
   cf_t* tmp = q->tmp;
-  uint32_t dc = (q->fft_plan.dc) ? 1 : 0;
 
   srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
 
   for (int i = 0; i < q->nof_symbols; i++) {
-    // Apply frequency domain window offset
-    if (q->window_offset_n) {
-      srsran_vec_prod_ccc(tmp, q->window_offset_buffer, tmp, symbol_sz);
-    }
-
-    // Perform FFT shift
-    memcpy(output, tmp + symbol_sz - nof_re / 2, sizeof(cf_t) * nof_re / 2);
-    memcpy(output + nof_re / 2, &tmp[dc], sizeof(cf_t) * nof_re / 2);
-
-    // Normalize output
-    if (isnormal(q->cfg.phase_compensation_hz)) {
-      // Get phase compensation
-      cf_t phase_compensation = conjf(q->phase_compensation[slot_in_sf * q->nof_symbols + i]);
-
-      // Apply normalization
-      if (q->fft_plan.norm) {
-        phase_compensation *= norm;
-      }
-
-      // Apply correction
-      srsran_vec_sc_prod_ccc(output, phase_compensation, output, nof_re);
-    } else if (q->fft_plan.norm) {
-      srsran_vec_sc_prod_cfc(output, norm, output, nof_re);
-    }
+    ofdm_rx_symbol_post(q, slot_in_sf * q->nof_symbols + i, tmp, output);
 
     tmp += symbol_sz;
     output += nof_re;
@@ -519,6 +574,18 @@ static void ofdm_rx_slot(srsran_ofdm_t* q, int slot_in_sf)
 #endif
 }
 
+#ifndef AVOID_GURU
+/* Transforms all the symbols of the subframe with a single DFT execution */
+static void ofdm_rx_sf_batch(srsran_ofdm_t* q)
+{
+  srsran_dft_run_guru_c(&q->fft_plan_batch);
+
+  for (uint32_t i = 0; i < SRSRAN_NOF_SLOTS_PER_SF * q->nof_symbols; i++) {
+    ofdm_rx_symbol_post(q, i, &q->tmp[i * q->cfg.symbol_sz], &q->cfg.out_buffer[i * q->nof_re]);
+  }
+}
+#endif /* AVOID_GURU */
+
 static void ofdm_rx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 {
   uint32_t i;
@@ -554,6 +621,12 @@ void srsran_ofdm_rx_sf(srsran_ofdm_t* q)
     srsran_vec_prod_ccc(q->cfg.in_buffer, q->shift_buffer, q->cfg.in_buffer, q->sf_sz);
   }
   if (!q->mbsfn_subframe) {
+#ifndef AVOID_GURU
+    if (q->fft_plan_batch.size) {
+      ofdm_rx_sf_batch(q);
+      return;
+    }
+#endif /* AVOID_GURU */
     for (uint32_t n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
       ofdm_rx_slot(q, n);
     }
@@ -563,6 +636,49 @@ void srsran_ofdm_rx_sf(srsran_ofdm_t* q)
   }
 }
 
+void srsran_ofdm_rx_sf_sc16(srsran_ofdm_t* q, const int16_t* input, float scale)
+{
+  // MBSFN subframes and the non guru path read the whole subframe
+#ifndef AVOID_GURU
+  bool fused = !q->mbsfn_subframe;
+#else
+  bool fused = false;
+#endif /* AVOID_GURU */
+  if (!fused) {
+    srsran_vec_convert_if(input, scale, (float*)q->cfg.in_buffer, 2 * q->sf_sz);
+    srsran_ofdm_rx_sf(q);
+    return;
+  }
+
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  uint32_t    cp1       = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(0, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+  uint32_t    cp2       = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(1, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+  // Only the samples read by the DFT are converted, the cyclic prefix before the window start is skipped
+  for (uint32_t i = 0; i < SRSRAN_NOF_SLOTS_PER_SF * q->nof_symbols; i++) {
+    uint32_t slot  = i / q->nof_symbols;
+    uint32_t l     = i % q->nof_symbols;
+    uint32_t start = slot * q->slot_sz + cp1 + l * (symbol_sz + cp2) - q->window_offset_n;
+    cf_t*    ptr   = &q->cfg.in_buffer[start];
+
+    srsran_vec_convert_if(&input[2 * start], scale, (float*)ptr, 2 * symbol_sz);
+    if (isnormal(q->cfg.freq_shift_f)) {
+      srsran_vec_prod_ccc(ptr, &q->shift_buffer[start], ptr, symbol_sz);
+    }
+  }
+
+#ifndef AVOID_GURU
+  if (q->fft_plan_batch.size) {
+    ofdm_rx_sf_batch(q);
+    return;
+  }
+#endif /* AVOID_GURU */
+  for (uint32_t n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
+    ofdm_rx_slot(q, n);
+  }
+}
+
 void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 {
   uint32_t n;
@@ -579,6 +695,51 @@ void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+#ifndef AVOID_GURU
+/* Maps the resource elements of an OFDM symbol onto the inverse-DFT input, in natural order */
+static void ofdm_tx_symbol_pre(srsran_ofdm_t* q, const cf_t* input, cf_t* tmp)
+{
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t nof_re    = q->nof_re;
+  uint32_t dc        = (q->fft_plan.dc) ? 1 : 0;
+
+  srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
+  srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+}
+
+/* Applies the normalization, phase compensation and CFR to the time-domain OFDM symbol that starts cp_len samples
+ * after output, and adds its cyclic prefix.
+ */
+static void ofdm_tx_symbol_post(srsran_ofdm_t* q, uint32_t symbol_idx, cf_t* output, int cp_len)
+{
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  float    norm      = 1.0f / sqrtf(symbol_sz);
+
+  if (isnormal(q->cfg.phase_compensation_hz)) {
+    // Get phase compensation
+    cf_t phase_compensation = q->phase_compensation[symbol_idx];
+
+    // Apply normalization
+    if (q->fft_plan.norm) {
+      phase_compensation *= norm;
+    }
+
+    // Apply correction
+    srsran_vec_sc_prod_ccc(&output[cp_len], phase_compensation, &output[cp_len], symbol_sz);
+  } else if (q->fft_plan.norm) {
+    srsran_vec_sc_prod_cfc(&output[cp_len], norm, &output[cp_len], symbol_sz);
+  }
+
+  // CFR: Process the time-domain signal without the CP
+  if (q->cfg.cfr_tx_cfg.cfr_enable) {
+    srsran_cfr_process(&q->tx_cfr, output + cp_len, output + cp_len);
+  }
+
+  /* add CP */
+  srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+}
+#endif /* AVOID_GURU */
+
 /* Transforms input OFDM symbols into output samples.
  * Performs the FFT on each symbol and adds CP.
  */
@@ -601,53 +762,53 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
     output += symbol_sz + cp_len;
   }
 #else
-  uint32_t nof_symbols = q->nof_symbols;
-  uint32_t nof_re = q->nof_re;
-  float norm = 1.0f / sqrtf(symbol_sz);
   cf_t* tmp = q->tmp;
 
   bzero(tmp, q->slot_sz);
-  uint32_t dc = (q->fft_plan.dc) ? 1 : 0;
 
-  for (int i = 0; i < nof_symbols; i++) {
-    srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
-    srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+  for (int i = 0; i < q->nof_symbols; i++) {
+    ofdm_tx_symbol_pre(q, input, tmp);
 
-    input += nof_re;
+    input += q->nof_re;
     tmp += symbol_sz;
   }
 
   srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
 
-  for (int i = 0; i < nof_symbols; i++) {
+  for (int i = 0; i < q->nof_symbols; i++) {
     int cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
 
-    if (isnormal(q->cfg.phase_compensation_hz)) {
-      // Get phase compensation
-      cf_t phase_compensation = q->phase_compensation[slot_in_sf * q->nof_symbols + i];
+    ofdm_tx_symbol_post(q, slot_in_sf * q->nof_symbols + i, output, cp_len);
+    output += symbol_sz + cp_len;
+  }
+#endif
+}
 
-      // Apply normalization
-      if (q->fft_plan.norm) {
-        phase_compensation *= norm;
-      }
+#ifndef AVOID_GURU
+/* Transforms all the symbols of the subframe with a single inverse-DFT execution */
+static void ofdm_tx_sf_batch(srsran_ofdm_t* q)
+{
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  cf_t*       output    = q->cfg.out_buffer;
 
-      // Apply correction
-      srsran_vec_sc_prod_ccc(&output[cp_len], phase_compensation, &output[cp_len], symbol_sz);
-    } else if (q->fft_plan.norm) {
-      srsran_vec_sc_prod_cfc(&output[cp_len], norm, &output[cp_len], symbol_sz);
-    }
+  bzero(q->tmp, q->slot_sz);
 
-    // CFR: Process the time-domain signal without the CP
-    if (q->cfg.cfr_tx_cfg.cfr_enable) {
-      srsran_cfr_process(&q->tx_cfr, output + cp_len, output + cp_len);
-    }
+  for (uint32_t i = 0; i < SRSRAN_NOF_SLOTS_PER_SF * q->nof_symbols; i++) {
+    ofdm_tx_symbol_pre(q, &q->cfg.in_buffer[i * q->nof_re], &q->tmp[i * symbol_sz]);
+  }
 
-    /* add CP */
-    srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+  srsran_dft_run_guru_c(&q->fft_plan_batch);
+
+  for (uint32_t i = 0; i < SRSRAN_NOF_SLOTS_PER_SF * q->nof_symbols; i++) {
+    uint32_t l      = i % q->nof_symbols;
+    int      cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(l, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+    ofdm_tx_symbol_post(q, i, output, cp_len);
     output += symbol_sz + cp_len;
   }
-#endif
 }
+#endif /* AVOID_GURU */
 
 void ofdm_tx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 {
@@ -677,8 +838,15 @@ void srsran_ofdm_tx_sf(srsran_ofdm_t* q)
 {
   uint32_t n;
   if (!q->mbsfn_subframe) {
-    for (n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
-      ofdm_tx_slot(q, n);
+#ifndef AVOID_GURU
+    if (q->fft_plan_batch.size) {
+      ofdm_tx_sf_batch(q);
+    } else
+#endif /* AVOID_GURU */
+    {
+      for (n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
+        ofdm_tx_slot(q, n);
+      }
     }
   } else {
     ofdm_tx_slot_mbsfn(q, q->cfg.in_buffer, q->cfg.out_buffer);
@@ -689,6 +857,58 @@ void srsran_ofdm_tx_sf(srsran_ofdm_t* q)
   }
 }
 
+void srsran_ofdm_tx_sf_sc16(srsran_ofdm_t* q, int16_t* output, float scale)
+{
+  srsran_ofdm_tx_sf(q);
+  srsran_vec_convert_fi((const float*)q->cfg.out_buffer, scale, output, 2 * q->sf_sz);
+}
+
+uint32_t srsran_ofdm_get_symbol_offset(const srsran_ofdm_t* q, uint32_t symbol_idx)
+{
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  uint32_t    slot      = symbol_idx / q->nof_symbols;
+  uint32_t    l         = symbol_idx % q->nof_symbols;
+  uint32_t    cp1       = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(0, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+  uint32_t    cp2       = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(1, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+  return slot * q->slot_sz + ((l == 0) ? 0 : cp1 + symbol_sz + (l - 1) * (cp2 + symbol_sz));
+}
+
+int srsran_ofdm_tx_symbol(srsran_ofdm_t* q, uint32_t symbol_idx)
+{
+  if (q == NULL || q->mbsfn_subframe || symbol_idx >= SRSRAN_NOF_SLOTS_PER_SF * q->nof_symbols) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  uint32_t    l         = symbol_idx % q->nof_symbols;
+  uint32_t    cp_len    = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(l, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+  uint32_t    offset    = srsran_ofdm_get_symbol_offset(q, symbol_idx);
+  const cf_t* input     = &q->cfg.in_buffer[symbol_idx * q->nof_re];
+  cf_t*       output    = &q->cfg.out_buffer[offset];
+
+#ifdef AVOID_GURU
+  memcpy(&q->tmp[q->nof_guards], input, q->nof_re * sizeof(cf_t));
+  srsran_dft_run_c(&q->fft_plan, q->tmp, &output[cp_len]);
+  memcpy(output, &output[symbol_sz], cp_len * sizeof(cf_t));
+#else
+  // The DFT runs between the plan buffers, which have the alignment the plan was created with
+  srsran_vec_cf_zero(q->tmp, symbol_sz);
+  ofdm_tx_symbol_pre(q, input, q->tmp);
+  srsran_dft_run_c_zerocopy(&q->fft_plan, q->tmp, q->fft_plan.out);
+  srsran_vec_cf_copy(&output[cp_len], q->fft_plan.out, symbol_sz);
+  ofdm_tx_symbol_post(q, symbol_idx, output, (int)cp_len);
+#endif
+
+  if (isnormal(q->cfg.freq_shift_f)) {
+    srsran_vec_prod_ccc(output, &q->shift_buffer[offset], output, cp_len + symbol_sz);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_ofdm_set_cfr(srsran_ofdm_t* q, srsran_cfr_cfg_t* cfr)
 {
   if (q == NULL || cfr == NULL) {
@@ -36,7 +36,14 @@ static float       rx_window_offset      = 0.5f;
 static float       freq_shift_f          = 0.0f;
 static double      phase_compensation_hz = 0.0;
 static uint32_t    force_symbol_sz       = 0;
-static double      elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
+static bool        symbol_streaming      = false;
+static bool        sc16_samples          = false;
+
+// Leaves headroom for the signal peaks, the truncation to 16 bit adds an error of about 1e-4
+#define SC16_SCALE 8192.0f
+#define SC16_MAX_MSE 0.001f
+
+static double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 {
   if (ts_end->tv_usec > ts_start->tv_usec) {
     return ((double)ts_end->tv_sec - (double)ts_start->tv_sec) * 1000000 + (double)ts_end->tv_usec -
@@ -57,12 +64,14 @@ static void usage(char* prog)
   printf("\t-o rx window offset (portion of CP length) [Default %.1f]\n", rx_window_offset);
   printf("\t-s frequency shift (normalised with sampling rate) [Default %.1f]\n", freq_shift_f);
   printf("\t-p Phase compensation carrier frequency in Hz [Default %.1f]\n", phase_compensation_hz);
+  printf("\t-y Modulate one symbol at a time [Default %s]\n", symbol_streaming ? "true" : "false");
+  printf("\t-w Exchange the subframe as 16 bit IQ samples [Default %s]\n", sc16_samples ? "true" : "false");
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "Nnerosp")) != -1) {
+  while ((opt = getopt(argc, argv, "Nnerospyw")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -85,6 +94,12 @@ static void parse_args(int argc, char** argv)
       case 'p':
         phase_compensation_hz = strtod(argv[optind], NULL);
         break;
+      case 'y':
+        symbol_streaming = true;
+        break;
+      case 'w':
+        sc16_samples = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -98,6 +113,7 @@ int main(int argc, char** argv)
   struct timeval  start, end;
   srsran_ofdm_t   fft = {}, ifft = {};
   cf_t *          input, *outfft, *outifft;
+  int16_t*        wire;
   float           mse;
   uint32_t        n_prb, max_prb;
 
@@ -121,7 +137,8 @@ int main(int argc, char** argv)
     input   = srsran_vec_cf_malloc(n_re);
     outfft  = srsran_vec_cf_malloc(n_re);
     outifft = srsran_vec_cf_malloc(sf_len);
-    if (!input || !outfft || !outifft) {
+    wire    = srsran_vec_i16_malloc(2 * sf_len);
+    if (!input || !outfft || !outifft || !wire) {
       perror("malloc");
       exit(-1);
     }
@@ -160,7 +177,19 @@ int main(int argc, char** argv)
     // Execute Tx
     gettimeofday(&start, NULL);
     for (uint32_t i = 0; i < nof_repetitions; i++) {
-      srsran_ofdm_tx_sf(&ifft);
+      if (symbol_streaming) {
+        // Modulate the symbols backwards, so that each symbol is checked not to depend on the previous ones
+        for (uint32_t l = SRSRAN_CP_NSYMB(cp) * SRSRAN_NOF_SLOTS_PER_SF; l-- > 0;) {
+          if (srsran_ofdm_tx_symbol(&ifft, l) < SRSRAN_SUCCESS) {
+            ERROR("Error modulating symbol %d", l);
+            exit(-1);
+          }
+        }
+      } else if (sc16_samples) {
+        srsran_ofdm_tx_sf_sc16(&ifft, wire, SC16_SCALE);
+      } else {
+        srsran_ofdm_tx_sf(&ifft);
+      }
     }
     gettimeofday(&end, NULL);
     printf(" Tx@%.1fMsps", (float)(sf_len * nof_repetitions) / elapsed_us(&start, &end));
@@ -168,7 +197,11 @@ int main(int argc, char** argv)
     // Execute Rx
     gettimeofday(&start, NULL);
     for (uint32_t i = 0; i < nof_repetitions; i++) {
-      srsran_ofdm_rx_sf(&fft);
+      if (sc16_samples) {
+        srsran_ofdm_rx_sf_sc16(&fft, wire, SC16_SCALE);
+      } else {
+        srsran_ofdm_rx_sf(&fft);
+      }
     }
     gettimeofday(&end, NULL);
     printf(" Rx@%.1fMsps", (double)(sf_len * nof_repetitions) / elapsed_us(&start, &end));
@@ -179,7 +212,7 @@ int main(int argc, char** argv)
 
     printf(" MSE=%.6f\n", mse);
 
-    if (mse >= 0.0001) {
+    if (mse >= (sc16_samples ? SC16_MAX_MSE : 0.0001)) {
       printf("MSE too large\n");
       exit(-1);
     }
@@ -190,6 +223,7 @@ int main(int argc, char** argv)
     free(input);
     free(outfft);
     free(outifft);
+    free(wire);
 
     n_prb++;
   }
@@ -29,6 +29,9 @@
 #define CURRENT_FFTSIZE srsran_symbol_sz(q->cell.nof_prb)
 #define CURRENT_SFLEN_RE SRSRAN_NOF_RE(q->cell)
 
+// Number of ACK/NACKs whose PHICH resources are computed and encoded together
+#define SRSRAN_ENB_DL_MAX_PHICH_BATCH 64
+
 static float enb_dl_get_norm_factor(uint32_t nof_prb)
 {
   return 0.05f / sqrtf(nof_prb);
@@ -137,11 +140,45 @@ void srsran_enb_dl_free(srsran_enb_dl_t* q)
       if (q->sf_symbols[i]) {
         free(q->sf_symbols[i]);
       }
+      if (q->crs_signal_td[i]) {
+        free(q->crs_signal_td[i]);
+      }
+      if (q->base_symbols[i]) {
+        free(q->base_symbols[i]);
+      }
     }
     bzero(q, sizeof(srsran_enb_dl_t));
   }
 }
 
+// The base signals only depend on the cell and the subframe index, they are mapped once for the whole radio frame
+static int enb_dl_gen_base_symbols(srsran_enb_dl_t* q)
+{
+  srsran_dl_sf_cfg_t dl_sf = {};
+  for (uint32_t p = 0; p < q->cell.nof_ports; p++) {
+    if (q->base_symbols[p]) {
+      free(q->base_symbols[p]);
+    }
+    q->base_symbols[p] = srsran_vec_cf_malloc(SRSRAN_NOF_SF_X_FRAME * CURRENT_SFLEN_RE);
+    if (q->base_symbols[p] == NULL) {
+      ERROR("Error allocating memory");
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+      cf_t* sf_symbols = &q->base_symbols[p][sf_idx * CURRENT_SFLEN_RE];
+      srsran_vec_cf_zero(sf_symbols, CURRENT_SFLEN_RE);
+      if (sf_idx == 0 || sf_idx == 5) {
+        srsran_pss_put_slot(q->pss_signal, sf_symbols, q->cell.nof_prb, q->cell.cp);
+        srsran_sss_put_slot(sf_idx ? q->sss_signal5 : q->sss_signal0, sf_symbols, q->cell.nof_prb, q->cell.cp);
+      }
+      dl_sf.tti = sf_idx;
+      srsran_refsignal_cs_put_sf(&q->csr_signal, &dl_sf, p, sf_symbols);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -225,11 +262,19 @@ int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell)
       srsran_pss_generate(q->pss_signal, cell.id % 3);
       srsran_sss_generate(q->sss_signal0, q->sss_signal5, cell.id);
 
+      if (enb_dl_gen_base_symbols(q)) {
+        return SRSRAN_ERROR;
+      }
+
       // Calculate common DCI locations
       for (int32_t cfi = 1; cfi <= 3; cfi++) {
         q->nof_common_locations[SRSRAN_CFI_IDX(cfi)] = srsran_pdcch_common_locations(
             &q->pdcch, q->common_locations[SRSRAN_CFI_IDX(cfi)], SRSRAN_MAX_CANDIDATES_COM, cfi);
       }
+
+      if (q->sparse_tx && srsran_enb_dl_set_sparse_tx(q, true)) {
+        return SRSRAN_ERROR;
+      }
     }
     ret = SRSRAN_SUCCESS;
 
@@ -264,6 +309,46 @@ int srsran_enb_dl_set_cfr(srsran_enb_dl_t* q, const srsran_cfr_cfg_t* cfr)
   return SRSRAN_SUCCESS;
 }
 
+int srsran_enb_dl_set_sparse_tx(srsran_enb_dl_t* q, bool enable)
+{
+  if (q == NULL || q->cell.nof_prb == 0) {
+    ERROR("Error, invalid inputs");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  q->sparse_tx = enable;
+  if (!enable) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Modulate the CRS of every subframe index alone, the grid is cleared by the next srsran_enb_dl_put_base_signals()
+  float              norm_factor = enb_dl_get_norm_factor(q->cell.nof_prb);
+  srsran_dl_sf_cfg_t dl_sf       = {};
+  for (uint32_t p = 0; p < q->cell.nof_ports; p++) {
+    srsran_ofdm_t* ifft = &q->ifft[p];
+    if (q->crs_signal_td[p]) {
+      free(q->crs_signal_td[p]);
+    }
+    q->crs_signal_td[p] = srsran_vec_cf_malloc(SRSRAN_NOF_SF_X_FRAME * ifft->sf_sz);
+    if (q->crs_signal_td[p] == NULL) {
+      ERROR("Error allocating memory");
+      q->sparse_tx = false;
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+      dl_sf.tti = sf_idx;
+      srsran_vec_cf_zero(q->sf_symbols[p], CURRENT_SFLEN_RE);
+      srsran_refsignal_cs_put_sf(&q->csr_signal, &dl_sf, p, q->sf_symbols[p]);
+      srsran_vec_sc_prod_cfc(q->sf_symbols[p], norm_factor, q->sf_symbols[p], CURRENT_SFLEN_RE);
+      srsran_ofdm_tx_sf(ifft);
+      srsran_vec_cf_copy(&q->crs_signal_td[p][sf_idx * ifft->sf_sz], ifft->cfg.out_buffer, ifft->sf_sz);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 #ifdef resolve
 void srsran_enb_dl_apply_power_allocation(srsran_enb_dl_t* q)
 {
@@ -323,17 +408,35 @@ void srsran_enb_dl_prepare_power_allocation(srsran_enb_dl_t* q)
 
 #endif
 
+static void set_busy_symbols(srsran_enb_dl_t* q, uint32_t first, uint32_t last)
+{
+  for (uint32_t l = first; l < last; l++) {
+    q->busy_symbols |= 1U << l;
+  }
+}
+
 static void clear_sf(srsran_enb_dl_t* q)
 {
+  q->busy_symbols = 0;
   for (int i = 0; i < q->cell.nof_ports; i++) {
     srsran_vec_cf_zero(q->sf_symbols[i], CURRENT_SFLEN_RE);
   }
 }
 
+static void set_busy_sync(srsran_enb_dl_t* q)
+{
+  uint32_t sf_idx = q->dl_sf.tti % 10;
+
+  if (sf_idx == 0 || sf_idx == 5) {
+    set_busy_symbols(q, SRSRAN_CP_NSYMB(q->cell.cp) - 2, SRSRAN_CP_NSYMB(q->cell.cp));
+  }
+}
+
 static void put_sync(srsran_enb_dl_t* q)
 {
   uint32_t sf_idx = q->dl_sf.tti % 10;
 
+  set_busy_sync(q);
   if (sf_idx == 0 || sf_idx == 5) {
     for (int p = 0; p < q->cell.nof_ports; p++) {
       srsran_pss_put_slot(q->pss_signal, q->sf_symbols[p], q->cell.nof_prb, q->cell.cp);
@@ -355,6 +458,32 @@ static void put_refs(srsran_enb_dl_t* q)
   }
 }
 
+// The precomputed base signals have all the CRS symbols, which TDD special subframes may not have
+static bool base_symbols_match(srsran_enb_dl_t* q)
+{
+  if (q->dl_sf.sf_type != SRSRAN_SF_NORM) {
+    return false;
+  }
+  for (uint32_t p = 0; p < q->cell.nof_ports; p++) {
+    uint32_t nof_crs_symbols = srsran_refsignal_cs_nof_symbols(&q->csr_signal, &q->dl_sf, p);
+    if (q->base_symbols[p] == NULL || nof_crs_symbols != (p < 2 ? 4 : 2)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void copy_base_symbols(srsran_enb_dl_t* q)
+{
+  uint32_t sf_idx = q->dl_sf.tti % 10;
+
+  q->busy_symbols = 0;
+  set_busy_sync(q);
+  for (int p = 0; p < q->cell.nof_ports; p++) {
+    srsran_vec_cf_copy(q->sf_symbols[p], &q->base_symbols[p][sf_idx * CURRENT_SFLEN_RE], CURRENT_SFLEN_RE);
+  }
+}
+
 static void put_mib(srsran_enb_dl_t* q)
 {
   uint8_t bch_payload[SRSRAN_BCH_PAYLOAD_LEN];
@@ -363,6 +492,7 @@ static void put_mib(srsran_enb_dl_t* q)
   uint32_t sfn    = q->dl_sf.tti / 10;
 
   if (sf_idx == 0) {
+    set_busy_symbols(q, SRSRAN_CP_NSYMB(q->cell.cp), SRSRAN_CP_NSYMB(q->cell.cp) + 4);
     srsran_pbch_mib_pack(&q->cell, sfn, bch_payload);
     srsran_pbch_encode(&q->pbch, bch_payload, q->sf_symbols, sfn % 4);
   }
@@ -370,17 +500,33 @@ static void put_mib(srsran_enb_dl_t* q)
 
 static void put_pcfich(srsran_enb_dl_t* q)
 {
+  set_busy_symbols(q, 0, 1);
   srsran_pcfich_encode(&q->pcfich, &q->dl_sf, q->sf_symbols);
 }
 
 void srsran_enb_dl_put_base(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf)
+{
+  srsran_enb_dl_put_base_signals(q, dl_sf);
+  put_pcfich(q);
+}
+
+void srsran_enb_dl_put_base_signals(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf)
 {
   srsran_ofdm_set_non_mbsfn_region(&q->ifft_mbsfn, dl_sf->non_mbsfn_region);
   q->dl_sf = *dl_sf;
-  clear_sf(q);
-  put_sync(q);
-  put_refs(q);
+  if (base_symbols_match(q)) {
+    copy_base_symbols(q);
+  } else {
+    clear_sf(q);
+    put_sync(q);
+    put_refs(q);
+  }
   put_mib(q);
+}
+
+void srsran_enb_dl_put_cfi(srsran_enb_dl_t* q, uint32_t cfi)
+{
+  q->dl_sf.cfi = cfi;
   put_pcfich(q);
 }
 
@@ -388,9 +534,31 @@ void srsran_enb_dl_put_phich(srsran_enb_dl_t* q, srsran_phich_grant_t* grant, bo
 {
   srsran_phich_resource_t resource;
   srsran_phich_calc(&q->phich, grant, &resource);
+  set_busy_symbols(q, 0, q->cell.phich_length == SRSRAN_PHICH_EXT ? 3 : 1);
   srsran_phich_encode(&q->phich, &q->dl_sf, resource, ack, q->sf_symbols);
 }
 
+int srsran_enb_dl_put_phich_batch(srsran_enb_dl_t*      q,
+                                  srsran_phich_grant_t* grants,
+                                  const uint8_t*        acks,
+                                  uint32_t              nof_acks)
+{
+  srsran_phich_resource_t resources[SRSRAN_ENB_DL_MAX_PHICH_BATCH];
+
+  set_busy_symbols(q, 0, q->cell.phich_length == SRSRAN_PHICH_EXT ? 3 : 1);
+  for (uint32_t offset = 0; offset < nof_acks; offset += SRSRAN_ENB_DL_MAX_PHICH_BATCH) {
+    uint32_t n = SRSRAN_MIN(nof_acks - offset, SRSRAN_ENB_DL_MAX_PHICH_BATCH);
+    for (uint32_t i = 0; i < n; i++) {
+      srsran_phich_calc(&q->phich, &grants[offset + i], &resources[i]);
+    }
+    if (srsran_phich_encode_batch(&q->phich, &q->dl_sf, resources, &acks[offset], n, q->sf_symbols) <
+        SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 bool srsran_enb_dl_location_is_common_ncce(srsran_enb_dl_t* q, const srsran_dci_location_t* loc)
 {
   if (SRSRAN_CFI_ISVALID(q->dl_sf.cfi)) {
@@ -401,6 +569,45 @@ bool srsran_enb_dl_location_is_common_ncce(srsran_enb_dl_t* q, const srsran_dci_
   }
 }
 
+int srsran_enb_dl_pack_pdcch_dl(srsran_enb_dl_t*  q,
+                                srsran_dci_cfg_t* dci_cfg,
+                                srsran_dci_dl_t*  dci_dl,
+                                srsran_dci_msg_t* msg)
+{
+  ZERO_OBJECT(*msg);
+  if (srsran_dci_msg_pack_pdsch(&q->cell, &q->dl_sf, dci_cfg, dci_dl, msg)) {
+    ERROR("Error packing DL DCI");
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_enb_dl_pack_pdcch_ul(srsran_enb_dl_t*  q,
+                                srsran_dci_cfg_t* dci_cfg,
+                                srsran_dci_ul_t*  dci_ul,
+                                srsran_dci_msg_t* msg)
+{
+  ZERO_OBJECT(*msg);
+  if (srsran_dci_msg_pack_pusch(&q->cell, &q->dl_sf, dci_cfg, dci_ul, msg)) {
+    ERROR("Error packing UL DCI");
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_enb_dl_put_pdcch_batch(srsran_enb_dl_t* q, srsran_dci_msg_t* msgs, uint32_t nof_msgs)
+{
+  if (nof_msgs == 0) {
+    return SRSRAN_SUCCESS;
+  }
+  set_busy_symbols(q, 0, SRSRAN_NOF_CTRL_SYMBOLS(q->cell, q->dl_sf.cfi));
+  if (srsran_pdcch_encode_batch(&q->pdcch, &q->dl_sf, msgs, nof_msgs, q->sf_symbols)) {
+    ERROR("Error encoding DCI messages");
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_enb_dl_put_pdcch_dl(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, srsran_dci_dl_t* dci_dl)
 {
   srsran_dci_msg_t dci_msg;
@@ -409,6 +616,7 @@ int srsran_enb_dl_put_pdcch_dl(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, sr
   if (srsran_dci_msg_pack_pdsch(&q->cell, &q->dl_sf, dci_cfg, dci_dl, &dci_msg)) {
     ERROR("Error packing DL DCI");
   }
+  set_busy_symbols(q, 0, SRSRAN_NOF_CTRL_SYMBOLS(q->cell, q->dl_sf.cfi));
   if (srsran_pdcch_encode(&q->pdcch, &q->dl_sf, &dci_msg, q->sf_symbols)) {
     ERROR("Error encoding DL DCI message");
     return SRSRAN_ERROR;
@@ -425,6 +633,7 @@ int srsran_enb_dl_put_pdcch_ul(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, sr
   if (srsran_dci_msg_pack_pusch(&q->cell, &q->dl_sf, dci_cfg, dci_ul, &dci_msg)) {
     ERROR("Error packing UL DCI");
   }
+  set_busy_symbols(q, 0, SRSRAN_NOF_CTRL_SYMBOLS(q->cell, q->dl_sf.cfi));
   if (srsran_pdcch_encode(&q->pdcch, &q->dl_sf, &dci_msg, q->sf_symbols)) {
     ERROR("Error encoding UL DCI message");
     return SRSRAN_ERROR;
@@ -435,33 +644,75 @@ int srsran_enb_dl_put_pdcch_ul(srsran_enb_dl_t* q, srsran_dci_cfg_t* dci_cfg, sr
 
 int srsran_enb_dl_put_pdsch(srsran_enb_dl_t* q, srsran_pdsch_cfg_t* pdsch, uint8_t* data[SRSRAN_MAX_CODEWORDS])
 {
+  set_busy_symbols(q,
+                   SRSRAN_NOF_CTRL_SYMBOLS(q->cell, q->dl_sf.cfi),
+                   SRSRAN_CP_NSYMB(q->cell.cp) + pdsch->grant.nof_symb_slot[1]);
   return srsran_pdsch_encode(&q->pdsch, &q->dl_sf, pdsch, data, q->sf_symbols);
 }
 
 int srsran_enb_dl_put_pmch(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data)
 {
+  set_busy_symbols(q, 0, SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NSYMB(q->cell.cp));
   return srsran_pmch_encode(&q->pmch, &q->dl_sf, pmch_cfg, data, q->sf_symbols);
 }
 
-void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
+static void enb_dl_gen_signal_sparse(srsran_enb_dl_t* q, uint32_t port_idx, float norm_factor)
+{
+  srsran_ofdm_t* ifft      = &q->ifft[port_idx];
+  uint32_t       nof_re    = SRSRAN_NRE * q->cell.nof_prb;
+  uint32_t       nof_symb  = SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NSYMB(q->cell.cp);
+  const cf_t*    crs_td    = &q->crs_signal_td[port_idx][(q->dl_sf.tti % SRSRAN_NOF_SF_X_FRAME) * ifft->sf_sz];
+  uint32_t       crs_symbs = 0;
+
+  // TDD special subframes may carry fewer CRS symbols than the precomputed signal
+  for (uint32_t l = 0; l < srsran_refsignal_cs_nof_symbols(&q->csr_signal, &q->dl_sf, port_idx); l++) {
+    crs_symbs |= 1U << srsran_refsignal_cs_nsymbol(l, q->cell.cp, port_idx);
+  }
+
+  for (uint32_t l = 0; l < nof_symb; l++) {
+    uint32_t offset = srsran_ofdm_get_symbol_offset(ifft, l);
+    uint32_t len    = (l + 1 < nof_symb ? srsran_ofdm_get_symbol_offset(ifft, l + 1) : ifft->sf_sz) - offset;
+
+    if (q->busy_symbols & (1U << l)) {
+      cf_t* symbol = &ifft->cfg.in_buffer[l * nof_re];
+      srsran_vec_sc_prod_cfc(symbol, norm_factor, symbol, nof_re);
+      srsran_ofdm_tx_symbol(ifft, l);
+    } else if (crs_symbs & (1U << l)) {
+      srsran_vec_cf_copy(&ifft->cfg.out_buffer[offset], &crs_td[offset], len);
+    } else {
+      srsran_vec_cf_zero(&ifft->cfg.out_buffer[offset], len);
+    }
+  }
+}
+
+void srsran_enb_dl_gen_signal_port(srsran_enb_dl_t* q, uint32_t port_idx)
 {
   float norm_factor = enb_dl_get_norm_factor(q->cell.nof_prb);
 
   // First apply the amplitude normalization, then perform the IFFT and optional CFR reduction
   if (q->dl_sf.sf_type == SRSRAN_SF_MBSFN) {
-    srsran_vec_sc_prod_cfc(q->ifft_mbsfn.cfg.in_buffer,
-                           norm_factor,
-                           q->ifft_mbsfn.cfg.in_buffer,
-                           SRSRAN_NOF_SLOTS_PER_SF * q->cell.nof_prb * SRSRAN_NRE * SRSRAN_CP_NSYMB(q->cell.cp));
-    srsran_ofdm_tx_sf(&q->ifft_mbsfn);
-  } else {
-    for (int i = 0; i < q->cell.nof_ports; i++) {
-      srsran_vec_sc_prod_cfc(q->ifft[i].cfg.in_buffer,
+    if (port_idx == 0) {
+      srsran_vec_sc_prod_cfc(q->ifft_mbsfn.cfg.in_buffer,
                              norm_factor,
-                             q->ifft[i].cfg.in_buffer,
+                             q->ifft_mbsfn.cfg.in_buffer,
                              SRSRAN_NOF_SLOTS_PER_SF * q->cell.nof_prb * SRSRAN_NRE * SRSRAN_CP_NSYMB(q->cell.cp));
-      srsran_ofdm_tx_sf(&q->ifft[i]);
+      srsran_ofdm_tx_sf(&q->ifft_mbsfn);
     }
+  } else if (port_idx < q->cell.nof_ports && q->sparse_tx && !q->cfr_config.cfr_enable) {
+    enb_dl_gen_signal_sparse(q, port_idx, norm_factor);
+  } else if (port_idx < q->cell.nof_ports) {
+    srsran_vec_sc_prod_cfc(q->ifft[port_idx].cfg.in_buffer,
+                           norm_factor,
+                           q->ifft[port_idx].cfg.in_buffer,
+                           SRSRAN_NOF_SLOTS_PER_SF * q->cell.nof_prb * SRSRAN_NRE * SRSRAN_CP_NSYMB(q->cell.cp));
+    srsran_ofdm_tx_sf(&q->ifft[port_idx]);
+  }
+}
+
+void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
+{
+  for (uint32_t i = 0; i < q->cell.nof_ports; i++) {
+    srsran_enb_dl_gen_signal_port(q, i);
   }
 }
 
@@ -148,11 +148,23 @@ int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
   return ret;
 }
 
+void srsran_enb_ul_rem_rnti(srsran_enb_ul_t* q, uint16_t rnti)
+{
+  if (q != NULL) {
+    srsran_pusch_rem_rnti(&q->pusch, rnti);
+  }
+}
+
 void srsran_enb_ul_fft(srsran_enb_ul_t* q)
 {
   srsran_ofdm_rx_sf(&q->fft);
 }
 
+void srsran_enb_ul_fft_sc16(srsran_enb_ul_t* q, const int16_t* input, float scale)
+{
+  srsran_ofdm_rx_sf_sc16(&q->fft, input, scale);
+}
+
 static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch_cfg_t* cfg, srsran_pucch_res_t* res)
 {
   int      ret                               = SRSRAN_SUCCESS;
@@ -277,7 +289,16 @@ int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                             srsran_pusch_cfg_t* cfg,
                             srsran_pusch_res_t* res)
 {
-  srsran_chest_ul_estimate_pusch(&q->chest, ul_sf, cfg, q->sf_symbols, &q->chest_res);
+  return srsran_enb_ul_get_pusch_grid(q, ul_sf, cfg, q->sf_symbols, res);
+}
+
+int srsran_enb_ul_get_pusch_grid(srsran_enb_ul_t*    q,
+                                 srsran_ul_sf_cfg_t* ul_sf,
+                                 srsran_pusch_cfg_t* cfg,
+                                 cf_t*               sf_symbols,
+                                 srsran_pusch_res_t* res)
+{
+  srsran_chest_ul_estimate_pusch(&q->chest, ul_sf, cfg, sf_symbols, &q->chest_res);
 
-  return srsran_pusch_decode(&q->pusch, ul_sf, cfg, &q->chest_res, q->sf_symbols, res);
+  return srsran_pusch_decode(&q->pusch, ul_sf, cfg, &q->chest_res, sf_symbols, res);
 }
@@ -24,6 +24,7 @@
 #include "srsran/phy/fec/turbo/turbodecoder_gen.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
+#include <pthread.h>
 #include <strings.h>
 
 /**
@@ -118,16 +119,23 @@ int srsran_cbsegm(srsran_cbsegm_t* s, uint32_t tbs)
 
 int srsran_cbsegm_cbindex(uint32_t long_cb)
 {
-  int j = 0;
-  while (j < SRSRAN_NOF_TC_CB_SIZES && tc_cb_sizes[j] < long_cb) {
-    j++;
+  // The sizes of Table 5.1.3-3 go in steps of 8, 16, 32 and 64 bits up to 512, 1024, 2048 and 6144 bits
+  if (long_cb <= 40) {
+    return 0;
   }
-
-  if (j == SRSRAN_NOF_TC_CB_SIZES) {
-    return SRSRAN_ERROR;
-  } else {
-    return j;
+  if (long_cb <= 512) {
+    return (int)SRSRAN_CEIL(long_cb - 40, 8);
+  }
+  if (long_cb <= 1024) {
+    return 59 + (int)SRSRAN_CEIL(long_cb - 512, 16);
+  }
+  if (long_cb <= 2048) {
+    return 91 + (int)SRSRAN_CEIL(long_cb - 1024, 32);
+  }
+  if (long_cb <= 6144) {
+    return 123 + (int)SRSRAN_CEIL(long_cb - 2048, 64);
   }
+  return SRSRAN_ERROR;
 }
 
 int srsran_cbsegm_cbsize(uint32_t index)
@@ -141,12 +149,26 @@ int srsran_cbsegm_cbsize(uint32_t index)
 
 bool srsran_cbsegm_cbsize_isvalid(uint32_t size)
 {
-  for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
-    if (tc_cb_sizes[i] == size) {
-      return true;
+  int idx = srsran_cbsegm_cbindex(size);
+  return idx >= 0 && tc_cb_sizes[idx] == size;
+}
+
+/**
+ * @brief Smallest valid lifting size that is not less than each index, 0 if there is none. It is filled once, the
+ * first time a LDPC segmentation is computed
+ */
+static uint16_t       cbsegm_ldpc_next_ls[MAX_LIFTSIZE + 1] = {};
+static pthread_once_t cbsegm_ldpc_next_ls_once              = PTHREAD_ONCE_INIT;
+
+static void cbsegm_ldpc_next_ls_init(void)
+{
+  uint16_t next = 0;
+  for (int Z = MAX_LIFTSIZE; Z >= 0; Z--) {
+    if (get_ls_index((uint16_t)Z) != VOID_LIFTSIZE) {
+      next = (uint16_t)Z;
     }
+    cbsegm_ldpc_next_ls[Z] = next;
   }
-  return false;
 }
 
 /**
@@ -163,28 +185,22 @@ static int cbsegm_ldpc_select_ls(uint32_t Kp, uint32_t K_b, uint32_t* Z_c, uint8
     return SRSRAN_ERROR;
   }
 
-  // Iterate from the minimum required lift size to the maximum value
-  for (uint16_t Z = SRSRAN_CEIL(Kp, K_b); Z <= MAX_LIFTSIZE; Z++) {
-    // Get index for a selected lifting size
-    uint8_t i = get_ls_index(Z);
-
-    // If the lifting index is valid, save outputs and return
-    if (i != VOID_LIFTSIZE) {
-      if (i_ls) {
-        *i_ls = i;
-      }
-
-      if (Z_c) {
-        *Z_c = Z;
-      }
+  // Look up the smallest valid lift size from the minimum required one
+  pthread_once(&cbsegm_ldpc_next_ls_once, cbsegm_ldpc_next_ls_init);
+  uint16_t Z = cbsegm_ldpc_next_ls[SRSRAN_CEIL(Kp, K_b)];
+  if (Z == 0) {
+    return SRSRAN_ERROR;
+  }
 
-      return SRSRAN_SUCCESS;
-    }
+  if (i_ls) {
+    *i_ls = get_ls_index(Z);
+  }
 
-    // Otherwise continue...
+  if (Z_c) {
+    *Z_c = Z;
   }
 
-  return SRSRAN_ERROR;
+  return SRSRAN_SUCCESS;
 }
 
 /**
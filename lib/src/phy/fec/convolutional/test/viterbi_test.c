@@ -37,6 +37,8 @@ static float    ebno_db     = 100.0;
 static uint32_t seed        = 0;
 static bool     tail_biting = false;
 
+#define BATCH_SIZE 20
+
 #define SNR_POINTS 10
 #define SNR_MIN 0.0
 #define SNR_MAX 5.0
@@ -114,6 +116,11 @@ int main(int argc, char** argv)
   int       errors_c   = 0;
   int       errors_f   = 0;
   int       errors_sse = 0;
+  int       errors_b   = 0;
+  float*    llr_b[BATCH_SIZE];
+  uint8_t*  data_f_b[BATCH_SIZE];
+  uint8_t*  data_rx_b[BATCH_SIZE];
+  uint32_t  nof_b = 0;
 #ifdef TEST_SSE
   srsran_viterbi_t dec_sse;
 #endif
@@ -186,6 +193,16 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  for (uint32_t b = 0; b < BATCH_SIZE; b++) {
+    llr_b[b]     = srsran_vec_f_malloc(coded_length);
+    data_f_b[b]  = srsran_vec_u8_malloc(frame_length);
+    data_rx_b[b] = srsran_vec_u8_malloc(frame_length);
+    if (!llr_b[b] || !data_f_b[b] || !data_rx_b[b]) {
+      perror("malloc");
+      exit(-1);
+    }
+  }
+
   float ebno_inc, esno_db;
   ebno_inc = (SNR_MAX - SNR_MIN) / SNR_POINTS;
   if (ebno_db == 100.0) {
@@ -244,6 +261,20 @@ int main(int argc, char** argv)
 #ifdef TEST_SSE
       VITERBI_TEST(srsran_viterbi_decode_uc, dec_sse, llr_c, errors_sse);
 #endif
+
+      // Batch decoding must give the same bits as decoding every frame on its own
+      srsran_vec_f_copy(llr_b[nof_b], llr, coded_length);
+      memcpy(data_f_b[nof_b], data_rx, frame_length);
+      nof_b++;
+      if (nof_b == BATCH_SIZE || frame_cnt + 1 == nof_frames) {
+        if (srsran_viterbi_decode_batch_f(&dec, llr_b, data_rx_b, nof_b, frame_length) < SRSRAN_SUCCESS) {
+          errors_b = -1;
+        }
+        for (uint32_t b = 0; b < nof_b && errors_b >= 0; b++) {
+          errors_b += srsran_bit_diff(data_f_b[b], data_rx_b[b], frame_length);
+        }
+        nof_b = 0;
+      }
       frame_cnt++;
       printf("     Eb/No: %3.2f %10d/%d   ", SNR_MIN + i * ebno_inc, frame_cnt, nof_frames);
       if (errors_s >= 0)
@@ -273,6 +304,7 @@ int main(int argc, char** argv)
 #ifdef TEST_SSE
       printf("sse    BER    :    %g\t%u errors\n", (float)errors_sse / (frame_cnt * frame_length), errors_sse);
 #endif
+      printf("batch mismatch:    %d bits\n", errors_b);
     }
   }
   srsran_viterbi_free(&dec);
@@ -287,6 +319,11 @@ int main(int argc, char** argv)
   free(llr_s);
   free(llr_us);
   free(data_rx);
+  for (uint32_t b = 0; b < BATCH_SIZE; b++) {
+    free(llr_b[b]);
+    free(data_f_b[b]);
+    free(data_rx_b[b]);
+  }
 
   if (snr_points == 1) {
     int expected_e = get_expected_errors(nof_frames, seed, frame_length, tail_biting, ebno_db);
@@ -302,6 +339,7 @@ int main(int argc, char** argv)
       passed &= (bool)(errors_c <= expected_e);
       passed &= (bool)(errors_f <= expected_e);
       passed &= (bool)(errors_sse <= expected_e);
+      passed &= (bool)(errors_b == 0);
       exit(!passed);
     }
   } else {
@@ -156,6 +156,13 @@ int decode37_avx2_16bit(void* o, uint16_t* symbols, uint8_t* data, uint32_t fram
   return q->framebits;
 }
 
+int decode37_avx2_batch(void* o, uint16_t* const* symbols, uint8_t* const* data, uint32_t nof_cw, uint32_t frame_length)
+{
+  srsran_viterbi_t* q = o;
+
+  return decode_viterbi37_avx2_batch(q->ptr_batch, symbols, data, nof_cw, frame_length, q->tail_biting ? TB_ITER : 0);
+}
+
 void free37_avx2_16bit(void* o)
 {
   srsran_viterbi_t* q = o;
@@ -172,6 +179,10 @@ void free37_avx2_16bit(void* o)
   if (q->tmp_s) {
     free(q->tmp_s);
   }
+  if (q->symbols_batch) {
+    free(q->symbols_batch);
+  }
+  delete_viterbi37_avx2_batch(q->ptr_batch);
   delete_viterbi37_avx2_16bit(q->ptr);
 }
 
@@ -439,12 +450,14 @@ int init37_avx2_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool
   q->gain_quant_s = 4;
   q->gain_quant   = DEFAULT_GAIN_16;
   q->tail_biting  = tail_biting;
-  q->decode_s     = decode37_avx2_16bit;
-  q->free         = free37_avx2_16bit;
-  q->decode_f     = NULL;
-  q->symbols_uc   = srsran_vec_u8_malloc(3 * (q->framebits + q->K - 1));
-  q->symbols_us   = srsran_vec_u16_malloc(3 * (q->framebits + q->K - 1));
-  if (!q->symbols_uc || !q->symbols_us) {
+  q->decode_s       = decode37_avx2_16bit;
+  q->decode_batch_s = decode37_avx2_batch;
+  q->free           = free37_avx2_16bit;
+  q->decode_f       = NULL;
+  q->symbols_uc     = srsran_vec_u8_malloc(3 * (q->framebits + q->K - 1));
+  q->symbols_us     = srsran_vec_u16_malloc(3 * (q->framebits + q->K - 1));
+  q->symbols_batch  = srsran_vec_u16_malloc(VITERBI37_AVX2_BATCH_SIZE * 3 * (q->framebits + q->K - 1));
+  if (!q->symbols_uc || !q->symbols_us || !q->symbols_batch) {
     perror("malloc");
     return -1;
   }
@@ -464,9 +477,13 @@ int init37_avx2_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool
     ERROR("create_viterbi37 failed");
     free37(q);
     return -1;
-  } else {
-    return 0;
   }
+  if ((q->ptr_batch = create_viterbi37_avx2_batch(poly, framebits)) == NULL) {
+    ERROR("create_viterbi37_avx2_batch failed");
+    free37_avx2_16bit(q);
+    return -1;
+  }
+  return 0;
 }
 
 #endif
@@ -575,6 +592,66 @@ int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data,
   }
 }
 
+/* symbols are real-valued, frames are decoded in groups sharing the SIMD registers when supported */
+int srsran_viterbi_decode_batch_f(srsran_viterbi_t* q,
+                                  float* const*     symbols,
+                                  uint8_t* const*   data,
+                                  uint32_t          nof_frames,
+                                  uint32_t          frame_length)
+{
+  if (q == NULL || symbols == NULL || data == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (frame_length > q->framebits) {
+    ERROR("Initialized decoder for max frame length %d bits", q->framebits);
+    return SRSRAN_ERROR;
+  }
+
+  if (!q->decode_batch_s) {
+    for (uint32_t i = 0; i < nof_frames; i++) {
+      if (srsran_viterbi_decode_f(q, symbols[i], data[i], frame_length) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+#ifdef LV_HAVE_AVX2
+  uint32_t len = q->tail_biting ? 3 * frame_length : 3 * (frame_length + q->K - 1);
+
+  for (uint32_t i = 0; i < nof_frames; i += VITERBI37_AVX2_BATCH_SIZE) {
+    uint32_t  nof_cw = SRSRAN_MIN(VITERBI37_AVX2_BATCH_SIZE, nof_frames - i);
+    uint16_t* symbols_us[VITERBI37_AVX2_BATCH_SIZE];
+
+    if (nof_cw < VITERBI37_AVX2_BATCH_MIN) {
+      for (uint32_t j = 0; j < nof_cw; j++) {
+        if (srsran_viterbi_decode_f(q, symbols[i + j], data[i + j], frame_length) < SRSRAN_SUCCESS) {
+          return SRSRAN_ERROR;
+        }
+      }
+      continue;
+    }
+
+    // Quantize every frame with its own scale, as srsran_viterbi_decode_f() does
+    for (uint32_t j = 0; j < nof_cw; j++) {
+      float    max   = 1e-9;
+      uint32_t max_i = srsran_vec_max_abs_fi(symbols[i + j], len);
+      if (max_i < len && isnormal(symbols[i + j][max_i])) {
+        max = fabsf(symbols[i + j][max_i]);
+      }
+      symbols_us[j] = &q->symbols_batch[j * 3 * (q->framebits + q->K - 1)];
+      srsran_vec_quant_fus(symbols[i + j], symbols_us[j], q->gain_quant / max, 32767.5, 65535, len);
+    }
+
+    if (q->decode_batch_s(q, symbols_us, &data[i], nof_cw, frame_length) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  return SRSRAN_SUCCESS;
+}
+
 /* symbols are int16 */
 int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -82,4 +82,22 @@ void delete_viterbi37_avx2_16bit(void* p);
 
 int update_viterbi37_blk_avx2_16bit(void* p, uint16_t* syms, uint32_t nbits, uint32_t* best_state);
 
+/* Maximum number of frames decoded at once by decode_viterbi37_avx2_batch() */
+#define VITERBI37_AVX2_BATCH_SIZE 16
+
+/* Fewer frames are faster to decode one by one */
+#define VITERBI37_AVX2_BATCH_MIN 6
+
+void* create_viterbi37_avx2_batch(int polys[3], uint32_t framebits);
+
+void delete_viterbi37_avx2_batch(void* p);
+
+/* Decodes nof_cw frames of frame_length bits. Tail-biting frames are repeated tb_iter times, 0 means terminated */
+int decode_viterbi37_avx2_batch(void*            p,
+                                uint16_t* const* syms,
+                                uint8_t* const*  data,
+                                uint32_t         nof_cw,
+                                uint32_t         frame_length,
+                                uint32_t         tb_iter);
+
 #endif /* SRSRAN_VITERBI37_H_ */
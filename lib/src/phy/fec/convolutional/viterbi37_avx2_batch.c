@@ -0,0 +1,215 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/* r=1/3 k=7 Viterbi decoder processing several frames of the same length at once. Unlike the other
+ * implementations, which spread the 64 trellis states across the SIMD register, every 16-bit lane carries the
+ * path metrics of a different frame. Branch metrics, add-compare-select and decisions are the same as in
+ * viterbi37_avx2_16bit.c, so every frame decodes to exactly the same bits as it would on its own.
+ */
+
+#include "parity.h"
+#include "viterbi37.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LV_HAVE_AVX2
+
+#include <immintrin.h>
+
+#define NOF_STATES 64
+#define NOF_BUTTERFLIES (NOF_STATES / 2)
+
+/* State info for instance of the batch Viterbi decoder */
+struct v37_batch {
+  __m256i   metrics1[NOF_STATES];           /* path metric buffer 1, one frame per lane */
+  __m256i   metrics2[NOF_STATES];           /* path metric buffer 2, one frame per lane */
+  uint8_t   branch_idx[NOF_BUTTERFLIES];    /* encoder output bits of each butterfly */
+  __m256i*  symbols;                        /* interleaved symbols, 3 registers per bit */
+  uint32_t* decisions;                      /* NOF_BUTTERFLIES decision masks per bit */
+  uint32_t  framebits;
+};
+
+void* create_viterbi37_avx2_batch(int polys[3], uint32_t framebits)
+{
+  void*             p;
+  struct v37_batch* vp;
+
+  if (posix_memalign(&p, sizeof(__m256i), sizeof(struct v37_batch))) {
+    return NULL;
+  }
+  vp = (struct v37_batch*)p;
+
+  for (int b = 0; b < NOF_BUTTERFLIES; b++) {
+    vp->branch_idx[b] = 0;
+    for (int k = 0; k < 3; k++) {
+      if ((polys[k] < 0) ^ parity((2 * b) & polys[k])) {
+        vp->branch_idx[b] |= 1U << k;
+      }
+    }
+  }
+
+  vp->framebits = framebits;
+  if (posix_memalign(&p, sizeof(__m256i), 3 * (framebits + 6) * sizeof(__m256i))) {
+    free(vp);
+    return NULL;
+  }
+  vp->symbols = (__m256i*)p;
+
+  // Only the last three repetitions of a tail-biting frame are traced back
+  if (posix_memalign(&p, sizeof(__m256i), 3 * (framebits + 6) * NOF_BUTTERFLIES * sizeof(uint32_t))) {
+    free(vp->symbols);
+    free(vp);
+    return NULL;
+  }
+  vp->decisions = (uint32_t*)p;
+
+  return vp;
+}
+
+void delete_viterbi37_avx2_batch(void* p)
+{
+  struct v37_batch* vp = p;
+
+  if (vp != NULL) {
+    free(vp->decisions);
+    free(vp->symbols);
+    free(vp);
+  }
+}
+
+/* The decisions of the two states of a butterfly and all frames are packed in a single 32-bit mask */
+static inline uint32_t decision_bit(const uint32_t* d, uint32_t state, uint32_t cw)
+{
+  uint32_t pos = (cw & 7) + 8 * (state & 1) + 16 * (cw >> 3);
+  return (d[state >> 1] >> pos) & 1;
+}
+
+int decode_viterbi37_avx2_batch(void*            p,
+                                uint16_t* const* syms,
+                                uint8_t* const*  data,
+                                uint32_t         nof_cw,
+                                uint32_t         frame_length,
+                                uint32_t         tb_iter)
+{
+  struct v37_batch* vp = p;
+
+  if (vp == NULL || nof_cw > VITERBI37_AVX2_BATCH_SIZE || frame_length > vp->framebits) {
+    return -1;
+  }
+
+  uint32_t nof_syms  = tb_iter ? frame_length : frame_length + 6;
+  uint32_t nof_steps = tb_iter ? tb_iter * frame_length : frame_length + 6;
+
+  // First bit of the frame returned by the chainback and first trellis step it needs decisions from
+  uint32_t first_bit  = tb_iter ? (tb_iter / 2) * frame_length : 0;
+  uint32_t first_step = first_bit + 6;
+
+  /* Interleave the symbols of all frames, one frame per lane */
+  uint16_t* s = (uint16_t*)vp->symbols;
+  if (nof_cw < VITERBI37_AVX2_BATCH_SIZE) {
+    memset(s, 0, 3 * nof_syms * sizeof(__m256i));
+  }
+  for (uint32_t cw = 0; cw < nof_cw; cw++) {
+    for (uint32_t i = 0; i < 3 * nof_syms; i++) {
+      s[i * VITERBI37_AVX2_BATCH_SIZE + cw] = syms[cw][i];
+    }
+  }
+
+  /* All states start with the same path metric, init_viterbi37_avx2_16bit() clears them as well */
+  __m256i* old_metrics = vp->metrics1;
+  __m256i* new_metrics = vp->metrics2;
+  for (uint32_t i = 0; i < NOF_STATES; i++) {
+    old_metrics[i] = _mm256_setzero_si256();
+  }
+
+  const __m256i ones       = _mm256_set1_epi16(-1);
+  const __m256i max_metric = _mm256_set1_epi16(8191);
+
+  for (uint32_t t = 0, i = 0; t < nof_steps; t++) {
+    __m256i metric[8], m_metric[8];
+
+    /* Form the branch metrics of the 8 possible encoder outputs */
+    __m256i sym0v = vp->symbols[3 * i];
+    __m256i sym1v = vp->symbols[3 * i + 1];
+    __m256i sym2v = vp->symbols[3 * i + 2];
+    for (uint32_t c = 0; c < 8; c++) {
+      __m256i x0 = (c & 1) ? _mm256_xor_si256(sym0v, ones) : sym0v;
+      __m256i x1 = (c & 2) ? _mm256_xor_si256(sym1v, ones) : sym1v;
+      __m256i x2 = (c & 4) ? _mm256_xor_si256(sym2v, ones) : sym2v;
+
+      metric[c]   = _mm256_srli_epi16(_mm256_avg_epu16(x2, _mm256_avg_epu16(x0, x1)), 3);
+      m_metric[c] = _mm256_sub_epi16(max_metric, metric[c]);
+    }
+
+    if (++i == nof_syms) {
+      i = 0;
+    }
+
+    /* Decisions before the first traced back step are overwritten */
+    uint32_t* d = &vp->decisions[(t < first_step ? 0 : t - first_step) * NOF_BUTTERFLIES];
+
+    for (uint32_t b = 0; b < NOF_BUTTERFLIES; b++) {
+      __m256i bm  = metric[vp->branch_idx[b]];
+      __m256i mbm = m_metric[vp->branch_idx[b]];
+
+      /* Add branch metrics to path metrics */
+      __m256i m0 = _mm256_add_epi16(old_metrics[b], bm);
+      __m256i m1 = _mm256_add_epi16(old_metrics[b + NOF_BUTTERFLIES], mbm);
+      __m256i m2 = _mm256_add_epi16(old_metrics[b], mbm);
+      __m256i m3 = _mm256_add_epi16(old_metrics[b + NOF_BUTTERFLIES], bm);
+
+      /* Compare and select, using modulo arithmetic. Metrics are never normalized: the comparisons only depend on
+       * their differences, which stay well below 2^15 for the quantized symbols of srsran_viterbi_decode_batch_f() */
+      __m256i decision0 = _mm256_cmpgt_epi16(_mm256_sub_epi16(m0, m1), _mm256_setzero_si256());
+      __m256i decision1 = _mm256_cmpgt_epi16(_mm256_sub_epi16(m2, m3), _mm256_setzero_si256());
+
+      new_metrics[2 * b]     = _mm256_blendv_epi8(m0, m1, decision0);
+      new_metrics[2 * b + 1] = _mm256_blendv_epi8(m2, m3, decision1);
+
+      d[b] = (uint32_t)_mm256_movemask_epi8(_mm256_packs_epi16(decision0, decision1));
+    }
+
+    /* Swap pointers to old and new metrics */
+    __m256i* tmp = old_metrics;
+    old_metrics  = new_metrics;
+    new_metrics  = tmp;
+  }
+
+  /* Chainback from state 0, looking 6 bits past the end of the decisions as the other implementations do */
+  for (uint32_t cw = 0; cw < nof_cw; cw++) {
+    uint32_t state = 0;
+    for (uint32_t n = (tb_iter ? nof_steps : frame_length); n-- > first_bit;) {
+      uint32_t k = 0;
+      if (n + 6 < nof_steps) {
+        k = decision_bit(&vp->decisions[(n + 6 - first_step) * NOF_BUTTERFLIES], state, cw);
+      }
+      state = (state >> 1) | (k << 5);
+      if (n < first_bit + frame_length) {
+        data[cw][n - first_bit] = (uint8_t)k;
+      }
+    }
+  }
+
+  return 0;
+}
+
+#endif
@@ -22,11 +22,40 @@
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <string.h>
 
 #ifdef LV_HAVE_SSE
 #include <immintrin.h>
 #endif // LV_HAVE_SSE
 
+#if defined(LV_HAVE_SSE) && defined(__PCLMUL__)
+#define CRC_CLMUL
+#elif defined(HAVE_NEONv8) && defined(__ARM_FEATURE_CRYPTO)
+#include <arm_neon.h>
+#define CRC_PMULL
+#endif
+
+// Minimum number of bytes processed by folding, shorter buffers use the slicing-by-8 tables
+#define CRC_FOLD_MIN_BYTES 64
+
+// Number of bytes packed at once by srsran_crc_checksum()
+#define CRC_PACK_BYTES 512
+
+// Computes x^e mod P(x)
+static uint64_t crc_xpow_mod(srsran_crc_t* h, uint32_t e)
+{
+  uint64_t poly = (uint64_t)h->polynom | h->crchighbit << 1U;
+  uint64_t r    = 1;
+  for (uint32_t i = 0; i < e; i++) {
+    r <<= 1U;
+    if (r & (h->crchighbit << 1U)) {
+      r ^= poly;
+    }
+  }
+  return r;
+}
+
 static void gen_crc_table(srsran_crc_t* h)
 {
   uint32_t pad        = (h->order < 8) ? (8 - h->order) : 0;
@@ -45,6 +74,182 @@ static void gen_crc_table(srsran_crc_t* h)
     }
     h->table[i] = (crc >> pad) & h->crcmask;
   }
+
+  // Slicing-by-8 tables: table8[k][i] is the CRC of byte i followed by k zero bytes, left-aligned to 32 bits
+  uint32_t poly32 = (uint32_t)((uint64_t)h->polynom << (32U - h->order));
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t crc = i << 24U;
+    for (uint32_t j = 0; j < 8; j++) {
+      crc = (crc & 0x80000000U) ? (crc << 1U) ^ poly32 : (crc << 1U);
+    }
+    h->table8[0][i] = crc;
+  }
+  for (uint32_t k = 1; k < 8; k++) {
+    for (uint32_t i = 0; i < 256; i++) {
+      h->table8[k][i] = (h->table8[k - 1][i] << 8U) ^ h->table8[0][h->table8[k - 1][i] >> 24U];
+    }
+  }
+
+  // Folding a 128-bit block over 128 and 512 bits
+  h->fold[0] = crc_xpow_mod(h, 128);
+  h->fold[1] = crc_xpow_mod(h, 128 + 64);
+  h->fold[2] = crc_xpow_mod(h, 512);
+  h->fold[3] = crc_xpow_mod(h, 512 + 64);
+}
+
+// Updates a left-aligned CRC with whole bytes, 8 bytes at a time
+static uint32_t crc_slice8(const srsran_crc_t* h, uint32_t crc, const uint8_t* data, uint32_t nbytes)
+{
+  while (nbytes >= 8) {
+    uint32_t hi = crc ^ ((uint32_t)data[0] << 24U | (uint32_t)data[1] << 16U | (uint32_t)data[2] << 8U | data[3]);
+    crc = h->table8[7][hi >> 24U] ^ h->table8[6][(hi >> 16U) & 0xffU] ^ h->table8[5][(hi >> 8U) & 0xffU] ^
+          h->table8[4][hi & 0xffU] ^ h->table8[3][data[4]] ^ h->table8[2][data[5]] ^ h->table8[1][data[6]] ^
+          h->table8[0][data[7]];
+    data += 8;
+    nbytes -= 8;
+  }
+  while (nbytes--) {
+    crc = (crc << 8U) ^ h->table8[0][(crc >> 24U) ^ *(data++)];
+  }
+  return crc;
+}
+
+#ifdef CRC_CLMUL
+typedef __m128i crc_fold_t;
+
+// Loads 16 bytes as a polynomial, the MSB of the first byte being the highest degree coefficient
+static inline crc_fold_t crc_fold_load(const uint8_t* data)
+{
+  const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data), bswap);
+}
+
+static inline void crc_fold_store(crc_fold_t x, uint8_t* data)
+{
+  const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  _mm_storeu_si128((__m128i*)data, _mm_shuffle_epi8(x, bswap));
+}
+
+static inline crc_fold_t crc_fold_set(uint64_t lo, uint64_t hi)
+{
+  return _mm_set_epi64x((long long)hi, (long long)lo);
+}
+
+static inline crc_fold_t crc_fold_xor(crc_fold_t a, crc_fold_t b)
+{
+  return _mm_xor_si128(a, b);
+}
+
+// Multiplies the high and low halves of x by the high and low constants of k and adds them
+static inline crc_fold_t crc_fold_mul(crc_fold_t x, crc_fold_t k)
+{
+  return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+}
+#endif // CRC_CLMUL
+
+#ifdef CRC_PMULL
+typedef uint64x2_t crc_fold_t;
+
+static inline crc_fold_t crc_fold_load(const uint8_t* data)
+{
+  uint64x2_t x = vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(data)));
+  return vextq_u64(x, x, 1);
+}
+
+static inline void crc_fold_store(crc_fold_t x, uint8_t* data)
+{
+  vst1q_u8(data, vrev64q_u8(vreinterpretq_u8_u64(vextq_u64(x, x, 1))));
+}
+
+static inline crc_fold_t crc_fold_set(uint64_t lo, uint64_t hi)
+{
+  return vcombine_u64(vcreate_u64(lo), vcreate_u64(hi));
+}
+
+static inline crc_fold_t crc_fold_xor(crc_fold_t a, crc_fold_t b)
+{
+  return veorq_u64(a, b);
+}
+
+static inline crc_fold_t crc_fold_mul(crc_fold_t x, crc_fold_t k)
+{
+  poly128_t lo = vmull_p64((poly64_t)vgetq_lane_u64(x, 0), (poly64_t)vgetq_lane_u64(k, 0));
+  poly128_t hi = vmull_p64((poly64_t)vgetq_lane_u64(x, 1), (poly64_t)vgetq_lane_u64(k, 1));
+  return veorq_u64(vreinterpretq_u64_p128(lo), vreinterpretq_u64_p128(hi));
+}
+#endif // CRC_PMULL
+
+/* Updates a left-aligned CRC with whole bytes. Long buffers are folded four 128-bit blocks at a time with carry-less
+ * multiplications until a single block is left, which has the same remainder as the folded data. Such block and the
+ * remaining bytes are then processed with the tables. */
+static uint32_t crc_update_bytes(const srsran_crc_t* h, uint32_t crc, const uint8_t* data, uint32_t nbytes)
+{
+#if defined(CRC_CLMUL) || defined(CRC_PMULL)
+  if (nbytes >= CRC_FOLD_MIN_BYTES) {
+    const crc_fold_t k128 = crc_fold_set(h->fold[0], h->fold[1]);
+    const crc_fold_t k512 = crc_fold_set(h->fold[2], h->fold[3]);
+
+    // The current CRC is added to the first bits of data
+    crc_fold_t x0 = crc_fold_xor(crc_fold_load(data), crc_fold_set(0, (uint64_t)crc << 32U));
+    crc_fold_t x1 = crc_fold_load(data + 16);
+    crc_fold_t x2 = crc_fold_load(data + 32);
+    crc_fold_t x3 = crc_fold_load(data + 48);
+    data += 64;
+    nbytes -= 64;
+
+    while (nbytes >= 64) {
+      x0 = crc_fold_xor(crc_fold_mul(x0, k512), crc_fold_load(data));
+      x1 = crc_fold_xor(crc_fold_mul(x1, k512), crc_fold_load(data + 16));
+      x2 = crc_fold_xor(crc_fold_mul(x2, k512), crc_fold_load(data + 32));
+      x3 = crc_fold_xor(crc_fold_mul(x3, k512), crc_fold_load(data + 48));
+      data += 64;
+      nbytes -= 64;
+    }
+
+    x1 = crc_fold_xor(crc_fold_mul(x0, k128), x1);
+    x2 = crc_fold_xor(crc_fold_mul(x1, k128), x2);
+    x3 = crc_fold_xor(crc_fold_mul(x2, k128), x3);
+
+    while (nbytes >= 16) {
+      x3 = crc_fold_xor(crc_fold_mul(x3, k128), crc_fold_load(data));
+      data += 16;
+      nbytes -= 16;
+    }
+
+    uint8_t block[16];
+    crc_fold_store(x3, block);
+    crc = crc_slice8(h, 0, block, 16);
+  }
+#endif // defined(CRC_CLMUL) || defined(CRC_PMULL)
+
+  return crc_slice8(h, crc, data, nbytes);
+}
+
+// Packs nbytes * 8 bits, one per byte, into nbytes
+static void crc_pack_bits(const uint8_t* bits, uint8_t* packed, uint32_t nbytes)
+{
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX2
+  const __m256i rev = _mm256_set_epi8(
+      8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+  for (; i + 4 <= nbytes; i += 4) {
+    __m256i  v    = _mm256_cmpgt_epi8(_mm256_loadu_si256((const __m256i*)&bits[8 * i]), _mm256_setzero_si256());
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_shuffle_epi8(v, rev));
+    memcpy(&packed[i], &mask, sizeof(uint32_t));
+  }
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_SSE
+  const __m128i rev128 = _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+  for (; i + 2 <= nbytes; i += 2) {
+    __m128i  v    = _mm_cmpgt_epi8(_mm_loadu_si128((const __m128i*)&bits[8 * i]), _mm_setzero_si128());
+    uint16_t mask = (uint16_t)_mm_movemask_epi8(_mm_shuffle_epi8(v, rev128));
+    memcpy(&packed[i], &mask, sizeof(uint16_t));
+  }
+#endif // LV_HAVE_SSE
+  for (; i < nbytes; i++) {
+    uint8_t* ptr = (uint8_t*)&bits[8 * i];
+    packed[i]    = (uint8_t)(srsran_bit_pack(&ptr, 8) & 0xFF);
+  }
 }
 
 uint64_t reversecrcbit(uint32_t crc, int nbits, srsran_crc_t* h)
@@ -72,6 +277,11 @@ int srsran_crc_set_init(srsran_crc_t* crc_par, uint64_t crc_init_value)
 
 int srsran_crc_init(srsran_crc_t* h, uint32_t crc_poly, int crc_order)
 {
+  if (crc_order < 1 || crc_order > 32) {
+    ERROR("Invalid CRC order %d", crc_order);
+    return -1;
+  }
+
   // Set crc working default parameters
   h->polynom = crc_poly;
   h->order   = crc_order;
@@ -94,48 +304,29 @@ int srsran_crc_init(srsran_crc_t* h, uint32_t crc_poly, int crc_order)
 
 uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
 {
-  int      i, k, len8, res8, a = 0;
+  uint8_t  packed[CRC_PACK_BYTES];
   uint32_t crc = 0;
-  uint8_t* pter;
-
-  srsran_crc_set_init(h, 0);
 
-  // Pack bits into bytes
-  len8 = (len >> 3);
-  res8 = (len - (len8 << 3));
-  if (res8 > 0) {
-    a = 1;
+  // Pack bits into bytes and calculate CRC
+  uint32_t len8 = (uint32_t)len >> 3U;
+  uint32_t res8 = (uint32_t)len - (len8 << 3U);
+  for (uint32_t i = 0; i < len8; i += CRC_PACK_BYTES) {
+    uint32_t nbytes = SRSRAN_MIN(CRC_PACK_BYTES, len8 - i);
+    crc_pack_bits(&data[8 * i], packed, nbytes);
+    crc = crc_update_bytes(h, crc, packed, nbytes);
   }
-
-  // Calculate CRC
-  for (i = 0; i < len8 + a; i++) {
-    pter = (uint8_t*)(data + 8 * i);
-    uint8_t byte;
-    if (i == len8) {
-      byte = 0x00;
-      for (k = 0; k < res8; k++) {
-        byte |= ((uint8_t) * (pter + k)) << (7 - k);
-      }
-    } else {
-#ifdef LV_HAVE_SSE
-      // Get 8 Bit
-      __m64 mask = _mm_cmpgt_pi8(*((__m64*)pter), _mm_set1_pi8(0));
-
-      // Reverse
-      mask = _mm_shuffle_pi8(mask, _mm_set_pi8(0, 1, 2, 3, 4, 5, 6, 7));
-
-      // Get mask and write
-      byte = (uint8_t)_mm_movemask_pi8(mask);
-#else  /* LV_HAVE_SSE */
-      byte = (uint8_t)(srsran_bit_pack(&pter, 8) & 0xFF);
-#endif /* LV_HAVE_SSE */
+  if (res8 > 0) {
+    uint8_t byte = 0x00;
+    for (uint32_t k = 0; k < res8; k++) {
+      byte |= ((uint8_t)data[8 * len8 + k]) << (7 - k);
     }
-    srsran_crc_checksum_put_byte(h, byte);
+    crc = crc_update_bytes(h, crc, &byte, 1);
   }
-  crc = (uint32_t)srsran_crc_checksum_get(h);
+  crc >>= 32U - h->order;
+  h->crcinit = crc;
 
   // Reverse CRC res8 positions
-  if (a == 1) {
+  if (res8 > 0) {
     crc = reversecrcbit(crc, 8 - res8, h);
   }
 
@@ -146,20 +337,20 @@ uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
 // len is multiple of 8
 uint32_t srsran_crc_checksum_byte(srsran_crc_t* h, const uint8_t* data, int len)
 {
-  int      i;
-  uint32_t crc = 0;
+  uint32_t crc = crc_update_bytes(h, 0, data, (uint32_t)len / 8) >> (32U - h->order);
 
-  srsran_crc_set_init(h, 0);
-
-  // Calculate CRC
-  for (i = 0; i < len / 8; i++) {
-    srsran_crc_checksum_put_byte(h, data[i]);
-  }
-  crc = (uint32_t)srsran_crc_checksum_get(h);
+  h->crcinit = crc;
 
   return crc;
 }
 
+void srsran_crc_checksum_put_bytes(srsran_crc_t* h, const uint8_t* data, uint32_t nbytes)
+{
+  uint32_t crc = (uint32_t)((h->crcinit & h->crcmask) << (32U - h->order));
+
+  h->crcinit = crc_update_bytes(h, crc, data, nbytes) >> (32U - h->order);
+}
+
 uint32_t srsran_crc_attach_byte(srsran_crc_t* h, uint8_t* data, int len)
 {
   uint32_t checksum = srsran_crc_checksum_byte(h, data, len);
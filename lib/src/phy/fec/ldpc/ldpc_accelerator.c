@@ -0,0 +1,336 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file ldpc_accelerator.c
+ * \brief Definition of the LDPC lookaside decoding interface and of the software accelerator.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/fec/ldpc/ldpc_accelerator.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+int srsran_ldpc_accelerator_open(const srsran_ldpc_accelerator_dev_t* dev, srsran_ldpc_accelerator_t* q)
+{
+  if (dev == NULL || q == NULL || dev->open_queue == NULL) {
+    return -1;
+  }
+
+  memset(q, 0, sizeof(srsran_ldpc_accelerator_t));
+
+  return dev->open_queue(dev->ptr, q);
+}
+
+void srsran_ldpc_accelerator_close(srsran_ldpc_accelerator_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->free != NULL) {
+    q->free(q->ptr);
+  }
+
+  memset(q, 0, sizeof(srsran_ldpc_accelerator_t));
+}
+
+int srsran_ldpc_accelerator_decode(srsran_ldpc_accelerator_t* q, srsran_ldpc_accelerator_op_t* ops, uint32_t nof_ops)
+{
+  if (q == NULL || q->ptr == NULL || ops == NULL || nof_ops > SRSRAN_LDPC_DECODER_MAX_BATCH) {
+    return -1;
+  }
+
+  srsran_ldpc_accelerator_op_t* pending[SRSRAN_LDPC_DECODER_MAX_BATCH];
+  srsran_ldpc_accelerator_op_t* completed[SRSRAN_LDPC_DECODER_MAX_BATCH];
+  for (uint32_t i = 0; i < nof_ops; i++) {
+    ops[i].nof_iter = -1;
+    pending[i]      = &ops[i];
+  }
+
+  // Keep submitting while the queue accepts operations, and wait for the submitted ones even if a submission fails,
+  // the accelerator may still be writing their messages
+  uint32_t nof_enqueued  = 0;
+  uint32_t nof_dequeued  = 0;
+  bool     enqueue_error = false;
+  while (nof_dequeued < nof_enqueued || (nof_enqueued < nof_ops && !enqueue_error)) {
+    if (nof_enqueued < nof_ops && !enqueue_error) {
+      int n = q->enqueue(q->ptr, &pending[nof_enqueued], nof_ops - nof_enqueued);
+      if (n < 0) {
+        ERROR("Error enqueueing LDPC decoding operations");
+        enqueue_error = true;
+      } else {
+        nof_enqueued += (uint32_t)n;
+      }
+    }
+
+    int n = q->dequeue(q->ptr, completed, nof_enqueued - nof_dequeued);
+    if (n < 0) {
+      ERROR("Error dequeueing LDPC decoding operations");
+      return -1;
+    }
+    nof_dequeued += (uint32_t)n;
+
+    if (n == 0) {
+      sched_yield();
+    }
+  }
+
+  if (enqueue_error) {
+    return -1;
+  }
+
+  for (uint32_t i = 0; i < nof_ops; i++) {
+    if (ops[i].nof_iter < 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+/*!
+ * \brief Fixed size FIFO of operations.
+ */
+typedef struct {
+  srsran_ldpc_accelerator_op_t* ops[SRSRAN_LDPC_ACCELERATOR_SW_QUEUE_SIZE];
+  uint32_t                      head;
+  uint32_t                      count;
+} ldpc_accelerator_sw_fifo_t;
+
+/*!
+ * \brief Queue of the software accelerator, served by its own worker thread.
+ */
+typedef struct {
+  srsran_ldpc_decoder_args_t args;
+  srsran_ldpc_decoder_t*     decoder[2][MAX_LIFTSIZE + 1]; /*!< \brief Decoders, created on first use. */
+
+  ldpc_accelerator_sw_fifo_t pending;
+  ldpc_accelerator_sw_fifo_t completed;
+
+  pthread_t       thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t  cvar;
+  bool            running;
+} ldpc_accelerator_sw_queue_t;
+
+static void sw_fifo_push(ldpc_accelerator_sw_fifo_t* fifo, srsran_ldpc_accelerator_op_t* op)
+{
+  fifo->ops[(fifo->head + fifo->count) % SRSRAN_LDPC_ACCELERATOR_SW_QUEUE_SIZE] = op;
+  fifo->count++;
+}
+
+static srsran_ldpc_accelerator_op_t* sw_fifo_pop(ldpc_accelerator_sw_fifo_t* fifo)
+{
+  srsran_ldpc_accelerator_op_t* op = fifo->ops[fifo->head];
+  fifo->head                       = (fifo->head + 1) % SRSRAN_LDPC_ACCELERATOR_SW_QUEUE_SIZE;
+  fifo->count--;
+  return op;
+}
+
+static srsran_ldpc_decoder_t* sw_get_decoder(ldpc_accelerator_sw_queue_t* q, srsran_basegraph_t bg, uint16_t ls)
+{
+  if ((bg != BG1 && bg != BG2) || get_ls_index(ls) == VOID_LIFTSIZE) {
+    ERROR("Invalid base graph or lifting size (%d)", ls);
+    return NULL;
+  }
+
+  srsran_ldpc_decoder_t** decoder = &q->decoder[bg == BG1 ? 0 : 1][ls];
+  if (*decoder != NULL) {
+    return *decoder;
+  }
+
+  srsran_ldpc_decoder_t* d = calloc(1, sizeof(srsran_ldpc_decoder_t));
+  if (d == NULL) {
+    return NULL;
+  }
+
+  srsran_ldpc_decoder_args_t args = q->args;
+  args.bg                         = bg;
+  args.ls                         = ls;
+  if (srsran_ldpc_decoder_init(d, &args) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising LDPC decoder for ls=%d", ls);
+    free(d);
+    return NULL;
+  }
+
+  *decoder = d;
+  return d;
+}
+
+static void* sw_queue_thread(void* arg)
+{
+  ldpc_accelerator_sw_queue_t* q = (ldpc_accelerator_sw_queue_t*)arg;
+
+  pthread_mutex_lock(&q->mutex);
+  while (q->running) {
+    if (q->pending.count == 0) {
+      pthread_cond_wait(&q->cvar, &q->mutex);
+      continue;
+    }
+    srsran_ldpc_accelerator_op_t* op = sw_fifo_pop(&q->pending);
+    pthread_mutex_unlock(&q->mutex);
+
+    srsran_ldpc_decoder_t* decoder = sw_get_decoder(q, op->bg, op->ls);
+    op->nof_iter =
+        (decoder == NULL)
+            ? -1
+            : srsran_ldpc_decoder_decode_crc_c(decoder, op->llr, op->message, op->cdwd_rm_length, op->crc);
+
+    pthread_mutex_lock(&q->mutex);
+    sw_fifo_push(&q->completed, op);
+  }
+  pthread_mutex_unlock(&q->mutex);
+
+  return NULL;
+}
+
+static int sw_queue_enqueue(void* ptr, srsran_ldpc_accelerator_op_t* const* ops, uint32_t nof_ops)
+{
+  ldpc_accelerator_sw_queue_t* q = (ldpc_accelerator_sw_queue_t*)ptr;
+
+  // Operations stay accounted until they are dequeued, so that completions always find room
+  pthread_mutex_lock(&q->mutex);
+  uint32_t nof_free = SRSRAN_LDPC_ACCELERATOR_SW_QUEUE_SIZE - q->pending.count - q->completed.count;
+  uint32_t n        = SRSRAN_MIN(nof_ops, nof_free);
+  for (uint32_t i = 0; i < n; i++) {
+    sw_fifo_push(&q->pending, ops[i]);
+  }
+  pthread_cond_signal(&q->cvar);
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)n;
+}
+
+static int sw_queue_dequeue(void* ptr, srsran_ldpc_accelerator_op_t** ops, uint32_t max_nof_ops)
+{
+  ldpc_accelerator_sw_queue_t* q = (ldpc_accelerator_sw_queue_t*)ptr;
+
+  pthread_mutex_lock(&q->mutex);
+  uint32_t n = SRSRAN_MIN(max_nof_ops, q->completed.count);
+  for (uint32_t i = 0; i < n; i++) {
+    ops[i] = sw_fifo_pop(&q->completed);
+  }
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)n;
+}
+
+static void sw_queue_free(void* ptr)
+{
+  ldpc_accelerator_sw_queue_t* q = (ldpc_accelerator_sw_queue_t*)ptr;
+  if (q == NULL) {
+    return;
+  }
+
+  pthread_mutex_lock(&q->mutex);
+  q->running = false;
+  pthread_cond_signal(&q->cvar);
+  pthread_mutex_unlock(&q->mutex);
+  pthread_join(q->thread, NULL);
+
+  pthread_cond_destroy(&q->cvar);
+  pthread_mutex_destroy(&q->mutex);
+
+  for (uint32_t i = 0; i < 2; i++) {
+    for (uint32_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
+      if (q->decoder[i][ls] != NULL) {
+        srsran_ldpc_decoder_free(q->decoder[i][ls]);
+        free(q->decoder[i][ls]);
+      }
+    }
+  }
+
+  free(q);
+}
+
+static int sw_open_queue(void* ptr, srsran_ldpc_accelerator_t* acc)
+{
+  const srsran_ldpc_decoder_args_t* args = (const srsran_ldpc_decoder_args_t*)ptr;
+
+  ldpc_accelerator_sw_queue_t* q = calloc(1, sizeof(ldpc_accelerator_sw_queue_t));
+  if (q == NULL) {
+    ERROR("Allocating LDPC accelerator queue");
+    return -1;
+  }
+  q->args    = *args;
+  q->running = true;
+
+  if (pthread_mutex_init(&q->mutex, NULL) || pthread_cond_init(&q->cvar, NULL)) {
+    ERROR("Creating LDPC accelerator queue mutex");
+    free(q);
+    return -1;
+  }
+
+  if (pthread_create(&q->thread, NULL, sw_queue_thread, q)) {
+    ERROR("Creating LDPC accelerator queue thread");
+    pthread_cond_destroy(&q->cvar);
+    pthread_mutex_destroy(&q->mutex);
+    free(q);
+    return -1;
+  }
+
+  acc->ptr     = q;
+  acc->enqueue = sw_queue_enqueue;
+  acc->dequeue = sw_queue_dequeue;
+  acc->free    = sw_queue_free;
+
+  return 0;
+}
+
+int srsran_ldpc_accelerator_sw_init(srsran_ldpc_accelerator_dev_t* dev, const srsran_ldpc_decoder_args_t* args)
+{
+  if (dev == NULL || args == NULL) {
+    return -1;
+  }
+
+  srsran_ldpc_decoder_args_t* dev_args = calloc(1, sizeof(srsran_ldpc_decoder_args_t));
+  if (dev_args == NULL) {
+    return -1;
+  }
+  *dev_args = *args;
+
+  dev->ptr        = dev_args;
+  dev->open_queue = sw_open_queue;
+  dev->free       = free;
+
+  return 0;
+}
+
+void srsran_ldpc_accelerator_dev_free(srsran_ldpc_accelerator_dev_t* dev)
+{
+  if (dev == NULL) {
+    return;
+  }
+
+  if (dev->free != NULL) {
+    dev->free(dev->ptr);
+  }
+
+  memset(dev, 0, sizeof(srsran_ldpc_accelerator_dev_t));
+}
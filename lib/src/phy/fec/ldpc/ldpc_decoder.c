@@ -29,6 +29,7 @@
  *
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "../utils_avx2.h"
@@ -36,6 +37,7 @@
 #include "ldpc_dec_all.h"
 #include "srsran/phy/fec/ldpc/base_graph.h"
 #include "srsran/phy/fec/ldpc/ldpc_decoder.h"
+#include "srsran/phy/utils/cpu_features.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
@@ -307,11 +309,127 @@ static void free_dec_c_avx2(void* o)
     free(q->pcm);
   }
   delete_ldpc_dec_c_avx2(q->ptr);
+  delete_ldpc_dec_c_avx2_batch(q->batch_ptr);
 }
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX2 implementation). */
 LDPC_DECODER_TEMPLATE(int8_t, c_avx2);
 
+/*! Carries out the decoding of several code blocks with 8-bit integer-valued LLRs (AVX2 implementation, LS <= 16).
+ */
+static int decode_batch_c_avx2(void*                o,
+                               const int8_t* const* llrs,
+                               uint8_t* const*      messages,
+                               const uint32_t*      cdwd_rm_length,
+                               srsran_crc_t*        crc,
+                               int*                 nof_iter,
+                               uint32_t             nof_cb)
+{
+  srsran_ldpc_decoder_t* q = o;
+
+  if (nof_cb > q->batch_size || nof_cb > SRSRAN_LDPC_DECODER_MAX_BATCH) {
+    return -1;
+  }
+
+  // All the code blocks go through the layers required by the longest one. The extra layers only involve parity
+  // bits with null LLRs, which leave the other code blocks unaffected.
+  uint8_t n_layers = 0;
+  for (uint32_t i_cb = 0; i_cb < nof_cb; i_cb++) {
+    uint32_t len = cdwd_rm_length[i_cb];
+    /* it must be smaller than the codeword size */
+    if (len > q->liftN - 2 * q->ls) {
+      len = q->liftN - 2 * q->ls;
+    }
+    /* We need at least q->bgK + 4 variable nodes to cover the high-rate region. However,*/
+    /* 2 variable nodes are systematically punctured by the encoder. */
+    if (len < (q->bgK + 2) * q->ls) {
+      len = (q->bgK + 2) * q->ls;
+    }
+    if (len % q->ls) {
+      len = (len / q->ls + 1) * q->ls;
+    }
+    n_layers = SRSRAN_MAX(n_layers, len / q->ls - q->bgK + 2);
+
+    nof_iter[i_cb] = 0;
+  }
+
+  if (init_ldpc_dec_c_avx2_batch(q->batch_ptr, llrs, nof_cb) < 0) {
+    return -1;
+  }
+
+  uint16_t* this_pcm                   = NULL;
+  int8_t(*these_var_indices)[MAX_CNCT] = NULL;
+
+  bool     cb_done[SRSRAN_LDPC_DECODER_MAX_BATCH] = {};
+  uint32_t nof_cb_done                            = 0;
+
+  for (int i_iteration = 0; i_iteration < q->max_nof_iter; i_iteration++) {
+    for (int i_layer = 0; i_layer < n_layers; i_layer++) {
+      update_ldpc_var_to_check_c_avx2_batch(q->batch_ptr, i_layer);
+
+      this_pcm          = q->pcm + i_layer * q->bgN;
+      these_var_indices = q->var_indices + i_layer;
+
+      update_ldpc_check_to_var_c_avx2_batch(q->batch_ptr, i_layer, this_pcm, these_var_indices);
+
+      update_ldpc_soft_bits_c_avx2_batch(q->batch_ptr, i_layer, these_var_indices);
+    }
+
+    if (crc != NULL) {
+      // Code blocks that already matched the CRC keep their message, the others are checked again
+      for (uint32_t i_cb = 0; i_cb < nof_cb; i_cb++) {
+        if (cb_done[i_cb]) {
+          continue;
+        }
+        extract_ldpc_message_c_avx2_batch(q->batch_ptr, messages[i_cb], q->liftK, i_cb);
+
+        if (srsran_crc_match(crc, messages[i_cb], q->liftK - crc->order)) {
+          nof_iter[i_cb] = i_iteration + 1;
+          cb_done[i_cb]  = true;
+          nof_cb_done++;
+        }
+      }
+
+      if (nof_cb_done == nof_cb) {
+        return 0;
+      }
+    }
+  }
+
+  /* If reached here, and CRC is being checked, the remaining code blocks have failed */
+  if (crc != NULL) {
+    return 0;
+  }
+
+  /* Without CRC, extract messages and return the maximum number of iterations */
+  for (uint32_t i_cb = 0; i_cb < nof_cb; i_cb++) {
+    extract_ldpc_message_c_avx2_batch(q->batch_ptr, messages[i_cb], q->liftK, i_cb);
+    nof_iter[i_cb] = q->max_nof_iter;
+  }
+
+  return 0;
+}
+
+/*! Initializes the batched decoder working with 8-bit integer-valued LLRs (AVX2 implementation), if the lifting size
+ * allows packing more than one code block in the SIMD registers. */
+static int init_batch_c_avx2(srsran_ldpc_decoder_t* q)
+{
+  uint32_t batch_size = SRSRAN_MIN(get_ldpc_dec_c_avx2_batch_size(q->ls), SRSRAN_LDPC_DECODER_MAX_BATCH);
+  if (batch_size < 2) {
+    return 0;
+  }
+
+  if ((q->batch_ptr = create_ldpc_dec_c_avx2_batch(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+    ERROR("Create_ldpc_dec failed");
+    return -1;
+  }
+
+  q->batch_size     = batch_size;
+  q->decode_batch_c = decode_batch_c_avx2;
+
+  return 0;
+}
+
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX2 implementation). */
 static int init_c_avx2(srsran_ldpc_decoder_t* q)
 {
@@ -325,6 +443,11 @@ static int init_c_avx2(srsran_ldpc_decoder_t* q)
 
   q->decode_c = decode_c_avx2;
 
+  if (init_batch_c_avx2(q) < 0) {
+    free_dec_c_avx2(q);
+    return -1;
+  }
+
   return 0;
 }
 
@@ -432,7 +555,7 @@ static int init_c_avx2long_flood(srsran_ldpc_decoder_t* q)
 
 // AVX512 Declarations
 
-#ifdef LV_HAVE_AVX512
+#if defined(LV_HAVE_AVX512) || defined(SRSRAN_SIMD_DISPATCH_AVX512)
 
 /*! Carries out the actual destruction of the memory allocated to the decoder, 8-bit-LLR case (AVX512 implementation).
  */
@@ -446,6 +569,9 @@ static void free_dec_c_avx512(void* o)
     free(q->pcm);
   }
   delete_ldpc_dec_c_avx512(q->ptr);
+#ifdef LV_HAVE_AVX2
+  delete_ldpc_dec_c_avx2_batch(q->batch_ptr);
+#endif // LV_HAVE_AVX2
 }
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX512 implementation). */
@@ -464,6 +590,14 @@ static int init_c_avx512(srsran_ldpc_decoder_t* q)
 
   q->decode_c = decode_c_avx512;
 
+#ifdef LV_HAVE_AVX2
+  // Small lifting sizes leave most of the 512-bit lanes idle, several code blocks are better decoded together
+  if (init_batch_c_avx2(q) < 0) {
+    free_dec_c_avx512(q);
+    return -1;
+  }
+#endif // LV_HAVE_AVX2
+
   return 0;
 }
 
@@ -576,6 +710,10 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
   q->liftM = ls * q->bgM;
   q->liftN = ls * q->bgN;
 
+  q->batch_ptr      = NULL;
+  q->batch_size     = 1;
+  q->decode_batch_c = NULL;
+
   q->max_nof_iter = (args->max_nof_iter == 0) ? LDPC_DECODER_DEFAULT_MAX_NOF_ITER : args->max_nof_iter;
 
   q->pcm = srsran_vec_u16_malloc(q->bgM * q->bgN);
@@ -629,16 +767,22 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
         return init_c_avx2long_flood(q);
       }
 #endif // LV_HAVE_AVX2
-#ifdef LV_HAVE_AVX512
+#if defined(LV_HAVE_AVX512) || defined(SRSRAN_SIMD_DISPATCH_AVX512)
     case SRSRAN_LDPC_DECODER_C_AVX512:
+    case SRSRAN_LDPC_DECODER_C_AVX512_FLOOD:
+      if (!srsran_cpu_has(SRSRAN_CPU_AVX512)) {
+        ERROR("The AVX512 LDPC decoder is not supported by this CPU");
+        return -1;
+      }
+      if (type == SRSRAN_LDPC_DECODER_C_AVX512_FLOOD) {
+        return init_c_avx512long_flood(q);
+      }
       if (ls <= SRSRAN_AVX512_B_SIZE) {
         return init_c_avx512(q);
       } else {
         return init_c_avx512long(q);
       }
-    case SRSRAN_LDPC_DECODER_C_AVX512_FLOOD:
-      return init_c_avx512long_flood(q);
-#endif // LV_HAVE_AVX2
+#endif // LV_HAVE_AVX512
 
     default:
       ERROR("Unknown decoder.");
@@ -683,3 +827,39 @@ int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
 {
   return q->decode_c(q, llrs, message, cdwd_rm_length, crc);
 }
+
+int srsran_ldpc_decoder_decode_batch(srsran_ldpc_decoder_t* q,
+                                     const int8_t* const*   llrs,
+                                     uint8_t* const*        messages,
+                                     const uint32_t*        cdwd_rm_length,
+                                     srsran_crc_t*          crc,
+                                     int*                   nof_iter,
+                                     uint32_t               nof_cb)
+{
+  if (q == NULL || q->decode_c == NULL || llrs == NULL || messages == NULL || cdwd_rm_length == NULL ||
+      nof_iter == NULL) {
+    return -1;
+  }
+
+  uint32_t i_cb = 0;
+  while (i_cb < nof_cb) {
+    uint32_t n = SRSRAN_MIN(nof_cb - i_cb, q->batch_size);
+
+    if (q->decode_batch_c != NULL && n > 1) {
+      if (q->decode_batch_c(q, llrs + i_cb, messages + i_cb, cdwd_rm_length + i_cb, crc, nof_iter + i_cb, n) < 0) {
+        return -1;
+      }
+    } else {
+      // A single code block is decoded faster by the regular decoder
+      n              = 1;
+      nof_iter[i_cb] = q->decode_c(q, llrs[i_cb], messages[i_cb], cdwd_rm_length[i_cb], crc);
+      if (nof_iter[i_cb] < 0) {
+        return -1;
+      }
+    }
+
+    i_cb += n;
+  }
+
+  return 0;
+}
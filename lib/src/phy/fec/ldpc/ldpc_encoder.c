@@ -36,6 +36,7 @@
 #include "ldpc_enc_all.h"
 #include "srsran/phy/fec/ldpc/base_graph.h"
 #include "srsran/phy/fec/ldpc/ldpc_encoder.h"
+#include "srsran/phy/utils/cpu_features.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
@@ -320,7 +321,7 @@ static int init_avx2long(srsran_ldpc_encoder_t* q)
 
 #endif
 
-#ifdef LV_HAVE_AVX512
+#if defined(LV_HAVE_AVX512) || defined(SRSRAN_SIMD_DISPATCH_AVX512)
 
 /*! Carries out the actual destruction of the memory allocated to the encoder. */
 static void free_enc_avx512(void* o)
@@ -555,8 +556,12 @@ int srsran_ldpc_encoder_init(srsran_ldpc_encoder_t*     q,
         return init_avx2long(q);
       }
 #endif // LV_HAVE_AVX2
-#ifdef LV_HAVE_AVX512
+#if defined(LV_HAVE_AVX512) || defined(SRSRAN_SIMD_DISPATCH_AVX512)
     case SRSRAN_LDPC_ENCODER_AVX512:
+      if (!srsran_cpu_has(SRSRAN_CPU_AVX512)) {
+        ERROR("The AVX512 LDPC encoder is not supported by this CPU");
+        return -1;
+      }
       if (ls <= SRSRAN_AVX512_B_SIZE) {
         return init_avx512(q);
       } else {
@@ -33,11 +33,18 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "srsran/phy/fec/ldpc/ldpc_common.h" //FILLER_BIT definition
 #include "srsran/phy/fec/ldpc/ldpc_rm.h"
 #include "srsran/phy/utils/vector.h"
 
+#if defined(LV_HAVE_AVX512) || defined(LV_HAVE_AVX2) || defined(LV_HAVE_SSE)
+#include <immintrin.h>
+#elif defined(HAVE_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #include "srsran/phy/utils/debug.h"
 
 //#define debug
@@ -107,6 +114,165 @@ struct pRM_rx_c {
   uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
 };
 
+/*!
+ * \brief Maximum number of rows of the bit interleaver (256QAM).
+ */
+#define RM_MAX_MOD_ORDER 8
+
+/*
+ * The bit interleaver transposes a mod_order x (E / mod_order) matrix of bytes. The SIMD kernels work on groups of 16
+ * columns per 128-bit lane: the mod_order vectors of a group are rebuilt from the mod_order input vectors with byte
+ * shuffles, which work in the same way in every lane, and every lane takes a different group of columns.
+ */
+#if defined(LV_HAVE_AVX512)
+#define RM_SIMD_LANES 4
+typedef __m512i rm_simd_t;
+
+static inline rm_simd_t rm_simd_loadu(const uint8_t* ptr)
+{
+  return _mm512_loadu_si512(ptr);
+}
+
+static inline void rm_simd_storeu(uint8_t* ptr, rm_simd_t v)
+{
+  _mm512_storeu_si512(ptr, v);
+}
+
+// Loads one 16-byte chunk every stride bytes in each lane
+static inline rm_simd_t rm_simd_load_lanes(const uint8_t* ptr, uint32_t stride)
+{
+  rm_simd_t v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)ptr));
+  v           = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(ptr + stride)), 1);
+  v           = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(ptr + 2 * stride)), 2);
+  return _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(ptr + 3 * stride)), 3);
+}
+
+// Stores each lane in a 16-byte chunk every stride bytes
+static inline void rm_simd_store_lanes(uint8_t* ptr, uint32_t stride, rm_simd_t v)
+{
+  _mm_storeu_si128((__m128i*)ptr, _mm512_castsi512_si128(v));
+  _mm_storeu_si128((__m128i*)(ptr + stride), _mm512_extracti32x4_epi32(v, 1));
+  _mm_storeu_si128((__m128i*)(ptr + 2 * stride), _mm512_extracti32x4_epi32(v, 2));
+  _mm_storeu_si128((__m128i*)(ptr + 3 * stride), _mm512_extracti32x4_epi32(v, 3));
+}
+
+static inline rm_simd_t rm_simd_set_shuffle(const uint8_t indices[16])
+{
+  return _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)indices));
+}
+
+static inline rm_simd_t rm_simd_shuffle_or(rm_simd_t acc, rm_simd_t a, rm_simd_t shuffle)
+{
+  return _mm512_or_si512(acc, _mm512_shuffle_epi8(a, shuffle));
+}
+
+static inline rm_simd_t rm_simd_zero()
+{
+  return _mm512_setzero_si512();
+}
+#elif defined(LV_HAVE_AVX2)
+#define RM_SIMD_LANES 2
+typedef __m256i rm_simd_t;
+
+static inline rm_simd_t rm_simd_loadu(const uint8_t* ptr)
+{
+  return _mm256_loadu_si256((const __m256i*)ptr);
+}
+
+static inline void rm_simd_storeu(uint8_t* ptr, rm_simd_t v)
+{
+  _mm256_storeu_si256((__m256i*)ptr, v);
+}
+
+static inline rm_simd_t rm_simd_load_lanes(const uint8_t* ptr, uint32_t stride)
+{
+  return _mm256_loadu2_m128i((const __m128i*)(ptr + stride), (const __m128i*)ptr);
+}
+
+static inline void rm_simd_store_lanes(uint8_t* ptr, uint32_t stride, rm_simd_t v)
+{
+  _mm256_storeu2_m128i((__m128i*)(ptr + stride), (__m128i*)ptr, v);
+}
+
+static inline rm_simd_t rm_simd_set_shuffle(const uint8_t indices[16])
+{
+  return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)indices));
+}
+
+static inline rm_simd_t rm_simd_shuffle_or(rm_simd_t acc, rm_simd_t a, rm_simd_t shuffle)
+{
+  return _mm256_or_si256(acc, _mm256_shuffle_epi8(a, shuffle));
+}
+
+static inline rm_simd_t rm_simd_zero()
+{
+  return _mm256_setzero_si256();
+}
+#elif defined(LV_HAVE_SSE) || (defined(HAVE_NEON) && defined(__aarch64__))
+#define RM_SIMD_LANES 1
+#ifdef LV_HAVE_SSE
+typedef __m128i rm_simd_t;
+
+static inline rm_simd_t rm_simd_loadu(const uint8_t* ptr)
+{
+  return _mm_loadu_si128((const __m128i*)ptr);
+}
+
+static inline void rm_simd_storeu(uint8_t* ptr, rm_simd_t v)
+{
+  _mm_storeu_si128((__m128i*)ptr, v);
+}
+
+static inline rm_simd_t rm_simd_shuffle_or(rm_simd_t acc, rm_simd_t a, rm_simd_t shuffle)
+{
+  return _mm_or_si128(acc, _mm_shuffle_epi8(a, shuffle));
+}
+
+static inline rm_simd_t rm_simd_zero()
+{
+  return _mm_setzero_si128();
+}
+#else  /* LV_HAVE_SSE */
+typedef uint8x16_t rm_simd_t;
+
+static inline rm_simd_t rm_simd_loadu(const uint8_t* ptr)
+{
+  return vld1q_u8(ptr);
+}
+
+static inline void rm_simd_storeu(uint8_t* ptr, rm_simd_t v)
+{
+  vst1q_u8(ptr, v);
+}
+
+// Out of range indices select zero, as in the x86 byte shuffle
+static inline rm_simd_t rm_simd_shuffle_or(rm_simd_t acc, rm_simd_t a, rm_simd_t shuffle)
+{
+  return vorrq_u8(acc, vqtbl1q_u8(a, shuffle));
+}
+
+static inline rm_simd_t rm_simd_zero()
+{
+  return vdupq_n_u8(0);
+}
+#endif /* LV_HAVE_SSE */
+
+static inline rm_simd_t rm_simd_load_lanes(const uint8_t* ptr, uint32_t stride)
+{
+  return rm_simd_loadu(ptr);
+}
+
+static inline void rm_simd_store_lanes(uint8_t* ptr, uint32_t stride, rm_simd_t v)
+{
+  rm_simd_storeu(ptr, v);
+}
+
+static inline rm_simd_t rm_simd_set_shuffle(const uint8_t indices[16])
+{
+  return rm_simd_loadu(indices);
+}
+#endif
+
 /*!
  * Initialize rate-matching parameters
  */
@@ -178,18 +344,27 @@ static void bit_selection_rm_tx(const uint8_t* input,
 {
   uint32_t E = out_len;
 
+  // The circular buffer is copied in contiguous segments between filler bits
   uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-
+  uint32_t icwd = k0 % Ncb;
   while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (input[icwd] != FILLER_BIT) {
-      output[k] = input[icwd];
-      k         = k + 1;
+    uint32_t       n      = SRSRAN_MIN(Ncb - icwd, E - k);
+    const uint8_t* filler = memchr(&input[icwd], FILLER_BIT, n);
+    if (filler != NULL) {
+      n = (uint32_t)(filler - &input[icwd]);
     }
-    j = j + 1;
-  } // while
+    memcpy(&output[k], &input[icwd], n);
+    k += n;
+    icwd += n;
+
+    // Skip filler bits and wrap around the circular buffer
+    while (icwd < Ncb && input[icwd] == FILLER_BIT) {
+      icwd++;
+    }
+    if (icwd >= Ncb) {
+      icwd = 0;
+    }
+  }
 }
 
 /*!
@@ -295,11 +470,12 @@ static void bit_selection_rm_rx_s(const int16_t* input,
  * missing symbol. Repeated symbols are added.
  * The input memory *output shall be either initialized to all zeros or to the
  * result of previous redundancy versions is available.
+ * The circular buffer is read in contiguous segments (skipping the filler bits), so that the soft bits are combined
+ * with saturated vector additions.
  */
 static void bit_selection_rm_rx_c(const int8_t*  input,
                                   const uint32_t in_len,
                                   int8_t*        output,
-                                  uint32_t*      indices,
                                   const uint32_t ini_exclude,
                                   const uint32_t end_exclude,
                                   const uint32_t k0,
@@ -307,18 +483,6 @@ static void bit_selection_rm_rx_c(const int8_t*  input,
 {
   uint32_t E = in_len;
 
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
-
   // set filler bits to INFINITY
   const long infinity8 = (1U << 7U) - 1; // Max positive value in 8-bit representation
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
@@ -326,19 +490,25 @@ static void bit_selection_rm_rx_c(const int8_t*  input,
   }
 
   // Add soft bits, in case of repetition
-  const int16_t infinity7 =
-      (1U << 6U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
-  // input is assume to be quantized from -infinity15 to infinity15. Only filler bits can be infinity16
-  long tmp = 0;
-  for (uint32_t i = 0; i < E; i++) {
-    tmp = (long)output[indices[i]] + input[i];
-    if (tmp > infinity7) {
-      tmp = infinity7;
+  const int8_t infinity7 =
+      (1U << 6U) - 1; // Messages use a 7-bit quantization. Soft bits use the remaining bit to denote infinity.
+  uint32_t k    = 0;
+  uint32_t icwd = k0 % Ncb;
+  while (k < E) {
+    if (icwd >= ini_exclude && icwd < end_exclude) { // avoid filler bits
+      icwd = end_exclude;
     }
-    if (tmp < -infinity7) {
-      tmp = -infinity7;
+    if (icwd >= Ncb) {
+      icwd = 0;
+      continue;
     }
-    output[indices[i]] = (int8_t)tmp;
+
+    // Contiguous segment until the filler bits or the end of the circular buffer
+    uint32_t seg_end = (icwd < ini_exclude) ? SRSRAN_MIN(ini_exclude, Ncb) : Ncb;
+    uint32_t n       = SRSRAN_MIN(seg_end - icwd, E - k);
+    srsran_vec_sum_sat_bbb(&output[icwd], &input[k], &output[icwd], infinity7, n);
+    k += n;
+    icwd += n;
   }
 }
 
@@ -352,7 +522,40 @@ bit_interleaver_rm_tx(const uint8_t* input, uint8_t* output, const uint32_t in_o
   uint32_t rows = 0;
   rows          = mod_order;
   cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
+  uint32_t j    = 0;
+
+#ifdef RM_SIMD_LANES
+  if (rows <= RM_MAX_MOD_ORDER) {
+    // Byte b of the v-th output vector of a group comes from row (16 * v + b) % rows
+    rm_simd_t shuffle[RM_MAX_MOD_ORDER][RM_MAX_MOD_ORDER];
+    for (uint32_t v = 0; v < rows; v++) {
+      for (uint32_t i = 0; i < rows; i++) {
+        uint8_t indices[16];
+        for (uint32_t b = 0; b < 16; b++) {
+          uint32_t p = 16 * v + b;
+          indices[b] = (p % rows == i) ? (uint8_t)(p / rows) : 0x80;
+        }
+        shuffle[v][i] = rm_simd_set_shuffle(indices);
+      }
+    }
+
+    for (; j + 16 * RM_SIMD_LANES <= cols; j += 16 * RM_SIMD_LANES) {
+      rm_simd_t in[RM_MAX_MOD_ORDER];
+      for (uint32_t i = 0; i < rows; i++) {
+        in[i] = rm_simd_loadu(&input[i * cols + j]);
+      }
+      for (uint32_t v = 0; v < rows; v++) {
+        rm_simd_t out = rm_simd_zero();
+        for (uint32_t i = 0; i < rows; i++) {
+          out = rm_simd_shuffle_or(out, in[i], shuffle[v][i]);
+        }
+        rm_simd_store_lanes(&output[j * rows + 16 * v], 16 * rows, out);
+      }
+    }
+  }
+#endif /* RM_SIMD_LANES */
+
+  for (; j < cols; j++) {
     for (uint32_t i = 0; i < rows; i++) {
       output[i + j * rows] = input[i * cols + j];
     }
@@ -394,7 +597,7 @@ bit_interleaver_rm_rx_s(const int16_t* input, int16_t* output, const uint32_t in
 }
 
 /*!
- * Bit deinterleaver (short)
+ * Bit deinterleaver (int8_t)
  */
 static void
 bit_interleaver_rm_rx_c(const int8_t* input, int8_t* output, const uint32_t in_out_len, const uint32_t mod_order)
@@ -403,7 +606,42 @@ bit_interleaver_rm_rx_c(const int8_t* input, int8_t* output, const uint32_t in_o
   uint32_t rows = 0;
   rows          = mod_order;
   cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
+  uint32_t j    = 0;
+
+#ifdef RM_SIMD_LANES
+  if (rows <= RM_MAX_MOD_ORDER) {
+    // Byte b of the i-th output row of a group comes from byte (b * rows + i) % 16 of input vector (b * rows + i) / 16
+    rm_simd_t shuffle[RM_MAX_MOD_ORDER][RM_MAX_MOD_ORDER];
+    for (uint32_t i = 0; i < rows; i++) {
+      for (uint32_t v = 0; v < rows; v++) {
+        uint8_t indices[16];
+        for (uint32_t b = 0; b < 16; b++) {
+          uint32_t p = b * rows + i;
+          indices[b] = (p / 16 == v) ? (uint8_t)(p % 16) : 0x80;
+        }
+        shuffle[i][v] = rm_simd_set_shuffle(indices);
+      }
+    }
+
+    const uint8_t* in_u8  = (const uint8_t*)input;
+    uint8_t*       out_u8 = (uint8_t*)output;
+    for (; j + 16 * RM_SIMD_LANES <= cols; j += 16 * RM_SIMD_LANES) {
+      rm_simd_t in[RM_MAX_MOD_ORDER];
+      for (uint32_t v = 0; v < rows; v++) {
+        in[v] = rm_simd_load_lanes(&in_u8[j * rows + 16 * v], 16 * rows);
+      }
+      for (uint32_t i = 0; i < rows; i++) {
+        rm_simd_t out = rm_simd_zero();
+        for (uint32_t v = 0; v < rows; v++) {
+          out = rm_simd_shuffle_or(out, in[v], shuffle[i][v]);
+        }
+        rm_simd_storeu(&out_u8[i * cols + j], out);
+      }
+    }
+  }
+#endif /* RM_SIMD_LANES */
+
+  for (; j < cols; j++) {
     for (uint32_t i = 0; i < rows; i++) {
       output[i * cols + j] = input[j * rows + i];
     }
@@ -690,15 +928,14 @@ int srsran_ldpc_rm_rx_c(srsran_ldpc_rm_t*        q,
 
   struct pRM_rx_c* pp            = q->ptr;
   int8_t*          tmp_rm_symbol = pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
   uint32_t         end_exclude   = q->K - 2 * q->ls;
   uint32_t         ini_exclude   = end_exclude - q->F;
 
   if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx_c(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx_c(input, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   } else {
     bit_interleaver_rm_rx_c(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx_c(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx_c(tmp_rm_symbol, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   }
 
   // Return the number of useful LLR
@@ -32,9 +32,11 @@
  * Options:
  *  - **-b \<number\>** Base Graph (1 or 2. Default 1).
  *  - **-l \<number\>** Lifting Size (according to 5GNR standard. Default 2).
+ *  - **-B** Decode all the codewords with a single batched call.
  */
 
 #include "srsran/phy/utils/vector.h"
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -44,11 +46,12 @@
 #include "srsran/phy/fec/ldpc/ldpc_decoder.h"
 #include "srsran/phy/utils/debug.h"
 
-srsran_basegraph_t base_graph = BG1; /*!< \brief Base Graph (BG1 or BG2). */
-int                lift_size  = 2;   /*!< \brief Lifting Size. */
-int                finalK;           /*!< \brief Number of uncoded bits (message length). */
-int                finalN;           /*!< \brief Number of coded bits (codeword length). */
-int                scheduling = 0;   /*!< \brief Message scheduling (0 for layered, 1 for flooded). */
+srsran_basegraph_t base_graph = BG1;   /*!< \brief Base Graph (BG1 or BG2). */
+int                lift_size  = 2;     /*!< \brief Lifting Size. */
+int                finalK;             /*!< \brief Number of uncoded bits (message length). */
+int                finalN;             /*!< \brief Number of coded bits (codeword length). */
+int                scheduling = 0;     /*!< \brief Message scheduling (0 for layered, 1 for flooded). */
+bool               batch      = false; /*!< \brief Decode all the codewords with a single batched call. */
 
 #define NOF_MESSAGES 10  /*!< \brief Number of codewords in the test. */
 static int nof_reps = 1; /*!< \brief Number of times tests are repeated (for computing throughput). */
@@ -63,6 +66,7 @@ void usage(char* prog)
   printf("\t-l Lifting Size [Default %d]\n", lift_size);
   printf("\t-x Scheduling [Default %c]\n", scheduling);
   printf("\t-R Number of times tests are repeated (for computing throughput). [Default %d]\n", nof_reps);
+  printf("\t-B Decode all the codewords with a single batched call. [Default %s]\n", batch ? "true" : "false");
 }
 
 /*!
@@ -71,7 +75,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt = 0;
-  while ((opt = getopt(argc, argv, "b:l:x:R:")) != -1) {
+  while ((opt = getopt(argc, argv, "b:l:x:R:B")) != -1) {
     switch (opt) {
       case 'b':
         base_graph = (int)strtol(optarg, NULL, 10) - 1;
@@ -85,6 +89,9 @@ void parse_args(int argc, char** argv)
       case 'R':
         nof_reps = (int)strtol(optarg, NULL, 10);
         break;
+      case 'B':
+        batch = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -186,6 +193,7 @@ int main(int argc, char** argv)
          decoder.liftN - 2 * lift_size,
          decoder.bg == BG1 ? 3 : 5);
   printf("  Scheduling: %s\n", scheduling ? "flooded" : "layered");
+  printf("  Batch size: %d\n", batch ? decoder.batch_size : 1);
 
   finalK = decoder.liftK;
   finalN = decoder.liftN - 2 * lift_size;
@@ -219,16 +227,42 @@ int main(int argc, char** argv)
   struct timeval t[3];
   double         elapsed_time = 0;
 
-  for (j = 0; j < NOF_MESSAGES; j++) {
-    printf("  codeword %d\n", j);
+  if (batch) {
+    const int8_t* llrs_batch[NOF_MESSAGES];
+    uint8_t*      messages_batch[NOF_MESSAGES];
+    uint32_t      lengths_batch[NOF_MESSAGES];
+    int           nof_iter_batch[NOF_MESSAGES];
+    for (j = 0; j < NOF_MESSAGES; j++) {
+      llrs_batch[j]     = symbols + j * finalN;
+      messages_batch[j] = messages_sim + j * finalK;
+      lengths_batch[j]  = finalN;
+    }
+
+    printf("  codewords 0-%d\n", NOF_MESSAGES - 1);
     gettimeofday(&t[1], NULL);
     for (l = 0; l < nof_reps; l++) {
-      srsran_ldpc_decoder_decode_c(&decoder, symbols + j * finalN, messages_sim + j * finalK, finalN);
+      if (srsran_ldpc_decoder_decode_batch(
+              &decoder, llrs_batch, messages_batch, lengths_batch, NULL, nof_iter_batch, NOF_MESSAGES) != 0) {
+        perror("batch decode");
+        exit(-1);
+      }
     }
 
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
     elapsed_time += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+  } else {
+    for (j = 0; j < NOF_MESSAGES; j++) {
+      printf("  codeword %d\n", j);
+      gettimeofday(&t[1], NULL);
+      for (l = 0; l < nof_reps; l++) {
+        srsran_ldpc_decoder_decode_c(&decoder, symbols + j * finalN, messages_sim + j * finalK, finalN);
+      }
+
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      elapsed_time += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+    }
   }
   printf("Elapsed time: %e s\n", elapsed_time);
 
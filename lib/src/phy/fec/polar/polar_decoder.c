@@ -38,6 +38,7 @@
 #include <string.h>
 
 #include "polar_decoder_ssc_c.h"
+#include "polar_decoder_scl_c_avx2.h"
 #include "polar_decoder_ssc_c_avx2.h"
 #include "polar_decoder_ssc_f.h"
 #include "polar_decoder_ssc_s.h"
@@ -112,6 +113,37 @@ static int decode_ssc_c_avx2(void*           o,
 
   return 0;
 }
+
+/*! SC-list Polar decoder AVX2 with int8_t LLR inputs, it returns the most likely candidate. */
+static int decode_scl_c_avx2(void*           o,
+                             const int8_t*   symbols,
+                             uint8_t*        data,
+                             const uint8_t   n,
+                             const uint16_t* frozen_set,
+                             const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  if (polar_decoder_scl_c_avx2(q->ptr, &symbols, &data, 1, 1, n, frozen_set, frozen_set_size) < 1) {
+    return -1;
+  }
+
+  return 0;
+}
+
+/*! SC-list Polar decoder AVX2 with int8_t LLR inputs, for a batch of codewords. */
+static int decode_batch_scl_c_avx2(void*                o,
+                                   const int8_t* const* symbols,
+                                   uint8_t* const*      data,
+                                   uint32_t             nof_cw,
+                                   const uint8_t        n,
+                                   const uint16_t*      frozen_set,
+                                   const uint16_t       frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  return polar_decoder_scl_c_avx2(q->ptr, symbols, data, nof_cw, q->list_size, n, frozen_set, frozen_set_size);
+}
 #endif // LV_HAVE_AVX2
 
 /*! Destructor of a (float) SSC polar decoder. */
@@ -142,6 +174,13 @@ static void free_ssc_c_avx2(void* o)
   srsran_polar_decoder_t* q = o;
   delete_polar_decoder_ssc_c_avx2(q->ptr);
 }
+
+/*! Destructor of a (int8_t, avx2) SC-list polar decoder. */
+static void free_scl_c_avx2(void* o)
+{
+  srsran_polar_decoder_t* q = o;
+  delete_polar_decoder_scl_c_avx2(q->ptr);
+}
 #endif
 
 /*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with float LLR inputs. */
@@ -201,11 +240,30 @@ static int init_ssc_c_avx2(srsran_polar_decoder_t* q)
   }
   return 0;
 }
+
+/*! Initializes a polar decoder structure to use the SC-list polar decoder algorithm with uint8_t LLR inputs and AVX2
+ * instructions. */
+static int init_scl_c_avx2(srsran_polar_decoder_t* q, uint8_t list_size)
+{
+  q->decode_c       = decode_scl_c_avx2;
+  q->decode_batch_c = decode_batch_scl_c_avx2;
+  q->free           = free_scl_c_avx2;
+  q->list_size      = list_size;
+
+  if ((q->ptr = create_polar_decoder_scl_c_avx2(q->nMax, list_size)) == NULL) {
+    ERROR("create_polar_decoder_scl_c_avx2 failed");
+    free_scl_c_avx2(q);
+    return -1;
+  }
+  return 0;
+}
 #endif
 
 int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_type_t type, const uint8_t nMax)
 {
-  q->nMax = nMax;
+  q->nMax           = nMax;
+  q->list_size      = 1;
+  q->decode_batch_c = NULL;
   switch (type) {
     case SRSRAN_POLAR_DECODER_SSC_F:
       return init_ssc_f(q);
@@ -216,6 +274,10 @@ int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_ty
 #ifdef LV_HAVE_AVX2
     case SRSRAN_POLAR_DECODER_SSC_C_AVX2:
       return init_ssc_c_avx2(q);
+    case SRSRAN_POLAR_DECODER_SCL4_C_AVX2:
+      return init_scl_c_avx2(q, 4);
+    case SRSRAN_POLAR_DECODER_SCL8_C_AVX2:
+      return init_scl_c_avx2(q, 8);
 #endif
     default:
       ERROR("Decoder not implemented");
@@ -273,3 +335,38 @@ int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
 
   return -1;
 }
+
+int srsran_polar_decoder_decode_list_c(srsran_polar_decoder_t* q,
+                                       const int8_t*           llr,
+                                       uint8_t*                data_decoded,
+                                       const uint8_t           n,
+                                       const uint16_t*         frozen_set,
+                                       const uint16_t          frozen_set_size)
+{
+  return srsran_polar_decoder_decode_batch_c(q, &llr, &data_decoded, 1, n, frozen_set, frozen_set_size);
+}
+
+int srsran_polar_decoder_decode_batch_c(srsran_polar_decoder_t* q,
+                                        const int8_t* const*    llr,
+                                        uint8_t* const*         data_decoded,
+                                        uint32_t                nof_cw,
+                                        const uint8_t           n,
+                                        const uint16_t*         frozen_set,
+                                        const uint16_t          frozen_set_size)
+{
+  if (q->nMax < n) {
+    return -1;
+  }
+
+  if (q->decode_batch_c) {
+    return q->decode_batch_c(q, llr, data_decoded, nof_cw, n, frozen_set, frozen_set_size);
+  }
+
+  for (uint32_t i = 0; i < nof_cw; i++) {
+    if (q->decode_c(q, llr[i], data_decoded[i], n, frozen_set, frozen_set_size) < 0) {
+      return -1;
+    }
+  }
+
+  return 1;
+}
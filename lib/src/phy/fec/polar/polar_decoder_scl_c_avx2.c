@@ -0,0 +1,487 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_c_avx2.c
+ * \brief Definition of the SC-list polar decoder inner functions working with
+ * 8-bit integer-valued LLRs and AVX2 instructions.
+ *
+ * All the decoding paths, and the paths of all the codewords of a batch, are interleaved: element \f$i\f$ of lane
+ * \f$l\f$ is stored at index \f$i W + l\f$, \f$W\f$ being the number of lanes. Functions f and g, and the partial
+ * sums, are then computed for all the lanes at once. Path metrics follow the min-sum approximation, which allows
+ * processing nodes with only frozen bits (rate-0 nodes) in a single step.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#include "polar_decoder_scl_c_avx2.h"
+#include "../utils_avx2.h"
+#include "polar_decoder_vector_avx2.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/utils/vector.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LV_HAVE_AVX2
+
+#include <immintrin.h>
+
+#define SCL_MAX_LANES SRSRAN_AVX2_B_SIZE /*!< \brief Maximum number of interleaved paths. */
+#define SCL_MAX_LIST 8                   /*!< \brief Maximum list size. */
+#define SCL_BIT_ONE 0x80                 /*!< \brief Representation of a bit 1, as used by the AVX2 g function. */
+
+/*!
+ * \brief Describes an SC-list polar decoder (8-bit, AVX2 version).
+ */
+struct pSCL_c_avx2 {
+  uint8_t   nMax;                    /*!< \brief Maximum \f$log_2\f$ of the codeword size. */
+  uint8_t   list_size;               /*!< \brief Number of paths per codeword. */
+  uint8_t   nof_lanes;               /*!< \brief Number of interleaved paths of the current batch. */
+  uint8_t   nof_paths;               /*!< \brief Number of active paths per codeword. */
+  int8_t*   llr[NMAX_LOG + 1];       /*!< \brief LLRs of the active node at every stage. */
+  uint8_t*  beta[NMAX_LOG + 1];      /*!< \brief Partial sums of the active node at every stage. */
+  uint8_t*  bit;                     /*!< \brief Bit decided for every path at every information bit. */
+  uint8_t*  parent;                  /*!< \brief Parent path of every path at every information bit. */
+  uint8_t*  is_frozen;               /*!< \brief Indicates the frozen bits. */
+  uint16_t* nof_frozen;              /*!< \brief Number of frozen bits before every position. */
+  uint16_t* info_set;                /*!< \brief Positions of the non-frozen bits. */
+  uint16_t  nof_info;                /*!< \brief Number of non-frozen bits. */
+  uint32_t  metric[SCL_MAX_LANES];   /*!< \brief Path metrics. */
+};
+
+/*!
+ * \brief Lane permutation of 32-byte vectors, split into in-lane and cross-lane shuffles.
+ */
+typedef struct {
+  __m256i same;                /*!< \brief Shuffle indices of bytes read from the same 128-bit lane. */
+  __m256i cross;               /*!< \brief Shuffle indices of bytes read from the other 128-bit lane. */
+  uint8_t perm[SCL_MAX_LANES]; /*!< \brief Source path of every path. */
+} scl_perm_t;
+
+void delete_polar_decoder_scl_c_avx2(void* p)
+{
+  struct pSCL_c_avx2* pp = p;
+
+  if (pp == NULL) {
+    return;
+  }
+
+  if (pp->llr[0]) {
+    free(pp->llr[0]);
+  }
+  if (pp->beta[0]) {
+    free(pp->beta[0]);
+  }
+  if (pp->bit) {
+    free(pp->bit);
+  }
+  if (pp->parent) {
+    free(pp->parent);
+  }
+  if (pp->is_frozen) {
+    free(pp->is_frozen);
+  }
+  if (pp->nof_frozen) {
+    free(pp->nof_frozen);
+  }
+  if (pp->info_set) {
+    free(pp->info_set);
+  }
+  free(pp);
+}
+
+void* create_polar_decoder_scl_c_avx2(const uint8_t nMax, const uint8_t list_size)
+{
+  if (nMax > NMAX_LOG || (list_size != 4 && list_size != SCL_MAX_LIST)) {
+    return NULL;
+  }
+
+  struct pSCL_c_avx2* pp = calloc(1, sizeof(struct pSCL_c_avx2));
+  if (pp == NULL) {
+    return NULL;
+  }
+  pp->nMax      = nMax;
+  pp->list_size = list_size;
+
+  uint32_t N = 1U << nMax;
+
+  // Stage s takes 2^s elements per lane, all stages are aligned to SRSRAN_AVX2_B_SIZE
+  pp->llr[0]     = srsran_vec_i8_malloc(SCL_MAX_LANES * (2 * N - 1));
+  pp->beta[0]    = srsran_vec_u8_malloc(SCL_MAX_LANES * (2 * N - 1));
+  pp->bit        = srsran_vec_u8_malloc(SCL_MAX_LANES * N);
+  pp->parent     = srsran_vec_u8_malloc(SCL_MAX_LANES * N);
+  pp->is_frozen  = srsran_vec_u8_malloc(N);
+  pp->nof_frozen = srsran_vec_u16_malloc(N + 1);
+  pp->info_set   = srsran_vec_u16_malloc(N);
+  if (pp->llr[0] == NULL || pp->beta[0] == NULL || pp->bit == NULL || pp->parent == NULL || pp->is_frozen == NULL ||
+      pp->nof_frozen == NULL || pp->info_set == NULL) {
+    delete_polar_decoder_scl_c_avx2(pp);
+    return NULL;
+  }
+
+  for (uint8_t s = 1; s <= nMax; s++) {
+    pp->llr[s]  = pp->llr[s - 1] + SCL_MAX_LANES * (1U << (s - 1));
+    pp->beta[s] = pp->beta[s - 1] + SCL_MAX_LANES * (1U << (s - 1));
+  }
+
+  return pp;
+}
+
+/*!
+ * Computes the shuffle indices that apply the lane permutation \a perm->perm to 32-byte vectors.
+ */
+static void scl_perm_prepare(scl_perm_t* perm, uint32_t nof_lanes)
+{
+  uint8_t same[SRSRAN_AVX2_B_SIZE];
+  uint8_t cross[SRSRAN_AVX2_B_SIZE];
+
+  for (uint32_t k = 0; k < SRSRAN_AVX2_B_SIZE; k++) {
+    uint32_t src = (k / nof_lanes) * nof_lanes + perm->perm[k % nof_lanes];
+    bool     in  = (src / 16) == (k / 16);
+    same[k]      = in ? (uint8_t)(src % 16) : 0x80;
+    cross[k]     = in ? 0x80 : (uint8_t)(src % 16);
+  }
+
+  perm->same  = _mm256_loadu_si256((__m256i*)same);
+  perm->cross = _mm256_loadu_si256((__m256i*)cross);
+}
+
+/*!
+ * Applies a lane permutation to an interleaved vector of \a len bytes. Vectors shorter than \ref SRSRAN_AVX2_B_SIZE
+ * are processed as if they were \ref SRSRAN_AVX2_B_SIZE long, the extra bytes not being in use.
+ */
+static void scl_perm_apply(const scl_perm_t* perm, uint8_t* x, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i += SRSRAN_AVX2_B_SIZE) {
+    __m256i m_x    = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m256i m_swap = _mm256_permute2x128_si256(m_x, m_x, 0x01);
+    __m256i m_z    = _mm256_or_si256(_mm256_shuffle_epi8(m_x, perm->same), _mm256_shuffle_epi8(m_swap, perm->cross));
+    _mm256_storeu_si256((__m256i*)&x[i], m_z);
+  }
+}
+
+/*!
+ * Updates the path metrics and the partial sums of a node whose bits are all frozen. With the min-sum approximation,
+ * the metric penalty is the sum of the magnitudes of the negative node LLRs.
+ */
+static void scl_rate_0(struct pSCL_c_avx2* q, uint8_t s)
+{
+  uint32_t W   = q->nof_lanes;
+  uint32_t len = W << s;
+  int8_t*  llr = q->llr[s];
+  uint32_t i   = 0;
+
+  if (len >= SRSRAN_AVX2_B_SIZE) {
+    const __m256i M_ZERO = _mm256_setzero_si256();
+    int16_t       acc[SRSRAN_AVX2_B_SIZE];
+
+    while (i < len) {
+      // 16-bit accumulators cannot overflow in 256 iterations
+      uint32_t end    = SRSRAN_MIN(len, i + 256 * SRSRAN_AVX2_B_SIZE);
+      __m256i  acc_lo = M_ZERO;
+      __m256i  acc_hi = M_ZERO;
+      for (; i < end; i += SRSRAN_AVX2_B_SIZE) {
+        __m256i m_neg = _mm256_min_epi8(_mm256_loadu_si256((__m256i*)&llr[i]), M_ZERO);
+        acc_lo        = _mm256_sub_epi16(acc_lo, _mm256_cvtepi8_epi16(_mm256_castsi256_si128(m_neg)));
+        acc_hi        = _mm256_sub_epi16(acc_hi, _mm256_cvtepi8_epi16(_mm256_extracti128_si256(m_neg, 1)));
+      }
+      _mm256_storeu_si256((__m256i*)&acc[0], acc_lo);
+      _mm256_storeu_si256((__m256i*)&acc[16], acc_hi);
+      for (uint32_t k = 0; k < SRSRAN_AVX2_B_SIZE; k++) {
+        q->metric[k % W] += (uint32_t)acc[k];
+      }
+    }
+  } else {
+    for (; i < len; i++) {
+      if (llr[i] < 0) {
+        q->metric[i % W] += (uint32_t)(-llr[i]);
+      }
+    }
+  }
+
+  srsran_vec_u8_zero(q->beta[s], len);
+}
+
+/*!
+ * Selects the \f$L\f$ most likely paths out of the \f$2L\f$ candidates of a codeword. Appending the candidate
+ * index makes all the metrics different, and a candidate survives if less than \f$L\f$ candidates have a lower metric.
+ */
+static uint32_t scl_select(const uint32_t* metric, const int8_t* llr, uint32_t L)
+{
+  int32_t key[2 * SCL_MAX_LIST];
+
+  for (uint32_t p = 0; p < SCL_MAX_LIST; p++) {
+    if (p < L) {
+      key[p]                = (int32_t)((metric[p] << 4U) | p);
+      key[SCL_MAX_LIST + p] = (int32_t)(((metric[p] + abs(llr[p])) << 4U) | (SCL_MAX_LIST + p));
+    } else {
+      key[p]                = INT32_MAX;
+      key[SCL_MAX_LIST + p] = INT32_MAX;
+    }
+  }
+
+  __m256i m_key0 = _mm256_loadu_si256((__m256i*)&key[0]);
+  __m256i m_key1 = _mm256_loadu_si256((__m256i*)&key[SCL_MAX_LIST]);
+
+  uint32_t keep = 0;
+  for (uint32_t i = 0; i < 2 * SCL_MAX_LIST; i++) {
+    if (i % SCL_MAX_LIST >= L) {
+      continue;
+    }
+    __m256i  m_key = _mm256_set1_epi32(key[i]);
+    uint32_t lt0   = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(m_key, m_key0)));
+    uint32_t lt1   = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(m_key, m_key1)));
+    if ((uint32_t)(__builtin_popcount(lt0) + __builtin_popcount(lt1)) < L) {
+      keep |= 1U << i;
+    }
+  }
+
+  return keep;
+}
+
+/*!
+ * Decides the information bit \a u_idx: every path is split into two, and the \f$L\f$ paths with the lowest metric
+ * survive for every codeword. The surviving paths are then moved to their lanes in all the stages still in use.
+ */
+static void scl_fork(struct pSCL_c_avx2* q, uint8_t n, uint32_t u_idx)
+{
+  uint32_t      W   = q->nof_lanes;
+  uint32_t      L   = q->list_size;
+  uint32_t      P   = q->nof_paths;
+  const int8_t* llr = q->llr[0];
+
+  scl_perm_t perm;
+  uint8_t    bits[SCL_MAX_LANES];
+  uint32_t   metric[SCL_MAX_LANES];
+  bool       identity = true;
+
+  // Paths which are not active yet keep their lane
+  for (uint32_t l = 0; l < W; l++) {
+    perm.perm[l] = (uint8_t)l;
+    bits[l]      = 0;
+    metric[l]    = q->metric[l];
+  }
+
+  for (uint32_t base = 0; base + L <= W; base += L) {
+
+    if (2 * P <= L) {
+      // All the paths survive, the paths using the less likely bit are appended
+      for (uint32_t l = base; l < base + P; l++) {
+        bits[l] = llr[l] < 0;
+      }
+      for (uint32_t l = base + P; l < base + 2 * P; l++) {
+        perm.perm[l] = (uint8_t)(l - P);
+        bits[l]      = !bits[l - P];
+        metric[l]    = q->metric[l - P] + abs(llr[l - P]);
+      }
+      identity = false;
+      continue;
+    }
+
+    // Bit p of keep tells whether path p survives with its most likely bit, bit p + SCL_MAX_LIST with the other one
+    uint32_t keep = scl_select(&q->metric[base], &llr[base], L);
+    if ((keep & ((1U << L) - 1)) != (1U << L) - 1) {
+      identity = false;
+    }
+
+    // Paths keeping their most likely bit stay in their lane; the others fill the lanes that are left free
+    uint32_t free_lane = 0;
+    for (uint32_t l = base; l < base + L; l++) {
+      bits[l] = llr[l] < 0;
+    }
+    for (uint32_t p = 0; p < L; p++) {
+      if (!(keep & (1U << (SCL_MAX_LIST + p)))) {
+        continue;
+      }
+      while (keep & (1U << free_lane)) {
+        free_lane++;
+      }
+      uint32_t l   = base + free_lane;
+      perm.perm[l] = (uint8_t)(base + p);
+      bits[l]      = llr[base + p] >= 0;
+      metric[l]    = q->metric[base + p] + abs(llr[base + p]);
+      free_lane++;
+    }
+  }
+  q->nof_paths = (uint8_t)SRSRAN_MIN(2 * P, L);
+
+  // Move the surviving paths in the stages still in use: the LLRs of the nodes whose right child has not been
+  // decoded yet, and the partial sums of the left children already decoded
+  if (!identity) {
+    scl_perm_prepare(&perm, W);
+    for (uint8_t t = 1; t <= n; t++) {
+      uint32_t half = W << (t - 1);
+      if ((u_idx >> (t - 1)) & 1U) {
+        scl_perm_apply(&perm, q->beta[t], half);
+      } else if (t < n) {
+        // The channel LLRs are the same for all the paths of a codeword
+        scl_perm_apply(&perm, (uint8_t*)q->llr[t], 2 * half);
+      }
+    }
+  }
+
+  uint8_t* bit    = &q->bit[u_idx * W];
+  uint8_t* parent = &q->parent[u_idx * W];
+  for (uint32_t l = 0; l < W; l++) {
+    q->metric[l]  = metric[l];
+    q->beta[0][l] = bits[l] ? SCL_BIT_ONE : 0;
+    bit[l]        = bits[l];
+    parent[l]     = perm.perm[l];
+  }
+}
+
+/*!
+ * Decodes the node at stage \a s covering the bits starting at \a u_idx.
+ */
+static void scl_node(struct pSCL_c_avx2* q, uint8_t n, uint8_t s, uint32_t u_idx)
+{
+  uint32_t size = 1U << s;
+
+  if (q->nof_frozen[u_idx + size] - q->nof_frozen[u_idx] == size) {
+    scl_rate_0(q, s);
+    return;
+  }
+
+  if (s == 0) {
+    scl_fork(q, n, u_idx);
+    return;
+  }
+
+  uint32_t half = q->nof_lanes << (s - 1);
+  int8_t*  llr  = q->llr[s];
+  uint8_t* beta = q->beta[s];
+
+  // Every stage has room for SCL_MAX_LANES lanes, so the AVX2 functions can process more than half bytes: the extra
+  // outputs land in positions which are not in use or still to be overwritten
+  srsran_vec_function_f_ccc_avx2(llr, llr + half, q->llr[s - 1], half);
+  scl_node(q, n, s - 1, u_idx);
+  memcpy(beta, q->beta[s - 1], half);
+
+  srsran_vec_function_g_bccc_avx2(beta, llr, llr + half, q->llr[s - 1], half);
+  scl_node(q, n, s - 1, u_idx + size / 2);
+  srsran_vec_xor_bbb_avx2(beta, q->beta[s - 1], beta, half);
+  memcpy(beta + half, q->beta[s - 1], half);
+}
+
+/*!
+ * Writes the message of the path in lane \a lane by tracing back its parents.
+ */
+static void scl_traceback(const struct pSCL_c_avx2* q, uint32_t N, uint32_t lane, uint8_t* data)
+{
+  uint32_t W = q->nof_lanes;
+
+  srsran_vec_u8_zero(data, N);
+  for (uint32_t i = q->nof_info; i > 0; i--) {
+    uint32_t u_idx = q->info_set[i - 1];
+    data[u_idx]    = q->bit[u_idx * W + lane];
+    lane           = q->parent[u_idx * W + lane];
+  }
+}
+
+int polar_decoder_scl_c_avx2(void*                p,
+                             const int8_t* const* llr,
+                             uint8_t* const*      data_decoded,
+                             uint32_t             nof_cw,
+                             uint32_t             nof_candidates,
+                             uint8_t              code_size_log,
+                             const uint16_t*      frozen_set,
+                             uint16_t             frozen_set_size)
+{
+  struct pSCL_c_avx2* q = p;
+
+  if (q == NULL || llr == NULL || data_decoded == NULL || code_size_log > q->nMax) {
+    return -1;
+  }
+
+  uint32_t N = 1U << code_size_log;
+  uint32_t L = q->list_size;
+
+  srsran_vec_u8_zero(q->is_frozen, N);
+  for (uint32_t i = 0; i < frozen_set_size; i++) {
+    if (frozen_set[i] >= N) {
+      return -1;
+    }
+    q->is_frozen[frozen_set[i]] = 1;
+  }
+  q->nof_frozen[0] = 0;
+  q->nof_info      = 0;
+  for (uint32_t i = 0; i < N; i++) {
+    q->nof_frozen[i + 1] = q->nof_frozen[i] + q->is_frozen[i];
+    if (!q->is_frozen[i]) {
+      q->info_set[q->nof_info++] = (uint16_t)i;
+    }
+  }
+
+  nof_candidates = SRSRAN_MIN(nof_candidates, L);
+
+  uint32_t max_nof_cw = SCL_MAX_LANES / L;
+  for (uint32_t cw = 0; cw < nof_cw; cw += max_nof_cw) {
+    // The number of lanes must be a power of two, missing codewords are padded with null LLRs
+    uint32_t batch = SRSRAN_MIN(nof_cw - cw, max_nof_cw);
+    uint32_t G     = 1;
+    while (G < batch) {
+      G *= 2;
+    }
+    uint32_t W   = G * L;
+    q->nof_lanes = (uint8_t)W;
+    q->nof_paths = 1;
+    srsran_vec_u32_zero(q->metric, SCL_MAX_LANES);
+
+    int8_t* channel = q->llr[code_size_log];
+    for (uint32_t g = 0; g < G; g++) {
+      const int8_t* x = (g < batch) ? llr[cw + g] : NULL;
+      for (uint32_t i = 0; i < N; i++) {
+        int8_t   v     = (x == NULL) ? 0 : ((x[i] < -127) ? -127 : x[i]);
+        uint64_t bcast = (uint64_t)(uint8_t)v * 0x0101010101010101UL;
+        if (L == SCL_MAX_LIST) {
+          memcpy(&channel[i * W + g * L], &bcast, SCL_MAX_LIST);
+        } else {
+          memcpy(&channel[i * W + g * L], &bcast, SCL_MAX_LIST / 2);
+        }
+      }
+    }
+
+    scl_node(q, code_size_log, code_size_log, 0);
+
+    uint32_t nof_out = SRSRAN_MIN(nof_candidates, q->nof_paths);
+    for (uint32_t g = 0; g < batch; g++) {
+      // Sort the paths of the codeword by increasing metric
+      uint8_t order[SCL_MAX_LIST];
+      for (uint32_t p = 0; p < q->nof_paths; p++) {
+        uint32_t j = p;
+        while (j > 0 && q->metric[g * L + order[j - 1]] > q->metric[g * L + p]) {
+          order[j] = order[j - 1];
+          j--;
+        }
+        order[j] = (uint8_t)p;
+      }
+
+      for (uint32_t c = 0; c < nof_out; c++) {
+        scl_traceback(q, N, g * L + order[c], data_decoded[cw + g] + c * N);
+      }
+    }
+  }
+
+  return (int)SRSRAN_MIN(nof_candidates, q->nof_paths);
+}
+
+#endif // LV_HAVE_AVX2
@@ -0,0 +1,78 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_c_avx2.h
+ * \brief Declaration of the SC-list polar decoder inner functions working with
+ * 8-bit integer-valued LLRs and AVX2 instructions.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#ifndef POLAR_DECODER_SCL_C_AVX2_H
+#define POLAR_DECODER_SCL_C_AVX2_H
+
+#include <stdint.h>
+
+/*!
+ * Creates an SC-list polar decoder structure of type pSCL_c_avx2, and allocates memory for the decoding buffers.
+ *
+ * \param[in] nMax \f$log_2\f$ of the number of bits in the codeword.
+ * \param[in] list_size Number of decoding paths, 4 or 8.
+ * \return A pointer to a pSCL_c_avx2 structure if the function executes correctly, NULL otherwise.
+ */
+void* create_polar_decoder_scl_c_avx2(uint8_t nMax, uint8_t list_size);
+
+/*!
+ * The (8-bit, avx2) SC-list polar decoder "destructor": it frees all the resources allocated to the decoder.
+ *
+ * \param[in, out] p A pointer to the dismantled decoder.
+ */
+void delete_polar_decoder_scl_c_avx2(void* p);
+
+/*!
+ * Decodes a batch of codewords sharing the same code size and frozen set. The paths of up to
+ * \f$32 / L\f$ codewords are processed together by the same AVX2 instructions.
+ *
+ * For each codeword, the decoder writes the \a nof_candidates most likely paths to \a data_decoded, one after the
+ * other (\f$2^n\f$ bits each), sorted by increasing path metric.
+ *
+ * \param[in, out] p A pointer to the decoder.
+ * \param[in] llr Pointers to the LLRs of each codeword.
+ * \param[out] data_decoded Pointers to the decoded candidates of each codeword.
+ * \param[in] nof_cw Number of codewords.
+ * \param[in] nof_candidates Maximum number of candidates to return per codeword.
+ * \param[in] code_size_log \f$log_2\f$ of the number of bits in the codeword.
+ * \param[in] frozen_set The position of the frozen bits in the codeword.
+ * \param[in] frozen_set_size Number of frozen bits.
+ * \return The number of candidates written for every codeword if the function executes correctly, -1 otherwise.
+ */
+int polar_decoder_scl_c_avx2(void*                p,
+                             const int8_t* const* llr,
+                             uint8_t* const*      data_decoded,
+                             uint32_t             nof_cw,
+                             uint32_t             nof_candidates,
+                             uint8_t              code_size_log,
+                             const uint16_t*      frozen_set,
+                             uint16_t             frozen_set_size);
+
+#endif // POLAR_DECODER_SCL_C_AVX2_H
@@ -26,7 +26,8 @@
  *
  * A batch of example messages is randomly generated, frozen bits are added, encoded, rate-matched, 2-PAM modulated,
  * sent over an AWGN channel, rate-dematched, and, finally, decoded by all three types of
- * decoder. Transmitted and received messages are compared to estimate the WER.
+ * decoder. Transmitted and received messages are compared to estimate the WER. With AVX2, the batch is also
+ * decoded at once by the SC-list decoder, whose most likely candidate is compared.
  * Multiple batches are simulated if the number of errors is not significant
  * enough.
  *
@@ -162,6 +163,7 @@ int main(int argc, char** argv)
   uint8_t* data_rx_s      = NULL;
   uint8_t* data_rx_c      = NULL;
   uint8_t* data_rx_c_avx2 = NULL;
+  uint8_t* data_rx_c_scl  = NULL;
 
   uint8_t* input_enc       = NULL; // input encoder
   uint8_t* output_enc      = NULL; // output encoder
@@ -183,6 +185,7 @@ int main(int argc, char** argv)
   uint8_t* output_dec_s      = NULL; // output decoder
   uint8_t* output_dec_c      = NULL; // output decoder
   uint8_t* output_dec_c_avx2 = NULL; // output decoder
+  uint8_t* output_dec_c_scl  = NULL; // output decoder, all the list candidates
 
   double var[SNR_POINTS + 1];
 
@@ -198,12 +201,16 @@ int main(int argc, char** argv)
   int errors_symb_c = 0;
 #ifdef LV_HAVE_AVX2
   int errors_symb_c_avx2 = 0;
+  int errors_symb_c_scl  = 0;
 #endif
 
   int n_error_words[SNR_POINTS + 1];
   int n_error_words_s[SNR_POINTS + 1];
   int n_error_words_c[SNR_POINTS + 1];
   int n_error_words_c_avx2[SNR_POINTS + 1];
+#ifdef LV_HAVE_AVX2
+  int n_error_words_c_scl[SNR_POINTS + 1];
+#endif // LV_HAVE_AVX2
 
   int last_i_batch[SNR_POINTS + 1];
 
@@ -212,6 +219,9 @@ int main(int argc, char** argv)
   double         elapsed_time_dec_s[SNR_POINTS + 1];
   double         elapsed_time_dec_c[SNR_POINTS + 1];
   double         elapsed_time_dec_c_avx2[SNR_POINTS + 1];
+#ifdef LV_HAVE_AVX2
+  double elapsed_time_dec_c_scl[SNR_POINTS + 1];
+#endif // LV_HAVE_AVX2
 
   double elapsed_time_enc[SNR_POINTS + 1];
   double elapsed_time_enc_avx2[SNR_POINTS + 1];
@@ -238,7 +248,10 @@ int main(int argc, char** argv)
 #ifdef LV_HAVE_AVX2
   srsran_polar_encoder_t enc_avx2;
   srsran_polar_decoder_t dec_c_avx2; // 8-bit
-#endif                               // LV_HAVE_AVX2
+  srsran_polar_decoder_t dec_c_scl;  // 8-bit, list
+  const int8_t*          llr_c_scl_ptr[BATCH_SIZE];
+  uint8_t*               output_dec_c_scl_ptr[BATCH_SIZE];
+#endif // LV_HAVE_AVX2
 
   parse_args(argc, argv);
 
@@ -276,6 +289,9 @@ int main(int argc, char** argv)
 
   // initialize a POLAR decoder (8 bit, avx2)
   srsran_polar_decoder_init(&dec_c_avx2, SRSRAN_POLAR_DECODER_SSC_C_AVX2, nMax);
+
+  // initialize a POLAR SC-list decoder (8 bit, avx2)
+  srsran_polar_decoder_init(&dec_c_scl, SRSRAN_POLAR_DECODER_SCL8_C_AVX2, nMax);
 #endif // LV_HAVE_AVX2
 
 #ifdef DATA_ALL_ONES
@@ -288,6 +304,7 @@ int main(int argc, char** argv)
   data_rx_s      = srsran_vec_u8_malloc(K * BATCH_SIZE);
   data_rx_c      = srsran_vec_u8_malloc(K * BATCH_SIZE);
   data_rx_c_avx2 = srsran_vec_u8_malloc(K * BATCH_SIZE);
+  data_rx_c_scl  = srsran_vec_u8_malloc(K * BATCH_SIZE);
 
   input_enc       = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
   output_enc      = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
@@ -309,10 +326,12 @@ int main(int argc, char** argv)
   output_dec_s      = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
   output_dec_c      = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
   output_dec_c_avx2 = srsran_vec_u8_malloc(NMAX * BATCH_SIZE);
+  output_dec_c_scl  = srsran_vec_u8_malloc(NMAX * BATCH_SIZE * SRSRAN_POLAR_DECODER_MAX_LIST_SIZE);
 
-  if (!data_tx || !data_rx || !data_rx_s || !data_rx_c || !data_rx_c_avx2 || !input_enc || !output_enc ||
-      !output_enc_avx2 || !rm_codeword || !rm_llr || !rm_llr_s || !rm_llr_c || !rm_llr_c_avx2 || !llr || !llr_s ||
-      !llr_c || !llr_c_avx2 || !output_dec || !output_dec_s || !output_dec_c || !output_dec_c_avx2) {
+  if (!data_tx || !data_rx || !data_rx_s || !data_rx_c || !data_rx_c_avx2 || !data_rx_c_scl || !input_enc ||
+      !output_enc || !output_enc_avx2 || !rm_codeword || !rm_llr || !rm_llr_s || !rm_llr_c || !rm_llr_c_avx2 || !llr ||
+      !llr_s || !llr_c || !llr_c_avx2 || !output_dec || !output_dec_s || !output_dec_c || !output_dec_c_avx2 ||
+      !output_dec_c_scl) {
     perror("malloc");
     exit(-1);
   }
@@ -364,6 +383,10 @@ int main(int argc, char** argv)
     n_error_words_s[i_snr]      = 0;
     n_error_words_c[i_snr]      = 0;
     n_error_words_c_avx2[i_snr] = 0;
+#ifdef LV_HAVE_AVX2
+    elapsed_time_dec_c_scl[i_snr] = 0;
+    n_error_words_c_scl[i_snr]    = 0;
+#endif // LV_HAVE_AVX2
 
     int i_batch = 0;
     printf("\nBatch:\n  ");
@@ -629,6 +652,42 @@ int main(int argc, char** argv)
           n_error_words_c_avx2[i_snr]++;
         }
       }
+
+      // 8-bit avx2 SC-list decoding, the whole batch in one call
+      for (j = 0; j < BATCH_SIZE; j++) {
+        llr_c_scl_ptr[j]        = llr_c_avx2 + j * code.N;
+        output_dec_c_scl_ptr[j] = output_dec_c_scl + j * code.N * dec_c_scl.list_size;
+      }
+
+      gettimeofday(&t[1], NULL);
+      if (srsran_polar_decoder_decode_batch_c(&dec_c_scl,
+                                              llr_c_scl_ptr,
+                                              output_dec_c_scl_ptr,
+                                              BATCH_SIZE,
+                                              code.n,
+                                              code.F_set,
+                                              code.F_set_size) < 1) {
+        printf("ERROR: SC-list decoder failed. SNR= %f\n", snr_db_vec[i_snr]);
+        exit(-1);
+      }
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      elapsed_time_dec_c_scl[i_snr] += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+      // extract message bits of the most likely candidate
+      for (j = 0; j < BATCH_SIZE; j++) {
+        srsran_polar_chanalloc_rx(
+            output_dec_c_scl_ptr[j], data_rx_c_scl + j * K, code.K, code.nPC, code.K_set, code.PC_set);
+      }
+
+      // check errors 8-bits SC-list decoder
+      for (int i = 0; i < BATCH_SIZE; i++) {
+        errors_symb_c_scl = srsran_bit_diff(data_tx + i * K, data_rx_c_scl + i * K, K);
+
+        if (errors_symb_c_scl != 0) {
+          n_error_words_c_scl[i_snr]++;
+        }
+      }
 #endif // LV_HAVE_AVX2
 
       last_i_batch[i_snr] = i_batch;
@@ -669,6 +728,12 @@ int main(int argc, char** argv)
         printf("%e ", (float)n_error_words_c_avx2[i_snr] / last_i_batch[i_snr] / BATCH_SIZE);
       }
       printf("];\n");
+
+      printf("WER_8_SCL=[");
+      for (int i_snr = 0; i_snr < snr_points; i_snr++) {
+        printf("%e ", (float)n_error_words_c_scl[i_snr] / last_i_batch[i_snr] / BATCH_SIZE);
+      }
+      printf("];\n");
 #endif // LV_HAVE_AVX2
       break;
     case 1:
@@ -704,6 +769,12 @@ int main(int argc, char** argv)
                n_error_words_c_avx2[i_snr],
                last_i_batch[i_snr] * BATCH_SIZE * code.N,
                last_i_batch[i_snr] * BATCH_SIZE * code.N / (1000000 * elapsed_time_dec_c_avx2[i_snr]));
+        printf("SNR: %3.1f\t INT8-SCL  WER: %.8f %d/%d \t dec_thrput(Mbps): %.2f\n",
+               snr_db_vec[i_snr],
+               (double)n_error_words_c_scl[i_snr] / last_i_batch[i_snr] / BATCH_SIZE,
+               n_error_words_c_scl[i_snr],
+               last_i_batch[i_snr] * BATCH_SIZE * code.N,
+               last_i_batch[i_snr] * BATCH_SIZE * code.N / (1000000 * elapsed_time_dec_c_scl[i_snr]));
 #endif // LV_HAVE_AVX2
         printf("\n");
       }
@@ -767,6 +838,16 @@ int main(int argc, char** argv)
                last_i_batch[i_snr] * BATCH_SIZE / elapsed_time_dec_c_avx2[i_snr],
                last_i_batch[i_snr] * BATCH_SIZE * K / elapsed_time_dec_c_avx2[i_snr],
                last_i_batch[i_snr] * BATCH_SIZE * code.N / elapsed_time_dec_c_avx2[i_snr]);
+
+        printf("\n**** FIXED POINT (8 bits, AVX2, SC-list) ****");
+        printf("\nEstimated word error rate:\n  %e (%d errors)\n",
+               (double)n_error_words_c_scl[i_snr] / last_i_batch[i_snr] / BATCH_SIZE,
+               n_error_words_c_scl[i_snr]);
+
+        printf("Estimated throughput decoder:\n  %e word/s\n  %e bit/s (information)\n  %e bit/s (encoded)\n",
+               last_i_batch[i_snr] * BATCH_SIZE / elapsed_time_dec_c_scl[i_snr],
+               last_i_batch[i_snr] * BATCH_SIZE * K / elapsed_time_dec_c_scl[i_snr],
+               last_i_batch[i_snr] * BATCH_SIZE * code.N / elapsed_time_dec_c_scl[i_snr]);
 #endif // LV_HAVE_AVX2
 
         printf("\n");
@@ -799,8 +880,10 @@ int main(int argc, char** argv)
   free(output_dec_c);
 
   free(output_dec_c_avx2);
+  free(output_dec_c_scl);
   free(output_enc_avx2);
   free(data_rx_c_avx2);
+  free(data_rx_c_scl);
 
 #ifdef DATA_ALL_ONES
 #else
@@ -819,6 +902,7 @@ int main(int argc, char** argv)
 #ifdef LV_HAVE_AVX2
   srsran_polar_encoder_free(&enc_avx2);
   srsran_polar_decoder_free(&dec_c_avx2);
+  srsran_polar_decoder_free(&dec_c_scl);
 #endif // LV_HAVE_AVX2
 
   int expected_errors = 0;
@@ -851,13 +935,19 @@ int main(int argc, char** argv)
     } else {
       printf("\n(8 bit, avx2) Test completed successfully!\n\n");
     }
+
+    if (n_error_words_c_scl[0] > expected_errors) {
+      printf("\n(8 bit, avx2, SC-list) Test failed!\n\n");
+    } else {
+      printf("\n(8 bit, avx2, SC-list) Test completed successfully!\n\n");
+    }
 #endif // LV_HAVE_AVX2
     printf("\r");
 
     exit((n_error_words[0] > expected_errors) || (n_error_words_s[0] > expected_errors) ||
          (n_error_words_c[0] > expected_errors)
 #ifdef LV_HAVE_AVX2
-         || (n_error_words_c_avx2[0] > expected_errors)
+         || (n_error_words_c_avx2[0] > expected_errors) || (n_error_words_c_scl[0] > expected_errors)
 #endif // LV_HAVE_AVX2
     );
 
@@ -876,6 +966,10 @@ int main(int argc, char** argv)
         perror("8-bit avx2 performance at SNR = %d too low!");
         exit(-1);
       }
+      if (n_error_words_c_scl[i_snr] > 10 * n_error_words[i_snr]) {
+        perror("8-bit avx2 SC-list performance at SNR = %d too low!");
+        exit(-1);
+      }
 #endif // LV_HAVE_AVX2
     }
 
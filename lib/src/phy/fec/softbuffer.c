@@ -46,7 +46,8 @@ int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
   return srsran_softbuffer_rx_init_guru(q, max_cb, max_cb_size);
 }
 
-int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+static int
+softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size, bool use_8bit, bool alloc_cb)
 {
   int ret = SRSRAN_ERROR;
 
@@ -62,12 +63,21 @@ int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, u
   q->max_cb      = max_cb;
   q->max_cb_size = max_cb_size;
 
-  q->buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->max_cb);
-  if (!q->buffer_f) {
-    perror("malloc");
-    goto clean_exit;
+  if (use_8bit) {
+    q->buffer_c = SRSRAN_MEM_ALLOC(int8_t*, q->max_cb);
+    if (!q->buffer_c) {
+      perror("malloc");
+      goto clean_exit;
+    }
+    SRSRAN_MEM_ZERO(q->buffer_c, int8_t*, q->max_cb);
+  } else {
+    q->buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->max_cb);
+    if (!q->buffer_f) {
+      perror("malloc");
+      goto clean_exit;
+    }
+    SRSRAN_MEM_ZERO(q->buffer_f, int16_t*, q->max_cb);
   }
-  SRSRAN_MEM_ZERO(q->buffer_f, int16_t*, q->max_cb);
 
   q->data = SRSRAN_MEM_ALLOC(uint8_t*, q->max_cb);
   if (!q->data) {
@@ -83,10 +93,19 @@ int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, u
   }
 
   for (uint32_t i = 0; i < q->max_cb; i++) {
-    q->buffer_f[i] = srsran_vec_i16_malloc(q->max_cb_size);
-    if (!q->buffer_f[i]) {
-      perror("malloc");
-      goto clean_exit;
+    // Unless allocated here, the code block soft bits are attached by the caller
+    if (alloc_cb && use_8bit) {
+      q->buffer_c[i] = srsran_vec_i8_malloc(q->max_cb_size);
+      if (!q->buffer_c[i]) {
+        perror("malloc");
+        goto clean_exit;
+      }
+    } else if (alloc_cb) {
+      q->buffer_f[i] = srsran_vec_i16_malloc(q->max_cb_size);
+      if (!q->buffer_f[i]) {
+        perror("malloc");
+        goto clean_exit;
+      }
     }
 
     q->data[i] = srsran_vec_u8_malloc(q->max_cb_size / 8);
@@ -109,6 +128,21 @@ clean_exit:
   return ret;
 }
 
+int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_rx_init(q, max_cb, max_cb_size, false, true);
+}
+
+int srsran_softbuffer_rx_init_guru_c(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_rx_init(q, max_cb, max_cb_size, true, true);
+}
+
+int srsran_softbuffer_rx_init_lazy(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_rx_init(q, max_cb, max_cb_size, false, false);
+}
+
 void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
 {
   if (q) {
@@ -120,6 +154,14 @@ void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
       }
       free(q->buffer_f);
     }
+    if (q->buffer_c) {
+      for (uint32_t i = 0; i < q->max_cb; i++) {
+        if (q->buffer_c[i]) {
+          free(q->buffer_c[i]);
+        }
+      }
+      free(q->buffer_c);
+    }
     if (q->data) {
       for (uint32_t i = 0; i < q->max_cb; i++) {
         if (q->data[i]) {
@@ -149,14 +191,17 @@ void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* q)
 
 void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
 {
-  if (q->buffer_f) {
+  if (q->buffer_f || q->buffer_c) {
     if (nof_cb > q->max_cb) {
       nof_cb = q->max_cb;
     }
     for (uint32_t i = 0; i < nof_cb; i++) {
-      if (q->buffer_f[i]) {
+      if (q->buffer_f && q->buffer_f[i]) {
         srsran_vec_i16_zero(q->buffer_f[i], q->max_cb_size);
       }
+      if (q->buffer_c && q->buffer_c[i]) {
+        srsran_vec_i8_zero(q->buffer_c[i], q->max_cb_size);
+      }
       if (q->data[i]) {
         srsran_vec_u8_zero(q->data[i], q->max_cb_size / 8);
       }
@@ -189,7 +234,7 @@ int srsran_softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t nof_prb)
   return srsran_softbuffer_tx_init_guru(q, max_cb, max_cb_size);
 }
 
-int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+static int softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t max_cb, uint32_t max_cb_size, bool alloc_cb)
 {
   // Protect pointer
   if (!q) {
@@ -210,8 +255,14 @@ int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, u
   }
   SRSRAN_MEM_ZERO(q->buffer_b, uint8_t*, q->max_cb);
 
+  q->cb_encoded = SRSRAN_MEM_ALLOC(bool, q->max_cb);
+  if (!q->cb_encoded) {
+    perror("malloc");
+    return SRSRAN_ERROR;
+  }
+
   // TODO: Use HARQ buffer limitation based on UE category
-  for (uint32_t i = 0; i < q->max_cb; i++) {
+  for (uint32_t i = 0; i < q->max_cb && alloc_cb; i++) {
     q->buffer_b[i] = srsran_vec_u8_malloc(q->max_cb_size);
     if (!q->buffer_b[i]) {
       perror("malloc");
@@ -224,6 +275,16 @@ int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, u
   return SRSRAN_SUCCESS;
 }
 
+int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_tx_init(q, max_cb, max_cb_size, true);
+}
+
+int srsran_softbuffer_tx_init_lazy(srsran_softbuffer_tx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return softbuffer_tx_init(q, max_cb, max_cb_size, false);
+}
+
 void srsran_softbuffer_tx_free(srsran_softbuffer_tx_t* q)
 {
   if (q) {
@@ -235,6 +296,9 @@ void srsran_softbuffer_tx_free(srsran_softbuffer_tx_t* q)
       }
       free(q->buffer_b);
     }
+    if (q->cb_encoded) {
+      free(q->cb_encoded);
+    }
     SRSRAN_MEM_ZERO(q, srsran_softbuffer_tx_t, 1);
   }
 }
@@ -262,4 +326,7 @@ void srsran_softbuffer_tx_reset_cb(srsran_softbuffer_tx_t* q, uint32_t nof_cb)
       }
     }
   }
+  if (q->cb_encoded) {
+    SRSRAN_MEM_ZERO(q->cb_encoded, bool, SRSRAN_MIN(nof_cb, q->max_cb));
+  }
 }
@@ -71,6 +71,22 @@ void parse_args(int argc, char** argv)
   }
 }
 
+// Bit-serial reference, returns the CRC of every prefix of data
+static void crc_reference(const uint8_t* data, uint32_t nbits, uint32_t order, uint32_t poly, uint32_t* prefix_crc)
+{
+  uint32_t mask = (uint32_t)((1ULL << order) - 1);
+  uint32_t crc  = 0;
+  for (uint32_t i = 0; i < nbits; i++) {
+    prefix_crc[i] = crc;
+    uint32_t fb   = ((crc >> (order - 1)) & 1U) ^ (data[i] & 1U);
+    crc           = (crc << 1U) & mask;
+    if (fb) {
+      crc ^= poly & mask;
+    }
+  }
+  prefix_crc[nbits] = crc;
+}
+
 int main(int argc, char** argv)
 {
   int          i;
@@ -111,6 +127,28 @@ int main(int argc, char** argv)
 
   INFO("checksum=%x", crc_word);
 
+  // Check every length against the bit-serial reference, both for unpacked and packed data
+  uint32_t* prefix_crc = malloc(sizeof(uint32_t) * (num_bits + 1));
+  uint8_t*  packed     = srsran_vec_u8_malloc(num_bits / 8 + 1);
+  if (!prefix_crc || !packed) {
+    perror("malloc");
+    exit(-1);
+  }
+  crc_reference(data, num_bits, crc_length, crc_poly, prefix_crc);
+  srsran_bit_pack_vector(data, packed, num_bits);
+  for (i = 0; i <= num_bits; i++) {
+    if (srsran_crc_checksum(&crc_p, data, i) != prefix_crc[i]) {
+      ERROR("Mismatch for %d bits", i);
+      exit(-1);
+    }
+    if (i % 8 == 0 && srsran_crc_checksum_byte(&crc_p, packed, i) != prefix_crc[i]) {
+      ERROR("Mismatch for %d packed bits", i);
+      exit(-1);
+    }
+  }
+  free(prefix_crc);
+  free(packed);
+
   free(data);
 
   // check if generated word is as expected
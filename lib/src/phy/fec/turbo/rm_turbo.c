@@ -20,6 +20,7 @@
  */
 
 #include <math.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -79,6 +80,8 @@ static srsran_bit_interleaver_t bit_interleavers_parity_bits[192];
 static uint16_t                 deinterleaver[192][4][18448];
 static int                      k0_vec[SRSRAN_NOF_TC_CB_SIZES][4][2];
 static bool                     rm_turbo_tables_generated = false;
+// The tables are shared by all the instances, which may be initialised concurrently by the PHY workers
+static pthread_mutex_t rm_turbo_tables_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 // Store deinterleaver version for sub-block turbo decoder
 #if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
@@ -275,6 +278,7 @@ static void interleave_table_sb(uint16_t* in, uint16_t* out, uint32_t cb_idx, ui
 
 void srsran_rm_turbo_gentables()
 {
+  pthread_mutex_lock(&rm_turbo_tables_mutex);
   if (!rm_turbo_tables_generated) {
     rm_turbo_tables_generated = true;
     for (int cb_idx = 0; cb_idx < SRSRAN_NOF_TC_CB_SIZES; cb_idx++) {
@@ -314,10 +318,12 @@ void srsran_rm_turbo_gentables()
       }
     }
   }
+  pthread_mutex_unlock(&rm_turbo_tables_mutex);
 }
 
 void srsran_rm_turbo_free_tables()
 {
+  pthread_mutex_lock(&rm_turbo_tables_mutex);
   if (rm_turbo_tables_generated) {
     for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
       srsran_bit_interleaver_free(&bit_interleavers_systematic_bits[i]);
@@ -326,6 +332,7 @@ void srsran_rm_turbo_free_tables()
     rm_turbo_tables_generated = false;
   }
   rm_turbo_tables_generated = false;
+  pthread_mutex_unlock(&rm_turbo_tables_mutex);
 }
 
 /**
@@ -352,20 +359,47 @@ int srsran_rm_turbo_tx_lut(uint8_t* w_buff,
                            uint32_t rv_idx)
 {
   if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
-    int in_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
-
     /* Sub-block interleaver (5.1.4.1.1) and bit collection */
     if (rv_idx == 0) {
-      // Systematic bits
-      // srsran_bit_interleave(systematic, w_buff, interleaver_systematic_bits[cb_idx], in_len/3);
-      srsran_bit_interleaver_run(&bit_interleavers_systematic_bits[cb_idx], systematic, w_buff, 0);
-
-      // Parity bits
-      // srsran_bit_interleave_w_offset(parity, &w_buff[in_len/24], interleaver_parity_bits[cb_idx], 2*in_len/3, 4);
-      srsran_bit_interleaver_run(&bit_interleavers_parity_bits[cb_idx], parity, &w_buff[in_len / 24], 4);
+      srsran_rm_turbo_tx_lut_interleave(w_buff, systematic, parity, cb_idx);
     }
 
     /* Bit selection and transmission 5.1.4.1.2 */
+    return srsran_rm_turbo_tx_lut_select(w_buff, output, cb_idx, out_len, w_offset, rv_idx);
+  } else {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+}
+
+int srsran_rm_turbo_tx_lut_interleave(uint8_t* w_buff, uint8_t* systematic, uint8_t* parity, uint32_t cb_idx)
+{
+  if (cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
+    int in_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
+
+    // Systematic bits
+    // srsran_bit_interleave(systematic, w_buff, interleaver_systematic_bits[cb_idx], in_len/3);
+    srsran_bit_interleaver_run(&bit_interleavers_systematic_bits[cb_idx], systematic, w_buff, 0);
+
+    // Parity bits
+    // srsran_bit_interleave_w_offset(parity, &w_buff[in_len/24], interleaver_parity_bits[cb_idx], 2*in_len/3, 4);
+    srsran_bit_interleaver_run(&bit_interleavers_parity_bits[cb_idx], parity, &w_buff[in_len / 24], 4);
+
+    return 0;
+  } else {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+}
+
+int srsran_rm_turbo_tx_lut_select(uint8_t* w_buff,
+                                  uint8_t* output,
+                                  uint32_t cb_idx,
+                                  uint32_t out_len,
+                                  uint32_t w_offset,
+                                  uint32_t rv_idx)
+{
+  if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
+    int in_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
+
     int w_len = 0;
     int r_ptr = k0_vec[cb_idx][rv_idx][1];
     while (w_len < out_len) {
@@ -387,6 +421,25 @@ int srsran_rm_turbo_tx_lut(uint8_t* w_buff,
   }
 }
 
+/* Selects the 16-bit deinterleaver table matching the input format of the turbo decoder */
+static uint16_t* rm_turbo_rx_deinterleaver(uint32_t cb_idx, uint32_t rv_idx, bool enable_input_tdec)
+{
+#if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
+  int cb_len = srsran_cbsegm_cbsize(cb_idx);
+  int idx    = deinter_table_idx_from_sb_len(srsran_tdec_autoimp_get_subblocks(cb_len));
+  if (idx < 0 || !enable_input_tdec) {
+    return deinterleaver[cb_idx][rv_idx];
+  } else if (idx < NOF_DEINTER_TABLE_SB_IDX) {
+    return deinterleaver_sb[idx][cb_idx][rv_idx];
+  } else {
+    ERROR("Sub-block size index %d not supported in srsran_rm_turbo_rx_lut()", idx);
+    return NULL;
+  }
+#else
+  return deinterleaver[cb_idx][rv_idx];
+#endif
+}
+
 int srsran_rm_turbo_rx_lut(int16_t* input, int16_t* output, uint32_t in_len, uint32_t cb_idx, uint32_t rv_idx)
 {
   return srsran_rm_turbo_rx_lut_(input, output, in_len, cb_idx, rv_idx, true);
@@ -408,21 +461,10 @@ int srsran_rm_turbo_rx_lut_(int16_t* input,
                             bool     enable_input_tdec)
 {
   if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
-#if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
-    int       cb_len  = srsran_cbsegm_cbsize(cb_idx);
-    int       idx     = deinter_table_idx_from_sb_len(srsran_tdec_autoimp_get_subblocks(cb_len));
-    uint16_t* deinter = NULL;
-    if (idx < 0 || !enable_input_tdec) {
-      deinter = deinterleaver[cb_idx][rv_idx];
-    } else if (idx < NOF_DEINTER_TABLE_SB_IDX) {
-      deinter = deinterleaver_sb[idx][cb_idx][rv_idx];
-    } else {
-      ERROR("Sub-block size index %d not supported in srsran_rm_turbo_rx_lut()", idx);
+    uint16_t* deinter = rm_turbo_rx_deinterleaver(cb_idx, rv_idx, enable_input_tdec);
+    if (deinter == NULL) {
       return -1;
     }
-#else
-    uint16_t* deinter = deinterleaver[cb_idx][rv_idx];
-#endif
 
 #ifdef LV_HAVE_AVX
     return srsran_rm_turbo_rx_lut_avx(input, output, deinter, in_len, cb_idx, rv_idx);
@@ -444,6 +486,39 @@ int srsran_rm_turbo_rx_lut_(int16_t* input,
   }
 }
 
+int srsran_rm_turbo_rx_lut_gather(const int16_t*  input,
+                                  const uint32_t* input_lut,
+                                  int16_t*        output,
+                                  uint32_t        in_len,
+                                  uint32_t        cb_idx,
+                                  uint32_t        rv_idx)
+{
+  if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
+    uint16_t* deinter = rm_turbo_rx_deinterleaver(cb_idx, rv_idx, true);
+    if (deinter == NULL) {
+      return -1;
+    }
+
+    uint32_t out_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
+
+    // Every pass over the circular buffer reuses the same deinterleaver entries, the input is read in order of the
+    // rate-matched bits so it stays in cache while the code block is processed
+    for (uint32_t i = 0; i < in_len; i += out_len) {
+      const uint32_t* lut = &input_lut[i];
+      uint32_t        len = SRSRAN_MIN(out_len, in_len - i);
+      for (uint32_t j = 0; j < len; j++) {
+        int16_t x    = input[lut[j] & SRSRAN_RM_TURBO_RX_LUT_IDX_MASK];
+        int16_t sign = (lut[j] & SRSRAN_RM_TURBO_RX_LUT_NEG) ? -1 : 0;
+        output[deinter[j]] += (int16_t)((x ^ sign) - sign);
+      }
+    }
+    return 0;
+  } else {
+    printf("Invalid inputs rv_idx=%d, cb_idx=%d\n", rv_idx, cb_idx);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+}
+
 int srsran_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len, uint32_t cb_idx, uint32_t rv_idx)
 {
   if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
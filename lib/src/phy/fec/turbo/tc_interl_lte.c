@@ -19,6 +19,7 @@
  *
  */
 
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -107,3 +108,83 @@ int srsran_tc_interl_LTE_gen_interl(srsran_tc_interl_t* h, uint32_t long_cb, uin
 
   return 0;
 }
+
+/************************************************
+ *
+ *  SHARED LTE TURBO CODE INTERLEAVERS
+ *
+ ************************************************/
+
+/* The interleavers of all the code block sizes for one window (1, 8, 16 or 32 subblocks), built by the first turbo
+ * decoder that asks for them and released with the last one */
+typedef struct {
+  srsran_tc_interl_t interl[SRSRAN_NOF_TC_CB_SIZES];
+  uint32_t           refcount;
+} tc_interl_shared_t;
+
+static tc_interl_shared_t tc_interl_shared[4];
+static pthread_mutex_t    tc_interl_shared_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static int tc_interl_shared_idx(uint32_t interl_win)
+{
+  switch (interl_win) {
+    case 1:
+      return 0;
+    case 8:
+      return 1;
+    case 16:
+      return 2;
+    case 32:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+static void tc_interl_shared_free(tc_interl_shared_t* t)
+{
+  for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
+    srsran_tc_interl_free(&t->interl[i]);
+  }
+}
+
+const srsran_tc_interl_t* srsran_tc_interl_LTE_shared_get(uint32_t interl_win)
+{
+  int idx = tc_interl_shared_idx(interl_win);
+  if (idx < 0) {
+    ERROR("Invalid interleaver window %d", interl_win);
+    return NULL;
+  }
+
+  pthread_mutex_lock(&tc_interl_shared_mutex);
+  tc_interl_shared_t* t = &tc_interl_shared[idx];
+  if (t->refcount == 0) {
+    for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
+      if (srsran_tc_interl_init(&t->interl[i], srsran_cbsegm_cbsize(i)) < 0 ||
+          srsran_tc_interl_LTE_gen_interl(&t->interl[i], srsran_cbsegm_cbsize(i), interl_win) < 0) {
+        tc_interl_shared_free(t);
+        pthread_mutex_unlock(&tc_interl_shared_mutex);
+        return NULL;
+      }
+    }
+  }
+  t->refcount++;
+  pthread_mutex_unlock(&tc_interl_shared_mutex);
+
+  return t->interl;
+}
+
+void srsran_tc_interl_LTE_shared_put(uint32_t interl_win)
+{
+  int idx = tc_interl_shared_idx(interl_win);
+  if (idx < 0) {
+    return;
+  }
+
+  pthread_mutex_lock(&tc_interl_shared_mutex);
+  tc_interl_shared_t* t = &tc_interl_shared[idx];
+  if (t->refcount > 0 && --t->refcount == 0) {
+    tc_interl_shared_free(t);
+  }
+  pthread_mutex_unlock(&tc_interl_shared_mutex);
+}
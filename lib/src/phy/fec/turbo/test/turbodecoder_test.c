@@ -62,7 +62,8 @@ void usage(char* prog)
   printf("\t-N nof_repetitions [Default %d]\n", nof_repetitions);
   printf("\t-l frame_length [Default %d]\n", frame_length);
   printf("\t-e ebno in dB [Default scan]\n");
-  printf("\t-d Decoder implementation type: 0: Generic, 1: SSE, 2: SSE-window\n");
+  printf("\t-d Decoder implementation type: 0: Auto, 1: Generic, 2: SSE, 3: SSE-window, 4: NEON-window, 5: AVX-window,\n");
+  printf("\t   6: SSE8-window, 7: AVX8-window, 8: AVX512-window\n");
   printf("\t-t test: check errors on exit [Default disabled]\n");
   printf("\t-s seed [Default 0=time]\n");
 }
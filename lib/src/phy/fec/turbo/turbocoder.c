@@ -19,6 +19,7 @@
  *
  */
 
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -45,16 +46,20 @@ static uint16_t                 tcod_per_fw[188][6144];
 static srsran_bit_interleaver_t tcod_interleavers[188];
 
 static bool table_initiated = false;
+// The tables are shared by all the instances, which may be initialised concurrently by the PHY workers
+static pthread_mutex_t table_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 int srsran_tcod_init(srsran_tcod_t* h, uint32_t max_long_cb)
 {
   h->max_long_cb = max_long_cb;
   h->temp        = srsran_vec_malloc(max_long_cb / 8);
 
+  pthread_mutex_lock(&table_mutex);
   if (!table_initiated) {
     table_initiated = true;
     srsran_tcod_gentable();
   }
+  pthread_mutex_unlock(&table_mutex);
   return 0;
 }
 
@@ -65,12 +70,14 @@ void srsran_tcod_free(srsran_tcod_t* h)
     free(h->temp);
   }
 
+  pthread_mutex_lock(&table_mutex);
   if (table_initiated) {
     for (int i = 0; i < 188; i++) {
       srsran_bit_interleaver_free(&tcod_interleavers[i]);
     }
     table_initiated = false;
   }
+  pthread_mutex_unlock(&table_mutex);
 }
 
 /* Expects bits (1 byte = 1 bit) and produces bits. The systematic and parity bits are interlaced in the output */
@@ -211,16 +218,13 @@ int srsran_tcod_encode_lut(srsran_tcod_t* h,
     if (crc_cb) {
       int block_size_nocrc = (long_cb - crc_cb->order - ((last_cb) ? crc_tb->order : 0)) / 8;
 
-      /* if CRC pointer is given */
+      /* if CRC pointer is given, put the data bytes in the TB and CB CRC */
+      srsran_crc_checksum_put_bytes(crc_tb, input, block_size_nocrc);
+      srsran_crc_checksum_put_bytes(crc_cb, input, block_size_nocrc);
+
       for (int i = 0; i < block_size_nocrc; i++) {
         uint8_t in = input[i];
 
-        /* Put byte in TB CRC and save latest checksum */
-        srsran_crc_checksum_put_byte(crc_tb, in);
-
-        /* Put byte in CB CRC and save latest checksum */
-        srsran_crc_checksum_put_byte(crc_cb, in);
-
         /* Run actual encoder */
         tcod_lut_t l = tcod_lut[state0][in];
         parity[i]    = l.output;
@@ -260,11 +264,11 @@ int srsran_tcod_encode_lut(srsran_tcod_t* h,
       /* No CRC given */
       int block_size_nocrc = (long_cb - ((last_cb) ? crc_tb->order : 0)) / 8;
 
+      srsran_crc_checksum_put_bytes(crc_tb, input, block_size_nocrc);
+
       for (uint32_t i = 0; i < block_size_nocrc; i++) {
         uint8_t in = input[i];
 
-        srsran_crc_checksum_put_byte(crc_tb, in);
-
         tcod_lut_t l = tcod_lut[state0][in];
         parity[i]    = l.output;
         state0       = l.next_state;
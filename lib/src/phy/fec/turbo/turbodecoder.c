@@ -25,6 +25,7 @@
 #include <strings.h>
 
 #include "srsran/phy/fec/turbo/turbodecoder.h"
+#include "srsran/phy/utils/cpu_features.h"
 #include "srsran/phy/utils/vector.h"
 #include "srsran/srsran.h"
 
@@ -72,6 +73,12 @@ srsran_tdec_16bit_impl_t avx16_win_impl = {tdec_winavx16_init,
                                            tdec_winavx16_decision_byte};
 #endif
 
+/* AVX512 window implementation, in turbodecoder_avx512.c */
+#if defined(LV_HAVE_AVX512) || defined(SRSRAN_SIMD_DISPATCH_AVX512)
+#define TDEC_HAVE_AVX512
+extern srsran_tdec_16bit_impl_t avx512_16_win_impl;
+#endif
+
 /* SSE window implementation */
 #ifdef LV_HAVE_SSE
 #define WINIMP_IS_SSE8
@@ -112,6 +119,7 @@ srsran_tdec_16bit_impl_t arm16_win_impl = {tdec_winarm16_init,
 #define AUTO_16_SSE 0
 #define AUTO_16_SSEWIN 1
 #define AUTO_16_AVXWIN 2
+#define AUTO_16_AVX512WIN 3
 #define AUTO_8_SSEWIN 0
 #define AUTO_8_AVXWIN 1
 #define AUTO_16_GEN 0
@@ -147,6 +155,12 @@ uint32_t interleaver_idx(uint32_t nof_subblocks)
   }
 }
 
+/* Number of subblocks of the interleaver at the given index */
+static uint32_t interleaver_win(uint32_t idx)
+{
+  return idx ? (8 << (idx - 1)) : 1;
+}
+
 /* Initializes the turbo decoder object */
 int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_impl_type_t dec_type)
 {
@@ -195,6 +209,16 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
       h->current_llr_type = SRSRAN_TDEC_8;
       break;
 #endif /* LV_HAVE_AVX2 */
+#ifdef TDEC_HAVE_AVX512
+    case SRSRAN_TDEC_AVX512_WINDOW:
+      if (!srsran_cpu_has(SRSRAN_CPU_AVX512)) {
+        ERROR("Error decoder %d not supported by this CPU", dec_type);
+        goto clean_and_exit;
+      }
+      h->dec16[0]         = &avx512_16_win_impl;
+      h->current_llr_type = SRSRAN_TDEC_16;
+      break;
+#endif /* TDEC_HAVE_AVX512 */
     default:
       ERROR("Error decoder %d not supported", dec_type);
       goto clean_and_exit;
@@ -255,6 +279,11 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
     h->dec16[AUTO_16_AVXWIN] = &avx16_win_impl;
     h->dec8[AUTO_8_AVXWIN]   = &avx8_win_impl;
 #endif /* LV_HAVE_AVX2 */
+#ifdef TDEC_HAVE_AVX512
+    if (srsran_cpu_has(SRSRAN_CPU_AVX512)) {
+      h->dec16[AUTO_16_AVX512WIN] = &avx512_16_win_impl;
+    }
+#endif /* TDEC_HAVE_AVX512 */
 #else  /* HAVE_NEON | LV_HAVE_SSE */
     h->dec16[AUTO_16_SSE]    = &gen_impl;
     h->dec16[AUTO_16_SSEWIN] = &gen_impl;
@@ -275,18 +304,15 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
       }
     }
 
-    // Compute 1 interleaver for each possible nof_subblocks (1, 8, 16 or 32)
+    // Get 1 interleaver for each possible nof_subblocks (1, 8, 16 or 32)
     for (int s = 0; s < 4; s++) {
-      for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
-        if (srsran_tc_interl_init(&h->interleaver[s][i], srsran_cbsegm_cbsize(i)) < 0) {
-          goto clean_and_exit;
-        }
-        srsran_tc_interl_LTE_gen_interl(&h->interleaver[s][i], srsran_cbsegm_cbsize(i), s ? (8 << (s - 1)) : 1);
+      if ((h->interleaver[s] = srsran_tc_interl_LTE_shared_get(interleaver_win(s))) == NULL) {
+        goto clean_and_exit;
       }
     }
   } else {
     uint32_t nof_subblocks;
-    if (dec_type < SRSRAN_TDEC_SSE8_WINDOW) {
+    if (h->current_llr_type == SRSRAN_TDEC_16) {
       if ((h->nof_blocks16[0] = h->dec16[0]->tdec_init(&h->dec16_hdlr[0], h->max_long_cb)) < 0) {
         goto clean_and_exit;
       }
@@ -297,12 +323,9 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
       }
       nof_subblocks = h->nof_blocks8[0];
     }
-    for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
-      if (srsran_tc_interl_init(&h->interleaver[interleaver_idx(nof_subblocks)][i], srsran_cbsegm_cbsize(i)) < 0) {
-        goto clean_and_exit;
-      }
-      srsran_tc_interl_LTE_gen_interl(
-          &h->interleaver[interleaver_idx(nof_subblocks)][i], srsran_cbsegm_cbsize(i), nof_subblocks);
+    uint32_t s = interleaver_idx(nof_subblocks);
+    if ((h->interleaver[s] = srsran_tc_interl_LTE_shared_get(interleaver_win(s))) == NULL) {
+      goto clean_and_exit;
     }
   }
 
@@ -354,8 +377,8 @@ void srsran_tdec_free(srsran_tdec_t* h)
     }
   }
   for (int s = 0; s < 4; s++) {
-    for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
-      srsran_tc_interl_free(&h->interleaver[s][i]);
+    if (h->interleaver[s]) {
+      srsran_tc_interl_LTE_shared_put(interleaver_win(s));
     }
   }
 
@@ -380,6 +403,11 @@ static void tdec_decision_byte(srsran_tdec_t* h, uint8_t* output)
 /* Returns number of subblocks in automatic mode for this long_cb */
 uint32_t srsran_tdec_autoimp_get_subblocks(uint32_t long_cb)
 {
+#ifdef TDEC_HAVE_AVX512
+  if (!(long_cb % 32) && long_cb > 2048 && srsran_cpu_has(SRSRAN_CPU_AVX512)) {
+    return 32;
+  } else
+#endif
 #ifdef LV_HAVE_AVX2
   if (!(long_cb % 16) && long_cb > 800) {
     return 16;
@@ -396,6 +424,8 @@ static int tdec_sb_idx(uint32_t long_cb)
 {
   uint32_t nof_sb = srsran_tdec_autoimp_get_subblocks(long_cb);
   switch (nof_sb) {
+    case 32:
+      return AUTO_16_AVX512WIN;
     case 16:
       return AUTO_16_AVXWIN;
     case 8:
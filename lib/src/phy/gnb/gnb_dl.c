@@ -240,6 +240,31 @@ void srsran_gnb_dl_gen_signal(srsran_gnb_dl_t* q)
   }
 }
 
+int srsran_gnb_dl_gen_symbols(srsran_gnb_dl_t* q, uint32_t first_symbol, uint32_t nof_symbols)
+{
+  if (q == NULL || first_symbol + nof_symbols > SRSRAN_NSYMB_PER_SLOT_NR) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  float norm_factor = gnb_dl_get_norm_factor(q->pdsch.carrier.nof_prb);
+
+  for (uint32_t i = 0; i < q->nof_tx_antennas && nof_symbols > 0; i++) {
+    for (uint32_t l = first_symbol; l < first_symbol + nof_symbols; l++) {
+      if (srsran_ofdm_tx_symbol(&q->fft[i], l) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR_INVALID_INPUTS;
+      }
+    }
+
+    // The samples of consecutive symbols are contiguous
+    uint32_t start = srsran_ofdm_get_symbol_offset(&q->fft[i], first_symbol);
+    uint32_t end   = srsran_ofdm_get_symbol_offset(&q->fft[i], first_symbol + nof_symbols);
+    cf_t*    out   = &q->fft[i].cfg.out_buffer[start];
+    srsran_vec_sc_prod_cfc(out, norm_factor, out, end - start);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 float srsran_gnb_dl_get_maximum_signal_power_dBfs(uint32_t nof_prb)
 {
   return srsran_convert_amplitude_to_dB(gnb_dl_get_norm_factor(nof_prb)) +
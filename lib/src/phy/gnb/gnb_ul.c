@@ -103,6 +103,8 @@ int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args
     q->pusch_min_snr_dB = args->pusch_min_snr_dB;
   }
 
+  q->pucch_chest_valid = false;
+
   return SRSRAN_SUCCESS;
 }
 
@@ -132,7 +134,8 @@ int srsran_gnb_ul_set_carrier(srsran_gnb_ul_t* q, const srsran_carrier_nr_t* car
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  q->carrier = *carrier;
+  q->carrier           = *carrier;
+  q->pucch_chest_valid = false;
 
   if (gnb_ul_alloc_prb(q, carrier->nof_prb) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -172,6 +175,9 @@ int srsran_gnb_ul_fft(srsran_gnb_ul_t* q)
 
   srsran_ofdm_rx_sf(&q->fft);
 
+  // The PUCCH channel estimates of the previous slot are no longer valid
+  q->pucch_chest_valid = false;
+
   return SRSRAN_SUCCESS;
 }
 
@@ -205,6 +211,65 @@ int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_gnb_ul_flush_pusch(srsran_gnb_ul_t* q)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  return srsran_pusch_nr_decode_flush(&q->pusch);
+}
+
+static bool gnb_ul_pucch_resource_equal(const srsran_pucch_nr_resource_t* a, const srsran_pucch_nr_resource_t* b)
+{
+  return a->format == b->format && a->starting_prb == b->starting_prb &&
+         a->intra_slot_hopping == b->intra_slot_hopping && a->second_hop_prb == b->second_hop_prb &&
+         a->nof_symbols == b->nof_symbols && a->start_symbol_idx == b->start_symbol_idx &&
+         a->initial_cyclic_shift == b->initial_cyclic_shift && a->time_domain_occ == b->time_domain_occ &&
+         a->nof_prb == b->nof_prb && a->occ_lenth == b->occ_lenth && a->occ_index == b->occ_index &&
+         a->additional_dmrs == b->additional_dmrs;
+}
+
+static bool gnb_ul_pucch_cfg_equal(const srsran_pucch_nr_common_cfg_t* a, const srsran_pucch_nr_common_cfg_t* b)
+{
+  return a->group_hopping == b->group_hopping && a->hopping_id_present == b->hopping_id_present &&
+         a->hopping_id == b->hopping_id && a->scrambling_id_present == b->scrambling_id_present &&
+         a->scambling_id == b->scambling_id;
+}
+
+static int gnb_ul_pucch_estimate(srsran_gnb_ul_t*                    q,
+                                 const srsran_slot_cfg_t*            slot_cfg,
+                                 const srsran_pucch_nr_common_cfg_t* cfg,
+                                 const srsran_pucch_nr_resource_t*   resource)
+{
+  // Skip the estimation if the last one was done on the same resource in this slot
+  if (q->pucch_chest_valid && gnb_ul_pucch_resource_equal(&q->pucch_chest_resource, resource) &&
+      gnb_ul_pucch_cfg_equal(&q->pucch_chest_cfg, cfg)) {
+    return SRSRAN_SUCCESS;
+  }
+  q->pucch_chest_valid = false;
+
+  int ret = SRSRAN_ERROR;
+  switch (resource->format) {
+    case SRSRAN_PUCCH_NR_FORMAT_1:
+      ret = srsran_dmrs_pucch_format1_estimate(&q->pucch, cfg, slot_cfg, resource, q->sf_symbols[0], &q->chest_pucch);
+      break;
+    case SRSRAN_PUCCH_NR_FORMAT_2:
+      ret = srsran_dmrs_pucch_format2_estimate(&q->pucch, cfg, slot_cfg, resource, q->sf_symbols[0], &q->chest_pucch);
+      break;
+    default:; // Do nothing
+  }
+  if (ret < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  q->pucch_chest_valid    = true;
+  q->pucch_chest_resource = *resource;
+  q->pucch_chest_cfg      = *cfg;
+
+  return SRSRAN_SUCCESS;
+}
+
 static int gnb_ul_decode_pucch_format1(srsran_gnb_ul_t*                    q,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_pucch_nr_common_cfg_t* cfg,
@@ -225,8 +290,7 @@ static int gnb_ul_decode_pucch_format1(srsran_gnb_ul_t*                    q,
   }
 
   // Channel estimation
-  if (srsran_dmrs_pucch_format1_estimate(&q->pucch, cfg, slot_cfg, resource, q->sf_symbols[0], &q->chest_pucch) <
-      SRSRAN_SUCCESS) {
+  if (gnb_ul_pucch_estimate(q, slot_cfg, cfg, resource) < SRSRAN_SUCCESS) {
     ERROR("Error in PUCCH format 1 estimation");
     return SRSRAN_ERROR;
   }
@@ -263,8 +327,7 @@ static int gnb_ul_decode_pucch_format2(srsran_gnb_ul_t*                    q,
                                        const srsran_uci_cfg_nr_t*          uci_cfg,
                                        srsran_uci_value_nr_t*              uci_value)
 {
-  if (srsran_dmrs_pucch_format2_estimate(&q->pucch, cfg, slot_cfg, resource, q->sf_symbols[0], &q->chest_pucch) <
-      SRSRAN_SUCCESS) {
+  if (gnb_ul_pucch_estimate(q, slot_cfg, cfg, resource) < SRSRAN_SUCCESS) {
     ERROR("Error in PUCCH format 2 estimation");
     return SRSRAN_ERROR;
   }
@@ -1862,6 +1862,234 @@ void srsran_predecoding_set_mimo_decoder(srsran_mimo_decoder_t _mimo_decoder)
   mimo_decoder = _mimo_decoder;
 }
 
+/* Equalizes one RE, w whitens the received signal and the channel when it is not NULL */
+static inline void predecoding_nr_gen(cf_t* y[SRSRAN_MAX_PORTS],
+                                      cf_t* h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                      cf_t* x[SRSRAN_MAX_LAYERS],
+                                      uint32_t nof_rxant,
+                                      uint32_t nof_layers,
+                                      uint32_t k,
+                                      float    noise_estimate,
+                                      const cf_t w[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS])
+{
+  cf_t _y[SRSRAN_MAX_PORTS];
+  cf_t _h[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS];
+  cf_t a[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N];
+  cf_t b[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N];
+  cf_t z[SRSRAN_MAX_LAYERS];
+
+  for (uint32_t r = 0; r < nof_rxant; r++) {
+    _y[r] = 0;
+    for (uint32_t l = 0; l < nof_layers; l++) {
+      _h[l][r] = 0;
+    }
+    for (uint32_t c = 0; c < nof_rxant; c++) {
+      if (w == NULL && c != r) {
+        continue;
+      }
+      cf_t wrc = (w == NULL) ? 1.0f : w[r][c];
+      _y[r] += wrc * y[c][k];
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        _h[l][r] += wrc * h[l][c][k];
+      }
+    }
+  }
+
+  // A = H' x H + No, z = H' x y
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    for (uint32_t j = 0; j < nof_layers; j++) {
+      a[i][j] = (i == j) ? noise_estimate : 0.0f;
+      for (uint32_t r = 0; r < nof_rxant; r++) {
+        a[i][j] += conjf(_h[i][r]) * _h[j][r];
+      }
+    }
+    z[i] = 0;
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      z[i] += conjf(_h[i][r]) * _y[r];
+    }
+  }
+
+  srsran_mat_hermitian_inv_gen(a, b, nof_layers);
+
+  // x = inv(A) x z
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    cf_t acc = 0;
+    for (uint32_t j = 0; j < nof_layers; j++) {
+      acc += b[i][j] * z[j];
+    }
+    x[i][k] = acc;
+  }
+}
+
+#if SRSRAN_SIMD_CF_SIZE
+/* Equalizes SRSRAN_SIMD_CF_SIZE consecutive RE starting at k, one in each SIMD lane */
+static inline void predecoding_nr_simd(cf_t* y[SRSRAN_MAX_PORTS],
+                                       cf_t* h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                       cf_t* x[SRSRAN_MAX_LAYERS],
+                                       uint32_t nof_rxant,
+                                       uint32_t nof_layers,
+                                       uint32_t k,
+                                       float    noise_estimate,
+                                       const cf_t w[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS])
+{
+  simd_cf_t _y[SRSRAN_MAX_PORTS];
+  simd_cf_t _h[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS];
+  simd_cf_t a[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N];
+  simd_cf_t b[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N];
+  simd_cf_t z[SRSRAN_MAX_LAYERS];
+
+  if (w == NULL) {
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      _y[r] = srsran_simd_cfi_loadu(&y[r][k]);
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        _h[l][r] = srsran_simd_cfi_loadu(&h[l][r][k]);
+      }
+    }
+  } else {
+    simd_cf_t y_in[SRSRAN_MAX_PORTS];
+    simd_cf_t h_in[SRSRAN_MAX_LAYERS][SRSRAN_MAX_PORTS];
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      y_in[r] = srsran_simd_cfi_loadu(&y[r][k]);
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        h_in[l][r] = srsran_simd_cfi_loadu(&h[l][r][k]);
+      }
+    }
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      _y[r] = srsran_simd_cf_zero();
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        _h[l][r] = srsran_simd_cf_zero();
+      }
+      for (uint32_t c = 0; c < nof_rxant; c++) {
+        simd_cf_t wrc = srsran_simd_cf_set1(w[r][c]);
+        _y[r]         = srsran_simd_cf_add(_y[r], srsran_simd_cf_prod(wrc, y_in[c]));
+        for (uint32_t l = 0; l < nof_layers; l++) {
+          _h[l][r] = srsran_simd_cf_add(_h[l][r], srsran_simd_cf_prod(wrc, h_in[l][c]));
+        }
+      }
+    }
+  }
+
+  // A = H' x H + No, z = H' x y
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    for (uint32_t j = 0; j < nof_layers; j++) {
+      a[i][j] = (i == j) ? srsran_simd_cf_set1(noise_estimate) : srsran_simd_cf_zero();
+      for (uint32_t r = 0; r < nof_rxant; r++) {
+        a[i][j] = srsran_simd_cf_add(a[i][j], srsran_simd_cf_conjprod(_h[j][r], _h[i][r]));
+      }
+    }
+    z[i] = srsran_simd_cf_zero();
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      z[i] = srsran_simd_cf_add(z[i], srsran_simd_cf_conjprod(_y[r], _h[i][r]));
+    }
+  }
+
+  srsran_mat_hermitian_inv_simd(a, b, nof_layers);
+
+  // x = inv(A) x z
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    simd_cf_t acc = srsran_simd_cf_zero();
+    for (uint32_t j = 0; j < nof_layers; j++) {
+      acc = srsran_simd_cf_add(acc, srsran_simd_cf_prod(b[i][j], z[j]));
+    }
+    srsran_simd_cfi_storeu(&x[i][k], acc);
+  }
+}
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+static int predecoding_nr(cf_t*      y[SRSRAN_MAX_PORTS],
+                          cf_t*      h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                          cf_t*      x[SRSRAN_MAX_LAYERS],
+                          uint32_t   nof_rxant,
+                          uint32_t   nof_layers,
+                          uint32_t   nof_re,
+                          float      noise_estimate,
+                          const cf_t w[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS])
+{
+  if (nof_layers == 0 || nof_layers > nof_rxant || nof_rxant > SRSRAN_MAX_PORTS || nof_layers > SRSRAN_MAX_LAYERS) {
+    ERROR("Error predecoding NR: invalid combination of %d layers and %d rx antennas", nof_layers, nof_rxant);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Zero forcing is singular without noise, keep the inversion well conditioned
+  noise_estimate = isnormal(noise_estimate) ? noise_estimate : 1e-9f;
+
+  uint32_t k = 0;
+#if SRSRAN_SIMD_CF_SIZE
+  for (; k + SRSRAN_SIMD_CF_SIZE < nof_re + 1; k += SRSRAN_SIMD_CF_SIZE) {
+    predecoding_nr_simd(y, h, x, nof_rxant, nof_layers, k, noise_estimate, w);
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+  for (; k < nof_re; k++) {
+    predecoding_nr_gen(y, h, x, nof_rxant, nof_layers, k, noise_estimate, w);
+  }
+
+  return nof_re;
+}
+
+int srsran_predecoding_mmse_nr(cf_t*    y[SRSRAN_MAX_PORTS],
+                               cf_t*    h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                               cf_t*    x[SRSRAN_MAX_LAYERS],
+                               uint32_t nof_rxant,
+                               uint32_t nof_layers,
+                               uint32_t nof_re,
+                               float    noise_estimate)
+{
+  if (y == NULL || h == NULL || x == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  return predecoding_nr(y, h, x, nof_rxant, nof_layers, nof_re, noise_estimate, NULL);
+}
+
+int srsran_predecoding_irc_nr(cf_t*      y[SRSRAN_MAX_PORTS],
+                              cf_t*      h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                              cf_t*      x[SRSRAN_MAX_LAYERS],
+                              uint32_t   nof_rxant,
+                              uint32_t   nof_layers,
+                              uint32_t   nof_re,
+                              const cf_t R[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS])
+{
+  if (y == NULL || h == NULL || x == NULL || R == NULL || nof_rxant > SRSRAN_MAX_PORTS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Cholesky decomposition of the interference plus noise covariance, R = L x L'
+  cf_t L[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS] = {};
+  for (uint32_t j = 0; j < nof_rxant; j++) {
+    float d = __real__ R[j][j];
+    for (uint32_t c = 0; c < j; c++) {
+      d -= __real__(L[j][c] * conjf(L[j][c]));
+    }
+    if (!isnormal(d) || d < 0) {
+      ERROR("Error predecoding IRC: the covariance matrix is not positive definite");
+      return SRSRAN_ERROR;
+    }
+    L[j][j] = sqrtf(d);
+    for (uint32_t i = j + 1; i < nof_rxant; i++) {
+      cf_t v = R[i][j];
+      for (uint32_t c = 0; c < j; c++) {
+        v -= L[i][c] * conjf(L[j][c]);
+      }
+      L[i][j] = v / __real__ L[j][j];
+    }
+  }
+
+  // Whitening filter W = inv(L), lower triangular, so that the whitened interference plus noise is white and unitary
+  cf_t W[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS] = {};
+  for (uint32_t i = 0; i < nof_rxant; i++) {
+    W[i][i] = 1.0f / __real__ L[i][i];
+    for (uint32_t j = 0; j < i; j++) {
+      cf_t v = 0;
+      for (uint32_t c = j; c < i; c++) {
+        v -= L[i][c] * W[c][j];
+      }
+      W[i][j] = v * W[i][i];
+    }
+  }
+
+  return predecoding_nr(y, h, x, nof_rxant, nof_layers, nof_re, 1.0f, W);
+}
+
 /* 36.211 v10.3.0 Section 6.3.4 */
 int srsran_predecoding_type(cf_t*              y[SRSRAN_MAX_PORTS],
                             cf_t*              h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
@@ -1991,6 +2219,55 @@ int srsran_precoding_diversity(cf_t* x[SRSRAN_MAX_LAYERS],
   }
 }
 
+int srsran_precoding_diversity_cw(const cf_t* d,
+                                  cf_t*       y[SRSRAN_MAX_PORTS],
+                                  int         nof_ports,
+                                  int         nof_symbols,
+                                  float       scaling)
+{
+  if (nof_ports == 2) {
+    // Layer i of symbol n is d[2 * n + i], so port 0 transmits the codeword as it is
+    int   n    = nof_symbols / 2;
+    float norm = scaling * M_SQRT1_2;
+    srsran_vec_sc_prod_cfc(d, norm, y[0], 2 * n);
+    for (int i = 0; i < n; i++) {
+      y[1][2 * i]     = -conjf(d[2 * i + 1]) * norm;
+      y[1][2 * i + 1] = conjf(d[2 * i]) * norm;
+    }
+    return 2 * n;
+  } else if (nof_ports == 4) {
+    int   n    = nof_symbols / 4;
+    float norm = scaling / M_SQRT2;
+    for (int i = 0; i < n; i++) {
+      const cf_t* x = &d[4 * i];
+
+      y[0][4 * i]     = x[0] * norm;
+      y[0][4 * i + 1] = x[1] * norm;
+      y[0][4 * i + 2] = 0;
+      y[0][4 * i + 3] = 0;
+
+      y[1][4 * i]     = 0;
+      y[1][4 * i + 1] = 0;
+      y[1][4 * i + 2] = x[2] * norm;
+      y[1][4 * i + 3] = x[3] * norm;
+
+      y[2][4 * i]     = -conjf(x[1]) * norm;
+      y[2][4 * i + 1] = conjf(x[0]) * norm;
+      y[2][4 * i + 2] = 0;
+      y[2][4 * i + 3] = 0;
+
+      y[3][4 * i]     = 0;
+      y[3][4 * i + 1] = 0;
+      y[3][4 * i + 2] = -conjf(x[3]) * norm;
+      y[3][4 * i + 3] = conjf(x[2]) * norm;
+    }
+    return 4 * n;
+  } else {
+    ERROR("Number of ports must be 2 or 4 for transmit diversity (nof_ports=%d)", nof_ports);
+    return -1;
+  }
+}
+
 #ifdef LV_HAVE_AVX
 
 int srsran_precoding_cdd_2x2_avx(cf_t* x[SRSRAN_MAX_LAYERS], cf_t* y[SRSRAN_MAX_PORTS], int nof_symbols, float scaling)
@@ -799,48 +799,177 @@ void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
   }
 }
 
-void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
+/* Max-log 256QAM LLR of a single symbol, scaled by w */
+static inline void demod_256qam_symbol(cf_t symbol, float w, float llr[8])
+{
+  float real = -__real__ symbol;
+  float imag = -__imag__ symbol;
+  llr[0]     = w * real;
+  llr[1]     = w * imag;
+  real       = fabsf(real) - 8.0f / sqrtf(170.0f);
+  imag       = fabsf(imag) - 8.0f / sqrtf(170.0f);
+  llr[2]     = w * real;
+  llr[3]     = w * imag;
+  real       = fabsf(real) - 4.0f / sqrtf(170.0f);
+  imag       = fabsf(imag) - 4.0f / sqrtf(170.0f);
+  llr[4]     = w * real;
+  llr[5]     = w * imag;
+  real       = fabsf(real) - 2.0f / sqrtf(170.0f);
+  imag       = fabsf(imag) - 2.0f / sqrtf(170.0f);
+  llr[6]     = w * real;
+  llr[7]     = w * imag;
+}
+
+#ifdef LV_HAVE_SSE
+
+/* Computes the four LLR levels of the interleaved real and imaginary parts in y */
+static inline void demod_256qam_levels_sse(__m128 y, __m128 l[4])
+{
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+  l[0] = _mm_xor_ps(y, sign_mask);
+  l[1] = _mm_sub_ps(_mm_andnot_ps(sign_mask, l[0]), _mm_set1_ps(8.0f / sqrtf(170.0f)));
+  l[2] = _mm_sub_ps(_mm_andnot_ps(sign_mask, l[1]), _mm_set1_ps(4.0f / sqrtf(170.0f)));
+  l[3] = _mm_sub_ps(_mm_andnot_ps(sign_mask, l[2]), _mm_set1_ps(2.0f / sqrtf(170.0f)));
+}
+
+/* Weight of the two symbols of a register, it is scale if csi is NULL or scale times their csi otherwise */
+static inline __m128 demod_256qam_weight_sse(const float* csi, int i, __m128 scale)
 {
+  if (csi == NULL) {
+    return scale;
+  }
+  return _mm_mul_ps(scale, _mm_setr_ps(csi[i], csi[i], csi[i + 1], csi[i + 1]));
+}
+
+static void demod_256qam_lte_s_sse(const cf_t* symbols, const float* csi, int16_t* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m128i*     resultPtr  = (__m128i*)llr;
+  const __m128 scale_v    = _mm_set1_ps(SCALE_SHORT_CONV_QAM256);
+
+  int i = 0;
+  for (; i < nsymbols - 3; i += 4) {
+    __m128 l1[4], l2[4];
+    demod_256qam_levels_sse(_mm_loadu_ps(symbolsPtr), l1);
+    demod_256qam_levels_sse(_mm_loadu_ps(symbolsPtr + 4), l2);
+    symbolsPtr += 8;
+
+    __m128 w1 = demod_256qam_weight_sse(csi, i, scale_v);
+    __m128 w2 = demod_256qam_weight_sse(csi, i + 2, scale_v);
+
+    // Every 32 bit word holds the real and imaginary LLR of one level of one symbol
+    __m128i v[4];
+    for (int k = 0; k < 4; k++) {
+      v[k] = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(l1[k], w1)), _mm_cvtps_epi32(_mm_mul_ps(l2[k], w2)));
+    }
+
+    // Transpose, so that every register holds the eight LLR of one symbol
+    __m128i v01lo = _mm_unpacklo_epi32(v[0], v[1]);
+    __m128i v23lo = _mm_unpacklo_epi32(v[2], v[3]);
+    __m128i v01hi = _mm_unpackhi_epi32(v[0], v[1]);
+    __m128i v23hi = _mm_unpackhi_epi32(v[2], v[3]);
+    _mm_storeu_si128(resultPtr++, _mm_unpacklo_epi64(v01lo, v23lo));
+    _mm_storeu_si128(resultPtr++, _mm_unpackhi_epi64(v01lo, v23lo));
+    _mm_storeu_si128(resultPtr++, _mm_unpacklo_epi64(v01hi, v23hi));
+    _mm_storeu_si128(resultPtr++, _mm_unpackhi_epi64(v01hi, v23hi));
+  }
+
+  for (; i < nsymbols; i++) {
+    float l[8];
+    demod_256qam_symbol(symbols[i], SCALE_SHORT_CONV_QAM256 * (csi ? csi[i] : 1.0f), l);
+    for (int k = 0; k < 8; k++) {
+      llr[8 * i + k] = (int16_t)l[k];
+    }
+  }
+}
+
+static void demod_256qam_lte_b_sse(const cf_t* symbols, const float* csi, int8_t* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m128i*     resultPtr  = (__m128i*)llr;
+  const __m128 scale_v    = _mm_set1_ps(SCALE_BYTE_CONV_QAM256);
+
+  int i = 0;
+  for (; i < nsymbols - 7; i += 8) {
+    __m128 l[4][4];
+    __m128 w[4];
+    for (int j = 0; j < 4; j++) {
+      demod_256qam_levels_sse(_mm_loadu_ps(symbolsPtr), l[j]);
+      symbolsPtr += 4;
+      w[j] = demod_256qam_weight_sse(csi, i + 2 * j, scale_v);
+    }
+
+    // Every 16 bit word holds the real and imaginary LLR of one level of one symbol
+    __m128i v[4];
+    for (int k = 0; k < 4; k++) {
+      __m128i v01 = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(l[0][k], w[0])),
+                                    _mm_cvtps_epi32(_mm_mul_ps(l[1][k], w[1])));
+      __m128i v23 = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(l[2][k], w[2])),
+                                    _mm_cvtps_epi32(_mm_mul_ps(l[3][k], w[3])));
+      v[k]        = _mm_packs_epi16(v01, v23);
+    }
+
+    // Transpose, so that every 64 bit word holds the eight LLR of one symbol
+    __m128i v01lo = _mm_unpacklo_epi16(v[0], v[1]);
+    __m128i v23lo = _mm_unpacklo_epi16(v[2], v[3]);
+    __m128i v01hi = _mm_unpackhi_epi16(v[0], v[1]);
+    __m128i v23hi = _mm_unpackhi_epi16(v[2], v[3]);
+    _mm_storeu_si128(resultPtr++, _mm_unpacklo_epi32(v01lo, v23lo));
+    _mm_storeu_si128(resultPtr++, _mm_unpackhi_epi32(v01lo, v23lo));
+    _mm_storeu_si128(resultPtr++, _mm_unpacklo_epi32(v01hi, v23hi));
+    _mm_storeu_si128(resultPtr++, _mm_unpackhi_epi32(v01hi, v23hi));
+  }
+
+  for (; i < nsymbols; i++) {
+    float l[8];
+    demod_256qam_symbol(symbols[i], SCALE_BYTE_CONV_QAM256 * (csi ? csi[i] : 1.0f), l);
+    for (int k = 0; k < 8; k++) {
+      llr[8 * i + k] = (int8_t)l[k];
+    }
+  }
+}
+
+#endif /* LV_HAVE_SSE */
+
+static void demod_256qam_lte_csi_b(const cf_t* symbols, const float* csi, int8_t* llr, int nsymbols)
+{
+#ifdef LV_HAVE_SSE
+  demod_256qam_lte_b_sse(symbols, csi, llr, nsymbols);
+#else
   for (int i = 0; i < nsymbols; i++) {
-    float real = -__real__ symbols[i];
-    float imag = -__imag__ symbols[i];
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
-    real       = fabsf(real) - 8.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 8.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
-    real       = fabsf(real) - 4.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 4.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
-    real       = fabsf(real) - 2.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 2.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * real;
-    *(llr++)   = SCALE_BYTE_CONV_QAM256 * imag;
+    float l[8];
+    demod_256qam_symbol(symbols[i], SCALE_BYTE_CONV_QAM256 * (csi ? csi[i] : 1.0f), l);
+    for (int k = 0; k < 8; k++) {
+      llr[8 * i + k] = (int8_t)l[k];
+    }
   }
+#endif /* LV_HAVE_SSE */
 }
 
-void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
+static void demod_256qam_lte_csi_s(const cf_t* symbols, const float* csi, short* llr, int nsymbols)
 {
+#ifdef LV_HAVE_SSE
+  demod_256qam_lte_s_sse(symbols, csi, llr, nsymbols);
+#else
   for (int i = 0; i < nsymbols; i++) {
-    float real = -__real__ symbols[i];
-    float imag = -__imag__ symbols[i];
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
-    real       = fabsf(real) - 8.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 8.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
-    real       = fabsf(real) - 4.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 4.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
-    real       = fabsf(real) - 2.0f / sqrtf(170.0f);
-    imag       = fabsf(imag) - 2.0f / sqrtf(170.0f);
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * real;
-    *(llr++)   = SCALE_SHORT_CONV_QAM256 * imag;
+    float l[8];
+    demod_256qam_symbol(symbols[i], SCALE_SHORT_CONV_QAM256 * (csi ? csi[i] : 1.0f), l);
+    for (int k = 0; k < 8; k++) {
+      llr[8 * i + k] = (short)l[k];
+    }
   }
+#endif /* LV_HAVE_SSE */
+}
+
+void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  demod_256qam_lte_csi_b(symbols, NULL, llr, nsymbols);
+}
+
+void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
+{
+  demod_256qam_lte_csi_s(symbols, NULL, llr, nsymbols);
 }
 
 int srsran_demod_soft_demodulate(srsran_mod_t modulation, const cf_t* symbols, float* llr, int nsymbols)
@@ -917,3 +1046,51 @@ int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols,
   }
   return 0;
 }
+
+int srsran_demod_soft_demodulate_csi_b(srsran_mod_t modulation,
+                                       const cf_t*  symbols,
+                                       const float* csi,
+                                       int8_t*      llr,
+                                       int          nsymbols)
+{
+  if (modulation == SRSRAN_MOD_256QAM) {
+    demod_256qam_lte_csi_b(symbols, csi, llr, nsymbols);
+    return 0;
+  }
+
+  if (srsran_demod_soft_demodulate_b(modulation, symbols, llr, nsymbols)) {
+    return -1;
+  }
+
+  uint32_t qm = srsran_mod_bits_x_symbol(modulation);
+  for (int i = 0; i < nsymbols && csi != NULL; i++) {
+    for (uint32_t k = 0; k < qm; k++) {
+      llr[qm * i + k] = (int8_t)((float)llr[qm * i + k] * csi[i]);
+    }
+  }
+  return 0;
+}
+
+int srsran_demod_soft_demodulate_csi_s(srsran_mod_t modulation,
+                                       const cf_t*  symbols,
+                                       const float* csi,
+                                       short*       llr,
+                                       int          nsymbols)
+{
+  if (modulation == SRSRAN_MOD_256QAM) {
+    demod_256qam_lte_csi_s(symbols, csi, llr, nsymbols);
+    return 0;
+  }
+
+  if (srsran_demod_soft_demodulate_s(modulation, symbols, llr, nsymbols)) {
+    return -1;
+  }
+
+  uint32_t qm = srsran_mod_bits_x_symbol(modulation);
+  for (int i = 0; i < nsymbols && csi != NULL; i++) {
+    for (uint32_t k = 0; k < qm; k++) {
+      llr[qm * i + k] = (short)((float)llr[qm * i + k] * csi[i]);
+    }
+  }
+  return 0;
+}
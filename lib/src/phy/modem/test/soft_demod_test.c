@@ -36,7 +36,7 @@ static srsran_mod_t modulation = SRSRAN_MOD_NITEMS;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64)\n", prog);
+  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256)\n", prog);
   printf("\t-n num_bits [Default %d]\n", num_bits);
   printf("\t-f nof_frames [Default %d]\n", nof_frames);
   printf("\t-v srsran_verbose [Default None]\n");
@@ -118,6 +118,9 @@ int main(int argc, char** argv)
   float*               llr;
   short*               llr_s;
   int8_t*              llr_b;
+  float*               csi;
+  short*               llr_csi_s;
+  int8_t*              llr_csi_b;
 
   parse_args(argc, argv);
 
@@ -165,6 +168,24 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  csi = srsran_vec_f_malloc(num_bits / mod.nbits_x_symbol);
+  if (!csi) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  llr_csi_s = srsran_vec_i16_malloc(num_bits);
+  if (!llr_csi_s) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  llr_csi_b = srsran_vec_i8_malloc(num_bits);
+  if (!llr_csi_b) {
+    perror("malloc");
+    exit(-1);
+  }
+
   /* generate random data */
   srand(0);
 
@@ -177,6 +198,9 @@ int main(int argc, char** argv)
     for (i = 0; i < num_bits; i++) {
       input[i] = rand() % 2;
     }
+    for (i = 0; i < num_bits / mod.nbits_x_symbol; i++) {
+      csi[i] = 0.1f + 0.9f * (float)rand() / (float)RAND_MAX;
+    }
 
     /* modulate */
     srsran_mod_modulate(&mod, input, symbols, num_bits);
@@ -209,6 +233,9 @@ int main(int argc, char** argv)
       mean_texec_b = SRSRAN_VEC_CMA((float)t[0].tv_usec, mean_texec_b, n - 1);
     }
 
+    srsran_demod_soft_demodulate_csi_s(modulation, symbols, csi, llr_csi_s, num_bits / mod.nbits_x_symbol);
+    srsran_demod_soft_demodulate_csi_b(modulation, symbols, csi, llr_csi_b, num_bits / mod.nbits_x_symbol);
+
     if (SRSRAN_VERBOSE_ISDEBUG()) {
       printf("bits=");
       srsran_vec_fprint_b(stdout, input, num_bits);
@@ -233,10 +260,28 @@ int main(int argc, char** argv)
         goto clean_exit;
       }
     }
+
+    // Check the fixed point LLR agree with the floating point ones, and that the CSI weights them
+    for (int i = 0; i < num_bits; i++) {
+      float w = csi[i / mod.nbits_x_symbol];
+      if ((fabsf(llr[i]) > 0.05f && (llr_s[i] > 0) != (llr[i] > 0)) ||
+          (fabsf(llr[i]) > 0.05f && (llr_b[i] > 0) != (llr[i] > 0))) {
+        printf("Error in fixed point LLR %d\n", i);
+        goto clean_exit;
+      }
+      if (fabsf((float)llr_csi_s[i] - w * (float)llr_s[i]) > 2.0f ||
+          fabsf((float)llr_csi_b[i] - w * (float)llr_b[i]) > 2.0f) {
+        printf("Error in CSI weighted LLR %d\n", i);
+        goto clean_exit;
+      }
+    }
   }
   ret = 0;
 
 clean_exit:
+  free(llr_csi_b);
+  free(llr_csi_s);
+  free(csi);
   free(llr_b);
   free(llr_s);
   free(llr);
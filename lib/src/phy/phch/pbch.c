@@ -190,6 +190,10 @@ int srsran_pbch_init(srsran_pbch_t* q)
     if (!q->rm_b) {
       goto clean;
     }
+    q->rm_b_tx = srsran_vec_u8_malloc(q->nof_symbols * 2);
+    if (!q->rm_b_tx) {
+      goto clean;
+    }
 
     ret = SRSRAN_SUCCESS;
   }
@@ -226,6 +230,9 @@ void srsran_pbch_free(srsran_pbch_t* q)
   if (q->rm_b) {
     free(q->rm_b);
   }
+  if (q->rm_b_tx) {
+    free(q->rm_b_tx);
+  }
   if (q->d) {
     free(q->d);
   }
@@ -250,7 +257,8 @@ int srsran_pbch_set_cell(srsran_pbch_t* q, srsran_cell_t cell)
         return SRSRAN_ERROR;
       }
     }
-    q->nof_symbols = (SRSRAN_CP_ISNORM(q->cell.cp)) ? PBCH_RE_CP_NORM : PBCH_RE_CP_EXT;
+    q->nof_symbols           = (SRSRAN_CP_ISNORM(q->cell.cp)) ? PBCH_RE_CP_NORM : PBCH_RE_CP_EXT;
+    q->encoded_payload_valid = false;
 
     ret = SRSRAN_SUCCESS;
   }
@@ -575,18 +583,24 @@ int srsran_pbch_encode(srsran_pbch_t* q,
 
     frame_idx = frame_idx % 4;
 
-    memcpy(q->data, bch_payload, sizeof(uint8_t) * SRSRAN_BCH_PAYLOAD_LEN);
+    /* encode, the payload is the same for the 4 radio frames the encoded bits span */
+    if (!q->encoded_payload_valid || memcmp(q->encoded_payload, bch_payload, SRSRAN_BCH_PAYLOAD_LEN) != 0) {
+      memcpy(q->data, bch_payload, sizeof(uint8_t) * SRSRAN_BCH_PAYLOAD_LEN);
+      srsran_crc_attach(&q->crc, q->data, SRSRAN_BCH_PAYLOAD_LEN);
+      srsran_crc_set_mask(q->data, q->cell.nof_ports);
 
-    /* encode & modulate */
-    srsran_crc_attach(&q->crc, q->data, SRSRAN_BCH_PAYLOAD_LEN);
-    srsran_crc_set_mask(q->data, q->cell.nof_ports);
+      srsran_convcoder_encode(&q->encoder, q->data, q->data_enc, SRSRAN_BCH_PAYLOADCRC_LEN);
 
-    srsran_convcoder_encode(&q->encoder, q->data, q->data_enc, SRSRAN_BCH_PAYLOADCRC_LEN);
+      srsran_rm_conv_tx(q->data_enc, SRSRAN_BCH_ENCODED_LEN, q->rm_b, 4 * nof_bits);
 
-    srsran_rm_conv_tx(q->data_enc, SRSRAN_BCH_ENCODED_LEN, q->rm_b, 4 * nof_bits);
+      memcpy(q->encoded_payload, bch_payload, sizeof(uint8_t) * SRSRAN_BCH_PAYLOAD_LEN);
+      q->encoded_payload_valid = true;
+    }
 
-    srsran_scrambling_b_offset(&q->seq, &q->rm_b[frame_idx * nof_bits], frame_idx * nof_bits, nof_bits);
-    srsran_mod_modulate(&q->mod, &q->rm_b[frame_idx * nof_bits], q->d, nof_bits);
+    /* scramble & modulate */
+    memcpy(q->rm_b_tx, &q->rm_b[frame_idx * nof_bits], sizeof(uint8_t) * nof_bits);
+    srsran_scrambling_b_offset(&q->seq, q->rm_b_tx, frame_idx * nof_bits, nof_bits);
+    srsran_mod_modulate(&q->mod, q->rm_b_tx, q->d, nof_bits);
 
     /* layer mapping & precoding */
     if (q->cell.nof_ports > 1) {
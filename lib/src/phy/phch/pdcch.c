@@ -44,6 +44,9 @@
 #define NOF_CCE(cfi) ((cfi > 0 && cfi < 4) ? q->nof_cce[cfi - 1] : 0)
 #define NOF_REGS(cfi) ((cfi > 0 && cfi < 4) ? q->nof_regs[cfi - 1] : 0)
 
+// Upper bound of the number of CCE, all the REs of 3 OFDM symbols of the largest cell
+#define PDCCH_MAX_NOF_CCE (SRSRAN_MAX_PRB * 3 * 12 * 2 / 72)
+
 float srsran_pdcch_coderate(uint32_t nof_bits, uint32_t l)
 {
   static const int nof_bits_x_symbol = 2; // QPSK
@@ -89,6 +92,13 @@ static int pdcch_init(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_anten
 
     srsran_vec_f_zero(q->llr, q->max_bits);
 
+    if (q->is_ue) {
+      q->rm_f_batch = srsran_vec_f_malloc(SRSRAN_PDCCH_MAX_BATCH * 3 * (SRSRAN_DCI_MAX_BITS + 16));
+      if (!q->rm_f_batch) {
+        goto clean;
+      }
+    }
+
     q->d = srsran_vec_cf_malloc(q->max_bits / 2);
     if (!q->d) {
       goto clean;
@@ -140,6 +150,9 @@ void srsran_pdcch_free(srsran_pdcch_t* q)
   if (q->llr) {
     free(q->llr);
   }
+  if (q->rm_f_batch) {
+    free(q->rm_f_batch);
+  }
   if (q->d) {
     free(q->d);
   }
@@ -328,6 +341,15 @@ uint32_t srsran_pdcch_common_locations_ncce(uint32_t nof_cce, srsran_dci_locatio
   return k;
 }
 
+static uint16_t pdcch_dci_crc_rem(srsran_pdcch_t* q, uint8_t* data, uint32_t nof_bits)
+{
+  uint8_t* x      = &data[nof_bits];
+  uint16_t p_bits = (uint16_t)srsran_bit_pack(&x, 16);
+  uint16_t crc    = ((uint16_t)srsran_crc_checksum(&q->crc, data, nof_bits) & 0xffff);
+
+  return p_bits ^ crc;
+}
+
 /** 36.212 5.3.3.2 to 5.3.3.4
  *
  * Returns XOR between parity and remainder bits
@@ -336,9 +358,6 @@ uint32_t srsran_pdcch_common_locations_ncce(uint32_t nof_cce, srsran_dci_locatio
  */
 int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t E, uint32_t nof_bits, uint16_t* crc)
 {
-  uint16_t p_bits, crc_res;
-  uint8_t* x;
-
   if (q != NULL) {
     if (data != NULL && E <= q->max_bits && nof_bits <= SRSRAN_DCI_MAX_BITS) {
       srsran_vec_f_zero(q->rm_f, 3 * (SRSRAN_DCI_MAX_BITS + 16));
@@ -351,12 +370,8 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
       /* viterbi decoder */
       srsran_viterbi_decode_f(&q->decoder, q->rm_f, data, nof_bits + 16);
 
-      x       = &data[nof_bits];
-      p_bits  = (uint16_t)srsran_bit_pack(&x, 16);
-      crc_res = ((uint16_t)srsran_crc_checksum(&q->crc, data, nof_bits) & 0xffff);
-
       if (crc) {
-        *crc = p_bits ^ crc_res;
+        *crc = pdcch_dci_crc_rem(q, data, nof_bits);
       }
 
       return SRSRAN_SUCCESS;
@@ -369,6 +384,52 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+/* Checks the location of a DCI candidate. Returns its payload size, 0 if the LLRs are too weak to be decoded or
+ * SRSRAN_ERROR_INVALID_INPUTS if the location is out of the control region */
+static int
+pdcch_msg_prepare(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg, float* mean)
+{
+  if (msg->location.ncce * 72 + PDCCH_FORMAT_NOF_BITS(msg->location.L) > NOF_CCE(sf->cfi) * 72) {
+    ERROR("Invalid location: nCCE: %d, L: %d, NofCCE: %d", msg->location.ncce, msg->location.L, NOF_CCE(sf->cfi));
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t nof_bits = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, msg->format);
+  uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
+
+  // Compute absolute mean of the LLRs
+  double m = 0;
+  for (int i = 0; i < e_bits; i++) {
+    m += fabsf(q->llr[msg->location.ncce * 72 + i]);
+  }
+  m /= e_bits;
+  *mean = (float)m;
+
+  if (*mean > 0.3f) {
+    return (int)nof_bits;
+  }
+
+  INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f", msg->location.ncce, msg->location.L, nof_bits, *mean);
+  return 0;
+}
+
+/* Completes a decoded DCI candidate: stores its size and resolves the Format0/1A ambiguity */
+static void pdcch_msg_decoded(srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg, uint32_t nof_bits, float mean)
+{
+  msg->nof_bits = nof_bits;
+  // Check format differentiation
+  if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
+    msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
+  }
+  INFO("Decoded DCI: nCCE=%d, L=%d, format=%s, msg_len=%d, mean=%f, crc_rem=0x%x",
+       msg->location.ncce,
+       msg->location.L,
+       srsran_dci_format_string(msg->format),
+       nof_bits,
+       mean,
+       msg->rnti);
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srsran_pdcch_t structure by the function
  * srsran_pdcch_extract_llr(). This function can be called multiple times.
  * The location to search for is obtained from msg.
@@ -379,47 +440,95 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
   if (q != NULL && msg != NULL && srsran_dci_location_isvalid(&msg->location)) {
-    if (msg->location.ncce * 72 + PDCCH_FORMAT_NOF_BITS(msg->location.L) > NOF_CCE(sf->cfi) * 72) {
-      ERROR("Invalid location: nCCE: %d, L: %d, NofCCE: %d", msg->location.ncce, msg->location.L, NOF_CCE(sf->cfi));
-    } else {
+    float mean     = 0;
+    int   nof_bits = pdcch_msg_prepare(q, sf, dci_cfg, msg, &mean);
+    if (nof_bits > 0) {
+      uint32_t e_bits = PDCCH_FORMAT_NOF_BITS(msg->location.L);
+
+      ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+      if (ret == SRSRAN_SUCCESS) {
+        pdcch_msg_decoded(dci_cfg, msg, nof_bits, mean);
+      } else {
+        ERROR("Error calling pdcch_dci_decode");
+      }
+    } else if (nof_bits == 0) {
       ret = SRSRAN_SUCCESS;
+    }
+  } else if (msg != NULL) {
+    ERROR("Invalid parameters, location=%d,%d", msg->location.ncce, msg->location.L);
+  }
+  return ret;
+}
+
+int srsran_pdcch_decode_msg_batch(srsran_pdcch_t*     q,
+                                  srsran_dl_sf_cfg_t* sf,
+                                  srsran_dci_cfg_t*   dci_cfg,
+                                  srsran_dci_msg_t*   msg,
+                                  uint32_t            nof_msg)
+{
+  if (q == NULL || msg == NULL || q->rm_f_batch == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-      uint32_t nof_bits = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, msg->format);
-      uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
+  for (uint32_t i0 = 0; i0 < nof_msg; i0 += SRSRAN_PDCCH_MAX_BATCH) {
+    srsran_dci_msg_t* m = &msg[i0];
+    uint32_t          n = SRSRAN_MIN(SRSRAN_PDCCH_MAX_BATCH, nof_msg - i0);
+    int               nof_bits[SRSRAN_PDCCH_MAX_BATCH];
+    float             mean[SRSRAN_PDCCH_MAX_BATCH];
 
-      // Compute absolute mean of the LLRs
-      double mean = 0;
-      for (int i = 0; i < e_bits; i++) {
-        mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
+    for (uint32_t i = 0; i < n; i++) {
+      if (!srsran_dci_location_isvalid(&m[i].location)) {
+        ERROR("Invalid parameters, location=%d,%d", m[i].location.ncce, m[i].location.L);
+        return SRSRAN_ERROR_INVALID_INPUTS;
       }
-      mean /= e_bits;
-
-      if (mean > 0.3f) {
-        ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
-        if (ret == SRSRAN_SUCCESS) {
-          msg->nof_bits = nof_bits;
-          // Check format differentiation
-          if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
-            msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
-          }
-        } else {
-          ERROR("Error calling pdcch_dci_decode");
+      nof_bits[i] = pdcch_msg_prepare(q, sf, dci_cfg, &m[i], &mean[i]);
+      if (nof_bits[i] < 0) {
+        return SRSRAN_ERROR_INVALID_INPUTS;
+      }
+      if (nof_bits[i] > SRSRAN_DCI_MAX_BITS) {
+        ERROR("Invalid parameters: nof_bits: %d", nof_bits[i]);
+        return SRSRAN_ERROR_INVALID_INPUTS;
+      }
+    }
+
+    // Decode together all the pending candidates with the same payload size as the first one
+    for (uint32_t i = 0; i < n; i++) {
+      if (nof_bits[i] == 0) {
+        continue;
+      }
+
+      uint32_t len = (uint32_t)nof_bits[i];
+      uint32_t idx[SRSRAN_PDCCH_MAX_BATCH];
+      float*   symbols[SRSRAN_PDCCH_MAX_BATCH];
+      uint8_t* data[SRSRAN_PDCCH_MAX_BATCH];
+      uint32_t count = 0;
+
+      for (uint32_t j = i; j < n; j++) {
+        if (nof_bits[j] == len) {
+          idx[count]     = j;
+          symbols[count] = &q->rm_f_batch[count * 3 * (SRSRAN_DCI_MAX_BITS + 16)];
+          data[count]    = m[j].payload;
+          srsran_rm_conv_rx(
+              &q->llr[m[j].location.ncce * 72], PDCCH_FORMAT_NOF_BITS(m[j].location.L), symbols[count], 3 * (len + 16));
+          nof_bits[j] = 0;
+          count++;
         }
-        INFO("Decoded DCI: nCCE=%d, L=%d, format=%s, msg_len=%d, mean=%f, crc_rem=0x%x",
-             msg->location.ncce,
-             msg->location.L,
-             srsran_dci_format_string(msg->format),
-             nof_bits,
-             mean,
-             msg->rnti);
-      } else {
-        INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f", msg->location.ncce, msg->location.L, nof_bits, mean);
+      }
+
+      if (srsran_viterbi_decode_batch_f(&q->decoder, symbols, data, count, len + 16) < SRSRAN_SUCCESS) {
+        ERROR("Error decoding DCI candidates");
+        return SRSRAN_ERROR;
+      }
+
+      for (uint32_t k = 0; k < count; k++) {
+        srsran_dci_msg_t* dci = &m[idx[k]];
+        dci->rnti             = pdcch_dci_crc_rem(q, dci->payload, len);
+        pdcch_msg_decoded(dci_cfg, dci, len, mean[idx[k]]);
       }
     }
-  } else if (msg != NULL) {
-    ERROR("Invalid parameters, location=%d,%d", msg->location.ncce, msg->location.L);
   }
-  return ret;
+
+  return SRSRAN_SUCCESS;
 }
 
 float srsran_pdcch_msg_corr(srsran_pdcch_t* q, srsran_dci_msg_t* msg)
@@ -648,3 +757,96 @@ int srsran_pdcch_encode(srsran_pdcch_t*     q,
   }
   return ret;
 }
+
+int srsran_pdcch_encode_batch(srsran_pdcch_t*     q,
+                              srsran_dl_sf_cfg_t* sf,
+                              srsran_dci_msg_t*   msgs,
+                              uint32_t            nof_msgs,
+                              cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
+{
+  if (q == NULL || sf_symbols == NULL || sf->cfi == 0 || sf->cfi > 3 || (nof_msgs > 0 && msgs == NULL)) {
+    ERROR("Invalid parameters: cfi=%d", sf->cfi);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  int      ret                         = SRSRAN_SUCCESS;
+  uint32_t nof_cce                     = NOF_CCE(sf->cfi);
+  uint32_t cce_begin                   = nof_cce;
+  uint32_t cce_end                     = 0;
+  bool     cce_used[PDCCH_MAX_NOF_CCE] = {};
+
+  // Encode every DCI at the bits of its CCEs. As with srsran_pdcch_encode(), a later message overwrites an earlier one
+  // in the same location
+  for (uint32_t i = 0; i < nof_msgs; i++) {
+    srsran_dci_msg_t* msg = &msgs[i];
+    if (!srsran_dci_location_isvalid(&msg->location) ||
+        msg->location.ncce + PDCCH_FORMAT_NOF_CCE(msg->location.L) > SRSRAN_MIN(nof_cce, PDCCH_MAX_NOF_CCE) ||
+        msg->nof_bits >= SRSRAN_DCI_MAX_BITS - 16) {
+      ERROR("Illegal DCI message nCCE: %d, L: %d, nof_cce: %d, nof_bits=%d",
+            msg->location.ncce,
+            msg->location.L,
+            nof_cce,
+            msg->nof_bits);
+      ret = SRSRAN_ERROR;
+      continue;
+    }
+    uint32_t e_bits = PDCCH_FORMAT_NOF_BITS(msg->location.L);
+    DEBUG("Encoding DCI: Nbits: %d, E: %d, nCCE: %d, L: %d, RNTI: 0x%x",
+          msg->nof_bits,
+          e_bits,
+          msg->location.ncce,
+          msg->location.L,
+          msg->rnti);
+    srsran_pdcch_dci_encode(q, msg->payload, &q->e[72 * msg->location.ncce], msg->nof_bits, e_bits, msg->rnti);
+
+    for (uint32_t n = 0; n < PDCCH_FORMAT_NOF_CCE(msg->location.L); n++) {
+      cce_used[msg->location.ncce + n] = true;
+    }
+    cce_begin = SRSRAN_MIN(cce_begin, msg->location.ncce);
+    cce_end   = SRSRAN_MAX(cce_end, msg->location.ncce + PDCCH_FORMAT_NOF_CCE(msg->location.L));
+  }
+  if (cce_begin >= cce_end) {
+    return ret;
+  }
+
+  // Scramble, modulate and precode the span of used CCEs in one pass. Every CCE has a multiple of 4 symbols, so the
+  // layer mapping and the precoding of the span match those of each message alone
+  uint32_t nof_bits    = 72 * (cce_end - cce_begin);
+  uint32_t nof_symbols = nof_bits / 2;
+  srsran_scrambling_b_offset(&q->seq[sf->tti % 10], &q->e[72 * cce_begin], 72 * cce_begin, nof_bits);
+  srsran_mod_modulate(&q->mod, &q->e[72 * cce_begin], q->d, nof_bits);
+
+  if (q->cell.nof_ports > 1) {
+    cf_t* x[SRSRAN_MAX_LAYERS] = {};
+    for (uint32_t i = 0; i < q->cell.nof_ports; i++) {
+      x[i] = q->x[i];
+    }
+    srsran_layermap_diversity(q->d, x, q->cell.nof_ports, nof_symbols);
+    srsran_precoding_diversity(x, q->symbols, q->cell.nof_ports, nof_symbols / q->cell.nof_ports, 1.0f);
+  } else {
+    srsran_vec_cf_copy(q->symbols[0], q->d, nof_symbols);
+  }
+
+  // Map each run of consecutive used CCEs, the unused ones keep what the grid has
+  for (uint32_t run_begin = cce_begin; run_begin < cce_end;) {
+    if (!cce_used[run_begin]) {
+      run_begin++;
+      continue;
+    }
+    uint32_t run_end = run_begin + 1;
+    while (run_end < cce_end && cce_used[run_end]) {
+      run_end++;
+    }
+    for (uint32_t i = 0; i < q->cell.nof_ports; i++) {
+      srsran_regs_pdcch_put_offset(q->regs,
+                                   sf->cfi,
+                                   &q->symbols[i][36 * (run_begin - cce_begin)],
+                                   sf_symbols[i],
+                                   run_begin * 9,
+                                   (run_end - run_begin) * 9);
+    }
+    run_begin = run_end;
+  }
+
+  return ret;
+}
@@ -173,7 +173,7 @@ static int pdcch_nr_init_common(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args
     return SRSRAN_ERROR;
   }
 
-  q->allocated = srsran_vec_u8_malloc(NMAX);
+  q->allocated = srsran_vec_u8_malloc(NMAX * SRSRAN_POLAR_DECODER_MAX_LIST_SIZE);
   if (q->allocated == NULL) {
     return SRSRAN_ERROR;
   }
@@ -230,7 +230,16 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
 
 #ifdef LV_HAVE_AVX2
   if (!args->disable_simd) {
-    decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+    switch (args->polar_list_size) {
+      case 4:
+        decoder_type = SRSRAN_POLAR_DECODER_SCL4_C_AVX2;
+        break;
+      case 8:
+        decoder_type = SRSRAN_POLAR_DECODER_SCL8_C_AVX2;
+        break;
+      default:
+        decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+    }
   }
 #endif // LV_HAVE_AVX2
 
@@ -246,6 +255,23 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
     q->evm_buffer = srsran_evm_buffer_alloc(SRSRAN_PDCCH_MAX_RE * 2);
   }
 
+  // Buffers for decoding the candidates of a search space in a batch
+  q->llr_batch = srsran_vec_i8_malloc(SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR * SRSRAN_PDCCH_MAX_RE * 2);
+  if (q->llr_batch == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  q->d_batch = srsran_vec_i8_malloc(SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR * SRSRAN_PDCCH_MAX_RE * 2);
+  if (q->d_batch == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  q->allocated_batch =
+      srsran_vec_u8_malloc(SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR * NMAX * SRSRAN_POLAR_DECODER_MAX_LIST_SIZE);
+  if (q->allocated_batch == NULL) {
+    return SRSRAN_ERROR;
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -281,6 +307,18 @@ void srsran_pdcch_nr_free(srsran_pdcch_nr_t* q)
     free(q->allocated);
   }
 
+  if (q->llr_batch) {
+    free(q->llr_batch);
+  }
+
+  if (q->d_batch) {
+    free(q->d_batch);
+  }
+
+  if (q->allocated_batch) {
+    free(q->allocated_batch);
+  }
+
   if (q->symbols) {
     free(q->symbols);
   }
@@ -569,81 +607,99 @@ int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_
   return SRSRAN_SUCCESS;
 }
 
-int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
-                           cf_t*                   slot_symbols,
-                           srsran_dmrs_pdcch_ce_t* ce,
-                           srsran_dci_msg_nr_t*    dci_msg,
-                           srsran_pdcch_nr_res_t*  res)
+int srsran_pdcch_nr_demodulate(srsran_pdcch_nr_t*           q,
+                               cf_t*                        slot_symbols,
+                               srsran_dmrs_pdcch_ce_t*      ce,
+                               const srsran_dci_location_t* location,
+                               int8_t*                      llr,
+                               float*                       evm)
 {
-  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
+  if (q == NULL || slot_symbols == NULL || ce == NULL || location == NULL || llr == NULL || evm == NULL) {
     return SRSRAN_ERROR;
   }
 
-  struct timeval t[3];
-  if (q->meas_time_en) {
-    gettimeofday(&t[1], NULL);
-  }
-
-  // Calculate...
-  q->K = dci_msg->nof_bits + 24U;                                  // Payload size including CRC
-  q->M = (1U << dci_msg->ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
-  q->E = q->M * 2;                                                 // Number of Rate-Matched bits
+  uint32_t M = (1U << location->L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
+  uint32_t E = M * 2;                                        // Number of Rate-Matched bits
 
   // Check number of estimates is correct
-  if (ce->nof_re != q->M) {
-    ERROR("Invalid number of channel estimates (%d != %d)", q->M, ce->nof_re);
+  if (ce->nof_re != M) {
+    ERROR("Invalid number of channel estimates (%d != %d)", M, ce->nof_re);
     return SRSRAN_ERROR;
   }
 
-  // Get polar code
-  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-  PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
-
   // Get symbols from grid
-  uint32_t m = pdcch_nr_cp(q, &dci_msg->ctx.location, slot_symbols, q->symbols, false);
-  if (q->M != m) {
-    ERROR("Unmatch number of RE (%d != %d)", m, q->M);
+  uint32_t m = pdcch_nr_cp(q, location, slot_symbols, q->symbols, false);
+  if (M != m) {
+    ERROR("Unmatch number of RE (%d != %d)", m, M);
     return SRSRAN_ERROR;
   }
 
   // Print channel estimates if enabled
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     PDCCH_DEBUG_RX("ce=");
-    srsran_vec_fprint_c(stdout, ce->ce, q->M);
+    srsran_vec_fprint_c(stdout, ce->ce, M);
   }
 
   // Equalise
-  srsran_predecoding_single(q->symbols, ce->ce, q->symbols, NULL, q->M, 1.0f, ce->noise_var);
+  srsran_predecoding_single(q->symbols, ce->ce, q->symbols, NULL, M, 1.0f, ce->noise_var);
 
   // Print symbols if enabled
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     PDCCH_DEBUG_RX("symbols=");
-    srsran_vec_fprint_c(stdout, q->symbols, q->M);
+    srsran_vec_fprint_c(stdout, q->symbols, M);
   }
 
   // Demodulation
-  int8_t* llr = (int8_t*)q->f;
-  srsran_demod_soft_demodulate_b(SRSRAN_MOD_QPSK, q->symbols, llr, q->M);
+  srsran_demod_soft_demodulate_b(SRSRAN_MOD_QPSK, q->symbols, llr, M);
 
   // Measure EVM if configured
   if (q->evm_buffer != NULL) {
-    res->evm = srsran_evm_run_b(q->evm_buffer, &q->modem_table, q->symbols, llr, q->E);
+    *evm = srsran_evm_run_b(q->evm_buffer, &q->modem_table, q->symbols, llr, E);
   } else {
-    res->evm = NAN;
+    *evm = NAN;
   }
 
   // Negate all LLR
-  for (uint32_t i = 0; i < q->E; i++) {
+  for (uint32_t i = 0; i < E; i++) {
     llr[i] *= -1;
   }
 
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Gets the polar code of a DCI message, it is shared by the candidates with the same DCI size and aggregation
+ * level
+ */
+static int pdcch_nr_set_code(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_msg)
+{
+  // Calculate...
+  q->K = dci_msg->nof_bits + 24U;                                  // Payload size including CRC
+  q->M = (1U << dci_msg->ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
+  q->E = q->M * 2;                                                 // Number of Rate-Matched bits
+
+  // Get polar code
+  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Descrambles the LLR of a candidate into llr and un-rate-matches them into d, the polar code must be set
+ */
+static int pdcch_nr_dematch(srsran_pdcch_nr_t*         q,
+                            const int8_t*              llr_in,
+                            const srsran_dci_msg_nr_t* dci_msg,
+                            int8_t*                    llr,
+                            int8_t*                    d)
+{
   // Descrambling
-  srsran_sequence_apply_c(llr, llr, q->E, pdcch_nr_c_init(q, dci_msg));
+  srsran_sequence_apply_c(llr_in, llr, q->E, pdcch_nr_c_init(q, dci_msg));
 
   // Un-rate matching
-  int8_t* d = (int8_t*)q->d;
   if (srsran_polar_rm_rx_c(&q->rm, llr, d, q->E, q->code.n, q->K, PDCCH_NR_POLAR_RM_IBIL) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
@@ -654,44 +710,61 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
     srsran_vec_fprint_bs(stdout, d, q->K);
   }
 
-  // Decode
-  if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-      SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-
-  // De-allocate channel
-  uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
-  srsran_polar_chanalloc_rx(q->allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
-
-  // Set first L bits to ones, c will have an offset of 24 bits
-  uint8_t* c = q->c;
-  srsran_bit_unpack(UINT32_MAX, &c, 24U);
-
-  // De-interleave
-  srsran_polar_interleaver_run_u8(c_prime, c, q->K, false);
-
-  // Print c
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-    PDCCH_INFO_RX("c_prime=");
-    srsran_vec_fprint_hex(stdout, c_prime, q->K);
-    PDCCH_INFO_RX("c=");
-    srsran_vec_fprint_hex(stdout, c, q->K);
-  }
+  return SRSRAN_SUCCESS;
+}
 
+/**
+ * @brief Selects the first of the decoded candidates, sorted by decreasing likelihood, passing the CRC and copies its
+ * payload into the DCI message
+ */
+static void pdcch_nr_select(srsran_pdcch_nr_t*     q,
+                            const uint8_t*         allocated,
+                            int                    nof_candidates,
+                            srsran_dci_msg_nr_t*   dci_msg,
+                            srsran_pdcch_nr_res_t* res)
+{
   // Unpack RNTI
   uint8_t  unpacked_rnti[16] = {};
   uint8_t* ptr               = unpacked_rnti;
   srsran_bit_unpack(dci_msg->ctx.rnti, &ptr, 16);
 
-  // De-Scramble CRC with RNTI
-  srsran_vec_xor_bbb(unpacked_rnti, &c[q->K - 16], &c[q->K - 16], 16);
+  // Select the first candidate passing the CRC
+  uint8_t* c         = q->c;
+  uint32_t checksum1 = 0;
+  uint32_t checksum2 = 0;
+  for (int i = 0; i < nof_candidates; i++) {
+    // De-allocate channel
+    uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
+    srsran_polar_chanalloc_rx(
+        &allocated[i * q->code.N], c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+
+    // Set first L bits to ones, c will have an offset of 24 bits
+    c = q->c;
+    srsran_bit_unpack(UINT32_MAX, &c, 24U);
+
+    // De-interleave
+    srsran_polar_interleaver_run_u8(c_prime, c, q->K, false);
+
+    // Print c
+    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+      PDCCH_INFO_RX("c_prime=");
+      srsran_vec_fprint_hex(stdout, c_prime, q->K);
+      PDCCH_INFO_RX("c=");
+      srsran_vec_fprint_hex(stdout, c, q->K);
+    }
 
-  // Check CRC
-  ptr                = &c[q->K - 24];
-  uint32_t checksum1 = srsran_crc_checksum(&q->crc24c, q->c, q->K);
-  uint32_t checksum2 = srsran_bit_pack(&ptr, 24);
-  res->crc           = checksum1 == checksum2;
+    // De-Scramble CRC with RNTI
+    srsran_vec_xor_bbb(unpacked_rnti, &c[q->K - 16], &c[q->K - 16], 16);
+
+    // Check CRC
+    ptr       = &c[q->K - 24];
+    checksum1 = srsran_crc_checksum(&q->crc24c, q->c, q->K);
+    checksum2 = srsran_bit_pack(&ptr, 24);
+    res->crc  = checksum1 == checksum2;
+    if (res->crc) {
+      break;
+    }
+  }
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
     PDCCH_INFO_RX("CRC={%06x, %06x}; msg=", checksum1, checksum2);
@@ -701,21 +774,141 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
   // Copy DCI message
   srsran_vec_u8_copy(dci_msg->payload, c, dci_msg->nof_bits);
 
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    char str[128] = {};
+    srsran_pdcch_nr_info(q, res, str, sizeof(str));
+    PDCCH_INFO_RX("%s", str);
+  }
+}
+
+int srsran_pdcch_nr_decode_llr(srsran_pdcch_nr_t*     q,
+                               const int8_t*          llr_in,
+                               srsran_dci_msg_nr_t*   dci_msg,
+                               srsran_pdcch_nr_res_t* res)
+{
+  if (q == NULL || llr_in == NULL || dci_msg == NULL || res == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
+  if (pdcch_nr_set_code(q, dci_msg) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  int8_t* d = (int8_t*)q->d;
+  if (pdcch_nr_dematch(q, llr_in, dci_msg, (int8_t*)q->f, d) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Decode, list decoders provide several candidates sorted by decreasing likelihood
+  int nof_candidates =
+      srsran_polar_decoder_decode_list_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size);
+  if (nof_candidates < 1) {
+    return SRSRAN_ERROR;
+  }
+
   if (q->meas_time_en) {
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
     q->meas_time_us = (uint32_t)t[0].tv_usec;
   }
 
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-    char str[128] = {};
-    srsran_pdcch_nr_info(q, res, str, sizeof(str));
-    PDCCH_INFO_RX("%s", str);
+  pdcch_nr_select(q, q->allocated, nof_candidates, dci_msg, res);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pdcch_nr_decode_llr_batch(srsran_pdcch_nr_t*     q,
+                                     const int8_t* const*   llr_in,
+                                     srsran_dci_msg_nr_t*   dci_msg,
+                                     srsran_pdcch_nr_res_t* res,
+                                     uint32_t               nof_msg)
+{
+  if (q == NULL || llr_in == NULL || dci_msg == NULL || res == NULL || q->d_batch == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (nof_msg == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  if (nof_msg > SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR) {
+    ERROR("Too many PDCCH candidates in a batch (%d > %d)", nof_msg, SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR);
+    return SRSRAN_ERROR;
+  }
+
+  // All the messages share the polar code
+  for (uint32_t i = 1; i < nof_msg; i++) {
+    if (dci_msg[i].nof_bits != dci_msg[0].nof_bits || dci_msg[i].ctx.location.L != dci_msg[0].ctx.location.L) {
+      ERROR("PDCCH candidates in a batch must have the same DCI size and aggregation level");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
+  if (pdcch_nr_set_code(q, &dci_msg[0]) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  const int8_t* d[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR]         = {};
+  uint8_t*      allocated[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
+  for (uint32_t i = 0; i < nof_msg; i++) {
+    int8_t* d_i = &q->d_batch[i * SRSRAN_PDCCH_MAX_RE * 2];
+    if (pdcch_nr_dematch(q, llr_in[i], &dci_msg[i], &q->llr_batch[i * SRSRAN_PDCCH_MAX_RE * 2], d_i) <
+        SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    d[i]         = d_i;
+    allocated[i] = &q->allocated_batch[i * NMAX * SRSRAN_POLAR_DECODER_MAX_LIST_SIZE];
+  }
+
+  // Decode all the codewords together, every one gets its own candidates
+  int nof_candidates = srsran_polar_decoder_decode_batch_c(
+      &q->decoder, d, allocated, nof_msg, q->code.n, q->code.F_set, q->code.F_set_size);
+  if (nof_candidates < 1) {
+    return SRSRAN_ERROR;
+  }
+
+  if (q->meas_time_en) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    q->meas_time_us = (uint32_t)t[0].tv_usec;
+  }
+
+  for (uint32_t i = 0; i < nof_msg; i++) {
+    pdcch_nr_select(q, allocated[i], nof_candidates, &dci_msg[i], &res[i]);
   }
 
   return SRSRAN_SUCCESS;
 }
 
+int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
+                           cf_t*                   slot_symbols,
+                           srsran_dmrs_pdcch_ce_t* ce,
+                           srsran_dci_msg_nr_t*    dci_msg,
+                           srsran_pdcch_nr_res_t*  res)
+{
+  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  // The LLR are descrambled in place by the decoder
+  int8_t* llr = (int8_t*)q->f;
+  if (srsran_pdcch_nr_demodulate(q, slot_symbols, ce, &dci_msg->ctx.location, llr, &res->evm) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  return srsran_pdcch_nr_decode_llr(q, llr, dci_msg, res);
+}
+
 uint32_t srsran_pdcch_nr_info(const srsran_pdcch_nr_t* q, const srsran_pdcch_nr_res_t* res, char* str, uint32_t str_len)
 {
   int len = 0;
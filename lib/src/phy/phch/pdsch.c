@@ -29,9 +29,9 @@
 #include <pthread.h>
 #include <semaphore.h>
 
-#include "prb_dl.h"
 #include "srsran/phy/phch/pdsch.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/re_pattern.h"
 #include "srsran/phy/utils/vector.h"
 
 #ifdef LV_HAVE_SSE
@@ -80,23 +80,23 @@ typedef struct {
 
 static void* srsran_pdsch_decode_thread(void* arg);
 
-static inline bool pdsch_cp_skip_symbol(const srsran_cell_t*        cell,
-                                        const srsran_pdsch_grant_t* grant,
-                                        uint32_t                    sf_idx,
-                                        uint32_t                    s,
-                                        uint32_t                    l,
-                                        uint32_t                    n)
+static inline bool pdsch_cp_skip_symbol(const srsran_cell_t* cell,
+                                        uint32_t             nof_symb,
+                                        uint32_t             sf_idx,
+                                        uint32_t             s,
+                                        uint32_t             l,
+                                        uint32_t             n)
 {
   // Skip center block signals
   if ((n >= cell->nof_prb / 2 - 3 && n < cell->nof_prb / 2 + 3 + (cell->nof_prb % 2))) {
     if (cell->frame_type == SRSRAN_FDD) {
       // FDD PSS/SSS
-      if (s == 0 && (sf_idx == 0 || sf_idx == 5) && (l >= grant->nof_symb_slot[s] - 2)) {
+      if (s == 0 && (sf_idx == 0 || sf_idx == 5) && (l >= nof_symb - 2)) {
         return true;
       }
     } else {
       // TDD SSS
-      if (s == 1 && (sf_idx == 0 || sf_idx == 5) && (l >= grant->nof_symb_slot[s] - 1)) {
+      if (s == 1 && (sf_idx == 0 || sf_idx == 5) && (l >= nof_symb - 1)) {
         return true;
       }
       // TDD PSS
@@ -133,6 +133,65 @@ static inline uint32_t pdsch_cp_crs_offset(const srsran_cell_t* cell, uint32_t l
   return cell->id % 3;
 }
 
+// Offset of the RE masks of a subframe, slot and symbol within the cell mask table
+static inline uint32_t pdsch_re_mask_idx(const srsran_pdsch_t* q, uint32_t sf_idx, uint32_t s, uint32_t l)
+{
+  return ((sf_idx * SRSRAN_NOF_SLOTS_PER_SF + s) * SRSRAN_CP_NORM_NSYMB + l) * q->cell.nof_prb;
+}
+
+/* Precomputes the RE that are not PDSCH, CRS and PSS/SSS/PBCH, in every subframe, symbol and PRB of the cell. A word
+ * per PRB masks the subcarriers to skip, so mapping is a masked copy of every PRB, or a single copy of consecutive PRB
+ * without CRS */
+static int pdsch_re_mask_gen(srsran_pdsch_t* q)
+{
+  uint32_t nof_masks = SRSRAN_NOF_SF_X_FRAME * SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NORM_NSYMB * q->cell.nof_prb;
+  uint32_t nof_refs  = (q->cell.nof_ports == 1) ? 2 : 4;
+  uint32_t nof_symb  = SRSRAN_CP_NSYMB(q->cell.cp);
+
+  if (q->re_mask) {
+    free(q->re_mask);
+  }
+  q->re_mask = calloc(nof_masks, sizeof(uint16_t));
+  if (!q->re_mask) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+      for (uint32_t l = 0; l < nof_symb; l++) {
+        uint16_t* re_mask = &q->re_mask[pdsch_re_mask_idx(q, sf_idx, s, l)];
+
+        // Cell specific reference signals, every SRSRAN_NRE / nof_refs subcarriers
+        uint16_t crs_mask = 0;
+        if (SRSRAN_SYMBOL_HAS_REF(l, q->cell.cp, q->cell.nof_ports)) {
+          uint32_t crs_offset = pdsch_cp_crs_offset(&q->cell, l, true);
+          for (uint32_t k = crs_offset; k < SRSRAN_NRE; k += SRSRAN_NRE / nof_refs) {
+            crs_mask |= (1U << k);
+          }
+        }
+
+        for (uint32_t n = 0; n < q->cell.nof_prb; n++) {
+          re_mask[n] = crs_mask;
+
+          // PBCH or Synch signals (SS). If the number or total PRB is odd, half of the the PBCH or SS will fall
+          // into the lower and upper PRB of the centre block
+          if (pdsch_cp_skip_symbol(&q->cell, nof_symb, sf_idx, s, l, n)) {
+            if (q->cell.nof_prb % 2 != 0 && n == q->cell.nof_prb / 2 - 3) {
+              re_mask[n] |= 0xfc0;
+            } else if (q->cell.nof_prb % 2 != 0 && n == q->cell.nof_prb / 2 + 3) {
+              re_mask[n] |= 0x03f;
+            } else {
+              re_mask[n] = 0xfff;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 static int srsran_pdsch_cp(const srsran_pdsch_t*       q,
                            cf_t*                       input,
                            cf_t*                       output,
@@ -141,9 +200,13 @@ static int srsran_pdsch_cp(const srsran_pdsch_t*       q,
                            uint32_t                    sf_idx,
                            bool                        put)
 {
-  cf_t*    in_ptr   = input;
-  cf_t*    out_ptr  = output;
-  uint32_t nof_refs = (q->cell.nof_ports == 1) ? 2 : 4;
+  uint32_t count = 0;
+
+  if (q->re_mask == NULL) {
+    ERROR("PDSCH cell is not set");
+    return SRSRAN_ERROR;
+  }
+  sf_idx %= SRSRAN_NOF_SF_X_FRAME;
 
   // Iterate over slots
   for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
@@ -152,71 +215,22 @@ static int srsran_pdsch_cp(const srsran_pdsch_t*       q,
 
     // Iterate over symbols
     for (uint32_t l = lstart; l < grant->nof_symb_slot[s]; l++) {
-      bool     has_crs    = SRSRAN_SYMBOL_HAS_REF(l, q->cell.cp, q->cell.nof_ports);
-      uint32_t crs_offset = pdsch_cp_crs_offset(&q->cell, l, has_crs);
+      const uint16_t* re_mask = &q->re_mask[pdsch_re_mask_idx(q, sf_idx, s, l)];
 
       // Grid symbol
       uint32_t lp = l + s * grant->nof_symb_slot[0];
 
-      // Iterate over PRB
-      for (uint32_t n = 0; n < q->cell.nof_prb; n++) {
-        // If this PRB is assigned
-        if (grant->prb_idx[s][n]) {
-          bool skip = pdsch_cp_skip_symbol(&q->cell, grant, sf_idx, s, l, n);
-
-          // Get grid pointer
-          if (put) {
-            out_ptr = &output[(lp * q->cell.nof_prb + n) * SRSRAN_NRE];
-          } else {
-            in_ptr = &input[(lp * q->cell.nof_prb + n) * SRSRAN_NRE];
-          }
-
-          // This is a symbol in a normal PRB with or without references
-          if (!skip) {
-            if (has_crs) {
-              prb_cp_ref(&in_ptr, &out_ptr, crs_offset, nof_refs, nof_refs, put);
-            } else {
-              prb_cp(&in_ptr, &out_ptr, 1);
-            }
-          } else if (q->cell.nof_prb % 2 != 0) {
-            // This is a symbol in a PRB with PBCH or Synch signals (SS).
-            // If the number or total PRB is odd, half of the the PBCH or SS will fall into the symbol
-            if (n == q->cell.nof_prb / 2 - 3) {
-              // Lower sync block half RB
-              if (has_crs) {
-                prb_cp_ref(&in_ptr, &out_ptr, crs_offset, nof_refs, nof_refs / 2, put);
-              } else {
-                prb_cp_half(&in_ptr, &out_ptr, 1);
-              }
-            } else if (n == q->cell.nof_prb / 2 + 3) {
-              // Upper sync block half RB
-              // Skip half RB on the grid
-              if (put) {
-                out_ptr += SRSRAN_NRE / 2;
-              } else {
-                in_ptr += SRSRAN_NRE / 2;
-              }
-
-              if (has_crs) {
-                prb_cp_ref(&in_ptr, &out_ptr, crs_offset, nof_refs, nof_refs / 2, put);
-              } else {
-                prb_cp_half(&in_ptr, &out_ptr, 1);
-              }
-            }
-          }
-        }
+      if (put) {
+        cf_t* grid = &output[lp * q->cell.nof_prb * SRSRAN_NRE];
+        count += srsran_re_pattern_symbol_put(&input[count], grid, grant->prb_idx[s], re_mask, q->cell.nof_prb);
+      } else {
+        cf_t* grid = &input[lp * q->cell.nof_prb * SRSRAN_NRE];
+        count += srsran_re_pattern_symbol_get(grid, &output[count], grant->prb_idx[s], re_mask, q->cell.nof_prb);
       }
     }
   }
 
-  int r;
-  if (put) {
-    r = abs((int)(input - in_ptr));
-  } else {
-    r = abs((int)(output - out_ptr));
-  }
-
-  return r;
+  return (int)count;
 }
 
 /**
@@ -302,6 +316,13 @@ static int pdsch_init(srsran_pdsch_t* q, uint32_t max_prb, bool is_ue, uint32_t
       }
     }
 
+    if (is_ue) {
+      if (srsran_scrambling_cache_init(&q->scrambling_cache,
+                                       q->max_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_256QAM))) {
+        goto clean;
+      }
+    }
+
     for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
       q->x[i] = srsran_vec_cf_malloc(q->max_re);
       if (!q->x[i]) {
@@ -454,6 +475,12 @@ void srsran_pdsch_free(srsran_pdsch_t* q)
     srsran_modem_table_free(&q->mod[i]);
   }
 
+  srsran_scrambling_cache_free(&q->scrambling_cache);
+
+  if (q->re_mask) {
+    free(q->re_mask);
+  }
+
   bzero(q, sizeof(srsran_pdsch_t));
 }
 
@@ -464,6 +491,12 @@ int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell)
   if (q != NULL && srsran_cell_isvalid(&cell)) {
     q->cell   = cell;
     q->max_re = q->cell.nof_prb * MAX_PDSCH_RE(q->cell.cp);
+    srsran_scrambling_cache_set_cell(&q->scrambling_cache, cell.id);
+
+    if (pdsch_re_mask_gen(q) < SRSRAN_SUCCESS) {
+      ERROR("Error generating PDSCH RE masks");
+      return SRSRAN_ERROR;
+    }
 
     // Resize EVM buffer, only for UE
     if (q->is_ue) {
@@ -520,11 +553,11 @@ static float apply_power_allocation(srsran_pdsch_t* q, srsran_pdsch_cfg_t* cfg,
   return rho_a;
 }
 
-static void csi_correction(srsran_pdsch_t* q, srsran_pdsch_cfg_t* cfg, uint32_t codeword_idx, uint32_t tb_idx, void* e)
+static float csi_max_get(srsran_pdsch_t* q, srsran_pdsch_cfg_t* cfg, uint32_t codeword_idx, uint32_t tb_idx)
 {
   uint32_t qm = srsran_mod_bits_x_symbol(cfg->grant.tb[tb_idx].mod);
   if (qm == 0) {
-    return;
+    return 1.0f;
   }
 
   const uint32_t csi_max_idx = srsran_vec_max_fi(q->csi[codeword_idx], cfg->grant.tb[tb_idx].nof_bits / qm);
@@ -532,6 +565,17 @@ static void csi_correction(srsran_pdsch_t* q, srsran_pdsch_cfg_t* cfg, uint32_t
   if (csi_max_idx < cfg->grant.tb[tb_idx].nof_bits / qm) {
     csi_max = q->csi[codeword_idx][csi_max_idx];
   }
+  return csi_max;
+}
+
+static void csi_correction(srsran_pdsch_t* q, srsran_pdsch_cfg_t* cfg, uint32_t codeword_idx, uint32_t tb_idx, void* e)
+{
+  uint32_t qm = srsran_mod_bits_x_symbol(cfg->grant.tb[tb_idx].mod);
+  if (qm == 0) {
+    return;
+  }
+
+  const float csi_max = csi_max_get(q, cfg, codeword_idx, tb_idx);
   int8_t*  e_b   = e;
   int16_t* e_s   = e;
   float*   csi_v = q->csi[codeword_idx];
@@ -690,7 +734,18 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
      * The MAX-log-MAP algorithm used in turbo decoding is unsensitive to SNR estimation,
      * thus we don't need tot set it in the LLRs normalization
      */
-    if (q->llr_is_8bit) {
+    // 256QAM weights the LLR by the CSI while demodulating, unless the EVM needs them unweighted
+    bool meas_evm  = cfg->meas_evm_en && q->evm_buffer[codeword_idx];
+    bool csi_demod = cfg->csi_enable && mcs->mod == SRSRAN_MOD_256QAM && !meas_evm;
+    if (csi_demod) {
+      float* csi = q->csi[codeword_idx];
+      srsran_vec_sc_prod_fff(csi, 1.0f / csi_max_get(q, cfg, codeword_idx, tb_idx), csi, cfg->grant.nof_re);
+      if (q->llr_is_8bit) {
+        srsran_demod_soft_demodulate_csi_b(mcs->mod, q->d[codeword_idx], csi, q->e[codeword_idx], cfg->grant.nof_re);
+      } else {
+        srsran_demod_soft_demodulate_csi_s(mcs->mod, q->d[codeword_idx], csi, q->e[codeword_idx], cfg->grant.nof_re);
+      }
+    } else if (q->llr_is_8bit) {
       srsran_demod_soft_demodulate_b(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
     } else {
       srsran_demod_soft_demodulate_s(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
@@ -714,7 +769,14 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
     }
 
     /* Bit scrambling */
-    if (q->llr_is_8bit) {
+    const uint8_t* seq = q->scrambling_seq[codeword_idx];
+    if (seq) {
+      if (q->llr_is_8bit) {
+        srsran_scrambling_packed_apply_c(seq, q->e[codeword_idx], q->e[codeword_idx], cfg->grant.tb[tb_idx].nof_bits);
+      } else {
+        srsran_scrambling_packed_apply_s(seq, q->e[codeword_idx], q->e[codeword_idx], cfg->grant.tb[tb_idx].nof_bits);
+      }
+    } else if (q->llr_is_8bit) {
       srsran_sequence_pdsch_apply_c(q->e[codeword_idx],
                                     q->e[codeword_idx],
                                     cfg->rnti,
@@ -732,7 +794,7 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
                                     cfg->grant.tb[tb_idx].nof_bits);
     }
 
-    if (cfg->csi_enable) {
+    if (cfg->csi_enable && !csi_demod) {
       csi_correction(q, cfg, codeword_idx, tb_idx, q->e[codeword_idx]);
     }
 
@@ -886,6 +948,15 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
       srsran_layerdemap_type(x, q->d, cfg->grant.nof_layers, nof_tb, nof_symbols[0], nof_symbols, cfg->grant.tx_scheme);
     }
 
+    // Fetch the scrambling sequences here, the cache is not shared with the coworker
+    for (uint32_t tb_idx = 0; tb_idx < SRSRAN_MAX_TB; tb_idx++) {
+      srsran_ra_tb_t* tb = &cfg->grant.tb[tb_idx];
+      if (tb->enabled && tb->cw_idx < SRSRAN_MAX_CODEWORDS) {
+        q->scrambling_seq[tb->cw_idx] = srsran_scrambling_cache_get(
+            &q->scrambling_cache, cfg->rnti, sf->tti % SRSRAN_NOF_SF_X_FRAME, tb->cw_idx, tb->nof_bits);
+      }
+    }
+
     /* Codeword decoding: Implementation of 3GPP 36.212 Table 5.3.3.1.5-1 and Table 5.3.3.1.5-2 */
     for (uint32_t tb_idx = 0; tb_idx < SRSRAN_MAX_TB; tb_idx++) {
       /* Decode only if transport block is enabled and the default ACK is not true */
@@ -988,21 +1059,14 @@ static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
            rv);
     }
 
-    /* Channel coding */
-    if (srsran_dlsch_encode2(&q->dl_sch, cfg, data, q->e[codeword_idx], tb_idx, nof_layers)) {
+    /* Channel coding and bit scrambling */
+    uint32_t seed =
+        srsran_sequence_pdsch_seed(cfg->rnti, codeword_idx, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id);
+    if (srsran_dlsch_encode2_scrambled(&q->dl_sch, cfg, data, q->e[codeword_idx], tb_idx, nof_layers, seed)) {
       ERROR("Error encoding (TB%d -> CW%d)", tb_idx, codeword_idx);
       return SRSRAN_ERROR;
     }
 
-    /* Bit scrambling */
-    srsran_sequence_pdsch_apply_pack((uint8_t*)q->e[codeword_idx],
-                                     (uint8_t*)q->e[codeword_idx],
-                                     cfg->rnti,
-                                     codeword_idx,
-                                     2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                     q->cell.id,
-                                     cfg->grant.tb[tb_idx].nof_bits);
-
     /* Bit mapping */
     srsran_mod_modulate_bytes(
         &q->mod[mcs->mod], (uint8_t*)q->e[codeword_idx], q->d[codeword_idx], cfg->grant.tb[tb_idx].nof_bits);
@@ -1082,7 +1146,15 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
     }
 
     // Layer mapping & precode if necessary
-    if (q->cell.nof_ports > 1) {
+    cf_t* symbols[SRSRAN_MAX_PORTS];
+    for (i = 0; i < SRSRAN_MAX_PORTS; i++) {
+      symbols[i] = q->symbols[i];
+    }
+    if (q->cell.nof_ports > 1 && cfg->grant.tx_scheme == SRSRAN_TXSCHEME_DIVERSITY && nof_tb == 1 &&
+        cfg->grant.nof_layers == q->cell.nof_ports) {
+      /* Transmit diversity reads the layers straight from the codeword, without the layer mapping buffers */
+      srsran_precoding_diversity_cw(q->d[0], q->symbols, q->cell.nof_ports, cfg->grant.nof_re, scaling);
+    } else if (q->cell.nof_ports > 1) {
       int nof_symbols;
       /* If number of layers is equal to transport blocks (codewords) skip layer mapping */
       if (cfg->grant.nof_layers == nof_tb) {
@@ -1116,17 +1188,17 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
                             scaling,
                             cfg->grant.tx_scheme);
     } else {
-      if (scaling == 1.0f) {
-        memcpy(q->symbols[0], q->d[0], cfg->grant.nof_re * sizeof(cf_t));
-      } else {
-        srsran_vec_sc_prod_cfc(q->d[0], scaling, q->symbols[0], cfg->grant.nof_re);
+      /* A single port maps the modulated symbols, scaled in place, without copying them */
+      if (scaling != 1.0f) {
+        srsran_vec_sc_prod_cfc(q->d[0], scaling, q->d[0], cfg->grant.nof_re);
       }
+      symbols[0] = q->d[0];
     }
 
     /* mapping to resource elements */
     uint32_t lstart = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi);
     for (i = 0; i < q->cell.nof_ports; i++) {
-      srsran_pdsch_put(q, q->symbols[i], sf_symbols[i], &cfg->grant, lstart, sf->tti % 10);
+      srsran_pdsch_put(q, symbols[i], sf_symbols[i], &cfg->grant, lstart, sf->tti % 10);
     }
 
     if (cfg->meas_time_en) {
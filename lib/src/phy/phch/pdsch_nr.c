@@ -200,28 +200,6 @@ void srsran_pdsch_nr_free(srsran_pdsch_nr_t* q)
   SRSRAN_MEM_ZERO(q, srsran_pdsch_nr_t, 1);
 }
 
-static inline uint32_t pdsch_nr_put_rb(cf_t* dst, cf_t* src, bool* rvd_mask)
-{
-  uint32_t count = 0;
-  for (uint32_t i = 0; i < SRSRAN_NRE; i++) {
-    if (!rvd_mask[i]) {
-      dst[i] = src[count++];
-    }
-  }
-  return count;
-}
-
-static inline uint32_t pdsch_nr_get_rb(cf_t* dst, cf_t* src, bool* rvd_mask)
-{
-  uint32_t count = 0;
-  for (uint32_t i = 0; i < SRSRAN_NRE; i++) {
-    if (!rvd_mask[i]) {
-      dst[count++] = src[i];
-    }
-  }
-  return count;
-}
-
 static int srsran_pdsch_nr_cp(const srsran_pdsch_nr_t*     q,
                               const srsran_sch_cfg_nr_t*   cfg,
                               const srsran_sch_grant_nr_t* grant,
@@ -232,37 +210,27 @@ static int srsran_pdsch_nr_cp(const srsran_pdsch_nr_t*     q,
   uint32_t count = 0;
 
   for (uint32_t l = grant->S; l < grant->S + grant->L; l++) {
-    // Initialise reserved RE mask to all false
-    bool rvd_mask[SRSRAN_NRE * SRSRAN_MAX_PRB_NR] = {};
+    // Initialise reserved RE mask to all false, one word per RB
+    uint16_t rvd_mask[SRSRAN_MAX_PRB_NR] = {};
 
     // Reserve DMRS
-    if (srsran_re_pattern_to_symbol_mask(&q->dmrs_re_pattern, l, rvd_mask) < SRSRAN_SUCCESS) {
+    if (srsran_re_pattern_to_rb_mask(&q->dmrs_re_pattern, l, rvd_mask) < SRSRAN_SUCCESS) {
       ERROR("Error generating DMRS reserved RE mask");
       return SRSRAN_ERROR;
     }
 
     // Reserve RE from configuration
-    if (srsran_re_pattern_list_to_symbol_mask(&cfg->rvd_re, l, rvd_mask) < SRSRAN_SUCCESS) {
+    if (srsran_re_pattern_list_to_rb_mask(&cfg->rvd_re, l, rvd_mask) < SRSRAN_SUCCESS) {
       ERROR("Error generating reserved RE mask");
       return SRSRAN_ERROR;
     }
 
-    // Actual copy
-    for (uint32_t rb = 0; rb < q->carrier.nof_prb; rb++) {
-      // Skip PRB if not available in grant
-      if (!grant->prb_idx[rb]) {
-        continue;
-      }
-
-      // Calculate RE index at the begin of the symbol
-      uint32_t re_idx = (q->carrier.nof_prb * l + rb) * SRSRAN_NRE;
-
-      // Put or get
-      if (put) {
-        count += pdsch_nr_put_rb(&sf_symbols[re_idx], &symbols[count], &rvd_mask[rb * SRSRAN_NRE]);
-      } else {
-        count += pdsch_nr_get_rb(&symbols[count], &sf_symbols[re_idx], &rvd_mask[rb * SRSRAN_NRE]);
-      }
+    // Actual copy, from the begin of the symbol
+    cf_t* grid = &sf_symbols[q->carrier.nof_prb * l * SRSRAN_NRE];
+    if (put) {
+      count += srsran_re_pattern_symbol_put(&symbols[count], grid, grant->prb_idx, rvd_mask, q->carrier.nof_prb);
+    } else {
+      count += srsran_re_pattern_symbol_get(grid, &symbols[count], grant->prb_idx, rvd_mask, q->carrier.nof_prb);
     }
   }
 
@@ -513,16 +481,25 @@ int srsran_pdsch_nr_decode(srsran_pdsch_nr_t*           q,
 
   uint32_t nof_re = grant->tb[0].nof_re;
 
-  if (channel->nof_re != nof_re) {
-    ERROR("Inconsistent number of RE (%d!=%d)", channel->nof_re, nof_re);
+  // Every layer spans the same RE of the grid, the channel is estimated for each of them
+  uint32_t nof_layers   = SRSRAN_MAX(grant->nof_layers, 1);
+  uint32_t nof_re_layer = nof_re / nof_layers;
+  if (channel->nof_re != nof_re_layer) {
+    ERROR("Inconsistent number of RE (%d!=%d)", channel->nof_re, nof_re_layer);
     return SRSRAN_ERROR;
   }
 
-  // Demapping from virtual to physical resource blocks
-  uint32_t nof_re_get = srsran_pdsch_nr_get(q, cfg, grant, q->x[0], sf_symbols[0]);
-  if (nof_re_get != nof_re) {
-    ERROR("Inconsistent number of RE (%d!=%d)", nof_re_get, nof_re);
-    return SRSRAN_ERROR;
+  // Demapping from virtual to physical resource blocks, one receive antenna per layer
+  for (uint32_t rx = 0; rx < nof_layers; rx++) {
+    if (sf_symbols[rx] == NULL) {
+      ERROR("Missing receive antenna %d for %d layers", rx, nof_layers);
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+    uint32_t nof_re_get = srsran_pdsch_nr_get(q, cfg, grant, q->x[rx], sf_symbols[rx]);
+    if (nof_re_get != nof_re_layer) {
+      ERROR("Inconsistent number of RE (%d!=%d)", nof_re_get, nof_re_layer);
+      return SRSRAN_ERROR;
+    }
   }
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
@@ -537,11 +514,18 @@ int srsran_pdsch_nr_decode(srsran_pdsch_nr_t*           q,
 
   // Antenna port demapping
   // ... Not implemented
-  srsran_predecoding_single(q->x[0], channel->ce[0][0], q->d[0], NULL, nof_re, 1.0f, channel->noise_estimate);
+  if (nof_layers == 1) {
+    srsran_predecoding_single(q->x[0], channel->ce[0][0], q->d[0], NULL, nof_re, 1.0f, channel->noise_estimate);
+  } else {
+    // Joint MMSE equalization of all layers, in place
+    if (srsran_predecoding_mmse_nr(
+            q->x, channel->ce, q->x, nof_layers, nof_layers, nof_re_layer, channel->noise_estimate) < SRSRAN_SUCCESS) {
+      ERROR("Error equalizing %d layers", nof_layers);
+      return SRSRAN_ERROR;
+    }
 
-  // Layer demapping
-  if (grant->nof_layers > 1) {
-    srsran_layerdemap_nr(q->d, nof_cw, q->x, grant->nof_layers, nof_re);
+    // Layer demapping
+    srsran_layerdemap_nr(q->d, nof_cw, q->x, nof_layers, nof_re);
   }
 
   // SCH decode
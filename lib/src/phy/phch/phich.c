@@ -309,48 +309,9 @@ int srsran_phich_decode(srsran_phich_t*         q,
 /** Encodes ACK/NACK bits, modulates and inserts into resource.
  * The parameter ack is an array of srsran_phich_ngroups() pointers to buffers of nof_sequences uint8_ts
  */
-int srsran_phich_encode(srsran_phich_t*         q,
-                        srsran_dl_sf_cfg_t*     sf,
-                        srsran_phich_resource_t n_phich,
-                        uint8_t                 ack,
-                        cf_t*                   sf_symbols[SRSRAN_MAX_PORTS])
+/* Adds the spread, not yet scrambled, symbols of one ACK/NACK to d */
+static void phich_spread_add(srsran_phich_t* q, uint32_t nseq, uint8_t ack, cf_t* d)
 {
-  int i;
-
-  if (q == NULL || sf_symbols == NULL) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
-
-  uint32_t sf_idx = sf->tti % 10;
-
-  if (SRSRAN_CP_ISEXT(q->cell.cp)) {
-    if (n_phich.nseq >= SRSRAN_PHICH_EXT_NSEQUENCES) {
-      ERROR("Invalid nseq %d", n_phich.nseq);
-      return SRSRAN_ERROR_INVALID_INPUTS;
-    }
-  } else {
-    if (n_phich.nseq >= SRSRAN_PHICH_NORM_NSEQUENCES) {
-      ERROR("Invalid nseq %d", n_phich.nseq);
-      return SRSRAN_ERROR_INVALID_INPUTS;
-    }
-  }
-  if (n_phich.ngroup >= srsran_regs_phich_ngroups(q->regs)) {
-    ERROR("Invalid ngroup %d", n_phich.ngroup);
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
-
-  /* Set pointers for layermapping & precoding */
-  cf_t* x[SRSRAN_MAX_LAYERS];
-  cf_t* symbols_precoding[SRSRAN_MAX_PORTS];
-
-  /* number of layers equals number of ports */
-  for (i = 0; i < q->cell.nof_ports; i++) {
-    x[i] = q->x[i];
-  }
-  for (i = 0; i < SRSRAN_MAX_PORTS; i++) {
-    symbols_precoding[i] = q->sf_symbols[i];
-  }
-
   /* encode ACK/NACK bit */
   srsran_phich_ack_encode(ack, q->data);
 
@@ -362,48 +323,48 @@ int srsran_phich_encode(srsran_phich_t*         q,
 
   /* Spread with w */
   if (SRSRAN_CP_ISEXT(q->cell.cp)) {
-    for (i = 0; i < SRSRAN_PHICH_EXT_MSYMB; i++) {
-      q->d[i] = w_ext[n_phich.nseq][i % SRSRAN_PHICH_EXT_NSF] * q->z[i / SRSRAN_PHICH_EXT_NSF];
+    for (int i = 0; i < SRSRAN_PHICH_EXT_MSYMB; i++) {
+      d[i] += w_ext[nseq][i % SRSRAN_PHICH_EXT_NSF] * q->z[i / SRSRAN_PHICH_EXT_NSF];
     }
   } else {
-    for (i = 0; i < SRSRAN_PHICH_NORM_MSYMB; i++) {
-      q->d[i] = w_normal[n_phich.nseq][i % SRSRAN_PHICH_NORM_NSF] * q->z[i / SRSRAN_PHICH_NORM_NSF];
+    for (int i = 0; i < SRSRAN_PHICH_NORM_MSYMB; i++) {
+      d[i] += w_normal[nseq][i % SRSRAN_PHICH_NORM_NSF] * q->z[i / SRSRAN_PHICH_NORM_NSF];
     }
   }
+}
 
-  DEBUG("d: ");
-  if (SRSRAN_VERBOSE_ISDEBUG())
-    srsran_vec_fprint_c(stdout, q->d, SRSRAN_PHICH_EXT_MSYMB);
-
-  srsran_scrambling_c(&q->seq[sf_idx], q->d);
-
-  /* align to REG */
+/* Adds the scrambled symbols of a group, aligned to its REGs, to d0 */
+static void phich_align_add(srsran_phich_t* q, uint32_t ngroup, const cf_t* d, cf_t* d0)
+{
   if (SRSRAN_CP_ISEXT(q->cell.cp)) {
-    if (n_phich.ngroup % 2) {
-      for (i = 0; i < SRSRAN_PHICH_EXT_MSYMB / 2; i++) {
-        q->d0[4 * i + 0] = 0;
-        q->d0[4 * i + 1] = 0;
-        q->d0[4 * i + 2] = q->d[2 * i];
-        q->d0[4 * i + 3] = q->d[2 * i + 1];
-      }
-    } else {
-      for (i = 0; i < SRSRAN_PHICH_EXT_MSYMB / 2; i++) {
-        q->d0[4 * i + 0] = q->d[2 * i];
-        q->d0[4 * i + 1] = q->d[2 * i + 1];
-        q->d0[4 * i + 2] = 0;
-        q->d0[4 * i + 3] = 0;
-      }
+    uint32_t offset = (ngroup % 2) ? 2 : 0;
+    for (int i = 0; i < SRSRAN_PHICH_EXT_MSYMB / 2; i++) {
+      d0[4 * i + offset + 0] += d[2 * i];
+      d0[4 * i + offset + 1] += d[2 * i + 1];
     }
   } else {
-    memcpy(q->d0, q->d, SRSRAN_PHICH_MAX_NSYMB * sizeof(cf_t));
+    srsran_vec_sum_ccc(d0, d, d0, SRSRAN_PHICH_MAX_NSYMB);
   }
+}
 
+/* Precodes d0 and adds it to the REGs of the group */
+static int phich_map(srsran_phich_t* q, uint32_t ngroup, cf_t* sf_symbols[SRSRAN_MAX_PORTS])
+{
   DEBUG("d0: ");
   if (SRSRAN_VERBOSE_ISDEBUG())
     srsran_vec_fprint_c(stdout, q->d0, SRSRAN_PHICH_MAX_NSYMB);
 
   /* layer mapping & precoding */
   if (q->cell.nof_ports > 1) {
+    /* Set pointers for layermapping & precoding, number of layers equals number of ports */
+    cf_t* x[SRSRAN_MAX_LAYERS];
+    cf_t* symbols_precoding[SRSRAN_MAX_PORTS];
+    for (int i = 0; i < q->cell.nof_ports; i++) {
+      x[i] = q->x[i];
+    }
+    for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
+      symbols_precoding[i] = q->sf_symbols[i];
+    }
     srsran_layermap_diversity(q->d0, x, q->cell.nof_ports, SRSRAN_PHICH_MAX_NSYMB);
     srsran_precoding_diversity(
         x, symbols_precoding, q->cell.nof_ports, SRSRAN_PHICH_MAX_NSYMB / q->cell.nof_ports, 1.0f);
@@ -413,12 +374,86 @@ int srsran_phich_encode(srsran_phich_t*         q,
   }
 
   /* mapping to resource elements */
-  for (i = 0; i < q->cell.nof_ports; i++) {
-    if (srsran_regs_phich_add(q->regs, q->sf_symbols[i], n_phich.ngroup, sf_symbols[i]) < 0) {
+  for (int i = 0; i < q->cell.nof_ports; i++) {
+    if (srsran_regs_phich_add(q->regs, q->sf_symbols[i], ngroup, sf_symbols[i]) < 0) {
       ERROR("Error putting PCHICH resource elements");
       return SRSRAN_ERROR;
     }
   }
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_phich_encode(srsran_phich_t*         q,
+                        srsran_dl_sf_cfg_t*     sf,
+                        srsran_phich_resource_t n_phich,
+                        uint8_t                 ack,
+                        cf_t*                   sf_symbols[SRSRAN_MAX_PORTS])
+{
+  return srsran_phich_encode_batch(q, sf, &n_phich, &ack, 1, sf_symbols);
+}
+
+int srsran_phich_encode_batch(srsran_phich_t*                q,
+                              srsran_dl_sf_cfg_t*            sf,
+                              const srsran_phich_resource_t* resources,
+                              const uint8_t*                 acks,
+                              uint32_t                       nof_acks,
+                              cf_t*                          sf_symbols[SRSRAN_MAX_PORTS])
+{
+  if (q == NULL || sf_symbols == NULL || (nof_acks > 0 && (resources == NULL || acks == NULL))) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t sf_idx     = sf->tti % 10;
+  uint32_t nof_groups = srsran_regs_phich_ngroups(q->regs);
+  uint32_t nof_seq    = SRSRAN_CP_ISEXT(q->cell.cp) ? SRSRAN_PHICH_EXT_NSEQUENCES : SRSRAN_PHICH_NORM_NSEQUENCES;
+
+  for (uint32_t i = 0; i < nof_acks; i++) {
+    if (resources[i].nseq >= nof_seq) {
+      ERROR("Invalid nseq %d", resources[i].nseq);
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+    if (resources[i].ngroup >= nof_groups) {
+      ERROR("Invalid ngroup %d", resources[i].ngroup);
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
+  /* The ACKs of a group are superimposed. As the scrambling is common to the group, their spread symbols are summed
+   * and scrambled once. With extended CP, pairs of groups share the same REGs, so they are precoded and mapped
+   * together */
+  uint32_t groups_x_reg = SRSRAN_CP_ISEXT(q->cell.cp) ? 2 : 1;
+  for (uint32_t reg_group = 0; reg_group < nof_groups; reg_group += groups_x_reg) {
+    bool used = false;
+    srsran_vec_cf_zero(q->d0, SRSRAN_PHICH_MAX_NSYMB);
+
+    for (uint32_t ngroup = reg_group; ngroup < reg_group + groups_x_reg && ngroup < nof_groups; ngroup++) {
+      bool group_used = false;
+      srsran_vec_cf_zero(q->d, SRSRAN_PHICH_MAX_NSYMB);
+      for (uint32_t i = 0; i < nof_acks; i++) {
+        if (resources[i].ngroup == ngroup) {
+          phich_spread_add(q, resources[i].nseq, acks[i], q->d);
+          group_used = true;
+        }
+      }
+      if (!group_used) {
+        continue;
+      }
+
+      DEBUG("d: ");
+      if (SRSRAN_VERBOSE_ISDEBUG())
+        srsran_vec_fprint_c(stdout, q->d, SRSRAN_PHICH_EXT_MSYMB);
+
+      srsran_scrambling_c(&q->seq[sf_idx], q->d);
+
+      /* align to REG */
+      phich_align_add(q, ngroup, q->d, q->d0);
+      used = true;
+    }
+
+    if (used && phich_map(q, reg_group, sf_symbols) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
 
   return SRSRAN_SUCCESS;
 }
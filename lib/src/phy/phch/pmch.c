@@ -183,6 +183,16 @@ int srsran_pmch_init(srsran_pmch_t* q, uint32_t max_prb, uint32_t nof_rx_antenna
       goto clean;
     }
 
+    // Packed bits, the TBS never exceeds the number of coded bits
+    uint32_t max_bytes = SRSRAN_CEIL(q->max_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_64QAM), 8);
+    for (uint32_t i = 0; i < SRSRAN_PMCH_CACHE_LEN; i++) {
+      q->cache[i].data = srsran_vec_u8_malloc(max_bytes);
+      q->cache[i].e    = srsran_vec_u8_malloc(max_bytes);
+      if (!q->cache[i].data || !q->cache[i].e) {
+        goto clean;
+      }
+    }
+
     ret = SRSRAN_SUCCESS;
   }
 clean:
@@ -223,6 +233,14 @@ void srsran_pmch_free(srsran_pmch_t* q)
     }
     free(q->seqs);
   }
+  for (uint32_t i = 0; i < SRSRAN_PMCH_CACHE_LEN; i++) {
+    if (q->cache[i].data) {
+      free(q->cache[i].data);
+    }
+    if (q->cache[i].e) {
+      free(q->cache[i].e);
+    }
+  }
   for (uint32_t i = 0; i < 4; i++) {
     srsran_modem_table_free(&q->mod[i]);
   }
@@ -396,6 +414,46 @@ void srsran_configure_pmch(srsran_pmch_cfg_t* pmch_cfg, srsran_cell_t* cell, srs
   }
 }
 
+/* Writes in q->e the codeword of the payload, reusing the one of a previous subframe when the payload and the grant
+ * did not change. The cache holds the bits before scrambling, since the scrambling sequence depends on the subframe.
+ */
+static int pmch_encode_cached(srsran_pmch_t* q, srsran_pmch_cfg_t* cfg, uint8_t* data)
+{
+  srsran_ra_tb_t* tb        = &cfg->pdsch_cfg.grant.tb[0];
+  uint32_t        nof_bytes = SRSRAN_CEIL(tb->nof_bits, 8);
+  uint32_t        tbs_bytes = SRSRAN_CEIL(tb->tbs, 8);
+
+  q->cache_tick++;
+
+  srsran_pmch_cache_t* oldest = &q->cache[0];
+  for (uint32_t i = 0; i < SRSRAN_PMCH_CACHE_LEN; i++) {
+    srsran_pmch_cache_t* c = &q->cache[i];
+    if (c->valid && c->tbs == tb->tbs && c->nof_bits == tb->nof_bits && c->mod == tb->mod &&
+        memcmp(c->data, data, tbs_bytes) == 0) {
+      memcpy(q->e, c->e, nof_bytes);
+      c->last_used = q->cache_tick;
+      return SRSRAN_SUCCESS;
+    }
+    if (!c->valid || (oldest->valid && c->last_used < oldest->last_used)) {
+      oldest = c;
+    }
+  }
+
+  if (srsran_dlsch_encode(&q->dl_sch, &cfg->pdsch_cfg, data, q->e)) {
+    return SRSRAN_ERROR;
+  }
+
+  oldest->valid     = true;
+  oldest->tbs       = tb->tbs;
+  oldest->nof_bits  = tb->nof_bits;
+  oldest->mod       = tb->mod;
+  oldest->last_used = q->cache_tick;
+  memcpy(oldest->data, data, tbs_bytes);
+  memcpy(oldest->e, q->e, nof_bytes);
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_pmch_encode(srsran_pmch_t*      q,
                        srsran_dl_sf_cfg_t* sf,
                        srsran_pmch_cfg_t*  cfg,
@@ -404,7 +462,7 @@ int srsran_pmch_encode(srsran_pmch_t*      q,
 {
   int i;
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
-  if (q != NULL && cfg != NULL) {
+  if (q != NULL && cfg != NULL && data != NULL) {
     for (i = 0; i < q->cell.nof_ports; i++) {
       if (sf_symbols[i] == NULL) {
         return SRSRAN_ERROR_INVALID_INPUTS;
@@ -431,8 +489,7 @@ int srsran_pmch_encode(srsran_pmch_t*      q,
          cfg->pdsch_cfg.grant.tb[0].nof_bits,
          0);
 
-    // TODO: use tb_encode directly
-    if (srsran_dlsch_encode(&q->dl_sch, &cfg->pdsch_cfg, data, q->e)) {
+    if (pmch_encode_cached(q, cfg, data)) {
       ERROR("Error encoding TB");
       return SRSRAN_ERROR;
     }
@@ -570,6 +570,13 @@ int srsran_prach_init(srsran_prach_t* p, uint32_t max_N_ifft_ul)
     p->cross      = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
     p->corr_freq  = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
 
+    p->corr_spec_batch = srsran_vec_cf_malloc(N_SEQS * SRSRAN_PRACH_N_ZC_LONG);
+    p->corr_batch      = srsran_vec_cf_malloc(N_SEQS * SRSRAN_PRACH_N_ZC_LONG);
+    if (!p->corr_spec_batch || !p->corr_batch) {
+      ERROR("Error allocating memory");
+      return SRSRAN_ERROR;
+    }
+
     // Set up ZC FFTS
     if (srsran_dft_plan(&p->zc_fft, SRSRAN_PRACH_N_ZC_LONG, SRSRAN_DFT_FORWARD, SRSRAN_DFT_COMPLEX)) {
       return SRSRAN_ERROR;
@@ -696,6 +703,24 @@ int srsran_prach_set_cell_(srsran_prach_t*      p,
       p->num_ra_preambles = p->N_roots;
     }
 
+    // Plan the correlation IFFT of all the root sequences searched, one row of N_zc samples per root
+    if (p->zc_ifft_batch.init_size) {
+      srsran_dft_plan_free(&p->zc_ifft_batch);
+    }
+    if (srsran_dft_plan_guru_c(&p->zc_ifft_batch,
+                               p->N_zc,
+                               SRSRAN_DFT_BACKWARD,
+                               p->corr_spec_batch,
+                               p->corr_batch,
+                               1,
+                               1,
+                               p->num_ra_preambles,
+                               p->N_zc,
+                               p->N_zc)) {
+      ERROR("Error creating DFT plan");
+      return SRSRAN_ERROR;
+    }
+
     // Create our FFT objects and buffers
     p->N_ifft_ul = N_ifft_ul;
     if (4 == preamble_format) {
@@ -881,19 +906,20 @@ int srsran_prach_process(srsran_prach_t* p,
   cancellation_idx    = -1;
   int max_idx         = 0;
   srsran_vec_cf_zero(p->cross, p->N_zc);
-  srsran_vec_cf_zero(p->corr_freq, p->N_zc);
+
+  // Correlate all the root sequences at once, their spectra are kept for the offset and cancellation estimates
   for (int i = 0; i < p->num_ra_preambles; i++) {
     cf_t* root_spec = get_precoded_dft(p, p->root_seqs_idx[i]);
+    srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, &p->corr_spec_batch[i * p->N_zc], p->N_zc);
+  }
+  srsran_dft_run_guru_c(&p->zc_ifft_batch);
 
-    srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, p->corr_spec, p->N_zc);
+  for (int i = 0; i < p->num_ra_preambles; i++) {
+    cf_t* corr_spec = &p->corr_spec_batch[i * p->N_zc];
 
-    srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
-    if (p->successive_cancellation) {
-      srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
-    }
-    srsran_dft_run(&p->zc_ifft, p->corr_spec, p->corr_spec);
+    srsran_vec_prod_conj_ccc(corr_spec, &corr_spec[1], p->cross, p->N_zc - 1);
 
-    srsran_vec_abs_square_cf(p->corr_spec, p->corr, p->N_zc);
+    srsran_vec_abs_square_cf(&p->corr_batch[i * p->N_zc], p->corr, p->N_zc);
 
     float corr_ave = srsran_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
 
@@ -913,16 +939,12 @@ int srsran_prach_process(srsran_prach_t* p,
         end -= p->deadzone;
       }
       start += p->deadzone;
-      p->peak_values[j] = 0;
-      for (int k = start; k < end; k++) {
-        if (p->corr[k] > p->peak_values[j]) {
-          p->peak_values[j]  = p->corr[k];
-          p->peak_offsets[j] = k - start;
-          if (p->peak_values[j] > max_peak) {
-            max_peak = p->peak_values[j];
-            max_idx  = k;
-          }
-        }
+      uint32_t offset    = srsran_vec_max_fi(&p->corr[start], end - start);
+      p->peak_values[j]  = p->corr[start + offset];
+      p->peak_offsets[j] = offset;
+      if (p->peak_values[j] > max_peak) {
+        max_peak = p->peak_values[j];
+        max_idx  = start + offset;
       }
     }
     if (max_peak > (p->detect_factor * corr_ave)) {
@@ -935,7 +957,7 @@ int srsran_prach_process(srsran_prach_t* p,
                 max_to_cancel          = max_peak;
                 p->prach_cancel.idx    = cancellation_idx;
                 p->prach_cancel.factor = (sqrt(max_peak / (p->N_zc * p->N_zc)));
-                srsran_prach_calculate_correction_array(p, p->corr_freq);
+                srsran_prach_calculate_correction_array(p, corr_spec);
               }
               if (srsran_prach_have_stored(((i * n_wins) + j), indices, *n_indices)) {
                 break;
@@ -1021,9 +1043,12 @@ int srsran_prach_free(srsran_prach_t* p)
   free(p->ifft_out);
   free(p->cross);
   free(p->corr_freq);
+  free(p->corr_spec_batch);
+  free(p->corr_batch);
   srsran_dft_plan_free(&p->fft);
   srsran_dft_plan_free(&p->zc_fft);
   srsran_dft_plan_free(&p->zc_ifft);
+  srsran_dft_plan_free(&p->zc_ifft_batch);
 
   if (p->signal_fft) {
     free(p->signal_fft);
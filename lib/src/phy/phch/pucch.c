@@ -69,6 +69,12 @@ int srsran_pucch_init_(srsran_pucch_t* q, bool is_ue)
 
     if (!q->is_ue) {
       q->ce = srsran_vec_cf_malloc(SRSRAN_PUCCH_MAX_SYMBOLS);
+
+      for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+        for (uint32_t i = 0; i < SRSRAN_NRE; i++) {
+          q->dft_nre[k][i] = cexpf(I * 2.0 * M_PI * i * k / (float)SRSRAN_NRE) / sqrtf(SRSRAN_NRE);
+        }
+      }
     }
 
     ret = SRSRAN_SUCCESS;
@@ -533,11 +539,7 @@ static int decode_signal_format3(srsran_pucch_t*     q,
 
     // Do FFT
     for (int k = 0; k < SRSRAN_NRE; k++) {
-      cf_t acc = 0.0f;
-      for (int i = 0; i < SRSRAN_NRE; i++) {
-        acc += z[n * SRSRAN_NRE + i] * cexpf(I * 2.0 * M_PI * i * k / (float)SRSRAN_NRE);
-      }
-      y_n[k] = acc / sqrtf(SRSRAN_NRE);
+      y_n[k] = srsran_vec_dot_prod_ccc(&z[n * SRSRAN_NRE], q->dft_nre[k], SRSRAN_NRE);
     }
 
     if (n < N_sf_0) {
@@ -622,70 +624,95 @@ static int encode_bits(srsran_pucch_cfg_t*   cfg,
   return SRSRAN_SUCCESS;
 }
 
-static bool decode_signal(srsran_pucch_t*     q,
-                          srsran_ul_sf_cfg_t* sf,
-                          srsran_pucch_cfg_t* cfg,
-                          uint8_t             pucch_bits[SRSRAN_CQI_MAX_BITS],
-                          uint32_t            nof_re,
-                          uint32_t            nof_uci_bits,
-                          float*              correlation)
+/* Correlates the received Format 1, 1A or 1B symbols with every hypothesis of d(0). The hypotheses only differ in the
+ * unit modulus d(0) that scales the whole sequence, so the reference and the energies are computed once and each
+ * correlation derives from a single complex inner product */
+static bool decode_signal_format1(srsran_pucch_t*     q,
+                                  srsran_ul_sf_cfg_t* sf,
+                                  srsran_pucch_cfg_t* cfg,
+                                  uint8_t             pucch_bits[SRSRAN_CQI_MAX_BITS],
+                                  uint32_t            nof_re,
+                                  float*              correlation)
 {
-  int16_t llr_pucch2[SRSRAN_CQI_MAX_BITS];
-  bool    detected = false;
-  float   corr = 0, corr_max = -1e9;
-  uint8_t b_max = 0, b2_max = 0; // default bit value, eg. HI is NACK
+  bool  detected = false;
+  float corr = 0, corr_max = -1e9;
 
-  cf_t ref[SRSRAN_PUCCH_MAX_SYMBOLS];
+  // Reference sequence for d(0) = 1
+  encode_signal_format12(q, sf, cfg, NULL, q->z_tmp, true);
+
+  float s_x  = crealf(srsran_vec_dot_prod_conj_ccc(q->z, q->z, nof_re)) / nof_re;
+  float s_y  = crealf(srsran_vec_dot_prod_conj_ccc(q->z_tmp, q->z_tmp, nof_re)) / nof_re;
+  cf_t  cov  = srsran_vec_dot_prod_conj_ccc(q->z, q->z_tmp, nof_re) / nof_re;
+  float norm = sqrtf(s_x * s_y);
 
   switch (cfg->format) {
     case SRSRAN_PUCCH_FORMAT_1:
-      encode_signal(q, sf, cfg, pucch_bits, q->z_tmp);
-      corr = srsran_vec_corr_ccc(q->z, q->z_tmp, nof_re);
+      corr = crealf(conjf(uci_encode_format1()) * cov) / norm;
       if (corr >= cfg->threshold_format1) {
         detected = true;
       }
       DEBUG("format1 corr=%f, nof_re=%d, th=%f", corr, nof_re, cfg->threshold_format1);
       break;
     case SRSRAN_PUCCH_FORMAT_1A:
-      detected = 0;
       for (uint8_t b = 0; b < 2; b++) {
-        pucch_bits[0] = b;
-        encode_signal(q, sf, cfg, pucch_bits, q->z_tmp);
-        corr = srsran_vec_corr_ccc(q->z, q->z_tmp, nof_re);
+        corr = crealf(conjf(uci_encode_format1a(b)) * cov) / norm;
         if (corr > corr_max) {
-          corr_max = corr;
-          b_max    = b;
+          corr_max      = corr;
+          pucch_bits[0] = b;
         }
         if (corr_max > cfg->threshold_format1) { // check with format1 in case ack+sr because ack only is binary
           detected = true;
         }
         DEBUG("format1a b=%d, corr=%f, nof_re=%d", b, corr, nof_re);
       }
-      corr          = corr_max;
-      pucch_bits[0] = b_max;
+      corr = corr_max;
       break;
     case SRSRAN_PUCCH_FORMAT_1B:
-      detected = 0;
-      for (uint8_t b = 0; b < 2; b++) {
-        for (uint8_t b2 = 0; b2 < 2; b2++) {
-          pucch_bits[0] = b;
-          pucch_bits[1] = b2;
-          encode_signal(q, sf, cfg, pucch_bits, q->z_tmp);
-          corr = srsran_vec_corr_ccc(q->z, q->z_tmp, nof_re);
-          if (corr > corr_max) {
-            corr_max = corr;
-            b_max    = b;
-            b2_max   = b2;
-          }
-          if (corr_max > cfg->threshold_format1) { // check with format1 in case ack+sr because ack only is binary
-            detected = true;
-          }
-          DEBUG("format1b b=%d, corr=%f, nof_re=%d", b, corr, nof_re);
+      for (uint8_t b = 0; b < 4; b++) {
+        uint8_t bits[2] = {b / 2, b % 2};
+        corr            = crealf(conjf(uci_encode_format1b(bits)) * cov) / norm;
+        if (corr > corr_max) {
+          corr_max      = corr;
+          pucch_bits[0] = bits[0];
+          pucch_bits[1] = bits[1];
+        }
+        if (corr_max > cfg->threshold_format1) { // check with format1 in case ack+sr because ack only is binary
+          detected = true;
         }
+        DEBUG("format1b b=%d, corr=%f, nof_re=%d", bits[0], corr, nof_re);
       }
-      corr          = corr_max;
-      pucch_bits[0] = b_max;
-      pucch_bits[1] = b2_max;
+      corr = corr_max;
+      break;
+    default:
+      ERROR("PUCCH format %d is not Format 1", cfg->format);
+      return false;
+  }
+
+  if (correlation) {
+    *correlation = corr;
+  }
+  return detected;
+}
+
+static bool decode_signal(srsran_pucch_t*     q,
+                          srsran_ul_sf_cfg_t* sf,
+                          srsran_pucch_cfg_t* cfg,
+                          uint8_t             pucch_bits[SRSRAN_CQI_MAX_BITS],
+                          uint32_t            nof_re,
+                          uint32_t            nof_uci_bits,
+                          float*              correlation)
+{
+  int16_t llr_pucch2[SRSRAN_CQI_MAX_BITS];
+  bool    detected = false;
+  float   corr     = 0;
+
+  cf_t ref[SRSRAN_PUCCH_MAX_SYMBOLS];
+
+  switch (cfg->format) {
+    case SRSRAN_PUCCH_FORMAT_1:
+    case SRSRAN_PUCCH_FORMAT_1A:
+    case SRSRAN_PUCCH_FORMAT_1B:
+      detected = decode_signal_format1(q, sf, cfg, pucch_bits, nof_re, &corr);
       break;
     case SRSRAN_PUCCH_FORMAT_2:
     case SRSRAN_PUCCH_FORMAT_2A:
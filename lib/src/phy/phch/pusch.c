@@ -43,16 +43,10 @@
 
 #define ACK_SNR_TH -1.0
 
-/* Allocate/deallocate PUSCH RBs to the resource grid
+/* Gets the PUSCH RBs from the resource grid
  */
-static int pusch_cp(srsran_pusch_t*       q,
-                    srsran_pusch_grant_t* grant,
-                    cf_t*                 input,
-                    cf_t*                 output,
-                    bool                  is_shortened,
-                    bool                  advance_input)
+static int pusch_get(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input, cf_t* output, bool is_shortened)
 {
-  cf_t* in_ptr  = input;
   cf_t* out_ptr = output;
 
   uint32_t L_ref = 3;
@@ -64,44 +58,49 @@ static int pusch_cp(srsran_pusch_t*       q,
     if (is_shortened && slot == 1) {
       N_srs = 1;
     }
-    INFO("%s PUSCH %d PRB to index %d at slot %d",
-         advance_input ? "Allocating" : "Getting",
-         grant->L_prb,
-         grant->n_prb_tilde[slot],
-         slot);
+    INFO("Getting PUSCH %d PRB from index %d at slot %d", grant->L_prb, grant->n_prb_tilde[slot], slot);
     for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(q->cell.cp) - N_srs; l++) {
       if (l != L_ref) {
         uint32_t idx = SRSRAN_RE_IDX(
             q->cell.nof_prb, l + slot * SRSRAN_CP_NSYMB(q->cell.cp), grant->n_prb_tilde[slot] * SRSRAN_NRE);
-        if (advance_input) {
-          out_ptr = &output[idx];
-        } else {
-          in_ptr = &input[idx];
-        }
-        memcpy(out_ptr, in_ptr, grant->L_prb * SRSRAN_NRE * sizeof(cf_t));
-        if (advance_input) {
-          in_ptr += grant->L_prb * SRSRAN_NRE;
-        } else {
-          out_ptr += grant->L_prb * SRSRAN_NRE;
-        }
+        memcpy(out_ptr, &input[idx], grant->L_prb * SRSRAN_NRE * sizeof(cf_t));
+        out_ptr += grant->L_prb * SRSRAN_NRE;
       }
     }
   }
-  if (advance_input) {
-    return in_ptr - input;
-  } else {
-    return out_ptr - output;
-  }
+  return out_ptr - output;
 }
 
-static int pusch_put(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input, cf_t* output, bool is_shortened)
+/* Transform precodes the PUSCH symbols and writes each SC-FDMA symbol straight to its RBs in the resource grid. It
+ * fuses srsran_dft_precoding() and the RB mapping, so the precoded symbols are not staged in an intermediate buffer.
+ */
+static int
+pusch_precode_put(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input, cf_t* output, bool is_shortened)
 {
-  return pusch_cp(q, grant, input, output, is_shortened, true);
-}
+  srsran_dft_plan_t* plan   = &q->dft_precoding.dft_plan[grant->L_prb];
+  uint32_t           M      = grant->L_prb * SRSRAN_NRE;
+  cf_t*              in_ptr = input;
 
-static int pusch_get(srsran_pusch_t* q, srsran_pusch_grant_t* grant, cf_t* input, cf_t* output, bool is_shortened)
-{
-  return pusch_cp(q, grant, input, output, is_shortened, false);
+  uint32_t L_ref = 3;
+  if (SRSRAN_CP_ISEXT(q->cell.cp)) {
+    L_ref = 2;
+  }
+  for (uint32_t slot = 0; slot < 2; slot++) {
+    uint32_t N_srs = 0;
+    if (is_shortened && slot == 1) {
+      N_srs = 1;
+    }
+    INFO("Allocating PUSCH %d PRB to index %d at slot %d", grant->L_prb, grant->n_prb_tilde[slot], slot);
+    for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(q->cell.cp) - N_srs; l++) {
+      if (l != L_ref) {
+        uint32_t idx = SRSRAN_RE_IDX(
+            q->cell.nof_prb, l + slot * SRSRAN_CP_NSYMB(q->cell.cp), grant->n_prb_tilde[slot] * SRSRAN_NRE);
+        srsran_dft_run_c(plan, in_ptr, &output[idx]);
+        in_ptr += M;
+      }
+    }
+  }
+  return in_ptr - input;
 }
 
 /** Initializes the PDCCH transmitter and receiver */
@@ -160,6 +159,11 @@ static int pusch_init(srsran_pusch_t* q, uint32_t max_prb, bool is_ue)
         ERROR("Allocating EVM buffer");
         goto clean;
       }
+
+      if (srsran_scrambling_cache_init(&q->scrambling_cache,
+                                       q->max_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_64QAM))) {
+        goto clean;
+      }
     }
     q->z = srsran_vec_cf_malloc(q->max_re);
     if (!q->z) {
@@ -213,6 +217,7 @@ void srsran_pusch_free(srsran_pusch_t* q)
     srsran_modem_table_free(&q->mod[i]);
   }
   srsran_sch_free(&q->ul_sch);
+  srsran_scrambling_cache_free(&q->scrambling_cache);
 
   bzero(q, sizeof(srsran_pusch_t));
 }
@@ -229,11 +234,19 @@ int srsran_pusch_set_cell(srsran_pusch_t* q, srsran_cell_t cell)
 
     q->cell   = cell;
     q->max_re = cell.nof_prb * MAX_PUSCH_RE(cell.cp);
-    ret       = SRSRAN_SUCCESS;
+    srsran_scrambling_cache_set_cell(&q->scrambling_cache, cell.id);
+    ret = SRSRAN_SUCCESS;
   }
   return ret;
 }
 
+void srsran_pusch_rem_rnti(srsran_pusch_t* q, uint16_t rnti)
+{
+  if (q != NULL) {
+    srsran_scrambling_cache_rem_rnti(&q->scrambling_cache, rnti);
+  }
+}
+
 int srsran_pusch_assert_grant(const srsran_pusch_grant_t* grant)
 {
   // Check for valid number of PRB
@@ -333,11 +346,8 @@ int srsran_pusch_encode(srsran_pusch_t*      q,
     // Bit mapping
     srsran_mod_modulate_bytes(&q->mod[cfg->grant.tb.mod], (uint8_t*)q->q, q->d, cfg->grant.tb.nof_bits);
 
-    // DFT precoding
-    srsran_dft_precoding(&q->dft_precoding, q->d, q->z, cfg->grant.L_prb, cfg->grant.nof_symb);
-
-    // Mapping to resource elements
-    uint32_t n = pusch_put(q, &cfg->grant, q->z, sf_symbols, sf->shortened);
+    // DFT precoding and mapping to resource elements
+    uint32_t n = pusch_precode_put(q, &cfg->grant, q->d, sf_symbols, sf->shortened);
     if (n != cfg->grant.nof_re) {
       ERROR("Error trying to allocate %d symbols but %d were allocated (tti=%d, short=%d, L=%d)",
             cfg->grant.nof_re,
@@ -432,25 +442,38 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
       out->evm = NAN;
     }
 
-    // Descrambling
+    // The sequence is generated once per RNTI and subframe, it falls back to the generator if it cannot be cached
+    const uint8_t* seq = srsran_scrambling_cache_get(
+        &q->scrambling_cache, cfg->rnti, sf->tti % SRSRAN_NOF_SF_X_FRAME, 0, cfg->grant.tb.nof_bits);
+
+    // Descrambling, 16-bit LLRs are descrambled by the decoder while they are deinterleaved
     if (q->llr_is_8bit) {
-      srsran_sequence_pusch_apply_c(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
-    } else {
-      srsran_sequence_pusch_apply_s(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      if (seq) {
+        srsran_scrambling_packed_apply_c(seq, q->q, q->q, cfg->grant.tb.nof_bits);
+      } else {
+        srsran_sequence_pusch_apply_c(
+            q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      }
     }
 
-    // Generate packed sequence for UCI decoder
+    // Generate unpacked sequence for UCI decoder and 16-bit LLR descrambling
     uint8_t* c = (uint8_t*)q->z; // Reuse Z
-    srsran_sequence_pusch_gen_unpack(
-        c, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+    if (seq) {
+      srsran_bit_unpack_vector(seq, c, (int)cfg->grant.tb.nof_bits);
+    } else {
+      srsran_sequence_pusch_gen_unpack(
+          c, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+    }
 
     // Set max number of iterations
     srsran_sch_set_max_noi(&q->ul_sch, cfg->max_nof_iterations);
 
     // Decode
-    ret      = srsran_ulsch_decode(&q->ul_sch, cfg, q->q, q->g, c, out->data, &out->uci);
+    if (q->llr_is_8bit) {
+      ret = srsran_ulsch_decode(&q->ul_sch, cfg, q->q, q->g, c, out->data, &out->uci);
+    } else {
+      ret = srsran_ulsch_decode_scrambled(&q->ul_sch, cfg, q->q, q->g, c, out->data, &out->uci);
+    }
     out->crc = (ret == 0);
 
     // Save number of iterations
@@ -454,14 +454,19 @@ static uint32_t ra_nr_tbs_from_n_info3(uint32_t n_info)
   uint32_t n            = (uint32_t)SRSRAN_MAX(3.0, floor(log2(n_info)) - 6.0);
   uint32_t n_info_prime = SRSRAN_MAX(ra_nr_tbs_table[0], POW2(n) * SRSRAN_FLOOR(n_info, POW2(n)));
 
-  // use Table 5.1.3.2-1 find the closest TBS that is not less than n_info_prime
-  for (uint32_t i = 0; i < RA_NR_TBS_SIZE_TABLE; i++) {
-    if (n_info_prime <= ra_nr_tbs_table[i]) {
-      return ra_nr_tbs_table[i];
+  // use Table 5.1.3.2-1 find the closest TBS that is not less than n_info_prime, the table is sorted
+  uint32_t lo = 0;
+  uint32_t hi = RA_NR_TBS_SIZE_TABLE - 1;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (ra_nr_tbs_table[mid] < n_info_prime) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
     }
   }
 
-  return ra_nr_tbs_table[RA_NR_TBS_SIZE_TABLE - 1];
+  return ra_nr_tbs_table[lo];
 }
 
 static uint32_t ra_nr_tbs_from_n_info4(uint32_t n_info, double R)
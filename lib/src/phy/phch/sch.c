@@ -25,6 +25,8 @@
 #include "srsran/srsran.h"
 #include <assert.h>
 #include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -198,8 +200,11 @@ clean:
   return ret;
 }
 
+static void sch_disable_cb_workers(srsran_sch_t* q);
+
 void srsran_sch_free(srsran_sch_t* q)
 {
+  sch_disable_cb_workers(q);
   srsran_rm_turbo_free_tables();
 
   if (q->cb_in) {
@@ -236,16 +241,19 @@ float srsran_sch_last_noi(srsran_sch_t* q)
 
 /* Encode a transport block according to 36.212 5.3.2
  *
+ * The e-bits are written w_offset bits after the beginning of e_bits. If scrambling is given, the bits are scrambled
+ * as well, in which case w_offset shall be 0.
  */
-static int encode_tb_off(srsran_sch_t*           q,
-                         srsran_softbuffer_tx_t* softbuffer,
-                         srsran_cbsegm_t*        cb_segm,
-                         uint32_t                Qm,
-                         uint32_t                rv,
-                         uint32_t                nof_e_bits,
-                         uint8_t*                data,
-                         uint8_t*                e_bits,
-                         uint32_t                w_offset)
+static int encode_tb_off(srsran_sch_t*            q,
+                         srsran_softbuffer_tx_t*  softbuffer,
+                         srsran_cbsegm_t*         cb_segm,
+                         uint32_t                 Qm,
+                         uint32_t                 rv,
+                         uint32_t                 nof_e_bits,
+                         uint8_t*                 data,
+                         uint8_t*                 e_bits,
+                         uint32_t                 w_offset,
+                         srsran_sequence_state_t* scrambling)
 {
   uint32_t i;
   uint32_t cb_len = 0, rp = 0, wp = 0, rlen = 0, n_e = 0;
@@ -274,9 +282,17 @@ static int encode_tb_off(srsran_sch_t*           q,
       gamma = Gp % cb_segm->C;
     }
 
+    /* Retransmissions with a different RV reuse the code blocks encoded and interleaved by the first transmission */
+    bool reuse_cb = (rv != 0 && softbuffer->cb_encoded != NULL && softbuffer->encoded_tbs == cb_segm->tbs);
+    for (i = 0; i < cb_segm->C && reuse_cb; i++) {
+      reuse_cb = softbuffer->cb_encoded[i];
+    }
+
     /* Reset TB CRC */
     srsran_crc_set_init(&q->crc_tb, 0);
 
+    uint32_t scrambled_bytes = 0;
+
     wp = 0;
     rp = 0;
     for (i = 0; i < cb_segm->C; i++) {
@@ -302,7 +318,7 @@ static int encode_tb_off(srsran_sch_t*           q,
 
       INFO("CB#%d: cb_len: %d, rlen: %d, wp: %d, rp: %d, E: %d", i, cb_len, rlen, wp, rp, n_e);
 
-      if (data) {
+      if (data && !reuse_cb) {
         bool last_cb = false;
 
         /* Copy data to another buffer, making space for the Codeblock CRC */
@@ -327,18 +343,19 @@ static int encode_tb_off(srsran_sch_t*           q,
                                q->parity_bits,
                                cblen_idx,
                                last_cb);
+
+        /* Sub-block interleaving into the circular buffer, kept for the retransmissions */
+        srsran_rm_turbo_tx_lut_interleave(softbuffer->buffer_b[i], q->cb_in, q->parity_bits, cblen_idx);
+        if (softbuffer->cb_encoded) {
+          softbuffer->cb_encoded[i] = true;
+          softbuffer->encoded_tbs   = cb_segm->tbs;
+        }
       }
       DEBUG("RM cblen_idx=%d, n_e=%d, wp=%d, nof_e_bits=%d", cblen_idx, n_e, wp, nof_e_bits);
 
       /* Rate matching */
-      if (srsran_rm_turbo_tx_lut(softbuffer->buffer_b[i],
-                                 q->cb_in,
-                                 q->parity_bits,
-                                 &e_bits[(wp + w_offset) / 8],
-                                 cblen_idx,
-                                 n_e,
-                                 (wp + w_offset) % 8,
-                                 rv)) {
+      if (srsran_rm_turbo_tx_lut_select(
+              softbuffer->buffer_b[i], &e_bits[(wp + w_offset) / 8], cblen_idx, n_e, (wp + w_offset) % 8, rv)) {
         ERROR("Error in rate matching");
         return SRSRAN_ERROR;
       }
@@ -346,6 +363,19 @@ static int encode_tb_off(srsran_sch_t*           q,
       /* Set read/write pointers */
       rp += rlen;
       wp += n_e;
+
+      /* Scramble the bytes completed by this code block while they are still in cache */
+      if (scrambling) {
+        uint32_t nof_bytes = wp / 8 - scrambled_bytes;
+        srsran_sequence_state_apply_packed(
+            scrambling, &e_bits[scrambled_bytes], &e_bits[scrambled_bytes], nof_bytes * 8);
+        scrambled_bytes += nof_bytes;
+      }
+    }
+
+    if (scrambling) {
+      srsran_sequence_state_apply_packed(
+          scrambling, &e_bits[scrambled_bytes], &e_bits[scrambled_bytes], wp - scrambled_bytes * 8);
     }
 
     INFO("END CB#%d: wp: %d, rp: %d", i, wp, rp);
@@ -356,121 +386,372 @@ static int encode_tb_off(srsran_sch_t*           q,
   return ret;
 }
 
-static int encode_tb(srsran_sch_t*           q,
-                     srsran_softbuffer_tx_t* soft_buffer,
+/* Decodes a single code block. If the code block CRC was already OK in a previous transmission, the data is recovered
+ * from the soft-buffer. The decoded bits (including the CB CRC) are written in cb_out and the number of iterations is
+ * returned. It shall not use any resource from q other than the given decoder and CRC, so it can be called
+ * concurrently for different code blocks.
+ */
+static int decode_cb(srsran_sch_t*           q,
+                     srsran_tdec_t*          decoder,
+                     srsran_crc_t*           crc_ptr,
+                     srsran_softbuffer_rx_t* softbuffer,
                      srsran_cbsegm_t*        cb_segm,
                      uint32_t                Qm,
                      uint32_t                rv,
                      uint32_t                nof_e_bits,
-                     uint8_t*                data,
-                     uint8_t*                e_bits)
+                     void*                   e_bits,
+                     const uint32_t*         e_lut,
+                     uint32_t                cb_idx,
+                     uint8_t*                cb_out)
 {
-  return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0);
+  int8_t*  e_bits_b = e_bits;
+  int16_t* e_bits_s = e_bits;
+
+  uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+  uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+
+  /* Do not process blocks with CRC Ok, copy decoded data from previous transmissions */
+  if (softbuffer->cb_crc[cb_idx]) {
+    memcpy(cb_out, softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+    return 0;
+  }
+
+  uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+
+  uint32_t Gp    = nof_e_bits / Qm;
+  uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
+  uint32_t n_e   = Qm * (Gp / cb_segm->C);
+
+  uint32_t rp   = cb_idx * n_e;
+  uint32_t n_e2 = n_e;
+
+  if (cb_idx > cb_segm->C - gamma) {
+    n_e2 = n_e + Qm;
+    rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
+  }
+
+  if (e_lut != NULL) {
+    if (srsran_rm_turbo_rx_lut_gather(e_bits_s, &e_lut[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
+  } else if (q->llr_is_8bit) {
+    if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
+  } else {
+    if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
+      ERROR("Error in rate matching");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  srsran_tdec_new_cb(decoder, cb_len);
+
+  // Run iterations and use CRC for early stopping
+  bool     early_stop    = false;
+  bool     stable        = false;
+  uint32_t cb_noi        = 0;
+  uint32_t len_crc       = cb_segm->C > 1 ? cb_len : cb_segm->tbs + 24;
+  uint32_t prev_checksum = 0;
+  do {
+    if (q->llr_is_8bit) {
+      srsran_tdec_iteration_8bit(decoder, (int8_t*)softbuffer->buffer_f[cb_idx], cb_out);
+    } else {
+      srsran_tdec_iteration(decoder, softbuffer->buffer_f[cb_idx], cb_out);
+    }
+    cb_noi++;
+
+    uint32_t checksum = srsran_crc_checksum_byte(crc_ptr, cb_out, len_crc);
+
+    // CRC is OK and ran the minimum number of iterations
+    if (!checksum && (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
+      softbuffer->cb_crc[cb_idx] = true;
+      early_stop                 = true;
+
+      // CRC is error and exceeded maximum iterations for this CB.
+      // Early stop the whole transport block.
+    } else if (q->early_stop_stable && cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS && checksum == prev_checksum) {
+      // Both constituent decoders agree on the same (wrong) hard decisions, more iterations are unlikely to converge.
+      // The checksum is used as a signature of the hard decisions.
+      stable = true;
+    }
+    prev_checksum = checksum;
+
+  } while (cb_noi < q->max_iterations && !early_stop && !stable);
+
+  INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s%s, rlen=%d, iterations=%d/%d",
+       cb_idx,
+       rp,
+       n_e2,
+       cb_len,
+       early_stop ? "OK" : "KO",
+       stable ? " (stable)" : "",
+       rlen,
+       cb_noi,
+       q->max_iterations);
+
+  return (int)cb_noi;
 }
 
-bool decode_tb_cb(srsran_sch_t*           q,
-                  srsran_softbuffer_rx_t* softbuffer,
-                  srsran_cbsegm_t*        cb_segm,
-                  uint32_t                Qm,
-                  uint32_t                rv,
-                  uint32_t                nof_e_bits,
-                  void*                   e_bits,
-                  uint8_t*                data)
+/* Parameters of the transport block being decoded by the code block workers */
+typedef struct {
+  srsran_sch_t*           q;
+  srsran_softbuffer_rx_t* softbuffer;
+  srsran_cbsegm_t*        cb_segm;
+  uint32_t                Qm;
+  uint32_t                rv;
+  uint32_t                nof_e_bits;
+  void*                   e_bits;
+  const uint32_t*         e_lut;
+  uint8_t*                data;
+} sch_cb_job_t;
+
+typedef struct {
+  /* Thread identifier: they must set before thread creation */
+  pthread_t pthread;
+  uint32_t  worker_idx;
+  void*     pool;
+
+  /* Decoder resources owned by this worker */
+  srsran_tdec_t decoder;
+  srsran_crc_t  crc_cb;
+  uint8_t*      cb_out;
+
+  /* Execution status */
+  int nof_iterations;
+
+  /* Semaphores */
+  sem_t start;
+  sem_t finish;
+
+  /* Thread flags */
+  bool started;
+  bool quit;
+} sch_cb_worker_t;
+
+typedef struct {
+  uint32_t         nof_workers;
+  sch_cb_worker_t* workers;
+
+  /* Scratch output for the calling thread */
+  uint8_t* cb_out;
+
+  /* Current job: it must be set before posting start semaphores */
+  sch_cb_job_t job;
+} sch_cb_pool_t;
+
+/* Decodes the code blocks cb_idx = first, first + step, ... of the transport block. If cb_out is NULL the code blocks
+ * are decoded in place, otherwise every code block is decoded in cb_out and its payload copied to the TB data. This
+ * prevents the CB CRC of one code block overwriting the beginning of the next one while they are decoded in parallel.
+ * Returns the total number of iterations or a negative value if an error occurred.
+ */
+static int decode_tb_cb_range(const sch_cb_job_t* job,
+                              srsran_tdec_t*      decoder,
+                              srsran_crc_t*       crc_cb,
+                              uint32_t            first,
+                              uint32_t            step,
+                              uint8_t*            cb_out)
 {
-  int8_t*  e_bits_b = e_bits;
-  int16_t* e_bits_s = e_bits;
+  srsran_cbsegm_t* cb_segm = job->cb_segm;
+  srsran_crc_t*    crc_ptr = cb_segm->C > 1 ? crc_cb : &job->q->crc_tb;
+  int              noi     = 0;
+
+  for (uint32_t cb_idx = first; cb_idx < cb_segm->C; cb_idx += step) {
+    uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+    uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+    uint8_t* out    = cb_out ? cb_out : &job->data[cb_idx * rlen / 8];
+
+    int n = decode_cb(job->q,
+                      decoder,
+                      crc_ptr,
+                      job->softbuffer,
+                      cb_segm,
+                      job->Qm,
+                      job->rv,
+                      job->nof_e_bits,
+                      job->e_bits,
+                      job->e_lut,
+                      cb_idx,
+                      out);
+    if (n < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    noi += n;
 
-  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
-    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
-    return false;
+    if (cb_out) {
+      memcpy(&job->data[cb_idx * rlen / 8], cb_out, rlen / 8 * sizeof(uint8_t));
+    }
   }
 
-  q->avg_iterations = 0;
+  return noi;
+}
 
-  for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
-    /* Do not process blocks with CRC Ok */
-    if (softbuffer->cb_crc[cb_idx] == false) {
-      uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+static void* sch_cb_worker_thread(void* arg)
+{
+  sch_cb_worker_t* w    = (sch_cb_worker_t*)arg;
+  sch_cb_pool_t*   pool = (sch_cb_pool_t*)w->pool;
 
-      uint32_t rlen  = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      uint32_t Gp    = nof_e_bits / Qm;
-      uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
-      uint32_t n_e   = Qm * (Gp / cb_segm->C);
+  sem_wait(&w->start);
+  while (!w->quit) {
+    // The calling thread takes the first code block, worker i takes i + 1
+    w->nof_iterations =
+        decode_tb_cb_range(&pool->job, &w->decoder, &w->crc_cb, w->worker_idx + 1, pool->nof_workers + 1, w->cb_out);
 
-      uint32_t rp   = cb_idx * n_e;
-      uint32_t n_e2 = n_e;
+    /* Post finish semaphore */
+    sem_post(&w->finish);
 
-      if (cb_idx > cb_segm->C - gamma) {
-        n_e2 = n_e + Qm;
-        rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
-      }
+    /* Wait for next loop */
+    sem_wait(&w->start);
+  }
+  sem_post(&w->finish);
 
-      if (q->llr_is_8bit) {
-        if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
-      } else {
-        if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
+  pthread_exit(NULL);
+  return w;
+}
+
+static void sch_disable_cb_workers(srsran_sch_t* q)
+{
+  sch_cb_pool_t* pool = (sch_cb_pool_t*)q->cb_workers;
+  if (pool == NULL) {
+    return;
+  }
+
+  if (pool->workers) {
+    for (uint32_t i = 0; i < pool->nof_workers; i++) {
+      sch_cb_worker_t* w = &pool->workers[i];
+      if (w->started) {
+        /* Stop threads */
+        w->quit = true;
+        sem_post(&w->start);
+        pthread_join(w->pthread, NULL);
+      }
+      sem_destroy(&w->start);
+      sem_destroy(&w->finish);
+      srsran_tdec_free(&w->decoder);
+      if (w->cb_out) {
+        free(w->cb_out);
       }
+    }
+    free(pool->workers);
+  }
 
-      srsran_tdec_new_cb(&q->decoder, cb_len);
+  if (pool->cb_out) {
+    free(pool->cb_out);
+  }
 
-      // Run iterations and use CRC for early stopping
-      bool     early_stop = false;
-      uint32_t cb_noi     = 0;
-      do {
-        if (q->llr_is_8bit) {
-          srsran_tdec_iteration_8bit(&q->decoder, (int8_t*)softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        } else {
-          srsran_tdec_iteration(&q->decoder, softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        }
-        q->avg_iterations++;
-        cb_noi++;
+  free(pool);
+  q->cb_workers = NULL;
+}
 
-        uint32_t      len_crc;
-        srsran_crc_t* crc_ptr;
+int srsran_sch_enable_cb_workers(srsran_sch_t* q, uint32_t nof_workers)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-        if (cb_segm->C > 1) {
-          len_crc = cb_len;
-          crc_ptr = &q->crc_cb;
-        } else {
-          len_crc = cb_segm->tbs + 24;
-          crc_ptr = &q->crc_tb;
-        }
+  // Release any previous pool, zero workers disables the parallel decoding
+  sch_disable_cb_workers(q);
+  if (nof_workers == 0) {
+    return SRSRAN_SUCCESS;
+  }
 
-        // CRC is OK and ran the minimum number of iterations
-        if (!srsran_crc_checksum_byte(crc_ptr, &data[cb_idx * rlen / 8], len_crc) &&
-            (cb_noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
-          softbuffer->cb_crc[cb_idx] = true;
-          early_stop                 = true;
+  sch_cb_pool_t* pool = calloc(sizeof(sch_cb_pool_t), 1);
+  if (!pool) {
+    ERROR("Allocating code block worker pool");
+    return SRSRAN_ERROR;
+  }
+  q->cb_workers = pool;
 
-          // CRC is error and exceeded maximum iterations for this CB.
-          // Early stop the whole transport block.
-        }
+  pool->cb_out = srsran_vec_u8_malloc(SRSRAN_TCOD_MAX_LEN_CB / 8);
+  if (!pool->cb_out) {
+    goto clean;
+  }
 
-      } while (cb_noi < q->max_iterations && !early_stop);
+  pool->workers = calloc(sizeof(sch_cb_worker_t), nof_workers);
+  if (!pool->workers) {
+    ERROR("Allocating code block workers");
+    goto clean;
+  }
+  pool->nof_workers = nof_workers;
 
-      INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
-           cb_idx,
-           rp,
-           n_e2,
-           cb_len,
-           early_stop ? "OK" : "KO",
-           rlen,
-           cb_noi,
-           q->max_iterations);
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    sch_cb_worker_t* w = &pool->workers[i];
+    w->worker_idx      = i;
+    w->pool            = pool;
 
-    } else {
-      // Copy decoded data from previous transmissions
-      uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+    if (srsran_tdec_init(&w->decoder, SRSRAN_TCOD_MAX_LEN_CB)) {
+      ERROR("Error initiating Turbo Decoder");
+      goto clean;
+    }
+    if (srsran_crc_init(&w->crc_cb, SRSRAN_LTE_CRC24B, 24)) {
+      ERROR("Error initiating CRC");
+      goto clean;
+    }
+    w->cb_out = srsran_vec_u8_malloc(SRSRAN_TCOD_MAX_LEN_CB / 8);
+    if (!w->cb_out) {
+      goto clean;
+    }
+    if (sem_init(&w->start, 0, 0) || sem_init(&w->finish, 0, 0)) {
+      ERROR("Creating semaphore");
+      goto clean;
+    }
+    if (pthread_create(&w->pthread, NULL, sch_cb_worker_thread, (void*)w)) {
+      ERROR("Creating code block worker thread");
+      goto clean;
+    }
+    w->started = true;
+  }
+
+  return SRSRAN_SUCCESS;
+
+clean:
+  sch_disable_cb_workers(q);
+  return SRSRAN_ERROR;
+}
+
+static bool decode_tb_cb(srsran_sch_t*           q,
+                         srsran_softbuffer_rx_t* softbuffer,
+                         srsran_cbsegm_t*        cb_segm,
+                         uint32_t                Qm,
+                         uint32_t                rv,
+                         uint32_t                nof_e_bits,
+                         void*                   e_bits,
+                         const uint32_t*         e_lut,
+                         uint8_t*                data)
+{
+  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
+    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
+    return false;
+  }
+
+  sch_cb_job_t job = {q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, e_lut, data};
+
+  int            noi  = 0;
+  sch_cb_pool_t* pool = (sch_cb_pool_t*)q->cb_workers;
+  if (pool != NULL && cb_segm->C > 1) {
+    // Distribute the code blocks among the workers and the calling thread
+    pool->job          = job;
+    uint32_t nof_going = SRSRAN_MIN(pool->nof_workers, cb_segm->C - 1);
+    for (uint32_t i = 0; i < nof_going; i++) {
+      sem_post(&pool->workers[i].start);
+    }
+
+    noi = decode_tb_cb_range(&job, &q->decoder, &q->crc_cb, 0, pool->nof_workers + 1, pool->cb_out);
+
+    for (uint32_t i = 0; i < nof_going; i++) {
+      sem_wait(&pool->workers[i].finish);
+      if (noi >= SRSRAN_SUCCESS) {
+        noi = pool->workers[i].nof_iterations < SRSRAN_SUCCESS ? SRSRAN_ERROR : noi + pool->workers[i].nof_iterations;
+      }
     }
+  } else {
+    noi = decode_tb_cb_range(&job, &q->decoder, &q->crc_cb, 0, 1, NULL);
+  }
+
+  if (noi < SRSRAN_SUCCESS) {
+    return false;
   }
 
   softbuffer->tb_crc = true;
@@ -489,7 +770,7 @@ bool decode_tb_cb(srsran_sch_t*           q,
     }
   }
 
-  q->avg_iterations /= (float)cb_segm->C;
+  q->avg_iterations = (float)noi / (float)cb_segm->C;
   return softbuffer->tb_crc;
 }
 
@@ -500,6 +781,7 @@ bool decode_tb_cb(srsran_sch_t*           q,
  * @param[inout] softbuffer Initialized softbuffer
  * @param[in] cb_segm Code block segmentation parameters
  * @param[in] e_bits Input transport block
+ * @param[in] e_lut Optional position and sign of every input bit in e_bits, NULL if e_bits are already in order
  * @param[in] Qm Modulation type
  * @param[in] rv Redundancy Version. Indicates which part of FEC bits is in input buffer
  * @param[out] softbuffer Initialized output softbuffer
@@ -513,6 +795,7 @@ static int decode_tb(srsran_sch_t*           q,
                      uint32_t                rv,
                      uint32_t                nof_e_bits,
                      int16_t*                e_bits,
+                     const uint32_t*         e_lut,
                      uint8_t*                data)
 {
   // Check inputs
@@ -545,7 +828,7 @@ static int decode_tb(srsran_sch_t*           q,
   }
 
   // Process Codeblocks
-  bool cb_crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data);
+  bool cb_crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, e_lut, data);
 
   // If any of the CBs CRC is KO
   if (!cb_crc_ok) {
@@ -605,6 +888,7 @@ int srsran_dlsch_decode2(srsran_sch_t*       q,
                    cfg->grant.tb[tb_idx].rv,
                    cfg->grant.tb[tb_idx].nof_bits,
                    e_bits,
+                   NULL,
                    data);
 }
 
@@ -623,12 +907,13 @@ int srsran_dlsch_encode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, uint8_t* data,
   return srsran_dlsch_encode2(q, cfg, data, e_bits, 0, 1);
 }
 
-int srsran_dlsch_encode2(srsran_sch_t*       q,
-                         srsran_pdsch_cfg_t* cfg,
-                         uint8_t*            data,
-                         uint8_t*            e_bits,
-                         int                 tb_idx,
-                         uint32_t            nof_layers)
+static int dlsch_encode(srsran_sch_t*            q,
+                        srsran_pdsch_cfg_t*      cfg,
+                        uint8_t*                 data,
+                        uint8_t*                 e_bits,
+                        int                      tb_idx,
+                        uint32_t                 nof_layers,
+                        srsran_sequence_state_t* scrambling)
 {
   uint32_t Nl = 1;
 
@@ -645,14 +930,40 @@ int srsran_dlsch_encode2(srsran_sch_t*       q,
 
   uint32_t Qm = srsran_mod_bits_x_symbol(cfg->grant.tb[tb_idx].mod);
 
-  return encode_tb(q,
-                   cfg->softbuffers.tx[tb_idx],
-                   &cb_segm,
-                   Qm * Nl,
-                   cfg->grant.tb[tb_idx].rv,
-                   cfg->grant.tb[tb_idx].nof_bits,
-                   data,
-                   e_bits);
+  return encode_tb_off(q,
+                       cfg->softbuffers.tx[tb_idx],
+                       &cb_segm,
+                       Qm * Nl,
+                       cfg->grant.tb[tb_idx].rv,
+                       cfg->grant.tb[tb_idx].nof_bits,
+                       data,
+                       e_bits,
+                       0,
+                       scrambling);
+}
+
+int srsran_dlsch_encode2(srsran_sch_t*       q,
+                         srsran_pdsch_cfg_t* cfg,
+                         uint8_t*            data,
+                         uint8_t*            e_bits,
+                         int                 tb_idx,
+                         uint32_t            nof_layers)
+{
+  return dlsch_encode(q, cfg, data, e_bits, tb_idx, nof_layers, NULL);
+}
+
+int srsran_dlsch_encode2_scrambled(srsran_sch_t*       q,
+                                   srsran_pdsch_cfg_t* cfg,
+                                   uint8_t*            data,
+                                   uint8_t*            e_bits,
+                                   int                 tb_idx,
+                                   uint32_t            nof_layers,
+                                   uint32_t            seed)
+{
+  srsran_sequence_state_t scrambling = {};
+  srsran_sequence_state_init(&scrambling, seed);
+
+  return dlsch_encode(q, cfg, data, e_bits, tb_idx, nof_layers, &scrambling);
 }
 
 /* Compute the interleaving function on-the-fly, because it depends on number of RI bits
@@ -1020,11 +1331,50 @@ void ulsch_deinterleave(int16_t*          q_bits,
   }
 }
 
+/* Generates the inverse of the UL-SCH channel interleaver: g_to_q[i] is the position in q_bits of the i-th bit of
+ * g_bits, skipping the RI bits. The sign of the scrambling sequence c_seq at that position is stored in the same entry,
+ * as srsran_rm_turbo_rx_lut_gather() expects, so that descrambling and deinterleaving can be done while gathering the
+ * code block bits.
+ */
+static void ulsch_deinterleave_gen(uint32_t       H_prime_total,
+                                   uint32_t       N_pusch_symbs,
+                                   uint32_t       Qm,
+                                   const uint8_t* ri_present,
+                                   const uint8_t* c_seq,
+                                   uint32_t*      g_to_q)
+{
+  uint32_t rows = H_prime_total / N_pusch_symbs;
+  uint32_t cols = N_pusch_symbs;
+  uint32_t idx  = 0;
+  for (uint32_t j = 0; j < rows; j++) {
+    for (uint32_t i = 0; i < cols; i++) {
+      uint32_t pos = j * Qm + i * rows * Qm;
+      for (uint32_t k = 0; k < Qm; k++, pos++) {
+        // c_seq holds 0 or 1, shifting it sets SRSRAN_RM_TURBO_RX_LUT_NEG without branching on the random sequence
+        if (ri_present == NULL || !ri_present[pos]) {
+          g_to_q[idx++] = pos | ((uint32_t)c_seq[pos] << 31U);
+        }
+      }
+    }
+  }
+}
+
+/* Descrambles and deinterleaves the first len bits of g_bits from q_bits, using the table from ulsch_deinterleave_gen()
+ */
+static void ulsch_deinterleave_lut(const int16_t* q_bits, const uint32_t* g_to_q, int16_t* g_bits, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++) {
+    int16_t x = q_bits[g_to_q[i] & SRSRAN_RM_TURBO_RX_LUT_IDX_MASK];
+    g_bits[i] = (g_to_q[i] & SRSRAN_RM_TURBO_RX_LUT_NEG) ? -x : x;
+  }
+}
+
 static int uci_decode_ri_ack(srsran_sch_t*       q,
                              srsran_pusch_cfg_t* cfg,
                              int16_t*            q_bits,
                              uint8_t*            c_seq,
-                             srsran_uci_value_t* uci_data)
+                             srsran_uci_value_t* uci_data,
+                             bool                q_bits_scrambled)
 {
   int ret = 0;
 
@@ -1059,17 +1409,18 @@ static int uci_decode_ri_ack(srsran_sch_t*       q,
       }
       beta /= beta_cqi;
     }
-    ret = srsran_uci_decode_ack_ri(cfg,
-                                   q_bits,
-                                   c_seq,
-                                   beta,
-                                   nb_q / Qm,
-                                   cqi_len,
-                                   q->ack_ri_bits,
-                                   uci_data->ack.ack_value,
-                                   &uci_data->ack.valid,
-                                   srsran_uci_cfg_total_ack(&cfg->uci_cfg),
-                                   false);
+    ret = (q_bits_scrambled ? srsran_uci_decode_ack_ri_scrambled : srsran_uci_decode_ack_ri)(
+        cfg,
+        q_bits,
+        c_seq,
+        beta,
+        nb_q / Qm,
+        cqi_len,
+        q->ack_ri_bits,
+        uci_data->ack.ack_value,
+        &uci_data->ack.valid,
+        srsran_uci_cfg_total_ack(&cfg->uci_cfg),
+        false);
     if (ret < 0) {
       return ret;
     }
@@ -1092,17 +1443,18 @@ static int uci_decode_ri_ack(srsran_sch_t*       q,
       }
       beta /= beta_cqi;
     }
-    ret = srsran_uci_decode_ack_ri(cfg,
-                                   q_bits,
-                                   c_seq,
-                                   beta,
-                                   nb_q / Qm,
-                                   cqi_len,
-                                   q->ack_ri_bits,
-                                   &uci_data->ri,
-                                   NULL,
-                                   cfg->uci_cfg.cqi.ri_len,
-                                   true);
+    ret = (q_bits_scrambled ? srsran_uci_decode_ack_ri_scrambled : srsran_uci_decode_ack_ri)(
+        cfg,
+        q_bits,
+        c_seq,
+        beta,
+        nb_q / Qm,
+        cqi_len,
+        q->ack_ri_bits,
+        &uci_data->ri,
+        NULL,
+        cfg->uci_cfg.cqi.ri_len,
+        true);
     if (ret < 0) {
       return ret;
     }
@@ -1119,13 +1471,14 @@ static int uci_decode_ri_ack(srsran_sch_t*       q,
   return Q_prime_ri;
 }
 
-int srsran_ulsch_decode(srsran_sch_t*       q,
+static int ulsch_decode(srsran_sch_t*       q,
                         srsran_pusch_cfg_t* cfg,
                         int16_t*            q_bits,
                         int16_t*            g_bits,
                         uint8_t*            c_seq,
                         uint8_t*            data,
-                        srsran_uci_value_t* uci_data)
+                        srsran_uci_value_t* uci_data,
+                        bool                q_bits_scrambled)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
@@ -1142,23 +1495,37 @@ int srsran_ulsch_decode(srsran_sch_t*       q,
   cfg->K_segm = cb_segm.C1 * cb_segm.K1 + cb_segm.C2 * cb_segm.K2;
 
   // Decode RI/HARQ values
-  if ((ret = uci_decode_ri_ack(q, cfg, q_bits, c_seq, uci_data)) < 0) {
+  if ((ret = uci_decode_ri_ack(q, cfg, q_bits, c_seq, uci_data, q_bits_scrambled)) < 0) {
     ERROR("Error decoding RI/HARQ bits");
     return SRSRAN_ERROR;
   }
 
   uint32_t Q_prime_ri = (uint32_t)ret;
 
-  // Deinterleave data and CQI in ULSCH
-  ulsch_deinterleave(q_bits,
-                     Qm,
-                     nb_q / Qm,
-                     cfg->grant.nof_symb,
-                     g_bits,
-                     q->ack_ri_bits,
-                     Q_prime_ri * Qm,
-                     q->temp_g_bits,
-                     q->ul_interleaver);
+  // Deinterleave data and CQI in ULSCH. Scrambled bits are only deinterleaved into g_bits for the CQI, the data bits
+  // are gathered from q_bits by every code block
+  const uint32_t* e_lut = NULL;
+  if (q_bits_scrambled) {
+    uint8_t* ri_present = Q_prime_ri > 0 ? q->temp_g_bits : NULL;
+    for (uint32_t i = 0; i < Q_prime_ri * Qm; i++) {
+      ri_present[q->ack_ri_bits[i].position] = 1;
+    }
+    ulsch_deinterleave_gen(nb_q / Qm, cfg->grant.nof_symb, Qm, ri_present, c_seq, q->ul_interleaver);
+    for (uint32_t i = 0; i < Q_prime_ri * Qm; i++) {
+      ri_present[q->ack_ri_bits[i].position] = 0;
+    }
+    e_lut = q->ul_interleaver;
+  } else {
+    ulsch_deinterleave(q_bits,
+                       Qm,
+                       nb_q / Qm,
+                       cfg->grant.nof_symb,
+                       g_bits,
+                       q->ack_ri_bits,
+                       Q_prime_ri * Qm,
+                       q->temp_g_bits,
+                       q->ul_interleaver);
+  }
 
   // Decode CQI (multiplexed at the front of ULSCH)
   uint32_t Q_prime_cqi = 0;
@@ -1167,14 +1534,13 @@ int srsran_ulsch_decode(srsran_sch_t*       q,
     uint32_t cqi_len = srsran_cqi_size(&cfg->uci_cfg.cqi);
     uint8_t  cqi_buff[SRSRAN_CQI_MAX_BITS];
     ZERO_OBJECT(cqi_buff);
-    ret = srsran_uci_decode_cqi_pusch(&q->uci_cqi,
-                                      cfg,
-                                      g_bits,
-                                      get_beta_cqi_offset(cfg->uci_offset.I_offset_cqi),
-                                      Q_prime_ri,
-                                      cqi_len,
-                                      cqi_buff,
-                                      &uci_data->cqi.data_crc);
+    float beta = get_beta_cqi_offset(cfg->uci_offset.I_offset_cqi);
+    if (q_bits_scrambled) {
+      uint32_t nof_cqi_bits = srsran_uci_cqi_pusch_Q_prime(cfg, cqi_len, beta, Q_prime_ri) * Qm;
+      ulsch_deinterleave_lut(q_bits, e_lut, g_bits, SRSRAN_MIN(nof_cqi_bits, nb_q - Q_prime_ri * Qm));
+    }
+    ret = srsran_uci_decode_cqi_pusch(
+        &q->uci_cqi, cfg, g_bits, beta, Q_prime_ri, cqi_len, cqi_buff, &uci_data->cqi.data_crc);
     if (ret < 0) {
       return ret;
     }
@@ -1187,11 +1553,37 @@ int srsran_ulsch_decode(srsran_sch_t*       q,
   // Decode ULSCH
   if (cb_segm.tbs > 0) {
     uint32_t G = nb_q / Qm - Q_prime_ri - Q_prime_cqi;
-    ret        = decode_tb(q, cfg->softbuffers.rx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, &g_bits[e_offset], data);
+    if (e_lut != NULL) {
+      ret = decode_tb(q, cfg->softbuffers.rx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, q_bits, &e_lut[e_offset], data);
+    } else {
+      ret = decode_tb(q, cfg->softbuffers.rx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, &g_bits[e_offset], NULL, data);
+    }
   }
   return ret;
 }
 
+int srsran_ulsch_decode(srsran_sch_t*       q,
+                        srsran_pusch_cfg_t* cfg,
+                        int16_t*            q_bits,
+                        int16_t*            g_bits,
+                        uint8_t*            c_seq,
+                        uint8_t*            data,
+                        srsran_uci_value_t* uci_data)
+{
+  return ulsch_decode(q, cfg, q_bits, g_bits, c_seq, data, uci_data, false);
+}
+
+int srsran_ulsch_decode_scrambled(srsran_sch_t*       q,
+                                  srsran_pusch_cfg_t* cfg,
+                                  int16_t*            q_bits,
+                                  int16_t*            g_bits,
+                                  uint8_t*            c_seq,
+                                  uint8_t*            data,
+                                  srsran_uci_value_t* uci_data)
+{
+  return ulsch_decode(q, cfg, q_bits, g_bits, c_seq, data, uci_data, true);
+}
+
 int srsran_ulsch_encode(srsran_sch_t*       q,
                         srsran_pusch_cfg_t* cfg,
                         uint8_t*            data,
@@ -1286,8 +1678,16 @@ int srsran_ulsch_encode(srsran_sch_t*       q,
   // Encode UL-SCH
   if (cb_segm.tbs > 0) {
     uint32_t G = nb_q / Qm - Q_prime_ri - Q_prime_cqi;
-    ret        = encode_tb_off(
-        q, cfg->softbuffers.tx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, data, &g_bits[e_offset / 8], e_offset % 8);
+    ret        = encode_tb_off(q,
+                        cfg->softbuffers.tx,
+                        &cb_segm,
+                        Qm,
+                        cfg->grant.tb.rv,
+                        G * Qm,
+                        data,
+                        &g_bits[e_offset / 8],
+                        e_offset % 8,
+                        NULL);
     if (ret) {
       return ret;
     }
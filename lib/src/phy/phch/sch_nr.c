@@ -25,13 +25,20 @@
 #include "srsran/phy/fec/ldpc/ldpc_common.h"
 #include "srsran/phy/fec/ldpc/ldpc_rm.h"
 #include "srsran/phy/phch/ra_nr.h"
+#include "srsran/phy/utils/cpu_features.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
+#include <pthread.h>
+#include <semaphore.h>
 
 #define SCH_INFO_TX(...) INFO("SCH Tx: " __VA_ARGS__)
 #define SCH_INFO_RX(...) INFO("SCH Rx: " __VA_ARGS__)
 
+static int  sch_nr_enable_cb_workers(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args);
+static void sch_nr_disable_cb_workers(srsran_sch_nr_t* q);
+static int  sch_nr_enable_pending_tbs(srsran_sch_nr_t* q);
+
 srsran_basegraph_t srsran_sch_nr_select_basegraph(uint32_t tbs, double R)
 {
   // if A ≤ 292 , or if A ≤ 3824 and R ≤ 0.67 , or if R ≤ 0 . 25 , LDPC base graph 2 is used;
@@ -91,7 +98,7 @@ static int sch_nr_cbsegm(srsran_basegraph_t bg, uint32_t tbs, srsran_cbsegm_t* c
   return SRSRAN_SUCCESS;
 }
 
-static int sch_nr_Nref(uint32_t N_rb, srsran_mcs_table_t mcs_table, uint32_t max_mimo_layers)
+static int sch_nr_Nref_calc(uint32_t N_rb, srsran_mcs_table_t mcs_table, uint32_t max_mimo_layers)
 {
   uint32_t           N_re_lbrm = SRSRAN_MAX_NRE_NR * sch_nr_n_prb_lbrm(N_rb);
   double             TCR_lbrm  = 948.0 / 1024.0;
@@ -111,6 +118,31 @@ static int sch_nr_Nref(uint32_t N_rb, srsran_mcs_table_t mcs_table, uint32_t max
   return (int)ceil((double)TBS_LRBM / (double)(cbsegm.C * R));
 }
 
+/**
+ * @brief N_ref of every number of PRB, for 256QAM and for the other MCS tables, with 4 layers. It only depends on the
+ * carrier, so it is computed once instead of for every TB
+ */
+static int            sch_nr_Nref_table[2][SRSRAN_MAX_PRB_NR + 1] = {};
+static pthread_once_t sch_nr_Nref_table_once                      = PTHREAD_ONCE_INIT;
+
+static void sch_nr_Nref_table_init(void)
+{
+  for (uint32_t N_rb = 0; N_rb <= SRSRAN_MAX_PRB_NR; N_rb++) {
+    sch_nr_Nref_table[0][N_rb] = sch_nr_Nref_calc(N_rb, srsran_mcs_table_64qam, 4);
+    sch_nr_Nref_table[1][N_rb] = sch_nr_Nref_calc(N_rb, srsran_mcs_table_256qam, 4);
+  }
+}
+
+static int sch_nr_Nref(uint32_t N_rb, srsran_mcs_table_t mcs_table, uint32_t max_mimo_layers)
+{
+  if (N_rb > SRSRAN_MAX_PRB_NR || max_mimo_layers != 4) {
+    return sch_nr_Nref_calc(N_rb, mcs_table, max_mimo_layers);
+  }
+
+  pthread_once(&sch_nr_Nref_table_once, sch_nr_Nref_table_init);
+  return sch_nr_Nref_table[mcs_table == srsran_mcs_table_256qam ? 1 : 0][N_rb];
+}
+
 int srsran_sch_nr_fill_tb_info(const srsran_carrier_nr_t* carrier,
                                const srsran_sch_cfg_t*    sch_cfg,
                                const srsran_sch_tb_t*     tb,
@@ -235,7 +267,12 @@ int srsran_sch_nr_init_tx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     encoder_type = SRSRAN_LDPC_ENCODER_AVX2;
   }
 #endif // LV_HAVE_AVX2
-#endif // LV_HAVE_AVX612
+#ifdef SRSRAN_SIMD_DISPATCH_AVX512
+  if (!args->disable_simd && srsran_cpu_has(SRSRAN_CPU_AVX512)) {
+    encoder_type = SRSRAN_LDPC_ENCODER_AVX512;
+  }
+#endif // SRSRAN_SIMD_DISPATCH_AVX512
+#endif // LV_HAVE_AVX512
 
   // Iterate over all possible lifting sizes
   for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
@@ -300,6 +337,11 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX2_FLOOD : SRSRAN_LDPC_DECODER_C_AVX2;
   }
 #endif // LV_HAVE_AVX2
+#ifdef SRSRAN_SIMD_DISPATCH_AVX512
+  if (!args->disable_simd && srsran_cpu_has(SRSRAN_CPU_AVX512)) {
+    decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX512_FLOOD : SRSRAN_LDPC_DECODER_C_AVX512;
+  }
+#endif // SRSRAN_SIMD_DISPATCH_AVX512
 #endif // LV_HAVE_AVX512
 
   // If the scaling factor is not provided use a default value that allows decoding all possible combinations of nPRB
@@ -356,6 +398,28 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     return SRSRAN_ERROR;
   }
 
+  // Open a queue of the lookaside decoder, if any. The code block workers open their own
+  if (args->accelerator != NULL && q->accelerator.ptr == NULL) {
+    if (srsran_ldpc_accelerator_open(args->accelerator, &q->accelerator) < SRSRAN_SUCCESS) {
+      ERROR("Error: opening LDPC accelerator queue");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Spawn the code block workers if requested
+  if (args->nof_cb_workers > 0 && q->cb_workers == NULL) {
+    if (sch_nr_enable_cb_workers(q, args) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // Allocate the queue of transport blocks decoded together if requested
+  if (args->defer_small_cb && q->pending_tbs == NULL) {
+    if (sch_nr_enable_pending_tbs(q) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -377,6 +441,14 @@ void srsran_sch_nr_free(srsran_sch_nr_t* q)
     return;
   }
 
+  sch_nr_disable_cb_workers(q);
+
+  if (q->pending_tbs) {
+    free(q->pending_tbs);
+  }
+
+  srsran_ldpc_accelerator_close(&q->accelerator);
+
   if (q->temp_cb) {
     free(q->temp_cb);
   }
@@ -411,7 +483,7 @@ static inline int sch_nr_encode(srsran_sch_nr_t*        q,
                                 uint8_t*                e_bits)
 {
   // Pointer protection
-  if (!q || !sch_cfg || !tb || !data || !e_bits) {
+  if (!q || !sch_cfg || !tb || !e_bits) {
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
@@ -420,8 +492,7 @@ static inline int sch_nr_encode(srsran_sch_nr_t*        q,
     return SRSRAN_ERROR;
   }
 
-  const uint8_t* input_ptr  = data;
-  uint8_t*       output_ptr = e_bits;
+  uint8_t* output_ptr = e_bits;
 
   srsran_sch_nr_tb_info_t cfg = {};
   if (srsran_sch_nr_fill_tb_info(&q->carrier, sch_cfg, tb, &cfg) < SRSRAN_SUCCESS) {
@@ -461,18 +532,37 @@ static inline int sch_nr_encode(srsran_sch_nr_t*        q,
     return SRSRAN_ERROR;
   }
 
+  // Retransmissions with a different RV only run the bit selection over the circular buffers encoded by the first
+  // transmission, regardless of the data provided
+  srsran_softbuffer_tx_t* softbuffer = tb->softbuffer.tx;
+  bool                    reuse_cb =
+      (tb->rv != 0 && softbuffer->cb_encoded != NULL && softbuffer->encoded_tbs == tb->tbs);
+  for (uint32_t r = 0; r < cfg.C && reuse_cb; r++) {
+    reuse_cb = softbuffer->cb_encoded[r];
+  }
+  if (reuse_cb) {
+    data = NULL;
+  } else if (data == NULL) {
+    ERROR("Error: no data provided and the soft-buffer does not hold the encoded transport block");
+    return SRSRAN_ERROR;
+  }
+
   // Calculate TB CRC
-  uint32_t checksum_tb = srsran_crc_checksum_byte(crc_tb, data, tb->tbs);
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-    DEBUG("tb=");
-    srsran_vec_fprint_byte(stdout, data, tb->tbs / 8);
+  uint32_t checksum_tb = 0;
+  if (data != NULL) {
+    checksum_tb = srsran_crc_checksum_byte(crc_tb, data, tb->tbs);
+    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+      DEBUG("tb=");
+      srsran_vec_fprint_byte(stdout, data, tb->tbs / 8);
+    }
   }
 
   // For each code block...
-  uint32_t j = 0;
+  const uint8_t* input_ptr = data;
+  uint32_t       j         = 0;
   for (uint32_t r = 0; r < cfg.C; r++) {
     // Select rate matching circular buffer
-    uint8_t* rm_buffer = tb->softbuffer.tx->buffer_b[r];
+    uint8_t* rm_buffer = softbuffer->buffer_b[r];
     if (rm_buffer == NULL) {
       ERROR("Error: soft-buffer provided NULL buffer for cb_idx=%d", r);
       return SRSRAN_ERROR;
@@ -518,6 +608,10 @@ static inline int sch_nr_encode(srsran_sch_nr_t*        q,
 
       // Encode code block
       srsran_ldpc_encoder_encode(encoder, q->temp_cb, rm_buffer, cfg.Kr);
+      if (softbuffer->cb_encoded != NULL) {
+        softbuffer->cb_encoded[r] = true;
+        softbuffer->encoded_tbs   = tb->tbs;
+      }
 
       if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
         DEBUG("encoded=");
@@ -551,6 +645,568 @@ static inline int sch_nr_encode(srsran_sch_nr_t*        q,
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * @brief Code blocks of a transport block pending to be decoded together
+ */
+typedef struct {
+  uint32_t      count;                                         ///< Number of pending code blocks
+  uint32_t      cb_idx[SRSRAN_LDPC_DECODER_MAX_BATCH];         ///< Code block index within the transport block
+  const int8_t* llr[SRSRAN_LDPC_DECODER_MAX_BATCH];            ///< Rate dematched LLRs
+  uint8_t*      message[SRSRAN_LDPC_DECODER_MAX_BATCH];        ///< Decoded (unpacked) code block
+  uint32_t      cdwd_rm_length[SRSRAN_LDPC_DECODER_MAX_BATCH]; ///< Number of LLRs after rate dematching
+  int           nof_iter[SRSRAN_LDPC_DECODER_MAX_BATCH];       ///< Decoder iterations, 0 if CRC did not match
+} sch_nr_cb_batch_t;
+
+/**
+ * @brief Get the 8-bit soft bits of a code block from a receive soft-buffer
+ * @note Soft-buffers initialised with 16-bit storage are reused as 8-bit storage
+ */
+static inline int8_t* sch_nr_rx_cb_buffer(const srsran_softbuffer_rx_t* softbuffer, uint32_t r)
+{
+  if (softbuffer->buffer_c != NULL) {
+    return softbuffer->buffer_c[r];
+  }
+  return (softbuffer->buffer_f != NULL) ? (int8_t*)softbuffer->buffer_f[r] : NULL;
+}
+
+/**
+ * @brief Decodes a batch of code blocks with the lookaside accelerator of q
+ * @return SRSRAN_SUCCESS if all the code blocks were decoded, SRSRAN_ERROR otherwise
+ */
+static int sch_nr_decode_cb_batch_accelerator(srsran_sch_nr_t*               q,
+                                              const srsran_sch_nr_tb_info_t* cfg,
+                                              srsran_crc_t*                  crc,
+                                              sch_nr_cb_batch_t*             batch)
+{
+  srsran_ldpc_accelerator_op_t ops[SRSRAN_LDPC_DECODER_MAX_BATCH] = {};
+  for (uint32_t i = 0; i < batch->count; i++) {
+    ops[i].bg             = cfg->bg;
+    ops[i].ls             = (uint16_t)cfg->Z;
+    ops[i].llr            = batch->llr[i];
+    ops[i].cdwd_rm_length = batch->cdwd_rm_length[i];
+    ops[i].crc            = crc;
+    ops[i].message        = batch->message[i];
+  }
+
+  if (srsran_ldpc_accelerator_decode(&q->accelerator, ops, batch->count) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < batch->count; i++) {
+    batch->nof_iter[i] = ops[i].nof_iter;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Stores the result of a decoded code block in the soft-buffer of its transport block
+ */
+static void sch_nr_decode_cb_result(const srsran_ldpc_decoder_t*   decoder,
+                                    const srsran_sch_nr_tb_info_t* cfg,
+                                    const srsran_sch_tb_t*         tb,
+                                    uint32_t                       r,
+                                    uint8_t*                       message,
+                                    int                            ret,
+                                    uint32_t*                      nof_iter_sum,
+                                    uint32_t*                      cb_ok)
+{
+  // Compute number of iterations
+  uint32_t n_iter_cb = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
+  *nof_iter_sum += n_iter_cb;
+
+  // Check if CB is all zeros
+  uint32_t cb_len = cfg->Kp - cfg->L_cb;
+
+  tb->softbuffer.rx->cb_crc[r] = (ret != 0);
+  SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg->C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
+
+  // CB Debug trace
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+    DEBUG("CB %d/%d:", r, cfg->C);
+    srsran_vec_fprint_hex(stdout, message, cb_len);
+  }
+
+  // Pack and count CRC OK only if CRC is match
+  if (tb->softbuffer.rx->cb_crc[r]) {
+    srsran_bit_pack_vector(message, tb->softbuffer.rx->data[r], cb_len);
+    (*cb_ok)++;
+  }
+}
+
+static int sch_nr_decode_cb_batch(srsran_sch_nr_t*               q,
+                                  srsran_ldpc_decoder_t*         decoder,
+                                  const srsran_sch_nr_tb_info_t* cfg,
+                                  const srsran_sch_tb_t*         tb,
+                                  srsran_crc_t*                  crc,
+                                  sch_nr_cb_batch_t*             batch,
+                                  uint32_t*                      nof_iter_sum,
+                                  uint32_t*                      cb_ok)
+{
+  if (batch->count == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Decode with the accelerator, or in the CPU if there is none or it fails. If CRC=KO, then nof_iter=0
+  bool decoded = false;
+  if (q->accelerator.ptr != NULL) {
+    decoded = (sch_nr_decode_cb_batch_accelerator(q, cfg, crc, batch) == SRSRAN_SUCCESS);
+    if (!decoded) {
+      ERROR("Error decoding CB with the LDPC accelerator, falling back to the CPU decoder");
+    }
+  }
+  if (!decoded && srsran_ldpc_decoder_decode_batch(decoder,
+                                                   batch->llr,
+                                                   batch->message,
+                                                   batch->cdwd_rm_length,
+                                                   crc,
+                                                   batch->nof_iter,
+                                                   batch->count) < SRSRAN_SUCCESS) {
+    ERROR("Error decoding CB");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < batch->count; i++) {
+    sch_nr_decode_cb_result(
+        decoder, cfg, tb, batch->cb_idx[i], batch->message[i], batch->nof_iter[i], nof_iter_sum, cb_ok);
+  }
+
+  batch->count = 0;
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Code block of a transport block pending to be rate dematched and decoded
+ */
+typedef struct {
+  uint32_t r;      ///< Code block index within the transport block
+  int8_t*  e_bits; ///< Rate matched LLRs of the code block
+  uint32_t E;      ///< Number of rate matched LLRs
+} sch_nr_cb_job_t;
+
+/**
+ * @brief Transport block being decoded, shared by the calling thread and the code block workers
+ */
+typedef struct {
+  const srsran_sch_nr_tb_info_t* cfg;
+  const srsran_sch_tb_t*         tb;
+  const sch_nr_cb_job_t*         cbs;
+  uint32_t                       nof_cbs;
+} sch_nr_tb_job_t;
+
+/**
+ * @brief Rate dematches and decodes the pending code blocks first, first + step, ... of a transport block. It only uses
+ * the decoders, rate matcher, CRC and temporal buffer of q, so it can run concurrently with other SCH objects for
+ * different code blocks of the same transport block.
+ */
+static int sch_nr_decode_cb_range(srsran_sch_nr_t*       q,
+                                  const sch_nr_tb_job_t* job,
+                                  uint32_t               first,
+                                  uint32_t               step,
+                                  uint32_t*              nof_iter_sum,
+                                  uint32_t*              cb_ok)
+{
+  const srsran_sch_nr_tb_info_t* cfg = job->cfg;
+  const srsran_sch_tb_t*         tb  = job->tb;
+
+  srsran_ldpc_decoder_t* decoder = (cfg->bg == BG1) ? q->decoder_bg1[cfg->Z] : q->decoder_bg2[cfg->Z];
+
+  // Select CB or TB early stop CRC
+  srsran_crc_t* crc = (cfg->L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
+  if (cfg->L_cb) {
+    crc = &q->crc_cb;
+  }
+
+  // Code blocks waiting to be decoded together. The accelerator takes batches of any size that fit in the temporal
+  // buffer, the CPU decoder those it interleaves in its SIMD lanes
+  sch_nr_cb_batch_t batch      = {};
+  uint32_t          batch_size = SRSRAN_MAX(decoder->batch_size, 1);
+  if (q->accelerator.ptr != NULL) {
+    batch_size = SRSRAN_MIN(SRSRAN_LDPC_DECODER_MAX_BATCH, (SRSRAN_LDPC_MAX_LEN_CB * 8) / decoder->liftK);
+  }
+
+  for (uint32_t i = first; i < job->nof_cbs; i += step) {
+    uint32_t r         = job->cbs[i].r;
+    uint32_t E         = job->cbs[i].E;
+    int8_t*  rm_buffer = sch_nr_rx_cb_buffer(tb->softbuffer.rx, r);
+
+    // LDPC Rate matching
+    SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
+                r,
+                E,
+                cfg->F,
+                cfg->bg == BG1 ? 1 : 2,
+                cfg->Z,
+                tb->rv,
+                cfg->Qm,
+                cfg->Nref);
+    int n_llr = srsran_ldpc_rm_rx_c(
+        &q->rx_rm, job->cbs[i].e_bits, rm_buffer, E, cfg->F, cfg->bg, cfg->Z, tb->rv, tb->mod, cfg->Nref);
+    if (n_llr < SRSRAN_SUCCESS) {
+      ERROR("Error in LDPC rate mateching");
+      return SRSRAN_ERROR;
+    }
+
+    // Queue the CB, the decoded messages of a batch are stored one after the other in the temporal buffer
+    batch.cb_idx[batch.count]         = r;
+    batch.llr[batch.count]            = rm_buffer;
+    batch.message[batch.count]        = q->temp_cb + batch.count * decoder->liftK;
+    batch.cdwd_rm_length[batch.count] = (uint32_t)n_llr;
+    batch.count++;
+
+    // Decode as soon as the batch is full
+    if (batch.count == batch_size) {
+      if (sch_nr_decode_cb_batch(q, decoder, cfg, tb, crc, &batch, nof_iter_sum, cb_ok) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  // Decode the remaining CBs
+  return sch_nr_decode_cb_batch(q, decoder, cfg, tb, crc, &batch, nof_iter_sum, cb_ok);
+}
+
+typedef struct {
+  /* Thread identifier: they must set before thread creation */
+  pthread_t pthread;
+  uint32_t  worker_idx;
+  void*     pool;
+
+  /* Decoder instances owned by this worker */
+  srsran_sch_nr_t sch;
+
+  /* Execution status */
+  int      ret;
+  uint32_t nof_iter_sum;
+  uint32_t cb_ok;
+
+  /* Semaphores */
+  sem_t start;
+  sem_t finish;
+
+  /* Thread flags */
+  bool started;
+  bool quit;
+} sch_nr_cb_worker_t;
+
+typedef struct {
+  uint32_t            nof_workers;
+  sch_nr_cb_worker_t* workers;
+
+  /* Current job: it must be set before posting start semaphores */
+  sch_nr_tb_job_t job;
+} sch_nr_cb_pool_t;
+
+static void* sch_nr_cb_worker_thread(void* arg)
+{
+  sch_nr_cb_worker_t* w    = (sch_nr_cb_worker_t*)arg;
+  sch_nr_cb_pool_t*   pool = (sch_nr_cb_pool_t*)w->pool;
+
+  sem_wait(&w->start);
+  while (!w->quit) {
+    // The calling thread takes the first code block, worker i takes i + 1
+    w->nof_iter_sum = 0;
+    w->cb_ok        = 0;
+    w->ret          = sch_nr_decode_cb_range(
+        &w->sch, &pool->job, w->worker_idx + 1, pool->nof_workers + 1, &w->nof_iter_sum, &w->cb_ok);
+
+    /* Post finish semaphore */
+    sem_post(&w->finish);
+
+    /* Wait for next loop */
+    sem_wait(&w->start);
+  }
+  sem_post(&w->finish);
+
+  pthread_exit(NULL);
+  return w;
+}
+
+static void sch_nr_disable_cb_workers(srsran_sch_nr_t* q)
+{
+  sch_nr_cb_pool_t* pool = (sch_nr_cb_pool_t*)q->cb_workers;
+  if (pool == NULL) {
+    return;
+  }
+
+  if (pool->workers) {
+    for (uint32_t i = 0; i < pool->nof_workers; i++) {
+      sch_nr_cb_worker_t* w = &pool->workers[i];
+      if (w->started) {
+        /* Stop threads */
+        w->quit = true;
+        sem_post(&w->start);
+        pthread_join(w->pthread, NULL);
+      }
+      sem_destroy(&w->start);
+      sem_destroy(&w->finish);
+      srsran_sch_nr_free(&w->sch);
+    }
+    free(pool->workers);
+  }
+
+  free(pool);
+  q->cb_workers = NULL;
+}
+
+static int sch_nr_enable_cb_workers(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
+{
+  sch_nr_cb_pool_t* pool = calloc(sizeof(sch_nr_cb_pool_t), 1);
+  if (!pool) {
+    ERROR("Allocating code block worker pool");
+    return SRSRAN_ERROR;
+  }
+  q->cb_workers = pool;
+
+  pool->workers = calloc(sizeof(sch_nr_cb_worker_t), args->nof_cb_workers);
+  if (!pool->workers) {
+    ERROR("Allocating code block workers");
+    goto clean;
+  }
+  pool->nof_workers = args->nof_cb_workers;
+
+  // The workers decode with their own SCH objects, without workers or deferred transport blocks of their own
+  srsran_sch_nr_args_t worker_args = *args;
+  worker_args.nof_cb_workers       = 0;
+  worker_args.defer_small_cb       = false;
+
+  for (uint32_t i = 0; i < pool->nof_workers; i++) {
+    sch_nr_cb_worker_t* w = &pool->workers[i];
+    w->worker_idx         = i;
+    w->pool               = pool;
+
+    if (srsran_sch_nr_init_rx(&w->sch, &worker_args) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating code block worker SCH");
+      goto clean;
+    }
+    if (sem_init(&w->start, 0, 0) || sem_init(&w->finish, 0, 0)) {
+      ERROR("Creating semaphore");
+      goto clean;
+    }
+    if (pthread_create(&w->pthread, NULL, sch_nr_cb_worker_thread, (void*)w)) {
+      ERROR("Creating code block worker thread");
+      goto clean;
+    }
+    w->started = true;
+  }
+
+  return SRSRAN_SUCCESS;
+
+clean:
+  sch_nr_disable_cb_workers(q);
+  return SRSRAN_ERROR;
+}
+
+/**
+ * @brief Joins the code blocks of a transport block once all of them are decoded, and checks the transport block CRC
+ */
+static int sch_nr_decode_tb_union(srsran_sch_nr_t*               q,
+                                  const srsran_sch_nr_tb_info_t* cfg,
+                                  const srsran_sch_tb_t*         tb,
+                                  srsran_sch_tb_res_nr_t*        res,
+                                  uint32_t                       nof_iter_sum,
+                                  uint32_t                       cb_ok)
+{
+  srsran_crc_t* crc_tb = (cfg->L_tb == 24) ? &q->crc_tb_24 : &q->crc_tb_16;
+
+  // Set average number of iterations
+  res->avg_iter = (float)nof_iter_sum / (float)cfg->C;
+
+  // Set average number of iterations
+  if (cfg->C > 0) {
+    res->avg_iter = (float)nof_iter_sum / (float)cfg->C;
+  } else {
+    res->avg_iter = NAN;
+  }
+
+  // Not all CB are decoded, skip TB union and CRC check
+  if (cb_ok != cfg->C) {
+    return SRSRAN_SUCCESS;
+  }
+
+  uint32_t checksum2  = 0;
+  uint8_t* output_ptr = res->payload;
+
+  for (uint32_t r = 0; r < cfg->C; r++) {
+    uint32_t cb_len = cfg->Kp - cfg->L_cb;
+
+    // Subtract TB CRC from the last code block
+    if (r == cfg->C - 1) {
+      cb_len -= cfg->L_tb;
+    }
+
+    // Append CB
+    srsran_vec_u8_copy(output_ptr, tb->softbuffer.rx->data[r], cb_len / 8);
+    output_ptr += cb_len / 8;
+
+    // Compute TB CRC for last block
+    if (cfg->C > 1 && r == cfg->C - 1) {
+      uint8_t  tb_crc_unpacked[24] = {};
+      uint8_t* tb_crc_unpacked_ptr = tb_crc_unpacked;
+      srsran_bit_unpack_vector(&tb->softbuffer.rx->data[r][cb_len / 8], tb_crc_unpacked, cfg->L_tb);
+      checksum2 = srsran_bit_pack(&tb_crc_unpacked_ptr, cfg->L_tb);
+    }
+  }
+
+  // Calculate TB CRC from packed data
+  if (cfg->C == 1) {
+    SCH_INFO_RX("TB: TBS=%d; CRC=%s", tb->tbs, tb->softbuffer.rx->cb_crc[0] ? "OK" : "KO");
+    res->crc = true;
+  } else {
+    // More than one
+    uint32_t checksum1 = srsran_crc_checksum_byte(crc_tb, res->payload, tb->tbs);
+    res->crc           = (checksum1 == checksum2);
+    SCH_INFO_RX("TB: TBS=%d; CRC={%06x, %06x}", tb->tbs, checksum1, checksum2);
+  }
+
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+    DEBUG("Decode: ");
+    srsran_vec_fprint_byte(stdout, res->payload, tb->tbs / 8);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Transport block of a single code block, pending to be decoded together with the code blocks of other transport
+ * blocks with the same base graph, lifting size and CRC
+ */
+typedef struct {
+  srsran_sch_nr_tb_info_t cfg;
+  srsran_sch_tb_t         tb;
+  srsran_sch_tb_res_nr_t* res;
+  const int8_t*           llr;     ///< Rate dematched LLRs, stored in the soft-buffer
+  uint32_t                nof_llr; ///< Number of LLRs after rate dematching
+} sch_nr_pending_tb_t;
+
+#define SCH_NR_MAX_PENDING_TB 64
+
+typedef struct {
+  uint32_t            count;
+  sch_nr_pending_tb_t tbs[SCH_NR_MAX_PENDING_TB];
+} sch_nr_pending_tbs_t;
+
+static int sch_nr_enable_pending_tbs(srsran_sch_nr_t* q)
+{
+  q->pending_tbs = calloc(sizeof(sch_nr_pending_tbs_t), 1);
+  if (!q->pending_tbs) {
+    ERROR("Allocating pending transport blocks");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Rate dematches the only code block of a transport block and queues it until srsran_sch_nr_decode_flush()
+ */
+static int sch_nr_decode_defer(srsran_sch_nr_t*               q,
+                               const srsran_sch_nr_tb_info_t* cfg,
+                               const srsran_sch_tb_t*         tb,
+                               const sch_nr_cb_job_t*         cb,
+                               srsran_sch_tb_res_nr_t*        res)
+{
+  sch_nr_pending_tbs_t* pending = (sch_nr_pending_tbs_t*)q->pending_tbs;
+
+  // Make room by decoding the queued transport blocks
+  if (pending->count == SCH_NR_MAX_PENDING_TB && srsran_sch_nr_decode_flush(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // LDPC Rate matching
+  int8_t* rm_buffer = sch_nr_rx_cb_buffer(tb->softbuffer.rx, cb->r);
+  SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
+              cb->r,
+              cb->E,
+              cfg->F,
+              cfg->bg == BG1 ? 1 : 2,
+              cfg->Z,
+              tb->rv,
+              cfg->Qm,
+              cfg->Nref);
+  int n_llr =
+      srsran_ldpc_rm_rx_c(&q->rx_rm, cb->e_bits, rm_buffer, cb->E, cfg->F, cfg->bg, cfg->Z, tb->rv, tb->mod, cfg->Nref);
+  if (n_llr < SRSRAN_SUCCESS) {
+    ERROR("Error in LDPC rate mateching");
+    return SRSRAN_ERROR;
+  }
+
+  sch_nr_pending_tb_t* p = &pending->tbs[pending->count];
+  p->cfg                 = *cfg;
+  p->tb                  = *tb;
+  p->res                 = res;
+  p->llr                 = rm_buffer;
+  p->nof_llr             = (uint32_t)n_llr;
+  pending->count++;
+
+  // The number of iterations is only known once decoded
+  res->avg_iter = NAN;
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_sch_nr_decode_flush(srsran_sch_nr_t* q)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  sch_nr_pending_tbs_t* pending = (sch_nr_pending_tbs_t*)q->pending_tbs;
+  if (pending == NULL) {
+    return SRSRAN_SUCCESS;
+  }
+
+  int  ret                         = SRSRAN_SUCCESS;
+  bool done[SCH_NR_MAX_PENDING_TB] = {};
+  for (uint32_t i = 0; i < pending->count; i++) {
+    if (done[i]) {
+      continue;
+    }
+
+    const srsran_sch_nr_tb_info_t* cfg     = &pending->tbs[i].cfg;
+    srsran_ldpc_decoder_t*         decoder = (cfg->bg == BG1) ? q->decoder_bg1[cfg->Z] : q->decoder_bg2[cfg->Z];
+    srsran_crc_t*                  crc     = (cfg->L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
+
+    // Gather the code blocks of this and the following transport blocks that share the decoder and the CRC
+    sch_nr_cb_batch_t batch = {};
+    for (uint32_t k = i; k < pending->count && batch.count < decoder->batch_size; k++) {
+      const srsran_sch_nr_tb_info_t* cfg_k = &pending->tbs[k].cfg;
+      if (done[k] || cfg_k->bg != cfg->bg || cfg_k->Z != cfg->Z || cfg_k->L_tb != cfg->L_tb) {
+        continue;
+      }
+      batch.cb_idx[batch.count]         = k;
+      batch.llr[batch.count]            = pending->tbs[k].llr;
+      batch.message[batch.count]        = q->temp_cb + batch.count * decoder->liftK;
+      batch.cdwd_rm_length[batch.count] = pending->tbs[k].nof_llr;
+      batch.count++;
+      done[k] = true;
+    }
+
+    // Decode. if CRC=KO, then nof_iter=0
+    if (srsran_ldpc_decoder_decode_batch(
+            decoder, batch.llr, batch.message, batch.cdwd_rm_length, crc, batch.nof_iter, batch.count) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error decoding CB");
+      ret = SRSRAN_ERROR;
+      continue;
+    }
+
+    for (uint32_t b = 0; b < batch.count; b++) {
+      sch_nr_pending_tb_t* p            = &pending->tbs[batch.cb_idx[b]];
+      uint32_t             nof_iter_sum = 0;
+      uint32_t             cb_ok        = 0;
+      sch_nr_decode_cb_result(decoder, &p->cfg, &p->tb, 0, batch.message[b], batch.nof_iter[b], &nof_iter_sum, &cb_ok);
+      if (sch_nr_decode_tb_union(q, &p->cfg, &p->tb, p->res, nof_iter_sum, cb_ok) < SRSRAN_SUCCESS) {
+        ret = SRSRAN_ERROR;
+      }
+    }
+  }
+  pending->count = 0;
+
+  return ret;
+}
+
 static int sch_nr_decode(srsran_sch_nr_t*        q,
                          const srsran_sch_cfg_t* sch_cfg,
                          const srsran_sch_tb_t*  tb,
@@ -607,12 +1263,15 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
   uint32_t cb_ok = 0;
   res->crc       = false;
 
+  // Code blocks that need to be decoded
+  sch_nr_cb_job_t cbs[SRSRAN_SCH_NR_MAX_NOF_CB_LDPC];
+  uint32_t        nof_cbs = 0;
+
   // For each code block...
   uint32_t j = 0;
   for (uint32_t r = 0; r < cfg.C; r++) {
-    bool    decoded   = tb->softbuffer.rx->cb_crc[r];
-    int8_t* rm_buffer = (int8_t*)tb->softbuffer.tx->buffer_b[r];
-    if (!rm_buffer) {
+    bool decoded = tb->softbuffer.rx->cb_crc[r];
+    if (!sch_nr_rx_cb_buffer(tb->softbuffer.rx, r)) {
       ERROR("Error: soft-buffer provided NULL buffer for cb_idx=%d", r);
       return SRSRAN_ERROR;
     }
@@ -637,116 +1296,53 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
       continue;
     }
 
-    // LDPC Rate matching
-    SCH_INFO_RX("RM CB %d: E=%d; F=%d; BG=%d; Z=%d; RV=%d; Qm=%d; Nref=%d;",
-                r,
-                E,
-                cfg.F,
-                cfg.bg == BG1 ? 1 : 2,
-                cfg.Z,
-                tb->rv,
-                cfg.Qm,
-                cfg.Nref);
-    int n_llr =
-        srsran_ldpc_rm_rx_c(&q->rx_rm, input_ptr, rm_buffer, E, cfg.F, cfg.bg, cfg.Z, tb->rv, tb->mod, cfg.Nref);
-    if (n_llr < SRSRAN_SUCCESS) {
-      ERROR("Error in LDPC rate mateching");
-      return SRSRAN_ERROR;
-    }
-
-    // Select CB or TB early stop CRC
-    srsran_crc_t* crc = (cfg.L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
-    if (cfg.L_cb) {
-      crc = &q->crc_cb;
-    }
-
-    // Decode. if CRC=KO, then ret=0
-    int ret = srsran_ldpc_decoder_decode_crc_c(decoder, rm_buffer, q->temp_cb, n_llr, crc);
-    if (ret < SRSRAN_SUCCESS) {
-      ERROR("Error decoding CB");
-      return SRSRAN_ERROR;
-    }
-
-    // Compute number of iterations
-    uint32_t n_iter_cb = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
-    nof_iter_sum += n_iter_cb;
-
-    // Check if CB is all zeros
-    uint32_t cb_len = cfg.Kp - cfg.L_cb;
-
-    tb->softbuffer.rx->cb_crc[r] = (ret != 0);
-    SCH_INFO_RX("CB %d/%d iter=%d CRC=%s", r, cfg.C, n_iter_cb, tb->softbuffer.rx->cb_crc[r] ? "OK" : "KO");
-
-    // CB Debug trace
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-      DEBUG("CB %d/%d:", r, cfg.C);
-      srsran_vec_fprint_hex(stdout, q->temp_cb, cb_len);
-    }
-
-    // Pack and count CRC OK only if CRC is match
-    if (tb->softbuffer.rx->cb_crc[r]) {
-      srsran_bit_pack_vector(q->temp_cb, tb->softbuffer.rx->data[r], cb_len);
-      cb_ok++;
-    }
+    cbs[nof_cbs].r      = r;
+    cbs[nof_cbs].e_bits = input_ptr;
+    cbs[nof_cbs].E      = E;
+    nof_cbs++;
 
     input_ptr += E;
   }
-  // Set average number of iterations
-  res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
 
-  // Set average number of iterations
-  if (cfg.C > 0) {
-    res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
-  } else {
-    res->avg_iter = NAN;
+  // A transport block of a single small code block is decoded at srsran_sch_nr_decode_flush(), in the SIMD lanes of the
+  // batch decoder together with the code blocks of other transport blocks
+  if (q->pending_tbs != NULL && q->accelerator.ptr == NULL && cfg.C == 1 && nof_cbs == 1 && decoder->batch_size > 1) {
+    return sch_nr_decode_defer(q, &cfg, tb, &cbs[0], res);
   }
 
-  // Not all CB are decoded, skip TB union and CRC check
-  if (cb_ok != cfg.C) {
-    return SRSRAN_SUCCESS;
-  }
+  sch_nr_tb_job_t job = {&cfg, tb, cbs, nof_cbs};
 
-  uint32_t checksum2  = 0;
-  uint8_t* output_ptr = res->payload;
-
-  for (uint32_t r = 0; r < cfg.C; r++) {
-    uint32_t cb_len = cfg.Kp - cfg.L_cb;
-
-    // Subtract TB CRC from the last code block
-    if (r == cfg.C - 1) {
-      cb_len -= cfg.L_tb;
+  sch_nr_cb_pool_t* pool = (sch_nr_cb_pool_t*)q->cb_workers;
+  if (pool != NULL && nof_cbs > 1) {
+    // Distribute the code blocks among the workers and the calling thread
+    pool->job          = job;
+    uint32_t nof_going = SRSRAN_MIN(pool->nof_workers, nof_cbs - 1);
+    for (uint32_t i = 0; i < nof_going; i++) {
+      sem_post(&pool->workers[i].start);
     }
 
-    // Append CB
-    srsran_vec_u8_copy(output_ptr, tb->softbuffer.rx->data[r], cb_len / 8);
-    output_ptr += cb_len / 8;
+    int ret = sch_nr_decode_cb_range(q, &job, 0, pool->nof_workers + 1, &nof_iter_sum, &cb_ok);
 
-    // Compute TB CRC for last block
-    if (cfg.C > 1 && r == cfg.C - 1) {
-      uint8_t  tb_crc_unpacked[24] = {};
-      uint8_t* tb_crc_unpacked_ptr = tb_crc_unpacked;
-      srsran_bit_unpack_vector(&tb->softbuffer.rx->data[r][cb_len / 8], tb_crc_unpacked, cfg.L_tb);
-      checksum2 = srsran_bit_pack(&tb_crc_unpacked_ptr, cfg.L_tb);
+    for (uint32_t i = 0; i < nof_going; i++) {
+      sch_nr_cb_worker_t* w = &pool->workers[i];
+      sem_wait(&w->finish);
+      if (w->ret < SRSRAN_SUCCESS) {
+        ret = SRSRAN_ERROR;
+      }
+      nof_iter_sum += w->nof_iter_sum;
+      cb_ok += w->cb_ok;
     }
-  }
 
-  // Calculate TB CRC from packed data
-  if (cfg.C == 1) {
-    SCH_INFO_RX("TB: TBS=%d; CRC=%s", tb->tbs, tb->softbuffer.rx->cb_crc[0] ? "OK" : "KO");
-    res->crc = true;
+    if (ret < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
   } else {
-    // More than one
-    uint32_t checksum1 = srsran_crc_checksum_byte(crc_tb, res->payload, tb->tbs);
-    res->crc           = (checksum1 == checksum2);
-    SCH_INFO_RX("TB: TBS=%d; CRC={%06x, %06x}", tb->tbs, checksum1, checksum2);
-  }
-
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-    DEBUG("Decode: ");
-    srsran_vec_fprint_byte(stdout, res->payload, tb->tbs / 8);
+    if (sch_nr_decode_cb_range(q, &job, 0, 1, &nof_iter_sum, &cb_ok) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
   }
 
-  return SRSRAN_SUCCESS;
+  return sch_nr_decode_tb_union(q, &cfg, tb, res, nof_iter_sum, cb_ok);
 }
 
 int srsran_dlsch_nr_encode(srsran_sch_nr_t*        q,
@@ -26,9 +26,10 @@
 
 static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
 
-static uint16_t rnti        = 0x1234;
-static bool     fast_sweep  = true;
-static bool     interleaved = false;
+static uint16_t rnti            = 0x1234;
+static bool     fast_sweep      = true;
+static bool     interleaved     = false;
+static uint32_t polar_list_size = 0;
 
 typedef struct {
   uint64_t time_us;
@@ -65,6 +66,23 @@ static int test(srsran_pdcch_nr_t*      tx,
   TESTASSERT(res.evm < 0.01f);
   TESTASSERT(res.crc);
 
+  // Decode the candidate LLR twice in a batch, as the UE blind search does
+  int8_t llr[2 * SRSRAN_PDCCH_MAX_RE];
+  float  evm = NAN;
+  TESTASSERT(srsran_pdcch_nr_demodulate(rx, grid, ce, &dci_msg_tx->ctx.location, llr, &evm) == SRSRAN_SUCCESS);
+
+  const int8_t*         llr_batch[2]     = {llr, llr};
+  srsran_dci_msg_nr_t   dci_msg_batch[2] = {*dci_msg_tx, *dci_msg_tx};
+  srsran_pdcch_nr_res_t res_batch[2]     = {};
+  srsran_vec_u8_zero(dci_msg_batch[0].payload, dci_msg_tx->nof_bits);
+  srsran_vec_u8_zero(dci_msg_batch[1].payload, dci_msg_tx->nof_bits);
+  TESTASSERT(srsran_pdcch_nr_decode_llr_batch(rx, llr_batch, dci_msg_batch, res_batch, 2) == SRSRAN_SUCCESS);
+
+  for (uint32_t i = 0; i < 2; i++) {
+    TESTASSERT(res_batch[i].crc);
+    TESTASSERT(memcmp(dci_msg_batch[i].payload, dci_msg_tx->payload, dci_msg_tx->nof_bits) == 0);
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -74,13 +92,14 @@ static void usage(char* prog)
   printf("\t-p Number of carrier PRB [Default %d]\n", carrier.nof_prb);
   printf("\t-F Fast CORESET frequency resource sweeping [Default %s]\n", fast_sweep ? "Enabled" : "Disabled");
   printf("\t-I Enable interleaved CCE-to-REG [Default %s]\n", interleaved ? "Enabled" : "Disabled");
+  printf("\t-L Polar SC-list size, 0 for SC decoding [Default %d]\n", polar_list_size);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 static int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "pFIv")) != -1) {
+  while ((opt = getopt(argc, argv, "pFIL:v")) != -1) {
     switch (opt) {
       case 'p':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -91,6 +110,9 @@ static int parse_args(int argc, char** argv)
       case 'I':
         interleaved ^= true;
         break;
+      case 'L':
+        polar_list_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -111,6 +133,7 @@ int main(int argc, char** argv)
   args.disable_simd           = false;
   args.measure_evm            = true;
   args.measure_time           = true;
+  args.polar_list_size        = polar_list_size;
 
   srsran_pdcch_nr_t pdcch_tx = {};
   srsran_pdcch_nr_t pdcch_rx = {};
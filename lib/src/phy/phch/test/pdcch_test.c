@@ -347,6 +347,72 @@ static int test_case1()
   return SRSRAN_SUCCESS;
 }
 
+// Encodes the DCIs of every candidate location, one by one and in a batch, and checks that both grids match
+static int test_case2()
+{
+  uint32_t nof_re                          = SRSRAN_NOF_RE(pdcch_tx.cell);
+  cf_t*    batch_symbols[SRSRAN_MAX_PORTS] = {};
+  int      ret                             = SRSRAN_ERROR;
+
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    batch_symbols[p] = srsran_vec_cf_malloc(nof_re);
+    if (batch_symbols[p] == NULL) {
+      goto clean;
+    }
+  }
+
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    srsran_dl_sf_cfg_t dl_sf_cfg = {};
+    dl_sf_cfg.cfi                = cfi;
+    dl_sf_cfg.tti                = sf_idx;
+
+    srsran_dci_location_t locations[SRSRAN_MAX_CANDIDATES] = {};
+    uint32_t              locations_count                  = 0;
+    locations_count +=
+        srsran_pdcch_common_locations(&pdcch_tx, &locations[locations_count], SRSRAN_MAX_CANDIDATES_COM, cfi);
+    locations_count +=
+        srsran_pdcch_ue_locations(&pdcch_tx, &dl_sf_cfg, &locations[locations_count], SRSRAN_MAX_CANDIDATES_UE, rnti);
+
+    // The candidates overlap, the later messages overwrite the earlier ones in both cases
+    srsran_dci_msg_t dci_tx[SRSRAN_MAX_CANDIDATES] = {};
+    for (uint32_t loc = 0; loc < locations_count; loc++) {
+      dci_tx[loc].format   = SRSRAN_DCI_FORMAT1A;
+      dci_tx[loc].nof_bits = srsran_dci_format_sizeof(&pdcch_tx.cell, &dl_sf_cfg, &dci_cfg, SRSRAN_DCI_FORMAT1A);
+      dci_tx[loc].location = locations[loc];
+      dci_tx[loc].rnti     = (uint16_t)(rnti + loc);
+      srsran_random_bit_vector(random_gen, dci_tx[loc].payload, dci_tx[loc].nof_bits);
+    }
+
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      srsran_vec_cf_zero(slot_symbols[p], nof_re);
+      srsran_vec_cf_zero(batch_symbols[p], nof_re);
+    }
+    for (uint32_t loc = 0; loc < locations_count; loc++) {
+      // The payload is modified by the CRC attachment, so each encoder gets its own copy
+      srsran_dci_msg_t dci = dci_tx[loc];
+      TESTASSERT(srsran_pdcch_encode(&pdcch_tx, &dl_sf_cfg, &dci, slot_symbols) == SRSRAN_SUCCESS);
+    }
+    TESTASSERT(srsran_pdcch_encode_batch(&pdcch_tx, &dl_sf_cfg, dci_tx, locations_count, batch_symbols) ==
+               SRSRAN_SUCCESS);
+
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      for (uint32_t i = 0; i < nof_re; i++) {
+        TESTASSERT(cabsf(slot_symbols[p][i] - batch_symbols[p][i]) < 1e-5f);
+      }
+    }
+  }
+  printf("test_case_2 - passed\n");
+  ret = SRSRAN_SUCCESS;
+
+clean:
+  for (uint32_t p = 0; p < nof_ports; p++) {
+    if (batch_symbols[p]) {
+      free(batch_symbols[p]);
+    }
+  }
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   srsran_regs_t regs = {};
@@ -416,6 +482,11 @@ int main(int argc, char** argv)
     goto quit;
   }
 
+  if (test_case2() < SRSRAN_SUCCESS) {
+    ERROR("Test case 2 failed");
+    goto quit;
+  }
+
   ret = SRSRAN_SUCCESS;
 
 quit:
@@ -98,16 +98,20 @@ void parse_args(int argc, char** argv)
 
 int main(int argc, char** argv)
 {
-  srsran_phich_t  phich;
-  srsran_regs_t   regs;
-  int             i, j;
-  int             nof_re;
-  cf_t*           slot_symbols[SRSRAN_MAX_PORTS];
-  uint8_t         ack[50][SRSRAN_PHICH_NORM_NSEQUENCES];
-  uint32_t        nsf;
-  int             cid, max_cid;
-  uint32_t        ngroup, nseq, max_nseq;
-  srsran_random_t random_gen = srsran_random_init(0x1234);
+  srsran_phich_t          phich;
+  srsran_regs_t           regs;
+  int                     i, j;
+  int                     nof_re;
+  cf_t*                   slot_symbols[SRSRAN_MAX_PORTS];
+  cf_t*                   batch_symbols[SRSRAN_MAX_PORTS];
+  uint8_t                 ack[50][SRSRAN_PHICH_NORM_NSEQUENCES];
+  uint8_t                 batch_acks[50 * SRSRAN_PHICH_NORM_NSEQUENCES];
+  uint32_t                nof_batch_acks;
+  srsran_phich_resource_t batch_resources[50 * SRSRAN_PHICH_NORM_NSEQUENCES];
+  uint32_t                nsf;
+  int                     cid, max_cid;
+  uint32_t                ngroup, nseq, max_nseq;
+  srsran_random_t         random_gen = srsran_random_init(0x1234);
 
   parse_args(argc, argv);
 
@@ -122,8 +126,9 @@ int main(int argc, char** argv)
   srsran_chest_dl_res_set_ones(&chest_res);
 
   for (i = 0; i < SRSRAN_MAX_PORTS; i++) {
-    slot_symbols[i] = srsran_vec_cf_malloc(nof_re);
-    if (!slot_symbols[i]) {
+    slot_symbols[i]  = srsran_vec_cf_malloc(nof_re);
+    batch_symbols[i] = srsran_vec_cf_malloc(nof_re);
+    if (!slot_symbols[i] || !batch_symbols[i]) {
       perror("malloc");
       exit(-1);
     }
@@ -161,11 +166,15 @@ int main(int argc, char** argv)
     for (nsf = 0; nsf < 10; nsf++) {
       dl_sf.tti = nsf;
 
-      srsran_phich_reset(&phich, slot_symbols);
+      for (i = 0; i < SRSRAN_MAX_PORTS; i++) {
+        srsran_vec_cf_zero(slot_symbols[i], nof_re);
+        srsran_vec_cf_zero(batch_symbols[i], nof_re);
+      }
 
       srsran_phich_resource_t resource;
 
       /* Transmit all PHICH groups and sequence numbers */
+      nof_batch_acks = 0;
       for (ngroup = 0; ngroup < srsran_phich_ngroups(&phich); ngroup++) {
         for (nseq = 0; nseq < max_nseq; nseq++) {
           resource.ngroup = ngroup;
@@ -174,6 +183,24 @@ int main(int argc, char** argv)
           ack[ngroup][nseq] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
 
           srsran_phich_encode(&phich, &dl_sf, resource, ack[ngroup][nseq], slot_symbols);
+
+          batch_resources[nof_batch_acks] = resource;
+          batch_acks[nof_batch_acks]      = ack[ngroup][nseq];
+          nof_batch_acks++;
+        }
+      }
+
+      /* The batch encoder must produce the same grid */
+      if (srsran_phich_encode_batch(&phich, &dl_sf, batch_resources, batch_acks, nof_batch_acks, batch_symbols)) {
+        printf("Error encoding the PHICH batch\n");
+        exit(-1);
+      }
+      for (i = 0; i < cell.nof_ports; i++) {
+        for (j = 0; j < nof_re; j++) {
+          if (cabsf(slot_symbols[i][j] - batch_symbols[i][j]) > 1e-5f) {
+            printf("PHICH batch mismatch at port %d, RE %d\n", i, j);
+            exit(-1);
+          }
         }
       }
       /* combine outputs */
@@ -222,6 +249,7 @@ int main(int argc, char** argv)
 
   for (i = 0; i < SRSRAN_MAX_PORTS; i++) {
     free(slot_symbols[i]);
+    free(batch_symbols[i]);
   }
   printf("OK\n");
   exit(0);
@@ -0,0 +1,837 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * End-to-end PHY shared channel benchmark. It encodes and decodes LTE PDSCH/PUSCH and NR PDSCH/PUSCH transport blocks
+ * over an ideal channel for every combination of the swept parameters and prints one JSON object per line, so the
+ * output can be consumed directly by scripts sizing hardware or tracking kernel regressions.
+ */
+
+#include <getopt.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "srsran/phy/phch/pdsch_nr.h"
+#include "srsran/phy/phch/pusch_nr.h"
+#include "srsran/phy/phch/ra_dl_nr.h"
+#include "srsran/phy/phch/ra_nr.h"
+#include "srsran/phy/phch/ra_ul_nr.h"
+#include "srsran/srsran.h"
+
+#define BENCH_MAX_LIST 16
+
+typedef enum {
+  bench_chain_lte_dl = 0,
+  bench_chain_lte_ul,
+  bench_chain_nr_dl,
+  bench_chain_nr_ul,
+  bench_chain_nof_chains
+} bench_chain_t;
+
+static const char* bench_chain_names[bench_chain_nof_chains] = {"lte_dl", "lte_ul", "nr_dl", "nr_ul"};
+
+typedef struct {
+  bench_chain_t chain;
+  uint32_t      nof_prb;
+  uint32_t      mcs;
+  uint32_t      nof_layers;
+  uint32_t      nof_rx_ant;
+  bool          ref_decoder; ///< 16-bit LLR turbo decoder (LTE) or generic C LDPC decoder (NR)
+} bench_case_t;
+
+typedef struct {
+  uint32_t tbs;    ///< Transport block bits per TTI/slot, summed over all codewords
+  uint32_t nof_ok; ///< Number of repetitions decoded with the CRC matching
+  double   encode_us;
+  double   decode_us;
+  double   encode_max_us;
+  double   decode_max_us;
+  double   cpu_us; ///< Thread CPU time spent encoding and decoding
+} bench_result_t;
+
+static bool     chains[bench_chain_nof_chains] = {true, true, true, true};
+static uint32_t prb_list[BENCH_MAX_LIST]       = {25, 50, 100};
+static uint32_t nof_prb_list                   = 3;
+static uint32_t mcs_list[BENCH_MAX_LIST]       = {10, 20, 28};
+static uint32_t nof_mcs_list                   = 3;
+static uint32_t layers_list[BENCH_MAX_LIST]    = {1, 2};
+static uint32_t nof_layers_list                = 2;
+static uint32_t ant_list[BENCH_MAX_LIST]       = {1, 2};
+static uint32_t nof_ant_list                   = 2;
+static bool     decoders[2]                    = {true, true}; // fast, ref
+static uint32_t nof_reps                       = 100;
+static int      cpu                            = -1;
+static char*    output_file                    = NULL;
+static uint16_t rnti                           = 0x1234;
+
+static srsran_random_t random_gen = NULL;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [cpmlaDnCov]\n", prog);
+  printf("\t-c Comma separated chains among lte_dl,lte_ul,nr_dl,nr_ul [Default all]\n");
+  printf("\t-p Comma separated PRB list [Default 25,50,100]\n");
+  printf("\t-m Comma separated MCS list [Default 10,20,28]\n");
+  printf("\t-l Comma separated layer list [Default 1,2]\n");
+  printf("\t-a Comma separated receive antenna list [Default 1,2]\n");
+  printf("\t-D Comma separated decoder list among fast,ref [Default fast,ref]\n");
+  printf("\t-n Number of timed repetitions per case [Default %d]\n", nof_reps);
+  printf("\t-C Pin the benchmark thread to this CPU [Default not pinned]\n");
+  printf("\t-o Write the JSON lines to this file [Default stdout]\n");
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static uint32_t parse_list(const char* str, uint32_t* list)
+{
+  uint32_t    n = 0;
+  const char* s = str;
+  while (n < BENCH_MAX_LIST) {
+    char* end = NULL;
+    list[n++] = (uint32_t)strtol(s, &end, 10);
+    if (*end != ',') {
+      break;
+    }
+    s = end + 1;
+  }
+  return n;
+}
+
+static int parse_names(const char* str, const char** names, uint32_t nof_names, bool* enabled)
+{
+  for (uint32_t i = 0; i < nof_names; i++) {
+    enabled[i] = false;
+  }
+
+  char  buffer[128];
+  char* saveptr = NULL;
+  strncpy(buffer, str, sizeof(buffer) - 1);
+  buffer[sizeof(buffer) - 1] = '\0';
+  for (char* tok = strtok_r(buffer, ",", &saveptr); tok != NULL; tok = strtok_r(NULL, ",", &saveptr)) {
+    uint32_t i = 0;
+    while (i < nof_names && strcmp(tok, names[i]) != 0) {
+      i++;
+    }
+    if (i == nof_names) {
+      ERROR("Unknown option '%s'", tok);
+      return SRSRAN_ERROR;
+    }
+    enabled[i] = true;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int parse_args(int argc, char** argv)
+{
+  static const char* decoder_names[2] = {"fast", "ref"};
+
+  int opt;
+  while ((opt = getopt(argc, argv, "cpmlaDnCov")) != -1) {
+    switch (opt) {
+      case 'c':
+        if (parse_names(argv[optind], bench_chain_names, bench_chain_nof_chains, chains) < SRSRAN_SUCCESS) {
+          return SRSRAN_ERROR;
+        }
+        break;
+      case 'p':
+        nof_prb_list = parse_list(argv[optind], prb_list);
+        break;
+      case 'm':
+        nof_mcs_list = parse_list(argv[optind], mcs_list);
+        break;
+      case 'l':
+        nof_layers_list = parse_list(argv[optind], layers_list);
+        break;
+      case 'a':
+        nof_ant_list = parse_list(argv[optind], ant_list);
+        break;
+      case 'D':
+        if (parse_names(argv[optind], decoder_names, 2, decoders) < SRSRAN_SUCCESS) {
+          return SRSRAN_ERROR;
+        }
+        break;
+      case 'n':
+        nof_reps = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'C':
+        cpu = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'o':
+        output_file = argv[optind];
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static double bench_clock_us(clockid_t clk)
+{
+  struct timespec ts = {};
+  clock_gettime(clk, &ts);
+  return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+// Accounts one encode/decode repetition given the wall clock at the start, between stages and at the end
+static void bench_account(bench_result_t* r, const double t[3], double cpu_us, bool crc)
+{
+  double enc = t[1] - t[0];
+  double dec = t[2] - t[1];
+  r->encode_us += enc;
+  r->decode_us += dec;
+  r->encode_max_us = SRSRAN_MAX(r->encode_max_us, enc);
+  r->decode_max_us = SRSRAN_MAX(r->decode_max_us, dec);
+  r->cpu_us += cpu_us;
+  r->nof_ok += crc ? 1 : 0;
+}
+
+// Returns false for the parameter combinations a chain can not run
+static bool bench_case_supported(const bench_case_t* c)
+{
+  switch (c->chain) {
+    case bench_chain_lte_dl:
+      // One layer is transmitted with TM1, two layers with TM4 and two codewords
+      return srsran_nofprb_isvalid(c->nof_prb) && c->mcs < 29 && c->nof_layers > 0 && c->nof_layers <= 2 &&
+             c->nof_rx_ant >= c->nof_layers && c->nof_rx_ant <= SRSRAN_MAX_PORTS;
+    case bench_chain_lte_ul:
+      // PUSCH is only decoded from 16-bit LLR
+      return c->ref_decoder && srsran_nofprb_isvalid(c->nof_prb) && srsran_dft_precoding_valid_prb(c->nof_prb) &&
+             c->mcs < 29 && c->nof_layers == 1 && c->nof_rx_ant == 1;
+    case bench_chain_nr_dl:
+    case bench_chain_nr_ul:
+      // The NR encoders only map a single layer onto the grid
+      return c->nof_prb > 0 && c->nof_prb <= SRSRAN_MAX_PRB_NR && c->mcs < 29 && c->nof_layers == 1 &&
+             c->nof_rx_ant == 1;
+    default:
+      break;
+  }
+  return false;
+}
+
+static void bench_random_tb(srsran_crc_t* crc, uint8_t* data, uint32_t tbs)
+{
+  for (uint32_t i = 0; i < tbs / 8; i++) {
+    data[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 255);
+  }
+  // Attach CRC for making sure TB with 0 CRC are detected
+  srsran_crc_attach_byte(crc, data, tbs - 24);
+}
+
+static int bench_lte_dl(const bench_case_t* c, bench_result_t* r)
+{
+  int                    ret                                 = SRSRAN_ERROR;
+  srsran_pdsch_t         pdsch_tx                            = {};
+  srsran_pdsch_t         pdsch_rx                            = {};
+  srsran_pdsch_cfg_t     pdsch_cfg                           = {};
+  srsran_dl_sf_cfg_t     dl_sf                               = {};
+  srsran_chest_dl_res_t  chest_res                           = {};
+  srsran_pdsch_res_t     pdsch_res[SRSRAN_MAX_CODEWORDS]     = {};
+  srsran_softbuffer_tx_t softbuffer_tx[SRSRAN_MAX_CODEWORDS] = {};
+  srsran_softbuffer_rx_t softbuffer_rx[SRSRAN_MAX_CODEWORDS] = {};
+  uint8_t*               data_tx[SRSRAN_MAX_CODEWORDS]       = {};
+  uint8_t*               data_rx[SRSRAN_MAX_CODEWORDS]       = {};
+  cf_t*                  tx_symbols[SRSRAN_MAX_PORTS]        = {};
+  srsran_crc_t           crc_tb                              = {};
+  srsran_dci_dl_t        dci                                 = {};
+  srsran_cell_t          cell                                = {};
+  srsran_tm_t            tm                                  = (c->nof_layers > 1) ? SRSRAN_TM4 : SRSRAN_TM1;
+
+  cell.nof_prb         = c->nof_prb;
+  cell.nof_ports       = c->nof_layers;
+  cell.id              = 1;
+  cell.cp              = SRSRAN_CP_NORM;
+  cell.phich_length    = SRSRAN_PHICH_NORM;
+  cell.phich_resources = SRSRAN_PHICH_R_1_6;
+  cell.frame_type      = SRSRAN_FDD;
+
+  dci.format                  = (tm == SRSRAN_TM4) ? SRSRAN_DCI_FORMAT2 : SRSRAN_DCI_FORMAT1A;
+  dci.rnti                    = rnti;
+  dci.type0_alloc.rbg_bitmask = 0xffffffff;
+  for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+    dci.tb[i].mcs_idx = (i < c->nof_layers) ? c->mcs : 0;
+    dci.tb[i].rv      = (i < c->nof_layers) ? 0 : 1;
+    dci.tb[i].cw_idx  = i;
+  }
+
+  dl_sf.tti = 1;
+  dl_sf.cfi = 1;
+
+  pdsch_cfg.power_scale = true;
+  pdsch_cfg.p_a         = 0.0f;
+  pdsch_cfg.p_b         = (tm > SRSRAN_TM1) ? 1 : 0;
+  pdsch_cfg.rnti        = rnti;
+
+  if (srsran_ra_dl_dci_to_grant(&cell, &dl_sf, tm, false, &dci, &pdsch_cfg.grant)) {
+    ERROR("Error computing resource allocation");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_pdsch_init_enb(&pdsch_tx, cell.nof_prb) || srsran_pdsch_set_cell(&pdsch_tx, cell) ||
+      srsran_pdsch_init_ue(&pdsch_rx, cell.nof_prb, c->nof_rx_ant) || srsran_pdsch_set_cell(&pdsch_rx, cell)) {
+    ERROR("Error creating PDSCH object");
+    goto clean_exit;
+  }
+  pdsch_rx.llr_is_8bit        = !c->ref_decoder;
+  pdsch_rx.dl_sch.llr_is_8bit = !c->ref_decoder;
+
+  if (srsran_chest_dl_res_init(&chest_res, cell.nof_prb) < SRSRAN_SUCCESS ||
+      srsran_crc_init(&crc_tb, SRSRAN_LTE_CRC24A, 24) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating channel estimates");
+    goto clean_exit;
+  }
+  srsran_chest_dl_res_set_identity(&chest_res);
+
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    tx_symbols[i] = srsran_vec_cf_malloc(SRSRAN_NOF_RE(cell));
+    if (tx_symbols[i] == NULL) {
+      ERROR("Error malloc");
+      goto clean_exit;
+    }
+    srsran_vec_cf_zero(tx_symbols[i], SRSRAN_NOF_RE(cell));
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+    if (srsran_softbuffer_tx_init(&softbuffer_tx[i], cell.nof_prb) ||
+        srsran_softbuffer_rx_init(&softbuffer_rx[i], cell.nof_prb)) {
+      ERROR("Error initiating soft buffer");
+      goto clean_exit;
+    }
+
+    if (pdsch_cfg.grant.tb[i].enabled) {
+      // The decoder writes whole code blocks, CRC included, so the payloads are oversized
+      data_tx[i] = srsran_vec_u8_malloc(pdsch_cfg.grant.tb[i].tbs);
+      data_rx[i] = srsran_vec_u8_malloc(pdsch_cfg.grant.tb[i].tbs);
+      if (data_tx[i] == NULL || data_rx[i] == NULL) {
+        ERROR("Error malloc");
+        goto clean_exit;
+      }
+      bench_random_tb(&crc_tb, data_tx[i], pdsch_cfg.grant.tb[i].tbs);
+      pdsch_res[i].payload = data_rx[i];
+      r->tbs += pdsch_cfg.grant.tb[i].tbs;
+    }
+  }
+
+  // The first repetition warms up caches and lazily built tables and is not accounted
+  for (uint32_t rep = 0; rep <= nof_reps; rep++) {
+    // The soft-buffers share a union, they are attached right before each stage
+    for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      srsran_softbuffer_tx_reset(&softbuffer_tx[i]);
+      srsran_softbuffer_rx_reset(&softbuffer_rx[i]);
+      pdsch_cfg.softbuffers.tx[i] = &softbuffer_tx[i];
+    }
+
+    double t[3];
+    double cpu_start = bench_clock_us(CLOCK_THREAD_CPUTIME_ID);
+    t[0]             = bench_clock_us(CLOCK_MONOTONIC);
+    if (srsran_pdsch_encode(&pdsch_tx, &dl_sf, &pdsch_cfg, data_tx, tx_symbols)) {
+      ERROR("Error encoding PDSCH");
+      goto clean_exit;
+    }
+    t[1] = bench_clock_us(CLOCK_MONOTONIC);
+    for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      pdsch_cfg.softbuffers.rx[i] = &softbuffer_rx[i];
+    }
+    if (srsran_pdsch_decode(&pdsch_rx, &dl_sf, &pdsch_cfg, &chest_res, tx_symbols, pdsch_res)) {
+      ERROR("Error decoding PDSCH");
+      goto clean_exit;
+    }
+    t[2]          = bench_clock_us(CLOCK_MONOTONIC);
+    double cpu_us = bench_clock_us(CLOCK_THREAD_CPUTIME_ID) - cpu_start;
+
+    bool crc = true;
+    for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      if (pdsch_cfg.grant.tb[i].enabled) {
+        crc = crc && pdsch_res[i].crc && memcmp(data_tx[i], data_rx[i], pdsch_cfg.grant.tb[i].tbs / 8) == 0;
+      }
+    }
+    if (rep > 0) {
+      bench_account(r, t, cpu_us, crc);
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_pdsch_free(&pdsch_tx);
+  srsran_pdsch_free(&pdsch_rx);
+  srsran_chest_dl_res_free(&chest_res);
+  for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+    srsran_softbuffer_tx_free(&softbuffer_tx[i]);
+    srsran_softbuffer_rx_free(&softbuffer_rx[i]);
+    free(data_tx[i]);
+    free(data_rx[i]);
+  }
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    free(tx_symbols[i]);
+  }
+  return ret;
+}
+
+static int bench_lte_ul(const bench_case_t* c, bench_result_t* r)
+{
+  int                        ret           = SRSRAN_ERROR;
+  srsran_pusch_t             pusch_tx      = {};
+  srsran_pusch_t             pusch_rx      = {};
+  srsran_pusch_cfg_t         cfg           = {};
+  srsran_ul_sf_cfg_t         ul_sf         = {};
+  srsran_chest_ul_res_t      chest_res     = {};
+  srsran_softbuffer_tx_t     softbuffer_tx = {};
+  srsran_softbuffer_rx_t     softbuffer_rx = {};
+  srsran_crc_t               crc_tb        = {};
+  srsran_dci_ul_t            dci           = {};
+  srsran_pusch_hopping_cfg_t ul_hopping    = {.n_sb = 1, .hopping_offset = 0, .hop_mode = 1};
+  uint8_t*                   data_tx       = NULL;
+  uint8_t*                   data_rx       = NULL;
+  cf_t*                      sf_symbols    = NULL;
+  srsran_cell_t              cell          = {};
+
+  cell.nof_prb         = c->nof_prb;
+  cell.nof_ports       = 1;
+  cell.id              = 1;
+  cell.cp              = SRSRAN_CP_NORM;
+  cell.phich_length    = SRSRAN_PHICH_NORM;
+  cell.phich_resources = SRSRAN_PHICH_R_1_6;
+  cell.frame_type      = SRSRAN_FDD;
+
+  dci.freq_hop_fl     = SRSRAN_RA_PUSCH_HOP_DISABLED;
+  dci.type2_alloc.riv = srsran_ra_type2_to_riv(c->nof_prb, 0, cell.nof_prb);
+  dci.tb.mcs_idx      = c->mcs;
+  dci.rnti            = rnti;
+
+  if (srsran_ra_ul_dci_to_grant(&cell, &ul_sf, &ul_hopping, &dci, &cfg.grant)) {
+    ERROR("Error computing resource allocation");
+    return SRSRAN_ERROR;
+  }
+  cfg.grant.n_prb_tilde[0] = cfg.grant.n_prb[0];
+  cfg.grant.n_prb_tilde[1] = cfg.grant.n_prb[1];
+  cfg.rnti                 = rnti;
+  cfg.enable_64qam         = true;
+
+  if (srsran_pusch_init_ue(&pusch_tx, cell.nof_prb) || srsran_pusch_set_cell(&pusch_tx, cell) ||
+      srsran_pusch_init_enb(&pusch_rx, cell.nof_prb) || srsran_pusch_set_cell(&pusch_rx, cell)) {
+    ERROR("Error creating PUSCH object");
+    goto clean_exit;
+  }
+
+  sf_symbols = srsran_vec_cf_malloc(SRSRAN_NOF_RE(cell));
+  data_tx    = srsran_vec_u8_malloc(cfg.grant.tb.tbs);
+  data_rx    = srsran_vec_u8_malloc(cfg.grant.tb.tbs);
+  if (sf_symbols == NULL || data_tx == NULL || data_rx == NULL) {
+    ERROR("Error malloc");
+    goto clean_exit;
+  }
+
+  if (srsran_softbuffer_tx_init(&softbuffer_tx, cell.nof_prb) ||
+      srsran_softbuffer_rx_init(&softbuffer_rx, cell.nof_prb) ||
+      srsran_chest_ul_res_init(&chest_res, cell.nof_prb) < SRSRAN_SUCCESS ||
+      srsran_crc_init(&crc_tb, SRSRAN_LTE_CRC24A, 24) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating soft buffers");
+    goto clean_exit;
+  }
+  srsran_chest_ul_res_set_identity(&chest_res);
+
+  bench_random_tb(&crc_tb, data_tx, cfg.grant.tb.tbs);
+  r->tbs = cfg.grant.tb.tbs;
+
+  srsran_pusch_data_t pdata     = {.ptr = data_tx};
+  srsran_pusch_res_t  pusch_res = {.data = data_rx};
+
+  for (uint32_t rep = 0; rep <= nof_reps; rep++) {
+    srsran_softbuffer_tx_reset(&softbuffer_tx);
+    srsran_softbuffer_rx_reset(&softbuffer_rx);
+    cfg.softbuffers.tx = &softbuffer_tx;
+
+    double t[3];
+    double cpu_start = bench_clock_us(CLOCK_THREAD_CPUTIME_ID);
+    t[0]             = bench_clock_us(CLOCK_MONOTONIC);
+    if (srsran_pusch_encode(&pusch_tx, &ul_sf, &cfg, &pdata, sf_symbols)) {
+      ERROR("Error encoding PUSCH");
+      goto clean_exit;
+    }
+    t[1]               = bench_clock_us(CLOCK_MONOTONIC);
+    cfg.softbuffers.rx = &softbuffer_rx;
+    if (srsran_pusch_decode(&pusch_rx, &ul_sf, &cfg, &chest_res, sf_symbols, &pusch_res)) {
+      ERROR("Error decoding PUSCH");
+      goto clean_exit;
+    }
+    t[2]          = bench_clock_us(CLOCK_MONOTONIC);
+    double cpu_us = bench_clock_us(CLOCK_THREAD_CPUTIME_ID) - cpu_start;
+
+    if (rep > 0) {
+      bench_account(r, t, cpu_us, pusch_res.crc && memcmp(data_tx, data_rx, cfg.grant.tb.tbs / 8) == 0);
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_pusch_free(&pusch_tx);
+  srsran_pusch_free(&pusch_rx);
+  srsran_chest_ul_res_free(&chest_res);
+  srsran_softbuffer_tx_free(&softbuffer_tx);
+  srsran_softbuffer_rx_free(&softbuffer_rx);
+  free(sf_symbols);
+  free(data_tx);
+  free(data_rx);
+  return ret;
+}
+
+// Fills the NR grant shared by both directions, the TBS depends on the DMRS and time allocation already loaded
+static int bench_nr_grant(const bench_case_t* c, srsran_sch_cfg_nr_t* cfg)
+{
+  cfg->grant.nof_dmrs_cdm_groups_without_data = 1;
+  cfg->grant.nof_layers                       = c->nof_layers;
+  cfg->grant.rnti                             = rnti;
+  cfg->grant.nof_prb                          = c->nof_prb;
+  for (uint32_t n = 0; n < SRSRAN_MAX_PRB_NR; n++) {
+    cfg->grant.prb_idx[n] = (n < c->nof_prb);
+  }
+
+  if (srsran_ra_nr_fill_tb(cfg, &cfg->grant, c->mcs, &cfg->grant.tb[0]) < SRSRAN_SUCCESS) {
+    ERROR("Error filling tb");
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static int bench_nr(const bench_case_t* c, bench_result_t* r)
+{
+  bool                   is_dl                            = (c->chain == bench_chain_nr_dl);
+  int                    ret                              = SRSRAN_ERROR;
+  srsran_carrier_nr_t    carrier                          = SRSRAN_DEFAULT_CARRIER_NR;
+  srsran_pdsch_nr_t      pdsch_tx                         = {};
+  srsran_pdsch_nr_t      pdsch_rx                         = {};
+  srsran_pusch_nr_t      pusch_tx                         = {};
+  srsran_pusch_nr_t      pusch_rx                         = {};
+  srsran_sch_cfg_nr_t    cfg                              = {};
+  srsran_chest_dl_res_t  chest                            = {};
+  srsran_softbuffer_tx_t softbuffer_tx                    = {};
+  srsran_softbuffer_rx_t softbuffer_rx                    = {};
+  srsran_pdsch_res_nr_t  pdsch_res                        = {};
+  srsran_pusch_data_nr_t pusch_data                       = {};
+  srsran_pusch_res_nr_t  pusch_res                        = {};
+  uint8_t*               data_tx[SRSRAN_MAX_TB]           = {};
+  uint8_t*               data_rx[SRSRAN_MAX_TB]           = {};
+  cf_t*                  sf_symbols[SRSRAN_MAX_LAYERS_NR] = {};
+
+  carrier.nof_prb         = c->nof_prb;
+  carrier.max_mimo_layers = c->nof_layers;
+  cfg.sch_cfg.mcs_table   = srsran_mcs_table_64qam;
+
+  if (is_dl) {
+    srsran_pdsch_nr_args_t args = {};
+    args.sch.disable_simd       = false;
+    if (srsran_pdsch_nr_init_enb(&pdsch_tx, &args) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating PDSCH for Tx");
+      goto clean_exit;
+    }
+    args.sch.disable_simd = c->ref_decoder;
+    if (srsran_pdsch_nr_init_ue(&pdsch_rx, &args) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating PDSCH for Rx");
+      goto clean_exit;
+    }
+    if (srsran_pdsch_nr_set_carrier(&pdsch_tx, &carrier) || srsran_pdsch_nr_set_carrier(&pdsch_rx, &carrier)) {
+      ERROR("Error setting PDSCH carrier");
+      goto clean_exit;
+    }
+    if (srsran_ra_dl_nr_time_default_A(0, cfg.dmrs.typeA_pos, &cfg.grant) < SRSRAN_SUCCESS) {
+      ERROR("Error loading default grant");
+      goto clean_exit;
+    }
+    cfg.grant.dci_format = srsran_dci_format_nr_1_0;
+  } else {
+    srsran_pusch_nr_args_t args = {};
+    args.sch.disable_simd       = false;
+    if (srsran_pusch_nr_init_ue(&pusch_tx, &args) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating PUSCH for Tx");
+      goto clean_exit;
+    }
+    args.sch.disable_simd = c->ref_decoder;
+    if (srsran_pusch_nr_init_gnb(&pusch_rx, &args) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating PUSCH for Rx");
+      goto clean_exit;
+    }
+    if (srsran_pusch_nr_set_carrier(&pusch_tx, &carrier) || srsran_pusch_nr_set_carrier(&pusch_rx, &carrier)) {
+      ERROR("Error setting PUSCH carrier");
+      goto clean_exit;
+    }
+    if (srsran_ra_ul_nr_pusch_time_resource_default_A(carrier.scs, 0, &cfg.grant) < SRSRAN_SUCCESS) {
+      ERROR("Error loading default grant");
+      goto clean_exit;
+    }
+    cfg.grant.dci_format = srsran_dci_format_nr_0_0;
+  }
+
+  if (bench_nr_grant(c, &cfg) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  if (!is_dl) {
+    srsran_sch_hl_cfg_nr_t sch_hl_cfg = {};
+    sch_hl_cfg.scaling                = 1.0f;
+    if (srsran_ra_ul_set_grant_uci_nr(&carrier, &sch_hl_cfg, &cfg.uci, &cfg) < SRSRAN_SUCCESS) {
+      ERROR("Setting UCI");
+      goto clean_exit;
+    }
+  }
+
+  for (uint32_t i = 0; i < c->nof_layers; i++) {
+    sf_symbols[i] = srsran_vec_cf_malloc(SRSRAN_SLOT_LEN_RE_NR(carrier.nof_prb));
+    if (sf_symbols[i] == NULL) {
+      ERROR("Error malloc");
+      goto clean_exit;
+    }
+  }
+
+  if (srsran_softbuffer_tx_init_guru(&softbuffer_tx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
+          SRSRAN_SUCCESS ||
+      srsran_softbuffer_rx_init_guru_c(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
+          SRSRAN_SUCCESS) {
+    ERROR("Error init soft-buffer");
+    goto clean_exit;
+  }
+
+  if (srsran_chest_dl_res_init(&chest, carrier.nof_prb) < SRSRAN_SUCCESS) {
+    ERROR("Initiating chest");
+    goto clean_exit;
+  }
+  srsran_chest_dl_res_set_identity(&chest);
+  chest.nof_re = cfg.grant.tb[0].nof_re / c->nof_layers;
+
+  for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+    if (!cfg.grant.tb[tb].enabled) {
+      continue;
+    }
+    data_tx[tb] = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
+    data_rx[tb] = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
+    if (data_tx[tb] == NULL || data_rx[tb] == NULL) {
+      ERROR("Error malloc");
+      goto clean_exit;
+    }
+    for (uint32_t i = 0; i < cfg.grant.tb[tb].tbs / 8; i++) {
+      data_tx[tb][i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, UINT8_MAX);
+    }
+    pdsch_res.tb[tb].payload = data_rx[tb];
+    pusch_data.payload[tb]   = data_tx[tb];
+    pusch_res.tb[tb].payload = data_rx[tb];
+    r->tbs += cfg.grant.tb[tb].tbs;
+  }
+
+  for (uint32_t rep = 0; rep <= nof_reps; rep++) {
+    srsran_softbuffer_tx_reset(&softbuffer_tx);
+    srsran_softbuffer_rx_reset(&softbuffer_rx);
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+      cfg.grant.tb[tb].softbuffer.tx = &softbuffer_tx;
+    }
+
+    double t[3];
+    double cpu_start = bench_clock_us(CLOCK_THREAD_CPUTIME_ID);
+    t[0]             = bench_clock_us(CLOCK_MONOTONIC);
+    int err          = is_dl ? srsran_pdsch_nr_encode(&pdsch_tx, &cfg, &cfg.grant, data_tx, sf_symbols)
+                             : srsran_pusch_nr_encode(&pusch_tx, &cfg, &cfg.grant, &pusch_data, sf_symbols);
+    if (err < SRSRAN_SUCCESS) {
+      ERROR("Error encoding");
+      goto clean_exit;
+    }
+    t[1] = bench_clock_us(CLOCK_MONOTONIC);
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+      cfg.grant.tb[tb].softbuffer.rx = &softbuffer_rx;
+    }
+    err = is_dl ? srsran_pdsch_nr_decode(&pdsch_rx, &cfg, &cfg.grant, &chest, sf_symbols, &pdsch_res)
+                 : srsran_pusch_nr_decode(&pusch_rx, &cfg, &cfg.grant, &chest, sf_symbols, &pusch_res);
+    if (err < SRSRAN_SUCCESS) {
+      ERROR("Error decoding");
+      goto clean_exit;
+    }
+    t[2]          = bench_clock_us(CLOCK_MONOTONIC);
+    double cpu_us = bench_clock_us(CLOCK_THREAD_CPUTIME_ID) - cpu_start;
+
+    bool crc = true;
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+      if (cfg.grant.tb[tb].enabled) {
+        bool tb_crc = is_dl ? pdsch_res.tb[tb].crc : pusch_res.tb[tb].crc;
+        crc         = crc && tb_crc && memcmp(data_tx[tb], data_rx[tb], cfg.grant.tb[tb].tbs / 8) == 0;
+      }
+    }
+    if (rep > 0) {
+      bench_account(r, t, cpu_us, crc);
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_pdsch_nr_free(&pdsch_tx);
+  srsran_pdsch_nr_free(&pdsch_rx);
+  srsran_pusch_nr_free(&pusch_tx);
+  srsran_pusch_nr_free(&pusch_rx);
+  srsran_chest_dl_res_free(&chest);
+  srsran_softbuffer_tx_free(&softbuffer_tx);
+  srsran_softbuffer_rx_free(&softbuffer_rx);
+  for (uint32_t i = 0; i < SRSRAN_MAX_TB; i++) {
+    free(data_tx[i]);
+    free(data_rx[i]);
+  }
+  for (uint32_t i = 0; i < SRSRAN_MAX_LAYERS_NR; i++) {
+    free(sf_symbols[i]);
+  }
+  return ret;
+}
+
+static void bench_print(FILE* f, const bench_case_t* c, const bench_result_t* r)
+{
+  double reps      = (double)SRSRAN_MAX(nof_reps, 1);
+  double encode_us = r->encode_us / reps;
+  double decode_us = r->decode_us / reps;
+  double cpu_us    = r->cpu_us / reps;
+
+  // Bits per microsecond are Mbps
+  fprintf(f,
+          "{\"chain\":\"%s\",\"prb\":%d,\"mcs\":%d,\"layers\":%d,\"antennas\":%d,\"decoder\":\"%s\",\"cpu\":%d,"
+          "\"reps\":%d,\"tbs\":%d,\"encode_us\":%.2f,\"encode_max_us\":%.2f,\"decode_us\":%.2f,\"decode_max_us\":%.2f,"
+          "\"encode_mbps\":%.2f,\"decode_mbps\":%.2f,\"mbps_per_core\":%.2f,\"crc_ok\":%d}\n",
+          bench_chain_names[c->chain],
+          c->nof_prb,
+          c->mcs,
+          c->nof_layers,
+          c->nof_rx_ant,
+          c->ref_decoder ? "ref" : "fast",
+          sched_getcpu(),
+          nof_reps,
+          r->tbs,
+          encode_us,
+          r->encode_max_us,
+          decode_us,
+          r->decode_max_us,
+          encode_us > 0 ? r->tbs / encode_us : 0.0,
+          decode_us > 0 ? r->tbs / decode_us : 0.0,
+          cpu_us > 0 ? r->tbs / cpu_us : 0.0,
+          r->nof_ok);
+  fflush(f);
+}
+
+int main(int argc, char** argv)
+{
+  int   ret = SRSRAN_ERROR;
+  FILE* f   = stdout;
+
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  if (cpu >= 0) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    if (sched_setaffinity(0, sizeof(cpu_set_t), &cpuset) != 0) {
+      perror("sched_setaffinity");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  if (output_file != NULL) {
+    f = fopen(output_file, "w");
+    if (f == NULL) {
+      perror("fopen");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  random_gen = srsran_random_init(0x1234);
+
+  for (uint32_t ch = 0; ch < bench_chain_nof_chains; ch++) {
+    if (!chains[ch]) {
+      continue;
+    }
+    for (uint32_t d = 0; d < 2; d++) {
+      if (!decoders[d]) {
+        continue;
+      }
+      for (uint32_t p = 0; p < nof_prb_list; p++) {
+        for (uint32_t m = 0; m < nof_mcs_list; m++) {
+          for (uint32_t l = 0; l < nof_layers_list; l++) {
+            for (uint32_t a = 0; a < nof_ant_list; a++) {
+              bench_case_t   c = {.chain       = (bench_chain_t)ch,
+                                  .nof_prb     = prb_list[p],
+                                  .mcs         = mcs_list[m],
+                                  .nof_layers  = layers_list[l],
+                                  .nof_rx_ant  = ant_list[a],
+                                  .ref_decoder = (d == 1)};
+              bench_result_t r = {};
+
+              if (!bench_case_supported(&c)) {
+                continue;
+              }
+
+              int err = SRSRAN_ERROR;
+              switch (c.chain) {
+                case bench_chain_lte_dl:
+                  err = bench_lte_dl(&c, &r);
+                  break;
+                case bench_chain_lte_ul:
+                  err = bench_lte_ul(&c, &r);
+                  break;
+                default:
+                  err = bench_nr(&c, &r);
+                  break;
+              }
+              if (err < SRSRAN_SUCCESS) {
+                ERROR("Error running %s with %d PRB and MCS %d", bench_chain_names[ch], c.nof_prb, c.mcs);
+                goto clean_exit;
+              }
+
+              // An ideal channel must never corrupt a transport block
+              if (r.nof_ok != nof_reps) {
+                ERROR("%s with %d PRB and MCS %d failed CRC in %d of %d repetitions",
+                      bench_chain_names[ch],
+                      c.nof_prb,
+                      c.mcs,
+                      nof_reps - r.nof_ok,
+                      nof_reps);
+                bench_print(f, &c, &r);
+                goto clean_exit;
+              }
+
+              bench_print(f, &c, &r);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  if (f != stdout) {
+    fclose(f);
+  }
+  return ret;
+}
@@ -252,6 +252,7 @@ int main(int argc, char** argv)
           if (format >= SRSRAN_PUCCH_FORMAT_2) {
             uci_data.cfg.cqi.data_enable = true;
           }
+          pucch_cfg.uci_cfg = uci_data.cfg;
 
           // Encode PUCCH signals
           gettimeofday(&t[1], NULL);
@@ -275,6 +276,9 @@ int main(int argc, char** argv)
           // Run AWGN channel
           srsran_channel_awgn_run_c(&awgn, sf_symbols, sf_symbols, SRSRAN_NOF_RE(cell));
 
+          // The channel estimator overwrites the DMRS bits with the detected ones
+          uint8_t drs_bits[2] = {pucch_cfg.pucch2_drs_bits[0], pucch_cfg.pucch2_drs_bits[1]};
+
           // Decode PUCCH signals
           gettimeofday(&t[1], NULL);
           if (srsran_chest_ul_estimate_pucch(&chest, &ul_sf, &pucch_cfg, sf_symbols, &chest_res) < SRSRAN_SUCCESS) {
@@ -291,6 +295,32 @@ int main(int argc, char** argv)
           get_time_interval(t);
           uint64_t t_dec = t[0].tv_usec + t[0].tv_sec * 1000000UL;
 
+          // Check the ACK bits carried by the Format 1A/1B symbols and the Format 2A/2B DMRS are detected
+          bool ack_ok = true;
+          switch (format) {
+            case SRSRAN_PUCCH_FORMAT_1:
+              ack_ok = res.detected;
+              break;
+            case SRSRAN_PUCCH_FORMAT_1A:
+            case SRSRAN_PUCCH_FORMAT_1B:
+              for (uint32_t i = 0; i < uci_data.cfg.ack[0].nof_acks; i++) {
+                ack_ok &= (res.uci_data.ack.ack_value[i] == uci_data.value.ack.ack_value[i]);
+              }
+              break;
+            case SRSRAN_PUCCH_FORMAT_2A:
+            case SRSRAN_PUCCH_FORMAT_2B:
+              for (uint32_t i = 0; i < uci_data.cfg.ack[0].nof_acks; i++) {
+                ack_ok &= (pucch_cfg.pucch2_drs_bits[i] == drs_bits[i]);
+              }
+              break;
+            default:
+              break;
+          }
+          if (!ack_ok) {
+            ERROR("Error detecting PUCCH format %s, n_pucch=%d", srsran_pucch_format_text(format), n_pucch);
+            goto quit;
+          }
+
           // Check EPRE and RSRP are +/- 1 dB and SNR measurements are +/- 3dB
           if (fabsf(chest_res.epre_dBfs) > 1.0 || fabsf(chest_res.rsrp_dBfs) > 1.0 ||
               fabsf(chest_res.snr_db - snr_db) > 3.0) {
@@ -56,6 +56,8 @@ int          freq_hop      = -1;
 int          riv           = -1;
 uint32_t     mcs_idx       = 0;
 bool         enable_64_qam = false;
+uint32_t     nof_cb_workers = 0;
+bool         early_stop     = false;
 
 void usage(char* prog)
 {
@@ -84,6 +86,8 @@ void usage(char* prog)
   printf("\n\tOther parameters:\n");
   printf("\t\t-p enable_64qam [Default %s]\n", enable_64_qam ? "enabled" : "disabled");
   printf("\t\t-s number of subframes [Default %d]\n", subframe);
+  printf("\t\t-w number of code block decoder workers [Default %d]\n", nof_cb_workers);
+  printf("\t\t-E stop decoding code blocks with stable hard decisions [Default %s]\n", early_stop ? "enabled" : "disabled");
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
@@ -139,7 +143,7 @@ void parse_extensive_param(char* param, char* arg)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "msLFrncpvf")) != -1) {
+  while ((opt = getopt(argc, argv, "msLFrncpvfwE")) != -1) {
     switch (opt) {
       case 'm':
         mcs_idx = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -169,6 +173,12 @@ void parse_args(int argc, char** argv)
         parse_extensive_param(argv[optind], argv[optind + 1]);
         optind++;
         break;
+      case 'w':
+        nof_cb_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'E':
+        early_stop ^= true;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -243,6 +253,11 @@ int main(int argc, char** argv)
     ERROR("Error creating PUSCH object");
     goto quit;
   }
+  if (srsran_sch_enable_cb_workers(&pusch_rx.ul_sch, nof_cb_workers)) {
+    ERROR("Error enabling code block workers");
+    goto quit;
+  }
+  pusch_rx.ul_sch.early_stop_stable = early_stop;
 
   uint16_t rnti = 62;
   dci.rnti      = rnti;
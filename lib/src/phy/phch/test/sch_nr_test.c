@@ -27,12 +27,18 @@
 #include <getopt.h>
 #include <srsran/phy/utils/random.h>
 
+// Maximum number of copies of a transport block decoded together
+#define MAX_NOF_DEFERRED 4
+
 static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
 
-static uint32_t            n_prb     = 0;  // Set to 0 for steering
-static uint32_t            mcs       = 30; // Set to 30 for steering
-static uint32_t            rv        = 4;  // Set to 30 for steering
-static srsran_sch_cfg_nr_t pdsch_cfg = {};
+static uint32_t            n_prb          = 0;  // Set to 0 for steering
+static uint32_t            mcs            = 30; // Set to 30 for steering
+static uint32_t            rv             = 4;  // Set to 30 for steering
+static uint32_t            nof_cb_workers = 0;  // Set to 0 for serial code block decoding
+static bool                accelerator    = false;
+static uint32_t            nof_deferred   = 0;  // Set to 0 for decoding each transport block on its own
+static srsran_sch_cfg_nr_t pdsch_cfg      = {};
 
 static void usage(char* prog)
 {
@@ -44,13 +50,19 @@ static void usage(char* prog)
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table));
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
+  printf("\t-w Number of code block decoding helper threads [Default %d]\n", nof_cb_workers);
+  printf("\t-a Decode with the software LDPC accelerator [Default %s]\n", accelerator ? "yes" : "no");
+  printf("\t-d Number of copies of each transport block decoded together through the deferred small code blocks, up "
+         "to %d [Default %d]\n",
+         MAX_NOF_DEFERRED,
+         nof_deferred);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "PpmTLvr")) != -1) {
+  while ((opt = getopt(argc, argv, "PpmTLvrwad")) != -1) {
     switch (opt) {
       case 'P':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -70,6 +82,15 @@ int parse_args(int argc, char** argv)
       case 'L':
         carrier.max_mimo_layers = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'w':
+        nof_cb_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'a':
+        accelerator = true;
+        break;
+      case 'd':
+        nof_deferred = SRSRAN_MIN((uint32_t)strtol(argv[optind], NULL, 10), MAX_NOF_DEFERRED);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -89,10 +110,13 @@ int main(int argc, char** argv)
   srsran_sch_nr_t sch_nr_rx = {};
   srsran_random_t rand_gen  = srsran_random_init(1234);
 
+  srsran_ldpc_accelerator_dev_t accelerator_dev = {};
+
   uint8_t* data_tx = srsran_vec_u8_malloc(1024 * 1024);
   uint8_t* encoded = srsran_vec_u8_malloc(1024 * 1024 * 8);
+  uint8_t* retx    = srsran_vec_u8_malloc(1024 * 1024 * 8);
   int8_t*  llr     = srsran_vec_i8_malloc(1024 * 1024 * 8);
-  uint8_t* data_rx = srsran_vec_u8_malloc(1024 * 1024);
+  uint8_t* data_rx = srsran_vec_u8_malloc(1024 * 1024 * MAX_NOF_DEFERRED);
 
   // Set default PDSCH configuration
   pdsch_cfg.sch_cfg.mcs_table = srsran_mcs_table_64qam;
@@ -101,7 +125,7 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  if (data_tx == NULL || data_rx == NULL) {
+  if (data_tx == NULL || data_rx == NULL || encoded == NULL || retx == NULL) {
     goto clean_exit;
   }
 
@@ -110,6 +134,19 @@ int main(int argc, char** argv)
   args.decoder_use_flooded    = false;
   args.decoder_scaling_factor = 0.8;
   args.max_nof_iter           = 20;
+  args.nof_cb_workers         = nof_cb_workers;
+  args.defer_small_cb         = (nof_deferred > 0);
+  if (accelerator) {
+    srsran_ldpc_decoder_args_t decoder_args = {};
+    decoder_args.type                       = SRSRAN_LDPC_DECODER_C;
+    decoder_args.scaling_fctr               = args.decoder_scaling_factor;
+    decoder_args.max_nof_iter               = args.max_nof_iter;
+    if (srsran_ldpc_accelerator_sw_init(&accelerator_dev, &decoder_args) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating LDPC accelerator");
+      goto clean_exit;
+    }
+    args.accelerator = &accelerator_dev;
+  }
   if (srsran_sch_nr_init_tx(&sch_nr_tx, &args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating SCH NR for Tx");
     goto clean_exit;
@@ -130,8 +167,8 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  srsran_softbuffer_tx_t softbuffer_tx = {};
-  srsran_softbuffer_rx_t softbuffer_rx = {};
+  srsran_softbuffer_tx_t softbuffer_tx                   = {};
+  srsran_softbuffer_rx_t softbuffer_rx[MAX_NOF_DEFERRED] = {};
 
   if (srsran_softbuffer_tx_init_guru(&softbuffer_tx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
       SRSRAN_SUCCESS) {
@@ -139,10 +176,12 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  if (srsran_softbuffer_rx_init_guru(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
-      SRSRAN_SUCCESS) {
-    ERROR("Error init soft-buffer");
-    goto clean_exit;
+  for (uint32_t i = 0; i < MAX_NOF_DEFERRED; i++) {
+    if (srsran_softbuffer_rx_init_guru_c(
+            &softbuffer_rx[i], SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) < SRSRAN_SUCCESS) {
+      ERROR("Error init soft-buffer");
+      goto clean_exit;
+    }
   }
 
   // Use grant default A time resources with m=0
@@ -199,32 +238,54 @@ int main(int argc, char** argv)
           goto clean_exit;
         }
 
+        // Retransmissions are served from the circular buffers kept in the soft-buffer, without data
+        if (rv != 0) {
+          if (srsran_dlsch_nr_encode(&sch_nr_tx, &pdsch_cfg.sch_cfg, &tb, NULL, retx) < SRSRAN_SUCCESS) {
+            ERROR("Error encoding retransmission");
+            goto clean_exit;
+          }
+
+          if (memcmp(encoded, retx, tb.nof_bits) != 0) {
+            ERROR("Failed to match retransmission; n_prb=%d; mcs=%d; rv=%d; TBS=%d;", n_prb, mcs, rv, tb.tbs);
+            goto clean_exit;
+          }
+        }
+
         for (uint32_t i = 0; i < tb.nof_bits; i++) {
           llr[i] = encoded[i] ? -10 : +10;
         }
 
-        tb.softbuffer.rx = &softbuffer_rx;
-        srsran_softbuffer_rx_reset(tb.softbuffer.rx);
+        // With deferred small code blocks, several copies are decoded together at the flush
+        srsran_sch_tb_res_nr_t res[MAX_NOF_DEFERRED] = {};
+        uint32_t               nof_copies            = SRSRAN_MAX(nof_deferred, 1);
+        for (uint32_t i = 0; i < nof_copies; i++) {
+          tb.softbuffer.rx = &softbuffer_rx[i];
+          srsran_softbuffer_rx_reset(tb.softbuffer.rx);
 
-        srsran_sch_tb_res_nr_t res = {};
-        res.payload                = data_rx;
-        if (srsran_dlsch_nr_decode(&sch_nr_rx, &pdsch_cfg.sch_cfg, &tb, llr, &res) < SRSRAN_SUCCESS) {
-          ERROR("Error encoding");
+          res[i].payload = data_rx + i * 1024 * 1024;
+          if (srsran_dlsch_nr_decode(&sch_nr_rx, &pdsch_cfg.sch_cfg, &tb, llr, &res[i]) < SRSRAN_SUCCESS) {
+            ERROR("Error encoding");
+            goto clean_exit;
+          }
+        }
+
+        if (srsran_sch_nr_decode_flush(&sch_nr_rx) < SRSRAN_SUCCESS) {
+          ERROR("Error decoding deferred transport blocks");
           goto clean_exit;
         }
 
-        if (rv == 0) {
-          if (!res.crc) {
+        for (uint32_t i = 0; i < nof_copies && rv == 0; i++) {
+          if (!res[i].crc) {
             ERROR("Failed to match CRC; n_prb=%d; mcs=%d; TBS=%d;", n_prb, mcs, tb.tbs);
             goto clean_exit;
           }
 
-          if (memcmp(data_tx, data_rx, tb.tbs / 8) != 0) {
+          if (memcmp(data_tx, res[i].payload, tb.tbs / 8) != 0) {
             ERROR("Failed to match Tx/Rx data; n_prb=%d; mcs=%d; TBS=%d;", n_prb, mcs, tb.tbs);
             printf("Tx data: ");
             srsran_vec_fprint_byte(stdout, data_tx, tb.tbs / 8);
             printf("Rx data: ");
-            srsran_vec_fprint_byte(stdout, data_rx, tb.tbs / 8);
+            srsran_vec_fprint_byte(stdout, res[i].payload, tb.tbs / 8);
             goto clean_exit;
           }
         }
@@ -240,6 +301,7 @@ clean_exit:
   srsran_random_free(rand_gen);
   srsran_sch_nr_free(&sch_nr_tx);
   srsran_sch_nr_free(&sch_nr_rx);
+  srsran_ldpc_accelerator_dev_free(&accelerator_dev);
   if (data_tx) {
     free(data_tx);
   }
@@ -252,8 +314,13 @@ clean_exit:
   if (encoded) {
     free(encoded);
   }
+  if (retx) {
+    free(retx);
+  }
   srsran_softbuffer_tx_free(&softbuffer_tx);
-  srsran_softbuffer_rx_free(&softbuffer_rx);
+  for (uint32_t i = 0; i < MAX_NOF_DEFERRED; i++) {
+    srsran_softbuffer_rx_free(&softbuffer_rx[i]);
+  }
 
   return ret;
 }
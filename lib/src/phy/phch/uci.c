@@ -287,6 +287,11 @@ int decode_cqi_long(srsran_uci_cqi_pusch_t* q, int16_t* q_bits, uint32_t Q, uint
 
 /* Encode UCI CQI/PMI
  */
+uint32_t srsran_uci_cqi_pusch_Q_prime(srsran_pusch_cfg_t* cfg, uint32_t cqi_len, float beta, uint32_t Q_prime_ri)
+{
+  return Q_prime_cqi(cfg, cqi_len, beta, Q_prime_ri);
+}
+
 int srsran_uci_decode_cqi_pusch(srsran_uci_cqi_pusch_t* q,
                                 srsran_pusch_cfg_t*     cfg,
                                 int16_t*                q_bits,
@@ -631,10 +636,11 @@ int srsran_uci_encode_ack_ri(srsran_pusch_cfg_t* cfg,
   return (int)Q_prime;
 }
 
-/* Decode UCI ACK/RI bits as described in 5.2.2.6 of 36.212
+/* Decode UCI ACK/RI bits as described in 5.2.2.6 of 36.212. If q_bits_scrambled is set, the LLRs are descrambled with
+ * c_seq as they are read.
  *  Currently only supporting 1-bit RI
  */
-int srsran_uci_decode_ack_ri(srsran_pusch_cfg_t* cfg,
+static int uci_decode_ack_ri(srsran_pusch_cfg_t* cfg,
                              int16_t*            q_bits,
                              uint8_t*            c_seq,
                              float               beta,
@@ -644,7 +650,8 @@ int srsran_uci_decode_ack_ri(srsran_pusch_cfg_t* cfg,
                              uint8_t*            data,
                              bool*               valid,
                              uint32_t            nof_bits,
-                             bool                is_ri)
+                             bool                is_ri,
+                             bool                q_bits_scrambled)
 {
   if (beta < 0) {
     ERROR("Error beta (%f) is reserved", beta);
@@ -675,6 +682,11 @@ int srsran_uci_decode_ack_ri(srsran_pusch_cfg_t* cfg,
 
       int16_t q = q_bits[pos];
 
+      // Descramble
+      if (q_bits_scrambled && c_seq[pos]) {
+        q = -q;
+      }
+
       // Remove scrambling of repeated bits
       if (nof_bits == 1) {
         if (acc_idx == 1 && pos > 0) {
@@ -713,6 +725,38 @@ int srsran_uci_decode_ack_ri(srsran_pusch_cfg_t* cfg,
   return (int)Qprime;
 }
 
+int srsran_uci_decode_ack_ri(srsran_pusch_cfg_t* cfg,
+                             int16_t*            q_bits,
+                             uint8_t*            c_seq,
+                             float               beta,
+                             uint32_t            H_prime_total,
+                             uint32_t            O_cqi,
+                             srsran_uci_bit_t*   ack_ri_bits,
+                             uint8_t*            data,
+                             bool*               valid,
+                             uint32_t            nof_bits,
+                             bool                is_ri)
+{
+  return uci_decode_ack_ri(
+      cfg, q_bits, c_seq, beta, H_prime_total, O_cqi, ack_ri_bits, data, valid, nof_bits, is_ri, false);
+}
+
+int srsran_uci_decode_ack_ri_scrambled(srsran_pusch_cfg_t* cfg,
+                                       int16_t*            q_bits,
+                                       uint8_t*            c_seq,
+                                       float               beta,
+                                       uint32_t            H_prime_total,
+                                       uint32_t            O_cqi,
+                                       srsran_uci_bit_t*   ack_ri_bits,
+                                       uint8_t*            data,
+                                       bool*               valid,
+                                       uint32_t            nof_bits,
+                                       bool                is_ri)
+{
+  return uci_decode_ack_ri(
+      cfg, q_bits, c_seq, beta, H_prime_total, O_cqi, ack_ri_bits, data, valid, nof_bits, is_ri, true);
+}
+
 uint32_t srsran_uci_cfg_total_ack(const srsran_uci_cfg_t* uci_cfg)
 {
   uint32_t nof_ack = 0;
@@ -0,0 +1,348 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/resampling/resample_poly.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+/**
+ * Kaiser window shape, about 70 dB of stop band attenuation
+ */
+#define RESAMPLE_POLY_KAISER_BETA 7.0
+
+/**
+ * Maximum interpolation factor after reducing the ratio, it bounds the prototype filter length
+ */
+#define RESAMPLE_POLY_MAX_INTERP 1024
+
+/**
+ * Number of input samples of the resampler, and output samples of the channelizer branches, processed at once
+ */
+#define RESAMPLE_POLY_BLOCK_LEN 1024
+
+static uint32_t resample_poly_gcd(uint32_t a, uint32_t b)
+{
+  while (b != 0) {
+    uint32_t t = a % b;
+    a          = b;
+    b          = t;
+  }
+  return a;
+}
+
+/* Zeroth order modified Bessel function of the first kind */
+static double resample_poly_bessel_i0(double x)
+{
+  double sum  = 1.0;
+  double term = 1.0;
+  for (uint32_t k = 1; k < 64 && term > 1e-12 * sum; k++) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+/*
+ * Designs a len long Kaiser windowed sinc low-pass filter with cut-off frequency fc, normalised to the sampling rate,
+ * and stores it split in nof_branches branches of len / nof_branches time reversed coefficients. Branch b takes the
+ * coefficients b, b + nof_branches, b + 2 * nof_branches...
+ */
+static void resample_poly_design(float* taps, uint32_t nof_branches, uint32_t taps_per_branch, double fc, double gain)
+{
+  uint32_t len    = nof_branches * taps_per_branch;
+  double   centre = (len - 1) / 2.0;
+  double   i0     = resample_poly_bessel_i0(RESAMPLE_POLY_KAISER_BETA);
+
+  for (uint32_t n = 0; n < len; n++) {
+    double t    = n - centre;
+    double sinc = fabs(t) < 1e-9 ? 1.0 : sin(2.0 * M_PI * fc * t) / (2.0 * M_PI * fc * t);
+    double r    = centre > 0.0 ? t / centre : 0.0;
+    double w    = resample_poly_bessel_i0(RESAMPLE_POLY_KAISER_BETA * sqrt(SRSRAN_MAX(0.0, 1.0 - r * r))) / i0;
+
+    uint32_t branch = n % nof_branches;
+    uint32_t idx    = n / nof_branches;
+    taps[branch * taps_per_branch + taps_per_branch - 1 - idx] = (float)(gain * 2.0 * fc * sinc * w);
+  }
+}
+
+int srsran_resample_poly_init(srsran_resample_poly_t* q, uint32_t interp, uint32_t decim, uint32_t taps_per_phase)
+{
+  if (q == NULL || interp == 0 || decim == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  memset(q, 0, sizeof(srsran_resample_poly_t));
+
+  uint32_t gcd      = resample_poly_gcd(interp, decim);
+  q->interp         = interp / gcd;
+  q->decim          = decim / gcd;
+  q->taps_per_phase = taps_per_phase ? taps_per_phase : SRSRAN_RESAMPLE_POLY_DEFAULT_TAPS;
+
+  if (q->interp > RESAMPLE_POLY_MAX_INTERP) {
+    ERROR("Resampling ratio %d/%d is too fine", q->interp, q->decim);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  q->taps    = srsran_vec_f_malloc(q->interp * q->taps_per_phase);
+  q->history = srsran_vec_cf_malloc(q->taps_per_phase - 1 + RESAMPLE_POLY_BLOCK_LEN);
+  if (q->taps == NULL || q->history == NULL) {
+    srsran_resample_poly_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  // The prototype runs at interp times the input rate and keeps the narrower of the input and output bands
+  double fc = 0.5 / SRSRAN_MAX(q->interp, q->decim);
+  resample_poly_design(q->taps, q->interp, q->taps_per_phase, fc, q->interp);
+
+  srsran_resample_poly_reset(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_resample_poly_reset(srsran_resample_poly_t* q)
+{
+  if (q == NULL || q->history == NULL) {
+    return;
+  }
+
+  q->phase = 0;
+  srsran_vec_cf_zero(q->history, q->taps_per_phase - 1);
+}
+
+uint32_t srsran_resample_poly_get_nof_out(const srsran_resample_poly_t* q, uint32_t nof_in)
+{
+  if (q == NULL || q->decim == 0) {
+    return 0;
+  }
+
+  // Output n is produced by the input (phase + n * decim) / interp
+  uint64_t span = (uint64_t)nof_in * q->interp;
+  if (span <= q->phase) {
+    return 0;
+  }
+  return (uint32_t)((span - q->phase + q->decim - 1) / q->decim);
+}
+
+uint32_t srsran_resample_poly_get_nof_in(const srsran_resample_poly_t* q, uint32_t nof_out)
+{
+  if (q == NULL || q->interp == 0 || nof_out == 0) {
+    return 0;
+  }
+
+  return (uint32_t)(((uint64_t)q->phase + (uint64_t)(nof_out - 1) * q->decim) / q->interp + 1);
+}
+
+float srsran_resample_poly_get_delay(const srsran_resample_poly_t* q)
+{
+  if (q == NULL || q->decim == 0) {
+    return 0.0f;
+  }
+
+  return (float)(q->interp * q->taps_per_phase - 1) / (2.0f * q->decim);
+}
+
+int srsran_resample_poly_run(srsran_resample_poly_t* q, const cf_t* input, cf_t* output, uint32_t nof_in)
+{
+  if (q == NULL || q->taps == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t T     = q->taps_per_phase;
+  uint32_t count = 0;
+
+  while (nof_in > 0) {
+    uint32_t n = SRSRAN_MIN(nof_in, RESAMPLE_POLY_BLOCK_LEN);
+    if (input) {
+      srsran_vec_cf_copy(&q->history[T - 1], input, n);
+      input += n;
+    } else {
+      srsran_vec_cf_zero(&q->history[T - 1], n);
+    }
+
+    // Every input sample produces the outputs of the branches below interp, the window ends at the new sample
+    for (uint32_t i = 0; i < n; i++) {
+      const cf_t* window = &q->history[i];
+      while (q->phase < q->interp) {
+        if (output) {
+          output[count] = srsran_vec_dot_prod_cfc(window, &q->taps[q->phase * T], T);
+        }
+        count++;
+        q->phase += q->decim;
+      }
+      q->phase -= q->interp;
+    }
+
+    // Keep the last samples for the next block
+    memmove(q->history, &q->history[n], sizeof(cf_t) * (T - 1));
+
+    nof_in -= n;
+  }
+
+  return (int)count;
+}
+
+void srsran_resample_poly_free(srsran_resample_poly_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->taps) {
+    free(q->taps);
+  }
+  if (q->history) {
+    free(q->history);
+  }
+
+  memset(q, 0, sizeof(srsran_resample_poly_t));
+}
+
+int srsran_channelizer_init(srsran_channelizer_t* q, uint32_t nof_channels, uint32_t taps_per_branch)
+{
+  if (q == NULL || nof_channels < 2) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  memset(q, 0, sizeof(srsran_channelizer_t));
+
+  q->nof_channels    = nof_channels;
+  q->taps_per_branch = taps_per_branch ? taps_per_branch : SRSRAN_RESAMPLE_POLY_DEFAULT_TAPS;
+
+  q->taps     = srsran_vec_f_malloc(nof_channels * q->taps_per_branch);
+  q->branches = calloc(nof_channels, sizeof(cf_t*));
+  q->dft_in   = srsran_vec_cf_malloc(nof_channels);
+  q->dft_out  = srsran_vec_cf_malloc(nof_channels);
+  if (q->taps == NULL || q->branches == NULL || q->dft_in == NULL || q->dft_out == NULL) {
+    srsran_channelizer_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t r = 0; r < nof_channels; r++) {
+    q->branches[r] = srsran_vec_cf_malloc(q->taps_per_branch - 1 + RESAMPLE_POLY_BLOCK_LEN);
+    if (q->branches[r] == NULL) {
+      srsran_channelizer_free(q);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  if (srsran_dft_plan_c(&q->ifft, nof_channels, SRSRAN_DFT_BACKWARD) < SRSRAN_SUCCESS) {
+    ERROR("Error planning channelizer DFT");
+    srsran_channelizer_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  // Every channel keeps the band of one channel spacing, with unit gain
+  resample_poly_design(q->taps, nof_channels, q->taps_per_branch, 0.5 / nof_channels, 1.0);
+
+  srsran_channelizer_reset(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_channelizer_reset(srsran_channelizer_t* q)
+{
+  if (q == NULL || q->branches == NULL) {
+    return;
+  }
+
+  for (uint32_t r = 0; r < q->nof_channels; r++) {
+    srsran_vec_cf_zero(q->branches[r], q->taps_per_branch - 1);
+  }
+}
+
+int srsran_channelizer_run(srsran_channelizer_t* q, const cf_t* input, cf_t** output, uint32_t nof_in)
+{
+  if (q == NULL || input == NULL || output == NULL || q->branches == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t N = q->nof_channels;
+  uint32_t T = q->taps_per_branch;
+  if (nof_in % N != 0) {
+    ERROR("The number of samples (%d) is not a multiple of the number of channels (%d)", nof_in, N);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t nof_out = nof_in / N;
+  for (uint32_t m0 = 0; m0 < nof_out; m0 += RESAMPLE_POLY_BLOCK_LEN) {
+    uint32_t n = SRSRAN_MIN(nof_out - m0, RESAMPLE_POLY_BLOCK_LEN);
+
+    // Branch r takes the samples N - 1 - r of every block of N samples
+    for (uint32_t r = 0; r < N; r++) {
+      cf_t* branch = &q->branches[r][T - 1];
+      for (uint32_t m = 0; m < n; m++) {
+        branch[m] = input[(m0 + m) * N + N - 1 - r];
+      }
+    }
+
+    for (uint32_t m = 0; m < n; m++) {
+      // The channel outputs are aligned to the last sample of the block, which shifts the branches by one
+      for (uint32_t r = 0; r < N; r++) {
+        q->dft_in[(r + 1) % N] = srsran_vec_dot_prod_cfc(&q->branches[r][m], &q->taps[r * T], T);
+      }
+
+      srsran_dft_run_c(&q->ifft, q->dft_in, q->dft_out);
+
+      for (uint32_t k = 0; k < N; k++) {
+        output[k][m0 + m] = q->dft_out[k];
+      }
+    }
+
+    // Keep the last samples of every branch for the next block
+    for (uint32_t r = 0; r < N; r++) {
+      memmove(q->branches[r], &q->branches[r][n], sizeof(cf_t) * (T - 1));
+    }
+  }
+
+  return (int)nof_out;
+}
+
+void srsran_channelizer_free(srsran_channelizer_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->branches) {
+    for (uint32_t r = 0; r < q->nof_channels; r++) {
+      if (q->branches[r]) {
+        free(q->branches[r]);
+      }
+    }
+    free(q->branches);
+  }
+  if (q->taps) {
+    free(q->taps);
+  }
+  if (q->dft_in) {
+    free(q->dft_in);
+  }
+  if (q->dft_out) {
+    free(q->dft_out);
+  }
+  srsran_dft_plan_free(&q->ifft);
+
+  memset(q, 0, sizeof(srsran_channelizer_t));
+}
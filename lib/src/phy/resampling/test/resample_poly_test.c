@@ -0,0 +1,270 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/resample_poly.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static uint32_t buffer_size  = 23040;
+static uint32_t interp       = 3;
+static uint32_t decim        = 4;
+static uint32_t nof_channels = 0;
+static float    tone_freq    = 0.05f;
+
+#define MAX_CHANNELS 16
+
+// The stream is processed in blocks of changing size to exercise the filter state
+static const uint32_t block_sizes[] = {1000, 1, 333, 4096, 17};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [sidcf]\n", prog);
+  printf("\t-s Number of input samples [Default %d]\n", buffer_size);
+  printf("\t-i Interpolation factor [Default %d]\n", interp);
+  printf("\t-d Decimation factor [Default %d]\n", decim);
+  printf("\t-c Number of channels, tests the channelizer instead of the resampler [Default %d]\n", nof_channels);
+  printf("\t-f Tone frequency, normalised to the input rate [Default %.2f]\n", tone_freq);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "sidcfv")) != -1) {
+    switch (opt) {
+      case 's':
+        buffer_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'i':
+        interp = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        decim = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        nof_channels = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        tone_freq = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/* Generates the tone a * exp(j*2*pi*f*n) accurately enough to measure the filters against it */
+static void gen_tone(cf_t* x, uint32_t len, float a, double f)
+{
+  for (uint32_t n = 0; n < len; n++) {
+    x[n] = a * cexp(I * 2.0 * M_PI * f * n);
+  }
+}
+
+/* Relative error power, in dB, of x against a tone of amplitude a and frequency f starting with phase 2*pi*f*t0 */
+static float tone_error_db(const cf_t* x, uint32_t len, float a, double f, double t0)
+{
+  double err = 0.0;
+  for (uint32_t n = 0; n < len; n++) {
+    cf_t expected = a * cexp(I * 2.0 * M_PI * f * (n + t0));
+    err += cabsf(x[n] - expected) * cabsf(x[n] - expected);
+  }
+  return srsran_convert_power_to_dB((float)(err / len) / (a * a + 1e-12f));
+}
+
+static int test_resampler(void)
+{
+  struct timeval         t[3] = {};
+  srsran_resample_poly_t q    = {};
+
+  if (srsran_resample_poly_init(&q, interp, decim, 0) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating resampler");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t nof_out = srsran_resample_poly_get_nof_out(&q, buffer_size);
+  cf_t*    in      = srsran_vec_cf_malloc(buffer_size);
+  cf_t*    out     = srsran_vec_cf_malloc(nof_out);
+  if (in == NULL || out == NULL) {
+    return SRSRAN_ERROR;
+  }
+  gen_tone(in, buffer_size, 1.0f, tone_freq);
+
+  int      ret   = SRSRAN_SUCCESS;
+  uint32_t count = 0;
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0, b = 0; i < buffer_size; b++) {
+    uint32_t n        = SRSRAN_MIN(block_sizes[b % 5], buffer_size - i);
+    uint32_t expected = srsran_resample_poly_get_nof_out(&q, n);
+    int      nout     = srsran_resample_poly_run(&q, &in[i], &out[count], n);
+    if (nout != (int)expected) {
+      ERROR("Block of %d samples produced %d samples, %d expected", n, nout, expected);
+      ret = SRSRAN_ERROR;
+      break;
+    }
+    count += nout;
+    i += n;
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t duration_us = (uint64_t)(t[0].tv_sec * 1000000UL + t[0].tv_usec);
+
+  if (count != nof_out) {
+    ERROR("Produced %d samples, %d expected", count, nof_out);
+    ret = SRSRAN_ERROR;
+  }
+
+  // Skip the filter transient and compare against the tone at the output rate
+  float    delay = srsran_resample_poly_get_delay(&q);
+  uint32_t skip  = (uint32_t)ceilf(2 * delay);
+  double   f_out = tone_freq * q.decim / q.interp;
+  float    err   = skip < count ? tone_error_db(&out[skip], count - skip, 1.0f, f_out, skip - delay) : 0.0f;
+
+  printf("Resampled %d/%d %d to %d samples at %.1f Msps; error: %.1f dB\n",
+         q.interp,
+         q.decim,
+         buffer_size,
+         count,
+         buffer_size / (double)duration_us,
+         err);
+
+  if (err > -40.0f) {
+    ret = SRSRAN_ERROR;
+  }
+
+  srsran_resample_poly_free(&q);
+  free(in);
+  free(out);
+
+  return ret;
+}
+
+static int test_channelizer(void)
+{
+  struct timeval       t[3]                    = {};
+  srsran_channelizer_t q                       = {};
+  cf_t*                out[MAX_CHANNELS]       = {};
+  cf_t*                tone                    = NULL;
+  float                amplitude[MAX_CHANNELS] = {};
+
+  if (nof_channels > MAX_CHANNELS || srsran_channelizer_init(&q, nof_channels, 0) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating channelizer");
+    return SRSRAN_ERROR;
+  }
+
+  // Tones on the first and the last (negative) channels, the rest shall stay empty
+  uint32_t nof_in  = buffer_size - buffer_size % nof_channels;
+  uint32_t nof_out = nof_in / nof_channels;
+  double   delta   = tone_freq / nof_channels;
+
+  amplitude[1]                = 1.0f;
+  amplitude[nof_channels - 1] = 0.5f;
+
+  cf_t* in = srsran_vec_cf_malloc(nof_in);
+  tone     = srsran_vec_cf_malloc(nof_in);
+  if (in == NULL || tone == NULL) {
+    return SRSRAN_ERROR;
+  }
+  srsran_vec_cf_zero(in, nof_in);
+  for (uint32_t k = 0; k < nof_channels; k++) {
+    out[k] = srsran_vec_cf_malloc(nof_out);
+    if (out[k] == NULL) {
+      return SRSRAN_ERROR;
+    }
+    if (amplitude[k] > 0.0f) {
+      gen_tone(tone, nof_in, amplitude[k], (double)k / nof_channels + delta);
+      srsran_vec_sum_ccc(in, tone, in, nof_in);
+    }
+  }
+
+  int      ret   = SRSRAN_SUCCESS;
+  uint32_t count = 0;
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0, b = 0; i < nof_in; b++) {
+    uint32_t n = SRSRAN_MIN(block_sizes[b % 5] * nof_channels, nof_in - i);
+
+    cf_t* ptr[MAX_CHANNELS];
+    for (uint32_t k = 0; k < nof_channels; k++) {
+      ptr[k] = &out[k][count];
+    }
+    int nout = srsran_channelizer_run(&q, &in[i], ptr, n);
+    if (nout != (int)(n / nof_channels)) {
+      ERROR("Block of %d samples produced %d samples per channel", n, nout);
+      ret = SRSRAN_ERROR;
+      break;
+    }
+    count += nout;
+    i += n;
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t duration_us = (uint64_t)(t[0].tv_sec * 1000000UL + t[0].tv_usec);
+
+  // Every channel is aligned to the last sample of its block, delayed by the prototype filter
+  double   delay = (nof_channels * q.taps_per_branch - 1) / 2.0;
+  uint32_t skip  = q.taps_per_branch;
+  for (uint32_t k = 0; k < nof_channels && ret == SRSRAN_SUCCESS && skip < count; k++) {
+    float err = 0.0f;
+    if (amplitude[k] > 0.0f) {
+      double t0 = (nof_channels - 1 - delay) / nof_channels + skip;
+      err       = tone_error_db(&out[k][skip], count - skip, amplitude[k], delta * nof_channels, t0);
+    } else {
+      err = srsran_convert_power_to_dB(srsran_vec_avg_power_cf(&out[k][skip], count - skip));
+    }
+    printf("Channel %d: %s %.1f dB\n", k, amplitude[k] > 0.0f ? "error" : "power", err);
+
+    if (err > -40.0f) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  printf("Channelized %d samples in %d channels at %.1f Msps\n", nof_in, nof_channels, nof_in / (double)duration_us);
+
+  srsran_channelizer_free(&q);
+  for (uint32_t k = 0; k < nof_channels; k++) {
+    if (out[k]) {
+      free(out[k]);
+    }
+  }
+  free(in);
+  free(tone);
+
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  int ret = nof_channels ? test_channelizer() : test_resampler();
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
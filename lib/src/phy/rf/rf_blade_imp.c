@@ -231,6 +231,7 @@ int rf_blade_open(char* args, void** h)
   handler->info.max_tx_gain = range_tx->max;
   handler->info.min_rx_gain = range_rx->min;
   handler->info.max_rx_gain = range_rx->max;
+  handler->info.sc16        = false;
 
   return SRSRAN_SUCCESS;
 
@@ -62,6 +62,20 @@ static srsran_rf_plugin_t plugin_zmq   = {"", NULL, &srsran_rf_dev_zmq};
 #endif
 #endif
 
+/* Define implementation for shared memory */
+#ifdef ENABLE_SHM
+#ifdef ENABLE_RF_PLUGINS
+static srsran_rf_plugin_t plugin_shm = {"libsrsran_rf_shm.so", NULL, NULL};
+#else
+#include "rf_shm_imp.h"
+static srsran_rf_plugin_t plugin_shm   = {"", NULL, &srsran_rf_dev_shm};
+#endif
+#endif
+
+/* Define implementation for memory-mapped IQ recordings */
+#include "rf_iq_imp.h"
+static srsran_rf_plugin_t plugin_iq = {"", NULL, &srsran_rf_dev_iq};
+
 /* Define implementation for file-based RF */
 #include "rf_file_imp.h"
 static srsran_rf_plugin_t plugin_file = {"", NULL, &srsran_rf_dev_file};
@@ -111,11 +125,15 @@ static srsran_rf_plugin_t* rf_plugins[] = {
 #ifdef ENABLE_ZEROMQ
     &plugin_zmq,
 #endif
+#ifdef ENABLE_SHM
+    &plugin_shm,
+#endif
 #ifdef ENABLE_SIDEKIQ
     &plugin_skiq,
 #endif
 #ifdef ENABLE_DUMMY_DEV
     &plugin_dummy,
 #endif
+    &plugin_iq,
     &plugin_file,
     NULL};
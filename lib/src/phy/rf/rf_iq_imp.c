@@ -0,0 +1,703 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "rf_iq_imp.h"
+#include "rf_helper.h"
+#include "rf_iq_imp_trx.h"
+#include <inttypes.h>
+#include <math.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/common/timestamp.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+  // Common attributes
+  srsran_rf_info_t info;
+  uint32_t         nof_channels;
+
+  // RF State
+  uint32_t srate; // radio rate configured by upper layers
+  uint32_t base_srate;
+  uint32_t decim_factor; // decimation factor between base_srate used on transport on radio's rate
+  uint32_t buffer_sz;    // longest reception and transmission at the base rate, in samples
+  double   rx_gain;
+  double   tx_gain;
+  bool     realtime; // receptions follow the wall clock, otherwise they return as fast as possible
+
+  // Replayed and recorded files
+  bool       rx_enabled;
+  bool       tx_enabled;
+  rf_iq_rx_t replayer;
+  rf_iq_tx_t recorder;
+  uint64_t   rx_start; // first replayed sample, relative to the start of the recording
+  bool       rx_loop;
+  bool       rx_eof;
+
+  // Various sample buffers
+  cf_t* buffer_decimation[SRSRAN_MAX_CHANNELS];
+  cf_t* buffer_tx;
+
+  // Rx timestamp and the wall clock reference that paces it
+  uint64_t        next_rx_ts;
+  uint64_t        next_tx_ts;
+  bool            rx_started;
+  uint64_t        clock_ts;
+  struct timespec clock_ref;
+
+  pthread_mutex_t tx_config_mutex;
+  pthread_mutex_t decim_mutex;
+  pthread_mutex_t rx_gain_mutex;
+} rf_iq_handler_t;
+
+static void update_rates(rf_iq_handler_t* handler, double srate);
+
+/*
+ * Static Atributes
+ */
+const char iq_devname[4] = "iq";
+
+/*
+ * Static methods
+ */
+
+// Sleeps until the wall clock reaches the given timestamp, the first call sets the reference
+static void rf_iq_pace(rf_iq_handler_t* handler, uint64_t ts)
+{
+  if (!handler->rx_started) {
+    clock_gettime(CLOCK_MONOTONIC, &handler->clock_ref);
+    handler->clock_ts   = ts;
+    handler->rx_started = true;
+    return;
+  }
+
+  uint64_t        elapsed = ts - handler->clock_ts;
+  struct timespec target  = handler->clock_ref;
+  target.tv_sec += (time_t)(elapsed / handler->base_srate);
+  target.tv_nsec += (long)((elapsed % handler->base_srate) * 1000000000UL / handler->base_srate);
+  if (target.tv_nsec >= 1000000000L) {
+    target.tv_sec++;
+    target.tv_nsec -= 1000000000L;
+  }
+
+  clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, NULL);
+}
+
+// Reads a channel from a relative sample, wrapping to rx_start at the end of the recording if it loops
+static int rf_iq_replay(rf_iq_handler_t* handler, uint32_t ch, uint64_t n, cf_t* buffer, uint32_t nsamples)
+{
+  uint64_t nof_samples = handler->replayer.hdr->nof_samples;
+  uint32_t count       = 0;
+
+  while (count < nsamples) {
+    uint64_t pos = n + count;
+    if (handler->rx_loop) {
+      pos = handler->rx_start + (pos - handler->rx_start) % (nof_samples - handler->rx_start);
+    }
+    int ret = rf_iq_rx_read(&handler->replayer, ch, pos, &buffer[count], nsamples - count);
+    if (ret <= 0) {
+      return (ret < 0) ? ret : SRSRAN_ERROR_RX_EOF;
+    }
+    count += ret;
+  }
+
+  return (int)count;
+}
+
+/*
+ * Public methods
+ */
+
+void rf_iq_suppress_stdout(void* h)
+{
+  // do nothing
+}
+
+void rf_iq_register_error_handler(void* h, srsran_rf_error_handler_t new_handler, void* arg)
+{
+  // do nothing
+}
+
+const char* rf_iq_devname(void* h)
+{
+  return iq_devname;
+}
+
+int rf_iq_start_rx_stream(void* h, bool now)
+{
+  return SRSRAN_SUCCESS;
+}
+
+int rf_iq_stop_rx_stream(void* h)
+{
+  return SRSRAN_SUCCESS;
+}
+
+void rf_iq_flush_buffer(void* h)
+{
+  // do nothing
+}
+
+bool rf_iq_has_rssi(void* h)
+{
+  return false;
+}
+
+float rf_iq_get_rssi(void* h)
+{
+  return 0.0;
+}
+
+int rf_iq_open(char* args, void** h)
+{
+  return rf_iq_open_multi(args, h, 1);
+}
+
+int rf_iq_open_multi(char* args, void** h, uint32_t nof_channels)
+{
+  int ret = SRSRAN_ERROR;
+  if (h && nof_channels < SRSRAN_MAX_CHANNELS) {
+    *h = NULL;
+
+    rf_iq_handler_t* handler = (rf_iq_handler_t*)malloc(sizeof(rf_iq_handler_t));
+    if (!handler) {
+      perror("malloc");
+      return SRSRAN_ERROR;
+    }
+    bzero(handler, sizeof(rf_iq_handler_t));
+    *h                        = handler;
+    handler->base_srate       = IQ_BASERATE_DEFAULT_HZ; // Sample rate for 100 PRB cell
+    handler->realtime         = true;
+    handler->info.max_rx_gain = IQ_MAX_GAIN_DB;
+    handler->info.min_rx_gain = IQ_MIN_GAIN_DB;
+    handler->info.max_tx_gain = IQ_MAX_GAIN_DB;
+    handler->info.min_tx_gain = IQ_MIN_GAIN_DB;
+    handler->nof_channels     = nof_channels;
+
+    if (pthread_mutex_init(&handler->tx_config_mutex, NULL)) {
+      perror("Mutex init");
+    }
+    if (pthread_mutex_init(&handler->decim_mutex, NULL)) {
+      perror("Mutex init");
+    }
+    if (pthread_mutex_init(&handler->rx_gain_mutex, NULL)) {
+      perror("Mutex init");
+    }
+
+    // parse args
+    char           rx_file[RF_PARAM_LEN] = {};
+    char           tx_file[RF_PARAM_LEN] = {};
+    char           tmp[RF_PARAM_LEN]     = {};
+    rf_iq_format_t format                = IQ_FORMAT_SC16;
+    uint32_t       rx_start_ms           = 0;
+    if (args && strlen(args)) {
+      // base_srate, only used for recording without replay
+      parse_uint32(args, "base_srate", -1, &handler->base_srate);
+
+      // rx_file, recording to replay
+      parse_string(args, "rx_file", -1, rx_file);
+
+      // tx_file, recording to create
+      parse_string(args, "tx_file", -1, tx_file);
+
+      // format of the new recording
+      if (parse_string(args, "format", -1, tmp) == SRSRAN_SUCCESS) {
+        if (!strcmp(tmp, "fc32")) {
+          format = IQ_FORMAT_FC32;
+        } else if (strcmp(tmp, "sc16") != 0) {
+          fprintf(stderr, "[iq] Error: unsupported format %s\n", tmp);
+          goto clean_exit;
+        }
+      }
+
+      // pace, fast decouples the receptions from the wall clock
+      if (parse_string(args, "pace", -1, tmp) == SRSRAN_SUCCESS) {
+        if (!strcmp(tmp, "fast")) {
+          handler->realtime = false;
+        } else if (strcmp(tmp, "realtime") != 0) {
+          fprintf(stderr, "[iq] Error: unsupported pace %s\n", tmp);
+          goto clean_exit;
+        }
+      }
+
+      // rx_start_ms, the replay can start anywhere in the recording
+      parse_uint32(args, "rx_start_ms", -1, &rx_start_ms);
+
+      // rx_loop
+      if (parse_string(args, "rx_loop", -1, tmp) == SRSRAN_SUCCESS) {
+        handler->rx_loop = !strcmp(tmp, "true");
+      }
+    }
+
+    // Without files the device is not usable, it shall not be picked by the automatic device selection
+    if (strlen(rx_file) == 0 && strlen(tx_file) == 0) {
+      fprintf(stderr, "[iq] Error: RF device args rx_file and/or tx_file are required for the IQ file no-RF module\n");
+      goto clean_exit;
+    }
+
+    // initialize replayer, the recording sets the base rate
+    if (strlen(rx_file)) {
+      if (rf_iq_rx_open(&handler->replayer, rx_file) != SRSRAN_SUCCESS) {
+        goto clean_exit;
+      }
+      const rf_iq_file_hdr_t* hdr = handler->replayer.hdr;
+      if (hdr->nof_channels < handler->nof_channels) {
+        fprintf(stderr, "[iq] Error: %s has %d channels, %d are needed\n", rx_file, hdr->nof_channels, nof_channels);
+        goto clean_exit;
+      }
+      handler->base_srate = hdr->base_srate;
+      handler->rx_start   = (uint64_t)rx_start_ms * hdr->base_srate / 1000;
+      if (handler->rx_start >= hdr->nof_samples) {
+        fprintf(stderr, "[iq] Error: %s is shorter than %d ms\n", rx_file, rx_start_ms);
+        goto clean_exit;
+      }
+      handler->next_rx_ts = hdr->first_ts + handler->rx_start;
+      handler->rx_enabled = true;
+      printf("[iq] Replaying %.3f s of %d channels from %s\n",
+             (double)(hdr->nof_samples - handler->rx_start) / hdr->base_srate,
+             hdr->nof_channels,
+             rx_file);
+    } else {
+      fprintf(stdout, "[iq] Rx file not specified. Receiving zeros.\n");
+    }
+
+    // initialize recorder
+    if (strlen(tx_file)) {
+      if (rf_iq_tx_open(&handler->recorder, tx_file, format, nof_channels, handler->base_srate) != SRSRAN_SUCCESS) {
+        goto clean_exit;
+      }
+      handler->tx_enabled = true;
+    }
+
+    update_rates(handler, 1.92e6);
+
+    // Create decimation and interpolation buffers
+    handler->buffer_sz = handler->base_srate * IQ_MAX_BUFFER_MS / 1000;
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      handler->buffer_decimation[i] = srsran_vec_cf_malloc(handler->buffer_sz);
+      if (!handler->buffer_decimation[i]) {
+        fprintf(stderr, "Error: allocating decimation buffer\n");
+        goto clean_exit;
+      }
+    }
+
+    handler->buffer_tx = srsran_vec_cf_malloc(handler->buffer_sz);
+    if (!handler->buffer_tx) {
+      fprintf(stderr, "Error: allocating tx buffer\n");
+      goto clean_exit;
+    }
+
+    ret = SRSRAN_SUCCESS;
+
+  clean_exit:
+    if (ret) {
+      rf_iq_close(handler);
+      *h = NULL;
+    }
+  }
+  return ret;
+}
+
+int rf_iq_close(void* h)
+{
+  rf_iq_handler_t* handler = (rf_iq_handler_t*)h;
+
+  rf_iq_rx_close(&handler->replayer);
+  rf_iq_tx_close(&handler->recorder);
+
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    if (handler->buffer_decimation[i]) {
+      free(handler->buffer_decimation[i]);
+    }
+  }
+
+  if (handler->buffer_tx) {
+    free(handler->buffer_tx);
+  }
+
+  pthread_mutex_destroy(&handler->tx_config_mutex);
+  pthread_mutex_destroy(&handler->decim_mutex);
+  pthread_mutex_destroy(&handler->rx_gain_mutex);
+
+  // Free all
+  free(handler);
+
+  return SRSRAN_SUCCESS;
+}
+void update_rates(rf_iq_handler_t* handler, double srate)
+{
+  pthread_mutex_lock(&handler->decim_mutex);
+  if (handler) {
+    // Decimation must be full integer
+    if (((uint64_t)handler->base_srate % (uint64_t)srate) == 0) {
+      handler->srate        = (uint32_t)srate;
+      handler->decim_factor = handler->base_srate / handler->srate;
+    } else {
+      fprintf(stderr,
+              "Error: couldn't update sample rate. %.2f is not divisible by %.2f\n",
+              srate / 1e6,
+              handler->base_srate / 1e6);
+    }
+    printf("Current sample rate is %.2f MHz with a base rate of %.2f MHz (x%d decimation)\n",
+           handler->srate / 1e6,
+           handler->base_srate / 1e6,
+           handler->decim_factor);
+  }
+  pthread_mutex_unlock(&handler->decim_mutex);
+}
+
+double rf_iq_set_rx_srate(void* h, double srate)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_iq_handler_t* handler = (rf_iq_handler_t*)h;
+    update_rates(handler, srate);
+    ret = handler->srate;
+  }
+  return ret;
+}
+
+double rf_iq_set_tx_srate(void* h, double srate)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_iq_handler_t* handler = (rf_iq_handler_t*)h;
+    update_rates(handler, srate);
+    ret = srate;
+  }
+  return ret;
+}
+
+int rf_iq_set_rx_gain(void* h, double gain)
+{
+  if (h) {
+    rf_iq_handler_t* handler = (rf_iq_handler_t*)h;
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    handler->rx_gain = gain;
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int rf_iq_set_rx_gain_ch(void* h, uint32_t ch, double gain)
+{
+  return rf_iq_set_rx_gain(h, gain);
+}
+
+int rf_iq_set_tx_gain(void* h, double gain)
+{
+  if (h) {
+    rf_iq_handler_t* handler = (rf_iq_handler_t*)h;
+    pthread_mutex_lock(&handler->tx_config_mutex);
+    handler->tx_gain = gain;
+    pthread_mutex_unlock(&handler->tx_config_mutex);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int rf_iq_set_tx_gain_ch(void* h, uint32_t ch, double gain)
+{
+  return rf_iq_set_tx_gain(h, gain);
+}
+
+double rf_iq_get_rx_gain(void* h)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_iq_handler_t* handler = (rf_iq_handler_t*)h;
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    ret = handler->rx_gain;
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
+  }
+  return ret;
+}
+
+double rf_iq_get_tx_gain(void* h)
+{
+  double ret = NAN;
+  if (h) {
+    rf_iq_handler_t* handler = (rf_iq_handler_t*)h;
+    pthread_mutex_lock(&handler->tx_config_mutex);
+    ret = handler->tx_gain;
+    pthread_mutex_unlock(&handler->tx_config_mutex);
+  }
+  return ret;
+}
+
+srsran_rf_info_t* rf_iq_get_info(void* h)
+{
+  srsran_rf_info_t* info = NULL;
+  if (h) {
+    rf_iq_handler_t* handler = (rf_iq_handler_t*)h;
+    info                      = &handler->info;
+  }
+  return info;
+}
+
+// The channels are mapped in order to the recorded channels, the frequency is not used
+double rf_iq_set_rx_freq(void* h, uint32_t ch, double freq)
+{
+  return freq;
+}
+
+double rf_iq_set_tx_freq(void* h, uint32_t ch, double freq)
+{
+  return freq;
+}
+
+void rf_iq_get_time(void* h, time_t* secs, double* frac_secs)
+{
+  if (h) {
+    rf_iq_handler_t*   handler = (rf_iq_handler_t*)h;
+    srsran_timestamp_t ts      = {};
+    srsran_timestamp_init_uint64(&ts, handler->next_rx_ts, handler->base_srate);
+    if (secs) {
+      *secs = ts.full_secs;
+    }
+
+    if (frac_secs) {
+      *frac_secs = ts.frac_secs;
+    }
+  }
+}
+
+int rf_iq_recv_with_time(void* h, void* data, uint32_t nsamples, bool blocking, time_t* secs, double* frac_secs)
+{
+  return rf_iq_recv_with_time_multi(h, &data, nsamples, blocking, secs, frac_secs);
+}
+
+int rf_iq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool blocking, time_t* secs, double* frac_secs)
+{
+  if (!h || !data) {
+    return SRSRAN_ERROR;
+  }
+
+  rf_iq_handler_t* handler = (rf_iq_handler_t*)h;
+
+  // Protect the access to decim_factor since is a shared variable
+  pthread_mutex_lock(&handler->decim_mutex);
+  uint32_t decim_factor = handler->decim_factor;
+  pthread_mutex_unlock(&handler->decim_mutex);
+
+  uint32_t nsamples_baserate = nsamples * decim_factor;
+  if (nsamples_baserate > handler->buffer_sz) {
+    fprintf(stderr,
+            "[iq] Error: Trying to receive %d samples but the buffers only keep %d.\n",
+            nsamples_baserate,
+            handler->buffer_sz);
+    return SRSRAN_ERROR;
+  }
+  uint64_t ts_end = handler->next_rx_ts + nsamples_baserate;
+
+  // set timestamp for this reception
+  if (secs != NULL && frac_secs != NULL) {
+    srsran_timestamp_t ts = {};
+    srsran_timestamp_init_uint64(&ts, handler->next_rx_ts, handler->base_srate);
+    *secs      = ts.full_secs;
+    *frac_secs = ts.frac_secs;
+  }
+
+  // Keep the reception in real time, unless it shall run as fast as possible
+  if (handler->realtime) {
+    rf_iq_pace(handler, ts_end);
+  }
+
+  for (uint32_t c = 0; c < handler->nof_channels; c++) {
+    // skip if buffer is not available
+    if (data[c] == NULL) {
+      continue;
+    }
+
+    cf_t* ptr = (decim_factor != 1) ? handler->buffer_decimation[c] : (cf_t*)data[c];
+    if (handler->rx_enabled) {
+      uint64_t n   = handler->next_rx_ts - handler->replayer.hdr->first_ts;
+      int      ret = rf_iq_replay(handler, c, n, ptr, nsamples_baserate);
+      if (ret < SRSRAN_SUCCESS) {
+        if (ret == SRSRAN_ERROR_RX_EOF && !handler->rx_eof) {
+          fprintf(stdout, "[iq] End of the recording\n");
+          handler->rx_eof = true;
+        }
+        return ret;
+      }
+    } else {
+      srsran_vec_cf_zero(ptr, nsamples_baserate);
+    }
+
+    // decimate if needed
+    if (decim_factor != 1) {
+      cf_t* dst = (cf_t*)data[c];
+      for (uint32_t i = 0, n = 0; i < nsamples; i++) {
+        // Averaging decimation
+        cf_t avg = 0.0f;
+        for (int j = 0; j < decim_factor; j++, n++) {
+          avg += ptr[n];
+        }
+        dst[i] = avg; // divide by decim_factor later via scale
+      }
+    }
+  }
+
+  // Set gain
+  pthread_mutex_lock(&handler->rx_gain_mutex);
+  float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
+  pthread_mutex_unlock(&handler->rx_gain_mutex);
+  // scale shall also incorporate decim_factor
+  if (decim_factor > 0) {
+    scale = scale / decim_factor;
+  }
+  if (scale != 1.0f) {
+    for (uint32_t c = 0; c < handler->nof_channels; c++) {
+      if (data[c]) {
+        srsran_vec_sc_prod_cfc(data[c], scale, data[c], nsamples);
+      }
+    }
+  }
+
+  // update rx time
+  handler->next_rx_ts = ts_end;
+
+  return nsamples;
+}
+
+int rf_iq_send_timed(void*  h,
+                     void*  data,
+                     int    nsamples,
+                     time_t secs,
+                     double frac_secs,
+                     bool   has_time_spec,
+                     bool   blocking,
+                     bool   is_start_of_burst,
+                     bool   is_end_of_burst)
+{
+  void* _data[4] = {data, NULL, NULL, NULL};
+
+  return rf_iq_send_timed_multi(
+      h, _data, nsamples, secs, frac_secs, has_time_spec, blocking, is_start_of_burst, is_end_of_burst);
+}
+
+int rf_iq_send_timed_multi(void*  h,
+                           void*  data[4],
+                           int    nsamples,
+                           time_t secs,
+                           double frac_secs,
+                           bool   has_time_spec,
+                           bool   blocking,
+                           bool   is_start_of_burst,
+                           bool   is_end_of_burst)
+{
+  if (!h || !data || nsamples <= 0) {
+    return SRSRAN_ERROR;
+  }
+
+  rf_iq_handler_t* handler = (rf_iq_handler_t*)h;
+
+  // Without recording the transmission is dropped
+  if (!handler->tx_enabled) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Load transmission gain
+  pthread_mutex_lock(&handler->tx_config_mutex);
+  float tx_gain = srsran_convert_dB_to_amplitude(handler->tx_gain);
+  pthread_mutex_unlock(&handler->tx_config_mutex);
+
+  // If the Tx gain is NAN, INF or 0.0, use 1.0
+  if (!isnormal(tx_gain)) {
+    tx_gain = 1.0f;
+  }
+
+  // Protect the access to decim_factor since is a shared variable
+  pthread_mutex_lock(&handler->decim_mutex);
+  uint32_t decim_factor = handler->decim_factor;
+  pthread_mutex_unlock(&handler->decim_mutex);
+
+  uint32_t nsamples_baseband = nsamples * decim_factor;
+  if (nsamples_baseband > handler->buffer_sz) {
+    fprintf(stderr, "Error: trying to transmit too many samples (%d > %d).\n", nsamples, handler->buffer_sz);
+    return SRSRAN_ERROR;
+  }
+
+  // The samples are stored at their timestamp, the gaps read as zeros. Untimed bursts follow the previous one
+  uint64_t tx_ts = handler->next_tx_ts;
+  if (has_time_spec) {
+    srsran_timestamp_t ts = {};
+    srsran_timestamp_init(&ts, secs, frac_secs);
+    tx_ts = srsran_timestamp_uint64(&ts, handler->base_srate);
+  }
+
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    cf_t* buf = (cf_t*)data[i];
+
+    if (buf != NULL && (decim_factor != 1 || tx_gain != 1.0f)) {
+      // perform zero order hold
+      cf_t* src = buf;
+      buf       = handler->buffer_tx;
+      for (uint32_t k = 0, n = 0; k < nsamples; k++) {
+        for (uint32_t j = 0; j < decim_factor; j++, n++) {
+          buf[n] = src[k];
+        }
+      }
+
+      // Scale according to current gain
+      srsran_vec_sc_prod_cfc(buf, tx_gain, buf, nsamples_baseband);
+    }
+
+    if (rf_iq_tx_write(&handler->recorder, i, tx_ts, buf, nsamples_baseband) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+  handler->next_tx_ts = tx_ts + nsamples_baseband;
+
+  return SRSRAN_SUCCESS;
+}
+
+rf_dev_t srsran_rf_dev_iq = {"iq",
+                             rf_iq_devname,
+                             rf_iq_start_rx_stream,
+                             rf_iq_stop_rx_stream,
+                             rf_iq_flush_buffer,
+                             rf_iq_has_rssi,
+                             rf_iq_get_rssi,
+                             rf_iq_suppress_stdout,
+                             rf_iq_register_error_handler,
+                             rf_iq_open,
+                             .srsran_rf_open_multi = rf_iq_open_multi,
+                             rf_iq_close,
+                             rf_iq_set_rx_srate,
+                             rf_iq_set_rx_gain,
+                             rf_iq_set_rx_gain_ch,
+                             rf_iq_set_tx_gain,
+                             rf_iq_set_tx_gain_ch,
+                             rf_iq_get_rx_gain,
+                             rf_iq_get_tx_gain,
+                             rf_iq_get_info,
+                             rf_iq_set_rx_freq,
+                             rf_iq_set_tx_srate,
+                             rf_iq_set_tx_freq,
+                             rf_iq_get_time,
+                             NULL,
+                             rf_iq_recv_with_time,
+                             rf_iq_recv_with_time_multi,
+                             rf_iq_send_timed,
+                             .srsran_rf_send_timed_multi = rf_iq_send_timed_multi};
@@ -0,0 +1,119 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "rf_iq_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+int rf_iq_rx_open(rf_iq_rx_t* q, const char* path)
+{
+  if (!q || !path) {
+    return SRSRAN_ERROR;
+  }
+
+  bzero(q, sizeof(rf_iq_rx_t));
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "[iq] Error: opening recording %s: %s\n", path, strerror(errno));
+    return SRSRAN_ERROR;
+  }
+
+  struct stat st = {};
+  if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(rf_iq_file_hdr_t)) {
+    fprintf(stderr, "[iq] Error: %s is not a recording\n", path);
+    close(fd);
+    return SRSRAN_ERROR;
+  }
+
+  void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    fprintf(stderr, "[iq] Error: mapping recording %s: %s\n", path, strerror(errno));
+    return SRSRAN_ERROR;
+  }
+  q->hdr    = (const rf_iq_file_hdr_t*)ptr;
+  q->map_sz = (size_t)st.st_size;
+
+  // Check the header, the recording shall contain all the samples it announces
+  const rf_iq_file_hdr_t* hdr = q->hdr;
+  q->sample_sz                = rf_iq_sample_size((rf_iq_format_t)hdr->format);
+
+  bool valid = memcmp(hdr->magic, IQ_FILE_MAGIC, sizeof(hdr->magic)) == 0 && hdr->version == IQ_FILE_VERSION &&
+               hdr->format <= IQ_FORMAT_SC16 && hdr->nof_channels > 0 && hdr->block_len > 0 && hdr->base_srate > 0;
+  if (valid && hdr->nof_samples > 0) {
+    uint64_t last = hdr->nof_samples - 1;
+    valid         = rf_iq_sample_offset(hdr, q->sample_sz, hdr->nof_channels - 1, last) + q->sample_sz <= q->map_sz;
+  }
+  if (!valid) {
+    fprintf(stderr, "[iq] Error: %s is not a valid recording\n", path);
+    rf_iq_rx_close(q);
+    return SRSRAN_ERROR;
+  }
+
+  // The replay reads forward, let the kernel read ahead aggressively
+  madvise(ptr, q->map_sz, MADV_SEQUENTIAL);
+
+  return SRSRAN_SUCCESS;
+}
+
+int rf_iq_rx_read(rf_iq_rx_t* q, uint32_t ch, uint64_t n, cf_t* buffer, uint32_t nsamples)
+{
+  if (!q || !q->hdr || ch >= q->hdr->nof_channels) {
+    return SRSRAN_ERROR;
+  }
+
+  // Only the recorded samples are read, the caller decides what follows the end
+  if (n >= q->hdr->nof_samples) {
+    return 0;
+  }
+  nsamples = (uint32_t)SRSRAN_MIN((uint64_t)nsamples, q->hdr->nof_samples - n);
+
+  // Copy block by block, the samples of a channel are only contiguous within a block
+  uint32_t count = 0;
+  while (count < nsamples) {
+    uint32_t       len = SRSRAN_MIN(nsamples - count, q->hdr->block_len - (uint32_t)((n + count) % q->hdr->block_len));
+    const uint8_t* src = (const uint8_t*)q->hdr + rf_iq_sample_offset(q->hdr, q->sample_sz, ch, n + count);
+    if (q->hdr->format == IQ_FORMAT_SC16) {
+      srsran_vec_convert_if((const int16_t*)src, IQ_SC16_NORM, (float*)&buffer[count], 2 * len);
+    } else {
+      memcpy(&buffer[count], src, (size_t)len * q->sample_sz);
+    }
+    count += len;
+  }
+
+  return (int)nsamples;
+}
+
+void rf_iq_rx_close(rf_iq_rx_t* q)
+{
+  if (q && q->hdr) {
+    munmap((void*)q->hdr, q->map_sz);
+    q->hdr = NULL;
+  }
+}
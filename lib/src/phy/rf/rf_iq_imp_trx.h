@@ -0,0 +1,111 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_IQ_IMP_TRX_H
+#define SRSRAN_RF_IQ_IMP_TRX_H
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Definitions */
+#define IQ_FILE_MAGIC "SRSRANIQ"
+#define IQ_FILE_VERSION (1)
+#define IQ_BLOCK_MS (1)          // Samples of a channel stored contiguously, in ms at the base rate
+#define IQ_GROW_MS (1000)        // The recordings grow in steps of this duration
+#define IQ_MAX_BUFFER_MS (10)    // Longest reception or transmission, in ms at the base rate
+#define IQ_SC16_NORM (INT16_MAX) // Amplitude 1.0 maps to full scale, as the ZMQ driver does
+#define IQ_BASERATE_DEFAULT_HZ (23040000)
+#define IQ_MAX_GAIN_DB (30.0f)
+#define IQ_MIN_GAIN_DB (0.0f)
+
+typedef enum { IQ_FORMAT_FC32 = 0, IQ_FORMAT_SC16 } rf_iq_format_t;
+
+/**
+ * Header at the start of every recording, the samples follow it.
+ *
+ * The samples are stored in blocks of block_len samples per channel, channel after channel, so a block of a channel is
+ * contiguous and the sample of any timestamp is found without scanning the file. Not written timestamps read as zeros.
+ */
+typedef struct {
+  char     magic[8]; ///< IQ_FILE_MAGIC, not null terminated
+  uint32_t version;
+  uint32_t format; ///< rf_iq_format_t
+  uint32_t nof_channels;
+  uint32_t base_srate; ///< Sampling rate of the recording in Hz
+  uint32_t block_len;  ///< Samples of a channel before the next channel starts
+  uint32_t reserved0;
+  uint64_t first_ts;    ///< Timestamp of the first sample, in samples at base_srate
+  uint64_t nof_samples; ///< Recorded samples per channel, only final once the recorder is closed
+  uint8_t  reserved[16];
+} rf_iq_file_hdr_t;
+
+typedef struct {
+  rf_iq_file_hdr_t* hdr; ///< Start of the mapping, NULL while closed
+  size_t            map_sz;
+  int               fd;
+  uint32_t          sample_sz;
+  uint64_t          nsamples; ///< Timestamp after the newest written sample, relative to first_ts
+  bool              started;  ///< first_ts is set by the first write
+} rf_iq_tx_t;
+
+typedef struct {
+  const rf_iq_file_hdr_t* hdr; ///< Start of the mapping, NULL while closed
+  size_t                  map_sz;
+  uint32_t                sample_sz;
+} rf_iq_rx_t;
+
+/* Offset in bytes of the sample n (relative to first_ts) of a channel */
+static inline size_t rf_iq_sample_offset(const rf_iq_file_hdr_t* hdr, uint32_t sample_sz, uint32_t ch, uint64_t n)
+{
+  uint64_t block = n / hdr->block_len;
+  return sizeof(rf_iq_file_hdr_t) +
+         (size_t)((block * hdr->nof_channels + ch) * hdr->block_len + n % hdr->block_len) * sample_sz;
+}
+
+static inline uint32_t rf_iq_sample_size(rf_iq_format_t format)
+{
+  return (format == IQ_FORMAT_SC16) ? 2 * sizeof(int16_t) : sizeof(cf_t);
+}
+
+/*
+ * Recorder functions
+ */
+SRSRAN_API int
+rf_iq_tx_open(rf_iq_tx_t* q, const char* path, rf_iq_format_t format, uint32_t nof_channels, uint32_t base_srate);
+
+SRSRAN_API int rf_iq_tx_write(rf_iq_tx_t* q, uint32_t ch, uint64_t ts, const cf_t* buffer, uint32_t nsamples);
+
+SRSRAN_API uint64_t rf_iq_tx_get_next_ts(rf_iq_tx_t* q);
+
+SRSRAN_API void rf_iq_tx_close(rf_iq_tx_t* q);
+
+/*
+ * Replayer functions
+ */
+SRSRAN_API int rf_iq_rx_open(rf_iq_rx_t* q, const char* path);
+
+SRSRAN_API int rf_iq_rx_read(rf_iq_rx_t* q, uint32_t ch, uint64_t n, cf_t* buffer, uint32_t nsamples);
+
+SRSRAN_API void rf_iq_rx_close(rf_iq_rx_t* q);
+
+#endif // SRSRAN_RF_IQ_IMP_TRX_H
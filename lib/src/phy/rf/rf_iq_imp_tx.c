@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "rf_iq_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* Makes the file and its mapping cover the relative sample n of every channel */
+static int rf_iq_tx_reserve(rf_iq_tx_t* q, uint64_t n)
+{
+  uint64_t grow    = (uint64_t)q->hdr->base_srate * IQ_GROW_MS / 1000;
+  uint64_t nblocks = SRSRAN_CEIL(n, q->hdr->block_len);
+  size_t   needed  = rf_iq_sample_offset(q->hdr, q->sample_sz, 0, nblocks * q->hdr->block_len);
+  if (needed <= q->map_sz) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Grow in large steps, the new space is a hole in the file that reads as zeros until it is written
+  nblocks       = SRSRAN_CEIL(n + grow, q->hdr->block_len);
+  size_t map_sz = rf_iq_sample_offset(q->hdr, q->sample_sz, 0, nblocks * q->hdr->block_len);
+  if (ftruncate(q->fd, (off_t)map_sz) < 0) {
+    fprintf(stderr, "[iq] Error: growing recording: %s\n", strerror(errno));
+    return SRSRAN_ERROR;
+  }
+
+  void* ptr = mremap(q->hdr, q->map_sz, map_sz, MREMAP_MAYMOVE);
+  if (ptr == MAP_FAILED) {
+    fprintf(stderr, "[iq] Error: mapping recording: %s\n", strerror(errno));
+    return SRSRAN_ERROR;
+  }
+  q->hdr    = (rf_iq_file_hdr_t*)ptr;
+  q->map_sz = map_sz;
+
+  return SRSRAN_SUCCESS;
+}
+
+int rf_iq_tx_open(rf_iq_tx_t* q, const char* path, rf_iq_format_t format, uint32_t nof_channels, uint32_t base_srate)
+{
+  if (!q || !path || nof_channels == 0 || base_srate < 1000) {
+    return SRSRAN_ERROR;
+  }
+
+  bzero(q, sizeof(rf_iq_tx_t));
+  q->sample_sz = rf_iq_sample_size(format);
+
+  q->fd = open(path, O_CREAT | O_TRUNC | O_RDWR, 0644);
+  if (q->fd < 0) {
+    fprintf(stderr, "[iq] Error: creating recording %s: %s\n", path, strerror(errno));
+    return SRSRAN_ERROR;
+  }
+
+  size_t map_sz = sizeof(rf_iq_file_hdr_t);
+  if (ftruncate(q->fd, (off_t)map_sz) < 0) {
+    fprintf(stderr, "[iq] Error: resizing recording %s: %s\n", path, strerror(errno));
+    close(q->fd);
+    return SRSRAN_ERROR;
+  }
+
+  void* ptr = mmap(NULL, map_sz, PROT_READ | PROT_WRITE, MAP_SHARED, q->fd, 0);
+  if (ptr == MAP_FAILED) {
+    fprintf(stderr, "[iq] Error: mapping recording %s: %s\n", path, strerror(errno));
+    close(q->fd);
+    return SRSRAN_ERROR;
+  }
+  q->hdr    = (rf_iq_file_hdr_t*)ptr;
+  q->map_sz = map_sz;
+
+  memcpy(q->hdr->magic, IQ_FILE_MAGIC, sizeof(q->hdr->magic));
+  q->hdr->version      = IQ_FILE_VERSION;
+  q->hdr->format       = format;
+  q->hdr->nof_channels = nof_channels;
+  q->hdr->base_srate   = base_srate;
+  q->hdr->block_len    = base_srate * IQ_BLOCK_MS / 1000;
+
+  return SRSRAN_SUCCESS;
+}
+
+int rf_iq_tx_write(rf_iq_tx_t* q, uint32_t ch, uint64_t ts, const cf_t* buffer, uint32_t nsamples)
+{
+  if (!q || !q->hdr || ch >= q->hdr->nof_channels) {
+    return SRSRAN_ERROR;
+  }
+
+  // The first write sets the timestamp of the recording start
+  if (!q->started) {
+    q->hdr->first_ts = ts;
+    q->started       = true;
+  }
+  if (ts < q->hdr->first_ts) {
+    fprintf(stderr, "[iq] Error: writing before the start of the recording\n");
+    return SRSRAN_ERROR;
+  }
+
+  uint64_t n = ts - q->hdr->first_ts;
+  if (rf_iq_tx_reserve(q, n + nsamples) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Copy block by block, the samples of a channel are only contiguous within a block
+  uint32_t count = 0;
+  while (count < nsamples) {
+    uint32_t len = SRSRAN_MIN(nsamples - count, q->hdr->block_len - (uint32_t)((n + count) % q->hdr->block_len));
+    uint8_t* dst = (uint8_t*)q->hdr + rf_iq_sample_offset(q->hdr, q->sample_sz, ch, n + count);
+    if (buffer == NULL) {
+      memset(dst, 0, (size_t)len * q->sample_sz);
+    } else if (q->hdr->format == IQ_FORMAT_SC16) {
+      srsran_vec_convert_fi((const float*)&buffer[count], IQ_SC16_NORM, (int16_t*)dst, 2 * len);
+    } else {
+      memcpy(dst, &buffer[count], (size_t)len * q->sample_sz);
+    }
+    count += len;
+  }
+
+  q->nsamples = SRSRAN_MAX(q->nsamples, n + nsamples);
+
+  return (int)nsamples;
+}
+
+uint64_t rf_iq_tx_get_next_ts(rf_iq_tx_t* q)
+{
+  return q->hdr->first_ts + q->nsamples;
+}
+
+void rf_iq_tx_close(rf_iq_tx_t* q)
+{
+  if (!q || !q->hdr) {
+    return;
+  }
+
+  // Trim the last growth step, the last block is kept complete so every block has the same layout
+  uint64_t nblocks    = SRSRAN_CEIL(q->nsamples, q->hdr->block_len);
+  size_t   file_sz    = rf_iq_sample_offset(q->hdr, q->sample_sz, 0, nblocks * q->hdr->block_len);
+  q->hdr->nof_samples = q->nsamples;
+
+  munmap(q->hdr, q->map_sz);
+  if (ftruncate(q->fd, (off_t)file_sz) < 0) {
+    fprintf(stderr, "[iq] Error: trimming recording: %s\n", strerror(errno));
+  }
+  close(q->fd);
+
+  q->hdr = NULL;
+}
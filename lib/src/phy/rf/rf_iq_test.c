@@ -0,0 +1,200 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/rf/rf.h"
+#include "srsran/phy/utils/debug.h"
+#include <complex.h>
+#include <math.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define NOF_CHANNELS 2
+#define NUM_SF (50)
+#define SF_LEN (1920)
+#define SRATE_HZ (1.92e6)
+#define TX_OFFSET_MS (4)
+#define TX_GAP_SF (10) // Subframe that is not transmitted, it shall be replayed as zeros
+#define RX_START_MS (7)
+
+static cf_t tx_sample(uint32_t ch, uint64_t ts)
+{
+  return (float)((ts + ch) % 1000) / 1000.0f - _Complex_I * (float)(ts % 7) / 8.0f;
+}
+
+/* Records NUM_SF subframes, the receptions return zeros as fast as possible since there is no file to replay */
+static int record(const char* args)
+{
+  srsran_rf_t radio = {};
+  if (srsran_rf_open_devname(&radio, "iq", (char*)args, NOF_CHANNELS)) {
+    fprintf(stderr, "Error opening rf\n");
+    return SRSRAN_ERROR;
+  }
+  srsran_rf_set_rx_srate(&radio, SRATE_HZ);
+  srsran_rf_set_tx_srate(&radio, SRATE_HZ);
+
+  cf_t  buffer[NOF_CHANNELS][SF_LEN];
+  void* ptr[SRSRAN_MAX_CHANNELS] = {};
+  for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+    ptr[c] = buffer[c];
+  }
+
+  for (uint32_t sf = 0; sf < NUM_SF; sf++) {
+    srsran_timestamp_t rx_time = {}, tx_time = {};
+    if (srsran_rf_recv_with_time_multi(&radio, ptr, SF_LEN, true, &rx_time.full_secs, &rx_time.frac_secs) != SF_LEN) {
+      fprintf(stderr, "Error receiving data\n");
+      return SRSRAN_ERROR;
+    }
+
+    // timed tx relative to receive time
+    srsran_timestamp_copy(&tx_time, &rx_time);
+    srsran_timestamp_add(&tx_time, 0, TX_OFFSET_MS * 1e-3);
+    uint64_t tx_ts = srsran_timestamp_uint64(&tx_time, SRATE_HZ);
+    for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+      for (uint32_t i = 0; i < SF_LEN; i++) {
+        buffer[c][i] = tx_sample(c, tx_ts + i);
+      }
+    }
+    if (sf != TX_GAP_SF && srsran_rf_send_timed_multi(
+                               &radio, ptr, SF_LEN, tx_time.full_secs, tx_time.frac_secs, true, true, false) !=
+                               SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error sending data\n");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  srsran_rf_close(&radio);
+  return SRSRAN_SUCCESS;
+}
+
+/* Replays nof_sf subframes from RX_START_MS and checks them against what was recorded, it returns the error count */
+static uint32_t replay(const char* args, uint32_t nof_sf, float tolerance)
+{
+  srsran_rf_t radio = {};
+  if (srsran_rf_open_devname(&radio, "iq", (char*)args, NOF_CHANNELS)) {
+    fprintf(stderr, "Error opening rf\n");
+    return 1;
+  }
+  srsran_rf_set_rx_srate(&radio, SRATE_HZ);
+
+  cf_t  buffer[NOF_CHANNELS][SF_LEN];
+  void* ptr[SRSRAN_MAX_CHANNELS] = {};
+  for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+    ptr[c] = buffer[c];
+  }
+
+  uint64_t first_ts  = TX_OFFSET_MS * SF_LEN;
+  uint64_t length    = NUM_SF * SF_LEN;
+  uint64_t start     = RX_START_MS * SF_LEN;
+  uint32_t nof_error = 0;
+
+  struct timeval t[3] = {};
+  gettimeofday(&t[1], NULL);
+  for (uint32_t sf = 0; sf < nof_sf; sf++) {
+    srsran_timestamp_t rx_time = {};
+    if (srsran_rf_recv_with_time_multi(&radio, ptr, SF_LEN, true, &rx_time.full_secs, &rx_time.frac_secs) != SF_LEN) {
+      fprintf(stderr, "Error receiving data\n");
+      nof_error++;
+      break;
+    }
+
+    // The replay keeps the timestamps of the recording, a loop restarts the samples but not the time
+    uint64_t rx_ts = srsran_timestamp_uint64(&rx_time, SRATE_HZ);
+    if (rx_ts != first_ts + start + (uint64_t)sf * SF_LEN) {
+      nof_error++;
+    }
+    for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+      for (uint32_t i = 0; i < SF_LEN; i++) {
+        uint64_t n        = start + ((uint64_t)sf * SF_LEN + i) % (length - start);
+        cf_t     expected = (n / SF_LEN == TX_GAP_SF) ? 0.0f : tx_sample(c, first_ts + n);
+        if (cabsf(buffer[c][i] - expected) > tolerance) {
+          nof_error++;
+        }
+      }
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  printf("replayed %d subframes at %.1f Msps with %d errors\n",
+         nof_sf,
+         (double)nof_sf * SF_LEN * NOF_CHANNELS / SRSRAN_MAX(t[0].tv_sec * 1000000UL + t[0].tv_usec, 1),
+         nof_error);
+
+  // Without loop, the next reception is past the end of the recording
+  if (nof_sf == NUM_SF - RX_START_MS &&
+      srsran_rf_recv_with_time_multi(&radio, ptr, SF_LEN, true, NULL, NULL) != SRSRAN_ERROR_RX_EOF) {
+    nof_error++;
+  }
+
+  srsran_rf_close(&radio);
+  return nof_error;
+}
+
+int main()
+{
+  char     path[] = "/tmp/rf_iq_test_XXXXXX";
+  char     args[RF_PARAM_LEN];
+  uint32_t nof_error = 0;
+
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    perror("mkstemp");
+    return SRSRAN_ERROR;
+  }
+  close(fd);
+
+  // Exact replay of a fc32 recording, then a sc16 recording within its quantization, also looping over the end
+  snprintf(args, RF_PARAM_LEN, "tx_file=%s,base_srate=1.92e6,format=fc32,pace=fast", path);
+  if (record(args)) {
+    nof_error++;
+  }
+  snprintf(args, RF_PARAM_LEN, "rx_file=%s,rx_start_ms=%d,pace=fast", path, RX_START_MS);
+  nof_error += replay(args, NUM_SF - RX_START_MS, 0.0f);
+
+  snprintf(args, RF_PARAM_LEN, "tx_file=%s,base_srate=1.92e6,format=sc16,pace=fast", path);
+  if (record(args)) {
+    nof_error++;
+  }
+  snprintf(args, RF_PARAM_LEN, "rx_file=%s,rx_start_ms=%d,rx_loop=true,pace=fast", path, RX_START_MS);
+  nof_error += replay(args, 2 * NUM_SF, 2.0f / INT16_MAX);
+
+  // The default pace follows the wall clock
+  struct timeval t[3] = {};
+  gettimeofday(&t[1], NULL);
+  snprintf(args, RF_PARAM_LEN, "rx_file=%s,rx_start_ms=%d", path, RX_START_MS);
+  nof_error += replay(args, NUM_SF - RX_START_MS, 2.0f / INT16_MAX);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  if (t[0].tv_sec * 1000 + t[0].tv_usec / 1000 < NUM_SF - RX_START_MS - 1) {
+    fprintf(stderr, "Real-time replay did not follow the wall clock\n");
+    nof_error++;
+  }
+
+  unlink(path);
+
+  printf("%s\n", nof_error ? "Failed" : "Passed");
+  return nof_error ? SRSRAN_ERROR : SRSRAN_SUCCESS;
+}
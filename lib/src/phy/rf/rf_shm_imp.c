@@ -0,0 +1,721 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp.h"
+#include "rf_helper.h"
+#include "rf_plugin.h"
+#include "rf_shm_imp_trx.h"
+#include <inttypes.h>
+#include <math.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/common/timestamp.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+  // Common attributes
+  srsran_rf_info_t info;
+  uint32_t         nof_channels;
+  uint32_t         nof_peers;
+
+  // RF State
+  uint32_t srate; // radio rate configured by upper layers
+  uint32_t base_srate;
+  uint32_t decim_factor; // decimation factor between base_srate used on transport on radio's rate
+  uint32_t ring_sz;      // ring capacity in samples
+  uint32_t trx_timeout_ms;
+  double   rx_gain;
+  double   tx_gain;
+  char     id[RF_PARAM_LEN];
+
+  // Own rings and the rings of the peers, the reception combines the peers
+  rf_shm_tx_t transmitter[SRSRAN_MAX_CHANNELS];
+  rf_shm_rx_t receiver[SHM_MAX_PEERS][SRSRAN_MAX_CHANNELS];
+
+  // Various sample buffers
+  cf_t* buffer_decimation[SRSRAN_MAX_CHANNELS];
+  cf_t* buffer_tx;
+
+  // Rx timestamp and the wall clock reference that paces it
+  uint64_t        next_rx_ts;
+  bool            rx_started;
+  uint64_t        clock_ts;
+  struct timespec clock_ref;
+
+  pthread_mutex_t tx_config_mutex;
+  pthread_mutex_t decim_mutex;
+  pthread_mutex_t rx_gain_mutex;
+} rf_shm_handler_t;
+
+static void update_rates(rf_shm_handler_t* handler, double srate);
+
+/*
+ * Static Atributes
+ */
+const char shm_devname[4] = "shm";
+
+/*
+ * Static methods
+ */
+
+// Sleeps until the wall clock reaches the given timestamp, the first call sets the reference
+static void rf_shm_pace(rf_shm_handler_t* handler, uint64_t ts)
+{
+  if (!handler->rx_started) {
+    clock_gettime(CLOCK_MONOTONIC, &handler->clock_ref);
+    handler->clock_ts   = ts;
+    handler->rx_started = true;
+    return;
+  }
+
+  uint64_t        elapsed = ts - handler->clock_ts;
+  struct timespec target  = handler->clock_ref;
+  target.tv_sec += (time_t)(elapsed / handler->base_srate);
+  target.tv_nsec += (long)((elapsed % handler->base_srate) * 1000000000UL / handler->base_srate);
+  if (target.tv_nsec >= 1000000000L) {
+    target.tv_sec++;
+    target.tv_nsec -= 1000000000L;
+  }
+
+  clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, NULL);
+}
+
+/*
+ * Public methods
+ */
+
+// Opens the rings of a peer, returns false if the maximum number of peers is reached
+static bool rf_shm_add_peer(rf_shm_handler_t* handler, const char* peer)
+{
+  if (handler->nof_peers == SHM_MAX_PEERS) {
+    fprintf(stderr, "[shm] Error: too many peers, the maximum is %d\n", SHM_MAX_PEERS);
+    return false;
+  }
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    char name[SHM_NAME_LEN] = {};
+    snprintf(name, SHM_NAME_LEN, SHM_NAME_PREFIX "%s_%d", peer, i);
+    rf_shm_rx_open(&handler->receiver[handler->nof_peers][i], name);
+  }
+  handler->nof_peers++;
+  return true;
+}
+
+// Adds a peer identifier, or all the peers of a range written as prefix[first-last] (e.g. ue[1-64])
+static bool rf_shm_add_peers(rf_shm_handler_t* handler, const char* token)
+{
+  char     prefix[RF_PARAM_LEN] = {};
+  uint32_t first = 0, last = 0;
+  if (sscanf(token, "%255[^[][%u-%u]", prefix, &first, &last) != 3) {
+    return rf_shm_add_peer(handler, token);
+  }
+
+  for (uint32_t n = first; n <= last; n++) {
+    char peer[RF_PARAM_LEN + 16] = {};
+    snprintf(peer, sizeof(peer), "%s%u", prefix, n);
+    if (!rf_shm_add_peer(handler, peer)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void rf_shm_suppress_stdout(void* h)
+{
+  // do nothing
+}
+
+void rf_shm_register_error_handler(void* h, srsran_rf_error_handler_t new_handler, void* arg)
+{
+  // do nothing
+}
+
+const char* rf_shm_devname(void* h)
+{
+  return shm_devname;
+}
+
+int rf_shm_start_rx_stream(void* h, bool now)
+{
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_stop_rx_stream(void* h)
+{
+  return SRSRAN_SUCCESS;
+}
+
+void rf_shm_flush_buffer(void* h)
+{
+  // do nothing
+}
+
+bool rf_shm_has_rssi(void* h)
+{
+  return false;
+}
+
+float rf_shm_get_rssi(void* h)
+{
+  return 0.0;
+}
+
+int rf_shm_open(char* args, void** h)
+{
+  return rf_shm_open_multi(args, h, 1);
+}
+
+int rf_shm_open_multi(char* args, void** h, uint32_t nof_channels)
+{
+  int ret = SRSRAN_ERROR;
+  if (h && nof_channels < SRSRAN_MAX_CHANNELS) {
+    *h = NULL;
+
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)malloc(sizeof(rf_shm_handler_t));
+    if (!handler) {
+      perror("malloc");
+      return SRSRAN_ERROR;
+    }
+    bzero(handler, sizeof(rf_shm_handler_t));
+    *h                        = handler;
+    handler->base_srate       = SHM_BASERATE_DEFAULT_HZ; // Sample rate for 100 PRB cell
+    handler->trx_timeout_ms   = SHM_TIMEOUT_MS;
+    handler->info.max_rx_gain = SHM_MAX_GAIN_DB;
+    handler->info.min_rx_gain = SHM_MIN_GAIN_DB;
+    handler->info.max_tx_gain = SHM_MAX_GAIN_DB;
+    handler->info.min_tx_gain = SHM_MIN_GAIN_DB;
+    handler->nof_channels     = nof_channels;
+
+    if (pthread_mutex_init(&handler->tx_config_mutex, NULL)) {
+      perror("Mutex init");
+    }
+    if (pthread_mutex_init(&handler->decim_mutex, NULL)) {
+      perror("Mutex init");
+    }
+    if (pthread_mutex_init(&handler->rx_gain_mutex, NULL)) {
+      perror("Mutex init");
+    }
+
+    // parse args
+    char     peers[RF_PARAM_LEN] = {};
+    uint32_t ring_ms             = SHM_RING_DEFAULT_MS;
+    if (args && strlen(args)) {
+      // base_srate
+      parse_uint32(args, "base_srate", -1, &handler->base_srate);
+
+      // ring_ms
+      parse_uint32(args, "ring_ms", -1, &ring_ms);
+
+      // trx_timeout_ms
+      parse_uint32(args, "trx_timeout_ms", -1, &handler->trx_timeout_ms);
+
+      // rx_peers, colon separated identifiers or ranges (prefix[first-last]) of the peers whose transmissions are
+      // received
+      parse_string(args, "rx_peers", -1, peers);
+
+      // id
+      parse_string(args, "id", -1, handler->id);
+    }
+
+    if (strlen(handler->id) == 0) {
+      fprintf(stderr,
+              "[shm] Error: No device 'id' option has been set. Please make sure to set this option to be able to "
+              "use the shared memory no-RF module\n");
+      goto clean_exit;
+    }
+
+    // The reception shall fit in the stable half of the rings
+    handler->ring_sz = (uint32_t)((uint64_t)handler->base_srate * SRSRAN_MAX(ring_ms, 2) / 1000);
+
+    update_rates(handler, 1.92e6);
+
+    // initialize transmitters
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      char name[SHM_NAME_LEN] = {};
+      snprintf(name, SHM_NAME_LEN, SHM_NAME_PREFIX "%s_%d", handler->id, i);
+      if (rf_shm_tx_open(&handler->transmitter[i], name, handler->ring_sz, handler->base_srate) != SRSRAN_SUCCESS) {
+        fprintf(stderr, "[shm] Error: opening transmitter\n");
+        goto clean_exit;
+      }
+    }
+
+    // initialize receivers
+    for (char* peer = strtok(peers, ":"); peer != NULL; peer = strtok(NULL, ":")) {
+      if (!rf_shm_add_peers(handler, peer)) {
+        goto clean_exit;
+      }
+    }
+    if (handler->nof_peers == 0) {
+      fprintf(stdout, "[shm] %s Rx peers not specified. Receiving zeros.\n", handler->id);
+    }
+
+    // Create decimation and interpolation buffers
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      handler->buffer_decimation[i] = srsran_vec_cf_malloc(handler->ring_sz / 2);
+      if (!handler->buffer_decimation[i]) {
+        fprintf(stderr, "Error: allocating decimation buffer\n");
+        goto clean_exit;
+      }
+    }
+
+    handler->buffer_tx = srsran_vec_cf_malloc(handler->ring_sz / 2);
+    if (!handler->buffer_tx) {
+      fprintf(stderr, "Error: allocating tx buffer\n");
+      goto clean_exit;
+    }
+
+    ret = SRSRAN_SUCCESS;
+
+  clean_exit:
+    if (ret) {
+      rf_shm_close(handler);
+      *h = NULL;
+    }
+  }
+  return ret;
+}
+
+int rf_shm_close(void* h)
+{
+  rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    rf_shm_tx_close(&handler->transmitter[i]);
+    for (uint32_t p = 0; p < handler->nof_peers; p++) {
+      rf_shm_rx_close(&handler->receiver[p][i]);
+    }
+  }
+
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    if (handler->buffer_decimation[i]) {
+      free(handler->buffer_decimation[i]);
+    }
+  }
+
+  if (handler->buffer_tx) {
+    free(handler->buffer_tx);
+  }
+
+  pthread_mutex_destroy(&handler->tx_config_mutex);
+  pthread_mutex_destroy(&handler->decim_mutex);
+  pthread_mutex_destroy(&handler->rx_gain_mutex);
+
+  // Free all
+  free(handler);
+
+  return SRSRAN_SUCCESS;
+}
+
+void update_rates(rf_shm_handler_t* handler, double srate)
+{
+  pthread_mutex_lock(&handler->decim_mutex);
+  if (handler) {
+    // Decimation must be full integer
+    if (((uint64_t)handler->base_srate % (uint64_t)srate) == 0) {
+      handler->srate        = (uint32_t)srate;
+      handler->decim_factor = handler->base_srate / handler->srate;
+    } else {
+      fprintf(stderr,
+              "Error: couldn't update sample rate. %.2f is not divisible by %.2f\n",
+              srate / 1e6,
+              handler->base_srate / 1e6);
+    }
+    printf("Current sample rate is %.2f MHz with a base rate of %.2f MHz (x%d decimation)\n",
+           handler->srate / 1e6,
+           handler->base_srate / 1e6,
+           handler->decim_factor);
+  }
+  pthread_mutex_unlock(&handler->decim_mutex);
+}
+
+double rf_shm_set_rx_srate(void* h, double srate)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    update_rates(handler, srate);
+    ret = handler->srate;
+  }
+  return ret;
+}
+
+double rf_shm_set_tx_srate(void* h, double srate)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    update_rates(handler, srate);
+    ret = srate;
+  }
+  return ret;
+}
+
+int rf_shm_set_rx_gain(void* h, double gain)
+{
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    handler->rx_gain = gain;
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_set_rx_gain_ch(void* h, uint32_t ch, double gain)
+{
+  return rf_shm_set_rx_gain(h, gain);
+}
+
+int rf_shm_set_tx_gain(void* h, double gain)
+{
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->tx_config_mutex);
+    handler->tx_gain = gain;
+    pthread_mutex_unlock(&handler->tx_config_mutex);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_set_tx_gain_ch(void* h, uint32_t ch, double gain)
+{
+  return rf_shm_set_tx_gain(h, gain);
+}
+
+double rf_shm_get_rx_gain(void* h)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    ret = handler->rx_gain;
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
+  }
+  return ret;
+}
+
+double rf_shm_get_tx_gain(void* h)
+{
+  double ret = NAN;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->tx_config_mutex);
+    ret = handler->tx_gain;
+    pthread_mutex_unlock(&handler->tx_config_mutex);
+  }
+  return ret;
+}
+
+srsran_rf_info_t* rf_shm_get_info(void* h)
+{
+  srsran_rf_info_t* info = NULL;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    info                      = &handler->info;
+  }
+  return info;
+}
+
+// The channels are mapped in order to the rings, the frequency is not used
+double rf_shm_set_rx_freq(void* h, uint32_t ch, double freq)
+{
+  return freq;
+}
+
+double rf_shm_set_tx_freq(void* h, uint32_t ch, double freq)
+{
+  return freq;
+}
+
+void rf_shm_get_time(void* h, time_t* secs, double* frac_secs)
+{
+  if (h) {
+    if (secs) {
+      *secs = 0;
+    }
+
+    if (frac_secs) {
+      *frac_secs = 0;
+    }
+  }
+}
+
+int rf_shm_recv_with_time(void* h, void* data, uint32_t nsamples, bool blocking, time_t* secs, double* frac_secs)
+{
+  return rf_shm_recv_with_time_multi(h, &data, nsamples, blocking, secs, frac_secs);
+}
+
+int rf_shm_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool blocking, time_t* secs, double* frac_secs)
+{
+  if (!h || !data) {
+    return SRSRAN_ERROR;
+  }
+
+  rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+
+  // Protect the access to decim_factor since is a shared variable
+  pthread_mutex_lock(&handler->decim_mutex);
+  uint32_t decim_factor = handler->decim_factor;
+  pthread_mutex_unlock(&handler->decim_mutex);
+
+  uint32_t nsamples_baserate = nsamples * decim_factor;
+  if (nsamples_baserate > handler->ring_sz / 2) {
+    fprintf(stderr,
+            "[shm] Error: Trying to receive %d samples but the rings only keep %d. Increase ring_ms.\n",
+            nsamples_baserate,
+            handler->ring_sz / 2);
+    return SRSRAN_ERROR;
+  }
+
+  // Map the peer rings, the first reception starts at the newest sample of the first running peer
+  for (uint32_t p = 0; p < handler->nof_peers; p++) {
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      rf_shm_rx_attach(&handler->receiver[p][i], handler->base_srate);
+    }
+    if (!handler->rx_started && rf_shm_rx_get_write_ts(&handler->receiver[p][0]) > 0) {
+      handler->next_rx_ts = rf_shm_rx_get_write_ts(&handler->receiver[p][0]);
+    }
+  }
+  uint64_t ts_end = handler->next_rx_ts + nsamples_baserate;
+
+  // set timestamp for this reception
+  if (secs != NULL && frac_secs != NULL) {
+    srsran_timestamp_t ts = {};
+    srsran_timestamp_init_uint64(&ts, handler->next_rx_ts, handler->base_srate);
+    *secs      = ts.full_secs;
+    *frac_secs = ts.frac_secs;
+  }
+
+  // Fill the transmission gap, the peers waiting for this reception end shall not stall
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    if (rf_shm_tx_is_running(&handler->transmitter[i])) {
+      rf_shm_tx_align(&handler->transmitter[i], ts_end);
+    }
+  }
+
+  // Keep the reception in real time and wait for the peers that are transmitting
+  rf_shm_pace(handler, ts_end);
+  for (uint32_t p = 0; p < handler->nof_peers; p++) {
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      rf_shm_rx_t* rx = &handler->receiver[p][i];
+      if (rf_shm_rx_get_write_ts(rx) > 0 && !rf_shm_rx_wait(rx, ts_end, handler->trx_timeout_ms)) {
+        fprintf(stderr, "[shm] %s stopped transmitting, no longer receiving it\n", rx->name);
+        rf_shm_rx_detach(rx);
+      }
+    }
+  }
+
+  // Combine the peers
+  for (uint32_t c = 0; c < handler->nof_channels; c++) {
+    // skip if buffer is not available
+    if (data[c] == NULL) {
+      continue;
+    }
+
+    cf_t* ptr        = (decim_factor != 1) ? handler->buffer_decimation[c] : (cf_t*)data[c];
+    bool  accumulate = false;
+    for (uint32_t p = 0; p < handler->nof_peers; p++) {
+      if (rf_shm_rx_baseband(&handler->receiver[p][c], handler->next_rx_ts, ptr, nsamples_baserate, accumulate) >=
+          SRSRAN_SUCCESS) {
+        accumulate = true;
+      }
+    }
+    if (!accumulate) {
+      srsran_vec_cf_zero(ptr, nsamples_baserate);
+    }
+
+    // decimate if needed
+    if (decim_factor != 1) {
+      cf_t* dst = (cf_t*)data[c];
+      for (uint32_t i = 0, n = 0; i < nsamples; i++) {
+        // Averaging decimation
+        cf_t avg = 0.0f;
+        for (int j = 0; j < decim_factor; j++, n++) {
+          avg += ptr[n];
+        }
+        dst[i] = avg; // divide by decim_factor later via scale
+      }
+    }
+  }
+
+  // Set gain
+  pthread_mutex_lock(&handler->rx_gain_mutex);
+  float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
+  pthread_mutex_unlock(&handler->rx_gain_mutex);
+  // scale shall also incorporate decim_factor
+  if (decim_factor > 0) {
+    scale = scale / decim_factor;
+  }
+  if (scale != 1.0f) {
+    for (uint32_t c = 0; c < handler->nof_channels; c++) {
+      if (data[c]) {
+        srsran_vec_sc_prod_cfc(data[c], scale, data[c], nsamples);
+      }
+    }
+  }
+
+  // update rx time
+  handler->next_rx_ts = ts_end;
+
+  return nsamples;
+}
+
+int rf_shm_send_timed(void*  h,
+                      void*  data,
+                      int    nsamples,
+                      time_t secs,
+                      double frac_secs,
+                      bool   has_time_spec,
+                      bool   blocking,
+                      bool   is_start_of_burst,
+                      bool   is_end_of_burst)
+{
+  void* _data[4] = {data, NULL, NULL, NULL};
+
+  return rf_shm_send_timed_multi(
+      h, _data, nsamples, secs, frac_secs, has_time_spec, blocking, is_start_of_burst, is_end_of_burst);
+}
+
+int rf_shm_send_timed_multi(void*  h,
+                            void*  data[4],
+                            int    nsamples,
+                            time_t secs,
+                            double frac_secs,
+                            bool   has_time_spec,
+                            bool   blocking,
+                            bool   is_start_of_burst,
+                            bool   is_end_of_burst)
+{
+  if (!h || !data || nsamples <= 0) {
+    return SRSRAN_ERROR;
+  }
+
+  rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+
+  // Load transmission gain
+  pthread_mutex_lock(&handler->tx_config_mutex);
+  float tx_gain = srsran_convert_dB_to_amplitude(handler->tx_gain);
+  pthread_mutex_unlock(&handler->tx_config_mutex);
+
+  // If the Tx gain is NAN, INF or 0.0, use 1.0
+  if (!isnormal(tx_gain)) {
+    tx_gain = 1.0f;
+  }
+
+  // Protect the access to decim_factor since is a shared variable
+  pthread_mutex_lock(&handler->decim_mutex);
+  uint32_t decim_factor = handler->decim_factor;
+  pthread_mutex_unlock(&handler->decim_mutex);
+
+  uint32_t nsamples_baseband = nsamples * decim_factor;
+  if (nsamples_baseband > handler->ring_sz / 2) {
+    fprintf(stderr, "Error: trying to transmit too many samples (%d > %d).\n", nsamples, handler->ring_sz / 2);
+    return SRSRAN_ERROR;
+  }
+
+  // check if this is a tx in the future
+  if (has_time_spec) {
+    srsran_timestamp_t ts = {};
+    srsran_timestamp_init(&ts, secs, frac_secs);
+    uint64_t tx_ts = srsran_timestamp_uint64(&ts, handler->base_srate);
+
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      int num_tx_gap_samples = rf_shm_tx_align(&handler->transmitter[i], tx_ts);
+      if (num_tx_gap_samples < 0) {
+        fprintf(stderr,
+                "[shm] Error: tx time is %.3f ms in the past (%" PRIu64 " < %" PRIu64 ")\n",
+                -1000.0 * num_tx_gap_samples / handler->base_srate,
+                tx_ts,
+                rf_shm_tx_get_nsamples(&handler->transmitter[i]));
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  // Write base-band samples, the ring is the only copy unless they need interpolation or gain
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    if (data[i] != NULL) {
+      cf_t* buf = (cf_t*)data[i];
+
+      if (decim_factor != 1 || tx_gain != 1.0f) {
+        // perform zero order hold
+        cf_t* src = buf;
+        buf       = handler->buffer_tx;
+        for (uint32_t k = 0, n = 0; k < nsamples; k++) {
+          for (uint32_t j = 0; j < decim_factor; j++, n++) {
+            buf[n] = src[k];
+          }
+        }
+
+        // Scale according to current gain
+        srsran_vec_sc_prod_cfc(buf, tx_gain, buf, nsamples_baseband);
+      }
+
+      rf_shm_tx_baseband(&handler->transmitter[i], buf, nsamples_baseband);
+    } else {
+      rf_shm_tx_zeros(&handler->transmitter[i], nsamples_baseband);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+rf_dev_t srsran_rf_dev_shm = {"shm",
+                              rf_shm_devname,
+                              rf_shm_start_rx_stream,
+                              rf_shm_stop_rx_stream,
+                              rf_shm_flush_buffer,
+                              rf_shm_has_rssi,
+                              rf_shm_get_rssi,
+                              rf_shm_suppress_stdout,
+                              rf_shm_register_error_handler,
+                              rf_shm_open,
+                              .srsran_rf_open_multi = rf_shm_open_multi,
+                              rf_shm_close,
+                              rf_shm_set_rx_srate,
+                              rf_shm_set_rx_gain,
+                              rf_shm_set_rx_gain_ch,
+                              rf_shm_set_tx_gain,
+                              rf_shm_set_tx_gain_ch,
+                              rf_shm_get_rx_gain,
+                              rf_shm_get_tx_gain,
+                              rf_shm_get_info,
+                              rf_shm_set_rx_freq,
+                              rf_shm_set_tx_srate,
+                              rf_shm_set_tx_freq,
+                              rf_shm_get_time,
+                              NULL,
+                              rf_shm_recv_with_time,
+                              rf_shm_recv_with_time_multi,
+                              rf_shm_send_timed,
+                              .srsran_rf_send_timed_multi = rf_shm_send_timed_multi};
+
+#ifdef ENABLE_RF_PLUGINS
+int register_plugin(rf_dev_t** rf_api)
+{
+  if (rf_api == NULL) {
+    return SRSRAN_ERROR;
+  }
+  *rf_api = &srsran_rf_dev_shm;
+  return SRSRAN_SUCCESS;
+}
+#endif /* ENABLE_RF_PLUGINS */
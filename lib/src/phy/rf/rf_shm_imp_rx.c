@@ -0,0 +1,206 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <fcntl.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+int rf_shm_rx_open(rf_shm_rx_t* q, const char* name)
+{
+  if (!q || !name) {
+    return SRSRAN_ERROR;
+  }
+
+  // Zero object, the ring is mapped on the first reception since the peer may not be running yet
+  bzero(q, sizeof(rf_shm_rx_t));
+  strncpy(q->name, name, SHM_NAME_LEN - 1);
+
+  return SRSRAN_SUCCESS;
+}
+
+bool rf_shm_rx_attach(rf_shm_rx_t* q, uint32_t base_srate)
+{
+  if (q->hdr) {
+    if (__atomic_load_n(&q->hdr->alive, __ATOMIC_ACQUIRE)) {
+      return true;
+    }
+
+    // The writer closed the ring, a new instance creates a new one under the same name
+    rf_shm_rx_detach(q);
+  }
+
+  // Do not try to open a missing ring on every reception
+  if (q->retry > 0) {
+    q->retry--;
+    return false;
+  }
+  q->retry = SHM_RETRY_PERIOD;
+
+  int fd = shm_open(q->name, O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st = {};
+  if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(rf_shm_ring_hdr_t)) {
+    close(fd);
+    return false;
+  }
+
+  void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    return false;
+  }
+
+  // The writer publishes the magic word once the header is ready
+  rf_shm_ring_hdr_t* hdr = (rf_shm_ring_hdr_t*)ptr;
+  if (__atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) != SHM_RING_MAGIC ||
+      rf_shm_ring_size(hdr->nof_samples) > (size_t)st.st_size) {
+    munmap(ptr, (size_t)st.st_size);
+    return false;
+  }
+
+  if (hdr->base_srate != base_srate) {
+    fprintf(stderr,
+            "[shm] Error: ring %s base rate is %.2f MHz but %.2f MHz is expected\n",
+            q->name,
+            hdr->base_srate / 1e6,
+            base_srate / 1e6);
+    munmap(ptr, (size_t)st.st_size);
+    return false;
+  }
+
+  q->hdr     = hdr;
+  q->samples = (const cf_t*)(hdr + 1);
+  q->map_sz  = (size_t)st.st_size;
+
+  printf("[shm] Attached to %s\n", q->name);
+
+  return true;
+}
+
+uint64_t rf_shm_rx_get_write_ts(rf_shm_rx_t* q)
+{
+  return (q->hdr) ? __atomic_load_n(&q->hdr->write_ts, __ATOMIC_ACQUIRE) : 0;
+}
+
+bool rf_shm_rx_wait(rf_shm_rx_t* q, uint64_t ts, uint32_t timeout_ms)
+{
+  struct timespec start = {}, now = {};
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  while (rf_shm_rx_get_write_ts(q) < ts) {
+    if (!__atomic_load_n(&q->hdr->alive, __ATOMIC_ACQUIRE)) {
+      return false;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t elapsed_ms = (now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000;
+    if (elapsed_ms > timeout_ms) {
+      return false;
+    }
+
+    usleep(10);
+  }
+
+  return true;
+}
+
+static void rf_shm_rx_copy(const cf_t* src, cf_t* dst, uint32_t nsamples, bool accumulate)
+{
+  if (accumulate) {
+    srsran_vec_sum_ccc(dst, src, dst, nsamples);
+  } else {
+    srsran_vec_cf_copy(dst, src, nsamples);
+  }
+}
+
+int rf_shm_rx_baseband(rf_shm_rx_t* q, uint64_t ts, cf_t* buffer, uint32_t nsamples, bool accumulate)
+{
+  if (!q || !q->hdr || !buffer) {
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t nof_samples = q->hdr->nof_samples;
+  uint64_t write_ts    = rf_shm_rx_get_write_ts(q);
+
+  // Only the newest half of the ring is stable, the writer may be overwriting the other half
+  uint64_t first_ts = q->hdr->first_ts;
+  if (write_ts > nof_samples / 2) {
+    first_ts = SRSRAN_MAX(first_ts, write_ts - nof_samples / 2);
+  }
+
+  uint64_t begin = SRSRAN_MAX(ts, first_ts);
+  uint64_t end   = SRSRAN_MIN(ts + nsamples, write_ts);
+  if (write_ts == 0 || begin >= end) {
+    if (!accumulate) {
+      srsran_vec_cf_zero(buffer, nsamples);
+    }
+    return 0;
+  }
+
+  // Samples the writer does not have are zero
+  if (!accumulate) {
+    srsran_vec_cf_zero(buffer, (uint32_t)(begin - ts));
+    srsran_vec_cf_zero(&buffer[end - ts], (uint32_t)(ts + nsamples - end));
+  }
+
+  uint32_t n   = (uint32_t)(end - begin);
+  uint32_t idx = (uint32_t)(begin % nof_samples);
+  uint32_t n1  = SRSRAN_MIN(n, nof_samples - idx);
+  rf_shm_rx_copy(&q->samples[idx], &buffer[begin - ts], n1, accumulate);
+  rf_shm_rx_copy(q->samples, &buffer[begin - ts + n1], n - n1, accumulate);
+
+  // Check the writer did not reach the copied samples meanwhile
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  write_ts = __atomic_load_n(&q->hdr->write_ts, __ATOMIC_RELAXED);
+  if (write_ts > nof_samples / 2 && write_ts - nof_samples / 2 > begin) {
+    uint64_t lost_end = SRSRAN_MIN(write_ts - nof_samples / 2, end);
+    if (!accumulate) {
+      srsran_vec_cf_zero(&buffer[begin - ts], (uint32_t)(lost_end - begin));
+    }
+    n -= (uint32_t)(lost_end - begin);
+  }
+
+  return (int)n;
+}
+
+void rf_shm_rx_detach(rf_shm_rx_t* q)
+{
+  if (q->hdr) {
+    munmap(q->hdr, q->map_sz);
+    q->hdr     = NULL;
+    q->samples = NULL;
+    q->map_sz  = 0;
+  }
+}
+
+void rf_shm_rx_close(rf_shm_rx_t* q)
+{
+  rf_shm_rx_detach(q);
+}
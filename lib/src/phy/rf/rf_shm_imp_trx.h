@@ -0,0 +1,119 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_SHM_IMP_TRX_H
+#define SRSRAN_RF_SHM_IMP_TRX_H
+
+#include "srsran/config.h"
+#include "srsran/phy/rf/rf.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Definitions */
+#define SHM_RING_MAGIC (0x73686d31) // "shm1"
+#define SHM_NAME_PREFIX "/srsran_shm_"
+#define SHM_NAME_LEN (RF_PARAM_LEN + 32)
+#define SHM_MAX_PEERS (64)
+#define SHM_MAX_BUFFER_SIZE (3072000) // 10 subframes at 20 MHz, in samples
+#define SHM_RING_DEFAULT_MS (20)
+#define SHM_TIMEOUT_MS (100)
+#define SHM_RETRY_PERIOD (100) // Receptions between attempts to open a missing peer ring
+#define SHM_BASERATE_DEFAULT_HZ (23040000)
+#define SHM_MAX_GAIN_DB (30.0f)
+#define SHM_MIN_GAIN_DB (0.0f)
+
+/**
+ * Header at the start of every ring, the samples follow it. The sample of timestamp ts lives at index ts % nof_samples.
+ *
+ * There is a single writer per ring and any number of readers, which never modify the ring. The writer stores the
+ * samples first and then publishes write_ts with release semantics. Readers only trust the newest half of the ring,
+ * since the writer may be overwriting the oldest half while they copy.
+ */
+typedef struct {
+  uint32_t magic;
+  uint32_t nof_samples; ///< Ring capacity in samples
+  uint32_t base_srate;
+  uint32_t alive;    ///< Non zero while the writer has the ring open, accessed atomically
+  uint64_t first_ts; ///< Timestamp of the first sample ever written, valid once write_ts is not zero
+  uint64_t write_ts; ///< Timestamp after the newest published sample, 0 until the first write. Accessed atomically
+  uint8_t  reserved[32];
+} rf_shm_ring_hdr_t;
+
+typedef struct {
+  char               name[SHM_NAME_LEN];
+  rf_shm_ring_hdr_t* hdr;
+  cf_t*              samples;
+  size_t             map_sz;
+  uint64_t           nsamples; ///< Local copy of write_ts
+  bool               running;
+  pthread_mutex_t    mutex; ///< Serialises the writes from the Rx alignment and the transmissions
+} rf_shm_tx_t;
+
+typedef struct {
+  char               name[SHM_NAME_LEN];
+  rf_shm_ring_hdr_t* hdr; ///< NULL while the peer ring is not mapped
+  const cf_t*        samples;
+  size_t             map_sz;
+  uint32_t           retry; ///< Receptions left before trying to map the peer ring again
+} rf_shm_rx_t;
+
+static inline size_t rf_shm_ring_size(uint32_t nof_samples)
+{
+  return sizeof(rf_shm_ring_hdr_t) + (size_t)nof_samples * sizeof(cf_t);
+}
+
+/*
+ * Transmitter functions
+ */
+SRSRAN_API int rf_shm_tx_open(rf_shm_tx_t* q, const char* name, uint32_t nof_samples, uint32_t base_srate);
+
+SRSRAN_API int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts);
+
+SRSRAN_API int rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, uint32_t nsamples);
+
+SRSRAN_API int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples);
+
+SRSRAN_API uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q);
+
+SRSRAN_API void rf_shm_tx_close(rf_shm_tx_t* q);
+
+SRSRAN_API bool rf_shm_tx_is_running(rf_shm_tx_t* q);
+
+/*
+ * Receiver functions
+ */
+SRSRAN_API int rf_shm_rx_open(rf_shm_rx_t* q, const char* name);
+
+SRSRAN_API bool rf_shm_rx_attach(rf_shm_rx_t* q, uint32_t base_srate);
+
+SRSRAN_API uint64_t rf_shm_rx_get_write_ts(rf_shm_rx_t* q);
+
+SRSRAN_API bool rf_shm_rx_wait(rf_shm_rx_t* q, uint64_t ts, uint32_t timeout_ms);
+
+SRSRAN_API int rf_shm_rx_baseband(rf_shm_rx_t* q, uint64_t ts, cf_t* buffer, uint32_t nsamples, bool accumulate);
+
+SRSRAN_API void rf_shm_rx_detach(rf_shm_rx_t* q);
+
+SRSRAN_API void rf_shm_rx_close(rf_shm_rx_t* q);
+
+#endif // SRSRAN_RF_SHM_IMP_TRX_H
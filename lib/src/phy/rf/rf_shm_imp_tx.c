@@ -0,0 +1,210 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+int rf_shm_tx_open(rf_shm_tx_t* q, const char* name, uint32_t nof_samples, uint32_t base_srate)
+{
+  int ret = SRSRAN_ERROR;
+
+  // Nothing is initialised yet, so there is nothing to close
+  if (!q || !name || nof_samples <= 1) {
+    return SRSRAN_ERROR;
+  }
+
+  // Zero object
+  bzero(q, sizeof(rf_shm_tx_t));
+
+  if (pthread_mutex_init(&q->mutex, NULL)) {
+    fprintf(stderr, "Error: creating mutex\n");
+    return SRSRAN_ERROR;
+  }
+
+  // From here on the object is open and the error path closes it
+  strncpy(q->name, name, SHM_NAME_LEN - 1);
+
+  // Drop the ring left by a previous instance, its readers drop their mapping once they see it is not alive
+  shm_unlink(q->name);
+
+  int fd = shm_open(q->name, O_CREAT | O_EXCL | O_RDWR, 0666);
+  if (fd < 0) {
+    fprintf(stderr, "[shm] Error: creating ring %s: %s\n", q->name, strerror(errno));
+    goto clean_exit;
+  }
+
+  size_t map_sz = rf_shm_ring_size(nof_samples);
+  if (ftruncate(fd, (off_t)map_sz) < 0) {
+    fprintf(stderr, "[shm] Error: resizing ring %s: %s\n", q->name, strerror(errno));
+    close(fd);
+    goto clean_exit;
+  }
+
+  void* ptr = mmap(NULL, map_sz, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    fprintf(stderr, "[shm] Error: mapping ring %s: %s\n", q->name, strerror(errno));
+    goto clean_exit;
+  }
+  q->map_sz  = map_sz;
+  q->hdr     = (rf_shm_ring_hdr_t*)ptr;
+  q->samples = (cf_t*)(q->hdr + 1);
+
+  // The new object is zeroed, readers do not trust the header until the magic word is published
+  q->hdr->nof_samples = nof_samples;
+  q->hdr->base_srate  = base_srate;
+  __atomic_store_n(&q->hdr->alive, 1, __ATOMIC_RELAXED);
+  __atomic_store_n(&q->hdr->magic, SHM_RING_MAGIC, __ATOMIC_RELEASE);
+
+  q->running = true;
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (ret) {
+    rf_shm_tx_close(q);
+  }
+  return ret;
+}
+
+// Writes at the write position and publishes at most half a ring at a time, a NULL buffer writes zeros
+static void _rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, uint64_t nsamples)
+{
+  uint32_t nof_samples = q->hdr->nof_samples;
+  uint64_t count       = 0;
+
+  while (count < nsamples) {
+    uint32_t n   = (uint32_t)SRSRAN_MIN(nsamples - count, nof_samples / 2);
+    uint32_t idx = (uint32_t)(q->nsamples % nof_samples);
+    uint32_t n1  = SRSRAN_MIN(n, nof_samples - idx);
+
+    // Keep the previous write_ts visible before the oldest samples are overwritten
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    if (buffer) {
+      srsran_vec_cf_copy(&q->samples[idx], &buffer[count], n1);
+      srsran_vec_cf_copy(q->samples, &buffer[count + n1], n - n1);
+    } else {
+      srsran_vec_cf_zero(&q->samples[idx], n1);
+      srsran_vec_cf_zero(q->samples, n - n1);
+    }
+
+    q->nsamples += n;
+    count += n;
+    __atomic_store_n(&q->hdr->write_ts, q->nsamples, __ATOMIC_RELEASE);
+  }
+}
+
+int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts)
+{
+  int64_t nsamples = 0;
+
+  pthread_mutex_lock(&q->mutex);
+
+  if (q->running) {
+    if (__atomic_load_n(&q->hdr->write_ts, __ATOMIC_RELAXED) == 0) {
+      // Nothing published yet, the ring starts at the first aligned timestamp
+      q->nsamples      = ts;
+      q->hdr->first_ts = ts;
+    } else {
+      nsamples = (int64_t)ts - (int64_t)q->nsamples;
+      if (nsamples >= q->hdr->nof_samples) {
+        // The whole ring is stale, clear it at once instead of writing the full gap
+        srsran_vec_cf_zero(q->samples, q->hdr->nof_samples);
+        q->nsamples = ts;
+        __atomic_store_n(&q->hdr->write_ts, q->nsamples, __ATOMIC_RELEASE);
+      } else if (nsamples > 0) {
+        _rf_shm_tx_baseband(q, NULL, (uint64_t)nsamples);
+      }
+    }
+  }
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)SRSRAN_MAX(SRSRAN_MIN(nsamples, INT32_MAX), INT32_MIN);
+}
+
+int rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, uint32_t nsamples)
+{
+  pthread_mutex_lock(&q->mutex);
+  if (q->running) {
+    _rf_shm_tx_baseband(q, buffer, nsamples);
+  }
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples)
+{
+  return rf_shm_tx_baseband(q, NULL, nsamples);
+}
+
+uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  uint64_t ret = q->nsamples;
+  pthread_mutex_unlock(&q->mutex);
+  return ret;
+}
+
+void rf_shm_tx_close(rf_shm_tx_t* q)
+{
+  // Not open, already closed or failed to open
+  if (!q || q->name[0] == '\0') {
+    return;
+  }
+
+  pthread_mutex_lock(&q->mutex);
+  q->running = false;
+  pthread_mutex_unlock(&q->mutex);
+
+  pthread_mutex_destroy(&q->mutex);
+
+  if (q->hdr) {
+    __atomic_store_n(&q->hdr->alive, 0, __ATOMIC_RELEASE);
+    munmap(q->hdr, q->map_sz);
+    q->hdr = NULL;
+    shm_unlink(q->name);
+  }
+
+  bzero(q, sizeof(rf_shm_tx_t));
+}
+
+bool rf_shm_tx_is_running(rf_shm_tx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  bool ret = false;
+  pthread_mutex_lock(&q->mutex);
+  ret = q->running;
+  pthread_mutex_unlock(&q->mutex);
+
+  return ret;
+}
@@ -0,0 +1,164 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/tsan_options.h"
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/rf/rf.h"
+#include "srsran/phy/utils/debug.h"
+#include <complex.h>
+#include <pthread.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+
+#define NOF_UE 2
+#define NOF_CHANNELS 2
+#define NUM_SF (500)
+#define SF_LEN (1920)
+#define SRATE_HZ (1.92e6)
+#define TX_OFFSET_MS (4)
+
+// Every node sends a bit of a mask scaled by a ramp, so the receivers can tell which nodes they combined
+static cf_t tx_sample(uint32_t node, uint32_t ch, uint64_t ts)
+{
+  return (float)(1U << node) * (1.0f + _Complex_I * (float)((ts + ch) % 1000));
+}
+
+typedef struct {
+  uint32_t node; // 0 for the eNB, k + 1 for the UE k
+  char     args[RF_PARAM_LEN];
+  uint32_t nof_full;  // Received samples that combine all the peers
+  uint32_t nof_error; // Received samples that are not a combination of peers
+} node_args_t;
+
+static bool check_sample(const node_args_t* n, uint32_t ch, uint64_t ts, cf_t sample, bool* full)
+{
+  // The eNB receives the sum of the UEs that were transmitting at ts, the UEs receive the eNB or nothing
+  uint32_t peers = (n->node == 0) ? ((1U << (NOF_UE + 1)) - 2) : 1U;
+  uint32_t mask  = (uint32_t)crealf(sample);
+
+  *full = (mask == peers);
+  return (crealf(sample) == (float)mask && (mask & ~peers) == 0 &&
+          cimagf(sample) == (float)mask * (float)((ts + ch) % 1000));
+}
+
+static void* node_thread(void* arg)
+{
+  node_args_t* n     = (node_args_t*)arg;
+  srsran_rf_t  radio = {};
+
+  printf("opening device with args=%s\n", n->args);
+  if (srsran_rf_open_devname(&radio, "shm", n->args, NOF_CHANNELS)) {
+    fprintf(stderr, "Error opening rf\n");
+    exit(-1);
+  }
+  srsran_rf_set_rx_srate(&radio, SRATE_HZ);
+  srsran_rf_set_tx_srate(&radio, SRATE_HZ);
+
+  cf_t  rx_buffer[NOF_CHANNELS][SF_LEN];
+  cf_t  tx_buffer[NOF_CHANNELS][SF_LEN];
+  void* rx_ptr[SRSRAN_MAX_CHANNELS] = {};
+  void* tx_ptr[SRSRAN_MAX_CHANNELS] = {};
+  for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+    rx_ptr[c] = rx_buffer[c];
+    tx_ptr[c] = tx_buffer[c];
+  }
+
+  for (uint32_t sf = 0; sf < NUM_SF; sf++) {
+    srsran_timestamp_t rx_time = {}, tx_time = {};
+    if (srsran_rf_recv_with_time_multi(&radio, rx_ptr, SF_LEN, true, &rx_time.full_secs, &rx_time.frac_secs) !=
+        SF_LEN) {
+      fprintf(stderr, "Error receiving data\n");
+      exit(-1);
+    }
+
+    // check the received samples
+    uint64_t rx_ts = srsran_timestamp_uint64(&rx_time, SRATE_HZ);
+    for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+      for (uint32_t i = 0; i < SF_LEN; i++) {
+        bool full = false;
+        if (!check_sample(n, c, rx_ts + i, rx_buffer[c][i], &full)) {
+          n->nof_error++;
+        }
+        n->nof_full += full ? 1 : 0;
+      }
+    }
+
+    // timed tx relative to receive time
+    srsran_timestamp_copy(&tx_time, &rx_time);
+    srsran_timestamp_add(&tx_time, 0, TX_OFFSET_MS * 1e-3);
+    uint64_t tx_ts = srsran_timestamp_uint64(&tx_time, SRATE_HZ);
+    for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+      for (uint32_t i = 0; i < SF_LEN; i++) {
+        tx_buffer[c][i] = tx_sample(n->node, c, tx_ts + i);
+      }
+    }
+    if (srsran_rf_send_timed_multi(
+            &radio, tx_ptr, SF_LEN, tx_time.full_secs, tx_time.frac_secs, true, true, false) != SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error sending data\n");
+      exit(-1);
+    }
+  }
+
+  srsran_rf_close(&radio);
+
+  return NULL;
+}
+
+int main()
+{
+  node_args_t nodes[NOF_UE + 1] = {};
+  pthread_t   threads[NOF_UE + 1];
+
+  // The eNB combines the UEs, given as a range of peers, every UE receives the eNB
+  snprintf(nodes[0].args,
+           RF_PARAM_LEN,
+           "id=test_enb,base_srate=1.92e6,trx_timeout_ms=1000,rx_peers=test_ue[0-%d]",
+           NOF_UE - 1);
+  for (uint32_t k = 0; k < NOF_UE; k++) {
+    nodes[k + 1].node = k + 1;
+    snprintf(nodes[k + 1].args, RF_PARAM_LEN, "id=test_ue%d,base_srate=1.92e6,trx_timeout_ms=1000,rx_peers=test_enb", k);
+  }
+
+  for (uint32_t i = 0; i < NOF_UE + 1; i++) {
+    if (pthread_create(&threads[i], NULL, node_thread, &nodes[i])) {
+      perror("pthread_create");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < NOF_UE + 1; i++) {
+    pthread_join(threads[i], NULL);
+
+    // After the start-up, most of the subframes shall carry all the peers
+    printf("node %d: %d/%d samples with all the peers; %d errors\n",
+           i,
+           nodes[i].nof_full,
+           NUM_SF * SF_LEN * NOF_CHANNELS,
+           nodes[i].nof_error);
+    if (nodes[i].nof_error > 0 || nodes[i].nof_full < NUM_SF * SF_LEN * NOF_CHANNELS / 2) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  return ret;
+}
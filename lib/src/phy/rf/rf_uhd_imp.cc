@@ -207,6 +207,12 @@ void suppress_handler(const char* x)
 static std::array<cf_t, 64 * 1024> zero_mem  = {}; // For transmitting zeros
 static std::array<cf_t, 64 * 1024> dummy_mem = {}; // For receiving
 
+/* Size in bytes of a sample in the host buffers, the zero and dummy buffers are large enough for any format */
+static inline size_t rf_uhd_sample_sz(const rf_uhd_handler_t* h)
+{
+  return h->info.sc16 ? 2 * sizeof(int16_t) : sizeof(cf_t);
+}
+
 static void log_overflow(rf_uhd_handler_t* h)
 {
   std::unique_lock<std::mutex> lock(h->tx_mutex);
@@ -756,9 +762,17 @@ static int uhd_init(rf_uhd_handler_t* handler, char* args, uint32_t nof_channels
   // Create UHD handler
   printf("Opening USRP channels=%d, args: %s\n", nof_channels, device_addr.to_string().c_str());
 
+  // Host sample format, sc16 buffers carry the over the wire samples without converting them. It is left in the
+  // arguments for the generic USRP, which sets its streams from it
+  handler->info.sc16 = device_addr.has_key("cpu_format") and device_addr["cpu_format"] == "sc16";
+
   // If RFNOC is accessible
 #ifdef UHD_ENABLE_RFNOC
   if (rf_uhd_rfnoc::is_required(device_addr)) {
+    if (handler->info.sc16) {
+      ERROR("The sc16 host sample format is not supported with RFNoC devices");
+      return SRSRAN_ERROR;
+    }
     handler->uhd = std::make_shared<rf_uhd_rfnoc>();
   }
 #endif // UHD_ENABLE_RFNOC
@@ -1309,8 +1323,8 @@ int rf_uhd_recv_with_time_multi(void*    h,
 
     for (uint32_t i = 0; i < handler->nof_rx_channels; i++) {
       if (data[i] != nullptr) {
-        cf_t* data_c = (cf_t*)data[i];
-        buffs_ptr[i] = &data_c[rxd_samples_total];
+        uint8_t* data_c = (uint8_t*)data[i];
+        buffs_ptr[i]    = &data_c[rxd_samples_total * rf_uhd_sample_sz(handler)];
       } else {
         buffs_ptr[i]   = dummy_mem.data();
         num_rx_samples = SRSRAN_MIN(num_rx_samples, (uint32_t)dummy_mem.size());
@@ -1424,12 +1438,12 @@ int rf_uhd_send_timed_multi(void*  h,
   }
 
   // Generate transmission buffer pointers
-  cf_t* data_c[SRSRAN_MAX_CHANNELS] = {};
+  uint8_t* data_c[SRSRAN_MAX_CHANNELS] = {};
   for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
-    if (i < handler->nof_tx_channels) {
-      data_c[i] = (data[i] != nullptr) ? (cf_t*)(data[i]) : zero_mem.data();
+    if (i < handler->nof_tx_channels and data[i] != nullptr) {
+      data_c[i] = (uint8_t*)data[i];
     } else {
-      data_c[i] = zero_mem.data();
+      data_c[i] = (uint8_t*)zero_mem.data();
     }
   }
 
@@ -1509,7 +1523,7 @@ int rf_uhd_send_timed_multi(void*  h,
 
     // Update data pointers
     for (int i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
-      void* buff   = (void*)&data_c[i][n];
+      void* buff   = (void*)&data_c[i][n * rf_uhd_sample_sz(handler)];
       buffs_ptr[i] = buff;
     }
 
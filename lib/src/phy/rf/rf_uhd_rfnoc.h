@@ -23,6 +23,7 @@
 #define SRSRAN_RF_UHD_RFNOC_H
 
 #include <chrono>
+#include <cmath>
 #include <complex>
 #include <csignal>
 #include <fstream>
@@ -84,7 +85,11 @@ private:
   std::vector<double> rx_center_freq_hz;
   std::vector<double> tx_freq_hz;
   std::vector<double> tx_center_freq_hz;
-  size_t              dma_fifo_depth = 8192UL * 4096UL;
+  double              rx_radio_freq_hz = 0.0; ///< Fixed Rx radio LO, every carrier is shifted by its DDC. 0 if not set
+  double              tx_radio_freq_hz = 0.0; ///< Fixed Tx radio LO, every carrier is shifted by its DUC. 0 if not set
+  double              rx_rate_hz       = 0.0; ///< Carrier sampling rate at the DDC outputs
+  double              tx_rate_hz       = 0.0; ///< Carrier sampling rate at the DUC inputs
+  size_t              dma_fifo_depth   = 8192UL * 4096UL;
 
   // Radio control
   std::vector<uhd::rfnoc::radio_ctrl::sptr> radio_ctrl = {};
@@ -154,6 +159,15 @@ private:
       return UHD_ERROR_KEY;
     }
 
+    // Parse the wideband radio center frequencies (optional). Without them, every radio is tuned to the first carrier
+    // mapped on it and the rest of the carriers are shifted from there
+    if (args.has_key("rfnoc_rx_freq")) {
+      parse_param(args, "rfnoc_rx_freq", rx_radio_freq_hz);
+    }
+    if (args.has_key("rfnoc_tx_freq")) {
+      parse_param(args, "rfnoc_tx_freq", tx_radio_freq_hz);
+    }
+
     // Set secondary parameters
     bw_hz = master_clock_rate / 2.0;
     tx_freq_hz.resize(nof_radios * nof_channels);
@@ -164,6 +178,35 @@ private:
     return UHD_ERROR_NONE;
   }
 
+  /**
+   * Checks that a carrier shifted offset_hz from the radio center fits, with its sampling rate, in the radio bandwidth
+   */
+  uhd_error check_carrier_offset(const std::string& dir, uint32_t ch, double offset_hz, double rate_hz)
+  {
+    // In loopback the radios are not tuned and the DDC/DUC shifts cancel each other
+    if (loopback) {
+      return UHD_ERROR_NONE;
+    }
+    if (std::abs(offset_hz) + rate_hz / 2.0 > master_clock_rate / 2.0) {
+      Error(dir << " channel " << ch << " is " << offset_hz / 1e6 << " MHz away from the radio center, it does not fit "
+                << "in " << master_clock_rate / 1e6 << " MHz of radio bandwidth");
+      return UHD_ERROR_VALUE;
+    }
+    return UHD_ERROR_NONE;
+  }
+
+  /**
+   * Checks that the master clock rate is an integer multiple of a DDC/DUC rate, up to the rounding of the rate
+   */
+  bool is_master_clock_fraction(double rate_hz) const
+  {
+    if (not std::isnormal(rate_hz) or rate_hz > master_clock_rate) {
+      return false;
+    }
+    double ratio = master_clock_rate / rate_hz;
+    return std::abs(ratio - std::round(ratio)) < 1e-6;
+  }
+
   uhd_error create_control_interfaces()
   {
     SRSRAN_UHD_SAFE_C_LOG_ERROR(
@@ -523,19 +566,41 @@ public:
   uhd_error set_master_clock_rate(double rate) override { return UHD_ERROR_NONE; }
   uhd_error set_rx_rate(double rate) override
   {
+    // The DDC decimates by integer ratios only, any other ratio would be coerced and would need a host resampler
+    if (not is_master_clock_fraction(rate)) {
+      Error("RX rate " << rate / 1e6 << " MHz is not an integer fraction of the " << master_clock_rate / 1e6
+                       << " MHz master clock rate");
+      return UHD_ERROR_VALUE;
+    }
+    rx_rate_hz = rate;
+
     SRSRAN_UHD_SAFE_C_LOG_ERROR(for (size_t i = 0; i < nof_radios; i++) {
       for (size_t j = 0; j < nof_channels; j++) {
         UHD_LOG_DEBUG(ddc_id[i], "Setting channel " << j << " output rate to " << rate / 1e6 << " MHz");
         ddc_ctrl[i]->set_arg("output_rate", std::to_string(rate), j);
+        UHD_LOG_DEBUG(ddc_id[i],
+                      "Actual channel " << j << " output rate " << ddc_ctrl[i]->get_arg<double>("output_rate", j) / 1e6
+                                        << " MHz");
       }
     })
   }
   uhd_error set_tx_rate(double rate) override
   {
+    // The DUC interpolates by integer ratios only
+    if (not is_master_clock_fraction(rate)) {
+      Error("TX rate " << rate / 1e6 << " MHz is not an integer fraction of the " << master_clock_rate / 1e6
+                       << " MHz master clock rate");
+      return UHD_ERROR_VALUE;
+    }
+    tx_rate_hz = rate;
+
     SRSRAN_UHD_SAFE_C_LOG_ERROR(for (size_t i = 0; i < nof_radios; i++) {
       for (size_t j = 0; j < nof_channels; j++) {
         UHD_LOG_DEBUG(duc_id[i], "Setting channel " << j << " input rate to " << rate / 1e6 << " MHz");
         duc_ctrl[i]->set_arg("input_rate", std::to_string(rate), j);
+        UHD_LOG_DEBUG(duc_id[i],
+                      "Actual channel " << j << " input rate " << duc_ctrl[i]->get_arg<double>("input_rate", j) / 1e6
+                                        << " MHz");
       }
     })
   }
@@ -676,35 +741,38 @@ public:
       return UHD_ERROR_NONE;
     }
 
-    // Update frequency
-    tx_freq_hz[ch] = target_freq;
-    actual_freq    = tx_freq_hz[ch];
-
-    Debug("Tuning Tx " << ch << " to " << actual_freq / 1e6 << " MHz...");
+    Debug("Tuning Tx " << ch << " to " << target_freq / 1e6 << " MHz...");
     size_t i = ch / nof_channels;
     size_t j = ch % nof_channels;
 
     SRSRAN_UHD_SAFE_C_LOG_ERROR(
-        // Set Radio Tx freq
+        // Set Radio Tx freq, either the configured wideband center or the first carrier of the radio
         if (not std::isnormal(tx_center_freq_hz[i]) and not loopback) {
+          double radio_freq_hz = std::isnormal(tx_radio_freq_hz) ? tx_radio_freq_hz : target_freq;
           UHD_LOG_DEBUG(radio_id[i],
-                        "Setting TX Freq: " << target_freq / 1e6 << " (" << uint64_t(target_freq) << ") MHz...");
-          radio_ctrl[i]->set_tx_frequency(target_freq, 0);
+                        "Setting TX Freq: " << radio_freq_hz / 1e6 << " (" << uint64_t(radio_freq_hz) << ") MHz...");
+          radio_ctrl[i]->set_tx_frequency(radio_freq_hz, 0);
           tx_center_freq_hz[i] = radio_ctrl[i]->get_tx_frequency(0);
           UHD_LOG_DEBUG(radio_id[i],
                         "Actual TX Freq: " << tx_center_freq_hz[i] / 1e6 << "(" << uint64_t(tx_center_freq_hz[i])
                                            << ") MHz...");
         }
 
-        // Setup DUC
-        double freq_hz = tx_freq_hz[nof_channels * i + j] - tx_center_freq_hz[i];
-        if (std::round(duc_ctrl[i]->get_arg<double>("freq") != freq_hz)) {
+        // Setup DUC, it shifts the carrier from the radio center
+        double freq_hz = target_freq - tx_center_freq_hz[i];
+        if (check_carrier_offset("TX", ch, freq_hz, tx_rate_hz) != UHD_ERROR_NONE) { return UHD_ERROR_VALUE; }
+
+        if (std::round(duc_ctrl[i]->get_arg<double>("freq", j)) != std::round(freq_hz)) {
           UHD_LOG_DEBUG(duc_id[i],
-                        "Setting " << j << " freq: " << freq_hz / 1e6 << "(" << uint64_t(freq_hz) << ") MHz ...");
+                        "Setting " << j << " freq: " << freq_hz / 1e6 << "(" << int64_t(freq_hz) << ") MHz ...");
           duc_ctrl[i]->set_arg("freq", std::to_string(freq_hz), j);
-          freq_hz = duc_ctrl[i]->get_arg<double>("freq");
+          freq_hz = duc_ctrl[i]->get_arg<double>("freq", j);
           Debug("Actual Tx " << ch << " freq error: " << tx_center_freq_hz[i] + freq_hz - target_freq << " Hz...");
-        })
+        }
+
+        // Update frequency
+        tx_freq_hz[ch] = target_freq;
+        actual_freq    = tx_center_freq_hz[i] + freq_hz;)
   }
   uhd_error set_rx_freq(uint32_t ch, double target_freq, double& actual_freq) override
   {
@@ -723,31 +791,34 @@ public:
       return UHD_ERROR_NONE;
     }
 
-    // Update frequency
-    rx_freq_hz[ch] = target_freq;
-    actual_freq    = rx_freq_hz[ch];
-
-    Debug("Tuning Rx " << ch << " to " << actual_freq / 1e6 << " MHz...");
+    Debug("Tuning Rx " << ch << " to " << target_freq / 1e6 << " MHz...");
     size_t i = ch / nof_channels;
     size_t j = ch % nof_channels;
 
     SRSRAN_UHD_SAFE_C_LOG_ERROR(
-        // Set Radio Tx freq
+        // Set Radio Rx freq, either the configured wideband center or the first carrier of the radio
         if (not std::isnormal(rx_center_freq_hz[i]) and not loopback) {
-          UHD_LOG_DEBUG(radio_id[i], "Setting RX Freq: " << target_freq / 1e6 << " MHz...");
-          radio_ctrl[i]->set_rx_frequency(target_freq, 0);
+          double radio_freq_hz = std::isnormal(rx_radio_freq_hz) ? rx_radio_freq_hz : target_freq;
+          UHD_LOG_DEBUG(radio_id[i], "Setting RX Freq: " << radio_freq_hz / 1e6 << " MHz...");
+          radio_ctrl[i]->set_rx_frequency(radio_freq_hz, 0);
           rx_center_freq_hz[i] = radio_ctrl[i]->get_rx_frequency(0);
           UHD_LOG_DEBUG(radio_id[i], "Actual RX Freq: " << rx_center_freq_hz[i] / 1e6 << " MHz...");
         }
 
-        // Setup DDC
-        double freq_hz = rx_center_freq_hz[i] - rx_freq_hz[nof_channels * i + j];
-        if (std::round(ddc_ctrl[i]->get_arg<double>("freq") != freq_hz)) {
+        // Setup DDC, it brings the carrier from its offset in the radio band down to baseband
+        double freq_hz = rx_center_freq_hz[i] - target_freq;
+        if (check_carrier_offset("RX", ch, freq_hz, rx_rate_hz) != UHD_ERROR_NONE) { return UHD_ERROR_VALUE; }
+
+        if (std::round(ddc_ctrl[i]->get_arg<double>("freq", j)) != std::round(freq_hz)) {
           UHD_LOG_DEBUG(ddc_id[i], "Setting " << j << " freq: " << freq_hz / 1e6 << " MHz ...");
           ddc_ctrl[i]->set_arg("freq", freq_hz, j);
-          freq_hz = ddc_ctrl[i]->get_arg<double>("freq");
+          freq_hz = ddc_ctrl[i]->get_arg<double>("freq", j);
           Debug("Actual Rx " << ch << " freq error: " << rx_center_freq_hz[i] - freq_hz - target_freq << " Hz...");
-        })
+        }
+
+        // Update frequency
+        rx_freq_hz[ch] = target_freq;
+        actual_freq    = rx_center_freq_hz[i] - freq_hz;)
   }
 };
 
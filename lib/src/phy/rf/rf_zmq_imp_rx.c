@@ -172,7 +172,10 @@ int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       }
     }
 
-    if (srsran_ringbuffer_init(&q->ringbuffer, ZMQ_MAX_BUFFER_SIZE)) {
+    // The async thread is the only writer unless the read is delayed, then the lock-free mode cannot be used
+    int ret_rb = (q->sample_offset > 0) ? srsran_ringbuffer_init(&q->ringbuffer, ZMQ_MAX_BUFFER_SIZE)
+                                        : srsran_ringbuffer_init_spsc(&q->ringbuffer, ZMQ_MAX_BUFFER_SIZE);
+    if (ret_rb) {
       fprintf(stderr, "Error: initiating ringbuffer\n");
       goto clean_exit;
     }
@@ -0,0 +1,280 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/scrambling/scrambling_cache.h"
+#include "srsran/phy/common/sequence.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <string.h>
+
+#ifdef LV_HAVE_SSE
+#include <immintrin.h>
+#endif /* LV_HAVE_SSE */
+
+static inline uint32_t scrambling_cache_home(uint16_t rnti)
+{
+  return rnti % SRSRAN_SCRAMBLING_CACHE_NOF_USERS;
+}
+
+static void scrambling_cache_user_free(srsran_scrambling_cache_user_t* u)
+{
+  for (uint32_t sf = 0; sf < SRSRAN_NOF_SF_X_FRAME; sf++) {
+    for (uint32_t cw = 0; cw < SRSRAN_MAX_CODEWORDS; cw++) {
+      if (u->seq[sf][cw]) {
+        free(u->seq[sf][cw]);
+      }
+    }
+  }
+  SRSRAN_MEM_ZERO(u, srsran_scrambling_cache_user_t, 1);
+}
+
+int srsran_scrambling_cache_init(srsran_scrambling_cache_t* q, uint32_t max_bits)
+{
+  if (q == NULL || max_bits == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_scrambling_cache_t, 1);
+  q->max_bits = max_bits;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_scrambling_cache_set_cell(srsran_scrambling_cache_t* q, uint32_t cell_id)
+{
+  if (q == NULL || q->cell_id == cell_id) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_SCRAMBLING_CACHE_NOF_USERS; i++) {
+    scrambling_cache_user_free(&q->users[i]);
+  }
+  q->cell_id = cell_id;
+}
+
+const uint8_t* srsran_scrambling_cache_get(srsran_scrambling_cache_t* q,
+                                           uint16_t                   rnti,
+                                           uint32_t                   sf_idx,
+                                           uint32_t                   cw_idx,
+                                           uint32_t                   nof_bits)
+{
+  if (q == NULL || rnti == 0 || sf_idx >= SRSRAN_NOF_SF_X_FRAME || cw_idx >= SRSRAN_MAX_CODEWORDS ||
+      nof_bits == 0 || nof_bits > q->max_bits) {
+    return NULL;
+  }
+
+  // Find the user, or the first free slot of its cluster
+  srsran_scrambling_cache_user_t* u = NULL;
+  for (uint32_t n = 0, i = scrambling_cache_home(rnti); n < SRSRAN_SCRAMBLING_CACHE_NOF_USERS && u == NULL; n++) {
+    if (q->users[i].rnti == rnti || q->users[i].rnti == 0) {
+      u = &q->users[i];
+    }
+    i = (i + 1) % SRSRAN_SCRAMBLING_CACHE_NOF_USERS;
+  }
+
+  // The table is full, the caller generates the sequence
+  if (u == NULL) {
+    return NULL;
+  }
+  u->rnti = rnti;
+
+  // The sequence is generated up to the byte boundary, so the packed applier can read whole bytes
+  uint32_t nof_bytes = SRSRAN_CEIL(nof_bits, 8);
+  if (u->seq[sf_idx][cw_idx] == NULL || u->nof_bytes[sf_idx][cw_idx] < nof_bytes) {
+    if (u->seq[sf_idx][cw_idx]) {
+      free(u->seq[sf_idx][cw_idx]);
+    }
+    u->seq[sf_idx][cw_idx]       = srsran_vec_u8_malloc(nof_bytes);
+    u->nof_bytes[sf_idx][cw_idx] = 0;
+    if (u->seq[sf_idx][cw_idx] == NULL) {
+      return NULL;
+    }
+
+    uint32_t seed = srsran_sequence_pdsch_seed(rnti, cw_idx, 2 * sf_idx, q->cell_id);
+    srsran_vec_u8_zero(u->seq[sf_idx][cw_idx], nof_bytes);
+    srsran_sequence_apply_packed(u->seq[sf_idx][cw_idx], u->seq[sf_idx][cw_idx], nof_bytes * 8, seed);
+    u->nof_bytes[sf_idx][cw_idx] = nof_bytes;
+  }
+
+  return u->seq[sf_idx][cw_idx];
+}
+
+void srsran_scrambling_cache_rem_rnti(srsran_scrambling_cache_t* q, uint16_t rnti)
+{
+  if (q == NULL || rnti == 0) {
+    return;
+  }
+
+  uint32_t i = scrambling_cache_home(rnti);
+  uint32_t n = 0;
+  for (; n < SRSRAN_SCRAMBLING_CACHE_NOF_USERS && q->users[i].rnti != rnti; n++) {
+    if (q->users[i].rnti == 0) {
+      return;
+    }
+    i = (i + 1) % SRSRAN_SCRAMBLING_CACHE_NOF_USERS;
+  }
+  if (n == SRSRAN_SCRAMBLING_CACHE_NOF_USERS) {
+    return;
+  }
+  scrambling_cache_user_free(&q->users[i]);
+
+  // Shift back the rest of the cluster, so lookups can keep stopping at the first free slot
+  uint32_t j = (i + 1) % SRSRAN_SCRAMBLING_CACHE_NOF_USERS;
+  while (q->users[j].rnti != 0) {
+    uint32_t home = scrambling_cache_home(q->users[j].rnti);
+
+    // Skip the users whose home lies cyclically in (i, j]
+    bool in_place = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+    if (!in_place) {
+      q->users[i] = q->users[j];
+      SRSRAN_MEM_ZERO(&q->users[j], srsran_scrambling_cache_user_t, 1);
+      i = j;
+    }
+    j = (j + 1) % SRSRAN_SCRAMBLING_CACHE_NOF_USERS;
+  }
+}
+
+void srsran_scrambling_cache_free(srsran_scrambling_cache_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_SCRAMBLING_CACHE_NOF_USERS; i++) {
+    scrambling_cache_user_free(&q->users[i]);
+  }
+  SRSRAN_MEM_ZERO(q, srsran_scrambling_cache_t, 1);
+}
+
+static inline bool scrambling_packed_bit(const uint8_t* seq, uint32_t i)
+{
+  return (seq[i / 8] >> (7 - i % 8)) & 1U;
+}
+
+void srsran_scrambling_packed_apply_c(const uint8_t* seq, const int8_t* in, int8_t* out, uint32_t len)
+{
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX2
+  // Every byte of the sequence selects the sign of 8 soft bits, MSB first
+  const __m256i shuffle_32 = _mm256_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+  const __m256i bits_32 = _mm256_set1_epi64x(0x0102040810204080);
+  for (; i + 32 <= len; i += 32) {
+    int32_t c;
+    memcpy(&c, &seq[i / 8], sizeof(int32_t));
+
+    // Expand the 32 sequence bits into 0x00/0xff masks
+    __m256i mask = _mm256_shuffle_epi8(_mm256_set1_epi32(c), shuffle_32);
+    mask         = _mm256_cmpeq_epi8(_mm256_and_si256(mask, bits_32), bits_32);
+
+    // Negate the masked soft bits, -x = (x ^ 0xff) + 1
+    __m256i v = _mm256_loadu_si256((__m256i*)&in[i]);
+    v         = _mm256_sub_epi8(_mm256_xor_si256(v, mask), mask);
+    _mm256_storeu_si256((__m256i*)&out[i], v);
+  }
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_SSE
+  const __m128i shuffle_16 = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+  const __m128i bits_16    = _mm_set1_epi64x(0x0102040810204080);
+  for (; i + 16 <= len; i += 16) {
+    int16_t c;
+    memcpy(&c, &seq[i / 8], sizeof(int16_t));
+
+    __m128i mask = _mm_shuffle_epi8(_mm_set1_epi16(c), shuffle_16);
+    mask         = _mm_cmpeq_epi8(_mm_and_si128(mask, bits_16), bits_16);
+
+    __m128i v = _mm_loadu_si128((__m128i*)&in[i]);
+    v         = _mm_sub_epi8(_mm_xor_si128(v, mask), mask);
+    _mm_storeu_si128((__m128i*)&out[i], v);
+  }
+#endif /* LV_HAVE_SSE */
+
+  for (; i < len; i++) {
+    out[i] = scrambling_packed_bit(seq, i) ? -in[i] : in[i];
+  }
+}
+
+void srsran_scrambling_packed_apply_s(const uint8_t* seq, const int16_t* in, int16_t* out, uint32_t len)
+{
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX2
+  // The first sequence byte selects the lower lane and the second the upper lane
+  const __m256i shuffle_16 = _mm256_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1);
+  const __m256i bits_16 = _mm256_setr_epi16(0x8080,
+                                            0x4040,
+                                            0x2020,
+                                            0x1010,
+                                            0x0808,
+                                            0x0404,
+                                            0x0202,
+                                            0x0101,
+                                            0x8080,
+                                            0x4040,
+                                            0x2020,
+                                            0x1010,
+                                            0x0808,
+                                            0x0404,
+                                            0x0202,
+                                            0x0101);
+  for (; i + 16 <= len; i += 16) {
+    int16_t c;
+    memcpy(&c, &seq[i / 8], sizeof(int16_t));
+
+    __m256i mask = _mm256_shuffle_epi8(_mm256_set1_epi16(c), shuffle_16);
+    mask         = _mm256_cmpeq_epi16(_mm256_and_si256(mask, bits_16), bits_16);
+
+    __m256i v = _mm256_loadu_si256((__m256i*)&in[i]);
+    v         = _mm256_sub_epi16(_mm256_xor_si256(v, mask), mask);
+    _mm256_storeu_si256((__m256i*)&out[i], v);
+  }
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_SSE
+  const __m128i bits_8 = _mm_setr_epi16(0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+  for (; i + 8 <= len; i += 8) {
+    __m128i mask = _mm_set1_epi16(seq[i / 8]);
+    mask         = _mm_cmpeq_epi16(_mm_and_si128(mask, bits_8), bits_8);
+
+    __m128i v = _mm_loadu_si128((__m128i*)&in[i]);
+    v         = _mm_sub_epi16(_mm_xor_si128(v, mask), mask);
+    _mm_storeu_si128((__m128i*)&out[i], v);
+  }
+#endif /* LV_HAVE_SSE */
+
+  for (; i < len; i++) {
+    out[i] = scrambling_packed_bit(seq, i) ? -in[i] : in[i];
+  }
+}
+
+void srsran_scrambling_packed_apply_bytes(const uint8_t* seq, const uint8_t* in, uint8_t* out, uint32_t len)
+{
+  srsran_vec_xor_bbb(seq, in, out, len / 8);
+
+  // Spare bits, the rest of the last byte is left untouched
+  uint32_t rem8 = len % 8;
+  if (rem8 != 0) {
+    out[len / 8] = in[len / 8] ^ (seq[len / 8] & (uint8_t)(0xffU << (8 - rem8)));
+  }
+}
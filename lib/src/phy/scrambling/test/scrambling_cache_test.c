@@ -0,0 +1,214 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/common/sequence.h"
+#include "srsran/phy/scrambling/scrambling_cache.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+static uint32_t cell_id  = 1;
+static uint32_t nof_bits = 50000;
+static uint32_t nof_reps = 100;
+
+#define NOF_RNTI 6
+
+// RNTIs 0x46 + k * 64 share the same home slot and exercise the probing and the removal shifts
+static const uint16_t rnti_list[NOF_RNTI] = {0x46, 0x86, 0xc6, 0x47, 0x106, 0x48};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [cnr]\n", prog);
+  printf("\t-c Cell identifier [Default %d]\n", cell_id);
+  printf("\t-n Maximum number of bits [Default %d]\n", nof_bits);
+  printf("\t-r Number of repetitions for the benchmark [Default %d]\n", nof_reps);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "cnr")) != -1) {
+    switch (opt) {
+      case 'c':
+        cell_id = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_bits = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_reps = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+typedef struct {
+  int8_t*  c_in;
+  int8_t*  c_gold;
+  int8_t*  c_out;
+  int16_t* s_in;
+  int16_t* s_gold;
+  int16_t* s_out;
+  uint8_t* b_in;
+  uint8_t* b_gold;
+  uint8_t* b_out;
+} buffers_t;
+
+/* Compares the cached sequence of a RNTI against the generator for a length of len bits */
+static int
+test_sequence(srsran_scrambling_cache_t* q, buffers_t* b, uint16_t rnti, uint32_t sf, uint32_t cw, uint32_t len)
+{
+  const uint8_t* seq = srsran_scrambling_cache_get(q, rnti, sf, cw, len);
+  TESTASSERT(seq != NULL);
+
+  srsran_sequence_pdsch_apply_c(b->c_in, b->c_gold, rnti, cw, 2 * sf, cell_id, len);
+  srsran_scrambling_packed_apply_c(seq, b->c_in, b->c_out, len);
+  TESTASSERT(memcmp(b->c_gold, b->c_out, len) == 0);
+
+  srsran_sequence_pdsch_apply_s(b->s_in, b->s_gold, rnti, cw, 2 * sf, cell_id, len);
+  srsran_scrambling_packed_apply_s(seq, b->s_in, b->s_out, len);
+  TESTASSERT(memcmp(b->s_gold, b->s_out, sizeof(int16_t) * len) == 0);
+
+  srsran_sequence_pdsch_apply_pack(b->b_in, b->b_gold, rnti, cw, 2 * sf, cell_id, len);
+  srsran_scrambling_packed_apply_bytes(seq, b->b_in, b->b_out, len);
+  TESTASSERT(memcmp(b->b_gold, b->b_out, len / 8) == 0);
+  if (len % 8) {
+    uint8_t mask = (uint8_t)(0xffU << (8 - len % 8));
+    TESTASSERT(((b->b_gold[len / 8] ^ b->b_out[len / 8]) & mask) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srsran_random_t           random_gen = srsran_random_init(0x1234);
+  srsran_scrambling_cache_t q          = {};
+  buffers_t                 b          = {};
+  int                       ret        = SRSRAN_ERROR;
+
+  b.c_in   = srsran_vec_i8_malloc(nof_bits);
+  b.c_gold = srsran_vec_i8_malloc(nof_bits);
+  b.c_out  = srsran_vec_i8_malloc(nof_bits);
+  b.s_in   = srsran_vec_i16_malloc(nof_bits);
+  b.s_gold = srsran_vec_i16_malloc(nof_bits);
+  b.s_out  = srsran_vec_i16_malloc(nof_bits);
+  b.b_in   = srsran_vec_u8_malloc(SRSRAN_CEIL(nof_bits, 8));
+  b.b_gold = srsran_vec_u8_malloc(SRSRAN_CEIL(nof_bits, 8));
+  b.b_out  = srsran_vec_u8_malloc(SRSRAN_CEIL(nof_bits, 8));
+  if (!b.c_in || !b.c_gold || !b.c_out || !b.s_in || !b.s_gold || !b.s_out || !b.b_in || !b.b_gold || !b.b_out) {
+    goto clean;
+  }
+
+  for (uint32_t i = 0; i < nof_bits; i++) {
+    b.c_in[i] = (int8_t)srsran_random_uniform_int_dist(random_gen, -128, 127);
+    b.s_in[i] = (int16_t)srsran_random_uniform_int_dist(random_gen, -32768, 32767);
+  }
+  for (uint32_t i = 0; i < SRSRAN_CEIL(nof_bits, 8); i++) {
+    b.b_in[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 255);
+  }
+
+  if (srsran_scrambling_cache_init(&q, nof_bits) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating cache");
+    goto clean;
+  }
+  srsran_scrambling_cache_set_cell(&q, cell_id);
+
+  // Lengths out of the SIMD boundaries, and growing lengths that regenerate the cached sequences
+  for (uint32_t r = 0; r < NOF_RNTI; r++) {
+    for (uint32_t sf = 0; sf < SRSRAN_NOF_SF_X_FRAME; sf++) {
+      uint32_t len = 1 + srsran_random_uniform_int_dist(random_gen, 0, 100) * (sf + 1) * 17;
+      len          = SRSRAN_MIN(nof_bits, len);
+      if (test_sequence(&q, &b, rnti_list[r], sf, sf % SRSRAN_MAX_CODEWORDS, len) < SRSRAN_SUCCESS ||
+          test_sequence(&q, &b, rnti_list[r], sf, sf % SRSRAN_MAX_CODEWORDS, nof_bits) < SRSRAN_SUCCESS) {
+        goto clean;
+      }
+    }
+  }
+
+  // Removing the first RNTIs of the cluster shall keep the rest reachable and correct
+  srsran_scrambling_cache_rem_rnti(&q, rnti_list[0]);
+  srsran_scrambling_cache_rem_rnti(&q, rnti_list[2]);
+  for (uint32_t r = 0; r < NOF_RNTI; r++) {
+    if (test_sequence(&q, &b, rnti_list[r], 3, 1, nof_bits - 3) < SRSRAN_SUCCESS) {
+      goto clean;
+    }
+  }
+
+  // Changing the cell drops the sequences of the previous cell
+  cell_id = (cell_id + 1) % SRSRAN_NUM_PCI;
+  srsran_scrambling_cache_set_cell(&q, cell_id);
+  if (test_sequence(&q, &b, rnti_list[1], 7, 0, nof_bits) < SRSRAN_SUCCESS) {
+    goto clean;
+  }
+
+  // Benchmark the cached applier against the generator
+  struct timeval t[3] = {};
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_reps; i++) {
+    srsran_sequence_pdsch_apply_s(b.s_in, b.s_out, rnti_list[1], 0, 14, cell_id, nof_bits);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t gen_us = t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_reps; i++) {
+    const uint8_t* seq = srsran_scrambling_cache_get(&q, rnti_list[1], 7, 0, nof_bits);
+    srsran_scrambling_packed_apply_s(seq, b.s_in, b.s_out, nof_bits);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t cache_us = t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+  printf("16 bit descrambling of %d bits: generator %.1f Mbps; cache %.1f Mbps\n",
+         nof_bits,
+         (double)nof_bits * nof_reps / SRSRAN_MAX(gen_us, 1),
+         (double)nof_bits * nof_reps / SRSRAN_MAX(cache_us, 1));
+
+  ret = SRSRAN_SUCCESS;
+
+clean:
+  srsran_scrambling_cache_free(&q);
+  srsran_random_free(random_gen);
+  free(b.c_in);
+  free(b.c_gold);
+  free(b.c_out);
+  free(b.s_in);
+  free(b.s_gold);
+  free(b.s_out);
+  free(b.b_in);
+  free(b.b_gold);
+  free(b.b_out);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -119,12 +119,18 @@ void srsran_cfo_correct_offset(srsran_cfo_t* h,
                                int           cexp_offset,
                                int           nsamples)
 {
+#if SRSRAN_CFO_USE_EXP_TABLE
   if (fabs(h->last_freq - freq) > h->tol) {
     h->last_freq = freq;
     srsran_cexptab_gen(&h->tab, h->cur_cexp, h->last_freq, h->nsamples);
     DEBUG("CFO generating new table for frequency %.4fe-6", freq * 1e6);
   }
   srsran_vec_prod_ccc(&h->cur_cexp[cexp_offset], input, output, nsamples);
+#else  /* SRSRAN_CFO_USE_EXP_TABLE */
+  // Start the oscillator where the table would have been read from
+  cf_t phase = cexpf(_Complex_I * 2.0f * (float)M_PI * freq * (float)cexp_offset);
+  srsran_vec_apply_cfo_phase(input, freq, phase, output, nsamples);
+#endif /* SRSRAN_CFO_USE_EXP_TABLE */
 }
 
 float srsran_cfo_est_corr_cp(cf_t* input_buffer, uint32_t nof_prb)
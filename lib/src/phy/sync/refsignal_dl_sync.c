@@ -376,11 +376,51 @@ int refsignal_dl_sync_find_peak(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uin
   return ret;
 }
 
-int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+static int refsignal_dl_sync_track_peak(srsran_refsignal_dl_sync_t* q,
+                                        cf_t*                       buffer,
+                                        uint32_t                    nsamples,
+                                        uint32_t                    peak_idx_hint,
+                                        uint32_t                    window)
 {
-  if (q == NULL || buffer == NULL) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
+  uint32_t sf_len = q->ifft.sf_sz;
+  if (sf_len == 0 || nsamples < sf_len) {
+    return SRSRAN_ERROR;
+  }
+
+  // Correlate with the first subframe only at the lags around the previous peak
+  uint32_t n_start = (peak_idx_hint > window) ? peak_idx_hint - window : 0;
+  uint32_t n_end   = SRSRAN_MIN(peak_idx_hint + window, nsamples - sf_len);
+  if (n_start > n_end) {
+    return SRSRAN_ERROR;
+  }
+
+  float    peak_value = 0.0f;
+  uint32_t peak_idx   = n_start;
+  for (uint32_t n = n_start; n <= n_end; n++) {
+    float corr = cabsf(srsran_vec_dot_prod_conj_ccc(&buffer[n], q->sequences[0], sf_len));
+    if (corr > peak_value) {
+      peak_value = corr;
+      peak_idx   = n;
+    }
   }
+
+  INFO("pci=%03d; sf_len=%d; hint=%d; imax=%d; peak=%.3f",
+       q->refsignal.cell.id,
+       sf_len,
+       peak_idx_hint,
+       peak_idx,
+       peak_value);
+
+  // A peak on the edge of the window means the cell timing has moved beyond it
+  if (window > 0 && (peak_idx == n_start || peak_idx == n_end)) {
+    return SRSRAN_ERROR;
+  }
+
+  return (int)peak_idx;
+}
+
+static void refsignal_dl_sync_measure(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples, int peak_idx)
+{
   uint32_t sf_len                 = q->ifft.sf_sz;
   uint32_t sf_count               = 0;
   float    rsrp_lin               = 0.0f;
@@ -395,9 +435,6 @@ int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, ui
   float    rsrp_false_avg         = 0.0f;
   bool     false_alarm            = false;
 
-  // Stage 1: find peak
-  int peak_idx = refsignal_dl_sync_find_peak(q, buffer, nsamples);
-
   // Stage 2: Proccess subframes
   if (peak_idx >= 0) {
     // Calculate initial subframe index and sample
@@ -522,6 +559,38 @@ int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, ui
   } else {
     refsignal_set_results_not_found(q);
   }
+}
+
+int srsran_refsignal_dl_sync_run(srsran_refsignal_dl_sync_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  if (q == NULL || buffer == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Stage 1: find peak
+  int peak_idx = refsignal_dl_sync_find_peak(q, buffer, nsamples);
+
+  // Stage 2 and 3: measure subframes and decide
+  refsignal_dl_sync_measure(q, buffer, nsamples, peak_idx);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_refsignal_dl_sync_track(srsran_refsignal_dl_sync_t* q,
+                                   cf_t*                       buffer,
+                                   uint32_t                    nsamples,
+                                   uint32_t                    peak_idx_hint,
+                                   uint32_t                    window)
+{
+  if (q == NULL || buffer == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Stage 1: find peak around the hint
+  int peak_idx = refsignal_dl_sync_track_peak(q, buffer, nsamples, peak_idx_hint, window);
+
+  // Stage 2 and 3: measure subframes and decide
+  refsignal_dl_sync_measure(q, buffer, nsamples, peak_idx);
 
   return SRSRAN_SUCCESS;
 }
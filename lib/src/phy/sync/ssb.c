@@ -102,7 +102,8 @@ int srsran_ssb_init(srsran_ssb_t* q, const srsran_ssb_args_t* args)
   }
 
   // Copy arguments
-  q->args = *args;
+  q->args          = *args;
+  q->sync_grid_key = 0;
 
   // Check if the maximum sampling rate is in range, force default otherwise
   q->args.max_srate_hz  = (!isnormal(q->args.max_srate_hz)) ? SRSRAN_SSB_DEFAULT_MAX_SRATE_HZ : q->args.max_srate_hz;
@@ -338,20 +339,9 @@ static void ssb_modulate_symbol(srsran_ssb_t* q, cf_t ssb_grid[SRSRAN_SSB_NOF_RE
   }
 }
 
-static int ssb_setup_corr(srsran_ssb_t* q)
+// Plans the correlation DFTs for a given correlation size
+static int ssb_setup_corr_plan(srsran_ssb_t* q, uint32_t corr_sz)
 {
-  // Skip if disabled
-  if (!q->args.enable_search) {
-    return SRSRAN_SUCCESS;
-  }
-
-  // Compute new correlation size
-  uint32_t corr_sz = SSB_CORR_SZ(q->symbol_sz);
-
-  // Skip if the symbol size is unchanged
-  if (q->corr_sz == corr_sz) {
-    return SRSRAN_SUCCESS;
-  }
   q->corr_sz = corr_sz;
 
   // Select correlation window, return error if the correlation window is smaller than a symbol
@@ -377,6 +367,30 @@ static int ssb_setup_corr(srsran_ssb_t* q)
     return SRSRAN_ERROR;
   }
 
+  return SRSRAN_SUCCESS;
+}
+
+static int ssb_setup_corr(srsran_ssb_t* q)
+{
+  // Skip if disabled
+  if (!q->args.enable_search) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Compute new correlation size
+  uint32_t corr_sz = SSB_CORR_SZ(q->symbol_sz);
+
+  // Skip if the symbol size and the frequency offset are unchanged, the PSS sequences are still valid
+  if (q->corr_sz == corr_sz && q->corr_f_offset == q->f_offset) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Replan the correlation only if the size changed
+  if (q->corr_sz != corr_sz && ssb_setup_corr_plan(q, corr_sz) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  q->corr_f_offset = q->f_offset;
+
   // Zero the time domain signal last samples
   srsran_vec_cf_zero(&q->tmp_time[q->symbol_sz], q->corr_window);
 
@@ -490,7 +504,8 @@ int srsran_ssb_set_cfg(srsran_ssb_t* q, const srsran_ssb_cfg_t* cfg)
   }
 
   // Finally, copy configuration
-  q->cfg       = *cfg;
+  q->cfg           = *cfg;
+  q->sync_grid_key = 0;
   q->symbol_sz = symbol_sz;
   q->sf_sz     = (uint32_t)round(1e-3 * cfg->srate_hz);
   q->ssb_sz    = SRSRAN_SSB_DURATION_NSYMB * (q->symbol_sz + q->cp_sz);
@@ -540,31 +555,40 @@ static int ssb_encode(srsran_ssb_t* q, uint32_t N_id, const srsran_pbch_msg_nr_t
 {
   uint32_t N_id_1 = SRSRAN_NID_1_NR(N_id);
   uint32_t N_id_2 = SRSRAN_NID_2_NR(N_id);
+  uint32_t key    = 1 + (N_id | (msg->hrf ? 1U : 0U) << 10U | msg->ssb_idx << 11U);
 
-  // Put PSS
-  if (srsran_pss_nr_put(ssb_grid, N_id_2, q->cfg.beta_pss) < SRSRAN_SUCCESS) {
-    ERROR("Error putting PSS");
-    return SRSRAN_ERROR;
-  }
+  // PSS, SSS and PBCH DMRS only change with the cell, half radio frame and SSB index
+  if (q->sync_grid_key != key) {
+    srsran_vec_cf_zero(q->sync_grid, SRSRAN_SSB_NOF_RE);
+    q->sync_grid_key = 0;
 
-  // Put SSS
-  if (srsran_sss_nr_put(ssb_grid, N_id_1, N_id_2, q->cfg.beta_sss) < SRSRAN_SUCCESS) {
-    ERROR("Error putting PSS");
-    return SRSRAN_ERROR;
-  }
+    // Put PSS
+    if (srsran_pss_nr_put(q->sync_grid, N_id_2, q->cfg.beta_pss) < SRSRAN_SUCCESS) {
+      ERROR("Error putting PSS");
+      return SRSRAN_ERROR;
+    }
 
-  // Put PBCH DMRS
-  srsran_dmrs_pbch_cfg_t pbch_dmrs_cfg = {};
-  pbch_dmrs_cfg.N_id                   = N_id;
-  pbch_dmrs_cfg.n_hf                   = msg->hrf ? 1 : 0;
-  pbch_dmrs_cfg.ssb_idx                = msg->ssb_idx;
-  pbch_dmrs_cfg.L_max                  = q->Lmax;
-  pbch_dmrs_cfg.beta                   = 0.0f;
-  pbch_dmrs_cfg.scs                    = q->cfg.scs;
-  if (srsran_dmrs_pbch_put(&pbch_dmrs_cfg, ssb_grid) < SRSRAN_SUCCESS) {
-    ERROR("Error putting PBCH DMRS");
-    return SRSRAN_ERROR;
+    // Put SSS
+    if (srsran_sss_nr_put(q->sync_grid, N_id_1, N_id_2, q->cfg.beta_sss) < SRSRAN_SUCCESS) {
+      ERROR("Error putting PSS");
+      return SRSRAN_ERROR;
+    }
+
+    // Put PBCH DMRS
+    srsran_dmrs_pbch_cfg_t pbch_dmrs_cfg = {};
+    pbch_dmrs_cfg.N_id                   = N_id;
+    pbch_dmrs_cfg.n_hf                   = msg->hrf ? 1 : 0;
+    pbch_dmrs_cfg.ssb_idx                = msg->ssb_idx;
+    pbch_dmrs_cfg.L_max                  = q->Lmax;
+    pbch_dmrs_cfg.beta                   = 0.0f;
+    pbch_dmrs_cfg.scs                    = q->cfg.scs;
+    if (srsran_dmrs_pbch_put(&pbch_dmrs_cfg, q->sync_grid) < SRSRAN_SUCCESS) {
+      ERROR("Error putting PBCH DMRS");
+      return SRSRAN_ERROR;
+    }
+    q->sync_grid_key = key;
   }
+  srsran_vec_cf_copy(ssb_grid, q->sync_grid, SRSRAN_SSB_NOF_RE);
 
   // Put PBCH payload
   srsran_pbch_nr_cfg_t pbch_cfg = {};
@@ -0,0 +1,235 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+#include "srsran/srsran.h"
+
+#define NOF_SF 6
+#define SB_LEN (NOF_SF * SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB))
+
+static double   srate_hz    = 11.52e6;
+static uint32_t nof_threads = 2;
+static float    snr_db      = 10.0f;
+
+typedef struct {
+  double   freq_offset_hz;
+  uint32_t cell_id;
+} test_cell_t;
+
+// The carriers without a cell are far enough from the others for their sub-bands not to contain any PSS
+static const test_cell_t cells[]          = {{-3.5e6, 17}, {1.2e6 + 37.0, 301}, {4.0e6 - 120.0, 502}};
+static const double      empty_carriers[] = {-1.4e6, 2.7e6};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [stnv]\n", prog);
+  printf("\t-s wideband sampling rate in Hz [Default %.2f MHz]\n", srate_hz / 1e6);
+  printf("\t-t number of worker threads [Default %d]\n", nof_threads);
+  printf("\t-n SNR in dB [Default %.1f]\n", snr_db);
+  printf("\t-v srsran_verbose\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "stnv")) != -1) {
+    switch (opt) {
+      case 's':
+        srate_hz = strtod(argv[optind], NULL);
+        break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/* Generates NOF_SF subframes of a 6 PRB cell transmitting only PSS and SSS, at 1.92 MHz */
+static int gen_cell(uint32_t cell_id, cf_t* signal)
+{
+  cf_t          pss[SRSRAN_PSS_LEN];
+  float         sss0[SRSRAN_SSS_LEN];
+  float         sss5[SRSRAN_SSS_LEN];
+  cf_t*         grid = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM));
+  srsran_ofdm_t ifft = {};
+  uint32_t      sf_len = SB_LEN / NOF_SF;
+
+  if (grid == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  srsran_pss_generate(pss, cell_id % 3);
+  srsran_sss_generate(sss0, sss5, cell_id);
+
+  for (uint32_t sf_idx = 0; sf_idx < NOF_SF; sf_idx++) {
+    if (srsran_ofdm_tx_init(&ifft, SRSRAN_CP_NORM, grid, &signal[sf_idx * sf_len], SRSRAN_CS_NOF_PRB)) {
+      ERROR("Error creating iFFT object");
+      free(grid);
+      return SRSRAN_ERROR;
+    }
+
+    srsran_vec_cf_zero(grid, SRSRAN_SF_LEN_RE(SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM));
+    if (sf_idx == 0 || sf_idx == 5) {
+      srsran_pss_put_slot(pss, grid, SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+      srsran_sss_put_slot(sf_idx ? sss5 : sss0, grid, SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+    }
+    srsran_ofdm_tx_sf(&ifft);
+    srsran_ofdm_tx_free(&ifft);
+  }
+
+  free(grid);
+  return SRSRAN_SUCCESS;
+}
+
+/* Interpolates a 1.92 MHz signal to the wideband rate, shifted to freq_offset_hz, and adds it to wb */
+static int add_cell(const cf_t* signal, double freq_offset_hz, cf_t* wb, uint32_t wb_len)
+{
+  srsran_dft_plan_t fft = {}, ifft = {};
+  cf_t*             sb_spectrum = srsran_vec_cf_malloc(SB_LEN);
+  cf_t*             wb_spectrum = srsran_vec_cf_malloc(wb_len);
+  cf_t*             wb_signal   = srsran_vec_cf_malloc(wb_len);
+
+  if (sb_spectrum == NULL || wb_spectrum == NULL || wb_signal == NULL ||
+      srsran_dft_plan_c(&fft, SB_LEN, SRSRAN_DFT_FORWARD) < SRSRAN_SUCCESS ||
+      srsran_dft_plan_c(&ifft, wb_len, SRSRAN_DFT_BACKWARD) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  srsran_dft_run_c(&fft, signal, sb_spectrum);
+
+  srsran_vec_cf_zero(wb_spectrum, wb_len);
+  srsran_vec_cf_copy(wb_spectrum, sb_spectrum, SB_LEN / 2);
+  srsran_vec_cf_copy(&wb_spectrum[wb_len - SB_LEN / 2], &sb_spectrum[SB_LEN / 2], SB_LEN / 2);
+  srsran_dft_run_c(&ifft, wb_spectrum, wb_signal);
+
+  srsran_vec_apply_cfo(wb_signal, (float)(freq_offset_hz / srate_hz), wb_signal, wb_len);
+  srsran_vec_sum_ccc(wb, wb_signal, wb, wb_len);
+
+  srsran_dft_plan_free(&fft);
+  srsran_dft_plan_free(&ifft);
+  free(sb_spectrum);
+  free(wb_spectrum);
+  free(wb_signal);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  const uint32_t nof_cells    = sizeof(cells) / sizeof(cells[0]);
+  const uint32_t nof_empty    = sizeof(empty_carriers) / sizeof(empty_carriers[0]);
+  const uint32_t nof_carriers = nof_cells + nof_empty;
+  const uint32_t wb_len       = (uint32_t)round(SB_LEN * srate_hz / SRSRAN_CS_SAMP_FREQ);
+
+  cf_t*                            sb      = srsran_vec_cf_malloc(SB_LEN);
+  cf_t*                            wb      = srsran_vec_cf_malloc(wb_len);
+  double                           freqs[nof_carriers];
+  srsran_ue_cellsearch_wb_result_t results[nof_carriers];
+  srsran_ue_cellsearch_wb_t        cs = {};
+
+  if (sb == NULL || wb == NULL) {
+    goto clean_exit;
+  }
+
+  srsran_vec_cf_zero(wb, wb_len);
+  for (uint32_t i = 0; i < nof_cells; i++) {
+    if (gen_cell(cells[i].cell_id, sb) < SRSRAN_SUCCESS || add_cell(sb, cells[i].freq_offset_hz, wb, wb_len)) {
+      ERROR("Error generating cell %d", cells[i].cell_id);
+      goto clean_exit;
+    }
+    freqs[i] = cells[i].freq_offset_hz;
+  }
+  for (uint32_t i = 0; i < nof_empty; i++) {
+    freqs[nof_cells + i] = empty_carriers[i];
+  }
+
+  // The noise is referred to the average power of the wideband signal
+  float noise_var = srsran_vec_avg_power_cf(wb, wb_len) * srsran_convert_dB_to_power(-snr_db);
+  srsran_ch_awgn_c(wb, wb, noise_var, wb_len);
+
+  srsran_ue_cellsearch_wb_args_t args = {};
+  args.srate_hz                       = srate_hz;
+  args.nof_samples                    = wb_len;
+  args.nof_threads                    = nof_threads;
+  if (srsran_ue_cellsearch_wb_init(&cs, &args) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating wideband cell search");
+    goto clean_exit;
+  }
+
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+  int nof_found = srsran_ue_cellsearch_wb_run(&cs, wb, freqs, nof_carriers, results);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  if (nof_found != (int)nof_cells) {
+    ERROR("Found %d cells, expected %d", nof_found, nof_cells);
+  }
+
+  ret = (nof_found == (int)nof_cells) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+  for (uint32_t i = 0; i < nof_carriers; i++) {
+    srsran_ue_cellsearch_wb_result_t* r = &results[i];
+    printf("carrier %+8.3f MHz: ", r->freq_offset_hz / 1e6);
+    if (r->found) {
+      printf("cell_id=%3d, psr=%5.1f, cfo=%+6.1f Hz\n", r->cell.cell_id, r->cell.psr, r->cell.cfo);
+    } else {
+      printf("no cell\n");
+    }
+
+    bool expected = i < nof_cells;
+    if (r->found != expected || (expected && r->cell.cell_id != cells[i].cell_id)) {
+      ERROR("Wrong result on carrier %+.3f MHz", r->freq_offset_hz / 1e6);
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  printf("Searched %d carriers in %ld us\n", nof_carriers, t[0].tv_usec + t[0].tv_sec * 1000000);
+
+clean_exit:
+  srsran_ue_cellsearch_wb_free(&cs);
+  if (sb) {
+    free(sb);
+  }
+  if (wb) {
+    free(wb);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -0,0 +1,293 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/sync/sync.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+#define CS_WB_FFT_SIZE 128
+
+// The PSS is searched in half a frame, leaving room before it for the SSS of TDD cells with extended CP
+#define CS_WB_FIND_OFFSET (4 * (CS_WB_FFT_SIZE + SRSRAN_CP_LEN_EXT(CS_WB_FFT_SIZE)))
+#define CS_WB_FIND_LEN ((uint32_t)(SRSRAN_CS_SAMP_FREQ / 200))
+#define CS_WB_MIN_SB_SAMPLES (CS_WB_FIND_OFFSET + CS_WB_FIND_LEN + CS_WB_FFT_SIZE)
+
+typedef struct {
+  pthread_t                  pthread;
+  srsran_ue_cellsearch_wb_t* q;
+  uint32_t                   worker_idx;
+
+  srsran_dft_plan_t ifft;
+  srsran_sync_t     sync;
+  cf_t*             sb;
+
+  // Carriers of the current search
+  const double*                     freq_offsets_hz;
+  uint32_t                          nof_carriers;
+  srsran_ue_cellsearch_wb_result_t* results;
+} cs_wb_worker_t;
+
+static void cs_wb_worker_free(cs_wb_worker_t* w)
+{
+  srsran_dft_plan_free(&w->ifft);
+  srsran_sync_free(&w->sync);
+  if (w->sb) {
+    free(w->sb);
+  }
+}
+
+static int cs_wb_worker_init(srsran_ue_cellsearch_wb_t* q, cs_wb_worker_t* w, uint32_t worker_idx)
+{
+  w->q          = q;
+  w->worker_idx = worker_idx;
+
+  w->sb = srsran_vec_cf_malloc(q->nof_sb_samples);
+  if (w->sb == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_dft_plan_c(&w->ifft, q->nof_sb_samples, SRSRAN_DFT_BACKWARD) < SRSRAN_SUCCESS) {
+    ERROR("Error planning sub-band DFT");
+    return SRSRAN_ERROR;
+  }
+  srsran_dft_plan_set_norm(&w->ifft, true);
+
+  if (srsran_sync_init(&w->sync, CS_WB_FIND_LEN, CS_WB_FIND_LEN, CS_WB_FFT_SIZE) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating sync");
+    return SRSRAN_ERROR;
+  }
+  srsran_sync_set_threshold(&w->sync, q->args.threshold);
+  srsran_sync_set_cfo_i_enable(&w->sync, false);
+  srsran_sync_set_cfo_pss_enable(&w->sync, true);
+  srsran_sync_sss_en(&w->sync, true);
+  srsran_sync_cp_en(&w->sync, true);
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Cuts the band of a carrier, centred at bin, from the wideband spectrum and transforms it back to time */
+static void cs_wb_channelize(srsran_ue_cellsearch_wb_t* q, cs_wb_worker_t* w, int bin)
+{
+  uint32_t N    = q->args.nof_samples;
+  uint32_t M    = q->nof_sb_samples;
+  uint32_t half = M / 2;
+
+  // The DFT has the DC in the first bin, the negative frequencies are at the end
+  cf_t* sb = w->sb;
+  for (uint32_t k = 0; k < half; k++) {
+    sb[k] = q->spectrum[((int)N + bin + (int)k) % (int)N];
+  }
+  for (uint32_t k = 1; k <= M - half; k++) {
+    sb[M - k] = q->spectrum[((int)N + bin - (int)k) % (int)N];
+  }
+
+  srsran_dft_run_c(&w->ifft, sb, sb);
+}
+
+/* Searches the three PSS on one sub-band and keeps the strongest cell whose SSS is detected */
+static void cs_wb_search_carrier(cs_wb_worker_t* w, srsran_ue_cellsearch_wb_result_t* res)
+{
+  float best_peak = 0.0f;
+
+  for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
+    uint32_t peak_pos = 0;
+
+    srsran_sync_reset(&w->sync);
+    srsran_sync_cfo_reset(&w->sync, 0.0f);
+    srsran_sync_set_N_id_2(&w->sync, N_id_2);
+    if (srsran_sync_find(&w->sync, w->sb, CS_WB_FIND_OFFSET, &peak_pos) != SRSRAN_SYNC_FOUND ||
+        !srsran_sync_sss_detected(&w->sync)) {
+      continue;
+    }
+
+    float peak = srsran_sync_get_peak_value(&w->sync);
+    if (peak > best_peak) {
+      best_peak            = peak;
+      res->found           = true;
+      res->cell.cell_id    = (uint32_t)srsran_sync_get_cell_id(&w->sync);
+      res->cell.cp         = srsran_sync_get_cp(&w->sync);
+      res->cell.frame_type = w->sync.frame_type;
+      res->cell.peak       = peak;
+      res->cell.psr        = peak;
+      res->cell.mode       = 1.0f;
+      res->cell.cfo        = 15000.0f * srsran_sync_get_cfo(&w->sync);
+    }
+  }
+}
+
+static void* cs_wb_worker_run(void* arg)
+{
+  cs_wb_worker_t*            w = (cs_wb_worker_t*)arg;
+  srsran_ue_cellsearch_wb_t* q = w->q;
+
+  // Carriers are interleaved among the workers
+  for (uint32_t c = w->worker_idx; c < w->nof_carriers; c += q->nof_workers) {
+    srsran_ue_cellsearch_wb_result_t* res = &w->results[c];
+
+    double bin_hz = q->args.srate_hz / q->args.nof_samples;
+    int    bin    = (int)lround(w->freq_offsets_hz[c] / bin_hz);
+
+    cs_wb_channelize(q, w, bin);
+    cs_wb_search_carrier(w, res);
+
+    // The carrier is not centred exactly in the sub-band, the remainder is seen as CFO
+    if (res->found) {
+      res->cell.cfo -= (float)(w->freq_offsets_hz[c] - bin * bin_hz);
+    }
+  }
+
+  return NULL;
+}
+
+int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t* q, const srsran_ue_cellsearch_wb_args_t* args)
+{
+  if (q == NULL || args == NULL || !isnormal(args->srate_hz) || args->srate_hz < SRSRAN_CS_SAMP_FREQ) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  memset(q, 0, sizeof(srsran_ue_cellsearch_wb_t));
+  q->args = *args;
+  if (q->args.threshold <= 0.0f) {
+    q->args.threshold = SRSRAN_CS_WB_DEFAULT_THRESHOLD;
+  }
+
+  // The capture must hold an integer number of sub-band samples
+  double nof_sb_samples = (double)args->nof_samples * SRSRAN_CS_SAMP_FREQ / args->srate_hz;
+  q->nof_sb_samples     = (uint32_t)round(nof_sb_samples);
+  if (fabs(nof_sb_samples - q->nof_sb_samples) > 1e-6 || q->nof_sb_samples < CS_WB_MIN_SB_SAMPLES) {
+    ERROR("Invalid wideband capture of %d samples at %.2f MHz", args->nof_samples, args->srate_hz / 1e6);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  q->spectrum = srsran_vec_cf_malloc(args->nof_samples);
+  if (q->spectrum == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_dft_plan_c(&q->fft, args->nof_samples, SRSRAN_DFT_FORWARD) < SRSRAN_SUCCESS) {
+    ERROR("Error planning wideband DFT");
+    srsran_ue_cellsearch_wb_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  // Without threads, the calling thread runs the only worker
+  q->nof_workers = SRSRAN_MAX(args->nof_threads, 1);
+  q->workers     = calloc(q->nof_workers, sizeof(cs_wb_worker_t));
+  if (q->workers == NULL) {
+    srsran_ue_cellsearch_wb_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  cs_wb_worker_t* workers = (cs_wb_worker_t*)q->workers;
+  for (uint32_t i = 0; i < q->nof_workers; i++) {
+    if (cs_wb_worker_init(q, &workers[i], i) < SRSRAN_SUCCESS) {
+      srsran_ue_cellsearch_wb_free(q);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->workers) {
+    cs_wb_worker_t* workers = (cs_wb_worker_t*)q->workers;
+    for (uint32_t i = 0; i < q->nof_workers; i++) {
+      cs_wb_worker_free(&workers[i]);
+    }
+    free(q->workers);
+  }
+
+  srsran_dft_plan_free(&q->fft);
+  if (q->spectrum) {
+    free(q->spectrum);
+  }
+
+  memset(q, 0, sizeof(srsran_ue_cellsearch_wb_t));
+}
+
+int srsran_ue_cellsearch_wb_run(srsran_ue_cellsearch_wb_t*        q,
+                                const cf_t*                       samples,
+                                const double*                     freq_offsets_hz,
+                                uint32_t                          nof_carriers,
+                                srsran_ue_cellsearch_wb_result_t* results)
+{
+  if (q == NULL || samples == NULL || freq_offsets_hz == NULL || results == NULL || q->workers == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Every carrier must fit, with its whole sub-band, in the captured bandwidth
+  double max_offset_hz = (q->args.srate_hz - SRSRAN_CS_SAMP_FREQ) / 2;
+  for (uint32_t c = 0; c < nof_carriers; c++) {
+    if (fabs(freq_offsets_hz[c]) > max_offset_hz) {
+      ERROR("Carrier at %+.2f MHz is out of the captured bandwidth", freq_offsets_hz[c] / 1e6);
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+    memset(&results[c], 0, sizeof(srsran_ue_cellsearch_wb_result_t));
+    results[c].freq_offset_hz = freq_offsets_hz[c];
+  }
+
+  // A single transform of the capture serves all the carriers
+  srsran_dft_run_c(&q->fft, samples, q->spectrum);
+
+  cs_wb_worker_t* workers   = (cs_wb_worker_t*)q->workers;
+  uint32_t        nof_start = 0;
+  for (uint32_t i = 0; i < q->nof_workers; i++) {
+    workers[i].freq_offsets_hz = freq_offsets_hz;
+    workers[i].nof_carriers    = nof_carriers;
+    workers[i].results         = results;
+  }
+
+  if (q->args.nof_threads == 0) {
+    cs_wb_worker_run(&workers[0]);
+  } else {
+    for (; nof_start < q->nof_workers; nof_start++) {
+      if (pthread_create(&workers[nof_start].pthread, NULL, cs_wb_worker_run, &workers[nof_start])) {
+        ERROR("Creating wideband cell search worker thread");
+        break;
+      }
+    }
+    for (uint32_t i = 0; i < nof_start; i++) {
+      pthread_join(workers[i].pthread, NULL);
+    }
+    if (nof_start != q->nof_workers) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  int nof_found = 0;
+  for (uint32_t c = 0; c < nof_carriers; c++) {
+    nof_found += results[c].found ? 1 : 0;
+  }
+
+  return nof_found;
+}
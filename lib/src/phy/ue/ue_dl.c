@@ -423,13 +423,11 @@ static int dci_blind_search(srsran_ue_dl_t*     q,
 {
   uint32_t nof_dci = 0;
   if (rnti) {
+    // Queue the candidates of all the locations not allocated yet and decode them together
+    bool     queued[SRSRAN_MAX_CANDIDATES] = {};
+    uint32_t nof_candidates                = 0;
     for (int l = 0; l < search_space->nof_locations; l++) {
-      if (nof_dci >= SRSRAN_MAX_DCI_MSG) {
-        ERROR("Can't store more DCIs in buffer");
-        return nof_dci;
-      }
       if (dci_location_is_allocated(q, search_space->loc[l])) {
-        INFO("Skipping location L=%d, ncce=%d. Already allocated", search_space->loc[l].L, search_space->loc[l].ncce);
         continue;
       }
       for (uint32_t f = 0; f < search_space->nof_formats; f++) {
@@ -440,17 +438,44 @@ static int dci_blind_search(srsran_ue_dl_t*     q,
              l,
              search_space->nof_locations);
 
-        // Try to decode a valid DCI msg
-        dci_msg[nof_dci].location = search_space->loc[l];
-        dci_msg[nof_dci].format   = search_space->formats[f];
-        dci_msg[nof_dci].rnti     = 0;
-        if (srsran_pdcch_decode_msg(&q->pdcch, sf, dci_cfg, &dci_msg[nof_dci])) {
-          ERROR("Error decoding DCI msg");
-          return SRSRAN_ERROR;
-        }
+        srsran_dci_msg_t* candidate = &q->dci_candidates[nof_candidates++];
+        candidate->location         = search_space->loc[l];
+        candidate->format           = search_space->formats[f];
+        candidate->rnti             = 0;
+        candidate->nof_bits         = 0;
+      }
+      queued[l] = true;
+    }
 
+    if (srsran_pdcch_decode_msg_batch(&q->pdcch, sf, dci_cfg, q->dci_candidates, nof_candidates)) {
+      ERROR("Error decoding DCI msg");
+      return SRSRAN_ERROR;
+    }
+
+    // Go through the decoded candidates in the same order as they were queued
+    srsran_dci_msg_t* candidates = q->dci_candidates;
+    for (int l = 0; l < search_space->nof_locations; l++) {
+      if (nof_dci >= SRSRAN_MAX_DCI_MSG) {
+        ERROR("Can't store more DCIs in buffer");
+        return nof_dci;
+      }
+      if (!queued[l]) {
+        INFO("Skipping location L=%d, ncce=%d. Already allocated", search_space->loc[l].L, search_space->loc[l].ncce);
+        continue;
+      }
+      srsran_dci_msg_t* location_candidates = candidates;
+      candidates += search_space->nof_formats;
+
+      // A message found in a previous location of this search may overlap
+      if (dci_location_is_allocated(q, search_space->loc[l])) {
+        INFO("Skipping location L=%d, ncce=%d. Already allocated", search_space->loc[l].L, search_space->loc[l].ncce);
+        continue;
+      }
+      for (uint32_t f = 0; f < search_space->nof_formats; f++) {
         // Check if RNTI is matched
-        if ((dci_msg[nof_dci].rnti == rnti) && (dci_msg[nof_dci].nof_bits > 0)) {
+        if ((location_candidates[f].rnti == rnti) && (location_candidates[f].nof_bits > 0)) {
+          dci_msg[nof_dci] = location_candidates[f];
+
           // Compute decoded message correlation to drastically reduce false alarm probability
           float corr = srsran_pdcch_msg_corr(&q->pdcch, &dci_msg[nof_dci]);
 
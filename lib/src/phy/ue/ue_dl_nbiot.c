@@ -752,43 +752,29 @@ int srsran_nbiot_ue_dl_decode_npdsch_no_bcch(srsran_nbiot_ue_dl_t* q, uint8_t* d
        q->npdsch_cfg.num_sf + 1,
        q->npdsch_cfg.grant.nof_sf * q->npdsch_cfg.grant.nof_rep);
 
-  if (q->npdsch_cfg.num_sf % q->npdsch_cfg.grant.nof_rep == 0) {
+  // The repetitions carry the same symbols, they are combined coherently by accumulating the subframe samples and
+  // the channel estimates. The first block of repetitions of every subframe is received before any other block
+  uint32_t m         = SRSRAN_MIN(q->npdsch_cfg.grant.nof_rep, 4);
+  uint32_t sf_offset = q->npdsch_cfg.sf_idx * q->nof_re;
+  bool     is_first  = q->npdsch_cfg.num_sf < q->npdsch_cfg.grant.nof_sf * m && q->npdsch_cfg.num_sf % m == 0;
+  if (is_first) {
     // copy data and ce symbols for first repetition of each subframe
-    srsran_vec_cf_copy(&q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re], q->sf_symbols, q->nof_re);
+    srsran_vec_cf_copy(&q->sf_buffer[sf_offset], q->sf_symbols, q->nof_re);
     for (int i = 0; i < q->cell.nof_ports; i++) {
-      srsran_vec_cf_copy(&q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re], q->ce[i], q->nof_re);
+      srsran_vec_cf_copy(&q->ce_buffer[i][sf_offset], q->ce[i], q->nof_re);
     }
   } else {
     // accumulate subframe samples and channel estimates
-    srsran_vec_sum_ccc(&q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re],
-                       q->sf_symbols,
-                       &q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re],
-                       q->nof_re);
+    srsran_vec_sum_ccc(&q->sf_buffer[sf_offset], q->sf_symbols, &q->sf_buffer[sf_offset], q->nof_re);
     for (int i = 0; i < q->cell.nof_ports; i++) {
-      srsran_vec_sum_ccc(&q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re],
-                         q->ce[i],
-                         &q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re],
-                         q->nof_re);
+      srsran_vec_sum_ccc(&q->ce_buffer[i][sf_offset], q->ce[i], &q->ce_buffer[i][sf_offset], q->nof_re);
     }
   }
   q->npdsch_cfg.num_sf++;
   // srsran_nbiot_ue_dl_save_signal(q, input, sfn, sf_idx);
 
   q->npdsch_cfg.rep_idx++;
-  int m = SRSRAN_MIN(q->npdsch_cfg.grant.nof_rep, 4);
   if (q->npdsch_cfg.rep_idx % m == 0) {
-    // average accumulated samples
-    srsran_vec_sc_prod_ccc(&q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re],
-                           1.0 / m,
-                           &q->sf_buffer[q->npdsch_cfg.sf_idx * q->nof_re],
-                           q->nof_re);
-    for (int i = 0; i < q->cell.nof_ports; i++) {
-      srsran_vec_sc_prod_ccc(&q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re],
-                             1.0 / m,
-                             &q->ce_buffer[i][q->npdsch_cfg.sf_idx * q->nof_re],
-                             q->nof_re);
-    }
-
     q->npdsch_cfg.sf_idx++;
     if (q->npdsch_cfg.sf_idx == q->npdsch_cfg.grant.nof_sf) {
       q->npdsch_cfg.sf_idx = 0;
@@ -798,17 +784,27 @@ int srsran_nbiot_ue_dl_decode_npdsch_no_bcch(srsran_nbiot_ue_dl_t* q, uint8_t* d
   }
 
   if (q->npdsch_cfg.num_sf == q->npdsch_cfg.grant.nof_sf * q->npdsch_cfg.grant.nof_rep) {
+    // average all the repetitions at once, the noise of the average decreases with the number of repetitions
+    uint32_t nof_re = q->npdsch_cfg.grant.nof_sf * q->nof_re;
+    float    norm   = 1.0f / q->npdsch_cfg.grant.nof_rep;
+    srsran_vec_sc_prod_cfc(q->sf_buffer, norm, q->sf_buffer, nof_re);
+    for (int i = 0; i < q->cell.nof_ports; i++) {
+      srsran_vec_sc_prod_cfc(q->ce_buffer[i], norm, q->ce_buffer[i], nof_re);
+    }
+    float noise_estimate = srsran_chest_dl_nbiot_get_noise_estimate(&q->chest) * norm;
+
     // try to decode NPDSCH
     INFO("%d.%d: Trying to decode NPDSCH with %d subframe(s).", tti / 10, tti % 10, q->npdsch_cfg.grant.nof_sf);
-    if (srsran_nbiot_ue_dl_decode_rnti_packet(q,
-                                              &q->npdsch_cfg.grant,
-                                              data,
-                                              tti / 10,
-                                              tti % 10,
-                                              rnti,
-                                              q->sf_buffer,
-                                              q->ce_buffer,
-                                              q->npdsch_cfg.rep_idx) != SRSRAN_SUCCESS) {
+    if (srsran_npdsch_decode_rnti(&q->npdsch,
+                                  &q->npdsch_cfg,
+                                  &q->softbuffer,
+                                  q->sf_buffer,
+                                  q->ce_buffer,
+                                  noise_estimate,
+                                  rnti,
+                                  tti / 10,
+                                  data,
+                                  q->npdsch_cfg.rep_idx) != SRSRAN_SUCCESS) {
       // decoding failed
       INFO("%d.%d: Error decoding NPDSCH with %d repetitions.", tti / 10, tti % 10, q->npdsch_cfg.rep_idx);
       q->pkt_errors++;
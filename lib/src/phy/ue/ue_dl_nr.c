@@ -117,6 +117,17 @@ int srsran_ue_dl_nr_init(srsran_ue_dl_nr_t* q, cf_t* input[SRSRAN_MAX_PORTS], co
     return SRSRAN_ERROR;
   }
 
+  // LLR of every candidate location of a slot
+  q->pdcch_llr = srsran_vec_i8_malloc((SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR + 1) * 2 * SRSRAN_PDCCH_MAX_RE);
+  if (q->pdcch_llr == NULL) {
+    ERROR("Error alloc");
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR + 1; i++) {
+    q->pdcch_candidates[i].llr = &q->pdcch_llr[i * 2 * SRSRAN_PDCCH_MAX_RE];
+  }
+  q->pdcch_candidates_count = 0;
+
   return SRSRAN_SUCCESS;
 }
 
@@ -147,6 +158,10 @@ void srsran_ue_dl_nr_free(srsran_ue_dl_nr_t* q)
     free(q->pdcch_ce);
   }
 
+  if (q->pdcch_llr) {
+    free(q->pdcch_llr);
+  }
+
   SRSRAN_MEM_ZERO(q, srsran_ue_dl_nr_t, 1);
 }
 
@@ -196,6 +211,9 @@ int srsran_ue_dl_nr_set_pdcch_config(srsran_ue_dl_nr_t*           q,
   // Copy new configuration
   q->cfg = *cfg;
 
+  // The measured candidates might belong to a CORESET that changed
+  q->pdcch_candidates_count = 0;
+
   // iterate over all possible CORESET and initialise/update the present ones
   for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_CORESET; i++) {
     // Skip CORESET if not present
@@ -228,6 +246,9 @@ void srsran_ue_dl_nr_estimate_fft(srsran_ue_dl_nr_t* q, const srsran_slot_cfg_t*
     srsran_ofdm_rx_sf(&q->fft[i]);
   }
 
+  // Forget the PDCCH candidates of the previous slot
+  q->pdcch_candidates_count = 0;
+
   // Estimate PDCCH channel for every configured CORESET
   for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_CORESET; i++) {
     if (q->cfg.coreset_present[i]) {
@@ -236,43 +257,35 @@ void srsran_ue_dl_nr_estimate_fft(srsran_ue_dl_nr_t* q, const srsran_slot_cfg_t*
   }
 }
 
-static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
-                                  srsran_dci_msg_nr_t*   dci_msg,
-                                  srsran_pdcch_nr_res_t* pdcch_res,
-                                  uint32_t               coreset_id)
+/**
+ * @brief Measures the DMRS of a PDCCH candidate location and, if it passes the EPRE and correlation thresholds,
+ * demodulates it
+ */
+static int ue_dl_nr_measure_candidate(srsran_ue_dl_nr_t* q, srsran_ue_dl_nr_pdcch_candidate_t* c)
 {
-  // Select debug information
-  srsran_ue_dl_nr_pdcch_info_t* pdcch_info = NULL;
-  if (q->pdcch_info_count < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR) {
-    pdcch_info = &q->pdcch_info[q->pdcch_info_count];
-    q->pdcch_info_count++;
-  } else {
-    ERROR("The UE does not expect more than %d candidates in this serving cell", SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR);
-    return SRSRAN_ERROR;
-  }
-  SRSRAN_MEM_ZERO(pdcch_info, srsran_ue_dl_nr_pdcch_info_t, 1);
-  pdcch_info->dci_ctx            = dci_msg->ctx;
-  pdcch_info->nof_bits           = dci_msg->nof_bits;
-  srsran_dmrs_pdcch_measure_t* m = &pdcch_info->measure;
+  srsran_dci_location_t*       location = &c->location;
+  srsran_dmrs_pdcch_measure_t* m        = &c->measure;
+
+  c->detected = false;
+  c->evm      = NAN;
 
   // Measures the PDCCH transmission DMRS
-  srsran_dci_location_t location = dci_msg->ctx.location;
-  if (srsran_dmrs_pdcch_get_measure(&q->dmrs_pdcch[coreset_id], &location, m) < SRSRAN_SUCCESS) {
-    ERROR("Error getting measure location L=%d, ncce=%d", location.L, location.ncce);
+  if (srsran_dmrs_pdcch_get_measure(&q->dmrs_pdcch[c->coreset_id], location, m) < SRSRAN_SUCCESS) {
+    ERROR("Error getting measure location L=%d, ncce=%d", location->L, location->ncce);
     return SRSRAN_ERROR;
   }
 
   // If measured correlation is invalid, early return
   if (!isnormal(m->norm_corr)) {
-    INFO("Discarded PDCCH candidate L=%d;ncce=%d; Invalid measurement;", location.L, location.ncce);
+    INFO("Discarded PDCCH candidate L=%d;ncce=%d; Invalid measurement;", location->L, location->ncce);
     return SRSRAN_SUCCESS;
   }
 
   // Compare EPRE with threshold
   if (m->epre_dBfs < q->pdcch_dmrs_epre_thr) {
     INFO("Discarded PDCCH candidate L=%d;ncce=%d; EPRE is too weak (%.1f<%.1f);",
-         location.L,
-         location.ncce,
+         location->L,
+         location->ncce,
          m->epre_dBfs,
          q->pdcch_dmrs_epre_thr);
     return SRSRAN_SUCCESS;
@@ -281,8 +294,8 @@ static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
   // Compare DMRS correlation with threshold
   if (m->norm_corr < q->pdcch_dmrs_corr_thr) {
     INFO("Discarded PDCCH candidate L=%d;ncce=%d; Correlation is too low (%.1f<%.1f); EPRE=%+.2f; RSRP=%+.2f;",
-         location.L,
-         location.ncce,
+         location->L,
+         location->ncce,
          m->norm_corr,
          q->pdcch_dmrs_corr_thr,
          m->epre_dBfs,
@@ -291,31 +304,85 @@ static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
   }
 
   // Extract PDCCH channel estimates
-  if (srsran_dmrs_pdcch_get_ce(&q->dmrs_pdcch[coreset_id], &location, q->pdcch_ce) < SRSRAN_SUCCESS) {
+  if (srsran_dmrs_pdcch_get_ce(&q->dmrs_pdcch[c->coreset_id], location, q->pdcch_ce) < SRSRAN_SUCCESS) {
     ERROR("Error extracting PDCCH DMRS");
     return SRSRAN_ERROR;
   }
 
-  // Decode PDCCH
-  if (srsran_pdcch_nr_decode(&q->pdcch, q->sf_symbols[0], q->pdcch_ce, dci_msg, pdcch_res) < SRSRAN_SUCCESS) {
-    ERROR("Error decoding PDCCH");
+  // Equalise and demodulate PDCCH, the LLR are decoded for every DCI size and RNTI looked for in the location
+  if (srsran_pdcch_nr_demodulate(&q->pdcch, q->sf_symbols[0], q->pdcch_ce, location, c->llr, &c->evm) <
+      SRSRAN_SUCCESS) {
+    ERROR("Error demodulating PDCCH");
     return SRSRAN_ERROR;
   }
+  c->detected = true;
 
-#if 0
-  static uint32_t num_pdcch = 0;
-  char            tmpstr[64];
-  snprintf(tmpstr, 64, "pdcch_symbols%d.dat", num_pdcch);
-  printf("save %d syms to %s\n", q->pdcch.M / 4, tmpstr);
-  srsran_vec_save_file(tmpstr, q->pdcch.symbols, q->pdcch.M / 4 * sizeof(cf_t));
-  // srsran_vec_fprint_c(stdout, q->pdcch.symbols, q->pdcch.M/4);
-  num_pdcch++;
-#endif
+  return SRSRAN_SUCCESS;
+}
 
-  // Save information
-  pdcch_info->result = *pdcch_res;
+/**
+ * @brief Gets a PDCCH candidate location, measuring it only the first time it is looked for in the slot
+ * @return The candidate, or NULL if an error occurred
+ */
+static srsran_ue_dl_nr_pdcch_candidate_t*
+ue_dl_nr_get_candidate(srsran_ue_dl_nr_t* q, uint32_t coreset_id, const srsran_dci_location_t* location)
+{
+  // Look for the location among the ones measured in this slot
+  for (uint32_t i = 0; i < q->pdcch_candidates_count; i++) {
+    srsran_ue_dl_nr_pdcch_candidate_t* c = &q->pdcch_candidates[i];
+    if (c->coreset_id == coreset_id && c->location.L == location->L && c->location.ncce == location->ncce) {
+      return c;
+    }
+  }
 
-  return SRSRAN_SUCCESS;
+  // Measure it in the next entry, or in the scratch one if they are all taken
+  uint32_t                           idx = SRSRAN_MIN(q->pdcch_candidates_count, SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR);
+  srsran_ue_dl_nr_pdcch_candidate_t* c   = &q->pdcch_candidates[idx];
+  c->coreset_id                          = coreset_id;
+  c->location                            = *location;
+  if (ue_dl_nr_measure_candidate(q, c) < SRSRAN_SUCCESS) {
+    return NULL;
+  }
+
+  // Keep the measurement for the rest of the slot
+  if (idx < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR) {
+    q->pdcch_candidates_count++;
+  }
+
+  return c;
+}
+
+/**
+ * @brief Gets the candidate location of a DCI message and records its blind-search information
+ * @return The blind-search information entry, or NULL if an error occurred
+ */
+static srsran_ue_dl_nr_pdcch_info_t* ue_dl_nr_measure_dci_ncce(srsran_ue_dl_nr_t*                  q,
+                                                               const srsran_dci_msg_nr_t*          dci_msg,
+                                                               uint32_t                            coreset_id,
+                                                               srsran_ue_dl_nr_pdcch_candidate_t** candidate)
+{
+  // Select debug information
+  srsran_ue_dl_nr_pdcch_info_t* pdcch_info = NULL;
+  if (q->pdcch_info_count < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR) {
+    pdcch_info = &q->pdcch_info[q->pdcch_info_count];
+    q->pdcch_info_count++;
+  } else {
+    ERROR("The UE does not expect more than %d candidates in this serving cell", SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR);
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pdcch_info, srsran_ue_dl_nr_pdcch_info_t, 1);
+  pdcch_info->dci_ctx  = dci_msg->ctx;
+  pdcch_info->nof_bits = dci_msg->nof_bits;
+
+  // Measure, screen and demodulate the candidate location, once per slot
+  srsran_ue_dl_nr_pdcch_candidate_t* c = ue_dl_nr_get_candidate(q, coreset_id, &dci_msg->ctx.location);
+  if (c == NULL) {
+    return NULL;
+  }
+  pdcch_info->measure = c->measure;
+
+  *candidate = c;
+  return pdcch_info;
 }
 
 static bool find_dci_msg(srsran_dci_msg_nr_t* dci_msg, uint32_t nof_dci_msg, srsran_dci_msg_nr_t* match)
@@ -400,8 +467,14 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
         return SRSRAN_ERROR;
       }
 
-      // Iterate over the candidates
-      for (int ncce_idx = 0; ncce_idx < nof_candidates && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR; ncce_idx++) {
+      // Measure the candidates, the ones passing the DMRS screening are decoded together
+      srsran_dci_msg_nr_t           dci_msg_list[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR]    = {};
+      srsran_pdcch_nr_res_t         res_list[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR]        = {};
+      srsran_ue_dl_nr_pdcch_info_t* pdcch_info_list[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
+      const int8_t*                 llr_list[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR]        = {};
+      float                         evm_list[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR]        = {};
+      uint32_t                      nof_detected                                               = 0;
+      for (int ncce_idx = 0; ncce_idx < nof_candidates; ncce_idx++) {
         // Build DCI context
         srsran_dci_ctx_t ctx = {};
         ctx.location.L       = L;
@@ -418,12 +491,41 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
         dci_msg.ctx                 = ctx;
         dci_msg.nof_bits            = (uint32_t)dci_nof_bits;
 
-        // Find and decode PDCCH transmission in the given ncce
-        srsran_pdcch_nr_res_t res = {};
-        if (ue_dl_nr_find_dci_ncce(q, &dci_msg, &res, coreset_id) < SRSRAN_SUCCESS) {
+        // Measure PDCCH transmission in the given ncce
+        srsran_ue_dl_nr_pdcch_candidate_t* c          = NULL;
+        srsran_ue_dl_nr_pdcch_info_t*      pdcch_info = ue_dl_nr_measure_dci_ncce(q, &dci_msg, coreset_id, &c);
+        if (pdcch_info == NULL) {
           return SRSRAN_ERROR;
         }
 
+        // Skip the decoding if the candidate was discarded by its DMRS
+        if (!c->detected) {
+          continue;
+        }
+
+        dci_msg_list[nof_detected]    = dci_msg;
+        pdcch_info_list[nof_detected] = pdcch_info;
+        llr_list[nof_detected]        = c->llr;
+        evm_list[nof_detected]        = c->evm;
+        nof_detected++;
+      }
+
+      // Decode PDCCH
+      if (srsran_pdcch_nr_decode_llr_batch(&q->pdcch, llr_list, dci_msg_list, res_list, nof_detected) <
+          SRSRAN_SUCCESS) {
+        ERROR("Error decoding PDCCH");
+        return SRSRAN_ERROR;
+      }
+
+      // Iterate over the decoded candidates
+      for (uint32_t i = 0; i < nof_detected && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR; i++) {
+        srsran_dci_msg_nr_t   dci_msg = dci_msg_list[i];
+        srsran_pdcch_nr_res_t res     = res_list[i];
+        res.evm                       = evm_list[i];
+
+        // Save information
+        pdcch_info_list[i]->result = res;
+
         // If the CRC was not match, move to next candidate
         if (!res.crc) {
           continue;
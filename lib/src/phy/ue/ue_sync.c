@@ -139,6 +139,7 @@ void srsran_ue_sync_reset(srsran_ue_sync_t* q)
   q->mean_sample_offset    = 0.0;
   q->next_rf_sample_offset = 0;
   q->frame_find_cnt        = 0;
+  q->cfo_phase             = 1.0f;
 }
 
 int srsran_ue_sync_start_agc(srsran_ue_sync_t* q,
@@ -225,6 +226,7 @@ int srsran_ue_sync_init_multi_decim_mode(
     q->file_mode                    = false;
     q->agc_period                   = 0;
     q->sample_offset_correct_period = DEFAULT_SAMPLE_OFFSET_CORRECT_PERIOD;
+    q->cfo_phase                    = 1.0f;
     q->sfo_ema                      = DEFAULT_SFO_EMA_COEFF;
 
     q->max_prb = max_prb;
@@ -730,6 +732,23 @@ static int receive_samples(srsran_ue_sync_t* q, cf_t* input_buffer[SRSRAN_MAX_CH
 }
 
 /* Returns 1 if the subframe is synchronized in time, 0 otherwise */
+/* Corrects the CFO in place using the sync object frequency. All antennas start from the same oscillator phase and
+ * the phase is carried over to the next call, so consecutive subframes see a continuous correction.
+ */
+static void ue_sync_correct_cfo(srsran_ue_sync_t* q, cf_t* input_buffer[SRSRAN_MAX_CHANNELS])
+{
+  float    cfo        = -q->cfo_current_value / q->fft_size;
+  uint32_t nsamples   = q->strack.cfo_corr_frame.nsamples;
+  cf_t     next_phase = q->cfo_phase;
+
+  for (int i = 0; i < q->nof_rx_antennas; i++) {
+    if (input_buffer[i]) {
+      next_phase = srsran_vec_apply_cfo_phase(input_buffer[i], cfo, q->cfo_phase, input_buffer[i], nsamples);
+    }
+  }
+  q->cfo_phase = next_phase;
+}
+
 int srsran_ue_sync_zerocopy(srsran_ue_sync_t* q,
                             cf_t*             input_buffer[SRSRAN_MAX_CHANNELS],
                             const uint32_t    max_num_samples)
@@ -777,12 +796,7 @@ int srsran_ue_sync_zerocopy(srsran_ue_sync_t* q,
         case SF_FIND:
           // Correct CFO before PSS/SSS find using the sync object corrector (initialized for 1 ms)
           if (q->cfo_correct_enable_find) {
-            for (int i = 0; i < q->nof_rx_antennas; i++) {
-              if (input_buffer[i]) {
-                srsran_cfo_correct(
-                    &q->strack.cfo_corr_frame, input_buffer[i], input_buffer[i], -q->cfo_current_value / q->fft_size);
-              }
-            }
+            ue_sync_correct_cfo(q, input_buffer);
           }
 
           // Run mode-specific find operation
@@ -809,12 +823,7 @@ int srsran_ue_sync_zerocopy(srsran_ue_sync_t* q,
 
           // Correct CFO before PSS/SSS tracking using the sync object corrector (initialized for 1 ms)
           if (q->cfo_correct_enable_track) {
-            for (int i = 0; i < q->nof_rx_antennas; i++) {
-              if (input_buffer[i]) {
-                srsran_cfo_correct(
-                    &q->strack.cfo_corr_frame, input_buffer[i], input_buffer[i], -q->cfo_current_value / q->fft_size);
-              }
-            }
+            ue_sync_correct_cfo(q, input_buffer);
           }
 
           if (q->mode == SYNC_MODE_PSS) {
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/bfp.h"
+#include "srsran/phy/utils/debug.h"
+#include <complex.h>
+#include <math.h>
+
+// Number of I and Q values of a PRB
+#define BFP_NOF_VALUES (2 * SRSRAN_NRE)
+
+static int16_t bfp_to_int16(float x, float scale)
+{
+  float v = roundf(x * scale);
+  if (v > INT16_MAX) {
+    return INT16_MAX;
+  }
+  if (v < INT16_MIN) {
+    return INT16_MIN;
+  }
+  return (int16_t)v;
+}
+
+// Smallest shift that fits all the values in iq_width bits, including the sign
+static uint32_t bfp_exponent(const int16_t* values, uint32_t iq_width)
+{
+  // The one's complement of the negative values has the same number of significant bits
+  uint32_t max_abs = 0;
+  for (uint32_t i = 0; i < BFP_NOF_VALUES; i++) {
+    uint32_t a = (uint32_t)(values[i] < 0 ? ~values[i] : values[i]);
+    max_abs |= a;
+  }
+
+  uint32_t nof_bits = 1;
+  while (max_abs >> (nof_bits - 1)) {
+    nof_bits++;
+  }
+  return nof_bits > iq_width ? nof_bits - iq_width : 0;
+}
+
+static void bfp_compress_prb(const cf_t* symbols, float scale, uint32_t iq_width, uint8_t* buffer)
+{
+  int16_t values[BFP_NOF_VALUES];
+  for (uint32_t i = 0; i < SRSRAN_NRE; i++) {
+    values[2 * i]     = bfp_to_int16(__real__ symbols[i], scale);
+    values[2 * i + 1] = bfp_to_int16(__imag__ symbols[i], scale);
+  }
+
+  uint32_t exponent = bfp_exponent(values, iq_width);
+  *(buffer++)       = (uint8_t)exponent;
+
+  // Pack the mantissas MSB first
+  uint32_t acc      = 0;
+  uint32_t acc_bits = 0;
+  uint32_t mask     = (1U << iq_width) - 1;
+  for (uint32_t i = 0; i < BFP_NOF_VALUES; i++) {
+    acc = (acc << iq_width) | ((uint32_t)(values[i] >> exponent) & mask);
+    acc_bits += iq_width;
+    while (acc_bits >= 8) {
+      acc_bits -= 8;
+      *(buffer++) = (uint8_t)(acc >> acc_bits);
+    }
+  }
+  if (acc_bits > 0) {
+    *buffer = (uint8_t)(acc << (8 - acc_bits));
+  }
+}
+
+static void bfp_decompress_prb(const uint8_t* buffer, float scale, uint32_t iq_width, cf_t* symbols)
+{
+  uint32_t exponent = *(buffer++) & 0xf;
+
+  int16_t  values[BFP_NOF_VALUES];
+  uint32_t acc      = 0;
+  uint32_t acc_bits = 0;
+  uint32_t mask     = (1U << iq_width) - 1;
+  for (uint32_t i = 0; i < BFP_NOF_VALUES; i++) {
+    while (acc_bits < iq_width) {
+      acc = (acc << 8) | *(buffer++);
+      acc_bits += 8;
+    }
+    acc_bits -= iq_width;
+
+    // Sign extend the mantissa and restore the exponent
+    int32_t mantissa = (int32_t)((acc >> acc_bits) & mask);
+    if (mantissa & (1 << (iq_width - 1))) {
+      mantissa -= (1 << iq_width);
+    }
+    values[i] = (int16_t)(mantissa * (1 << exponent));
+  }
+
+  float inv_scale = 1.0f / scale;
+  for (uint32_t i = 0; i < SRSRAN_NRE; i++) {
+    __real__ symbols[i] = values[2 * i] * inv_scale;
+    __imag__ symbols[i] = values[2 * i + 1] * inv_scale;
+  }
+}
+
+int srsran_bfp_compress(const cf_t* symbols, float scale, uint32_t nof_prb, uint32_t iq_width, uint8_t* buffer)
+{
+  if (symbols == NULL || buffer == NULL || !isnormal(scale)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (iq_width < SRSRAN_BFP_MIN_IQ_WIDTH || iq_width > SRSRAN_BFP_MAX_IQ_WIDTH) {
+    ERROR("Invalid BFP mantissa width (%d)", iq_width);
+    return SRSRAN_ERROR_OUT_OF_BOUNDS;
+  }
+
+  uint32_t prb_bytes = SRSRAN_BFP_PRB_BYTES(iq_width);
+  for (uint32_t prb = 0; prb < nof_prb; prb++) {
+    bfp_compress_prb(&symbols[prb * SRSRAN_NRE], scale, iq_width, &buffer[prb * prb_bytes]);
+  }
+
+  return (int)(nof_prb * prb_bytes);
+}
+
+int srsran_bfp_decompress(const uint8_t* buffer, float scale, uint32_t nof_prb, uint32_t iq_width, cf_t* symbols)
+{
+  if (symbols == NULL || buffer == NULL || !isnormal(scale)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (iq_width < SRSRAN_BFP_MIN_IQ_WIDTH || iq_width > SRSRAN_BFP_MAX_IQ_WIDTH) {
+    ERROR("Invalid BFP mantissa width (%d)", iq_width);
+    return SRSRAN_ERROR_OUT_OF_BOUNDS;
+  }
+
+  uint32_t prb_bytes = SRSRAN_BFP_PRB_BYTES(iq_width);
+  for (uint32_t prb = 0; prb < nof_prb; prb++) {
+    bfp_decompress_prb(&buffer[prb * prb_bytes], scale, iq_width, &symbols[prb * SRSRAN_NRE]);
+  }
+
+  return (int)(nof_prb * prb_bytes);
+}
@@ -35,6 +35,9 @@
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/vector.h"
 
+/* Largest input of srsran_bit_interleaver_run() processed with AVX2 gathers, it covers the turbo rate matching */
+#define BIT_INTERLEAVER_GATHER_MAX_BYTES 2048
+
 void srsran_bit_interleaver_init(srsran_bit_interleaver_t* q, uint16_t* interleaver, uint32_t nof_bits)
 {
   static const uint8_t mask[] = {0x80, 0x40, 0x20, 0x10, 0x8, 0x4, 0x2, 0x1};
@@ -51,6 +54,10 @@ void srsran_bit_interleaver_init(srsran_bit_interleaver_t* q, uint16_t* interlea
     q->interleaver[i] = i_px;
     q->byte_idx[i]    = (uint16_t)(interleaver[i] / 8);
     q->bit_mask[i]    = (uint8_t)(mask[i_px % 8]);
+
+    if (q->byte_idx[i] >= q->nof_input_bytes) {
+      q->nof_input_bytes = q->byte_idx[i] + 1;
+    }
   }
 }
 
@@ -99,6 +106,40 @@ void srsran_bit_interleaver_run(srsran_bit_interleaver_t* q, uint8_t* input, uin
   bit_mask += i - w_offset_p;
   output_ptr += st;
 
+#ifdef LV_HAVE_AVX2
+  // Each 32-bit gather reads up to 3 bytes past the one it needs, so the gathers work on a padded copy of the input
+  if (q->nof_input_bytes <= BIT_INTERLEAVER_GATHER_MAX_BYTES && i < (int)q->nof_bits - 31) {
+    uint8_t gather_input[BIT_INTERLEAVER_GATHER_MAX_BYTES + 3] __attribute__((aligned(32)));
+    memcpy(gather_input, input, q->nof_input_bytes);
+    memset(&gather_input[q->nof_input_bytes], 0, 3);
+
+    // Puts the 32 compared bits back in order after the saturated packs, and MSB first within each byte
+    const __m256i perm    = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    const __m256i reverse = _mm256_setr_epi8(
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+    for (; i < (int)q->nof_bits - 31; i += 32) {
+      __m256i zero[4];
+      for (uint32_t k = 0; k < 4; k++) {
+        __m256i idx  = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)&byte_idx[8 * k]));
+        __m256i m    = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)&bit_mask[8 * k]));
+        __m256i word = _mm256_i32gather_epi32((const int*)gather_input, idx, 1);
+        zero[k]      = _mm256_cmpeq_epi32(_mm256_and_si256(word, m), _mm256_setzero_si256());
+      }
+
+      __m256i v = _mm256_packs_epi16(_mm256_packs_epi32(zero[0], zero[1]), _mm256_packs_epi32(zero[2], zero[3]));
+      v         = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(v, perm), reverse);
+
+      uint32_t out32 = ~(uint32_t)_mm256_movemask_epi8(v);
+      memcpy(output_ptr, &out32, sizeof(uint32_t));
+
+      byte_idx += 32;
+      bit_mask += 32;
+      output_ptr += 4;
+    }
+  }
+#endif /* LV_HAVE_AVX2 */
+
 #ifdef LV_HAVE_SSE
   for (; i < (int)q->nof_bits - 15; i += 16) {
     __m128i in128 = _mm_setzero_si128();
@@ -699,9 +740,25 @@ void srsran_bit_copy(uint8_t* dst, uint32_t dst_offset, uint8_t* src, uint32_t s
 
 void srsran_bit_unpack_vector(const uint8_t* packed, uint8_t* unpacked, int nof_bits)
 {
-  uint32_t i, nbytes;
-  nbytes = nof_bits / 8;
-  for (i = 0; i < nbytes; i++) {
+  uint32_t i = 0, nbytes;
+  nbytes     = nof_bits / 8;
+
+#ifdef LV_HAVE_AVX2
+  // Spread 4 bytes over 32 lanes, byte k of the input to lanes 8k to 8k+7, and test one bit per lane in MSB order
+  const __m256i spread = _mm256_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+  const __m256i bit_mask = _mm256_set1_epi64x((long long)0x0102040810204080ULL);
+  for (; i + 4 <= nbytes; i += 4) {
+    uint32_t word;
+    memcpy(&word, &packed[i], sizeof(uint32_t));
+    __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32((int)word), spread);
+    v         = _mm256_cmpeq_epi8(_mm256_and_si256(v, bit_mask), bit_mask);
+    _mm256_storeu_si256((__m256i*)unpacked, _mm256_and_si256(v, _mm256_set1_epi8(1)));
+    unpacked += 32;
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < nbytes; i++) {
     srsran_bit_unpack(packed[i], &unpacked, 8);
   }
   if (nof_bits % 8) {
@@ -754,11 +811,24 @@ void srsran_bit_unpack_lsb(uint32_t value, uint8_t** bits, int nof_bits)
 
 void srsran_bit_pack_vector(uint8_t* unpacked, uint8_t* packed, int nof_bits)
 {
-  uint32_t i, nbytes;
-  nbytes = nof_bits / 8;
+  uint32_t i = 0, nbytes;
+  nbytes     = nof_bits / 8;
+
+#ifdef LV_HAVE_AVX2
+  // Reverse the lanes of every 8 so that the first bit of each byte lands on its MSB, then take the sign of 32 lanes
+  const __m256i reverse = _mm256_setr_epi8(
+      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  for (; i + 4 <= nbytes; i += 4) {
+    __m256i v = _mm256_cmpgt_epi8(_mm256_loadu_si256((__m256i*)unpacked), _mm256_setzero_si256());
+    unpacked += 32;
+
+    uint32_t word = (uint32_t)_mm256_movemask_epi8(_mm256_shuffle_epi8(v, reverse));
+    memcpy(&packed[i], &word, sizeof(uint32_t));
+  }
+#endif /* LV_HAVE_AVX2 */
 
 #ifdef LV_HAVE_SSE
-  for (i = 0; i < nbytes; i++) {
+  for (; i < nbytes; i++) {
     // Get 8 Bit
     __m64 mask = _mm_cmpgt_pi8(*((__m64*)unpacked), _mm_set1_pi8(0));
     unpacked += 8;
@@ -770,7 +840,7 @@ void srsran_bit_pack_vector(uint8_t* unpacked, uint8_t* packed, int nof_bits)
     packed[i] = (uint8_t)_mm_movemask_pi8(mask);
   }
 #else  /* LV_HAVE_SSE */
-  for (i = 0; i < nbytes; i++) {
+  for (; i < nbytes; i++) {
     packed[i] = srsran_bit_pack(&unpacked, 8);
   }
 #endif /* LV_HAVE_SSE */
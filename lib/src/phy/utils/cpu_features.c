@@ -0,0 +1,150 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/cpu_features.h"
+#include "srsran/phy/utils/vector.h"
+#include <pthread.h>
+#include <stdio.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+
+#define X86_CPUID_BASIC_LEAF 1
+#define X86_CPUID_ADVANCED_LEAF 7
+
+// XCR0 state components: SSE and AVX registers, and the AVX-512 opmask and upper ZMM registers
+#define X86_XCR0_YMM 0x06U
+#define X86_XCR0_ZMM 0xe6U
+
+static uint64_t x86_xgetbv(void)
+{
+  uint32_t eax = 0, edx = 0;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return ((uint64_t)edx << 32U) | eax;
+}
+
+static uint32_t cpu_features_detect(void)
+{
+  uint32_t     features = 0;
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+  if (!__get_cpuid(X86_CPUID_BASIC_LEAF, &eax, &ebx, &ecx, &edx)) {
+    return features;
+  }
+
+  if (ecx & bit_SSE4_1) {
+    features |= SRSRAN_CPU_SSE41;
+  }
+
+  // AVX registers are only usable if the OS saves them on context switches
+  uint64_t xcr0 = (ecx & bit_OSXSAVE) ? x86_xgetbv() : 0;
+  if (!(ecx & bit_AVX) || (xcr0 & X86_XCR0_YMM) != X86_XCR0_YMM) {
+    return features;
+  }
+  features |= SRSRAN_CPU_AVX;
+  if (ecx & bit_FMA) {
+    features |= SRSRAN_CPU_FMA;
+  }
+
+  if (__get_cpuid_max(0, NULL) < X86_CPUID_ADVANCED_LEAF) {
+    return features;
+  }
+  __cpuid_count(X86_CPUID_ADVANCED_LEAF, 0, eax, ebx, ecx, edx);
+
+  if (ebx & bit_AVX2) {
+    features |= SRSRAN_CPU_AVX2;
+  }
+
+  const unsigned int avx512_bits = bit_AVX512F | bit_AVX512CD | bit_AVX512BW | bit_AVX512DQ;
+  if ((ebx & avx512_bits) == avx512_bits && (xcr0 & X86_XCR0_ZMM) == X86_XCR0_ZMM) {
+    features |= SRSRAN_CPU_AVX512;
+  }
+
+  return features;
+}
+
+#elif defined(__aarch64__)
+
+static uint32_t cpu_features_detect(void)
+{
+  // Advanced SIMD is mandatory in ARMv8-A
+  return SRSRAN_CPU_NEON;
+}
+
+#else
+
+static uint32_t cpu_features_detect(void)
+{
+#ifdef HAVE_NEON
+  return SRSRAN_CPU_NEON;
+#else
+  return 0;
+#endif
+}
+
+#endif
+
+static pthread_once_t cpu_features_once = PTHREAD_ONCE_INIT;
+static uint32_t       cpu_features      = 0;
+
+static void cpu_features_init(void)
+{
+  cpu_features = cpu_features_detect();
+}
+
+uint32_t srsran_cpu_features(void)
+{
+  pthread_once(&cpu_features_once, cpu_features_init);
+  return cpu_features;
+}
+
+bool srsran_cpu_has(uint32_t features)
+{
+  return (srsran_cpu_features() & features) == features;
+}
+
+int srsran_cpu_features_string(char* str, uint32_t str_len)
+{
+  static const struct {
+    srsran_cpu_feature_t feature;
+    const char*          name;
+  } names[] = {{SRSRAN_CPU_SSE41, "sse4.1"},
+               {SRSRAN_CPU_AVX, "avx"},
+               {SRSRAN_CPU_AVX2, "avx2"},
+               {SRSRAN_CPU_FMA, "fma"},
+               {SRSRAN_CPU_AVX512, "avx512"},
+               {SRSRAN_CPU_NEON, "neon"}};
+
+  if (str == NULL || str_len == 0) {
+    return 0;
+  }
+
+  uint32_t features = srsran_cpu_features();
+  int      len      = 0;
+  str[0]            = '\0';
+  for (uint32_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+    if ((features & names[i].feature) && (uint32_t)len < str_len) {
+      len += snprintf(&str[len], str_len - len, "%s%s", len ? " " : "", names[i].name);
+    }
+  }
+
+  return SRSRAN_MIN(len, (int)str_len - 1);
+}
@@ -363,6 +363,90 @@ inline void srsran_mat_2x2_mmse_avx(__m256  y0,
 
 #endif /* LV_HAVE_AVX */
 
+void srsran_mat_hermitian_inv_gen(cf_t     a[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N],
+                                  cf_t     r[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N],
+                                  uint32_t N)
+{
+  for (uint32_t i = 0; i < N; i++) {
+    for (uint32_t j = 0; j < N; j++) {
+      r[i][j] = (i == j) ? 1.0f : 0.0f;
+    }
+  }
+
+  for (uint32_t k = 0; k < N; k++) {
+    float rcp = 1.0f / __real__ a[k][k];
+
+    for (uint32_t j = 0; j < N; j++) {
+      a[k][j] *= rcp;
+      r[k][j] *= rcp;
+    }
+
+    for (uint32_t i = 0; i < N; i++) {
+      if (i == k) {
+        continue;
+      }
+      cf_t f = a[i][k];
+      for (uint32_t j = 0; j < N; j++) {
+        a[i][j] -= f * a[k][j];
+        r[i][j] -= f * r[k][j];
+      }
+    }
+  }
+}
+
+int srsran_mat_hermitian_inv_soa(cf_t*    a[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N],
+                                 cf_t*    r[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N],
+                                 uint32_t N,
+                                 uint32_t nof_re)
+{
+  if (a == NULL || r == NULL || N == 0 || N > SRSRAN_MAT_HERM_MAX_N) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t k = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t a_simd[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N];
+  simd_cf_t r_simd[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N];
+
+  for (; k + SRSRAN_SIMD_CF_SIZE < nof_re + 1; k += SRSRAN_SIMD_CF_SIZE) {
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        a_simd[i][j] = srsran_simd_cfi_loadu(&a[i][j][k]);
+      }
+    }
+
+    srsran_mat_hermitian_inv_simd(a_simd, r_simd, N);
+
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        srsran_simd_cfi_storeu(&r[i][j][k], r_simd[i][j]);
+      }
+    }
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  cf_t a_gen[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N];
+  cf_t r_gen[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N];
+  for (; k < nof_re; k++) {
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        a_gen[i][j] = a[i][j][k];
+      }
+    }
+
+    srsran_mat_hermitian_inv_gen(a_gen, r_gen, N);
+
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        r[i][j][k] = r_gen[i][j];
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_matrix_NxN_inv_init(srsran_matrix_NxN_inv_t* q, uint32_t N)
 {
   int ret = SRSRAN_SUCCESS;
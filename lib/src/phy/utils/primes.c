@@ -21,7 +21,7 @@
 
 #include "srsran/phy/utils/primes.h"
 
-#define NOF_PRIME_NUMBERS 463
+#define NOF_PRIME_NUMBERS 464
 
 static const uint32_t prime_numbers[NOF_PRIME_NUMBERS] = {
     2,    3,    5,    7,    11,   13,   17,   19,   23,   29,   31,   37,   41,   43,   47,   53,   59,   61,   67,
@@ -48,7 +48,7 @@ static const uint32_t prime_numbers[NOF_PRIME_NUMBERS] = {
     2741, 2749, 2753, 2767, 2777, 2789, 2791, 2797, 2801, 2803, 2819, 2833, 2837, 2843, 2851, 2857, 2861, 2879, 2887,
     2897, 2903, 2909, 2917, 2927, 2939, 2953, 2957, 2963, 2969, 2971, 2999, 3001, 3011, 3019, 3023, 3037, 3041, 3049,
     3061, 3067, 3079, 3083, 3089, 3109, 3119, 3121, 3137, 3163, 3167, 3169, 3181, 3187, 3191, 3203, 3209, 3217, 3221,
-    3229, 3251, 3253, 3257, 3259, 3271, 3299};
+    3229, 3251, 3253, 3257, 3259, 3271, 3299, 3301};
 
 int srsran_prime_greater_than(uint32_t n)
 {
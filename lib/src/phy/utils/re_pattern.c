@@ -23,6 +23,10 @@
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
+#ifdef LV_HAVE_AVX512
+#include <immintrin.h>
+#endif /* LV_HAVE_AVX512 */
+
 bool srsran_re_pattern_to_mask(const srsran_re_pattern_list_t* list, uint32_t l, uint32_t k)
 {
   uint32_t rb_idx = k % SRSRAN_NRE;
@@ -108,6 +112,156 @@ int srsran_re_pattern_list_to_symbol_mask(const srsran_re_pattern_list_t* list,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_re_pattern_to_rb_mask(const srsran_re_pattern_t* pattern, uint32_t l, uint16_t* rb_mask)
+{
+  // Check inputs
+  if (pattern == NULL || rb_mask == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Check symbol index is in range
+  if (l >= SRSRAN_NSYMB_PER_SLOT_NR) {
+    ERROR("Symbol index is out of range");
+    return SRSRAN_ERROR;
+  }
+
+  // Skip pattern if it is not active in this OFDM symbol
+  if (!pattern->symbol[l]) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Make sure RB end is bounded
+  if (pattern->rb_end > SRSRAN_MAX_PRB_NR) {
+    return SRSRAN_ERROR;
+  }
+
+  // Pack the frequency-domain pattern
+  uint16_t sc_mask = 0;
+  for (uint32_t sc_idx = 0; sc_idx < SRSRAN_NRE; sc_idx++) {
+    sc_mask |= pattern->sc[sc_idx] ? (1U << sc_idx) : 0;
+  }
+
+  // Add mask for pattern
+  for (uint32_t rb_idx = pattern->rb_begin; rb_idx < pattern->rb_end; rb_idx += pattern->rb_stride) {
+    rb_mask[rb_idx] |= sc_mask;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_re_pattern_list_to_rb_mask(const srsran_re_pattern_list_t* list, uint32_t l, uint16_t* rb_mask)
+{
+  // Check inputs
+  if (list == NULL || rb_mask == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Iterate all given patterns
+  for (uint32_t i = 0; i < list->count; i++) {
+    if (srsran_re_pattern_to_rb_mask(&list->data[i], l, rb_mask) < SRSRAN_SUCCESS) {
+      ERROR("Error calculating mask");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+#define RE_PATTERN_RB_FULL ((1U << SRSRAN_NRE) - 1U)
+
+// Copies the RE of a RB not set in the mask, the grid is the destination if put is true
+static inline uint32_t re_pattern_rb_cp(cf_t* grid, cf_t* symbols, uint16_t rb_mask, bool put)
+{
+  uint32_t used = ~rb_mask & RE_PATTERN_RB_FULL;
+
+#ifdef LV_HAVE_AVX512
+  // A complex float is moved as a double, expanding into the grid or compressing from it. The RB is split in 8 + 4 RE
+  __mmask8 m0 = (__mmask8)(used & 0xffU);
+  __mmask8 m1 = (__mmask8)(used >> 8U);
+  uint32_t n0 = __builtin_popcount(m0);
+  if (put) {
+    _mm512_mask_storeu_pd((double*)grid, m0, _mm512_maskz_expandloadu_pd(m0, (double*)symbols));
+    _mm512_mask_storeu_pd((double*)&grid[8], m1, _mm512_maskz_expandloadu_pd(m1, (double*)&symbols[n0]));
+  } else {
+    _mm512_mask_compressstoreu_pd((double*)symbols, m0, _mm512_maskz_loadu_pd(m0, (double*)grid));
+    _mm512_mask_compressstoreu_pd((double*)&symbols[n0], m1, _mm512_maskz_loadu_pd(m1, (double*)&grid[8]));
+  }
+  return n0 + __builtin_popcount(m1);
+#else  /* LV_HAVE_AVX512 */
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < SRSRAN_NRE; i++) {
+    if (used & (1U << i)) {
+      if (put) {
+        grid[i] = symbols[count];
+      } else {
+        symbols[count] = grid[i];
+      }
+      count++;
+    }
+  }
+  return count;
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline uint32_t re_pattern_symbol_cp(cf_t*           grid,
+                                            cf_t*           symbols,
+                                            const bool*     prb_mask,
+                                            const uint16_t* rb_mask,
+                                            uint32_t        nof_prb,
+                                            bool            put)
+{
+  uint32_t count = 0;
+
+  for (uint32_t rb = 0; rb < nof_prb;) {
+    // Skip RB if not allocated
+    if (!prb_mask[rb]) {
+      rb++;
+      continue;
+    }
+
+    // RB with masked RE
+    if (rb_mask[rb] != 0) {
+      count += re_pattern_rb_cp(&grid[rb * SRSRAN_NRE], &symbols[count], rb_mask[rb], put);
+      rb++;
+      continue;
+    }
+
+    // Run of allocated RB without masked RE
+    uint32_t rb_end = rb + 1;
+    while (rb_end < nof_prb && prb_mask[rb_end] && rb_mask[rb_end] == 0) {
+      rb_end++;
+    }
+    uint32_t nof_re = (rb_end - rb) * SRSRAN_NRE;
+    if (put) {
+      srsran_vec_cf_copy(&grid[rb * SRSRAN_NRE], &symbols[count], nof_re);
+    } else {
+      srsran_vec_cf_copy(&symbols[count], &grid[rb * SRSRAN_NRE], nof_re);
+    }
+    count += nof_re;
+    rb = rb_end;
+  }
+
+  return count;
+}
+
+uint32_t srsran_re_pattern_symbol_put(const cf_t*     symbols,
+                                      cf_t*           grid,
+                                      const bool*     prb_mask,
+                                      const uint16_t* rb_mask,
+                                      uint32_t        nof_prb)
+{
+  return re_pattern_symbol_cp(grid, (cf_t*)symbols, prb_mask, rb_mask, nof_prb, true);
+}
+
+uint32_t srsran_re_pattern_symbol_get(const cf_t*     grid,
+                                      cf_t*           symbols,
+                                      const bool*     prb_mask,
+                                      const uint16_t* rb_mask,
+                                      uint32_t        nof_prb)
+{
+  return re_pattern_symbol_cp((cf_t*)grid, symbols, prb_mask, rb_mask, nof_prb, false);
+}
+
 int srsran_re_pattern_merge(srsran_re_pattern_list_t* list, const srsran_re_pattern_t* p)
 {
   // Check inputs are valid
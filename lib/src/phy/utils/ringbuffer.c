@@ -19,15 +19,47 @@
  *
  */
 
+#include <limits.h>
+#include <linux/futex.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/ringbuffer.h"
 #include "srsran/phy/utils/vector.h"
 
+#define RINGBUFFER_CACHE_LINE 64
+
+/* One side of the lock-free ring buffer, every side sits on its own cache line */
+typedef struct {
+  uint64_t pos;     ///< Bytes written (head) or read (tail) since the reset, only modified by its own side
+  uint32_t seq;     ///< Changes every time pos does, the other side sleeps on it
+  uint32_t waiting; ///< Set by the other side before sleeping on seq
+  uint8_t  reserved[RINGBUFFER_CACHE_LINE - 16];
+} ringbuffer_spsc_side_t;
+
+struct srsran_ringbuffer_spsc_s {
+  ringbuffer_spsc_side_t head; ///< Writer side, the reader sleeps on it while there are not enough bytes
+  ringbuffer_spsc_side_t tail; ///< Reader side, the writer sleeps on it while there is not enough space
+  uint32_t               active;
+  uint32_t               size;     ///< Size of the physical buffer, the positions wrap at it
+  bool                   mirrored; ///< The physical buffer is mapped twice back to back
+};
+
+static int  ringbuffer_spsc_buffer_alloc(srsran_ringbuffer_t* q, int capacity);
+static void ringbuffer_spsc_buffer_free(srsran_ringbuffer_t* q);
+static void ringbuffer_spsc_publish(ringbuffer_spsc_side_t* side, uint64_t pos);
+static int  ringbuffer_spsc_write(srsran_ringbuffer_t* q, const uint8_t* ptr, int nof_bytes, int32_t timeout_ms);
+static int  ringbuffer_spsc_read(srsran_ringbuffer_t* q, uint8_t* ptr, void** block, int nof_bytes, int32_t timeout_ms);
+static int  ringbuffer_spsc_read_convert_conj(srsran_ringbuffer_t* q, cf_t* dst_ptr, float norm, int nof_samples);
+
 int srsran_ringbuffer_init(srsran_ringbuffer_t* q, int capacity)
 {
+  q->spsc   = NULL;
   q->buffer = srsran_vec_malloc(capacity);
   if (!q->buffer) {
     return SRSRAN_ERROR;
@@ -42,9 +74,36 @@ int srsran_ringbuffer_init(srsran_ringbuffer_t* q, int capacity)
   return SRSRAN_SUCCESS;
 }
 
+int srsran_ringbuffer_init_spsc(srsran_ringbuffer_t* q, int capacity)
+{
+  void* state = NULL;
+  if (capacity <= 0 || posix_memalign(&state, RINGBUFFER_CACHE_LINE, sizeof(srsran_ringbuffer_spsc_t)) != 0) {
+    return SRSRAN_ERROR;
+  }
+  memset(state, 0, sizeof(srsran_ringbuffer_spsc_t));
+
+  q->spsc   = (srsran_ringbuffer_spsc_t*)state;
+  q->buffer = NULL;
+  q->count  = 0;
+  q->wpm    = 0;
+  q->rpm    = 0;
+  if (ringbuffer_spsc_buffer_alloc(q, capacity) < SRSRAN_SUCCESS) {
+    free(q->spsc);
+    q->spsc = NULL;
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_ringbuffer_free(srsran_ringbuffer_t* q)
 {
-  if (q) {
+  if (q && q->spsc) {
+    srsran_ringbuffer_stop(q);
+    ringbuffer_spsc_buffer_free(q);
+    free(q->spsc);
+    q->spsc = NULL;
+  } else if (q) {
     srsran_ringbuffer_stop(q);
     if (q->buffer) {
       free(q->buffer);
@@ -58,6 +117,12 @@ void srsran_ringbuffer_free(srsran_ringbuffer_t* q)
 
 void srsran_ringbuffer_reset(srsran_ringbuffer_t* q)
 {
+  if (q->spsc) {
+    q->spsc->head.pos = 0;
+    q->spsc->tail.pos = 0;
+    return;
+  }
+
   // Check first if it is initiated
   if (q->capacity != 0) {
     pthread_mutex_lock(&q->mutex);
@@ -70,6 +135,12 @@ void srsran_ringbuffer_reset(srsran_ringbuffer_t* q)
 
 int srsran_ringbuffer_resize(srsran_ringbuffer_t* q, int capacity)
 {
+  if (q->spsc) {
+    ringbuffer_spsc_buffer_free(q);
+    srsran_ringbuffer_reset(q);
+    return ringbuffer_spsc_buffer_alloc(q, capacity);
+  }
+
   if (q->buffer) {
     free(q->buffer);
     q->buffer = NULL;
@@ -87,6 +158,11 @@ int srsran_ringbuffer_resize(srsran_ringbuffer_t* q, int capacity)
 
 int srsran_ringbuffer_status(srsran_ringbuffer_t* q)
 {
+  if (q->spsc) {
+    return (int)(__atomic_load_n(&q->spsc->head.pos, __ATOMIC_ACQUIRE) -
+                 __atomic_load_n(&q->spsc->tail.pos, __ATOMIC_ACQUIRE));
+  }
+
   int status = 0;
   pthread_mutex_lock(&q->mutex);
   status = q->count;
@@ -96,6 +172,9 @@ int srsran_ringbuffer_status(srsran_ringbuffer_t* q)
 
 int srsran_ringbuffer_space(srsran_ringbuffer_t* q)
 {
+  if (q->spsc) {
+    return q->capacity - srsran_ringbuffer_status(q);
+  }
   return q->capacity - q->count;
 }
 
@@ -127,6 +206,10 @@ int srsran_ringbuffer_write_timed_block(srsran_ringbuffer_t* q, void* p, int nof
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
+  if (q->spsc) {
+    return ringbuffer_spsc_write(q, ptr, nof_bytes, timeout_ms);
+  }
+
   // Get current time and update timeout
   if (timeout_ms > 0) {
     gettimeofday(&now, NULL);
@@ -198,6 +281,10 @@ int srsran_ringbuffer_read_timed_block(srsran_ringbuffer_t* q, void* p, int nof_
   uint8_t*        ptr    = (uint8_t*)p;
   struct timespec towait = {};
 
+  if (q->spsc) {
+    return ringbuffer_spsc_read(q, ptr, NULL, nof_bytes, timeout_ms);
+  }
+
   // Get current time and update timeout
   if (timeout_ms > 0) {
     struct timespec now = {};
@@ -257,6 +344,14 @@ int srsran_ringbuffer_read_timed_block(srsran_ringbuffer_t* q, void* p, int nof_
 
 void srsran_ringbuffer_stop(srsran_ringbuffer_t* q)
 {
+  if (q->spsc) {
+    __atomic_store_n(&q->spsc->active, 0, __ATOMIC_SEQ_CST);
+    q->active = false;
+    ringbuffer_spsc_publish(&q->spsc->head, q->spsc->head.pos);
+    ringbuffer_spsc_publish(&q->spsc->tail, q->spsc->tail.pos);
+    return;
+  }
+
   pthread_mutex_lock(&q->mutex);
   q->active = false;
   pthread_cond_broadcast(&q->write_cvar);
@@ -269,6 +364,10 @@ int srsran_ringbuffer_read_convert_conj(srsran_ringbuffer_t* q, cf_t* dst_ptr, f
 {
   uint32_t nof_bytes = nof_samples * 4;
 
+  if (q->spsc) {
+    return ringbuffer_spsc_read_convert_conj(q, dst_ptr, norm, nof_samples);
+  }
+
   pthread_mutex_lock(&q->mutex);
   while (q->count < nof_bytes && q->active) {
     pthread_cond_wait(&q->write_cvar, &q->mutex);
@@ -305,6 +404,10 @@ int srsran_ringbuffer_read_block(srsran_ringbuffer_t* q, void** p, int nof_bytes
   int             ret    = SRSRAN_SUCCESS;
   struct timespec towait = {};
 
+  if (q->spsc) {
+    return ringbuffer_spsc_read(q, NULL, p, nof_bytes, timeout_ms);
+  }
+
   // Get current time and update timeout
   if (timeout_ms > 0) {
     struct timespec now = {};
@@ -353,3 +456,265 @@ int srsran_ringbuffer_read_block(srsran_ringbuffer_t* q, void** p, int nof_bytes
   pthread_mutex_unlock(&q->mutex);
   return ret;
 }
+
+/* Allocates the physical buffer, mapping it twice back to back when possible so any block is contiguous */
+static int ringbuffer_spsc_buffer_alloc(srsran_ringbuffer_t* q, int capacity)
+{
+  srsran_ringbuffer_spsc_t* s = q->spsc;
+
+  s->mirrored = false;
+  q->buffer   = NULL;
+
+#ifdef MFD_CLOEXEC
+  long page = sysconf(_SC_PAGESIZE);
+  if (page > 0) {
+    size_t size = SRSRAN_CEIL((size_t)capacity, (size_t)page) * (size_t)page;
+    int    fd   = memfd_create("srsran_ringbuffer", MFD_CLOEXEC);
+    if (fd >= 0 && size <= UINT32_MAX && ftruncate(fd, (off_t)size) == 0) {
+      uint8_t* base = mmap(NULL, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (base != MAP_FAILED) {
+        if (mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+            mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED) {
+          q->buffer   = base;
+          s->size     = (uint32_t)size;
+          s->mirrored = true;
+        } else {
+          munmap(base, 2 * size);
+        }
+      }
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+#endif /* MFD_CLOEXEC */
+
+  // Fallback, the blocks that wrap are copied in two parts
+  if (!s->mirrored) {
+    q->buffer = srsran_vec_malloc(capacity);
+    if (!q->buffer) {
+      return SRSRAN_ERROR;
+    }
+    s->size = (uint32_t)capacity;
+  }
+
+  q->capacity = capacity;
+  q->active   = true;
+  __atomic_store_n(&s->active, 1, __ATOMIC_SEQ_CST);
+
+  return SRSRAN_SUCCESS;
+}
+
+static void ringbuffer_spsc_buffer_free(srsran_ringbuffer_t* q)
+{
+  if (q->buffer) {
+    if (q->spsc->mirrored) {
+      munmap(q->buffer, 2 * (size_t)q->spsc->size);
+    } else {
+      free(q->buffer);
+    }
+    q->buffer = NULL;
+  }
+  q->spsc->mirrored = false;
+}
+
+static void ringbuffer_spsc_futex_wait(uint32_t* addr, uint32_t val, const struct timespec* timeout)
+{
+  syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, timeout, NULL, 0);
+}
+
+static void ringbuffer_spsc_futex_wake(uint32_t* addr)
+{
+  syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+/* Checks whether the writer has space for (or the reader has available) nof_bytes */
+static bool ringbuffer_spsc_ready(srsran_ringbuffer_t* q, bool writer, int nof_bytes)
+{
+  srsran_ringbuffer_spsc_t* s = q->spsc;
+  if (writer) {
+    uint64_t tail = __atomic_load_n(&s->tail.pos, __ATOMIC_ACQUIRE);
+    return s->head.pos - tail + (uint64_t)nof_bytes <= (uint64_t)q->capacity;
+  }
+  uint64_t head = __atomic_load_n(&s->head.pos, __ATOMIC_ACQUIRE);
+  return head - s->tail.pos >= (uint64_t)nof_bytes;
+}
+
+/* Sleeps on the other side until it is ready, stopped or the timeout expires. A timeout <= 0 waits forever */
+static int ringbuffer_spsc_wait(srsran_ringbuffer_t* q, bool writer, int nof_bytes, int32_t timeout_ms)
+{
+  srsran_ringbuffer_spsc_t* s        = q->spsc;
+  ringbuffer_spsc_side_t*   other    = writer ? &s->tail : &s->head;
+  struct timespec           deadline = {};
+
+  if (timeout_ms > 0) {
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    long nsec = deadline.tv_nsec + (timeout_ms % 1000L) * 1000000L;
+    deadline.tv_sec += timeout_ms / 1000L + nsec / 1000000000L;
+    deadline.tv_nsec = nsec % 1000000000L;
+  }
+
+  while (!ringbuffer_spsc_ready(q, writer, nof_bytes)) {
+    if (!__atomic_load_n(&s->active, __ATOMIC_ACQUIRE)) {
+      return SRSRAN_SUCCESS;
+    }
+
+    // Announce the sleep before checking again, so the other side either sees the flag or this side sees its update
+    uint32_t seq = __atomic_load_n(&other->seq, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&other->waiting, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (ringbuffer_spsc_ready(q, writer, nof_bytes) || !__atomic_load_n(&s->active, __ATOMIC_ACQUIRE)) {
+      __atomic_store_n(&other->waiting, 0, __ATOMIC_RELAXED);
+      continue;
+    }
+
+    struct timespec  rel     = {};
+    struct timespec* timeout = NULL;
+    if (timeout_ms > 0) {
+      struct timespec now = {};
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      long long nsec = (deadline.tv_sec - now.tv_sec) * 1000000000LL + (deadline.tv_nsec - now.tv_nsec);
+      if (nsec <= 0) {
+        __atomic_store_n(&other->waiting, 0, __ATOMIC_RELAXED);
+        return SRSRAN_ERROR_TIMEOUT;
+      }
+      rel.tv_sec  = nsec / 1000000000LL;
+      rel.tv_nsec = nsec % 1000000000LL;
+      timeout     = &rel;
+    }
+    ringbuffer_spsc_futex_wait(&other->seq, seq, timeout);
+    __atomic_store_n(&other->waiting, 0, __ATOMIC_RELAXED);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Makes the new position visible to the other side, waking it only if it went to sleep */
+static void ringbuffer_spsc_publish(ringbuffer_spsc_side_t* side, uint64_t pos)
+{
+  __atomic_store_n(&side->pos, pos, __ATOMIC_RELEASE);
+  __atomic_fetch_add(&side->seq, 1, __ATOMIC_RELEASE);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&side->waiting, __ATOMIC_RELAXED)) {
+    ringbuffer_spsc_futex_wake(&side->seq);
+  }
+}
+
+/* Copies into the buffer at a position, zeros if the source is NULL */
+static void ringbuffer_spsc_copy_in(srsran_ringbuffer_t* q, uint64_t pos, const uint8_t* ptr, int nof_bytes)
+{
+  uint32_t idx = (uint32_t)(pos % q->spsc->size);
+  uint32_t n1  = q->spsc->mirrored ? (uint32_t)nof_bytes : SRSRAN_MIN((uint32_t)nof_bytes, q->spsc->size - idx);
+
+  if (ptr) {
+    memcpy(&q->buffer[idx], ptr, n1);
+    memcpy(q->buffer, &ptr[n1], nof_bytes - n1);
+  } else {
+    memset(&q->buffer[idx], 0, n1);
+    memset(q->buffer, 0, nof_bytes - n1);
+  }
+}
+
+static void ringbuffer_spsc_copy_out(srsran_ringbuffer_t* q, uint64_t pos, uint8_t* ptr, int nof_bytes)
+{
+  uint32_t idx = (uint32_t)(pos % q->spsc->size);
+  uint32_t n1  = q->spsc->mirrored ? (uint32_t)nof_bytes : SRSRAN_MIN((uint32_t)nof_bytes, q->spsc->size - idx);
+
+  memcpy(ptr, &q->buffer[idx], n1);
+  memcpy(&ptr[n1], q->buffer, nof_bytes - n1);
+}
+
+static int ringbuffer_spsc_write(srsran_ringbuffer_t* q, const uint8_t* ptr, int nof_bytes, int32_t timeout_ms)
+{
+  srsran_ringbuffer_spsc_t* s = q->spsc;
+
+  if (nof_bytes > q->capacity) {
+    ERROR("Buffer overrun: lost %d bytes", nof_bytes - q->capacity);
+    nof_bytes = q->capacity;
+  }
+
+  if (timeout_ms == 0) {
+    // Non blocking, write what fits and drop the rest
+    int space = q->capacity - (int)(s->head.pos - __atomic_load_n(&s->tail.pos, __ATOMIC_ACQUIRE));
+    if (space < nof_bytes) {
+      ERROR("Buffer overrun: lost %d bytes", nof_bytes - space);
+      nof_bytes = space;
+    }
+  } else {
+    int ret = ringbuffer_spsc_wait(q, true, nof_bytes, timeout_ms);
+    if (ret < SRSRAN_SUCCESS) {
+      return ret;
+    }
+  }
+
+  if (!__atomic_load_n(&s->active, __ATOMIC_ACQUIRE)) {
+    return 0;
+  }
+
+  ringbuffer_spsc_copy_in(q, s->head.pos, ptr, nof_bytes);
+  ringbuffer_spsc_publish(&s->head, s->head.pos + nof_bytes);
+
+  return nof_bytes;
+}
+
+/* Reads nof_bytes, either copying them into ptr or, if block is given, pointing at them inside the buffer. The block
+ * stays valid until the writer is given the space back, i.e. until the next read */
+static int ringbuffer_spsc_read(srsran_ringbuffer_t* q, uint8_t* ptr, void** block, int nof_bytes, int32_t timeout_ms)
+{
+  srsran_ringbuffer_spsc_t* s = q->spsc;
+
+  if (nof_bytes > q->capacity) {
+    ERROR("Requested %d bytes from a ring buffer of %d bytes", nof_bytes, q->capacity);
+    return SRSRAN_ERROR;
+  }
+
+  int ret = ringbuffer_spsc_wait(q, false, nof_bytes, timeout_ms);
+  if (ret < SRSRAN_SUCCESS) {
+    return ret;
+  }
+  if (!__atomic_load_n(&s->active, __ATOMIC_ACQUIRE)) {
+    return 0;
+  }
+
+  uint64_t pos = s->tail.pos;
+  if (block) {
+    uint32_t idx = (uint32_t)(pos % s->size);
+    if (!s->mirrored && idx + nof_bytes > s->size) {
+      // Without the mirror the capacity must be multiple of the block size, as in the locking mode
+      ERROR("Block of %d bytes wraps around the ring buffer", nof_bytes);
+      return SRSRAN_ERROR;
+    }
+    *block = &q->buffer[idx];
+  } else {
+    ringbuffer_spsc_copy_out(q, pos, ptr, nof_bytes);
+  }
+  ringbuffer_spsc_publish(&s->tail, pos + nof_bytes);
+
+  return nof_bytes;
+}
+
+/* Converts in place in the buffer, the writer is only given the space back once the samples are out */
+static int ringbuffer_spsc_read_convert_conj(srsran_ringbuffer_t* q, cf_t* dst_ptr, float norm, int nof_samples)
+{
+  srsran_ringbuffer_spsc_t* s         = q->spsc;
+  int                       nof_bytes = nof_samples * 4;
+
+  if (nof_bytes > q->capacity || ringbuffer_spsc_wait(q, false, nof_bytes, -1) < SRSRAN_SUCCESS ||
+      !__atomic_load_n(&s->active, __ATOMIC_ACQUIRE)) {
+    return SRSRAN_ERROR;
+  }
+
+  uint64_t pos = s->tail.pos;
+  uint32_t idx = (uint32_t)(pos % s->size);
+  uint32_t n1  = s->mirrored ? (uint32_t)nof_bytes : SRSRAN_MIN((uint32_t)nof_bytes, s->size - idx);
+  float*   dst = (float*)dst_ptr;
+
+  srsran_vec_convert_if((int16_t*)&q->buffer[idx], norm, dst, n1 / 2);
+  if (n1 < (uint32_t)nof_bytes) {
+    srsran_vec_convert_if((int16_t*)q->buffer, norm, &dst[n1 / 2], (nof_bytes - n1) / 2);
+  }
+  srsran_vec_conj_cc(dst_ptr, dst_ptr, nof_samples);
+  ringbuffer_spsc_publish(&s->tail, pos + nof_bytes);
+
+  return nof_samples;
+}
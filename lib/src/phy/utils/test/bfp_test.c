@@ -0,0 +1,113 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/bfp.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/support/srsran_test.h"
+#include <complex.h>
+#include <math.h>
+
+#define NOF_PRB 106
+
+static srsran_random_t random_gen = NULL;
+
+static int test_round_trip(uint32_t iq_width)
+{
+  cf_t    symbols[NOF_PRB * SRSRAN_NRE];
+  cf_t    decoded[NOF_PRB * SRSRAN_NRE];
+  uint8_t buffer[NOF_PRB * SRSRAN_BFP_PRB_BYTES(SRSRAN_BFP_MAX_IQ_WIDTH)];
+  float   scale = 4096.0f;
+
+  srsran_random_uniform_complex_dist_vector(random_gen, symbols, NOF_PRB * SRSRAN_NRE, -1.0f, 1.0f);
+
+  int nof_bytes = NOF_PRB * SRSRAN_BFP_PRB_BYTES(iq_width);
+  TESTASSERT(srsran_bfp_compress(symbols, scale, NOF_PRB, iq_width, buffer) == nof_bytes);
+  TESTASSERT(srsran_bfp_decompress(buffer, scale, NOF_PRB, iq_width, decoded) == nof_bytes);
+
+  // The quantisation step of each PRB depends on its largest value
+  for (uint32_t prb = 0; prb < NOF_PRB; prb++) {
+    float max_abs = 0.0f;
+    for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+      cf_t x  = symbols[prb * SRSRAN_NRE + k];
+      max_abs = SRSRAN_MAX(max_abs, SRSRAN_MAX(fabsf(__real__ x), fabsf(__imag__ x)));
+    }
+    float max_error = max_abs * ldexpf(1.0f, 2 - (int)iq_width) + 1.0f / scale;
+
+    for (uint32_t k = 0; k < SRSRAN_NRE; k++) {
+      cf_t x = symbols[prb * SRSRAN_NRE + k];
+      cf_t y = decoded[prb * SRSRAN_NRE + k];
+      TESTASSERT(fabsf(__real__ x - __real__ y) <= max_error);
+      TESTASSERT(fabsf(__imag__ x - __imag__ y) <= max_error);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Integer values that fit in the mantissa are transported without loss
+static int test_exact(uint32_t iq_width)
+{
+  cf_t    symbols[NOF_PRB * SRSRAN_NRE];
+  cf_t    decoded[NOF_PRB * SRSRAN_NRE];
+  uint8_t buffer[NOF_PRB * SRSRAN_BFP_PRB_BYTES(SRSRAN_BFP_MAX_IQ_WIDTH)];
+  int32_t max_value = (1 << (iq_width - 1)) - 1;
+
+  for (uint32_t i = 0; i < NOF_PRB * SRSRAN_NRE; i++) {
+    float re   = (float)srsran_random_uniform_int_dist(random_gen, -max_value - 1, max_value);
+    float im   = (float)srsran_random_uniform_int_dist(random_gen, -max_value - 1, max_value);
+    symbols[i] = re + I * im;
+  }
+
+  TESTASSERT(srsran_bfp_compress(symbols, 1.0f, NOF_PRB, iq_width, buffer) > 0);
+  TESTASSERT(srsran_bfp_decompress(buffer, 1.0f, NOF_PRB, iq_width, decoded) > 0);
+
+  for (uint32_t i = 0; i < NOF_PRB * SRSRAN_NRE; i++) {
+    TESTASSERT(symbols[i] == decoded[i]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  random_gen = srsran_random_init(0x1234);
+
+  TESTASSERT(SRSRAN_BFP_PRB_BYTES(9) == 28);
+  TESTASSERT(SRSRAN_BFP_PRB_BYTES(16) == 49);
+
+  for (uint32_t iq_width = SRSRAN_BFP_MIN_IQ_WIDTH + 1; iq_width <= SRSRAN_BFP_MAX_IQ_WIDTH; iq_width++) {
+    TESTASSERT(test_round_trip(iq_width) == SRSRAN_SUCCESS);
+  }
+
+  TESTASSERT(test_exact(9) == SRSRAN_SUCCESS);
+  TESTASSERT(test_exact(16) == SRSRAN_SUCCESS);
+
+  // Invalid mantissa widths are rejected
+  cf_t    symbols[SRSRAN_NRE] = {};
+  uint8_t buffer[SRSRAN_BFP_PRB_BYTES(SRSRAN_BFP_MAX_IQ_WIDTH)];
+  TESTASSERT(srsran_bfp_compress(symbols, 1.0f, 1, 0, buffer) < SRSRAN_SUCCESS);
+  TESTASSERT(srsran_bfp_compress(symbols, 1.0f, 1, SRSRAN_BFP_MAX_IQ_WIDTH + 1, buffer) < SRSRAN_SUCCESS);
+
+  srsran_random_free(random_gen);
+
+  return SRSRAN_SUCCESS;
+}
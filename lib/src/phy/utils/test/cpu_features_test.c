@@ -0,0 +1,68 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/cpu_features.h"
+#include "srsran/support/srsran_test.h"
+#include <stdio.h>
+#include <string.h>
+
+int main(int argc, char** argv)
+{
+  uint32_t features = srsran_cpu_features();
+
+  // Cached value
+  TESTASSERT(srsran_cpu_features() == features);
+  TESTASSERT(srsran_cpu_has(0));
+
+  // The test is running, so the host supports the instruction sets the library was built for
+#ifdef LV_HAVE_SSE
+  TESTASSERT(srsran_cpu_has(SRSRAN_CPU_SSE41));
+#endif // LV_HAVE_SSE
+#ifdef LV_HAVE_AVX2
+  TESTASSERT(srsran_cpu_has(SRSRAN_CPU_AVX | SRSRAN_CPU_AVX2));
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_FMA
+  TESTASSERT(srsran_cpu_has(SRSRAN_CPU_FMA));
+#endif // LV_HAVE_FMA
+#ifdef LV_HAVE_AVX512
+  TESTASSERT(srsran_cpu_has(SRSRAN_CPU_AVX512));
+#endif // LV_HAVE_AVX512
+#ifdef HAVE_NEON
+  TESTASSERT(srsran_cpu_has(SRSRAN_CPU_NEON));
+#endif // HAVE_NEON
+
+  // AVX-512 and AVX2 state need OS support for AVX
+  if (srsran_cpu_has(SRSRAN_CPU_AVX2) || srsran_cpu_has(SRSRAN_CPU_AVX512)) {
+    TESTASSERT(srsran_cpu_has(SRSRAN_CPU_AVX));
+  }
+
+  char str[64] = {};
+  int  len     = srsran_cpu_features_string(str, sizeof(str));
+  TESTASSERT(len >= 0 && len < (int)sizeof(str));
+  TESTASSERT(str[len] == '\0');
+  printf("CPU features: %s\n", str);
+
+  // Truncated output is still terminated
+  len = srsran_cpu_features_string(str, 4);
+  TESTASSERT(len <= 3 && strlen(str) == (size_t)len);
+
+  return SRSRAN_SUCCESS;
+}
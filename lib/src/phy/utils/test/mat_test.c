@@ -33,6 +33,7 @@
 static bool            inverter    = false;
 static bool            zf_solver   = false;
 static bool            mmse_solver = false;
+static bool            herm_inv    = false;
 static bool            verbose     = false;
 static srsran_random_t random_gen  = NULL;
 
@@ -72,8 +73,9 @@ double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 
 void usage(char* prog)
 {
-  printf("Usage: %s [mzvh]\n", prog);
+  printf("Usage: %s [mznvh]\n", prog);
   printf("\t-m Test Minimum Mean Squared Error (MMSE) solver\n");
+  printf("\t-n Test batched NxN Hermitian matrix inversion\n");
   printf("\t-z Test Zero Forcing (ZF) solver\n");
   printf("\t-v Verbose\n");
   printf("\t-h Show this message\n");
@@ -82,7 +84,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "imzvh")) != -1) {
+  while ((opt = getopt(argc, argv, "imznvh")) != -1) {
     switch (opt) {
       case 'i':
         inverter = true;
@@ -93,6 +95,9 @@ void parse_args(int argc, char** argv)
       case 'z':
         zf_solver = true;
         break;
+      case 'n':
+        herm_inv = true;
+        break;
       case 'v':
         verbose = true;
         break;
@@ -293,6 +298,70 @@ bool test_matrix_inv(void)
   return true;
 }
 
+static bool test_hermitian_inv_soa(void)
+{
+  // Not a multiple of any SIMD width, so that the generic tail is also verified
+  const uint32_t nof_re = 37;
+  bool           passed = true;
+
+  for (uint32_t N = 1; N <= SRSRAN_MAT_HERM_MAX_N && passed; N++) {
+    cf_t* a[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N] = {};
+    cf_t* r[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N] = {};
+    cf_t  gold[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N][nof_re];
+
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        a[i][j] = srsran_vec_cf_malloc(nof_re);
+        r[i][j] = srsran_vec_cf_malloc(nof_re);
+      }
+    }
+
+    // A = H' x H + I is Hermitian positive definite
+    for (uint32_t k = 0; k < nof_re; k++) {
+      cf_t h[SRSRAN_MAT_HERM_MAX_N][SRSRAN_MAT_HERM_MAX_N];
+      for (uint32_t i = 0; i < N; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+          h[i][j] = RANDOM_CF();
+        }
+      }
+      for (uint32_t i = 0; i < N; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+          cf_t acc = (i == j) ? 1.0f : 0.0f;
+          for (uint32_t c = 0; c < N; c++) {
+            acc += conjf(h[c][i]) * h[c][j];
+          }
+          a[i][j][k]    = acc;
+          gold[i][j][k] = acc;
+        }
+      }
+    }
+
+    srsran_mat_hermitian_inv_soa(a, r, N, nof_re);
+
+    // A x inv(A) = I
+    for (uint32_t k = 0; k < nof_re; k++) {
+      for (uint32_t i = 0; i < N; i++) {
+        for (uint32_t j = 0; j < N; j++) {
+          cf_t acc = 0;
+          for (uint32_t c = 0; c < N; c++) {
+            acc += gold[i][c][k] * r[c][j][k];
+          }
+          passed &= cabsf(acc - ((i == j) ? 1.0f : 0.0f)) < 1e-4f;
+        }
+      }
+    }
+
+    for (uint32_t i = 0; i < N; i++) {
+      for (uint32_t j = 0; j < N; j++) {
+        free(a[i][j]);
+        free(r[i][j]);
+      }
+    }
+  }
+
+  return passed;
+}
+
 int main(int argc, char** argv)
 {
   bool passed = true;
@@ -322,6 +391,10 @@ int main(int argc, char** argv)
     RUN_TEST(test_matrix_inv);
   }
 
+  if (herm_inv) {
+    RUN_TEST(test_hermitian_inv_soa);
+  }
+
   RUN_TEST(test_vec_dot_prod_ccc);
 
   printf("%s!\n", (passed) ? "Ok" : "Failed");
@@ -21,6 +21,7 @@
 
 #include "srsran/phy/utils/re_pattern.h"
 #include "srsran/support/srsran_test.h"
+#include <string.h>
 
 int main(int argc, char** argv)
 {
@@ -65,5 +66,54 @@ int main(int argc, char** argv)
     }
   }
 
+  // Create a third pattern overlapping the list with a stride
+  srsran_re_pattern_t pattern_3 = pattern_1;
+  pattern_3.rb_begin            = 20;
+  pattern_3.rb_end              = 60;
+  pattern_3.rb_stride           = 3;
+  pattern_3.sc[1]               = true;
+
+  // Assert compact RB mask and masked copy against the RE mask
+  for (uint32_t l = 0; l < SRSRAN_NSYMB_PER_SLOT_NR; l++) {
+    bool     mask[SRSRAN_NRE * SRSRAN_MAX_PRB_NR]      = {};
+    uint16_t rb_mask[SRSRAN_MAX_PRB_NR]                = {};
+    bool     prb_mask[SRSRAN_MAX_PRB_NR]               = {};
+    cf_t     symbols[SRSRAN_NRE * SRSRAN_MAX_PRB_NR]   = {};
+    cf_t     grid[SRSRAN_NRE * SRSRAN_MAX_PRB_NR]      = {};
+    cf_t     extracted[SRSRAN_NRE * SRSRAN_MAX_PRB_NR] = {};
+    uint32_t nof_re                                    = 0;
+
+    TESTASSERT(srsran_re_pattern_list_to_symbol_mask(&pattern_list, l, mask) == SRSRAN_SUCCESS);
+    TESTASSERT(srsran_re_pattern_to_symbol_mask(&pattern_3, l, mask) == SRSRAN_SUCCESS);
+    TESTASSERT(srsran_re_pattern_list_to_rb_mask(&pattern_list, l, rb_mask) == SRSRAN_SUCCESS);
+    TESTASSERT(srsran_re_pattern_to_rb_mask(&pattern_3, l, rb_mask) == SRSRAN_SUCCESS);
+
+    for (uint32_t k = 0; k < SRSRAN_NRE * SRSRAN_MAX_PRB_NR; k++) {
+      TESTASSERT(mask[k] == ((rb_mask[k / SRSRAN_NRE] >> (k % SRSRAN_NRE)) & 1U));
+      symbols[k] = (float)k;
+    }
+
+    // Allocate some RB runs with and without masked RE
+    for (uint32_t rb = 0; rb < SRSRAN_MAX_PRB_NR; rb++) {
+      prb_mask[rb] = (rb % 7 != 0);
+      for (uint32_t k = 0; k < SRSRAN_NRE && prb_mask[rb]; k++) {
+        nof_re += mask[rb * SRSRAN_NRE + k] ? 0 : 1;
+      }
+    }
+
+    TESTASSERT(srsran_re_pattern_symbol_put(symbols, grid, prb_mask, rb_mask, SRSRAN_MAX_PRB_NR) == nof_re);
+    uint32_t count = 0;
+    for (uint32_t k = 0; k < SRSRAN_NRE * SRSRAN_MAX_PRB_NR; k++) {
+      if (prb_mask[k / SRSRAN_NRE] && !mask[k]) {
+        TESTASSERT(grid[k] == symbols[count++]);
+      } else {
+        TESTASSERT(grid[k] == 0.0f);
+      }
+    }
+
+    TESTASSERT(srsran_re_pattern_symbol_get(grid, extracted, prb_mask, rb_mask, SRSRAN_MAX_PRB_NR) == nof_re);
+    TESTASSERT(memcmp(extracted, symbols, sizeof(cf_t) * nof_re) == 0);
+  }
+
   return SRSRAN_SUCCESS;
 }
\ No newline at end of file
@@ -151,16 +151,32 @@ int threaded_blocking_test(struct thread_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
-int main(int argc, char** argv)
+/* Reads blocks of N bytes; the capacity is not a multiple of it, so the SPSC mode needs its mirrored mapping */
+int test_read_block_wrap(srsran_ringbuffer_t* q, uint8_t* in)
+{
+  for (int i = 0; i < M; i++) {
+    void* block = NULL;
+    TESTASSERT(srsran_ringbuffer_write(q, in, N) == N);
+    TESTASSERT(srsran_ringbuffer_read_block(q, &block, N, 0) == N);
+    TESTASSERT(!memcmp(in, block, N));
+  }
+  TESTASSERT(srsran_ringbuffer_status(q) == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int run_tests(bool spsc)
 {
   int ret = SRSRAN_SUCCESS;
-  parse_args(argc, argv);
   struct thread_args_t thread_in;
 
-  uint8_t*            in  = srsran_vec_u8_malloc(N * 2);
-  uint8_t*            out = srsran_vec_u8_malloc(N * 10);
-  srsran_ringbuffer_t ring_buf;
-  srsran_ringbuffer_init(&ring_buf, N);
+  uint8_t*            in       = srsran_vec_u8_malloc(N * 2);
+  uint8_t*            out      = srsran_vec_u8_malloc(N * 10);
+  srsran_ringbuffer_t ring_buf = {};
+  if (spsc) {
+    TESTASSERT(srsran_ringbuffer_init_spsc(&ring_buf, N) == SRSRAN_SUCCESS);
+  } else {
+    TESTASSERT(srsran_ringbuffer_init(&ring_buf, N) == SRSRAN_SUCCESS);
+  }
 
   thread_in.in  = in;
   thread_in.out = out;
@@ -190,10 +206,32 @@ int main(int argc, char** argv)
     printf("Error in multithreaded blocking ringbuffer test\n");
     ret = SRSRAN_ERROR;
   }
+  srsran_ringbuffer_reset(&ring_buf);
+
+  if (spsc) {
+    if (srsran_ringbuffer_resize(&ring_buf, N + N / 2) < SRSRAN_SUCCESS || test_read_block_wrap(&ring_buf, in)) {
+      printf("Error in ringbuffer block read test\n");
+      ret = SRSRAN_ERROR;
+    }
+  }
+
   srsran_ringbuffer_stop(&ring_buf);
   srsran_ringbuffer_free(&ring_buf);
   free(in);
   free(out);
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  int ret = run_tests(false);
+  if (run_tests(true) < SRSRAN_SUCCESS) {
+    printf("Error in single producer single consumer mode\n");
+    ret = SRSRAN_ERROR;
+  }
+
   printf("Done\n");
   return ret;
 }
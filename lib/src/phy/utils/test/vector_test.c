@@ -228,6 +228,26 @@ TEST(
     free(y);
     free(z);)
 
+TEST(
+    srsran_vec_sum_sat_bbb, MALLOC(int8_t, x); MALLOC(int8_t, y); MALLOC(int8_t, z);
+
+    int16_t gold = 0.0f;
+    for (int i = 0; i < block_size; i++) {
+      x[i] = RANDOM_B();
+      y[i] = RANDOM_B();
+    }
+
+    TEST_CALL(srsran_vec_sum_sat_bbb(x, y, z, 63, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          gold = SRSRAN_MIN(SRSRAN_MAX(x[i] + y[i], -63), 63);
+          mse += abs(gold - z[i]);
+        }
+
+    free(x);
+    free(y);
+    free(z);)
+
 TEST(
     srsran_vec_neg_bbb, MALLOC(int8_t, x); MALLOC(int8_t, y); MALLOC(int8_t, z);
 
@@ -776,6 +796,25 @@ TEST(
     free(x);
     free(z);)
 
+TEST(
+    srsran_vec_apply_cfo_phase, MALLOC(cf_t, x); MALLOC(cf_t, z);
+
+    const float cfo   = 0.1f;
+    const int   split = block_size / 3;
+    cf_t        gold;
+    for (int i = 0; i < block_size; i++) { x[i] = RANDOM_CF(); }
+
+    TEST_CALL(cf_t phase = srsran_vec_apply_cfo_phase(x, cfo, 1.0f, z, split);
+              srsran_vec_apply_cfo_phase(&x[split], cfo, phase, &z[split], block_size - split);)
+
+        for (int i = 0; i < block_size; i++) {
+          gold = x[i] * cexpf(_Complex_I * 2.0f * (float)M_PI * i * cfo);
+          mse += cabsf(gold - z[i]) / cabsf(gold);
+        } mse /= block_size;
+
+    free(x);
+    free(z);)
+
 TEST(
     srsran_vec_gen_sine, MALLOC(cf_t, z);
 
@@ -877,6 +916,69 @@ TEST(
     free(x_abs);
     free(env);)
 
+TEST(
+    srsran_vec_interleave, MALLOC(cf_t, x); MALLOC(cf_t, y); cf_t* z = srsran_vec_cf_malloc(2 * block_size);
+
+    for (int i = 0; i < block_size; i++) {
+      x[i] = RANDOM_CF();
+      y[i] = RANDOM_CF();
+    }
+
+    TEST_CALL(srsran_vec_interleave(x, y, z, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          mse += cabsf(x[i] - z[2 * i]) + cabsf(y[i] - z[2 * i + 1]);
+        }
+
+    free(x);
+    free(y);
+    free(z);)
+
+TEST(
+    srsran_vec_interleave_add, MALLOC(cf_t, x); MALLOC(cf_t, y); cf_t* z = srsran_vec_cf_malloc(2 * block_size);
+    cf_t* gold = srsran_vec_cf_malloc(2 * block_size);
+
+    for (int i = 0; i < block_size; i++) {
+      x[i] = RANDOM_CF();
+      y[i] = RANDOM_CF();
+    }
+
+    // Each call accumulates on top of the previous output, a repetition at a time
+    srsran_vec_cf_zero(gold, 2 * block_size);
+    for (int r = 0; r < nof_repetitions; r++) {
+      for (int i = 0; i < block_size; i++) {
+        gold[2 * i] += x[i];
+        gold[2 * i + 1] += y[i];
+      }
+    } srsran_vec_cf_zero(z, 2 * block_size);
+
+    TEST_CALL(srsran_vec_interleave_add(x, y, z, block_size))
+
+        for (int i = 0; i < 2 * block_size; i++) { mse += cabsf(gold[i] - z[i]) / nof_repetitions; }
+
+    free(x);
+    free(y);
+    free(z);
+    free(gold);)
+
+TEST(
+    srsran_vec_convert_fb, MALLOC(float, x); MALLOC(int8_t, z); float scale = 100.0f;
+
+    for (int i = 0; i < block_size; i++) { x[i] = RANDOM_F(); }
+
+    TEST_CALL(srsran_vec_convert_fb(x, scale, z, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          int8_t gold = (int8_t)(x[i] * scale);
+          double err  = abs(gold - z[i]);
+          if (err > mse) {
+            mse = err;
+          }
+        }
+
+    free(x);
+    free(z);)
+
 int main(int argc, char** argv)
 {
   char     func_names[MAX_FUNCTIONS][32];
@@ -923,6 +1025,10 @@ int main(int argc, char** argv)
         test_srsran_vec_neg_sss(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_sum_sat_bbb(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_neg_bbb(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
@@ -1039,6 +1145,10 @@ int main(int argc, char** argv)
         test_srsran_vec_apply_cfo(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_apply_cfo_phase(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_gen_sine(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
@@ -1059,6 +1169,18 @@ int main(int argc, char** argv)
         test_srsran_vec_gen_clip_env(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_interleave(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
+    passed[func_count][size_count] =
+        test_srsran_vec_interleave_add(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
+    passed[func_count][size_count] =
+        test_srsran_vec_convert_fb(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     sizes[size_count] = block_size;
     size_count++;
   }
@@ -24,48 +24,58 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef __linux__
+#include <malloc.h>
+#include <sys/mman.h>
+#endif /* __linux__ */
 
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include "srsran/phy/utils/vector_simd.h"
+#include "vector_simd_dispatch.h"
 
 void srsran_vec_xor_bbb(const uint8_t* x, const uint8_t* y, uint8_t* z, const uint32_t len)
 {
-  srsran_vec_xor_bbb_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_xor_bbb_simd)(x, y, z, len);
 }
 
 // Used in PRACH detector, AGC and chest_dl for noise averaging
 float srsran_vec_acc_ff(const float* x, const uint32_t len)
 {
-  return srsran_vec_acc_ff_simd(x, len);
+  return SRSRAN_VEC_SIMD(srsran_vec_acc_ff_simd)(x, len);
 }
 
 cf_t srsran_vec_acc_cc(const cf_t* x, const uint32_t len)
 {
-  return srsran_vec_acc_cc_simd(x, len);
+  return SRSRAN_VEC_SIMD(srsran_vec_acc_cc_simd)(x, len);
 }
 
 void srsran_vec_sub_fff(const float* x, const float* y, float* z, const uint32_t len)
 {
-  srsran_vec_sub_fff_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_sub_fff_simd)(x, y, z, len);
 }
 
 void srsran_vec_sub_sss(const int16_t* x, const int16_t* y, int16_t* z, const uint32_t len)
 {
-  srsran_vec_sub_sss_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_sub_sss_simd)(x, y, z, len);
 }
 
 void srsran_vec_sub_bbb(const int8_t* x, const int8_t* y, int8_t* z, const uint32_t len)
 {
-  srsran_vec_sub_bbb_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_sub_bbb_simd)(x, y, z, len);
+}
+
+void srsran_vec_sum_sat_bbb(const int8_t* x, const int8_t* y, int8_t* z, const int8_t limit, const uint32_t len)
+{
+  SRSRAN_VEC_SIMD(srsran_vec_sum_sat_bbb_simd)(x, y, z, limit, len);
 }
 
 /* sum a scalar to all elements of a vector */
 void srsran_vec_sc_sum_fff(const float* x, float h, float* z, uint32_t len)
 {
-  srsran_vec_sc_sum_fff_simd(x, h, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_sc_sum_fff_simd)(x, h, z, len);
 }
 
 // Noise estimation in chest_dl, interpolation
@@ -77,12 +87,12 @@ void srsran_vec_sub_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t le
 // Used in PSS/SSS and sum_ccc
 void srsran_vec_sum_fff(const float* x, const float* y, float* z, const uint32_t len)
 {
-  srsran_vec_add_fff_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_add_fff_simd)(x, y, z, len);
 }
 
 void srsran_vec_sum_sss(const int16_t* x, const int16_t* y, int16_t* z, const uint32_t len)
 {
-  srsran_vec_sum_sss_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_sum_sss_simd)(x, y, z, len);
 }
 
 void srsran_vec_sum_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len)
@@ -93,55 +103,55 @@ void srsran_vec_sum_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t le
 // PSS, PBCH, DEMOD, FFTW, etc.
 void srsran_vec_sc_prod_fff(const float* x, const float h, float* z, const uint32_t len)
 {
-  srsran_vec_sc_prod_fff_simd(x, h, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_sc_prod_fff_simd)(x, h, z, len);
 }
 
 // Used throughout
 void srsran_vec_sc_prod_cfc(const cf_t* x, const float h, cf_t* z, const uint32_t len)
 {
-  srsran_vec_sc_prod_cfc_simd(x, h, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_sc_prod_cfc_simd)(x, h, z, len);
 }
 
 void srsran_vec_sc_prod_fcc(const float* x, const cf_t h, cf_t* z, const uint32_t len)
 {
-  srsran_vec_sc_prod_fcc_simd(x, h, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_sc_prod_fcc_simd)(x, h, z, len);
 }
 
 // Chest UL
 void srsran_vec_sc_prod_ccc(const cf_t* x, const cf_t h, cf_t* z, const uint32_t len)
 {
-  srsran_vec_sc_prod_ccc_simd(x, h, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_sc_prod_ccc_simd)(x, h, z, len);
 }
 
 // Used in turbo decoder
 void srsran_vec_convert_if(const int16_t* x, const float scale, float* z, const uint32_t len)
 {
-  srsran_vec_convert_if_simd(x, z, scale, len);
+  SRSRAN_VEC_SIMD(srsran_vec_convert_if_simd)(x, z, scale, len);
 }
 
 void srsran_vec_convert_fi(const float* x, const float scale, int16_t* z, const uint32_t len)
 {
-  srsran_vec_convert_fi_simd(x, z, scale, len);
+  SRSRAN_VEC_SIMD(srsran_vec_convert_fi_simd)(x, z, scale, len);
 }
 
 void srsran_vec_convert_conj_cs(const cf_t* x, const float scale, int16_t* z, const uint32_t len)
 {
-  srsran_vec_convert_conj_cs_simd(x, z, scale, len);
+  SRSRAN_VEC_SIMD(srsran_vec_convert_conj_cs_simd)(x, z, scale, len);
 }
 
 void srsran_vec_convert_fb(const float* x, const float scale, int8_t* z, const uint32_t len)
 {
-  srsran_vec_convert_fb_simd(x, z, scale, len);
+  SRSRAN_VEC_SIMD(srsran_vec_convert_fb_simd)(x, z, scale, len);
 }
 
 void srsran_vec_lut_sss(const short* x, const unsigned short* lut, short* y, const uint32_t len)
 {
-  srsran_vec_lut_sss_simd(x, lut, y, len);
+  SRSRAN_VEC_SIMD(srsran_vec_lut_sss_simd)(x, lut, y, len);
 }
 
 void srsran_vec_lut_bbb(const int8_t* x, const unsigned short* lut, int8_t* y, const uint32_t len)
 {
-  srsran_vec_lut_bbb_simd(x, lut, y, len);
+  SRSRAN_VEC_SIMD(srsran_vec_lut_bbb_simd)(x, lut, y, len);
 }
 
 void srsran_vec_lut_sis(const short* x, const unsigned int* lut, short* y, const uint32_t len)
@@ -151,14 +161,60 @@ void srsran_vec_lut_sis(const short* x, const unsigned int* lut, short* y, const
   }
 }
 
+/* Size of the transparent huge pages the buffers are aligned to and advised for */
+#define VEC_HUGE_PAGE_SIZE (2U * 1024U * 1024U)
+
+static bool vec_use_hugepages = false;
+
+bool srsran_vec_set_hugepages(bool enable)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (enable) {
+    // Grow the heap in huge page multiples and never give it back, so the small buffers end up packed in regions
+    // that stay mapped and can be collapsed into huge pages
+#ifdef M_TOP_PAD
+    mallopt(M_TOP_PAD, VEC_HUGE_PAGE_SIZE);
+    mallopt(M_TRIM_THRESHOLD, 64 * VEC_HUGE_PAGE_SIZE);
+#endif /* M_TOP_PAD */
+  }
+  vec_use_hugepages = enable;
+  return true;
+#else  /* defined(__linux__) && defined(MADV_HUGEPAGE) */
+  vec_use_hugepages = false;
+  return !enable;
+#endif /* defined(__linux__) && defined(MADV_HUGEPAGE) */
+}
+
+static void vec_advise_hugepages(void* ptr, uint32_t size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // Only the huge pages entirely inside the buffer, the neighbouring heap chunks are left alone
+  uintptr_t begin = ((uintptr_t)ptr + VEC_HUGE_PAGE_SIZE - 1) & ~((uintptr_t)VEC_HUGE_PAGE_SIZE - 1);
+  uintptr_t end   = ((uintptr_t)ptr + size) & ~((uintptr_t)VEC_HUGE_PAGE_SIZE - 1);
+  if (begin < end) {
+    madvise((void*)begin, end - begin, MADV_HUGEPAGE);
+  }
+#endif /* defined(__linux__) && defined(MADV_HUGEPAGE) */
+}
+
 void* srsran_vec_malloc(uint32_t size)
 {
-  void* ptr;
-  if (posix_memalign(&ptr, SRSRAN_SIMD_BIT_ALIGN, size)) {
+  void*  ptr;
+  size_t align = SRSRAN_SIMD_BIT_ALIGN;
+
+  // Buffers of at least one huge page start on a huge page boundary, so none of it is split into 4 KiB pages
+  if (vec_use_hugepages && size >= VEC_HUGE_PAGE_SIZE) {
+    align = VEC_HUGE_PAGE_SIZE;
+  }
+
+  if (posix_memalign(&ptr, align, size)) {
     return NULL;
-  } else {
-    return ptr;
   }
+
+  if (vec_use_hugepages) {
+    vec_advise_hugepages(ptr, size);
+  }
+  return ptr;
 }
 
 cf_t* srsran_vec_cf_malloc(uint32_t nsamples)
@@ -271,8 +327,8 @@ void* srsran_vec_realloc(void* ptr, uint32_t old_size, uint32_t new_size)
 #ifndef LV_HAVE_SSE
   return realloc(ptr, new_size);
 #else
-  void* new_ptr;
-  if (posix_memalign(&new_ptr, SRSRAN_SIMD_BIT_ALIGN, new_size)) {
+  void* new_ptr = srsran_vec_malloc(new_size);
+  if (new_ptr == NULL) {
     return NULL;
   } else {
     memcpy(new_ptr, ptr, old_size);
@@ -474,29 +530,29 @@ void srsran_vec_conj_cc(const cf_t* x, cf_t* y, const uint32_t len)
 // Used in scrambling complex
 void srsran_vec_prod_cfc(const cf_t* x, const float* y, cf_t* z, const uint32_t len)
 {
-  srsran_vec_prod_cfc_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_prod_cfc_simd)(x, y, z, len);
 }
 
 // Used in scrambling float
 void srsran_vec_prod_fff(const float* x, const float* y, float* z, const uint32_t len)
 {
-  srsran_vec_prod_fff_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_prod_fff_simd)(x, y, z, len);
 }
 
 void srsran_vec_prod_sss(const int16_t* x, const int16_t* y, int16_t* z, const uint32_t len)
 {
-  srsran_vec_prod_sss_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_prod_sss_simd)(x, y, z, len);
 }
 
 // Scrambling
 void srsran_vec_neg_sss(const int16_t* x, const int16_t* y, int16_t* z, const uint32_t len)
 {
-  srsran_vec_neg_sss_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_neg_sss_simd)(x, y, z, len);
 }
 
 void srsran_vec_neg_bbb(const int8_t* x, const int8_t* y, int8_t* z, const uint32_t len)
 {
-  srsran_vec_neg_bbb_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_neg_bbb_simd)(x, y, z, len);
 }
 
 void srsran_vec_neg_bb(const int8_t* x, int8_t* z, const uint32_t len)
@@ -509,7 +565,7 @@ void srsran_vec_neg_bb(const int8_t* x, int8_t* z, const uint32_t len)
 // CFO and OFDM processing
 void srsran_vec_prod_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len)
 {
-  srsran_vec_prod_ccc_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_prod_ccc_simd)(x, y, z, len);
 }
 
 void srsran_vec_prod_ccc_split(const float*   x_re,
@@ -520,13 +576,13 @@ void srsran_vec_prod_ccc_split(const float*   x_re,
                                float*         z_im,
                                const uint32_t len)
 {
-  srsran_vec_prod_ccc_split_simd(x_re, x_im, y_re, y_im, z_re, z_im, len);
+  SRSRAN_VEC_SIMD(srsran_vec_prod_ccc_split_simd)(x_re, x_im, y_re, y_im, z_re, z_im, len);
 }
 
 // PRACH, CHEST UL, etc.
 void srsran_vec_prod_conj_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len)
 {
-  srsran_vec_prod_conj_ccc_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_prod_conj_ccc_simd)(x, y, z, len);
 }
 
 //#define DIV_USE_VEC
@@ -534,41 +590,36 @@ void srsran_vec_prod_conj_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint3
 // Used in SSS
 void srsran_vec_div_ccc(const cf_t* x, const cf_t* y, cf_t* z, const uint32_t len)
 {
-  srsran_vec_div_ccc_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_div_ccc_simd)(x, y, z, len);
 }
 
 /* Complex division by float z=x/y */
 void srsran_vec_div_cfc(const cf_t* x, const float* y, cf_t* z, const uint32_t len)
 {
-  srsran_vec_div_cfc_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_div_cfc_simd)(x, y, z, len);
 }
 
 void srsran_vec_div_fff(const float* x, const float* y, float* z, const uint32_t len)
 {
-  srsran_vec_div_fff_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_div_fff_simd)(x, y, z, len);
 }
 
 // PSS. convolution
 cf_t srsran_vec_dot_prod_ccc(const cf_t* x, const cf_t* y, const uint32_t len)
 {
-  return srsran_vec_dot_prod_ccc_simd(x, y, len);
+  return SRSRAN_VEC_SIMD(srsran_vec_dot_prod_ccc_simd)(x, y, len);
 }
 
 // Convolution filter and in SSS search
 cf_t srsran_vec_dot_prod_cfc(const cf_t* x, const float* y, const uint32_t len)
 {
-  uint32_t i;
-  cf_t     res = 0;
-  for (i = 0; i < len; i++) {
-    res += x[i] * y[i];
-  }
-  return res;
+  return SRSRAN_VEC_SIMD(srsran_vec_dot_prod_cfc_simd)(x, y, len);
 }
 
 // SYNC
 cf_t srsran_vec_dot_prod_conj_ccc(const cf_t* x, const cf_t* y, const uint32_t len)
 {
-  return srsran_vec_dot_prod_conj_ccc_simd(x, y, len);
+  return SRSRAN_VEC_SIMD(srsran_vec_dot_prod_conj_ccc_simd)(x, y, len);
 }
 
 // PHICH
@@ -584,7 +635,7 @@ float srsran_vec_dot_prod_fff(const float* x, const float* y, const uint32_t len
 
 int32_t srsran_vec_dot_prod_sss(const int16_t* x, const int16_t* y, const uint32_t len)
 {
-  return srsran_vec_dot_prod_sss_simd(x, y, len);
+  return SRSRAN_VEC_SIMD(srsran_vec_dot_prod_sss_simd)(x, y, len);
 }
 
 float srsran_vec_avg_power_cf(const cf_t* x, const uint32_t len)
@@ -664,7 +715,7 @@ float srsran_vec_corr_ccc(const cf_t* x, cf_t* y, const uint32_t len)
 // PSS (disabled and using abs_square )
 void srsran_vec_abs_cf(const cf_t* x, float* abs, const uint32_t len)
 {
-  srsran_vec_abs_cf_simd(x, abs, len);
+  SRSRAN_VEC_SIMD(srsran_vec_abs_cf_simd)(x, abs, len);
 }
 
 void srsran_vec_abs_dB_cf(const cf_t* x, float default_value, float* abs, const uint32_t len)
@@ -702,23 +753,23 @@ void srsran_vec_arg_deg_cf(const cf_t* x, float default_value, float* arg, const
 // PRACH
 void srsran_vec_abs_square_cf(const cf_t* x, float* abs_square, const uint32_t len)
 {
-  srsran_vec_abs_square_cf_simd(x, abs_square, len);
+  SRSRAN_VEC_SIMD(srsran_vec_abs_square_cf_simd)(x, abs_square, len);
 }
 
 uint32_t srsran_vec_max_fi(const float* x, const uint32_t len)
 {
-  return srsran_vec_max_fi_simd(x, len);
+  return SRSRAN_VEC_SIMD(srsran_vec_max_fi_simd)(x, len);
 }
 
 uint32_t srsran_vec_max_abs_fi(const float* x, const uint32_t len)
 {
-  return srsran_vec_max_abs_fi_simd(x, len);
+  return SRSRAN_VEC_SIMD(srsran_vec_max_abs_fi_simd)(x, len);
 }
 
 // CP autocorr
 uint32_t srsran_vec_max_abs_ci(const cf_t* x, const uint32_t len)
 {
-  return srsran_vec_max_ci_simd(x, len);
+  return SRSRAN_VEC_SIMD(srsran_vec_max_ci_simd)(x, len);
 }
 
 void srsran_vec_quant_fs(const float*   in,
@@ -839,27 +890,32 @@ void srsran_vec_quant_sus(const int16_t* in,
 
 void srsran_vec_interleave(const cf_t* x, const cf_t* y, cf_t* z, const int len)
 {
-  srsran_vec_interleave_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_interleave_simd)(x, y, z, len);
 }
 
 void srsran_vec_interleave_add(const cf_t* x, const cf_t* y, cf_t* z, const int len)
 {
-  srsran_vec_interleave_add_simd(x, y, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_interleave_add_simd)(x, y, z, len);
 }
 
 cf_t srsran_vec_gen_sine(cf_t amplitude, float freq, cf_t* z, int len)
 {
-  return srsran_vec_gen_sine_simd(amplitude, freq, z, len);
+  return SRSRAN_VEC_SIMD(srsran_vec_gen_sine_simd)(amplitude, freq, z, len);
 }
 
 void srsran_vec_apply_cfo(const cf_t* x, float cfo, cf_t* z, int len)
 {
-  srsran_vec_apply_cfo_simd(x, cfo, z, len);
+  SRSRAN_VEC_SIMD(srsran_vec_apply_cfo_simd)(x, cfo, z, len);
+}
+
+cf_t srsran_vec_apply_cfo_phase(const cf_t* x, float cfo, cf_t phase, cf_t* z, int len)
+{
+  return SRSRAN_VEC_SIMD(srsran_vec_apply_cfo_phase_simd)(x, cfo, phase, z, len);
 }
 
 float srsran_vec_estimate_frequency(const cf_t* x, int len)
 {
-  return srsran_vec_estimate_frequency_simd(x, len);
+  return SRSRAN_VEC_SIMD(srsran_vec_estimate_frequency_simd)(x, len);
 }
 
 // TODO: implement with SIMD
@@ -189,6 +189,45 @@ void srsran_vec_sub_bbb_simd(const int8_t* x, const int8_t* y, int8_t* z, const
   }
 }
 
+void srsran_vec_sum_sat_bbb_simd(const int8_t* x, const int8_t* y, int8_t* z, const int8_t limit, const int len)
+{
+  int i = 0;
+#if SRSRAN_SIMD_B_SIZE
+  simd_b_t upper = srsran_simd_b_set1(limit);
+  simd_b_t lower = srsran_simd_b_set1(-limit);
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(y) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_B_SIZE + 1; i += SRSRAN_SIMD_B_SIZE) {
+      simd_b_t a = srsran_simd_b_load(&x[i]);
+      simd_b_t b = srsran_simd_b_load(&y[i]);
+
+      simd_b_t r = srsran_simd_b_min(srsran_simd_b_max(srsran_simd_b_add(a, b), lower), upper);
+
+      srsran_simd_b_store(&z[i], r);
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_B_SIZE + 1; i += SRSRAN_SIMD_B_SIZE) {
+      simd_b_t a = srsran_simd_b_loadu(&x[i]);
+      simd_b_t b = srsran_simd_b_loadu(&y[i]);
+
+      simd_b_t r = srsran_simd_b_min(srsran_simd_b_max(srsran_simd_b_add(a, b), lower), upper);
+
+      srsran_simd_b_storeu(&z[i], r);
+    }
+  }
+#endif /* SRSRAN_SIMD_B_SIZE */
+
+  for (; i < len; i++) {
+    int16_t tmp = (int16_t)x[i] + (int16_t)y[i];
+    if (tmp > limit) {
+      tmp = limit;
+    }
+    if (tmp < -limit) {
+      tmp = -limit;
+    }
+    z[i] = (int8_t)tmp;
+  }
+}
+
 void srsran_vec_prod_sss_simd(const int16_t* x, const int16_t* y, int16_t* z, const int len)
 {
   int i = 0;
@@ -407,26 +446,22 @@ void srsran_vec_convert_if_simd(const int16_t* x, float* z, const float scale, c
   int         i    = 0;
   const float gain = 1.0f / scale;
 
-#ifdef LV_HAVE_SSE
-  __m128 s = _mm_set1_ps(gain);
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE
+  simd_f_t s = srsran_simd_f_set1(gain);
   if (SRSRAN_IS_ALIGNED(z)) {
-    for (; i < len - 3; i += 4) {
-      __m64* ptr = (__m64*)&x[i];
-      __m128 fl  = _mm_cvtpi16_ps(*ptr);
-      __m128 v   = _mm_mul_ps(fl, s);
+    for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
+      simd_f_t v = srsran_simd_f_mul(srsran_simd_convert_loadu_s_f(&x[i]), s);
 
-      _mm_store_ps(&z[i], v);
+      srsran_simd_f_store(&z[i], v);
     }
   } else {
-    for (; i < len - 3; i += 4) {
-      __m64* ptr = (__m64*)&x[i];
-      __m128 fl  = _mm_cvtpi16_ps(*ptr);
-      __m128 v   = _mm_mul_ps(fl, s);
+    for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
+      simd_f_t v = srsran_simd_f_mul(srsran_simd_convert_loadu_s_f(&x[i]), s);
 
-      _mm_storeu_ps(&z[i], v);
+      srsran_simd_f_storeu(&z[i], v);
     }
   }
-#endif /* LV_HAVE_SSE */
+#endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
 
   for (; i < len; i++) {
     z[i] = ((float)x[i]) * gain;
@@ -555,10 +590,10 @@ void srsran_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, co
     }
   } else {
     for (; i < len - 16 + 1; i += 16) {
-      __m128 a = _mm_load_ps(&x[i]);
-      __m128 b = _mm_load_ps(&x[i + 1 * 4]);
-      __m128 c = _mm_load_ps(&x[i + 2 * 4]);
-      __m128 d = _mm_load_ps(&x[i + 3 * 4]);
+      __m128 a = _mm_loadu_ps(&x[i]);
+      __m128 b = _mm_loadu_ps(&x[i + 1 * 4]);
+      __m128 c = _mm_loadu_ps(&x[i + 2 * 4]);
+      __m128 d = _mm_loadu_ps(&x[i + 3 * 4]);
 
       __m128 sa = _mm_mul_ps(a, s);
       __m128 sb = _mm_mul_ps(b, s);
@@ -580,7 +615,18 @@ void srsran_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, co
 #endif
 
 #ifdef HAVE_NEON
-#pragma message "srsran_vec_convert_fb_simd not implemented in neon"
+  float32x4_t s = vdupq_n_f32(scale);
+  for (; i < len - 16 + 1; i += 16) {
+    int32x4_t a = vcvtq_s32_f32(vmulq_f32(vld1q_f32(&x[i]), s));
+    int32x4_t b = vcvtq_s32_f32(vmulq_f32(vld1q_f32(&x[i + 1 * 4]), s));
+    int32x4_t c = vcvtq_s32_f32(vmulq_f32(vld1q_f32(&x[i + 2 * 4]), s));
+    int32x4_t d = vcvtq_s32_f32(vmulq_f32(vld1q_f32(&x[i + 3 * 4]), s));
+
+    int16x8_t ab = vcombine_s16(vqmovn_s32(a), vqmovn_s32(b));
+    int16x8_t cd = vcombine_s16(vqmovn_s32(c), vqmovn_s32(d));
+
+    vst1q_s8(&z[i], vcombine_s8(vqmovn_s16(ab), vqmovn_s16(cd)));
+  }
 #endif /* HAVE_NEON */
 
   for (; i < len; i++) {
@@ -796,6 +842,47 @@ cf_t srsran_vec_dot_prod_ccc_simd(const cf_t* x, const cf_t* y, const int len)
   return result;
 }
 
+cf_t srsran_vec_dot_prod_cfc_simd(const cf_t* x, const float* y, const int len)
+{
+  int  i      = 0;
+  cf_t result = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  if (len >= SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t simd_result = srsran_simd_cf_zero();
+    if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(y)) {
+      for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t xVal = srsran_simd_cfi_load(&x[i]);
+        simd_f_t  yVal = srsran_simd_f_load(&y[i]);
+
+        simd_result = srsran_simd_cf_add(srsran_simd_cf_mul(xVal, yVal), simd_result);
+      }
+    } else {
+      for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t xVal = srsran_simd_cfi_loadu(&x[i]);
+        simd_f_t  yVal = srsran_simd_f_loadu(&y[i]);
+
+        simd_result = srsran_simd_cf_add(srsran_simd_cf_mul(xVal, yVal), simd_result);
+      }
+    }
+
+    __attribute__((aligned(64))) float simd_re[SRSRAN_SIMD_CF_SIZE];
+    __attribute__((aligned(64))) float simd_im[SRSRAN_SIMD_CF_SIZE];
+    srsran_simd_cf_store(simd_re, simd_im, simd_result);
+    for (int j = 0; j < SRSRAN_SIMD_CF_SIZE; j++) {
+      __real__ result += simd_re[j];
+      __imag__ result += simd_im[j];
+    }
+  }
+#endif
+
+  for (; i < len; i++) {
+    result += x[i] * y[i];
+  }
+
+  return result;
+}
+
 #ifdef ENABLE_C16
 c16_t srsran_vec_dot_prod_ccc_c16i_simd(const c16_t* x, const c16_t* y, const int len)
 {
@@ -1587,37 +1674,33 @@ uint32_t srsran_vec_max_ci_simd(const cf_t* x, const int len)
 
 void srsran_vec_interleave_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len)
 {
-  uint32_t i = 0, k = 0;
+  int i = 0, k = 0;
 
-#ifdef LV_HAVE_SSE
+#if SRSRAN_SIMD_F_SIZE
   if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(y) && SRSRAN_IS_ALIGNED(z)) {
-    for (; i < len - 2 + 1; i += 2) {
-      __m128i a = _mm_load_si128((__m128i*)&x[i]);
-      __m128i b = _mm_load_si128((__m128i*)&y[i]);
+    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
+      simd_f_t a = srsran_simd_f_load((float*)&x[i]);
+      simd_f_t b = srsran_simd_f_load((float*)&y[i]);
 
-      __m128i r1 = _mm_unpacklo_epi64(a, b);
-      _mm_store_si128((__m128i*)&z[k], r1);
-      k += 2;
+      srsran_simd_f_store((float*)&z[k], srsran_simd_f_interleave_low(a, b));
+      k += SRSRAN_SIMD_F_SIZE / 2;
 
-      __m128i r2 = _mm_unpackhi_epi64(a, b);
-      _mm_store_si128((__m128i*)&z[k], r2);
-      k += 2;
+      srsran_simd_f_store((float*)&z[k], srsran_simd_f_interleave_high(a, b));
+      k += SRSRAN_SIMD_F_SIZE / 2;
     }
   } else {
-    for (; i < len - 2 + 1; i += 2) {
-      __m128i a = _mm_loadu_si128((__m128i*)&x[i]);
-      __m128i b = _mm_loadu_si128((__m128i*)&y[i]);
+    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
+      simd_f_t a = srsran_simd_f_loadu((float*)&x[i]);
+      simd_f_t b = srsran_simd_f_loadu((float*)&y[i]);
 
-      __m128i r1 = _mm_unpacklo_epi64(a, b);
-      _mm_storeu_si128((__m128i*)&z[k], r1);
-      k += 2;
+      srsran_simd_f_storeu((float*)&z[k], srsran_simd_f_interleave_low(a, b));
+      k += SRSRAN_SIMD_F_SIZE / 2;
 
-      __m128i r2 = _mm_unpackhi_epi64(a, b);
-      _mm_storeu_si128((__m128i*)&z[k], r2);
-      k += 2;
+      srsran_simd_f_storeu((float*)&z[k], srsran_simd_f_interleave_high(a, b));
+      k += SRSRAN_SIMD_F_SIZE / 2;
     }
   }
-#endif /* LV_HAVE_SSE */
+#endif /* SRSRAN_SIMD_F_SIZE */
 
   for (; i < len; i++) {
     z[k++] = x[i];
@@ -1627,45 +1710,37 @@ void srsran_vec_interleave_simd(const cf_t* x, const cf_t* y, cf_t* z, const int
 
 void srsran_vec_interleave_add_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len)
 {
-  uint32_t i = 0, k = 0;
+  int i = 0, k = 0;
 
-#ifdef LV_HAVE_SSE
+#if SRSRAN_SIMD_F_SIZE
   if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(y) && SRSRAN_IS_ALIGNED(z)) {
-    for (; i < len - 2 + 1; i += 2) {
-      __m128i a = _mm_load_si128((__m128i*)&x[i]);
-      __m128i b = _mm_load_si128((__m128i*)&y[i]);
-
-      __m128 r1 = (__m128)_mm_unpacklo_epi64(a, b);
-      __m128 z1 = _mm_load_ps((float*)&z[k]);
-      r1        = _mm_add_ps((__m128)r1, z1);
-      _mm_store_ps((float*)&z[k], r1);
-      k += 2;
-
-      __m128 r2 = (__m128)_mm_unpackhi_epi64(a, b);
-      __m128 z2 = _mm_load_ps((float*)&z[k]);
-      r2        = _mm_add_ps((__m128)r2, z2);
-      _mm_store_ps((float*)&z[k], r2);
-      k += 2;
+    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
+      simd_f_t a = srsran_simd_f_load((float*)&x[i]);
+      simd_f_t b = srsran_simd_f_load((float*)&y[i]);
+
+      simd_f_t r1 = srsran_simd_f_add(srsran_simd_f_interleave_low(a, b), srsran_simd_f_load((float*)&z[k]));
+      srsran_simd_f_store((float*)&z[k], r1);
+      k += SRSRAN_SIMD_F_SIZE / 2;
+
+      simd_f_t r2 = srsran_simd_f_add(srsran_simd_f_interleave_high(a, b), srsran_simd_f_load((float*)&z[k]));
+      srsran_simd_f_store((float*)&z[k], r2);
+      k += SRSRAN_SIMD_F_SIZE / 2;
     }
   } else {
-    for (; i < len - 2 + 1; i += 2) {
-      __m128i a = _mm_loadu_si128((__m128i*)&x[i]);
-      __m128i b = _mm_loadu_si128((__m128i*)&y[i]);
+    for (; i < len - SRSRAN_SIMD_F_SIZE / 2 + 1; i += SRSRAN_SIMD_F_SIZE / 2) {
+      simd_f_t a = srsran_simd_f_loadu((float*)&x[i]);
+      simd_f_t b = srsran_simd_f_loadu((float*)&y[i]);
 
-      __m128 r1 = (__m128)_mm_unpacklo_epi64(a, b);
-      __m128 z1 = _mm_loadu_ps((float*)&z[k]);
-      r1        = _mm_add_ps((__m128)r1, z1);
-      _mm_storeu_ps((float*)&z[k], r1);
-      k += 2;
+      simd_f_t r1 = srsran_simd_f_add(srsran_simd_f_interleave_low(a, b), srsran_simd_f_loadu((float*)&z[k]));
+      srsran_simd_f_storeu((float*)&z[k], r1);
+      k += SRSRAN_SIMD_F_SIZE / 2;
 
-      __m128 r2 = (__m128)_mm_unpackhi_epi64(a, b);
-      __m128 z2 = _mm_loadu_ps((float*)&z[k]);
-      r2        = _mm_add_ps((__m128)r2, z2);
-      _mm_storeu_ps((float*)&z[k], r2);
-      k += 2;
+      simd_f_t r2 = srsran_simd_f_add(srsran_simd_f_interleave_high(a, b), srsran_simd_f_loadu((float*)&z[k]));
+      srsran_simd_f_storeu((float*)&z[k], r2);
+      k += SRSRAN_SIMD_F_SIZE / 2;
     }
   }
-#endif /* LV_HAVE_SSE */
+#endif /* SRSRAN_SIMD_F_SIZE */
 
   for (; i < len; i++) {
     z[k++] += x[i];
@@ -1720,21 +1795,21 @@ cf_t srsran_vec_gen_sine_simd(cf_t amplitude, float freq, cf_t* z, int len)
   return phase;
 }
 
-void srsran_vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t* z, int len)
+static void vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t phase, cf_t* z, int len)
 {
   const float TWOPI = 2.0f * (float)M_PI;
   int         i     = 0;
   cf_t        osc   = cexpf(_Complex_I * TWOPI * cfo);
-  cf_t        phase = 1.0f;
 
 #if SRSRAN_SIMD_CF_SIZE
   // Load initial phases and oscillator
   srsran_simd_aligned cf_t _phase[SRSRAN_SIMD_CF_SIZE];
-  _phase[0] = phase;
-  for (int k = 1; k < SRSRAN_SIMD_CF_SIZE; k++) {
-    _phase[k] = _phase[k - 1] * osc;
+  cf_t                     osc_n = 1.0f;
+  for (int k = 0; k < SRSRAN_SIMD_CF_SIZE; k++) {
+    _phase[k] = phase * osc_n;
+    osc_n *= osc;
   }
-  simd_cf_t _simd_osc   = srsran_simd_cf_set1(_phase[SRSRAN_SIMD_CF_SIZE - 1] * osc);
+  simd_cf_t _simd_osc   = srsran_simd_cf_set1(osc_n);
   simd_cf_t _simd_phase = srsran_simd_cfi_load(_phase);
 
   if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
@@ -1773,6 +1848,31 @@ void srsran_vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t* z, int len)
   }
 }
 
+void srsran_vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t* z, int len)
+{
+  vec_apply_cfo_simd(x, cfo, 1.0f, z, len);
+}
+
+// Number of samples the recursive oscillator runs before it is re-seeded from a normalized phase
+#define VEC_CFO_NCO_BLOCK 512
+
+cf_t srsran_vec_apply_cfo_phase_simd(const cf_t* x, float cfo, cf_t phase, cf_t* z, int len)
+{
+  const float TWOPI     = 2.0f * (float)M_PI;
+  cf_t        block_osc = cexpf(_Complex_I * TWOPI * cfo * VEC_CFO_NCO_BLOCK);
+
+  for (int i = 0; i < len; i += VEC_CFO_NCO_BLOCK) {
+    int n = (len - i < VEC_CFO_NCO_BLOCK) ? (len - i) : VEC_CFO_NCO_BLOCK;
+
+    // Keep the oscillator on the unit circle, the recursive rotation drifts in amplitude over long buffers
+    phase /= cabsf(phase);
+    vec_apply_cfo_simd(&x[i], cfo, phase, &z[i], n);
+    phase *= (n == VEC_CFO_NCO_BLOCK) ? block_osc : cexpf(_Complex_I * TWOPI * cfo * n);
+  }
+
+  return phase / cabsf(phase);
+}
+
 float srsran_vec_estimate_frequency_simd(const cf_t* x, int len)
 {
   cf_t sum = 0.0f;
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * AVX-512 build of the vector_simd.c kernels for ENABLE_SIMD_DISPATCH builds, compiled with the AVX-512 flags while
+ * the rest of the library targets the baseline instruction set. Every kernel gets an _avx512 suffix, so both versions
+ * can be linked together and selected at run time by vector_simd_dispatch.c.
+ */
+
+#ifdef SRSRAN_SIMD_DISPATCH_AVX512
+
+#ifndef LV_HAVE_AVX512
+#error "vector_simd_avx512.c must be compiled with the AVX-512 flags"
+#endif // LV_HAVE_AVX512
+
+#define srsran_vec_abs_cf_simd srsran_vec_abs_cf_simd_avx512
+#define srsran_vec_abs_square_cf_simd srsran_vec_abs_square_cf_simd_avx512
+#define srsran_vec_acc_cc_simd srsran_vec_acc_cc_simd_avx512
+#define srsran_vec_acc_ff_simd srsran_vec_acc_ff_simd_avx512
+#define srsran_vec_add_fff_simd srsran_vec_add_fff_simd_avx512
+#define srsran_vec_apply_cfo_phase_simd srsran_vec_apply_cfo_phase_simd_avx512
+#define srsran_vec_apply_cfo_simd srsran_vec_apply_cfo_simd_avx512
+#define srsran_vec_convert_conj_cs_simd srsran_vec_convert_conj_cs_simd_avx512
+#define srsran_vec_convert_fb_simd srsran_vec_convert_fb_simd_avx512
+#define srsran_vec_convert_fi_simd srsran_vec_convert_fi_simd_avx512
+#define srsran_vec_convert_if_simd srsran_vec_convert_if_simd_avx512
+#define srsran_vec_div_ccc_simd srsran_vec_div_ccc_simd_avx512
+#define srsran_vec_div_cfc_simd srsran_vec_div_cfc_simd_avx512
+#define srsran_vec_div_fff_simd srsran_vec_div_fff_simd_avx512
+#define srsran_vec_dot_prod_ccc_simd srsran_vec_dot_prod_ccc_simd_avx512
+#define srsran_vec_dot_prod_cfc_simd srsran_vec_dot_prod_cfc_simd_avx512
+#define srsran_vec_dot_prod_conj_ccc_simd srsran_vec_dot_prod_conj_ccc_simd_avx512
+#define srsran_vec_dot_prod_sss_simd srsran_vec_dot_prod_sss_simd_avx512
+#define srsran_vec_estimate_frequency_simd srsran_vec_estimate_frequency_simd_avx512
+#define srsran_vec_gen_sine_simd srsran_vec_gen_sine_simd_avx512
+#define srsran_vec_interleave_add_simd srsran_vec_interleave_add_simd_avx512
+#define srsran_vec_interleave_simd srsran_vec_interleave_simd_avx512
+#define srsran_vec_lut_bbb_simd srsran_vec_lut_bbb_simd_avx512
+#define srsran_vec_lut_sss_simd srsran_vec_lut_sss_simd_avx512
+#define srsran_vec_max_abs_fi_simd srsran_vec_max_abs_fi_simd_avx512
+#define srsran_vec_max_ci_simd srsran_vec_max_ci_simd_avx512
+#define srsran_vec_max_fi_simd srsran_vec_max_fi_simd_avx512
+#define srsran_vec_neg_bbb_simd srsran_vec_neg_bbb_simd_avx512
+#define srsran_vec_neg_sss_simd srsran_vec_neg_sss_simd_avx512
+#define srsran_vec_prod_ccc_simd srsran_vec_prod_ccc_simd_avx512
+#define srsran_vec_prod_ccc_split_simd srsran_vec_prod_ccc_split_simd_avx512
+#define srsran_vec_prod_cfc_simd srsran_vec_prod_cfc_simd_avx512
+#define srsran_vec_prod_conj_ccc_simd srsran_vec_prod_conj_ccc_simd_avx512
+#define srsran_vec_prod_fff_simd srsran_vec_prod_fff_simd_avx512
+#define srsran_vec_prod_sss_simd srsran_vec_prod_sss_simd_avx512
+#define srsran_vec_sc_prod_ccc_simd srsran_vec_sc_prod_ccc_simd_avx512
+#define srsran_vec_sc_prod_ccc_simd2 srsran_vec_sc_prod_ccc_simd2_avx512
+#define srsran_vec_sc_prod_cfc_simd srsran_vec_sc_prod_cfc_simd_avx512
+#define srsran_vec_sc_prod_fcc_simd srsran_vec_sc_prod_fcc_simd_avx512
+#define srsran_vec_sc_prod_fff_simd srsran_vec_sc_prod_fff_simd_avx512
+#define srsran_vec_sc_sum_fff_simd srsran_vec_sc_sum_fff_simd_avx512
+#define srsran_vec_sub_bbb_simd srsran_vec_sub_bbb_simd_avx512
+#define srsran_vec_sub_fff_simd srsran_vec_sub_fff_simd_avx512
+#define srsran_vec_sub_sss_simd srsran_vec_sub_sss_simd_avx512
+#define srsran_vec_sum_sat_bbb_simd srsran_vec_sum_sat_bbb_simd_avx512
+#define srsran_vec_sum_sss_simd srsran_vec_sum_sss_simd_avx512
+#define srsran_vec_xor_bbb_simd srsran_vec_xor_bbb_simd_avx512
+
+#include "vector_simd.c"
+
+#endif // SRSRAN_SIMD_DISPATCH_AVX512
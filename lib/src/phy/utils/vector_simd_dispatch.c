@@ -0,0 +1,45 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "vector_simd_dispatch.h"
+
+#ifdef SRSRAN_SIMD_DISPATCH_AVX512
+
+#include "srsran/phy/utils/cpu_features.h"
+
+#define VEC_SIMD_DECLARE_AVX512(FUNC) extern __typeof__(FUNC) FUNC##_avx512;
+SRSRAN_VEC_SIMD_KERNELS(VEC_SIMD_DECLARE_AVX512)
+
+#define VEC_SIMD_INIT_BASELINE(FUNC) .FUNC = FUNC,
+srsran_vec_simd_table_t srsran_vec_simd_table = {SRSRAN_VEC_SIMD_KERNELS(VEC_SIMD_INIT_BASELINE)};
+
+/* The table is valid before this runs, so other constructors can call srsran_vec_*() in any order */
+__attribute__((constructor)) static void srsran_vec_simd_dispatch(void)
+{
+  if (!srsran_cpu_has(SRSRAN_CPU_AVX512)) {
+    return;
+  }
+
+#define VEC_SIMD_SELECT_AVX512(FUNC) srsran_vec_simd_table.FUNC = FUNC##_avx512;
+  SRSRAN_VEC_SIMD_KERNELS(VEC_SIMD_SELECT_AVX512)
+}
+
+#endif // SRSRAN_SIMD_DISPATCH_AVX512
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Run-time selection of the srsran_vec_*_simd() kernels. In ENABLE_SIMD_DISPATCH builds vector_simd.c is compiled
+ * twice, for the baseline instruction set and for AVX-512 (vector_simd_avx512.c, with an _avx512 suffix), and the
+ * srsran_vec_*() functions call the kernels through a table that points to the AVX-512 versions when the CPU supports
+ * them. Otherwise SRSRAN_VEC_SIMD() is a direct call to the only version built.
+ */
+
+#ifndef SRSRAN_VECTOR_SIMD_DISPATCH_H
+#define SRSRAN_VECTOR_SIMD_DISPATCH_H
+
+#include "srsran/phy/utils/vector_simd.h"
+
+#ifdef SRSRAN_SIMD_DISPATCH_AVX512
+
+/* Kernels declared in vector_simd.h (but the ENABLE_C16 ones), the same list is renamed in vector_simd_avx512.c */
+#define SRSRAN_VEC_SIMD_KERNELS(X)                                                                                     \
+  X(srsran_vec_abs_cf_simd)                                                                                            \
+  X(srsran_vec_abs_square_cf_simd)                                                                                     \
+  X(srsran_vec_acc_cc_simd)                                                                                            \
+  X(srsran_vec_acc_ff_simd)                                                                                            \
+  X(srsran_vec_add_fff_simd)                                                                                           \
+  X(srsran_vec_apply_cfo_phase_simd)                                                                                   \
+  X(srsran_vec_apply_cfo_simd)                                                                                         \
+  X(srsran_vec_convert_conj_cs_simd)                                                                                   \
+  X(srsran_vec_convert_fb_simd)                                                                                        \
+  X(srsran_vec_convert_fi_simd)                                                                                        \
+  X(srsran_vec_convert_if_simd)                                                                                        \
+  X(srsran_vec_div_ccc_simd)                                                                                           \
+  X(srsran_vec_div_cfc_simd)                                                                                           \
+  X(srsran_vec_div_fff_simd)                                                                                           \
+  X(srsran_vec_dot_prod_ccc_simd)                                                                                      \
+  X(srsran_vec_dot_prod_cfc_simd)                                                                                      \
+  X(srsran_vec_dot_prod_conj_ccc_simd)                                                                                 \
+  X(srsran_vec_dot_prod_sss_simd)                                                                                      \
+  X(srsran_vec_estimate_frequency_simd)                                                                                \
+  X(srsran_vec_gen_sine_simd)                                                                                          \
+  X(srsran_vec_interleave_add_simd)                                                                                    \
+  X(srsran_vec_interleave_simd)                                                                                        \
+  X(srsran_vec_lut_bbb_simd)                                                                                           \
+  X(srsran_vec_lut_sss_simd)                                                                                           \
+  X(srsran_vec_max_abs_fi_simd)                                                                                        \
+  X(srsran_vec_max_ci_simd)                                                                                            \
+  X(srsran_vec_max_fi_simd)                                                                                            \
+  X(srsran_vec_neg_bbb_simd)                                                                                           \
+  X(srsran_vec_neg_sss_simd)                                                                                           \
+  X(srsran_vec_prod_ccc_simd)                                                                                          \
+  X(srsran_vec_prod_ccc_split_simd)                                                                                    \
+  X(srsran_vec_prod_cfc_simd)                                                                                          \
+  X(srsran_vec_prod_conj_ccc_simd)                                                                                     \
+  X(srsran_vec_prod_fff_simd)                                                                                          \
+  X(srsran_vec_prod_sss_simd)                                                                                          \
+  X(srsran_vec_sc_prod_ccc_simd)                                                                                       \
+  X(srsran_vec_sc_prod_ccc_simd2)                                                                                      \
+  X(srsran_vec_sc_prod_cfc_simd)                                                                                       \
+  X(srsran_vec_sc_prod_fcc_simd)                                                                                       \
+  X(srsran_vec_sc_prod_fff_simd)                                                                                       \
+  X(srsran_vec_sc_sum_fff_simd)                                                                                        \
+  X(srsran_vec_sub_bbb_simd)                                                                                           \
+  X(srsran_vec_sub_fff_simd)                                                                                           \
+  X(srsran_vec_sub_sss_simd)                                                                                           \
+  X(srsran_vec_sum_sat_bbb_simd)                                                                                       \
+  X(srsran_vec_sum_sss_simd)                                                                                           \
+  X(srsran_vec_xor_bbb_simd)
+
+#define SRSRAN_VEC_SIMD_POINTER(FUNC) __typeof__(FUNC)* FUNC;
+
+typedef struct {
+  SRSRAN_VEC_SIMD_KERNELS(SRSRAN_VEC_SIMD_POINTER)
+} srsran_vec_simd_table_t;
+
+/* Filled with the baseline kernels at load time and switched once, when the library is loaded, after CPUID */
+extern srsran_vec_simd_table_t srsran_vec_simd_table;
+
+#define SRSRAN_VEC_SIMD(FUNC) (srsran_vec_simd_table.FUNC)
+
+#else // SRSRAN_SIMD_DISPATCH_AVX512
+
+#define SRSRAN_VEC_SIMD(FUNC) FUNC
+
+#endif // SRSRAN_SIMD_DISPATCH_AVX512
+
+#endif // SRSRAN_VECTOR_SIMD_DISPATCH_H
@@ -22,8 +22,10 @@
 #include "srsran/radio/radio.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/string_helpers.h"
+#include "srsran/common/tti_trace.h"
 #include "srsran/config.h"
 #include "srsran/support/srsran_assert.h"
+#include <chrono>
 #include <list>
 #include <string>
 #include <unistd.h>
@@ -47,6 +49,14 @@ radio::~radio()
   for (srsran_resampler_fft_t& q : decimators) {
     srsran_resampler_fft_free(&q);
   }
+
+  for (srsran_resample_poly_t& q : tx_resamplers) {
+    srsran_resample_poly_free(&q);
+  }
+
+  for (srsran_resample_poly_t& q : rx_resamplers) {
+    srsran_resample_poly_free(&q);
+  }
 }
 
 int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
@@ -107,6 +117,8 @@ int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
   rf_devices.resize(device_args_list.size());
   rf_info.resize(device_args_list.size());
   rx_offset_n.resize(device_args_list.size());
+  rx_next_time.resize(device_args_list.size());
+  rf_metrics.dev.resize(device_args_list.size());
 
   tx_channel_mapping.set_config(nof_channels_x_dev, nof_antennas);
   rx_channel_mapping.set_config(nof_channels_x_dev, nof_antennas);
@@ -138,6 +150,22 @@ int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
     }
   }
 
+  // Staging buffers for merging consecutive transmissions, they hold tx_coalesce_max_sf subframes of the largest size
+  tx_coalesce_max_sf = args.tx_coalesce_max_sf;
+  if (tx_coalesce_max_sf > 0) {
+    tx_coalesce.resize(rf_devices.size());
+    for (tx_coalesce_t& q : tx_coalesce) {
+      for (uint32_t ch = 0; ch < nof_channels_x_dev; ch++) {
+        q.buffers[ch].resize((size_t)tx_coalesce_max_sf * SRSRAN_SF_LEN_MAX);
+      }
+    }
+  }
+
+  // Every device but the first, which is received by the caller, gets its own reception thread
+  for (uint32_t device_idx = 1; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
+    rx_threads.emplace_back(new rx_dev_thread(this, device_idx));
+  }
+
   is_start_of_burst = true;
   is_initialized    = true;
 
@@ -222,6 +250,21 @@ int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
   // Frequency offset
   freq_offset = args.freq_offset;
 
+  // Host side front-end impairments correction
+  rx_correction_enable = args.rx_dc_correction or args.rx_iq_correction or args.rx_digital_agc;
+  if (rx_correction_enable) {
+    srsran_rx_correction_cfg_t rx_correction_cfg = {};
+    rx_correction_cfg.dc_enable                  = args.rx_dc_correction;
+    rx_correction_cfg.iq_enable                  = args.rx_iq_correction;
+    rx_correction_cfg.agc_enable                 = args.rx_digital_agc;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      if (srsran_rx_correction_init(&rx_corrections[ch], &rx_correction_cfg) < SRSRAN_SUCCESS) {
+        logger.error("Error initialising the Rx correction of channel %d", ch);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -232,6 +275,14 @@ bool radio::is_init()
 
 void radio::stop()
 {
+  // The reception threads are idle unless rx_now() is running, which holds the Rx mutex
+  {
+    std::lock_guard<std::mutex> lock(rx_mutex);
+    for (auto& t : rx_threads) {
+      t->stop();
+    }
+  }
+
   // Stop Rx streams as soon as possible to avoid Overflows
   if (radio_is_streaming) {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -289,31 +340,50 @@ bool radio::start_agc(bool tx_gain_same_rx)
 
 bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time)
 {
+  srsran::tti_trace_scope      trace_scope(srsran::tti_trace_event::radio_rx, buffer.get_nof_samples());
   std::unique_lock<std::mutex> lock(rx_mutex);
   bool                         ret = true;
   rf_buffer_t                  buffer_rx;
 
   // Extract decimation ratio. As the decimation may take some time to set a new ratio, deactivate the decimation and
   // keep receiving samples to avoid stalling the RX stream
-  uint32_t ratio = 1; // No decimation by default
+  uint32_t ratio    = 1; // No decimation by default
+  bool     rational = false;
   if (decimator_busy) {
     lock.unlock();
   } else if (decimators[0].ratio > 1) {
     ratio = decimators[0].ratio;
+  } else if (rx_resamplers[0].interp > 0) {
+    rational = true;
+  }
+  bool resample = ratio > 1 or rational;
+
+  // The sc16 samples are passed through as they are received
+  if (buffer.is_sc16() and resample) {
+    logger.error("The sc16 sample format does not support resampling");
+    return false;
   }
 
   // Calculate number of samples, considering the decimation ratio
   uint32_t nof_samples = buffer.get_nof_samples() * ratio;
+  if (rational) {
+    nof_samples = srsran_resample_poly_get_nof_in(&rx_resamplers[0], buffer.get_nof_samples());
+
+    // When resampling up, the last sample may produce more samples than requested, leave it for the next call
+    if (srsran_resample_poly_get_nof_out(&rx_resamplers[0], nof_samples) > buffer.get_nof_samples()) {
+      nof_samples--;
+    }
+  }
 
   // Check decimation buffer protection
-  if (ratio > 1 && nof_samples > rx_buffer[0].size()) {
+  if (resample && nof_samples > rx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Rx number of samples ({}/{}) exceeds buffer size ({})",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_samples,
                    rx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
@@ -321,13 +391,14 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
     nof_samples = rx_buffer[0].size();
   }
 
-  // Set new buffer size
+  // Set new buffer size and format
   buffer_rx.set_nof_samples(nof_samples);
+  buffer_rx.set_sc16(buffer.is_sc16());
 
   // If the interpolator have been set, interpolate
   for (uint32_t ch = 0; ch < nof_channels; ch++) {
     // Use rx buffer if decimator is required
-    buffer_rx.set(ch, ratio > 1 ? rx_buffer[ch].data() : buffer.get(ch));
+    buffer_rx.set(ch, resample ? rx_buffer[ch].data() : buffer.get(ch));
   }
 
   if (not radio_is_streaming) {
@@ -341,11 +412,44 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
       for (srsran_rf_t& rf_device : rf_devices) {
         srsran_rf_flush_buffer(&rf_device);
       }
+      rx_align_pending = true;
+    }
+
+    // The stream restarts, so its timestamps do not follow the previous ones
+    for (rx_next_time_t& t : rx_next_time) {
+      t = {};
     }
   }
 
-  for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
-    ret &= rx_dev(device_idx, buffer_rx, rxd_time.get_ptr(device_idx));
+  // Receive all the devices at the same time, the first one in this thread
+  for (uint32_t device_idx = 1; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
+    rx_threads[device_idx - 1]->start_rx(buffer_rx, rxd_time.get_ptr(device_idx));
+  }
+  ret &= rx_dev(0, buffer_rx, rxd_time.get_ptr(0));
+  for (auto& t : rx_threads) {
+    ret &= t->wait_rx();
+  }
+
+  // Once all the devices have been received, compare their timestamps
+  if (rx_align_pending and ret) {
+    align_rx_devices(rxd_time);
+    rx_align_pending = false;
+  }
+
+  // The last received sample gives the current time to the transmission deadline metrics and to the transmission
+  // coalescing, which sends the staged samples that would miss their deadline waiting for more buffers
+  if (ret and std::isnormal(cur_rx_srate)) {
+    rx_time_now = srsran_timestamp_real(rxd_time.get_ptr(0)) + nof_samples / cur_rx_srate;
+  }
+  if (tx_coalesce_max_sf > 0 and ret and std::isnormal(cur_rx_srate)) {
+    std::unique_lock<std::mutex> tx_lock(tx_mutex, std::try_to_lock);
+    if (tx_lock.owns_lock()) {
+      for (uint32_t device_idx = 0; device_idx < (uint32_t)tx_coalesce.size(); device_idx++) {
+        if (tx_coalesce[device_idx].nof_samples > 0 and tx_coalesce_margin(device_idx) < tx_coalesce_margin_sec) {
+          tx_coalesce_flush(device_idx);
+        }
+      }
+    }
   }
 
   // Perform decimation
@@ -355,6 +459,29 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
         srsran_resampler_fft_run(&decimators[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
       }
     }
+  } else if (rational) {
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      // Resample every channel, even without destination, for all the resamplers to keep the same state
+      int n = srsran_resample_poly_run(&rx_resamplers[ch], buffer_rx.get(ch), buffer.get(ch), nof_samples);
+
+      // Fill the samples the receive buffer protection left out with zeros
+      if (buffer.get(ch) and n >= 0 and (uint32_t)n < buffer.get_nof_samples()) {
+        srsran_vec_cf_zero(&buffer.get(ch)[n], buffer.get_nof_samples() - n);
+      }
+    }
+  }
+
+  // Correct the front-end impairments before the samples reach the PHY
+  if (rx_correction_enable and not buffer.is_sc16()) {
+    bool reset = rx_correction_reset_pending.exchange(false);
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      if (reset) {
+        srsran_rx_correction_reset(&rx_corrections[ch]);
+      }
+      if (buffer.get(ch)) {
+        srsran_rx_correction_run(&rx_corrections[ch], buffer.get(ch), buffer.get(ch), buffer.get_nof_samples());
+      }
+    }
   }
 
   return ret;
@@ -369,11 +496,16 @@ bool radio::rx_dev(const uint32_t& device_idx, const rf_buffer_interface& buffer
   time_t* full_secs = rxd_time ? &rxd_time->full_secs : nullptr;
   double* frac_secs = rxd_time ? &rxd_time->frac_secs : nullptr;
 
+  if (buffer.is_sc16() != rf_info.at(device_idx).sc16) {
+    logger.error("Rx buffer sample format does not match the RF device format");
+    return false;
+  }
+
   void* radio_buffers[SRSRAN_MAX_CHANNELS] = {};
 
-  // Discard channels not allocated, need to point to valid buffer
-  for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
-    radio_buffers[i] = dummy_buffers[i].data();
+  // Discard channels not allocated, need to point to valid buffer. Every device has its own, as they receive at once
+  for (uint32_t i = 0; i < nof_channels_x_dev; i++) {
+    radio_buffers[i] = dummy_buffers[device_idx * nof_channels_x_dev + i].data();
   }
 
   if (not map_channels(rx_channel_mapping, device_idx, 0, buffer, radio_buffers)) {
@@ -397,8 +529,34 @@ bool radio::rx_dev(const uint32_t& device_idx, const rf_buffer_interface& buffer
   // Subtract number of offset samples
   rx_offset_n.at(device_idx) = nof_samples_offset - ((int)nof_samples - (int)buffer.get_nof_samples());
 
-  int ret =
+  auto t_start = std::chrono::steady_clock::now();
+  int  ret =
       srsran_rf_recv_with_time_multi(&rf_devices[device_idx], radio_buffers, nof_samples, true, full_secs, frac_secs);
+  auto t_end = std::chrono::steady_clock::now();
+
+  // Compare the timestamp with the end of the previous reception of the device
+  int64_t gap_nsamples = 0;
+  if (rxd_time != nullptr and ret > 0 and std::isnormal(cur_rx_srate)) {
+    rx_next_time_t& next = rx_next_time[device_idx];
+    if (next.srate == cur_rx_srate) {
+      srsran_timestamp_t ts_gap = *rxd_time;
+      srsran_timestamp_sub(&ts_gap, next.time.full_secs, next.time.frac_secs);
+      gap_nsamples = (int64_t)round(cur_rx_srate * srsran_timestamp_real(&ts_gap));
+    }
+    next.time  = *rxd_time;
+    next.srate = cur_rx_srate;
+    srsran_timestamp_add(&next.time, 0, (double)nof_samples / cur_rx_srate);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    rf_dev_metrics_t&           m = rf_metrics.dev[device_idx];
+    m.rx_call.add(std::chrono::duration_cast<std::chrono::microseconds>(t_end - t_start).count());
+    if (gap_nsamples != 0) {
+      m.rx_gaps++;
+      m.rx_gap_samples += gap_nsamples;
+    }
+  }
 
   // If the number of received samples filled the buffer, there is nothing else to do
   if (buffer.get_nof_samples() <= nof_samples) {
@@ -409,37 +567,175 @@ bool radio::rx_dev(const uint32_t& device_idx, const rf_buffer_interface& buffer
   uint32_t nof_zeros = buffer.get_nof_samples() - nof_samples;
   for (auto& b : radio_buffers) {
     if (b != nullptr) {
-      cf_t* ptr = (cf_t*)b;
-      srsran_vec_cf_zero(&ptr[nof_samples], nof_zeros);
+      if (buffer.is_sc16()) {
+        int16_t* ptr = (int16_t*)b;
+        srsran_vec_i16_zero(&ptr[2 * nof_samples], 2 * nof_zeros);
+      } else {
+        cf_t* ptr = (cf_t*)b;
+        srsran_vec_cf_zero(&ptr[nof_samples], nof_zeros);
+      }
     }
   }
 
   return ret > 0;
 }
 
+void radio::align_rx_devices(rf_timestamp_interface& rxd_time)
+{
+  // Find the newest timestamp, the other devices are behind it
+  uint32_t newest_idx = 0;
+  for (uint32_t device_idx = 1; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
+    if (srsran_timestamp_compare(&rxd_time[device_idx], &rxd_time[newest_idx]) > 0) {
+      newest_idx = device_idx;
+    }
+  }
+
+  for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
+    srsran_timestamp_t diff = rxd_time[newest_idx];
+    srsran_timestamp_sub(&diff, rxd_time[device_idx].full_secs, rxd_time[device_idx].frac_secs);
+    double diff_sec = srsran_timestamp_real(&diff);
+    if (diff_sec > rx_align_max_sec) {
+      logger.warning("RF device %d is %.1f ms behind device %d, the devices are not synchronised",
+                     device_idx,
+                     diff_sec * 1e3,
+                     newest_idx);
+      continue;
+    }
+
+    // Skip if it is aligned or the PHY has already set an offset
+    int32_t offset = (int32_t)round(diff_sec * cur_rx_srate);
+    if (offset == 0 or rx_offset_n[device_idx] != 0) {
+      continue;
+    }
+    logger.info("Aligning RF device %d with device %d, discarding %d samples", device_idx, newest_idx, offset);
+    rx_offset_n[device_idx] = offset;
+  }
+}
+
+radio::rx_dev_thread::rx_dev_thread(radio* parent_, uint32_t device_idx_) :
+  thread("RF_RX_DEV" + std::to_string(device_idx_)), parent(parent_), device_idx(device_idx_)
+{
+  running = true;
+  start(0);
+}
+
+radio::rx_dev_thread::~rx_dev_thread()
+{
+  stop();
+}
+
+void radio::rx_dev_thread::start_rx(const rf_buffer_interface& buffer, srsran_timestamp_t* rxd_time)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  rx_buffer = &buffer;
+  rx_time   = rxd_time;
+  rx_done   = false;
+  cvar.notify_all();
+}
+
+bool radio::rx_dev_thread::wait_rx()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (not rx_done and running) {
+    cvar.wait(lock);
+  }
+  rx_done = false;
+  return rx_result;
+}
+
+void radio::rx_dev_thread::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running   = false;
+    rx_result = false;
+    cvar.notify_all();
+  }
+  wait_thread_finish();
+}
+
+void radio::rx_dev_thread::run_thread()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (running) {
+    if (rx_buffer == nullptr) {
+      cvar.wait(lock);
+      continue;
+    }
+
+    // Receive without holding the lock
+    const rf_buffer_interface* buffer   = rx_buffer;
+    srsran_timestamp_t*        rxd_time = rx_time;
+    lock.unlock();
+    bool result = parent->rx_dev(device_idx, *buffer, rxd_time);
+    lock.lock();
+
+    rx_buffer = nullptr;
+    rx_result = result;
+    rx_done   = true;
+    cvar.notify_all();
+  }
+}
+
 bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time)
 {
+  srsran::tti_trace_scope      trace_scope(srsran::tti_trace_event::radio_tx, buffer.get_nof_samples());
   bool                         ret = true;
   std::unique_lock<std::mutex> lock(tx_mutex);
-  uint32_t                     ratio = interpolators[0].ratio;
+  uint32_t                     ratio    = interpolators[0].ratio;
+  bool                         rational = tx_resamplers[0].interp > 0;
+
+  // The sc16 samples are passed through as they are given
+  if (buffer.is_sc16() and (ratio > 1 or rational)) {
+    logger.error("The sc16 sample format does not support resampling");
+    return false;
+  }
 
   // Get number of samples at the low rate
   uint32_t nof_samples = buffer.get_nof_samples();
 
+  // Get number of samples at the device rate
+  size_t nof_interp_samples = (size_t)nof_samples * (size_t)ratio;
+  if (rational) {
+    nof_interp_samples = srsran_resample_poly_get_nof_out(&tx_resamplers[0], nof_samples);
+  }
+
   // Check that number of the interpolated samples does not exceed the buffer size
-  if (ratio > 1 && (size_t)nof_samples * (size_t)ratio > tx_buffer[0].size()) {
+  if ((ratio > 1 or rational) && nof_interp_samples > tx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Tx number of samples ({}/{}) exceeds buffer size ({})\n",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_interp_samples,
                    tx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
     // Limit number of samples to transmit
-    nof_samples = tx_buffer[0].size() / ratio;
+    if (rational) {
+      nof_samples = (uint32_t)((uint64_t)tx_buffer[0].size() * tx_resamplers[0].decim / tx_resamplers[0].interp);
+    } else {
+      nof_samples = tx_buffer[0].size() / ratio;
+    }
+  }
+
+  // If the fractional interpolators have been set, resample
+  if (rational) {
+    uint32_t nof_out = 0;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      int n = srsran_resample_poly_run(&tx_resamplers[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
+      nof_out = (uint32_t)SRSRAN_MAX(n, 0);
+
+      // Set the buffer pointer
+      buffer.set(ch, tx_buffer[ch].data());
+    }
+
+    // Set buffer size after applying the resampling
+    buffer.set_nof_samples(nof_out);
   }
 
   // If the interpolator have been set, interpolate
@@ -535,6 +831,11 @@ bool radio::tx_dev(const uint32_t& device_idx, rf_buffer_interface& buffer, cons
     return false;
   }
 
+  if (buffer.is_sc16() != rf_info.at(device_idx).sc16) {
+    logger.error("Tx buffer sample format does not match the RF device format");
+    return false;
+  }
+
   // Copy timestamp and add Tx time offset calibration
   srsran_timestamp_t tx_time = tx_time_;
   if (!tx_adv_negative) {
@@ -564,18 +865,33 @@ bool radio::tx_dev(const uint32_t& device_idx, rf_buffer_interface& buffer, cons
     tx_time       = end_of_burst_time[device_idx]; // Keeps same transmission time
     nof_samples   = nof_samples - past_nsamples;   // Subtracts the number of trimmed samples
 
+    {
+      std::lock_guard<std::mutex> lock(metrics_mutex);
+      rf_metrics.dev[device_idx].tx_overlaps++;
+    }
+
     // Prints discarded samples
     logger.debug("Detected RF overlap of %.1f us. Discarding %d samples.",
                  srsran_timestamp_real(&ts_overlap) * 1.0e6,
                  past_nsamples);
 
   } else if (past_nsamples < 0 and not is_start_of_burst) {
+    {
+      std::lock_guard<std::mutex> lock(metrics_mutex);
+      rf_metrics.dev[device_idx].tx_gaps++;
+    }
+
     // if the gap is bigger than TX_MAX_GAP_ZEROS, stop burst
     if (fabs(srsran_timestamp_real(&ts_overlap)) > tx_max_gap_zeros) {
       logger.info("Detected RF gap of %.1f us. Sending end-of-burst.", srsran_timestamp_real(&ts_overlap) * 1.0e6);
       tx_end_nolock();
     } else {
       logger.debug("Detected RF gap of %.1f us. Tx'ing zeroes.", srsran_timestamp_real(&ts_overlap) * 1.0e6);
+      // The zeros go after the staged samples
+      if (not tx_coalesce_flush(device_idx)) {
+        return false;
+      }
+
       // Otherwise, transmit zeros
       uint32_t gap_nsamples = abs(past_nsamples);
       while (gap_nsamples > 0) {
@@ -619,12 +935,120 @@ bool radio::tx_dev(const uint32_t& device_idx, rf_buffer_interface& buffer, cons
     return false;
   }
 
-  int ret = srsran_rf_send_timed_multi(
-      rf_device, radio_buffers, nof_samples, tx_time.full_secs, tx_time.frac_secs, true, is_start_of_burst, false);
+  return tx_dev_send(device_idx, radio_buffers, nof_samples, tx_time);
+}
+
+bool radio::tx_dev_send(const uint32_t&           device_idx,
+                        void**                    radio_buffers,
+                        uint32_t                  nof_samples,
+                        const srsran_timestamp_t& tx_time)
+{
+  // Send straight away if the coalescing is disabled or the buffer would not fit
+  if (tx_coalesce_max_sf == 0 or nof_samples > tx_coalesce[device_idx].buffers[0].size()) {
+    if (not tx_coalesce_flush(device_idx)) {
+      return false;
+    }
+    return tx_dev_send_timed(device_idx, radio_buffers, nof_samples, tx_time, is_start_of_burst);
+  }
+
+  tx_coalesce_t& q = tx_coalesce[device_idx];
+
+  // The staged samples are sent first if the new ones do not follow them or do not fit
+  if (q.nof_samples > 0) {
+    srsran_timestamp_t ts_gap = tx_time;
+    srsran_timestamp_sub(&ts_gap, q.tx_time.full_secs, q.tx_time.frac_secs);
+    int64_t gap_nsamples = (int64_t)round(cur_tx_srate * srsran_timestamp_real(&ts_gap)) - q.nof_samples;
+    if (gap_nsamples != 0 or q.nof_samples + nof_samples > q.buffers[0].size()) {
+      if (not tx_coalesce_flush(device_idx)) {
+        return false;
+      }
+    }
+  }
+
+  // Stage the samples, the first buffer sets the timestamp and the start of burst
+  if (q.nof_samples == 0) {
+    q.tx_time        = tx_time;
+    q.start_of_burst = is_start_of_burst;
+  }
+  size_t sample_sz = rf_info.at(device_idx).sc16 ? 2 * sizeof(int16_t) : sizeof(cf_t);
+  for (uint32_t ch = 0; ch < nof_channels_x_dev; ch++) {
+    memcpy((uint8_t*)q.buffers[ch].data() + sample_sz * q.nof_samples, radio_buffers[ch], sample_sz * nof_samples);
+  }
+  q.nof_samples += nof_samples;
+  q.nof_buffers++;
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    rf_metrics.dev[device_idx].tx_staged_max = std::max(rf_metrics.dev[device_idx].tx_staged_max, q.nof_samples);
+  }
+
+  // Keep the samples only if the next buffer, expected after as long as this one lasts, arrives in time
+  double wait_sec = (double)nof_samples / cur_tx_srate;
+  if (q.nof_buffers >= tx_coalesce_max_sf or tx_coalesce_margin(device_idx) - wait_sec < tx_coalesce_margin_sec) {
+    return tx_coalesce_flush(device_idx);
+  }
+
+  return true;
+}
+
+bool radio::tx_coalesce_flush(const uint32_t& device_idx)
+{
+  if (device_idx >= tx_coalesce.size() or tx_coalesce[device_idx].nof_samples == 0) {
+    return true;
+  }
+
+  tx_coalesce_t& q                                  = tx_coalesce[device_idx];
+  void*          radio_buffers[SRSRAN_MAX_CHANNELS] = {};
+  for (uint32_t ch = 0; ch < SRSRAN_MAX_CHANNELS; ch++) {
+    radio_buffers[ch] = ch < nof_channels_x_dev ? (void*)q.buffers[ch].data() : (void*)zeros.data();
+  }
+
+  bool ret = tx_dev_send_timed(device_idx, radio_buffers, q.nof_samples, q.tx_time, q.start_of_burst);
+
+  logger.debug("Sent %d coalesced buffers of device %d (%d samples)", q.nof_buffers, device_idx, q.nof_samples);
+  q.nof_samples = 0;
+  q.nof_buffers = 0;
+
+  return ret;
+}
+
+bool radio::tx_dev_send_timed(const uint32_t&           device_idx,
+                              void**                    radio_buffers,
+                              uint32_t                  nof_samples,
+                              const srsran_timestamp_t& tx_time,
+                              bool                      start_of_burst)
+{
+  double now     = rx_time_now;
+  auto   t_start = std::chrono::steady_clock::now();
+  int    ret     = srsran_rf_send_timed_multi(&rf_devices[device_idx],
+                                              radio_buffers,
+                                              nof_samples,
+                                              tx_time.full_secs,
+                                              tx_time.frac_secs,
+                                              true,
+                                              start_of_burst,
+                                              false);
+  auto   t_end   = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  rf_dev_metrics_t&           m = rf_metrics.dev[device_idx];
+  m.tx_call.add(std::chrono::duration_cast<std::chrono::microseconds>(t_end - t_start).count());
+  if (std::isnormal(now)) {
+    m.tx_deadline.add((int64_t)round((srsran_timestamp_real(&tx_time) - now) * 1e6));
+  }
 
   return ret > SRSRAN_SUCCESS;
 }
 
+double radio::tx_coalesce_margin(const uint32_t& device_idx)
+{
+  // Nothing is held while the current time is not known
+  double now = rx_time_now;
+  if (not std::isnormal(now)) {
+    return 0.0;
+  }
+  return srsran_timestamp_real(&tx_coalesce[device_idx].tx_time) - now;
+}
+
 void radio::tx_end()
 {
   std::unique_lock<std::mutex> lock(tx_mutex);
@@ -638,6 +1062,7 @@ void radio::tx_end_nolock()
   }
   if (!is_start_of_burst) {
     for (uint32_t i = 0; i < (uint32_t)rf_devices.size(); i++) {
+      tx_coalesce_flush(i);
       srsran_rf_send_timed2(
           &rf_devices[i], zeros.data(), 0, end_of_burst_time[i].full_secs, end_of_burst_time[i].frac_secs, false, true);
     }
@@ -695,6 +1120,7 @@ void radio::set_rx_freq(const uint32_t& carrier_idx, const double& freq)
 
           srsran_rf_set_rx_freq(&rf_devices[dm.device_idx], dm.channel_idx, freq + freq_offset);
         }
+        rx_correction_reset_pending = true;
       } else {
         logger.error("set_rx_freq: physical_channel_idx=%d for %d antennas exceeds maximum channels (%d)",
                      device_mapping.carrier_idx,
@@ -717,6 +1143,7 @@ void radio::set_rx_gain(const float& gain)
   for (srsran_rf_t& rf_device : rf_devices) {
     srsran_rf_set_rx_gain(&rf_device, gain);
   }
+  rx_correction_reset_pending = true;
 }
 
 void radio::set_rx_gain_th(const float& gain)
@@ -729,6 +1156,20 @@ void radio::set_rx_gain_th(const float& gain)
   }
 }
 
+bool radio::set_resampler(srsran_resample_poly_t& q, double out_srate, double in_srate)
+{
+  uint32_t interp = (uint32_t)out_srate;
+  uint32_t decim  = (uint32_t)in_srate;
+
+  // Keep the filter state if the ratio does not change
+  if (q.interp > 0 and (uint64_t)q.interp * decim == (uint64_t)q.decim * interp) {
+    return true;
+  }
+
+  srsran_resample_poly_free(&q);
+  return srsran_resample_poly_init(&q, interp, decim, 0) == SRSRAN_SUCCESS;
+}
+
 void radio::set_rx_srate(const double& srate)
 {
   if (!is_initialized) {
@@ -746,17 +1187,22 @@ void radio::set_rx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_rx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
-                  srate / 1e6,
-                  cur_rx_srate / srate);
+    // Integer ratios use the FFT decimators, other ratios the polyphase resamplers
+    bool     integer = ((uint32_t)cur_rx_srate % (uint32_t)srate) == 0;
+    uint32_t ratio   = integer ? (uint32_t)ceil(cur_rx_srate / srate) : 1;
 
     // Update decimators
-    uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
       srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+      if (integer) {
+        srsran_resample_poly_free(&rx_resamplers[ch]);
+      } else {
+        srsran_assert(set_resampler(rx_resamplers[ch], srate, cur_rx_srate),
+                      "The sampling rate ratio is not supported (%.2f MHz / %.2f MHz = %.3f)",
+                      cur_rx_srate / 1e6,
+                      srate / 1e6,
+                      cur_rx_srate / srate);
+      }
     }
 
     decimator_busy = false;
@@ -974,7 +1420,7 @@ double radio::get_dev_cal_tx_adv_sec(const std::string& device_name)
             cur_tx_srate);
         nsamples = blade_default_tx_adv_samples + (int)(blade_default_tx_adv_offset_sec * cur_tx_srate);
       }
-    } else if (device_name == "zmq") {
+    } else if (device_name == "zmq" || device_name == "shm" || device_name == "iq") {
       nsamples = 0;
     }
   } else {
@@ -993,6 +1439,11 @@ void radio::set_tx_srate(const double& srate)
     return;
   }
 
+  // The staged samples were produced at the current rate
+  for (uint32_t device_idx = 0; device_idx < (uint32_t)tx_coalesce.size(); device_idx++) {
+    tx_coalesce_flush(device_idx);
+  }
+
   // If fix sampling rate...
   if (std::isnormal(fix_srate_hz)) {
     // If the sampling rate was not set, set it
@@ -1002,17 +1453,22 @@ void radio::set_tx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_tx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
-                  srate / 1e6,
-                  cur_rx_srate / srate);
+    // Integer ratios use the FFT interpolators, other ratios the polyphase resamplers
+    bool     integer = ((uint32_t)cur_tx_srate % (uint32_t)srate) == 0;
+    uint32_t ratio   = integer ? (uint32_t)ceil(cur_tx_srate / srate) : 1;
 
     // Update interpolators
-    uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
       srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+      if (integer) {
+        srsran_resample_poly_free(&tx_resamplers[ch]);
+      } else {
+        srsran_assert(set_resampler(tx_resamplers[ch], cur_tx_srate, srate),
+                      "The sampling rate ratio is not supported (%.2f MHz / %.2f MHz = %.3f)",
+                      cur_tx_srate / 1e6,
+                      srate / 1e6,
+                      cur_tx_srate / srate);
+      }
     }
   } else {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -1042,6 +1498,7 @@ bool radio::get_metrics(rf_metrics_t* metrics)
   std::lock_guard<std::mutex> lock(metrics_mutex);
   *metrics   = rf_metrics;
   rf_metrics = {};
+  rf_metrics.dev.resize(rf_devices.size());
   return true;
 }
 
@@ -1116,11 +1573,11 @@ bool radio::map_channels(const channel_mapping&     map,
 
       // Set pointer if device index matches
       if (physical_idx.device_idx == device_idx) {
-        cf_t* ptr = buffer.get(i, j, nof_antennas);
+        uint8_t* ptr = (uint8_t*)buffer.get(i, j, nof_antennas);
 
         // Add sample offset only if it is a valid pointer
         if (ptr != nullptr) {
-          ptr += sample_offset;
+          ptr += (size_t)sample_offset * (buffer.is_sc16() ? 2 * sizeof(int16_t) : sizeof(cf_t));
         }
 
         radio_buffers[physical_idx.channel_idx] = ptr;
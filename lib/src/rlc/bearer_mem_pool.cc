@@ -55,5 +55,9 @@ void deallocate_rlc_bearer(void* p)
 {
   get_bearer_pool()->deallocate_node(p);
 }
+pool_metrics_t get_rlc_bearer_pool_metrics()
+{
+  return get_bearer_pool()->get_metrics("rlc_bearer");
+}
 
 } // namespace srsran
@@ -190,6 +190,7 @@ void rlc::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu)
   }
 
   if (valid_lcid(lcid)) {
+    sdu->md.trace.stamp(pkt_trace_point::rlc_tx);
     rlc_array.at(lcid)->write_sdu_s(std::move(sdu));
     update_bsr(lcid);
   } else {
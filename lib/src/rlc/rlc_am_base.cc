@@ -85,6 +85,7 @@ bool rlc_am::configure(const rlc_config_t& cfg_)
     RlcError("Error configuring bearer (TX)");
     return false;
   }
+  tx_base->invalidate_buffer_state(true);
 
   if (cfg.rat == srsran_rat_t::lte) {
     RlcInfo("AM LTE configured - t_poll_retx=%d, poll_pdu=%d, poll_byte=%d, max_retx_thresh=%d, "
@@ -120,6 +121,7 @@ void rlc_am::stop()
   RlcDebug("Stopped bearer");
   tx_base->stop();
   rx_base->stop();
+  tx_base->invalidate_buffer_state();
 }
 
 void rlc_am::reestablish()
@@ -127,6 +129,7 @@ void rlc_am::reestablish()
   RlcDebug("Reestablished bearer");
   tx_base->reestablish(); // calls stop and enables tx again
   rx_base->reestablish(); // calls only stop
+  tx_base->invalidate_buffer_state(true);
 }
 
 /****************************************************************************
@@ -177,6 +180,7 @@ void rlc_am::get_buffer_state(uint32_t& n_bytes_newtx, uint32_t& n_bytes_prio)
 uint32_t rlc_am::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   uint32_t read_bytes = tx_base->read_pdu(payload, nof_bytes);
+  tx_base->invalidate_buffer_state(true);
 
   std::lock_guard<std::mutex> lock(metrics_mutex);
   metrics.num_tx_pdus += read_bytes > 0 ? 1 : 0;
@@ -208,6 +212,16 @@ rlc_bearer_metrics_t rlc_am::get_metrics()
   return metrics;
 }
 
+void rlc_am::trace_tx_sdu(byte_buffer_t& sdu)
+{
+  if (not sdu.md.trace.sampled) {
+    return;
+  }
+  sdu.md.trace.stamp(pkt_trace_point::rlc_read);
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  metrics.tx_pkt_latency.add(sdu.md.trace);
+}
+
 void rlc_am::reset_metrics()
 {
   std::lock_guard<std::mutex> lock(metrics_mutex);
@@ -229,8 +243,9 @@ void rlc_am::set_bsr_callback(bsr_callback_t callback)
  *******************************************************/
 int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
+  // The PDCP does not wait for the MAC reading the PDUs, which holds the Tx mutex. The SDU mutex keeps stop() from
+  // emptying the queue between the tx_enabled check and the push
+  std::lock_guard<std::mutex> lock(sdu_mutex);
   if (!tx_enabled) {
     return SRSRAN_ERROR;
   }
@@ -243,18 +258,17 @@ int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
   // Get SDU info
   uint32_t sdu_pdcp_sn = sdu->md.pdcp_sn;
 
+  // Log the SDU before storing it, since read_pdu() may pop and free it right after the push
+  RlcHexInfo(sdu->msg,
+             sdu->N_bytes,
+             "Tx SDU (%d B, PDCP_SN=%ld tx_sdu_queue_len=%d)",
+             sdu->N_bytes,
+             sdu_pdcp_sn,
+             tx_sdu_queue.size() + 1);
+
   // Store SDU
-  uint8_t*                                 msg_ptr   = sdu->msg;
-  uint32_t                                 nof_bytes = sdu->N_bytes;
-  srsran::error_type<unique_byte_buffer_t> ret       = tx_sdu_queue.try_write(std::move(sdu));
-  if (ret) {
-    RlcHexInfo(msg_ptr,
-               nof_bytes,
-               "Tx SDU (%d B, PDCP_SN=%ld tx_sdu_queue_len=%d)",
-               nof_bytes,
-               sdu_pdcp_sn,
-               tx_sdu_queue.size());
-  } else {
+  srsran::error_type<unique_byte_buffer_t> ret = tx_sdu_queue.try_write(std::move(sdu));
+  if (not ret) {
     // in case of fail, the try_write returns back the sdu
     RlcHexWarning(ret.error()->msg,
                   ret.error()->N_bytes,
@@ -264,14 +278,20 @@ int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
                   tx_sdu_queue.size());
     return SRSRAN_ERROR;
   }
+  invalidate_buffer_state();
 
   return SRSRAN_SUCCESS;
 }
 
-void rlc_am::rlc_am_base_tx::discard_sdu(uint32_t discard_sn)
+void rlc_am::rlc_am_base_tx::disable_tx()
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  // Wait for the SDU being written, so that no SDU is pushed once the queue is emptied
+  std::lock_guard<std::mutex> lock(sdu_mutex);
+  tx_enabled = false;
+}
 
+void rlc_am::rlc_am_base_tx::discard_sdu(uint32_t discard_sn)
+{
   if (!tx_enabled) {
     return;
   }
@@ -286,6 +306,9 @@ void rlc_am::rlc_am_base_tx::discard_sdu(uint32_t discard_sn)
 
   // Discard fails when the PDCP PDU is already in Tx window.
   RlcInfo("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
+  if (discarded) {
+    invalidate_buffer_state();
+  }
 }
 
 bool rlc_am::rlc_am_base_tx::sdu_queue_is_full()
@@ -298,6 +321,35 @@ void rlc_am::rlc_am_base_tx::set_bsr_callback(bsr_callback_t callback)
   bsr_callback = callback;
 }
 
+void rlc_am::rlc_am_base_tx::invalidate_buffer_state(bool force_report)
+{
+  if (force_report) {
+    buffer_state_force_report.store(true, std::memory_order_relaxed);
+  }
+  buffer_state_dirty.store(true, std::memory_order_release);
+}
+
+bool rlc_am::rlc_am_base_tx::get_cached_buffer_state(uint32_t& n_bytes_newtx, uint32_t& n_bytes_prio) const
+{
+  if (buffer_state_dirty.load(std::memory_order_acquire)) {
+    return false;
+  }
+  n_bytes_newtx = buffer_state_newtx.load(std::memory_order_relaxed);
+  n_bytes_prio  = buffer_state_prio.load(std::memory_order_relaxed);
+  return true;
+}
+
+void rlc_am::rlc_am_base_tx::update_buffer_state(uint32_t lcid, uint32_t n_bytes_newtx, uint32_t n_bytes_prio)
+{
+  bool changed = buffer_state_newtx.exchange(n_bytes_newtx, std::memory_order_relaxed) != n_bytes_newtx;
+  changed |= buffer_state_prio.exchange(n_bytes_prio, std::memory_order_relaxed) != n_bytes_prio;
+  bool force = buffer_state_force_report.exchange(false, std::memory_order_relaxed);
+  if (bsr_callback && (changed || force)) {
+    RlcDebug("Calling BSR callback - %d new_tx, %d prio bytes", n_bytes_newtx, n_bytes_prio);
+    bsr_callback(lcid, n_bytes_newtx, n_bytes_prio);
+  }
+}
+
 /*******************************************************
  *     RLC AM RX entity
  *     This class is used for common code between the
@@ -315,5 +367,7 @@ void rlc_am::rlc_am_base_rx::write_pdu(uint8_t* payload, const uint32_t nof_byte
   } else {
     handle_data_pdu(payload, nof_bytes);
   }
+  // Either the retx queue or the pending status report may have changed
+  parent->tx_base->invalidate_buffer_state();
 }
 } // namespace srsran
@@ -85,6 +85,7 @@ bool rlc_am_lte_tx::configure(const rlc_config_t& cfg_)
   // make sure Tx queue is empty before attempting to resize
   empty_queue_nolock();
   tx_sdu_queue.resize(cfg_.tx_queue_length);
+  tx_sdu_queue.set_aqm(cfg_.tx_aqm);
 
   tx_enabled = true;
 
@@ -99,9 +100,10 @@ void rlc_am_lte_tx::stop()
 
 void rlc_am_lte_tx::stop_nolock()
 {
-  empty_queue_nolock();
+  // Disable the Tx first, since the SDUs are written without the Tx mutex
+  disable_tx();
 
-  tx_enabled = false;
+  empty_queue_nolock();
 
   if (parent->timers != nullptr && poll_retx_timer.is_valid()) {
     poll_retx_timer.stop();
@@ -204,6 +206,10 @@ uint32_t rlc_am_lte_tx::get_buffer_state()
 
 void rlc_am_lte_tx::get_buffer_state(uint32_t& n_bytes_newtx, uint32_t& n_bytes_prio)
 {
+  // Nothing changed since the last computation
+  if (get_cached_buffer_state(n_bytes_newtx, n_bytes_prio)) {
+    return;
+  }
   std::lock_guard<std::mutex> lock(mutex);
   get_buffer_state_nolock(n_bytes_newtx, n_bytes_prio);
 }
@@ -214,7 +220,11 @@ void rlc_am_lte_tx::get_buffer_state_nolock(uint32_t& n_bytes_newtx, uint32_t& n
   n_bytes_prio    = 0;
   uint32_t n_sdus = 0;
 
+  // Changes from now on invalidate the computed state again
+  buffer_state_dirty.store(false, std::memory_order_relaxed);
+
   if (not tx_enabled) {
+    update_buffer_state(parent->lcid, 0, 0);
     return;
   }
 
@@ -271,10 +281,7 @@ void rlc_am_lte_tx::get_buffer_state_nolock(uint32_t& n_bytes_newtx, uint32_t& n
     RlcDebug("Total buffer state - %d SDUs (%d B)", n_sdus, n_bytes_newtx);
   }
 
-  if (bsr_callback) {
-    RlcDebug("Calling BSR callback - %d new_tx, %d prio bytes", n_bytes_newtx, n_bytes_prio);
-    bsr_callback(parent->lcid, n_bytes_newtx, n_bytes_prio);
-  }
+  update_buffer_state(parent->lcid, n_bytes_newtx, n_bytes_prio);
 }
 
 uint32_t rlc_am_lte_tx::read_pdu(uint8_t* payload, uint32_t nof_bytes)
@@ -329,6 +336,7 @@ void rlc_am_lte_tx::timer_expired(uint32_t timeout_id)
   } else if (status_prohibit_timer.is_valid() && status_prohibit_timer.id() == timeout_id) {
     RlcDebug("Status prohibit timer expired after %dms", status_prohibit_timer.duration());
   }
+  invalidate_buffer_state();
 
   if (bsr_callback) {
     uint32_t new_tx_queue = 0, prio_tx_queue = 0;
@@ -824,6 +832,7 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
       }
       break;
     }
+    parent->trace_tx_sdu(*tx_sdu);
 
     // store sdu info
     if (undelivered_sdu_info_queue.has_pdcp_sn(tx_sdu->md.pdcp_sn)) {
@@ -1507,9 +1516,8 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
           rx_window[vr_r].buf->N_bytes -= len;
 
           RlcHexInfo(rx_sdu->msg, rx_sdu->N_bytes, "Rx SDU (%d B)", rx_sdu->N_bytes);
-          sdu_rx_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
-                                     std::chrono::high_resolution_clock::now() - rx_sdu->get_timestamp())
-                                     .count());
+          sdu_rx_latency_ms.push(
+              std::chrono::duration_cast<std::chrono::milliseconds>(rx_sdu->get_latency_us()).count());
           parent->pdcp->write_pdu(parent->lcid, std::move(rx_sdu));
           {
             std::lock_guard<std::mutex> lock(parent->metrics_mutex);
@@ -1560,9 +1568,8 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
 
     if (rlc_am_end_aligned(rx_window[vr_r].header.fi)) {
       RlcHexInfo(rx_sdu->msg, rx_sdu->N_bytes, "Rx SDU (%d B)", rx_sdu->N_bytes);
-      sdu_rx_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
-                                 std::chrono::high_resolution_clock::now() - rx_sdu->get_timestamp())
-                                 .count());
+      sdu_rx_latency_ms.push(
+          std::chrono::duration_cast<std::chrono::milliseconds>(rx_sdu->get_latency_us()).count());
       parent->pdcp->write_pdu(parent->lcid, std::move(rx_sdu));
       {
         std::lock_guard<std::mutex> lock(parent->metrics_mutex);
@@ -1655,6 +1662,7 @@ void rlc_am_lte_rx::timer_expired(uint32_t timeout_id)
     }
 
     debug_state();
+    tx->invalidate_buffer_state();
   }
 }
 
@@ -1678,12 +1686,14 @@ int rlc_am_lte_rx::get_status_pdu(rlc_status_pdu_t* status, const uint32_t max_p
       status->ack_sn = i;
     } else {
       status->nacks[status->N_nack].nack_sn = i;
+      status->nacks[status->N_nack].has_so  = false;
       status->N_nack++;
     }
 
-    // make sure we don't exceed grant size
-    if (rlc_am_packed_length(status) > max_pdu_size) {
-      RlcDebug("Status PDU too big (%d > %d)", rlc_am_packed_length(status), max_pdu_size);
+    // make sure we don't exceed grant size. Only full PDUs are NACKed, so the length grows by 12 bits per NACK
+    uint32_t pdu_len = (15 + 12 * status->N_nack + 7) / 8;
+    if (pdu_len > max_pdu_size) {
+      RlcDebug("Status PDU too big (%d > %d)", pdu_len, max_pdu_size);
       if (status->N_nack >= 1 && status->N_nack < RLC_AM_WINDOW_SIZE) {
         RlcDebug("Removing last NACK SN=%d", status->nacks[status->N_nack].nack_sn);
         status->N_nack--;
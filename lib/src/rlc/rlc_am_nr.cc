@@ -78,6 +78,7 @@ bool rlc_am_nr_tx::configure(const rlc_config_t& cfg_)
   // make sure Tx queue is empty before attempting to resize
   empty_queue_no_lock();
   tx_sdu_queue.resize(cfg_.tx_queue_length);
+  tx_sdu_queue.set_aqm(cfg_.tx_aqm);
 
   // Check timers are valid
   if (not poll_retransmit_timer.is_valid()) {
@@ -191,6 +192,11 @@ uint32_t rlc_am_nr_tx::build_new_pdu(uint8_t* payload, uint32_t nof_bytes)
     return 0;
   }
 
+  if (segment_pool.nof_free_segments() == 0) {
+    RlcInfo("Cannot build data PDU - No segments available");
+    return 0;
+  }
+
   // Read new SDU from TX queue
   unique_byte_buffer_t tx_sdu;
   RlcDebug("Reading from RLC SDU queue. Queue size %d", tx_sdu_queue.size());
@@ -200,6 +206,7 @@ uint32_t rlc_am_nr_tx::build_new_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   if (tx_sdu != nullptr) {
     RlcDebug("Read RLC SDU - RLC_SN=%d, PDCP_SN=%d, %d bytes", st.tx_next, tx_sdu->md.pdcp_sn, tx_sdu->N_bytes);
+    parent->trace_tx_sdu(*tx_sdu);
   } else {
     RlcDebug("No SDUs left in the tx queue.");
     return 0;
@@ -312,9 +319,7 @@ uint32_t rlc_am_nr_tx::build_new_sdu_segment(rlc_amd_tx_pdu_nr& tx_pdu, uint8_t*
   memcpy(&payload[hdr_len], tx_pdu.sdu_buf->msg, segment_payload_len);
 
   // Store Segment Info
-  rlc_amd_tx_pdu_nr::pdu_segment segment_info;
-  segment_info.payload_len = segment_payload_len;
-  tx_pdu.segment_list.push_back(segment_info);
+  tx_pdu.segment_list.push_back(segment_pool, 0, segment_payload_len);
   return hdr_len + segment_payload_len;
 }
 
@@ -355,9 +360,14 @@ uint32_t rlc_am_nr_tx::build_continuation_sdu_segment(rlc_amd_tx_pdu_nr& tx_pdu,
     return 0;
   }
 
+  if (segment_pool.nof_free_segments() == 0) {
+    RlcInfo("cannot build new sdu_segment, there are no segments available");
+    return 0;
+  }
+
   // Can the rest of the SDU be sent on a single segment PDU?
-  const rlc_amd_tx_pdu_nr::pdu_segment& seg       = tx_pdu.segment_list.back();
-  uint32_t                              last_byte = seg.so + seg.payload_len;
+  const rlc_am_nr_tx_segment& seg       = tx_pdu.segment_list.back();
+  uint32_t                    last_byte = seg.so + seg.payload_len;
   RlcDebug("continuing SDU segment. SN=%d, last byte transmitted %d", tx_pdu.rlc_sn, last_byte);
 
   // Sanity check: last byte must be smaller than SDU size
@@ -411,10 +421,7 @@ uint32_t rlc_am_nr_tx::build_continuation_sdu_segment(rlc_amd_tx_pdu_nr& tx_pdu,
   memcpy(&payload[hdr_len], &tx_pdu.sdu_buf->msg[last_byte], segment_payload_len);
 
   // Store PDU segment info into tx_window
-  rlc_amd_tx_pdu_nr::pdu_segment segment_info = {};
-  segment_info.so                             = last_byte;
-  segment_info.payload_len                    = segment_payload_len;
-  tx_pdu.segment_list.push_back(segment_info);
+  tx_pdu.segment_list.push_back(segment_pool, last_byte, segment_payload_len);
 
   if (si == rlc_nr_si_field_t::neither_first_nor_last_segment) {
     RlcInfo("grant is not large enough for full SDU."
@@ -632,6 +639,12 @@ uint32_t rlc_am_nr_tx::build_retx_pdu_with_segmentation(rlc_amd_retx_nr_t& retx,
     return 0;
   }
 
+  // Splitting the SDU takes up to two segments from the pool
+  if (segment_pool.nof_free_segments() < 2) {
+    RlcInfo("Cannot build RETX segment - No segments available. SN=%d", retx.sn);
+    return 0;
+  }
+
   // Sanity check: could this have been transmitted without segmentation?
   if (nof_bytes > (tx_pdu.sdu_buf->N_bytes + expected_hdr_len)) {
     RlcError("called %s, but there are enough bytes to avoid segmentation. SN=%d", __FUNCTION__, retx.sn);
@@ -662,39 +675,17 @@ uint32_t rlc_am_nr_tx::build_retx_pdu_with_segmentation(rlc_amd_retx_nr_t& retx,
   RlcDebug("Updating RETX segment info. SN=%d, is_segment=%s", retx.sn, retx.is_segment ? "true" : "false");
   if (!retx.is_segment) {
     // Retx is not a segment yet
-    rlc_amd_tx_pdu_nr::pdu_segment seg1 = {};
-    seg1.so                             = retx.current_so;
-    seg1.payload_len                    = retx_pdu_payload_size;
-    rlc_amd_tx_pdu_nr::pdu_segment seg2 = {};
-    seg2.so                             = retx.current_so + retx_pdu_payload_size;
-    seg2.payload_len                    = retx.segment_length - retx_pdu_payload_size;
-    tx_pdu.segment_list.push_back(seg1);
-    tx_pdu.segment_list.push_back(seg2);
-    RlcDebug("New segment: SN=%d, SO=%d len=%d", retx.sn, seg1.so, seg1.payload_len);
-    RlcDebug("New segment: SN=%d, SO=%d len=%d", retx.sn, seg2.so, seg2.payload_len);
+    uint32_t so2 = retx.current_so + retx_pdu_payload_size;
+    tx_pdu.segment_list.push_back(segment_pool, retx.current_so, retx_pdu_payload_size);
+    tx_pdu.segment_list.push_back(segment_pool, so2, retx.segment_length - retx_pdu_payload_size);
+    RlcDebug("New segment: SN=%d, SO=%d len=%d", retx.sn, retx.current_so, retx_pdu_payload_size);
+    RlcDebug("New segment: SN=%d, SO=%d len=%d", retx.sn, so2, retx.segment_length - retx_pdu_payload_size);
   } else {
-    // Retx is already a segment
-    // Find current segment in segment list.
-    std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator it;
-    for (it = tx_pdu.segment_list.begin(); it != tx_pdu.segment_list.end(); ++it) {
-      if (it->so == retx.current_so) {
-        break;
-      }
-    }
-    if (it != tx_pdu.segment_list.end()) {
-      rlc_amd_tx_pdu_nr::pdu_segment seg1 = {};
-      seg1.so                             = it->so;
-      seg1.payload_len                    = retx_pdu_payload_size;
-      rlc_amd_tx_pdu_nr::pdu_segment seg2 = {};
-      seg2.so                             = it->so + retx_pdu_payload_size;
-      seg2.payload_len                    = it->payload_len - retx_pdu_payload_size;
-
-      std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator begin_it   = tx_pdu.segment_list.erase(it);
-      std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator insert_it  = tx_pdu.segment_list.insert(begin_it, seg2);
-      std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator insert_it2 = tx_pdu.segment_list.insert(insert_it, seg1);
+    // Retx is already a segment. Split the current segment in the segment list
+    if (tx_pdu.segment_list.split(retx.current_so, retx_pdu_payload_size)) {
       RlcDebug("Old segment SN=%d, SO=%d len=%d", retx.sn, retx.current_so, retx.segment_length);
-      RlcDebug("New segment SN=%d, SO=%d len=%d", retx.sn, seg1.so, seg1.payload_len);
-      RlcDebug("New segment SN=%d, SO=%d len=%d", retx.sn, seg2.so, seg2.payload_len);
+      RlcDebug("New segment SN=%d, SO=%d len=%d", retx.sn, retx.current_so, retx_pdu_payload_size);
+      RlcDebug("New segment SN=%d, SO=%d", retx.sn, retx.current_so + retx_pdu_payload_size);
     } else {
       RlcDebug("Could not find segment. SN=%d, SO=%d length=%d", retx.sn, retx.current_so, retx.segment_length);
     }
@@ -922,7 +913,7 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
           RlcError("Received NACK with SO, but there is no segment information. SN=%d", nack.nack_sn);
         }
         bool segment_found = false;
-        for (const rlc_amd_tx_pdu_nr::pdu_segment& segm : pdu.segment_list) {
+        for (const rlc_am_nr_tx_segment& segm : pdu.segment_list) {
           if (segm.so >= nack.so_start && segm.so <= nack.so_end) {
             if (not retx_queue.has_sn(nack.nack_sn, segm.so)) {
               rlc_amd_retx_nr_t& retx = retx_queue.push();
@@ -950,7 +941,7 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
                      nack.nack_sn,
                      nack.so_start,
                      nack.so_end);
-          for (const rlc_amd_tx_pdu_nr::pdu_segment& segm : pdu.segment_list) {
+          for (const rlc_am_nr_tx_segment& segm : pdu.segment_list) {
             RlcDebug("Segments for SN=%d. SO=%d, SO_end=%d", nack.nack_sn, segm.so, segm.payload_len);
           }
         }
@@ -971,7 +962,7 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
           } else {
             RlcInfo("Scheduled RETX of SDU SN=%d", nack.nack_sn);
             retx_sn_set.insert(nack.nack_sn);
-            for (auto segm : (*tx_window)[nack.nack_sn].segment_list) {
+            for (const rlc_am_nr_tx_segment& segm : (*tx_window)[nack.nack_sn].segment_list) {
               rlc_amd_retx_nr_t& retx = retx_queue.push();
               retx.sn                 = nack.nack_sn;
               retx.is_segment         = true;
@@ -1033,11 +1024,21 @@ uint32_t rlc_am_nr_tx::get_buffer_state()
 
 void rlc_am_nr_tx::get_buffer_state(uint32_t& n_bytes_new, uint32_t& n_bytes_prio)
 {
+  // Nothing changed since the last computation
+  if (get_cached_buffer_state(n_bytes_new, n_bytes_prio)) {
+    return;
+  }
   std::lock_guard<std::mutex> lock(mutex);
   RlcDebug("buffer state - do_status=%s", do_status() ? "yes" : "no");
 
+  // Changes from now on invalidate the computed state again
+  buffer_state_dirty.store(false, std::memory_order_relaxed);
+  n_bytes_new  = 0;
+  n_bytes_prio = 0;
+
   if (!tx_enabled) {
     RlcError("get_buffer_state() failed: TX is not enabled.");
+    update_buffer_state(parent->lcid, 0, 0);
     return;
   }
 
@@ -1074,8 +1075,8 @@ void rlc_am_nr_tx::get_buffer_state(uint32_t& n_bytes_new, uint32_t& n_bytes_pri
       rlc_amd_tx_pdu_nr& seg_pdu = (*tx_window)[sdu_under_segmentation_sn];
       if (not seg_pdu.segment_list.empty()) {
         // obtain amount of already transmitted Bytes
-        const rlc_amd_tx_pdu_nr::pdu_segment& seg       = seg_pdu.segment_list.back();
-        uint32_t                              last_byte = seg.so + seg.payload_len;
+        const rlc_am_nr_tx_segment& seg       = seg_pdu.segment_list.back();
+        uint32_t                    last_byte = seg.so + seg.payload_len;
         if (last_byte <= seg_pdu.sdu_buf->N_bytes) {
           // compute remaining bytes pending for transmission
           uint32_t remaining_bytes = seg_pdu.sdu_buf->N_bytes - last_byte;
@@ -1105,10 +1106,7 @@ void rlc_am_nr_tx::get_buffer_state(uint32_t& n_bytes_new, uint32_t& n_bytes_pri
   n_bytes_new += min_hdr_size * n_sdus;
   RlcDebug("total buffer state - %d SDUs (%d B)", n_sdus, n_bytes_new + n_bytes_prio);
 
-  if (bsr_callback) {
-    RlcDebug("calling BSR callback - %d new_tx, %d priority bytes", n_bytes_new, n_bytes_prio);
-    bsr_callback(parent->lcid, n_bytes_new, n_bytes_prio);
-  }
+  update_buffer_state(parent->lcid, n_bytes_new, n_bytes_prio);
 }
 
 /*
@@ -1218,6 +1216,8 @@ void rlc_am_nr_tx::empty_queue_no_lock()
 void rlc_am_nr_tx::stop()
 {
   std::lock_guard<std::mutex> lock(mutex);
+  // Disable the Tx first, since the SDUs are written without the Tx mutex
+  disable_tx();
   empty_queue_no_lock();
 
   if (parent->timers != nullptr && poll_retransmit_timer.is_valid()) {
@@ -1233,13 +1233,13 @@ void rlc_am_nr_tx::stop()
 
   // Drop all messages in RETX queue
   retx_queue.clear();
-
-  tx_enabled = false;
 }
 
 void rlc_am_nr_tx::timer_expired(uint32_t timeout_id)
 {
   std::unique_lock<std::mutex> lock(mutex);
+  // Expiries may schedule retransmissions
+  invalidate_buffer_state();
 
   // t-PollRetransmit
   if (poll_retransmit_timer.is_valid() && poll_retransmit_timer.id() == timeout_id) {
@@ -1404,6 +1404,8 @@ bool rlc_am_nr_rx::configure(const rlc_config_t& cfg_)
       RlcError("attempt to configure unsupported rx_sn_field_length %s", to_string(cfg.rx_sn_field_length));
       return false;
   }
+  rx_window_fully_received.resize(rx_window_size());
+  rx_window_fully_received.reset();
 
   RlcDebug("RLC AM NR configured rx entity.");
 
@@ -1428,6 +1430,7 @@ void rlc_am_nr_rx::stop()
 
   // Drop all messages in RX window
   rx_window->clear();
+  rx_window_fully_received.reset();
 }
 
 void rlc_am_nr_rx::reestablish()
@@ -1534,20 +1537,9 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
      * all bytes have been received.
      */
     if (rx_mod_base_nr(header.sn) == rx_mod_base_nr(st.rx_highest_status)) {
-      uint32_t sn_upd = 0;
-      for (sn_upd = (st.rx_highest_status + 1) % mod_nr; rx_mod_base_nr(sn_upd) < rx_mod_base_nr(st.rx_next_highest);
-           sn_upd = (sn_upd + 1) % mod_nr) {
-        if (rx_window->has_sn(sn_upd)) {
-          if (not(*rx_window)[sn_upd].fully_received) {
-            break; // first SDU not fully received
-          }
-        } else {
-          break; // first SDU not fully received
-        }
-      }
       // Update to the SN of the first SDU with missing bytes.
       // If it not exists, update to the end of the rx_window.
-      st.rx_highest_status = sn_upd;
+      st.rx_highest_status = find_not_fully_received((st.rx_highest_status + 1) % mod_nr, st.rx_next_highest);
     }
     /*
      * - if x = RX_Next:
@@ -1566,6 +1558,7 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
           // RX_Next serves as the lower edge of the receiving window
           // As such, we remove any SDU from the window if we update this value
           rx_window->remove_pdu(sn_upd);
+          mark_fully_received(sn_upd, false);
         } else {
           break; // first SDU not fully received
         }
@@ -1654,6 +1647,7 @@ int rlc_am_nr_rx::handle_full_data_sdu(const rlc_am_nr_pdu_header_t& header, con
   rx_sdu.buf->N_bytes   = nof_bytes - hdr_len;
   rx_sdu.fully_received = true;
   rx_sdu.has_gap        = false;
+  mark_fully_received(header.sn, true);
   return SRSRAN_SUCCESS;
 }
 
@@ -1709,6 +1703,7 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
       memcpy(&rx_sdu.buf->msg[rx_sdu.buf->N_bytes], it.buf->msg, it.buf->N_bytes);
       rx_sdu.buf->N_bytes += it.buf->N_bytes;
     }
+    mark_fully_received(header.sn, true);
   }
   return SRSRAN_SUCCESS;
 }
@@ -1733,72 +1728,72 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
    */
   RlcDebug("Generating status PDU");
   for (uint32_t i = st.rx_next; rx_mod_base_nr(i) < rx_mod_base_nr(st.rx_highest_status); i = (i + 1) % mod_nr) {
-    if ((rx_window->has_sn(i) && (*rx_window)[i].fully_received)) {
-      RlcDebug("SDU SN=%d is fully received", i);
-    } else {
-      if (not rx_window->has_sn(i)) {
-        // No segment received, NACK the whole SDU
-        RlcDebug("Adding NACK for full SDU. NACK SN=%d", i);
-        rlc_status_nack_t nack;
-        nack.nack_sn = i;
-        nack.has_so  = false;
-        status->push_nack(nack);
-      } else if (not(*rx_window)[i].fully_received) {
-        // Some segments were received, but not all.
-        // NACK non consecutive missing bytes
-        RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
-        uint32_t last_so         = 0;
-        bool     last_segment_rx = false;
-        for (auto segm = (*rx_window)[i].segments.begin(); segm != (*rx_window)[i].segments.end(); segm++) {
-          if (segm->header.so != last_so) {
-            // Some bytes were not received
-            rlc_status_nack_t nack;
-            nack.nack_sn  = i;
-            nack.has_so   = true;
-            nack.so_start = last_so;
-            nack.so_end   = segm->header.so - 1; // set to last missing byte
-            status->push_nack(nack);
-            if (nack.so_start > nack.so_end) {
-              // Print segment list
-              for (auto segm_it = (*rx_window)[i].segments.begin(); segm_it != (*rx_window)[i].segments.end();
-                   segm_it++) {
-                RlcError("Segment: segm.header.so=%d, segm.buf.N_bytes=%d", segm_it->header.so, segm_it->buf->N_bytes);
-              }
-              RlcError("Error: SO_start=%d > SO_end=%d. NACK_SN=%d. SO_start=%d, SO_end=%d, seg.so=%d",
-                       nack.so_start,
-                       nack.so_end,
-                       nack.nack_sn,
-                       nack.so_start,
-                       nack.so_end,
-                       segm->header.so);
-              srsran_assert(nack.so_start <= nack.so_end,
-                            "Error: SO_start=%d > SO_end=%d. NACK_SN=%d",
-                            nack.so_start,
-                            nack.so_end,
-                            nack.nack_sn);
-            } else {
-              RlcDebug("First/middle segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d",
-                       nack.nack_sn,
-                       nack.so_start,
-                       nack.so_end);
-            }
-          }
-          if (segm->header.si == rlc_nr_si_field_t::last_segment) {
-            last_segment_rx = true;
-          }
-          last_so = segm->header.so + segm->buf->N_bytes;
-        } // Segment loop
-        if (not last_segment_rx) {
+    // Skip the runs of fully received SDUs
+    i = find_not_fully_received(i, st.rx_highest_status);
+    if (i == st.rx_highest_status) {
+      break;
+    }
+    if (not rx_window->has_sn(i)) {
+      // No segment received, NACK the whole SDU
+      RlcDebug("Adding NACK for full SDU. NACK SN=%d", i);
+      rlc_status_nack_t nack;
+      nack.nack_sn = i;
+      nack.has_so  = false;
+      status->push_nack(nack);
+    } else if (not(*rx_window)[i].fully_received) {
+      // Some segments were received, but not all.
+      // NACK non consecutive missing bytes
+      RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
+      uint32_t last_so         = 0;
+      bool     last_segment_rx = false;
+      for (auto segm = (*rx_window)[i].segments.begin(); segm != (*rx_window)[i].segments.end(); segm++) {
+        if (segm->header.so != last_so) {
+          // Some bytes were not received
           rlc_status_nack_t nack;
           nack.nack_sn  = i;
           nack.has_so   = true;
           nack.so_start = last_so;
-          nack.so_end   = rlc_status_nack_t::so_end_of_sdu;
+          nack.so_end   = segm->header.so - 1; // set to last missing byte
           status->push_nack(nack);
-          RlcDebug(
-              "Final segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d", nack.nack_sn, nack.so_start, nack.so_end);
-          srsran_assert(nack.so_start <= nack.so_end, "Error: SO_start > SO_end. NACK_SN=%d", nack.nack_sn);
+          if (nack.so_start > nack.so_end) {
+            // Print segment list
+            for (auto segm_it = (*rx_window)[i].segments.begin(); segm_it != (*rx_window)[i].segments.end();
+                 segm_it++) {
+              RlcError("Segment: segm.header.so=%d, segm.buf.N_bytes=%d", segm_it->header.so, segm_it->buf->N_bytes);
+            }
+            RlcError("Error: SO_start=%d > SO_end=%d. NACK_SN=%d. SO_start=%d, SO_end=%d, seg.so=%d",
+                     nack.so_start,
+                     nack.so_end,
+                     nack.nack_sn,
+                     nack.so_start,
+                     nack.so_end,
+                     segm->header.so);
+            srsran_assert(nack.so_start <= nack.so_end,
+                          "Error: SO_start=%d > SO_end=%d. NACK_SN=%d",
+                          nack.so_start,
+                          nack.so_end,
+                          nack.nack_sn);
+          } else {
+            RlcDebug("First/middle segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d",
+                     nack.nack_sn,
+                     nack.so_start,
+                     nack.so_end);
+          }
+        }
+        if (segm->header.si == rlc_nr_si_field_t::last_segment) {
+          last_segment_rx = true;
         }
+        last_so = segm->header.so + segm->buf->N_bytes;
+      } // Segment loop
+      if (not last_segment_rx) {
+        rlc_status_nack_t nack;
+        nack.nack_sn  = i;
+        nack.has_so   = true;
+        nack.so_start = last_so;
+        nack.so_end   = rlc_status_nack_t::so_end_of_sdu;
+        status->push_nack(nack);
+        RlcDebug("Final segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d", nack.nack_sn, nack.so_start, nack.so_end);
+        srsran_assert(nack.so_start <= nack.so_end, "Error: SO_start > SO_end. NACK_SN=%d", nack.nack_sn);
       }
     }
   } // NACK loop
@@ -1847,6 +1842,8 @@ bool rlc_am_nr_rx::get_do_status()
 void rlc_am_nr_rx::timer_expired(uint32_t timeout_id)
 {
   std::unique_lock<std::mutex> lock(mutex);
+  // The status report may be sent now or include other SNs
+  tx->invalidate_buffer_state();
 
   // Status Prohibit
   if (status_prohibit_timer.is_valid() && status_prohibit_timer.id() == timeout_id) {
@@ -1974,6 +1971,34 @@ bool rlc_am_nr_rx::inside_rx_window(uint32_t sn) const
   return rx_mod_base_nr(sn) < rx_window_size();
 }
 
+void rlc_am_nr_rx::mark_fully_received(uint32_t sn, bool value)
+{
+  rx_window_fully_received.set(sn % rx_window_size(), value);
+}
+
+uint32_t rlc_am_nr_rx::find_not_fully_received(uint32_t sn_start, uint32_t sn_end) const
+{
+  if (rx_mod_base_nr(sn_start) >= rx_mod_base_nr(sn_end)) {
+    return sn_start;
+  }
+  uint32_t nof_sn = rx_mod_base_nr(sn_end) - rx_mod_base_nr(sn_start);
+  uint32_t pos    = sn_start % rx_window_size();
+
+  // The searched range may wrap around the end of the bitset
+  uint32_t len1 = std::min(nof_sn, rx_window_size() - pos);
+  int      idx  = rx_window_fully_received.find_lowest(pos, pos + len1, false);
+  if (idx >= 0) {
+    return (sn_start + (idx - pos)) % mod_nr;
+  }
+  if (len1 < nof_sn) {
+    idx = rx_window_fully_received.find_lowest(0, nof_sn - len1, false);
+    if (idx >= 0) {
+      return (sn_start + len1 + idx) % mod_nr;
+    }
+  }
+  return sn_end;
+}
+
 /*
  * This function is used to check if the Rx_Highest_Status is
  * valid when t-Reasseambly expires.
@@ -49,6 +49,13 @@ bool rlc_am_nr_status_pdu_t::is_continuous_sequence(const rlc_status_nack_t& lef
     return false;
   }
 
+  // The merged NACK range must fit into its 8-bit field
+  uint32_t left_range  = left.has_nack_range ? left.nack_range : 1;
+  uint32_t right_range = right.has_nack_range ? right.nack_range : 1;
+  if (left_range + right_range > UINT8_MAX) {
+    return false;
+  }
+
   // Segments on left side (if present) must reach the end of sdu
   if (left.has_so && left.so_end != rlc_status_nack_t::so_end_of_sdu) {
     return false;
@@ -262,6 +262,16 @@ void rlc_um_base::rlc_um_base_tx::empty_queue()
   tx_sdu.reset();
 }
 
+void rlc_um_base::rlc_um_base_tx::trace_tx_sdu(byte_buffer_t& sdu)
+{
+  if (not sdu.md.trace.sampled) {
+    return;
+  }
+  sdu.md.trace.stamp(pkt_trace_point::rlc_read);
+  std::lock_guard<std::mutex> lock(parent->metrics_mutex);
+  parent->metrics.tx_pkt_latency.add(sdu.md.trace);
+}
+
 bool rlc_um_base::rlc_um_base_tx::has_data()
 {
   return (tx_sdu != nullptr || !tx_sdu_queue.is_empty());
@@ -328,7 +338,6 @@ bool rlc_um_base::rlc_um_base_tx::sdu_queue_is_full()
 
 uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  unique_byte_buffer_t pdu;
   {
     std::lock_guard<std::mutex> lock(mutex);
     RlcDebug("MAC opportunity - %d bytes", nof_bytes);
@@ -337,14 +346,8 @@ uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t
       RlcInfo("No data available to be sent");
       return 0;
     }
-
-    pdu = make_byte_buffer();
-    if (!pdu || pdu->N_bytes != 0) {
-      RlcError("Failed to allocate PDU buffer");
-      return 0;
-    }
   }
-  return build_data_pdu(std::move(pdu), payload, nof_bytes);
+  return pack_data_pdu(payload, nof_bytes);
 }
 
 } // namespace srsran
@@ -115,13 +115,14 @@ bool rlc_um_lte::rlc_um_lte_tx::configure(const rlc_config_t& cnfg_, std::string
   }
 
   tx_sdu_queue.resize(cnfg_.tx_queue_length);
+  tx_sdu_queue.set_aqm(cnfg_.tx_aqm);
 
   rb_name = rb_name_;
 
   return true;
 }
 
-uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
+uint32_t rlc_um_lte::rlc_um_lte_tx::pack_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
   rlc_umd_pdu_header_t        header = {};
@@ -132,45 +133,31 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
 
   uint32_t to_move = 0;
   uint32_t last_li = 0;
-  uint8_t* pdu_ptr = pdu->msg;
 
   int head_len  = rlc_um_packed_length(&header);
-  int pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
+  int pdu_space = nof_bytes;
 
   if (pdu_space <= head_len + 1) {
     RlcInfo("Cannot build a PDU - %d bytes available, %d bytes required for header", nof_bytes, head_len);
     return 0;
   }
 
+  // The SDU segments are gathered first, and copied only once into the payload after the header
+  tx_segments.clear();
+
   // Check for SDU segment
   if (tx_sdu) {
     uint32_t space = pdu_space - head_len;
     to_move        = space >= tx_sdu->N_bytes ? tx_sdu->N_bytes : space;
     RlcDebug("adding remainder of SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
-#ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
-      mean_pdu_latency_us.push(latency_us);
-      RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
-               (uint64_t)latency_us,
-               (long)mean_pdu_latency_us.value());
-#else
-      RlcDebug("%s Complete SDU scheduled for tx.", rb_name.c_str());
-#endif
-      tx_sdu.reset();
-    }
-    pdu_space -= SRSRAN_MIN(to_move, pdu->get_tailroom());
+    add_sdu_segment(to_move);
+    pdu_space -= to_move;
     header.fi |= RLC_FI_FIELD_NOT_START_ALIGNED; // First byte does not correspond to first byte of SDU
   }
 
   // Pull SDUs from queue
-  while (pdu_space > head_len + 1 && tx_sdu_queue.size() > 0) {
+  while (pdu_space > head_len + 1 && tx_sdu_queue.size() > 0 && not tx_segments.full()) {
     RlcDebug("pdu_space=%d, head_len=%d", pdu_space, head_len);
     if (last_li > 0) {
       header.li[header.N_li++] = last_li;
@@ -182,27 +169,12 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
       header.N_li--;
       break;
     }
-    tx_sdu  = tx_sdu_queue.read();
+    tx_sdu = tx_sdu_queue.read();
+    trace_tx_sdu(*tx_sdu);
     to_move = (space >= tx_sdu->N_bytes) ? tx_sdu->N_bytes : space;
     RlcDebug("adding new SDU segment - %d bytes of %d remaining", to_move, tx_sdu->N_bytes);
-    memcpy(pdu_ptr, tx_sdu->msg, to_move);
     last_li = to_move;
-    pdu_ptr += to_move;
-    pdu->N_bytes += to_move;
-    tx_sdu->N_bytes -= to_move;
-    tx_sdu->msg += to_move;
-    if (tx_sdu->N_bytes == 0) {
-#ifdef ENABLE_TIMESTAMP
-      auto latency_us = tx_sdu->get_latency_us().count();
-      mean_pdu_latency_us.push(latency_us);
-      RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
-               (uint64_t)latency_us,
-               (long)mean_pdu_latency_us.value());
-#else
-      RlcDebug("Complete SDU scheduled for tx.");
-#endif
-      tx_sdu.reset();
-    }
+    add_sdu_segment(to_move);
     pdu_space -= to_move;
   }
 
@@ -215,14 +187,37 @@ uint32_t rlc_um_lte::rlc_um_lte_tx::build_data_pdu(unique_byte_buffer_t pdu, uin
   vt_us     = (vt_us + 1) % cfg.um.tx_mod;
 
   // Add header and TX
-  rlc_um_write_data_pdu_header(&header, pdu.get());
-  memcpy(payload, pdu->msg, pdu->N_bytes);
+  uint32_t pdu_len = rlc_um_write_data_pdu_header(header, payload);
+  pdu_len += tx_segments.linearize(payload + pdu_len);
+  tx_segments.clear();
 
-  RlcHexInfo(payload, pdu->N_bytes, "Tx PDU SN=%d (%d B)", header.sn, pdu->N_bytes);
+  RlcHexInfo(payload, pdu_len, "Tx PDU SN=%d (%d B)", header.sn, pdu_len);
 
   debug_state();
 
-  return pdu->N_bytes;
+  return pdu_len;
+}
+
+void rlc_um_lte::rlc_um_lte_tx::add_sdu_segment(uint32_t to_move)
+{
+  if (tx_sdu->N_bytes > to_move) {
+    // The remainder of the SDU stays in tx_sdu for the next PDUs
+    tx_segments.append(tx_sdu->msg, to_move);
+    tx_sdu->N_bytes -= to_move;
+    tx_sdu->msg += to_move;
+    return;
+  }
+#ifdef ENABLE_TIMESTAMP
+  auto latency_us = tx_sdu->get_latency_us().count();
+  mean_pdu_latency_us.push(latency_us);
+  RlcDebug("Complete SDU scheduled for tx. Stack latency (last/average): %" PRIu64 "/%ld us",
+           (uint64_t)latency_us,
+           (long)mean_pdu_latency_us.value());
+#else
+  RlcDebug("Complete SDU scheduled for tx.");
+#endif
+  // The segment list releases the SDU once its bytes are copied into the PDU
+  tx_segments.append(std::move(tx_sdu), to_move);
 }
 
 void rlc_um_lte::rlc_um_lte_tx::debug_state()
@@ -761,52 +756,57 @@ void rlc_um_read_data_pdu_header(uint8_t*              payload,
 
 void rlc_um_write_data_pdu_header(rlc_umd_pdu_header_t* header, byte_buffer_t* pdu)
 {
-  uint32_t i;
-  uint8_t  ext = (header->N_li > 0) ? 1 : 0;
   // Make room for the header
   uint32_t len = rlc_um_packed_length(header);
   pdu->msg -= len;
-  uint8_t* ptr = pdu->msg;
+  pdu->N_bytes += rlc_um_write_data_pdu_header(*header, pdu->msg);
+}
+
+uint32_t rlc_um_write_data_pdu_header(const rlc_umd_pdu_header_t& header, uint8_t* payload)
+{
+  uint32_t i;
+  uint8_t  ext = (header.N_li > 0) ? 1 : 0;
+  uint8_t* ptr = payload;
 
   // Fixed part
-  if (header->sn_size == rlc_umd_sn_size_t::size5bits) {
-    *ptr = (header->fi & 0x03) << 6; // 2 bits FI
-    *ptr |= (ext & 0x01) << 5;       // 1 bit EXT
-    *ptr |= header->sn & 0x1F;       // 5 bits SN
+  if (header.sn_size == rlc_umd_sn_size_t::size5bits) {
+    *ptr = (header.fi & 0x03) << 6; // 2 bits FI
+    *ptr |= (ext & 0x01) << 5;      // 1 bit EXT
+    *ptr |= header.sn & 0x1F;       // 5 bits SN
     ptr++;
   } else {
-    *ptr = (header->fi & 0x03) << 3;   // 3 Reserved bits | 2 bits FI
-    *ptr |= (ext & 0x01) << 2;         // 1 bit EXT
-    *ptr |= (header->sn & 0x300) >> 8; // 2 bits SN
+    *ptr = (header.fi & 0x03) << 3;   // 3 Reserved bits | 2 bits FI
+    *ptr |= (ext & 0x01) << 2;        // 1 bit EXT
+    *ptr |= (header.sn & 0x300) >> 8; // 2 bits SN
     ptr++;
-    *ptr = (header->sn & 0xFF); // 8 bits SN
+    *ptr = (header.sn & 0xFF); // 8 bits SN
     ptr++;
   }
 
   // Extension part
   i = 0;
-  while (i < header->N_li) {
-    ext  = ((i + 1) == header->N_li) ? 0 : 1;
-    *ptr = (ext & 0x01) << 7;             // 1 bit header
-    *ptr |= (header->li[i] & 0x7F0) >> 4; // 7 bits of LI
+  while (i < header.N_li) {
+    ext  = ((i + 1) == header.N_li) ? 0 : 1;
+    *ptr = (ext & 0x01) << 7;            // 1 bit header
+    *ptr |= (header.li[i] & 0x7F0) >> 4; // 7 bits of LI
     ptr++;
-    *ptr = (header->li[i] & 0x00F) << 4; // 4 bits of LI
+    *ptr = (header.li[i] & 0x00F) << 4; // 4 bits of LI
     i++;
-    if (i < header->N_li) {
-      ext = ((i + 1) == header->N_li) ? 0 : 1;
-      *ptr |= (ext & 0x01) << 3;            // 1 bit header
-      *ptr |= (header->li[i] & 0x700) >> 8; // 3 bits of LI
+    if (i < header.N_li) {
+      ext = ((i + 1) == header.N_li) ? 0 : 1;
+      *ptr |= (ext & 0x01) << 3;           // 1 bit header
+      *ptr |= (header.li[i] & 0x700) >> 8; // 3 bits of LI
       ptr++;
-      *ptr = (header->li[i] & 0x0FF); // 8 bits of LI
+      *ptr = (header.li[i] & 0x0FF); // 8 bits of LI
       ptr++;
       i++;
     }
   }
   // Pad if N_li is odd
-  if (header->N_li % 2 == 1)
+  if (header.N_li % 2 == 1)
     ptr++;
 
-  pdu->N_bytes += ptr - pdu->msg;
+  return ptr - payload;
 }
 
 uint32_t rlc_um_packed_length(rlc_umd_pdu_header_t* header)
@@ -21,6 +21,7 @@
 
 #include "srsran/rlc/rlc_um_nr.h"
 #include "srsran/interfaces/ue_pdcp_interfaces.h"
+#include <algorithm>
 #include <sstream>
 
 #define RX_MOD_NR_BASE(x) (((x)-RX_Next_Highest - UM_Window_Size) % mod)
@@ -130,13 +131,14 @@ bool rlc_um_nr::rlc_um_nr_tx::configure(const rlc_config_t& cnfg_, std::string r
   head_len_segment = rlc_um_nr_packed_length(header);
 
   tx_sdu_queue.resize(cnfg_.tx_queue_length);
+  tx_sdu_queue.set_aqm(cnfg_.tx_aqm);
 
   rb_name = rb_name_;
 
   return true;
 }
 
-uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8_t* payload, uint32_t nof_bytes)
+uint32_t rlc_um_nr::rlc_um_nr_tx::pack_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   // Sanity check (we need at least 2B for a SDU)
   if (nof_bytes < 2) {
@@ -150,7 +152,7 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
   header.sn                          = TX_Next;
   header.sn_size                     = cfg.um_nr.sn_field_length;
 
-  uint32_t pdu_space = SRSRAN_MIN(nof_bytes, pdu->get_tailroom());
+  uint32_t pdu_space = nof_bytes;
 
   // Select segmentation information and header size
   if (tx_sdu == nullptr) {
@@ -162,6 +164,7 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
       RlcDebug("Cannot build any PDU, tx_sdu_queue has no non-null SDU.");
       return 0;
     }
+    trace_tx_sdu(*tx_sdu);
     next_so = 0;
 
     // Check for full SDU case
@@ -194,11 +197,10 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
   // Log
   RlcDebug("adding %s - (%d/%d)", to_string(header.si).c_str(), to_move, tx_sdu->N_bytes);
 
-  // Move data from SDU to PDU
-  uint8_t* pdu_ptr = pdu->msg;
-  memcpy(pdu_ptr, tx_sdu->msg, to_move);
-  pdu_ptr += to_move;
-  pdu->N_bytes += to_move;
+  // Add header and move data from SDU straight into the PDU
+  uint32_t ret = rlc_um_nr_write_data_pdu_header(header, payload);
+  memcpy(payload + ret, tx_sdu->msg, to_move);
+  ret += to_move;
   tx_sdu->N_bytes -= to_move;
   tx_sdu->msg += to_move;
 
@@ -216,20 +218,15 @@ uint32_t rlc_um_nr::rlc_um_nr_tx::build_data_pdu(unique_byte_buffer_t pdu, uint8
     next_so = 0;
   }
 
-  // Add header and TX
-  rlc_um_nr_write_data_pdu_header(header, pdu.get());
-  memcpy(payload, pdu->msg, pdu->N_bytes);
-  uint32_t ret = pdu->N_bytes;
-
   // Assert number of bytes
   srsran_expect(
       ret <= nof_bytes, "Error while packing MAC PDU (more bytes written (%d) than expected (%d)!", ret, nof_bytes);
 
   if (header.si == rlc_nr_si_field_t::full_sdu) {
     // log without SN
-    RlcHexInfo(payload, ret, "Tx PDU (%d B)", pdu->N_bytes);
+    RlcHexInfo(payload, ret, "Tx PDU (%d B)", ret);
   } else {
-    RlcHexInfo(payload, ret, "Tx PDU SN=%d (%d B)", header.sn, pdu->N_bytes);
+    RlcHexInfo(payload, ret, "Tx PDU SN=%d (%d B)", header.sn, ret);
   }
 
   debug_state();
@@ -263,6 +260,13 @@ bool rlc_um_nr::rlc_um_nr_rx::configure(const rlc_config_t& cnfg_, std::string r
 
   rb_name = rb_name_;
 
+  // The slots are indexed by SN modulo the SN space, so a new SN never takes the slot of one still in the window
+  if (cfg.um_nr.sn_field_length == rlc_um_nr_sn_size_t::size6bits) {
+    rx_window = std::unique_ptr<rlc_ringbuffer_base<rlc_umd_sdu_nr_t> >(new rlc_ringbuffer_t<rlc_umd_sdu_nr_t, 64>);
+  } else {
+    rx_window = std::unique_ptr<rlc_ringbuffer_base<rlc_umd_sdu_nr_t> >(new rlc_ringbuffer_t<rlc_umd_sdu_nr_t, 4096>);
+  }
+
   // check timer
   if (not reassembly_timer.is_valid()) {
     RlcError("Configuring RLC UM NR RX: timers not configured");
@@ -294,7 +298,9 @@ void rlc_um_nr::rlc_um_nr_rx::reset()
   rx_sdu.reset();
 
   // Drop all messages in RX window
-  rx_window.clear();
+  if (rx_window != nullptr) {
+    rx_window->clear();
+  }
 
   // stop timer
   if (reassembly_timer.is_valid()) {
@@ -330,13 +336,7 @@ void rlc_um_nr::rlc_um_nr_rx::timer_expired(uint32_t timeout_id)
     }
 
     // discard all segments with SN < updated RX_Next_Reassembly
-    for (auto it = rx_window.begin(); it != rx_window.end();) {
-      if (RX_MOD_NR_BASE(it->first) < RX_MOD_NR_BASE(RX_Next_Reassembly)) {
-        it = rx_window.erase(it);
-      } else {
-        ++it;
-      }
-    }
+    discard_sn_range((RX_Next_Highest + mod - UM_Window_Size) % mod, RX_Next_Reassembly, false);
 
     // check start of t_reassembly
     if (RX_MOD_NR_BASE(RX_Next_Highest) > RX_MOD_NR_BASE(RX_Next_Reassembly + 1) ||
@@ -388,117 +388,141 @@ bool rlc_um_nr::rlc_um_nr_rx::has_missing_byte_segment(const uint32_t sn)
 {
   // is at least one missing byte segment of the RLC SDU associated with SN = RX_Next_Reassembly before the last byte of
   // all received segments of this RLC SDU
-  return (rx_window.find(sn) != rx_window.end());
+  return rx_window->has_sn(sn);
 }
 
-// Sect 5.2.2.2.3
-void rlc_um_nr::rlc_um_nr_rx::handle_rx_buffer_update(const uint32_t sn)
+// Removes the SNs in [first_sn, end_sn) from the Rx window
+void rlc_um_nr::rlc_um_nr_rx::discard_sn_range(uint32_t first_sn, uint32_t end_sn, bool count_lost)
 {
-  if (rx_window.find(sn) != rx_window.end()) {
-    bool sdu_complete = false;
-
-    // iterate over received segments and try to assemble full SDU
-    auto& pdu = rx_window.at(sn);
-    for (auto it = pdu.segments.begin(); it != pdu.segments.end();) {
-      RlcDebug("Have %s segment with SO=%d for SN=%d",
-               to_string_short(it->second.header.si).c_str(),
-               it->second.header.so,
-               it->second.header.sn);
-      if (it->second.header.so == pdu.next_expected_so) {
-        if (pdu.next_expected_so == 0) {
-          if (pdu.sdu == nullptr) {
-            // reuse buffer of first segment for final SDU
-            pdu.sdu              = std::move(it->second.buf);
-            pdu.next_expected_so = pdu.sdu->N_bytes;
-            RlcDebug("Reusing first segment of SN=%d for final SDU", it->second.header.sn);
-            it = pdu.segments.erase(it);
-          } else {
-            RlcDebug("SDU buffer already allocated. Possible retransmission of first segment.");
-            if (it->second.header.so != pdu.next_expected_so) {
-              RlcError("Invalid PDU. SO doesn't match. Discarding all segments of SN=%d.", sn);
-              rx_window.erase(sn);
-              return;
-            }
-          }
-        } else {
-          if (it->second.buf->N_bytes > pdu.sdu->get_tailroom()) {
-            RlcError("Cannot fit RLC PDU in SDU buffer (tailroom=%d, len=%d), dropping both. Erasing SN=%d.",
-                     rx_sdu->get_tailroom(),
-                     it->second.buf->N_bytes,
-                     it->second.header.sn);
-            rx_window.erase(sn);
-            metrics.num_lost_pdus++;
-            return;
-          }
+  for (uint32_t sn = first_sn; sn != end_sn; sn = (sn + 1) % mod) {
+    if (rx_window->has_sn(sn)) {
+      if (count_lost) {
+        RlcInfo("SN=%d outside rx window [%d:%d] - discarding", sn, RX_Next_Highest - UM_Window_Size, RX_Next_Highest);
+        metrics.num_lost_pdus++;
+      }
+      rx_window->remove_pdu(sn);
+    }
+  }
+}
+
+// Copies the payload of a segment in place into the SDU buffer of its SN, which is reserved by the first segment
+bool rlc_um_nr::rlc_um_nr_rx::place_segment(const rlc_um_nr_pdu_header_t& header,
+                                            const uint8_t*                payload,
+                                            const uint32_t                nof_bytes)
+{
+  uint32_t header_len = rlc_um_nr_packed_length(header);
+  if (nof_bytes <= header_len) {
+    RlcWarning("Discarding segment of SN=%d without payload", header.sn);
+    return false;
+  }
+  srsran::interval<uint32_t> range(header.so, header.so + nof_bytes - header_len);
+
+  if (not rx_window->has_sn(header.sn)) {
+    rlc_umd_sdu_nr_t& new_sdu = rx_window->add_pdu(header.sn);
+    new_sdu.sdu               = make_byte_buffer();
+    if (new_sdu.sdu == nullptr) {
+      RlcError("Couldn't allocate SDU in %s().", __FUNCTION__);
+      rx_window->remove_pdu(header.sn);
+      return false;
+    }
+  }
+  rlc_umd_sdu_nr_t& rx_pdu = (*rx_window)[header.sn];
+
+  if (range.stop() > rx_pdu.sdu->get_tailroom()) {
+    RlcError("Cannot fit SO=%d (%d B) in SDU buffer (tailroom=%d). Erasing SN=%d.",
+             header.so,
+             range.length(),
+             rx_pdu.sdu->get_tailroom(),
+             header.sn);
+    rx_window->remove_pdu(header.sn);
+    metrics.num_lost_pdus++;
+    return false;
+  }
 
-          // add this segment to the end of the SDU buffer
-          memcpy(pdu.sdu->msg + pdu.sdu->N_bytes, it->second.buf->msg, it->second.buf->N_bytes);
-          pdu.sdu->N_bytes += it->second.buf->N_bytes;
-          pdu.next_expected_so += it->second.buf->N_bytes;
-          RlcDebug("Appended SO=%d of SN=%d", it->second.header.so, it->second.header.sn);
-          it = pdu.segments.erase(it);
+  // Find the first received range that does not end before the segment, it is either adjacent or after it
+  auto it = rx_pdu.ranges.begin();
+  while (it != rx_pdu.ranges.end() and it->stop() < range.start()) {
+    ++it;
+  }
+  if (it != rx_pdu.ranges.end() and it->overlaps(range)) {
+    RlcInfo("Discarding duplicate SO=%d of SN=%d", header.so, header.sn);
+    return false;
+  }
 
-          if (pdu.next_expected_so == pdu.total_sdu_length) {
-            // entire SDU has been received, it will be passed up the stack outside the loop
-            sdu_complete = true;
-            break;
-          }
-        }
-      } else {
-        // handle next segment
-        ++it;
-      }
+  if (it != rx_pdu.ranges.end() and it->stop() == range.start()) {
+    // Extend the preceding range, which may now reach the next one
+    it->set(it->start(), range.stop());
+    auto next = it + 1;
+    if (next != rx_pdu.ranges.end() and next->start() == it->stop()) {
+      it->set(it->start(), next->stop());
+      rx_pdu.ranges.erase(next);
+    }
+  } else if (it != rx_pdu.ranges.end() and it->start() == range.stop()) {
+    it->set(range.start(), it->stop());
+  } else {
+    if (rx_pdu.ranges.full()) {
+      RlcWarning("Too many gaps in the segments of SN=%d. Erasing SN=%d.", header.sn, header.sn);
+      rx_window->remove_pdu(header.sn);
+      metrics.num_lost_pdus++;
+      return false;
     }
+    size_t pos = it - rx_pdu.ranges.begin();
+    rx_pdu.ranges.push_back(range);
+    std::rotate(rx_pdu.ranges.begin() + pos, rx_pdu.ranges.end() - 1, rx_pdu.ranges.end());
+  }
+
+  memcpy(rx_pdu.sdu->msg + range.start(), payload + header_len, range.length());
+  if (header.si == rlc_nr_si_field_t::last_segment) {
+    rx_pdu.total_sdu_length = range.stop();
+    RlcDebug("updating total SDU length for SN=%d to %d B", header.sn, rx_pdu.total_sdu_length);
+  }
+  RlcDebug("Placed %s segment SO=%d of SN=%d (%d B)",
+           to_string_short(header.si).c_str(),
+           header.so,
+           header.sn,
+           range.length());
+  return true;
+}
+
+// Sect 5.2.2.2.3
+void rlc_um_nr::rlc_um_nr_rx::handle_rx_buffer_update(const uint32_t sn)
+{
+  if (rx_window->has_sn(sn)) {
+    rlc_umd_sdu_nr_t& pdu = (*rx_window)[sn];
 
-    if (sdu_complete) {
+    if (pdu.fully_received()) {
       // deliver full SDU to upper layers
+      pdu.sdu->N_bytes = pdu.total_sdu_length;
       RlcInfo("Rx SDU (%d B)", pdu.sdu->N_bytes);
       pdcp->write_pdu(lcid, std::move(pdu.sdu));
 
       // delete PDU from rx_window
-      rx_window.erase(sn);
+      rx_window->remove_pdu(sn);
 
-      // find next SN in rx buffer
+      // find next SN in rx buffer, or RX_Next_Highest if no further segments were received
       if (sn == RX_Next_Reassembly) {
-        if (rx_window.empty()) {
-          // no further segments received
-          RX_Next_Reassembly = RX_Next_Highest;
-        } else {
-          for (auto it = rx_window.begin(); it != rx_window.end(); ++it) {
-            RlcDebug("SN=%d has %zd segments", it->first, it->second.segments.size());
-            if (RX_MOD_NR_BASE(it->first) > RX_MOD_NR_BASE(RX_Next_Reassembly)) {
-              RX_Next_Reassembly = it->first;
-              break;
-            }
-          }
-        }
+        do {
+          RX_Next_Reassembly = (RX_Next_Reassembly + 1) % mod;
+        } while (RX_Next_Reassembly != RX_Next_Highest and not rx_window->has_sn(RX_Next_Reassembly));
         RlcDebug("Updating RX_Next_Reassembly=%d", RX_Next_Reassembly);
       }
     } else if (not sn_in_reassembly_window(sn)) {
       // SN outside of rx window
 
-      RX_Next_Highest = (sn + 1) % mod; // update RX_Next_highest
+      uint32_t old_lower_edge = (RX_Next_Highest + mod - UM_Window_Size) % mod;
+      RX_Next_Highest         = (sn + 1) % mod; // update RX_Next_highest
+      uint32_t new_lower_edge = (RX_Next_Highest + mod - UM_Window_Size) % mod;
       RlcDebug("Updating RX_Next_Highest=%d", RX_Next_Highest);
 
-      // drop all SNs outside of new rx window
-      for (auto it = rx_window.begin(); it != rx_window.end();) {
-        if (not sn_in_reassembly_window(it->first)) {
-          RlcInfo("SN=%d outside rx window [%d:%d] - discarding",
-                  it->first,
-                  RX_Next_Highest - UM_Window_Size,
-                  RX_Next_Highest);
-          it = rx_window.erase(it);
-          metrics.num_lost_pdus++;
-        } else {
-          ++it;
-        }
-      }
+      // drop all SNs outside of new rx window, which can only be those below the new lower edge of the window
+      uint32_t nof_out = std::min((new_lower_edge + mod - old_lower_edge) % mod, UM_Window_Size);
+      discard_sn_range(old_lower_edge, (old_lower_edge + nof_out) % mod, true);
 
       if (not sn_in_reassembly_window(RX_Next_Reassembly)) {
         // update RX_Next_Reassembly to first SN that has not been reassembled and delivered
-        for (const auto& rx_pdu : rx_window) {
-          if (rx_pdu.first >= RX_MOD_NR_BASE(RX_Next_Highest - UM_Window_Size)) {
-            RX_Next_Reassembly = rx_pdu.first;
+        for (uint32_t rx_sn = new_lower_edge; rx_sn != RX_Next_Highest; rx_sn = (rx_sn + 1) % mod) {
+          if (rx_window->has_sn(rx_sn)) {
+            RX_Next_Reassembly = rx_sn;
             RlcDebug("Updating RX_Next_Reassembly=%d", RX_Next_Reassembly);
             break;
           }
@@ -529,15 +553,6 @@ void rlc_um_nr::rlc_um_nr_rx::handle_rx_buffer_update(const uint32_t sn)
   }
 }
 
-inline void rlc_um_nr::rlc_um_nr_rx::update_total_sdu_length(rlc_umd_pdu_segments_nr_t& pdu_segments,
-                                                             const rlc_umd_pdu_nr_t&    rx_pdu)
-{
-  if (rx_pdu.header.si == rlc_nr_si_field_t::last_segment) {
-    pdu_segments.total_sdu_length = rx_pdu.header.so + rx_pdu.buf->N_bytes;
-    RlcDebug("updating total SDU length for SN=%d to %d B", rx_pdu.header.sn, pdu_segments.total_sdu_length);
-  }
-};
-
 // Section 5.2.2.2.2
 void rlc_um_nr::rlc_um_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
@@ -558,43 +573,7 @@ void rlc_um_nr::rlc_um_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_byt
   } else if (sn_invalid_for_rx_buffer(header.sn)) {
     RlcInfo("Discarding SN=%d", header.sn);
     // Nothing else to do here ..
-  } else {
-    // place PDU in receive buffer
-    rlc_umd_pdu_nr_t rx_pdu = {};
-    rx_pdu.header           = header;
-    rx_pdu.buf              = rlc_um_nr_strip_pdu_header(header, payload, nof_bytes);
-
-    // check if this SN is already present in rx buffer
-    if (rx_window.find(header.sn) == rx_window.end()) {
-      // first received segment of this SN, add to rx buffer
-      RlcHexDebug(rx_pdu.buf->msg,
-                  rx_pdu.buf->N_bytes,
-                  "placing %s segment of SN=%d (%d B) in Rx buffer",
-                  to_string_short(header.si).c_str(),
-                  header.sn,
-                  rx_pdu.buf->N_bytes);
-      rlc_umd_pdu_segments_nr_t pdu_segments = {};
-      update_total_sdu_length(pdu_segments, rx_pdu);
-      pdu_segments.segments.emplace(header.so, std::move(rx_pdu));
-      rx_window[header.sn] = std::move(pdu_segments);
-    } else {
-      // other segment for this SN already present, update received data
-      RlcHexDebug(rx_pdu.buf->msg,
-                  rx_pdu.buf->N_bytes,
-                  "updating SN=%d at SO=%d with %d B",
-                  rx_pdu.header.sn,
-                  rx_pdu.header.so,
-                  rx_pdu.buf->N_bytes);
-
-      auto& pdu_segments = rx_window.at(header.sn);
-
-      // calculate total SDU length
-      update_total_sdu_length(pdu_segments, rx_pdu);
-
-      // append to list of segments
-      pdu_segments.segments.emplace(header.so, std::move(rx_pdu));
-    }
-
+  } else if (place_segment(header, payload, nof_bytes)) {
     // handle received segments
     handle_rx_buffer_update(header.sn);
   }
@@ -711,7 +690,14 @@ uint32_t rlc_um_nr_write_data_pdu_header(const rlc_um_nr_pdu_header_t& header, b
   // Make room for the header
   uint32_t len = rlc_um_nr_packed_length(header);
   pdu->msg -= len;
-  uint8_t* ptr = pdu->msg;
+  pdu->N_bytes += rlc_um_nr_write_data_pdu_header(header, pdu->msg);
+
+  return len;
+}
+
+uint32_t rlc_um_nr_write_data_pdu_header(const rlc_um_nr_pdu_header_t& header, uint8_t* payload)
+{
+  uint8_t* ptr = payload;
 
   // write SI field
   *ptr = (header.si & 0x03) << 6; // 2 bits SI
@@ -740,9 +726,7 @@ uint32_t rlc_um_nr_write_data_pdu_header(const rlc_um_nr_pdu_header_t& header, b
     }
   }
 
-  pdu->N_bytes += ptr - pdu->msg;
-
-  return len;
+  return ptr - payload;
 }
 
 } // namespace srsran
@@ -132,6 +132,14 @@ void backend_worker::process_log_entry(detail::log_entry&& entry)
 {
   // Check first for flush commands.
   if (entry.flush_cmd) {
+    // Entries pushed by other threads before the flush may still be queued behind it, process them first.
+    for (size_t n = queue.size(); n > 0; --n) {
+      auto item = queue.try_pop();
+      if (!item.first) {
+        break;
+      }
+      process_log_entry(std::move(item.second));
+    }
     process_flush_command(*entry.flush_cmd);
     return;
   }
@@ -100,9 +100,11 @@ private:
   {
     if (queue.is_almost_full()) {
       err_handler(fmt::format("The backend queue size is about to reach its maximum "
-                              "capacity of {} elements, new log entries will get "
+                              "capacity of {} elements (plus {} elements per logging "
+                              "thread), new log entries will get "
                               "discarded.\nConsider increasing the queue capacity.",
-                              queue.get_capacity()));
+                              queue.get_capacity(),
+                              queue.get_ring_capacity()));
       err_handler = [](const std::string&) {};
     }
   }
@@ -0,0 +1,232 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_ASYNC_FILE_SINK_H
+#define SRSLOG_ASYNC_FILE_SINK_H
+
+#include "file_utils.h"
+#include "srsran/srslog/sink.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace srslog {
+
+/// This sink implementation writes to files from a helper thread, so that the backend thread never blocks on file IO.
+/// The input data is appended to a front buffer that the helper thread swaps with its back buffer and writes to the
+/// file once it is half full, or periodically. Includes the optional features of file rotation by size and by time: a
+/// new file is created when the file size exceeds an established threshold, or when the rotation period expires.
+/// Rotation happens between writes, so a file may exceed the threshold by the size of a buffer.
+class async_file_sink : public sink
+{
+public:
+  async_file_sink(std::string                    name,
+                  size_t                         max_size,
+                  std::chrono::seconds           rotation_period,
+                  size_t                         buffer_capacity,
+                  std::unique_ptr<log_formatter> f) :
+    sink(std::move(f)),
+    max_size((max_size == 0) ? 0 : std::max<size_t>(max_size, 4 * 1024)),
+    rotation_period(rotation_period),
+    base_filename(std::move(name)),
+    capacity(std::max<size_t>(buffer_capacity, 4 * 1024))
+  {
+    front_buffer.reserve(capacity);
+    back_buffer.reserve(capacity);
+    writer = std::thread([this]() { run_writer(); });
+  }
+
+  ~async_file_sink() override
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      running = false;
+    }
+    cvar_writer.notify_one();
+    writer.join();
+  }
+
+  async_file_sink(const async_file_sink& other) = delete;
+  async_file_sink& operator=(const async_file_sink& other) = delete;
+
+  detail::error_string write(detail::memory_buffer buffer) override
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!writer_error.empty()) {
+      return take_error();
+    }
+
+    // The front buffer grows while the helper thread is busy. Beyond a limit, wait for it to avoid exhausting memory.
+    cvar_sink.wait(lock, [this, &buffer]() {
+      return front_buffer.size() + buffer.size() <= max_pending_factor * capacity or front_buffer.empty();
+    });
+    front_buffer.insert(front_buffer.end(), buffer.begin(), buffer.end());
+
+    if (front_buffer.size() >= capacity / 2) {
+      lock.unlock();
+      cvar_writer.notify_one();
+    }
+    return {};
+  }
+
+  detail::error_string flush() override
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    flush_requested = true;
+    cvar_writer.notify_one();
+    cvar_sink.wait(lock, [this]() { return !flush_requested; });
+    return take_error();
+  }
+
+protected:
+  /// Returns the current file index.
+  /// NOTE: Only valid after a flush.
+  uint32_t get_file_index() const { return file_index; }
+
+private:
+  /// Maximum size of the pending data, in number of buffer capacities.
+  static constexpr size_t max_pending_factor = 8;
+
+  /// Returns and clears the last error reported by the helper thread.
+  /// NOTE: The mutex must be held.
+  detail::error_string take_error()
+  {
+    if (writer_error.empty()) {
+      return {};
+    }
+    std::string err;
+    std::swap(err, writer_error);
+    return err;
+  }
+
+  void run_writer()
+  {
+    // Period after which the pending data is written even if the buffer is not half full.
+    const std::chrono::milliseconds write_period{100};
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cvar_writer.wait_for(lock, write_period, [this]() {
+        return !running or flush_requested or front_buffer.size() >= capacity / 2;
+      });
+
+      bool do_flush = flush_requested;
+      bool stop     = !running;
+      std::swap(front_buffer, back_buffer);
+      cvar_sink.notify_all();
+
+      // Write without holding the mutex, so that the backend can keep appending to the front buffer.
+      lock.unlock();
+      auto err = write_back_buffer(do_flush or stop);
+      lock.lock();
+
+      if (err) {
+        writer_error = err.get_error();
+      }
+      if (do_flush and front_buffer.empty()) {
+        flush_requested = false;
+        cvar_sink.notify_all();
+      }
+      if (stop and front_buffer.empty()) {
+        return;
+      }
+    }
+  }
+
+  /// Writes the back buffer into the file, rotating it when needed.
+  /// NOTE: Only called from the helper thread.
+  detail::error_string write_back_buffer(bool flush_file)
+  {
+    if (!back_buffer.empty()) {
+      if (auto err_str = handle_rotation(back_buffer.size())) {
+        back_buffer.clear();
+        return err_str;
+      }
+      auto err_str = handler.write(detail::memory_buffer(back_buffer.data(), back_buffer.size()));
+      back_buffer.clear();
+      if (err_str) {
+        return err_str;
+      }
+      // Shrink the buffer back if it grew while the writer was busy.
+      if (back_buffer.capacity() > capacity) {
+        std::vector<char>().swap(back_buffer);
+        back_buffer.reserve(capacity);
+      }
+    }
+    if (flush_file) {
+      return handler.flush();
+    }
+    return {};
+  }
+
+  /// Creates the first file, or a new one when the file size or the file age exceeds the configured limits.
+  detail::error_string handle_rotation(size_t size)
+  {
+    auto now = std::chrono::steady_clock::now();
+    if (file_index == 0) {
+      file_creation_tp = now;
+      current_size     = size;
+      return create_file();
+    }
+
+    current_size += size;
+    bool size_exceeded = max_size && current_size > max_size;
+    bool time_exceeded = rotation_period.count() > 0 && now - file_creation_tp >= rotation_period;
+    if (size_exceeded or time_exceeded) {
+      file_creation_tp = now;
+      current_size     = size;
+      return create_file();
+    }
+    return {};
+  }
+
+  /// Creates a new file and increments the file index counter.
+  detail::error_string create_file()
+  {
+    return handler.create(file_utils::build_filename_with_index(base_filename, file_index++));
+  }
+
+private:
+  const size_t                          max_size;
+  const std::chrono::seconds            rotation_period;
+  const std::string                     base_filename;
+  const size_t                          capacity;
+  std::mutex                            mutex;
+  std::condition_variable               cvar_writer;
+  std::condition_variable               cvar_sink;
+  std::vector<char>                     front_buffer;
+  bool                                  running         = true;
+  bool                                  flush_requested = false;
+  std::string                           writer_error;
+  std::thread                           writer;
+  // Only accessed by the helper thread.
+  std::vector<char>                     back_buffer;
+  file_utils::file                      handler;
+  size_t                                current_size = 0;
+  uint32_t                              file_index   = 0;
+  std::chrono::steady_clock::time_point file_creation_tp;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_ASYNC_FILE_SINK_H
@@ -21,6 +21,7 @@
 
 #include "srsran/srslog/srslog.h"
 #include "formatters/json_formatter.h"
+#include "sinks/async_file_sink.h"
 #include "sinks/file_sink.h"
 #include "sinks/syslog_sink.h"
 #include "srslog_instance.h"
@@ -178,6 +179,30 @@ sink& srslog::fetch_file_sink(const std::string&             path,
   return *s;
 }
 
+sink& srslog::fetch_async_file_sink(const std::string&             path,
+                                    size_t                         max_size,
+                                    std::chrono::seconds           rotation_period,
+                                    std::unique_ptr<log_formatter> f)
+{
+  assert(!path.empty() && "Empty path string");
+
+  if (auto* s = find_sink(path)) {
+    return *s;
+  }
+
+  /// Capacity of each of the two buffers of the sink.
+  constexpr size_t buffer_capacity = 1024 * 1024;
+
+  //: TODO: GCC5 or lower versions emits an error if we use the new() expression
+  // directly, use redundant piecewise_construct instead.
+  auto& s = srslog_instance::get().get_sink_repo().emplace(
+      std::piecewise_construct,
+      std::forward_as_tuple(path),
+      std::forward_as_tuple(new async_file_sink(path, max_size, rotation_period, buffer_capacity, std::move(f))));
+
+  return *s;
+}
+
 sink& srslog::fetch_syslog_sink(const std::string&             preamble_,
                                 syslog_local_type              log_local_,
                                 std::unique_ptr<log_formatter> f)
@@ -20,6 +20,9 @@
  */
 
 #include "srsran/system/sys_metrics_processor.h"
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
 #include <fstream>
 #include <sstream>
 #include <sys/sysinfo.h>
@@ -92,6 +95,9 @@ sys_metrics_t sys_metrics_processor::get_metrics()
   // Calculate cpu metrics.
   calculate_cpu_metrics(metrics, measure_interval_ms / 1000.f);
 
+  // Calculate the metrics of each thread.
+  calculate_thread_metrics(metrics, measure_interval_ms / 1000.f);
+
   // Get the stats from the proc.
   proc_stats_info current_query;
   metrics.thread_count      = current_query.num_threads;
@@ -121,6 +127,107 @@ float sys_metrics_processor::calculate_cpu_usage(const proc_stats_info& current_
          (cpu_count * ticks_per_second * delta_time_in_seconds);
 }
 
+/// Reads the cumulative counters of the given thread. Returns false if the thread is gone.
+static bool read_thread_stats(const std::string& task_dir, sys_metrics_processor::thread_stats_info& info)
+{
+  std::string line;
+  {
+    std::ifstream file(task_dir + "/stat");
+    if (!file || !std::getline(file, line)) {
+      return false;
+    }
+  }
+
+  // The name goes between parenthesis and may contain spaces, the fields are read from the closing one.
+  std::size_t name_start = line.find('(');
+  std::size_t name_end   = line.rfind(')');
+  if (name_start == std::string::npos || name_end == std::string::npos || name_end < name_start) {
+    return false;
+  }
+  info.name = line.substr(name_start + 1, name_end - name_start - 1);
+
+  // Skip from the state field up to cmajflt to get to utime and stime.
+  std::istringstream reader(line.substr(name_end + 1));
+  std::string        skip;
+  for (unsigned i = 0; i != 11; ++i) {
+    reader >> skip;
+  }
+  reader >> info.utime >> info.stime;
+
+  // The second field of the schedstat is the time spent waiting in a run queue, in ns.
+  {
+    std::ifstream file(task_dir + "/schedstat");
+    uint64_t      run_ns = 0;
+    if (file) {
+      file >> run_ns >> info.runqueue_delay_ns;
+    }
+  }
+
+  std::ifstream file(task_dir + "/status");
+  while (std::getline(file, line)) {
+    std::istringstream status_reader(line);
+    std::string        label;
+    status_reader >> label;
+    if (label == "voluntary_ctxt_switches:") {
+      status_reader >> info.voluntary_ctxt_switches;
+    } else if (label == "nonvoluntary_ctxt_switches:") {
+      status_reader >> info.nonvoluntary_ctxt_switches;
+    }
+  }
+
+  return true;
+}
+
+/// Returns the increase of a cumulative counter, clamped to zero.
+template <typename T>
+static T counter_delta(T current, T last)
+{
+  return (current >= last) ? current - last : 0;
+}
+
+void sys_metrics_processor::calculate_thread_metrics(sys_metrics_t& metrics, float delta_time_in_seconds)
+{
+  DIR* dir = ::opendir("/proc/self/task");
+  if (dir == nullptr) {
+    return;
+  }
+
+  std::map<uint32_t, thread_stats_info> current_query;
+  while (const struct dirent* entry = ::readdir(dir)) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    }
+
+    thread_stats_info info;
+    if (!read_thread_stats(std::string("/proc/self/task/") + entry->d_name, info)) {
+      continue;
+    }
+    uint32_t tid = std::strtoul(entry->d_name, nullptr, 10);
+
+    // Threads created during this period are reported from the next one, when there is a reference to compare to. A
+    // different name means that the tid has been reused by another thread.
+    auto last = last_thread_query.find(tid);
+    if (last != last_thread_query.end() && last->second.name == info.name &&
+        metrics.nof_threads < metrics_max_supported_threads) {
+      const thread_stats_info& prev = last->second;
+      sys_thread_metrics_t&    m    = metrics.threads[metrics.nof_threads++];
+
+      std::strncpy(m.name.data(), info.name.c_str(), m.name.size() - 1);
+      m.tid       = tid;
+      m.cpu_usage = (counter_delta(info.utime, prev.utime) + counter_delta(info.stime, prev.stime)) * 100.f /
+                    (ticks_per_second * delta_time_in_seconds);
+      m.voluntary_ctxt_switches    = counter_delta(info.voluntary_ctxt_switches, prev.voluntary_ctxt_switches);
+      m.nonvoluntary_ctxt_switches = counter_delta(info.nonvoluntary_ctxt_switches, prev.nonvoluntary_ctxt_switches);
+      m.runqueue_delay_us          = counter_delta(info.runqueue_delay_ns, prev.runqueue_delay_ns) / 1000;
+    }
+
+    current_query.emplace(tid, std::move(info));
+  }
+  ::closedir(dir);
+
+  last_thread_query = std::move(current_query);
+}
+
 sys_metrics_processor::cpu_metrics_t sys_metrics_processor::read_cpu_idle_from_line(const std::string& line) const
 {
   std::istringstream reader(line);
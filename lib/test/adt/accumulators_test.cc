@@ -0,0 +1,109 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/accumulators.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+struct test_metrics {
+  uint64_t nof_updates = 0;
+  uint64_t sum         = 0;
+
+  test_metrics& operator+=(const test_metrics& other)
+  {
+    nof_updates += other.nof_updates;
+    sum += other.sum;
+    return *this;
+  }
+};
+
+void test_snapshot_accumulator_single_thread()
+{
+  snapshot_accumulator<test_metrics, 2> acc;
+  TESTASSERT_EQ(0, acc.snapshot().nof_updates);
+
+  for (uint32_t i = 0; i < 10; ++i) {
+    acc.update([i](test_metrics& m) {
+      m.nof_updates++;
+      m.sum += i;
+    });
+  }
+  test_metrics m = acc.snapshot();
+  TESTASSERT_EQ(10, m.nof_updates);
+  TESTASSERT_EQ(45, m.sum);
+
+  // The metrics are reset after each snapshot
+  TESTASSERT_EQ(0, acc.snapshot().nof_updates);
+  acc.update([](test_metrics& m) { m.nof_updates++; });
+  TESTASSERT_EQ(1, acc.snapshot().nof_updates);
+  TESTASSERT_EQ(0, acc.snapshot().nof_updates);
+}
+
+// The writers are more than MaxThreads, so some of them share the locked buffers
+void test_snapshot_accumulator_concurrent()
+{
+  const uint32_t nof_writers = 6, nof_updates = 100000;
+
+  snapshot_accumulator<test_metrics, 4> acc;
+  std::atomic<uint32_t>                 nof_running{nof_writers};
+  std::vector<std::thread>              writers;
+  for (uint32_t w = 0; w < nof_writers; ++w) {
+    writers.emplace_back([&acc, &nof_running]() {
+      for (uint32_t i = 0; i < nof_updates; ++i) {
+        acc.update([i](test_metrics& m) {
+          m.nof_updates++;
+          m.sum += i;
+        });
+      }
+      nof_running--;
+    });
+  }
+
+  test_metrics total;
+  uint32_t     nof_snapshots = 0;
+  while (nof_running > 0) {
+    test_metrics m = acc.snapshot();
+    TESTASSERT(m.nof_updates <= nof_writers * nof_updates);
+    total += m;
+    nof_snapshots++;
+  }
+  for (std::thread& t : writers) {
+    t.join();
+  }
+  total += acc.snapshot();
+
+  // No update is lost or counted twice, regardless of when the snapshots were taken
+  TESTASSERT_EQ(nof_writers * nof_updates, total.nof_updates);
+  TESTASSERT_EQ(nof_writers * (uint64_t)nof_updates * (nof_updates - 1) / 2, total.sum);
+  TESTASSERT(nof_snapshots > 0);
+}
+
+} // namespace srsran
+
+int main()
+{
+  srsran::test_snapshot_accumulator_single_thread();
+  srsran::test_snapshot_accumulator_concurrent();
+  return 0;
+}
@@ -278,6 +278,39 @@ void test_bitset_find()
   }
 }
 
+template <bool reversed>
+void test_bitset_ranges()
+{
+  // Ranges within a word, ending at a word boundary and spanning several words
+  const size_t ranges[][2] = {{0, 0}, {3, 9}, {0, 64}, {60, 70}, {64, 128}, {10, 150}, {127, 129}, {149, 150}};
+
+  for (const auto& r : ranges) {
+    srsran::bounded_bitset<150, reversed> bitset(150);
+    bitset.fill(r[0], r[1]);
+    TESTASSERT(bitset.count() == r[1] - r[0]);
+    for (size_t i = 0; i < bitset.size(); ++i) {
+      TESTASSERT(bitset.test(i) == (i >= r[0] and i < r[1]));
+    }
+    TESTASSERT(bitset.any(r[0], r[1]) == (r[1] > r[0]));
+    TESTASSERT(not bitset.any(0, r[0]));
+    TESTASSERT(not bitset.any(r[1], bitset.size()));
+
+    bitset.flip();
+    TESTASSERT(bitset.count() == bitset.size() - (r[1] - r[0]));
+    TESTASSERT(not bitset.any(r[0], r[1]));
+    bitset.fill(0, bitset.size(), false);
+    TESTASSERT(bitset.none());
+  }
+
+  // Clearing a range only touches the range
+  srsran::bounded_bitset<150, reversed> bitset(150);
+  bitset.fill(0, bitset.size());
+  bitset.fill(60, 70, false);
+  TESTASSERT(bitset.count() == 140);
+  TESTASSERT(bitset.test(59) and not bitset.test(60) and not bitset.test(69) and bitset.test(70));
+  TESTASSERT(bitset.any(0, 61) and not bitset.any(60, 70) and bitset.any(69, 71));
+}
+
 int main()
 {
   test_bit_operations();
@@ -289,6 +322,8 @@ int main()
   TESTASSERT(test_bitset_resize() == SRSRAN_SUCCESS);
   test_bitset_find<false>();
   test_bitset_find<true>();
+  test_bitset_ranges<false>();
+  test_bitset_ranges<true>();
   printf("Success\n");
   return 0;
 }
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/flat_hash_map.h"
+#include "srsran/common/test_common.h"
+#include <map>
+#include <random>
+
+namespace srsran {
+
+void test_flat_hash_map_basic()
+{
+  flat_hash_map<uint32_t, std::string> map;
+  TESTASSERT(map.empty() and map.size() == 0);
+  TESTASSERT(map.find(0) == nullptr and not map.contains(5));
+
+  map.insert_or_assign(0, "obj0");
+  map.insert_or_assign(5, "obj5");
+  TESTASSERT(map.size() == 2 and not map.empty());
+  TESTASSERT(*map.find(0) == "obj0" and *map.find(5) == "obj5");
+
+  // Values are replaced
+  map.insert_or_assign(5, "new5");
+  TESTASSERT(map.size() == 2 and *map.find(5) == "new5");
+
+  TESTASSERT(map.erase(0));
+  TESTASSERT(not map.erase(0));
+  TESTASSERT(map.size() == 1 and not map.contains(0) and map.contains(5));
+
+  map.clear();
+  TESTASSERT(map.empty() and not map.contains(5));
+}
+
+// Compares with std::map, with keys that collide in the low and high bits
+void test_flat_hash_map_random()
+{
+  std::mt19937                            rgen(1234);
+  flat_hash_map<uint32_t, uint32_t>       map;
+  std::map<uint32_t, uint32_t>            ref;
+  std::uniform_int_distribution<int>      op_dist(0, 2);
+  std::uniform_int_distribution<uint32_t> key_dist(0, 1023);
+
+  for (uint32_t i = 0; i < 100000; ++i) {
+    uint32_t key = key_dist(rgen);
+    key          = (i % 2 == 0) ? key << 22 : key;
+    switch (op_dist(rgen)) {
+      case 0:
+      case 1:
+        map.insert_or_assign(key, i);
+        ref[key] = i;
+        break;
+      default:
+        TESTASSERT(map.erase(key) == (ref.erase(key) > 0));
+        break;
+    }
+    TESTASSERT(map.size() == ref.size());
+  }
+  TESTASSERT(map.capacity() >= 2 * map.size());
+  for (const auto& p : ref) {
+    TESTASSERT(map.find(p.first) != nullptr and *map.find(p.first) == p.second);
+  }
+  for (uint32_t i = 0; i < 1024; ++i) {
+    TESTASSERT(map.contains(i) == (ref.count(i) > 0));
+    TESTASSERT(map.contains(i << 22) == (ref.count(i << 22) > 0));
+  }
+}
+
+} // namespace srsran
+
+int main()
+{
+  srsran::test_flat_hash_map_basic();
+  srsran::test_flat_hash_map_random();
+  return 0;
+}
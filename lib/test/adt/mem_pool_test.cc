@@ -117,7 +117,13 @@ void test_fixedsize_pool()
     }
     std::unique_ptr<BigObj> obj(new (std::nothrow) BigObj());
     TESTASSERT(obj == nullptr);
+    srsran::pool_metrics_t m = fixed_pool->get_metrics("big_obj");
+    TESTASSERT_EQ(pool_size, m.capacity);
+    TESTASSERT_EQ(pool_size, m.in_use);
+    TESTASSERT_EQ(pool_size, m.high_water);
+    TESTASSERT_EQ(1, m.nof_alloc_failures);
     vec.clear();
+    TESTASSERT_EQ(0, fixed_pool->get_metrics("big_obj").in_use);
     obj = std::unique_ptr<BigObj>(new (std::nothrow) BigObj());
     TESTASSERT(obj != nullptr);
     obj.reset();
@@ -177,6 +183,14 @@ void test_background_pool()
 
     // This will trigger a new batch allocation in the background
     objs.push_back(obj_pool.make());
+
+    srsran::pool_metrics_t m = obj_pool.get_metrics("D");
+    TESTASSERT_EQ(16 - 4 + 1, m.in_use);
+    TESTASSERT_EQ(m.in_use, m.high_water);
+    TESTASSERT_EQ(m.nof_allocs, m.nof_cache_hits);
+    objs.pop_back();
+    TESTASSERT_EQ(16 - 4, obj_pool.get_metrics("D").in_use);
+    TESTASSERT_EQ(16 - 4 + 1, obj_pool.get_metrics("D").high_water);
   }
   TESTASSERT(C::dtor_counter == C::default_ctor_counter);
 }
@@ -192,6 +192,69 @@ int test_bit_ref()
     TESTASSERT(bref.distance() == 216);
   }
 
+  // random fields and octet strings at any offset
+  {
+    std::uniform_int_distribution<uint64_t> val_dist;
+    std::uniform_int_distribution<uint32_t> nbits_dist(1, 63), nbytes_dist(0, 20);
+    for (uint32_t trial = 0; trial < 100; ++trial) {
+      std::vector<uint64_t>              vals;
+      std::vector<uint32_t>              nbits;
+      std::vector<std::vector<uint8_t> > octs;
+      bit_ref                            bref(&buf[0], sizeof(buf));
+      for (uint32_t i = 0; i < 10; ++i) {
+        nbits.push_back(nbits_dist(g));
+        vals.push_back(val_dist(g) & ((1ul << nbits.back()) - 1ul));
+        octs.emplace_back(nbytes_dist(g));
+        for (uint8_t& b : octs.back()) {
+          b = val_dist(g);
+        }
+        TESTASSERT(bref.pack(vals.back(), nbits.back()) == SRSASN_SUCCESS);
+        TESTASSERT(bref.pack_bytes(octs.back().data(), octs.back().size()) == SRSASN_SUCCESS);
+      }
+      int nof_bits = bref.distance();
+
+      cbit_ref bref2(&buf[0], sizeof(buf));
+      for (uint32_t i = 0; i < vals.size(); ++i) {
+        uint64_t val;
+        TESTASSERT(bref2.unpack(val, nbits[i]) == SRSASN_SUCCESS);
+        TESTASSERT(val == vals[i]);
+        std::vector<uint8_t> oct(octs[i].size());
+        TESTASSERT(bref2.unpack_bytes(oct.data(), oct.size()) == SRSASN_SUCCESS);
+        TESTASSERT(oct == octs[i]);
+      }
+      TESTASSERT(bref2.distance() == nof_bits);
+    }
+  }
+
+  // 64 bit values
+  {
+    bit_ref bref(&buf[0], sizeof(buf));
+    TESTASSERT(bref.pack(1, 3) == SRSASN_SUCCESS);
+    TESTASSERT(bref.pack(0x7123456789abcdefu, 63) == SRSASN_SUCCESS);
+    TESTASSERT(bref.distance() == 66);
+    cbit_ref bref2(&buf[0], sizeof(buf));
+    uint64_t val;
+    TESTASSERT(bref2.unpack(val, 2) == SRSASN_SUCCESS and val == 0);
+    TESTASSERT(bref2.unpack(val, 64) == SRSASN_SUCCESS);
+    TESTASSERT(val == 0xf123456789abcdefu);
+  }
+
+  // buffer limits
+  {
+    bit_ref bref(&buf[0], 2);
+    TESTASSERT(bref.pack(0, 3) == SRSASN_SUCCESS);
+    TESTASSERT(bref.pack(0, 14) != SRSASN_SUCCESS);
+    TESTASSERT(bref.pack(0, 13) == SRSASN_SUCCESS);
+    TESTASSERT(bref.distance_bytes_end() == 0);
+    cbit_ref bref2(&buf[0], 2);
+    uint32_t val;
+    TESTASSERT(bref2.unpack(val, 5) == SRSASN_SUCCESS);
+    TESTASSERT(bref2.unpack(val, 12) != SRSASN_SUCCESS);
+    uint8_t oct[2];
+    TESTASSERT(bref2.unpack_bytes(oct, 2) != SRSASN_SUCCESS);
+    TESTASSERT(bref2.unpack(val, 11) == SRSASN_SUCCESS);
+  }
+
   return 0;
 }
 
@@ -527,6 +590,66 @@ int test_copy_ptr()
   return 0;
 }
 
+int test_decode_arena()
+{
+  decode_arena             arena(256);
+  dyn_array<dyn_octstring> arr_copy;
+  copy_ptr<dyn_octstring>  cptr_copy;
+  {
+    dyn_array<dyn_octstring> arr;
+    copy_ptr<dyn_octstring>  cptr, cptr2;
+    {
+      decode_arena_scope scope(arena);
+      arr.resize(4);
+      for (uint32_t i = 0; i < arr.size(); ++i) {
+        arr[i].resize(100);
+        memset(arr[i].data(), i, arr[i].size());
+      }
+      cptr.set_present();
+      cptr->resize(10);
+      cptr2.set_present();
+      (*cptr2) = arr[1];
+    }
+    // The members that did not fit in the first chunk were allocated in other chunks
+    TESTASSERT(arena.nof_chunks() > 1);
+    TESTASSERT(cptr.is_present() and cptr->size() == 10);
+    TESTASSERT(cptr2->size() == 100 and (*cptr2)[99] == 1);
+
+    // Copies and resizes made outside of the scope are allocated in the heap
+    arr_copy  = arr;
+    cptr_copy = cptr2;
+    arr.resize(20);
+    TESTASSERT(arr[3].size() == 100 and arr[3][50] == 3);
+
+    // The released objects are moved to the heap
+    dyn_octstring* released = cptr2.release();
+    TESTASSERT(released->size() == 100 and (*released)[0] == 1);
+    delete released;
+  }
+  arena.reset();
+  TESTASSERT(arena.nof_chunks() == 1);
+  TESTASSERT(arr_copy.size() == 4 and arr_copy[2][99] == 2);
+  TESTASSERT(*cptr_copy == arr_copy[1]);
+
+  // Nested scopes restore the previous arena
+  decode_arena arena2;
+  {
+    dyn_array<uint8_t>      arr;
+    copy_ptr<dyn_octstring> cptr;
+    decode_arena_scope      scope(arena);
+    {
+      decode_arena_scope scope2(arena2);
+      arr.resize(1);
+    }
+    TESTASSERT(arena2.nof_chunks() == 1);
+    cptr.set_present();
+    cptr->resize(1000);
+    TESTASSERT(arena.nof_chunks() == 2);
+  }
+
+  return 0;
+}
+
 class EnumTest
 {
 public:
@@ -694,6 +817,7 @@ int main()
   TESTASSERT(test_bitstring() == 0);
   TESTASSERT(test_seq_of() == 0);
   TESTASSERT(test_copy_ptr() == 0);
+  TESTASSERT(test_decode_arena() == 0);
   TESTASSERT(test_enum() == 0);
   TESTASSERT(test_big_integers() == 0);
   test_varlength_field_pack();
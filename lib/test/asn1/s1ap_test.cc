@@ -96,6 +96,51 @@ int test_init_ctxt_setup_req()
   return SRSRAN_SUCCESS;
 }
 
+int test_init_ctxt_setup_req_arena()
+{
+  uint8_t s1ap_msg[] = {
+      0x00, 0x09, 0x00, 0x80, 0xc6, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x02, 0x00, 0x64, 0x00, 0x08, 0x00, 0x02, 0x00,
+      0x01, 0x00, 0x42, 0x00, 0x0a, 0x18, 0x3b, 0x9a, 0xca, 0x00, 0x60, 0x3b, 0x9a, 0xca, 0x00, 0x00, 0x18, 0x00, 0x78,
+      0x00, 0x00, 0x34, 0x00, 0x73, 0x45, 0x00, 0x09, 0x3c, 0x0f, 0x80, 0x0a, 0x00, 0x21, 0xf0, 0xb7, 0x36, 0x1c, 0x56,
+      0x64, 0x27, 0x3e, 0x5b, 0x04, 0xb7, 0x02, 0x07, 0x42, 0x02, 0x3e, 0x06, 0x00, 0x09, 0xf1, 0x07, 0x00, 0x07, 0x00,
+      0x37, 0x52, 0x66, 0xc1, 0x01, 0x09, 0x1b, 0x07, 0x74, 0x65, 0x73, 0x74, 0x31, 0x32, 0x33, 0x06, 0x6d, 0x6e, 0x63,
+      0x30, 0x37, 0x30, 0x06, 0x6d, 0x63, 0x63, 0x39, 0x30, 0x31, 0x04, 0x67, 0x70, 0x72, 0x73, 0x05, 0x01, 0xc0, 0xa8,
+      0x03, 0x02, 0x27, 0x0e, 0x80, 0x80, 0x21, 0x0a, 0x03, 0x00, 0x00, 0x0a, 0x81, 0x06, 0x08, 0x08, 0x08, 0x08, 0x50,
+      0x0b, 0xf6, 0x09, 0xf1, 0x07, 0x80, 0x01, 0x01, 0xf6, 0x7e, 0x72, 0x69, 0x13, 0x09, 0xf1, 0x07, 0x00, 0x01, 0x23,
+      0x05, 0xf4, 0xf6, 0x7e, 0x72, 0x69, 0x00, 0x6b, 0x00, 0x05, 0x18, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x49, 0x00, 0x20,
+      0x45, 0x25, 0xe4, 0x9a, 0x77, 0xc8, 0xd5, 0xcf, 0x26, 0x33, 0x63, 0xeb, 0x5b, 0xb9, 0xc3, 0x43, 0x9b, 0x9e, 0xb3,
+      0x86, 0x1f, 0xa8, 0xa7, 0xcf, 0x43, 0x54, 0x07, 0xae, 0x42, 0x2b, 0x63, 0xb9};
+
+  // The same PDU is decoded several times in the arena, without growing it
+  asn1::decode_arena arena;
+  s1ap_pdu_c         copy;
+  for (uint32_t i = 0; i < 3; ++i) {
+    arena.reset();
+    s1ap_pdu_c pdu;
+    cbit_ref   bref(&s1ap_msg[0], sizeof(s1ap_msg));
+    {
+      asn1::decode_arena_scope scope(arena);
+      TESTASSERT(pdu.unpack(bref) == SRSASN_SUCCESS);
+    }
+    TESTASSERT(arena.nof_chunks() == 1);
+
+    uint8_t buffer[1024];
+    bit_ref bref2(buffer, sizeof(buffer));
+    TESTASSERT(pdu.pack(bref2) == SRSASN_SUCCESS);
+    TESTASSERT_EQ(sizeof(s1ap_msg), (uint32_t)bref2.distance_bytes());
+    TESTASSERT(memcmp(buffer, s1ap_msg, sizeof(s1ap_msg)) == 0);
+    copy = pdu;
+  }
+  arena.reset();
+
+  // The copy made outside of the scope does not use the arena memory
+  auto& ctxt_setup = copy.init_msg().value.init_context_setup_request();
+  TESTASSERT(ctxt_setup->ue_security_cap.value.encryption_algorithms.to_string() == "1100000000000000");
+  TESTASSERT(test_pack_unpack_consistency(copy) == SRSASN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
+
 int test_ue_ctxt_release_req()
 {
   uint8_t s1ap_msg[] = {0x00, 0x12, 0x40, 0x15, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01,
@@ -388,6 +433,7 @@ int main()
 
   TESTASSERT(test_s1setup_request() == 0);
   TESTASSERT(test_init_ctxt_setup_req() == 0);
+  TESTASSERT(test_init_ctxt_setup_req_arena() == 0);
   TESTASSERT(test_ue_ctxt_release_req() == 0);
   TESTASSERT(test_proc_id_consistency(*spy) == 0);
   TESTASSERT(test_ho_request() == 0);
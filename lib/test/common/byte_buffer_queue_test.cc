@@ -22,6 +22,7 @@
 #define NMSGS 1000000
 
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include <stdio.h>
 
@@ -80,7 +81,92 @@ int test_concurrent_writeread()
   return result;
 }
 
+int test_codel_control_law()
+{
+  codel_config_t cfg;
+  cfg.enabled     = true;
+  cfg.target_ms   = 5;
+  cfg.interval_ms = 100;
+  codel aqm;
+  aqm.configure(cfg);
+
+  codel::clock_t::time_point t0   = {};
+  std::chrono::microseconds  long_delay(20000);
+  std::chrono::microseconds  short_delay(1000);
+  uint32_t                   qlen = 100000;
+
+  // A delay below the target or a nearly empty queue is not dropped from
+  TESTASSERT(not aqm.should_drop(t0 + std::chrono::milliseconds(1), short_delay, qlen));
+  TESTASSERT(not aqm.should_drop(t0 + std::chrono::milliseconds(2), long_delay, 1000));
+
+  // The delay must stay above the target for one interval before the first drop
+  TESTASSERT(not aqm.should_drop(t0 + std::chrono::milliseconds(10), long_delay, qlen));
+  TESTASSERT(not aqm.should_drop(t0 + std::chrono::milliseconds(109), long_delay, qlen));
+  TESTASSERT(aqm.should_drop(t0 + std::chrono::milliseconds(110), long_delay, qlen));
+
+  // The next drops come at interval/sqrt(count)
+  TESTASSERT(not aqm.should_drop(t0 + std::chrono::milliseconds(209), long_delay, qlen));
+  TESTASSERT(aqm.should_drop(t0 + std::chrono::milliseconds(210), long_delay, qlen));
+  TESTASSERT(not aqm.should_drop(t0 + std::chrono::milliseconds(280), long_delay, qlen));
+  TESTASSERT(aqm.should_drop(t0 + std::chrono::milliseconds(281), long_delay, qlen));
+
+  // The dropping state ends as soon as the delay goes below the target
+  TESTASSERT(not aqm.should_drop(t0 + std::chrono::milliseconds(400), short_delay, qlen));
+  TESTASSERT(not aqm.should_drop(t0 + std::chrono::milliseconds(401), long_delay, qlen));
+
+  printf("Passed\n");
+  return SRSRAN_SUCCESS;
+}
+
+int test_codel_queue()
+{
+  byte_buffer_queue q(512);
+  codel_config_t    cfg;
+  cfg.enabled     = true;
+  cfg.target_ms   = 5;
+  cfg.interval_ms = 10;
+  q.set_aqm(cfg);
+
+  // SDUs that have already waited for longer than the target
+  const uint32_t nof_sdus = 300;
+  auto           tp       = tsc_clock::now() - std::chrono::milliseconds(50);
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    unique_byte_buffer_t b = srsran::make_byte_buffer();
+    TESTASSERT(b != nullptr);
+    memcpy(b->msg, &i, 4);
+    b->N_bytes = 1000;
+    b->set_timestamp(tp);
+    q.write(std::move(b));
+  }
+
+  // Nothing is dropped until the delay stays above the target for one interval
+  uint32_t             nof_read = 0;
+  unique_byte_buffer_t b        = q.read();
+  TESTASSERT(b != nullptr);
+  nof_read++;
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  while (not q.is_empty()) {
+    b = q.read();
+    TESTASSERT(b != nullptr);
+    nof_read++;
+  }
+  TESTASSERT(q.get_nof_aqm_drops() > 0);
+  TESTASSERT_EQ(nof_sdus, nof_read + q.get_nof_aqm_drops());
+  TESTASSERT_EQ(0, q.size_bytes());
+
+  // The last SDU is never dropped
+  uint32_t last_sn = 0;
+  memcpy(&last_sn, b->msg, 4);
+  TESTASSERT_EQ(nof_sdus - 1, last_sn);
+
+  printf("Passed\n");
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
-  return test_concurrent_writeread();
+  TESTASSERT(test_concurrent_writeread() == SRSRAN_SUCCESS);
+  TESTASSERT(test_codel_control_law() == SRSRAN_SUCCESS);
+  TESTASSERT(test_codel_queue() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
 }
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include <vector>
+
+using namespace srsran;
+
+int test_size_classes()
+{
+  // Small payloads get a buffer with less headroom and tailroom
+  unique_byte_buffer_t small = make_sized_byte_buffer(40);
+  TESTASSERT(small != nullptr);
+  TESTASSERT_EQ(SRSRAN_SMALL_BUFFER_HEADROOM, small->get_headroom());
+  TESTASSERT_EQ(SRSRAN_SMALL_BUFFER_SIZE_BYTES - SRSRAN_SMALL_BUFFER_HEADROOM, small->get_tailroom());
+
+  unique_byte_buffer_t medium = make_sized_byte_buffer(1500);
+  TESTASSERT(medium != nullptr);
+  TESTASSERT_EQ(SRSRAN_MEDIUM_BUFFER_HEADROOM, medium->get_headroom());
+  TESTASSERT(medium->get_tailroom() >= 1500 + SRSRAN_SIZED_BUFFER_TRAILER_MARGIN);
+
+  // Payloads that fit no smaller class get a default byte buffer
+  unique_byte_buffer_t large = make_sized_byte_buffer(9000);
+  TESTASSERT(large != nullptr);
+  unique_byte_buffer_t dflt = make_byte_buffer();
+  TESTASSERT_EQ(dflt->get_headroom(), large->get_headroom());
+  TESTASSERT_EQ(dflt->get_tailroom(), large->get_tailroom());
+
+  // The headers are prepended in the headroom, and clear() restores the headroom of the class
+  small->append_bytes((uint8_t*)"payload", 7);
+  small->msg -= 4;
+  small->N_bytes += 4;
+  TESTASSERT_EQ(SRSRAN_SMALL_BUFFER_HEADROOM - 4, small->get_headroom());
+  small->clear();
+  TESTASSERT_EQ(SRSRAN_SMALL_BUFFER_HEADROOM, small->get_headroom());
+
+  // A default buffer is copied to a small buffer at its headroom, instead of the larger headroom of the source
+  dflt->append_bytes((uint8_t*)"payload", 7);
+  *small = *dflt;
+  TESTASSERT_EQ(SRSRAN_SMALL_BUFFER_HEADROOM, small->get_headroom());
+  TESTASSERT_EQ(7, small->N_bytes);
+  TESTASSERT(memcmp(small->msg, "payload", 7) == 0);
+  *dflt = *small;
+  TESTASSERT_EQ(SRSRAN_SMALL_BUFFER_HEADROOM, dflt->get_headroom());
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_pool_reuse()
+{
+  // The buffers are returned to the pool of their class, so the pools are never depleted
+  for (uint32_t i = 0; i < 4; ++i) {
+    std::vector<unique_byte_buffer_t> bufs;
+    for (uint32_t j = 0; j < 3000; ++j) {
+      bufs.push_back(make_sized_byte_buffer(j % 3 == 0 ? 40 : (j % 3 == 1 ? 1500 : 9000)));
+      TESTASSERT(bufs.back() != nullptr);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_size_classes() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pool_reuse() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/iq_tap.h"
+#include "srsran/common/test_common.h"
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace srsran;
+
+static const char* samples_filename = "iq_tap_test.bin";
+
+std::vector<std::string> read_index()
+{
+  std::ifstream            f(std::string(samples_filename) + ".csv");
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(f, line);) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+std::vector<uint8_t> read_samples()
+{
+  std::ifstream f(samples_filename, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+int test_capture()
+{
+  std::vector<uint8_t> data(6000);
+  std::iota(data.begin(), data.end(), 0);
+  std::vector<uint16_t> rntis = {0x46, 0x47};
+
+  iq_tap tap;
+  TESTASSERT(not tap.is_running());
+  TESTASSERT(not tap.push(iq_tap::direction_t::rx, 0, 0, 0, false, data.data(), 100, {}));
+  TESTASSERT(tap.start(samples_filename, 8, data.size()));
+  TESTASSERT(tap.is_running());
+
+  TESTASSERT(tap.push(iq_tap::direction_t::rx, 10, 0, 0, false, data.data(), data.size(), rntis));
+  TESTASSERT(tap.push(iq_tap::direction_t::tx, 14, 1, 1, true, data.data() + 1, 100, {}));
+  // Buffers larger than a slot are not captured
+  std::vector<uint8_t> large(8193);
+  TESTASSERT(not tap.push(iq_tap::direction_t::rx, 11, 0, 0, false, large.data(), large.size(), {}));
+  tap.stop();
+  TESTASSERT(not tap.is_running());
+  TESTASSERT_EQ(0, tap.nof_dropped());
+
+  // Each buffer takes a slot of whole 4 KiB blocks, padded with zeros
+  std::vector<uint8_t> samples = read_samples();
+  TESTASSERT_EQ(2 * 8192, samples.size());
+  TESTASSERT(std::equal(data.begin(), data.end(), samples.begin()));
+  TESTASSERT(std::all_of(samples.begin() + data.size(), samples.begin() + 8192, [](uint8_t v) { return v == 0; }));
+  TESTASSERT(std::equal(data.begin() + 1, data.begin() + 101, samples.begin() + 8192));
+
+  std::vector<std::string> index = read_index();
+  TESTASSERT_EQ(3, index.size());
+  TESTASSERT(index[0] == "tti,direction,cc,port,format,offset,nof_bytes,rntis");
+  TESTASSERT(index[1] == "10,rx,0,0,fc32,0,6000,0x46;0x47");
+  TESTASSERT(index[2] == "14,tx,1,1,sc16,8192,100,");
+  return SRSRAN_SUCCESS;
+}
+
+int test_concurrent_producers()
+{
+  std::vector<uint8_t> data(4096);
+  const uint32_t       nof_threads = 4, nof_buffers = 1000;
+
+  iq_tap tap;
+  TESTASSERT(tap.start(samples_filename, 16, data.size()));
+  std::vector<std::thread> producers;
+  std::atomic<uint32_t>    nof_pushed = {0};
+  for (uint32_t t = 0; t < nof_threads; ++t) {
+    producers.emplace_back([&, t]() {
+      for (uint32_t i = 0; i < nof_buffers; ++i) {
+        if (tap.push(iq_tap::direction_t::rx, i, t, 0, false, data.data(), data.size(), {})) {
+          nof_pushed++;
+        }
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  tap.stop();
+
+  // Every buffer is either written or counted as dropped, the producers never wait for the writer
+  TESTASSERT_EQ(nof_threads * nof_buffers, nof_pushed + tap.nof_dropped());
+  TESTASSERT_EQ(nof_pushed + 1, read_index().size());
+  TESTASSERT_EQ(nof_pushed * data.size(), read_samples().size());
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_capture() == SRSRAN_SUCCESS);
+  TESTASSERT(test_concurrent_producers() == SRSRAN_SUCCESS);
+  remove(samples_filename);
+  remove((std::string(samples_filename) + ".csv").c_str());
+  return SRSRAN_SUCCESS;
+}
@@ -306,6 +306,56 @@ int test_multiqueue_threading4()
   return 0;
 }
 
+int test_multiqueue_batch_pop()
+{
+  std::cout << "\n===== TEST multiqueue batch pop: start =====\n";
+  // Description: several producers push to their own queue, blocking when it is full. The consumer pops batches of
+  //              objects, which keep the order of each queue
+
+  const int                       nof_producers = 4, nof_pushes = 100000, capacity = 64, batch_size = 8;
+  multiqueue_handler<int>         multiqueue(capacity);
+  std::vector<queue_handle<int> > qids;
+  std::vector<std::thread>        producers;
+  for (int p = 0; p < nof_producers; ++p) {
+    qids.push_back(multiqueue.add_queue());
+  }
+  for (int p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&qids, p, nof_pushes]() {
+      for (int i = 0; i < nof_pushes; ++i) {
+        qids[p].push(p * nof_pushes + i);
+      }
+    });
+  }
+
+  std::vector<int> next(nof_producers, 0);
+  int              batch[batch_size];
+  int              count = 0;
+  while (count < nof_producers * nof_pushes) {
+    size_t n = multiqueue.wait_pop(batch, batch_size);
+    TESTASSERT(n > 0 and n <= (size_t)batch_size);
+    for (size_t i = 0; i < n; ++i) {
+      int p = batch[i] / nof_pushes;
+      TESTASSERT(batch[i] % nof_pushes == next[p]);
+      next[p]++;
+    }
+    count += n;
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  for (auto& q : qids) {
+    TESTASSERT(q.size() == 0);
+  }
+
+  multiqueue.stop();
+  TESTASSERT(multiqueue.wait_pop(batch, batch_size) == 0);
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+
+  return 0;
+}
+
 int test_task_thread_pool()
 {
   std::cout << "\n====== TEST task thread pool test 1: start ======\n";
@@ -410,6 +460,206 @@ int test_task_thread_pool3()
   return 0;
 }
 
+int test_task_thread_pool_priorities()
+{
+  std::cout << "\n====== TEST task thread pool priorities: start ======\n";
+  // Description: long low priority tasks fill all but one worker, and the normal tasks keep running in the free one
+
+  const uint32_t nof_workers = 3, nof_low_tasks = 6, nof_normal_tasks = 100;
+
+  std::atomic<bool>     release_low{false};
+  std::atomic<uint32_t> nof_low_running{0}, max_low_running{0}, nof_low_done{0}, nof_normal_done{0};
+
+  task_thread_pool thread_pool(nof_workers);
+  for (uint32_t i = 0; i < nof_low_tasks; ++i) {
+    thread_pool.push_task(
+        [&]() {
+          uint32_t n = ++nof_low_running;
+          for (uint32_t m = max_low_running; n > m and not max_low_running.compare_exchange_weak(m, n);) {
+          }
+          while (not release_low) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+          }
+          nof_low_running--;
+          nof_low_done++;
+        },
+        task_priority::low);
+  }
+  for (uint32_t i = 0; i < nof_normal_tasks; ++i) {
+    thread_pool.push_task([&nof_normal_done]() { nof_normal_done++; });
+  }
+
+  // The normal tasks finish while the low priority ones are still blocked
+  for (uint32_t i = 0; i < 5000 and (nof_normal_done < nof_normal_tasks or nof_low_running < nof_workers - 1); ++i) {
+    usleep(1000);
+  }
+  TESTASSERT(nof_normal_done == nof_normal_tasks);
+  TESTASSERT(nof_low_done == 0);
+  usleep(10000);
+  TESTASSERT(max_low_running == nof_workers - 1);
+
+  // Once released, the low priority tasks run in turns
+  release_low = true;
+  for (uint32_t i = 0; i < 5000 and nof_low_done < nof_low_tasks; ++i) {
+    usleep(1000);
+  }
+  TESTASSERT(nof_low_done == nof_low_tasks);
+  TESTASSERT(max_low_running == nof_workers - 1);
+  thread_pool.stop();
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
+int test_task_thread_pool_stealing()
+{
+  std::cout << "\n====== TEST task thread pool stealing: start ======\n";
+  // Description: the sub-tasks pushed by a task stay in the queue of its worker, and the idle workers steal them
+
+  const uint32_t nof_workers = 4, nof_tasks = 64;
+
+  std::mutex                     count_mutex;
+  std::map<std::thread::id, int> count_worker;
+  std::atomic<uint32_t>          nof_done{0};
+
+  task_thread_pool thread_pool(nof_workers);
+  thread_pool.push_task([&]() {
+    for (uint32_t i = 0; i < nof_tasks; ++i) {
+      thread_pool.push_task([&]() {
+        std::this_thread::sleep_for(std::chrono::microseconds{500});
+        {
+          std::lock_guard<std::mutex> lock(count_mutex);
+          count_worker[std::this_thread::get_id()]++;
+        }
+        nof_done++;
+      });
+    }
+  });
+  for (uint32_t i = 0; i < 5000 and nof_done < nof_tasks; ++i) {
+    usleep(1000);
+  }
+  thread_pool.stop();
+
+  TESTASSERT(nof_done == nof_tasks);
+  std::lock_guard<std::mutex> lock(count_mutex);
+  for (auto& w : count_worker) {
+    std::cout << "worker " << w.first << ": " << w.second << " sub-tasks\n";
+  }
+  TESTASSERT(count_worker.size() > 1);
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
+int test_thread_pool_task_stealing()
+{
+  std::cout << "\n====== TEST thread pool task stealing: start ======\n";
+  // Description: a single busy worker splits its work in sub-tasks, the idle workers of the pool take some of them
+
+  const uint32_t nof_workers = 4, nof_tasks = 64;
+
+  class stealing_worker : public thread_pool::worker
+  {
+  public:
+    std::mutex                     count_mutex;
+    std::map<std::thread::id, int> count_worker;
+    std::atomic<bool>              done{false};
+
+  protected:
+    void work_imp() override
+    {
+      thread_pool::task_group group;
+      for (uint32_t i = 0; i < nof_tasks; ++i) {
+        push_task(group, [this]() {
+          std::this_thread::sleep_for(std::chrono::microseconds{500});
+          std::lock_guard<std::mutex> lock(count_mutex);
+          count_worker[std::this_thread::get_id()]++;
+        });
+      }
+      wait_tasks(group);
+      done = true;
+    }
+  };
+
+  class idle_worker : public thread_pool::worker
+  {
+  protected:
+    void work_imp() override {}
+  };
+
+  thread_pool                                           pool(nof_workers);
+  stealing_worker                                       busy;
+  std::vector<std::unique_ptr<thread_pool::worker> >    idle;
+  pool.init_worker(0, &busy);
+  for (uint32_t i = 1; i < nof_workers; ++i) {
+    idle.emplace_back(new idle_worker);
+    pool.init_worker(i, idle.back().get());
+  }
+
+  pool.start_worker(pool.wait_worker_id(0));
+  pool.wait_worker_id(0);
+  TESTASSERT(busy.done);
+
+  std::lock_guard<std::mutex> lock(busy.count_mutex);
+  uint32_t                    total_count = 0;
+  for (auto& w : busy.count_worker) {
+    total_count += w.second;
+    std::cout << "worker " << w.first << ": " << w.second << " sub-tasks\n";
+  }
+  TESTASSERT(total_count == nof_tasks);
+  TESTASSERT(busy.count_worker.size() > 1);
+
+  pool.stop();
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
+int test_thread_pool_autoscale()
+{
+  std::cout << "\n====== TEST thread pool autoscale: start ======\n";
+  // Description: the idle workers are parked one at a time, and woken again once the active ones are busy
+
+  const uint32_t nof_workers = 4;
+
+  class sleeping_worker : public thread_pool::worker
+  {
+  protected:
+    void work_imp() override { std::this_thread::sleep_for(std::chrono::milliseconds{1}); }
+  };
+
+  thread_pool                                         pool(nof_workers);
+  std::vector<std::unique_ptr<thread_pool::worker> > workers;
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    workers.emplace_back(new sleeping_worker);
+    pool.init_worker(i, workers.back().get());
+  }
+
+  // Without load, a worker is parked on every call down to the minimum
+  TESTASSERT(pool.autoscale(1, 0.5f) == 3);
+  TESTASSERT(pool.autoscale(1, 0.5f) == 2);
+  TESTASSERT(pool.autoscale(1, 0.5f) == 1);
+  TESTASSERT(pool.autoscale(1, 0.5f) == 1);
+
+  // Only the active worker is picked, and keeping it busy all the time wakes another one
+  for (uint32_t i = 0; i < 20; ++i) {
+    thread_pool::worker* w = pool.wait_worker(i);
+    TESTASSERT(w != nullptr and w->get_id() == 0);
+    pool.start_worker(w);
+  }
+  pool.wait_worker_id(0);
+  TESTASSERT(pool.autoscale(1, 0.5f) >= 2);
+
+  pool.stop();
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
 struct C {
   std::unique_ptr<int> val{new int{5}};
 };
@@ -492,6 +742,53 @@ int test_inplace_task()
   return 0;
 }
 
+int test_pooled_task()
+{
+  std::cout << "\n======= TEST pooled task: start =======\n";
+
+  struct E {
+    std::array<int, 1024> huge_val;
+    E() { huge_val[0] = 7; }
+  };
+  static_assert(srsran::move_task_t::fits_small_buffer<C>(), "failed check\n");
+  static_assert(not srsran::move_task_t::fits_small_buffer<D>(), "failed check\n");
+
+  // More tasks than pool blocks, so that the last ones fall back to the heap
+  int                              sum = 0;
+  D                                d;
+  std::vector<srsran::move_task_t> tasks;
+  for (size_t i = 0; i < srsran::move_callback_pool_capacity + 100; ++i) {
+    tasks.emplace_back([&sum, d]() { sum += d.big_val[0]; });
+    TESTASSERT(not tasks.back().is_in_small_buffer());
+  }
+  E e;
+  tasks.emplace_back([&sum, e]() { sum += e.huge_val[0]; });
+  for (srsran::move_task_t& t : tasks) {
+    t();
+  }
+  TESTASSERT(sum == 6 * (int)(srsran::move_callback_pool_capacity + 100) + 7);
+
+  // Tasks created in one thread and destroyed in another return their block to the pool
+  srsran::task_multiqueue mq;
+  auto                    q = mq.add_queue();
+  std::thread             t([&q, &sum, d]() {
+    for (size_t i = 0; i < 10000; ++i) {
+      q.push([&sum, d]() { sum += d.big_val[0]; });
+    }
+  });
+  srsran::move_task_t task;
+  for (size_t i = 0; i < 10000; ++i) {
+    TESTASSERT(mq.wait_pop(&task));
+    task();
+  }
+  t.join();
+  TESTASSERT(sum == 6 * (int)(srsran::move_callback_pool_capacity + 100 + 10000) + 7);
+
+  std::cout << "outcome: Success\n";
+  std::cout << "========================================\n";
+  return 0;
+}
+
 int main()
 {
   TESTASSERT(test_multiqueue() == 0);
@@ -499,10 +796,16 @@ int main()
   TESTASSERT(test_multiqueue_threading2() == 0);
   TESTASSERT(test_multiqueue_threading3() == 0);
   TESTASSERT(test_multiqueue_threading4() == 0);
+  TESTASSERT(test_multiqueue_batch_pop() == 0);
 
   TESTASSERT(test_task_thread_pool() == 0);
   TESTASSERT(test_task_thread_pool2() == 0);
   TESTASSERT(test_task_thread_pool3() == 0);
+  TESTASSERT(test_task_thread_pool_priorities() == 0);
+  TESTASSERT(test_task_thread_pool_stealing() == 0);
+  TESTASSERT(test_thread_pool_task_stealing() == 0);
+  TESTASSERT(test_thread_pool_autoscale() == 0);
 
   TESTASSERT(test_inplace_task() == 0);
+  TESTASSERT(test_pooled_task() == 0);
 }
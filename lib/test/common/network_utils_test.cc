@@ -130,6 +130,92 @@ int test_socket_handler()
   return 0;
 }
 
+int test_udp_batch_rx()
+{
+  auto& logger = srslog::fetch_basic_logger("S1AP", false);
+
+  srsran::unique_socket rx_socket, tx_socket;
+  using namespace srsran::net_utils;
+  TESTASSERT(rx_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(rx_socket.bind_addr("127.0.100.2", 2152));
+  TESTASSERT(tx_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(tx_socket.bind_addr("127.0.100.3", 2152));
+
+  srsran::task_scheduler    task_sched;
+  srsran::task_queue_handle task_queue = task_sched.make_task_queue();
+  std::vector<uint32_t>     rx_sizes;
+  auto                      pdu_handler = [&rx_sizes](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+    TESTASSERT(ntohs(from.sin_port) == 2152);
+    rx_sizes.push_back(pdu->N_bytes);
+  };
+  srsran::socket_manager_itf::recv_callback_t rx_callback =
+      srsran::make_sdu_handler(logger, task_queue, pdu_handler);
+
+  // Send more datagrams than a single recvmmsg() call reads
+  uint8_t     buf[128]   = {};
+  int32_t     nof_counts = 40;
+  sockaddr_in rx_addrin  = rx_socket.get_addr_in();
+  for (int32_t i = 0; i < nof_counts; ++i) {
+    TESTASSERT(sendto(tx_socket.fd(), buf, i + 1, 0, (struct sockaddr*)&rx_addrin, sizeof(rx_addrin)) == i + 1);
+  }
+
+  // TEST: The datagrams are read in batches and dispatched in order
+  TESTASSERT(rx_callback(rx_socket.fd()));
+  TESTASSERT(rx_callback(rx_socket.fd()));
+  // No data left in the socket
+  TESTASSERT(rx_callback(rx_socket.fd()));
+  task_sched.run_pending_tasks();
+  TESTASSERT(rx_sizes.size() == (size_t)nof_counts);
+  for (int32_t i = 0; i < nof_counts; ++i) {
+    TESTASSERT(rx_sizes[i] == (uint32_t)i + 1);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_udp_gso_tx()
+{
+  srsran::unique_socket rx_socket, tx_socket;
+  using namespace srsran::net_utils;
+  TESTASSERT(rx_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(rx_socket.bind_addr("127.0.100.4", 2152));
+  TESTASSERT(tx_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(tx_socket.bind_addr("127.0.100.5", 2152));
+
+  // Runs of datagrams with the same size, with a shorter one ending a run, and a datagram to another destination
+  std::vector<uint32_t>    sizes = {100, 100, 100, 100, 40, 60, 60, 60, 200, 20};
+  std::vector<uint8_t>     data(1000);
+  std::vector<iovec>       iovs(sizes.size());
+  std::vector<sockaddr_in> addrs(sizes.size(), rx_socket.get_addr_in());
+  addrs[8].sin_port = htons(2153);
+
+  uint32_t offset = 0;
+  for (uint32_t i = 0; i < sizes.size(); ++i) {
+    for (uint32_t j = 0; j < sizes[i]; ++j) {
+      data[offset + j] = i;
+    }
+    iovs[i].iov_base = &data[offset];
+    iovs[i].iov_len  = sizes[i];
+    offset += sizes[i];
+  }
+
+  // TEST: The datagrams are received one by one and in order, whether sent with GSO or not
+  for (bool gso : {udp_gso_supported(tx_socket.fd()), false}) {
+    TESTASSERT(send_datagrams(tx_socket.fd(), iovs.data(), addrs.data(), sizes.size(), gso) == sizes.size());
+    for (uint32_t i = 0; i < sizes.size(); ++i) {
+      if (i == 8) {
+        continue;
+      }
+      uint8_t buf[1000];
+      ssize_t n = recv(rx_socket.fd(), buf, sizeof(buf), MSG_DONTWAIT);
+      TESTASSERT(n == (ssize_t)sizes[i]);
+      TESTASSERT(buf[0] == i and buf[n - 1] == i);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int test_sctp_bind_error()
 {
   srsran::unique_socket sock;
@@ -157,6 +243,8 @@ int main()
   srslog::init();
 
   TESTASSERT(test_socket_handler() == 0);
+  TESTASSERT(test_udp_batch_rx() == 0);
+  TESTASSERT(test_udp_gso_tx() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
 
   return 0;
@@ -0,0 +1,158 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap_capture_ring.h"
+#include "srsran/common/test_common.h"
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace srsran;
+
+static const uint32_t rec_hdr_len = sizeof(pcaprec_hdr_t);
+
+// Reads the records of a block, checking their length and content. Returns the number of records
+uint32_t check_records(span<const uint8_t> block, uint32_t incl_len, uint32_t orig_len)
+{
+  uint32_t nof_records = 0;
+  for (size_t offset = 0; offset < block.size(); nof_records++) {
+    pcaprec_hdr_t rec_hdr;
+    memcpy(&rec_hdr, block.data() + offset, rec_hdr_len);
+    TESTASSERT_EQ(incl_len, rec_hdr.incl_len);
+    TESTASSERT_EQ(orig_len, rec_hdr.orig_len);
+    const uint8_t* data = block.data() + offset + rec_hdr_len;
+    for (uint32_t i = 0; i < rec_hdr.incl_len; ++i) {
+      TESTASSERT_EQ((uint8_t)i, data[i]);
+    }
+    offset += rec_hdr_len + rec_hdr.incl_len;
+  }
+  return nof_records;
+}
+
+int test_push_and_wrap_around()
+{
+  std::vector<uint8_t> data(100);
+  std::iota(data.begin(), data.end(), 0);
+  size_t rec_len = rec_hdr_len + data.size();
+
+  // The header and payload are stored one after the other
+  pcap_capture_ring ring(0);
+  TESTASSERT(ring.init(10 * rec_len));
+  for (uint32_t i = 0; i < 10; ++i) {
+    TESTASSERT(ring.push(data.data(), 10, data.data() + 10, 90));
+  }
+  TESTASSERT(not ring.push(data.data(), 10, data.data() + 10, 90));
+  TESTASSERT_EQ(1, ring.nof_dropped());
+
+  span<const uint8_t> block = ring.front_block();
+  TESTASSERT_EQ(10 * rec_len, block.size());
+  TESTASSERT_EQ(10, check_records(block, 100, 100));
+
+  // Records that do not fit at the end of the ring are stored at its start, and read in a second block
+  ring.release(7 * rec_len);
+  for (uint32_t i = 0; i < 5; ++i) {
+    TESTASSERT(ring.push(data.data(), 10, data.data() + 10, 90));
+  }
+  block = ring.front_block();
+  TESTASSERT_EQ(3 * rec_len, block.size());
+  ring.release(block.size());
+  block = ring.front_block();
+  TESTASSERT_EQ(5 * rec_len, block.size());
+  TESTASSERT_EQ(5, check_records(block, 100, 100));
+  ring.release(block.size());
+  TESTASSERT(ring.front_block().empty());
+
+  // Records larger than the ring are dropped
+  std::vector<uint8_t> large(ring.capacity());
+  TESTASSERT(not ring.push(data.data(), 10, large.data(), large.size()));
+  return SRSRAN_SUCCESS;
+}
+
+int test_snaplen()
+{
+  std::vector<uint8_t> data(100);
+  std::iota(data.begin(), data.end(), 0);
+
+  pcap_capture_ring ring(0);
+  TESTASSERT(ring.init(4096));
+  ring.set_snaplen(40);
+  TESTASSERT(ring.push(data.data(), 30, data.data() + 30, 70));
+  TESTASSERT(ring.push(data.data(), 30, data.data() + 30, 5));
+  TESTASSERT(ring.push(data.data(), 50, data.data() + 50, 50));
+
+  span<const uint8_t> block = ring.front_block();
+  TESTASSERT_EQ(1, check_records(block.subspan(0, rec_hdr_len + 40), 40, 100));
+  TESTASSERT_EQ(1, check_records(block.subspan(rec_hdr_len + 40, rec_hdr_len + 35), 35, 35));
+  TESTASSERT_EQ(1, check_records(block.last(rec_hdr_len + 40), 40, 100));
+  return SRSRAN_SUCCESS;
+}
+
+int test_concurrent_producers()
+{
+  std::vector<uint8_t> data(64);
+  std::iota(data.begin(), data.end(), 0);
+  const uint32_t nof_threads = 4, nof_records = 10000;
+
+  pcap_capture_ring ring(4096);
+  TESTASSERT(ring.init(64 * 1024));
+  std::vector<std::thread> producers;
+  for (uint32_t t = 0; t < nof_threads; ++t) {
+    producers.emplace_back([&]() {
+      for (uint32_t i = 0; i < nof_records;) {
+        if (ring.push(data.data(), 16, data.data() + 16, 48)) {
+          i++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  uint32_t nof_read = 0;
+  while (nof_read < nof_threads * nof_records) {
+    span<const uint8_t> block = ring.wait_block(std::chrono::milliseconds(1));
+    nof_read += check_records(block, 64, 64);
+    ring.release(block.size());
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  TESTASSERT(ring.front_block().empty());
+
+  // stop() wakes up the writer without waiting for the timeout
+  std::thread stopper([&ring]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ring.stop();
+  });
+  auto t0 = std::chrono::steady_clock::now();
+  TESTASSERT(ring.wait_block(std::chrono::seconds(10)).empty());
+  TESTASSERT(std::chrono::steady_clock::now() - t0 < std::chrono::seconds(5));
+  stopper.join();
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_push_and_wrap_around() == SRSRAN_SUCCESS);
+  TESTASSERT(test_snaplen() == SRSRAN_SUCCESS);
+  TESTASSERT(test_concurrent_producers() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pkt_trace.h"
+#include "srsran/common/test_common.h"
+
+using namespace srsran;
+
+int test_sampling()
+{
+  // Disabled by default
+  pkt_trace_t trace;
+  trace.start();
+  TESTASSERT(not trace.sampled);
+
+  pkt_trace_set_period(4);
+  uint32_t nof_sampled = 0;
+  for (uint32_t i = 0; i < 40; ++i) {
+    trace.start();
+    nof_sampled += trace.sampled ? 1 : 0;
+  }
+  TESTASSERT_EQ(10, nof_sampled);
+
+  pkt_trace_set_period(0);
+  trace.start();
+  TESTASSERT(not trace.sampled);
+  return SRSRAN_SUCCESS;
+}
+
+int test_latency_hist()
+{
+  pkt_latency_hist_t hist;
+  hist.add(0);
+  hist.add(1);
+  hist.add(3);
+  hist.add(1000);
+  hist.add((int64_t)1 << 40);
+  TESTASSERT_EQ(1, hist.bins[0]);
+  TESTASSERT_EQ(1, hist.bins[1]);
+  TESTASSERT_EQ(1, hist.bins[2]);
+  TESTASSERT_EQ(1, hist.bins[10]);
+  TESTASSERT_EQ(1, hist.bins[pkt_latency_hist_t::nof_bins - 1]);
+  TESTASSERT_EQ(5, hist.count);
+  TESTASSERT_EQ((int64_t)1 << 40, hist.max_us);
+
+  // Each value falls in the bin whose lower bound is the highest one not above it
+  TESTASSERT(pkt_latency_hist_t::bin_lower_us(2) <= 3 and 3 < pkt_latency_hist_t::bin_lower_us(3));
+  TESTASSERT(pkt_latency_hist_t::bin_lower_us(10) <= 1000 and 1000 < pkt_latency_hist_t::bin_lower_us(11));
+  return SRSRAN_SUCCESS;
+}
+
+int test_latency_breakdown()
+{
+  pkt_trace_set_period(1);
+  pkt_trace_t trace;
+  trace.start();
+  TESTASSERT(trace.sampled);
+  trace.stamp(pkt_trace_point::pdcp_tx);
+  trace.stamp(pkt_trace_point::rlc_tx);
+  trace.stamp(pkt_trace_point::rlc_read);
+
+  // Overwrite the timestamps with known intervals
+  tsc_clock::time_point t0 = trace.tp[(size_t)pkt_trace_point::gtpu_rx];
+  trace.tp[(size_t)pkt_trace_point::pdcp_tx]  = t0 + std::chrono::microseconds(10);
+  trace.tp[(size_t)pkt_trace_point::rlc_tx]   = t0 + std::chrono::microseconds(40);
+  trace.tp[(size_t)pkt_trace_point::rlc_read] = t0 + std::chrono::microseconds(2040);
+
+  pkt_latency_metrics_t metrics;
+  metrics.add(trace);
+  TESTASSERT_EQ(10, metrics.gtpu.total_us);
+  TESTASSERT_EQ(30, metrics.pdcp.total_us);
+  TESTASSERT_EQ(2000, metrics.rlc_queue.total_us);
+  TESTASSERT_EQ(2040, metrics.total.total_us);
+  TESTASSERT_EQ(1, metrics.total.count);
+  pkt_trace_set_period(0);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_sampling() == SRSRAN_SUCCESS);
+  TESTASSERT(test_latency_hist() == SRSRAN_SUCCESS);
+  TESTASSERT(test_latency_breakdown() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
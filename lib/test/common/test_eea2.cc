@@ -24,6 +24,7 @@
 #include <stdlib.h>
 
 #include "srsran/common/liblte_security.h"
+#include "srsran/common/security.h"
 #include "srsran/common/test_common.h"
 #include "srsran/srsran.h"
 
@@ -455,6 +456,34 @@ int test_set_1_invalid()
   return SRSRAN_SUCCESS;
 }
 
+// The cached key schedule must give the same ciphertext as the per-PDU key schedule, also when ciphering in place
+int test_cached_key_schedule()
+{
+  uint8_t key[] = {0xd3, 0xc5, 0xd5, 0x92, 0x32, 0x7f, 0xb1, 0x1c, 0x40, 0x35, 0xc6, 0x68, 0x0a, 0xf8, 0xc6, 0xd1};
+  uint8_t msg[200];
+  uint8_t ct_exp[200];
+  uint8_t buf[200];
+
+  srsran::security_128_aes_ctx_t aes;
+  srsran::security_128_aes_set_key(aes, key);
+  for (uint32_t len = 1; len <= sizeof(msg); len++) {
+    uint32_t count     = 0x398a59b4 + len;
+    uint8_t  bearer    = len % 32;
+    uint8_t  direction = len % 2;
+    for (uint32_t i = 0; i < len; i++) {
+      msg[i] = (uint8_t)(i * 37 + len);
+    }
+    TESTASSERT(liblte_security_encryption_eea2(key, count, bearer, direction, msg, len * 8, ct_exp) == LIBLTE_SUCCESS);
+
+    memcpy(buf, msg, len);
+    TESTASSERT(srsran::security_128_eea2(aes, count, bearer, direction, buf, len, buf) == SRSRAN_SUCCESS);
+    TESTASSERT(arrcmp(ct_exp, buf, len) == 0);
+    TESTASSERT(srsran::security_128_eea2(aes, count, bearer, direction, buf, len, buf) == SRSRAN_SUCCESS);
+    TESTASSERT(arrcmp(msg, buf, len) == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
 /*
  * Functions
  */
@@ -469,4 +498,5 @@ int main(int argc, char* argv[])
   TESTASSERT(test_set_6() == SRSRAN_SUCCESS);
   TESTASSERT(test_set_1_block_size() == SRSRAN_SUCCESS);
   TESTASSERT(test_set_1_invalid() == SRSRAN_SUCCESS);
+  TESTASSERT(test_cached_key_schedule() == SRSRAN_SUCCESS);
 }
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "srsran/common/liblte_security.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include "srsran/srsran.h"
+
+/*
+ * Tests
+ *
+ * Document Reference: 33.401 V14.6.0 Annex C.2
+ *
+ */
+
+int test_set_2()
+{
+  uint8_t  key[]     = {0xd3, 0xc5, 0xd5, 0x92, 0x32, 0x7f, 0xb1, 0x1c, 0x40, 0x35, 0xc6, 0x68, 0x0a, 0xf8, 0xc6, 0xd1};
+  uint32_t count     = 0x398a59b4;
+  uint8_t  bearer    = 0x1a;
+  uint8_t  direction = 1;
+  uint32_t len_bits = 64, len_bytes = (len_bits + 7) / 8;
+  uint8_t  msg[] = {0x48, 0x45, 0x83, 0xd5, 0xaf, 0xe0, 0x82, 0xae};
+  uint8_t  mt[]  = {0xb9, 0x37, 0x87, 0xe6};
+
+  uint8_t mac[4];
+
+  // gen mac
+  srsran::security_128_eia2(key, count, bearer, direction, msg, len_bytes, mac);
+  for (int i = 0; i < 4; i++) {
+    TESTASSERT(mac[i] == mt[i]);
+  }
+
+  // gen mac with the cached key schedule
+  srsran::security_128_aes_ctx_t aes;
+  srsran::security_128_aes_set_key(aes, key);
+  srsran::security_128_eia2(aes, count, bearer, direction, msg, len_bytes, mac);
+  for (int i = 0; i < 4; i++) {
+    TESTASSERT(mac[i] == mt[i]);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_set_5()
+{
+  uint8_t  key[]     = {0x83, 0xfd, 0x23, 0xa2, 0x44, 0xa7, 0x4c, 0xf3, 0x58, 0xda, 0x30, 0x19, 0xf1, 0x72, 0x26, 0x35};
+  uint32_t count     = 0x36af6144;
+  uint8_t  bearer    = 0x0f;
+  uint8_t  direction = 1;
+  uint32_t len_bits = 768, len_bytes = (len_bits + 7) / 8;
+  uint8_t  msg[] = {0x35, 0xc6, 0x87, 0x16, 0x63, 0x3c, 0x66, 0xfb, 0x75, 0x0c, 0x26, 0x68, 0x65, 0xd5, 0x3c, 0x11,
+                   0xea, 0x05, 0xb1, 0xe9, 0xfa, 0x49, 0xc8, 0x39, 0x8d, 0x48, 0xe1, 0xef, 0xa5, 0x90, 0x9d, 0x39,
+                   0x47, 0x90, 0x28, 0x37, 0xf5, 0xae, 0x96, 0xd5, 0xa0, 0x5b, 0xc8, 0xd6, 0x1c, 0xa8, 0xdb, 0xef,
+                   0x1b, 0x13, 0xa4, 0xb4, 0xab, 0xfe, 0x4f, 0xb1, 0x00, 0x60, 0x45, 0xb6, 0x74, 0xbb, 0x54, 0x72,
+                   0x93, 0x04, 0xc3, 0x82, 0xbe, 0x53, 0xa5, 0xaf, 0x05, 0x55, 0x61, 0x76, 0xf6, 0xea, 0xa2, 0xef,
+                   0x1d, 0x05, 0xe4, 0xb0, 0x83, 0x18, 0x1e, 0xe6, 0x74, 0xcd, 0xa5, 0xa4, 0x85, 0xf7, 0x4d, 0x7a};
+  uint8_t  mt[]  = {0xe6, 0x57, 0xe1, 0x82};
+
+  uint8_t mac[4];
+
+  // gen mac
+  srsran::security_128_eia2(key, count, bearer, direction, msg, len_bytes, mac);
+  for (int i = 0; i < 4; i++) {
+    TESTASSERT(mac[i] == mt[i]);
+  }
+
+  // gen mac with the cached key schedule
+  srsran::security_128_aes_ctx_t aes;
+  srsran::security_128_aes_set_key(aes, key);
+  srsran::security_128_eia2(aes, count, bearer, direction, msg, len_bytes, mac);
+  for (int i = 0; i < 4; i++) {
+    TESTASSERT(mac[i] == mt[i]);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * The cached key schedule must give the same MAC as the per-PDU key schedule for any message length, in particular
+ * around the block boundaries of the CMAC
+ */
+int test_cached_key_schedule()
+{
+  uint8_t key[] = {0x2b, 0xd6, 0x45, 0x9f, 0x82, 0xc5, 0xb3, 0x00, 0x95, 0x2c, 0x49, 0x10, 0x48, 0x81, 0xff, 0x48};
+  uint8_t msg[200];
+  for (uint32_t i = 0; i < sizeof(msg); i++) {
+    msg[i] = (uint8_t)(i * 37 + 11);
+  }
+
+  srsran::security_128_aes_ctx_t aes;
+  srsran::security_128_aes_set_key(aes, key);
+  for (uint32_t len = 0; len <= sizeof(msg); len++) {
+    uint32_t count      = 0x1000 + len;
+    uint8_t  mac[4]     = {};
+    uint8_t  mac_exp[4] = {};
+    liblte_security_128_eia2(key, count, len % 32, len % 2, msg, len, mac_exp);
+    srsran::security_128_eia2(aes, count, len % 32, len % 2, msg, len, mac);
+    for (int i = 0; i < 4; i++) {
+      TESTASSERT(mac[i] == mac_exp[i]);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Functions
+ */
+
+int main(int argc, char* argv[])
+{
+  TESTASSERT(test_set_2() == SRSRAN_SUCCESS);
+  TESTASSERT(test_set_5() == SRSRAN_SUCCESS);
+  TESTASSERT(test_cached_key_schedule() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
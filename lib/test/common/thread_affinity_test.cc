@@ -0,0 +1,79 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/thread_affinity.h"
+#include "srsran/common/test_common.h"
+#include <pthread.h>
+#include <sched.h>
+
+int test_parse_core_list()
+{
+  std::vector<uint32_t> cores;
+
+  TESTASSERT(srsran::parse_core_list("", cores));
+  TESTASSERT(cores.empty());
+
+  TESTASSERT(srsran::parse_core_list("3", cores));
+  TESTASSERT(cores == std::vector<uint32_t>({3}));
+
+  TESTASSERT(srsran::parse_core_list("2-5,8,10-11", cores));
+  TESTASSERT(cores == std::vector<uint32_t>({2, 3, 4, 5, 8, 10, 11}));
+
+  // TEST: malformed lists are rejected
+  TESTASSERT(not srsran::parse_core_list("5-2", cores));
+  TESTASSERT(not srsran::parse_core_list("a", cores));
+  TESTASSERT(not srsran::parse_core_list("1,,2", cores));
+  TESTASSERT(not srsran::parse_core_list("1-", cores));
+  TESTASSERT(not srsran::parse_core_list("100000", cores));
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_apply_thread_affinity()
+{
+  // TEST: threads of a class without placement keep the cores they had
+  cpu_set_t before, after;
+  TESTASSERT(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &before) == 0);
+  TESTASSERT(srsran::apply_thread_affinity(srsran::thread_class_t::stack));
+  TESTASSERT(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &after) == 0);
+  TESTASSERT(CPU_EQUAL(&before, &after));
+
+  // TEST: the thread is pinned to the cores of its class, take one it is already allowed to run on
+  uint32_t core = 0;
+  while (not CPU_ISSET(core, &before)) {
+    core++;
+  }
+  srsran::thread_affinity_t affinity = {};
+  affinity.cores                     = {core};
+  srsran::set_thread_affinity(srsran::thread_class_t::phy_worker, affinity);
+  TESTASSERT(srsran::apply_thread_affinity(srsran::thread_class_t::phy_worker));
+  TESTASSERT(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &after) == 0);
+  TESTASSERT(CPU_COUNT(&after) == 1 && CPU_ISSET(core, &after));
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_parse_core_list() == SRSRAN_SUCCESS);
+  TESTASSERT(test_apply_thread_affinity() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
@@ -448,6 +448,60 @@ void timers_test7()
   TESTASSERT(timers.nof_running_timers() == 1 and timers.nof_timers() == 3);
 }
 
+/**
+ * Description:
+ * - check that timers spanning the upper levels of the wheel expire at the right tic, when many long timers are running
+ * - check that timers run from an expiry callback with duration 1 expire in the next tic
+ */
+void timers_test8()
+{
+  const size_t  nof_timers = 1000;
+  timer_handler timers(nof_timers);
+  std::mt19937  rgen(0);
+
+  // Start with a time offset, so that the timers cross the wrap-around of the upper level indexes
+  for (size_t i = 0; i < 1000; ++i) {
+    timers.step_all();
+  }
+
+  std::vector<unique_timer> tlist(nof_timers);
+  std::vector<uint32_t>     expiry_tic(nof_timers, 0);
+  uint32_t                  tic = 0;
+  for (size_t i = 0; i < nof_timers; ++i) {
+    tlist[i] = timers.get_unique_timer();
+    // durations up to 2^18 tics, a few of them below the level 0 size
+    uint32_t dur = 1U + std::uniform_int_distribution<uint32_t>{0, (i % 10 == 0) ? 255U : (1U << 18U)}(rgen);
+    tlist[i].set(dur, [&expiry_tic, &tic, i](uint32_t tid) { expiry_tic[i] = tic; });
+    tlist[i].run();
+  }
+  TESTASSERT(timers.nof_running_timers() == nof_timers);
+
+  for (tic = 1; tic <= (1U << 18U) + 1; ++tic) {
+    timers.step_all();
+  }
+  TESTASSERT(timers.nof_running_timers() == 0);
+  for (size_t i = 0; i < nof_timers; ++i) {
+    TESTASSERT(tlist[i].is_expired());
+    TESTASSERT(expiry_tic[i] == tlist[i].duration());
+  }
+
+  // timer restarted from its own callback
+  uint32_t     count = 0;
+  unique_timer t     = timers.get_unique_timer();
+  t.set(1, [&t, &count](uint32_t tid) {
+    if (++count < 3) {
+      t.run();
+    }
+  });
+  t.run();
+  for (size_t i = 0; i < 3; ++i) {
+    timers.step_all();
+    TESTASSERT(count == i + 1);
+  }
+  timers.step_all();
+  TESTASSERT(count == 3 and not t.is_running());
+}
+
 int main()
 {
   timers_test1();
@@ -457,6 +511,7 @@ int main()
   timers_test5();
   timers_test6();
   timers_test7();
+  timers_test8();
   printf("Success\n");
   return 0;
 }
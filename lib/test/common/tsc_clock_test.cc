@@ -0,0 +1,65 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/tsc_clock.h"
+#include <thread>
+
+using namespace srsran;
+
+int test_tsc_clock_monotonic()
+{
+  tsc_clock::time_point prev = tsc_clock::now();
+  for (uint32_t i = 0; i < 100000; ++i) {
+    tsc_clock::time_point t = tsc_clock::now();
+    TESTASSERT(t >= prev);
+    prev = t;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_tsc_clock_calibration()
+{
+  // The intervals measured by the clock match those of steady_clock
+  auto s0 = std::chrono::steady_clock::now();
+  auto t0 = tsc_clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  auto s1 = std::chrono::steady_clock::now();
+  auto t1 = tsc_clock::now();
+
+  int64_t steady_us = std::chrono::duration_cast<std::chrono::microseconds>(s1 - s0).count();
+  int64_t tsc_us    = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+  TESTASSERT(std::abs(tsc_us - steady_us) < steady_us / 50 + 100);
+
+  // The time points start from the steady_clock time of the calibration
+  int64_t offset_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(s1.time_since_epoch() - t1.time_since_epoch()).count();
+  TESTASSERT(std::abs(offset_ms) < 10);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_tsc_clock_monotonic() == SRSRAN_SUCCESS);
+  TESTASSERT(test_tsc_clock_calibration() == SRSRAN_SUCCESS);
+  printf("Counter frequency: %.3f MHz\n", tsc_clock::counter_frequency_hz() / 1e6);
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/tti_trace.h"
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace srsran;
+
+static const char* trace_filename = "tti_trace_test.json";
+
+std::string read_trace()
+{
+  std::ifstream     f(trace_filename);
+  std::stringstream ss;
+  ss << f.rdbuf();
+  return ss.str();
+}
+
+size_t count_occurrences(const std::string& s, const std::string& pattern)
+{
+  size_t n = 0;
+  for (size_t pos = s.find(pattern); pos != std::string::npos; pos = s.find(pattern, pos + 1)) {
+    n++;
+  }
+  return n;
+}
+
+int test_disabled_trace()
+{
+  // Nothing is recorded before the tracer is started
+  {
+    tti_trace_scope scope(tti_trace_event::txrx_run, 1);
+  }
+  TESTASSERT(tti_trace_write_chrome_json(trace_filename));
+  TESTASSERT_EQ(0, count_occurrences(read_trace(), "\"ph\":\"X\""));
+  return SRSRAN_SUCCESS;
+}
+
+int test_threads_trace()
+{
+  tti_trace_init(1000);
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < 4; ++t) {
+    threads.emplace_back([]() {
+      for (uint32_t tti = 0; tti < 100; ++tti) {
+        tti_trace_scope scope(tti_trace_event::sf_worker_work, tti);
+        tti_trace_scope ul_scope(tti_trace_event::cc_worker_ul, tti);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  TESTASSERT(tti_trace_write_chrome_json(trace_filename));
+  std::string trace = read_trace();
+  TESTASSERT_EQ(800, count_occurrences(trace, "\"ph\":\"X\""));
+  TESTASSERT_EQ(400, count_occurrences(trace, "\"name\":\"cc_worker_ul\""));
+  TESTASSERT_EQ(8, count_occurrences(trace, "\"args\":{\"tti_rx\":99}"));
+
+  // The export stops the tracer
+  {
+    tti_trace_scope scope(tti_trace_event::txrx_run, 1);
+  }
+  TESTASSERT(tti_trace_write_chrome_json(trace_filename));
+  TESTASSERT_EQ(0, count_occurrences(read_trace(), "\"name\":\"txrx_run\""));
+  return SRSRAN_SUCCESS;
+}
+
+int test_trace_wrap_around()
+{
+  // Only the newest records are kept once the buffer is full
+  tti_trace_init(10);
+  for (uint32_t tti = 0; tti < 25; ++tti) {
+    tti_trace_scope scope(tti_trace_event::mac_get_dl_sched, tti);
+  }
+  TESTASSERT(tti_trace_write_chrome_json(trace_filename));
+  std::string trace = read_trace();
+  TESTASSERT_EQ(10, count_occurrences(trace, "\"name\":\"mac_get_dl_sched\""));
+  TESTASSERT_EQ(0, count_occurrences(trace, "\"args\":{\"tti_tx_dl\":14}"));
+  TESTASSERT_EQ(1, count_occurrences(trace, "\"args\":{\"tti_tx_dl\":15}"));
+  TESTASSERT(trace.find("{\"tti_tx_dl\":15}") < trace.find("{\"tti_tx_dl\":24}"));
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_disabled_trace() == SRSRAN_SUCCESS);
+  TESTASSERT(test_threads_trace() == SRSRAN_SUCCESS);
+  TESTASSERT(test_trace_wrap_around() == SRSRAN_SUCCESS);
+  std::remove(trace_filename);
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "pdcp_lte_test.h"
+#include "srsran/common/thread_pool.h"
+#include <unistd.h>
+
+// RLC dummy that keeps all the PDUs, to check their order
+class rlc_collect_dummy : public rlc_dummy
+{
+public:
+  explicit rlc_collect_dummy(srslog::basic_logger& logger) : rlc_dummy(logger) {}
+  void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) override { pdus.push_back(std::move(sdu)); }
+
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+};
+
+srsran::pdcp_config_t make_drb_cfg()
+{
+  return {1,
+          srsran::PDCP_RB_IS_DRB,
+          srsran::SECURITY_DIRECTION_DOWNLINK,
+          srsran::SECURITY_DIRECTION_UPLINK,
+          srsran::PDCP_SN_LEN_12,
+          srsran::pdcp_t_reordering_t::ms500,
+          srsran::pdcp_discard_timer_t::infinity,
+          false,
+          srsran::srsran_rat_t::lte};
+}
+
+srsran::unique_byte_buffer_t make_test_sdu(uint32_t idx)
+{
+  srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+  sdu->N_bytes                     = 1 + (idx * 37) % 1500;
+  for (uint32_t i = 0; i < sdu->N_bytes; ++i) {
+    sdu->msg[i] = (uint8_t)(idx + i);
+  }
+  return sdu;
+}
+
+// Runs the stack tasks while the workers finish the jobs that were dropped
+void drain_tasks(srsue::stack_test_dummy& stack)
+{
+  for (uint32_t i = 0; i < 100; ++i) {
+    stack.run_pending_tasks();
+    usleep(1000);
+  }
+}
+
+// Runs the stack tasks until the RLC has received nof_pdus or a timeout of 5 seconds
+void wait_pdus(srsue::stack_test_dummy& stack, const rlc_collect_dummy& rlc, size_t nof_pdus)
+{
+  for (uint32_t i = 0; i < 50000 and rlc.pdus.size() < nof_pdus; ++i) {
+    stack.run_pending_tasks();
+    usleep(100);
+  }
+}
+
+/*
+ * The offloaded ciphering generates the same PDUs as the inline ciphering, in the same order
+ */
+int test_tx_crypto_offload(srsran::CIPHERING_ALGORITHM_ID_ENUM cipher_algo, srslog::basic_logger& logger)
+{
+  const uint32_t nof_sdus = 300;
+
+  srsran::as_security_config_t sec = sec_cfg;
+  sec.cipher_algo                  = cipher_algo;
+
+  pdcp_lte_test_helper pdcp_hlp(make_drb_cfg(), sec, logger);
+
+  rlc_collect_dummy       rlc(logger);
+  rrc_dummy               rrc(logger);
+  gw_dummy                gw(logger);
+  srsue::stack_test_dummy stack;
+  srsran::pdcp_entity_lte pdcp(&rlc, &rrc, &gw, &stack.task_sched, logger, 0);
+  TESTASSERT(pdcp.configure(make_drb_cfg()));
+  pdcp.config_security(sec);
+  pdcp.enable_integrity(srsran::DIRECTION_TXRX);
+  pdcp.enable_encryption(srsran::DIRECTION_TXRX);
+  pdcp.set_tx_crypto_offload(true);
+
+  std::vector<srsran::unique_byte_buffer_t> expected;
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    pdcp_hlp.pdcp.write_sdu(make_test_sdu(i));
+    expected.push_back(srsran::make_byte_buffer());
+    pdcp_hlp.rlc.get_last_sdu(expected.back());
+    pdcp.write_sdu(make_test_sdu(i));
+  }
+  TESTASSERT(rlc.pdus.empty());
+
+  wait_pdus(stack, rlc, nof_sdus);
+  TESTASSERT(rlc.pdus.size() == nof_sdus);
+  TESTASSERT(pdcp.nof_pending_tx_crypto_pdus() == 0);
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    TESTASSERT(rlc.pdus[i]->md.pdcp_sn == i);
+    TESTASSERT(rlc.pdus[i]->N_bytes == expected[i]->N_bytes);
+    TESTASSERT(memcmp(rlc.pdus[i]->msg, expected[i]->msg, expected[i]->N_bytes) == 0);
+  }
+
+  // Without ciphering the PDUs are passed to the RLC right away
+  pdcp.config_security({k_int, k_enc, k_int, k_enc, sec.integ_algo, srsran::CIPHERING_ALGORITHM_ID_EEA0});
+  pdcp.write_sdu(make_test_sdu(0));
+  TESTASSERT(rlc.pdus.size() == nof_sdus + 1);
+
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * The PDUs that are in the workers when the entity is reset or destroyed are dropped
+ */
+int test_tx_crypto_offload_reset(srslog::basic_logger& logger)
+{
+  rlc_collect_dummy       rlc(logger);
+  rrc_dummy               rrc(logger);
+  gw_dummy                gw(logger);
+  srsue::stack_test_dummy stack;
+
+  std::unique_ptr<srsran::pdcp_entity_lte> pdcp(
+      new srsran::pdcp_entity_lte(&rlc, &rrc, &gw, &stack.task_sched, logger, 0));
+  TESTASSERT(pdcp->configure(make_drb_cfg()));
+  pdcp->config_security(sec_cfg);
+  pdcp->enable_encryption(srsran::DIRECTION_TXRX);
+  pdcp->set_tx_crypto_offload(true);
+
+  for (uint32_t i = 0; i < 10; ++i) {
+    pdcp->write_sdu(make_test_sdu(i));
+  }
+  TESTASSERT(pdcp->nof_pending_tx_crypto_pdus() == 10);
+  pdcp->reset();
+  TESTASSERT(pdcp->nof_pending_tx_crypto_pdus() == 0);
+
+  // The entity is usable again after being re-enabled
+  pdcp->set_enabled(true);
+  pdcp->write_sdu(make_test_sdu(0));
+  wait_pdus(stack, rlc, 1);
+  TESTASSERT(rlc.pdus.size() == 1);
+
+  for (uint32_t i = 0; i < 10; ++i) {
+    pdcp->write_sdu(make_test_sdu(i));
+  }
+  pdcp.reset();
+  drain_tasks(stack);
+  TESTASSERT(rlc.pdus.size() == 1);
+
+  return SRSRAN_SUCCESS;
+}
+
+int run_all_tests()
+{
+  // Setup log
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("PDCP", false);
+  logger.set_level(srslog::basic_levels::info);
+  logger.set_hex_dump_max_size(128);
+
+  TESTASSERT(test_tx_crypto_offload(srsran::CIPHERING_ALGORITHM_ID_128_EEA1, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_tx_crypto_offload(srsran::CIPHERING_ALGORITHM_ID_128_EEA2, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_tx_crypto_offload(srsran::CIPHERING_ALGORITHM_ID_128_EEA3, logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_tx_crypto_offload_reset(logger) == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+  srsran::get_crypto_workers().set_nof_workers(2);
+  srsran::get_crypto_workers().start();
+
+  int ret = run_all_tests();
+  srsran::get_crypto_workers().stop();
+  if (ret != SRSRAN_SUCCESS) {
+    fprintf(stderr, "pdcp_lte_test_crypto_offload() failed\n");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -124,6 +124,140 @@ int test_tx_sdu_discard(const srsran::pdcp_lte_state_t& init_state,
   pdcp->notify_delivery(sns_notified); // PDCP should not find PDU to notify.
   return 0;
 }
+/*
+ * Test discard of SDUs written at different TTIs. The SDUs expire in arrival order, each after its own timeout
+ */
+int test_tx_sdu_discard_staggered(srsran::pdcp_discard_timer_t discard_timeout, srslog::basic_logger& logger)
+{
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::PDCP_SN_LEN_12,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               discard_timeout,
+                               false,
+                               srsran::srsran_rat_t::lte};
+
+  pdcp_lte_test_helper     pdcp_hlp(cfg, sec_cfg, logger);
+  srsran::pdcp_entity_lte* pdcp    = &pdcp_hlp.pdcp;
+  rlc_dummy*               rlc     = &pdcp_hlp.rlc;
+  srsue::stack_test_dummy* stack   = &pdcp_hlp.stack;
+  uint32_t                 timeout = static_cast<uint32_t>(cfg.discard_timer);
+
+  pdcp_hlp.set_pdcp_initial_state(normal_init_state);
+
+  auto write_sdu = [pdcp]() {
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    sdu->append_bytes(sdu1, sizeof(sdu1));
+    pdcp->write_sdu(std::move(sdu));
+  };
+
+  // SN 0 and 1 are written at TTI 0, SN 2 at TTI 10 and SN 3 at TTI 20
+  write_sdu();
+  write_sdu();
+  for (uint32_t i = 0; i < 10; ++i) {
+    stack->run_tti();
+  }
+  write_sdu();
+  for (uint32_t i = 0; i < 10; ++i) {
+    stack->run_tti();
+  }
+  write_sdu();
+  TESTASSERT(pdcp->nof_discard_timers() == 4);
+
+  // SN 1 is delivered, so only SN 0 expires at TTI 50
+  srsran::pdcp_sn_vector_t sns_notified;
+  sns_notified.push_back(1);
+  pdcp->notify_delivery(sns_notified);
+  for (uint32_t i = 20; i < timeout - 1; ++i) {
+    stack->run_tti();
+  }
+  TESTASSERT(rlc->discard_count == 0);
+  stack->run_tti();
+  TESTASSERT(rlc->discard_count == 1);
+  TESTASSERT(pdcp->nof_discard_timers() == 2);
+
+  // SN 2 expires at TTI 60 and SN 3 at TTI 70
+  for (uint32_t i = 0; i < 9; ++i) {
+    stack->run_tti();
+  }
+  TESTASSERT(rlc->discard_count == 1);
+  stack->run_tti();
+  TESTASSERT(rlc->discard_count == 2);
+  for (uint32_t i = 0; i < 9; ++i) {
+    stack->run_tti();
+  }
+  TESTASSERT(rlc->discard_count == 2);
+  stack->run_tti();
+  TESTASSERT(rlc->discard_count == 3);
+  TESTASSERT(pdcp->nof_discard_timers() == 0);
+
+  // The discard ring restarts after being drained
+  write_sdu();
+  for (uint32_t i = 0; i < timeout - 1; ++i) {
+    stack->run_tti();
+  }
+  TESTASSERT(rlc->discard_count == 3);
+  stack->run_tti();
+  TESTASSERT(rlc->discard_count == 4);
+  return 0;
+}
+
+/*
+ * Test hand over of the buffered SDUs for forwarding, across the SN wrap-around
+ */
+int test_tx_sdu_forward(srsran::pdcp_discard_timer_t discard_timeout, srslog::basic_logger& logger)
+{
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::PDCP_SN_LEN_12,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               discard_timeout,
+                               false,
+                               srsran::srsran_rat_t::lte};
+
+  pdcp_lte_test_helper     pdcp_hlp(cfg, sec_cfg, logger);
+  srsran::pdcp_entity_lte* pdcp = &pdcp_hlp.pdcp;
+
+  srsran::pdcp_lte_state_t init_state = {};
+  init_state.next_pdcp_tx_sn          = 4093;
+  pdcp_hlp.set_pdcp_initial_state(init_state);
+
+  // Write SDUs with SN 4093, 4094, 4095, 0 and 1
+  for (uint32_t i = 0; i < 5; ++i) {
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    sdu->append_bytes(sdu1, sizeof(sdu1));
+    pdcp->write_sdu(std::move(sdu));
+  }
+  TESTASSERT(pdcp->nof_discard_timers() == 5);
+
+  srsran::pdcp_sn_vector_t sns_notified;
+  sns_notified.push_back(4094);
+  pdcp->notify_delivery(sns_notified);
+
+  // The SDUs not yet delivered are handed over in COUNT order, and the timers are stopped
+  std::vector<srsran::unique_byte_buffer_t> fwd_sdus = pdcp->get_buffered_pdus();
+  TESTASSERT(pdcp->nof_discard_timers() == 0);
+  TESTASSERT(fwd_sdus.size() == 4);
+  uint32_t expected_sns[] = {4093, 4095, 0, 1};
+  for (uint32_t i = 0; i < fwd_sdus.size(); ++i) {
+    TESTASSERT(fwd_sdus[i]->md.pdcp_sn == expected_sns[i]);
+    TESTASSERT(fwd_sdus[i]->N_bytes == sizeof(sdu1));
+  }
+  TESTASSERT(pdcp->get_buffered_pdus().empty());
+
+  // Late notifications for the forwarded SDUs are ignored
+  sns_notified.clear();
+  sns_notified.push_back(0);
+  pdcp->notify_delivery(sns_notified);
+  return 0;
+}
+
 /*
  * TX Test: PDCP Entity with SN LEN = 12 and 18.
  * PDCP entity configured with EIA2 and EEA2
@@ -141,6 +275,18 @@ int test_tx_discard_all(srslog::basic_logger& logger)
    * Test TX PDU discard.
    */
   TESTASSERT(test_tx_sdu_discard(normal_init_state, srsran::pdcp_discard_timer_t::ms50, logger) == 0);
+
+  /*
+   * TX Test 3: PDCP Entity with SN LEN = 12
+   * Test TX PDU discard of SDUs written at different TTIs.
+   */
+  TESTASSERT(test_tx_sdu_discard_staggered(srsran::pdcp_discard_timer_t::ms50, logger) == 0);
+
+  /*
+   * TX Test 4: PDCP Entity with SN LEN = 12
+   * Test forwarding of the buffered PDUs.
+   */
+  TESTASSERT(test_tx_sdu_forward(srsran::pdcp_discard_timer_t::ms50, logger) == 0);
   return 0;
 }
 
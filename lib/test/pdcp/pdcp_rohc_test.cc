@@ -0,0 +1,281 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsran/common/test_common.h"
+#include "srsran/upper/pdcp_rohc.h"
+
+struct test_pkt_t {
+  uint8_t  protocol = 17;
+  uint16_t ip_id    = 0;
+  uint16_t udp_csum = 0;
+  uint32_t ssrc     = 0x11223344;
+  bool     rtp      = true;
+  bool     m        = false;
+  uint16_t sn       = 0;
+  uint32_t ts       = 0;
+  uint32_t nof_data = 32;
+};
+
+srsran::byte_buffer_t make_packet(const test_pkt_t& p)
+{
+  srsran::byte_buffer_t pkt;
+  uint32_t              hdr_len = p.rtp ? 40 : 28;
+  pkt.N_bytes                   = hdr_len + p.nof_data;
+
+  uint8_t* ip = pkt.msg;
+  memset(ip, 0, hdr_len);
+  ip[0] = 0x45;
+  ip[2] = pkt.N_bytes >> 8;
+  ip[3] = pkt.N_bytes & 0xff;
+  ip[4] = p.ip_id >> 8;
+  ip[5] = p.ip_id & 0xff;
+  ip[6] = 0x40;
+  ip[8] = 64;
+  ip[9] = p.protocol;
+  uint8_t addr[8] = {192, 168, 3, 1, 172, 16, 0, 2};
+  memcpy(&ip[12], addr, sizeof(addr));
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < 20; i += 2) {
+    sum += (ip[i] << 8) | ip[i + 1];
+  }
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  ip[10] = (~sum >> 8) & 0xff;
+  ip[11] = ~sum & 0xff;
+
+  uint8_t* udp = &ip[20];
+  udp[0]       = 0x9c;
+  udp[1]       = 0x40;
+  udp[2]       = 0x9c;
+  udp[3]       = 0x42;
+  udp[4]       = (pkt.N_bytes - 20) >> 8;
+  udp[5]       = (pkt.N_bytes - 20) & 0xff;
+  udp[6]       = p.udp_csum >> 8;
+  udp[7]       = p.udp_csum & 0xff;
+
+  if (p.rtp) {
+    uint8_t* rtp = &udp[8];
+    rtp[0]       = 0x80;
+    rtp[1]       = (p.m ? 0x80 : 0) | 96;
+    rtp[2]       = p.sn >> 8;
+    rtp[3]       = p.sn & 0xff;
+    for (uint32_t i = 0; i < 4; ++i) {
+      rtp[4 + i] = (p.ts >> (24 - 8 * i)) & 0xff;
+      rtp[8 + i] = (p.ssrc >> (24 - 8 * i)) & 0xff;
+    }
+  }
+  for (uint32_t i = 0; i < p.nof_data; ++i) {
+    ip[hdr_len + i] = (p.sn + i) & 0xff;
+  }
+  return pkt;
+}
+
+srsran::pdcp_rohc_config_t make_rohc_cfg()
+{
+  srsran::pdcp_rohc_config_t cfg;
+  cfg.enabled     = true;
+  cfg.max_cid     = 15;
+  cfg.profile_rtp = true;
+  cfg.profile_udp = true;
+  return cfg;
+}
+
+// Compresses and decompresses the packet. Returns the size of the compressed packet
+uint32_t roundtrip(srsran::pdcp_rohc& comp, srsran::pdcp_rohc& decomp, const test_pkt_t& p)
+{
+  srsran::byte_buffer_t orig = make_packet(p);
+  srsran::byte_buffer_t pkt  = orig;
+  TESTASSERT(comp.compress(&pkt));
+  uint32_t rohc_len = pkt.N_bytes;
+  TESTASSERT(decomp.decompress(&pkt));
+  TESTASSERT_EQ(orig.N_bytes, pkt.N_bytes);
+  TESTASSERT(memcmp(orig.msg, pkt.msg, orig.N_bytes) == 0);
+  return rohc_len;
+}
+
+int test_rtp_stream(srslog::basic_logger& logger)
+{
+  srsran::pdcp_rohc comp(logger);
+  srsran::pdcp_rohc decomp(logger);
+  comp.configure(make_rohc_cfg());
+  decomp.configure(make_rohc_cfg());
+
+  // Start close to the wrap-around of the RTP SN
+  test_pkt_t p;
+  p.sn    = 65530;
+  p.ts    = 1000;
+  p.ip_id = 1000;
+
+  // The IR packets are sent until the TS_STRIDE is known, then the headers are compressed to the UO-0 octet
+  uint32_t nof_ir = 0;
+  for (uint32_t i = 0; i < 100; ++i) {
+    uint32_t len = roundtrip(comp, decomp, p);
+    if (len > p.nof_data + 2) {
+      TESTASSERT(i < 5);
+      nof_ir++;
+    } else {
+      TESTASSERT_EQ(p.nof_data + 2, len);
+    }
+    p.sn++;
+    p.ts += 160;
+    p.ip_id++;
+  }
+  TESTASSERT(nof_ir >= 3);
+
+  // A talk spurt after a silence is sent in UOR-2 packets, the first one with the M bit
+  p.ts += 160 * 20;
+  p.m = true;
+  TESTASSERT_EQ(p.nof_data + 4, roundtrip(comp, decomp, p));
+  p.m = false;
+  for (uint32_t i = 0; i < 10; ++i) {
+    p.sn++;
+    p.ts += 160;
+    p.ip_id++;
+    TESTASSERT_EQ(p.nof_data + (i < 2 ? 4 : 2), roundtrip(comp, decomp, p));
+  }
+
+  // A jump of the TS that does not fit in the UOR-2 packet is sent in IR packets
+  p.sn++;
+  p.ts += 160 * 1000;
+  p.ip_id++;
+  TESTASSERT(roundtrip(comp, decomp, p) > p.nof_data + 4);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_rtp_loss(srslog::basic_logger& logger)
+{
+  srsran::pdcp_rohc comp(logger);
+  srsran::pdcp_rohc decomp(logger);
+  comp.configure(make_rohc_cfg());
+  decomp.configure(make_rohc_cfg());
+
+  test_pkt_t p;
+  p.udp_csum = 0xabcd;
+  for (uint32_t i = 0; i < 10; ++i) {
+    roundtrip(comp, decomp, p);
+    p.sn++;
+    p.ts += 160;
+  }
+
+  // The IP-ID does not follow the SN, so it is sent with the UDP checksum after the UO-0 octet
+  for (uint32_t i = 0; i < 10; ++i) {
+    TESTASSERT_EQ(p.nof_data + 6, roundtrip(comp, decomp, p));
+    p.sn++;
+    p.ts += 160;
+  }
+
+  // Lost packets are recovered from the SN, up to the interpretation interval of UO-0
+  for (uint32_t i = 0; i < 10; ++i) {
+    srsran::byte_buffer_t pkt = make_packet(p);
+    TESTASSERT(comp.compress(&pkt));
+    p.sn++;
+    p.ts += 160;
+  }
+  TESTASSERT_EQ(p.nof_data + 6, roundtrip(comp, decomp, p));
+
+  // Corrupted headers fail the CRC
+  p.sn++;
+  p.ts += 160;
+  srsran::byte_buffer_t pkt = make_packet(p);
+  TESTASSERT(comp.compress(&pkt));
+  pkt.msg[1] ^= 0x08;
+  TESTASSERT(not decomp.decompress(&pkt));
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_udp_and_uncompressed(srslog::basic_logger& logger)
+{
+  srsran::pdcp_rohc comp(logger);
+  srsran::pdcp_rohc decomp(logger);
+  comp.configure(make_rohc_cfg());
+  decomp.configure(make_rohc_cfg());
+
+  // UDP packets without RTP header are compressed with profile 0x0002
+  test_pkt_t udp;
+  udp.rtp = false;
+  for (uint32_t i = 0; i < 10; ++i) {
+    uint32_t len = roundtrip(comp, decomp, udp);
+    if (i >= 3) {
+      TESTASSERT_EQ(udp.nof_data + 2, len);
+    }
+    udp.ip_id++;
+  }
+
+  // Other packets are sent with profile 0x0000, interleaved with the UDP flow
+  test_pkt_t tcp;
+  tcp.rtp      = false;
+  tcp.protocol = 6;
+  for (uint32_t i = 0; i < 10; ++i) {
+    uint32_t len = roundtrip(comp, decomp, tcp);
+    TESTASSERT_EQ(28 + tcp.nof_data + (i < 3 ? 3 : 0), len);
+    TESTASSERT_EQ(udp.nof_data + 2, roundtrip(comp, decomp, udp));
+    udp.ip_id++;
+  }
+
+  // Contexts are created for each RTP flow
+  test_pkt_t rtp[3];
+  for (uint32_t i = 0; i < 20; ++i) {
+    for (uint32_t j = 0; j < 3; ++j) {
+      rtp[j].ssrc = j;
+      rtp[j].sn++;
+      rtp[j].ts += 160;
+      rtp[j].ip_id++;
+      uint32_t len = roundtrip(comp, decomp, rtp[j]);
+      if (i >= 5) {
+        TESTASSERT_EQ(rtp[j].nof_data + 2, len);
+      }
+    }
+  }
+
+  // After a reset, the packets without context are discarded until the next IR
+  decomp.reset();
+  srsran::byte_buffer_t pkt = make_packet(udp);
+  TESTASSERT(comp.compress(&pkt));
+  TESTASSERT(not decomp.decompress(&pkt));
+  comp.reset();
+  TESTASSERT(roundtrip(comp, decomp, udp) > udp.nof_data + 2);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("PDCP", false);
+  logger.set_level(srslog::basic_levels::debug);
+  logger.set_hex_dump_max_size(128);
+
+  if (test_rtp_stream(logger) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "test_rtp_stream() failed\n");
+    return SRSRAN_ERROR;
+  }
+  if (test_rtp_loss(logger) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "test_rtp_loss() failed\n");
+    return SRSRAN_ERROR;
+  }
+  if (test_udp_and_uncompressed(logger) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "test_udp_and_uncompressed() failed\n");
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
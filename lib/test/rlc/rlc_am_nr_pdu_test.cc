@@ -2426,6 +2426,32 @@ int rlc_am_nr_control_pdu_test_nack_merge_range_range(rlc_am_nr_sn_size_t sn_siz
   return SRSRAN_SUCCESS;
 }
 
+// Test that merged NACKs never exceed the maximum NACK range
+int rlc_am_nr_control_pdu_test_nack_merge_max_range(rlc_am_nr_sn_size_t sn_size)
+{
+  test_delimit_logger delimiter("Control PDU ({} bit SN) test NACK merge: max range", to_number(sn_size));
+
+  const uint32_t mod_nr = cardinality(sn_size);
+
+  rlc_am_nr_status_pdu_t status_pdu(sn_size);
+  status_pdu.ack_sn = 1000;
+  for (uint32_t i = 0; i < 300; i++) {
+    rlc_status_nack_t nack;
+    nack.nack_sn = (500 + i) % mod_nr;
+    status_pdu.push_nack(nack);
+  }
+
+  TESTASSERT_EQ(2, status_pdu.nacks.size());
+  TESTASSERT_EQ(500, status_pdu.nacks[0].nack_sn);
+  TESTASSERT_EQ(true, status_pdu.nacks[0].has_nack_range);
+  TESTASSERT_EQ(255, status_pdu.nacks[0].nack_range);
+  TESTASSERT_EQ(755, status_pdu.nacks[1].nack_sn);
+  TESTASSERT_EQ(true, status_pdu.nacks[1].has_nack_range);
+  TESTASSERT_EQ(45, status_pdu.nacks[1].nack_range);
+
+  return SRSRAN_SUCCESS;
+}
+
 // Test status PDU for correct trimming and estimation of packed size
 // 1) Test init, copy and reset
 // 2) Test step-wise growth and trimming of status PDU while covering several corner cases
@@ -3025,6 +3051,16 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
+  if (rlc_am_nr_control_pdu_test_nack_merge_max_range(rlc_am_nr_sn_size_t::size12bits)) {
+    fprintf(stderr, "rlc_am_nr_control_pdu_test_nack_merge_max_range(size12bits) failed.\n");
+    return SRSRAN_ERROR;
+  }
+
+  if (rlc_am_nr_control_pdu_test_nack_merge_max_range(rlc_am_nr_sn_size_t::size18bits)) {
+    fprintf(stderr, "rlc_am_nr_control_pdu_test_nack_merge_max_range(size18bits) failed.\n");
+    return SRSRAN_ERROR;
+  }
+
   if (rlc_am_nr_control_pdu_test_trimming(rlc_am_nr_sn_size_t::size12bits)) {
     fprintf(stderr, "rlc_am_nr_control_pdu_test_trimming(size12bits) failed.\n");
     return SRSRAN_ERROR;
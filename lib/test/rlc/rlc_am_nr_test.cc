@@ -3365,6 +3365,64 @@ int full_rx_window_t_reassembly_expiry(rlc_am_nr_sn_size_t sn_size)
   return SRSRAN_SUCCESS;
 }
 
+/*
+ * Test that the buffer state is reported to the BSR callback only when it changes or after a PDU is read
+ */
+int bsr_report_test(rlc_am_nr_sn_size_t sn_size)
+{
+  rlc_am_tester tester(true, nullptr);
+  timer_handler timers(8);
+
+  test_delimit_logger delimiter("BSR report ({} bit SN)", to_number(sn_size));
+  rlc_am              rlc1(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+
+  uint32_t nof_reports = 0, last_newtx = 0, last_prio = 0;
+  rlc1.set_bsr_callback([&](uint32_t lcid, uint32_t newtx, uint32_t prio) {
+    nof_reports++;
+    last_newtx = newtx;
+    last_prio  = prio;
+  });
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_nr_config(to_number(sn_size)))) {
+    return SRSRAN_ERROR;
+  }
+
+  // The first query after configuring is always reported
+  TESTASSERT_EQ(0, rlc1.get_buffer_state());
+  TESTASSERT_EQ(1, nof_reports);
+
+  // Queries without state changes use the cached state
+  TESTASSERT_EQ(0, rlc1.get_buffer_state());
+  TESTASSERT_EQ(1, nof_reports);
+
+  uint32_t header_size   = sn_size == rlc_am_nr_sn_size_t::size12bits ? 2 : 3;
+  uint32_t payload_size  = 1;
+  uint32_t data_pdu_size = header_size + payload_size;
+  for (uint32_t i = 0; i < 2; i++) {
+    unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    sdu->msg[0]              = i;
+    sdu->N_bytes             = payload_size;
+    sdu->md.pdcp_sn          = i;
+    rlc1.write_sdu(std::move(sdu));
+  }
+  TESTASSERT_EQ(2 * data_pdu_size, rlc1.get_buffer_state());
+  TESTASSERT_EQ(2, nof_reports);
+  TESTASSERT_EQ(2 * data_pdu_size, last_newtx);
+  TESTASSERT_EQ(0, last_prio);
+  TESTASSERT_EQ(2 * data_pdu_size, rlc1.get_buffer_state());
+  TESTASSERT_EQ(2, nof_reports);
+
+  // Reading a PDU always triggers a report
+  byte_buffer_t pdu_buf;
+  pdu_buf.N_bytes = rlc1.read_pdu(pdu_buf.msg, data_pdu_size);
+  TESTASSERT_EQ(data_pdu_size, pdu_buf.N_bytes);
+  TESTASSERT_EQ(data_pdu_size, rlc1.get_buffer_state());
+  TESTASSERT_EQ(3, nof_reports);
+  TESTASSERT_EQ(data_pdu_size, last_newtx);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   // Setup the log message spy to intercept error and warning log entries from RLC
@@ -3395,6 +3453,7 @@ int main()
     TESTASSERT(window_checker_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(retx_segmentation_required_checker_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(basic_test(sn_size) == SRSRAN_SUCCESS);
+    TESTASSERT(bsr_report_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(lost_pdu_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(lost_pdu_duplicated_nack_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(lost_pdus_trimmed_nack_test(sn_size) == SRSRAN_SUCCESS);
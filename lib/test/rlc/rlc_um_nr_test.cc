@@ -626,6 +626,54 @@ int rlc_um_nr_test9()
   return SRSRAN_SUCCESS;
 }
 
+// Segments of one SDU received out of order and duplicated are reassembled in place into a single SDU
+int rlc_um_nr_test10()
+{
+  rlc_um_nr_test_context1 ctxt;
+
+  const uint32_t sdu_size = 40;
+
+  ctxt.tester.set_expected_sdu_len(sdu_size);
+
+  unique_byte_buffer_t sdu_buf = srsran::make_byte_buffer();
+  memset(sdu_buf->msg, 0x5a, sdu_size);
+  sdu_buf->N_bytes = sdu_size;
+  ctxt.rlc1.write_sdu(std::move(sdu_buf));
+
+  // Read PDUs from RLC1 with grant much smaller than SDU size
+  const uint32_t       max_num_pdus = 10;
+  uint32_t             num_pdus     = 0;
+  unique_byte_buffer_t pdu_bufs[max_num_pdus];
+
+  while (ctxt.rlc1.get_buffer_state() != 0 && num_pdus < max_num_pdus) {
+    pdu_bufs[num_pdus]          = srsran::make_byte_buffer();
+    int len                     = ctxt.rlc1.read_pdu(pdu_bufs[num_pdus]->msg, 10);
+    pdu_bufs[num_pdus]->N_bytes = len;
+    num_pdus++;
+  }
+
+  TESTASSERT(num_pdus > 4);
+
+  // Last segment first, then the odd and the even segments, with a duplicate in between
+  ctxt.rlc2.write_pdu(pdu_bufs[num_pdus - 1]->msg, pdu_bufs[num_pdus - 1]->N_bytes);
+  for (uint32_t i = 1; i < num_pdus - 1; i += 2) {
+    ctxt.rlc2.write_pdu(pdu_bufs[i]->msg, pdu_bufs[i]->N_bytes);
+  }
+  ctxt.rlc2.write_pdu(pdu_bufs[1]->msg, pdu_bufs[1]->N_bytes);
+  for (uint32_t i = 0; i < num_pdus - 1; i += 2) {
+    TESTASSERT(ctxt.tester.get_num_sdus() == 0);
+    ctxt.rlc2.write_pdu(pdu_bufs[i]->msg, pdu_bufs[i]->N_bytes);
+  }
+
+  TESTASSERT(ctxt.tester.get_num_sdus() == 1);
+  TESTASSERT(ctxt.tester.sdus.at(0)->N_bytes == sdu_size);
+  TESTASSERT(ctxt.tester.sdus.at(0)->msg[0] == 0x5a);
+
+  TESTASSERT(ctxt.timers.nof_running_timers() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
 #if PCAP
@@ -683,6 +731,11 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
+  if (rlc_um_nr_test10()) {
+    fprintf(stderr, "rlc_um_nr_test10() failed.\n");
+    return SRSRAN_ERROR;
+  }
+
 #if PCAP
   pcap_handle->close();
 #endif
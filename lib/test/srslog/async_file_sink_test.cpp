@@ -0,0 +1,156 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "file_test_utils.h"
+#include "src/srslog/sinks/async_file_sink.h"
+#include "test_dummies.h"
+#include "testing_helpers.h"
+#include <thread>
+
+using namespace srslog;
+
+static constexpr char log_filename[] = "async_file_sink_test.log";
+
+/// A Test-Specific Subclass of async_file_sink. This subclass provides public
+/// access to the data members of the parent class.
+class async_file_sink_subclass : public async_file_sink
+{
+public:
+  async_file_sink_subclass(std::string name, size_t max_size, std::chrono::seconds rotation_period) :
+    async_file_sink(std::move(name),
+                    max_size,
+                    rotation_period,
+                    0,
+                    std::unique_ptr<log_formatter>(new test_dummies::log_formatter_dummy))
+  {}
+
+  uint32_t get_num_of_files() const { return get_file_index(); }
+};
+
+static bool when_data_is_written_to_file_then_contents_are_valid()
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+  async_file_sink_subclass             file(log_filename, 0, std::chrono::seconds(0));
+
+  // Write more than the buffer capacity, so that the helper thread writes while new data is appended.
+  std::vector<std::string> entries;
+  for (unsigned i = 0; i != 1000; ++i) {
+    std::string entry = "Test log entry - " + std::to_string(i) + '\n';
+    file.write(detail::memory_buffer(entry));
+    entries.push_back(entry);
+  }
+
+  file.flush();
+
+  ASSERT_EQ(file_test_utils::file_exists(log_filename), true);
+  ASSERT_EQ(file_test_utils::compare_file_contents(log_filename, entries), true);
+  ASSERT_EQ(file.get_num_of_files(), 1);
+
+  return true;
+}
+
+static bool when_sink_is_destroyed_then_pending_data_is_written()
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+
+  std::vector<std::string> entries;
+  {
+    async_file_sink_subclass file(log_filename, 0, std::chrono::seconds(0));
+    for (unsigned i = 0; i != 10; ++i) {
+      std::string entry = "Test log entry - " + std::to_string(i) + '\n';
+      file.write(detail::memory_buffer(entry));
+      entries.push_back(entry);
+    }
+  }
+
+  ASSERT_EQ(file_test_utils::compare_file_contents(log_filename, entries), true);
+
+  return true;
+}
+
+static bool when_data_written_exceeds_size_threshold_then_new_file_is_created()
+{
+  std::string                          filename0 = file_utils::build_filename_with_index(log_filename, 0);
+  std::string                          filename1 = file_utils::build_filename_with_index(log_filename, 1);
+  file_test_utils::scoped_file_deleter deleter   = {filename0, filename1};
+
+  async_file_sink_subclass file(log_filename, 5000, std::chrono::seconds(0));
+
+  // Build a 1000 byte entry.
+  std::string entry(1000, 'a');
+
+  // Fill in the file with 5000 bytes, the threshold.
+  for (unsigned i = 0; i != 5; ++i) {
+    file.write(detail::memory_buffer(entry));
+  }
+  file.flush();
+
+  // Only one file should exist.
+  ASSERT_EQ(file.get_num_of_files(), 1);
+
+  // Trigger a file rotation.
+  file.write(detail::memory_buffer(entry));
+  file.flush();
+
+  // A second file should be created.
+  ASSERT_EQ(file.get_num_of_files(), 2);
+  ASSERT_EQ(file_test_utils::file_exists(filename1), true);
+
+  return true;
+}
+
+static bool when_rotation_period_expires_then_new_file_is_created()
+{
+  std::string                          filename0 = file_utils::build_filename_with_index(log_filename, 0);
+  std::string                          filename1 = file_utils::build_filename_with_index(log_filename, 1);
+  file_test_utils::scoped_file_deleter deleter   = {filename0, filename1};
+
+  async_file_sink_subclass file(log_filename, 0, std::chrono::seconds(1));
+
+  std::string entry = "Test log entry\n";
+  file.write(detail::memory_buffer(entry));
+  file.flush();
+  file.write(detail::memory_buffer(entry));
+  file.flush();
+
+  // The period did not expire yet.
+  ASSERT_EQ(file.get_num_of_files(), 1);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  file.write(detail::memory_buffer(entry));
+  file.flush();
+
+  ASSERT_EQ(file.get_num_of_files(), 2);
+  ASSERT_EQ(file_test_utils::compare_file_contents(filename0, {entry, entry}), true);
+  ASSERT_EQ(file_test_utils::compare_file_contents(filename1, {entry}), true);
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_data_is_written_to_file_then_contents_are_valid);
+  TEST_FUNCTION(when_sink_is_destroyed_then_pending_data_is_written);
+  TEST_FUNCTION(when_data_written_exceeds_size_threshold_then_new_file_is_created);
+  TEST_FUNCTION(when_rotation_period_expires_then_new_file_is_created);
+
+  return 0;
+}
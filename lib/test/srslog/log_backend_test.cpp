@@ -22,6 +22,7 @@
 #include "src/srslog/log_backend_impl.h"
 #include "test_dummies.h"
 #include "testing_helpers.h"
+#include <thread>
 
 using namespace srslog;
 
@@ -233,6 +234,50 @@ static bool when_empty_handler_is_used_then_backend_does_not_crash()
   return true;
 }
 
+static bool when_many_threads_push_entries_then_entries_of_each_thread_keep_order()
+{
+  test_dummies::sink_dummy s;
+
+  log_backend_impl backend;
+  backend.start();
+
+  const unsigned        nof_threads = 4;
+  const unsigned        nof_entries = 5000;
+  std::vector<unsigned> next_seq(nof_threads, 0);
+  bool                  in_order = true;
+
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t != nof_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (unsigned i = 0; i != nof_entries; ++i) {
+        auto entry        = build_log_entry(&s, nullptr);
+        entry.format_func = [&next_seq, &in_order, t, i](detail::log_entry_metadata&& metadata,
+                                                         fmt::memory_buffer&           buffer) {
+          // Runs in the backend thread.
+          in_order &= (next_seq[t]++ == i);
+        };
+        // Retry while the ring of this thread is full.
+        while (!backend.push(std::move(entry))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Stop the backend to ensure the entries have been processed.
+  backend.stop();
+
+  ASSERT_EQ(in_order, true);
+  for (unsigned t = 0; t != nof_threads; ++t) {
+    ASSERT_EQ(next_seq[t], nof_entries);
+  }
+
+  return true;
+}
+
 int main()
 {
   TEST_FUNCTION(when_backend_is_started_then_is_started_returns_true);
@@ -243,6 +288,7 @@ int main()
   TEST_FUNCTION(when_sink_write_fails_then_error_handler_is_invoked);
   TEST_FUNCTION(when_handler_is_set_after_start_then_handler_is_not_used);
   TEST_FUNCTION(when_empty_handler_is_used_then_backend_does_not_crash);
+  TEST_FUNCTION(when_many_threads_push_entries_then_entries_of_each_thread_keep_order);
 
   return 0;
 }
@@ -33,6 +33,8 @@ void  reserve_rnti_memblocks(size_t nof_blocks);
 void* allocate_rnti_dedicated_mem(uint16_t rnti, std::size_t size, std::size_t align);
 void  deallocate_rnti_dedicated_mem(uint16_t rnti, void* p);
 
+srsran::pool_metrics_t get_rnti_pool_metrics();
+
 template <typename T>
 using unique_rnti_ptr = srsran::unique_pool_ptr<T>;
 
@@ -84,6 +84,8 @@ struct log_args_t {
   int         all_hex_limit;
   int         file_max_size;
   std::string filename;
+  bool        file_async;
+  int         file_rotation_period;
 };
 
 struct gui_args_t {
@@ -92,9 +94,14 @@ struct gui_args_t {
 
 struct general_args_t {
   uint32_t    rrc_inactivity_timer;
+  uint32_t    nr_rrc_pack_workers;
   float       metrics_period_secs;
   bool        metrics_csv_enable;
   std::string metrics_csv_filename;
+  std::string metrics_udp_addr;
+  int         metrics_udp_port;
+  std::string metrics_http_addr;
+  int         metrics_http_port;
   bool        report_json_enable;
   std::string report_json_filename;
   bool        report_json_asn1_oct;
@@ -104,6 +111,10 @@ struct general_args_t {
   bool        tracing_enable;
   std::size_t tracing_buffcapacity;
   std::string tracing_filename;
+  bool        tti_trace_enable;
+  std::size_t tti_trace_records;
+  std::string tti_trace_filename;
+  uint32_t    pkt_trace_period;
   std::string eia_pref_list;
   std::string eea_pref_list;
   uint32_t    max_mac_dl_kos;
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        metrics_binary.h
+ * Description: Metrics class exporting the per-UE and per-cell counters as
+ *              binary UDP datagrams and through a Prometheus HTTP endpoint.
+ *****************************************************************************/
+
+#ifndef SRSENB_METRICS_BINARY_H
+#define SRSENB_METRICS_BINARY_H
+
+#include "srsran/common/network_utils.h"
+#include "srsran/interfaces/enb_metrics_interface.h"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace srsenb {
+
+/**
+ * Exports the MAC/PHY metrics of each period without text formatting on the metrics thread.
+ *
+ * Every period is sent to the UDP destination in one or more datagrams with the little-endian layout below, so that
+ * the decoding and formatting are done by the collector. Each datagram is self-contained:
+ *   header (32 bytes): u32 magic "SRSM", u16 version, u8 datagram index, u8 nof datagrams, u32 sequence number,
+ *                      u32 period in us, u64 UNIX time in us, u16 nof cells, u16 nof UEs, u32 reserved
+ *   cell (8 bytes):    u8 cc_idx, u8 reserved, u16 pci, u32 RACH count of the period
+ *   UE (64 bytes):     u16 rnti, u8 cc_idx, u8 reserved, u32 nof TTIs, u32 DL bits, u32 UL bits, u32 DL PDUs,
+ *                      u32 DL PDU errors, u32 UL PDUs, u32 UL PDU errors, u32 DL buffer bytes, u32 UL buffer bytes,
+ *                      f32 DL CQI, f32 DL RI, f32 DL MCS, f32 UL MCS, f32 UL SINR, f32 PHR
+ * The HTTP endpoint serves the counters accumulated since the UE was created in the Prometheus text format. The text
+ * is only generated when /metrics is scraped, in the HTTP thread.
+ */
+class metrics_binary : public srsran::metrics_listener<enb_metrics_t>
+{
+public:
+  constexpr static uint32_t magic          = 0x4d535253; // "SRSM"
+  constexpr static uint16_t version        = 1;
+  constexpr static uint32_t header_len     = 32;
+  constexpr static uint32_t cell_len       = 8;
+  constexpr static uint32_t ue_len         = 64;
+  constexpr static uint32_t max_datagram   = 1400;
+  constexpr static uint32_t max_nof_chunks = 255;
+
+  metrics_binary() = default;
+  ~metrics_binary();
+
+  /// Opens the UDP feed if udp_port is not 0 and the HTTP endpoint if http_port is not 0
+  bool init(const std::string& udp_addr, int udp_port, const std::string& http_addr, int http_port);
+
+  void set_metrics(const enb_metrics_t& m, const uint32_t period_usec) override;
+  void stop() override;
+
+  /// Serializes the metrics of one period into the datagrams sent to the UDP feed
+  static void serialize(const enb_metrics_t&               m,
+                        uint32_t                           period_usec,
+                        uint32_t                           seq,
+                        uint64_t                           timestamp_us,
+                        std::vector<std::vector<uint8_t>>& datagrams);
+
+  /// Returns the Prometheus text exposition of the accumulated counters
+  std::string format_prometheus();
+
+private:
+  struct ue_counters_t {
+    uint32_t pci       = 0;
+    uint64_t nof_tti   = 0;
+    uint64_t dl_bits   = 0;
+    uint64_t ul_bits   = 0;
+    uint64_t dl_pdus   = 0;
+    uint64_t dl_errors = 0;
+    uint64_t ul_pdus   = 0;
+    uint64_t ul_errors = 0;
+    uint32_t dl_buffer = 0;
+    uint32_t ul_buffer = 0;
+    float    dl_cqi    = 0;
+    float    dl_mcs    = 0;
+    float    ul_mcs    = 0;
+    float    ul_snr    = 0;
+    float    phr       = 0;
+  };
+
+  void accumulate(const enb_metrics_t& m);
+  void run_http();
+  void serve_http(int fd);
+
+  srsran::unique_socket             udp_sock;
+  srsran::unique_socket             http_sock;
+  std::thread                       http_thread;
+  std::atomic<bool>                 running{false};
+  uint32_t                          seq = 0;
+  std::vector<std::vector<uint8_t>> datagrams;
+  std::mutex                        counters_mutex;
+  std::map<uint16_t, ue_counters_t> ue_counters;
+  std::map<uint32_t, uint64_t>      cell_rach;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_METRICS_BINARY_H
@@ -22,10 +22,15 @@
 #ifndef SRSENB_CC_WORKER_H
 #define SRSENB_CC_WORKER_H
 
+#include <chrono>
 #include <string.h>
 
 #include "../phy_common.h"
+#include "srsenb/hdr/common/common_enb.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <condition_variable>
 
 #define LOG_EXECTIME
 
@@ -61,22 +66,55 @@ public:
                stack_interface_phy_lte::ul_sched_t& ul_grants,
                srsran_mbsfn_cfg_t*                  mbsfn_cfg);
 
+  /* The DL subframe in two steps: the PDCCH DL grants and PDSCH/PMCH, which only depend on the DL scheduling, and the
+   * PDCCH UL grants and PHICH followed by the signal generation. The base signals can be put in advance, before the
+   * scheduling is known, with work_dl_base() */
+  void work_dl_base(const srsran_dl_sf_cfg_t& dl_sf_cfg);
+  void work_dl_data(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
+                    stack_interface_phy_lte::dl_sched_t& dl_grants,
+                    srsran_mbsfn_cfg_t*                  mbsfn_cfg);
+  void work_dl_ctrl(stack_interface_phy_lte::ul_sched_t& ul_grants);
+
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
 
 private:
   constexpr static float PUSCH_RL_SNR_DB_TH = 1.0f;
   constexpr static float PUCCH_RL_CORR_TH   = 0.15f;
+  // Minimum number of turbo decoder half-iterations when the UL processing is running late
+  constexpr static uint32_t PUSCH_MIN_TURBO_ITS = 2;
 
   int  encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srsran_mbsfn_cfg_t* mbsfn_cfg);
-  bool decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                         srsran_ul_cfg_t&                           ul_cfg,
-                         srsran_pusch_res_t&                        pusch_res);
+
+  // PUSCH configuration and decoding result of a grant, kept until the MAC has been notified
+  struct pusch_slot_t {
+    stack_interface_phy_lte::ul_sched_grant_t* ul_grant     = nullptr;
+    srsran_ul_cfg_t                            ul_cfg       = {};
+    srsran_pusch_res_t                         pusch_res    = {};
+    srsran_chest_ul_res_t                      chest_res    = {};
+    bool                                       uci_required = false;
+    bool                                       decoded      = false;
+  };
+
+  bool prepare_pusch(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, pusch_slot_t& slot);
+  bool run_pusch(srsran_enb_ul_t& q, pusch_slot_t& slot);
+  void run_pusch_slots(srsran_enb_ul_t& q, uint32_t nof_slots);
+  void report_pusch(pusch_slot_t& slot);
+  void demodulate_ul();
   void decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch);
+  void decode_pusch_parallel(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch);
+  void gen_signal_ports(uint32_t thread_idx);
+  void gen_signal();
+  cf_t* get_buffer_sc16(cf_t* buffer);
   int  encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks);
   int  encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_grants);
   int  decode_pucch();
+  void decode_srs();
+  bool is_known_rnti(uint16_t rnti) const;
+
+  // Dense UE index, the slot of the RNTI in ue_db
+  static uint32_t ue_idx(uint16_t rnti) { return rnti % SRSENB_MAX_UES; }
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -90,10 +128,39 @@ private:
   srsran_enb_dl_t enb_dl = {};
   srsran_enb_ul_t enb_ul = {};
 
-  srsran_dl_sf_cfg_t dl_sf = {};
-  srsran_ul_sf_cfg_t ul_sf = {};
-
-  srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
+  srsran_dl_sf_cfg_t dl_sf          = {};
+  srsran_ul_sf_cfg_t ul_sf          = {};
+  bool               dl_base_ready  = false; ///< The base signals of dl_sf are in the grid, only the CFI is missing
+  bool               ul_fft_pending = false; ///< The UL subframe is not demodulated until a channel needs it
+
+  // Start time of the UL processing of the current subframe
+  std::chrono::steady_clock::time_point ul_start = {};
+
+  srsran_softbuffer_tx_t temp_mbsfn_softbuffer  = {};
+  bool                   mbsfn_softbuffer_ready = false; ///< Allocated on the first MBSFN subframe
+
+  // SRS of all the UEs that sound in the subframe, measured in a single pass
+  srsran_chest_ul_srs_batch_t             srs_batch = {};
+  std::vector<srsran_refsignal_srs_cfg_t> srs_cfgs;
+  std::vector<srsran_chest_ul_srs_meas_t> srs_meas;
+  std::vector<uint16_t>                   srs_rntis;
+
+  // Parallel PUSCH decoding. Each helper thread decodes whole grants with its own estimator and decoder, reading the
+  // resource grid demodulated by enb_ul. The MAC is notified afterwards, in grant order.
+  std::vector<srsran_enb_ul_t>              pusch_decoders;
+  std::unique_ptr<srsran::task_thread_pool> pusch_pool;
+  std::vector<pusch_slot_t>                 pusch_slots;
+  std::atomic<uint32_t>                     pusch_next_slot = {0};
+  uint32_t                                  pusch_pending   = 0;
+  std::mutex                                pusch_mutex;
+  std::condition_variable                   pusch_cvar;
+
+  // Parallel DL signal generation. The port p IFFT and CFR run in the thread p % (tx_helpers + 1), where 0 is this one
+  std::unique_ptr<srsran::task_thread_pool> tx_pool;
+  uint32_t                                  tx_helpers = 0;
+  uint32_t                                  tx_pending = 0;
+  std::mutex                                tx_mutex;
+  std::condition_variable                   tx_cvar;
 
   // Class to store user information
   class ue
@@ -104,8 +171,6 @@ private:
       // Do nothing
     }
 
-    srsran_phich_grant_t phich_grant = {};
-
     void     metrics_read(phy_metrics_t* metrics);
     void     metrics_dl(uint32_t mcs);
     void     metrics_ul(uint32_t mcs, float rssi, float sinr, float turbo_iters);
@@ -120,9 +185,19 @@ private:
   // Component carrier index
   uint32_t cc_idx = 0;
 
-  // Each worker keeps a local copy of the user database. Uses more memory but more efficient to manage concurrency
-  std::map<uint16_t, ue*> ue_db;
-  std::mutex              mutex;
+  /* Each worker keeps a local copy of the user database. Uses more memory but more efficient to manage concurrency. It
+   * holds the C-RNTIs and the M-RNTI, which the MAC allocates in different slots of its own rnti_map_t, so the slot is
+   * a dense UE index. The SI, P and RA-RNTIs carry no state and are not stored */
+  rnti_map_t<ue> ue_db;
+  std::mutex     mutex;
+
+  // PHICH resource of the last PUSCH of each UE, indexed by ue_idx()
+  std::array<srsran_phich_grant_t, SRSENB_MAX_UES> phich_grants = {};
+
+  // Control channels of the TTI, gathered to be encoded in a single batch
+  std::array<srsran_phich_grant_t, stack_interface_phy_lte::MAX_GRANTS> phich_batch_grants = {};
+  std::array<uint8_t, stack_interface_phy_lte::MAX_GRANTS>              phich_batch_acks   = {};
+  std::array<srsran_dci_msg_t, stack_interface_phy_lte::MAX_GRANTS>     pdcch_batch_msgs   = {};
 };
 
 } // namespace lte
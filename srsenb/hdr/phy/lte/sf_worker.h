@@ -22,6 +22,7 @@
 #ifndef SRSENB_PHCH_WORKER_H
 #define SRSENB_PHCH_WORKER_H
 
+#include <condition_variable>
 #include <mutex>
 #include <string.h>
 
@@ -60,6 +61,30 @@ public:
 
 private:
   void work_imp() final;
+  void work_dl_data(const srsran_dl_sf_cfg_t&                 dl_sf,
+                    stack_interface_phy_lte::dl_sched_list_t& dl_grants,
+                    srsran_mbsfn_cfg_t*                       mbsfn_cfg);
+  void start_dl_data(const srsran_dl_sf_cfg_t&                 dl_sf,
+                     stack_interface_phy_lte::dl_sched_list_t& dl_grants,
+                     srsran_mbsfn_cfg_t*                       mbsfn_cfg);
+  void wait_dl_data();
+  bool split_carriers() const;
+  /// Runs f(cc) for every carrier, as sub-tasks that the idle PHY workers can take when the carriers are split
+  template <typename F>
+  void for_each_carrier(F&& f)
+  {
+    srsran::thread_pool::task_group group;
+    for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+      if (split_carriers()) {
+        push_task(group, [&f, cc]() { f(cc); });
+      } else {
+        f(cc);
+      }
+    }
+    wait_tasks(group);
+  }
+  /// Copies the subframe buffers of all the ports of a carrier to the IQ capture
+  void capture_iq(srsran::iq_tap::direction_t dir, uint32_t tti, uint32_t cc, srsran::span<const uint16_t> rntis);
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -71,8 +96,13 @@ private:
   uint32_t                                       tti_rx = 0, tti_tx_dl = 0, tti_tx_ul = 0;
   std::vector<std::unique_ptr<cc_worker> >       cc_workers;
   srsran::phy_common_interface::worker_context_t context = {};
+  phy_common::tti_timing_t                       timing  = {};
 
-  srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
+  // Helper thread encoding the PDSCH of the TX TTI while the MAC schedules the UL
+  std::unique_ptr<srsran::task_thread_pool> dl_pool;
+  bool                                      dl_pending = false;
+  std::mutex                                dl_mutex;
+  std::condition_variable                   dl_cvar;
 };
 
 } // namespace lte
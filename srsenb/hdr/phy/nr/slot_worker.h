@@ -23,6 +23,7 @@
 #define SRSENB_NR_SLOT_WORKER_H
 
 #include "srsran/common/thread_pool.h"
+#include <condition_variable>
 #include "srsran/interfaces/gnb_interfaces.h"
 #include "srsran/interfaces/phy_common_interface.h"
 #include "srsran/srslog/srslog.h"
@@ -66,6 +67,8 @@ public:
     uint32_t                    rf_port          = 0;
     srsran_subcarrier_spacing_t scs              = srsran_subcarrier_spacing_15kHz;
     uint32_t                    pusch_max_its    = 10;
+    uint32_t                    pusch_cb_workers = 0;
+    bool                        dl_early_symbols = false;
     float                       pusch_min_snr_dB = -10.0f;
     double                      srate_hz         = 0.0;
   };
@@ -106,6 +109,21 @@ private:
    */
   bool work_dl();
 
+  /**
+   * @brief Puts the PDSCH and NZP-CSI-RS of the DL slot in the resource grid
+   * @return True if no error occurs, false otherwise
+   */
+  bool work_dl_data(const stack_interface_phy_nr::dl_sched_t& dl_sched);
+
+  /**
+   * @brief Counts the symbols at the start of the slot that no PDSCH or NZP-CSI-RS is mapped onto. They only carry
+   * PDCCH, so they can be modulated before the PDSCH is encoded
+   */
+  uint32_t get_nof_early_symbols(const stack_interface_phy_nr::dl_sched_t& dl_sched) const;
+
+  void start_early_symbols(uint32_t nof_symbols);
+  void wait_early_symbols();
+
   srsran::phy_common_interface& common;
   stack_interface_phy_nr&       stack;
   srslog::basic_logger&         logger;
@@ -123,6 +141,12 @@ private:
   std::vector<cf_t*>                             tx_buffer; ///< Baseband transmit buffers
   std::vector<cf_t*>                             rx_buffer; ///< Baseband receive buffers
   std::mutex mutex; ///< Protect concurrent access from workers (and main process that inits the class)
+
+  // Helper thread modulating the early symbols of the DL slot while the PDSCH is encoded
+  std::unique_ptr<srsran::task_thread_pool> dl_pool;
+  bool                                      dl_pending = false;
+  std::mutex                                dl_mutex;
+  std::condition_variable                   dl_cvar;
 };
 
 } // namespace nr
@@ -106,6 +106,8 @@ public:
     uint32_t               nof_prach_workers = 0;
     uint32_t               prio              = 52;
     uint32_t               pusch_max_its     = 10;
+    uint32_t               pusch_cb_workers  = 0;
+    bool                   dl_early_symbols  = false;
     float                  pusch_min_snr_dB  = -10;
     srsran::phy_log_args_t log               = {};
   };
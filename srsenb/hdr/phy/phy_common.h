@@ -26,6 +26,7 @@
 #include "srsenb/hdr/phy/phy_ue_db.h"
 #include "srsran/common/gen_mch_tables.h"
 #include "srsran/common/interfaces_common.h"
+#include "srsran/common/iq_tap.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
@@ -35,6 +36,7 @@
 #include "srsran/phy/channel/channel.h"
 #include "srsran/radio/radio.h"
 
+#include <chrono>
 #include <map>
 #include <srsran/common/tti_sempahore.h>
 #include <string.h>
@@ -68,9 +70,33 @@ public:
    */
   void worker_end(const worker_context_t& w_ctx, const bool& tx_enable, srsran::rf_buffer_t& buffer) override;
 
+  /// Time at which each processing stage of a subframe finished, and the time the subframe must be sent to the radio
+  struct tti_timing_t {
+    using time_point = std::chrono::steady_clock::time_point;
+    time_point                                  deadline;
+    time_point                                  rx;
+    std::array<time_point, SRSRAN_MAX_CARRIERS> ul_decode;
+    uint32_t                                    nof_carriers = 0;
+    time_point                                  mac_sched;
+    time_point                                  dl_encode;
+    time_point                                  tx_submit;
+  };
+
+  /**
+   * Accumulates the slack to the deadline of every processing stage of a subframe, it is called by the workers once
+   * worker_end() has handed the subframe to the radio
+   */
+  void add_tti_timing(const tti_timing_t& timing);
+
+  /// Returns the timing histograms accumulated since the last call and resets them
+  void get_timing_metrics(phy_timing_metrics_t& m);
+
   // Common objects
   phy_args_t params = {};
 
+  /// Capture of the RX and TX subframes of the LTE carriers, running when enabled in the arguments
+  srsran::iq_tap iq_capture;
+
   uint32_t get_nof_carriers_lte() { return static_cast<uint32_t>(cell_list_lte.size()); }
   uint32_t get_nof_carriers_nr() { return static_cast<uint32_t>(cell_list_nr.size()); }
   uint32_t get_nof_carriers() { return static_cast<uint32_t>(cell_list_lte.size() + cell_list_nr.size()); }
@@ -276,6 +302,9 @@ public:
   void             set_cfr_config(srsran_cfr_cfg_t cfr_cfg) { cfr_config = cfr_cfg; }
   srsran_cfr_cfg_t get_cfr_config() { return cfr_config; }
 
+  /// Returns true if the LTE samples are exchanged with the radio as 16 bit IQ samples, see srsran_rf_info_t
+  bool is_sc16() const { return sc16; }
+
   // Common Physical Uplink DMRS configuration
   srsran_refsignal_dmrs_pusch_cfg_t dmrs_pusch_cfg = {};
 
@@ -308,6 +337,9 @@ private:
   phy_cell_cfg_list_nr_t cell_list_nr;
   std::mutex             cell_gain_mutex;
 
+  std::mutex           timing_mutex;
+  phy_timing_metrics_t timing_metrics = {};
+
   bool                    have_mtch_stop   = false;
   std::mutex              mtch_mutex;
   std::condition_variable mtch_cvar;
@@ -318,6 +350,7 @@ private:
   uint8_t                 mcch_table[10]   = {};
   uint32_t                mch_period_stop  = 0;
   srsran::rf_buffer_t     tx_buffer        = {};
+  bool                    sc16             = false;
   bool                    is_mch_subframe(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti);
   bool                    is_mcch_subframe(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti);
 };
@@ -49,6 +49,9 @@ typedef std::vector<phy_cell_cfg_t> phy_cell_cfg_list_t;
 struct cfr_args_t {
   bool              enable           = false;
   srsran_cfr_mode_t mode             = SRSRAN_CFR_THR_MANUAL;
+  srsran_cfr_algo_t algo             = SRSRAN_CFR_ALGO_CLIP_FILTER;
+  uint32_t          pulse_len        = 0;
+  uint32_t          nof_threads      = 0;
   float             manual_thres     = 0.5f;
   float             strength         = 1.0f;
   float             auto_target_papr = 8.0f;
@@ -63,7 +66,22 @@ struct phy_args_t {
   float                   max_prach_offset_us = 10;
   uint32_t                pusch_max_its       = 10;
   uint32_t                nr_pusch_max_its    = 10;
+  uint32_t                nr_pusch_cb_workers = 0;
+  bool                    nr_dl_early_symbols = false;
   bool                    pusch_8bit_decoder  = false;
+  uint32_t                pusch_cb_workers    = 0;
+  uint32_t                pusch_ue_workers    = 0;
+  bool                    pusch_early_stop    = false;
+  uint32_t                pusch_deadline_us   = 0;
+  bool                    pusch_wiener        = false;
+  bool                    dl_pipeline         = false;
+  bool                    dl_sparse_tx        = false;
+  bool                    phy_task_stealing   = false;
+  uint32_t                rf_rx_ring_sz       = 0;
+  bool                    iq_tap_enable       = false;
+  std::string             iq_tap_filename;
+  uint32_t                iq_tap_ring_sz      = 256;
+  bool                    use_hugepages       = false;
   float                   tx_amplitude        = 1.0f;
   uint32_t                nof_phy_threads     = 1;
   std::string             equalizer_mode      = "mmse";
@@ -22,7 +22,11 @@
 #ifndef SRSENB_PHY_METRICS_H
 #define SRSENB_PHY_METRICS_H
 
+#include <array>
+#include <algorithm>
 #include <limits>
+#include <stdint.h>
+#include <vector>
 
 namespace srsenb {
 
@@ -53,6 +57,37 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// PHY subframe timing, common to all users
+
+/// Histogram of the time left to the TX deadline of the subframe when a processing stage finishes. Negative slacks
+/// are stages that finished after the deadline.
+struct phy_timing_hist_t {
+  constexpr static uint32_t nof_bins     = 16;
+  constexpr static int32_t  bin_us       = 250;
+  constexpr static int32_t  min_slack_us = -1000; ///< Lower edge of the first bin, smaller slacks count in it too
+
+  std::array<uint32_t, nof_bins> bins     = {};
+  uint32_t                       nof_tti  = 0;
+  uint32_t                       nof_late = 0;
+
+  void add(int64_t slack_us)
+  {
+    int64_t bin = (slack_us - min_slack_us) / bin_us;
+    bins[std::min(std::max(bin, (int64_t)0), (int64_t)nof_bins - 1)]++;
+    nof_late += (slack_us < 0) ? 1 : 0;
+    nof_tti++;
+  }
+  static int32_t bin_lower_us(uint32_t bin) { return min_slack_us + (int32_t)bin * bin_us; }
+};
+
+struct phy_timing_metrics_t {
+  phy_timing_hist_t              rx;        ///< The worker starts processing the received subframe
+  std::vector<phy_timing_hist_t> ul_decode; ///< UL decoding of each carrier
+  phy_timing_hist_t              mac_sched; ///< DL and UL scheduling returned by the MAC
+  phy_timing_hist_t              dl_encode; ///< DL subframe generated for all carriers
+  phy_timing_hist_t              tx_submit; ///< Subframe handed to the radio
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
@@ -25,7 +25,9 @@
 #include "phy_interfaces.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <srsran/adt/circular_array.h>
 
@@ -81,37 +83,92 @@ private:
   } cell_state_t;
 
   /**
-   * Cell information for the UE database
+   * Cell configuration for the UE database, it is immutable once it is published
    */
   struct cell_info_t {
-    cell_state_t state      = cell_state_none; ///< Configuration state
-    uint32_t     enb_cc_idx = 0;               ///< Corresponding eNb cell/carrier index
-    uint8_t      last_ri    = 0;               ///< Last reported rank indicator
-    srsran::circular_array<srsran_ra_tb_t, SRSRAN_MAX_HARQ_PROC> last_tb =
-        {}; ///< Stores last PUSCH Resource allocation
-    bool                                    stash_use_tbs_index_alt = false;
-    srsran::phy_cfg_t                       phy_cfg;            ///< Configuration, it has a default constructor
-    srsran::circular_array<bool, TTIMOD_SZ> is_grant_available; ///< Indicates whether there is an available grant
+    cell_state_t      state                   = cell_state_none; ///< Configuration state
+    uint32_t          enb_cc_idx              = 0;               ///< Corresponding eNb cell/carrier index
+    bool              stash_use_tbs_index_alt = false;
+    srsran::phy_cfg_t phy_cfg; ///< Configuration, it has a default constructor
   };
 
   /**
-   * UE object stored in the PHY common database
+   * UE state written by the PHY workers, it is shared by all the configuration snapshots of the UE
+   */
+  struct ue_state_t {
+    std::array<std::atomic<uint8_t>, SRSRAN_MAX_CARRIERS> last_ri = {}; ///< Last reported rank indicator per cell
+    /// Last PUSCH resource allocation per cell, a HARQ process is only accessed by the workers processing its TTIs
+    std::array<srsran::circular_array<srsran_ra_tb_t, SRSRAN_MAX_HARQ_PROC>, SRSRAN_MAX_CARRIERS> last_tb = {};
+  };
+
+  /**
+   * UE configuration snapshot stored in the PHY common database, it is immutable once it is published
    */
   struct common_ue {
-    bool                                                  stashed_multiple_csi_request_enabled = false;
-    srsran::circular_array<srsran_pdsch_ack_t, TTIMOD_SZ> pdsch_ack = {}; ///< Pending acknowledgements for this Cell
-    std::array<cell_info_t, SRSRAN_MAX_CARRIERS>          cell_info = {}; ///< Cell information, indexed by ue_cell_idx
+    bool                                         stashed_multiple_csi_request_enabled = false;
+    std::array<cell_info_t, SRSRAN_MAX_CARRIERS> cell_info = {}; ///< Cell information, indexed by ue_cell_idx
+    std::shared_ptr<ue_state_t>                  state;
+  };
+
+  typedef std::map<uint16_t, std::shared_ptr<const common_ue> > ue_map_t;
+
+  /**
+   * UE database indexed by RNTI. The PHY workers read it without locking. The stack modifies a copy and publishes it
+   * with an atomic pointer swap, then frees the previous copy after every reader that could be using it has left.
+   * Readers register in one of two counters, selected by the parity of the reader epoch. A writer flips the epoch and
+   * waits for the previous counter to drain, twice, so every reader that started before the swap has finished.
+   */
+  std::atomic<const ue_map_t*>                 ue_db;
+  mutable std::array<std::atomic<uint32_t>, 2> nof_readers  = {};
+  std::atomic<uint32_t>                        reader_epoch = {0};
+
+  /**
+   * Serialises the database writers, the readers never take it
+   */
+  std::mutex write_mutex;
+
+  /**
+   * Pins the database snapshot that is current on construction until destruction
+   */
+  class ue_db_reader
+  {
+  public:
+    explicit ue_db_reader(const phy_ue_db& db_) : db(db_), epoch(db_.reader_epoch.load() % 2)
+    {
+      db.nof_readers[epoch]++;
+      map = db.ue_db.load();
+    }
+    ~ue_db_reader() { db.nof_readers[epoch]--; }
+    ue_db_reader(const ue_db_reader&) = delete;
+    ue_db_reader& operator=(const ue_db_reader&) = delete;
+
+    const ue_map_t& operator*() const { return *map; }
+    const ue_map_t* operator->() const { return map; }
+
+  private:
+    const phy_ue_db& db;
+    uint32_t         epoch;
+    const ue_map_t*  map = nullptr;
   };
 
   /**
-   * UE database indexed by RNTI
+   * Per-TTI pending acknowledgements, indexed by RNTI. The worker that schedules the PDSCH in a TTI rebuilds the slot
+   * from the current database and fills it, the worker that receives the UCI of the TTI reads and updates it. The
+   * worker TX semaphore chain orders both, and the slot entries are neither added nor removed in between.
+   */
+  srsran::circular_array<std::map<uint16_t, srsran_pdsch_ack_t>, TTIMOD_SZ> pdsch_ack;
+
+  /**
+   * Per-TTI persistent PUCCH resource of the pending ACKs of the DL SPS occasions, indexed by RNTI. It follows the
+   * access pattern of pdsch_ack
    */
-  std::map<uint16_t, common_ue> ue_db;
+  srsran::circular_array<std::map<uint16_t, uint32_t>, TTIMOD_SZ> sps_n1_pucch;
 
   /**
-   * Concurrency protection mutex, allowed modifications from const methods.
+   * Per-TTI PUSCH grant availability, indexed by RNTI, as a mask of UE cell/carrier indexes. It is only accessed by
+   * the worker that processes the UL of the TTI
    */
-  mutable std::mutex mutex;
+  srsran::circular_array<std::map<uint16_t, uint32_t>, TTIMOD_SZ> ul_grant_mask;
 
   /**
    * Stack interface
@@ -129,20 +186,27 @@ private:
   const phy_cell_cfg_list_t* cell_cfg_list = nullptr;
 
   /**
-   * Internal RNTI addition, it is not thread safe protected
+   * Publishes a new database and frees the previous one once no reader uses it, it requires the write mutex
+   *
+   * @param db new UE database
+   */
+  void _publish(ue_map_t* db);
+
+  /**
+   * Creates the configuration of a new RNTI
    *
    * @param rnti identifier of the UE
-   * @return SRSRAN_SUCCESS if the RNTI is not duplicated and is added successfully, SRSRAN_ERROR code if it exists
+   * @return the default UE configuration
    */
-  inline int _add_rnti(uint16_t rnti);
+  std::shared_ptr<common_ue> _new_rnti(uint16_t rnti) const;
 
   /**
-   * Internal pending ACK clear for a given RNTI and TTI, it is not thread safe protected
+   * Resets the pending ACK of a UE, keeping the essentials of its configuration
    *
-   * @param tti is the given TTI (requires assertion prior to call)
-   * @param rnti identifier of the UE (requires assertion prior to call)
+   * @param ue UE configuration
+   * @param pdsch_ack pending ACK to reset
    */
-  inline void _clear_tti_pending_rnti(uint32_t tti, uint16_t rnti);
+  static void _reset_pdsch_ack(const common_ue& ue, srsran_pdsch_ack_t& pdsch_ack);
 
   /**
    * Helper method to set the constant attributes of a given RNTI after the configuration is set, it does not modify
@@ -154,14 +218,14 @@ private:
   inline void _set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t& phy_cfg) const;
 
   /**
-   * Gets the SCell index for a given RNTI and a eNb cell/carrier. It returns the SCell index (0 if PCell) if the cc_idx
+   * Gets the SCell index for a given UE and a eNb cell/carrier. It returns the SCell index (0 if PCell) if the cc_idx
    * is found among the configured cells/carriers. Otherwise, it returns SRSRAN_MAX_CARRIERS.
    *
-   * @param rnti identifier of the UE (requires assertion prior to call)
+   * @param ue UE configuration
    * @param enb_cc_idx the eNb cell/carrier index to look for in the RNTI.
    * @return the SCell index as described above.
    */
-  inline uint32_t _get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline uint32_t _get_ue_cc_idx(const common_ue& ue, uint32_t enb_cc_idx);
 
   /**
    * Gets the eNb Cell/Carrier index in which the UCI shall be carried. This corresponds to the serving cell with lowest
@@ -171,48 +235,50 @@ private:
    *
    * @param tti The UL processing TTI
    * @param rnti Temporal UE ID
+   * @param ue UE configuration
    * @return the eNb Cell/Carrier with lowest serving cell index that has an UL grant
    */
-  uint32_t _get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const;
+  uint32_t _get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti, const common_ue& ue) const;
 
   /**
-   * Checks if a given RNTI exists in the database
+   * Finds a given RNTI in a database
+   * @param db UE database
    * @param rnti provides UE identifier
-   * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
+   * @return the UE configuration if the indicated RNTI exists, otherwise it returns nullptr
    */
-  inline int _assert_rnti(uint16_t rnti) const;
+  static inline const common_ue* _find_rnti(const ue_map_t& db, uint16_t rnti);
 
   /**
    * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell
-   * @param rnti provides UE identifier
+   * @param ue UE configuration, it can be nullptr
    * @param enb_cc_idx provides eNb cell/carrier
    * @return SRSRAN_SUCCESS if the indicated RNTI exists, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_enb_cc(const common_ue* ue, uint32_t enb_cc_idx);
 
   /**
    * Checks if an RNTI uses a given eNb cell/carrier as PCell
-   * @param rnti provides UE identifier
+   * @param ue UE configuration, it can be nullptr
    * @param enb_cc_idx provides eNb cell/carrier index
    * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier of the RNTI is a PCell, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_enb_pcell(const common_ue* ue, uint32_t enb_cc_idx);
 
   /**
    * Checks if an RNTI is configured to use an specified UE cell/carrier as PCell or SCell
-   * @param rnti provides UE identifier
+   * @param ue UE configuration, it can be nullptr
    * @param ue_cc_idx UE cell/carrier index that is asserted
    * @return SRSRAN_SUCCESS if the indicated cell/carrier index is valid, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const;
+  static inline int _assert_ue_cc(const common_ue* ue, uint32_t ue_cc_idx);
 
   /**
    * Checks if an RNTI is configured to use an specified eNb cell/carrier as PCell or SCell and it is active
-   * @param rnti provides UE identifier
+   * @param ue UE configuration, it can be nullptr
    * @param enb_cc_idx UE cell/carrier index that is asserted
    * @return SRSRAN_SUCCESS if the indicated eNb cell/carrier is active, otherwise it returns SRSRAN_ERROR
    */
-  inline int _assert_active_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const;
+  static inline int _assert_active_enb_cc(const common_ue* ue, uint32_t enb_cc_idx);
 
   /**
    * Internal eNb stack assertion
@@ -229,22 +295,27 @@ private:
   /**
    * Internal eNb general configuration getter, returns default configuration if the UE does not exist in the given cell
    *
+   * @param db UE database
    * @param rnti provides UE identifier
    * @param enb_cc_idx eNb cell index
    * @param[out] phy_cfg The PHY configuration of the indicated UE for the indicated eNb carrier/call index.
    * @return SRSRAN_SUCCESS if provided context is correct, SRSRAN_ERROR code otherwise
    */
-  inline int _get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const;
+  static inline int
+  _get_rnti_config(const ue_map_t& db, uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg);
 
   /**
    * Count number of configured secondary serving cells
    *
-   * @param rnti provides UE identifier
+   * @param ue UE configuration
    * @return The number of configured secondary cells
    */
-  inline uint32_t _count_nof_configured_scell(uint16_t rnti);
+  static inline uint32_t _count_nof_configured_scell(const common_ue& ue);
 
 public:
+  phy_ue_db();
+  ~phy_ue_db();
+
   /**
    * Initialises the UE database with the stack and cell list
    * @param stack_ptr points to the stack (read/write)
@@ -358,9 +429,20 @@ public:
    * @param tti is the given TTI to fill
    * @param cc_idx the carrier where the DCI is scheduled
    * @param dci carries the Transport Block and required scheduling information
+   * @param n1_pucch_an persistent PUCCH resource of the ACK of a DL SPS occasion, -1 if the DCI was in the PDCCH
    *
    */
-  bool set_ack_pending(uint32_t tti, uint32_t enb_cc_idx, const srsran_dci_dl_t& dci);
+  bool set_ack_pending(uint32_t tti, uint32_t enb_cc_idx, const srsran_dci_dl_t& dci, int n1_pucch_an = -1);
+
+  /**
+   * Selects the persistent PUCCH resource in the PUCCH configuration if the pending ACK of the TTI belongs to a DL SPS
+   * occasion, which has no PDCCH to derive the resource from
+   *
+   * @param tti the current UL reception TTI
+   * @param rnti is the UE identifier
+   * @param pucch_cfg is the PUCCH configuration of the UE
+   */
+  void fill_sps_pucch_cfg(uint32_t tti, uint16_t rnti, srsran_pucch_cfg_t& pucch_cfg) const;
 
   /**
    * Fills the Uplink Control Information (UCI) configuration and returns true/false idicating if UCI bits are required.
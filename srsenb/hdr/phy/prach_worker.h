@@ -28,6 +28,8 @@
 #include "srsran/interfaces/enb_phy_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <atomic>
+#include <memory>
+#include <vector>
 
 // Setting ENABLE_PRACH_GUI to non zero enables a GUI showing signal received in the PRACH window.
 #define ENABLE_PRACH_GUI 0
@@ -40,11 +42,10 @@ namespace srsenb {
 
 class stack_interface_phy_lte;
 
-class prach_worker : srsran::thread
+class prach_worker
 {
 public:
-  prach_worker(uint32_t cc_idx_, srslog::basic_logger& logger) :
-    buffer_pool(8), thread("PRACH_WORKER"), logger(logger), running(false)
+  prach_worker(uint32_t cc_idx_, srslog::basic_logger& logger) : buffer_pool(8), logger(logger), running(false)
   {
     cc_idx = cc_idx_;
   }
@@ -54,20 +55,15 @@ public:
             stack_interface_phy_lte*  mac,
             int                       priority,
             uint32_t                  nof_workers);
-  int  new_tti(uint32_t tti, cf_t* buffer);
+  int  new_tti(uint32_t tti, cf_t* buffer, bool sc16 = false);
   void set_max_prach_offset_us(float delay_us);
   void stop();
 
 private:
   uint32_t cc_idx = 0;
 
-  uint32_t prach_indices[165] = {};
-  float    prach_offsets[165] = {};
-  float    prach_p2avg[165]   = {};
-
   srsran_cell_t      cell      = {};
   srsran_prach_cfg_t prach_cfg = {};
-  srsran_prach_t     prach     = {};
 
 #if defined(ENABLE_GUI) and ENABLE_PRACH_GUI
   plot_real_t                              plot_real;
@@ -91,8 +87,33 @@ private:
     char debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN];
 #endif /* SRSRAN_BUFFER_POOL_LOG_ENABLED */
   };
-  srsran::buffer_pool<sf_buffer>  buffer_pool;
-  srsran::block_queue<sf_buffer*> pending_buffers;
+
+  // Each detector has its own PRACH object, so that the detectors of a carrier process consecutive occasions in
+  // parallel. Occasions are handed to whichever detector is idle first.
+  class detector : public srsran::thread
+  {
+  public:
+    detector(prach_worker& parent_, uint32_t id) : thread("PRACH_WORKER" + std::to_string(id)), parent(parent_) {}
+
+    int  init();
+    void free();
+    int  run_tti(sf_buffer* b);
+
+    srsran_prach_t prach = {};
+
+  private:
+    prach_worker& parent;
+
+    uint32_t prach_indices[165] = {};
+    float    prach_offsets[165] = {};
+    float    prach_p2avg[165]   = {};
+
+    void run_thread() final;
+  };
+
+  srsran::buffer_pool<sf_buffer>          buffer_pool;
+  srsran::block_queue<sf_buffer*>         pending_buffers;
+  std::vector<std::unique_ptr<detector> > detectors;
 
   srslog::basic_logger&    logger;
   sf_buffer*               current_buffer      = nullptr;
@@ -103,9 +124,6 @@ private:
   uint32_t                 nof_sf      = 0;
   uint32_t                 sf_cnt      = 0;
   uint32_t                 nof_workers = 0;
-
-  void run_thread() final;
-  int  run_tti(sf_buffer* b);
 };
 
 class prach_worker_pool
@@ -147,11 +165,11 @@ public:
     }
   }
 
-  int new_tti(uint32_t cc_idx, uint32_t tti, cf_t* buffer)
+  int new_tti(uint32_t cc_idx, uint32_t tti, cf_t* buffer, bool sc16 = false)
   {
     int ret = SRSRAN_ERROR;
     if (cc_idx < prach_vec.size()) {
-      ret = prach_vec[cc_idx]->new_tti(tti, buffer);
+      ret = prach_vec[cc_idx]->new_tti(tti, buffer, sc16);
     }
     return ret;
   }
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_RF_RX_THREAD_H
+#define SRSENB_RF_RX_THREAD_H
+
+#include "srsran/common/threads.h"
+#include "srsran/interfaces/radio_interfaces.h"
+#include "srsran/radio/rf_buffer.h"
+#include "srsran/radio/rf_timestamp.h"
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace srsenb {
+
+/**
+ * Receives the subframes from the radio in a dedicated thread, so that a late TX/RX thread does not delay the radio
+ * reception and cause overflows.
+ *
+ * The subframes are written in a single producer single consumer ring of pre-allocated buffers, the TX/RX thread only
+ * waits when the ring is empty. If the ring is full the received subframe is discarded, as the radio would do on an
+ * overflow, and the ring keeps the subframes in sequence.
+ */
+class rf_rx_thread final : public srsran::thread
+{
+public:
+  explicit rf_rx_thread(srslog::basic_logger& logger);
+  ~rf_rx_thread() final;
+
+  /**
+   * Allocates the ring buffers, the thread is not started
+   * @param radio_h Radio to receive from
+   * @param nof_channels Number of RF channels, the logical channels of the radio buffers
+   * @param sf_len Subframe length in samples
+   * @param sc16 Set if the radio delivers 16 bit IQ samples
+   * @param nof_sf Number of subframes of the ring
+   */
+  bool init(srsran::radio_interface_phy* radio_h, uint32_t nof_channels, uint32_t sf_len, bool sc16, uint32_t nof_sf);
+
+  /// Starts receiving, once the radio is configured. It returns false if it has been stopped before
+  bool start_rx(int prio);
+
+  /// Stops the thread and wakes up the consumer, it can be called from any thread
+  void stop();
+
+  /**
+   * Waits for the next received subframe and copies it into the buffers of the given RF buffer, the channels without
+   * buffer are skipped
+   * @return false if the thread has been stopped
+   */
+  bool pop(srsran::rf_buffer_t& buffer, srsran::rf_timestamp_t& timestamp);
+
+private:
+  struct sf_t {
+    cf_t*                  samples[SRSRAN_MAX_CHANNELS] = {};
+    srsran::rf_timestamp_t timestamp                    = {};
+  };
+
+  void run_thread() override;
+  void receive(sf_t& sf);
+
+  srslog::basic_logger&        logger;
+  srsran::radio_interface_phy* radio        = nullptr;
+  uint32_t                     nof_channels = 0;
+  uint32_t                     sf_len       = 0;
+  bool                         sc16         = false;
+
+  std::vector<sf_t>     ring;
+  sf_t                  discard       = {}; ///< Written when the ring is full
+  std::atomic<uint32_t> write_idx     = {0};
+  std::atomic<uint32_t> read_idx      = {0};
+  uint32_t              nof_discarded = 0;
+
+  std::mutex              mutex; ///< Only protects the start/stop and the consumer sleep, not the ring
+  std::condition_variable cvar;
+  std::atomic<bool>       running = {true};
+  bool                    started = false;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_RF_RX_THREAD_H
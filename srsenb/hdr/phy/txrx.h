@@ -24,6 +24,7 @@
 
 #include "phy_common.h"
 #include "prach_worker.h"
+#include "rf_rx_thread.h"
 #include "srsenb/hdr/phy/lte/worker_pool.h"
 #include "srsenb/hdr/phy/nr/worker_pool.h"
 #include "srsran/config.h"
@@ -31,6 +32,7 @@
 #include "srsran/phy/channel/channel.h"
 #include "srsran/radio/radio.h"
 #include <atomic>
+#include <memory>
 
 namespace srsenb {
 
@@ -59,6 +61,10 @@ private:
   phy_common*                  worker_com  = nullptr;
   srsran::channel_ptr          ul_channel  = nullptr;
 
+  // Optional thread receiving ahead of the TX/RX thread
+  std::unique_ptr<rf_rx_thread> rf_rx   = nullptr;
+  uint32_t                      rf_prio = 0;
+
   // Main system TTI counter
   uint32_t tti = 0;
 
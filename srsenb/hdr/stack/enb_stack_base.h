@@ -33,6 +33,8 @@ namespace srsenb {
 typedef struct {
   bool        enable;
   std::string filename;
+  uint32_t    snaplen;
+  uint32_t    sampling;
 } pcap_args_t;
 
 typedef struct {
@@ -71,6 +73,9 @@ typedef struct {
 typedef struct {
   uint32_t         sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
   uint32_t         gtpu_indirect_tunnel_timeout_msec;
+  uint32_t         gtpu_nof_rx_sockets;
+  uint32_t         pdcp_nof_crypto_workers; // Threads that cipher the DRB PDUs (0 to cipher in the stack thread)
+  bool             up_thread; // Run PDCP and GTPU in a user-plane thread, apart from RRC, S1AP and MAC control
   mac_args_t       mac;
   s1ap_args_t      s1ap;
   pcap_args_t      mac_pcap;
@@ -44,6 +44,10 @@
 namespace srsenb {
 
 class gtpu_pdcp_adapter;
+class task_queue_forwarder;
+class pdcp_up_adapter;
+class gtpu_up_adapter;
+class rrc_up_adapter;
 
 class enb_stack_lte final : public enb_stack_base,
                             public stack_interface_phy_lte,
@@ -51,7 +55,8 @@ class enb_stack_lte final : public enb_stack_base,
                             public srsran::thread
 {
 public:
-  enb_stack_lte(srslog::sink& log_sink);
+  /// With up_thread_ set, PDCP and GTPU run in a user-plane thread apart from the RRC, S1AP and MAC control tasks
+  explicit enb_stack_lte(srslog::sink& log_sink, bool up_thread_ = false);
   ~enb_stack_lte() final;
 
   // eNB stack base interface
@@ -104,7 +109,8 @@ public:
   {
     return mac.push_pdu(tti, rnti, enb_cc_idx, nof_bytes, crc_res, grant_nof_prbs);
   }
-  int get_dl_sched(uint32_t tti, dl_sched_list_t& dl_sched_res) final { return mac.get_dl_sched(tti, dl_sched_res); }
+  void start_dl_sched(uint32_t tti_tx_dl) final { mac.start_dl_sched(tti_tx_dl); }
+  int  get_dl_sched(uint32_t tti, dl_sched_list_t& dl_sched_res) final { return mac.get_dl_sched(tti, dl_sched_res); }
   int get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res) final
   {
     return mac.get_mch_sched(tti, is_mcch, dl_sched_res);
@@ -149,10 +155,27 @@ public:
 
 private:
   static const int STACK_MAIN_THREAD_PRIO = 4;
+  static const int STACK_UP_THREAD_PRIO   = 4;
   // thread loop
   void run_thread() override;
   void stop_impl();
   void tti_clock_impl();
+  void up_tti_clock_impl();
+
+  // Runs the task in the thread that owns the PDCP and GTPU, and waits for it to finish
+  void run_up_task(srsran::move_task_t task);
+
+  class up_thread_t final : public srsran::thread
+  {
+  public:
+    explicit up_thread_t(enb_stack_lte& parent_) : thread("STACK_UP"), parent(parent_) {}
+    std::atomic<bool> running{false};
+
+  private:
+    void run_thread() final;
+
+    enb_stack_lte& parent;
+  };
 
   // args
   stack_args_t args    = {};
@@ -175,6 +198,17 @@ private:
   srsran::task_scheduler    task_sched;
   srsran::task_queue_handle enb_task_queue, sync_task_queue, metrics_task_queue, x2_task_queue;
 
+  // user-plane thread. Without it, up_sched points to task_sched and the PDCP and GTPU run in the stack thread
+  const bool                            up_thread;
+  srsran::task_scheduler                up_task_sched;
+  srsran::task_scheduler*               up_sched = nullptr;
+  srsran::task_queue_handle             up_sync_task_queue, x2_pdu_task_queue;
+  up_thread_t                           up_worker;
+  std::unique_ptr<task_queue_forwarder> ctrl_forwarder, up_forwarder;
+  std::unique_ptr<pdcp_up_adapter>      pdcp_adapter;
+  std::unique_ptr<gtpu_up_adapter>      gtpu_adapter_rrc;
+  std::unique_ptr<rrc_up_adapter>       rrc_adapter;
+
   // bearer management
   enb_bearer_manager                 bearers; // helper to manage mapping between EPS and radio bearers
   std::unique_ptr<gtpu_pdcp_adapter> gtpu_adapter;
@@ -23,6 +23,7 @@
 #define SRSRAN_BASE_UE_BUFFER_MANAGER_H
 
 #include "sched_config.h"
+#include "srsran/adt/bounded_vector.h"
 #include "srsran/adt/span.h"
 #include "srsran/common/common_lte.h"
 #include "srsran/common/common_nr.h"
@@ -85,6 +86,17 @@ public:
   int                                  get_bsr() const;
   const std::array<int, MAX_NOF_LCGS>& get_bsr_state() const { return lcg_bsr; }
 
+  // QoS methods
+  /// Refills the GBR/MBR token buckets and ages the waiting time of the bearers with pending data. Only the LCIDs with
+  /// a GBR, MBR or delay budget are visited. It is called once per TTI/slot, with its duration in msec
+  void new_qos_period(float period_ms);
+  /// Urgency of the UE DL bearers, >0 when a GBR bearer is below its rate or a bearer waited part of its delay budget
+  float get_dl_qos_urgency() const { return dl_qos_urgency; }
+  /// Urgency of the UE UL LCGs, as the fraction of the delay budget the LCG has waited with pending BSR
+  float get_ul_qos_urgency() const { return ul_qos_urgency; }
+  /// DL newtx buffer status for given LCID that can be transmitted without exceeding its MBR
+  int get_dl_tx_mbr_limited(uint32_t lcid) const;
+
   static bool is_lcid_valid(uint32_t lcid) { return lcid <= MAX_LC_ID; }
   static bool is_lcg_valid(uint32_t lcg) { return lcg <= MAX_LCG_ID; }
 
@@ -93,6 +105,13 @@ protected:
 
   bool config_lcid_internal(uint32_t lcid, const mac_lc_ch_cfg_t& bearer_cfg);
 
+  /// Accounts the DL newtx bytes allocated to the LCID in its GBR/MBR buckets and restarts its waiting time
+  void consume_dl_qos_tokens(uint32_t lcid, int bytes);
+  bool has_dl_gbr_deficit(uint32_t lcid) const
+  {
+    return channels[lcid].cfg.gbr_dl > 0 and channels[lcid].gbr_tokens > 0;
+  }
+
   srslog::basic_logger& logger;
   uint16_t              rnti;
 
@@ -102,10 +121,21 @@ protected:
     int             buf_prio_tx = 0;
     int             Bj          = 0;
     int             bucket_size = 0;
+    float           gbr_tokens  = 0; ///< Bytes owed to the bearer to meet its GBR, negative if it is ahead
+    float           mbr_tokens  = 0; ///< Bytes the bearer can send without exceeding its MBR
+    float           wait_ms     = 0; ///< Time with pending data since the bearer was last allocated
   };
   std::array<logical_channel, MAX_NOF_LCIDS> channels;
 
   std::array<int, MAX_NOF_LCGS> lcg_bsr;
+
+private:
+  void update_qos_lcids();
+
+  srsran::bounded_vector<uint32_t, MAX_NOF_LCIDS> qos_lcids; ///< Active LCIDs with a GBR, MBR or delay budget
+  std::array<float, MAX_NOF_LCGS>                 lcg_wait_ms;
+  float                                           dl_qos_urgency = 0;
+  float                                           ul_qos_urgency = 0;
 };
 
 } // namespace srsenb
@@ -22,6 +22,7 @@
 #ifndef SRSENB_MAC_METRICS_H
 #define SRSENB_MAC_METRICS_H
 
+#include "srsran/adt/pool/pool_metrics.h"
 #include <cstdint>
 #include <vector>
 
@@ -72,6 +73,8 @@ struct mac_metrics_t {
   std::vector<mac_cc_info_t> cc_info;
   /// Per UE MAC metrics.
   std::vector<mac_ue_metrics_t> ues;
+  /// Occupancy of the pool of HARQ softbuffers.
+  srsran::pool_metrics_t softbuffer_pool;
 };
 
 } // namespace srsenb
@@ -35,14 +35,20 @@ struct mac_lc_ch_cfg_t {
   uint32_t bsd                                          = 1000; // msec
   uint32_t pbr                                          = -1;   // prioritised bit rate
   int      group                                        = 0;    // logical channel group
+  uint32_t gbr_dl                                       = 0;    // DL guaranteed bit rate (kB/s), 0 for non-GBR
+  uint32_t gbr_ul                                       = 0;    // UL guaranteed bit rate (kB/s), 0 for non-GBR
+  uint32_t mbr_dl                                       = 0;    // DL maximum bit rate (kB/s), 0 for no limit
+  uint32_t delay_budget                                 = 0;    // packet delay budget (msec), 0 if undefined
 
   bool is_active() const { return direction != IDLE; }
   bool is_dl() const { return direction == DL or direction == BOTH; }
   bool is_ul() const { return direction == UL or direction == BOTH; }
+  bool is_gbr() const { return gbr_dl > 0 or gbr_ul > 0; }
   bool operator==(const mac_lc_ch_cfg_t& other) const
   {
     return direction == other.direction and priority == other.priority and bsd == other.bsd and pbr == other.pbr and
-           group == other.group;
+           group == other.group and gbr_dl == other.gbr_dl and gbr_ul == other.gbr_ul and mbr_dl == other.mbr_dl and
+           delay_budget == other.delay_budget;
   }
   bool operator!=(const mac_lc_ch_cfg_t& other) const { return not(*this == other); }
 };
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSRAN_UL_PRESCHED_PREDICTOR_H
+#define SRSRAN_UL_PRESCHED_PREDICTOR_H
+
+#include <cstdint>
+
+namespace srsenb {
+
+/**
+ * Predictor of periodic UL traffic (e.g. VoIP frames), used to allocate UL grants before the UE has to send a SR
+ * and save the SR -> grant -> BSR round-trip.
+ *
+ * The period and the size of the UL bursts are learnt from the UL SDUs received by the MAC. Once the period is
+ * confirmed, a proactive grant is due one period after the last burst. A proactive grant followed by UL data within
+ * "rx_window" slots is a hit, and the next one is attempted one slot earlier to get closer to the data arrival at the
+ * UE. An unused grant is a miss and the next one is delayed. After "max_misses" consecutive misses the predictor
+ * backs off until the period is learnt again from the bursts that the UE reports via SR/BSR.
+ */
+class ul_presched_predictor
+{
+public:
+  /// @param rx_window_ maximum number of slots between a UL grant and the reception of its PUSCH data
+  explicit ul_presched_predictor(uint32_t rx_window_) : rx_window(rx_window_) {}
+
+  /// max_bytes_ = 0 disables the prediction
+  void set_cfg(uint32_t max_bytes_, uint32_t max_misses_);
+  void reset();
+
+  /// Called once per TTI/slot
+  void new_slot();
+
+  /// Called when the MAC receives UL SDUs of a DRB
+  void ul_data_rx(uint32_t nof_bytes);
+
+  /// Called when a UL newtx grant is allocated to the UE
+  void ul_newtx_alloc();
+
+  /// True if the traffic period is confirmed and the UE should not be considered idle
+  bool is_armed() const { return max_bytes > 0 and nof_confirmations >= min_confirmations; }
+
+  /// Bytes of the proactive grant that is due in this slot, 0 if none
+  uint32_t get_presched_bytes() const;
+
+private:
+  const static uint32_t min_confirmations = 3;
+  const static uint32_t burst_gap         = 8; ///< SDUs closer than this belong to the same burst
+  const static uint32_t max_period        = 320;
+  const static uint32_t min_presched_size = 16;
+  const static uint32_t miss_backoff      = 2;
+  constexpr static float ewma_alpha       = 0.25;
+  constexpr static float period_tolerance = 0.25; ///< Relative deviation of a period that keeps it confirmed
+
+  bool is_due() const { return is_armed() and not grant_pending and static_cast<int32_t>(count - next_grant) >= 0; }
+
+  const uint32_t rx_window;
+  uint32_t       max_bytes  = 0;
+  uint32_t       max_misses = 2;
+
+  uint32_t count             = 0;
+  uint32_t last_rx           = 0;
+  uint32_t last_burst_start  = 0;
+  bool     has_rx            = false;
+  uint32_t burst_bytes       = 0;
+  float    period_est        = 0;
+  float    size_est          = 0;
+  uint32_t nof_confirmations = 0;
+  uint32_t next_grant        = 0;
+  bool     grant_pending     = false;
+  uint32_t grant_slot        = 0;
+  uint32_t nof_misses        = 0;
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_UL_PRESCHED_PREDICTOR_H
@@ -24,6 +24,7 @@
 
 #include "sched.h"
 #include "sched_interface.h"
+#include "sched_recorder.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_rr.h"
 #include "srsran/adt/circular_map.h"
@@ -31,6 +32,7 @@
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/mac_pcap_net.h"
 #include "srsran/common/task_scheduler.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/common/tti_sync_cv.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
@@ -39,6 +41,9 @@
 #include "srsran/srslog/srslog.h"
 #include "ta.h"
 #include "ue.h"
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <vector>
 
 namespace srsenb {
@@ -73,12 +78,13 @@ public:
   int push_pdu(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t nof_bytes, bool crc_res, uint32_t ul_nof_prbs)
       override;
 
+  void start_dl_sched(uint32_t tti_tx_dl) override;
   int  get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res) override;
   int  get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res) override;
   int  get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res) override;
   void set_sched_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs) override
   {
-    scheduler.set_dl_tti_mask(tti_mask, nof_sfs);
+    sched_h->set_dl_tti_mask(tti_mask, nof_sfs);
   }
   void build_mch_sched(uint32_t tbs);
 
@@ -93,6 +99,7 @@ public:
 
   // Indicates that the PHY config dedicated has been enabled or not
   void phy_config_enabled(uint16_t rnti, bool enabled) override;
+  bool admit_gbr_bearer(uint16_t rnti, uint32_t gbr_dl, uint32_t gbr_ul) override;
 
   /* Manages UE bearers and associated configuration */
   int bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, mac_lc_ch_cfg_t* cfg) override;
@@ -101,6 +108,7 @@ public:
 
   /* Handover-related */
   uint16_t reserve_new_crnti(const sched_interface::ue_cfg_t& ue_cfg) override;
+  uint16_t reserve_sps_crnti(uint16_t rnti) override;
 
   void get_metrics(mac_metrics_t& metrics);
 
@@ -115,6 +123,7 @@ public:
                   const uint8_t              mcch_payload_length) override;
 
 private:
+  int      run_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list);
   bool     check_ue_active(uint16_t rnti);
   uint16_t allocate_ue(uint32_t enb_cc_idx);
   bool     is_valid_rnti_unprotected(uint16_t rnti);
@@ -151,8 +160,24 @@ private:
 
   /* Scheduler unit */
   sched                                    scheduler;
+  std::unique_ptr<sched_recorder>          sched_rec;            ///< Set if the scheduler inputs are recorded
+  sched_interface*                         sched_h = &scheduler; ///< Scheduler, or its recorder
   std::vector<sched_interface::cell_cfg_t> cell_config;
 
+  /* Scheduling thread, the DL results wait in a slot per TTI until the PHY worker picks them up */
+  struct sched_slot_t {
+    uint32_t        tti_tx_dl = 0;
+    bool            pending   = false; ///< Set from start_dl_sched() until get_dl_sched() takes the result
+    bool            ready     = false;
+    int             ret       = SRSRAN_SUCCESS;
+    dl_sched_list_t dl_sched_res;
+  };
+  const static uint32_t                     nof_sched_slots = 8; ///< Above the number of TTIs in flight in the PHY
+  std::unique_ptr<srsran::task_thread_pool> sched_thread;
+  std::array<sched_slot_t, nof_sched_slots> sched_slots;
+  std::mutex                                sched_slots_mutex;
+  std::condition_variable                   sched_slots_cvar;
+
   sched_interface::dl_pdu_mch_t mch = {};
 
   /* Map of active UEs */
@@ -160,6 +185,12 @@ private:
   rnti_map_t<unique_rnti_ptr<ue> > ue_db;
   std::atomic<uint16_t>            ue_counter{0};
 
+  /* SPS C-RNTIs, above the C-RNTI range and below the reserved RNTIs of TS 36.321 Table 7.1-1. Stack thread only */
+  static const uint16_t        FIRST_SPS_CRNTI = FIRST_RNTI + 60000;
+  static const uint16_t        NOF_SPS_CRNTIS  = 0xFFF4 - FIRST_SPS_CRNTI;
+  std::map<uint16_t, uint16_t> sps_crntis; ///< SPS C-RNTI -> C-RNTI
+  uint16_t                     sps_crnti_counter = 0;
+
   uint8_t* assemble_rar(sched_interface::dl_sched_rar_grant_t* grants,
                         uint32_t                               enb_cc_idx,
                         uint32_t                               nof_grants,
@@ -203,6 +234,10 @@ private:
   // PDCCH order
   std::vector<sched_interface::dl_sched_po_info_t> pending_po_prachs = {};
 
+  // Code block slabs of all carriers, they must outlive the softbuffer pool
+  const static uint32_t               softbuffer_cb_per_batch = 32;
+  std::unique_ptr<softbuffer_cb_pool> cb_pool;
+
   // Softbuffer pool
   std::unique_ptr<srsran::obj_pool_itf<ue_cc_softbuffers> > softbuffer_pool;
 };
@@ -26,7 +26,9 @@
 #include "sched_interface.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/common/thread_pool.h"
 #include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 
@@ -56,6 +58,9 @@ public:
 
   void phy_config_enabled(uint16_t rnti, bool enabled);
 
+  /// Checks whether the PCell of the UE can carry a new GBR bearer (kB/s) on top of the configured GBR bearers
+  bool admit_gbr_bearer(uint16_t rnti, uint32_t gbr_dl, uint32_t gbr_ul);
+
   int bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, const mac_lc_ch_cfg_t& cfg) final;
   int bearer_ue_rem(uint16_t rnti, uint32_t lc_id) final;
 
@@ -76,6 +81,7 @@ public:
   int ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr) final;
   int ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb) final;
   int ul_snr_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code) final;
+  int ul_sdu_info(uint16_t rnti, uint32_t lcid, uint32_t nof_bytes) final;
 
   int dl_sched(uint32_t tti, uint32_t enb_cc_idx, dl_sched_res_t& sched_result) final;
   int ul_sched(uint32_t tti, uint32_t enb_cc_idx, ul_sched_res_t& sched_result) final;
@@ -94,6 +100,7 @@ public:
 
 protected:
   void new_tti(srsran::tti_point tti_rx);
+  void new_tti_parallel(srsran::tti_point tti_rx, const srsran::bounded_vector<uint32_t, SRSRAN_MAX_CARRIERS>& cc_list);
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
   // Helper methods
   template <typename Func>
@@ -105,6 +112,7 @@ protected:
   std::vector<sched_cell_params_t> sched_cell_params;
 
   rnti_map_t<std::unique_ptr<sched_ue> > ue_db;
+  sched_ue_active_list                   active_ues;
 
   // independent schedulers for each carrier
   std::vector<std::unique_ptr<carrier_sched> > carrier_schedulers;
@@ -112,6 +120,12 @@ protected:
   // Storage of past scheduling results
   sched_result_ringbuffer sched_results;
 
+  // Helpers taking the decisions of the carriers concurrently
+  std::unique_ptr<srsran::task_thread_pool> cc_workers;
+  std::mutex                                cc_workers_mutex;
+  std::condition_variable                   cc_workers_cvar;
+  uint32_t                                  cc_workers_pending = 0;
+
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
   bool              configured;
@@ -35,17 +35,27 @@ class ra_sched;
 class sched::carrier_sched
 {
 public:
-  explicit carrier_sched(rrc_interface_mac*       rrc_,
-                         sched_ue_list*           ue_db_,
-                         uint32_t                 enb_cc_idx_,
-                         sched_result_ringbuffer* sched_results_);
+  explicit carrier_sched(rrc_interface_mac*          rrc_,
+                         sched_ue_list*              ue_db_,
+                         const sched_ue_active_list* active_ues_,
+                         uint32_t                    enb_cc_idx_,
+                         sched_result_ringbuffer*    sched_results_);
   ~carrier_sched();
   void                   reset();
   void                   carrier_cfg(const sched_cell_params_t& sched_params_);
   void                   set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs);
   const cc_sched_result& generate_tti_result(srsran::tti_point tti_rx);
+
+  /// Steps of generate_tti_result, for the carriers to be scheduled concurrently
+  //! Set up the subframes written in tti_rx. It must not run concurrently with other carriers
+  void prepare_tti(srsran::tti_point tti_rx);
+  //! Take the carrier allocation decisions. Only the carrier state and the carrier result are written
+  void schedule_tti(srsran::tti_point tti_rx);
+  //! Generate the carrier result, consuming the UE-wide state. It must not run concurrently with other carriers
+  const cc_sched_result& finish_tti_result(srsran::tti_point tti_rx);
   int                    dl_rach_info(dl_sched_rar_info_t rar_info);
   int                    pdcch_order_info(dl_sched_po_info_t pdcch_order_info);
+  void                   ue_rem(uint16_t rnti);
 
   // getters
   const ra_sched* get_ra_sched() const { return ra_sched_ptr.get(); }
@@ -61,13 +71,16 @@ private:
   sf_sched* get_sf_sched(srsran::tti_point tti_rx);
   //! Schedule PDCCH orders
   void pdcch_order_sched(sf_sched* tti_sched);
+  //! Schedule the SPS activations, occasions and releases of the UEs whose PCell is this carrier
+  void sps_sched(sf_sched* tti_sched, bool dl_active);
 
   // args
   const sched_cell_params_t* cc_cfg = nullptr;
   srslog::basic_logger&      logger;
   rrc_interface_mac*         rrc   = nullptr;
-  sched_ue_list*             ue_db = nullptr;
-  const uint32_t             enb_cc_idx;
+  sched_ue_list*              ue_db      = nullptr;
+  const sched_ue_active_list* active_ues = nullptr;
+  const uint32_t              enb_cc_idx;
 
   // Subframe scheduling logic
   srsran::circular_array<sf_sched, TTIMOD_SZ> sf_scheds;
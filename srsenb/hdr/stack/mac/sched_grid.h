@@ -93,12 +93,14 @@ public:
   void         new_tti(tti_point tti_rx);
   alloc_result alloc_dl_ctrl(uint32_t aggr_lvl, rbg_interval rbg_range, alloc_type_t alloc_type);
   alloc_result alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask, bool has_pusch_grant);
+  alloc_result alloc_dl_sps(sched_ue* user, const rbgmask_t& user_mask, bool needs_pdcch, bool has_pusch_grant);
   bool         reserve_dl_rbgs(uint32_t start_rbg, uint32_t end_rbg);
   void         rem_last_alloc_dl(rbg_interval rbgs);
 
   alloc_result alloc_ul_data(sched_ue* user, prb_interval alloc, bool needs_pdcch, bool strict = true);
   alloc_result reserve_ul_prbs(const prbmask_t& prbmask, bool strict);
   alloc_result reserve_ul_prbs(prb_interval alloc, bool strict);
+  void         release_ul_prbs(prb_interval alloc);
   bool         find_ul_alloc(uint32_t L, prb_interval* alloc) const;
 
   // getters
@@ -154,21 +156,29 @@ public:
     sched_interface::dl_sched_po_t po_grant;
   };
   struct dl_alloc_t {
+    enum type_t { DATA, SPS_ACTIVATION, SPS_OCCASION, SPS_RELEASE };
     size_t    dci_idx;
     uint16_t  rnti;
     rbgmask_t user_mask;
     uint32_t  pid;
+    type_t    type = DATA;
+    bool      needs_pdcch() const { return type != SPS_OCCASION; }
   };
   struct ul_alloc_t {
     enum type_t { NEWTX, NOADAPT_RETX, ADAPT_RETX };
+    enum sps_t { NO_SPS, SPS_ACTIVATION, SPS_OCCASION };
     bool         is_msg3 = false;
     size_t       dci_idx;
     type_t       type;
     uint16_t     rnti;
     prb_interval alloc;
     int          msg3_mcs = -1;
+    sps_t        sps      = NO_SPS;
     bool         is_retx() const { return type == NOADAPT_RETX or type == ADAPT_RETX; }
-    bool         needs_pdcch() const { return (type == NEWTX and not is_msg3) or type == ADAPT_RETX; }
+    bool         needs_pdcch() const
+    {
+      return (type == NEWTX and not is_msg3 and sps != SPS_OCCASION) or type == ADAPT_RETX;
+    }
   };
   struct pending_msg3_t {
     uint16_t rnti  = 0;
@@ -200,6 +210,14 @@ public:
   }
   alloc_result alloc_phich(sched_ue* user);
 
+  // SPS alloc methods
+  alloc_result alloc_dl_sps(sched_ue* user, const rbgmask_t& user_mask, uint32_t pid, dl_alloc_t::type_t sps_type);
+  alloc_result alloc_ul_sps(sched_ue* user, prb_interval alloc, ul_alloc_t::sps_t sps_type);
+  //! Reserve the PRBs of a UL SPS occasion ahead of the Msg3 and UL data allocations of the subframe
+  alloc_result reserve_ul_sps(uint16_t rnti, prb_interval alloc);
+  //! Free the reserved PRBs of the UL SPS occasions that were not allocated, e.g. because the UE was removed
+  void release_ul_sps_reservations();
+
   // compute DCIs and generate dl_sched_result/ul_sched_result for a given TTI
   void generate_sched_results(sched_ue_list& ue_db);
 
@@ -242,6 +260,12 @@ private:
   srsran::bounded_vector<ul_alloc_t, sched_interface::MAX_DATA_LIST> ul_data_allocs;
   uint32_t                                                           last_msg3_prb = 0, max_msg3_prb = 0;
 
+  struct ul_sps_reservation_t {
+    uint16_t     rnti;
+    prb_interval alloc;
+  };
+  srsran::bounded_vector<ul_sps_reservation_t, sched_interface::MAX_DATA_LIST> ul_sps_reservations;
+
   // Next TTI state
   tti_point tti_rx;
 };
@@ -80,12 +80,19 @@ public:
     int         init_dl_cqi               = 5;
     float       max_sib_coderate          = 0.8;
     int         pdcch_cqi_offset          = 0;
+    uint32_t    nof_cc_workers            = 0;
+    float       gbr_max_load              = 0.8; ///< Fraction of the cell peak rate that GBR bearers can reserve
+    uint32_t    ul_presched_max_bytes     = 0;   ///< Max size of the proactive UL grants of periodic traffic, 0 disables
+    uint32_t    ul_presched_max_misses    = 2;   ///< Unused proactive UL grants before the pre-scheduling backs off
   };
 
   struct cell_cfg_t {
     // Main cell configuration (used to calculate DCI locations in scheduler)
     srsran_cell_t cell;
 
+    // Uplink-downlink configuration, only used if cell.frame_type is SRSRAN_TDD
+    srsran_tdd_config_t tdd_config;
+
     /* SIB configuration */
     cell_cfg_sib_t sibs[MAX_SIBS];
     uint32_t       si_window_ms;
@@ -146,6 +153,17 @@ public:
     enum class ue_tx_ant_sel_t { release, closed_loop, open_loop } ue_tx_ant_sel = ue_tx_ant_sel_t::release;
   };
 
+  /// Semi-persistent scheduling configuration of the UE PCell (TS 36.331 SPS-Config)
+  struct sps_cfg_t {
+    uint16_t sps_crnti              = SRSRAN_INVALID_RNTI;
+    uint32_t lcid                   = 0; ///< Bearer whose traffic activates the SPS grants
+    uint32_t dl_interval            = 0; ///< DL SPS period in subframes, 0 if DL SPS is not configured
+    uint32_t dl_nof_harq            = 1; ///< HARQ processes reserved for the DL SPS occasions
+    uint32_t n1_pucch_an            = 0; ///< n1PUCCH-AN-Persistent of the HARQ-ACKs of the DL SPS occasions
+    uint32_t ul_interval            = 0; ///< UL SPS period in subframes, 0 if UL SPS is not configured
+    uint32_t implicit_release_after = 2; ///< Empty occasions before the DL/UL SPS grants are released
+  };
+
   struct ue_cfg_t {
     struct cc_cfg_t {
       bool            active               = false;
@@ -166,6 +184,7 @@ public:
     uint32_t                            measgap_offset    = 0;
     enum class ul64qam_cap { undefined, disabled, enabled };
     ul64qam_cap support_ul64qam = ul64qam_cap::undefined;
+    sps_cfg_t   sps_cfg         = {};
   };
 
   typedef struct {
@@ -195,6 +214,10 @@ public:
     bool            mac_ce_rnti;
     uint32_t        nof_pdu_elems[SRSRAN_MAX_TB];
     dl_sched_pdu_t  pdu[SRSRAN_MAX_TB][MAX_RLC_PDU_LIST];
+    uint16_t        sps_crnti;   ///< If set, the DCI CRC and the PDSCH are scrambled with the SPS C-RNTI
+    bool            no_pdcch;    ///< DL SPS occasion, the UE uses the configured assignment
+    bool            no_pdsch;    ///< DL SPS release, the DCI is not followed by a PDSCH
+    uint32_t        n1_pucch_an; ///< PUCCH resource of the HARQ-ACK of a DL SPS occasion
   };
 
   typedef struct {
@@ -202,6 +225,7 @@ public:
     uint32_t        current_tx_nb;
     uint32_t        tbs;
     srsran_dci_ul_t dci;
+    uint16_t        sps_crnti; ///< If set, the DCI CRC and the PUSCH are scrambled with the SPS C-RNTI
   } ul_sched_data_t;
 
   struct dl_sched_rar_info_t {
@@ -317,6 +341,7 @@ public:
   virtual int ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)                                          = 0;
   virtual int ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)                                           = 0;
   virtual int ul_snr_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code) = 0;
+  virtual int ul_sdu_info(uint16_t rnti, uint32_t lcid, uint32_t nof_bytes)                                 = 0;
 
   /* Run Scheduler for this tti */
   virtual int dl_sched(uint32_t tti, uint32_t enb_cc_idx, dl_sched_res_t& sched_result) = 0;
@@ -34,6 +34,7 @@ namespace srsenb {
 
 constexpr float    tti_duration_ms = 1;
 constexpr uint32_t NOF_AGGR_LEVEL  = 4;
+constexpr uint32_t MAX_SPS_MCS     = 15; ///< The MSB of the MCS of a SPS activation DCI is used for its validation
 
 /***********************
  *   Helper Types
@@ -118,6 +118,34 @@ void generate_pdcch_order_dci(sched_interface::dl_sched_po_t& pdcch_order,
                               const sched_cell_params_t&      cell_params,
                               uint32_t                        current_cfi);
 
+/**
+ * Generate the DCI format 1A that activates the DL SPS assignment of a UE, with the fields that validate it
+ * \remark See TS 36.213 - Section 9.2 and Table 9.2-1
+ * @return false if the MCS cannot be signalled in a SPS activation
+ */
+bool generate_dl_sps_activation_dci(srsran_dci_dl_t&           dci,
+                                    uint16_t                   crnti,
+                                    prb_interval               prb_range,
+                                    uint32_t                   mcs,
+                                    const sched_cell_params_t& cell_params);
+
+/**
+ * Generate the DCI format 1A that releases the DL SPS assignment of a UE. It is not followed by a PDSCH
+ * \remark See TS 36.213 - Section 9.2 and Table 9.2-1A
+ */
+void generate_dl_sps_release_dci(srsran_dci_dl_t& dci, uint16_t crnti, const sched_cell_params_t& cell_params);
+
+/**
+ * Generate the DCI format 0 that activates the UL SPS grant of a UE, with the fields that validate it
+ * \remark See TS 36.213 - Section 9.2 and Table 9.2-1
+ * @return false if the MCS cannot be signalled in a SPS activation
+ */
+bool generate_ul_sps_activation_dci(srsran_dci_ul_t&           dci,
+                                    uint16_t                   crnti,
+                                    prb_interval               prb_range,
+                                    uint32_t                   mcs,
+                                    const sched_cell_params_t& cell_params);
+
 void log_broadcast_allocation(const sched_interface::dl_sched_bc_t& bc,
                               rbg_interval                          rbg_range,
                               const sched_cell_params_t&            cell_params);
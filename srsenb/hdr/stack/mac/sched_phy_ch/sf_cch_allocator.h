@@ -34,6 +34,9 @@ class sf_cch_allocator
 {
 public:
   const static uint32_t MAX_CFI = 3;
+  /// Maximum number of DFS nodes visited by a DCI allocation attempt, so that the allocation time stays bounded when
+  /// the PDCCH is crowded. Once exceeded, the allocation fails as if no other combination of DCI positions was found
+  const static uint32_t MAX_DFS_STEPS = 256;
   struct tree_node {
     int8_t                pucch_n_prb = -1; ///< this PUCCH resource identifier
     uint16_t              rnti        = SRSRAN_INVALID_RNTI;
@@ -82,6 +85,7 @@ private:
   // PDCCH allocation algorithm
   bool alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
   bool get_next_dfs();
+  void backjump_dfs(const alloc_record& record);
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -92,6 +96,7 @@ private:
   tti_point                 tti_rx;
   uint32_t                  current_cfix     = 0;
   uint32_t                  current_max_cfix = 0;
+  uint32_t                  nof_dfs_steps    = 0;
   std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
   std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
 };
@@ -0,0 +1,134 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_SCHED_RECORDER_H
+#define SRSENB_SCHED_RECORDER_H
+
+#include "sched.h"
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace srsenb {
+
+/**
+ * Scheduler decorator that logs every call changing the state of the scheduler to a binary file, and then forwards
+ * it. A recording feeds the same workload to a scheduler offline through sched_replay().
+ *
+ * The file starts with a magic number and a format version, followed by one record per call: a 16-bit call type, a
+ * 32-bit payload length and the call arguments. Configuration structures are stored as raw images, so recordings are
+ * only portable between builds with the same scheduler interface structures.
+ */
+class sched_recorder final : public sched_interface
+{
+public:
+  explicit sched_recorder(sched& sched_);
+  ~sched_recorder() override;
+
+  bool open(const std::string& filename);
+  void close();
+
+  int cell_cfg(const std::vector<cell_cfg_t>& cell_cfg) override;
+  int reset() override;
+
+  int  ue_cfg(uint16_t rnti, const ue_cfg_t& cfg) override;
+  int  ue_rem(uint16_t rnti) override;
+  bool ue_exists(uint16_t rnti) override { return sched_h.ue_exists(rnti); }
+  void phy_config_enabled(uint16_t rnti, bool enabled);
+
+  int bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, const mac_lc_ch_cfg_t& cfg) override;
+  int bearer_ue_rem(uint16_t rnti, uint32_t lc_id) override;
+
+  uint32_t get_ul_buffer(uint16_t rnti) override { return sched_h.get_ul_buffer(rnti); }
+  uint32_t get_dl_buffer(uint16_t rnti) override { return sched_h.get_dl_buffer(rnti); }
+
+  int dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue) override;
+  int dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds) override;
+
+  int dl_ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack) override;
+  int dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info) override;
+  int dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value) override;
+  int dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value) override;
+  int dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value) override;
+  int dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value) override;
+  int ul_crc_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, bool crc) override;
+  int ul_sr_info(uint32_t tti, uint16_t rnti) override;
+  int ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr) override;
+  int ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb) override;
+  int ul_snr_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code) override;
+  int ul_sdu_info(uint16_t rnti, uint32_t lcid, uint32_t nof_bytes) override;
+
+  int dl_sched(uint32_t tti, uint32_t enb_cc_idx, dl_sched_res_t& sched_result) override;
+  int ul_sched(uint32_t tti, uint32_t enb_cc_idx, ul_sched_res_t& sched_result) override;
+
+  int set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_info) override;
+
+  void                                 set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs) override;
+  std::array<int, SRSRAN_MAX_CARRIERS> get_enb_ue_cc_map(uint16_t rnti) override
+  {
+    return sched_h.get_enb_ue_cc_map(rnti);
+  }
+  std::array<int, SRSRAN_MAX_CARRIERS> get_enb_ue_activ_cc_map(uint16_t rnti) override
+  {
+    return sched_h.get_enb_ue_activ_cc_map(rnti);
+  }
+  int ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes) override;
+
+private:
+  template <typename... Args>
+  void write(uint16_t type, const Args&... args);
+
+  sched&                sched_h;
+  std::mutex            mutex;
+  FILE*                 f = nullptr;
+  std::vector<uint8_t>  buffer;
+  srslog::basic_logger& logger;
+};
+
+/// Initial value of the digests of scheduling decisions
+constexpr uint64_t sched_digest_init = 0xcbf29ce484222325ULL;
+
+/// Folds the decisions of a scheduling result into a digest, ignoring the fields that do not depend on the scheduler
+void sched_result_digest(uint64_t& digest, const sched_interface::dl_sched_res_t& res);
+void sched_result_digest(uint64_t& digest, const sched_interface::ul_sched_res_t& res);
+
+/// Outcome of the replay of a recording
+struct sched_replay_stats_t {
+  uint32_t                 nof_calls    = 0;
+  uint32_t                 nof_dl_sched = 0;
+  uint32_t                 nof_ul_sched = 0;
+  std::chrono::nanoseconds sched_time{0}; ///< Time spent in dl_sched() and ul_sched()
+  uint64_t                 dl_digest = 0; ///< Digest of the DL decisions, equal if two schedulers decided alike
+  uint64_t                 ul_digest = 0; ///< Digest of the UL decisions
+};
+
+/**
+ * Feeds the calls of a recording to a scheduler, in order and as fast as possible. The scheduler must be initialized,
+ * the cell configuration is part of the recording.
+ * @return SRSRAN_SUCCESS if the whole recording was replayed
+ */
+int sched_replay(const std::string& filename, sched& sched_, sched_replay_stats_t& stats);
+
+} // namespace srsenb
+
+#endif // SRSENB_SCHED_RECORDER_H
@@ -24,10 +24,12 @@
 
 #include "sched_lte_common.h"
 #include "sched_ue_ctrl/sched_lch.h"
+#include "sched_ue_ctrl/sched_sps.h"
 #include "sched_ue_ctrl/sched_ue_cell.h"
 #include "sched_ue_ctrl/tpc.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
+#include "srsenb/hdr/stack/mac/common/ul_presched_predictor.h"
 #include "srsran/srslog/srslog.h"
 #include <bitset>
 #include <map>
@@ -83,6 +85,7 @@ public:
   const ue_cfg_t&           get_ue_cfg() const { return cfg; }
   uint32_t                  get_aggr_level(uint32_t enb_cc_idx, uint32_t nof_bits);
   void                      ul_buffer_add(uint8_t lcid, uint32_t bytes);
+  void                      ul_sdu_info(uint32_t lcid, uint32_t nof_bytes);
   void                      metrics_read(mac_ue_metrics_t& metrics);
 
   /*******************************************************
@@ -105,6 +108,15 @@ public:
   uint32_t get_pending_ul_old_data(uint32_t enb_cc_idx);
   uint32_t get_expected_ul_bitrate(uint32_t enb_cc_idx, int nof_prbs = -1) const;
 
+  /// QoS urgency of the UE bearers, 0 when no GBR bearer is behind its rate and no delay budget is at risk
+  float get_dl_qos_urgency() const { return lch_handler.get_dl_qos_urgency(); }
+  float get_ul_qos_urgency() const { return lch_handler.get_ul_qos_urgency(); }
+
+  /// Semi-persistent scheduling state. SPS is only used in the PCell of UEs without SCells
+  sps_ue_manager& get_sps() { return sps; }
+  uint32_t        get_pending_dl_sps_bytes() const;
+  uint32_t        get_pending_ul_sps_bytes() const;
+
   dl_harq_proc* get_pending_dl_harq(tti_point tti_tx_dl, uint32_t enb_cc_idx);
   dl_harq_proc* get_empty_dl_harq(tti_point tti_tx_dl, uint32_t enb_cc_idx);
   ul_harq_proc* get_ul_harq(tti_point tti_tx_ul, uint32_t enb_cc_idx);
@@ -137,6 +149,20 @@ public:
                        int                               explicit_mcs = -1,
                        uci_pusch_t                       uci_type     = UCI_PUSCH_NONE);
 
+  /// Generate the DL SPS activation, or the occasion that reuses the activated assignment without PDCCH
+  int  generate_dl_sps_dci(uint32_t                          pid,
+                           sched_interface::dl_sched_data_t* data,
+                           tti_point                         tti_tx_dl,
+                           uint32_t                          enb_cc_idx,
+                           bool                              is_activation);
+  void generate_dl_sps_release_dci(sched_interface::dl_sched_data_t* data, uint32_t enb_cc_idx);
+  /// Generate the UL SPS activation, or the occasion that reuses the activated grant without PDCCH
+  int  generate_ul_sps_format0(sched_interface::ul_sched_data_t* data,
+                               tti_point                         tti_tx_ul,
+                               uint32_t                          enb_cc_idx,
+                               bool                              is_activation,
+                               srsran_dci_location_t             dci_pos);
+
   srsran_dci_format_t           get_dci_format();
   const cce_cfi_position_table* get_locations(uint32_t enb_cc_idx, uint32_t current_cfi, uint32_t sf_idx) const;
 
@@ -151,7 +177,15 @@ public:
   bool pusch_enabled(tti_point tti_rx, uint32_t enb_cc_idx, bool needs_pdcch) const;
   bool phich_enabled(tti_point tti_rx, uint32_t enb_cc_idx) const;
 
+  /// Whether the UE has no pending data, SR or busy HARQs, and its carriers are not changing state
+  bool is_idle() const;
+
 private:
+  friend class sched_ue_active_list;
+
+  /// TTIs between a UL grant and the reception of its PUSCH data, with margin for the PHY/MAC processing
+  static const uint32_t ul_presched_rx_window = FDD_HARQ_DELAY_DL_MS + FDD_HARQ_DELAY_UL_MS + 4;
+
   bool is_sr_triggered();
 
   tbs_info allocate_new_dl_mac_pdu(sched_interface::dl_sched_data_t* data,
@@ -208,14 +242,17 @@ private:
   const sched_cell_params_t* main_cc_params = nullptr;
 
   /* Buffer states */
-  bool           sr = false;
-  lch_ue_manager lch_handler;
+  bool                  sr = false;
+  lch_ue_manager        lch_handler;
+  ul_presched_predictor ul_presched{ul_presched_rx_window};
+  sps_ue_manager        sps;
 
   uint32_t cqi_request_tti = 0;
   uint16_t rnti            = 0;
   uint32_t max_msg3retx    = 0;
 
   bool phy_config_dedicated_enabled = false;
+  bool in_active_list               = false;
 
   tti_point                  current_tti;
   std::vector<sched_ue_cell> cells; ///< List of eNB cells that may be configured/activated/deactivated for the UE
@@ -223,6 +260,33 @@ private:
 
 using sched_ue_list = rnti_map_t<std::unique_ptr<sched_ue> >;
 
+/**
+ * Subset of the ue_db with the UEs that may need a grant. The UEs are added by the scheduler events that can create
+ * work for them (buffer states, BSRs, SRs, HARQ feedback, reconfigurations) and pruned at the start of the TTI once
+ * idle, so the scheduling policies do not scan every attached UE in every TTI.
+ */
+class sched_ue_active_list
+{
+public:
+  using const_iterator = std::vector<sched_ue*>::const_iterator;
+
+  sched_ue_active_list() { ues.reserve(SRSENB_MAX_UES); }
+
+  void add(sched_ue& ue);
+  void rem(sched_ue& ue);
+  //! Remove the UEs that became idle
+  void prune();
+  void clear();
+
+  size_t         size() const { return ues.size(); }
+  bool           empty() const { return ues.empty(); }
+  const_iterator begin() const { return ues.begin(); }
+  const_iterator end() const { return ues.end(); }
+
+private:
+  std::vector<sched_ue*> ues;
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_SCHEDULER_UE_H
@@ -33,7 +33,7 @@ class harq_proc
 {
 public:
   harq_proc();
-  void init(uint32_t id);
+  void init(uint32_t id, uint32_t* active_mask_ = nullptr);
   void reset(uint32_t tb_idx);
 
   uint32_t get_id() const { return id; }
@@ -53,6 +53,7 @@ protected:
   bool has_pending_retx_common(uint32_t tb_idx) const;
   int  set_ack_common(uint32_t tb_idx, bool ack);
   void reset_pending_data_common();
+  void set_active(uint32_t tb_idx, bool value);
 
   enum ack_t { NACK, ACK };
 
@@ -67,6 +68,7 @@ protected:
   std::array<int, SRSRAN_MAX_TB>      last_mcs  = {};
   std::array<int, SRSRAN_MAX_TB>      last_tbs  = {};
   srsran::tti_point                   tti;
+  uint32_t*                           active_mask = nullptr; ///< Bit id is set while any TB is active
 };
 
 class dl_harq_proc : public harq_proc
@@ -132,6 +134,8 @@ public:
   static const bool is_async = ASYNC_DL_SCHED;
 
   harq_entity(size_t nof_dl_harqs, size_t nof_ul_harqs);
+  harq_entity(harq_entity&& other) noexcept;
+  harq_entity& operator=(harq_entity&& other) noexcept;
 
   void reset();
   void new_tti(tti_point tti_rx);
@@ -141,6 +145,7 @@ public:
   std::vector<dl_harq_proc>&       dl_harq_procs() { return dl_harqs; }
   const std::vector<dl_harq_proc>& dl_harq_procs() const { return dl_harqs; }
   std::vector<ul_harq_proc>&       ul_harq_procs() { return ul_harqs; }
+  const std::vector<ul_harq_proc>& ul_harq_procs() const { return ul_harqs; }
 
   /**
    * Get the DL harq proc based on tti_tx_dl
@@ -155,6 +160,9 @@ public:
    */
   dl_harq_proc* get_empty_dl_harq(tti_point tti_tx_dl);
 
+  /// Exclude the first nof_harqs DL HARQ processes from the search of empty HARQs, e.g. to leave them to DL SPS
+  void reserve_dl_harqs(uint32_t nof_harqs) { nof_reserved_dl_harqs = std::min<size_t>(nof_harqs, dl_harqs.size()); }
+
   /**
    * Set ACK state for DL Harq Proc
    * @param tti_rx tti the DL ACK was received
@@ -177,11 +185,27 @@ public:
 
 private:
   dl_harq_proc* get_oldest_dl_harq(tti_point tti_tx_dl);
+  void          bind_harqs();
+
+  /// Calls f for each DL HARQ with an active TB, the HARQs that are empty are not visited
+  template <typename F>
+  void for_each_active_dl_harq(F&& f)
+  {
+    for (uint32_t mask = dl_active_mask; mask != 0; mask &= mask - 1) {
+      f(dl_harqs[srsran::find_first_lsb_one(mask)]);
+    }
+  }
 
   std::array<tti_point, SRSRAN_FDD_NOF_HARQ> last_ttis;
 
   std::vector<dl_harq_proc> dl_harqs;
   std::vector<ul_harq_proc> ul_harqs;
+  size_t                    nof_reserved_dl_harqs = 0;
+
+  // Bitmaps of the HARQs with an active TB, kept by the HARQs themselves. The per TTI updates and the searches of
+  // pending retxs only visit the active HARQs
+  uint32_t dl_active_mask = 0;
+  uint32_t ul_active_mask = 0;
 };
 
 } // namespace srsenb
@@ -45,7 +45,10 @@ public:
   using base_type::get_bsr_state;
   using base_type::get_dl_prio_tx;
   using base_type::get_dl_tx;
+  using base_type::get_dl_tx_mbr_limited;
   using base_type::get_dl_tx_total;
+  using base_type::get_dl_qos_urgency;
+  using base_type::get_ul_qos_urgency;
   using base_type::is_bearer_active;
   using base_type::is_bearer_dl;
   using base_type::is_bearer_ul;
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_SPS_H
+#define SRSRAN_SCHED_SPS_H
+
+#include "sched_ue_cell.h"
+#include <bitset>
+
+namespace srsenb {
+
+/**
+ * Semi-persistent scheduling state of the PCell of a UE. It tracks the DL assignment and the UL grant that the UE
+ * uses periodically after their activation, until they are released (TS 36.321 Section 5.10). The carrier scheduler
+ * places the activations, occasions and releases in the subframe grid
+ */
+class sps_ue_manager
+{
+public:
+  enum class state_t { inactive, active, releasing };
+
+  explicit sps_ue_manager(uint16_t rnti_);
+
+  void                              set_cfg(const sched_interface::sps_cfg_t& cfg_);
+  const sched_interface::sps_cfg_t& get_cfg() const { return cfg; }
+  bool                              dl_configured() const { return cfg.dl_interval > 0; }
+  bool                              ul_configured() const { return cfg.ul_interval > 0; }
+  bool is_active() const { return dl_state != state_t::inactive or ul_state != state_t::inactive; }
+
+  /// DL SPS
+  state_t          get_dl_state() const { return dl_state; }
+  bool             is_dl_occasion(tti_point tti_tx_dl) const;
+  uint32_t         get_dl_pid(tti_point tti_tx_dl) const;
+  const rbgmask_t& get_dl_mask() const { return dl_mask; }
+  const tbs_info&  get_dl_tb() const { return dl_tb; }
+  void             dl_activated(tti_point tti_tx_dl, const rbgmask_t& mask, const tbs_info& tb);
+  void             dl_occasion(bool has_data);
+  void             dl_released();
+  bool             is_dl_sps_harq(uint32_t enb_cc_idx, uint32_t pid) const;
+  void             set_dl_sps_harq(uint32_t enb_cc_idx, uint32_t pid, bool is_sps);
+
+  /// UL SPS
+  state_t         get_ul_state() const { return ul_state; }
+  bool            is_ul_occasion(tti_point tti_tx_ul) const;
+  prb_interval    get_ul_alloc() const { return ul_alloc; }
+  const tbs_info& get_ul_tb() const { return ul_tb; }
+  void            ul_activated(tti_point tti_tx_ul, prb_interval alloc, const tbs_info& tb);
+  void            ul_occasion(bool has_data);
+  bool            is_ul_sps_harq(uint32_t enb_cc_idx, uint32_t pid) const;
+  void            set_ul_sps_harq(uint32_t enb_cc_idx, uint32_t pid, bool is_sps);
+
+  /// SPS C-RNTI of the pending retxs of the SPS HARQs, which outlive a reconfiguration of SPS or of the PCell
+  uint16_t get_harq_sps_crnti() const { return harq_sps_crnti; }
+
+private:
+  void reset();
+  void set_harq_cell(uint32_t enb_cc_idx);
+
+  uint16_t                   rnti;
+  srslog::basic_logger&      logger;
+  sched_interface::sps_cfg_t cfg            = {};
+  uint16_t                   harq_sps_crnti = SRSRAN_INVALID_RNTI;
+  uint32_t                   harq_cc_idx    = 0;
+
+  // DL SPS assignment
+  state_t                                         dl_state = state_t::inactive;
+  tti_point                                       dl_start_tti;
+  rbgmask_t                                       dl_mask;
+  tbs_info                                        dl_tb;
+  uint32_t                                        dl_empty_occasions = 0;
+  std::bitset<sched_ue_cell::SCHED_MAX_HARQ_PROC> dl_sps_harqs;
+
+  // UL SPS grant
+  state_t                                         ul_state = state_t::inactive;
+  tti_point                                       ul_start_tti;
+  prb_interval                                    ul_alloc;
+  tbs_info                                        ul_tb;
+  uint32_t                                        ul_empty_occasions = 0;
+  std::bitset<sched_ue_cell::SCHED_MAX_HARQ_PROC> ul_sps_harqs;
+};
+
+/**
+ * Find the contiguous RBGs and the MCS of a DL SPS assignment that fits req_bytes. The MCS is limited to the values
+ * that a SPS activation can signal
+ * @return false if there is no grant in the free RBGs of current_mask
+ */
+bool find_dl_sps_grant(const sched_ue_cell& cell,
+                       tti_point            tti_tx_dl,
+                       const rbgmask_t&     current_mask,
+                       uint32_t             req_bytes,
+                       rbgmask_t&           mask,
+                       tbs_info&            tb);
+
+/**
+ * Find the contiguous PRBs and the MCS of a UL SPS grant that fits req_bytes. The MCS is limited to the values that
+ * a SPS activation can signal
+ * @return false if there is no grant in the free PRBs of current_mask
+ */
+bool find_ul_sps_grant(const sched_ue_cell& cell,
+                       const prbmask_t&     current_mask,
+                       uint32_t             req_bytes,
+                       prb_interval&        alloc,
+                       tbs_info&            tb);
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_SPS_H
@@ -37,6 +37,8 @@ public:
 
   virtual void sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched) = 0;
   virtual void sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched) = 0;
+  /// Called when a UE is removed, for the policies that keep a per-UE history
+  virtual void rem_user(uint16_t rnti) {}
 
 protected:
   srslog::basic_logger& logger = srslog::fetch_basic_logger("MAC");
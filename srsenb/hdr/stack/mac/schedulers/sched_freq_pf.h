@@ -0,0 +1,58 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_FREQ_PF_H
+#define SRSRAN_SCHED_FREQ_PF_H
+
+#include "sched_time_pf.h"
+
+namespace srsenb {
+
+/**
+ * Frequency-domain proportional fair scheduler. The UEs keep the time-domain PF history and the UL allocation of
+ * sched_time_pf, but each free DL RBG is handed to the UE with the highest PF metric on that RBG. The metric of a UE
+ * on a RBG is the spectral efficiency of its subband CQI, weighted by the inverse of its average rate.
+ * UEs with contiguous DCI formats, and the ones whose metric allocation fails, are served greedily afterwards.
+ */
+class sched_freq_pf final : public sched_time_pf
+{
+public:
+  sched_freq_pf(const sched_cell_params_t&          cell_params_,
+                const sched_interface::sched_args_t& sched_args,
+                const sched_ue_active_list&          active_ues_);
+  void sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched) override;
+
+private:
+  void compute_dl_metrics(sched_ue_list& ue_db);
+  void assign_dl_rbgs(const rbgmask_t& dl_mask);
+
+  /// UEs with a new DL transmission, in PF priority order
+  std::vector<ue_ctxt*> dl_newtx_ues;
+  /// Metric matrix, one row of nof_rbgs per UE of dl_newtx_ues
+  std::vector<float> dl_metric;
+  /// RBGs still needed by each UE and the mask assigned to it
+  std::vector<uint32_t>  dl_pending_rbgs;
+  std::vector<rbgmask_t> dl_ue_mask;
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_FREQ_PF_H
@@ -29,25 +29,33 @@
 
 namespace srsenb {
 
-class sched_time_pf final : public sched_base
+class sched_time_pf : public sched_base
 {
   using ue_cit_t = sched_ue_list::const_iterator;
 
 public:
-  sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args);
+  sched_time_pf(const sched_cell_params_t&          cell_params_,
+                const sched_interface::sched_args_t& sched_args,
+                const sched_ue_active_list&          active_ues_);
   void sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched) override;
   void sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched) override;
+  void rem_user(uint16_t rnti) override;
 
-private:
+protected:
   void new_tti(sched_ue_list& ue_db, sf_sched* tti_sched);
 
-  const sched_cell_params_t* cc_cfg         = nullptr;
-  float                      fairness_coeff = 1;
+  const sched_cell_params_t*  cc_cfg         = nullptr;
+  const sched_ue_active_list* active_ues       = nullptr;
+  float                       fairness_coeff   = 1;
+  float                       qos_weight_coeff = 0; ///< Weight of the bearers QoS urgency in the PF priority
 
   srsran::tti_point current_tti_rx;
+  uint64_t          tti_count = 0; ///< Number of TTIs scheduled, it does not wrap-around as tti_point
 
   struct ue_ctxt {
-    ue_ctxt(uint16_t rnti_, float fairness_coeff_) : rnti(rnti_), fairness_coeff(fairness_coeff_) {}
+    ue_ctxt(uint16_t rnti_, float fairness_coeff_, float qos_weight_coeff_) :
+      rnti(rnti_), fairness_coeff(fairness_coeff_), qos_weight_coeff(qos_weight_coeff_)
+    {}
     float    dl_avg_rate() const { return dl_nof_samples == 0 ? 0 : dl_avg_rate_; }
     float    ul_avg_rate() const { return ul_nof_samples == 0 ? 0 : ul_avg_rate_; }
     uint32_t dl_count() const { return dl_nof_samples; }
@@ -55,9 +63,12 @@ private:
     void     new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched);
     void     save_dl_alloc(uint32_t alloc_bytes, float alpha);
     void     save_ul_alloc(uint32_t alloc_bytes, float alpha);
+    //! Age the averages with the TTIs the UE was not a candidate, as if nothing had been allocated in them
+    void     save_idle_ttis(uint32_t nof_ttis, float alpha);
 
     const uint16_t rnti;
     const float    fairness_coeff;
+    const float    qos_weight_coeff;
 
     int                 ue_cc_idx  = 0;
     float               dl_prio    = 0;
@@ -66,6 +77,8 @@ private:
     const dl_harq_proc* dl_newtx_h = nullptr;
     const ul_harq_proc* ul_h       = nullptr;
 
+    uint64_t last_tti_count = 0; ///< Last TTI the UE was a candidate
+
   private:
     float    dl_avg_rate_   = 0;
     float    ul_avg_rate_   = 0;
@@ -0,0 +1,45 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_TIME_QOS_H
+#define SRSRAN_SCHED_TIME_QOS_H
+
+#include "sched_time_pf.h"
+
+namespace srsenb {
+
+/**
+ * Time-domain PF scheduler whose UE priority is weighted by the QoS urgency of its bearers, i.e.
+ * prio = r / R^fairness_coeff * (1 + qos_weight_coeff * urgency). The urgency grows with the GBR deficit of the GBR
+ * bearers and with the fraction of the delay budget that the bearers with pending data have waited.
+ * The policy arguments are "<fairness_coeff>,<qos_weight_coeff>"
+ */
+class sched_time_qos final : public sched_time_pf
+{
+public:
+  sched_time_qos(const sched_cell_params_t&          cell_params_,
+                 const sched_interface::sched_args_t& sched_args,
+                 const sched_ue_active_list&          active_ues_);
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_TIME_QOS_H
@@ -24,8 +24,10 @@
 
 #include "common/mac_metrics.h"
 #include "sched_interface.h"
+#include "srsran/adt/accumulators.h"
 #include "srsran/adt/circular_array.h"
 #include "srsran/adt/circular_map.h"
+#include "srsran/adt/pool/batch_mem_pool.h"
 #include "srsran/adt/pool/pool_interface.h"
 #include "srsran/common/block_queue.h"
 #include "srsran/common/mac_pcap.h"
@@ -45,6 +47,37 @@ class rrc_interface_mac;
 class rlc_interface_mac;
 class phy_interface_stack_lte;
 
+/// Slabs of code block softbuffers, one per carrier, shared by the HARQ processes of all UEs. Code block buffers are
+/// handed out when a grant needs them and recycled on ACK/max-retx, so the memory follows the active traffic
+class softbuffer_cb_pool
+{
+public:
+  softbuffer_cb_pool(uint32_t nof_cells, uint32_t max_cb_size, uint32_t nof_cb_per_batch);
+
+  int16_t* allocate_rx_cb(uint32_t enb_cc_idx);
+  void     deallocate_rx_cb(uint32_t enb_cc_idx, int16_t* cb);
+  uint8_t* allocate_tx_cb(uint32_t enb_cc_idx);
+  void     deallocate_tx_cb(uint32_t enb_cc_idx, uint8_t* cb);
+
+private:
+  // Alignment of the code block buffers handed out, so the PHY can use aligned SIMD accesses
+  const static size_t cb_alignment = 64;
+
+  struct cell_slab {
+    std::mutex                     mutex;
+    srsran::growing_batch_mem_pool rx_pool;
+    srsran::growing_batch_mem_pool tx_pool;
+    cell_slab(size_t rx_node_size, size_t tx_node_size, size_t nof_cb_per_batch);
+  };
+
+  static size_t node_size(size_t cb_size) { return cb_size + cb_alignment + sizeof(void*); }
+  static void*  allocate_aligned(cell_slab& slab, srsran::growing_batch_mem_pool& pool);
+  static void   deallocate_aligned(cell_slab& slab, srsran::growing_batch_mem_pool& pool, void* cb);
+
+  const uint32_t                           max_cb_size;
+  std::vector<std::unique_ptr<cell_slab> > cells;
+};
+
 /// Class to manage the allocation, deallocation & access to UE carrier DL + UL softbuffers
 struct ue_cc_softbuffers {
   // List of Tx softbuffers for all HARQ processes of one carrier
@@ -57,16 +90,32 @@ struct ue_cc_softbuffers {
   cc_softbuffer_tx_list_t softbuffer_tx_list;
   cc_softbuffer_rx_list_t softbuffer_rx_list;
 
+  // Slab where the code block buffers are taken from
+  softbuffer_cb_pool* cb_pool    = nullptr;
+  uint32_t            enb_cc_idx = 0;
+
   ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_);
   ue_cc_softbuffers(ue_cc_softbuffers&&) noexcept = default;
   ~ue_cc_softbuffers();
   void clear();
+  void set_cb_pool(softbuffer_cb_pool* cb_pool_, uint32_t enb_cc_idx_);
+
+  /// Attaches the code block buffers required by a TB of tbs_bits and recycles the ones in excess
+  bool reserve_tx(uint32_t pid, uint32_t tb_idx, uint32_t tbs_bits);
+  bool reserve_rx(uint32_t tti, uint32_t tbs_bits);
+  /// Recycles all the code block buffers of a HARQ process
+  void release_tx(uint32_t pid, uint32_t tb_idx);
+  void release_rx(uint32_t tti);
 
   srsran_softbuffer_tx_t& get_tx(uint32_t pid, uint32_t tb_idx)
   {
     return softbuffer_tx_list.at(pid * SRSRAN_MAX_TB + tb_idx);
   }
   srsran_softbuffer_rx_t& get_rx(uint32_t tti) { return softbuffer_rx_list.at(tti % nof_rx_harq_proc); }
+
+private:
+  void set_nof_cb(srsran_softbuffer_tx_t& buffer, uint32_t nof_cb);
+  void set_nof_cb(srsran_softbuffer_rx_t& buffer, uint32_t nof_cb);
 };
 
 /// Class to manage the allocation, deallocation & access to pending UL HARQ buffers
@@ -102,7 +151,9 @@ public:
   ~cc_buffer_handler();
 
   void reset();
-  void allocate_cc(srsran::unique_pool_ptr<ue_cc_softbuffers> cc_softbuffers_);
+  void allocate_cc(srsran::unique_pool_ptr<ue_cc_softbuffers> cc_softbuffers_,
+                   softbuffer_cb_pool*                        cb_pool,
+                   uint32_t                                   enb_cc_idx);
   void deallocate_cc();
 
   bool                    empty() const { return cc_softbuffers == nullptr; }
@@ -111,6 +162,18 @@ public:
     return cc_softbuffers->get_tx(pid, tb_idx);
   }
   srsran_softbuffer_rx_t& get_rx_softbuffer(uint32_t tti) { return cc_softbuffers->get_rx(tti); }
+  bool                    reserve_tx_softbuffer(tti_point tti_tx_dl,
+                                                uint32_t  pid,
+                                                uint32_t  tb_idx,
+                                                uint32_t  tbs_bits,
+                                                bool      ndi);
+  bool                    reserve_rx_softbuffer(uint32_t tti, uint32_t tbs_bits, uint32_t current_tx_nb);
+  void                    release_tx_softbuffer(tti_point                          tti_rx,
+                                                uint32_t                           tb_idx,
+                                                bool                               ack,
+                                                uint32_t                           max_harq_tx,
+                                                const sched_interface::cell_cfg_t& cell_cfg);
+  void                    release_rx_softbuffer(uint32_t tti, bool crc, uint32_t max_harq_tx);
   srsran::byte_buffer_t*  get_tx_payload_buffer(size_t harq_pid, size_t tb)
   {
     return tx_payload_buffer[harq_pid][tb].get();
@@ -126,6 +189,12 @@ private:
 
   // One buffer per TB per DL HARQ process and per carrier is needed for each UE.
   std::array<std::array<srsran::unique_byte_buffer_t, SRSRAN_MAX_TB>, SRSRAN_FDD_NOF_HARQ> tx_payload_buffer;
+
+  // Last transmission of each HARQ process, to recycle its code block buffers on ACK/max-retx
+  std::array<tti_point, SRSRAN_FDD_NOF_HARQ>                           tx_harq_tti   = {};
+  std::array<std::array<bool, SRSRAN_MAX_TB>, SRSRAN_FDD_NOF_HARQ>     tx_harq_ndi   = {};
+  std::array<std::array<uint32_t, SRSRAN_MAX_TB>, SRSRAN_FDD_NOF_HARQ> tx_harq_tx_nb = {};
+  std::array<uint32_t, SRSRAN_FDD_NOF_HARQ>                            rx_harq_tx_nb = {};
 };
 
 class ue : public srsran::read_pdu_interface, public mac_ta_ue_interface
@@ -139,7 +208,8 @@ public:
      phy_interface_stack_lte*                 phy_,
      srslog::basic_logger&                    logger,
      uint32_t                                 nof_cells_,
-     srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool);
+     srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool,
+     softbuffer_cb_pool*                      cb_pool);
 
   virtual ~ue();
   void reset();
@@ -170,21 +240,33 @@ public:
 
   srsran_softbuffer_tx_t* get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx);
   srsran_softbuffer_rx_t* get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti);
+  bool                    reserve_tx_softbuffer(uint32_t enb_cc_idx,
+                                                uint32_t tti_tx_dl,
+                                                uint32_t harq_process,
+                                                uint32_t tb_idx,
+                                                uint32_t tbs,
+                                                bool     ndi);
+  bool reserve_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti, uint32_t tbs, uint32_t current_tx_nb);
+  void release_tx_softbuffer(uint32_t                           enb_cc_idx,
+                             uint32_t                           tti_rx,
+                             uint32_t                           tb_idx,
+                             bool                               ack,
+                             const sched_interface::cell_cfg_t& cell_cfg);
+  void release_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti_rx, bool crc);
 
   uint8_t* request_buffer(uint32_t tti, uint32_t enb_cc_idx, uint32_t len);
   void     process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint32_t grant_nof_prbs);
   srsran::unique_byte_buffer_t release_pdu(uint32_t tti, uint32_t enb_cc_idx);
   void                         clear_old_buffers(uint32_t tti);
 
-  std::mutex metrics_mutex = {};
-  void       metrics_read(mac_ue_metrics_t* metrics_);
-  void       metrics_rx(bool crc, uint32_t tbs);
-  void       metrics_tx(bool crc, uint32_t tbs);
-  void       metrics_phr(float phr);
-  void       metrics_dl_ri(uint32_t dl_cqi);
-  void       metrics_dl_pmi(uint32_t dl_cqi);
-  void       metrics_dl_cqi(uint32_t dl_cqi);
-  void       metrics_cnt();
+  void metrics_read(mac_ue_metrics_t* metrics_);
+  void metrics_rx(bool crc, uint32_t tbs);
+  void metrics_tx(bool crc, uint32_t tbs);
+  void metrics_phr(float phr);
+  void metrics_dl_ri(uint32_t dl_cqi);
+  void metrics_dl_pmi(uint32_t dl_cqi);
+  void metrics_dl_cqi(uint32_t dl_cqi);
+  void metrics_cnt();
 
   uint32_t read_pdu(uint32_t lcid, uint8_t* payload, uint32_t requested_bytes) final;
 
@@ -208,20 +290,39 @@ private:
 
   std::atomic<bool> active_state{true};
 
-  uint32_t         phr_counter    = 0;
-  uint32_t         dl_cqi_counter = 0;
-  uint32_t         dl_ri_counter  = 0;
-  uint32_t         dl_pmi_counter = 0;
-  mac_ue_metrics_t ue_metrics     = {};
+  // Metrics accumulated by the PHY workers and the stack thread, until they are read by the metrics thread
+  struct metrics_acc_t {
+    uint32_t nof_tti      = 0;
+    int      tx_pkts      = 0;
+    int      tx_errors    = 0;
+    int      tx_brate     = 0;
+    int      rx_pkts      = 0;
+    int      rx_errors    = 0;
+    int      rx_brate     = 0;
+    float    phr_sum      = 0;
+    uint32_t phr_count    = 0;
+    float    dl_cqi_sum   = 0;
+    uint32_t dl_cqi_count = 0;
+    float    dl_ri_sum    = 0;
+    uint32_t dl_ri_count  = 0;
+    float    dl_pmi_sum   = 0;
+    uint32_t dl_pmi_count = 0;
+
+    metrics_acc_t& operator+=(const metrics_acc_t& other);
+  };
+  srsran::snapshot_accumulator<metrics_acc_t> metrics_acc;
 
   srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool = nullptr;
+  softbuffer_cb_pool*                      cb_pool         = nullptr;
+  uint32_t                                 max_harq_tx     = 5; ///< Maximum number of DL and UL HARQ transmissions
 
   srsran::block_queue<uint32_t> pending_ta_commands;
   ta                            ta_fsm;
 
   // For UL there are multiple buffers per PID and are managed by pdu_queue
-  srsran::sch_pdu mac_msg_dl, mac_msg_ul;
-  srsran::mch_pdu mch_mac_msg_dl;
+  srsran::sch_pdu           mac_msg_dl, mac_msg_ul;
+  srsran::ul_sch_pdu_parser ul_pdu_parser;
+  srsran::mch_pdu           mch_mac_msg_dl;
 
   srsran::bounded_vector<cc_buffer_handler, SRSRAN_MAX_CARRIERS> cc_buffers;
 
@@ -75,6 +75,9 @@ public:
 
   void update_mac();
 
+  /// Asks the MAC whether the UE cell has room for the GBR of a new E-RAB. Non-GBR E-RABs are always admitted
+  bool admit_erab(const asn1::s1ap::erab_level_qos_params_s& qos);
+
 private:
   int  apply_basic_conn_cfg(const asn1::rrc::rr_cfg_ded_s& rr_cfg);
   void apply_current_bearers_cfg();
@@ -25,6 +25,7 @@
 #include "rrc_bearer_cfg.h"
 #include "rrc_cell_cfg.h"
 #include "rrc_metrics.h"
+#include "ue_rr_cfg.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsran/adt/circular_buffer.h"
@@ -185,6 +186,9 @@ private:
   // derived params
   std::unique_ptr<enb_cell_common_list> cell_common_list;
 
+  // RRCConnectionSetup encoding shared by all UEs, built with the first UE
+  rrc_conn_setup_template conn_setup_tmpl;
+
   // state
   std::unique_ptr<freq_res_common_list>    cell_res_list;
   std::map<uint16_t, unique_rnti_ptr<ue> > users; // NOTE: has to have fixed addr
@@ -126,6 +126,8 @@ public:
 
   const std::map<uint8_t, erab_t>&        get_erabs() const { return erabs; }
   const asn1::rrc::drb_to_add_mod_list_l& get_established_drbs() const { return current_drbs; }
+  /// Returns the first E-RAB whose QCI has SPS enabled, or nullptr if there is none
+  const erab_t* find_sps_erab() const;
 
   std::map<uint8_t, std::vector<uint8_t> > erab_info_list;
   std::map<uint8_t, erab_t>                erabs;
@@ -171,6 +171,16 @@ public:
   const uint16_t* get_n_pucch_cs() const { return n_pucch_cs_present ? &n_pucch_cs_idx : nullptr; }
   bool            is_pucch_cs_allocated() const { return n_pucch_cs_present; }
 
+  /// SPS C-RNTI and persistent HARQ-ACK PUCCH resource of the PCell
+  struct sps_res_t {
+    uint16_t sps_crnti   = SRSRAN_INVALID_RNTI;
+    uint16_t n1_pucch_an = 0;
+  };
+
+  const sps_res_t* get_sps_res() const { return sps_res_present ? &sps_res : nullptr; }
+  bool             alloc_sps_resources(uint16_t sps_crnti);
+  bool             dealloc_sps_resources();
+
 private:
   bool alloc_cell_resources(uint32_t ue_cc_idx);
   bool alloc_cqi_resources(uint32_t ue_cc_idx, uint32_t period);
@@ -189,8 +199,10 @@ private:
   std::vector<ue_cell_ded> cell_list;
   bool                     sr_res_present     = false;
   bool                     n_pucch_cs_present = false;
+  bool                     sps_res_present    = false;
   sr_res_t                 sr_res             = {};
   uint16_t                 n_pucch_cs_idx     = 0;
+  sps_res_t                sps_res            = {};
 };
 
 } // namespace srsenb
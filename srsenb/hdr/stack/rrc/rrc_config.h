@@ -27,6 +27,7 @@
 #include "srsran/common/security.h"
 #include "srsran/interfaces/enb_rrc_interface_types.h"
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/upper/codel.h"
 #include <array>
 
 namespace srsenb {
@@ -39,12 +40,23 @@ struct rrc_cfg_sr_t {
   uint32_t                                                   nof_subframes;
 };
 
+/// Semi-persistent scheduling of the bearers of a QCI. An interval of 0 disables SPS in that direction
+struct rrc_cfg_sps_t {
+  bool     enabled                = false;
+  uint32_t dl_interval            = 0; ///< semiPersistSchedIntervalDL in subframes
+  uint32_t ul_interval            = 0; ///< semiPersistSchedIntervalUL in subframes
+  uint32_t dl_nof_harq            = 1; ///< numberOfConfSPS-Processes
+  uint32_t implicit_release_after = 2; ///< implicitReleaseAfter, in empty SPS transmissions
+};
+
 struct rrc_cfg_qci_t {
   bool                                          configured            = false;
   int                                           enb_dl_max_retx_thres = -1;
+  srsran::codel_config_t                        enb_dl_aqm;
   asn1::rrc::lc_ch_cfg_s::ul_specific_params_s_ lc_cfg;
   asn1::rrc::pdcp_cfg_s                         pdcp_cfg;
   asn1::rrc::rlc_cfg_c                          rlc_cfg;
+  rrc_cfg_sps_t                                 sps;
 };
 
 struct srb_cfg_t {
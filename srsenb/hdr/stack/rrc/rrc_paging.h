@@ -78,6 +78,9 @@ private:
     tti_point                    tti_tx_dl;
     asn1::rrc::pcch_msg_s        pcch_msg;
     srsran::unique_byte_buffer_t pdu;
+    /// Bit positions in "pdu" of the paging record list length field and of the end of the last packed record
+    uint32_t list_len_bit_offset = 0;
+    uint32_t records_end_bit     = 0;
 
     bool is_tx() const { return tti_tx_dl.is_valid(); }
     bool empty() const { return pdu == nullptr; }
@@ -86,11 +89,17 @@ private:
       tti_tx_dl = tti_point();
       pcch_msg.msg.c1().paging().paging_record_list.clear();
       pdu.reset();
+      list_len_bit_offset = 0;
+      records_end_bit     = 0;
     }
   };
   const static size_t nof_paging_subframes = 4;
+  /// Number of bits of the PagingRecordList length field, i.e. ceil(log2(ASN1_RRC_MAX_PAGE_REC))
+  const static uint32_t record_list_len_bits = 4;
 
   bool add_paging_record(uint32_t ueid, const asn1::rrc::paging_record_s& paging_record);
+  bool pack_pcch(pcch_info& pcch);
+  bool pack_paging_record(pcch_info& pcch, const asn1::rrc::paging_record_s& paging_record);
 
   static int get_sf_idx_key(uint32_t sf_idx)
   {
@@ -188,17 +197,65 @@ bool paging_manager::add_paging_record(uint32_t ueid, const asn1::rrc::paging_re
 
   record_list.push_back(paging_record);
 
-  asn1::bit_ref bref(pending_pcch.pdu->msg, pending_pcch.pdu->get_tailroom());
-  if (pending_pcch.pcch_msg.pack(bref) == asn1::SRSASN_ERROR_ENCODE_FAIL) {
+  // During paging storms many records target the same PO. Rather than re-packing the whole PCCH message for every
+  // new record, the record is appended to the already encoded list
+  bool ret = record_list.size() == 1 ? pack_pcch(pending_pcch) : pack_paging_record(pending_pcch, paging_record);
+  if (not ret) {
     logger.error("Failed to pack PCCH message");
     pending_pcch.clear();
     return false;
   }
-  pending_pcch.pdu->N_bytes = (uint32_t)bref.distance_bytes();
 
   return true;
 }
 
+/// Packs the full PCCH message and records the positions required to append paging records later on
+bool paging_manager::pack_pcch(pcch_info& pcch)
+{
+  asn1::bit_ref bref(pcch.pdu->msg, pcch.pdu->get_tailroom());
+  if (pcch.pcch_msg.msg.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  pcch.records_end_bit = (uint32_t)bref.distance();
+  bref.align_bytes_zero();
+  pcch.pdu->N_bytes = (uint32_t)bref.distance_bytes();
+
+  // The record list length field precedes the first record
+  uint8_t       rec_buf[32];
+  asn1::bit_ref rec_bref(rec_buf, sizeof(rec_buf));
+  if (pcch.pcch_msg.msg.c1().paging().paging_record_list[0].pack(rec_bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  pcch.list_len_bit_offset = pcch.records_end_bit - (uint32_t)rec_bref.distance() - record_list_len_bits;
+  return true;
+}
+
+/// Appends the UPER encoding of a paging record to an already packed PCCH message and updates its list length
+bool paging_manager::pack_paging_record(pcch_info& pcch, const asn1::rrc::paging_record_s& paging_record)
+{
+  asn1::bit_ref bref(pcch.pdu->msg, pcch.pdu->get_tailroom());
+  if (bref.advance_bits(pcch.records_end_bit) != asn1::SRSASN_SUCCESS or
+      paging_record.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  pcch.records_end_bit = (uint32_t)bref.distance();
+  bref.align_bytes_zero();
+  pcch.pdu->N_bytes = (uint32_t)bref.distance_bytes();
+
+  // Overwrite the record list length field in place, which is encoded as (size - 1) with the list lower bound of 1
+  uint32_t len_field = (uint32_t)pcch.pcch_msg.msg.c1().paging().paging_record_list.size() - 1;
+  for (uint32_t i = 0; i < record_list_len_bits; ++i) {
+    uint32_t bit_pos = pcch.list_len_bit_offset + i;
+    uint8_t  mask    = 0x80u >> (bit_pos % 8u);
+    if ((len_field >> (record_list_len_bits - 1 - i)) & 1u) {
+      pcch.pdu->msg[bit_pos / 8] |= mask;
+    } else {
+      pcch.pdu->msg[bit_pos / 8] &= ~mask;
+    }
+  }
+  return true;
+}
+
 size_t paging_manager::pending_pcch_bytes(tti_point tti_tx_dl)
 {
   int sf_key = get_sf_idx_key(tti_tx_dl.sf_idx());
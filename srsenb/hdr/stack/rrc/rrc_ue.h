@@ -150,9 +150,11 @@ public:
 
   /**
    * Sends the CCCH message to the underlying layer and optionally encodes it as an octet string if a valid string
-   * pointer is passed.
+   * pointer is passed. The message is packed unless an already encoded pdu is passed.
    */
-  void send_dl_ccch(asn1::rrc::dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str = nullptr);
+  void send_dl_ccch(asn1::rrc::dl_ccch_msg_s*    dl_ccch_msg,
+                    std::string*                 octet_str   = nullptr,
+                    srsran::unique_byte_buffer_t encoded_pdu = srsran::unique_byte_buffer_t());
 
   /**
    * Sends the DCCH message to the underlying layer and optionally encodes it as an octet string if a valid string
@@ -226,6 +228,7 @@ private:
 
   /// Helper to fill cell_ded_list with SCells provided in the eNB config
   void update_scells();
+  void update_sps();
 
   ///< UE's Physical layer dedicated configuration
   phy_interface_rrc_lte::phy_rrc_cfg_list_t phy_rrc_dedicated_list = {};
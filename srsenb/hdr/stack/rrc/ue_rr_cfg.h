@@ -44,7 +44,9 @@
 #define SRSENB_UE_RR_CFG_H
 
 #include "srsran/asn1/rrc.h"
+#include "srsran/common/byte_buffer.h"
 #include "srsran/interfaces/rrc_interface_types.h"
+#include <vector>
 
 namespace srsenb {
 
@@ -58,6 +60,37 @@ int fill_rr_cfg_ded_setup(asn1::rrc::rr_cfg_ded_s& rr_cfg,
                           const rrc_cfg_t&         enb_cfg,
                           const ue_cell_ded_list&  ue_cell_list);
 
+/**
+ * Encoded DL-CCCH RRCConnectionSetup, which is the same for all the UEs of the eNB except for the transaction id and the
+ * SR/CQI PUCCH resources. These fields have a fixed size in PER, so they are written at their bit offset in a copy of
+ * the encoded template instead of packing the whole message for every UE.
+ */
+class rrc_conn_setup_template
+{
+public:
+  /// Encodes the template from a message filled by fill_rr_cfg_ded_setup. If the UE fields cannot be located in the
+  /// encoded message, the template is not valid and pack() fails
+  bool init(const asn1::rrc::dl_ccch_msg_s& msg);
+  bool is_init() const { return initiated; }
+  bool is_valid() const { return valid; }
+
+  /// Writes the encoding of msg in pdu. msg has to be filled by fill_rr_cfg_ded_setup with the eNB config of init()
+  bool pack(const asn1::rrc::dl_ccch_msg_s& msg, srsran::byte_buffer_t& pdu) const;
+
+private:
+  struct field_offset {
+    uint32_t field_idx;
+    uint32_t bit_offset;
+  };
+
+  bool patch(const asn1::rrc::dl_ccch_msg_s& msg, srsran::byte_buffer_t& pdu) const;
+
+  bool                      initiated = false;
+  bool                      valid     = false;
+  std::vector<uint8_t>      encoded;
+  std::vector<field_offset> ue_fields;
+};
+
 /// Apply Reconf updates and update current state
 int apply_reconf_updates(asn1::rrc::rrc_conn_recfg_r8_ies_s&  recfg_r8,
                          ue_var_cfg_t&                        current_ue_cfg,
@@ -154,6 +154,9 @@ private:
 
   asn1::s1ap::s1_setup_resp_s s1setupresponse;
 
+  // Memory of the members of the last received PDU, so that decoding does not call malloc
+  asn1::decode_arena rx_pdu_arena;
+
   void build_tai_cgi();
   bool connect_mme();
   bool setup_s1();
@@ -33,16 +33,13 @@
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
+#include "srsran/upper/gtpu.h"
 
 #include <netinet/in.h>
 
 #ifndef SRSENB_GTPU_H
 #define SRSENB_GTPU_H
 
-namespace srsran {
-struct gtpu_header_t;
-}
-
 namespace srsenb {
 
 class pdcp_interface_gtpu;
@@ -69,6 +66,8 @@ public:
     uint32_t teid_out      = 0;
     uint32_t spgw_addr     = 0;
 
+    srsran::gtpu_gpdu_header_template_t gpdu_hdr = {}; ///< G-PDU header without extension headers
+
     tunnel_state                                    state = tunnel_state::pdcp_active;
     srsran::unique_timer                            rx_timer;
     srsran::byte_buffer_pool_ptr<buffered_sdu_list> buffer;
@@ -169,6 +168,9 @@ public:
   void handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
   void handle_gtpu_m1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
 
+  /// Sends the UL PDUs written by PDCP since the last call with a single sendmmsg(). Called once per TTI
+  void flush_ul_pdus();
+
 private:
   static const int GTPU_PORT = 2152;
 
@@ -219,7 +221,26 @@ private:
   // Socket file descriptor
   int fd = -1;
 
-  void send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buffer_t pdu, int pdcp_sn = -1);
+  // Additional S1U sockets, each read by its own socket_manager thread
+  std::vector<int>                                     extra_rx_fds;
+  std::vector<std::unique_ptr<srsran::socket_manager>> extra_rx_socket_handlers;
+
+  int open_s1u_socket();
+
+  // UL PDUs to the SPGW waiting for the next flush. The batch is also flushed when full
+  static const uint32_t MAX_UL_TX_BATCH = 64;
+  struct ul_tx_pdu_t {
+    srsran::unique_byte_buffer_t pdu;
+    sockaddr_in                  addr;
+  };
+  srsran::bounded_vector<ul_tx_pdu_t, MAX_UL_TX_BATCH> ul_tx_batch;
+  // The UL PDUs of a burst toward the same SPGW are sent as UDP GSO messages, if supported by the kernel
+  bool ul_gso = false;
+
+  void send_pdu_to_tunnel(const gtpu_tunnel&           tx_tun,
+                          srsran::unique_byte_buffer_t pdu,
+                          int                          pdcp_sn = -1,
+                          bool                         batched = false);
 
   void echo_response(in_addr_t addr, in_port_t port, uint16_t seq);
   void error_indication(in_addr_t addr, in_port_t port, uint32_t err_teid);
@@ -70,11 +70,14 @@ public:
   void reestablish(uint16_t rnti) override;
 
   // pdcp_interface_gtpu
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override;
+  std::vector<srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override;
 
   // Metrics
   void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
 
+  // Cipher the DL PDUs of the DRBs of the users added from now on in the crypto workers
+  void set_tx_crypto_offload(bool enable) { tx_crypto_offload = enable; }
+
 private:
   class user_interface_rlc : public srsue::rlc_interface_pdcp
   {
@@ -132,6 +135,7 @@ private:
   gtpu_interface_pdcp*      gtpu = nullptr;
   srsran::task_sched_handle task_sched;
   srslog::basic_logger&     logger;
+  bool                      tx_crypto_offload = false;
 };
 
 } // namespace srsenb
@@ -0,0 +1,232 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_UP_THREAD_ADAPTERS_H
+#define SRSRAN_UP_THREAD_ADAPTERS_H
+
+#include "srsran/common/task_scheduler.h"
+#include "srsran/interfaces/enb_gtpu_interfaces.h"
+#include "srsran/interfaces/enb_pdcp_interfaces.h"
+#include "srsran/interfaces/enb_rrc_interface_pdcp.h"
+#include "srsran/srslog/logger.h"
+#include <future>
+
+/*
+ * When the eNB stack runs PDCP and GTPU in a dedicated user-plane thread, the RRC and the RLC reach them through
+ * the adapters below, and vice versa. Calls are turned into tasks for the thread that owns the layer, so that
+ * neither plane runs code of the other one.
+ */
+
+namespace srsenb {
+
+/// Hands tasks over to the thread that serves a task queue
+class task_queue_forwarder
+{
+public:
+  explicit task_queue_forwarder(srsran::task_queue_handle queue_) : queue(std::move(queue_)) {}
+
+  /// Enqueues the task. Tasks posted through the same forwarder run in the order they were posted
+  void post(srsran::move_task_t task) { queue.push(std::move(task)); }
+
+  /// Enqueues the task without blocking, returns false if the queue is full
+  bool try_post(srsran::move_task_t task) { return queue.try_push(std::move(task)).has_value(); }
+
+  /// Runs the task in the thread of the queue and waits for it to finish
+  void run_blocking(srsran::move_task_t task)
+  {
+    std::promise<void> done;
+    queue.push([&task, &done]() {
+      task();
+      done.set_value();
+    });
+    done.get_future().wait();
+  }
+
+private:
+  srsran::task_queue_handle queue;
+};
+
+/// PDCP as seen from the RRC and the RLC. Bearer configuration, SDUs and PDUs are forwarded in call order. Only the
+/// bearer state accessors, used in handover, wait for the user-plane thread
+class pdcp_up_adapter final : public pdcp_interface_rrc, public pdcp_interface_rlc
+{
+public:
+  pdcp_up_adapter(pdcp_interface_rrc* pdcp_rrc_, pdcp_interface_rlc* pdcp_rlc_, task_queue_forwarder& up_) :
+    pdcp_rrc(pdcp_rrc_), pdcp_rlc(pdcp_rlc_), up(&up_)
+  {}
+
+  // pdcp_interface_rrc
+  void set_enabled(uint16_t rnti, uint32_t lcid, bool enable) override
+  {
+    up->post([this, rnti, lcid, enable]() { pdcp_rrc->set_enabled(rnti, lcid, enable); });
+  }
+  void reset(uint16_t rnti) override
+  {
+    up->post([this, rnti]() { pdcp_rrc->reset(rnti); });
+  }
+  void add_user(uint16_t rnti) override
+  {
+    up->post([this, rnti]() { pdcp_rrc->add_user(rnti); });
+  }
+  void rem_user(uint16_t rnti) override
+  {
+    up->post([this, rnti]() { pdcp_rrc->rem_user(rnti); });
+  }
+  void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn = -1) override
+  {
+    up->post([this, rnti, lcid, pdcp_sn, sdu = std::move(sdu)]() mutable {
+      pdcp_rrc->write_sdu(rnti, lcid, std::move(sdu), pdcp_sn);
+    });
+  }
+  void add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cnfg) override
+  {
+    up->post([this, rnti, lcid, cnfg]() { pdcp_rrc->add_bearer(rnti, lcid, cnfg); });
+  }
+  void del_bearer(uint16_t rnti, uint32_t lcid) override
+  {
+    up->post([this, rnti, lcid]() { pdcp_rrc->del_bearer(rnti, lcid); });
+  }
+  void config_security(uint16_t rnti, uint32_t lcid, const srsran::as_security_config_t& sec_cfg) override
+  {
+    up->post([this, rnti, lcid, sec_cfg]() { pdcp_rrc->config_security(rnti, lcid, sec_cfg); });
+  }
+  void enable_integrity(uint16_t rnti, uint32_t lcid) override
+  {
+    up->post([this, rnti, lcid]() { pdcp_rrc->enable_integrity(rnti, lcid); });
+  }
+  void enable_encryption(uint16_t rnti, uint32_t lcid) override
+  {
+    up->post([this, rnti, lcid]() { pdcp_rrc->enable_encryption(rnti, lcid); });
+  }
+  void send_status_report(uint16_t rnti) override
+  {
+    up->post([this, rnti]() { pdcp_rrc->send_status_report(rnti); });
+  }
+  void send_status_report(uint16_t rnti, uint32_t lcid) override
+  {
+    up->post([this, rnti, lcid]() { pdcp_rrc->send_status_report(rnti, lcid); });
+  }
+  bool get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state_t* state) override
+  {
+    bool ret = false;
+    up->run_blocking([this, rnti, lcid, state, &ret]() { ret = pdcp_rrc->get_bearer_state(rnti, lcid, state); });
+    return ret;
+  }
+  bool set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte_state_t& state) override
+  {
+    bool ret = false;
+    up->run_blocking([this, rnti, lcid, &state, &ret]() { ret = pdcp_rrc->set_bearer_state(rnti, lcid, state); });
+    return ret;
+  }
+  void reestablish(uint16_t rnti) override
+  {
+    up->post([this, rnti]() { pdcp_rrc->reestablish(rnti); });
+  }
+
+  // pdcp_interface_rlc
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override
+  {
+    up->post([this, rnti, lcid, pdu = std::move(pdu)]() mutable { pdcp_rlc->write_pdu(rnti, lcid, std::move(pdu)); });
+  }
+  void notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) override
+  {
+    up->post([this, rnti, lcid, pdcp_sns]() { pdcp_rlc->notify_delivery(rnti, lcid, pdcp_sns); });
+  }
+  void notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) override
+  {
+    up->post([this, rnti, lcid, pdcp_sns]() { pdcp_rlc->notify_failure(rnti, lcid, pdcp_sns); });
+  }
+
+private:
+  pdcp_interface_rrc*   pdcp_rrc = nullptr;
+  pdcp_interface_rlc*   pdcp_rlc = nullptr;
+  task_queue_forwarder* up       = nullptr;
+};
+
+/// GTPU as seen from the RRC. Only the tunnel setup, which returns the allocated TEID, waits for the user-plane thread
+class gtpu_up_adapter final : public gtpu_interface_rrc
+{
+public:
+  gtpu_up_adapter(gtpu_interface_rrc* gtpu_, task_queue_forwarder& up_) : gtpu_obj(gtpu_), up(&up_) {}
+
+  srsran::expected<uint32_t> add_bearer(uint16_t            rnti,
+                                        uint32_t            eps_bearer_id,
+                                        uint32_t            addr,
+                                        uint32_t            teid_out,
+                                        uint32_t&           addr_in,
+                                        const bearer_props* props = nullptr) override
+  {
+    srsran::expected<uint32_t> ret;
+    up->run_blocking([&]() { ret = gtpu_obj->add_bearer(rnti, eps_bearer_id, addr, teid_out, addr_in, props); });
+    return ret;
+  }
+  void set_tunnel_status(uint32_t teidin, bool dl_active) override
+  {
+    up->post([this, teidin, dl_active]() { gtpu_obj->set_tunnel_status(teidin, dl_active); });
+  }
+  void rem_bearer(uint16_t rnti, uint32_t eps_bearer_id) override
+  {
+    up->post([this, rnti, eps_bearer_id]() { gtpu_obj->rem_bearer(rnti, eps_bearer_id); });
+  }
+  void mod_bearer_rnti(uint16_t old_rnti, uint16_t new_rnti) override
+  {
+    up->post([this, old_rnti, new_rnti]() { gtpu_obj->mod_bearer_rnti(old_rnti, new_rnti); });
+  }
+  void rem_user(uint16_t rnti) override
+  {
+    up->post([this, rnti]() { gtpu_obj->rem_user(rnti); });
+  }
+
+private:
+  gtpu_interface_rrc*   gtpu_obj = nullptr;
+  task_queue_forwarder* up       = nullptr;
+};
+
+/// RRC as seen from the PDCP. The RRC already queues the PDUs internally, the integrity failures are forwarded to the
+/// control thread
+class rrc_up_adapter final : public rrc_interface_pdcp
+{
+public:
+  rrc_up_adapter(rrc_interface_pdcp* rrc_, task_queue_forwarder& ctrl_, srslog::basic_logger& logger_) :
+    rrc_obj(rrc_), ctrl(&ctrl_), logger(logger_)
+  {}
+
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override
+  {
+    rrc_obj->write_pdu(rnti, lcid, std::move(pdu));
+  }
+  void notify_pdcp_integrity_error(uint16_t rnti, uint32_t lcid) override
+  {
+    // Never block the user-plane thread on the control thread, which may be waiting for it
+    if (not ctrl->try_post([this, rnti, lcid]() { rrc_obj->notify_pdcp_integrity_error(rnti, lcid); })) {
+      logger.warning("Couldn't forward PDCP integrity failure to RRC, rnti=0x%x, lcid=%d", rnti, lcid);
+    }
+  }
+
+private:
+  rrc_interface_pdcp*   rrc_obj = nullptr;
+  task_queue_forwarder* ctrl    = nullptr;
+  srslog::basic_logger& logger;
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_UP_THREAD_ADAPTERS_H
@@ -133,7 +133,7 @@ public:
     }
     nr_stack->write_sdu(rnti, lcid, std::move(sdu), pdcp_sn);
   }
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override
+  std::vector<srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override
   {
     if (nr_stack == nullptr) {
       return {};
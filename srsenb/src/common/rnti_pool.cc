@@ -56,5 +56,9 @@ void deallocate_rnti_dedicated_mem(uint16_t rnti, void* ptr)
 {
   get_rnti_pool()->deallocate(rnti, ptr);
 }
+srsran::pool_metrics_t get_rnti_pool_metrics()
+{
+  return get_rnti_pool()->get_metrics("rnti_mem");
+}
 
 } // namespace srsenb
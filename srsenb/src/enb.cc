@@ -20,12 +20,15 @@
  */
 
 #include "srsenb/hdr/enb.h"
+#include "srsenb/hdr/common/rnti_pool.h"
 #include "srsenb/hdr/stack/enb_stack_lte.h"
 #include "srsenb/hdr/x2_adapter.h"
 #include "srsenb/src/enb_cfg_parser.h"
 #include "srsgnb/hdr/stack/gnb_stack_nr.h"
+#include "srsgnb/hdr/stack/mac/harq_softbuffer.h"
 #include "srsran/build_info.h"
 #include "srsran/common/enb_events.h"
+#include "srsran/rlc/bearer_mem_pool.h"
 #include "srsran/radio/radio_null.h"
 #include <iostream>
 
@@ -64,7 +67,7 @@ int enb::init(const all_args_t& args_)
   std::unique_ptr<enb_stack_lte> tmp_eutra_stack;
   if (not rrc_cfg.cell_list.empty()) {
     // add EUTRA stack
-    tmp_eutra_stack.reset(new enb_stack_lte(log_sink));
+    tmp_eutra_stack.reset(new enb_stack_lte(log_sink, args.stack.up_thread));
     if (tmp_eutra_stack == nullptr) {
       srsran::console("Error creating EUTRA stack.\n");
       return SRSRAN_ERROR;
@@ -212,12 +215,21 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   radio->get_metrics(&m->rf);
   phy->get_metrics(m->phy);
+  phy->get_timing_metrics(m->phy_timing);
   if (eutra_stack) {
     eutra_stack->get_metrics(&m->stack);
   }
   if (nr_stack) {
     nr_stack->get_metrics(&m->nr_stack);
   }
+  m->pools.clear();
+  srsran::get_byte_buffer_pool_metrics(m->pools);
+  m->pools.push_back(srsran::get_rlc_bearer_pool_metrics());
+  m->pools.push_back(get_rnti_pool_metrics());
+  if (eutra_stack) {
+    m->pools.push_back(m->stack.mac.softbuffer_pool);
+  }
+  harq_softbuffer_pool::get_instance().get_metrics(m->pools);
   m->running = true;
   m->sys     = sys_proc.get_metrics();
   return true;
@@ -763,6 +763,39 @@ int field_srb::parse(libconfig::Setting& root)
   return 0;
 }
 
+/// Parses the optional SPS section of a QCI. The intervals and implicitReleaseAfter take the values of SPS-Config
+static int parse_qci_sps(libconfig::Setting& root, rrc_cfg_sps_t& sps)
+{
+  sps_cfg_dl_c::setup_s_::semi_persist_sched_interv_dl_e_ dl_interv;
+  sps_cfg_ul_c::setup_s_::semi_persist_sched_interv_ul_e_ ul_interv;
+  sps_cfg_ul_c::setup_s_::implicit_release_after_e_       implicit_release;
+
+  root.lookupValue("dl_interval", sps.dl_interval);
+  root.lookupValue("ul_interval", sps.ul_interval);
+  root.lookupValue("dl_nof_harq", sps.dl_nof_harq);
+  root.lookupValue("implicit_release_after", sps.implicit_release_after);
+  if (sps.dl_interval > 0 and not asn1::number_to_enum(dl_interv, (uint16_t)sps.dl_interval)) {
+    fprintf(stderr, "Invalid SPS dl_interval=%d\n", sps.dl_interval);
+    return SRSRAN_ERROR;
+  }
+  // The sub-frame UL intervals of Rel-14 are not supported
+  bool valid_ul_interv = sps.ul_interval >= 10 and asn1::number_to_enum(ul_interv, (uint16_t)sps.ul_interval);
+  if (sps.ul_interval > 0 and not valid_ul_interv) {
+    fprintf(stderr, "Invalid SPS ul_interval=%d\n", sps.ul_interval);
+    return SRSRAN_ERROR;
+  }
+  if (sps.dl_nof_harq < 1 or sps.dl_nof_harq > 8) {
+    fprintf(stderr, "Invalid SPS dl_nof_harq=%d\n", sps.dl_nof_harq);
+    return SRSRAN_ERROR;
+  }
+  if (not asn1::number_to_enum(implicit_release, (uint8_t)sps.implicit_release_after)) {
+    fprintf(stderr, "Invalid SPS implicit_release_after=%d\n", sps.implicit_release_after);
+    return SRSRAN_ERROR;
+  }
+  sps.enabled = sps.dl_interval > 0 or sps.ul_interval > 0;
+  return SRSRAN_SUCCESS;
+}
+
 int field_qci::parse(libconfig::Setting& root)
 {
   auto nof_qci = (uint32_t)root.getLength();
@@ -790,7 +823,22 @@ int field_qci::parse(libconfig::Setting& root)
 
     qcicfg.pdcp_cfg.rlc_am_present =
         q["pdcp_config"].lookupValue("status_report_required", qcicfg.pdcp_cfg.rlc_am.status_report_required);
-    qcicfg.pdcp_cfg.hdr_compress.set(pdcp_cfg_s::hdr_compress_c_::types::not_used);
+
+    // ROHC is enabled with the RTP/UDP and UDP profiles when the number of contexts is set
+    uint32_t rohc_max_cid = 0;
+    if (q["pdcp_config"].lookupValue("rohc_max_cid", rohc_max_cid)) {
+      if (rohc_max_cid < 1 or rohc_max_cid > 15) {
+        fprintf(stderr, "Invalid rohc_max_cid=%d for qci=%d. Valid values are 1..15\n", rohc_max_cid, qci);
+        return SRSRAN_ERROR;
+      }
+      pdcp_cfg_s::hdr_compress_c_::rohc_s_& rohc = qcicfg.pdcp_cfg.hdr_compress.set_rohc();
+      rohc.max_cid_present                         = true;
+      rohc.max_cid                                 = rohc_max_cid;
+      rohc.profiles.profile0x0001                  = true;
+      rohc.profiles.profile0x0002                  = true;
+    } else {
+      qcicfg.pdcp_cfg.hdr_compress.set(pdcp_cfg_s::hdr_compress_c_::types::not_used);
+    }
 
     // Parse RLC section
     rlc_cfg_c* rlc_cfg = &qcicfg.rlc_cfg;
@@ -924,6 +972,24 @@ int field_qci::parse(libconfig::Setting& root)
 
     if (q.exists("enb_specific")) {
       qcicfg.enb_dl_max_retx_thres = (int)q["enb_specific"]["dl_max_retx_thresh"];
+
+      // CoDel is enabled on the DL RLC SDU queue of the bearer when the target delay is set
+      srsran::codel_config_t& aqm = qcicfg.enb_dl_aqm;
+      aqm.enabled                 = q["enb_specific"].lookupValue("dl_codel_target_ms", aqm.target_ms);
+      q["enb_specific"].lookupValue("dl_codel_interval_ms", aqm.interval_ms);
+      if (aqm.enabled and (aqm.target_ms == 0 or aqm.interval_ms <= aqm.target_ms)) {
+        fprintf(stderr,
+                "Invalid dl_codel_target_ms=%d/dl_codel_interval_ms=%d for qci=%d\n",
+                aqm.target_ms,
+                aqm.interval_ms,
+                qci);
+        return SRSRAN_ERROR;
+      }
+    }
+
+    if (q.exists("sps_config") and parse_qci_sps(q["sps_config"], qcicfg.sps) != SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error parsing sps_config for qci=%d\n", qci);
+      return SRSRAN_ERROR;
     }
 
     cfg.insert(std::make_pair(qci, qcicfg));
@@ -1711,18 +1777,21 @@ int parse_cell_cfg(all_args_t* args_, srsran_cell_t* cell)
 // Parse the relevant CFR configuration params
 int parse_cfr_args(all_args_t* args, srsran_cfr_cfg_t* cfr_config)
 {
-  cfr_config->cfr_enable  = args->phy.cfr_args.enable;
-  cfr_config->cfr_mode    = args->phy.cfr_args.mode;
-  cfr_config->alpha       = args->phy.cfr_args.strength;
-  cfr_config->manual_thr  = args->phy.cfr_args.manual_thres;
-  cfr_config->max_papr_db = args->phy.cfr_args.auto_target_papr;
-  cfr_config->ema_alpha   = args->phy.cfr_args.ema_alpha;
+  cfr_config->cfr_enable   = args->phy.cfr_args.enable;
+  cfr_config->cfr_mode     = args->phy.cfr_args.mode;
+  cfr_config->alpha        = args->phy.cfr_args.strength;
+  cfr_config->manual_thr   = args->phy.cfr_args.manual_thres;
+  cfr_config->max_papr_db  = args->phy.cfr_args.auto_target_papr;
+  cfr_config->ema_alpha    = args->phy.cfr_args.ema_alpha;
+  cfr_config->algo         = args->phy.cfr_args.algo;
+  cfr_config->pc_pulse_len = args->phy.cfr_args.pulse_len;
 
   if (!srsran_cfr_params_valid(cfr_config)) {
     fprintf(stderr,
-            "Invalid CFR parameters: cfr_mode=%d, alpha=%.2f, manual_thr=%.2f, \n "
+            "Invalid CFR parameters: cfr_mode=%d, algo=%d, alpha=%.2f, manual_thr=%.2f, \n "
             "max_papr_db=%.2f, ema_alpha=%.2f\n",
             cfr_config->cfr_mode,
+            cfr_config->algo,
             cfr_config->alpha,
             cfr_config->manual_thr,
             cfr_config->max_papr_db,
@@ -1867,6 +1936,10 @@ int set_derived_args(all_args_t* args_, rrc_cfg_t* rrc_cfg_, phy_cfg_t* phy_cfg_
                    "mac.nof_prealloc_ues=%d must be within [0, %d]",
                    args_->stack.mac.nof_prealloc_ues,
                    SRSENB_MAX_UES);
+  ASSERT_VALID_CFG(args_->stack.mac.max_nof_ues > 0 and args_->stack.mac.max_nof_ues <= SRSENB_MAX_UES,
+                   "mac.max_nof_ues=%d must be within [1, %d], build with a larger ENB_MAX_UES for more UEs",
+                   args_->stack.mac.max_nof_ues,
+                   SRSENB_MAX_UES);
 
   // Check for a forced  DL EARFCN or frequency (only valid for a single cell config
   if (rrc_cfg_->cell_list.size() > 0) {
@@ -2096,9 +2169,10 @@ int set_derived_args(all_args_t* args_, rrc_cfg_t* rrc_cfg_, phy_cfg_t* phy_cfg_
   rrc_cfg_->max_mac_ul_kos       = args_->general.max_mac_ul_kos;
   rrc_cfg_->rlf_release_timer_ms = args_->general.rlf_release_timer_ms;
 
-  // Set sync queue capacity to 1 for ZMQ
-  if (args_->rf.device_name == "zmq") {
-    srslog::fetch_basic_logger("ENB").info("Using sync queue size of one for ZMQ based radio.");
+  // Set sync queue capacity to 1 for ZMQ, shared memory and IQ files
+  if (args_->rf.device_name == "zmq" || args_->rf.device_name == "shm" || args_->rf.device_name == "iq") {
+    srslog::fetch_basic_logger("ENB").info("Using sync queue size of one for %s based radio.",
+                                           args_->rf.device_name.c_str());
     args_->stack.sync_queue_size = 1;
   } else {
     // use default size
@@ -2132,6 +2206,7 @@ int set_derived_args_nr(all_args_t* args_, rrc_nr_cfg_t* rrc_nr_cfg_, phy_cfg_t*
   }
 
   rrc_nr_cfg_->inactivity_timeout_ms = args_->general.rrc_inactivity_timer;
+  rrc_nr_cfg_->nof_pack_workers      = args_->general.nr_rrc_pack_workers;
 
   // Create NR dedicated cell configuration from RRC configuration
   for (auto& cfg : rrc_nr_cfg_->cell_list) {
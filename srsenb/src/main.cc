@@ -28,8 +28,12 @@
 
 #include "srsran/common/common_helper.h"
 #include "srsran/common/config_file.h"
+#include "srsran/common/pkt_trace.h"
 #include "srsran/common/crash_handler.h"
+#include "srsran/common/thread_affinity.h"
 #include "srsran/common/tsan_options.h"
+#include "srsran/common/tti_trace.h"
+#include "srsran/phy/utils/vector.h"
 #include "srsran/srslog/event_trace.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/support/emergency_handlers.h"
@@ -43,6 +47,7 @@
 #include <string>
 
 #include "srsenb/hdr/enb.h"
+#include "srsenb/hdr/metrics_binary.h"
 #include "srsenb/hdr/metrics_csv.h"
 #include "srsenb/hdr/metrics_json.h"
 #include "srsenb/hdr/metrics_stdout.h"
@@ -66,6 +71,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string mnc;
   string enb_id;
   string cfr_mode;
+  string cfr_algo;
   bool   use_standard_lte_rates = false;
 
   // Command line only options
@@ -112,6 +118,10 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("rf.device_name",       bpo::value<string>(&args->rf.device_name)->default_value("auto"),       "Front-end device name")
     ("rf.device_args",       bpo::value<string>(&args->rf.device_args)->default_value("auto"),       "Front-end device arguments")
     ("rf.time_adv_nsamples", bpo::value<string>(&args->rf.time_adv_nsamples)->default_value("auto"), "Transmission time advance")
+    ("rf.rx_dc_correction",  bpo::value<bool>(&args->rf.rx_dc_correction)->default_value(false),     "Remove the receiver DC offset on the host")
+    ("rf.rx_iq_correction",  bpo::value<bool>(&args->rf.rx_iq_correction)->default_value(false),     "Compensate the receiver IQ imbalance on the host")
+    ("rf.rx_digital_agc",    bpo::value<bool>(&args->rf.rx_digital_agc)->default_value(false),       "Fast digital gain control of the received samples on the host")
+    ("rf.tx_coalesce",       bpo::value<uint32_t>(&args->rf.tx_coalesce_max_sf)->default_value(0),   "Maximum number of consecutive subframes sent together to the radio, 0 disables it")
 
     ("gui.enable",        bpo::value<bool>(&args->gui.enable)->default_value(false),          "Enable GUI plots")
 
@@ -140,10 +150,14 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     ("log.filename",      bpo::value<string>(&args->log.filename)->default_value("/tmp/ue.log"),"Log filename")
     ("log.file_max_size", bpo::value<int>(&args->log.file_max_size)->default_value(-1), "Maximum file size (in kilobytes). When passed, multiple files are created. Default -1 (single file)")
+    ("log.file_async",    bpo::value<bool>(&args->log.file_async)->default_value(false), "Write the log file from a helper thread, so that large log volumes do not stall the logging backend")
+    ("log.file_rotation_period", bpo::value<int>(&args->log.file_rotation_period)->default_value(0), "Period (in seconds) after which a new log file is created when file_async is set. Default 0 (no time-based rotation)")
 
     /* PCAP */
     ("pcap.enable",    bpo::value<bool>(&args->stack.mac_pcap.enable)->default_value(false),         "Enable MAC packet captures for wireshark")
     ("pcap.filename",  bpo::value<string>(&args->stack.mac_pcap.filename)->default_value("/tmp/enb_mac.pcap"), "MAC layer capture filename")
+    ("pcap.snaplen",   bpo::value<uint32_t>(&args->stack.mac_pcap.snaplen)->default_value(0),            "Maximum bytes captured per MAC PDU, 0 captures the whole PDUs")
+    ("pcap.sampling",  bpo::value<uint32_t>(&args->stack.mac_pcap.sampling)->default_value(1),           "Capture one MAC PDU of every N PDUs")
     ("pcap.nr_filename",  bpo::value<string>(&args->nr_stack.mac.pcap.filename)->default_value("/tmp/enb_mac_nr.pcap"), "NR MAC layer capture filename")
     ("pcap.s1ap_enable",   bpo::value<bool>(&args->stack.s1ap_pcap.enable)->default_value(false),         "Enable S1AP packet captures for wireshark")
     ("pcap.s1ap_filename", bpo::value<string>(&args->stack.s1ap_pcap.filename)->default_value("/tmp/enb_s1ap.pcap"), "S1AP layer capture filename")
@@ -154,9 +168,10 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("pcap.bind_port", bpo::value<uint16_t>(&args->stack.mac_pcap_net.bind_port)->default_value(5687),        "Bind port for MAC network trace")
     ("pcap.client_ip", bpo::value<string>(&args->stack.mac_pcap_net.client_ip)->default_value("127.0.0.1"),     "Client IP address for MAC network trace")
     ("pcap.client_port", bpo::value<uint16_t>(&args->stack.mac_pcap_net.client_port)->default_value(5847),    "Enable MAC network captures")
+    ("pcap.sched_filename", bpo::value<string>(&args->stack.mac.sched_record_filename)->default_value(""), "Records the MAC scheduler inputs to this file for their offline replay, empty disables it")
 
     /* Scheduling section */
-    ("scheduler.policy", bpo::value<string>(&args->stack.mac.sched.sched_policy)->default_value("time_pf"), "DL and UL data scheduling policy (E.g. time_rr, time_pf)")
+    ("scheduler.policy", bpo::value<string>(&args->stack.mac.sched.sched_policy)->default_value("time_pf"), "DL and UL data scheduling policy (E.g. time_rr, time_pf, freq_pf, time_qos)")
     ("scheduler.policy_args", bpo::value<string>(&args->stack.mac.sched.sched_policy_args)->default_value("2"), "Scheduler policy-specific arguments")
     ("scheduler.pdsch_mcs", bpo::value<int>(&args->stack.mac.sched.pdsch_mcs)->default_value(-1), "Optional fixed PDSCH MCS (ignores reported CQIs if specified)")
     ("scheduler.pdsch_max_mcs", bpo::value<int>(&args->stack.mac.sched.pdsch_max_mcs)->default_value(-1), "Optional PDSCH MCS limit")
@@ -180,11 +195,17 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.init_dl_cqi", bpo::value<int>(&args->stack.mac.sched.init_dl_cqi)->default_value(5), "DL CQI value used before any CQI report is available to the eNB")
     ("scheduler.max_sib_coderate", bpo::value<float>(&args->stack.mac.sched.max_sib_coderate)->default_value(0.8), "Upper bound on SIB and RAR grants coderate")
     ("scheduler.pdcch_cqi_offset", bpo::value<int>(&args->stack.mac.sched.pdcch_cqi_offset)->default_value(0), "CQI offset in derivation of PDCCH aggregation level")
+    ("scheduler.nof_cc_workers", bpo::value<uint32_t>(&args->stack.mac.sched.nof_cc_workers)->default_value(0), "Number of helper threads scheduling the carriers concurrently (0 for sequential)")
+    ("scheduler.gbr_max_load", bpo::value<float>(&args->stack.mac.sched.gbr_max_load)->default_value(0.8), "Fraction of the cell peak rate that the GBR bearers can reserve (0 disables the GBR admission control)")
+    ("scheduler.ul_presched_max_bytes", bpo::value<uint32_t>(&args->stack.mac.sched.ul_presched_max_bytes)->default_value(0), "Maximum size of the UL grants allocated before the SR of periodic UL traffic (0 disables the UL pre-scheduling)")
+    ("scheduler.ul_presched_max_misses", bpo::value<uint32_t>(&args->stack.mac.sched.ul_presched_max_misses)->default_value(2), "Consecutive unused pre-scheduled UL grants before the UL pre-scheduling of a UE backs off")
+    ("scheduler.sched_thread", bpo::value<bool>(&args->stack.mac.sched_thread)->default_value(false), "Schedule each TTI in a dedicated MAC thread as soon as its UL feedback is complete")
 
 
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),               "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_threads",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_threads)->default_value(0),          "Number of fading and delay worker threads, 0 for none")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),          "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),         "Target SNR in dB")
     ("channel.dl.fading.enable",     bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false),        "Enable/Disable Fading model")
@@ -204,6 +225,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_threads",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_threads)->default_value(0),             "Number of fading and delay worker threads, 0 for none")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Received signal power in decibels full scale (dBfs)")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
@@ -225,6 +247,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     /* CFR section */
     ("cfr.enable", bpo::value<bool>(&args->phy.cfr_args.enable)->default_value(args->phy.cfr_args.enable), "CFR enable")
     ("cfr.mode", bpo::value<string>(&cfr_mode)->default_value("manual"), "CFR mode")
+    ("cfr.algo", bpo::value<string>(&cfr_algo)->default_value("clip_filter"), "CFR algorithm: clip_filter or peak_cancel")
+    ("cfr.pulse_len", bpo::value<uint32_t>(&args->phy.cfr_args.pulse_len)->default_value(args->phy.cfr_args.pulse_len), "Half length of the peak cancellation pulse in samples, 0 uses the whole OFDM symbol")
+    ("cfr.nof_threads", bpo::value<uint32_t>(&args->phy.cfr_args.nof_threads)->default_value(args->phy.cfr_args.nof_threads), "Number of helper threads per carrier generating the antenna ports in parallel (0 disables it)")
     ("cfr.manual_thres", bpo::value<float>(&args->phy.cfr_args.manual_thres)->default_value(args->phy.cfr_args.manual_thres), "Fixed manual clipping threshold for CFR manual mode")
     ("cfr.strength", bpo::value<float>(&args->phy.cfr_args.strength)->default_value(args->phy.cfr_args.strength), "CFR ratio between amplitude-limited vs original signal (0 to 1)")
     ("cfr.auto_target_papr", bpo::value<float>(&args->phy.cfr_args.auto_target_papr)->default_value(args->phy.cfr_args.auto_target_papr), "Signal PAPR target (in dB) in CFR auto modes")
@@ -234,12 +259,29 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.metrics_period_secs", bpo::value<float>(&args->general.metrics_period_secs)->default_value(1.0), "Periodicity for metrics in seconds.")
     ("expert.metrics_csv_enable",  bpo::value<bool>(&args->general.metrics_csv_enable)->default_value(false), "Write metrics to CSV file.")
     ("expert.metrics_csv_filename", bpo::value<string>(&args->general.metrics_csv_filename)->default_value("/tmp/enb_metrics.csv"), "Metrics CSV filename.")
+    ("expert.metrics_udp_addr", bpo::value<string>(&args->general.metrics_udp_addr)->default_value("127.0.0.1"), "Destination address of the binary metrics datagrams.")
+    ("expert.metrics_udp_port", bpo::value<int>(&args->general.metrics_udp_port)->default_value(0), "Destination port of the binary metrics datagrams (0 disables them).")
+    ("expert.metrics_http_addr", bpo::value<string>(&args->general.metrics_http_addr)->default_value("0.0.0.0"), "Bind address of the Prometheus metrics HTTP endpoint.")
+    ("expert.metrics_http_port", bpo::value<int>(&args->general.metrics_http_port)->default_value(0), "Port of the Prometheus metrics HTTP endpoint (0 disables it).")
     ("expert.pusch_max_its", bpo::value<uint32_t>(&args->phy.pusch_max_its)->default_value(8), "Maximum number of turbo decoder iterations for LTE.")
     ("expert.pusch_8bit_decoder", bpo::value<bool>(&args->phy.pusch_8bit_decoder)->default_value(false), "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental).")
+    ("expert.pusch_cb_workers", bpo::value<uint32_t>(&args->phy.pusch_cb_workers)->default_value(0), "Number of helper threads per carrier for decoding PUSCH code blocks in parallel (0 disables it).")
+    ("expert.pusch_ue_workers", bpo::value<uint32_t>(&args->phy.pusch_ue_workers)->default_value(0), "Number of helper threads per carrier for decoding the PUSCH of different UEs in parallel (0 disables it).")
+    ("expert.pusch_early_stop", bpo::value<bool>(&args->phy.pusch_early_stop)->default_value(false), "Stop decoding PUSCH code blocks whose hard decisions do not change between iterations.")
+    ("expert.pusch_deadline_us", bpo::value<uint32_t>(&args->phy.pusch_deadline_us)->default_value(0), "UL processing time in microseconds after which the remaining PUSCH of the subframe are decoded with half of the turbo decoder iterations (0 disables it).")
+    ("expert.pusch_wiener", bpo::value<bool>(&args->phy.pusch_wiener)->default_value(false), "Smooth the PUSCH channel estimates with a Wiener filter selected by the measured SNR instead of the 3-tap filter.")
+    ("expert.dl_pipeline", bpo::value<bool>(&args->phy.dl_pipeline)->default_value(false), "Encode the PDSCH in a helper thread of each PHY worker while the MAC schedules the UL.")
+    ("expert.dl_sparse_tx", bpo::value<bool>(&args->phy.dl_sparse_tx)->default_value(false), "Only run the IFFT of the DL symbols carrying more than CRS, the CRS-only symbols are precomputed.")
+    ("expert.phy_task_stealing", bpo::value<bool>(&args->phy.phy_task_stealing)->default_value(false), "Let the idle PHY workers decode and encode the carriers of a busy subframe.")
+    ("expert.rf_rx_ring_size", bpo::value<uint32_t>(&args->phy.rf_rx_ring_sz)->default_value(0), "Number of subframes a dedicated RF thread can receive ahead of the TX/RX thread, 0 receives in the TX/RX thread.")
+    ("expert.iq_tap_enable", bpo::value<bool>(&args->phy.iq_tap_enable)->default_value(false), "Capture the RX and TX subframes of the LTE carriers.")
+    ("expert.iq_tap_filename", bpo::value<string>(&args->phy.iq_tap_filename)->default_value("/tmp/enb_iq.bin"), "IQ capture filename, the subframe index is written to <filename>.csv.")
+    ("expert.iq_tap_ring_size", bpo::value<uint32_t>(&args->phy.iq_tap_ring_sz)->default_value(256), "Number of captured subframe buffers waiting to be written.")
+    ("expert.use_hugepages", bpo::value<bool>(&args->phy.use_hugepages)->default_value(false), "Back the PHY buffers with transparent huge pages, placed on the NUMA node of the allocating thread.")
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
-    ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
+    ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. With 0, PRACH is detected in the receive thread.")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
     ("expert.estimator_fil_w", bpo::value<float>(&args->phy.estimator_fil_w)->default_value(0.1), "Chooses the coefficients for the 3-tap channel estimator centered filter.")
@@ -252,16 +294,25 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.tracing_enable",  bpo::value<bool>(&args->general.tracing_enable)->default_value(false), "Events tracing.")
     ("expert.tracing_filename", bpo::value<string>(&args->general.tracing_filename)->default_value("/tmp/enb_tracing.log"), "Tracing events filename.")
     ("expert.tracing_buffcapacity", bpo::value<std::size_t>(&args->general.tracing_buffcapacity)->default_value(1000000), "Tracing buffer capcity.")
+    ("expert.tti_trace_enable",  bpo::value<bool>(&args->general.tti_trace_enable)->default_value(false), "Record the timing of the PHY, MAC and radio calls of each TTI.")
+    ("expert.tti_trace_filename", bpo::value<string>(&args->general.tti_trace_filename)->default_value("/tmp/enb_tti_trace.json"), "TTI trace filename, written at exit in the Chrome trace event format.")
+    ("expert.tti_trace_records", bpo::value<std::size_t>(&args->general.tti_trace_records)->default_value(100000), "Number of TTI trace records kept per thread.")
+    ("expert.pkt_trace_period", bpo::value<uint32_t>(&args->general.pkt_trace_period)->default_value(0), "Trace the layer latencies of 1 in every N DL packets (0 to disable).")
     ("expert.stdout_ts_enable", bpo::value<bool>(&stdout_ts_enable)->default_value(false), "Prints once per second the timestamp into stdout.")
     ("expert.rrc_inactivity_timer", bpo::value<uint32_t>(&args->general.rrc_inactivity_timer)->default_value(30000), "Inactivity timer in ms.")
+    ("expert.nr_rrc_pack_workers", bpo::value<uint32_t>(&args->general.nr_rrc_pack_workers)->default_value(0), "Number of threads that pack the NR RRC DL-DCCH messages (0 to pack them in the stack thread).")
     ("expert.print_buffer_state", bpo::value<bool>(&args->general.print_buffer_state)->default_value(false), "Prints on the console the buffer state every 10 seconds.")
     ("expert.eea_pref_list", bpo::value<string>(&args->general.eea_pref_list)->default_value("EEA0, EEA2, EEA1"), "Ordered preference list for the selection of encryption algorithm (EEA) (default: EEA0, EEA2, EEA1).")
     ("expert.eia_pref_list", bpo::value<string>(&args->general.eia_pref_list)->default_value("EIA2, EIA1, EIA0"), "Ordered preference list for the selection of integrity algorithm (EIA) (default: EIA2, EIA1, EIA0).")
     ("expert.nof_prealloc_ues", bpo::value<uint32_t>(&args->stack.mac.nof_prealloc_ues)->default_value(8), "Number of UE resources to preallocate during eNB initialization.")
+    ("expert.max_nof_ues", bpo::value<uint32_t>(&args->stack.mac.max_nof_ues)->default_value(SRSENB_MAX_UES), "Maximum number of connected UEs, up to the size of the UE tables set at build time.")
     ("expert.lcid_padding", bpo::value<int>(&args->stack.mac.lcid_padding)->default_value(3), "LCID on which to put MAC padding")
     ("expert.max_mac_dl_kos", bpo::value<uint32_t>(&args->general.max_mac_dl_kos)->default_value(100), "Maximum number of consecutive KOs in DL before triggering the UE's release (default 100).")
     ("expert.max_mac_ul_kos", bpo::value<uint32_t>(&args->general.max_mac_ul_kos)->default_value(100), "Maximum number of consecutive KOs in UL before triggering the UE's release (default 100).")
     ("expert.gtpu_tunnel_timeout", bpo::value<uint32_t>(&args->stack.gtpu_indirect_tunnel_timeout_msec)->default_value(0), "Maximum time that GTPU takes to release indirect forwarding tunnel since the last received GTPU PDU (0 for infinity).")
+    ("expert.gtpu_nof_rx_sockets", bpo::value<uint32_t>(&args->stack.gtpu_nof_rx_sockets)->default_value(1), "Number of S1U sockets, each one read by its own thread, that receive the GTPU PDUs from the core.")
+    ("expert.pdcp_nof_crypto_workers", bpo::value<uint32_t>(&args->stack.pdcp_nof_crypto_workers)->default_value(0), "Number of threads that cipher the PDCP PDUs of the DRBs (0 to cipher them in the stack thread).")
+    ("expert.stack_up_thread", bpo::value<bool>(&args->stack.up_thread)->default_value(false), "Run PDCP and GTPU in a dedicated user-plane thread, apart from RRC, S1AP and MAC control tasks.")
     ("expert.rlf_release_timer_ms", bpo::value<uint32_t>(&args->general.rlf_release_timer_ms)->default_value(4000), "Time taken by eNB to release UE context after it detects an RLF.")
     ("expert.extended_cp", bpo::value<bool>(&args->phy.extended_cp)->default_value(false), "Use extended cyclic prefix")
     ("expert.ts1_reloc_prep_timeout", bpo::value<uint32_t>(&args->stack.s1ap.ts1_reloc_prep_timeout)->default_value(10000), "S1AP TS 36.413 TS1RelocPrep Expiry Timeout value in milliseconds.")
@@ -286,9 +337,34 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_mu_mimo", bpo::value<bool>(&args->nr_stack.mac.sched_cfg.mu_mimo_enabled)->default_value(false), "Co-schedule rank 1 NR UEs with low-correlation PMIs on the same PRBs and different DMRS ports.")
+    ("scheduler.nr_policy", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy)->default_value("time_rr"), "NR scheduler policy (time_rr or time_pf).")
+    ("scheduler.nr_policy_args", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy_args)->default_value("1"), "NR scheduler policy arguments (fairness coefficient of time_pf).")
+    ("scheduler.nr_ul_presched_max_bytes", bpo::value<uint32_t>(&args->nr_stack.mac.sched_cfg.ul_presched_max_bytes)->default_value(0), "Maximum size of the NR UL grants allocated before the SR of periodic UL traffic (0 disables the UL pre-scheduling)")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
+    ("expert.nr_pusch_cb_workers", bpo::value<uint32_t>(&args->phy.nr_pusch_cb_workers)->default_value(0), "Number of helper threads per NR PHY worker that decode PUSCH code blocks in parallel.")
+    ("expert.nr_dl_early_symbols", bpo::value<bool>(&args->phy.nr_dl_early_symbols)->default_value(false), "Modulate the NR DL symbols before the first PDSCH symbol in a helper thread while the PDSCH is encoded.")
   ;
 
+  // Affinity section, the CPU cores and NUMA node of each class of real-time threads
+  const std::vector<srsran::thread_class_t> affinity_classes = {srsran::thread_class_t::txrx,
+                                                                srsran::thread_class_t::phy_worker,
+                                                                srsran::thread_class_t::prach_worker,
+                                                                srsran::thread_class_t::stack,
+                                                                srsran::thread_class_t::gtpu,
+                                                                srsran::thread_class_t::log};
+  std::vector<string>                       affinity_cores(affinity_classes.size());
+  std::vector<int>                          affinity_numa_node(affinity_classes.size());
+  std::vector<uint32_t>                     affinity_spin_us(affinity_classes.size());
+  for (uint32_t i = 0; i < affinity_classes.size(); i++) {
+    string name = srsran::to_string(affinity_classes[i]);
+    common.add_options()
+      (("affinity." + name + "_cores").c_str(), bpo::value<string>(&affinity_cores[i])->default_value(""), ("CPU cores of the " + name + " threads, e.g. 2-5,8. Empty leaves them to the kernel.").c_str())
+      (("affinity." + name + "_numa_node").c_str(), bpo::value<int>(&affinity_numa_node[i])->default_value(-1), ("NUMA node the " + name + " threads allocate their memory from (-1 for the default policy).").c_str())
+      (("affinity." + name + "_spin_us").c_str(), bpo::value<uint32_t>(&affinity_spin_us[i])->default_value(0), ("Time in microseconds the " + name + " threads busy-poll a handoff before sleeping (0 to sleep at once).").c_str())
+    ;
+  }
+
   // Positional options - config file location
   bpo::options_description position("Positional options");
   position.add_options()
@@ -374,14 +450,6 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     }
   }
 
-  // Check PRACH workers
-  if (args->phy.nof_prach_threads > 1) {
-    fprintf(stderr,
-            "nof_prach_workers = %d. Value is not supported, only 0 or 1 are allowed\n",
-            args->phy.nof_prach_threads);
-    exit(1);
-  }
-
   // Convert eNB Id
   std::size_t pos = {};
   try {
@@ -402,6 +470,33 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     exit(1);
   }
 
+  // parse the CFR algorithm string
+  args->phy.cfr_args.algo = srsran_cfr_str2algo(cfr_algo.c_str());
+  if (args->phy.cfr_args.algo == SRSRAN_CFR_ALGO_INVALID) {
+    cout << "Error, invalid CFR algorithm: " << cfr_algo << endl;
+    exit(1);
+  }
+
+  // Configure the placement of the real-time threads
+  for (uint32_t i = 0; i < affinity_classes.size(); i++) {
+    if (affinity_numa_node[i] >= srsran::max_nof_numa_nodes) {
+      cout << "Error, invalid affinity." << srsran::to_string(affinity_classes[i]) << "_numa_node: "
+           << affinity_numa_node[i] << ". Valid nodes are 0 to " << srsran::max_nof_numa_nodes - 1
+           << ", or -1 for the default policy" << endl;
+      exit(1);
+    }
+    if (!srsran::set_thread_affinity(
+            affinity_classes[i], affinity_cores[i], affinity_numa_node[i], affinity_spin_us[i])) {
+      cout << "Error parsing affinity." << srsran::to_string(affinity_classes[i]) << "_cores: " << affinity_cores[i]
+           << endl;
+      exit(1);
+    }
+  }
+
+  if (!srsran_vec_set_hugepages(args->phy.use_hugepages)) {
+    cout << "Warning, huge pages are not supported on this platform" << endl;
+  }
+
   // Apply all_level to any unset layers
   if (vm.count("log.all_level")) {
     if (!vm.count("log.rf_level")) {
@@ -614,10 +709,17 @@ int main(int argc, char* argv[])
   parse_args(&args, argc, argv);
 
   // Setup the default log sink.
-  srslog::set_default_sink(
-      (args.log.filename == "stdout")
-          ? srslog::fetch_stdout_sink()
-          : srslog::fetch_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+  if (args.log.filename == "stdout") {
+    srslog::set_default_sink(srslog::fetch_stdout_sink());
+  } else if (args.log.file_async) {
+    srslog::set_default_sink(
+        srslog::fetch_async_file_sink(args.log.filename,
+                                      fixup_log_file_maxsize(args.log.file_max_size),
+                                      std::chrono::seconds(std::max(args.log.file_rotation_period, 0))));
+  } else {
+    srslog::set_default_sink(
+        srslog::fetch_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+  }
 
   // Alarms log channel creation.
   srslog::sink&        alarm_sink     = srslog::fetch_file_sink(args.general.alarms_filename, 0, true);
@@ -632,8 +734,16 @@ int main(int argc, char* argv[])
   }
 #endif
 
-  // Start the log backend.
-  srslog::init();
+  if (args.general.tti_trace_enable) {
+    srsran::tti_trace_init(args.general.tti_trace_records);
+  }
+  srsran::pkt_trace_set_period(args.general.pkt_trace_period);
+
+  // Start the log backend, its thread inherits the placement of the log class.
+  {
+    srsran::scoped_thread_affinity log_affinity(srsran::thread_class_t::log);
+    srslog::init();
+  }
 
   srslog::fetch_basic_logger("ALL").set_level(srslog::basic_levels::warning);
   srslog::fetch_basic_logger("POOL").set_level(srslog::basic_levels::warning);
@@ -681,6 +791,18 @@ int main(int argc, char* argv[])
     metricshub.add_listener(&json_metrics);
   }
 
+  srsenb::metrics_binary binary_metrics;
+  if (args.general.metrics_udp_port != 0 or args.general.metrics_http_port != 0) {
+    if (binary_metrics.init(args.general.metrics_udp_addr,
+                            args.general.metrics_udp_port,
+                            args.general.metrics_http_addr,
+                            args.general.metrics_http_port)) {
+      metricshub.add_listener(&binary_metrics);
+    } else {
+      srsran::console("Error opening the binary metrics exporter\n");
+    }
+  }
+
   // create input thread
   std::thread input(&input_loop, &metrics_screen, (enb_command_interface*)enb.get());
 
@@ -714,6 +836,9 @@ int main(int argc, char* argv[])
   input.join();
   metricshub.stop();
   enb->stop();
+  if (args.general.tti_trace_enable and not srsran::tti_trace_write_chrome_json(args.general.tti_trace_filename)) {
+    srsran::console("Error writing the TTI trace to %s\n", args.general.tti_trace_filename.c_str());
+  }
   cout << "---  exiting  ---" << endl;
 
   return SRSRAN_SUCCESS;
@@ -0,0 +1,345 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/metrics_binary.h"
+#include "srsran/srslog/bundled/fmt/format.h"
+#include "srsran/support/srsran_assert.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace srsenb;
+
+namespace {
+
+/// Writes little-endian fields in a pre-sized buffer.
+class le_writer
+{
+public:
+  explicit le_writer(uint8_t* ptr_) : ptr(ptr_) {}
+
+  void u8(uint8_t v) { *ptr++ = v; }
+  void u16(uint16_t v)
+  {
+    u8(v & 0xff);
+    u8(v >> 8);
+  }
+  void u32(uint32_t v)
+  {
+    u16(v & 0xffff);
+    u16(v >> 16);
+  }
+  void u64(uint64_t v)
+  {
+    u32(v & 0xffffffff);
+    u32(v >> 32);
+  }
+  void f32(float v)
+  {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    u32(bits);
+  }
+  // The MAC counters are signed, but never negative
+  void cnt(int v) { u32(static_cast<uint32_t>(std::max(0, v))); }
+
+private:
+  uint8_t* ptr;
+};
+
+/// Appends the line of one sample to the Prometheus text, skipping the values that were not measured.
+template <typename T>
+void append_sample(fmt::memory_buffer& buf, const char* name, uint16_t rnti, uint32_t pci, T value)
+{
+  if (std::isnan(static_cast<double>(value))) {
+    return;
+  }
+  fmt::format_to(buf, "{}{{rnti=\"0x{:x}\",pci=\"{}\"}} {}\n", name, rnti, pci, value);
+}
+
+} // namespace
+
+constexpr uint32_t metrics_binary::magic;
+constexpr uint16_t metrics_binary::version;
+constexpr uint32_t metrics_binary::header_len;
+constexpr uint32_t metrics_binary::cell_len;
+constexpr uint32_t metrics_binary::ue_len;
+constexpr uint32_t metrics_binary::max_datagram;
+constexpr uint32_t metrics_binary::max_nof_chunks;
+
+metrics_binary::~metrics_binary()
+{
+  stop();
+}
+
+bool metrics_binary::init(const std::string& udp_addr, int udp_port, const std::string& http_addr, int http_port)
+{
+  if (udp_port != 0) {
+    if (not udp_sock.open_socket(srsran::net_utils::addr_family::ipv4,
+                                 srsran::net_utils::socket_type::datagram,
+                                 srsran::net_utils::protocol_type::UDP) or
+        not udp_sock.connect_to(udp_addr.c_str(), udp_port)) {
+      udp_sock.close();
+      return false;
+    }
+  }
+  if (http_port != 0) {
+    if (not http_sock.open_socket(srsran::net_utils::addr_family::ipv4,
+                                  srsran::net_utils::socket_type::stream,
+                                  srsran::net_utils::protocol_type::TCP) or
+        not http_sock.reuse_addr() or not http_sock.bind_addr(http_addr.c_str(), http_port) or
+        not http_sock.start_listen()) {
+      http_sock.close();
+      udp_sock.close();
+      return false;
+    }
+    running     = true;
+    http_thread = std::thread([this]() { run_http(); });
+  }
+  return true;
+}
+
+void metrics_binary::stop()
+{
+  running = false;
+  if (http_thread.joinable()) {
+    http_thread.join();
+  }
+  if (http_sock.is_open()) {
+    http_sock.close();
+  }
+  if (udp_sock.is_open()) {
+    udp_sock.close();
+  }
+}
+
+void metrics_binary::set_metrics(const enb_metrics_t& m, const uint32_t period_usec)
+{
+  if (udp_sock.is_open()) {
+    auto     tp           = std::chrono::system_clock::now().time_since_epoch();
+    uint64_t timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(tp).count();
+    serialize(m, period_usec, seq++, timestamp_us, datagrams);
+    for (const auto& d : datagrams) {
+      // A lost period is not retransmitted, the collector detects it from the sequence number
+      send(udp_sock.fd(), d.data(), d.size(), MSG_DONTWAIT);
+    }
+  }
+  if (http_sock.is_open()) {
+    accumulate(m);
+  }
+}
+
+void metrics_binary::serialize(const enb_metrics_t&               m,
+                               uint32_t                           period_usec,
+                               uint32_t                           seq,
+                               uint64_t                           timestamp_us,
+                               std::vector<std::vector<uint8_t>>& datagrams)
+{
+  const auto& cells     = m.stack.mac.cc_info;
+  uint32_t    nof_cells = std::min<uint32_t>(cells.size(), (max_datagram - header_len - ue_len) / cell_len);
+  uint32_t    nof_ues   = std::min(m.stack.mac.ues.size(), m.phy.size());
+
+  uint32_t ues_per_datagram = (max_datagram - header_len - nof_cells * cell_len) / ue_len;
+  uint32_t nof_datagrams    = std::max(1u, (nof_ues + ues_per_datagram - 1) / ues_per_datagram);
+  nof_datagrams             = std::min(nof_datagrams, max_nof_chunks);
+
+  datagrams.resize(nof_datagrams);
+  for (uint32_t d = 0, ue_idx = 0; d < nof_datagrams; ++d) {
+    uint32_t nof_ues_d = std::min(ues_per_datagram, nof_ues - ue_idx);
+    datagrams[d].resize(header_len + nof_cells * cell_len + nof_ues_d * ue_len);
+
+    le_writer w(datagrams[d].data());
+    w.u32(magic);
+    w.u16(version);
+    w.u8(d);
+    w.u8(nof_datagrams);
+    w.u32(seq);
+    w.u32(period_usec);
+    w.u64(timestamp_us);
+    w.u16(nof_cells);
+    w.u16(nof_ues_d);
+    w.u32(0);
+
+    for (uint32_t cc = 0; cc < nof_cells; ++cc) {
+      w.u8(cc);
+      w.u8(0);
+      w.u16(cells[cc].pci);
+      w.u32(cells[cc].cc_rach_counter);
+    }
+
+    for (uint32_t i = 0; i < nof_ues_d; ++i, ++ue_idx) {
+      const mac_ue_metrics_t& mac = m.stack.mac.ues[ue_idx];
+      const phy_metrics_t&    phy = m.phy[ue_idx];
+      w.u16(mac.rnti);
+      w.u8(mac.cc_idx);
+      w.u8(0);
+      w.u32(mac.nof_tti);
+      w.cnt(mac.tx_brate);
+      w.cnt(mac.rx_brate);
+      w.cnt(mac.tx_pkts);
+      w.cnt(mac.tx_errors);
+      w.cnt(mac.rx_pkts);
+      w.cnt(mac.rx_errors);
+      w.cnt(mac.dl_buffer);
+      w.cnt(mac.ul_buffer);
+      w.f32(mac.dl_cqi);
+      w.f32(mac.dl_ri);
+      w.f32(phy.dl.mcs);
+      w.f32(phy.ul.mcs);
+      w.f32(phy.ul.pusch_sinr);
+      w.f32(mac.phr);
+    }
+  }
+}
+
+void metrics_binary::accumulate(const enb_metrics_t& m)
+{
+  std::lock_guard<std::mutex> lock(counters_mutex);
+
+  uint32_t                          nof_ues = std::min(m.stack.mac.ues.size(), m.phy.size());
+  std::map<uint16_t, ue_counters_t> updated;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    const mac_ue_metrics_t& mac = m.stack.mac.ues[i];
+    const phy_metrics_t&    phy = m.phy[i];
+
+    // The UEs missing from this period are released, and their counters restart if the RNTI is reused
+    ue_counters_t& c = updated[mac.rnti];
+    auto           it = ue_counters.find(mac.rnti);
+    if (it != ue_counters.end()) {
+      c = it->second;
+    }
+    c.pci = mac.pci;
+    c.nof_tti += mac.nof_tti;
+    c.dl_bits += std::max(0, mac.tx_brate);
+    c.ul_bits += std::max(0, mac.rx_brate);
+    c.dl_pdus += std::max(0, mac.tx_pkts);
+    c.dl_errors += std::max(0, mac.tx_errors);
+    c.ul_pdus += std::max(0, mac.rx_pkts);
+    c.ul_errors += std::max(0, mac.rx_errors);
+    c.dl_buffer = std::max(0, mac.dl_buffer);
+    c.ul_buffer = std::max(0, mac.ul_buffer);
+    c.dl_cqi    = mac.dl_cqi;
+    c.dl_mcs    = phy.dl.mcs;
+    c.ul_mcs    = phy.ul.mcs;
+    c.ul_snr    = phy.ul.pusch_sinr;
+    c.phr       = mac.phr;
+  }
+  ue_counters.swap(updated);
+
+  for (uint32_t cc = 0; cc < m.stack.mac.cc_info.size(); ++cc) {
+    cell_rach[m.stack.mac.cc_info[cc].pci] += m.stack.mac.cc_info[cc].cc_rach_counter;
+  }
+}
+
+std::string metrics_binary::format_prometheus()
+{
+  std::map<uint16_t, ue_counters_t> ues;
+  std::map<uint32_t, uint64_t>      rach;
+  {
+    std::lock_guard<std::mutex> lock(counters_mutex);
+    ues  = ue_counters;
+    rach = cell_rach;
+  }
+
+  fmt::memory_buffer buf;
+  fmt::format_to(buf, "# TYPE srsenb_cell_rach_total counter\n");
+  for (const auto& cell : rach) {
+    fmt::format_to(buf, "srsenb_cell_rach_total{{pci=\"{}\"}} {}\n", cell.first, cell.second);
+  }
+
+  // One family at a time, as required by the text format
+  auto append_family = [&buf, &ues](const char* name, const char* type, auto get) {
+    fmt::format_to(buf, "# TYPE {} {}\n", name, type);
+    for (const auto& ue : ues) {
+      append_sample(buf, name, ue.first, ue.second.pci, get(ue.second));
+    }
+  };
+  append_family("srsenb_ue_tti_total", "counter", [](const ue_counters_t& c) { return c.nof_tti; });
+  append_family("srsenb_ue_dl_bits_total", "counter", [](const ue_counters_t& c) { return c.dl_bits; });
+  append_family("srsenb_ue_ul_bits_total", "counter", [](const ue_counters_t& c) { return c.ul_bits; });
+  append_family("srsenb_ue_dl_pdus_total", "counter", [](const ue_counters_t& c) { return c.dl_pdus; });
+  append_family("srsenb_ue_dl_pdu_errors_total", "counter", [](const ue_counters_t& c) { return c.dl_errors; });
+  append_family("srsenb_ue_ul_pdus_total", "counter", [](const ue_counters_t& c) { return c.ul_pdus; });
+  append_family("srsenb_ue_ul_pdu_errors_total", "counter", [](const ue_counters_t& c) { return c.ul_errors; });
+  append_family("srsenb_ue_dl_buffer_bytes", "gauge", [](const ue_counters_t& c) { return c.dl_buffer; });
+  append_family("srsenb_ue_ul_buffer_bytes", "gauge", [](const ue_counters_t& c) { return c.ul_buffer; });
+  append_family("srsenb_ue_dl_cqi", "gauge", [](const ue_counters_t& c) { return c.dl_cqi; });
+  append_family("srsenb_ue_dl_mcs", "gauge", [](const ue_counters_t& c) { return c.dl_mcs; });
+  append_family("srsenb_ue_ul_mcs", "gauge", [](const ue_counters_t& c) { return c.ul_mcs; });
+  append_family("srsenb_ue_ul_sinr_db", "gauge", [](const ue_counters_t& c) { return c.ul_snr; });
+  append_family("srsenb_ue_phr_db", "gauge", [](const ue_counters_t& c) { return c.phr; });
+
+  return fmt::to_string(buf);
+}
+
+void metrics_binary::run_http()
+{
+  while (running) {
+    // Wake up periodically to check whether the exporter was stopped
+    pollfd pfd = {http_sock.fd(), POLLIN, 0};
+    if (poll(&pfd, 1, 100) <= 0 or not(pfd.revents & POLLIN)) {
+      continue;
+    }
+    int fd = accept(http_sock.fd(), nullptr, nullptr);
+    if (fd < 0) {
+      continue;
+    }
+    serve_http(fd);
+    ::close(fd);
+  }
+}
+
+void metrics_binary::serve_http(int fd)
+{
+  timeval timeout = {1, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  // Only the request line matters, the rest of the headers are not parsed
+  std::string request;
+  char        buf[1024];
+  while (request.find("\r\n\r\n") == std::string::npos and request.size() < 8192) {
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if (n <= 0) {
+      return;
+    }
+    request.append(buf, n);
+  }
+
+  std::string response;
+  if (request.compare(0, 13, "GET /metrics ") == 0 or request.compare(0, 13, "GET /metrics?") == 0) {
+    std::string body = format_prometheus();
+    response         = "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+               std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+  } else {
+    response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+  }
+
+  for (size_t sent = 0; sent < response.size();) {
+    ssize_t n = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+    if (n <= 0) {
+      return;
+    }
+    sent += n;
+  }
+}
@@ -26,6 +26,22 @@ using namespace srsenb;
 
 namespace {
 
+/// Time histogram container metrics, used by the bearer latency breakdown and the RF device health.
+DECLARE_METRIC("count", metric_count, uint32_t, "");
+DECLARE_METRIC("value_us", metric_value_us, int32_t, "us");
+DECLARE_METRIC_SET("rf_bin_container", mset_rf_bin_container, metric_value_us, metric_count);
+DECLARE_METRIC("name", metric_hist_name, std::string, "");
+DECLARE_METRIC("max_us", metric_max_us, int64_t, "us");
+DECLARE_METRIC("avg_us", metric_avg_us, float, "us");
+DECLARE_METRIC_LIST("bin_list", mlist_rf_bins, std::vector<mset_rf_bin_container>);
+DECLARE_METRIC_SET("hist_container",
+                   mset_rf_hist_container,
+                   metric_hist_name,
+                   metric_count,
+                   metric_max_us,
+                   metric_avg_us,
+                   mlist_rf_bins);
+
 /// Bearer container metrics.
 DECLARE_METRIC("bearer_id", metric_bearer_id, uint32_t, "");
 DECLARE_METRIC("qci", metric_qci, uint32_t, "");
@@ -35,6 +51,7 @@ DECLARE_METRIC("dl_latency", metric_dl_latency, float, "");
 DECLARE_METRIC("ul_latency", metric_ul_latency, float, "");
 DECLARE_METRIC("dl_buffered_bytes", metric_dl_buffered_bytes, uint32_t, "");
 DECLARE_METRIC("ul_buffered_bytes", metric_ul_buffered_bytes, uint32_t, "");
+DECLARE_METRIC_LIST("dl_latency_breakdown", mlist_dl_latency_hist, std::vector<mset_rf_hist_container>);
 DECLARE_METRIC_SET("bearer_container",
                    mset_bearer_container,
                    metric_bearer_id,
@@ -44,7 +61,8 @@ DECLARE_METRIC_SET("bearer_container",
                    metric_dl_latency,
                    metric_ul_latency,
                    metric_dl_buffered_bytes,
-                   metric_ul_buffered_bytes);
+                   metric_ul_buffered_bytes,
+                   mlist_dl_latency_hist);
 
 /// UE container metrics.
 DECLARE_METRIC("ue_rnti", metric_ue_rnti, uint32_t, "");
@@ -95,16 +113,113 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// PHY timing container metrics.
+DECLARE_METRIC("slack_us", metric_slack_us, int32_t, "us");
+DECLARE_METRIC_SET("bin_container", mset_bin_container, metric_slack_us, metric_count);
+DECLARE_METRIC("stage", metric_stage, std::string, "");
+DECLARE_METRIC("nof_tti", metric_nof_tti, uint32_t, "");
+DECLARE_METRIC("nof_late", metric_nof_late, uint32_t, "");
+DECLARE_METRIC_LIST("bin_list", mlist_bins, std::vector<mset_bin_container>);
+DECLARE_METRIC_SET("timing_container", mset_timing_container, metric_stage, metric_nof_tti, metric_nof_late, mlist_bins);
+
+/// RF device health container metrics.
+DECLARE_METRIC("device", metric_rf_device, uint32_t, "");
+DECLARE_METRIC("rx_gaps", metric_rx_gaps, uint32_t, "");
+DECLARE_METRIC("rx_gap_samples", metric_rx_gap_samples, int64_t, "");
+DECLARE_METRIC("tx_gaps", metric_tx_gaps, uint32_t, "");
+DECLARE_METRIC("tx_overlaps", metric_tx_overlaps, uint32_t, "");
+DECLARE_METRIC("tx_staged_max", metric_tx_staged_max, uint32_t, "");
+DECLARE_METRIC_LIST("hist_list", mlist_rf_hist, std::vector<mset_rf_hist_container>);
+DECLARE_METRIC_SET("rf_device_container",
+                   mset_rf_device_container,
+                   metric_rf_device,
+                   metric_rx_gaps,
+                   metric_rx_gap_samples,
+                   metric_tx_gaps,
+                   metric_tx_overlaps,
+                   metric_tx_staged_max,
+                   mlist_rf_hist);
+DECLARE_METRIC("rf_o", metric_rf_o, uint32_t, "");
+DECLARE_METRIC("rf_u", metric_rf_u, uint32_t, "");
+DECLARE_METRIC("rf_l", metric_rf_l, uint32_t, "");
+DECLARE_METRIC_LIST("device_list", mlist_rf_devices, std::vector<mset_rf_device_container>);
+DECLARE_METRIC_SET("rf_container", mset_rf_container, metric_rf_o, metric_rf_u, metric_rf_l, mlist_rf_devices);
+
+/// Thread metrics.
+DECLARE_METRIC("thread_name", metric_thread_name, std::string, "");
+DECLARE_METRIC("tid", metric_tid, uint32_t, "");
+DECLARE_METRIC("cpu_usage", metric_thread_cpu_usage, float, "%");
+DECLARE_METRIC("voluntary_ctxt_switches", metric_voluntary_ctxt_switches, uint32_t, "");
+DECLARE_METRIC("nonvoluntary_ctxt_switches", metric_nonvoluntary_ctxt_switches, uint32_t, "");
+DECLARE_METRIC("runqueue_delay_us", metric_runqueue_delay_us, uint64_t, "us");
+DECLARE_METRIC_SET("thread_container",
+                   mset_thread_container,
+                   metric_thread_name,
+                   metric_tid,
+                   metric_thread_cpu_usage,
+                   metric_voluntary_ctxt_switches,
+                   metric_nonvoluntary_ctxt_switches,
+                   metric_runqueue_delay_us);
+
+/// Pool metrics.
+DECLARE_METRIC("pool_name", metric_pool_name, std::string, "");
+DECLARE_METRIC("capacity", metric_pool_capacity, uint64_t, "");
+DECLARE_METRIC("in_use", metric_pool_in_use, uint64_t, "");
+DECLARE_METRIC("high_water", metric_pool_high_water, uint64_t, "");
+DECLARE_METRIC("nof_allocs", metric_pool_nof_allocs, uint64_t, "");
+DECLARE_METRIC("alloc_failures", metric_pool_alloc_failures, uint64_t, "");
+DECLARE_METRIC("cache_hit_rate", metric_pool_cache_hit_rate, float, "");
+DECLARE_METRIC_SET("pool_container",
+                   mset_pool_container,
+                   metric_pool_name,
+                   metric_pool_capacity,
+                   metric_pool_in_use,
+                   metric_pool_high_water,
+                   metric_pool_nof_allocs,
+                   metric_pool_alloc_failures,
+                   metric_pool_cache_hit_rate);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
+DECLARE_METRIC_LIST("phy_timing_list", mlist_phy_timing, std::vector<mset_timing_container>);
+DECLARE_METRIC_LIST("thread_list", mlist_threads, std::vector<mset_thread_container>);
+DECLARE_METRIC_LIST("pool_list", mlist_pools, std::vector<mset_pool_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t = srslog::build_context_type<metric_type_tag,
+                                                    metric_timestamp_tag,
+                                                    mlist_cell,
+                                                    mlist_phy_timing,
+                                                    mset_rf_container,
+                                                    mlist_threads,
+                                                    mlist_pools>;
 
 } // namespace
 
+/// Fill a time histogram, the value of each bin is its lower edge.
+template <typename Hist>
+static void fill_hist_metrics(std::vector<mset_rf_hist_container>& list, const std::string& name, const Hist& hist)
+{
+  if (hist.count == 0) {
+    return;
+  }
+  list.emplace_back();
+  auto& container = list.back();
+  container.write<metric_hist_name>(name);
+  container.write<metric_count>(hist.count);
+  container.write<metric_max_us>(hist.max_us);
+  container.write<metric_avg_us>((float)hist.total_us / hist.count);
+
+  auto& bin_list = container.get<mlist_rf_bins>();
+  for (uint32_t i = 0; i < Hist::nof_bins; i++) {
+    bin_list.emplace_back();
+    bin_list.back().write<metric_value_us>(Hist::bin_lower_us(i));
+    bin_list.back().write<metric_count>(hist.bins[i]);
+  }
+}
+
 /// Fill the metrics for the i'th UE in the enb metrics struct.
 static void fill_ue_metrics(mset_ue_container& ue, const enb_metrics_t& m, unsigned i)
 {
@@ -171,6 +286,93 @@ static void fill_ue_metrics(mset_ue_container& ue, const enb_metrics_t& m, unsig
     bearer_container.write<metric_ul_latency>(rlc_bearer[drb.first].rx_latency_ms / 1e3);
     bearer_container.write<metric_dl_buffered_bytes>(pdcp_bearer[drb.first].num_tx_buffered_pdus_bytes);
     bearer_container.write<metric_ul_buffered_bytes>(rlc_bearer[drb.first].rx_buffered_bytes);
+
+    // Latency breakdown of the sampled DL packets
+    const srsran::pkt_latency_metrics_t& latency      = rlc_bearer[drb.first].tx_pkt_latency;
+    auto&                                latency_list = bearer_container.get<mlist_dl_latency_hist>();
+    fill_hist_metrics(latency_list, "gtpu", latency.gtpu);
+    fill_hist_metrics(latency_list, "pdcp", latency.pdcp);
+    fill_hist_metrics(latency_list, "rlc_queue", latency.rlc_queue);
+    fill_hist_metrics(latency_list, "total", latency.total);
+  }
+}
+
+/// Fill the histogram of a PHY processing stage, the slack of each bin is its lower edge.
+static void fill_timing_metrics(std::vector<mset_timing_container>& list,
+                                const std::string&                   stage,
+                                const phy_timing_hist_t&             hist)
+{
+  if (hist.nof_tti == 0) {
+    return;
+  }
+  list.emplace_back();
+  auto& timing = list.back();
+  timing.write<metric_stage>(stage);
+  timing.write<metric_nof_tti>(hist.nof_tti);
+  timing.write<metric_nof_late>(hist.nof_late);
+
+  auto& bin_list = timing.get<mlist_bins>();
+  for (uint32_t i = 0; i < phy_timing_hist_t::nof_bins; i++) {
+    bin_list.emplace_back();
+    bin_list.back().write<metric_slack_us>(phy_timing_hist_t::bin_lower_us(i));
+    bin_list.back().write<metric_count>(hist.bins[i]);
+  }
+}
+
+/// Fill the health metrics of every RF device.
+static void fill_rf_metrics(mset_rf_container& rf, const srsran::rf_metrics_t& m)
+{
+  rf.write<metric_rf_o>(m.rf_o);
+  rf.write<metric_rf_u>(m.rf_u);
+  rf.write<metric_rf_l>(m.rf_l);
+
+  auto& device_list = rf.get<mlist_rf_devices>();
+  for (unsigned i = 0, e = m.dev.size(); i != e; ++i) {
+    device_list.emplace_back();
+    auto& device = device_list.back();
+    device.write<metric_rf_device>(i);
+    device.write<metric_rx_gaps>(m.dev[i].rx_gaps);
+    device.write<metric_rx_gap_samples>(m.dev[i].rx_gap_samples);
+    device.write<metric_tx_gaps>(m.dev[i].tx_gaps);
+    device.write<metric_tx_overlaps>(m.dev[i].tx_overlaps);
+    device.write<metric_tx_staged_max>(m.dev[i].tx_staged_max);
+
+    auto& hist_list = device.get<mlist_rf_hist>();
+    fill_hist_metrics(hist_list, "rx_call", m.dev[i].rx_call);
+    fill_hist_metrics(hist_list, "tx_call", m.dev[i].tx_call);
+    fill_hist_metrics(hist_list, "tx_deadline", m.dev[i].tx_deadline);
+  }
+}
+
+/// Fill the CPU usage and scheduling of each thread of the process.
+static void fill_thread_metrics(std::vector<mset_thread_container>& list, const srsran::sys_metrics_t& m)
+{
+  for (uint32_t i = 0; i != m.nof_threads; ++i) {
+    const srsran::sys_thread_metrics_t& t = m.threads[i];
+    list.emplace_back();
+    auto& thread = list.back();
+    thread.write<metric_thread_name>(std::string(t.name.data()));
+    thread.write<metric_tid>(t.tid);
+    thread.write<metric_thread_cpu_usage>(t.cpu_usage);
+    thread.write<metric_voluntary_ctxt_switches>(t.voluntary_ctxt_switches);
+    thread.write<metric_nonvoluntary_ctxt_switches>(t.nonvoluntary_ctxt_switches);
+    thread.write<metric_runqueue_delay_us>(t.runqueue_delay_us);
+  }
+}
+
+/// Fill the occupancy of the memory and object pools.
+static void fill_pool_metrics(std::vector<mset_pool_container>& list, const std::vector<srsran::pool_metrics_t>& pools)
+{
+  for (const srsran::pool_metrics_t& p : pools) {
+    list.emplace_back();
+    auto& pool = list.back();
+    pool.write<metric_pool_name>(p.name);
+    pool.write<metric_pool_capacity>(p.capacity);
+    pool.write<metric_pool_in_use>(p.in_use);
+    pool.write<metric_pool_high_water>(p.high_water);
+    pool.write<metric_pool_nof_allocs>(p.nof_allocs);
+    pool.write<metric_pool_alloc_failures>(p.nof_alloc_failures);
+    pool.write<metric_pool_cache_hit_rate>(p.nof_allocs > 0 ? (float)p.nof_cache_hits / p.nof_allocs : 0.f);
   }
 }
 
@@ -238,6 +440,25 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  // PHY subframe timing, relative to the TX deadline.
+  auto& timing_list = ctx.get<mlist_phy_timing>();
+  fill_timing_metrics(timing_list, "rx", m.phy_timing.rx);
+  for (unsigned cc_idx = 0, e = m.phy_timing.ul_decode.size(); cc_idx != e; ++cc_idx) {
+    fill_timing_metrics(timing_list, "ul_decode_cc" + std::to_string(cc_idx), m.phy_timing.ul_decode[cc_idx]);
+  }
+  fill_timing_metrics(timing_list, "mac_sched", m.phy_timing.mac_sched);
+  fill_timing_metrics(timing_list, "dl_encode", m.phy_timing.dl_encode);
+  fill_timing_metrics(timing_list, "tx_submit", m.phy_timing.tx_submit);
+
+  // RF health of the period.
+  fill_rf_metrics(ctx.get<mset_rf_container>(), m.rf);
+
+  // CPU usage and preemption of each thread.
+  fill_thread_metrics(ctx.get<mlist_threads>(), m.sys);
+
+  // Occupancy of the pools.
+  fill_pool_metrics(ctx.get<mlist_pools>(), m.pools);
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
@@ -22,6 +22,7 @@
 #include <iomanip>
 
 #include "srsran/common/threads.h"
+#include "srsran/common/tti_trace.h"
 #include "srsran/srsran.h"
 
 #include "srsenb/hdr/phy/lte/cc_worker.h"
@@ -63,9 +64,17 @@ cc_worker::cc_worker(srslog::basic_logger& logger) : logger(logger)
 
 cc_worker::~cc_worker()
 {
+  if (pusch_pool) {
+    pusch_pool->stop();
+  }
+  for (auto& q : pusch_decoders) {
+    srsran_enb_ul_free(&q);
+  }
+
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
   srsran_enb_dl_free(&enb_dl);
   srsran_enb_ul_free(&enb_ul);
+  srsran_chest_ul_srs_batch_free(&srs_batch);
 
   for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
     if (signal_buffer_rx[p]) {
@@ -75,11 +84,6 @@ cc_worker::~cc_worker()
       free(signal_buffer_tx[p]);
     }
   }
-
-  // Delete all users
-  for (auto& it : ue_db) {
-    delete it.second;
-  }
 }
 
 #ifdef DEBUG_WRITE_FILE
@@ -122,6 +126,10 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     ERROR("Error setting the CFR");
     return;
   }
+  if (phy->params.dl_sparse_tx && srsran_enb_dl_set_sparse_tx(&enb_dl, true) < SRSRAN_SUCCESS) {
+    ERROR("Error enabling the sparse DL transmission");
+    return;
+  }
   if (srsran_enb_ul_init(&enb_ul, signal_buffer_rx[0], nof_prb)) {
     ERROR("Error initiating ENB UL");
     return;
@@ -132,6 +140,15 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     return;
   }
 
+  if (srsran_chest_ul_srs_batch_init(&srs_batch, SRSENB_MAX_UES) < SRSRAN_SUCCESS ||
+      srsran_chest_ul_srs_batch_set_cell(&srs_batch, cell) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating the SRS estimator");
+    return;
+  }
+  srs_cfgs.reserve(SRSENB_MAX_UES);
+  srs_meas.resize(SRSENB_MAX_UES);
+  srs_rntis.reserve(SRSENB_MAX_UES);
+
   /* Setup SI-RNTI in PHY */
   add_rnti(SRSRAN_SIRNTI);
 
@@ -143,19 +160,50 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     add_rnti(i);
   }
 
-  if (srsran_softbuffer_tx_init(&temp_mbsfn_softbuffer, nof_prb)) {
-    ERROR("Error initiating soft buffer");
-    exit(-1);
-  }
-
-  srsran_softbuffer_tx_reset(&temp_mbsfn_softbuffer);
-
   Info("Component Carrier Worker %d configured cell %d PRB", cc_idx, nof_prb);
 
   if (phy->params.pusch_8bit_decoder) {
     enb_ul.pusch.llr_is_8bit        = true;
     enb_ul.pusch.ul_sch.llr_is_8bit = true;
   }
+  enb_ul.pusch.ul_sch.early_stop_stable = phy->params.pusch_early_stop;
+
+  if (srsran_sch_enable_cb_workers(&enb_ul.pusch.ul_sch, phy->params.pusch_cb_workers)) {
+    ERROR("Error enabling PUSCH code block workers");
+    return;
+  }
+
+  // The helper decoders only estimate and decode, their FFT is never run
+  if (phy->params.pusch_ue_workers > 0) {
+    pusch_decoders.resize(phy->params.pusch_ue_workers);
+    for (auto& q : pusch_decoders) {
+      q = {};
+      if (srsran_enb_ul_init(&q, signal_buffer_rx[0], nof_prb)) {
+        ERROR("Error initiating ENB UL");
+        return;
+      }
+      if (srsran_enb_ul_set_cell(&q, cell, &phy->dmrs_pusch_cfg, nullptr)) {
+        ERROR("Error initiating ENB UL");
+        return;
+      }
+      q.pusch.llr_is_8bit              = enb_ul.pusch.llr_is_8bit;
+      q.pusch.ul_sch.llr_is_8bit       = enb_ul.pusch.ul_sch.llr_is_8bit;
+      q.pusch.ul_sch.early_stop_stable = enb_ul.pusch.ul_sch.early_stop_stable;
+      if (srsran_sch_enable_cb_workers(&q.pusch.ul_sch, phy->params.pusch_cb_workers)) {
+        ERROR("Error enabling PUSCH code block workers");
+        return;
+      }
+    }
+    pusch_slots.resize(stack_interface_phy_lte::MAX_GRANTS);
+    pusch_pool.reset(new srsran::task_thread_pool(phy->params.pusch_ue_workers));
+  }
+
+  // Every port has its own IFFT and CFR, so they can be generated by helper threads
+  uint32_t nof_ports = phy->get_nof_ports(cc_idx);
+  tx_helpers         = SRSRAN_MIN(phy->params.cfr_args.nof_threads, SRSRAN_MAX(nof_ports, 1) - 1);
+  if (tx_helpers > 0) {
+    tx_pool.reset(new srsran::task_thread_pool(tx_helpers));
+  }
   initiated = true;
 
 #ifdef DEBUG_WRITE_FILE
@@ -169,13 +217,26 @@ void cc_worker::reset()
   ue_db.clear();
 }
 
+/* The sc16 samples are exchanged with the radio through the second half of the buffers, the first half keeps the cf_t
+ * samples the OFDM demodulator and modulator work with. It fits the twice as many samples the radio may receive */
+cf_t* cc_worker::get_buffer_sc16(cf_t* buffer)
+{
+  return &buffer[SRSRAN_SF_LEN_PRB(phy->get_nof_prb(cc_idx))];
+}
+
 cf_t* cc_worker::get_buffer_rx(uint32_t antenna_idx)
 {
+  if (phy->is_sc16()) {
+    return get_buffer_sc16(signal_buffer_rx[antenna_idx]);
+  }
   return signal_buffer_rx[antenna_idx];
 }
 
 cf_t* cc_worker::get_buffer_tx(uint32_t antenna_idx)
 {
+  if (phy->is_sc16()) {
+    return get_buffer_sc16(signal_buffer_tx[antenna_idx]);
+  }
   return signal_buffer_tx[antenna_idx];
 }
 
@@ -190,9 +251,19 @@ int cc_worker::add_rnti(uint16_t rnti)
 {
   std::unique_lock<std::mutex> lock(mutex);
 
+  // The common RNTIs are always known
+  if (not SRSRAN_RNTI_ISUSER(rnti) and rnti != SRSRAN_MRNTI) {
+    return SRSRAN_SUCCESS;
+  }
+
   // Create user unless already exists
-  if (ue_db.count(rnti) == 0) {
-    ue_db[rnti] = new ue(rnti);
+  if (not ue_db.contains(rnti)) {
+    if (not ue_db.has_space(rnti)) {
+      Error("Adding rnti=0x%x, its slot is used by another user", rnti);
+      return SRSRAN_ERROR;
+    }
+    ue_db.insert(rnti, ue(rnti));
+    phich_grants[ue_idx(rnti)] = {};
   }
   return SRSRAN_SUCCESS;
 }
@@ -200,9 +271,12 @@ int cc_worker::add_rnti(uint16_t rnti)
 void cc_worker::rem_rnti(uint16_t rnti)
 {
   std::lock_guard<std::mutex> lock(mutex);
-  if (ue_db.count(rnti)) {
-    delete ue_db[rnti];
-    ue_db.erase(rnti);
+  ue_db.erase(rnti);
+
+  // Drop the scrambling sequences cached by every PUSCH decoder
+  srsran_enb_ul_rem_rnti(&enb_ul, rnti);
+  for (srsran_enb_ul_t& q : pusch_decoders) {
+    srsran_enb_ul_rem_rnti(&q, rnti);
   }
 }
 
@@ -212,32 +286,70 @@ uint32_t cc_worker::get_nof_rnti()
   return ue_db.size();
 }
 
+bool cc_worker::is_known_rnti(uint16_t rnti) const
+{
+  if (SRSRAN_RNTI_ISUSER(rnti) or rnti == SRSRAN_MRNTI) {
+    return ue_db.contains(rnti);
+  }
+  return rnti == SRSRAN_SIRNTI or rnti == SRSRAN_PRNTI or SRSRAN_RNTI_ISRAR(rnti);
+}
+
 void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy_lte::ul_sched_t& ul_grants)
 {
   std::lock_guard<std::mutex> lock(mutex);
-  ul_sf = ul_sf_cfg;
+  srsran::tti_trace_scope     trace_scope(srsran::tti_trace_event::cc_worker_ul, ul_sf_cfg.tti);
+  ul_sf    = ul_sf_cfg;
+  ul_start = std::chrono::steady_clock::now();
   logger.set_context(ul_sf.tti);
 
-  // Process UL signal
-  srsran_enb_ul_fft(&enb_ul);
+  // The UL signal is demodulated by the first PUSCH or PUCCH to decode, subframes without any are not demodulated
+  ul_fft_pending = true;
 
   // Decode pending UL grants for the tti they were scheduled
   decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
 
   // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
   decode_pucch();
+
+  // Measure the SRS of the UEs that sound in this subframe
+  decode_srs();
 }
 
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                         stack_interface_phy_lte::dl_sched_t& dl_grants,
                         stack_interface_phy_lte::ul_sched_t& ul_grants,
                         srsran_mbsfn_cfg_t*                  mbsfn_cfg)
+{
+  work_dl_data(dl_sf_cfg, dl_grants, mbsfn_cfg);
+  work_dl_ctrl(ul_grants);
+}
+
+void cc_worker::work_dl_base(const srsran_dl_sf_cfg_t& dl_sf_cfg)
 {
   std::lock_guard<std::mutex> lock(mutex);
   dl_sf = dl_sf_cfg;
 
-  // Put base signals (references, PBCH, PCFICH and PSS/SSS) into the resource grid
-  srsran_enb_dl_put_base(&enb_dl, &dl_sf);
+  // Put the references, PBCH and PSS/SSS into the resource grid, the PCFICH waits for the CFI
+  srsran_enb_dl_put_base_signals(&enb_dl, &dl_sf);
+  dl_base_ready = true;
+}
+
+void cc_worker::work_dl_data(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
+                             stack_interface_phy_lte::dl_sched_t& dl_grants,
+                             srsran_mbsfn_cfg_t*                  mbsfn_cfg)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  srsran::tti_trace_scope     trace_scope(srsran::tti_trace_event::cc_worker_dl_data, dl_sf_cfg.tti);
+
+  // Put base signals (references, PBCH, PCFICH and PSS/SSS) into the resource grid, unless only the PCFICH is missing
+  if (dl_base_ready and dl_sf.tti == dl_sf_cfg.tti) {
+    dl_sf = dl_sf_cfg;
+    srsran_enb_dl_put_cfi(&enb_dl, dl_sf.cfi);
+  } else {
+    dl_sf = dl_sf_cfg;
+    srsran_enb_dl_put_base(&enb_dl, &dl_sf);
+  }
+  dl_base_ready = false;
 
   // Put DL grants to resource grid. PDSCH data will be encoded as well.
   if (dl_sf_cfg.sf_type == SRSRAN_SF_NORM) {
@@ -248,6 +360,12 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
       encode_pmch(dl_grants.pdsch, mbsfn_cfg);
     }
   }
+}
+
+void cc_worker::work_dl_ctrl(stack_interface_phy_lte::ul_sched_t& ul_grants)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  srsran::tti_trace_scope     trace_scope(srsran::tti_trace_event::cc_worker_dl_ctrl, dl_sf.tti);
 
   // Put UL grants to resource grid.
   encode_pdcch_ul(ul_grants.pusch, ul_grants.nof_grants);
@@ -256,12 +374,12 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   encode_phich(ul_grants.phich, ul_grants.nof_phich);
 
   // Generate signal and transmit
-  srsran_enb_dl_gen_signal(&enb_dl);
+  gen_signal();
 
-  // Scale if cell gain is set
+  // Scale if cell gain is set, the sc16 conversion applies it, as it does not change the PAPR
   float cell_gain_db = phy->get_cell_gain(cc_idx);
-  if (std::isnormal(cell_gain_db)) {
-    float    scale  = srsran_convert_dB_to_amplitude(cell_gain_db);
+  float scale        = std::isnormal(cell_gain_db) ? srsran_convert_dB_to_amplitude(cell_gain_db) : 1.0f;
+  if (std::isnormal(cell_gain_db) and not phy->is_sc16()) {
     uint32_t sf_len = SRSRAN_SF_LEN_PRB(enb_dl.cell.nof_prb);
     for (uint32_t i = 0; i < enb_dl.cell.nof_ports; i++) {
       srsran_vec_sc_prod_cfc(signal_buffer_tx[i], scale, signal_buffer_tx[i], sf_len);
@@ -281,13 +399,25 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
     // clear measurement flag on cell
     phy->clear_cell_measure_trigger(cc_idx);
   }
+
+  // Convert into the samples handed to the radio
+  if (phy->is_sc16()) {
+    uint32_t sf_len = SRSRAN_SF_LEN_PRB(enb_dl.cell.nof_prb);
+    for (uint32_t i = 0; i < enb_dl.cell.nof_ports; i++) {
+      srsran_vec_convert_fi((float*)signal_buffer_tx[i],
+                            scale * SRSRAN_RF_SC16_FULL_SCALE,
+                            (int16_t*)get_buffer_tx(i),
+                            2 * sf_len);
+    }
+  }
 }
 
-bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                                  srsran_ul_cfg_t&                           ul_cfg,
-                                  srsran_pusch_res_t&                        pusch_res)
+bool cc_worker::prepare_pusch(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, pusch_slot_t& slot)
 {
-  uint16_t rnti = ul_grant.dci.rnti;
+  uint16_t         rnti   = ul_grant.dci.rnti;
+  srsran_ul_cfg_t& ul_cfg = slot.ul_cfg;
+
+  slot.ul_grant = &ul_grant;
 
   // Invalid RNTI
   if (rnti == SRSRAN_INVALID_RNTI) {
@@ -295,7 +425,7 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   }
 
   // RNTI does not exist
-  if (ue_db.count(rnti) == 0) {
+  if (not ue_db.contains(rnti)) {
     return false;
   }
 
@@ -307,9 +437,14 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   }
 
   // Fill UCI configuration
-  bool uci_required =
+  slot.uci_required =
       phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, ul_grant.dci.cqi_request, true, ul_cfg.pusch.uci_cfg);
 
+  // The PUSCH of the UL SPS grants is scrambled with the SPS C-RNTI
+  if (ul_grant.sps_crnti != SRSRAN_INVALID_RNTI) {
+    ul_cfg.pusch.rnti = ul_grant.sps_crnti;
+  }
+
   // Compute UL grant
   srsran_pusch_grant_t& grant = ul_cfg.pusch.grant;
   if (srsran_ra_ul_dci_to_grant(&enb_ul.cell, &ul_sf, &ul_cfg.hopping, &ul_grant.dci, &grant)) {
@@ -338,20 +473,57 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     Error("Error setting last UL TB for RNTI %x, CC %d, PID %d", rnti, cc_idx, ul_grant.pid);
   }
 
-  // Run PUSCH decoder
   ul_cfg.pusch.softbuffers.rx = ul_grant.softbuffer_rx;
-  pusch_res.data              = ul_grant.data;
-  if (pusch_res.data) {
-    if (srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
-      Error("Decoding PUSCH for RNTI %x", rnti);
+  slot.pusch_res.data         = ul_grant.data;
+  return true;
+}
+
+bool cc_worker::run_pusch(srsran_enb_ul_t& q, pusch_slot_t& slot)
+{
+  srsran_ul_cfg_t& ul_cfg = slot.ul_cfg;
+
+  // Reduce the turbo decoder iterations if the UL processing of this subframe is running late
+  if (phy->params.pusch_deadline_us > 0) {
+    auto elapsed_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - ul_start).count();
+    if (elapsed_us > phy->params.pusch_deadline_us) {
+      ul_cfg.pusch.max_nof_iterations = SRSRAN_MAX(ul_cfg.pusch.max_nof_iterations / 2, PUSCH_MIN_TURBO_ITS);
+    }
+  }
+
+  // Run PUSCH decoder, every decoder works on its own copy of the subframe configuration
+  if (slot.pusch_res.data) {
+    srsran_ul_sf_cfg_t sf = ul_sf;
+    if (srsran_enb_ul_get_pusch_grid(&q, &sf, &ul_cfg.pusch, enb_ul.sf_symbols, &slot.pusch_res)) {
+      Error("Decoding PUSCH for RNTI %x", slot.ul_grant->dci.rnti);
       return false;
     }
   }
+  slot.chest_res = q.chest_res;
+  return true;
+}
+
+void cc_worker::run_pusch_slots(srsran_enb_ul_t& q, uint32_t nof_slots)
+{
+  for (uint32_t i = pusch_next_slot++; i < nof_slots; i = pusch_next_slot++) {
+    pusch_slots[i].decoded = run_pusch(q, pusch_slots[i]);
+  }
+}
+
+void cc_worker::report_pusch(pusch_slot_t& slot)
+{
+  stack_interface_phy_lte::ul_sched_grant_t& ul_grant  = *slot.ul_grant;
+  srsran_ul_cfg_t&                           ul_cfg    = slot.ul_cfg;
+  srsran_pusch_res_t&                        pusch_res = slot.pusch_res;
+  srsran_chest_ul_res_t&                     chest_res = slot.chest_res;
+  uint16_t                                   rnti      = ul_grant.dci.rnti;
+
   // Save PHICH scheduling for this user. Each user can have just 1 PUSCH dci per TTI
-  ue_db[rnti]->phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
-  ue_db[rnti]->phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
+  srsran_phich_grant_t& phich_grant = phich_grants[ue_idx(rnti)];
+  phich_grant.n_prb_lowest          = ul_cfg.pusch.grant.n_prb_tilde[0];
+  phich_grant.n_dmrs                = ul_grant.dci.n_dmrs;
 
-  float snr_db = enb_ul.chest_res.snr_db;
+  float snr_db = chest_res.snr_db;
 
   // Notify MAC of RL status
   if (snr_db >= PUSCH_RL_SNR_DB_TH) {
@@ -359,58 +531,141 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     phy->stack->snr_info(ul_sf.tti, rnti, cc_idx, snr_db, mac_interface_phy_lte::PUSCH);
 
     // Notify MAC of Time Alignment only if it enabled and valid measurement, ignore value otherwise
-    if (ul_cfg.pusch.meas_ta_en and not std::isnan(enb_ul.chest_res.ta_us) and not std::isinf(enb_ul.chest_res.ta_us)) {
-      phy->stack->ta_info(ul_sf.tti, rnti, enb_ul.chest_res.ta_us);
+    if (ul_cfg.pusch.meas_ta_en and not std::isnan(chest_res.ta_us) and not std::isinf(chest_res.ta_us)) {
+      phy->stack->ta_info(ul_sf.tti, rnti, chest_res.ta_us);
     }
   }
 
   // Send UCI data to MAC
-  if (uci_required) {
+  if (slot.uci_required) {
     phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, pusch_res.uci);
   }
 
-  // Save statistics only if data was provided
+  // Notify MAC new received data and HARQ Indication value, save statistics only if data was provided
   if (ul_grant.data != nullptr) {
     // Save metrics stats
-    ue_db[rnti]->metrics_ul(ul_grant.dci.tb.mcs_idx,
-                            enb_ul.chest_res.epre_dBfs - phy->params.rx_gain_offset,
-                            enb_ul.chest_res.snr_db,
-                            pusch_res.avg_iterations_block);
+    ue_db[rnti].metrics_ul(ul_grant.dci.tb.mcs_idx,
+                           chest_res.epre_dBfs - phy->params.rx_gain_offset,
+                           chest_res.snr_db,
+                           pusch_res.avg_iterations_block);
+
+    // Inform MAC about the CRC result
+    phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
+    // Push PDU buffer
+    phy->stack->push_pdu(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc, ul_cfg.pusch.grant.L_prb);
+    // Logging
+    if (logger.info.enabled()) {
+      char str[512];
+      srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &chest_res, str, sizeof(str));
+      logger.info("PUSCH: cc=%d, %s", cc_idx, str);
+    }
+  }
+}
+
+void cc_worker::demodulate_ul()
+{
+  if (!ul_fft_pending) {
+    return;
+  }
+  ul_fft_pending = false;
+
+  // Process UL signal, the sc16 samples are converted as the cyclic prefixes are removed
+  if (phy->is_sc16()) {
+    srsran_enb_ul_fft_sc16(&enb_ul, (int16_t*)get_buffer_rx(0), SRSRAN_RF_SC16_FULL_SCALE);
+  } else {
+    srsran_enb_ul_fft(&enb_ul);
   }
-  return true;
 }
 
 void cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch)
 {
+  if (nof_pusch > 0) {
+    demodulate_ul();
+  }
+
+  if (pusch_pool) {
+    decode_pusch_parallel(grants, nof_pusch);
+    return;
+  }
+
   // Iterate over all the grants, all the grants need to report MAC the CRC status
   for (uint32_t i = 0; i < nof_pusch; i++) {
-    // Get grant itself and RNTI
-    stack_interface_phy_lte::ul_sched_grant_t& ul_grant = grants[i];
-    uint16_t                                   rnti     = ul_grant.dci.rnti;
-
-    srsran_pusch_res_t pusch_res = {};
-    srsran_ul_cfg_t    ul_cfg    = {};
+    pusch_slot_t slot = {};
 
     // Decodes PUSCH for the given grant
-    if (!decode_pusch_rnti(ul_grant, ul_cfg, pusch_res)) {
+    if (!prepare_pusch(grants[i], slot) || !run_pusch(enb_ul, slot)) {
       return;
     }
+    report_pusch(slot);
+  }
+}
 
-    // Notify MAC new received data and HARQ Indication value
-    if (ul_grant.data != nullptr) {
-      // Inform MAC about the CRC result
-      phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
-      // Push PDU buffer
-      phy->stack->push_pdu(
-          tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc, ul_cfg.pusch.grant.L_prb);
-      // Logging
-      if (logger.info.enabled()) {
-        char str[512];
-        srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &enb_ul.chest_res, str, sizeof(str));
-        logger.info("PUSCH: cc=%d, %s", cc_idx, str);
-      }
+void cc_worker::decode_pusch_parallel(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch)
+{
+  // Configure the grants in order, up to the first one that cannot be decoded
+  uint32_t nof_slots = 0;
+  for (; nof_slots < nof_pusch; nof_slots++) {
+    pusch_slots[nof_slots] = {};
+    if (!prepare_pusch(grants[nof_slots], pusch_slots[nof_slots])) {
+      break;
     }
   }
+
+  // This thread and the helpers take the next pending grant until all of them are decoded
+  uint32_t nof_helpers = SRSRAN_MIN((uint32_t)pusch_decoders.size(), SRSRAN_MAX(nof_slots, 1) - 1);
+  pusch_next_slot      = 0;
+  pusch_pending        = nof_helpers;
+  for (uint32_t i = 0; i < nof_helpers; i++) {
+    pusch_pool->push_task([this, i, nof_slots]() {
+      run_pusch_slots(pusch_decoders[i], nof_slots);
+      std::lock_guard<std::mutex> lock(pusch_mutex);
+      pusch_pending--;
+      pusch_cvar.notify_one();
+    });
+  }
+  run_pusch_slots(enb_ul, nof_slots);
+  {
+    std::unique_lock<std::mutex> lock(pusch_mutex);
+    pusch_cvar.wait(lock, [this]() { return pusch_pending == 0; });
+  }
+
+  // Notify the MAC in grant order, as the serial decoding does
+  for (uint32_t i = 0; i < nof_slots; i++) {
+    if (!pusch_slots[i].decoded) {
+      return;
+    }
+    report_pusch(pusch_slots[i]);
+  }
+}
+
+void cc_worker::gen_signal_ports(uint32_t thread_idx)
+{
+  for (uint32_t p = thread_idx; p < enb_dl.cell.nof_ports; p += tx_helpers + 1) {
+    srsran_enb_dl_gen_signal_port(&enb_dl, p);
+  }
+}
+
+void cc_worker::gen_signal()
+{
+  if (!tx_pool) {
+    srsran_enb_dl_gen_signal(&enb_dl);
+    return;
+  }
+
+  tx_pending = tx_helpers;
+  for (uint32_t i = 0; i < tx_helpers; i++) {
+    tx_pool->push_task([this, i]() {
+      gen_signal_ports(i + 1);
+      std::lock_guard<std::mutex> lock(tx_mutex);
+      tx_pending--;
+      tx_cvar.notify_one();
+    });
+  }
+  gen_signal_ports(0);
+  {
+    std::unique_lock<std::mutex> lock(tx_mutex);
+    tx_cvar.wait(lock, [this]() { return tx_pending == 0; });
+  }
 }
 
 int cc_worker::decode_pucch()
@@ -419,6 +674,7 @@ int cc_worker::decode_pucch()
 
   for (auto& iter : ue_db) {
     uint16_t rnti = iter.first;
+    ue&      user = iter.second;
 
     // If it's a User RNTI and doesn't have PUSCH grant in this TTI
     if (SRSRAN_RNTI_ISUSER(rnti) and phy->ue_db.is_pcell(rnti, cc_idx)) {
@@ -436,9 +692,13 @@ int cc_worker::decode_pucch()
         continue;
       }
 
+      // The ACKs of the DL SPS occasions use the persistent PUCCH resource
+      phy->ue_db.fill_sps_pucch_cfg(tti_rx, rnti, ul_cfg.pucch);
+
       // If ret is more than success, UCI is present
       if (ret > SRSRAN_SUCCESS) {
         // Decode PUCCH
+        demodulate_ul();
         if (srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &ul_cfg.pucch, &pucch_res)) {
           Error("Error getting PUCCH");
           continue;
@@ -464,9 +724,9 @@ int cc_worker::decode_pucch()
 
         // Save metrics
         if (pucch_res.detected) {
-          ue_db[rnti]->metrics_ul_pucch(pucch_res.rssi_dbFs - phy->params.rx_gain_offset,
-                                        pucch_res.ni_dbFs - -phy->params.rx_gain_offset,
-                                        pucch_res.snr_db);
+          user.metrics_ul_pucch(pucch_res.rssi_dbFs - phy->params.rx_gain_offset,
+                                pucch_res.ni_dbFs - -phy->params.rx_gain_offset,
+                                pucch_res.snr_db);
         }
       }
     }
@@ -474,25 +734,103 @@ int cc_worker::decode_pucch()
   return 0;
 }
 
+void cc_worker::decode_srs()
+{
+  srs_cfgs.clear();
+  srs_rntis.clear();
+
+  for (auto& iter : ue_db) {
+    uint16_t rnti = iter.first;
+    if (not SRSRAN_RNTI_ISUSER(rnti) or not phy->ue_db.ue_has_cell(rnti, cc_idx)) {
+      continue;
+    }
+
+    srsran_ul_cfg_t ul_cfg = {};
+    if (phy->ue_db.get_ul_config(rnti, cc_idx, ul_cfg) < SRSRAN_SUCCESS) {
+      Error("Error retrieving last UL configuration for RNTI %x, CC %d", rnti, cc_idx);
+      continue;
+    }
+
+    // Skip the UEs that do not sound in this subframe
+    if (not ul_cfg.srs.configured or
+        srsran_refsignal_srs_send_cs(ul_cfg.srs.subframe_config, tti_rx % SRSRAN_NOF_SF_X_FRAME) != 1 or
+        srsran_refsignal_srs_send_ue(ul_cfg.srs.I_srs, tti_rx) != 1) {
+      continue;
+    }
+    srs_cfgs.push_back(ul_cfg.srs);
+    srs_rntis.push_back(rnti);
+  }
+
+  if (srs_cfgs.empty()) {
+    return;
+  }
+
+  demodulate_ul();
+  if (srsran_chest_ul_srs_batch_estimate(&srs_batch,
+                                         &ul_sf,
+                                         srs_cfgs.data(),
+                                         srs_cfgs.size(),
+                                         &phy->dmrs_pusch_cfg,
+                                         enb_ul.sf_symbols,
+                                         srs_meas.data()) < SRSRAN_SUCCESS) {
+    Error("Error measuring the SRS of %zd UEs", srs_cfgs.size());
+    return;
+  }
+
+  for (uint32_t i = 0; i < srs_rntis.size(); i++) {
+    // The time alignment is tracked in the PCell
+    if (phy->ue_db.is_pcell(srs_rntis[i], cc_idx)) {
+      phy->stack->ta_info(tti_rx, srs_rntis[i], srs_meas[i].ta_us);
+    }
+    phy->stack->snr_info(tti_rx, srs_rntis[i], cc_idx, srs_meas[i].snr_db, mac_interface_phy_lte::SRS);
+    Info("SRS: cc=%d; rnti=0x%x; snr=%.1f dB; ta=%.1f us;",
+         cc_idx,
+         srs_rntis[i],
+         srs_meas[i].snr_db,
+         srs_meas[i].ta_us);
+  }
+}
+
 int cc_worker::encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks)
 {
+  if (nof_acks > phich_batch_grants.size()) {
+    Error("Discarding %zd of %d PHICH, the batch holds %zd",
+          nof_acks - phich_batch_grants.size(),
+          nof_acks,
+          phich_batch_grants.size());
+    nof_acks = phich_batch_grants.size();
+  }
+
+  uint32_t nof_phich = 0;
   for (uint32_t i = 0; i < nof_acks; i++) {
-    if (acks[i].rnti && ue_db.count(acks[i].rnti)) {
-      srsran_enb_dl_put_phich(&enb_dl, &ue_db[acks[i].rnti]->phich_grant, acks[i].ack);
+    if (acks[i].rnti && ue_db.contains(acks[i].rnti)) {
+      srsran_phich_grant_t& phich_grant = phich_grants[ue_idx(acks[i].rnti)];
+      phich_batch_grants[nof_phich]     = phich_grant;
+      phich_batch_acks[nof_phich]       = acks[i].ack;
+      nof_phich++;
 
       Info("PHICH: rnti=0x%x, hi=%d, I_lowest=%d, n_dmrs=%d, tti_tx_dl=%d",
            acks[i].rnti,
            acks[i].ack,
-           ue_db[acks[i].rnti]->phich_grant.n_prb_lowest,
-           ue_db[acks[i].rnti]->phich_grant.n_dmrs,
+           phich_grant.n_prb_lowest,
+           phich_grant.n_dmrs,
            tti_tx_dl);
     }
   }
-  return SRSRAN_SUCCESS;
+  return srsran_enb_dl_put_phich_batch(&enb_dl, phich_batch_grants.data(), phich_batch_acks.data(), nof_phich);
 }
 
 int cc_worker::encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_grants)
 {
+  if (nof_grants > pdcch_batch_msgs.size()) {
+    Error("Discarding %zd of %d PUSCH grants, the PDCCH batch holds %zd",
+          nof_grants - pdcch_batch_msgs.size(),
+          nof_grants,
+          pdcch_batch_msgs.size());
+    nof_grants = pdcch_batch_msgs.size();
+  }
+
+  uint32_t nof_msgs = 0;
   for (uint32_t i = 0; i < nof_grants; i++) {
     if (grants[i].needs_pdcch) {
       srsran_dci_cfg_t dci_cfg = {};
@@ -510,7 +848,13 @@ int cc_worker::encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants
         }
       }
 
-      if (srsran_enb_dl_put_pdcch_ul(&enb_dl, &dci_cfg, &grants[i].dci)) {
+      // The CRC of the UL SPS activations and retxs is scrambled with the SPS C-RNTI
+      srsran_dci_ul_t dci = grants[i].dci;
+      if (grants[i].sps_crnti != SRSRAN_INVALID_RNTI) {
+        dci.rnti = grants[i].sps_crnti;
+      }
+
+      if (srsran_enb_dl_pack_pdcch_ul(&enb_dl, &dci_cfg, &dci, &pdcch_batch_msgs[nof_msgs++])) {
         Error("Error putting PUSCH %d", i);
         return SRSRAN_ERROR;
       }
@@ -523,14 +867,28 @@ int cc_worker::encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants
       }
     }
   }
+
+  if (srsran_enb_dl_put_pdcch_batch(&enb_dl, pdcch_batch_msgs.data(), nof_msgs)) {
+    Error("Error putting the PDCCH of %d PUSCH grants", nof_msgs);
+    return SRSRAN_ERROR;
+  }
   return SRSRAN_SUCCESS;
 }
 
 int cc_worker::encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants)
 {
+  if (nof_grants > pdcch_batch_msgs.size()) {
+    Error("Discarding %zd of %d PDSCH grants, the PDCCH batch holds %zd",
+          nof_grants - pdcch_batch_msgs.size(),
+          nof_grants,
+          pdcch_batch_msgs.size());
+    nof_grants = pdcch_batch_msgs.size();
+  }
+
+  uint32_t nof_msgs = 0;
   for (uint32_t i = 0; i < nof_grants; i++) {
     uint16_t rnti = grants[i].dci.rnti;
-    if (rnti) {
+    if (rnti and grants[i].needs_pdcch) {
       srsran_dci_cfg_t dci_cfg = {};
 
       if (phy->ue_db.get_dci_dl_config(grants[i].dci.rnti, cc_idx, dci_cfg) < SRSRAN_SUCCESS) {
@@ -547,7 +905,13 @@ int cc_worker::encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants
         }
       }
 
-      if (srsran_enb_dl_put_pdcch_dl(&enb_dl, &dci_cfg, &grants[i].dci)) {
+      // The CRC of the DL SPS activations, releases and retxs is scrambled with the SPS C-RNTI
+      srsran_dci_dl_t dci = grants[i].dci;
+      if (grants[i].sps_crnti != SRSRAN_INVALID_RNTI) {
+        dci.rnti = grants[i].sps_crnti;
+      }
+
+      if (srsran_enb_dl_pack_pdcch_dl(&enb_dl, &dci_cfg, &dci, &pdcch_batch_msgs[nof_msgs++])) {
         ERROR("Error putting PDCCH %d", i);
         return SRSRAN_ERROR;
       }
@@ -560,6 +924,11 @@ int cc_worker::encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants
       }
     }
   }
+
+  if (srsran_enb_dl_put_pdcch_batch(&enb_dl, pdcch_batch_msgs.data(), nof_msgs)) {
+    ERROR("Error putting the PDCCH of %d PDSCH grants", nof_msgs);
+    return SRSRAN_ERROR;
+  }
   return 0;
 }
 
@@ -570,7 +939,15 @@ int cc_worker::encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srs
   srsran_configure_pmch(&pmch_cfg, &enb_dl.cell, mbsfn_cfg);
   srsran_ra_dl_compute_nof_re(&enb_dl.cell, &dl_sf, &pmch_cfg.pdsch_cfg.grant);
 
-  // Set soft buffer
+  // Set soft buffer, it is only allocated when the cell transmits its first MBSFN subframe
+  if (not mbsfn_softbuffer_ready) {
+    if (srsran_softbuffer_tx_init(&temp_mbsfn_softbuffer, enb_dl.cell.nof_prb)) {
+      Error("Error initiating MBSFN soft buffer");
+      return SRSRAN_ERROR;
+    }
+    srsran_softbuffer_tx_reset(&temp_mbsfn_softbuffer);
+    mbsfn_softbuffer_ready = true;
+  }
   pmch_cfg.pdsch_cfg.softbuffers.tx[0] = &temp_mbsfn_softbuffer;
 
   // Encode PMCH
@@ -587,8 +964,9 @@ int cc_worker::encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srs
   }
 
   // Save metrics stats
-  if (ue_db.count(SRSRAN_MRNTI)) {
-    ue_db[SRSRAN_MRNTI]->metrics_dl(mbsfn_cfg->mbsfn_mcs);
+  auto it = ue_db.find(SRSRAN_MRNTI);
+  if (it != ue_db.end()) {
+    it->second.metrics_dl(mbsfn_cfg->mbsfn_mcs);
   }
   return SRSRAN_SUCCESS;
 }
@@ -600,7 +978,12 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
   for (uint32_t i = 0; i < nof_grants; i++) {
     uint16_t rnti = grants[i].dci.rnti;
 
-    if (rnti && ue_db.count(rnti)) {
+    // The DL SPS releases have no PDSCH
+    if (not grants[i].has_pdsch) {
+      continue;
+    }
+
+    if (rnti && is_known_rnti(rnti)) {
       srsran_dl_cfg_t dl_cfg = {};
 
       if (phy->ue_db.get_dl_config(rnti, cc_idx, dl_cfg) < SRSRAN_SUCCESS) {
@@ -620,6 +1003,11 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
         dl_cfg.pdsch.softbuffers.tx[j] = grants[i].softbuffer_tx[j];
       }
 
+      // The PDSCH of the DL SPS grants is scrambled with the SPS C-RNTI
+      if (grants[i].sps_crnti != SRSRAN_INVALID_RNTI) {
+        dl_cfg.pdsch.rnti = grants[i].sps_crnti;
+      }
+
       // Encode PDSCH
       if (srsran_enb_dl_put_pdsch(&enb_dl, &dl_cfg.pdsch, grants[i].data)) {
         Error("Error putting PDSCH %d", i);
@@ -629,7 +1017,7 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
       // Save pending ACK
       if (SRSRAN_RNTI_ISUSER(rnti)) {
         // Push whole DCI
-        phy->ue_db.set_ack_pending(tti_tx_ul, cc_idx, grants[i].dci);
+        phy->ue_db.set_ack_pending(tti_tx_ul, cc_idx, grants[i].dci, grants[i].n1_pucch_an);
       }
 
       if (LOG_THIS(rnti) and logger.info.enabled()) {
@@ -640,7 +1028,10 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
       }
 
       // Save metrics stats
-      ue_db[rnti]->metrics_dl(grants[i].dci.tb[0].mcs_idx);
+      auto it = ue_db.find(rnti);
+      if (it != ue_db.end()) {
+        it->second.metrics_dl(grants[i].dci.tb[0].mcs_idx);
+      }
     } else {
       Error("User rnti=0x%x not found in cc_worker=%d", rnti, cc_idx);
     }
@@ -658,9 +1049,7 @@ uint32_t cc_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
   uint32_t                    cnt = 0;
   metrics.resize(ue_db.size());
   for (auto& ue : ue_db) {
-    if ((SRSRAN_RNTI_ISUSER(ue.first) || ue.first == SRSRAN_MRNTI)) {
-      ue.second->metrics_read(&metrics[cnt++]);
-    }
+    ue.second.metrics_read(&metrics[cnt++]);
   }
   metrics.resize(cnt);
   return cnt;
@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/threads.h"
+#include "srsran/common/tti_trace.h"
 #include "srsran/srsran.h"
 
 #include "srsenb/hdr/phy/lte/sf_worker.h"
@@ -63,15 +64,9 @@ static int plot_worker_id = -1;
 
 using namespace asn1::rrc;
 
-//#define DEBUG_WRITE_FILE
-
 namespace srsenb {
 namespace lte {
 
-#ifdef DEBUG_WRITE_FILE
-FILE* f;
-#endif
-
 void sf_worker::init(phy_common* phy_)
 {
   phy = phy_;
@@ -88,21 +83,14 @@ void sf_worker::init(phy_common* phy_)
     cc_workers.push_back(std::unique_ptr<cc_worker>(q));
   }
 
-  if (srsran_softbuffer_tx_init(&temp_mbsfn_softbuffer, phy->get_nof_prb(0))) {
-    ERROR("Error initiating soft buffer");
-    exit(-1);
+  if (phy->params.dl_pipeline) {
+    dl_pool.reset(new srsran::task_thread_pool(1));
   }
 
-  srsran_softbuffer_tx_reset(&temp_mbsfn_softbuffer);
-
   Info("Worker %d configured cell %d PRB", get_id(), phy->get_nof_prb(0));
 
   initiated = true;
   running   = true;
-
-#ifdef DEBUG_WRITE_FILE
-  f = fopen("test.dat", "w");
-#endif
 }
 
 cf_t* sf_worker::get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx)
@@ -118,6 +106,9 @@ void sf_worker::set_context(const srsran::phy_common_interface::worker_context_t
 
   context.copy(w_ctx);
 
+  // The subframe has just been received, it is transmitted FDD_HARQ_DELAY_UL_MS after its start
+  timing.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(FDD_HARQ_DELAY_UL_MS - 1);
+
   for (auto& w : cc_workers) {
     w->set_tti(w_ctx.sf_idx);
   }
@@ -150,6 +141,7 @@ uint32_t sf_worker::get_nof_rnti()
 void sf_worker::work_imp()
 {
   std::lock_guard<std::mutex> lock(work_mutex);
+  srsran::tti_trace_scope     trace_scope(srsran::tti_trace_event::sf_worker_work, tti_rx);
 
   srsran_ul_sf_cfg_t ul_sf = {};
   srsran_dl_sf_cfg_t dl_sf = {};
@@ -180,18 +172,44 @@ void sf_worker::work_imp()
 
   Debug("Worker %d running", get_id());
 
+  timing.rx           = std::chrono::steady_clock::now();
+  timing.nof_carriers = cc_workers.size();
+
   // Configure UL subframe
   ul_sf.tti = tti_rx;
 
+  // Capture the received subframe before the UL processing, which converts the sc16 samples in place
+  if (phy->iq_capture.is_running()) {
+    for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+      srsran::bounded_vector<uint16_t, srsran::iq_tap::max_nof_rntis> rntis;
+      for (uint32_t i = 0; i < ul_grants[cc].nof_grants and not rntis.full(); i++) {
+        rntis.push_back(ul_grants[cc].pusch[i].dci.rnti);
+      }
+      capture_iq(srsran::iq_tap::direction_t::rx, tti_rx, cc, rntis);
+    }
+  }
+
   // Set UL grant availability prior to any UL processing
   if (phy->ue_db.set_ul_grant_available(tti_rx, ul_grants) < SRSRAN_SUCCESS) {
     Info("Failed setting UL grants. Some grant's RNTI does not exist.");
   }
 
-  // Process UL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+  // Process UL, the carriers are handed to the idle PHY workers if task stealing is enabled
+  for_each_carrier([this, &ul_sf, &ul_grants](uint32_t cc) {
     cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
+    timing.ul_decode[cc] = std::chrono::steady_clock::now();
+  });
+
+  // Configure DL subframe
+  dl_sf.tti              = tti_tx_dl;
+  dl_sf.sf_type          = sf_type;
+  dl_sf.non_mbsfn_region = mbsfn_cfg.non_mbsfn_region_length;
+
+  // The UL feedback is complete, the MAC can schedule while the base signals, which do not depend on it, are put
+  if (sf_type == SRSRAN_SF_NORM) {
+    stack->start_dl_sched(tti_tx_dl);
   }
+  for_each_carrier([this, &dl_sf](uint32_t cc) { cc_workers[cc]->work_dl_base(dl_sf); });
 
   // Get DL scheduling for the TX TTI from MAC
   if (sf_type == SRSRAN_SF_NORM) {
@@ -210,53 +228,68 @@ void sf_worker::work_imp()
   }
 
   // Get UL scheduling for the TX TTI from MAC
-  if (stack->get_ul_sched(tti_tx_ul, ul_grants_tx) < 0) {
-    Error("Getting UL scheduling from MAC");
+  auto get_ul_sched = [this, stack, &ul_grants_tx]() {
+    if (stack->get_ul_sched(tti_tx_ul, ul_grants_tx) < 0) {
+      Error("Getting UL scheduling from MAC");
+      return false;
+    }
+    timing.mac_sched = std::chrono::steady_clock::now();
+    return true;
+  };
+
+  // Without the DL pipeline the UL is scheduled right after the DL
+  if (not dl_pool and not get_ul_sched()) {
     phy->worker_end(context, true, tx_buffer);
     return;
   }
 
-  // Configure DL subframe
-  dl_sf.tti              = tti_tx_dl;
-  dl_sf.sf_type          = sf_type;
-  dl_sf.non_mbsfn_region = mbsfn_cfg.non_mbsfn_region_length;
-
   // Prepare for receive ACK for DL grants in t_tx_dl+4
   phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
 
   // Process DL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    // Select CFI and make sure it is in the right range
-    dl_sf.cfi = dl_grants[cc].cfi;
-    dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
-    dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
-
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+  if (dl_pool) {
+    // The PDSCH only depends on the DL scheduling, the helper encodes it while the MAC schedules the UL
+    start_dl_data(dl_sf, dl_grants, &mbsfn_cfg);
+    bool ul_sched_ok = get_ul_sched();
+    wait_dl_data();
+    if (not ul_sched_ok) {
+      phy->worker_end(context, true, tx_buffer);
+      return;
+    }
+  } else {
+    work_dl_data(dl_sf, dl_grants, &mbsfn_cfg);
   }
+  // The PDCCH UL grants, PHICH and signal generation of each carrier are independent up to the TX combine
+  for_each_carrier([this, &ul_grants_tx](uint32_t cc) { cc_workers[cc]->work_dl_ctrl(ul_grants_tx[cc]); });
+  timing.dl_encode = std::chrono::steady_clock::now();
 
   // Save grants
   phy->set_ul_grants(tti_tx_ul, ul_grants_tx);
 
   // Set or combine RF ports
+  tx_buffer.set_sc16(phy->is_sc16());
   for (uint32_t cc = 0; cc < phy->get_nof_carriers_lte(); cc++) {
     for (uint32_t ant = 0; ant < phy->get_nof_ports(0); ant++) {
       tx_buffer.set_combine(phy->get_rf_port(cc), ant, phy->get_nof_ports(0), cc_workers[cc]->get_buffer_tx(ant));
     }
   }
 
+  if (phy->iq_capture.is_running()) {
+    for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+      srsran::bounded_vector<uint16_t, srsran::iq_tap::max_nof_rntis> rntis;
+      for (uint32_t i = 0; i < dl_grants[cc].nof_grants and not rntis.full(); i++) {
+        if (dl_grants[cc].pdsch[i].has_pdsch) {
+          rntis.push_back(dl_grants[cc].pdsch[i].dci.rnti);
+        }
+      }
+      capture_iq(srsran::iq_tap::direction_t::tx, tti_tx_dl, cc, rntis);
+    }
+  }
+
   Debug("Sending to radio");
   phy->worker_end(context, true, tx_buffer);
-
-#ifdef DEBUG_WRITE_FILE
-  fwrite(signal_buffer_tx, SRSRAN_SF_LEN_PRB(phy->cell.nof_prb) * sizeof(cf_t), 1, f);
-#endif
-
-#ifdef DEBUG_WRITE_FILE
-  if (tti_tx_dl == 10) {
-    fclose(f);
-    exit(-1);
-  }
-#endif
+  timing.tx_submit = std::chrono::steady_clock::now();
+  phy->add_tti_timing(timing);
 
   /* Tell the plotting thread to draw the plots */
 #ifdef ENABLE_GUI
@@ -266,6 +299,71 @@ void sf_worker::work_imp()
 #endif
 }
 
+void sf_worker::capture_iq(srsran::iq_tap::direction_t  dir,
+                           uint32_t                     tti,
+                           uint32_t                     cc,
+                           srsran::span<const uint16_t> rntis)
+{
+  uint32_t nof_samples = SRSRAN_SF_LEN_PRB(phy->get_nof_prb(cc));
+  uint32_t nof_bytes   = phy->is_sc16() ? nof_samples * 2 * sizeof(int16_t) : nof_samples * sizeof(cf_t);
+  for (uint32_t port = 0; port < phy->get_nof_ports(cc); port++) {
+    cf_t* buffer = (dir == srsran::iq_tap::direction_t::rx) ? cc_workers[cc]->get_buffer_rx(port)
+                                                            : cc_workers[cc]->get_buffer_tx(port);
+    phy->iq_capture.push(dir, tti, cc, port, phy->is_sc16(), buffer, nof_bytes, rntis);
+  }
+}
+
+void sf_worker::work_dl_data(const srsran_dl_sf_cfg_t&                 dl_sf,
+                             stack_interface_phy_lte::dl_sched_list_t& dl_grants,
+                             srsran_mbsfn_cfg_t*                       mbsfn_cfg)
+{
+  srsran::thread_pool::task_group group;
+  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+    // Select CFI and make sure it is in the right range
+    srsran_dl_sf_cfg_t cc_dl_sf = dl_sf;
+    cc_dl_sf.cfi                = dl_grants[cc].cfi;
+    cc_dl_sf.cfi                = SRSRAN_MAX(cc_dl_sf.cfi, 1);
+    cc_dl_sf.cfi                = SRSRAN_MIN(cc_dl_sf.cfi, 3);
+
+    if (split_carriers()) {
+      push_task(group, [this, cc, cc_dl_sf, &dl_grants, mbsfn_cfg]() mutable {
+        cc_workers[cc]->work_dl_data(cc_dl_sf, dl_grants[cc], mbsfn_cfg);
+      });
+    } else {
+      cc_workers[cc]->work_dl_data(cc_dl_sf, dl_grants[cc], mbsfn_cfg);
+    }
+  }
+  wait_tasks(group);
+}
+
+bool sf_worker::split_carriers() const
+{
+  return phy->params.phy_task_stealing && cc_workers.size() > 1;
+}
+
+void sf_worker::start_dl_data(const srsran_dl_sf_cfg_t&                 dl_sf,
+                              stack_interface_phy_lte::dl_sched_list_t& dl_grants,
+                              srsran_mbsfn_cfg_t*                       mbsfn_cfg)
+{
+  {
+    std::lock_guard<std::mutex> lock(dl_mutex);
+    dl_pending = true;
+  }
+  // The arguments live in work_imp(), which waits for the task before returning
+  dl_pool->push_task([this, &dl_sf, &dl_grants, mbsfn_cfg]() {
+    work_dl_data(dl_sf, dl_grants, mbsfn_cfg);
+    std::lock_guard<std::mutex> lock(dl_mutex);
+    dl_pending = false;
+    dl_cvar.notify_one();
+  });
+}
+
+void sf_worker::wait_dl_data()
+{
+  std::unique_lock<std::mutex> lock(dl_mutex);
+  dl_cvar.wait(lock, [this]() { return !dl_pending; });
+}
+
 /************ METRICS interface ********************/
 uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
@@ -340,10 +438,7 @@ int sf_worker::read_pucch_d(uint32_t cc_idx, cf_t* pdsch_d)
   return cc_workers[cc_idx]->read_pucch_d(pdsch_d);
 }
 
-sf_worker::~sf_worker()
-{
-  srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
-}
+sf_worker::~sf_worker() {}
 
 } // namespace lte
 } // namespace srsenb
@@ -19,6 +19,7 @@
  *
  */
 #include "srsenb/hdr/phy/lte/worker_pool.h"
+#include <thread>
 
 namespace srsenb {
 namespace lte {
@@ -29,15 +30,31 @@ bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink&
 {
   // Add workers to workers pool and start threads.
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
+  pool.set_thread_class(srsran::thread_class_t::phy_worker);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i), log_sink);
     log.set_level(log_level);
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
+    workers.push_back(std::unique_ptr<lte::sf_worker>(new sf_worker(log)));
+  }
+
+  // The workers allocate their buffers and plan their FFTs independently of each other, so they are initialised in
+  // parallel to shorten the start up. Each thread places the worker buffers and helper threads as the worker threads
+  std::vector<std::thread> init_threads;
+  init_threads.reserve(workers.size());
+  for (auto& w : workers) {
+    sf_worker* worker = w.get();
+    init_threads.emplace_back([worker, common]() {
+      srsran::scoped_thread_affinity affinity(srsran::thread_class_t::phy_worker);
+      worker->init(common);
+    });
+  }
+  for (auto& t : init_threads) {
+    t.join();
+  }
 
-    auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
-    pool.init_worker(i, w.get(), prio);
-    workers.push_back(std::move(w));
+  for (uint32_t i = 0; i < workers.size(); i++) {
+    pool.init_worker(i, workers[i].get(), prio);
   }
 
   return true;
@@ -89,14 +89,16 @@ bool slot_worker::init(const args_t& args)
   }
 
   // Prepare UL arguments
-  srsran_gnb_ul_args_t ul_args   = {};
-  ul_args.pusch.measure_time     = true;
-  ul_args.pusch.measure_evm      = true;
-  ul_args.pusch.max_layers       = args.nof_rx_ports;
-  ul_args.pusch.sch.max_nof_iter = args.pusch_max_its;
-  ul_args.pusch.max_prb          = args.nof_max_prb;
-  ul_args.nof_max_prb            = args.nof_max_prb;
-  ul_args.pusch_min_snr_dB       = args.pusch_min_snr_dB;
+  srsran_gnb_ul_args_t ul_args     = {};
+  ul_args.pusch.measure_time       = true;
+  ul_args.pusch.measure_evm        = true;
+  ul_args.pusch.max_layers         = args.nof_rx_ports;
+  ul_args.pusch.sch.max_nof_iter   = args.pusch_max_its;
+  ul_args.pusch.sch.nof_cb_workers = args.pusch_cb_workers;
+  ul_args.pusch.sch.defer_small_cb = true;
+  ul_args.pusch.max_prb            = args.nof_max_prb;
+  ul_args.nof_max_prb              = args.nof_max_prb;
+  ul_args.pusch_min_snr_dB         = args.pusch_min_snr_dB;
 
   // Initialise UL
   if (srsran_gnb_ul_init(&gnb_ul, rx_buffer[0], &ul_args) < SRSRAN_SUCCESS) {
@@ -104,6 +106,10 @@ bool slot_worker::init(const args_t& args)
     return false;
   }
 
+  if (args.dl_early_symbols) {
+    dl_pool.reset(new srsran::task_thread_pool(1));
+  }
+
 #ifdef DEBUG_WRITE_FILE
   const char* filename = "nr_baseband.dat";
   printf("Opening %s to dump baseband\n", filename);
@@ -234,16 +240,23 @@ bool slot_worker::work_ul()
     }
   }
 
+  // Decode every PUSCH before informing the stack, the transport blocks of a single small code block are decoded
+  // together once all of them are demodulated
+  srsran::bounded_vector<stack_interface_phy_nr::pusch_info_t, stack_interface_phy_nr::MAX_GRANTS> pusch_info_list;
+
   // For each PUSCH...
   for (stack_interface_phy_nr::pusch_t& pusch : ul_sched->pusch) {
     // Prepare PUSCH
-    stack_interface_phy_nr::pusch_info_t pusch_info = {};
-    pusch_info.uci_cfg                              = pusch.sch.uci;
-    pusch_info.pid                                  = pusch.pid;
-    pusch_info.rnti                                 = pusch.sch.grant.rnti;
-    pusch_info.pdu                                  = srsran::make_byte_buffer();
+    pusch_info_list.emplace_back();
+    stack_interface_phy_nr::pusch_info_t& pusch_info = pusch_info_list.back();
+    pusch_info.uci_cfg                               = pusch.sch.uci;
+    pusch_info.pid                                   = pusch.pid;
+    pusch_info.rnti                                  = pusch.sch.grant.rnti;
+    pusch_info.pdu                                   = srsran::make_byte_buffer();
     if (pusch_info.pdu == nullptr) {
       logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+      // Do not leave deferred transport blocks pointing to this slot PUSCH data
+      srsran_gnb_ul_flush_pusch(&gnb_ul);
       return false;
     }
     pusch_info.pdu->N_bytes             = pusch.sch.grant.tb[0].tbs / 8;
@@ -253,11 +266,23 @@ bool slot_worker::work_ul()
     if (srsran_gnb_ul_get_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
         SRSRAN_SUCCESS) {
       logger.error("Error getting PUSCH");
+      srsran_gnb_ul_flush_pusch(&gnb_ul);
       return false;
     }
 
     // Extract DMRS information
     pusch_info.csi = gnb_ul.dmrs.csi;
+  }
+
+  // Decode the deferred transport blocks
+  if (srsran_gnb_ul_flush_pusch(&gnb_ul) < SRSRAN_SUCCESS) {
+    logger.error("Error decoding PUSCH");
+    return false;
+  }
+
+  for (uint32_t i = 0; i < pusch_info_list.size(); i++) {
+    const stack_interface_phy_nr::pusch_t& pusch      = ul_sched->pusch[i];
+    stack_interface_phy_nr::pusch_info_t&  pusch_info = pusch_info_list[i];
 
     // Inform stack
     if (stack.pusch_info(ul_slot_cfg, pusch_info) < SRSRAN_SUCCESS) {
@@ -267,8 +292,11 @@ bool slot_worker::work_ul()
 
     // Log PUSCH decoding
     if (logger.info.enabled()) {
+      // The channel estimate of the gNb UL object belongs to the last PUSCH, use the one saved for this PUSCH
       std::array<char, 512> str;
-      srsran_gnb_ul_pusch_info(&gnb_ul, &pusch.sch, &pusch_info.pusch_data, str.data(), (uint32_t)str.size());
+      uint32_t              len = srsran_pusch_nr_rx_info(
+          &gnb_ul.pusch, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data, str.data(), (uint32_t)str.size());
+      srsran_csi_meas_info_short(&pusch_info.csi, &str[len], (uint32_t)str.size() - len);
 
       if (logger.debug.enabled()) {
         std::array<char, 1024> str_extra = {};
@@ -348,8 +376,42 @@ bool slot_worker::work_dl()
     }
   }
 
+  // The symbols before the first PDSCH symbol are ready, the helper modulates them while the PDSCH is encoded
+  uint32_t nof_early_symbols = (dl_pool) ? get_nof_early_symbols(*dl_sched_ptr) : 0;
+  if (nof_early_symbols > 0) {
+    start_early_symbols(nof_early_symbols);
+  }
+
+  bool ret = work_dl_data(*dl_sched_ptr);
+
+  // Generate baseband signal
+  if (nof_early_symbols > 0) {
+    wait_early_symbols();
+    if (ret) {
+      srsran_gnb_dl_gen_symbols(&gnb_dl, nof_early_symbols, SRSRAN_NSYMB_PER_SLOT_NR - nof_early_symbols);
+    }
+  } else if (ret) {
+    srsran_gnb_dl_gen_signal(&gnb_dl);
+  }
+  if (not ret) {
+    return false;
+  }
+
+  // Add SSB to the baseband signal
+  for (const stack_interface_phy_nr::ssb_t& ssb : dl_sched_ptr->ssb) {
+    if (srsran_gnb_dl_add_ssb(&gnb_dl, &ssb.pbch_msg, dl_slot_cfg.idx) < SRSRAN_SUCCESS) {
+      logger.error("SSB: Error putting signal");
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool slot_worker::work_dl_data(const stack_interface_phy_nr::dl_sched_t& dl_sched)
+{
   // Encode PDSCH
-  for (const stack_interface_phy_nr::pdsch_t& pdsch : dl_sched_ptr->pdsch) {
+  for (const stack_interface_phy_nr::pdsch_t& pdsch : dl_sched.pdsch) {
     // convert MAC to PHY buffer data structures
     uint8_t* data[SRSRAN_MAX_TB] = {};
     for (uint32_t i = 0; i < SRSRAN_MAX_TB; ++i) {
@@ -380,25 +442,53 @@ bool slot_worker::work_dl()
   }
 
   // Put NZP-CSI-RS
-  for (const srsran_csi_rs_nzp_resource_t& nzp_csi_rs : dl_sched_ptr->nzp_csi_rs) {
+  for (const srsran_csi_rs_nzp_resource_t& nzp_csi_rs : dl_sched.nzp_csi_rs) {
     if (srsran_gnb_dl_nzp_csi_rs_put(&gnb_dl, &dl_slot_cfg, &nzp_csi_rs) < SRSRAN_SUCCESS) {
       logger.error("NZP-CSI-RS: Error putting signal");
       return false;
     }
   }
 
-  // Generate baseband signal
-  srsran_gnb_dl_gen_signal(&gnb_dl);
+  return true;
+}
 
-  // Add SSB to the baseband signal
-  for (const stack_interface_phy_nr::ssb_t& ssb : dl_sched_ptr->ssb) {
-    if (srsran_gnb_dl_add_ssb(&gnb_dl, &ssb.pbch_msg, dl_slot_cfg.idx) < SRSRAN_SUCCESS) {
-      logger.error("SSB: Error putting signal");
-      return false;
+uint32_t slot_worker::get_nof_early_symbols(const stack_interface_phy_nr::dl_sched_t& dl_sched) const
+{
+  // The DMRS and PT-RS of a PDSCH lie within its allocated symbols
+  uint32_t nof_symbols = SRSRAN_NSYMB_PER_SLOT_NR;
+  for (const stack_interface_phy_nr::pdsch_t& pdsch : dl_sched.pdsch) {
+    nof_symbols = SRSRAN_MIN(nof_symbols, pdsch.sch.grant.S);
+  }
+  for (const srsran_csi_rs_nzp_resource_t& nzp_csi_rs : dl_sched.nzp_csi_rs) {
+    const srsran_csi_rs_resource_mapping_t& mapping = nzp_csi_rs.resource_mapping;
+    nof_symbols = SRSRAN_MIN(nof_symbols, mapping.first_symbol_idx);
+    if (mapping.first_symbol_idx2 != 0) {
+      nof_symbols = SRSRAN_MIN(nof_symbols, mapping.first_symbol_idx2);
     }
   }
 
-  return true;
+  // A slot without PDSCH nor NZP-CSI-RS has nothing to overlap with
+  return (nof_symbols < SRSRAN_NSYMB_PER_SLOT_NR) ? nof_symbols : 0;
+}
+
+void slot_worker::start_early_symbols(uint32_t nof_symbols)
+{
+  {
+    std::lock_guard<std::mutex> lock(dl_mutex);
+    dl_pending = true;
+  }
+  dl_pool->push_task([this, nof_symbols]() {
+    srsran_gnb_dl_gen_symbols(&gnb_dl, 0, nof_symbols);
+    std::lock_guard<std::mutex> lock(dl_mutex);
+    dl_pending = false;
+    dl_cvar.notify_one();
+  });
+}
+
+void slot_worker::wait_early_symbols()
+{
+  std::unique_lock<std::mutex> lock(dl_mutex);
+  dl_cvar.wait(lock, [this]() { return !dl_pending; });
 }
 
 void slot_worker::work_imp()
@@ -54,6 +54,7 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
   logger.set_level(log_level);
 
   // Add workers to workers pool and start threads
+  pool.set_thread_class(srsran::thread_class_t::phy_worker);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}-NR", args.log.id_preamble, i), log_sink);
     log.set_level(log_level);
@@ -72,8 +73,12 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.rf_port                 = cell_list[cell_index].rf_port;
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
+    w_args.pusch_cb_workers        = args.pusch_cb_workers;
+    w_args.dl_early_symbols        = args.dl_early_symbols;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
 
+    // Place the worker buffers and helper threads created here as the worker threads
+    srsran::scoped_thread_affinity affinity(srsran::thread_class_t::phy_worker);
     if (not w->init(w_args)) {
       return false;
     }
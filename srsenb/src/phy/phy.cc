@@ -173,7 +173,9 @@ int phy::init_lte(const phy_args_t&            args,
 
   workers_common.params = args;
 
-  workers_common.init(cfg.phy_cell_cfg, cfg.phy_cell_cfg_nr, radio, stack_lte_);
+  if (not workers_common.init(cfg.phy_cell_cfg, cfg.phy_cell_cfg_nr, radio, stack_lte_)) {
+    return SRSRAN_ERROR;
+  }
   if (cfg.cfr_config.cfr_enable) {
     workers_common.set_cfr_config(cfg.cfr_config);
   }
@@ -286,6 +288,11 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
   }
 }
 
+void phy::get_timing_metrics(phy_timing_metrics_t& m)
+{
+  workers_common.get_timing_metrics(m);
+}
+
 void phy::cmd_cell_gain(uint32_t cell_id, float gain_db)
 {
   Info("set_cell_gain: cell_id=%d, gain_db=%.2f", cell_id, gain_db);
@@ -376,6 +383,8 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.pusch_cb_workers        = args.nr_pusch_cb_workers;
+  worker_args.dl_early_symbols        = args.nr_dl_early_symbols;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
@@ -50,6 +50,16 @@ bool phy_common::init(const phy_cell_cfg_list_t&    cell_list_,
   cell_list_lte = cell_list_;
   cell_list_nr  = cell_list_nr_;
 
+  // The PHY workers wait on the semaphore to transmit in order
+  semaphore.set_thread_class(srsran::thread_class_t::phy_worker);
+
+  // The sc16 samples are demodulated and modulated as they come from and go to the radio, without any processing
+  srsran_rf_info_t* rf_info = (radio != nullptr) ? radio->get_info() : nullptr;
+  sc16                      = rf_info != nullptr and rf_info->sc16;
+  if (sc16 and (params.dl_channel_args.enable or params.ul_channel_args.enable or not cell_list_nr.empty())) {
+    srslog::fetch_basic_logger("PHY").error("The sc16 sample format supports neither channel emulators nor NR cells");
+    return false;
+  }
 
   // Instantiate DL channel emulator
   if (params.dl_channel_args.enable) {
@@ -74,6 +84,19 @@ bool phy_common::init(const phy_cell_cfg_list_t&    cell_list_,
     build_mcch_table();
   }
 
+  // The capture slots hold a subframe of the widest carrier in the cf_t format, sc16 buffers take half of it
+  if (params.iq_tap_enable and not cell_list_lte.empty()) {
+    uint32_t max_prb = 0;
+    for (const auto& cell : cell_list_lte) {
+      max_prb = SRSRAN_MAX(max_prb, cell.cell.nof_prb);
+    }
+    if (not iq_capture.start(
+            params.iq_tap_filename, params.iq_tap_ring_sz, SRSRAN_SF_LEN_PRB(max_prb) * sizeof(cf_t))) {
+      srslog::fetch_basic_logger("PHY").error("Error starting the IQ capture to %s", params.iq_tap_filename.c_str());
+      return false;
+    }
+  }
+
   reset();
   return true;
 }
@@ -81,6 +104,13 @@ bool phy_common::init(const phy_cell_cfg_list_t&    cell_list_,
 void phy_common::stop()
 {
   semaphore.wait_all();
+
+  if (iq_capture.is_running()) {
+    iq_capture.stop();
+    if (iq_capture.nof_dropped() > 0) {
+      srsran::console("IQ capture dropped %" PRIu64 " subframe buffers\n", iq_capture.nof_dropped());
+    }
+  }
 }
 
 void phy_common::clear_grants(uint16_t rnti)
@@ -167,6 +197,32 @@ void phy_common::worker_end(const worker_context_t& w_ctx, const bool& tx_enable
   semaphore.release();
 }
 
+void phy_common::add_tti_timing(const tti_timing_t& timing)
+{
+  auto slack_us = [&timing](const tti_timing_t::time_point& t) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(timing.deadline - t).count();
+  };
+
+  std::lock_guard<std::mutex> lock(timing_mutex);
+  timing_metrics.rx.add(slack_us(timing.rx));
+  if (timing_metrics.ul_decode.size() < timing.nof_carriers) {
+    timing_metrics.ul_decode.resize(timing.nof_carriers);
+  }
+  for (uint32_t cc = 0; cc < timing.nof_carriers; cc++) {
+    timing_metrics.ul_decode[cc].add(slack_us(timing.ul_decode[cc]));
+  }
+  timing_metrics.mac_sched.add(slack_us(timing.mac_sched));
+  timing_metrics.dl_encode.add(slack_us(timing.dl_encode));
+  timing_metrics.tx_submit.add(slack_us(timing.tx_submit));
+}
+
+void phy_common::get_timing_metrics(phy_timing_metrics_t& m)
+{
+  std::lock_guard<std::mutex> lock(timing_mutex);
+  m              = timing_metrics;
+  timing_metrics = {};
+}
+
 void phy_common::set_mch_period_stop(uint32_t stop)
 {
   std::lock_guard<std::mutex> lock(mtch_mutex);
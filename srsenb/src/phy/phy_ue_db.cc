@@ -20,9 +20,17 @@
  */
 
 #include "srsenb/hdr/phy/phy_ue_db.h"
+#include <thread>
 
 using namespace srsenb;
 
+phy_ue_db::phy_ue_db() : ue_db(new ue_map_t) {}
+
+phy_ue_db::~phy_ue_db()
+{
+  delete ue_db.load();
+}
+
 void phy_ue_db::init(stack_interface_phy_lte*   stack_ptr,
                      const phy_args_t&          phy_args_,
                      const phy_cell_cfg_list_t& cell_cfg_list_)
@@ -32,52 +40,46 @@ void phy_ue_db::init(stack_interface_phy_lte*   stack_ptr,
   cell_cfg_list = &cell_cfg_list_;
 }
 
-inline int phy_ue_db::_add_rnti(uint16_t rnti)
+void phy_ue_db::_publish(ue_map_t* db)
 {
-  // Private function not mutexed
+  // Private function, requires the write mutex
+  const ue_map_t* old_db = ue_db.exchange(db);
 
-  // Assert RNTI does NOT exist
-  if (ue_db.count(rnti)) {
-    return SRSRAN_ERROR;
+  // Wait for the readers of both epochs, a reader that registers after this only sees the new database
+  for (uint32_t i = 0; i < 2; i++) {
+    uint32_t epoch = reader_epoch.fetch_add(1) % 2;
+    while (nof_readers[epoch].load() != 0) {
+      std::this_thread::yield();
+    }
   }
 
-  // Create new UE by accesing it
-  ue_db[rnti].cell_info[0] = {};
+  delete old_db;
+}
 
-  // Get UE
-  common_ue& ue = ue_db[rnti];
+std::shared_ptr<phy_ue_db::common_ue> phy_ue_db::_new_rnti(uint16_t rnti) const
+{
+  std::shared_ptr<common_ue> ue = std::make_shared<common_ue>();
+  ue->state                     = std::make_shared<ue_state_t>();
 
   // Load default values to PCell
-  ue.cell_info[0].phy_cfg.set_defaults();
+  ue->cell_info[0].phy_cfg.set_defaults();
 
   // Set constant configuration fields
-  _set_common_config_rnti(rnti, ue.cell_info[0].phy_cfg);
+  _set_common_config_rnti(rnti, ue->cell_info[0].phy_cfg);
 
   // Configure as PCell
-  ue.cell_info[0].state = cell_state_primary;
+  ue->cell_info[0].state = cell_state_primary;
 
-  // Iterate all pending ACK
-  for (uint32_t tti = 0; tti < TTIMOD_SZ; tti++) {
-    _clear_tti_pending_rnti(tti, rnti);
-  }
-
-  return SRSRAN_SUCCESS;
+  return ue;
 }
 
-inline void phy_ue_db::_clear_tti_pending_rnti(uint32_t tti, uint16_t rnti)
+void phy_ue_db::_reset_pdsch_ack(const common_ue& ue, srsran_pdsch_ack_t& pdsch_ack)
 {
-  // Private function not mutexed, no need to assert RNTI or TTI
-
-  // Get UE
-  common_ue& ue = ue_db[rnti];
-
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
-
   // Reset ACK information
   pdsch_ack = {};
 
   uint32_t nof_active_cc = 0;
-  for (auto& cell_info : ue.cell_info) {
+  for (const cell_info_t& cell_info : ue.cell_info) {
     if (cell_info.state == cell_state_primary or cell_info.state == cell_state_secondary_active) {
       nof_active_cc++;
     }
@@ -100,6 +102,7 @@ inline void phy_ue_db::_set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t&
   phy_cfg.ul_cfg.pusch.meas_epre_en                  = phy_args->pusch_meas_epre;
   phy_cfg.ul_cfg.pusch.meas_ta_en                    = phy_args->pusch_meas_ta;
   phy_cfg.ul_cfg.pusch.meas_evm_en                   = phy_args->pusch_meas_evm;
+  phy_cfg.ul_cfg.pusch.chest_wiener_en               = phy_args->pusch_wiener;
   phy_cfg.ul_cfg.pusch.max_nof_iterations            = phy_args->pusch_max_its;
   phy_cfg.ul_cfg.pucch.threshold_format1             = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1;
   phy_cfg.ul_cfg.pucch.threshold_data_valid_format1a = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1A;
@@ -109,10 +112,9 @@ inline void phy_ue_db::_set_common_config_rnti(uint16_t rnti, srsran::phy_cfg_t&
   phy_cfg.ul_cfg.pucch.meas_ta_en                    = phy_args->pucch_meas_ta;
 }
 
-inline uint32_t phy_ue_db::_get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) const
+inline uint32_t phy_ue_db::_get_ue_cc_idx(const common_ue& ue, uint32_t enb_cc_idx)
 {
-  uint32_t         ue_cc_idx = 0;
-  const common_ue& ue        = ue_db.at(rnti);
+  uint32_t ue_cc_idx = 0;
 
   for (; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
     const cell_info_t& scell_info = ue.cell_info[ue_cc_idx];
@@ -125,36 +127,42 @@ inline uint32_t phy_ue_db::_get_ue_cc_idx(uint16_t rnti, uint32_t enb_cc_idx) co
   return ue_cc_idx;
 }
 
-uint32_t phy_ue_db::_get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const
+uint32_t phy_ue_db::_get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti, const common_ue& ue) const
 {
+  const std::map<uint16_t, uint32_t>& grant_mask = ul_grant_mask[tti];
+
   // Find the lowest index available PUSCH grant
-  for (const cell_info_t& cell_info : ue_db.at(rnti).cell_info) {
-    if (cell_info.is_grant_available[tti]) {
-      return cell_info.enb_cc_idx;
+  auto it = grant_mask.find(rnti);
+  if (it != grant_mask.end()) {
+    for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
+      if (it->second & (1U << ue_cc_idx)) {
+        return ue.cell_info[ue_cc_idx].enb_cc_idx;
+      }
     }
   }
 
   return (uint32_t)cell_cfg_list->size();
 }
 
-inline int phy_ue_db::_assert_rnti(uint16_t rnti) const
+inline const phy_ue_db::common_ue* phy_ue_db::_find_rnti(const ue_map_t& db, uint16_t rnti)
 {
-  if (not ue_db.count(rnti)) {
-    return SRSRAN_ERROR;
+  auto it = db.find(rnti);
+  if (it == db.end()) {
+    return nullptr;
   }
 
-  return SRSRAN_SUCCESS;
+  return it->second.get();
 }
 
-inline int phy_ue_db::_assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
+inline int phy_ue_db::_assert_enb_cc(const common_ue* ue, uint32_t enb_cc_idx)
 {
   // Assert RNTI exist
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
+  if (ue == nullptr) {
     return SRSRAN_ERROR;
   }
 
   // Check Component Carrier is part of UE SCell map
-  if (_get_ue_cc_idx(rnti, enb_cc_idx) == SRSRAN_MAX_CARRIERS) {
+  if (_get_ue_cc_idx(*ue, enb_cc_idx) == SRSRAN_MAX_CARRIERS) {
     return SRSRAN_ERROR;
   }
 
@@ -163,17 +171,18 @@ inline int phy_ue_db::_assert_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
 
 bool phy_ue_db::ue_has_cell(uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  return _assert_enb_cc(rnti, enb_cc_idx) == SRSRAN_SUCCESS;
+  ue_db_reader db(*this);
+  return _assert_enb_cc(_find_rnti(*db, rnti), enb_cc_idx) == SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) const
+inline int phy_ue_db::_assert_enb_pcell(const common_ue* ue, uint32_t enb_cc_idx)
 {
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  if (_assert_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Check cell is PCell
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)];
+  const cell_info_t& cell_info = ue->cell_info[_get_ue_cc_idx(*ue, enb_cc_idx)];
   if (cell_info.state != cell_state_primary) {
     return SRSRAN_ERROR;
   }
@@ -181,9 +190,9 @@ inline int phy_ue_db::_assert_enb_pcell(uint16_t rnti, uint32_t enb_cc_idx) cons
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const
+inline int phy_ue_db::_assert_ue_cc(const common_ue* ue, uint32_t ue_cc_idx)
 {
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
+  if (ue == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -192,7 +201,7 @@ inline int phy_ue_db::_assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const
     return SRSRAN_ERROR;
   }
 
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info.at(ue_cc_idx);
+  const cell_info_t& cell_info = ue->cell_info.at(ue_cc_idx);
   if (cell_info.state == cell_state_none) {
     return SRSRAN_ERROR;
   }
@@ -200,14 +209,14 @@ inline int phy_ue_db::_assert_ue_cc(uint16_t rnti, uint32_t ue_cc_idx) const
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_assert_active_enb_cc(uint16_t rnti, uint32_t enb_cc_idx) const
+inline int phy_ue_db::_assert_active_enb_cc(const common_ue* ue, uint32_t enb_cc_idx)
 {
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  if (_assert_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Check SCell is active, ignore PCell state
-  const cell_info_t& cell_info = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)];
+  const cell_info_t& cell_info = ue->cell_info[_get_ue_cc_idx(*ue, enb_cc_idx)];
   if (cell_info.state != cell_state_primary and cell_info.state != cell_state_secondary_active) {
     return SRSRAN_ERROR;
   }
@@ -233,53 +242,65 @@ inline int phy_ue_db::_assert_cell_list_cfg() const
   return SRSRAN_SUCCESS;
 }
 
-inline int phy_ue_db::_get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const
+inline int
+phy_ue_db::_get_rnti_config(const ue_map_t& db, uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg)
 {
-  srsran::phy_cfg_t default_cfg = {};
-  default_cfg.set_defaults();
-  default_cfg.dl_cfg.pdsch.rnti = rnti;
-  default_cfg.ul_cfg.pucch.rnti = rnti;
-  default_cfg.ul_cfg.pusch.rnti = rnti;
-
   // Use default configuration for non-user C-RNTI
   if (not SRSRAN_RNTI_ISUSER(rnti)) {
-    phy_cfg = default_cfg;
+    phy_cfg = {};
+    phy_cfg.set_defaults();
+    phy_cfg.dl_cfg.pdsch.rnti = rnti;
+    phy_cfg.ul_cfg.pucch.rnti = rnti;
+    phy_cfg.ul_cfg.pusch.rnti = rnti;
     return SRSRAN_SUCCESS;
   }
 
   // Make sure the C-RNTI exists and the cell/carrier is configured
-  if (_assert_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue = _find_rnti(db, rnti);
+  if (_assert_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Write the current configuration
-  uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
-  phy_cfg            = ue_db.at(rnti).cell_info.at(ue_cc_idx).phy_cfg;
+  uint32_t ue_cc_idx = _get_ue_cc_idx(*ue, enb_cc_idx);
+  phy_cfg            = ue->cell_info.at(ue_cc_idx).phy_cfg;
   return SRSRAN_SUCCESS;
 }
 
 void phy_ue_db::clear_tti_pending_ack(uint32_t tti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_reader                            db(*this);
+  std::map<uint16_t, srsran_pdsch_ack_t>& tti_pdsch_ack = pdsch_ack[tti];
+  sps_n1_pucch[tti].clear();
+
+  // Drop the removed UEs
+  for (auto it = tti_pdsch_ack.begin(); it != tti_pdsch_ack.end();) {
+    if (db->count(it->first) == 0) {
+      it = tti_pdsch_ack.erase(it);
+    } else {
+      ++it;
+    }
+  }
 
-  // Iterate all UEs
-  for (auto& iter : ue_db) {
-    _clear_tti_pending_rnti(TTIMOD(tti), iter.first);
+  // Iterate all UEs, the insertions only allocate for the UEs added since the last time the TTI was cleared
+  for (const auto& iter : *db) {
+    _reset_pdsch_ack(*iter.second, tti_pdsch_ack[iter.first]);
   }
 }
 
 void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_cfg_list_t& phy_cfg_list)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(write_mutex);
+  std::unique_ptr<ue_map_t>   db(new ue_map_t(*ue_db.load()));
 
-  // Create new user if did not exist
-  if (ue_db.count(rnti) == 0) {
-    _add_rnti(rnti);
+  // Create new user if did not exist, otherwise modify a copy of the current configuration
+  std::shared_ptr<common_ue> ue;
+  if (db->count(rnti) == 0) {
+    ue = _new_rnti(rnti);
+  } else {
+    ue = std::make_shared<common_ue>(*db->at(rnti));
   }
 
-  // Get UE by reference
-  common_ue& ue = ue_db[rnti];
-
   // During a reconfiguration, all parameters in phy_cfg_t shall be applied immediately except:
   // - Multiple CSI request field in DCI (phy_cfg_t.dl_cfg.dci.multiple_csi_request_enabled)
   // - Extended TBS tables (for 256QAM) (phy_cfg_t.dl_cfg.pdsch.use_tbs_index_alt)
@@ -289,9 +310,9 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
   // and the reception of the reconfigurationComplete, the values before the reconfiguration shall be used
 
   // Store the current values for CSI and extended TBS in temporary variables
-  ue.stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+  ue->stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(*ue) > 0);
   for (uint32_t i = 0; i < SRSRAN_MAX_CARRIERS; i++) {
-    ue.cell_info[i].stash_use_tbs_index_alt = ue.cell_info[i].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
+    ue->cell_info[i].stash_use_tbs_index_alt = ue->cell_info[i].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
   }
 
   // Iterate PHY RRC configuration for each UE cell/carrier
@@ -300,7 +321,7 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
     const phy_interface_rrc_lte::phy_rrc_cfg_t& phy_rrc_dedicated = phy_cfg_list[ue_cc_idx];
 
     // Configured, add/modify entry in the cell_info map
-    cell_info_t& cell_info = ue.cell_info[ue_cc_idx];
+    cell_info_t& cell_info = ue->cell_info[ue_cc_idx];
 
     // Configure PHY
     if (cell_info.state == cell_state_primary) {
@@ -335,34 +356,39 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
 
   // Disable the rest of potential serving cells
   for (uint32_t i = nof_cc; i < SRSRAN_MAX_CARRIERS; i++) {
-    ue.cell_info[i].state = cell_state_none;
+    ue->cell_info[i].state = cell_state_none;
   }
 
   // Enable/Disable extended CSI field in DCI according to 3GPP 36.212 R10 5.3.3.1.1 Format 0
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < nof_cc; ue_cc_idx++) {
-    ue.cell_info[ue_cc_idx].phy_cfg.dl_cfg.dci.multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+    ue->cell_info[ue_cc_idx].phy_cfg.dl_cfg.dci.multiple_csi_request_enabled = (_count_nof_configured_scell(*ue) > 0);
   }
+
+  (*db)[rnti] = std::move(ue);
+  _publish(db.release());
 }
 
 int phy_ue_db::rem_rnti(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(write_mutex);
 
-  if (ue_db.count(rnti) == 0) {
+  if (ue_db.load()->count(rnti) == 0) {
     return SRSRAN_ERROR;
   }
 
-  ue_db.erase(rnti);
+  std::unique_ptr<ue_map_t> db(new ue_map_t(*ue_db.load()));
+  db->erase(rnti);
+  _publish(db.release());
 
   return SRSRAN_SUCCESS;
 }
 
-uint32_t phy_ue_db::_count_nof_configured_scell(uint16_t rnti)
+uint32_t phy_ue_db::_count_nof_configured_scell(const common_ue& ue)
 {
   uint32_t nof_configured_scell = 0;
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
-    if (ue_db[rnti].cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_inactive ||
-        ue_db[rnti].cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_active) {
+    if (ue.cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_inactive ||
+        ue.cell_info[ue_cc_idx].state == cell_state_t::cell_state_secondary_active) {
       nof_configured_scell++;
     }
   }
@@ -371,36 +397,43 @@ uint32_t phy_ue_db::_count_nof_configured_scell(uint16_t rnti)
 
 int phy_ue_db::complete_config(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(write_mutex);
 
   // Makes sure the RNTI exists
-  if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
+  const common_ue* current = _find_rnti(*ue_db.load(), rnti);
+  if (current == nullptr) {
     return SRSRAN_ERROR;
   }
 
   // Once the reconfiguration is complete, the temporary parameters become the new ones
+  std::shared_ptr<common_ue> ue = std::make_shared<common_ue>(*current);
 
   // Update temporary multiple CSI DCI field with the new value
-  ue_db[rnti].stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(rnti) > 0);
+  ue->stashed_multiple_csi_request_enabled = (_count_nof_configured_scell(*ue) > 0);
   // Update temporary alternate TBS value with the new one
   for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
-    ue_db[rnti].cell_info[ue_cc_idx].stash_use_tbs_index_alt =
-        ue_db[rnti].cell_info[ue_cc_idx].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
+    ue->cell_info[ue_cc_idx].stash_use_tbs_index_alt = ue->cell_info[ue_cc_idx].phy_cfg.dl_cfg.pdsch.use_tbs_index_alt;
   }
 
+  std::unique_ptr<ue_map_t> db(new ue_map_t(*ue_db.load()));
+  (*db)[rnti] = std::move(ue);
+  _publish(db.release());
+
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::activate_deactivate_scell(uint16_t rnti, uint32_t ue_cc_idx, bool activate)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(write_mutex);
 
   // Assert RNTI and SCell are valid
-  if (_assert_ue_cc(rnti, ue_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* current = _find_rnti(*ue_db.load(), rnti);
+  if (_assert_ue_cc(current, ue_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_SUCCESS;
   }
 
-  cell_info_t& cell_info = ue_db[rnti].cell_info[ue_cc_idx];
+  std::shared_ptr<common_ue> ue        = std::make_shared<common_ue>(*current);
+  cell_info_t&               cell_info = ue->cell_info[ue_cc_idx];
 
   // If scell is default only complain
   if (activate and cell_info.state == cell_state_none) {
@@ -410,31 +443,36 @@ int phy_ue_db::activate_deactivate_scell(uint16_t rnti, uint32_t ue_cc_idx, bool
   // Set scell state
   cell_info.state = (activate) ? cell_state_secondary_active : cell_state_secondary_inactive;
 
+  std::unique_ptr<ue_map_t> db(new ue_map_t(*ue_db.load()));
+  (*db)[rnti] = std::move(ue);
+  _publish(db.release());
+
   return SRSRAN_SUCCESS;
 }
 
 bool phy_ue_db::is_pcell(uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  return _assert_enb_pcell(rnti, enb_cc_idx) == SRSRAN_SUCCESS;
+  ue_db_reader db(*this);
+  return _assert_enb_pcell(_find_rnti(*db, rnti), enb_cc_idx) == SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t& dl_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  ue_db_reader      db(*this);
+  srsran::phy_cfg_t phy_cfg = {};
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (_get_rnti_config(*db, rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   dl_cfg = phy_cfg.dl_cfg;
 
   // The DL configuration must overwrite the use_tbs_index_alt value (for 256QAM) with the temporary value
   // in case we are in the middle of a reconfiguration
-  if (ue_db.count(rnti) && SRSRAN_RNTI_ISUSER(rnti)) {
-    uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
+  const common_ue* ue = _find_rnti(*db, rnti);
+  if (ue != nullptr && SRSRAN_RNTI_ISUSER(rnti)) {
+    uint32_t ue_cc_idx = _get_ue_cc_idx(*ue, enb_cc_idx);
     if (ue_cc_idx == 0) {
-      dl_cfg.pdsch.use_tbs_index_alt = ue_db.at(rnti).cell_info[ue_cc_idx].stash_use_tbs_index_alt;
+      dl_cfg.pdsch.use_tbs_index_alt = ue->cell_info[ue_cc_idx].stash_use_tbs_index_alt;
     }
   }
   return SRSRAN_SUCCESS;
@@ -442,20 +480,21 @@ int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t
 
 int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  ue_db_reader      db(*this);
+  srsran::phy_cfg_t phy_cfg = {};
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (_get_rnti_config(*db, rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   dci_cfg = phy_cfg.dl_cfg.dci;
 
   // The DCI configuration used for DL grants must overwrite the multiple_csi_request_enabled value with the
   // temporary value in case we are in the middle of a reconfiguration
-  if (ue_db.count(rnti) && SRSRAN_RNTI_ISUSER(rnti)) {
-    uint32_t ue_cc_idx = _get_ue_cc_idx(rnti, enb_cc_idx);
+  const common_ue* ue = _find_rnti(*db, rnti);
+  if (ue != nullptr && SRSRAN_RNTI_ISUSER(rnti)) {
+    uint32_t ue_cc_idx = _get_ue_cc_idx(*ue, enb_cc_idx);
     if (ue_cc_idx == 0) {
-      dci_cfg.multiple_csi_request_enabled = ue_db.at(rnti).stashed_multiple_csi_request_enabled;
+      dci_cfg.multiple_csi_request_enabled = ue->stashed_multiple_csi_request_enabled;
     }
   }
   return SRSRAN_SUCCESS;
@@ -463,10 +502,10 @@ int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_
 
 int phy_ue_db::get_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_ul_cfg_t& ul_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  ue_db_reader      db(*this);
+  srsran::phy_cfg_t phy_cfg = {};
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (_get_rnti_config(*db, rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   ul_cfg = phy_cfg.ul_cfg;
@@ -476,10 +515,10 @@ int phy_ue_db::get_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_ul_cfg_t
 
 int phy_ue_db::get_dci_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  ue_db_reader      db(*this);
+  srsran::phy_cfg_t phy_cfg = {};
 
-  if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
+  if (_get_rnti_config(*db, rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   dci_cfg = phy_cfg.dl_cfg.dci;
@@ -487,19 +526,26 @@ int phy_ue_db::get_dci_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_
   return SRSRAN_SUCCESS;
 }
 
-bool phy_ue_db::set_ack_pending(uint32_t tti, uint32_t enb_cc_idx, const srsran_dci_dl_t& dci)
+bool phy_ue_db::set_ack_pending(uint32_t tti, uint32_t enb_cc_idx, const srsran_dci_dl_t& dci, int n1_pucch_an)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_reader db(*this);
 
   // Assert rnti and cell exits and it is active
-  if (_assert_active_enb_cc(dci.rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue = _find_rnti(*db, dci.rnti);
+  if (_assert_active_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
     return false;
   }
 
-  common_ue& ue        = ue_db.at(dci.rnti);
-  uint32_t   ue_cc_idx = _get_ue_cc_idx(dci.rnti, enb_cc_idx);
+  // The TTI slot was prepared before the UE was added, its ACK cannot be tracked
+  std::map<uint16_t, srsran_pdsch_ack_t>& tti_pdsch_ack = pdsch_ack[tti];
+  auto                                    it            = tti_pdsch_ack.find(dci.rnti);
+  if (it == tti_pdsch_ack.end()) {
+    return false;
+  }
+
+  uint32_t ue_cc_idx = _get_ue_cc_idx(*ue, enb_cc_idx);
 
-  srsran_pdsch_ack_cc_t& pdsch_ack_cc = ue.pdsch_ack[tti].cc[ue_cc_idx];
+  srsran_pdsch_ack_cc_t& pdsch_ack_cc = it->second.cc[ue_cc_idx];
   pdsch_ack_cc.M                      = 1; ///< Hardcoded for FDD
 
   // Fill PDSCH ACK information
@@ -520,9 +566,29 @@ bool phy_ue_db::set_ack_pending(uint32_t tti, uint32_t enb_cc_idx, const srsran_
       pdsch_ack_m.value[tb_idx] = 2;
     }
   }
+
+  // The DL SPS occasions are only scheduled in the PCell
+  if (n1_pucch_an >= 0) {
+    sps_n1_pucch[tti][dci.rnti] = static_cast<uint32_t>(n1_pucch_an);
+  }
   return true;
 }
 
+void phy_ue_db::fill_sps_pucch_cfg(uint32_t tti, uint16_t rnti, srsran_pucch_cfg_t& pucch_cfg) const
+{
+  const std::map<uint16_t, uint32_t>& tti_sps_n1_pucch = sps_n1_pucch[tti];
+  auto                                it               = tti_sps_n1_pucch.find(rnti);
+  if (it == tti_sps_n1_pucch.end()) {
+    return;
+  }
+
+  // The scheduler configures a single persistent resource, whatever the TPC command of the SPS activation
+  pucch_cfg.sps_enabled = true;
+  for (uint32_t& n_pucch_1 : pucch_cfg.n_pucch_1) {
+    n_pucch_1 = it->second;
+  }
+}
+
 int phy_ue_db::fill_uci_cfg(uint32_t          tti,
                             uint32_t          enb_cc_idx,
                             uint16_t          rnti,
@@ -530,7 +596,7 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
                             bool              is_pusch_available,
                             srsran_uci_cfg_t& uci_cfg)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_reader db(*this);
 
   // Reset UCI CFG, avoid returning carrying cached information
   uci_cfg = {};
@@ -541,12 +607,14 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   }
 
   // Assert eNb Cell/Carrier for the given RNTI
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue_ptr = _find_rnti(*db, rnti);
+  if (_assert_active_enb_cc(ue_ptr, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
+  const common_ue& ue = *ue_ptr;
 
   // Get the eNb cell/carrier index with lowest serving cell index (ue_cc_idx) that has an available grant.
-  uint32_t uci_enb_cc_id         = _get_uci_enb_cc_idx(tti, rnti);
+  uint32_t uci_enb_cc_id         = _get_uci_enb_cc_idx(tti, rnti, ue);
   bool     pusch_grant_available = (uci_enb_cc_id < (uint32_t)cell_cfg_list->size());
 
   // There is a PUSCH grant available for the provided RNTI in at least one serving cell and this call is for PUCCH
@@ -560,11 +628,10 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
   }
 
   // No PUSCH grant for this TTI and cell and no enb_cc_idx is not the PCell
-  if (not pusch_grant_available and _get_ue_cc_idx(rnti, enb_cc_idx) != 0) {
+  if (not pusch_grant_available and _get_ue_cc_idx(ue, enb_cc_idx) != 0) {
     return SRSRAN_SUCCESS;
   }
 
-  common_ue&               ue           = ue_db.at(rnti);
   const srsran::phy_cfg_t& pcell_cfg    = ue.cell_info[0].phy_cfg;
   bool                     uci_required = false;
 
@@ -587,7 +654,8 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
       const srsran_cell_t& cell = cell_cfg_list->at(cell_info.enb_cc_idx).cell;
 
       // Check if CQI report is required
-      periodic_cqi_required = srsran_enb_dl_gen_cqi_periodic(&cell, &dl_cfg, tti, cell_info.last_ri, &uci_cfg.cqi);
+      periodic_cqi_required =
+          srsran_enb_dl_gen_cqi_periodic(&cell, &dl_cfg, tti, ue.state->last_ri[cell_idx].load(), &uci_cfg.cqi);
 
       // Save SCell index for using it after
       uci_cfg.cqi.scell_index = cell_idx;
@@ -600,16 +668,19 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
     // Aperiodic only supported for PCell
     const srsran_dl_cfg_t& dl_cfg = pcell_info.phy_cfg.dl_cfg;
 
-    uci_required = srsran_enb_dl_gen_cqi_aperiodic(&pcell, &dl_cfg, pcell_info.last_ri, &uci_cfg.cqi);
+    uci_required = srsran_enb_dl_gen_cqi_aperiodic(&pcell, &dl_cfg, ue.state->last_ri[0].load(), &uci_cfg.cqi);
   }
 
-  // Get pending ACKs from PDSCH
-  srsran_dl_sf_cfg_t dl_sf_cfg  = {};
-  dl_sf_cfg.tti                 = tti;
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
-  pdsch_ack.is_pusch_available  = is_pusch_available;
-  srsran_enb_dl_gen_ack(&pcell, &dl_sf_cfg, &pdsch_ack, &uci_cfg);
-  uci_required |= (srsran_uci_cfg_total_ack(&uci_cfg) > 0);
+  // Get pending ACKs from PDSCH, a UE added after the TTI slot was prepared has none
+  std::map<uint16_t, srsran_pdsch_ack_t>& tti_pdsch_ack = pdsch_ack[tti];
+  auto                                    it            = tti_pdsch_ack.find(rnti);
+  if (it != tti_pdsch_ack.end()) {
+    srsran_dl_sf_cfg_t dl_sf_cfg  = {};
+    dl_sf_cfg.tti                 = tti;
+    it->second.is_pusch_available = is_pusch_available;
+    srsran_enb_dl_gen_ack(&pcell, &dl_sf_cfg, &it->second, &uci_cfg);
+    uci_required |= (srsran_uci_cfg_total_ack(&uci_cfg) > 0);
+  }
 
   // Return whether UCI needs to be decoded
   return uci_required ? 1 : SRSRAN_SUCCESS;
@@ -654,18 +725,21 @@ void phy_ue_db::send_cqi_data(uint32_t                      tti,
   }
 }
 
+
 int phy_ue_db::send_uci_data(uint32_t                  tti,
                              uint16_t                  rnti,
                              uint32_t                  enb_cc_idx,
                              const srsran_uci_cfg_t&   uci_cfg,
                              const srsran_uci_value_t& uci_value)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_reader db(*this);
 
   // Assert UE RNTI database entry and eNb cell/carrier must be active
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue_ptr = _find_rnti(*db, rnti);
+  if (_assert_active_enb_cc(ue_ptr, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
+  const common_ue& ue = *ue_ptr;
 
   // Assert Stack
   if (_assert_stack() != SRSRAN_SUCCESS) {
@@ -677,22 +751,23 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
     stack->sr_detected(tti, rnti);
   }
 
-  // Get UE
-  common_ue& ue = ue_db.at(rnti);
-
-  // Get ACK info
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
-  const srsran_cell_t& cell      = cell_cfg_list->at(ue.cell_info[0].enb_cc_idx).cell;
-  srsran_enb_dl_get_ack(&cell, &uci_cfg, &uci_value, &pdsch_ack);
-
-  // Iterate over the ACK information
-  for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
-    const srsran_pdsch_ack_cc_t& pdsch_ack_cc = pdsch_ack.cc[ue_cc_idx];
-    for (uint32_t m = 0; m < pdsch_ack_cc.M; m++) {
-      if (pdsch_ack_cc.m[m].present) {
-        for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
-          if (pdsch_ack_cc.m[m].value[tb] != 2) {
-            stack->ack_info(tti, rnti, ue.cell_info[ue_cc_idx].enb_cc_idx, tb, pdsch_ack_cc.m[m].value[tb] == 1);
+  // Get ACK info, a UE added after the TTI slot was prepared has none
+  const srsran_cell_t&                    cell          = cell_cfg_list->at(ue.cell_info[0].enb_cc_idx).cell;
+  std::map<uint16_t, srsran_pdsch_ack_t>& tti_pdsch_ack = pdsch_ack[tti];
+  auto                                    it            = tti_pdsch_ack.find(rnti);
+  if (it != tti_pdsch_ack.end()) {
+    srsran_pdsch_ack_t& pdsch_ack_tti = it->second;
+    srsran_enb_dl_get_ack(&cell, &uci_cfg, &uci_value, &pdsch_ack_tti);
+
+    // Iterate over the ACK information
+    for (uint32_t ue_cc_idx = 0; ue_cc_idx < SRSRAN_MAX_CARRIERS; ue_cc_idx++) {
+      const srsran_pdsch_ack_cc_t& pdsch_ack_cc = pdsch_ack_tti.cc[ue_cc_idx];
+      for (uint32_t m = 0; m < pdsch_ack_cc.M; m++) {
+        if (pdsch_ack_cc.m[m].present) {
+          for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+            if (pdsch_ack_cc.m[m].value[tb] != 2) {
+              stack->ack_info(tti, rnti, ue.cell_info[ue_cc_idx].enb_cc_idx, tb, pdsch_ack_cc.m[m].value[tb] == 1);
+            }
           }
         }
       }
@@ -700,13 +775,13 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
   }
 
   // Assert the SCell exists and it is active
-  if (_assert_ue_cc(rnti, uci_cfg.cqi.scell_index) != SRSRAN_SUCCESS) {
+  if (_assert_ue_cc(&ue, uci_cfg.cqi.scell_index) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Get CQI carrier index
-  cell_info_t& cqi_scell_info = ue_db.at(rnti).cell_info[uci_cfg.cqi.scell_index];
-  uint32_t     cqi_cc_idx     = cqi_scell_info.enb_cc_idx;
+  const cell_info_t& cqi_scell_info = ue.cell_info[uci_cfg.cqi.scell_index];
+  uint32_t           cqi_cc_idx     = cqi_scell_info.enb_cc_idx;
 
   // Notify CQI only if CRC is valid
   if (uci_value.cqi.data_crc) {
@@ -736,7 +811,7 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
   // Rank indicator (TM3 and TM4)
   if (uci_cfg.cqi.ri_len) {
     stack->ri_info(tti, rnti, cqi_cc_idx, uci_value.ri);
-    cqi_scell_info.last_ri = uci_value.ri;
+    ue.state->last_ri[uci_cfg.cqi.scell_index].store(uci_value.ri);
   }
 
   return SRSRAN_SUCCESS;
@@ -744,43 +819,49 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
 
 int phy_ue_db::set_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid, srsran_ra_tb_t tb)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_reader db(*this);
 
   // Assert UE DB entry
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue = _find_rnti(*db, rnti);
+  if (_assert_active_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // Save resource allocation
-  ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid] = tb;
+  ue->state->last_tb[_get_ue_cc_idx(*ue, enb_cc_idx)][pid] = tb;
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid, srsran_ra_tb_t& ra_tb) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ue_db_reader db(*this);
 
   // Assert UE DB entry
-  if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+  const common_ue* ue = _find_rnti(*db, rnti);
+  if (_assert_active_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   // writes the latest stored UL transmission grant
-  ra_tb = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid];
+  ra_tb = ue->state->last_tb[_get_ue_cc_idx(*ue, enb_cc_idx)][pid];
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::set_ul_grant_available(uint32_t tti, const stack_interface_phy_lte::ul_sched_list_t& ul_sched_list)
 {
-  int                         ret = SRSRAN_SUCCESS;
-  std::lock_guard<std::mutex> lock(mutex);
+  int                           ret = SRSRAN_SUCCESS;
+  ue_db_reader                  db(*this);
+  std::map<uint16_t, uint32_t>& grant_mask = ul_grant_mask[tti];
 
-  // Reset all available grants flags for the given TTI
-  for (auto& ue : ue_db) {
-    for (cell_info_t& cell_info : ue.second.cell_info) {
-      cell_info.is_grant_available[tti] = false;
+  // Reset all available grants flags for the given TTI, dropping the removed UEs
+  for (auto it = grant_mask.begin(); it != grant_mask.end();) {
+    if (db->count(it->first) == 0) {
+      it = grant_mask.erase(it);
+    } else {
+      it->second = 0;
+      ++it;
     }
   }
 
@@ -791,13 +872,14 @@ int phy_ue_db::set_ul_grant_available(uint32_t tti, const stack_interface_phy_lt
       const stack_interface_phy_lte::ul_sched_grant_t& ul_sched_grant = ul_sched.pusch[i];
       uint16_t                                         rnti           = ul_sched_grant.dci.rnti;
       // Check that eNb Cell/Carrier is active for the given RNTI
-      if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
+      const common_ue* ue = _find_rnti(*db, rnti);
+      if (_assert_active_enb_cc(ue, enb_cc_idx) != SRSRAN_SUCCESS) {
         ret = SRSRAN_ERROR;
         srslog::fetch_basic_logger("PHY").info("Error setting grant for rnti=0x%x, cc=%d", rnti, enb_cc_idx);
         continue;
       }
       // Rise Grant available flag
-      ue_db[rnti].cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].is_grant_available[tti] = true;
+      grant_mask[rnti] |= (1U << _get_ue_cc_idx(*ue, enb_cc_idx));
     }
   }
 
@@ -20,7 +20,9 @@
  */
 
 #include "srsenb/hdr/phy/prach_worker.h"
+#include "srsran/common/thread_affinity.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
+#include "srsran/phy/rf/rf.h"
 #include "srsran/srsran.h"
 
 namespace srsenb {
@@ -38,21 +40,24 @@ int prach_worker::init(const srsran_cell_t&      cell_,
 
   max_prach_offset_us = 50;
 
-  if (srsran_prach_init(&prach, srsran_symbol_sz(cell.nof_prb))) {
-    return -1;
-  }
-
-  if (srsran_prach_set_cfg(&prach, &prach_cfg, cell.nof_prb)) {
-    ERROR("Error initiating PRACH");
-    return -1;
+  // Without worker threads the occasions are detected in the caller's thread, by a single detector
+  for (uint32_t i = 0; i < SRSRAN_MAX(nof_workers, 1); i++) {
+    detectors.push_back(std::unique_ptr<detector>(new detector(*this, i)));
+    srsran::scoped_numa_policy numa(srsran::thread_class_t::prach_worker);
+    if (detectors.back()->init()) {
+      return -1;
+    }
   }
 
-  srsran_prach_set_detect_factor(&prach, 60);
+  const srsran_prach_t& prach = detectors.front()->prach;
 
   nof_sf = (uint32_t)ceilf(prach.T_tot * 1000);
 
   if (nof_workers > 0) {
-    start(priority);
+    running = true;
+    for (auto& d : detectors) {
+      d->start(priority);
+    }
   }
 
   initiated = true;
@@ -80,15 +85,19 @@ int prach_worker::init(const srsran_cell_t&      cell_,
 
 void prach_worker::stop()
 {
-  running      = false;
-  sf_buffer* s = nullptr;
-  pending_buffers.push(s);
-
-  if (nof_workers > 0) {
-    wait_thread_finish();
+  running = false;
+  for (uint32_t i = 0; i < detectors.size(); i++) {
+    sf_buffer* s = nullptr;
+    pending_buffers.push(s);
   }
 
-  srsran_prach_free(&prach);
+  for (auto& d : detectors) {
+    if (nof_workers > 0) {
+      d->wait_thread_finish();
+    }
+    d->free();
+  }
+  detectors.clear();
 }
 
 void prach_worker::set_max_prach_offset_us(float delay_us)
@@ -96,10 +105,13 @@ void prach_worker::set_max_prach_offset_us(float delay_us)
   max_prach_offset_us = delay_us;
 }
 
-int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
+int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx, bool sc16)
 {
   // Save buffer only if it's a PRACH TTI
-  if (srsran_prach_tti_opportunity(&prach, tti_rx, -1) || sf_cnt) {
+  if (detectors.empty()) {
+    return 0;
+  }
+  if (srsran_prach_tti_opportunity(&detectors.front()->prach, tti_rx, -1) || sf_cnt) {
     if (sf_cnt == 0) {
       current_buffer = buffer_pool.allocate();
       if (!current_buffer) {
@@ -112,9 +124,13 @@ int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
       return -1;
     }
     if (current_buffer->nof_samples + SRSRAN_SF_LEN_PRB(cell.nof_prb) < sf_buffer_sz) {
-      memcpy(&current_buffer->samples[sf_cnt * SRSRAN_SF_LEN_PRB(cell.nof_prb)],
-             buffer_rx,
-             sizeof(cf_t) * SRSRAN_SF_LEN_PRB(cell.nof_prb));
+      cf_t* samples = &current_buffer->samples[sf_cnt * SRSRAN_SF_LEN_PRB(cell.nof_prb)];
+      if (sc16) {
+        srsran_vec_convert_if(
+            (int16_t*)buffer_rx, SRSRAN_RF_SC16_FULL_SCALE, (float*)samples, 2 * SRSRAN_SF_LEN_PRB(cell.nof_prb));
+      } else {
+        memcpy(samples, buffer_rx, sizeof(cf_t) * SRSRAN_SF_LEN_PRB(cell.nof_prb));
+      }
       current_buffer->nof_samples += SRSRAN_SF_LEN_PRB(cell.nof_prb);
       if (sf_cnt == 0) {
         current_buffer->tti = tti_rx;
@@ -127,7 +143,7 @@ int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
     if (sf_cnt == nof_sf) {
       sf_cnt = 0;
       if (nof_workers == 0) {
-        run_tti(current_buffer);
+        detectors.front()->run_tti(current_buffer);
         current_buffer->reset();
         buffer_pool.deallocate(current_buffer);
       } else {
@@ -138,63 +154,84 @@ int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
   return 0;
 }
 
-int prach_worker::run_tti(sf_buffer* b)
+int prach_worker::detector::init()
 {
-  uint32_t prach_nof_det = 0;
-  if (srsran_prach_tti_opportunity(&prach, b->tti, -1)) {
-    // Detect possible PRACHs
-    if (srsran_prach_detect_offset(&prach,
-                                   prach_cfg.freq_offset,
-                                   &b->samples[prach.N_cp],
-                                   nof_sf * SRSRAN_SF_LEN_PRB(cell.nof_prb) - prach.N_cp,
-                                   prach_indices,
-                                   prach_offsets,
-                                   prach_p2avg,
-                                   &prach_nof_det)) {
-      logger.error("Error detecting PRACH");
-      return SRSRAN_ERROR;
-    }
+  if (srsran_prach_init(&prach, srsran_symbol_sz(parent.cell.nof_prb))) {
+    return -1;
+  }
+
+  if (srsran_prach_set_cfg(&prach, &parent.prach_cfg, parent.cell.nof_prb)) {
+    ERROR("Error initiating PRACH");
+    return -1;
+  }
+
+  srsran_prach_set_detect_factor(&prach, 60);
+
+  return 0;
+}
 
-    if (prach_nof_det) {
-      for (uint32_t i = 0; i < prach_nof_det; i++) {
-        logger.info("PRACH: cc=%d, %d/%d, preamble=%d, offset=%.1f us, peak2avg=%.1f, max_offset=%.1f us",
-                    cc_idx,
-                    i,
-                    prach_nof_det,
-                    prach_indices[i],
-                    prach_offsets[i] * 1e6,
-                    prach_p2avg[i],
-                    max_prach_offset_us);
+void prach_worker::detector::free()
+{
+  srsran_prach_free(&prach);
+}
 
-        if (prach_offsets[i] * 1e6 < max_prach_offset_us) {
-          // Convert time offset to Time Alignment command
-          uint32_t n_ta = (uint32_t)(prach_offsets[i] / (16 * SRSRAN_LTE_TS));
+int prach_worker::detector::run_tti(sf_buffer* b)
+{
+  const srsran_cell_t& cell          = parent.cell;
+  uint32_t             cc_idx        = parent.cc_idx;
+  uint32_t             nof_sf        = parent.nof_sf;
+  uint32_t             prach_nof_det = 0;
+
+  // Buffers are only started at PRACH opportunities, new_tti() has already checked it
+  if (srsran_prach_detect_offset(&prach,
+                                 parent.prach_cfg.freq_offset,
+                                 &b->samples[prach.N_cp],
+                                 nof_sf * SRSRAN_SF_LEN_PRB(cell.nof_prb) - prach.N_cp,
+                                 prach_indices,
+                                 prach_offsets,
+                                 prach_p2avg,
+                                 &prach_nof_det)) {
+    parent.logger.error("Error detecting PRACH");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < prach_nof_det; i++) {
+    parent.logger.info("PRACH: cc=%d, %d/%d, preamble=%d, offset=%.1f us, peak2avg=%.1f, max_offset=%.1f us",
+                       cc_idx,
+                       i,
+                       prach_nof_det,
+                       prach_indices[i],
+                       prach_offsets[i] * 1e6,
+                       prach_p2avg[i],
+                       parent.max_prach_offset_us);
 
-          stack->rach_detected(b->tti, cc_idx, prach_indices[i], n_ta);
+    if (prach_offsets[i] * 1e6 < parent.max_prach_offset_us) {
+      // Convert time offset to Time Alignment command
+      uint32_t n_ta = (uint32_t)(prach_offsets[i] / (16 * SRSRAN_LTE_TS));
+
+      parent.stack->rach_detected(b->tti, cc_idx, prach_indices[i], n_ta);
 
 #if defined(ENABLE_GUI) and ENABLE_PRACH_GUI
-          uint32_t nof_samples = SRSRAN_MIN(nof_sf * SRSRAN_SF_LEN_PRB(cell.nof_prb), 3 * SRSRAN_SF_LEN_MAX);
-          srsran_vec_abs_cf(b->samples, plot_buffer.data(), nof_samples);
-          plot_real_setNewData(&plot_real, plot_buffer.data(), nof_samples);
+      uint32_t nof_samples = SRSRAN_MIN(nof_sf * SRSRAN_SF_LEN_PRB(cell.nof_prb), 3 * SRSRAN_SF_LEN_MAX);
+      srsran_vec_abs_cf(b->samples, parent.plot_buffer.data(), nof_samples);
+      plot_real_setNewData(&parent.plot_real, parent.plot_buffer.data(), nof_samples);
 #endif // defined(ENABLE_GUI) and ENABLE_PRACH_GUI
-        }
-      }
     }
   }
   return 0;
 }
 
-void prach_worker::run_thread()
+void prach_worker::detector::run_thread()
 {
-  running = true;
-  while (running) {
-    sf_buffer* b = pending_buffers.wait_pop();
-    if (running && b) {
+  srsran::apply_thread_affinity(srsran::thread_class_t::prach_worker);
+  while (parent.running) {
+    sf_buffer* b = parent.pending_buffers.wait_pop();
+    if (parent.running && b) {
       int ret = run_tti(b);
       b->reset();
-      buffer_pool.deallocate(b);
+      parent.buffer_pool.deallocate(b);
       if (ret) {
-        running = false;
+        parent.running = false;
       }
     }
   }
@@ -0,0 +1,162 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/rf_rx_thread.h"
+#include "srsran/common/thread_affinity.h"
+#include "srsran/phy/utils/vector.h"
+#include <string.h>
+
+namespace srsenb {
+
+rf_rx_thread::rf_rx_thread(srslog::basic_logger& logger) : thread("RF_RX"), logger(logger)
+{
+  /* Do nothing */
+}
+
+rf_rx_thread::~rf_rx_thread()
+{
+  stop();
+
+  for (sf_t& sf : ring) {
+    for (cf_t* ptr : sf.samples) {
+      free(ptr);
+    }
+  }
+  for (cf_t* ptr : discard.samples) {
+    free(ptr);
+  }
+}
+
+bool rf_rx_thread::init(srsran::radio_interface_phy* radio_h,
+                        uint32_t                     nof_channels_,
+                        uint32_t                     sf_len_,
+                        bool                         sc16_,
+                        uint32_t                     nof_sf)
+{
+  if (radio_h == nullptr or nof_channels_ > SRSRAN_MAX_CHANNELS or nof_sf == 0) {
+    return false;
+  }
+
+  radio        = radio_h;
+  nof_channels = nof_channels_;
+  sf_len       = sf_len_;
+  sc16         = sc16_;
+
+  // The radio may receive up to twice the subframe length to compensate the time offsets
+  ring.resize(nof_sf);
+  for (uint32_t i = 0; i <= nof_sf; i++) {
+    sf_t& sf = (i < nof_sf) ? ring[i] : discard;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      sf.samples[ch] = srsran_vec_cf_malloc(2 * sf_len);
+      if (sf.samples[ch] == nullptr) {
+        logger.error("Error allocating the RF receive ring");
+        return false;
+      }
+      srsran_vec_cf_zero(sf.samples[ch], 2 * sf_len);
+    }
+  }
+
+  return true;
+}
+
+bool rf_rx_thread::start_rx(int prio)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (not running) {
+    return false;
+  }
+  started = start(prio);
+  return started;
+}
+
+void rf_rx_thread::stop()
+{
+  bool join = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    running = false;
+    join    = started;
+    started = false;
+  }
+  cvar.notify_all();
+
+  if (join) {
+    wait_thread_finish();
+  }
+}
+
+void rf_rx_thread::receive(sf_t& sf)
+{
+  srsran::rf_buffer_t buffer(sf.samples, sf_len);
+  buffer.set_sc16(sc16);
+  radio->rx_now(buffer, sf.timestamp);
+}
+
+void rf_rx_thread::run_thread()
+{
+  srsran::apply_thread_affinity(srsran::thread_class_t::txrx);
+
+  while (running) {
+    uint32_t w = write_idx.load(std::memory_order_relaxed);
+
+    // The consumer does not touch the subframes it has not read yet, the one being written is not visible
+    if (w - read_idx.load(std::memory_order_acquire) >= (uint32_t)ring.size()) {
+      receive(discard);
+      nof_discarded++;
+      logger.warning("RF receive ring full, discarded %d subframes", nof_discarded);
+      continue;
+    }
+
+    receive(ring[w % ring.size()]);
+    write_idx.store(w + 1, std::memory_order_release);
+
+    // The consumer checks the ring with the mutex held before it sleeps, so the notification cannot be lost
+    { std::lock_guard<std::mutex> lock(mutex); }
+    cvar.notify_one();
+  }
+}
+
+bool rf_rx_thread::pop(srsran::rf_buffer_t& buffer, srsran::rf_timestamp_t& timestamp)
+{
+  uint32_t r = read_idx.load(std::memory_order_relaxed);
+
+  if (write_idx.load(std::memory_order_acquire) == r) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cvar.wait(lock, [this, r]() { return not running or write_idx.load(std::memory_order_acquire) != r; });
+  }
+  if (not running) {
+    return false;
+  }
+
+  const sf_t& sf        = ring[r % ring.size()];
+  size_t      sample_sz = sc16 ? 2 * sizeof(int16_t) : sizeof(cf_t);
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    if (buffer.get(ch) != nullptr) {
+      memcpy(buffer.get(ch), sf.samples[ch], sample_sz * sf_len);
+    }
+  }
+  timestamp.copy(sf.timestamp);
+
+  read_idx.store(r + 1, std::memory_order_release);
+  return true;
+}
+
+} // namespace srsenb
@@ -23,7 +23,9 @@
 
 #include "srsenb/hdr/phy/txrx.h"
 #include "srsran/common/band_helper.h"
+#include "srsran/common/thread_affinity.h"
 #include "srsran/common/threads.h"
+#include "srsran/common/tti_trace.h"
 #include "srsran/srsran.h"
 
 #define Error(fmt, ...)                                                                                                \
@@ -61,6 +63,7 @@ bool txrx::init(enb_time_interface*          enb_,
   worker_com  = worker_com_;
   prach       = prach_;
   running     = true;
+  rf_prio     = prio_;
 
   // Instantiate UL channel emulator
   if (worker_com->params.ul_channel_args.enable) {
@@ -68,6 +71,18 @@ bool txrx::init(enb_time_interface*          enb_,
         new srsran::channel(worker_com->params.ul_channel_args, worker_com->get_nof_rf_channels(), logger));
   }
 
+  // Allocate the receive ring, the thread starts once the radio is configured
+  if (worker_com->params.rf_rx_ring_sz > 0) {
+    rf_rx = std::unique_ptr<rf_rx_thread>(new rf_rx_thread(logger));
+    if (not rf_rx->init(radio_h,
+                        worker_com->get_nof_rf_channels(),
+                        SRSRAN_SF_LEN_PRB(worker_com->get_nof_prb(0)),
+                        worker_com->is_sc16(),
+                        worker_com->params.rf_rx_ring_sz)) {
+      return false;
+    }
+  }
+
   start(prio_);
   return true;
 }
@@ -82,12 +97,19 @@ void txrx::stop()
 {
   if (running) {
     running = false;
+
+    // Wakes up the TX/RX thread if it waits for a subframe
+    if (rf_rx) {
+      rf_rx->stop();
+    }
     wait_thread_finish();
   }
 }
 
 void txrx::run_thread()
 {
+  srsran::apply_thread_affinity(srsran::thread_class_t::txrx);
+
   srsran::rf_buffer_t    buffer    = {};
   srsran::rf_timestamp_t timestamp = {};
   uint32_t               sf_len    = SRSRAN_SF_LEN_PRB(worker_com->get_nof_prb(0));
@@ -133,6 +155,11 @@ void txrx::run_thread()
 
   logger.info("Starting RX/TX thread nof_prb=%d, sf_len=%d", worker_com->get_nof_prb(0), sf_len);
 
+  // Receive in the RF thread from now on
+  if (rf_rx and not rf_rx->start_rx(rf_prio)) {
+    return;
+  }
+
   // Set TTI so that first TX is at tti=0
   tti = TTI_SUB(0, FDD_HARQ_DELAY_UL_MS + 1);
 
@@ -140,6 +167,7 @@ void txrx::run_thread()
   while (running) {
     tti = TTI_ADD(tti, 1);
     logger.set_context(tti);
+    srsran::tti_trace_scope trace_scope(srsran::tti_trace_event::txrx_run, tti);
 
     lte::sf_worker* lte_worker = nullptr;
     if (worker_com->get_nof_carriers_lte() > 0) {
@@ -186,7 +214,15 @@ void txrx::run_thread()
     }
 
     buffer.set_nof_samples(sf_len);
-    radio_h->rx_now(buffer, timestamp);
+    buffer.set_sc16(worker_com->is_sc16());
+    if (rf_rx) {
+      if (not rf_rx->pop(buffer, timestamp)) {
+        running = false;
+        continue;
+      }
+    } else {
+      radio_h->rx_now(buffer, timestamp);
+    }
 
     if (ul_channel) {
       ul_channel->run(buffer.to_cf_t(), buffer.to_cf_t(), sf_len, timestamp.get(0));
@@ -203,7 +239,8 @@ void txrx::run_thread()
 
     // Trigger prach worker execution
     for (uint32_t cc = 0; cc < worker_com->get_nof_carriers_lte(); cc++) {
-      prach->new_tti(cc, tti, buffer.get(worker_com->get_rf_port(cc), 0, worker_com->get_nof_ports(0)));
+      prach->new_tti(
+          cc, tti, buffer.get(worker_com->get_rf_port(cc), 0, worker_com->get_nof_ports(0)), buffer.is_sc16());
     }
 
     // Set NR worker context and start
@@ -23,6 +23,8 @@
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsenb/hdr/enb.h"
 #include "srsenb/hdr/stack/upper/gtpu_pdcp_adapter.h"
+#include "srsenb/hdr/stack/upper/up_thread_adapters.h"
+#include "srsran/common/thread_affinity.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_x2_interfaces.h"
 #include "srsran/rlc/bearer_mem_pool.h"
@@ -32,7 +34,7 @@ using namespace srsran;
 
 namespace srsenb {
 
-enb_stack_lte::enb_stack_lte(srslog::sink& log_sink) :
+enb_stack_lte::enb_stack_lte(srslog::sink& log_sink, bool up_thread_) :
   thread("STACK"),
   mac_logger(srslog::fetch_basic_logger("MAC", log_sink)),
   rlc_logger(srslog::fetch_basic_logger("RLC", log_sink, false)),
@@ -42,10 +44,14 @@ enb_stack_lte::enb_stack_lte(srslog::sink& log_sink) :
   gtpu_logger(srslog::fetch_basic_logger("GTPU", log_sink, false)),
   stack_logger(srslog::fetch_basic_logger("STCK", log_sink, false)),
   task_sched(512, 128),
-  pdcp(&task_sched, pdcp_logger),
+  up_thread(up_thread_),
+  up_task_sched(512, 128),
+  up_sched(up_thread_ ? &up_task_sched : &task_sched),
+  up_worker(*this),
+  pdcp(up_sched, pdcp_logger),
   mac(&task_sched, mac_logger),
   rlc(rlc_logger),
-  gtpu(&task_sched, gtpu_logger, &get_rx_io_manager()),
+  gtpu(up_sched, gtpu_logger, &get_rx_io_manager()),
   s1ap(&task_sched, s1ap_logger, &get_rx_io_manager()),
   rrc(&task_sched, bearers),
   mac_pcap(),
@@ -55,6 +61,15 @@ enb_stack_lte::enb_stack_lte(srslog::sink& log_sink) :
   enb_task_queue     = task_sched.make_task_queue();
   metrics_task_queue = task_sched.make_task_queue();
   // sync_queue is added in init()
+
+  if (up_thread) {
+    // All the messages from the control plane and the RLC share one queue, so that the PDCP sees them in call order
+    ctrl_forwarder.reset(new task_queue_forwarder(task_sched.make_task_queue()));
+    up_forwarder.reset(new task_queue_forwarder(up_task_sched.make_task_queue(4096)));
+    pdcp_adapter.reset(new pdcp_up_adapter(&pdcp, &pdcp, *up_forwarder));
+    gtpu_adapter_rrc.reset(new gtpu_up_adapter(&gtpu, *up_forwarder));
+    rrc_adapter.reset(new rrc_up_adapter(&rrc, *ctrl_forwarder, stack_logger));
+  }
 }
 
 enb_stack_lte::~enb_stack_lte()
@@ -100,11 +115,15 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   // Set up pcap and trace
   if (args.mac_pcap.enable) {
+    mac_pcap.set_snaplen(args.mac_pcap.snaplen);
+    mac_pcap.set_sampling(args.mac_pcap.sampling);
     mac_pcap.open(args.mac_pcap.filename);
     mac.start_pcap(&mac_pcap);
   }
 
   if (args.mac_pcap_net.enable) {
+    mac_pcap_net.set_snaplen(args.mac_pcap.snaplen);
+    mac_pcap_net.set_sampling(args.mac_pcap.sampling);
     mac_pcap_net.open(args.mac_pcap_net.client_ip,
                       args.mac_pcap_net.bind_ip,
                       args.mac_pcap_net.client_port,
@@ -119,10 +138,14 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   // add sync queue
   sync_task_queue = task_sched.make_task_queue(args.sync_queue_size);
+  if (up_thread) {
+    up_sync_task_queue = up_task_sched.make_task_queue(args.sync_queue_size);
+  }
 
-  // add x2 queue
+  // add x2 queues. The PDUs of the NR PDCP go to the GTPU
   if (x2_ != nullptr) {
-    x2_task_queue = task_sched.make_task_queue();
+    x2_task_queue     = task_sched.make_task_queue();
+    x2_pdu_task_queue = up_sched->make_task_queue();
   }
 
   // setup bearer managers
@@ -133,9 +156,24 @@ int enb_stack_lte::init(const stack_args_t&      args_,
     stack_logger.error("Couldn't initialize MAC");
     return SRSRAN_ERROR;
   }
-  rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler());
-  pdcp.init(&rlc, &rrc, gtpu_adapter.get());
-  if (rrc.init(rrc_cfg, phy, &mac, &rlc, &pdcp, &s1ap, &gtpu, x2_) != SRSRAN_SUCCESS) {
+  pdcp_interface_rlc* rlc_pdcp = &pdcp;
+  pdcp_interface_rrc* rrc_pdcp = &pdcp;
+  gtpu_interface_rrc* rrc_gtpu = &gtpu;
+  rrc_interface_pdcp* pdcp_rrc = &rrc;
+  if (up_thread) {
+    rlc_pdcp = pdcp_adapter.get();
+    rrc_pdcp = pdcp_adapter.get();
+    rrc_gtpu = gtpu_adapter_rrc.get();
+    pdcp_rrc = rrc_adapter.get();
+  }
+  rlc.init(rlc_pdcp, &rrc, &mac, task_sched.get_timer_handler());
+  pdcp.init(&rlc, pdcp_rrc, gtpu_adapter.get());
+  if (args.pdcp_nof_crypto_workers > 0) {
+    get_crypto_workers().set_nof_workers(args.pdcp_nof_crypto_workers);
+    get_crypto_workers().start();
+    pdcp.set_tx_crypto_offload(true);
+  }
+  if (rrc.init(rrc_cfg, phy, &mac, &rlc, rrc_pdcp, &s1ap, rrc_gtpu, x2_) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize RRC");
     return SRSRAN_ERROR;
   }
@@ -151,12 +189,17 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   gtpu_args.mme_addr                     = args.s1ap.mme_addr;
   gtpu_args.gtp_bind_addr                = args.s1ap.gtp_bind_addr;
   gtpu_args.indirect_tunnel_timeout_msec = args.gtpu_indirect_tunnel_timeout_msec;
+  gtpu_args.nof_rx_sockets               = args.gtpu_nof_rx_sockets;
   if (gtpu.init(gtpu_args, gtpu_adapter.get()) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize GTPU");
     return SRSRAN_ERROR;
   }
 
   started = true;
+  if (up_thread) {
+    up_worker.running = true;
+    up_worker.start(STACK_UP_THREAD_PRIO);
+  }
   start(STACK_MAIN_THREAD_PRIO);
 
   return SRSRAN_SUCCESS;
@@ -166,6 +209,9 @@ void enb_stack_lte::tti_clock()
 {
   if (started.load(std::memory_order_relaxed)) {
     sync_task_queue.push([this]() { tti_clock_impl(); });
+    if (up_thread) {
+      up_sync_task_queue.push([this]() { up_tti_clock_impl(); });
+    }
   }
 }
 
@@ -173,6 +219,24 @@ void enb_stack_lte::tti_clock_impl()
 {
   task_sched.tic();
   rrc.tti_clock();
+  if (not up_thread) {
+    gtpu.flush_ul_pdus();
+  }
+}
+
+void enb_stack_lte::up_tti_clock_impl()
+{
+  up_task_sched.tic();
+  gtpu.flush_ul_pdus();
+}
+
+void enb_stack_lte::run_up_task(srsran::move_task_t task)
+{
+  if (up_thread) {
+    up_forwarder->run_blocking(std::move(task));
+  } else {
+    task();
+  }
 }
 
 void enb_stack_lte::stop()
@@ -188,12 +252,19 @@ void enb_stack_lte::stop_impl()
   get_rx_io_manager().stop();
 
   s1ap.stop();
-  gtpu.stop();
+  run_up_task([this]() { gtpu.stop(); });
   mac.stop();
   rlc.stop();
-  pdcp.stop();
+  run_up_task([this]() { pdcp.stop(); });
   rrc.stop();
 
+  if (up_thread) {
+    // The tasks posted by rrc.stop() run before the user-plane thread leaves
+    run_up_task([this]() { up_worker.running = false; });
+    up_task_sched.stop();
+    up_worker.wait_thread_finish();
+  }
+
   if (args.mac_pcap.enable) {
     mac_pcap.close();
   }
@@ -206,6 +277,7 @@ void enb_stack_lte::stop_impl()
     s1ap_pcap.close();
   }
 
+  get_crypto_workers().stop();
   task_sched.stop();
   get_background_workers().stop();
 
@@ -220,7 +292,7 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
     mac.get_metrics(metrics.mac);
     if (not metrics.mac.ues.empty()) {
       rlc.get_metrics(metrics.rlc, metrics.mac.ues[0].nof_tti);
-      pdcp.get_metrics(metrics.pdcp, metrics.mac.ues[0].nof_tti);
+      run_up_task([this, &metrics]() { pdcp.get_metrics(metrics.pdcp, metrics.mac.ues[0].nof_tti); });
     }
     rrc.get_metrics(metrics.rrc);
     s1ap.get_metrics(metrics.s1ap);
@@ -239,18 +311,29 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
 
 void enb_stack_lte::run_thread()
 {
+  srsran::apply_thread_affinity(srsran::thread_class_t::stack);
   while (started.load(std::memory_order_relaxed)) {
     task_sched.run_next_task();
   }
 }
 
+void enb_stack_lte::up_thread_t::run_thread()
+{
+  srsran::apply_thread_affinity(srsran::thread_class_t::stack);
+  while (running.load(std::memory_order_relaxed)) {
+    parent.up_task_sched.run_next_task();
+  }
+}
+
 void enb_stack_lte::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
   // call GTPU adapter to map to EPS bearer
   auto task = [this, rnti, lcid](srsran::unique_byte_buffer_t& pdu) {
     gtpu_adapter->write_pdu(rnti, lcid, std::move(pdu));
   };
-  x2_task_queue.push(std::bind(task, std::move(pdu)));
+  auto bound_task = std::bind(task, std::move(pdu));
+  static_assert(srsran::move_task_t::fits_small_buffer<decltype(bound_task)>(), "PDU task must not be allocated");
+  x2_pdu_task_queue.push(std::move(bound_task));
 }
 
 } // namespace srsenb
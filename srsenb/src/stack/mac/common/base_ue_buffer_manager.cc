@@ -35,6 +35,7 @@ base_ue_buffer_manager<isNR>::base_ue_buffer_manager(uint16_t rnti_, srslog::bas
   logger(logger_), rnti(rnti_)
 {
   std::fill(lcg_bsr.begin(), lcg_bsr.end(), 0);
+  std::fill(lcg_wait_ms.begin(), lcg_wait_ms.end(), 0);
 }
 
 template <bool isNR>
@@ -109,6 +110,11 @@ bool base_ue_buffer_manager<isNR>::config_lcid_internal(uint32_t lcid, const mac
       channels[lcid].bucket_size = channels[lcid].cfg.bsd * channels[lcid].cfg.pbr;
       channels[lcid].Bj          = 0;
     }
+    // The MBR bucket starts full, so that the first TTIs are not throttled
+    channels[lcid].gbr_tokens = 0;
+    channels[lcid].mbr_tokens = channels[lcid].cfg.mbr_dl * channels[lcid].cfg.bsd;
+    channels[lcid].wait_ms    = 0;
+    update_qos_lcids();
     return true;
   }
   return false;
@@ -163,6 +169,9 @@ int base_ue_buffer_manager<isNR>::ul_bsr(uint32_t lcg_id, uint32_t val)
     logger.warning("SCHED: The provided lcg_id=%d for rnti=0x%x is not valid", lcg_id, rnti);
     return SRSRAN_ERROR;
   }
+  if (val < (uint32_t)lcg_bsr[lcg_id]) {
+    lcg_wait_ms[lcg_id] = 0;
+  }
   lcg_bsr[lcg_id] = val;
   return SRSRAN_SUCCESS;
 }
@@ -179,6 +188,84 @@ int base_ue_buffer_manager<isNR>::dl_buffer_state(uint8_t lcid, uint32_t tx_queu
   return SRSRAN_SUCCESS;
 }
 
+template <bool isNR>
+void base_ue_buffer_manager<isNR>::update_qos_lcids()
+{
+  qos_lcids.clear();
+  for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
+    const mac_lc_ch_cfg_t& cfg = channels[lcid].cfg;
+    if (cfg.is_active() and (cfg.is_gbr() or cfg.mbr_dl > 0 or cfg.delay_budget > 0)) {
+      qos_lcids.push_back(lcid);
+    }
+  }
+}
+
+template <bool isNR>
+void base_ue_buffer_manager<isNR>::new_qos_period(float period_ms)
+{
+  dl_qos_urgency = 0;
+  ul_qos_urgency = 0;
+  if (qos_lcids.empty()) {
+    return;
+  }
+
+  // The UL waiting time restarts when a BSR reports that the LCG buffer was served
+  for (uint32_t lcg = 0; is_lcg_valid(lcg); ++lcg) {
+    lcg_wait_ms[lcg] = lcg_bsr[lcg] > 0 ? lcg_wait_ms[lcg] + period_ms : 0;
+  }
+
+  for (uint32_t lcid : qos_lcids) {
+    logical_channel&       ch  = channels[lcid];
+    const mac_lc_ch_cfg_t& cfg = ch.cfg;
+    if (cfg.is_dl()) {
+      if (cfg.mbr_dl > 0) {
+        ch.mbr_tokens = std::min(ch.mbr_tokens + cfg.mbr_dl * period_ms, (float)cfg.mbr_dl * cfg.bsd);
+      }
+      if (ch.buf_tx > 0) {
+        // GBR tokens only accrue while the bearer has data, an idle GBR bearer is not owed anything
+        ch.wait_ms += period_ms;
+        float urgency = cfg.delay_budget > 0 ? ch.wait_ms / cfg.delay_budget : 0;
+        if (cfg.gbr_dl > 0) {
+          float gbr_bucket = (float)cfg.gbr_dl * cfg.bsd;
+          ch.gbr_tokens    = std::min(ch.gbr_tokens + cfg.gbr_dl * period_ms, gbr_bucket);
+          urgency          = std::max(urgency, ch.gbr_tokens / gbr_bucket);
+        }
+        dl_qos_urgency = std::max(dl_qos_urgency, urgency);
+      } else {
+        ch.wait_ms    = 0;
+        ch.gbr_tokens = std::min(ch.gbr_tokens, 0.0F);
+      }
+    }
+    if (cfg.is_ul() and cfg.delay_budget > 0 and lcg_bsr[cfg.group] > 0) {
+      ul_qos_urgency = std::max(ul_qos_urgency, lcg_wait_ms[cfg.group] / cfg.delay_budget);
+    }
+  }
+}
+
+template <bool isNR>
+int base_ue_buffer_manager<isNR>::get_dl_tx_mbr_limited(uint32_t lcid) const
+{
+  int tx = get_dl_tx(lcid);
+  if (tx > 0 and channels[lcid].cfg.mbr_dl > 0) {
+    tx = std::min(tx, std::max(0, (int)channels[lcid].mbr_tokens));
+  }
+  return tx;
+}
+
+template <bool isNR>
+void base_ue_buffer_manager<isNR>::consume_dl_qos_tokens(uint32_t lcid, int bytes)
+{
+  logical_channel& ch = channels[lcid];
+  ch.wait_ms          = 0;
+  if (ch.cfg.gbr_dl > 0) {
+    // Bursts ahead of the GBR are credited for at most one bucket
+    ch.gbr_tokens = std::max(ch.gbr_tokens - bytes, -(float)ch.cfg.gbr_dl * ch.cfg.bsd);
+  }
+  if (ch.cfg.mbr_dl > 0) {
+    ch.mbr_tokens -= bytes;
+  }
+}
+
 // Explicit instantiation
 template class base_ue_buffer_manager<true>;
 template class base_ue_buffer_manager<false>;
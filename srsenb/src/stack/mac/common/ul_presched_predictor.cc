@@ -0,0 +1,120 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/stack/mac/common/ul_presched_predictor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace srsenb {
+
+void ul_presched_predictor::set_cfg(uint32_t max_bytes_, uint32_t max_misses_)
+{
+  max_bytes  = max_bytes_;
+  max_misses = std::max(max_misses_, 1U);
+}
+
+void ul_presched_predictor::reset()
+{
+  has_rx            = false;
+  burst_bytes       = 0;
+  period_est        = 0;
+  size_est          = 0;
+  nof_confirmations = 0;
+  grant_pending     = false;
+  nof_misses        = 0;
+}
+
+void ul_presched_predictor::new_slot()
+{
+  count++;
+  if (not grant_pending or count - grant_slot <= rx_window) {
+    return;
+  }
+  // The proactive grant was not used by the UE
+  grant_pending = false;
+  if (++nof_misses >= max_misses) {
+    nof_misses        = 0;
+    nof_confirmations = 0;
+    return;
+  }
+  next_grant = grant_slot + std::lround(period_est) + miss_backoff;
+}
+
+void ul_presched_predictor::ul_data_rx(uint32_t nof_bytes)
+{
+  if (max_bytes == 0 or nof_bytes == 0) {
+    return;
+  }
+  bool hit       = grant_pending and count - grant_slot <= rx_window;
+  bool new_burst = not has_rx or count - last_rx >= burst_gap;
+  uint32_t period = std::lround(period_est);
+
+  if (hit) {
+    // Probe an earlier slot in the next period
+    grant_pending = false;
+    nof_misses    = 0;
+    next_grant    = grant_slot + period - 1;
+  }
+  if (new_burst) {
+    if (has_rx) {
+      size_est = size_est == 0 ? burst_bytes : (1 - ewma_alpha) * size_est + ewma_alpha * burst_bytes;
+      // The bursts scheduled proactively are shifted by the probing and do not measure the traffic period
+      if (not hit) {
+        uint32_t sample = count - last_burst_start;
+        if (sample > max_period) {
+          nof_confirmations = 0;
+        } else if (nof_confirmations > 0 and std::abs(sample - period_est) <= period_tolerance * period_est) {
+          period_est = (1 - ewma_alpha) * period_est + ewma_alpha * sample;
+          nof_confirmations++;
+        } else {
+          period_est        = sample;
+          nof_confirmations = 1;
+        }
+        period     = std::lround(period_est);
+        next_grant = count + (period > rx_window ? period - rx_window : 1);
+      }
+    }
+    has_rx           = true;
+    last_burst_start = count;
+    burst_bytes      = 0;
+  }
+  burst_bytes += nof_bytes;
+  last_rx = count;
+}
+
+void ul_presched_predictor::ul_newtx_alloc()
+{
+  if (is_due()) {
+    grant_pending = true;
+    grant_slot    = count;
+  }
+}
+
+uint32_t ul_presched_predictor::get_presched_bytes() const
+{
+  if (not is_due()) {
+    return 0;
+  }
+  return std::min(std::max(static_cast<uint32_t>(size_est), min_presched_size), max_bytes);
+}
+
+} // namespace srsenb
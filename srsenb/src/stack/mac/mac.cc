@@ -27,6 +27,7 @@
 #include "srsran/common/rwlock_guard.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/time_prof.h"
+#include "srsran/common/tti_trace.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interface_mac.h"
@@ -66,6 +67,15 @@ bool mac::init(const mac_args_t&        args_,
 
   scheduler.init(rrc, args.sched);
 
+  // Record the scheduler inputs, so that the workload can be replayed offline
+  if (not args.sched_record_filename.empty()) {
+    sched_rec.reset(new sched_recorder(scheduler));
+    if (not sched_rec->open(args.sched_record_filename)) {
+      return false;
+    }
+    sched_h = sched_rec.get();
+  }
+
   // Init softbuffer for SI messages
   common_buffers.resize(cells.size());
   for (auto& cc : common_buffers) {
@@ -79,6 +89,9 @@ bool mac::init(const mac_args_t&        args_,
     srsran_softbuffer_tx_init(&cc.rar_softbuffer_tx, args.nof_prb);
   }
 
+  // Initiate the code block slabs, shared by the softbuffers of all UEs
+  cb_pool.reset(new softbuffer_cb_pool(cells.size(), SOFTBUFFER_SIZE, softbuffer_cb_per_batch));
+
   // Initiate common pool of softbuffers
   uint32_t nof_prb          = args.nof_prb;
   auto     init_softbuffers = [nof_prb](void* ptr) {
@@ -90,12 +103,21 @@ bool mac::init(const mac_args_t&        args_,
 
   detected_rachs.resize(cells.size());
 
+  // The scheduling thread takes the DL scheduling and the MAC PDU generation out of the PHY workers
+  if (args.sched_thread) {
+    sched_thread.reset(new srsran::task_thread_pool(1));
+  }
+
   started = true;
   return true;
 }
 
 void mac::stop()
 {
+  if (sched_thread != nullptr) {
+    sched_thread->stop();
+  }
+
   srsran::rwlock_write_guard lock(rwlock);
   if (started) {
     started = false;
@@ -108,6 +130,10 @@ void mac::stop()
       srsran_softbuffer_tx_free(&cc.pcch_softbuffer_tx);
       srsran_softbuffer_tx_free(&cc.rar_softbuffer_tx);
     }
+
+    if (sched_rec != nullptr) {
+      sched_rec->close();
+    }
   }
 }
 
@@ -143,7 +169,7 @@ int mac::rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint
   int                       ret = -1;
   if (check_ue_active(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
-      ret = scheduler.dl_rlc_buffer_state(rnti, lc_id, tx_queue, retx_queue);
+      ret = sched_h->dl_rlc_buffer_state(rnti, lc_id, tx_queue, retx_queue);
     } else {
       for (uint32_t i = 0; i < mch.num_mtch_sched; i++) {
         if (lc_id == mch.mtch_sched[i].lcid) {
@@ -159,20 +185,29 @@ int mac::rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint
 int mac::bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, mac_lc_ch_cfg_t* cfg)
 {
   srsran::rwlock_read_guard lock(rwlock);
-  return check_ue_active(rnti) ? scheduler.bearer_ue_cfg(rnti, lc_id, *cfg) : -1;
+  return check_ue_active(rnti) ? sched_h->bearer_ue_cfg(rnti, lc_id, *cfg) : -1;
 }
 
 int mac::bearer_ue_rem(uint16_t rnti, uint32_t lc_id)
 {
   srsran::rwlock_read_guard lock(rwlock);
-  return check_ue_active(rnti) ? scheduler.bearer_ue_rem(rnti, lc_id) : -1;
+  return check_ue_active(rnti) ? sched_h->bearer_ue_rem(rnti, lc_id) : -1;
 }
 
 void mac::phy_config_enabled(uint16_t rnti, bool enabled)
 {
+  if (sched_rec != nullptr) {
+    sched_rec->phy_config_enabled(rnti, enabled);
+    return;
+  }
   scheduler.phy_config_enabled(rnti, enabled);
 }
 
+bool mac::admit_gbr_bearer(uint16_t rnti, uint32_t gbr_dl, uint32_t gbr_ul)
+{
+  return scheduler.admit_gbr_bearer(rnti, gbr_dl, gbr_ul);
+}
+
 // Update UE configuration
 int mac::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t* cfg)
 {
@@ -187,7 +222,7 @@ int mac::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t* cfg)
 
   // Update Scheduler configuration
   if (cfg) {
-    if (scheduler.ue_cfg(rnti, *cfg) == SRSRAN_ERROR) {
+    if (sched_h->ue_cfg(rnti, *cfg) == SRSRAN_ERROR) {
       logger.error("Registering UE rnti=0x%x to SCHED", rnti);
       return SRSRAN_ERROR;
     }
@@ -210,7 +245,13 @@ int mac::ue_rem(uint16_t rnti)
       return SRSRAN_ERROR;
     }
   }
-  scheduler.ue_rem(rnti);
+  sched_h->ue_rem(rnti);
+  for (auto it = sps_crntis.begin(); it != sps_crntis.end(); ++it) {
+    if (it->second == rnti) {
+      sps_crntis.erase(it);
+      break;
+    }
+  }
 
   // Remove UE from the perspective of L1
   // Note: Let any pending retx ACK to arrive, so that PHY recognizes rnti
@@ -229,7 +270,7 @@ int mac::ue_set_crnti(uint16_t temp_crnti, uint16_t crnti, const sched_interface
   srsran::rwlock_read_guard lock(rwlock);
   if (temp_crnti == crnti) {
     // Schedule ConRes Msg4
-    scheduler.dl_mac_buffer_state(crnti, (uint32_t)srsran::dl_sch_lcid::CON_RES_ID);
+    sched_h->dl_mac_buffer_state(crnti, (uint32_t)srsran::dl_sch_lcid::CON_RES_ID, 1);
   }
   return ue_cfg(crnti, &cfg);
 }
@@ -238,7 +279,7 @@ int mac::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg_)
 {
   srsran::rwlock_write_guard lock(rwlock);
   cell_config = cell_cfg_;
-  return scheduler.cell_cfg(cell_config);
+  return sched_h->cell_cfg(cell_config);
 }
 
 void mac::get_metrics(mac_metrics_t& metrics)
@@ -246,14 +287,14 @@ void mac::get_metrics(mac_metrics_t& metrics)
   srsran::rwlock_read_guard lock(rwlock);
   metrics.ues.reserve(ue_db.size());
   for (auto& u : ue_db) {
-    if (not scheduler.ue_exists(u.first)) {
-      continue;
-    }
     metrics.ues.emplace_back();
     auto& ue_metrics = metrics.ues.back();
 
+    if (scheduler.metrics_read(u.first, ue_metrics) != SRSRAN_SUCCESS) {
+      metrics.ues.pop_back();
+      continue;
+    }
     u.second->metrics_read(&ue_metrics);
-    scheduler.metrics_read(u.first, ue_metrics);
     ue_metrics.pci = (ue_metrics.cc_idx < cell_config.size()) ? cell_config[ue_metrics.cc_idx].cell.id : 0;
   }
   metrics.cc_info.resize(detected_rachs.size());
@@ -261,6 +302,9 @@ void mac::get_metrics(mac_metrics_t& metrics)
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
     metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].cell.id : 0;
   }
+  if (softbuffer_pool != nullptr) {
+    metrics.softbuffer_pool = softbuffer_pool->get_metrics("harq_softbuffer");
+  }
 }
 
 void mac::toggle_padding()
@@ -274,7 +318,7 @@ void mac::add_padding()
   for (auto it = ue_db.begin(); it != ue_db.end(); ++it) {
     uint16_t cur_rnti = it->first;
     auto     ue       = it;
-    scheduler.dl_rlc_buffer_state(ue->first, args.lcid_padding, 20e6, 0);
+    sched_h->dl_rlc_buffer_state(ue->first, args.lcid_padding, 20e6, 0);
     ue->second->trigger_padding(args.lcid_padding);
   }
 }
@@ -294,8 +338,11 @@ int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
     return SRSRAN_ERROR;
   }
 
-  int nof_bytes = scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
+  int nof_bytes = sched_h->dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
   ue_db[rnti]->metrics_tx(ack, nof_bytes);
+  if (enb_cc_idx < cell_config.size()) {
+    ue_db[rnti]->release_tx_softbuffer(enb_cc_idx, tti_rx, tb_idx, ack, cell_config[enb_cc_idx]);
+  }
 
   rrc_h->set_radiolink_dl_state(rnti, ack);
 
@@ -313,11 +360,12 @@ int mac::crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
 
   ue_db[rnti]->set_tti(tti_rx);
   ue_db[rnti]->metrics_rx(crc, nof_bytes);
+  ue_db[rnti]->release_rx_softbuffer(enb_cc_idx, tti_rx, crc);
 
   rrc_h->set_radiolink_ul_state(rnti, crc);
 
   // Scheduler uses eNB's CC mapping
-  return scheduler.ul_crc_info(tti_rx, rnti, enb_cc_idx, crc);
+  return sched_h->ul_crc_info(tti_rx, rnti, enb_cc_idx, crc);
 }
 
 int mac::push_pdu(uint32_t tti_rx,
@@ -372,7 +420,7 @@ int mac::ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_v
     return SRSRAN_ERROR;
   }
 
-  scheduler.dl_ri_info(tti, rnti, enb_cc_idx, ri_value);
+  sched_h->dl_ri_info(tti, rnti, enb_cc_idx, ri_value);
   ue_db[rnti]->metrics_dl_ri(ri_value);
 
   return SRSRAN_SUCCESS;
@@ -387,7 +435,7 @@ int mac::pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi
     return SRSRAN_ERROR;
   }
 
-  scheduler.dl_pmi_info(tti, rnti, enb_cc_idx, pmi_value);
+  sched_h->dl_pmi_info(tti, rnti, enb_cc_idx, pmi_value);
   ue_db[rnti]->metrics_dl_pmi(pmi_value);
 
   return SRSRAN_SUCCESS;
@@ -402,7 +450,7 @@ int mac::cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi
     return SRSRAN_ERROR;
   }
 
-  scheduler.dl_cqi_info(tti, rnti, enb_cc_idx, cqi_value);
+  sched_h->dl_cqi_info(tti, rnti, enb_cc_idx, cqi_value);
   ue_db[rnti]->metrics_dl_cqi(cqi_value);
 
   return SRSRAN_SUCCESS;
@@ -417,7 +465,7 @@ int mac::sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
     return SRSRAN_ERROR;
   }
 
-  scheduler.dl_sb_cqi_info(tti, rnti, enb_cc_idx, sb_idx, cqi_value);
+  sched_h->dl_sb_cqi_info(tti, rnti, enb_cc_idx, sb_idx, cqi_value);
   return SRSRAN_SUCCESS;
 }
 
@@ -432,7 +480,7 @@ int mac::snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr
 
   rrc_h->set_radiolink_ul_state(rnti, snr >= args.rlf_min_ul_snr_estim);
 
-  return scheduler.ul_snr_info(tti_rx, rnti, enb_cc_idx, snr, (uint32_t)ch);
+  return sched_h->ul_snr_info(tti_rx, rnti, enb_cc_idx, snr, (uint32_t)ch);
 }
 
 int mac::ta_info(uint32_t tti, uint16_t rnti, float ta_us)
@@ -445,7 +493,7 @@ int mac::ta_info(uint32_t tti, uint16_t rnti, float ta_us)
 
   uint32_t nof_ta_count = ue_db[rnti]->set_ta_us(ta_us);
   if (nof_ta_count > 0) {
-    return scheduler.dl_mac_buffer_state(rnti, (uint32_t)srsran::dl_sch_lcid::TA_CMD, nof_ta_count);
+    return sched_h->dl_mac_buffer_state(rnti, (uint32_t)srsran::dl_sch_lcid::TA_CMD, nof_ta_count);
   }
   return SRSRAN_SUCCESS;
 }
@@ -459,7 +507,7 @@ int mac::sr_detected(uint32_t tti, uint16_t rnti)
     return SRSRAN_ERROR;
   }
 
-  return scheduler.ul_sr_info(tti, rnti);
+  return sched_h->ul_sr_info(tti, rnti);
 }
 
 bool mac::is_valid_rnti_unprotected(uint16_t rnti)
@@ -487,8 +535,8 @@ uint16_t mac::allocate_ue(uint32_t enb_cc_idx)
     // Pre-check if rnti is valid
     {
       srsran::rwlock_read_guard read_lock(rwlock);
-      if (ue_db.full()) {
-        logger.warning("Maximum number of connected UEs %zd connected to the eNB. Ignoring PRACH", SRSENB_MAX_UES);
+      if (ue_db.full() or (args.max_nof_ues > 0 and ue_db.size() >= args.max_nof_ues)) {
+        logger.warning("Maximum number of connected UEs %zd connected to the eNB. Ignoring PRACH", ue_db.size());
         return SRSRAN_INVALID_RNTI;
       }
       if (not is_valid_rnti_unprotected(rnti)) {
@@ -497,8 +545,17 @@ uint16_t mac::allocate_ue(uint32_t enb_cc_idx)
     }
 
     // Allocate and initialize UE object
-    unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
-        rnti, rnti, enb_cc_idx, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
+    unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(rnti,
+                                                   rnti,
+                                                   enb_cc_idx,
+                                                   sched_h,
+                                                   rrc_h,
+                                                   rlc_h,
+                                                   phy_h,
+                                                   logger,
+                                                   cells.size(),
+                                                   softbuffer_pool.get(),
+                                                   cb_pool.get());
 
     // Add UE to rnti map
     srsran::rwlock_write_guard rw_lock(rwlock);
@@ -554,6 +611,24 @@ uint16_t mac::reserve_new_crnti(const sched_interface::ue_cfg_t& uecfg)
   return rnti;
 }
 
+uint16_t mac::reserve_sps_crnti(uint16_t rnti)
+{
+  for (const auto& p : sps_crntis) {
+    if (p.second == rnti) {
+      return p.first;
+    }
+  }
+  for (uint32_t i = 0; i < NOF_SPS_CRNTIS; ++i) {
+    uint16_t sps_crnti = FIRST_SPS_CRNTI + (sps_crnti_counter++ % NOF_SPS_CRNTIS);
+    if (sps_crntis.insert(std::make_pair(sps_crnti, rnti)).second) {
+      logger.info("Reserved SPS C-RNTI=0x%x for rnti=0x%x", sps_crnti, rnti);
+      return sps_crnti;
+    }
+  }
+  logger.warning("No SPS C-RNTI left for rnti=0x%x", rnti);
+  return SRSRAN_INVALID_RNTI;
+}
+
 void mac::rach_detected(uint32_t tti, uint32_t enb_cc_idx, uint32_t preamble_idx, uint32_t time_adv)
 {
   static srsran::mutexed_tprof<srsran::avg_time_stats> rach_tprof("rach_tprof", "MAC", 1);
@@ -604,7 +679,7 @@ void mac::rach_detected(uint32_t tti, uint32_t enb_cc_idx, uint32_t preamble_idx
     }
 
     // Trigger scheduler RACH
-    scheduler.dl_rach_info(enb_cc_idx, rar_info);
+    sched_h->dl_rach_info(enb_cc_idx, rar_info);
 
     auto get_pci = [this, enb_cc_idx]() {
       srsran::rwlock_read_guard lock(rwlock);
@@ -630,7 +705,59 @@ void mac::rach_detected(uint32_t tti, uint32_t enb_cc_idx, uint32_t preamble_idx
   });
 }
 
+void mac::start_dl_sched(uint32_t tti_tx_dl)
+{
+  if (sched_thread == nullptr or not started) {
+    return;
+  }
+
+  sched_slot_t* slot = &sched_slots[tti_tx_dl % nof_sched_slots];
+  {
+    std::lock_guard<std::mutex> lock(sched_slots_mutex);
+    // A result still being computed cannot be overwritten, this TTI is scheduled by the PHY worker
+    if (slot->pending and not slot->ready) {
+      logger.warning("Scheduling slot of TTI %d is busy, scheduling TTI %d in the PHY worker",
+                     slot->tti_tx_dl,
+                     tti_tx_dl);
+      return;
+    }
+    slot->tti_tx_dl = tti_tx_dl;
+    slot->pending   = true;
+    slot->ready     = false;
+  }
+
+  sched_thread->push_task([this, slot, tti_tx_dl]() {
+    slot->dl_sched_res.clear();
+    slot->dl_sched_res.resize(cells.size());
+    int ret = run_dl_sched(tti_tx_dl, slot->dl_sched_res);
+
+    std::lock_guard<std::mutex> lock(sched_slots_mutex);
+    slot->ret   = ret;
+    slot->ready = true;
+    sched_slots_cvar.notify_all();
+  });
+}
+
 int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
+{
+  srsran::tti_trace_scope trace_scope(srsran::tti_trace_event::mac_get_dl_sched, tti_tx_dl);
+  if (sched_thread != nullptr) {
+    sched_slot_t*                slot = &sched_slots[tti_tx_dl % nof_sched_slots];
+    std::unique_lock<std::mutex> lock(sched_slots_mutex);
+    if (slot->pending and slot->tti_tx_dl == tti_tx_dl) {
+      sched_slots_cvar.wait(lock, [slot]() { return slot->ready; });
+      for (uint32_t cc = 0; cc < std::min(dl_sched_res_list.size(), slot->dl_sched_res.size()); ++cc) {
+        dl_sched_res_list[cc] = slot->dl_sched_res[cc];
+      }
+      slot->pending = false;
+      return slot->ret;
+    }
+  }
+
+  return run_dl_sched(tti_tx_dl, dl_sched_res_list);
+}
+
+int mac::run_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 {
   if (!started) {
     return 0;
@@ -647,7 +774,7 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < cell_config.size(); enb_cc_idx++) {
     // Run scheduler with current info
     sched_interface::dl_sched_res_t sched_result = {};
-    if (scheduler.dl_sched(tti_tx_dl, enb_cc_idx, sched_result) < 0) {
+    if (sched_h->dl_sched(tti_tx_dl, enb_cc_idx, sched_result) < 0) {
       logger.error("Running scheduler");
       return SRSRAN_ERROR;
     }
@@ -664,7 +791,12 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 
       if (ue_db.contains(rnti)) {
         // Copy dci info
-        dl_sched_res->pdsch[n].dci = sched_result.data[i].dci;
+        dl_sched_res->pdsch[n].dci         = sched_result.data[i].dci;
+        dl_sched_res->pdsch[n].sps_crnti   = sched_result.data[i].sps_crnti;
+        dl_sched_res->pdsch[n].needs_pdcch = not sched_result.data[i].no_pdcch;
+        dl_sched_res->pdsch[n].has_pdsch   = not sched_result.data[i].no_pdsch;
+        dl_sched_res->pdsch[n].n1_pucch_an =
+            sched_result.data[i].no_pdcch ? static_cast<int>(sched_result.data[i].n1_pucch_an) : -1;
 
         for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
           dl_sched_res->pdsch[n].softbuffer_tx[tb] =
@@ -675,6 +807,18 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
             continue;
           }
 
+          // Attach the code block buffers the TB needs
+          if (sched_result.data[i].tbs[tb] > 0 and
+              not ue_db[rnti]->reserve_tx_softbuffer(enb_cc_idx,
+                                                     tti_tx_dl,
+                                                     sched_result.data[i].dci.pid,
+                                                     tb,
+                                                     sched_result.data[i].tbs[tb],
+                                                     sched_result.data[i].dci.tb[tb].ndi)) {
+            logger.warning("Failed to reserve DL softbuffer for rnti=0x%x, pid=%d", rnti, sched_result.data[i].dci.pid);
+            continue;
+          }
+
           if (sched_result.data[i].nof_pdu_elems[tb] > 0) {
             /* Get PDU if it's a new transmission */
             dl_sched_res->pdsch[n].data[tb] = ue_db[rnti]->generate_pdu(enb_cc_idx,
@@ -960,6 +1104,7 @@ uint8_t* mac::assemble_rar(sched_interface::dl_sched_rar_grant_t* grants,
 
 int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
 {
+  srsran::tti_trace_scope trace_scope(srsran::tti_trace_event::mac_get_ul_sched, tti_tx_ul);
   if (!started) {
     return SRSRAN_SUCCESS;
   }
@@ -978,7 +1123,7 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
 
     // Run scheduler with current info
     sched_interface::ul_sched_res_t sched_result = {};
-    if (scheduler.ul_sched(tti_tx_ul, enb_cc_idx, sched_result) < 0) {
+    if (sched_h->ul_sched(tti_tx_ul, enb_cc_idx, sched_result) < 0) {
       logger.error("Running scheduler");
       return SRSRAN_ERROR;
     }
@@ -996,6 +1141,7 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
           phy_ul_sched_res->pusch[n].current_tx_nb = sched_result.pusch[i].current_tx_nb;
           phy_ul_sched_res->pusch[n].pid           = TTI_RX(tti_tx_ul) % SRSRAN_FDD_NOF_HARQ;
           phy_ul_sched_res->pusch[n].needs_pdcch   = sched_result.pusch[i].needs_pdcch;
+          phy_ul_sched_res->pusch[n].sps_crnti     = sched_result.pusch[i].sps_crnti;
           phy_ul_sched_res->pusch[n].dci           = sched_result.pusch[i].dci;
           phy_ul_sched_res->pusch[n].softbuffer_rx = ue_db[rnti]->get_rx_softbuffer(enb_cc_idx, tti_tx_ul);
 
@@ -1005,6 +1151,13 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
             continue;
           }
 
+          // Attach the code block buffers the TB needs
+          if (not ue_db[rnti]->reserve_rx_softbuffer(
+                  enb_cc_idx, tti_tx_ul, sched_result.pusch[i].tbs, sched_result.pusch[i].current_tx_nb)) {
+            logger.warning("Failed to reserve UL softbuffer for tti=%d, cc=%d", tti_tx_ul, enb_cc_idx);
+            continue;
+          }
+
           if (sched_result.pusch[n].current_tx_nb == 0) {
             srsran_softbuffer_rx_reset_tbs(phy_ul_sched_res->pusch[n].softbuffer_rx, sched_result.pusch[i].tbs * 8);
           }
@@ -1055,8 +1208,17 @@ void mac::write_mcch(const srsran::sib2_mbms_t* sib2_,
   memcpy(mcch_payload_buffer, mcch_payload, mcch_payload_length * sizeof(uint8_t));
   current_mcch_length = mcch_payload_length;
 
-  unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
-      SRSRAN_MRNTI, SRSRAN_MRNTI, 0, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
+  unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(SRSRAN_MRNTI,
+                                                 SRSRAN_MRNTI,
+                                                 0,
+                                                 sched_h,
+                                                 rrc_h,
+                                                 rlc_h,
+                                                 phy_h,
+                                                 logger,
+                                                 cells.size(),
+                                                 softbuffer_pool.get(),
+                                                 cb_pool.get());
 
   auto ret = ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr));
   if (!ret) {
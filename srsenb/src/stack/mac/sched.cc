@@ -50,7 +50,7 @@ void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
   sched_cfg = sched_cfg_;
 
   // Initialize first carrier scheduler
-  carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0, &sched_results});
+  carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, &active_ues, 0, &sched_results});
 
   reset();
 }
@@ -61,6 +61,7 @@ int sched::reset()
   for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
     c->reset();
   }
+  active_ues.clear();
   ue_db.clear();
   return 0;
 }
@@ -79,11 +80,17 @@ int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
 
   sched_results.set_nof_carriers(cell_cfg.size());
 
+  // The first carrier is scheduled by the caller thread, the helpers take the rest
+  uint32_t nof_cc_workers = std::min(sched_cfg.nof_cc_workers, (uint32_t)cell_cfg.size() - 1);
+  if (nof_cc_workers > 0 and (cc_workers == nullptr or cc_workers->nof_workers() != nof_cc_workers)) {
+    cc_workers.reset(new srsran::task_thread_pool(nof_cc_workers));
+  }
+
   // Create remaining cells, if not created yet
   uint32_t prev_size = carrier_schedulers.size();
   carrier_schedulers.resize(sched_cell_params.size());
   for (uint32_t i = prev_size; i < sched_cell_params.size(); ++i) {
-    carrier_schedulers[i].reset(new carrier_sched{rrc, &ue_db, i, &sched_results});
+    carrier_schedulers[i].reset(new carrier_sched{rrc, &ue_db, &active_ues, i, &sched_results});
   }
 
   // setup all carriers cfg params
@@ -109,6 +116,7 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
     auto                        it = ue_db.find(rnti);
     if (it != ue_db.end()) {
       it->second->set_cfg(ue_cfg);
+      active_ues.add(*it->second);
       return SRSRAN_SUCCESS;
     }
   }
@@ -116,6 +124,7 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
   // Add new user case
   std::unique_ptr<sched_ue>   ue{new sched_ue(rnti, sched_cell_params, ue_cfg)};
   std::lock_guard<std::mutex> lock(sched_mutex);
+  active_ues.add(*ue);
   ue_db.insert(rnti, std::move(ue));
   return SRSRAN_SUCCESS;
 }
@@ -124,6 +133,10 @@ int sched::ue_rem(uint16_t rnti)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
   if (ue_db.contains(rnti)) {
+    active_ues.rem(*ue_db[rnti]);
+    for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
+      c->ue_rem(rnti);
+    }
     ue_db.erase(rnti);
   } else {
     Error("User rnti=0x%x not found", rnti);
@@ -142,7 +155,61 @@ void sched::phy_config_enabled(uint16_t rnti, bool enabled)
 {
   // TODO: Check if correct use of last_tti
   ue_db_access_locked(
-      rnti, [this, enabled](sched_ue& ue) { ue.phy_config_enabled(last_tti, enabled); }, __PRETTY_FUNCTION__);
+      rnti,
+      [this, enabled](sched_ue& ue) {
+        ue.phy_config_enabled(last_tti, enabled);
+        active_ues.add(ue);
+      },
+      __PRETTY_FUNCTION__);
+}
+
+bool sched::admit_gbr_bearer(uint16_t rnti, uint32_t gbr_dl, uint32_t gbr_ul)
+{
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  auto                        it = ue_db.find(rnti);
+  if (it == ue_db.end() or it->second->get_ue_cfg().supported_cc_list.empty()) {
+    return false;
+  }
+  uint32_t enb_cc_idx = it->second->get_ue_cfg().supported_cc_list[0].enb_cc_idx;
+  if (sched_cfg.gbr_max_load <= 0 or enb_cc_idx >= sched_cell_params.size()) {
+    return true;
+  }
+
+  // Sum of the GBRs already configured in the cell
+  uint64_t dl_load = gbr_dl, ul_load = gbr_ul;
+  for (auto& u : ue_db) {
+    const ue_cfg_t& ue_cfg = u.second->get_ue_cfg();
+    if (ue_cfg.supported_cc_list.empty() or ue_cfg.supported_cc_list[0].enb_cc_idx != enb_cc_idx) {
+      continue;
+    }
+    for (const mac_lc_ch_cfg_t& bearer : ue_cfg.ue_bearers) {
+      if (bearer.is_active()) {
+        dl_load += bearer.gbr_dl;
+        ul_load += bearer.gbr_ul;
+      }
+    }
+  }
+
+  // Peak rate of the cell at the maximum MCS, in kB/s (bytes per TTI)
+  uint32_t nof_prb = sched_cell_params[enb_cc_idx].nof_prb();
+  int      dl_mcs  = sched_cfg.pdsch_max_mcs < 0 ? 28 : std::min(sched_cfg.pdsch_max_mcs, 28);
+  int      ul_mcs  = sched_cfg.pusch_max_mcs < 0 ? 28 : std::min(sched_cfg.pusch_max_mcs, 28);
+  int      dl_tbs  = srsran_ra_tbs_from_idx(srsran_ra_tbs_idx_from_mcs(dl_mcs, false, false), nof_prb);
+  int      ul_tbs  = srsran_ra_tbs_from_idx(srsran_ra_tbs_idx_from_mcs(ul_mcs, false, true), nof_prb);
+  float    dl_cap  = sched_cfg.gbr_max_load * std::max(dl_tbs, 0) / 8 / tti_duration_ms;
+  float    ul_cap  = sched_cfg.gbr_max_load * std::max(ul_tbs, 0) / 8 / tti_duration_ms;
+  if (dl_load > dl_cap or ul_load > ul_cap) {
+    srslog::fetch_basic_logger("MAC").warning(
+        "SCHED: Rejecting GBR bearer of rnti=0x%x. GBR load of cc=%d would be DL=%d/%.0f, UL=%d/%.0f kB/s",
+        rnti,
+        enb_cc_idx,
+        (int)dl_load,
+        dl_cap,
+        (int)ul_load,
+        ul_cap);
+    return false;
+  }
+  return true;
 }
 
 int sched::bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, const mac_lc_ch_cfg_t& cfg_)
@@ -176,12 +243,18 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
 
 int sched::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue)
 {
-  return ue_db_access_locked(rnti, [&](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue); });
+  return ue_db_access_locked(rnti, [&](sched_ue& ue) {
+    ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue);
+    active_ues.add(ue);
+  });
 }
 
 int sched::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds)
 {
-  return ue_db_access_locked(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
+  return ue_db_access_locked(rnti, [this, ce_code, nof_cmds](sched_ue& ue) {
+    ue.mac_buffer_state(ce_code, nof_cmds);
+    active_ues.add(ue);
+  });
 }
 
 int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
@@ -189,15 +262,20 @@ int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint
   int ret = -1;
   ue_db_access_locked(
       rnti,
-      [&](sched_ue& ue) { ret = ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack); },
+      [&](sched_ue& ue) {
+        ret = ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack);
+        active_ues.add(ue);
+      },
       __PRETTY_FUNCTION__);
   return ret;
 }
 
 int sched::ul_crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, bool crc)
 {
-  return ue_db_access_locked(
-      rnti, [tti_rx, enb_cc_idx, crc](sched_ue& ue) { ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc); });
+  return ue_db_access_locked(rnti, [this, tti_rx, enb_cc_idx, crc](sched_ue& ue) {
+    ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc);
+    active_ues.add(ue);
+  });
 }
 
 int sched::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
@@ -214,8 +292,11 @@ int sched::dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_
 
 int sched::dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, cqi_value](sched_ue& ue) { ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value); });
+  // The CQI may trigger the activation of a SCell
+  return ue_db_access_locked(rnti, [this, tti, enb_cc_idx, cqi_value](sched_ue& ue) {
+    ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value);
+    active_ues.add(ue);
+  });
 }
 
 int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value)
@@ -239,12 +320,23 @@ int sched::ul_snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, floa
 
 int sched::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 {
-  return ue_db_access_locked(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
+  return ue_db_access_locked(rnti, [this, lcg_id, bsr](sched_ue& ue) {
+    ue.ul_buffer_state(lcg_id, bsr);
+    active_ues.add(ue);
+  });
 }
 
 int sched::ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes)
 {
-  return ue_db_access_locked(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
+  return ue_db_access_locked(rnti, [this, lcid, bytes](sched_ue& ue) {
+    ue.ul_buffer_add(lcid, bytes);
+    active_ues.add(ue);
+  });
+}
+
+int sched::ul_sdu_info(uint16_t rnti, uint32_t lcid, uint32_t nof_bytes)
+{
+  return ue_db_access_locked(rnti, [lcid, nof_bytes](sched_ue& ue) { ue.ul_sdu_info(lcid, nof_bytes); });
 }
 
 int sched::ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)
@@ -256,7 +348,12 @@ int sched::ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)
 int sched::ul_sr_info(uint32_t tti, uint16_t rnti)
 {
   return ue_db_access_locked(
-      rnti, [](sched_ue& ue) { ue.set_sr(); }, __PRETTY_FUNCTION__);
+      rnti,
+      [this](sched_ue& ue) {
+        ue.set_sr();
+        active_ues.add(ue);
+      },
+      __PRETTY_FUNCTION__);
 }
 
 void sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
@@ -361,6 +458,24 @@ void sched::new_tti(tti_point tti_rx)
 {
   last_tti = std::max(last_tti, tti_rx);
 
+  // The UEs that went idle stop being scheduling candidates
+  if (not is_generated(tti_rx, 0)) {
+    active_ues.prune();
+  }
+
+  if (cc_workers != nullptr) {
+    srsran::bounded_vector<uint32_t, SRSRAN_MAX_CARRIERS> cc_list;
+    for (uint32_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+      if (not is_generated(tti_rx, cc_idx)) {
+        cc_list.push_back(cc_idx);
+      }
+    }
+    if (cc_list.size() > 1) {
+      new_tti_parallel(tti_rx, cc_list);
+      return;
+    }
+  }
+
   // Generate sched results for all CCs, if not yet generated
   for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
@@ -370,16 +485,74 @@ void sched::new_tti(tti_point tti_rx)
   }
 }
 
+/// Generate the scheduling decision of several CCs concurrently. The carriers only share the UEs, so the TTI is split:
+/// 1. Sequentially, the UE-wide TTI state and the result storage are set up.
+/// 2. Concurrently, each carrier takes its PHICH, broadcast, RAR and UE allocation decisions. They read the UE buffers
+///    and HARQs, but they only write the carrier grid.
+/// 3. Sequentially, in CC order, the DCIs and MAC PDUs are generated. This reconciles the UE-wide state: the DL buffers
+///    are consumed by the lower CCs first and the UCI on PUSCH is placed as in the sequential scheduler. A CA UE may
+///    get grants larger than its buffers in several CCs, which are padded.
+void sched::new_tti_parallel(tti_point tti_rx, const srsran::bounded_vector<uint32_t, SRSRAN_MAX_CARRIERS>& cc_list)
+{
+  for (auto& user : ue_db) {
+    user.second->new_subframe(tti_rx, cc_list[0]);
+  }
+  for (uint32_t cc_idx : cc_list) {
+    carrier_schedulers[cc_idx]->prepare_tti(tti_rx);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(cc_workers_mutex);
+    cc_workers_pending = cc_list.size() - 1;
+  }
+  for (uint32_t i = 1; i < cc_list.size(); ++i) {
+    carrier_sched* carrier = carrier_schedulers[cc_list[i]].get();
+    cc_workers->push_task([this, carrier, tti_rx]() {
+      carrier->schedule_tti(tti_rx);
+      std::lock_guard<std::mutex> lock(cc_workers_mutex);
+      cc_workers_pending--;
+      cc_workers_cvar.notify_one();
+    });
+  }
+  carrier_schedulers[cc_list[0]]->schedule_tti(tti_rx);
+  {
+    std::unique_lock<std::mutex> lock(cc_workers_mutex);
+    cc_workers_cvar.wait(lock, [this]() { return cc_workers_pending == 0; });
+  }
+
+  for (uint32_t cc_idx : cc_list) {
+    carrier_schedulers[cc_idx]->finish_tti_result(tti_rx);
+  }
+}
+
 /// Check if TTI result is generated
 bool sched::is_generated(srsran::tti_point tti_rx, uint32_t enb_cc_idx) const
 {
   return sched_results.has_sf(tti_rx) and sched_results.get_sf(tti_rx)->is_generated(enb_cc_idx);
 }
 
+// Reads all the scheduler metrics of the UE with a single lock, so that the metrics thread does not stall the TTI
 int sched::metrics_read(uint16_t rnti, mac_ue_metrics_t& metrics)
 {
   return ue_db_access_locked(
-      rnti, [&metrics](sched_ue& ue) { ue.metrics_read(metrics); }, "metrics_read");
+      rnti,
+      [this, &metrics](sched_ue& ue) {
+        ue.metrics_read(metrics);
+        metrics.dl_buffer = ue.get_pending_dl_rlc_data();
+        metrics.ul_buffer = ue.get_pending_ul_new_data(to_tx_ul(last_tti), -1);
+
+        // set PCell sector id
+        metrics.cc_idx = SRSRAN_MAX_CARRIERS;
+        for (size_t enb_cc_idx = 0; enb_cc_idx < carrier_schedulers.size(); ++enb_cc_idx) {
+          const sched_ue_cell* cc_ue = ue.find_ue_carrier(enb_cc_idx);
+          if (cc_ue != nullptr and cc_ue->get_ue_cc_idx() == 0) {
+            metrics.cc_idx = enb_cc_idx;
+            break;
+          }
+        }
+      },
+      "metrics_read",
+      false);
 }
 
 // Common way to access ue_db elements in a read locking way
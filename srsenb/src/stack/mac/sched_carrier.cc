@@ -21,7 +21,9 @@
 
 #include "srsenb/hdr/stack/mac/sched_carrier.h"
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsenb/hdr/stack/mac/schedulers/sched_freq_pf.h"
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
+#include "srsenb/hdr/stack/mac/schedulers/sched_time_qos.h"
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_rr.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/string_helpers.h"
@@ -330,12 +332,14 @@ void ra_sched::reset()
  *                 Carrier scheduling
  *******************************************************/
 
-sched::carrier_sched::carrier_sched(rrc_interface_mac*       rrc_,
-                                    sched_ue_list*           ue_db_,
-                                    uint32_t                 enb_cc_idx_,
-                                    sched_result_ringbuffer* sched_results_) :
+sched::carrier_sched::carrier_sched(rrc_interface_mac*          rrc_,
+                                    sched_ue_list*              ue_db_,
+                                    const sched_ue_active_list* active_ues_,
+                                    uint32_t                    enb_cc_idx_,
+                                    sched_result_ringbuffer*    sched_results_) :
   rrc(rrc_),
   ue_db(ue_db_),
+  active_ues(active_ues_),
   logger(srslog::fetch_basic_logger("MAC")),
   enb_cc_idx(enb_cc_idx_),
   prev_sched_results(sched_results_)
@@ -349,6 +353,7 @@ void sched::carrier_sched::reset()
 {
   ra_sched_ptr.reset();
   bc_sched_ptr.reset();
+  sched_algo.reset();
   pending_pdcch_orders.clear();
 }
 
@@ -365,8 +370,14 @@ void sched::carrier_sched::carrier_cfg(const sched_cell_params_t& cell_params_)
   if (cell_params_.sched_cfg->sched_policy == "time_rr") {
     sched_algo.reset(new sched_time_rr{*cc_cfg, *cell_params_.sched_cfg});
     logger.info("Using time-domain RR scheduling policy for cc=%d", cc_cfg->enb_cc_idx);
+  } else if (cell_params_.sched_cfg->sched_policy == "freq_pf") {
+    sched_algo.reset(new sched_freq_pf{*cc_cfg, *cell_params_.sched_cfg, *active_ues});
+    logger.info("Using frequency-domain PF scheduling policy for cc=%d", cc_cfg->enb_cc_idx);
+  } else if (cell_params_.sched_cfg->sched_policy == "time_qos") {
+    sched_algo.reset(new sched_time_qos{*cc_cfg, *cell_params_.sched_cfg, *active_ues});
+    logger.info("Using time-domain QoS-weighted PF scheduling policy for cc=%d", cc_cfg->enb_cc_idx);
   } else {
-    sched_algo.reset(new sched_time_pf{*cc_cfg, *cell_params_.sched_cfg});
+    sched_algo.reset(new sched_time_pf{*cc_cfg, *cell_params_.sched_cfg, *active_ues});
     logger.info("Using time-domain PF scheduling policy for cc=%d", cc_cfg->enb_cc_idx);
   }
 
@@ -383,17 +394,30 @@ void sched::carrier_sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
 
 const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_rx)
 {
-  sf_sched*        tti_sched = get_sf_sched(tti_rx);
-  sf_sched_result* sf_result = prev_sched_results->get_sf(tti_rx);
-  cc_sched_result* cc_result = sf_result->get_cc(enb_cc_idx);
-
-  bool dl_active = sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0;
-
   /* Refresh UE internal buffers and subframe vars */
   for (auto& user : *ue_db) {
     user.second->new_subframe(tti_rx, enb_cc_idx);
   }
 
+  prepare_tti(tti_rx);
+  schedule_tti(tti_rx);
+  return finish_tti_result(tti_rx);
+}
+
+void sched::carrier_sched::prepare_tti(tti_point tti_rx)
+{
+  get_sf_sched(tti_rx);
+  if (sf_dl_mask[to_tx_dl(tti_rx).to_uint() % sf_dl_mask.size()] == 0) {
+    get_sf_sched(tti_rx + MSG3_DELAY_MS);
+  }
+}
+
+void sched::carrier_sched::schedule_tti(tti_point tti_rx)
+{
+  sf_sched* tti_sched = get_sf_sched(tti_rx);
+
+  bool dl_active = sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0;
+
   /* Schedule PHICH */
   for (auto& ue_pair : *ue_db) {
     if (tti_sched->alloc_phich(ue_pair.second.get()) == alloc_result::no_grant_space) {
@@ -417,6 +441,10 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
     pdcch_order_sched(tti_sched);
   }
 
+  /* Schedule the SPS grants, whose resources are fixed by their activation. The PRBs of the UL occasions were
+   * reserved when the subframe was created. A DL occasion that collides with broadcast data is skipped */
+  sps_sched(tti_sched, dl_active);
+
   /* Prioritize PDCCH scheduling for DL and UL data in a RoundRobin fashion */
   if ((tti_rx.to_uint() % 2) == 0) {
     alloc_ul_users(tti_sched);
@@ -428,6 +456,12 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
   if ((tti_rx.to_uint() % 2) == 1) {
     alloc_ul_users(tti_sched);
   }
+}
+
+const cc_sched_result& sched::carrier_sched::finish_tti_result(tti_point tti_rx)
+{
+  sf_sched*        tti_sched = get_sf_sched(tti_rx);
+  cc_sched_result* cc_result = prev_sched_results->get_sf(tti_rx)->get_cc(enb_cc_idx);
 
   /* Select the winner DCI allocation combination, store all the scheduling results */
   tti_sched->generate_sched_results(*ue_db);
@@ -480,10 +514,108 @@ sf_sched* sched::carrier_sched::get_sf_sched(tti_point tti_rx)
     sf_sched_result* sf_res = prev_sched_results->get_sf(tti_rx);
     // start new TTI for the given CC.
     ret->new_tti(tti_rx, sf_res);
+
+    // Reserve the PRBs of the UL SPS occasions before any other UL allocation, e.g. Msg3, is made
+    for (sched_ue* u : *active_ues) {
+      const sps_ue_manager& sps = u->get_sps();
+      if (sps.is_ul_occasion(ret->get_tti_tx_ul()) and u->get_ue_cfg().supported_cc_list[0].enb_cc_idx == enb_cc_idx and
+          u->pusch_enabled(tti_rx, enb_cc_idx, false)) {
+        ret->reserve_ul_sps(u->get_rnti(), sps.get_ul_alloc());
+      }
+    }
   }
   return ret;
 }
 
+void sched::carrier_sched::sps_sched(sf_sched* tti_sched, bool dl_active)
+{
+  using dl_alloc_t = sf_sched::dl_alloc_t;
+  using ul_alloc_t = sf_sched::ul_alloc_t;
+
+  // NOTE: In case of 6 PRBs, do not transmit if there is going to be a PRACH in the UL to avoid collisions
+  bool dl_blocked = not dl_active;
+  if (cc_cfg->nof_prb() == 6) {
+    tti_point tti_rx_ack = to_tx_dl_ack(tti_sched->get_tti_rx());
+    dl_blocked |= srsran_prach_in_window_config_fdd(cc_cfg->cfg.prach_config, tti_rx_ack.to_uint(), -1);
+  }
+
+  for (sched_ue* u : *active_ues) {
+    sps_ue_manager& sps = u->get_sps();
+    if (u->nof_carriers_configured() != 1 or u->get_ue_cfg().supported_cc_list[0].enb_cc_idx != enb_cc_idx) {
+      continue;
+    }
+    sched_ue_cell* cc = u->find_ue_carrier(enb_cc_idx);
+    if (cc == nullptr or cc->cc_state() != cc_st::active) {
+      continue;
+    }
+
+    /* UL SPS */
+    tti_point tti_tx_ul = tti_sched->get_tti_tx_ul();
+    if (sps.ul_configured()) {
+      if (sps.is_ul_occasion(tti_tx_ul)) {
+        if (tti_sched->alloc_ul_sps(u, sps.get_ul_alloc(), ul_alloc_t::SPS_OCCASION) == alloc_result::success) {
+          sps.ul_occasion(u->get_pending_ul_new_data(tti_tx_ul, enb_cc_idx) > 0);
+        }
+      } else if (sps.get_ul_state() == sps_ue_manager::state_t::inactive and u->get_pending_ul_sps_bytes() > 0 and
+                 u->get_ul_harq(tti_tx_ul, enb_cc_idx)->is_empty() and not tti_sched->is_ul_alloc(u->get_rnti())) {
+        // The PRACH PRBs are avoided, as they recur with the SPS occasions
+        prbmask_t used_mask   = tti_sched->get_ul_mask();
+        uint32_t  prach_start = cc_cfg->cfg.prach_freq_offset;
+        used_mask.fill(prach_start, std::min(prach_start + 6, cc_cfg->nof_prb()));
+        prb_interval alloc;
+        tbs_info     tb;
+        if (find_ul_sps_grant(*cc, used_mask, u->get_pending_ul_sps_bytes(), alloc, tb) and
+            tti_sched->alloc_ul_sps(u, alloc, ul_alloc_t::SPS_ACTIVATION) == alloc_result::success) {
+          sps.ul_activated(tti_tx_ul, alloc, tb);
+        }
+      }
+    }
+
+    /* DL SPS */
+    tti_point tti_tx_dl = tti_sched->get_tti_tx_dl();
+    if (not sps.dl_configured() or dl_blocked) {
+      continue;
+    }
+    switch (sps.get_dl_state()) {
+      case sps_ue_manager::state_t::inactive: {
+        // The activation is aligned with the first SPS HARQ, so that the pid signalled in the DCI is the SPS pid
+        uint32_t pid = sps.get_dl_pid(tti_tx_dl);
+        if (u->get_pending_dl_sps_bytes() == 0 or pid != 0 or not u->get_dl_harq(pid, enb_cc_idx).is_empty()) {
+          break;
+        }
+        rbgmask_t mask;
+        tbs_info  tb;
+        if (find_dl_sps_grant(*cc, tti_tx_dl, tti_sched->get_dl_mask(), u->get_pending_dl_sps_bytes(), mask, tb) and
+            tti_sched->alloc_dl_sps(u, mask, pid, dl_alloc_t::SPS_ACTIVATION) == alloc_result::success) {
+          sps.dl_activated(tti_tx_dl, mask, tb);
+        }
+        break;
+      }
+      case sps_ue_manager::state_t::active: {
+        if (not sps.is_dl_occasion(tti_tx_dl)) {
+          break;
+        }
+        uint32_t pid = sps.get_dl_pid(tti_tx_dl);
+        if (u->get_pending_dl_bytes(enb_cc_idx) == 0) {
+          sps.dl_occasion(false);
+        } else if (tti_sched->alloc_dl_sps(u, sps.get_dl_mask(), pid, dl_alloc_t::SPS_OCCASION) ==
+                   alloc_result::success) {
+          sps.dl_occasion(true);
+        }
+        break;
+      }
+      case sps_ue_manager::state_t::releasing:
+        if (tti_sched->alloc_dl_sps(u, rbgmask_t(cc_cfg->nof_rbgs), 0, dl_alloc_t::SPS_RELEASE) ==
+            alloc_result::success) {
+          sps.dl_released();
+        }
+        break;
+    }
+  }
+
+  tti_sched->release_ul_sps_reservations();
+}
+
 const sf_sched_result* sched::carrier_sched::get_sf_result(tti_point tti_rx) const
 {
   return prev_sched_results->get_sf(tti_rx);
@@ -507,6 +639,13 @@ int sched::carrier_sched::pdcch_order_info(dl_sched_po_info_t pdcch_order_info)
   return SRSRAN_SUCCESS;
 }
 
+void sched::carrier_sched::ue_rem(uint16_t rnti)
+{
+  if (sched_algo != nullptr) {
+    sched_algo->rem_user(rnti);
+  }
+}
+
 void sched::carrier_sched::pdcch_order_sched(sf_sched* tti_sched)
 {
   for (auto it = pending_pdcch_orders.begin(); it != pending_pdcch_orders.end();) {
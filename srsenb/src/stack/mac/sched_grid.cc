@@ -194,6 +194,24 @@ alloc_result sf_grid_t::alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask
   return ret;
 }
 
+//! Allocates the RBs of a DL SPS assignment. Only the activation and the release carry a PDCCH, in format 1A
+alloc_result sf_grid_t::alloc_dl_sps(sched_ue* user, const rbgmask_t& user_mask, bool needs_pdcch, bool has_pusch_grant)
+{
+  if (needs_pdcch) {
+    uint32_t nof_bits = srsran_dci_format_sizeof(&cc_cfg->cfg.cell, nullptr, nullptr, SRSRAN_DCI_FORMAT1A);
+    uint32_t aggr_idx = user->get_aggr_level(cc_cfg->enb_cc_idx, nof_bits);
+    return alloc_dl(aggr_idx, alloc_type_t::DL_DATA, user_mask, user, has_pusch_grant);
+  }
+
+  if ((dl_mask & user_mask).any()) {
+    logger.debug("SCHED: DL SPS occasion of rnti=0x%x collides with allocation previously made.", user->get_rnti());
+    return alloc_result::sch_collision;
+  }
+  dl_mask |= user_mask;
+
+  return alloc_result::success;
+}
+
 alloc_result sf_grid_t::alloc_ul_data(sched_ue* user, prb_interval alloc, bool needs_pdcch, bool strict)
 {
   if (alloc.stop() > ul_mask.size()) {
@@ -256,6 +274,13 @@ alloc_result sf_grid_t::reserve_ul_prbs(prb_interval alloc, bool strict)
   return reserve_ul_prbs(newmask, strict);
 }
 
+void sf_grid_t::release_ul_prbs(prb_interval alloc)
+{
+  prbmask_t mask(ul_mask.size());
+  mask.fill(alloc.start(), std::min(alloc.stop(), (uint32_t)ul_mask.size()));
+  ul_mask &= ~mask;
+}
+
 alloc_result sf_grid_t::reserve_ul_prbs(const prbmask_t& prbmask, bool strict)
 {
   alloc_result ret = alloc_result::success;
@@ -328,6 +353,7 @@ void sf_sched::new_tti(tti_point tti_rx_, sf_sched_result* cc_results_)
   po_allocs.clear();
   data_allocs.clear();
   ul_data_allocs.clear();
+  ul_sps_reservations.clear();
 
   tti_rx = tti_rx_;
   tti_alloc.new_tti(tti_rx_);
@@ -643,6 +669,102 @@ alloc_result sf_sched::alloc_ul_user(sched_ue* user, prb_interval alloc)
   return alloc_ul(user, alloc, alloc_type, h->is_msg3());
 }
 
+alloc_result
+sf_sched::alloc_dl_sps(sched_ue* user, const rbgmask_t& user_mask, uint32_t pid, dl_alloc_t::type_t sps_type)
+{
+  if (data_allocs.full()) {
+    logger.warning("SCHED: Maximum number of DL allocations reached");
+    return alloc_result::no_grant_space;
+  }
+  if (is_dl_alloc(user->get_rnti())) {
+    return alloc_result::no_rnti_opportunity;
+  }
+  if (not user->pdsch_enabled(get_tti_rx(), cc_cfg->enb_cc_idx)) {
+    return alloc_result::no_rnti_opportunity;
+  }
+
+  bool         needs_pdcch     = sps_type != dl_alloc_t::SPS_OCCASION;
+  bool         has_pusch_grant = is_ul_alloc(user->get_rnti());
+  alloc_result ret             = tti_alloc.alloc_dl_sps(user, user_mask, needs_pdcch, has_pusch_grant);
+  if (ret != alloc_result::success) {
+    return ret;
+  }
+
+  dl_alloc_t alloc;
+  alloc.dci_idx   = needs_pdcch ? tti_alloc.get_pdcch_grid().nof_allocs() - 1 : 0;
+  alloc.rnti      = user->get_rnti();
+  alloc.user_mask = user_mask;
+  alloc.pid       = pid;
+  alloc.type      = sps_type;
+  data_allocs.push_back(alloc);
+
+  return alloc_result::success;
+}
+
+alloc_result sf_sched::alloc_ul_sps(sched_ue* user, prb_interval alloc, ul_alloc_t::sps_t sps_type)
+{
+  if (ul_data_allocs.full()) {
+    logger.debug("SCHED: Maximum number of UL allocations=%zd reached", ul_data_allocs.size());
+    return alloc_result::no_grant_space;
+  }
+  if (is_ul_alloc(user->get_rnti())) {
+    return alloc_result::no_rnti_opportunity;
+  }
+
+  bool needs_pdcch = sps_type == ul_alloc_t::SPS_ACTIVATION;
+  if (not user->pusch_enabled(get_tti_rx(), cc_cfg->enb_cc_idx, needs_pdcch)) {
+    logger.debug("SCHED: PDCCH/PUSCH would collide with rnti=0x%x Measurement Gap", user->get_rnti());
+    return alloc_result::no_rnti_opportunity;
+  }
+
+  // The PRBs of the occasions may have been reserved when the subframe was created
+  uint16_t rnti     = user->get_rnti();
+  auto     same_ue  = [rnti](const ul_sps_reservation_t& r) { return r.rnti == rnti; };
+  auto     it       = std::find_if(ul_sps_reservations.begin(), ul_sps_reservations.end(), same_ue);
+  bool     reserved = it != ul_sps_reservations.end() and it->alloc == alloc;
+  if (it != ul_sps_reservations.end()) {
+    tti_alloc.release_ul_prbs(it->alloc);
+    ul_sps_reservations.erase(it);
+  }
+  alloc_result ret = tti_alloc.alloc_ul_data(user, alloc, needs_pdcch, not reserved);
+  if (ret != alloc_result::success) {
+    return ret;
+  }
+
+  ul_data_allocs.emplace_back();
+  ul_alloc_t& ul_alloc = ul_data_allocs.back();
+  ul_alloc.type        = ul_alloc_t::NEWTX;
+  ul_alloc.dci_idx     = needs_pdcch ? tti_alloc.get_pdcch_grid().nof_allocs() - 1 : 0;
+  ul_alloc.rnti        = user->get_rnti();
+  ul_alloc.alloc       = alloc;
+  ul_alloc.sps         = sps_type;
+
+  return alloc_result::success;
+}
+
+alloc_result sf_sched::reserve_ul_sps(uint16_t rnti, prb_interval alloc)
+{
+  if (ul_sps_reservations.full()) {
+    return alloc_result::no_grant_space;
+  }
+  prbmask_t mask(get_ul_mask().size());
+  mask.fill(alloc.start(), alloc.stop());
+  if ((get_ul_mask() & mask).any()) {
+    return alloc_result::sch_collision;
+  }
+  tti_alloc.reserve_ul_prbs(mask, false);
+  ul_sps_reservations.push_back({rnti, alloc});
+  return alloc_result::success;
+}
+
+void sf_sched::release_ul_sps_reservations()
+{
+  for (const ul_sps_reservation_t& r : ul_sps_reservations) {
+    tti_alloc.release_ul_prbs(r.alloc);
+  }
+  ul_sps_reservations.clear();
+}
+
 alloc_result sf_sched::alloc_phich(sched_ue* user)
 {
   using phich_t = sched_interface::ul_sched_phich_t;
@@ -704,26 +826,53 @@ void sf_sched::set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t&
     sched_interface::dl_sched_data_t* data = &dl_result->data.back();
 
     // Assign NCCE/L
-    data->dci.location = dci_result[data_alloc.dci_idx]->dci_pos;
+    if (data_alloc.needs_pdcch()) {
+      data->dci.location = dci_result[data_alloc.dci_idx]->dci_pos;
+    }
 
     // Generate DCI Format1/2/2A
     auto ue_it = ue_list.find(data_alloc.rnti);
     if (ue_it == ue_list.end()) {
       continue;
     }
-    sched_ue*           user        = ue_it->second.get();
+    sched_ue* user = ue_it->second.get();
+
+    if (data_alloc.type == dl_alloc_t::SPS_RELEASE) {
+      user->generate_dl_sps_release_dci(data, cc_cfg->enb_cc_idx);
+      logger.info("SCHED: DL SPS release rnti=0x%x, cc=%d, dci=(%d, %d), tti_tx_dl=%d",
+                  user->get_rnti(),
+                  cc_cfg->enb_cc_idx,
+                  data->dci.location.L,
+                  data->dci.location.ncce,
+                  get_tti_tx_dl().to_uint());
+      continue;
+    }
+
     uint32_t            data_before = user->get_pending_dl_bytes(cc_cfg->enb_cc_idx);
     const dl_harq_proc& dl_harq     = user->get_dl_harq(data_alloc.pid, cc_cfg->enb_cc_idx);
-    bool                is_newtx    = dl_harq.is_empty();
-
-    int tbs = user->generate_dl_dci_format(
-        data_alloc.pid, data, get_tti_tx_dl(), cc_cfg->enb_cc_idx, tti_alloc.get_cfi(), data_alloc.user_mask);
+    bool                is_newtx    = dl_harq.is_empty() or data_alloc.type != dl_alloc_t::DATA;
+    const char*         tx_label    = data_alloc.type == dl_alloc_t::SPS_ACTIVATION ? "SPS activation"
+                                      : data_alloc.type == dl_alloc_t::SPS_OCCASION ? "SPS tx"
+                                      : is_newtx                                    ? "tx"
+                                                                                    : "retx";
+
+    int tbs = 0;
+    if (data_alloc.type == dl_alloc_t::DATA) {
+      tbs = user->generate_dl_dci_format(
+          data_alloc.pid, data, get_tti_tx_dl(), cc_cfg->enb_cc_idx, tti_alloc.get_cfi(), data_alloc.user_mask);
+    } else {
+      tbs = user->generate_dl_sps_dci(data_alloc.pid,
+                                      data,
+                                      get_tti_tx_dl(),
+                                      cc_cfg->enb_cc_idx,
+                                      data_alloc.type == dl_alloc_t::SPS_ACTIVATION);
+    }
 
     if (tbs <= 0) {
       fmt::memory_buffer str_buffer;
       fmt::format_to(str_buffer,
                      "SCHED: DL {} failed rnti=0x{:x}, pid={}, mask={:x}, tbs={}, buffer={}",
-                     is_newtx ? "tx" : "retx",
+                     tx_label,
                      user->get_rnti(),
                      data_alloc.pid,
                      data_alloc.user_mask,
@@ -738,7 +887,7 @@ void sf_sched::set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t&
     fmt::format_to(str_buffer,
                    "SCHED: DL {} rnti=0x{:x}, cc={}, pid={}, mask=0x{:x}, dci=({}, {}), n_rtx={}, cfi={}, "
                    "tbs={}, buffer={}/{}, tti_tx_dl={}",
-                   is_newtx ? "tx" : "retx",
+                   tx_label,
                    user->get_rnti(),
                    cc_cfg->enb_cc_idx,
                    data_alloc.pid,
@@ -865,14 +1014,20 @@ void sf_sched::set_ul_sched_result(const sf_cch_allocator::alloc_result_t& dci_r
     ul_result->pusch.emplace_back();
     sched_interface::ul_sched_data_t& pusch = ul_result->pusch.back();
     uint32_t total_data_before              = user->get_pending_ul_data_total(get_tti_tx_ul(), cc_cfg->enb_cc_idx);
-    int      tbs                            = user->generate_format0(&pusch,
-                                                                     get_tti_tx_ul(),
-                                                                     cc_cfg->enb_cc_idx,
-                                                                     ul_alloc.alloc,
-                                                                     ul_alloc.needs_pdcch(),
-                                                                     cce_range,
-                                                                     ul_alloc.msg3_mcs,
-                                                                     uci_type);
+    int      tbs                            = 0;
+    if (ul_alloc.sps == ul_alloc_t::NO_SPS) {
+      tbs = user->generate_format0(&pusch,
+                                   get_tti_tx_ul(),
+                                   cc_cfg->enb_cc_idx,
+                                   ul_alloc.alloc,
+                                   ul_alloc.needs_pdcch(),
+                                   cce_range,
+                                   ul_alloc.msg3_mcs,
+                                   uci_type);
+    } else {
+      tbs = user->generate_ul_sps_format0(
+          &pusch, get_tti_tx_ul(), cc_cfg->enb_cc_idx, ul_alloc.sps == ul_alloc_t::SPS_ACTIVATION, cce_range);
+    }
 
     ul_harq_proc* h                 = user->get_ul_harq(get_tti_tx_ul(), cc_cfg->enb_cc_idx);
     uint32_t      new_pending_bytes = user->get_pending_ul_new_data(get_tti_tx_ul(), cc_cfg->enb_cc_idx);
@@ -901,7 +1056,7 @@ void sf_sched::set_ul_sched_result(const sf_cch_allocator::alloc_result_t& dci_r
       fmt::format_to(str_buffer,
                      "SCHED: {} {} rnti=0x{:x}, cc={}, pid={}, dci=({},{}), prb={}, n_rtx={}, cfi={}, tbs={}, bsr={} "
                      "({}-{}), tti_tx_ul={}",
-                     ul_alloc.is_msg3 ? "Msg3" : "UL",
+                     ul_alloc.is_msg3 ? "Msg3" : (ul_alloc.sps != ul_alloc_t::NO_SPS ? "UL SPS" : "UL"),
                      ul_alloc.is_retx() ? "retx" : "tx",
                      user->get_rnti(),
                      cc_cfg->enb_cc_idx,
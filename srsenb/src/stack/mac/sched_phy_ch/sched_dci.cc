@@ -347,6 +347,79 @@ void generate_pdcch_order_dci(sched_interface::dl_sched_po_t& pdcch_order,
   get_mac_logger().debug("PDCCH order: rnti=0x%x", pdcch_order.dci.rnti);
 }
 
+bool generate_dl_sps_activation_dci(srsran_dci_dl_t&           dci,
+                                    uint16_t                   crnti,
+                                    prb_interval               prb_range,
+                                    uint32_t                   mcs,
+                                    const sched_cell_params_t& cell_params)
+{
+  // The MSB of the MCS is used to validate the activation
+  if (mcs > MAX_SPS_MCS) {
+    return false;
+  }
+
+  dci                  = {};
+  dci.format           = SRSRAN_DCI_FORMAT1A;
+  dci.rnti             = crnti;
+  dci.alloc_type       = SRSRAN_RA_ALLOC_TYPE2;
+  dci.type2_alloc.mode = srsran_ra_type2_t::SRSRAN_RA_TYPE2_LOC;
+  dci.type2_alloc.riv  = srsran_ra_type2_to_riv(prb_range.length(), prb_range.start(), cell_params.nof_prb());
+  dci.pid              = 0; // HARQ process number "000"
+  dci.tb[0].mcs_idx    = mcs;
+  dci.tb[0].rv         = 0; // Redundancy version "00"
+  dci.tb[0].ndi        = false;
+  dci.tb[0].cw_idx     = 0;
+  dci.tpc_pucch        = 0; // Selects the first n1PUCCH-AN-Persistent
+  SRSRAN_DCI_TB_DISABLE(dci.tb[1]);
+
+  return true;
+}
+
+void generate_dl_sps_release_dci(srsran_dci_dl_t& dci, uint16_t crnti, const sched_cell_params_t& cell_params)
+{
+  uint32_t nof_prb = cell_params.nof_prb();
+  uint32_t riv_len = (uint32_t)ceilf(log2f(nof_prb * (nof_prb + 1) / 2.0F));
+
+  dci                  = {};
+  dci.format           = SRSRAN_DCI_FORMAT1A;
+  dci.rnti             = crnti;
+  dci.alloc_type       = SRSRAN_RA_ALLOC_TYPE2;
+  dci.type2_alloc.mode = srsran_ra_type2_t::SRSRAN_RA_TYPE2_LOC;
+  dci.type2_alloc.riv  = (1U << riv_len) - 1U; // Resource block assignment set to all "1"s
+  dci.pid              = 0;                    // HARQ process number "000"
+  dci.tb[0].mcs_idx    = 31;                   // MCS set to "11111"
+  dci.tb[0].rv         = 0;                    // Redundancy version "00"
+  dci.tb[0].ndi        = false;
+  dci.tb[0].cw_idx     = 0;
+  SRSRAN_DCI_TB_DISABLE(dci.tb[1]);
+}
+
+bool generate_ul_sps_activation_dci(srsran_dci_ul_t&           dci,
+                                    uint16_t                   crnti,
+                                    prb_interval               prb_range,
+                                    uint32_t                   mcs,
+                                    const sched_cell_params_t& cell_params)
+{
+  // The MSB of the MCS and RV field is used to validate the activation
+  if (mcs > MAX_SPS_MCS) {
+    return false;
+  }
+
+  dci                 = {};
+  dci.format          = SRSRAN_DCI_FORMAT0;
+  dci.rnti            = crnti;
+  dci.freq_hop_fl     = srsran_dci_ul_t::SRSRAN_RA_PUSCH_HOP_DISABLED;
+  dci.type2_alloc.riv = srsran_ra_type2_to_riv(prb_range.length(), prb_range.start(), cell_params.nof_prb());
+  dci.tb.mcs_idx      = mcs;
+  dci.tb.rv           = 0;
+  dci.tb.ndi          = false;
+  dci.tpc_pusch       = 0; // TPC command for scheduled PUSCH "00"
+  dci.n_dmrs          = 0; // Cyclic shift DM RS "000"
+  dci.cqi_request     = false;
+
+  return true;
+}
+
 void log_broadcast_allocation(const sched_interface::dl_sched_bc_t& bc,
                               rbg_interval                          rbg_range,
                               const sched_cell_params_t&            cell_params)
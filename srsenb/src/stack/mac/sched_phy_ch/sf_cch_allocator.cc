@@ -76,6 +76,7 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
 {
   temp_dci_dfs.clear();
   uint32_t start_cfix = current_cfix;
+  nof_dfs_steps       = 0;
 
   alloc_record record;
   record.user       = user;
@@ -116,6 +117,7 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
     if (temp_dci_dfs.empty()) {
       temp_dci_dfs = last_dci_dfs;
     }
+    backjump_dfs(record);
   } while (get_next_dfs());
 
   // Revert steps to initial state, before dci record allocation was attempted
@@ -127,6 +129,10 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
 bool sf_cch_allocator::get_next_dfs()
 {
   do {
+    if (nof_dfs_steps >= MAX_DFS_STEPS) {
+      // Search budget exhausted
+      return false;
+    }
     uint32_t start_child_idx = 0;
     if (last_dci_dfs.empty()) {
       // If we reach root, increase CFI
@@ -149,8 +155,35 @@ bool sf_cch_allocator::get_next_dfs()
   return true;
 }
 
+/// The new DCI failed with the current DCI positions. Only the allocations that overlap one of its CCE candidates, or
+/// that take a PUCCH resource it may need, can free space for it. The allocations after the deepest of them are
+/// thus removed without trying their alternative positions.
+void sf_cch_allocator::backjump_dfs(const alloc_record& record)
+{
+  const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
+  if (dci_locs == nullptr) {
+    return;
+  }
+  pdcch_mask_t cand_mask(nof_cces());
+  for (uint32_t ncce : (*dci_locs)[record.aggr_idx]) {
+    cand_mask.fill(ncce, std::min(ncce + (1U << record.aggr_idx), nof_cces()));
+  }
+  bool needs_pucch = record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci and
+                     not cc_cfg->sched_cfg->pucch_mux_enabled;
+
+  while (not last_dci_dfs.empty()) {
+    const tree_node& node = last_dci_dfs.back();
+    if ((node.current_mask & cand_mask).any() or (needs_pucch and node.pucch_n_prb >= 0)) {
+      return;
+    }
+    last_dci_dfs.pop_back();
+  }
+}
+
 bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
 {
+  nof_dfs_steps++;
+
   // Get DCI Location Table
   const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
   if (dci_locs == nullptr or (*dci_locs)[record.aggr_idx].empty()) {
@@ -203,14 +236,13 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
       }
     }
 
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
+    if (node.total_mask.any(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx))) {
       // there is a PDCCH collision. Try another CCE position
       continue;
     }
 
     // Allocation successful
+    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
     node.total_mask |= node.current_mask;
     if (node.pucch_n_prb >= 0) {
       node.total_pucch_mask.set(node.pucch_n_prb);
@@ -0,0 +1,717 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/sched_recorder.h"
+#include <cstring>
+#include <type_traits>
+
+namespace srsenb {
+
+namespace {
+
+const uint32_t sched_record_magic   = 0x43455253; // "SREC"
+const uint32_t sched_record_version = 2;
+
+/// Size of the record header, made of the call type and the payload length
+const size_t sched_record_header_len = sizeof(uint16_t) + sizeof(uint32_t);
+
+enum sched_record_type : uint16_t {
+  record_cell_cfg = 1,
+  record_reset,
+  record_ue_cfg,
+  record_ue_rem,
+  record_phy_config_enabled,
+  record_bearer_ue_cfg,
+  record_bearer_ue_rem,
+  record_dl_rlc_buffer_state,
+  record_dl_mac_buffer_state,
+  record_dl_ack_info,
+  record_dl_rach_info,
+  record_dl_ri_info,
+  record_dl_pmi_info,
+  record_dl_cqi_info,
+  record_dl_sb_cqi_info,
+  record_ul_crc_info,
+  record_ul_sr_info,
+  record_ul_bsr,
+  record_ul_phr,
+  record_ul_snr_info,
+  record_ul_sdu_info,
+  record_ul_buffer_add,
+  record_set_pdcch_order,
+  record_set_dl_tti_mask,
+  record_dl_sched,
+  record_ul_sched
+};
+
+/// Applies f to the fields of a cell configuration, in their order in the recording
+template <typename F, typename Cfg>
+void visit_cell_cfg(F& f, Cfg& c)
+{
+  f(c.cell);
+  f(c.tdd_config);
+  f(c.sibs);
+  f(c.si_window_ms);
+  f(c.target_pucch_ul_sinr);
+  f(c.pusch_hopping_cfg);
+  f(c.target_pusch_ul_sinr);
+  f(c.min_phr_thres);
+  f(c.enable_phr_handling);
+  f(c.enable_64qam);
+  f(c.prach_config);
+  f(c.prach_nof_preambles);
+  f(c.prach_freq_offset);
+  f(c.prach_rar_window);
+  f(c.prach_contention_resolution_timer);
+  f(c.maxharq_msg3tx);
+  f(c.n1pucch_an);
+  f(c.delta_pucch_shift);
+  f(c.nrb_pucch);
+  f(c.nrb_cqi);
+  f(c.ncs_an);
+  f(c.srs_subframe_config);
+  f(c.srs_subframe_offset);
+  f(c.srs_bw_config);
+  f(c.scell_list);
+}
+
+/// Applies f to the fields of a UE configuration, in their order in the recording
+template <typename F, typename Cfg>
+void visit_ue_cfg(F& f, Cfg& c)
+{
+  f(c.maxharq_tx);
+  f(c.continuous_pusch);
+  f(c.uci_offset);
+  f(c.pucch_cfg);
+  f(c.ue_bearers);
+  f(c.supported_cc_list);
+  f(c.dl_ant_info);
+  f(c.use_tbs_index_alt);
+  f(c.measgap_period);
+  f(c.measgap_offset);
+  f(c.support_ul64qam);
+  f(c.sps_cfg);
+}
+
+/// Appends the raw image of trivially copyable values, and vectors and configurations made of them, to a buffer
+struct record_packer {
+  std::vector<uint8_t>& buffer;
+
+  template <typename T>
+  void operator()(const T& v)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Recorded values must be trivially copyable");
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&v);
+    buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+  }
+  template <typename T>
+  void operator()(const std::vector<T>& v)
+  {
+    (*this)((uint32_t)v.size());
+    for (const T& e : v) {
+      (*this)(e);
+    }
+  }
+  void operator()(const sched_interface::cell_cfg_t& c) { visit_cell_cfg(*this, c); }
+  void operator()(const sched_interface::ue_cfg_t& c) { visit_ue_cfg(*this, c); }
+};
+
+/// Reads back the values written by record_packer, ok is cleared if the payload is too short
+struct record_unpacker {
+  const uint8_t* ptr;
+  const uint8_t* end;
+  bool           ok = true;
+
+  template <typename T>
+  void operator()(T& v)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Recorded values must be trivially copyable");
+    if (not ok or (size_t)(end - ptr) < sizeof(T)) {
+      ok = false;
+      return;
+    }
+    memcpy(&v, ptr, sizeof(T));
+    ptr += sizeof(T);
+  }
+  template <typename T>
+  void operator()(std::vector<T>& v)
+  {
+    uint32_t n = 0;
+    (*this)(n);
+    if (not ok or n > (size_t)(end - ptr)) {
+      ok = false;
+      return;
+    }
+    v.resize(n);
+    for (T& e : v) {
+      (*this)(e);
+    }
+  }
+  void operator()(sched_interface::cell_cfg_t& c) { visit_cell_cfg(*this, c); }
+  void operator()(sched_interface::ue_cfg_t& c) { visit_ue_cfg(*this, c); }
+
+  /// Reads all the arguments of a call, true if they matched the payload exactly
+  template <typename... Args>
+  bool read(Args&... args)
+  {
+    int expand[] = {0, ((*this)(args), 0)...};
+    (void)expand;
+    return ok and ptr == end;
+  }
+};
+
+void digest_add(uint64_t& digest, uint64_t value)
+{
+  // FNV-1a
+  digest = (digest ^ value) * 0x100000001b3ULL;
+}
+
+} // namespace
+
+sched_recorder::sched_recorder(sched& sched_) : sched_h(sched_), logger(srslog::fetch_basic_logger("MAC")) {}
+
+sched_recorder::~sched_recorder()
+{
+  close();
+}
+
+bool sched_recorder::open(const std::string& filename)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (f != nullptr) {
+    fclose(f);
+  }
+
+  f = fopen(filename.c_str(), "wb");
+  if (f == nullptr) {
+    logger.error("Failed to open scheduler recording file %s", filename.c_str());
+    return false;
+  }
+
+  const uint32_t header[] = {sched_record_magic, sched_record_version};
+  if (fwrite(header, sizeof(header), 1, f) != 1) {
+    logger.error("Failed to write scheduler recording file %s", filename.c_str());
+    fclose(f);
+    f = nullptr;
+    return false;
+  }
+
+  logger.info("Recording scheduler inputs to %s", filename.c_str());
+  return true;
+}
+
+void sched_recorder::close()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (f != nullptr) {
+    fclose(f);
+    f = nullptr;
+  }
+}
+
+template <typename... Args>
+void sched_recorder::write(uint16_t type, const Args&... args)
+{
+  if (f == nullptr) {
+    return;
+  }
+
+  buffer.clear();
+  record_packer packer{buffer};
+  packer(type);
+  packer(uint32_t(0));
+  int expand[] = {0, (packer(args), 0)...};
+  (void)expand;
+
+  uint32_t len = buffer.size() - sched_record_header_len;
+  memcpy(&buffer[sizeof(uint16_t)], &len, sizeof(len));
+
+  if (fwrite(buffer.data(), buffer.size(), 1, f) != 1) {
+    logger.error("Failed to write scheduler recording, stopping the recording");
+    fclose(f);
+    f = nullptr;
+  }
+}
+
+int sched_recorder::cell_cfg(const std::vector<cell_cfg_t>& cell_cfg)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_cell_cfg, cell_cfg);
+  return sched_h.cell_cfg(cell_cfg);
+}
+
+int sched_recorder::reset()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_reset);
+  return sched_h.reset();
+}
+
+int sched_recorder::ue_cfg(uint16_t rnti, const ue_cfg_t& cfg)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_ue_cfg, rnti, cfg);
+  return sched_h.ue_cfg(rnti, cfg);
+}
+
+int sched_recorder::ue_rem(uint16_t rnti)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_ue_rem, rnti);
+  return sched_h.ue_rem(rnti);
+}
+
+void sched_recorder::phy_config_enabled(uint16_t rnti, bool enabled)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_phy_config_enabled, rnti, enabled);
+  sched_h.phy_config_enabled(rnti, enabled);
+}
+
+int sched_recorder::bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, const mac_lc_ch_cfg_t& cfg)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_bearer_ue_cfg, rnti, lc_id, cfg);
+  return sched_h.bearer_ue_cfg(rnti, lc_id, cfg);
+}
+
+int sched_recorder::bearer_ue_rem(uint16_t rnti, uint32_t lc_id)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_bearer_ue_rem, rnti, lc_id);
+  return sched_h.bearer_ue_rem(rnti, lc_id);
+}
+
+int sched_recorder::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_dl_rlc_buffer_state, rnti, lc_id, tx_queue, prio_tx_queue);
+  return sched_h.dl_rlc_buffer_state(rnti, lc_id, tx_queue, prio_tx_queue);
+}
+
+int sched_recorder::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_dl_mac_buffer_state, rnti, ce_code, nof_cmds);
+  return sched_h.dl_mac_buffer_state(rnti, ce_code, nof_cmds);
+}
+
+int sched_recorder::dl_ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_dl_ack_info, tti, rnti, enb_cc_idx, tb_idx, ack);
+  return sched_h.dl_ack_info(tti, rnti, enb_cc_idx, tb_idx, ack);
+}
+
+int sched_recorder::dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_dl_rach_info, enb_cc_idx, rar_info);
+  return sched_h.dl_rach_info(enb_cc_idx, rar_info);
+}
+
+int sched_recorder::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_dl_ri_info, tti, rnti, enb_cc_idx, ri_value);
+  return sched_h.dl_ri_info(tti, rnti, enb_cc_idx, ri_value);
+}
+
+int sched_recorder::dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_dl_pmi_info, tti, rnti, enb_cc_idx, pmi_value);
+  return sched_h.dl_pmi_info(tti, rnti, enb_cc_idx, pmi_value);
+}
+
+int sched_recorder::dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_dl_cqi_info, tti, rnti, enb_cc_idx, cqi_value);
+  return sched_h.dl_cqi_info(tti, rnti, enb_cc_idx, cqi_value);
+}
+
+int sched_recorder::dl_sb_cqi_info(uint32_t tti,
+                                   uint16_t rnti,
+                                   uint32_t enb_cc_idx,
+                                   uint32_t sb_idx,
+                                   uint32_t cqi_value)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_dl_sb_cqi_info, tti, rnti, enb_cc_idx, sb_idx, cqi_value);
+  return sched_h.dl_sb_cqi_info(tti, rnti, enb_cc_idx, sb_idx, cqi_value);
+}
+
+int sched_recorder::ul_crc_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, bool crc)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_ul_crc_info, tti, rnti, enb_cc_idx, crc);
+  return sched_h.ul_crc_info(tti, rnti, enb_cc_idx, crc);
+}
+
+int sched_recorder::ul_sr_info(uint32_t tti, uint16_t rnti)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_ul_sr_info, tti, rnti);
+  return sched_h.ul_sr_info(tti, rnti);
+}
+
+int sched_recorder::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_ul_bsr, rnti, lcg_id, bsr);
+  return sched_h.ul_bsr(rnti, lcg_id, bsr);
+}
+
+int sched_recorder::ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_ul_phr, rnti, phr, ul_nof_prb);
+  return sched_h.ul_phr(rnti, phr, ul_nof_prb);
+}
+
+int sched_recorder::ul_snr_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_ul_snr_info, tti, rnti, enb_cc_idx, snr, ul_ch_code);
+  return sched_h.ul_snr_info(tti, rnti, enb_cc_idx, snr, ul_ch_code);
+}
+
+int sched_recorder::ul_sdu_info(uint16_t rnti, uint32_t lcid, uint32_t nof_bytes)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_ul_sdu_info, rnti, lcid, nof_bytes);
+  return sched_h.ul_sdu_info(rnti, lcid, nof_bytes);
+}
+
+int sched_recorder::dl_sched(uint32_t tti, uint32_t enb_cc_idx, dl_sched_res_t& sched_result)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_dl_sched, tti, enb_cc_idx);
+  return sched_h.dl_sched(tti, enb_cc_idx, sched_result);
+}
+
+int sched_recorder::ul_sched(uint32_t tti, uint32_t enb_cc_idx, ul_sched_res_t& sched_result)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_ul_sched, tti, enb_cc_idx);
+  return sched_h.ul_sched(tti, enb_cc_idx, sched_result);
+}
+
+int sched_recorder::set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_info)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_set_pdcch_order, enb_cc_idx, pdcch_order_info);
+  return sched_h.set_pdcch_order(enb_cc_idx, pdcch_order_info);
+}
+
+void sched_recorder::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_set_dl_tti_mask, std::vector<uint8_t>(tti_mask, tti_mask + nof_sfs));
+  sched_h.set_dl_tti_mask(tti_mask, nof_sfs);
+}
+
+int sched_recorder::ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  write(record_ul_buffer_add, rnti, lcid, bytes);
+  return sched_h.ul_buffer_add(rnti, lcid, bytes);
+}
+
+/// Replays one record, false if its payload does not match its type
+static bool replay_record(uint16_t type, record_unpacker& u, sched& sched_, sched_replay_stats_t& stats)
+{
+  uint16_t rnti       = 0;
+  uint32_t tti        = 0;
+  uint32_t enb_cc_idx = 0;
+  uint32_t v1 = 0, v2 = 0;
+  bool     flag = false;
+
+  switch (type) {
+    case record_cell_cfg: {
+      std::vector<sched_interface::cell_cfg_t> cell_cfg;
+      if (not u.read(cell_cfg)) {
+        return false;
+      }
+      sched_.cell_cfg(cell_cfg);
+    } break;
+    case record_reset:
+      if (not u.read()) {
+        return false;
+      }
+      sched_.reset();
+      break;
+    case record_ue_cfg: {
+      sched_interface::ue_cfg_t cfg;
+      if (not u.read(rnti, cfg)) {
+        return false;
+      }
+      sched_.ue_cfg(rnti, cfg);
+    } break;
+    case record_ue_rem:
+      if (not u.read(rnti)) {
+        return false;
+      }
+      sched_.ue_rem(rnti);
+      break;
+    case record_phy_config_enabled:
+      if (not u.read(rnti, flag)) {
+        return false;
+      }
+      sched_.phy_config_enabled(rnti, flag);
+      break;
+    case record_bearer_ue_cfg: {
+      mac_lc_ch_cfg_t cfg;
+      if (not u.read(rnti, v1, cfg)) {
+        return false;
+      }
+      sched_.bearer_ue_cfg(rnti, v1, cfg);
+    } break;
+    case record_bearer_ue_rem:
+      if (not u.read(rnti, v1)) {
+        return false;
+      }
+      sched_.bearer_ue_rem(rnti, v1);
+      break;
+    case record_dl_rlc_buffer_state: {
+      uint32_t lc_id = 0;
+      if (not u.read(rnti, lc_id, v1, v2)) {
+        return false;
+      }
+      sched_.dl_rlc_buffer_state(rnti, lc_id, v1, v2);
+    } break;
+    case record_dl_mac_buffer_state:
+      if (not u.read(rnti, v1, v2)) {
+        return false;
+      }
+      sched_.dl_mac_buffer_state(rnti, v1, v2);
+      break;
+    case record_dl_ack_info:
+      if (not u.read(tti, rnti, enb_cc_idx, v1, flag)) {
+        return false;
+      }
+      sched_.dl_ack_info(tti, rnti, enb_cc_idx, v1, flag);
+      break;
+    case record_dl_rach_info: {
+      sched_interface::dl_sched_rar_info_t rar_info;
+      if (not u.read(enb_cc_idx, rar_info)) {
+        return false;
+      }
+      sched_.dl_rach_info(enb_cc_idx, rar_info);
+    } break;
+    case record_dl_ri_info:
+      if (not u.read(tti, rnti, enb_cc_idx, v1)) {
+        return false;
+      }
+      sched_.dl_ri_info(tti, rnti, enb_cc_idx, v1);
+      break;
+    case record_dl_pmi_info:
+      if (not u.read(tti, rnti, enb_cc_idx, v1)) {
+        return false;
+      }
+      sched_.dl_pmi_info(tti, rnti, enb_cc_idx, v1);
+      break;
+    case record_dl_cqi_info:
+      if (not u.read(tti, rnti, enb_cc_idx, v1)) {
+        return false;
+      }
+      sched_.dl_cqi_info(tti, rnti, enb_cc_idx, v1);
+      break;
+    case record_dl_sb_cqi_info:
+      if (not u.read(tti, rnti, enb_cc_idx, v1, v2)) {
+        return false;
+      }
+      sched_.dl_sb_cqi_info(tti, rnti, enb_cc_idx, v1, v2);
+      break;
+    case record_ul_crc_info:
+      if (not u.read(tti, rnti, enb_cc_idx, flag)) {
+        return false;
+      }
+      sched_.ul_crc_info(tti, rnti, enb_cc_idx, flag);
+      break;
+    case record_ul_sr_info:
+      if (not u.read(tti, rnti)) {
+        return false;
+      }
+      sched_.ul_sr_info(tti, rnti);
+      break;
+    case record_ul_bsr:
+      if (not u.read(rnti, v1, v2)) {
+        return false;
+      }
+      sched_.ul_bsr(rnti, v1, v2);
+      break;
+    case record_ul_phr: {
+      int phr = 0;
+      if (not u.read(rnti, phr, v1)) {
+        return false;
+      }
+      sched_.ul_phr(rnti, phr, v1);
+    } break;
+    case record_ul_snr_info: {
+      float snr = 0;
+      if (not u.read(tti, rnti, enb_cc_idx, snr, v1)) {
+        return false;
+      }
+      sched_.ul_snr_info(tti, rnti, enb_cc_idx, snr, v1);
+    } break;
+    case record_ul_sdu_info:
+      if (not u.read(rnti, v1, v2)) {
+        return false;
+      }
+      sched_.ul_sdu_info(rnti, v1, v2);
+      break;
+    case record_ul_buffer_add:
+      if (not u.read(rnti, v1, v2)) {
+        return false;
+      }
+      sched_.ul_buffer_add(rnti, v1, v2);
+      break;
+    case record_set_pdcch_order: {
+      sched_interface::dl_sched_po_info_t po_info;
+      if (not u.read(enb_cc_idx, po_info)) {
+        return false;
+      }
+      sched_.set_pdcch_order(enb_cc_idx, po_info);
+    } break;
+    case record_set_dl_tti_mask: {
+      std::vector<uint8_t> tti_mask;
+      if (not u.read(tti_mask)) {
+        return false;
+      }
+      sched_.set_dl_tti_mask(tti_mask.data(), tti_mask.size());
+    } break;
+    case record_dl_sched: {
+      if (not u.read(tti, enb_cc_idx)) {
+        return false;
+      }
+      sched_interface::dl_sched_res_t res;
+      auto                            t0 = std::chrono::steady_clock::now();
+      sched_.dl_sched(tti, enb_cc_idx, res);
+      stats.sched_time += std::chrono::steady_clock::now() - t0;
+      stats.nof_dl_sched++;
+      sched_result_digest(stats.dl_digest, res);
+    } break;
+    case record_ul_sched: {
+      if (not u.read(tti, enb_cc_idx)) {
+        return false;
+      }
+      sched_interface::ul_sched_res_t res;
+      auto                            t0 = std::chrono::steady_clock::now();
+      sched_.ul_sched(tti, enb_cc_idx, res);
+      stats.sched_time += std::chrono::steady_clock::now() - t0;
+      stats.nof_ul_sched++;
+      sched_result_digest(stats.ul_digest, res);
+    } break;
+    default:
+      return false;
+  }
+
+  return true;
+}
+
+void sched_result_digest(uint64_t& digest, const sched_interface::dl_sched_res_t& res)
+{
+  digest_add(digest, res.cfi);
+  for (const sched_interface::dl_sched_data_t& data : res.data) {
+    digest_add(digest, data.dci.rnti);
+    digest_add(digest, data.dci.location.ncce | (data.dci.location.L << 16u));
+    digest_add(digest, data.dci.alloc_type == SRSRAN_RA_ALLOC_TYPE0 ? data.dci.type0_alloc.rbg_bitmask
+                                                                     : data.dci.type2_alloc.riv);
+    digest_add(digest, data.dci.tb[0].mcs_idx | (data.dci.tb[1].mcs_idx << 8u));
+    digest_add(digest, data.tbs[0] | ((uint64_t)data.tbs[1] << 32u));
+  }
+  for (const sched_interface::dl_sched_rar_t& rar : res.rar) {
+    digest_add(digest, rar.tbs | ((uint64_t)rar.msg3_grant.size() << 32u));
+  }
+  for (const sched_interface::dl_sched_bc_t& bc : res.bc) {
+    digest_add(digest, bc.index | ((uint64_t)bc.tbs << 32u));
+  }
+  for (const sched_interface::dl_sched_po_t& po : res.po) {
+    digest_add(digest, po.crnti);
+  }
+}
+
+void sched_result_digest(uint64_t& digest, const sched_interface::ul_sched_res_t& res)
+{
+  for (const sched_interface::ul_sched_data_t& pusch : res.pusch) {
+    digest_add(digest, pusch.dci.rnti | (pusch.needs_pdcch << 16u));
+    digest_add(digest, pusch.dci.type2_alloc.riv | ((uint64_t)pusch.dci.tb.mcs_idx << 32u));
+    digest_add(digest, pusch.tbs);
+  }
+  for (const sched_interface::ul_sched_phich_t& phich : res.phich) {
+    digest_add(digest, phich.rnti | (phich.phich << 16u));
+  }
+}
+
+int sched_replay(const std::string& filename, sched& sched_, sched_replay_stats_t& stats)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("MAC");
+
+  stats           = {};
+  stats.dl_digest = sched_digest_init;
+  stats.ul_digest = sched_digest_init;
+
+  FILE* f = fopen(filename.c_str(), "rb");
+  if (f == nullptr) {
+    logger.error("Failed to open scheduler recording file %s", filename.c_str());
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t header[2] = {};
+  if (fread(header, sizeof(header), 1, f) != 1 or header[0] != sched_record_magic or
+      header[1] != sched_record_version) {
+    logger.error("%s is not a scheduler recording of version %d", filename.c_str(), sched_record_version);
+    fclose(f);
+    return SRSRAN_ERROR;
+  }
+
+  int                  ret = SRSRAN_SUCCESS;
+  std::vector<uint8_t> payload;
+  uint8_t              record_header[sched_record_header_len];
+  while (fread(record_header, sizeof(record_header), 1, f) == 1) {
+    uint16_t type = 0;
+    uint32_t len  = 0;
+    memcpy(&type, record_header, sizeof(type));
+    memcpy(&len, record_header + sizeof(type), sizeof(len));
+
+    payload.resize(len);
+    if (len > 0 and fread(payload.data(), len, 1, f) != 1) {
+      logger.error("Scheduler recording %s is truncated", filename.c_str());
+      ret = SRSRAN_ERROR;
+      break;
+    }
+
+    record_unpacker u{payload.data(), payload.data() + len};
+    if (not replay_record(type, u, sched_, stats)) {
+      logger.error("Invalid record of type %d in scheduler recording %s", type, filename.c_str());
+      ret = SRSRAN_ERROR;
+      break;
+    }
+    stats.nof_calls++;
+  }
+
+  fclose(f);
+  return ret;
+}
+
+} // namespace srsenb
@@ -26,6 +26,7 @@
 #include "srsenb/hdr/stack/mac/sched_ue.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/srslog/bundled/fmt/ranges.h"
+#include <algorithm>
 
 namespace srsenb {
 
@@ -42,7 +43,7 @@ namespace srsenb {
  *******************************************************/
 
 sched_ue::sched_ue(uint16_t rnti_, const std::vector<sched_cell_params_t>& cell_list_params_, const ue_cfg_t& cfg_) :
-  logger(srslog::fetch_basic_logger("MAC")), rnti(rnti_), lch_handler(rnti_)
+  logger(srslog::fetch_basic_logger("MAC")), rnti(rnti_), lch_handler(rnti_), sps(rnti_)
 {
   cells.reserve(cell_list_params_.size());
   for (auto& c : cell_list_params_) {
@@ -67,6 +68,8 @@ void sched_ue::set_cfg(const ue_cfg_t& cfg_)
     main_cc_params = cells[primary_cc_idx].cell_cfg;
     cell           = main_cc_params->cfg.cell;
     max_msg3retx   = main_cc_params->cfg.maxharq_msg3tx;
+    ul_presched.set_cfg(main_cc_params->sched_cfg->ul_presched_max_bytes,
+                        main_cc_params->sched_cfg->ul_presched_max_misses);
   }
 
   // update configuration
@@ -93,6 +96,12 @@ void sched_ue::set_cfg(const ue_cfg_t& cfg_)
     logger.info("SCHED: Enqueueing SCell Activation CMD for rnti=0x%x", rnti);
   }
 
+  // update SPS. The DL SPS HARQs of the PCell are not used for dynamic newtxs
+  sps.set_cfg(cfg.supported_cc_list.size() == 1 ? cfg.sps_cfg : sched_interface::sps_cfg_t{});
+  for (auto& c : cells) {
+    c.harq_ent.reserve_dl_harqs((c.is_pcell() and sps.dl_configured()) ? sps.get_cfg().dl_nof_harq : 0);
+  }
+
   check_ue_cfg_correctness(cfg);
 }
 
@@ -101,6 +110,7 @@ void sched_ue::new_subframe(tti_point tti_rx, uint32_t enb_cc_idx)
   if (current_tti != tti_rx) {
     current_tti = tti_rx;
     lch_handler.new_tti();
+    ul_presched.new_slot();
     for (auto& cc : cells) {
       cc.new_tti(tti_rx);
     }
@@ -140,6 +150,14 @@ void sched_ue::ul_buffer_add(uint8_t lcid, uint32_t bytes)
   lch_handler.ul_buffer_add(lcid, bytes);
 }
 
+void sched_ue::ul_sdu_info(uint32_t lcid, uint32_t nof_bytes)
+{
+  // Only the DRBs carry the periodic traffic that is worth pre-scheduling
+  if (srsran::is_lte_drb(lcid)) {
+    ul_presched.ul_data_rx(nof_bytes);
+  }
+}
+
 void sched_ue::ul_phr(int phr, uint32_t grant_nof_prb)
 {
   cells[cfg.supported_cc_list[0].enb_cc_idx].tpc_fsm.set_phr(phr, grant_nof_prb);
@@ -259,6 +277,33 @@ bool sched_ue::phich_enabled(tti_point tti_rx, uint32_t enb_cc_idx) const
   return true;
 }
 
+bool sched_ue::is_idle() const
+{
+  if (sr or lch_handler.has_pending_dl_txs() or lch_handler.get_bsr() > 0 or ul_presched.is_armed() or
+      sps.is_active()) {
+    return false;
+  }
+  for (const sched_ue_cell& cc : cells) {
+    if (not cc.configured()) {
+      continue;
+    }
+    if (cc.cc_state() == cc_st::activating or cc.cc_state() == cc_st::deactivating) {
+      return false;
+    }
+    for (const dl_harq_proc& h : cc.harq_ent.dl_harq_procs()) {
+      if (not h.is_empty()) {
+        return false;
+      }
+    }
+    for (const ul_harq_proc& h : cc.harq_ent.ul_harq_procs()) {
+      if (not h.is_empty()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 int sched_ue::set_ack_info(tti_point tti_rx, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
   return cells[enb_cc_idx].set_ack_info(tti_rx, tb_idx, ack);
@@ -365,6 +410,7 @@ int sched_ue::generate_dl_dci_format(uint32_t                          pid,
 {
   srsran_dci_format_t dci_format = get_dci_format();
   int                 tbs_bytes  = 0;
+  bool                is_newtx   = get_dl_harq(pid, enb_cc_idx).is_empty();
 
   // Set common DCI fields
   srsran_dci_dl_t* dci = &data->dci;
@@ -395,9 +441,75 @@ int sched_ue::generate_dl_dci_format(uint32_t                          pid,
     dci->tpc_pucch = cells[enb_cc_idx].tpc_fsm.encode_pucch_tpc();
   }
 
+  // The retxs of the DL SPS HARQs are scheduled with the SPS C-RNTI and NDI=1 (TS 36.321 Section 5.3.1)
+  if (tbs_bytes > 0 and is_newtx) {
+    sps.set_dl_sps_harq(enb_cc_idx, pid, false);
+  } else if (tbs_bytes > 0 and sps.is_dl_sps_harq(enb_cc_idx, pid)) {
+    data->sps_crnti = sps.get_harq_sps_crnti();
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; ++tb) {
+      dci->tb[tb].ndi = true;
+    }
+  }
+
   return tbs_bytes;
 }
 
+int sched_ue::generate_dl_sps_dci(uint32_t                          pid,
+                                  sched_interface::dl_sched_data_t* data,
+                                  tti_point                         tti_tx_dl,
+                                  uint32_t                          enb_cc_idx,
+                                  bool                              is_activation)
+{
+  sched_ue_cell&   cc   = cells[enb_cc_idx];
+  dl_harq_proc*    h    = &cc.harq_ent.dl_harq_procs()[pid];
+  const tbs_info&  tb   = sps.get_dl_tb();
+  const rbgmask_t& mask = sps.get_dl_mask();
+
+  srsran_dci_location_t dci_pos = data->dci.location;
+  prb_interval          prbs    = prb_interval::rbgs_to_prbs(rbg_interval::find_first_interval(mask), cell.nof_prb);
+  if (not generate_dl_sps_activation_dci(data->dci, rnti, prbs, tb.mcs, *cc.cell_cfg)) {
+    return 0;
+  }
+  data->dci.location  = dci_pos;
+  data->dci.pid       = pid;
+  data->dci.ue_cc_idx = cc.get_ue_cc_idx();
+  data->sps_crnti     = sps.get_cfg().sps_crnti;
+  data->no_pdcch      = not is_activation;
+  data->n1_pucch_an   = sps.get_cfg().n1_pucch_an;
+
+  // Allocate MAC PDU
+  int rem_tbs = tb.tbs_bytes;
+  rem_tbs -= allocate_mac_ces(data, lch_handler, rem_tbs);
+  rem_tbs -= allocate_mac_sdus(data, lch_handler, rem_tbs, 0);
+  if (rem_tbs == tb.tbs_bytes) {
+    return 0;
+  }
+
+  if (not h->is_empty(0)) {
+    // The UE flushes the HARQ of an occasion, whatever the state of the previous transmission (TS 36.321 5.3.2.1)
+    logger.info("SCHED: DL SPS occasion of rnti=0x%x overrides pending retx of pid=%d", rnti, pid);
+    h->reset(0);
+  }
+  h->new_tx(mask, 0, tti_tx_dl, tb.mcs, tb.tbs_bytes, dci_pos.ncce, get_ue_cfg().maxharq_tx);
+  sps.set_dl_sps_harq(enb_cc_idx, pid, true);
+
+  data->tbs[0] = (uint32_t)tb.tbs_bytes;
+  data->tbs[1] = 0;
+  return tb.tbs_bytes;
+}
+
+void sched_ue::generate_dl_sps_release_dci(sched_interface::dl_sched_data_t* data, uint32_t enb_cc_idx)
+{
+  srsran_dci_location_t dci_pos = data->dci.location;
+  srsenb::generate_dl_sps_release_dci(data->dci, rnti, *cells[enb_cc_idx].cell_cfg);
+  data->dci.location  = dci_pos;
+  data->dci.ue_cc_idx = cells[enb_cc_idx].get_ue_cc_idx();
+  data->sps_crnti     = sps.get_cfg().sps_crnti;
+  data->no_pdsch      = true;
+  data->tbs[0]        = 0;
+  data->tbs[1]        = 0;
+}
+
 int sched_ue::generate_format1a(uint32_t                          pid,
                                 sched_interface::dl_sched_data_t* data,
                                 tti_point                         tti_tx_dl,
@@ -647,9 +759,11 @@ int sched_ue::generate_format0(sched_interface::ul_sched_data_t* data,
     // If Msg3 set different nof retx
     uint32_t nof_retx = (data->needs_pdcch) ? get_max_retx() : max_msg3retx;
     h->new_tx(tti_tx_ul, tbinfo.mcs, tbinfo.tbs_bytes, alloc, nof_retx, not data->needs_pdcch);
+    sps.set_ul_sps_harq(enb_cc_idx, h->get_id(), false);
     // Un-trigger the SR if data is allocated
     if (tbinfo.tbs_bytes > 0) {
       unset_sr();
+      ul_presched.ul_newtx_alloc();
     }
   } else {
     // retx
@@ -670,6 +784,12 @@ int sched_ue::generate_format0(sched_interface::ul_sched_data_t* data,
 
     dci->type2_alloc.riv = srsran_ra_type2_to_riv(alloc.length(), alloc.start(), cell.nof_prb);
 
+    // The retxs of the UL SPS HARQs are scheduled with the SPS C-RNTI and NDI=1 (TS 36.321 Section 5.4.1)
+    if (not is_newtx and sps.is_ul_sps_harq(enb_cc_idx, h->get_id())) {
+      data->sps_crnti = sps.get_harq_sps_crnti();
+      dci->tb.ndi     = true;
+    }
+
     // If there are no RE available for ULSCH but there is UCI to transmit, allocate PUSCH becuase
     // resources have been reserved already and in CA it will be used to ACK other carriers
     if (tbinfo.tbs_bytes == 0 && (cqi_request || uci_type != UCI_PUSCH_NONE)) {
@@ -700,6 +820,39 @@ int sched_ue::generate_format0(sched_interface::ul_sched_data_t* data,
   return tbinfo.tbs_bytes;
 }
 
+int sched_ue::generate_ul_sps_format0(sched_interface::ul_sched_data_t* data,
+                                      tti_point                         tti_tx_ul,
+                                      uint32_t                          enb_cc_idx,
+                                      bool                              is_activation,
+                                      srsran_dci_location_t             dci_pos)
+{
+  ul_harq_proc*   h     = get_ul_harq(tti_tx_ul, enb_cc_idx);
+  const tbs_info& tb    = sps.get_ul_tb();
+  prb_interval    alloc = sps.get_ul_alloc();
+
+  // The occasions reuse the DCI of the activation to derive the PUSCH grant
+  if (not generate_ul_sps_activation_dci(data->dci, rnti, alloc, tb.mcs, *cells[enb_cc_idx].cell_cfg)) {
+    return -1;
+  }
+  data->dci.location  = dci_pos;
+  data->dci.ue_cc_idx = cells[enb_cc_idx].get_ue_cc_idx();
+  data->needs_pdcch   = is_activation;
+  data->sps_crnti     = sps.get_cfg().sps_crnti;
+
+  if (not h->is_empty(0)) {
+    // The configured grant is a newtx for the UE, whatever the state of the HARQ (TS 36.321 Section 5.4.2.1)
+    logger.info("SCHED: UL SPS occasion of rnti=0x%x overrides pending retx of pid=%d", rnti, h->get_id());
+    h->reset(0);
+  }
+  h->new_tx(tti_tx_ul, tb.mcs, tb.tbs_bytes, alloc, get_max_retx(), false);
+  sps.set_ul_sps_harq(enb_cc_idx, h->get_id(), true);
+  unset_sr();
+
+  data->tbs           = tb.tbs_bytes;
+  data->current_tx_nb = h->nof_retx(0);
+  return tb.tbs_bytes;
+}
+
 /*******************************************************
  *
  * Functions used by scheduler or scheduler metric objects
@@ -918,6 +1071,11 @@ uint32_t sched_ue::get_pending_ul_data_total(tti_point tti_tx_ul, int this_enb_c
         return 512;
       }
     }
+    // Grant the periodic UL traffic before the UE has to send a SR
+    uint32_t presched_bytes = ul_presched.get_presched_bytes();
+    if (presched_bytes > 0 and this_enb_cc_idx == (int)cfg.supported_cc_list[0].enb_cc_idx) {
+      return presched_bytes + sbsr_size;
+    }
     for (uint32_t i = 0; i < cells.size(); ++i) {
       if (cells[i].configured() and needs_cqi(tti_tx_ul.to_uint(), i)) {
         return 128;
@@ -949,6 +1107,17 @@ uint32_t sched_ue::get_pending_ul_new_data(tti_point tti_tx_ul, int this_enb_cc_
   return pending_data;
 }
 
+uint32_t sched_ue::get_pending_dl_sps_bytes() const
+{
+  return lch_handler.get_dl_tx_total_with_overhead(sps.get_cfg().lcid);
+}
+
+uint32_t sched_ue::get_pending_ul_sps_bytes() const
+{
+  uint32_t lcid = sps.get_cfg().lcid;
+  return lcid < cfg.ue_bearers.size() ? lch_handler.get_bsr_with_overhead(cfg.ue_bearers[lcid].group) : 0;
+}
+
 uint32_t sched_ue::get_required_prb_ul(uint32_t enb_cc_idx, uint32_t req_bytes)
 {
   return srsenb::get_required_prb_ul(cells[enb_cc_idx], req_bytes);
@@ -1073,4 +1242,44 @@ int sched_ue::enb_to_ue_cc_idx(uint32_t enb_cc_idx) const
   return enb_cc_idx < cells.size() ? cells[enb_cc_idx].get_ue_cc_idx() : -1;
 }
 
+/*******************************************************
+ *                  Active UE list
+ *******************************************************/
+
+void sched_ue_active_list::add(sched_ue& ue)
+{
+  if (not ue.in_active_list) {
+    ue.in_active_list = true;
+    ues.push_back(&ue);
+  }
+}
+
+void sched_ue_active_list::rem(sched_ue& ue)
+{
+  if (ue.in_active_list) {
+    ue.in_active_list = false;
+    ues.erase(std::find(ues.begin(), ues.end(), &ue));
+  }
+}
+
+void sched_ue_active_list::prune()
+{
+  auto it = std::remove_if(ues.begin(), ues.end(), [](sched_ue* ue) {
+    if (ue->is_idle()) {
+      ue->in_active_list = false;
+      return true;
+    }
+    return false;
+  });
+  ues.erase(it, ues.end());
+}
+
+void sched_ue_active_list::clear()
+{
+  for (sched_ue* ue : ues) {
+    ue->in_active_list = false;
+  }
+  ues.clear();
+}
+
 } // namespace srsenb
@@ -38,20 +38,33 @@ namespace srsenb {
 
 harq_proc::harq_proc() : logger(&srslog::fetch_basic_logger("MAC")) {}
 
-void harq_proc::init(uint32_t id_)
+void harq_proc::init(uint32_t id_, uint32_t* active_mask_)
 {
-  id = id_;
+  id          = id_;
+  active_mask = active_mask_;
+}
+
+void harq_proc::set_active(uint32_t tb_idx, bool value)
+{
+  active[tb_idx] = value;
+  if (active_mask != nullptr) {
+    if (value or not is_empty()) {
+      *active_mask |= (1U << id);
+    } else {
+      *active_mask &= ~(1U << id);
+    }
+  }
 }
 
 void harq_proc::reset(uint32_t tb_idx)
 {
   ack_state[tb_idx] = false;
-  active[tb_idx]    = false;
   n_rtx[tb_idx]     = 0;
   tti               = tti_point{0};
   last_mcs[tb_idx]  = -1;
   last_tbs[tb_idx]  = -1;
   tx_cnt[tb_idx]    = 0;
+  set_active(tb_idx, false);
 }
 
 bool harq_proc::is_empty() const
@@ -88,7 +101,7 @@ int harq_proc::set_ack_common(uint32_t tb_idx, bool ack_)
   ack_state[tb_idx] = ack_;
   logger->debug("ACK=%d received pid=%d, tb_idx=%d, n_rtx=%d, max_retx=%d", ack_, id, tb_idx, n_rtx[tb_idx], max_retx);
   if (ack_) {
-    active[tb_idx] = false;
+    set_active(tb_idx, false);
   }
   return SRSRAN_SUCCESS;
 }
@@ -103,7 +116,7 @@ void harq_proc::new_tx_common(uint32_t tb_idx, tti_point tti_, int mcs, int tbs,
   last_mcs[tb_idx] = mcs;
   last_tbs[tb_idx] = tbs;
 
-  active[tb_idx] = true;
+  set_active(tb_idx, true);
 }
 
 void harq_proc::new_retx_common(uint32_t tb_idx, tti_point tti_, int* mcs, int* tbs)
@@ -121,8 +134,8 @@ void harq_proc::new_retx_common(uint32_t tb_idx, tti_point tti_, int* mcs, int*
 
 void harq_proc::reset_pending_data_common()
 {
-  for (bool& tb : active) {
-    tb = false;
+  for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; ++tb) {
+    set_active(tb, false);
   }
 }
 
@@ -164,7 +177,7 @@ void dl_harq_proc::new_tti(tti_point tti_tx_dl)
                    get_id(),
                    tti.to_uint(),
                    max_retx);
-      active[tb] = false;
+      set_active(tb, false);
     }
   }
 }
@@ -238,7 +251,7 @@ void ul_harq_proc::new_tti()
   if (has_pending_retx() and nof_retx(0) + 1 >= max_nof_retx()) {
     logger->info(
         "SCHED: discarding UL pid=%d, tti=%d, maximum number of retx exceeded (%d)", get_id(), tti.to_uint(), max_retx);
-    active[0] = false;
+    set_active(0, false);
     if (not pending_phich) {
       reset_pending_data();
     }
@@ -341,12 +354,42 @@ uint32_t ul_harq_proc::get_pending_data() const
  *******************/
 
 harq_entity::harq_entity(size_t nof_dl_harqs, size_t nof_ul_harqs) : dl_harqs(nof_dl_harqs), ul_harqs(nof_ul_harqs)
+{
+  srsran_assert(nof_dl_harqs <= 32 and nof_ul_harqs <= 32, "The HARQ bitmaps hold up to 32 HARQs");
+  bind_harqs();
+}
+
+harq_entity::harq_entity(harq_entity&& other) noexcept :
+  last_ttis(other.last_ttis),
+  dl_harqs(std::move(other.dl_harqs)),
+  ul_harqs(std::move(other.ul_harqs)),
+  nof_reserved_dl_harqs(other.nof_reserved_dl_harqs),
+  dl_active_mask(other.dl_active_mask),
+  ul_active_mask(other.ul_active_mask)
+{
+  bind_harqs();
+}
+
+harq_entity& harq_entity::operator=(harq_entity&& other) noexcept
+{
+  last_ttis             = other.last_ttis;
+  dl_harqs              = std::move(other.dl_harqs);
+  ul_harqs              = std::move(other.ul_harqs);
+  nof_reserved_dl_harqs = other.nof_reserved_dl_harqs;
+  dl_active_mask        = other.dl_active_mask;
+  ul_active_mask        = other.ul_active_mask;
+  bind_harqs();
+  return *this;
+}
+
+/// Points the HARQs to the active bitmaps of this entity
+void harq_entity::bind_harqs()
 {
   for (uint32_t i = 0; i < dl_harqs.size(); ++i) {
-    dl_harqs[i].init(i);
+    dl_harqs[i].init(i, &dl_active_mask);
   }
   for (uint32_t i = 0; i < ul_harqs.size(); ++i) {
-    ul_harqs[i].init(i);
+    ul_harqs[i].init(i, &ul_active_mask);
   }
 }
 
@@ -371,20 +414,20 @@ void harq_entity::new_tti(tti_point tti_rx)
 {
   last_ttis[tti_rx.to_uint() % last_ttis.size()] = tti_rx;
   get_ul_harq(to_tx_ul(tti_rx))->new_tti();
-  for (auto& hdl : dl_harqs) {
-    hdl.new_tti(to_tx_dl(tti_rx));
-  }
+  for_each_active_dl_harq([tti_rx](dl_harq_proc& hdl) { hdl.new_tti(to_tx_dl(tti_rx)); });
 }
 
 dl_harq_proc* harq_entity::get_empty_dl_harq(tti_point tti_tx_dl)
 {
   if (not is_async) {
     dl_harq_proc* h = &dl_harqs[tti_tx_dl.to_uint() % nof_dl_harqs()];
-    return h->is_empty() ? h : nullptr;
+    return (h->is_empty() and h->get_id() >= nof_reserved_dl_harqs) ? h : nullptr;
   }
 
-  auto it = std::find_if(dl_harqs.begin(), dl_harqs.end(), [](dl_harq_proc& h) { return h.is_empty(); });
-  return it != dl_harqs.end() ? &(*it) : nullptr;
+  // Lowest HARQ that is neither active nor reserved
+  uint32_t free_mask = ~dl_active_mask & srsran::mask_lsb_zeros<uint32_t>(nof_reserved_dl_harqs) &
+                       srsran::mask_lsb_ones<uint32_t>(dl_harqs.size());
+  return free_mask != 0 ? &dl_harqs[srsran::find_first_lsb_one(free_mask)] : nullptr;
 }
 
 dl_harq_proc* harq_entity::get_pending_dl_harq(tti_point tti_tx_dl)
@@ -398,6 +441,13 @@ dl_harq_proc* harq_entity::get_pending_dl_harq(tti_point tti_tx_dl)
 
 std::tuple<uint32_t, int, int> harq_entity::set_ack_info(tti_point tti_rx, uint32_t tb_idx, bool ack)
 {
+  for (auto& h : dl_harqs) {
+    // Skip the empty HARQs whose last tx was one TTI wrap-around ago
+    if (h.get_tti() + FDD_HARQ_DELAY_DL_MS == tti_rx and not h.is_empty(tb_idx)) {
+      h.set_ack(tb_idx, ack);
+      return std::make_tuple(h.get_id(), h.get_tbs(tb_idx), h.get_mcs(tb_idx));
+    }
+  }
   for (auto& h : dl_harqs) {
     if (h.get_tti() + FDD_HARQ_DELAY_DL_MS == tti_rx) {
       if (h.set_ack(tb_idx, ack) == SRSRAN_SUCCESS) {
@@ -430,12 +480,12 @@ void harq_entity::finish_tti(tti_point tti_rx)
   }
 
   // Reset DL harq which has 0 retxs
-  for (auto& h : dl_harqs) {
-    if (not h.is_empty() and h.max_nof_retx() == 0) {
+  for_each_active_dl_harq([](dl_harq_proc& h) {
+    if (h.max_nof_retx() == 0) {
       // reuse harqs with no retxs
       h.reset_pending_data();
     }
-  }
+  });
 }
 
 /**
@@ -447,7 +497,7 @@ dl_harq_proc* harq_entity::get_oldest_dl_harq(tti_point tti_tx_dl)
 {
   int      oldest_idx = -1;
   uint32_t oldest_tti = 0;
-  for (const dl_harq_proc& h : dl_harqs) {
+  for_each_active_dl_harq([&](const dl_harq_proc& h) {
     tti_point ack_tti_rx = h.get_tti() + FDD_HARQ_DELAY_DL_MS;
     if (h.has_pending_retx(tti_tx_dl) and (last_ttis[ack_tti_rx.to_uint() % last_ttis.size()] == ack_tti_rx)) {
       uint32_t x = tti_tx_dl - h.get_tti();
@@ -456,7 +506,7 @@ dl_harq_proc* harq_entity::get_oldest_dl_harq(tti_point tti_tx_dl)
         oldest_tti = x;
       }
     }
-  }
+  });
   return (oldest_idx >= 0) ? &dl_harqs[oldest_idx] : nullptr;
 }
 
@@ -80,6 +80,7 @@ void lch_ue_manager::new_tti()
       }
     }
   }
+  new_qos_period(tti_duration_ms);
 }
 
 void lch_ue_manager::dl_buffer_state(uint8_t lcid, uint32_t tx_queue, uint32_t prio_tx_queue)
@@ -134,9 +135,20 @@ int lch_ue_manager::get_max_prio_lcid() const
     return prio_lcid;
   }
 
+  // Select GBR lcid below its guaranteed bit rate
+  for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
+    if (get_dl_tx_mbr_limited(lcid) > 0 and has_dl_gbr_deficit(lcid) and channels[lcid].cfg.priority < min_prio_val) {
+      min_prio_val = channels[lcid].cfg.priority;
+      prio_lcid    = lcid;
+    }
+  }
+  if (prio_lcid >= 0) {
+    return prio_lcid;
+  }
+
   // Select lcid with new txs using Bj
   for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
-    if (get_dl_tx(lcid) > 0 and channels[lcid].Bj > 0 and channels[lcid].cfg.priority < min_prio_val) {
+    if (get_dl_tx_mbr_limited(lcid) > 0 and channels[lcid].Bj > 0 and channels[lcid].cfg.priority < min_prio_val) {
       min_prio_val = channels[lcid].cfg.priority;
       prio_lcid    = lcid;
     }
@@ -149,7 +161,7 @@ int lch_ue_manager::get_max_prio_lcid() const
   size_t                              nof_lcids    = 0;
   std::array<uint32_t, MAX_NOF_LCIDS> chosen_lcids = {};
   for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
-    if (get_dl_tx_total(lcid) > 0) {
+    if (get_dl_prio_tx(lcid) + get_dl_tx_mbr_limited(lcid) > 0) {
       if (channels[lcid].cfg.priority < min_prio_val) {
         min_prio_val    = channels[lcid].cfg.priority;
         chosen_lcids[0] = lcid;
@@ -216,12 +228,15 @@ int lch_ue_manager::alloc_tx_bytes(uint8_t lcid, int rem_bytes)
     return 0;
   }
   int rem_bytes_no_header = rem_bytes - rlc_overhead;
-  int alloc               = std::min(rem_bytes_no_header, get_dl_tx(lcid));
+  int alloc               = std::min(rem_bytes_no_header, get_dl_tx_mbr_limited(lcid));
   channels[lcid].buf_tx -= alloc;
   if (alloc > 0 and channels[lcid].cfg.pbr != pbr_infinity) {
     // Update Bj
     channels[lcid].Bj -= alloc;
   }
+  if (alloc > 0) {
+    consume_dl_qos_tokens(lcid, alloc);
+  }
   return alloc + (alloc > 0 ? rlc_overhead : 0);
 }
 
@@ -231,7 +246,7 @@ bool lch_ue_manager::has_pending_dl_txs() const
     return true;
   }
   for (uint32_t lcid = 0; is_lcid_valid(lcid); ++lcid) {
-    if (get_dl_tx_total(lcid) > 0) {
+    if (get_dl_prio_tx(lcid) + get_dl_tx_mbr_limited(lcid) > 0) {
       return true;
     }
   }
@@ -245,7 +260,7 @@ int lch_ue_manager::get_dl_tx_total_with_overhead(uint32_t lcid) const
 
 int lch_ue_manager::get_dl_tx_with_overhead(uint32_t lcid) const
 {
-  return get_dl_mac_sdu_size_with_overhead(lcid, get_dl_tx(lcid));
+  return get_dl_mac_sdu_size_with_overhead(lcid, get_dl_tx_mbr_limited(lcid));
 }
 
 int lch_ue_manager::get_dl_prio_tx_with_overhead(uint32_t lcid) const
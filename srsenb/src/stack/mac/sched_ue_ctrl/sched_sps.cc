@@ -0,0 +1,265 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/sched_ue_ctrl/sched_sps.h"
+#include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsran/common/string_helpers.h"
+
+namespace srsenb {
+
+sps_ue_manager::sps_ue_manager(uint16_t rnti_) : rnti(rnti_), logger(srslog::fetch_basic_logger("MAC")) {}
+
+void sps_ue_manager::set_cfg(const sched_interface::sps_cfg_t& cfg_)
+{
+  sched_interface::sps_cfg_t new_cfg = cfg_;
+  if (new_cfg.sps_crnti == SRSRAN_INVALID_RNTI) {
+    new_cfg.dl_interval = 0;
+    new_cfg.ul_interval = 0;
+  }
+  new_cfg.dl_nof_harq = std::max(1U, std::min(new_cfg.dl_nof_harq, (uint32_t)sched_ue_cell::SCHED_MAX_HARQ_PROC));
+
+  bool changed = new_cfg.sps_crnti != cfg.sps_crnti or new_cfg.dl_interval != cfg.dl_interval or
+                 new_cfg.dl_nof_harq != cfg.dl_nof_harq or new_cfg.ul_interval != cfg.ul_interval or
+                 new_cfg.n1_pucch_an != cfg.n1_pucch_an;
+  cfg = new_cfg;
+  if (changed) {
+    // The RRC reconfiguration releases the SPS grants of the previous configuration
+    reset();
+    if (dl_configured() or ul_configured()) {
+      logger.info("SCHED: rnti=0x%x SPS configured with SPS C-RNTI=0x%x, DL interval=%d, UL interval=%d",
+                  rnti,
+                  cfg.sps_crnti,
+                  cfg.dl_interval,
+                  cfg.ul_interval);
+    }
+  }
+}
+
+void sps_ue_manager::reset()
+{
+  dl_state           = state_t::inactive;
+  dl_empty_occasions = 0;
+  ul_state           = state_t::inactive;
+  ul_empty_occasions = 0;
+}
+
+bool sps_ue_manager::is_dl_occasion(tti_point tti_tx_dl) const
+{
+  return dl_state == state_t::active and (tti_tx_dl - dl_start_tti) % cfg.dl_interval == 0;
+}
+
+uint32_t sps_ue_manager::get_dl_pid(tti_point tti_tx_dl) const
+{
+  // TS 36.321 Section 5.10.1. The SPS intervals divide the 10240 TTI period, so the pids do not jump at the wrap-around
+  return (tti_tx_dl.to_uint() / cfg.dl_interval) % cfg.dl_nof_harq;
+}
+
+void sps_ue_manager::dl_activated(tti_point tti_tx_dl, const rbgmask_t& mask, const tbs_info& tb)
+{
+  dl_state           = state_t::active;
+  dl_start_tti       = tti_tx_dl;
+  dl_mask            = mask;
+  dl_tb              = tb;
+  dl_empty_occasions = 0;
+  if (logger.info.enabled()) {
+    fmt::memory_buffer str_buffer;
+    fmt::format_to(str_buffer,
+                   "SCHED: DL SPS activated rnti=0x{:x}, mask=0x{:x}, mcs={}, tbs={}, tti_tx_dl={}",
+                   rnti,
+                   mask,
+                   tb.mcs,
+                   tb.tbs_bytes,
+                   tti_tx_dl);
+    logger.info("%s", srsran::to_c_str(str_buffer));
+  }
+}
+
+void sps_ue_manager::dl_occasion(bool has_data)
+{
+  dl_empty_occasions = has_data ? 0 : dl_empty_occasions + 1;
+  if (dl_empty_occasions >= cfg.implicit_release_after) {
+    // The UE keeps the assignment until it receives the release DCI
+    dl_state = state_t::releasing;
+  }
+}
+
+void sps_ue_manager::dl_released()
+{
+  dl_state           = state_t::inactive;
+  dl_empty_occasions = 0;
+  logger.info("SCHED: DL SPS released rnti=0x%x", rnti);
+}
+
+void sps_ue_manager::set_harq_cell(uint32_t enb_cc_idx)
+{
+  if (enb_cc_idx != harq_cc_idx) {
+    // The pending retxs of the SPS HARQs of the previous PCell are dropped after a handover
+    dl_sps_harqs.reset();
+    ul_sps_harqs.reset();
+    harq_cc_idx = enb_cc_idx;
+  }
+  harq_sps_crnti = cfg.sps_crnti;
+}
+
+bool sps_ue_manager::is_dl_sps_harq(uint32_t enb_cc_idx, uint32_t pid) const
+{
+  return enb_cc_idx == harq_cc_idx and dl_sps_harqs.test(pid);
+}
+
+void sps_ue_manager::set_dl_sps_harq(uint32_t enb_cc_idx, uint32_t pid, bool is_sps)
+{
+  if (is_sps) {
+    set_harq_cell(enb_cc_idx);
+    dl_sps_harqs.set(pid);
+  } else if (enb_cc_idx == harq_cc_idx) {
+    dl_sps_harqs.reset(pid);
+  }
+}
+
+bool sps_ue_manager::is_ul_occasion(tti_point tti_tx_ul) const
+{
+  return ul_state == state_t::active and (tti_tx_ul - ul_start_tti) % cfg.ul_interval == 0;
+}
+
+void sps_ue_manager::ul_activated(tti_point tti_tx_ul, prb_interval alloc, const tbs_info& tb)
+{
+  ul_state           = state_t::active;
+  ul_start_tti       = tti_tx_ul;
+  ul_alloc           = alloc;
+  ul_tb              = tb;
+  ul_empty_occasions = 0;
+  if (logger.info.enabled()) {
+    fmt::memory_buffer str_buffer;
+    fmt::format_to(str_buffer,
+                   "SCHED: UL SPS activated rnti=0x{:x}, prb={}, mcs={}, tbs={}, tti_tx_ul={}",
+                   rnti,
+                   alloc,
+                   tb.mcs,
+                   tb.tbs_bytes,
+                   tti_tx_ul);
+    logger.info("%s", srsran::to_c_str(str_buffer));
+  }
+}
+
+void sps_ue_manager::ul_occasion(bool has_data)
+{
+  // The UE releases the grant by itself after implicitReleaseAfter MAC PDUs without SDUs (TS 36.321 Section 5.10.2)
+  ul_empty_occasions = has_data ? 0 : ul_empty_occasions + 1;
+  if (ul_empty_occasions >= cfg.implicit_release_after) {
+    ul_state           = state_t::inactive;
+    ul_empty_occasions = 0;
+    logger.info("SCHED: UL SPS implicitly released rnti=0x%x", rnti);
+  }
+}
+
+bool sps_ue_manager::is_ul_sps_harq(uint32_t enb_cc_idx, uint32_t pid) const
+{
+  return enb_cc_idx == harq_cc_idx and ul_sps_harqs.test(pid);
+}
+
+void sps_ue_manager::set_ul_sps_harq(uint32_t enb_cc_idx, uint32_t pid, bool is_sps)
+{
+  if (is_sps) {
+    set_harq_cell(enb_cc_idx);
+    ul_sps_harqs.set(pid);
+  } else if (enb_cc_idx == harq_cc_idx) {
+    ul_sps_harqs.reset(pid);
+  }
+}
+
+bool find_dl_sps_grant(const sched_ue_cell& cell,
+                       tti_point            tti_tx_dl,
+                       const rbgmask_t&     current_mask,
+                       uint32_t             req_bytes,
+                       rbgmask_t&           mask,
+                       tbs_info&            tb)
+{
+  uint32_t max_mcs = std::min(cell.max_mcs_dl, MAX_SPS_MCS);
+  for (uint32_t nof_rbgs = 1; nof_rbgs <= current_mask.size(); ++nof_rbgs) {
+    mask = find_available_rbgmask(nof_rbgs, true, current_mask);
+    if (mask.count() < nof_rbgs) {
+      // No contiguous interval of nof_rbgs free RBGs
+      return false;
+    }
+    uint32_t nof_prb = count_prb_per_tb(mask);
+    if (cell.fixed_mcs_dl >= 0 and cell.dl_cqi().is_cqi_info_received()) {
+      tb.mcs       = std::min((uint32_t)cell.fixed_mcs_dl, max_mcs);
+      tb.tbs_bytes = get_tbs_bytes((uint32_t)tb.mcs, nof_prb, false, false);
+    } else {
+      uint32_t nof_re = cell.cell_cfg->get_dl_lb_nof_re(tti_tx_dl, nof_prb);
+      tb              = compute_min_mcs_and_tbs_from_required_bytes(
+          nof_prb, nof_re, cell.get_dl_cqi(mask), max_mcs, req_bytes, false, false, false);
+    }
+    if (tb.tbs_bytes >= (int)req_bytes) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// The UL SPS grants are placed in the highest free PRBs, away from the Msg3 grants, which start from the lowest PRBs
+static prb_interval find_highest_ul_prbs(uint32_t nof_prb, const prbmask_t& current_mask)
+{
+  for (int start = (int)current_mask.size() - (int)nof_prb; start >= 0; --start) {
+    if (not current_mask.any(start, start + nof_prb)) {
+      return {(uint32_t)start, (uint32_t)start + nof_prb};
+    }
+  }
+  return {};
+}
+
+bool find_ul_sps_grant(const sched_ue_cell& cell,
+                       const prbmask_t&     current_mask,
+                       uint32_t             req_bytes,
+                       prb_interval&        alloc,
+                       tbs_info&            tb)
+{
+  using ul64qam_cap = sched_interface::ue_cfg_t::ul64qam_cap;
+
+  uint32_t max_mcs   = std::min(cell.max_mcs_ul, MAX_SPS_MCS);
+  bool     ulqam64   = cell.get_ue_cfg()->support_ul64qam == ul64qam_cap::enabled;
+  uint32_t max_prbs  = std::min(cell.tpc_fsm.max_ul_prbs(), cell.cell_cfg->nof_prb());
+  uint32_t nof_symb  = 2 * (SRSRAN_CP_NSYMB(cell.cell_cfg->cfg.cell.cp) - 1);
+  uint32_t req_prbs  = std::max(get_required_prb_ul(cell, req_bytes), 1U);
+  int      req_total = static_cast<int>(req_bytes) + 4; // Space for the BSR and the subheaders
+  for (uint32_t nof_prb = req_prbs; nof_prb <= max_prbs; ++nof_prb) {
+    if (not srsran_dft_precoding_valid_prb(nof_prb)) {
+      continue;
+    }
+    alloc = find_highest_ul_prbs(nof_prb, current_mask);
+    if (alloc.length() < nof_prb) {
+      return false;
+    }
+    if (cell.fixed_mcs_ul >= 0) {
+      tb.mcs       = std::min((uint32_t)cell.fixed_mcs_ul, max_mcs);
+      tb.tbs_bytes = get_tbs_bytes((uint32_t)tb.mcs, nof_prb, false, true);
+    } else {
+      tb = compute_min_mcs_and_tbs_from_required_bytes(
+          nof_prb, nof_symb * nof_prb * SRSRAN_NRE, cell.get_ul_cqi(), max_mcs, req_total, true, ulqam64, false);
+    }
+    if (tb.tbs_bytes >= req_total) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace srsenb
@@ -0,0 +1,164 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/schedulers/sched_freq_pf.h"
+#include "srsran/phy/phch/cqi.h"
+#include "srsran/phy/utils/vector.h"
+#include <algorithm>
+
+namespace srsenb {
+
+sched_freq_pf::sched_freq_pf(const sched_cell_params_t&          cell_params_,
+                             const sched_interface::sched_args_t& sched_args,
+                             const sched_ue_active_list&          active_ues_) :
+  sched_time_pf(cell_params_, sched_args, active_ues_)
+{
+  dl_newtx_ues.reserve(SRSENB_MAX_UES);
+  dl_metric.reserve(SRSENB_MAX_UES * MAX_NOF_RBGS);
+  dl_pending_rbgs.reserve(SRSENB_MAX_UES);
+  dl_ue_mask.reserve(SRSENB_MAX_UES);
+}
+
+void sched_freq_pf::sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched)
+{
+  srsran::tti_point tti_rx{tti_sched->get_tti_rx()};
+  if (current_tti_rx != tti_rx) {
+    new_tti(ue_db, tti_sched);
+  }
+
+  // Retransmissions are allocated first, in time-domain PF order, as they keep their number of RBGs
+  dl_newtx_ues.clear();
+  while (not dl_queue.empty()) {
+    ue_ctxt& ue = *dl_queue.top();
+    dl_queue.pop();
+    if (ue.dl_retx_h != nullptr) {
+      alloc_result code = try_dl_retx_alloc(*tti_sched, *ue_db[ue.rnti], *ue.dl_retx_h);
+      if (code == alloc_result::success) {
+        ue.save_dl_alloc(ue.dl_retx_h->get_tbs(0) + ue.dl_retx_h->get_tbs(1), 0.01);
+        continue;
+      }
+      if (code == alloc_result::no_cch_space or ue.dl_newtx_h == nullptr) {
+        ue.save_dl_alloc(0, 0.01);
+        continue;
+      }
+    }
+    dl_newtx_ues.push_back(&ue);
+  }
+  if (dl_newtx_ues.empty()) {
+    return;
+  }
+
+  compute_dl_metrics(ue_db);
+  assign_dl_rbgs(tti_sched->get_dl_mask());
+
+  // Allocate the metric masks in PF priority order. A failed allocation frees its RBGs for the greedy pass
+  for (uint32_t i = 0; i < dl_newtx_ues.size(); ++i) {
+    if (dl_ue_mask[i].none()) {
+      continue;
+    }
+    sched_ue& ue = *ue_db[dl_newtx_ues[i]->rnti];
+    if (tti_sched->alloc_dl_user(&ue, dl_ue_mask[i], dl_newtx_ues[i]->dl_newtx_h->get_id()) != alloc_result::success) {
+      dl_ue_mask[i].reset();
+    }
+  }
+
+  // UEs left without RBGs take the remaining ones greedily
+  for (uint32_t i = 0; i < dl_newtx_ues.size(); ++i) {
+    ue_ctxt&  ue_ctxt = *dl_newtx_ues[i];
+    sched_ue& ue      = *ue_db[ue_ctxt.rnti];
+    if (dl_ue_mask[i].none()) {
+      try_dl_newtx_alloc_greedy(*tti_sched, ue, *ue_ctxt.dl_newtx_h, &dl_ue_mask[i]);
+    }
+    uint32_t nof_rbgs = dl_ue_mask[i].count();
+    ue_ctxt.save_dl_alloc(
+        nof_rbgs > 0 ? ue.get_expected_dl_bitrate(cc_cfg->enb_cc_idx, nof_rbgs) * tti_duration_ms / 8 : 0, 0.01);
+  }
+}
+
+void sched_freq_pf::compute_dl_metrics(sched_ue_list& ue_db)
+{
+  uint32_t nof_rbgs = cc_cfg->nof_rbgs;
+  uint32_t nof_ues  = dl_newtx_ues.size();
+  dl_metric.resize(nof_ues * nof_rbgs);
+  dl_pending_rbgs.assign(nof_ues, 0);
+  dl_ue_mask.assign(nof_ues, rbgmask_t(nof_rbgs));
+
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    sched_ue&      ue      = *ue_db[dl_newtx_ues[i]->rnti];
+    sched_ue_cell* ue_cell = ue.find_ue_carrier(cc_cfg->enb_cc_idx);
+    float*         row     = &dl_metric[i * nof_rbgs];
+    if (ue_cell == nullptr or ue.get_dci_format() == SRSRAN_DCI_FORMAT1A) {
+      // Contiguous allocations are left to the greedy pass
+      srsran_vec_f_zero(row, nof_rbgs);
+      continue;
+    }
+    dl_pending_rbgs[i] = ue.get_required_dl_rbgs(cc_cfg->enb_cc_idx).stop();
+
+    // Spectral efficiency of each subband, weighted by the PF fairness of the UE
+    bool use_tbs_index_alt = ue_cell->get_ue_cfg()->use_tbs_index_alt;
+    for (uint32_t rbg = 0; rbg < nof_rbgs; ++rbg) {
+      int cqi  = ue_cell->dl_cqi().get_rbg_cqi(rbg);
+      row[rbg] = srsran_cqi_to_coderate(std::max(cqi, 0), use_tbs_index_alt);
+    }
+    float R = std::max(dl_newtx_ues[i]->dl_avg_rate(), 1.0f);
+    srsran_vec_sc_prod_fff(row, 1 / pow(R, fairness_coeff), row, nof_rbgs);
+  }
+}
+
+void sched_freq_pf::assign_dl_rbgs(const rbgmask_t& dl_mask)
+{
+  uint32_t nof_rbgs = cc_cfg->nof_rbgs;
+  uint32_t nof_ues  = dl_newtx_ues.size();
+
+  // The RBGs with the highest metrics are assigned first, so that UEs needing few RBGs get their best subbands
+  srsran::bounded_vector<uint32_t, MAX_NOF_RBGS> rbgs;
+  std::array<float, MAX_NOF_RBGS>                best_metric = {};
+  for (uint32_t rbg = 0; rbg < nof_rbgs; ++rbg) {
+    if (dl_mask.test(rbg)) {
+      continue;
+    }
+    rbgs.push_back(rbg);
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      best_metric[rbg] = std::max(best_metric[rbg], dl_metric[i * nof_rbgs + rbg]);
+    }
+  }
+  std::sort(rbgs.begin(), rbgs.end(), [&best_metric](uint32_t a, uint32_t b) {
+    return best_metric[a] > best_metric[b];
+  });
+
+  for (uint32_t rbg : rbgs) {
+    int   best_ue = -1;
+    float best    = 0;
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      float metric = dl_metric[i * nof_rbgs + rbg];
+      if (dl_pending_rbgs[i] > 0 and metric > best) {
+        best_ue = i;
+        best    = metric;
+      }
+    }
+    if (best_ue >= 0) {
+      dl_ue_mask[best_ue].set(rbg);
+      dl_pending_rbgs[best_ue]--;
+    }
+  }
+}
+
+} // namespace srsenb
@@ -26,9 +26,12 @@ namespace srsenb {
 
 using srsran::tti_point;
 
-sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args)
+sched_time_pf::sched_time_pf(const sched_cell_params_t&          cell_params_,
+                             const sched_interface::sched_args_t& sched_args,
+                             const sched_ue_active_list&          active_ues_)
 {
-  cc_cfg = &cell_params_;
+  cc_cfg     = &cell_params_;
+  active_ues = &active_ues_;
   if (not sched_args.sched_policy_args.empty()) {
     fairness_coeff = std::stof(sched_args.sched_policy_args);
   }
@@ -51,21 +54,18 @@ void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
     ul_queue.pop();
   }
   current_tti_rx = tti_point{tti_sched->get_tti_rx()};
-  // remove deleted users from history
-  for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
-    if (not ue_db.contains(it->first)) {
-      it = ue_history_db.erase(it);
-    } else {
-      ++it;
-    }
-  }
-  // add new users to history db, and update priority queues
-  for (auto& u : ue_db) {
-    auto it = ue_history_db.find(u.first);
+  tti_count++;
+  // add new users to history db, and update priority queues. Only the active UEs are candidates, the idle ones
+  // catch up with the TTIs they missed once they become active again
+  for (sched_ue* u : *active_ues) {
+    auto it = ue_history_db.find(u->get_rnti());
     if (it == ue_history_db.end()) {
-      it = ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff}).value();
+      it = ue_history_db.insert(u->get_rnti(), ue_ctxt{u->get_rnti(), fairness_coeff, qos_weight_coeff}).value();
+    } else if (it->second.last_tti_count + 1 < tti_count) {
+      it->second.save_idle_ttis(tti_count - it->second.last_tti_count - 1, 0.01);
     }
-    it->second.new_tti(*cc_cfg, *u.second, tti_sched);
+    it->second.last_tti_count = tti_count;
+    it->second.new_tti(*cc_cfg, *u, tti_sched);
     if (it->second.dl_newtx_h != nullptr or it->second.dl_retx_h != nullptr) {
       dl_queue.push(&it->second);
     }
@@ -75,6 +75,11 @@ void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
   }
 }
 
+void sched_time_pf::rem_user(uint16_t rnti)
+{
+  ue_history_db.erase(rnti);
+}
+
 /*****************************************************************
  *                         Dowlink
  *****************************************************************/
@@ -192,6 +197,7 @@ void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue&
     float r = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
     float R = dl_avg_rate();
     dl_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+    dl_prio *= 1 + qos_weight_coeff * ue.get_dl_qos_urgency();
   }
 
   // Calculate UL priority
@@ -203,6 +209,7 @@ void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue&
     float r = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
     float R = ul_avg_rate();
     ul_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+    ul_prio *= 1 + qos_weight_coeff * ue.get_ul_qos_urgency();
   }
 }
 
@@ -228,6 +235,22 @@ void sched_time_pf::ue_ctxt::save_ul_alloc(uint32_t alloc_bytes, float exp_avg_a
   ul_nof_samples++;
 }
 
+void sched_time_pf::ue_ctxt::save_idle_ttis(uint32_t nof_ttis, float exp_avg_alpha)
+{
+  // The fast start samples are averaged one by one, the exponential average decays in a single step
+  uint32_t dl_ttis = nof_ttis, ul_ttis = nof_ttis;
+  for (; dl_ttis > 0 and dl_nof_samples < 1 / exp_avg_alpha; --dl_ttis) {
+    save_dl_alloc(0, exp_avg_alpha);
+  }
+  dl_avg_rate_ *= pow(1 - exp_avg_alpha, dl_ttis);
+  dl_nof_samples += dl_ttis;
+  for (; ul_ttis > 0 and ul_nof_samples < 1 / exp_avg_alpha; --ul_ttis) {
+    save_ul_alloc(0, exp_avg_alpha);
+  }
+  ul_avg_rate_ *= pow(1 - exp_avg_alpha, ul_ttis);
+  ul_nof_samples += ul_ttis;
+}
+
 bool sched_time_pf::ue_dl_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
                                                    const sched_time_pf::ue_ctxt* rhs) const
 {
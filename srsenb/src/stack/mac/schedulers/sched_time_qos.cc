@@ -0,0 +1,38 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/schedulers/sched_time_qos.h"
+
+namespace srsenb {
+
+sched_time_qos::sched_time_qos(const sched_cell_params_t&          cell_params_,
+                               const sched_interface::sched_args_t& sched_args,
+                               const sched_ue_active_list&          active_ues_) :
+  sched_time_pf(cell_params_, sched_args, active_ues_)
+{
+  qos_weight_coeff = 10;
+  size_t sep       = sched_args.sched_policy_args.find(',');
+  if (sep != std::string::npos) {
+    qos_weight_coeff = std::stof(sched_args.sched_policy_args.substr(sep + 1));
+  }
+}
+
+} // namespace srsenb
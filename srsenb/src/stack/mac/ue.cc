@@ -29,33 +29,107 @@
 #include "srsran/interfaces/enb_phy_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interface_mac.h"
+#include "srsran/phy/fec/turbo/turbodecoder.h"
+#include "srsran/phy/phch/ra.h"
+#include "srsran/phy/utils/vector.h"
 
 namespace srsenb {
 
+softbuffer_cb_pool::cell_slab::cell_slab(size_t rx_node_size, size_t tx_node_size, size_t nof_cb_per_batch) :
+  rx_pool(nof_cb_per_batch, rx_node_size, alignof(void*)), tx_pool(nof_cb_per_batch, tx_node_size, alignof(void*))
+{}
+
+softbuffer_cb_pool::softbuffer_cb_pool(uint32_t nof_cells, uint32_t max_cb_size_, uint32_t nof_cb_per_batch) :
+  max_cb_size(max_cb_size_)
+{
+  for (uint32_t i = 0; i < nof_cells; i++) {
+    cells.emplace_back(new cell_slab(
+        node_size(max_cb_size * sizeof(int16_t)), node_size(max_cb_size * sizeof(uint8_t)), nof_cb_per_batch));
+  }
+}
+
+void* softbuffer_cb_pool::allocate_aligned(cell_slab& slab, srsran::growing_batch_mem_pool& pool)
+{
+  void* node;
+  {
+    std::lock_guard<std::mutex> lock(slab.mutex);
+    node = pool.allocate_node();
+  }
+
+  // Align the code block buffer and keep the node address right before it
+  uintptr_t cb_addr = ((uintptr_t)node + sizeof(void*) + cb_alignment - 1) & ~(uintptr_t)(cb_alignment - 1);
+  void*     cb      = reinterpret_cast<void*>(cb_addr);
+  static_cast<void**>(cb)[-1] = node;
+  return cb;
+}
+
+void softbuffer_cb_pool::deallocate_aligned(cell_slab& slab, srsran::growing_batch_mem_pool& pool, void* cb)
+{
+  void*                       node = static_cast<void**>(cb)[-1];
+  std::lock_guard<std::mutex> lock(slab.mutex);
+  pool.deallocate_node(node);
+}
+
+int16_t* softbuffer_cb_pool::allocate_rx_cb(uint32_t enb_cc_idx)
+{
+  cell_slab& slab = *cells.at(enb_cc_idx);
+  return static_cast<int16_t*>(allocate_aligned(slab, slab.rx_pool));
+}
+
+void softbuffer_cb_pool::deallocate_rx_cb(uint32_t enb_cc_idx, int16_t* cb)
+{
+  cell_slab& slab = *cells.at(enb_cc_idx);
+  deallocate_aligned(slab, slab.rx_pool, cb);
+}
+
+uint8_t* softbuffer_cb_pool::allocate_tx_cb(uint32_t enb_cc_idx)
+{
+  cell_slab& slab = *cells.at(enb_cc_idx);
+  return static_cast<uint8_t*>(allocate_aligned(slab, slab.tx_pool));
+}
+
+void softbuffer_cb_pool::deallocate_tx_cb(uint32_t enb_cc_idx, uint8_t* cb)
+{
+  cell_slab& slab = *cells.at(enb_cc_idx);
+  deallocate_aligned(slab, slab.tx_pool, cb);
+}
+
+/// Number of code blocks of a TB, the same calculation is used to reset the softbuffers
+static uint32_t softbuffer_nof_cb(uint32_t tbs_bits, uint32_t max_cb)
+{
+  return SRSRAN_MIN((tbs_bits + 24) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1, max_cb);
+}
+
 ue_cc_softbuffers::ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_) :
   nof_tx_harq_proc(nof_tx_harq_proc_), nof_rx_harq_proc(nof_rx_harq_proc_)
 {
-  // Create and init Rx buffers
+  int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
+  srsran_assert(ret != SRSRAN_ERROR, "Invalid number of PRB=%d", nof_prb);
+  uint32_t max_cb = (uint32_t)ret / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+
+  // Create and init Rx buffers, the code block buffers are taken from the carrier slab on demand
   softbuffer_rx_list.resize(nof_rx_harq_proc);
   for (srsran_softbuffer_rx_t& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_init(&buffer, nof_prb);
+    srsran_softbuffer_rx_init_lazy(&buffer, max_cb, SOFTBUFFER_SIZE);
   }
 
   // Create and init Tx buffers
   softbuffer_tx_list.resize(nof_tx_harq_proc * SRSRAN_MAX_TB);
   for (auto& buffer : softbuffer_tx_list) {
-    srsran_softbuffer_tx_init(&buffer, nof_prb);
+    srsran_softbuffer_tx_init_lazy(&buffer, max_cb, SOFTBUFFER_SIZE);
   }
 }
 
 ue_cc_softbuffers::~ue_cc_softbuffers()
 {
   for (auto& buffer : softbuffer_rx_list) {
+    set_nof_cb(buffer, 0);
     srsran_softbuffer_rx_free(&buffer);
   }
   softbuffer_rx_list.clear();
 
   for (auto& buffer : softbuffer_tx_list) {
+    set_nof_cb(buffer, 0);
     srsran_softbuffer_tx_free(&buffer);
   }
   softbuffer_tx_list.clear();
@@ -64,13 +138,84 @@ ue_cc_softbuffers::~ue_cc_softbuffers()
 void ue_cc_softbuffers::clear()
 {
   for (auto& buffer : softbuffer_rx_list) {
+    set_nof_cb(buffer, 0);
     srsran_softbuffer_rx_reset(&buffer);
   }
   for (auto& buffer : softbuffer_tx_list) {
+    set_nof_cb(buffer, 0);
     srsran_softbuffer_tx_reset(&buffer);
   }
 }
 
+void ue_cc_softbuffers::set_cb_pool(softbuffer_cb_pool* cb_pool_, uint32_t enb_cc_idx_)
+{
+  // Recycled softbuffers do not hold code block buffers, so they can be moved to another carrier
+  cb_pool    = cb_pool_;
+  enb_cc_idx = enb_cc_idx_;
+}
+
+void ue_cc_softbuffers::set_nof_cb(srsran_softbuffer_tx_t& buffer, uint32_t nof_cb)
+{
+  for (uint32_t i = 0; i < buffer.max_cb; i++) {
+    if (i < nof_cb and buffer.buffer_b[i] == nullptr) {
+      buffer.buffer_b[i] = cb_pool->allocate_tx_cb(enb_cc_idx);
+      srsran_vec_u8_zero(buffer.buffer_b[i], buffer.max_cb_size);
+      buffer.cb_encoded[i] = false;
+    } else if (i >= nof_cb and buffer.buffer_b[i] != nullptr) {
+      cb_pool->deallocate_tx_cb(enb_cc_idx, buffer.buffer_b[i]);
+      buffer.buffer_b[i]   = nullptr;
+      buffer.cb_encoded[i] = false;
+    }
+  }
+}
+
+void ue_cc_softbuffers::set_nof_cb(srsran_softbuffer_rx_t& buffer, uint32_t nof_cb)
+{
+  for (uint32_t i = 0; i < buffer.max_cb; i++) {
+    if (i < nof_cb and buffer.buffer_f[i] == nullptr) {
+      buffer.buffer_f[i] = cb_pool->allocate_rx_cb(enb_cc_idx);
+      srsran_vec_i16_zero(buffer.buffer_f[i], buffer.max_cb_size);
+    } else if (i >= nof_cb and buffer.buffer_f[i] != nullptr) {
+      cb_pool->deallocate_rx_cb(enb_cc_idx, buffer.buffer_f[i]);
+      buffer.buffer_f[i] = nullptr;
+    }
+  }
+}
+
+bool ue_cc_softbuffers::reserve_tx(uint32_t pid, uint32_t tb_idx, uint32_t tbs_bits)
+{
+  if (cb_pool == nullptr) {
+    return false;
+  }
+  srsran_softbuffer_tx_t& buffer = get_tx(pid, tb_idx);
+  set_nof_cb(buffer, softbuffer_nof_cb(tbs_bits, buffer.max_cb));
+  return true;
+}
+
+bool ue_cc_softbuffers::reserve_rx(uint32_t tti, uint32_t tbs_bits)
+{
+  if (cb_pool == nullptr) {
+    return false;
+  }
+  srsran_softbuffer_rx_t& buffer = get_rx(tti);
+  set_nof_cb(buffer, softbuffer_nof_cb(tbs_bits, buffer.max_cb));
+  return true;
+}
+
+void ue_cc_softbuffers::release_tx(uint32_t pid, uint32_t tb_idx)
+{
+  if (cb_pool != nullptr) {
+    set_nof_cb(get_tx(pid, tb_idx), 0);
+  }
+}
+
+void ue_cc_softbuffers::release_rx(uint32_t tti)
+{
+  if (cb_pool != nullptr) {
+    set_nof_cb(get_rx(tti), 0);
+  }
+}
+
 cc_used_buffers_map::cc_used_buffers_map() : logger(&srslog::fetch_basic_logger("MAC")) {}
 
 cc_used_buffers_map::~cc_used_buffers_map()
@@ -166,10 +311,13 @@ cc_buffer_handler::~cc_buffer_handler()
  * @param num_cc Number of carriers to add buffers for (default 1)
  * @return number of carriers
  */
-void cc_buffer_handler::allocate_cc(srsran::unique_pool_ptr<ue_cc_softbuffers> cc_softbuffers_)
+void cc_buffer_handler::allocate_cc(srsran::unique_pool_ptr<ue_cc_softbuffers> cc_softbuffers_,
+                                    softbuffer_cb_pool*                        cb_pool,
+                                    uint32_t                                   enb_cc_idx)
 {
   srsran_assert(empty(), "Cannot allocate softbuffers in CC that is already initialized");
   cc_softbuffers = std::move(cc_softbuffers_);
+  cc_softbuffers->set_cb_pool(cb_pool, enb_cc_idx);
 }
 
 void cc_buffer_handler::deallocate_cc()
@@ -184,6 +332,62 @@ void cc_buffer_handler::reset()
   }
 }
 
+bool cc_buffer_handler::reserve_tx_softbuffer(tti_point tti_tx_dl,
+                                              uint32_t  pid,
+                                              uint32_t  tb_idx,
+                                              uint32_t  tbs_bits,
+                                              bool      ndi)
+{
+  // The NDI toggles on every new transmission of the HARQ process
+  uint32_t& tx_nb = tx_harq_tx_nb.at(pid).at(tb_idx);
+  tx_nb           = (tx_nb == 0 or tx_harq_ndi[pid][tb_idx] != ndi) ? 1 : tx_nb + 1;
+
+  tx_harq_ndi[pid][tb_idx] = ndi;
+  tx_harq_tti[pid]         = tti_tx_dl;
+  return cc_softbuffers->reserve_tx(pid, tb_idx, tbs_bits);
+}
+
+bool cc_buffer_handler::reserve_rx_softbuffer(uint32_t tti, uint32_t tbs_bits, uint32_t current_tx_nb)
+{
+  rx_harq_tx_nb[tti % SRSRAN_FDD_NOF_HARQ] = current_tx_nb;
+  return cc_softbuffers->reserve_rx(tti, tbs_bits);
+}
+
+void cc_buffer_handler::release_tx_softbuffer(tti_point                          tti_rx,
+                                              uint32_t                           tb_idx,
+                                              bool                               ack,
+                                              uint32_t                           max_harq_tx,
+                                              const sched_interface::cell_cfg_t& cell_cfg)
+{
+  // The HARQ feedback received in subframe n is for the PDSCH in the subframes n-k of the cell duplex mode
+  uint32_t nof_k                                     = 1;
+  uint32_t k[SRSRAN_MAX_TDD_DL_ASSOCIATION_SET_SIZE] = {FDD_HARQ_DELAY_DL_MS};
+  if (cell_cfg.cell.frame_type == SRSRAN_TDD) {
+    nof_k = srsran_tdd_dl_association_set(cell_cfg.tdd_config, tti_rx.sf_idx(), k);
+  }
+
+  for (uint32_t pid = 0; pid < SRSRAN_FDD_NOF_HARQ; pid++) {
+    for (uint32_t i = 0; i < nof_k; i++) {
+      if (not tx_harq_tti[pid].is_valid() or tx_harq_tti[pid] + k[i] != tti_rx) {
+        continue;
+      }
+      // Keep the code blocks if the HARQ process can still be retransmitted
+      if (ack or tx_harq_tx_nb[pid][tb_idx] >= max_harq_tx) {
+        cc_softbuffers->release_tx(pid, tb_idx);
+        tx_harq_tx_nb[pid][tb_idx] = 0;
+      }
+    }
+  }
+}
+
+void cc_buffer_handler::release_rx_softbuffer(uint32_t tti, bool crc, uint32_t max_harq_tx)
+{
+  // Keep the soft bits if the HARQ process can still be retransmitted
+  if (crc or rx_harq_tx_nb[tti % SRSRAN_FDD_NOF_HARQ] + 1 >= max_harq_tx) {
+    cc_softbuffers->release_rx(tti);
+  }
+}
+
 ue::ue(uint16_t                                 rnti_,
        uint32_t                                 enb_cc_idx,
        sched_interface*                         sched_,
@@ -192,7 +396,8 @@ ue::ue(uint16_t                                 rnti_,
        phy_interface_stack_lte*                 phy_,
        srslog::basic_logger&                    logger_,
        uint32_t                                 nof_cells_,
-       srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool_) :
+       srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool_,
+       softbuffer_cb_pool*                      cb_pool_) :
   rnti(rnti_),
   sched(sched_),
   rrc(rrc_),
@@ -204,20 +409,18 @@ ue::ue(uint16_t                                 rnti_,
   mac_msg_ul(20, logger_),
   ta_fsm(this),
   softbuffer_pool(softbuffer_pool_),
+  cb_pool(cb_pool_),
   cc_buffers(nof_cells_)
 {
   // Allocate buffer for PCell
-  cc_buffers[enb_cc_idx].allocate_cc(softbuffer_pool->make());
+  cc_buffers[enb_cc_idx].allocate_cc(softbuffer_pool->make(), cb_pool, enb_cc_idx);
 }
 
 ue::~ue() {}
 
 void ue::reset()
 {
-  {
-    std::lock_guard<std::mutex> lock(metrics_mutex);
-    ue_metrics = {};
-  }
+  metrics_acc.snapshot();
   nof_failures = 0;
 
   for (auto& cc : cc_buffers) {
@@ -240,9 +443,10 @@ void ue::ue_cfg(const sched_interface::ue_cfg_t& ue_cfg)
   for (const auto& ue_cc : ue_cfg.supported_cc_list) {
     // Allocate and initialize Rx/Tx softbuffers for new carriers (exclude PCell)
     if (ue_cc.active and cc_buffers[ue_cc.enb_cc_idx].empty()) {
-      cc_buffers[ue_cc.enb_cc_idx].allocate_cc(softbuffer_pool->make());
+      cc_buffers[ue_cc.enb_cc_idx].allocate_cc(softbuffer_pool->make(), cb_pool, ue_cc.enb_cc_idx);
     }
   }
+  max_harq_tx = ue_cfg.maxharq_tx;
 }
 
 srsran_softbuffer_rx_t* ue::get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti)
@@ -265,6 +469,51 @@ srsran_softbuffer_tx_t* ue::get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq
   return &cc_buffers[enb_cc_idx].get_tx_softbuffer(harq_process, tb_idx);
 }
 
+bool ue::reserve_tx_softbuffer(uint32_t enb_cc_idx,
+                               uint32_t tti_tx_dl,
+                               uint32_t harq_process,
+                               uint32_t tb_idx,
+                               uint32_t tbs,
+                               bool     ndi)
+{
+  if ((size_t)enb_cc_idx >= cc_buffers.size() or cc_buffers[enb_cc_idx].empty()) {
+    ERROR("eNB CC Index (%d/%zd) out-of-range", enb_cc_idx, cc_buffers.size());
+    return false;
+  }
+
+  return cc_buffers[enb_cc_idx].reserve_tx_softbuffer(tti_point{tti_tx_dl}, harq_process, tb_idx, tbs * 8, ndi);
+}
+
+bool ue::reserve_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti, uint32_t tbs, uint32_t current_tx_nb)
+{
+  if ((size_t)enb_cc_idx >= cc_buffers.size() or cc_buffers[enb_cc_idx].empty()) {
+    ERROR("eNB CC Index (%d/%zd) out-of-range", enb_cc_idx, cc_buffers.size());
+    return false;
+  }
+
+  return cc_buffers[enb_cc_idx].reserve_rx_softbuffer(tti, tbs * 8, current_tx_nb);
+}
+
+void ue::release_tx_softbuffer(uint32_t                           enb_cc_idx,
+                               uint32_t                           tti_rx,
+                               uint32_t                           tb_idx,
+                               bool                               ack,
+                               const sched_interface::cell_cfg_t& cell_cfg)
+{
+  // On NACK, the soft-buffer is kept for the retransmission, unless the HARQ process reached its maximum number of
+  // transmissions. Otherwise, it is reused on the next new transmission
+  if ((size_t)enb_cc_idx < cc_buffers.size() and not cc_buffers[enb_cc_idx].empty()) {
+    cc_buffers[enb_cc_idx].release_tx_softbuffer(tti_point{tti_rx}, tb_idx, ack, max_harq_tx, cell_cfg);
+  }
+}
+
+void ue::release_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti_rx, bool crc)
+{
+  if ((size_t)enb_cc_idx < cc_buffers.size() and not cc_buffers[enb_cc_idx].empty()) {
+    cc_buffers[enb_cc_idx].release_rx_softbuffer(tti_rx, crc, max_harq_tx);
+  }
+}
+
 uint8_t* ue::request_buffer(uint32_t tti, uint32_t enb_cc_idx, uint32_t len)
 {
   srsran_assert(len > 0, "UE buffers: Requesting buffer for zero bytes");
@@ -303,10 +552,14 @@ uint32_t ue::set_ta(int ta_)
 void ue::process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint32_t grant_nof_prbs)
 {
   // Unpack ULSCH MAC PDU
-  mac_msg_ul.init_rx(pdu->size(), true);
-  mac_msg_ul.parse_packet(pdu->data());
+  if (ul_pdu_parser.parse(pdu->data(), pdu->size()) != SRSRAN_SUCCESS) {
+    logger.warning(pdu->data(), pdu->size(), "Corrupted MAC PDU (pdu_len=%d)", pdu->size());
+  }
 
   if (logger.info.enabled()) {
+    // The sch_pdu parser is only used to print the subheaders
+    mac_msg_ul.init_rx(pdu->size(), true);
+    mac_msg_ul.parse_packet(pdu->data());
     fmt::memory_buffer str_buffer;
     mac_msg_ul.to_string(str_buffer);
     logger.info("0x%x %s", rnti, srsran::to_c_str(str_buffer));
@@ -323,71 +576,69 @@ void ue::process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint3
   uint32_t lcid_most_data = 0;
   int      most_data      = -99;
 
-  while (mac_msg_ul.next()) {
-    assert(mac_msg_ul.get());
-    if (mac_msg_ul.get()->is_sdu()) {
-      /* In some cases, an uplink transmission with only CQI has all zeros and gets routed to RRC
-       * Compute the checksum if lcid=0 and avoid routing in that case
-       */
-      bool route_pdu = true;
-      if (mac_msg_ul.get()->get_sdu_lcid() == 0) {
-        uint8_t* x   = mac_msg_ul.get()->get_sdu_ptr();
-        uint32_t sum = 0;
-        for (uint32_t i = 0; i < mac_msg_ul.get()->get_payload_size(); i++) {
-          sum += x[i];
-        }
-        if (sum == 0) {
-          route_pdu = false;
-          logger.debug("Received all zero PDU");
-        }
+  srsran::bounded_vector<rlc_rx_pdu_t, srsran::ul_sch_pdu_parser::MAX_SUBPDUS> rlc_pdus;
+  for (const srsran::ul_sch_subpdu_t& sdu : ul_pdu_parser.sdus()) {
+    uint8_t* sdu_ptr = pdu->data() + sdu.offset;
+
+    /* In some cases, an uplink transmission with only CQI has all zeros and gets routed to RRC
+     * Compute the checksum if lcid=0 and avoid routing in that case
+     */
+    bool route_pdu = true;
+    if (sdu.lcid == 0) {
+      uint32_t sum = 0;
+      for (uint32_t i = 0; i < sdu.nof_bytes; i++) {
+        sum += sdu_ptr[i];
       }
-
-      if (route_pdu) {
-        rlc->write_pdu(rnti,
-                       mac_msg_ul.get()->get_sdu_lcid(),
-                       mac_msg_ul.get()->get_sdu_ptr(),
-                       mac_msg_ul.get()->get_payload_size());
+      if (sum == 0) {
+        route_pdu = false;
+        logger.debug("Received all zero PDU");
       }
+    }
 
-      // Indicate scheduler to update BSR counters
-      // sched->ul_recv_len(rnti, mac_msg_ul.get()->get_sdu_lcid(), mac_msg_ul.get()->get_payload_size());
+    if (route_pdu) {
+      rlc_pdus.push_back({sdu.lcid, sdu_ptr, sdu.nof_bytes});
 
-      // Indicate DRB activity in UL to RRC
-      if (mac_msg_ul.get()->get_sdu_lcid() > 2) {
-        rrc->set_activity_user(rnti);
-        logger.debug("UL activity rnti=0x%x, n_bytes=%d", rnti, pdu->size());
-      }
+      // Indicate scheduler the received UL data, to predict the periodic UL traffic
+      sched->ul_sdu_info(rnti, sdu.lcid, sdu.nof_bytes);
+    }
 
-      if ((int)mac_msg_ul.get()->get_payload_size() > most_data) {
-        most_data      = (int)mac_msg_ul.get()->get_payload_size();
-        lcid_most_data = mac_msg_ul.get()->get_sdu_lcid();
-      }
+    // Indicate DRB activity in UL to RRC
+    if (sdu.lcid > 2) {
+      rrc->set_activity_user(rnti);
+      logger.debug("UL activity rnti=0x%x, n_bytes=%d", rnti, pdu->size());
+    }
 
-      // Save contention resolution if lcid == 0
-      if (mac_msg_ul.get()->get_sdu_lcid() == 0 && route_pdu) {
-        int nbytes = srsran::sch_subh::MAC_CE_CONTRES_LEN;
-        if (mac_msg_ul.get()->get_payload_size() >= (uint32_t)nbytes) {
-          uint8_t* ue_cri_ptr = (uint8_t*)&conres_id;
-          uint8_t* pkt_ptr    = mac_msg_ul.get()->get_sdu_ptr(); // Warning here: we want to include the
-          for (int i = 0; i < nbytes; i++) {
-            ue_cri_ptr[nbytes - i - 1] = pkt_ptr[i];
-          }
-        } else {
-          logger.error("Received CCCH UL message of invalid size=%d bytes", mac_msg_ul.get()->get_payload_size());
+    if ((int)sdu.nof_bytes > most_data) {
+      most_data      = (int)sdu.nof_bytes;
+      lcid_most_data = sdu.lcid;
+    }
+
+    // Save contention resolution if lcid == 0
+    if (sdu.lcid == 0 && route_pdu) {
+      int nbytes = srsran::sch_subh::MAC_CE_CONTRES_LEN;
+      if (sdu.nof_bytes >= (uint32_t)nbytes) {
+        uint8_t* ue_cri_ptr = (uint8_t*)&conres_id;
+        for (int i = 0; i < nbytes; i++) {
+          ue_cri_ptr[nbytes - i - 1] = sdu_ptr[i];
         }
+      } else {
+        logger.error("Received CCCH UL message of invalid size=%d bytes", sdu.nof_bytes);
       }
     }
   }
-  mac_msg_ul.reset();
+
+  // Hand all the SDUs to RLC at once
+  if (not rlc_pdus.empty()) {
+    rlc->write_pdus(rnti, rlc_pdus);
+  }
 
   /* Process CE after all SDUs because we need to update BSR after */
-  bool bsr_received = false;
-  while (mac_msg_ul.next()) {
-    assert(mac_msg_ul.get());
-    if (!mac_msg_ul.get()->is_sdu()) {
-      // Process MAC Control Element
-      bsr_received |= process_ce(mac_msg_ul.get(), grant_nof_prbs);
-    }
+  bool             bsr_received = false;
+  srsran::sch_subh ce;
+  for (const srsran::ul_sch_subpdu_t& subpdu : ul_pdu_parser.ces()) {
+    // Process MAC Control Element
+    ce.init_rx_ce(subpdu.lcid, pdu->data() + subpdu.offset, subpdu.nof_bytes);
+    bsr_received |= process_ce(&ce, grant_nof_prbs);
   }
 
   // If BSR is not received means that new data has arrived and there is no space for BSR transmission
@@ -606,86 +857,104 @@ uint8_t* ue::generate_mch_pdu(uint32_t                             harq_pid,
 }
 
 /******* METRICS interface ***************/
+ue::metrics_acc_t& ue::metrics_acc_t::operator+=(const metrics_acc_t& other)
+{
+  nof_tti += other.nof_tti;
+  tx_pkts += other.tx_pkts;
+  tx_errors += other.tx_errors;
+  tx_brate += other.tx_brate;
+  rx_pkts += other.rx_pkts;
+  rx_errors += other.rx_errors;
+  rx_brate += other.rx_brate;
+  phr_sum += other.phr_sum;
+  phr_count += other.phr_count;
+  dl_cqi_sum += other.dl_cqi_sum;
+  dl_cqi_count += other.dl_cqi_count;
+  dl_ri_sum += other.dl_ri_sum;
+  dl_ri_count += other.dl_ri_count;
+  dl_pmi_sum += other.dl_pmi_sum;
+  dl_pmi_count += other.dl_pmi_count;
+  return *this;
+}
+
+// Called from the metrics thread. The scheduler fills the buffer and carrier fields
 void ue::metrics_read(mac_ue_metrics_t* metrics_)
 {
-  uint32_t ul_buffer = sched->get_ul_buffer(rnti);
-  uint32_t dl_buffer = sched->get_dl_buffer(rnti);
-
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.rnti      = rnti;
-  ue_metrics.ul_buffer = ul_buffer;
-  ue_metrics.dl_buffer = dl_buffer;
-
-  // set PCell sector id
-  std::array<int, SRSRAN_MAX_CARRIERS> cc_list = sched->get_enb_ue_cc_map(rnti);
-  auto                                 it      = std::find(cc_list.begin(), cc_list.end(), 0);
-  ue_metrics.cc_idx                            = std::distance(cc_list.begin(), it);
-
-  *metrics_ = ue_metrics;
+  metrics_acc_t acc = metrics_acc.snapshot();
 
-  phr_counter    = 0;
-  dl_cqi_counter = 0;
-  ue_metrics     = {};
+  metrics_->rnti      = rnti;
+  metrics_->nof_tti   = acc.nof_tti;
+  metrics_->tx_pkts   = acc.tx_pkts;
+  metrics_->tx_errors = acc.tx_errors;
+  metrics_->tx_brate  = acc.tx_brate;
+  metrics_->rx_pkts   = acc.rx_pkts;
+  metrics_->rx_errors = acc.rx_errors;
+  metrics_->rx_brate  = acc.rx_brate;
+  metrics_->phr       = acc.phr_count > 0 ? acc.phr_sum / acc.phr_count : 0;
+  metrics_->dl_cqi    = acc.dl_cqi_count > 0 ? acc.dl_cqi_sum / acc.dl_cqi_count : 0;
+  metrics_->dl_ri     = acc.dl_ri_count > 0 ? acc.dl_ri_sum / acc.dl_ri_count : 0;
+  metrics_->dl_pmi    = acc.dl_pmi_count > 0 ? acc.dl_pmi_sum / acc.dl_pmi_count : 0;
 }
 
 void ue::metrics_phr(float phr)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.phr = SRSRAN_VEC_CMA(phr, ue_metrics.phr, phr_counter);
-  phr_counter++;
+  metrics_acc.update([phr](metrics_acc_t& m) {
+    m.phr_sum += phr;
+    m.phr_count++;
+  });
 }
 
 void ue::metrics_dl_ri(uint32_t dl_ri)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  if (ue_metrics.dl_ri == 0.0f) {
-    ue_metrics.dl_ri = (float)dl_ri + 1.0f;
-  } else {
-    ue_metrics.dl_ri = SRSRAN_VEC_EMA((float)dl_ri + 1.0f, ue_metrics.dl_ri, 0.5f);
-  }
-  dl_ri_counter++;
+  metrics_acc.update([dl_ri](metrics_acc_t& m) {
+    m.dl_ri_sum += (float)dl_ri + 1.0f;
+    m.dl_ri_count++;
+  });
 }
 
 void ue::metrics_dl_pmi(uint32_t dl_ri)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.dl_pmi = SRSRAN_VEC_CMA((float)dl_ri, ue_metrics.dl_pmi, dl_pmi_counter);
-  dl_pmi_counter++;
+  metrics_acc.update([dl_ri](metrics_acc_t& m) {
+    m.dl_pmi_sum += (float)dl_ri;
+    m.dl_pmi_count++;
+  });
 }
 
 void ue::metrics_dl_cqi(uint32_t dl_cqi)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.dl_cqi = SRSRAN_VEC_CMA((float)dl_cqi, ue_metrics.dl_cqi, dl_cqi_counter);
-  dl_cqi_counter++;
+  metrics_acc.update([dl_cqi](metrics_acc_t& m) {
+    m.dl_cqi_sum += (float)dl_cqi;
+    m.dl_cqi_count++;
+  });
 }
 
 void ue::metrics_rx(bool crc, uint32_t tbs)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  if (crc) {
-    ue_metrics.rx_brate += tbs * 8;
-  } else {
-    ue_metrics.rx_errors++;
-  }
-  ue_metrics.rx_pkts++;
+  metrics_acc.update([crc, tbs](metrics_acc_t& m) {
+    if (crc) {
+      m.rx_brate += tbs * 8;
+    } else {
+      m.rx_errors++;
+    }
+    m.rx_pkts++;
+  });
 }
 
 void ue::metrics_tx(bool crc, uint32_t tbs)
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  if (crc) {
-    ue_metrics.tx_brate += tbs * 8;
-  } else {
-    ue_metrics.tx_errors++;
-  }
-  ue_metrics.tx_pkts++;
+  metrics_acc.update([crc, tbs](metrics_acc_t& m) {
+    if (crc) {
+      m.tx_brate += tbs * 8;
+    } else {
+      m.tx_errors++;
+    }
+    m.tx_pkts++;
+  });
 }
 
 void ue::metrics_cnt()
 {
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  ue_metrics.nof_tti++;
+  metrics_acc.update([](metrics_acc_t& m) { m.nof_tti++; });
 }
 
 void ue::tic()
@@ -57,6 +57,47 @@ mac_lc_ch_cfg_t get_bearer_default_srb2_config()
   return bearer;
 }
 
+// TS 23.203 Table 6.1.7 - Packet delay budget of the standardized QCIs (msec)
+uint32_t get_qci_delay_budget(uint32_t qci)
+{
+  switch (qci) {
+    case 1:
+    case 5:
+    case 7:
+    case 66:
+    case 67:
+      return 100;
+    case 2:
+      return 150;
+    case 3:
+    case 75:
+    case 79:
+      return 50;
+    case 65:
+      return 75;
+    case 69:
+      return 60;
+    case 70:
+      return 200;
+    case 80:
+    case 82:
+    case 83:
+      return 10;
+    case 84:
+      return 30;
+    case 85:
+      return 5;
+    default:
+      return 300;
+  }
+}
+
+/// S1AP bit rates are in bit/s, the scheduler works in kB/s
+uint32_t bitrate_to_kBps(uint64_t bitrate)
+{
+  return std::min<uint64_t>((bitrate + 7999) / 8000, std::numeric_limits<uint32_t>::max());
+}
+
 void ue_cfg_apply_srb_updates(ue_cfg_t& ue_cfg, const srb_to_add_mod_list_l& srbs);
 
 /**
@@ -79,6 +120,12 @@ void ue_cfg_apply_phy_cfg_ded(ue_cfg_t& ue_cfg, const asn1::rrc::phys_cfg_ded_s&
  */
 void ue_cfg_apply_conn_reconf(ue_cfg_t& ue_cfg, const rrc_conn_recfg_r8_ies_s& conn_recfg, const rrc_cfg_t& rrc_cfg);
 
+/**
+ * Adds to sched_interface::ue_cfg_t the SPS-Config of the RRCReconfiguration. A release in both directions clears the
+ * SPS configuration of the scheduler
+ */
+void ue_cfg_apply_sps_cfg(ue_cfg_t& ue_cfg, const sps_cfg_s& sps_cfg);
+
 void ue_cfg_apply_capabilities(ue_cfg_t& ue_cfg, const rrc_cfg_t& rrc_cfg, const srsran::rrc_ue_capabilities_t& uecaps);
 
 /***************************
@@ -257,9 +304,38 @@ void mac_controller::apply_current_bearers_cfg()
       bcfg.group    = drb.lc_ch_cfg.ul_specific_params.lc_ch_group;
       bcfg.pbr      = drb.lc_ch_cfg.ul_specific_params.prioritised_bit_rate.to_number();
       bcfg.priority = drb.lc_ch_cfg.ul_specific_params.prio;
-      bcfg.bsd      = drb.lc_ch_cfg.ul_specific_params.bucket_size_dur;
+      bcfg.bsd      = drb.lc_ch_cfg.ul_specific_params.bucket_size_dur.to_number();
+    }
+
+    // QoS targets of the E-RAB, enforced by the QoS-aware scheduling policy
+    auto erab_it = drb.eps_bearer_id_present ? bearer_list.get_erabs().find(drb.eps_bearer_id)
+                                             : bearer_list.get_erabs().end();
+    if (erab_it != bearer_list.get_erabs().end()) {
+      const asn1::s1ap::erab_level_qos_params_s& qos = erab_it->second.qos_params;
+      bcfg.delay_budget                              = get_qci_delay_budget(qos.qci);
+      if (qos.gbr_qos_info_present) {
+        bcfg.gbr_dl = bitrate_to_kBps(qos.gbr_qos_info.erab_guaranteed_bitrate_dl);
+        bcfg.gbr_ul = bitrate_to_kBps(qos.gbr_qos_info.erab_guaranteed_bitrate_ul);
+        bcfg.mbr_dl = bitrate_to_kBps(qos.gbr_qos_info.erab_maximum_bitrate_dl);
+      }
     }
   }
+
+  // Bearer whose traffic is served by the SPS grants
+  const bearer_cfg_handler::erab_t* sps_erab = bearer_list.find_sps_erab();
+  if (sps_erab != nullptr and current_sched_ue_cfg.sps_cfg.sps_crnti != SRSRAN_INVALID_RNTI) {
+    current_sched_ue_cfg.sps_cfg.lcid = sps_erab->lcid;
+  }
+}
+
+bool mac_controller::admit_erab(const asn1::s1ap::erab_level_qos_params_s& qos)
+{
+  if (not qos.gbr_qos_info_present) {
+    return true;
+  }
+  return mac->admit_gbr_bearer(rnti,
+                               bitrate_to_kBps(qos.gbr_qos_info.erab_guaranteed_bitrate_dl),
+                               bitrate_to_kBps(qos.gbr_qos_info.erab_guaranteed_bitrate_ul));
 }
 
 void mac_controller::handle_target_enb_ho_cmd(const asn1::rrc::rrc_conn_recfg_r8_ies_s& conn_recfg,
@@ -455,6 +531,11 @@ void ue_cfg_apply_reconf_complete_updates(ue_cfg_t&                      ue_cfg,
     if (conn_recfg.rr_cfg_ded.srb_to_add_mod_list_present) {
       ue_cfg_apply_srb_updates(ue_cfg, conn_recfg.rr_cfg_ded.srb_to_add_mod_list);
     }
+
+    // Apply SPS updates. The UE only uses the SPS-Config once it completes the reconfiguration
+    if (conn_recfg.rr_cfg_ded.sps_cfg_present) {
+      ue_cfg_apply_sps_cfg(ue_cfg, conn_recfg.rr_cfg_ded.sps_cfg);
+    }
   }
 
   // Apply Scell configurations
@@ -497,6 +578,37 @@ void ue_cfg_apply_reconf_complete_updates(ue_cfg_t&                      ue_cfg,
   }
 }
 
+void ue_cfg_apply_sps_cfg(ue_cfg_t& ue_cfg, const sps_cfg_s& sps_cfg)
+{
+  auto& mac_sps = ue_cfg.sps_cfg;
+  if (sps_cfg.semi_persist_sched_c_rnti_present) {
+    mac_sps.sps_crnti = sps_cfg.semi_persist_sched_c_rnti.to_number();
+  }
+  if (sps_cfg.sps_cfg_dl_present) {
+    if (sps_cfg.sps_cfg_dl.type().value == setup_opts::setup) {
+      const auto& dl_setup = sps_cfg.sps_cfg_dl.setup();
+      const auto& n1_list  = dl_setup.n1_pucch_an_persistent_list;
+      mac_sps.dl_interval  = dl_setup.semi_persist_sched_interv_dl.to_number();
+      mac_sps.dl_nof_harq  = dl_setup.nof_conf_sps_processes;
+      mac_sps.n1_pucch_an  = n1_list.size() > 0 ? n1_list[0] : 0;
+    } else {
+      mac_sps.dl_interval = 0;
+    }
+  }
+  if (sps_cfg.sps_cfg_ul_present) {
+    if (sps_cfg.sps_cfg_ul.type().value == setup_opts::setup) {
+      const auto& ul_setup           = sps_cfg.sps_cfg_ul.setup();
+      mac_sps.ul_interval            = ul_setup.semi_persist_sched_interv_ul.to_number();
+      mac_sps.implicit_release_after = ul_setup.implicit_release_after.to_number();
+    } else {
+      mac_sps.ul_interval = 0;
+    }
+  }
+  if (mac_sps.dl_interval == 0 and mac_sps.ul_interval == 0) {
+    mac_sps = {};
+  }
+}
+
 void ue_cfg_apply_meas_cfg(ue_cfg_t& ue_cfg, const meas_cfg_s& meas_cfg, const rrc_cfg_t& rrc_cfg)
 {
   if (meas_cfg.meas_gap_cfg_present) {
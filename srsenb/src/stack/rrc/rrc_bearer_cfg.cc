@@ -421,6 +421,17 @@ void bearer_cfg_handler::rem_gtpu_bearer(uint32_t erab_id)
   gtpu->rem_bearer(rnti, erab_id);
 }
 
+const bearer_cfg_handler::erab_t* bearer_cfg_handler::find_sps_erab() const
+{
+  for (const auto& erab_pair : erabs) {
+    auto qci_it = cfg->qci_cfg.find(erab_pair.second.qos_params.qci);
+    if (qci_it != cfg->qci_cfg.end() and qci_it->second.sps.enabled) {
+      return &erab_pair.second;
+    }
+  }
+  return nullptr;
+}
+
 void bearer_cfg_handler::fill_pending_nas_info(asn1::rrc::rrc_conn_recfg_r8_ies_s* msg)
 {
   // Add space for NAS messages
@@ -161,6 +161,7 @@ ue_cell_ded_list::~ue_cell_ded_list()
   }
   dealloc_sr_resources();
   dealloc_pucch_cs_resources();
+  dealloc_sps_resources();
 }
 
 ue_cell_ded* ue_cell_ded_list::get_enb_cc_idx(uint32_t enb_cc_idx)
@@ -221,6 +222,7 @@ bool ue_cell_ded_list::rem_last_cell()
   if (ue_cc_idx == UE_PCELL_CC_IDX) {
     dealloc_sr_resources();
     dealloc_pucch_cs_resources();
+    dealloc_sps_resources();
   }
   dealloc_cqi_resources(ue_cc_idx);
   cell_list.pop_back();
@@ -593,4 +595,48 @@ bool ue_cell_ded_list::dealloc_pucch_cs_resources()
   return false;
 }
 
+bool ue_cell_ded_list::alloc_sps_resources(uint16_t sps_crnti)
+{
+  ue_cell_ded* cell = get_ue_cc_idx(UE_PCELL_CC_IDX);
+  if (cell == nullptr) {
+    logger.error("The user cell pcell has not been allocated");
+    return false;
+  }
+  if (sps_res_present) {
+    logger.error("The user SPS resources are already allocated");
+    return false;
+  }
+  if (sps_crnti == SRSRAN_INVALID_RNTI) {
+    logger.warning("Could not allocate SPS resources without SPS C-RNTI");
+    return false;
+  }
+
+  // The persistent HARQ-ACK resource of the DL SPS occasions shares the pool of the PUCCH CS resources
+  const sib_type2_s& sib2      = cell->cell_common->sib2;
+  const uint16_t     N_pucch_1 = sib2.rr_cfg_common.pucch_cfg_common.n1_pucch_an;
+  for (uint32_t i = 0; i < cell_res_common::N_PUCCH_MAX_RES; i++) {
+    if (!pucch_res->n_pucch_cs_used[i] && (i <= N_pucch_1 && i != sr_res.sr_N_pucch)) {
+      pucch_res->n_pucch_cs_used[i] = true;
+      sps_res.sps_crnti             = sps_crnti;
+      sps_res.n1_pucch_an           = i;
+      sps_res_present               = true;
+      logger.info("Allocated SPS C-RNTI=0x%x, n1_pucch_an=%d", sps_crnti, i);
+      return true;
+    }
+  }
+  logger.warning("Could not allocate SPS n1_pucch_an");
+  return false;
+}
+
+bool ue_cell_ded_list::dealloc_sps_resources()
+{
+  if (sps_res_present) {
+    pucch_res->n_pucch_cs_used[sps_res.n1_pucch_an] = false;
+    sps_res_present                                 = false;
+    logger.info("Deallocated SPS n1_pucch_an=%d", sps_res.n1_pucch_an);
+    return true;
+  }
+  return false;
+}
+
 } // namespace srsenb
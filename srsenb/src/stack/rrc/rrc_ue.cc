@@ -28,6 +28,7 @@
 #include "srsran/asn1/rrc_utils.h"
 #include "srsran/common/enb_events.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/enb_s1ap_interfaces.h"
@@ -518,8 +519,16 @@ void rrc::ue::send_connection_setup()
   // Configure PHY layer
   apply_setup_phy_config_dedicated(rr_cfg.phys_cfg_ded); // It assumes SCell has not been set before
 
+  // Only the transaction id and PUCCH resources differ between UEs, so they are written in the encoded template
+  if (not parent->conn_setup_tmpl.is_init() and not parent->conn_setup_tmpl.init(dl_ccch_msg)) {
+    parent->logger.info("RRCConnectionSetup cannot be encoded from a template. Packing it for every UE");
+  }
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu != nullptr and not parent->conn_setup_tmpl.pack(dl_ccch_msg, *pdu)) {
+    pdu->clear();
+  }
   std::string octet_str;
-  send_dl_ccch(&dl_ccch_msg, &octet_str);
+  send_dl_ccch(&dl_ccch_msg, &octet_str, std::move(pdu));
 
   // Log event.
   asn1::json_writer json_writer;
@@ -775,8 +784,16 @@ void rrc::ue::send_connection_reest(uint8_t ncc)
   // Configure PHY layer
   apply_setup_phy_config_dedicated(rr_cfg.phys_cfg_ded); // It assumes SCell has not been set before
 
+  // Only the transaction id and PUCCH resources differ between UEs, so they are written in the encoded template
+  if (not parent->conn_setup_tmpl.is_init() and not parent->conn_setup_tmpl.init(dl_ccch_msg)) {
+    parent->logger.info("RRCConnectionSetup cannot be encoded from a template. Packing it for every UE");
+  }
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu != nullptr and not parent->conn_setup_tmpl.pack(dl_ccch_msg, *pdu)) {
+    pdu->clear();
+  }
   std::string octet_str;
-  send_dl_ccch(&dl_ccch_msg, &octet_str);
+  send_dl_ccch(&dl_ccch_msg, &octet_str, std::move(pdu));
 
   apply_rr_cfg_ded_diff(current_ue_cfg.rr_cfg, rr_cfg);
 
@@ -858,6 +875,7 @@ void rrc::ue::send_connection_reconf(srsran::unique_byte_buffer_t pdu,
   parent->logger.debug("RRC state %d", state);
 
   update_scells();
+  update_sps();
 
   /* Create RRCConnectionReconfiguration ASN1 message */
   dl_dcch_msg_s     dl_dcch_msg;
@@ -1233,6 +1251,11 @@ int rrc::ue::setup_erab(uint16_t                                           erab_
     cause.set_radio_network().value = asn1::s1ap::cause_radio_network_opts::multiple_erab_id_instances;
     return SRSRAN_ERROR;
   }
+  if (not mac_ctrl.admit_erab(qos_params)) {
+    cause.set_radio_network().value = asn1::s1ap::cause_radio_network_opts::radio_res_not_available;
+    parent->logger.warning("Not enough radio resources for the GBR E-RAB id=%d of rnti=0x%x", erab_id, rnti);
+    return SRSRAN_ERROR;
+  }
   if (bearer_list.addmod_erab(erab_id, qos_params, addr, gtpu_teid_out, nas_pdu, cause) != SRSRAN_SUCCESS) {
     parent->logger.error("Couldn't add E-RAB id=%d for rnti=0x%x", erab_id, rnti);
     return SRSRAN_ERROR;
@@ -1295,19 +1318,44 @@ void rrc::ue::update_scells()
   parent->logger.info("SCells activated for rnti=0x%x", rnti);
 }
 
+void rrc::ue::update_sps()
+{
+  const bearer_cfg_handler::erab_t* sps_erab = bearer_list.find_sps_erab();
+  if (sps_erab == nullptr) {
+    if (ue_cell_list.dealloc_sps_resources()) {
+      parent->logger.info("SPS released for rnti=0x%x", rnti);
+    }
+    return;
+  }
+  if (ue_cell_list.get_sps_res() != nullptr) {
+    // SPS resources already allocated
+    return;
+  }
+  // The scheduler only supports SPS in the PCell of single carrier UEs
+  if (ue_cell_list.nof_cells() > 1) {
+    parent->logger.info("Skipping SPS configuration of E-RAB id=%d for CA rnti=0x%x", sps_erab->id, rnti);
+    return;
+  }
+  if (ue_cell_list.alloc_sps_resources(parent->mac->reserve_sps_crnti(rnti))) {
+    parent->logger.info("SPS configured for E-RAB id=%d of rnti=0x%x", sps_erab->id, rnti);
+  }
+}
+
 /********************** HELPERS ***************************/
 
-void rrc::ue::send_dl_ccch(dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str)
+void rrc::ue::send_dl_ccch(dl_ccch_msg_s* dl_ccch_msg, std::string* octet_str, srsran::unique_byte_buffer_t encoded_pdu)
 {
   // Allocate a new PDU buffer, pack the message and send to PDCP
-  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  srsran::unique_byte_buffer_t pdu = encoded_pdu != nullptr ? std::move(encoded_pdu) : srsran::make_byte_buffer();
   if (pdu) {
-    asn1::bit_ref bref(pdu->msg, pdu->get_tailroom());
-    if (dl_ccch_msg->pack(bref) != asn1::SRSASN_SUCCESS) {
-      parent->logger.error(pdu->msg, pdu->N_bytes, "Failed to pack DL-CCCH-Msg:");
-      return;
+    if (pdu->N_bytes == 0) {
+      asn1::bit_ref bref(pdu->msg, pdu->get_tailroom());
+      if (dl_ccch_msg->pack(bref) != asn1::SRSASN_SUCCESS) {
+        parent->logger.error(pdu->msg, pdu->N_bytes, "Failed to pack DL-CCCH-Msg:");
+        return;
+      }
+      pdu->N_bytes = (uint32_t)bref.distance_bytes();
     }
-    pdu->N_bytes = (uint32_t)bref.distance_bytes();
 
     // Log Tx message
     parent->log_rrc_message(
@@ -1580,6 +1628,7 @@ void rrc::ue::apply_rlc_rb_updates(const rr_cfg_ded_s& pending_rr_cfg)
         parent->cfg.qci_cfg.at(erab.qos_params.qci).enb_dl_max_retx_thres > 0) {
       rlc_cfg.am.max_retx_thresh = parent->cfg.qci_cfg.at(erab.qos_params.qci).enb_dl_max_retx_thres;
     }
+    rlc_cfg.tx_aqm = parent->cfg.qci_cfg.at(erab.qos_params.qci).enb_dl_aqm;
     parent->rlc->add_bearer(rnti, drb.lc_ch_id, rlc_cfg);
 
     // register EPS bearer over LTE PDCP
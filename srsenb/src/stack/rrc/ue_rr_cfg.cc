@@ -337,6 +337,262 @@ int fill_rr_cfg_ded_setup(asn1::rrc::rr_cfg_ded_s& rr_cfg,
   return fill_phy_cfg_ded_setup(rr_cfg.phys_cfg_ded, enb_cfg, ue_cell_list);
 }
 
+/******************************
+ *  RRCConnectionSetup template
+ *****************************/
+
+namespace {
+
+/// UE-specific field of the RRCConnectionSetup. All of them are constrained integers with lower bound 0
+struct conn_setup_ue_field {
+  uint32_t nof_bits;
+  bool (*is_present)(const dl_ccch_msg_s& msg);
+  uint32_t (*get)(const dl_ccch_msg_s& msg);
+  void (*set)(dl_ccch_msg_s& msg, uint32_t val);
+};
+
+const phys_cfg_ded_s& conn_setup_phy_cfg(const dl_ccch_msg_s& msg)
+{
+  return msg.msg.c1().rrc_conn_setup().crit_exts.c1().rrc_conn_setup_r8().rr_cfg_ded.phys_cfg_ded;
+}
+
+phys_cfg_ded_s& conn_setup_phy_cfg(dl_ccch_msg_s& msg)
+{
+  return msg.msg.c1().rrc_conn_setup().crit_exts.c1().rrc_conn_setup_r8().rr_cfg_ded.phys_cfg_ded;
+}
+
+bool conn_setup_has_sr(const dl_ccch_msg_s& msg)
+{
+  const phys_cfg_ded_s& phy_cfg = conn_setup_phy_cfg(msg);
+  return phy_cfg.sched_request_cfg_present and phy_cfg.sched_request_cfg.type().value == setup_e::setup;
+}
+
+bool conn_setup_has_cqi_periodic(const dl_ccch_msg_s& msg)
+{
+  const phys_cfg_ded_s& phy_cfg = conn_setup_phy_cfg(msg);
+  return phy_cfg.cqi_report_cfg_present and phy_cfg.cqi_report_cfg.cqi_report_periodic_present and
+         phy_cfg.cqi_report_cfg.cqi_report_periodic.type().value == setup_e::setup;
+}
+
+const conn_setup_ue_field conn_setup_ue_fields[] = {
+    // rrc-TransactionIdentifier (0..3)
+    {2,
+     [](const dl_ccch_msg_s&) { return true; },
+     [](const dl_ccch_msg_s& msg) -> uint32_t { return msg.msg.c1().rrc_conn_setup().rrc_transaction_id; },
+     [](dl_ccch_msg_s& msg, uint32_t val) { msg.msg.c1().rrc_conn_setup().rrc_transaction_id = val; }},
+    // sr-PUCCH-ResourceIndex (0..2047)
+    {11,
+     conn_setup_has_sr,
+     [](const dl_ccch_msg_s& msg) -> uint32_t {
+       return conn_setup_phy_cfg(msg).sched_request_cfg.setup().sr_pucch_res_idx;
+     },
+     [](dl_ccch_msg_s& msg, uint32_t val) { conn_setup_phy_cfg(msg).sched_request_cfg.setup().sr_pucch_res_idx = val; }},
+    // sr-ConfigIndex (0..157)
+    {8,
+     conn_setup_has_sr,
+     [](const dl_ccch_msg_s& msg) -> uint32_t { return conn_setup_phy_cfg(msg).sched_request_cfg.setup().sr_cfg_idx; },
+     [](dl_ccch_msg_s& msg, uint32_t val) { conn_setup_phy_cfg(msg).sched_request_cfg.setup().sr_cfg_idx = val; }},
+    // cqi-PUCCH-ResourceIndex (0..1185)
+    {11,
+     conn_setup_has_cqi_periodic,
+     [](const dl_ccch_msg_s& msg) -> uint32_t {
+       return conn_setup_phy_cfg(msg).cqi_report_cfg.cqi_report_periodic.setup().cqi_pucch_res_idx;
+     },
+     [](dl_ccch_msg_s& msg, uint32_t val) {
+       conn_setup_phy_cfg(msg).cqi_report_cfg.cqi_report_periodic.setup().cqi_pucch_res_idx = val;
+     }},
+    // cqi-pmi-ConfigIndex (0..1023)
+    {10,
+     conn_setup_has_cqi_periodic,
+     [](const dl_ccch_msg_s& msg) -> uint32_t {
+       return conn_setup_phy_cfg(msg).cqi_report_cfg.cqi_report_periodic.setup().cqi_pmi_cfg_idx;
+     },
+     [](dl_ccch_msg_s& msg, uint32_t val) {
+       conn_setup_phy_cfg(msg).cqi_report_cfg.cqi_report_periodic.setup().cqi_pmi_cfg_idx = val;
+     }}};
+
+bool pack_dl_ccch(const dl_ccch_msg_s& msg, std::vector<uint8_t>& buf)
+{
+  buf.resize(SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET);
+  asn1::bit_ref bref(buf.data(), buf.size());
+  if (msg.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  buf.resize(bref.distance_bytes());
+  return true;
+}
+
+/// Writes the nof_bits lsbs of val at the bit_offset of buf, keeping the other bits of buf
+void write_bits(uint8_t* buf, uint32_t bit_offset, uint32_t val, uint32_t nof_bits)
+{
+  for (uint32_t i = 0; i < nof_bits; ++i) {
+    uint32_t pos  = bit_offset + i;
+    auto     mask = static_cast<uint8_t>(0x80u >> (pos % 8));
+    if ((val >> (nof_bits - 1 - i)) & 1u) {
+      buf[pos / 8] |= mask;
+    } else {
+      buf[pos / 8] &= ~mask;
+    }
+  }
+}
+
+} // namespace
+
+bool rrc_conn_setup_template::init(const dl_ccch_msg_s& msg)
+{
+  initiated = true;
+  valid     = false;
+  ue_fields.clear();
+  if (not pack_dl_ccch(msg, encoded)) {
+    return false;
+  }
+
+  // Each field is located by setting its msb. All the other bits of the encoding stay the same
+  dl_ccch_msg_s        probe = msg;
+  std::vector<uint8_t> buf0, buf1;
+  for (uint32_t i = 0; i < sizeof(conn_setup_ue_fields) / sizeof(conn_setup_ue_fields[0]); ++i) {
+    const conn_setup_ue_field& field = conn_setup_ue_fields[i];
+    if (not field.is_present(msg)) {
+      continue;
+    }
+    field.set(probe, 0);
+    bool ret = pack_dl_ccch(probe, buf0);
+    field.set(probe, 1u << (field.nof_bits - 1));
+    ret &= pack_dl_ccch(probe, buf1);
+    field.set(probe, field.get(msg));
+    if (not ret or buf0.size() != encoded.size() or buf1.size() != encoded.size()) {
+      return false;
+    }
+    uint32_t nof_diff_bits = 0, bit_offset = 0;
+    for (uint32_t j = 0; j < 8 * buf0.size(); ++j) {
+      if (((buf0[j / 8] ^ buf1[j / 8]) >> (7 - j % 8)) & 1u) {
+        nof_diff_bits++;
+        bit_offset = j;
+      }
+    }
+    if (nof_diff_bits != 1) {
+      return false;
+    }
+    ue_fields.push_back(field_offset{i, bit_offset});
+  }
+
+  // Check that patching the template gives the same encoding as packing a message with other UE values
+  for (const field_offset& f : ue_fields) {
+    const conn_setup_ue_field& field = conn_setup_ue_fields[f.field_idx];
+    field.set(probe, (field.get(msg) + 1) % (1u << (field.nof_bits - 1)));
+  }
+  srsran::byte_buffer_t pdu;
+  valid = pack_dl_ccch(probe, buf0) and patch(probe, pdu) and buf0.size() == pdu.N_bytes and
+          memcmp(buf0.data(), pdu.msg, pdu.N_bytes) == 0;
+  if (not valid) {
+    ue_fields.clear();
+  }
+  return valid;
+}
+
+bool rrc_conn_setup_template::pack(const dl_ccch_msg_s& msg, srsran::byte_buffer_t& pdu) const
+{
+  return valid and patch(msg, pdu);
+}
+
+bool rrc_conn_setup_template::patch(const dl_ccch_msg_s& msg, srsran::byte_buffer_t& pdu) const
+{
+  if (pdu.get_tailroom() < encoded.size()) {
+    return false;
+  }
+  // The UE fields present in msg have to be the ones of the template
+  uint32_t nof_present = 0;
+  for (const conn_setup_ue_field& field : conn_setup_ue_fields) {
+    nof_present += field.is_present(msg) ? 1 : 0;
+  }
+  if (nof_present != ue_fields.size()) {
+    return false;
+  }
+
+  memcpy(pdu.msg, encoded.data(), encoded.size());
+  pdu.N_bytes = encoded.size();
+  for (const field_offset& f : ue_fields) {
+    const conn_setup_ue_field& field = conn_setup_ue_fields[f.field_idx];
+    if (not field.is_present(msg)) {
+      return false;
+    }
+    uint32_t val = field.get(msg);
+    if (val >= (1u << field.nof_bits)) {
+      return false;
+    }
+    write_bits(pdu.msg, f.bit_offset, val, field.nof_bits);
+  }
+  return true;
+}
+
+/// Fills the SPS-Config of the first E-RAB with SPS enabled. Returns false if the UE has no SPS resources
+bool fill_sps_cfg_setup(sps_cfg_s&                sps_cfg,
+                        const rrc_cfg_t&          enb_cfg,
+                        const ue_cell_ded_list&   ue_cell_list,
+                        const bearer_cfg_handler& bearers)
+{
+  const ue_cell_ded_list::sps_res_t* sps_res  = ue_cell_list.get_sps_res();
+  const bearer_cfg_handler::erab_t*  sps_erab = bearers.find_sps_erab();
+  if (sps_res == nullptr or sps_erab == nullptr) {
+    return false;
+  }
+  const rrc_cfg_sps_t& sps_enb_cfg = enb_cfg.qci_cfg.at(sps_erab->qos_params.qci).sps;
+
+  sps_cfg                                   = {};
+  sps_cfg.semi_persist_sched_c_rnti_present = true;
+  sps_cfg.semi_persist_sched_c_rnti.from_number(sps_res->sps_crnti);
+  sps_cfg.sps_cfg_dl_present = true;
+  if (sps_enb_cfg.dl_interval > 0) {
+    auto& dl_setup = sps_cfg.sps_cfg_dl.set_setup();
+    asn1::number_to_enum(dl_setup.semi_persist_sched_interv_dl, sps_enb_cfg.dl_interval);
+    dl_setup.nof_conf_sps_processes = sps_enb_cfg.dl_nof_harq;
+    dl_setup.n1_pucch_an_persistent_list.push_back(sps_res->n1_pucch_an);
+  } else {
+    sps_cfg.sps_cfg_dl.set_release();
+  }
+  sps_cfg.sps_cfg_ul_present = true;
+  if (sps_enb_cfg.ul_interval > 0) {
+    auto& ul_setup = sps_cfg.sps_cfg_ul.set_setup();
+    asn1::number_to_enum(ul_setup.semi_persist_sched_interv_ul, sps_enb_cfg.ul_interval);
+    asn1::number_to_enum(ul_setup.implicit_release_after, sps_enb_cfg.implicit_release_after);
+  } else {
+    sps_cfg.sps_cfg_ul.set_release();
+  }
+  return true;
+}
+
+/// Sets the SPS-Config of the rrcConnectionReconfiguration if it differs from the one of the UE
+void fill_sps_cfg_reconf(asn1::rrc::rr_cfg_ded_s&  rr_cfg,
+                         const rr_cfg_ded_s&       current_rr_cfg,
+                         const rrc_cfg_t&          enb_cfg,
+                         const ue_cell_ded_list&   ue_cell_list,
+                         const bearer_cfg_handler& bearers)
+{
+  const sps_cfg_s& current_sps = current_rr_cfg.sps_cfg;
+  bool             current_setup =
+      current_rr_cfg.sps_cfg_present and
+      ((current_sps.sps_cfg_dl_present and current_sps.sps_cfg_dl.type().value == setup_opts::setup) or
+       (current_sps.sps_cfg_ul_present and current_sps.sps_cfg_ul.type().value == setup_opts::setup));
+
+  if (not fill_sps_cfg_setup(rr_cfg.sps_cfg, enb_cfg, ue_cell_list, bearers)) {
+    if (current_setup) {
+      // Release SPS in both directions
+      rr_cfg.sps_cfg_present            = true;
+      rr_cfg.sps_cfg                    = {};
+      rr_cfg.sps_cfg.sps_cfg_dl_present = true;
+      rr_cfg.sps_cfg.sps_cfg_dl.set_release();
+      rr_cfg.sps_cfg.sps_cfg_ul_present = true;
+      rr_cfg.sps_cfg.sps_cfg_ul.set_release();
+    }
+    return;
+  }
+  rr_cfg.sps_cfg_present = not current_rr_cfg.sps_cfg_present or
+                           current_sps.semi_persist_sched_c_rnti.to_number() !=
+                               rr_cfg.sps_cfg.semi_persist_sched_c_rnti.to_number() or
+                           current_sps.sps_cfg_dl != rr_cfg.sps_cfg.sps_cfg_dl or
+                           current_sps.sps_cfg_ul != rr_cfg.sps_cfg.sps_cfg_ul;
+}
+
 int fill_rr_cfg_ded_reconf(asn1::rrc::rr_cfg_ded_s&             rr_cfg,
                            const rr_cfg_ded_s&                  current_rr_cfg,
                            const rrc_cfg_t&                     enb_cfg,
@@ -357,6 +613,9 @@ int fill_rr_cfg_ded_reconf(asn1::rrc::rr_cfg_ded_s&             rr_cfg,
   rr_cfg.drb_to_add_mod_list_present = rr_cfg.drb_to_add_mod_list.size() > 0;
   rr_cfg.drb_to_release_list_present = rr_cfg.drb_to_release_list.size() > 0;
 
+  // (Re)configure SPS if required
+  fill_sps_cfg_reconf(rr_cfg, current_rr_cfg, enb_cfg, ue_cell_list, bearers);
+
   // PhysCfgDed update needed
   if (phy_cfg_updated) {
     rr_cfg.phys_cfg_ded_present = true;
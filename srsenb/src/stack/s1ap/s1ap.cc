@@ -257,7 +257,8 @@ srsran::proc_outcome_t s1ap::s1_setup_proc_t::start_mme_connection()
     };
     s1ap_ptr->task_sched.notify_background_task_result(notify_result);
   };
-  srsran::get_background_workers().push_task(connect_callback);
+  // The connection may block for seconds, so it must not delay the other background tasks
+  srsran::get_background_workers().push_task(connect_callback, srsran::task_priority::low);
   procDebug("Connection to MME requested.");
 
   return srsran::proc_outcome_t::yield;
@@ -686,10 +687,17 @@ bool s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu)
     pcap->write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
-  s1ap_pdu_c     rx_pdu;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
+  // The previous PDU was destroyed, its memory is reused. The handlers copy what they keep outside of the scope
+  rx_pdu_arena.reset();
+  s1ap_pdu_c        rx_pdu;
+  asn1::cbit_ref    bref(pdu->msg, pdu->N_bytes);
+  asn1::SRSASN_CODE unpack_ret;
+  {
+    asn1::decode_arena_scope arena_scope(rx_pdu_arena);
+    unpack_ret = rx_pdu.unpack(bref);
+  }
 
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  if (unpack_ret != asn1::SRSASN_SUCCESS) {
     logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
     cause_c cause;
     cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
@@ -29,6 +29,7 @@
 #include "srsran/support/srsran_assert.h"
 
 #include <errno.h>
+#include <array>
 #include <linux/ip.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -98,6 +99,7 @@ gtpu_tunnel_manager::add_tunnel(uint16_t rnti, uint32_t eps_bearer_id, uint32_t
   tun->eps_bearer_id = eps_bearer_id;
   tun->teid_out      = teidout;
   tun->spgw_addr     = spgw_addr;
+  tun->gpdu_hdr      = srsran::gtpu_make_gpdu_header_template(teidout);
 
   if (ue_teidin_db.find(rnti) == ue_teidin_db.end()) {
     auto ret = ue_teidin_db.emplace(rnti, ue_bearer_tunnel_list());
@@ -384,32 +386,13 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
 
   tunnels.init(args, pdcp);
 
-  char errbuf[128] = {};
-
   // Set up socket
-  fd = socket(AF_INET, SOCK_DGRAM, 0);
+  fd = open_s1u_socket();
   if (fd < 0) {
-    logger.error("Failed to create socket");
-    return SRSRAN_ERROR;
-  }
-  int enable = 1;
-#if defined(SO_REUSEADDR)
-  if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int)) < 0)
-    logger.error("setsockopt(SO_REUSEADDR) failed");
-#endif
-#if defined(SO_REUSEPORT)
-  if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(int)) < 0)
-    logger.error("setsockopt(SO_REUSEPORT) failed");
-#endif
-
-  struct sockaddr_in bindaddr;
-  bzero(&bindaddr, sizeof(struct sockaddr_in));
-  // Bind socket
-  if (not net_utils::bind_addr(fd, gtp_bind_addr.c_str(), GTPU_PORT, &bindaddr)) {
-    snprintf(errbuf, sizeof(errbuf), "%s", strerror(errno));
-    srsran::console("Failed to bind on address %s, port %d: %s\n", gtp_bind_addr.c_str(), int(GTPU_PORT), errbuf);
     return SRSRAN_ERROR;
   }
+  ul_gso = net_utils::udp_gso_supported(fd);
+  logger.info("UDP GSO %s for the UL PDUs", ul_gso ? "enabled" : "not supported");
 
   // Assign a handler to rx S1U packets
   auto rx_callback = [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
@@ -417,6 +400,22 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
   };
   rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_handler(logger, gtpu_queue, rx_callback));
 
+  // The additional S1U sockets share the port with SO_REUSEPORT, which keeps each flow in the same socket, and are
+  // read by their own threads. All of them dispatch the PDUs to the GTPU queue
+  for (uint32_t i = 1; i < args.nof_rx_sockets; ++i) {
+    int rx_fd = open_s1u_socket();
+    if (rx_fd < 0) {
+      return SRSRAN_ERROR;
+    }
+    extra_rx_fds.push_back(rx_fd);
+    extra_rx_socket_handlers.emplace_back(new srsran::socket_manager());
+    extra_rx_socket_handlers.back()->add_socket_handler(rx_fd,
+                                                        srsran::make_sdu_handler(logger, gtpu_queue, rx_callback));
+  }
+  if (args.nof_rx_sockets > 1) {
+    logger.info("Receiving S1U PDUs with %d sockets", args.nof_rx_sockets);
+  }
+
   // Start MCH socket if enabled
   if (args.embms_enable) {
     if (not m1u.init(args.embms_m1u_multiaddr, args.embms_m1u_if_addr)) {
@@ -426,8 +425,46 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
   return SRSRAN_SUCCESS;
 }
 
+int gtpu::open_s1u_socket()
+{
+  char errbuf[128] = {};
+
+  int sock_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (sock_fd < 0) {
+    logger.error("Failed to create socket");
+    return -1;
+  }
+  int enable = 1;
+#if defined(SO_REUSEADDR)
+  if (setsockopt(sock_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int)) < 0)
+    logger.error("setsockopt(SO_REUSEADDR) failed");
+#endif
+#if defined(SO_REUSEPORT)
+  if (setsockopt(sock_fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(int)) < 0)
+    logger.error("setsockopt(SO_REUSEPORT) failed");
+#endif
+
+  struct sockaddr_in bindaddr;
+  bzero(&bindaddr, sizeof(struct sockaddr_in));
+  // Bind socket
+  if (not net_utils::bind_addr(sock_fd, gtp_bind_addr.c_str(), GTPU_PORT, &bindaddr)) {
+    snprintf(errbuf, sizeof(errbuf), "%s", strerror(errno));
+    srsran::console("Failed to bind on address %s, port %d: %s\n", gtp_bind_addr.c_str(), int(GTPU_PORT), errbuf);
+    close(sock_fd);
+    return -1;
+  }
+  return sock_fd;
+}
+
 void gtpu::stop()
 {
+  flush_ul_pdus();
+  // Stop the threads of the additional S1U sockets before closing them
+  extra_rx_socket_handlers.clear();
+  for (int rx_fd : extra_rx_fds) {
+    close(rx_fd);
+  }
+  extra_rx_fds.clear();
   if (fd > 0) {
     close(fd);
     fd = -1;
@@ -444,10 +481,27 @@ void gtpu::write_pdu(uint16_t rnti, uint32_t eps_bearer_id, srsran::unique_byte_
   }
   const gtpu_tunnel& tx_tun = *tunnels.find_tunnel(teids[0].teid);
   log_message(tx_tun, false, srsran::make_span(pdu));
-  send_pdu_to_tunnel(tx_tun, std::move(pdu));
+  send_pdu_to_tunnel(tx_tun, std::move(pdu), -1, true);
 }
 
-void gtpu::send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buffer_t pdu, int pdcp_sn)
+void gtpu::flush_ul_pdus()
+{
+  if (ul_tx_batch.empty()) {
+    return;
+  }
+  static_assert(MAX_UL_TX_BATCH <= net_utils::max_send_datagrams, "UL batch too large for send_datagrams()");
+  std::array<struct iovec, MAX_UL_TX_BATCH> iovs;
+  std::array<sockaddr_in, MAX_UL_TX_BATCH>  addrs;
+  for (uint32_t i = 0; i < ul_tx_batch.size(); ++i) {
+    iovs[i].iov_base = ul_tx_batch[i].pdu->msg;
+    iovs[i].iov_len  = ul_tx_batch[i].pdu->N_bytes;
+    addrs[i]         = ul_tx_batch[i].addr;
+  }
+  net_utils::send_datagrams(fd, iovs.data(), addrs.data(), ul_tx_batch.size(), ul_gso);
+  ul_tx_batch.clear();
+}
+
+void gtpu::send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buffer_t pdu, int pdcp_sn, bool batched)
 {
   // Check valid IP version
   struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
@@ -456,29 +510,36 @@ void gtpu::send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buf
     return;
   }
 
-  gtpu_header_t header;
-  header.flags        = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
-  header.message_type = GTPU_MSG_DATA_PDU;
-  header.length       = pdu->N_bytes;
-  header.teid         = tx_tun.teid_out;
+  struct sockaddr_in servaddr;
+  servaddr.sin_family      = AF_INET;
+  servaddr.sin_addr.s_addr = htonl(tx_tun.spgw_addr);
+  servaddr.sin_port        = htons(GTPU_PORT);
 
   if (pdcp_sn >= 0) {
-    header.flags |= GTPU_FLAGS_EXTENDED_HDR;
+    gtpu_header_t header;
+    header.flags             = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL | GTPU_FLAGS_EXTENDED_HDR;
+    header.message_type      = GTPU_MSG_DATA_PDU;
+    header.length            = pdu->N_bytes;
+    header.teid              = tx_tun.teid_out;
     header.next_ext_hdr_type = GTPU_EXT_HEADER_PDCP_PDU_NUMBER;
     header.ext_buffer.resize(4u);
     header.ext_buffer[0] = 0x01u;
     header.ext_buffer[1] = (pdcp_sn >> 8u) & 0xffu;
     header.ext_buffer[2] = pdcp_sn & 0xffu;
     header.ext_buffer[3] = 0;
+    if (!gtpu_write_header(&header, pdu.get(), logger)) {
+      logger.error("Error writing GTP-U Header. Flags 0x%x, Message Type 0x%x", header.flags, header.message_type);
+      return;
+    }
+  } else if (!gtpu_write_gpdu_header(tx_tun.gpdu_hdr, pdu.get(), logger)) {
+    logger.error("Error writing GTP-U Header. TEID 0x%x", tx_tun.teid_out);
+    return;
   }
-
-  struct sockaddr_in servaddr;
-  servaddr.sin_family      = AF_INET;
-  servaddr.sin_addr.s_addr = htonl(tx_tun.spgw_addr);
-  servaddr.sin_port        = htons(GTPU_PORT);
-
-  if (!gtpu_write_header(&header, pdu.get(), logger)) {
-    logger.error("Error writing GTP-U Header. Flags 0x%x, Message Type 0x%x", header.flags, header.message_type);
+  if (batched) {
+    if (ul_tx_batch.full()) {
+      flush_ul_pdus();
+    }
+    ul_tx_batch.push_back(ul_tx_pdu_t{std::move(pdu), servaddr});
     return;
   }
   if (sendto(fd, pdu->msg, pdu->N_bytes, MSG_EOR, (struct sockaddr*)&servaddr, sizeof(struct sockaddr_in)) < 0) {
@@ -617,6 +678,7 @@ void gtpu::handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const soc
 
   logger.debug("Received %d bytes from S1-U interface", pdu->N_bytes);
   pdu->set_timestamp();
+  pdu->md.trace.start();
 
   // Decode GTPU Header
   gtpu_header_t header;
@@ -720,13 +782,14 @@ int gtpu::create_dl_fwd_tunnel(uint32_t rx_teid_in, uint32_t tx_teid_in)
 
   tunnels.setup_forwarding(rx_teid_in, tx_teid_in);
 
-  // Get all buffered PDCP PDUs, and forward them through tx tunnel
-  std::map<uint32_t, srsran::unique_byte_buffer_t> pdus = pdcp->get_buffered_pdus(rx_tun->rnti, rx_tun->eps_bearer_id);
-  for (auto& pdu_pair : pdus) {
-    uint32_t pdcp_sn = pdu_pair.first;
-    log_message(*tx_tun, false, srsran::make_span(pdu_pair.second), pdcp_sn);
-    send_pdu_to_tunnel(*tx_tun, std::move(pdu_pair.second), pdcp_sn);
+  // Take over the buffered PDCP PDUs, and forward them through tx tunnel in UDP bursts
+  std::vector<srsran::unique_byte_buffer_t> pdus = pdcp->get_buffered_pdus(rx_tun->rnti, rx_tun->eps_bearer_id);
+  for (srsran::unique_byte_buffer_t& pdu : pdus) {
+    uint32_t pdcp_sn = pdu->md.pdcp_sn;
+    log_message(*tx_tun, false, srsran::make_span(pdu), pdcp_sn);
+    send_pdu_to_tunnel(*tx_tun, std::move(pdu), pdcp_sn, true);
   }
+  flush_ul_pdus();
 
   return SRSRAN_SUCCESS;
 }
@@ -739,7 +802,7 @@ void gtpu::error_indication(in_addr_t addr, in_port_t port, uint32_t err_teid)
   logger.info("TX GTPU Error Indication. Seq: %d, Error TEID: %d", tx_seq, err_teid);
 
   gtpu_header_t        header = {};
-  unique_byte_buffer_t pdu    = make_byte_buffer();
+  unique_byte_buffer_t pdu    = make_sized_byte_buffer(GTPU_EXTENDED_HEADER_LEN);
   if (pdu == nullptr) {
     logger.error("Could not allocate byte buffer for error indication");
     return;
@@ -773,7 +836,7 @@ void gtpu::echo_response(in_addr_t addr, in_port_t port, uint16_t seq)
   logger.info("TX GTPU Echo Response, Seq: %d", seq);
 
   gtpu_header_t        header = {};
-  unique_byte_buffer_t pdu    = make_byte_buffer();
+  unique_byte_buffer_t pdu    = make_sized_byte_buffer(GTPU_EXTENDED_HEADER_LEN);
   if (pdu == nullptr) {
     logger.error("Could not allocate byte buffer for echo response");
     return;
@@ -811,7 +874,7 @@ bool gtpu::send_end_marker(uint32_t teidin)
   logger.info("Tx GTPU End Marker, " TEID_IN_FMT ", rnti=0x%x", teidin, tx_tun->rnti);
 
   gtpu_header_t        header = {};
-  unique_byte_buffer_t pdu    = make_byte_buffer();
+  unique_byte_buffer_t pdu    = make_sized_byte_buffer(GTPU_EXTENDED_HEADER_LEN);
   if (pdu == nullptr) {
     logger.warning("Failed to allocate buffer to send End Marker to TEID=%d", teidin);
     return false;
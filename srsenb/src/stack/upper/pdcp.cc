@@ -51,6 +51,7 @@ void pdcp::add_user(uint16_t rnti)
   if (users.count(rnti) == 0) {
     unique_rnti_ptr<srsran::pdcp> obj = make_rnti_obj<srsran::pdcp>(rnti, task_sched, logger.id().c_str());
     obj->init(&users[rnti].rlc_itf, &users[rnti].rrc_itf, &users[rnti].gtpu_itf);
+    obj->set_tx_crypto_offload(tx_crypto_offload);
     users[rnti].rlc_itf.rnti  = rnti;
     users[rnti].gtpu_itf.rnti = rnti;
     users[rnti].rrc_itf.rnti  = rnti;
@@ -191,7 +192,7 @@ void pdcp::send_status_report(uint16_t rnti, uint32_t lcid)
   }
 }
 
-std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint16_t rnti, uint32_t lcid)
+std::vector<srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint16_t rnti, uint32_t lcid)
 {
   if (users.count(rnti)) {
     return users[rnti].pdcp->get_buffered_pdus(lcid);
@@ -229,6 +229,19 @@ void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof
   pthread_rwlock_unlock(&rwlock);
 }
 
+void rlc::write_pdus(uint16_t rnti, srsran::span<const rlc_rx_pdu_t> pdus)
+{
+  // Take the lock and look up the user once for all the PDUs
+  pthread_rwlock_rdlock(&rwlock);
+  auto it = users.find(rnti);
+  if (it != users.end()) {
+    for (const rlc_rx_pdu_t& pdu : pdus) {
+      it->second.rlc->write_pdu(pdu.lcid, pdu.payload, pdu.nof_bytes);
+    }
+  }
+  pthread_rwlock_unlock(&rwlock);
+}
+
 void rlc::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
   pthread_rwlock_rdlock(&rwlock);
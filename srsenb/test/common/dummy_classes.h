@@ -42,6 +42,7 @@ public:
   int  bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, mac_lc_ch_cfg_t* cfg) override { return 0; }
   int  bearer_ue_rem(uint16_t rnti, uint32_t lc_id) override { return 0; }
   void phy_config_enabled(uint16_t rnti, bool enabled) override {}
+  bool admit_gbr_bearer(uint16_t rnti, uint32_t gbr_dl, uint32_t gbr_ul) override { return true; }
   void write_mcch(const srsran::sib2_mbms_t* sib2_,
                   const srsran::sib13_t*     sib13_,
                   const srsran::mcch_msg_t*  mcch_,
@@ -49,6 +50,7 @@ public:
                   const uint8_t              mcch_payload_length) override
   {}
   uint16_t reserve_new_crnti(const sched_interface::ue_cfg_t& ue_cfg) override { return last_rnti++; }
+  uint16_t reserve_sps_crnti(uint16_t rnti) override { return rnti + 0xEA60; }
 
   uint16_t last_rnti = 70;
 };
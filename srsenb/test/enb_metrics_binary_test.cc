@@ -0,0 +1,192 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/metrics_binary.h"
+#include "srsran/common/test_common.h"
+#include <arpa/inet.h>
+#include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace srsenb;
+
+namespace {
+
+uint32_t read_u32(const uint8_t* p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+uint16_t read_u16(const uint8_t* p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+float read_f32(const uint8_t* p)
+{
+  uint32_t bits = read_u32(p);
+  float    v;
+  memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+enb_metrics_t make_metrics(uint32_t nof_ues)
+{
+  enb_metrics_t m = {};
+  m.stack.mac.cc_info.resize(2);
+  m.stack.mac.cc_info[0].pci             = 1;
+  m.stack.mac.cc_info[0].cc_rach_counter = 3;
+  m.stack.mac.cc_info[1].pci             = 2;
+  m.stack.mac.ues.resize(nof_ues);
+  m.phy.resize(nof_ues);
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    m.stack.mac.ues[i].rnti      = 0x46 + i;
+    m.stack.mac.ues[i].pci       = 1;
+    m.stack.mac.ues[i].nof_tti   = 20;
+    m.stack.mac.ues[i].tx_brate  = 8000 + i;
+    m.stack.mac.ues[i].tx_pkts   = 20;
+    m.stack.mac.ues[i].tx_errors = 1;
+    m.stack.mac.ues[i].dl_cqi    = 12.5;
+    m.phy[i].dl.mcs              = 27;
+    m.phy[i].ul.mcs              = NAN;
+  }
+  return m;
+}
+
+int test_serialize()
+{
+  std::vector<std::vector<uint8_t>> datagrams;
+  metrics_binary::serialize(make_metrics(2), 20000, 7, 123456789, datagrams);
+  TESTASSERT_EQ(1, datagrams.size());
+  const uint8_t* p = datagrams[0].data();
+  TESTASSERT_EQ(metrics_binary::header_len + 2 * metrics_binary::cell_len + 2 * metrics_binary::ue_len,
+                datagrams[0].size());
+  TESTASSERT_EQ(metrics_binary::magic, read_u32(p));
+  TESTASSERT_EQ(1, p[7]);
+  TESTASSERT_EQ(7, read_u32(p + 8));
+  TESTASSERT_EQ(20000, read_u32(p + 12));
+  TESTASSERT_EQ(123456789, read_u32(p + 16));
+  TESTASSERT_EQ(2, read_u16(p + 24));
+  TESTASSERT_EQ(2, read_u16(p + 26));
+
+  const uint8_t* cell = p + metrics_binary::header_len;
+  TESTASSERT_EQ(1, read_u16(cell + 2));
+  TESTASSERT_EQ(3, read_u32(cell + 4));
+
+  const uint8_t* ue = cell + 2 * metrics_binary::cell_len + metrics_binary::ue_len;
+  TESTASSERT_EQ(0x47, read_u16(ue));
+  TESTASSERT_EQ(20, read_u32(ue + 4));
+  TESTASSERT_EQ(8001, read_u32(ue + 8));
+  TESTASSERT_EQ(12.5, read_f32(ue + 40));
+  TESTASSERT_EQ(27, read_f32(ue + 48));
+  TESTASSERT(std::isnan(read_f32(ue + 52)));
+
+  // The UEs that do not fit in one datagram are sent in the following ones, each with the header and the cells
+  metrics_binary::serialize(make_metrics(50), 20000, 8, 0, datagrams);
+  TESTASSERT_EQ(3, datagrams.size());
+  uint32_t nof_ues = 0;
+  for (uint32_t d = 0; d < datagrams.size(); ++d) {
+    TESTASSERT(datagrams[d].size() <= metrics_binary::max_datagram);
+    TESTASSERT_EQ(d, datagrams[d][6]);
+    TESTASSERT_EQ(3, datagrams[d][7]);
+    TESTASSERT_EQ(2, read_u16(&datagrams[d][24]));
+    nof_ues += read_u16(&datagrams[d][26]);
+  }
+  TESTASSERT_EQ(50, nof_ues);
+
+  return SRSRAN_SUCCESS;
+}
+
+std::string http_get(int port, const std::string& path)
+{
+  int         fd   = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr = {};
+  addr.sin_family  = AF_INET;
+  addr.sin_port    = htons(port);
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+    close(fd);
+    return "";
+  }
+  std::string req = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  send(fd, req.data(), req.size(), 0);
+  std::string resp;
+  char        buf[1024];
+  ssize_t     n;
+  while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+    resp.append(buf, n);
+  }
+  close(fd);
+  return resp;
+}
+
+int test_udp_and_http()
+{
+  const int port = 58765;
+
+  int         rx_fd = socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in addr  = {};
+  addr.sin_family   = AF_INET;
+  addr.sin_port     = htons(port);
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  TESTASSERT(bind(rx_fd, (sockaddr*)&addr, sizeof(addr)) == 0);
+
+  metrics_binary exporter;
+  TESTASSERT(exporter.init("127.0.0.1", port, "127.0.0.1", port));
+  exporter.set_metrics(make_metrics(2), 20000);
+  exporter.set_metrics(make_metrics(1), 20000);
+
+  uint8_t buf[2048];
+  TESTASSERT(recv(rx_fd, buf, sizeof(buf), 0) > 0);
+  TESTASSERT_EQ(0, read_u32(buf + 8));
+  TESTASSERT(recv(rx_fd, buf, sizeof(buf), 0) > 0);
+  TESTASSERT_EQ(1, read_u32(buf + 8));
+  close(rx_fd);
+
+  // The counters are accumulated over both periods, and the released UE is removed
+  std::string resp = http_get(port, "/metrics");
+  TESTASSERT(resp.compare(0, 15, "HTTP/1.1 200 OK") == 0);
+  TESTASSERT(resp.find("srsenb_ue_dl_bits_total{rnti=\"0x46\",pci=\"1\"} 16000\n") != std::string::npos);
+  TESTASSERT(resp.find("srsenb_ue_dl_pdu_errors_total{rnti=\"0x46\",pci=\"1\"} 2\n") != std::string::npos);
+  TESTASSERT(resp.find("srsenb_ue_dl_cqi{rnti=\"0x46\",pci=\"1\"} 12.5\n") != std::string::npos);
+  TESTASSERT(resp.find("srsenb_cell_rach_total{pci=\"1\"} 6\n") != std::string::npos);
+  TESTASSERT(resp.find("rnti=\"0x47\"") == std::string::npos);
+  TESTASSERT(resp.find("srsenb_ue_ul_mcs{") == std::string::npos);
+
+  TESTASSERT(http_get(port, "/").compare(0, 22, "HTTP/1.1 404 Not Found") == 0);
+
+  exporter.stop();
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_serialize() == SRSRAN_SUCCESS);
+  TESTASSERT(test_udp_and_http() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
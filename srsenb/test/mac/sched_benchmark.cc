@@ -20,29 +20,42 @@
  */
 
 #include "sched_test_common.h"
+#include "sched_traffic_model.h"
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsran/adt/accumulators.h"
 #include "srsran/common/common_lte.h"
+#include "srsran/common/string_helpers.h"
+#include <boost/program_options.hpp>
 #include <chrono>
 
+// shorten boost program options namespace
+namespace bpo = boost::program_options;
+
 namespace srsenb {
 
 struct run_params {
-  uint32_t    nof_prbs;
-  uint32_t    nof_ues;
-  uint32_t    nof_ttis;
-  uint32_t    cqi;
-  const char* sched_policy;
+  uint32_t           nof_prbs;
+  uint32_t           nof_ues;
+  uint32_t           nof_ttis;
+  uint32_t           nof_cc;
+  uint32_t           cqi;
+  sched_traffic_type traffic;
+  std::string        sched_policy;
 };
 
 struct run_params_range {
-  std::vector<uint32_t>    nof_prbs{srsran::lte_cell_nof_prbs.begin(), srsran::lte_cell_nof_prbs.end()};
-  std::vector<uint32_t>    nof_ues      = {1, 2, 5, 32};
-  uint32_t                 nof_ttis     = 10000;
-  std::vector<uint32_t>    cqi          = {5, 10, 15};
-  std::vector<const char*> sched_policy = {"time_rr", "time_pf"};
-
-  size_t     nof_runs() const { return nof_prbs.size() * nof_ues.size() * cqi.size() * sched_policy.size(); }
+  std::vector<uint32_t>           nof_prbs{srsran::lte_cell_nof_prbs.begin(), srsran::lte_cell_nof_prbs.end()};
+  std::vector<uint32_t>           nof_ues      = {1, 2, 5, 32};
+  uint32_t                        nof_ttis     = 10000;
+  std::vector<uint32_t>           nof_cc       = {1};
+  std::vector<uint32_t>           cqi          = {5, 10, 15};
+  std::vector<sched_traffic_type> traffic      = {sched_traffic_type::full_buffer};
+  std::vector<std::string>        sched_policy = {"time_rr", "time_pf", "freq_pf"};
+
+  size_t nof_runs() const
+  {
+    return nof_prbs.size() * nof_ues.size() * nof_cc.size() * cqi.size() * traffic.size() * sched_policy.size();
+  }
   run_params get_params(size_t idx) const
   {
     run_params r = {};
@@ -51,13 +64,20 @@ struct run_params_range {
     idx /= nof_prbs.size();
     r.nof_ues = nof_ues[idx % nof_ues.size()];
     idx /= nof_ues.size();
+    r.nof_cc = nof_cc[idx % nof_cc.size()];
+    idx /= nof_cc.size();
     r.cqi = cqi[idx % cqi.size()];
     idx /= cqi.size();
+    r.traffic = traffic[idx % traffic.size()];
+    idx /= traffic.size();
     r.sched_policy = sched_policy.at(idx);
     return r;
   }
 };
 
+/// CQI trace shared by all the runs. When empty, the UEs report the CQI of the run parameters
+static sched_cqi_trace cqi_trace_file{0};
+
 class sched_tester : public sched_sim_base
 {
   static std::vector<sched_interface::cell_cfg_t> get_cell_cfg(srsran::span<const sched_cell_params_t> cell_params)
@@ -81,35 +101,48 @@ public:
 
   srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
   sched*                sched_ptr;
-  uint32_t              dl_bytes_per_tti   = 100000;
-  uint32_t              ul_bytes_per_tti   = 100000;
+  uint32_t              dl_bytes_per_tti   = sched_traffic_source::full_buffer_bytes;
+  uint32_t              ul_bytes_per_tti   = sched_traffic_source::full_buffer_bytes;
   run_params            current_run_params = {};
 
   std::vector<sched_interface::dl_sched_res_t> dl_result;
   std::vector<sched_interface::ul_sched_res_t> ul_result;
 
   struct throughput_stats {
-    srsran::rolling_average<float>  mean_dl_tbs, mean_ul_tbs, avg_dl_mcs, avg_ul_mcs;
-    srsran::rolling_average<double> avg_latency;
-    std::vector<uint32_t>           latency_samples;
+    srsran::rolling_average<float> mean_dl_tbs, mean_ul_tbs, avg_dl_mcs, avg_ul_mcs;
+    sched_latency_stats            latency;
   };
   throughput_stats total_stats;
 
+  /// Buffers of the UEs that follow a traffic model, as seen by the RLC and by the UE
+  struct ue_traffic_ctxt {
+    uint32_t             ue_idx;
+    sched_traffic_source source;
+    uint32_t             dl_pending = 0, ul_pending = 0;
+    bool                 dl_changed = false, ul_changed = false;
+  };
+  std::map<uint16_t, ue_traffic_ctxt> ue_traffic;
+  /// The traffic only starts once all the UEs are connected, so that the RA procedures do not compete with it
+  bool traffic_started = false;
+
+  void add_traffic(uint16_t rnti, uint32_t ue_idx)
+  {
+    ue_traffic.emplace(rnti, ue_traffic_ctxt{ue_idx, sched_traffic_source{current_run_params.traffic, rnti}});
+  }
+
   int advance_tti()
   {
     tti_point tti_rx = get_tti_rx().is_valid() ? get_tti_rx() + 1 : tti_point(0);
     mac_logger.set_context(tti_rx.to_uint());
     new_tti(tti_rx);
 
+    std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
     for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
-      std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
       TESTASSERT(sched_ptr->dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_result[cc]) == SRSRAN_SUCCESS);
       TESTASSERT(sched_ptr->ul_sched(to_tx_ul(tti_rx).to_uint(), cc, ul_result[cc]) == SRSRAN_SUCCESS);
-      std::chrono::time_point<std::chrono::steady_clock> tp2 = std::chrono::steady_clock::now();
-      std::chrono::nanoseconds tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp);
-      total_stats.avg_latency.push(tdur.count());
-      total_stats.latency_samples.push_back(tdur.count());
     }
+    std::chrono::time_point<std::chrono::steady_clock> tp2 = std::chrono::steady_clock::now();
+    total_stats.latency.push(std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp).count());
 
     sf_output_res_t sf_out{get_cell_params(), tti_rx, ul_result, dl_result};
     update(sf_out);
@@ -120,14 +153,36 @@ public:
 
   void set_external_tti_events(const sim_ue_ctxt_t& ue_ctxt, ue_tti_events& pending_events) override
   {
-    // do nothing
-    if (ue_ctxt.conres_rx) {
-      sched_ptr->ul_bsr(ue_ctxt.rnti, 1, dl_bytes_per_tti);
-      sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, ul_bytes_per_tti, 0);
-
-      if (get_tti_rx().to_uint() % 5 == 0) {
-        for (auto& cc : pending_events.cc_list) {
-          cc.dl_cqi = current_run_params.cqi;
+    if (not ue_ctxt.conres_rx) {
+      return;
+    }
+    auto& traffic = ue_traffic.at(ue_ctxt.rnti);
+    if (not traffic_started) {
+      // wait for the other UEs
+    } else if (traffic.source.is_full_buffer()) {
+      sched_ptr->ul_bsr(ue_ctxt.rnti, 1, ul_bytes_per_tti);
+      sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, dl_bytes_per_tti, 0);
+    } else {
+      uint32_t new_dl_bytes, new_ul_bytes;
+      traffic.source.step(get_tti_rx().to_uint(), new_dl_bytes, new_ul_bytes);
+      traffic.dl_pending += new_dl_bytes;
+      traffic.ul_pending += new_ul_bytes;
+      if (new_dl_bytes > 0 or traffic.dl_changed) {
+        sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, traffic.dl_pending, 0);
+      }
+      if (new_ul_bytes > 0 or traffic.ul_changed) {
+        sched_ptr->ul_bsr(ue_ctxt.rnti, 1, traffic.ul_pending);
+      }
+      traffic.dl_changed = false;
+      traffic.ul_changed = false;
+    }
+
+    if (get_tti_rx().to_uint() % 5 == 0) {
+      uint32_t cqi = cqi_trace_file.empty() ? current_run_params.cqi
+                                            : cqi_trace_file.get_cqi(traffic.ue_idx, get_tti_rx().to_uint());
+      for (auto& cc : pending_events.cc_list) {
+        if (cc.configured) {
+          cc.dl_cqi = cqi;
           cc.ul_snr = 40;
         }
       }
@@ -136,46 +191,90 @@ public:
 
   void process_stats(sf_output_res_t& sf_out)
   {
+    uint32_t dl_tbs = 0, ul_tbs = 0;
     for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
-      uint32_t dl_tbs = 0, ul_tbs = 0, dl_mcs = 0, ul_mcs = 0;
+      uint32_t dl_mcs = 0, ul_mcs = 0;
       for (const auto& data : sf_out.dl_cc_result[cc].data) {
         dl_tbs += data.tbs[0];
         dl_tbs += data.tbs[1];
         dl_mcs = std::max(dl_mcs, data.dci.tb[0].mcs_idx);
+        serve_dl_data(data);
       }
-      total_stats.mean_dl_tbs.push(dl_tbs);
       if (not sf_out.dl_cc_result[cc].data.empty()) {
         total_stats.avg_dl_mcs.push(dl_mcs);
       }
       for (const auto& pusch : sf_out.ul_cc_result[cc].pusch) {
         ul_tbs += pusch.tbs;
         ul_mcs = std::max(ul_mcs, pusch.dci.tb.mcs_idx);
+        serve_ul_data(pusch);
       }
-      total_stats.mean_ul_tbs.push(ul_tbs);
       if (not sf_out.ul_cc_result[cc].pusch.empty()) {
         total_stats.avg_ul_mcs.push(ul_mcs);
       }
     }
+    total_stats.mean_dl_tbs.push(dl_tbs);
+    total_stats.mean_ul_tbs.push(ul_tbs);
+  }
+
+private:
+  void serve_dl_data(const sched_interface::dl_sched_data_t& data)
+  {
+    auto it = ue_traffic.find(data.dci.rnti);
+    if (it == ue_traffic.end() or it->second.source.is_full_buffer()) {
+      return;
+    }
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; ++tb) {
+      for (uint32_t i = 0; i < data.nof_pdu_elems[tb]; ++i) {
+        if (data.pdu[tb][i].lcid == 3) {
+          it->second.dl_pending -= std::min(it->second.dl_pending, data.pdu[tb][i].nbytes);
+          it->second.dl_changed = true;
+        }
+      }
+    }
+  }
+  void serve_ul_data(const sched_interface::ul_sched_data_t& pusch)
+  {
+    auto it = ue_traffic.find(pusch.dci.rnti);
+    if (it == ue_traffic.end() or it->second.source.is_full_buffer() or pusch.current_tx_nb > 0) {
+      return;
+    }
+    it->second.ul_pending -= std::min(it->second.ul_pending, pusch.tbs);
+    it->second.ul_changed = true;
   }
 };
 
 struct run_data {
-  run_params                params;
-  float                     avg_dl_throughput;
-  float                     avg_ul_throughput;
-  float                     avg_dl_mcs;
-  float                     avg_ul_mcs;
-  std::chrono::microseconds avg_latency;
-  std::chrono::microseconds q0_9_latency;
+  run_params params;
+  float      avg_dl_throughput;
+  float      avg_ul_throughput;
+  float      avg_dl_mcs;
+  float      avg_ul_mcs;
+  double     avg_latency_usec;
+  double     q0_5_latency_usec;
+  double     q0_9_latency_usec;
+  double     q0_99_latency_usec;
+  double     max_latency_usec;
 };
 
 int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results)
 {
-  std::vector<sched_interface::cell_cfg_t> cell_list(1, generate_default_cell_cfg(params.nof_prbs));
+  std::vector<sched_interface::cell_cfg_t> cell_list(params.nof_cc, generate_default_cell_cfg(params.nof_prbs));
   sched_interface::ue_cfg_t                ue_cfg_default = generate_default_ue_cfg();
   sched_interface::sched_args_t            sched_args     = {};
   sched_args.sched_policy                                 = params.sched_policy;
 
+  // All the carriers are SCells of each other, the UEs aggregate them once connected
+  for (uint32_t cc = 0; cc < params.nof_cc; ++cc) {
+    for (uint32_t scell = 0; scell < params.nof_cc; ++scell) {
+      if (scell != cc) {
+        cell_list[cc].scell_list.emplace_back();
+        cell_list[cc].scell_list.back().enb_cc_idx               = scell;
+        cell_list[cc].scell_list.back().cross_carrier_scheduling = false;
+        cell_list[cc].scell_list.back().ul_allowed               = true;
+      }
+    }
+  }
+
   sched     sched_obj;
   rrc_dummy rrc{};
   sched_obj.init(&rrc, sched_args);
@@ -194,6 +293,7 @@ int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results
       TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
     }
     TESTASSERT(tester.add_user(rnti, ue_cfg_default, 16) == SRSRAN_SUCCESS);
+    tester.add_traffic(rnti, ue_idx);
     TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
   }
 
@@ -206,23 +306,43 @@ int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results
     ue_db_ctxt = tester.get_enb_ctxt().ue_db;
   }
 
+  tester.traffic_started = true;
+
+  // Aggregate the SCells, and wait for their activation
+  if (params.nof_cc > 1) {
+    for (const auto& ue : ue_db_ctxt) {
+      sched_interface::ue_cfg_t ue_cfg = *tester.get_user_cfg(ue.first);
+      ue_cfg.supported_cc_list.resize(params.nof_cc);
+      for (uint32_t i = 0; i < params.nof_cc; ++i) {
+        ue_cfg.supported_cc_list[i]            = ue_cfg.supported_cc_list[0];
+        ue_cfg.supported_cc_list[i].active     = true;
+        ue_cfg.supported_cc_list[i].enb_cc_idx = i;
+      }
+      TESTASSERT(tester.ue_recfg(ue.first, ue_cfg) == SRSRAN_SUCCESS);
+    }
+    for (uint32_t count = 0; count < 100; ++count) {
+      tester.advance_tti();
+    }
+  }
+
   // Run benchmark
   tester.total_stats = {};
-  tester.total_stats.latency_samples.reserve(params.nof_ttis);
+  tester.total_stats.latency.reserve(params.nof_ttis);
   for (uint32_t count = 0; count < params.nof_ttis; ++count) {
     tester.advance_tti();
   }
-  std::sort(tester.total_stats.latency_samples.begin(), tester.total_stats.latency_samples.end());
-
-  run_data run_result          = {};
-  run_result.params            = params;
-  run_result.avg_dl_throughput = tester.total_stats.mean_dl_tbs.value() * 8.0F / 1e-3F;
-  run_result.avg_ul_throughput = tester.total_stats.mean_ul_tbs.value() * 8.0F / 1e-3F;
-  run_result.avg_dl_mcs        = tester.total_stats.avg_dl_mcs.value();
-  run_result.avg_ul_mcs        = tester.total_stats.avg_ul_mcs.value();
-  run_result.avg_latency  = std::chrono::microseconds(static_cast<int>(tester.total_stats.avg_latency.value() / 1000));
-  run_result.q0_9_latency = std::chrono::microseconds(
-      tester.total_stats.latency_samples[static_cast<size_t>(tester.total_stats.latency_samples.size() * 0.9)] / 1000);
+
+  run_data run_result           = {};
+  run_result.params             = params;
+  run_result.avg_dl_throughput  = tester.total_stats.mean_dl_tbs.value() * 8.0F / 1e-3F;
+  run_result.avg_ul_throughput  = tester.total_stats.mean_ul_tbs.value() * 8.0F / 1e-3F;
+  run_result.avg_dl_mcs         = tester.total_stats.avg_dl_mcs.value();
+  run_result.avg_ul_mcs         = tester.total_stats.avg_ul_mcs.value();
+  run_result.avg_latency_usec   = tester.total_stats.latency.mean_usec();
+  run_result.q0_5_latency_usec  = tester.total_stats.latency.percentile_usec(0.5);
+  run_result.q0_9_latency_usec  = tester.total_stats.latency.percentile_usec(0.9);
+  run_result.q0_99_latency_usec = tester.total_stats.latency.percentile_usec(0.99);
+  run_result.max_latency_usec   = tester.total_stats.latency.percentile_usec(1.0);
   run_results.push_back(run_result);
 
   return SRSRAN_SUCCESS;
@@ -264,25 +384,29 @@ run_data expected_run_result(run_params params)
 void print_benchmark_results(const std::vector<run_data>& run_results)
 {
   srslog::flush();
-  fmt::print("run | Nprb | cqi | sched pol | Nue | DL/UL [Mbps] | DL/UL mcs | DL/UL OH [%] | latency | latency q0.9 "
-             "[usec]\n");
+  fmt::print("run | Nprb | Ncc | cqi |     traffic | sched pol |  Nue | DL/UL [Mbps] | DL/UL mcs | DL/UL OH [%] | "
+             "latency mean/q0.5/q0.9/q0.99/max [usec]\n");
   fmt::print("------------------------------------------------------------------------------------------------------"
-             "------\n");
+             "---------------------------------------\n");
   for (uint32_t i = 0; i < run_results.size(); ++i) {
     const run_data& r = run_results[i];
 
     int   tbs_idx           = srsran_ra_tbs_idx_from_mcs(28, false, false);
-    int   tbs               = srsran_ra_tbs_from_idx(tbs_idx, r.params.nof_prbs);
+    int   tbs               = srsran_ra_tbs_from_idx(tbs_idx, r.params.nof_prbs) * r.params.nof_cc;
     float dl_rate_overhead  = 1.0F - r.avg_dl_throughput / (static_cast<float>(tbs) * 1e3F);
     tbs_idx                 = srsran_ra_tbs_idx_from_mcs(24, false, true);
     uint32_t nof_pusch_prbs = r.params.nof_prbs - (r.params.nof_prbs == 6 ? 2 : 4);
-    tbs                     = srsran_ra_tbs_from_idx(tbs_idx, nof_pusch_prbs);
+    tbs                     = srsran_ra_tbs_from_idx(tbs_idx, nof_pusch_prbs) * r.params.nof_cc;
     float ul_rate_overhead  = 1.0F - r.avg_ul_throughput / (static_cast<float>(tbs) * 1e3F);
+    std::string cqi_str     = cqi_trace_file.empty() ? std::to_string(r.params.cqi) : "trace";
 
-    fmt::print("{:>3d}{:>6d}{:>6d}{:>12}{:>6d}{:>9.2}/{:>4.2}{:>9.1f}/{:>4.1f}{:9.1f}/{:>4.1f}{:>9d}{:12d}\n",
+    fmt::print("{:>3d}{:>7d}{:>6d}{:>6}{:>14}{:>12}{:>7d}{:>9.2f}/{:>5.2f}{:>8.1f}/{:>4.1f}{:>9.1f}/{:>4.1f}"
+               "{:>11.1f}/{:.1f}/{:.1f}/{:.1f}/{:.1f}\n",
                i,
                r.params.nof_prbs,
-               r.params.cqi,
+               r.params.nof_cc,
+               cqi_str,
+               to_string(r.params.traffic),
                r.params.sched_policy,
                r.params.nof_ues,
                r.avg_dl_throughput / 1e6,
@@ -291,9 +415,31 @@ void print_benchmark_results(const std::vector<run_data>& run_results)
                r.avg_ul_mcs,
                dl_rate_overhead * 100,
                ul_rate_overhead * 100,
-               r.avg_latency.count(),
-               r.q0_9_latency.count());
+               r.avg_latency_usec,
+               r.q0_5_latency_usec,
+               r.q0_9_latency_usec,
+               r.q0_99_latency_usec,
+               r.max_latency_usec);
+  }
+}
+
+/// Returns an error if the q0.99 scheduling latency of any run exceeds the given budget
+int check_latency_budget(const std::vector<run_data>& run_results, double max_q0_99_latency_usec)
+{
+  if (max_q0_99_latency_usec <= 0) {
+    return SRSRAN_SUCCESS;
+  }
+  bool success = true;
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    if (run_results[i].q0_99_latency_usec > max_q0_99_latency_usec) {
+      fmt::print("run {}: latency q0.99 above budget ({:.1f} > {:.1f}) usec\n",
+                 i,
+                 run_results[i].q0_99_latency_usec,
+                 max_q0_99_latency_usec);
+      success = false;
+    }
   }
+  return success ? SRSRAN_SUCCESS : SRSRAN_ERROR;
 }
 
 int run_rate_test()
@@ -348,12 +494,10 @@ int run_rate_test()
   return success ? SRSRAN_SUCCESS : SRSRAN_ERROR;
 }
 
-int run_all()
+int run_param_sweep(const run_params_range& run_param_list, double max_q0_99_latency_usec)
 {
-  run_params_range      run_param_list{};
   srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
 
-  fmt::print("Running all param combinations\n");
   std::vector<run_data> run_results;
   size_t                nof_runs = run_param_list.nof_runs();
   for (size_t r = 0; r < nof_runs; ++r) {
@@ -365,39 +509,113 @@ int run_all()
 
   print_benchmark_results(run_results);
 
-  return SRSRAN_SUCCESS;
+  return check_latency_budget(run_results, max_q0_99_latency_usec);
 }
 
-int run_benchmark()
-{
-  run_params_range      run_param_list{};
-  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+struct bench_args_t {
+  std::string      mode;
+  run_params_range run_param_list;
+  double           max_q0_99_latency_usec = 0;
+};
 
-  run_param_list.nof_ttis     = 1000000;
-  run_param_list.nof_prbs     = {100};
-  run_param_list.cqi          = {15};
-  run_param_list.nof_ues      = {5};
-  run_param_list.sched_policy = {"time_pf"};
+template <typename T>
+void parse_param_list(const bpo::variables_map& vm, const char* name, std::vector<T>& list)
+{
+  if (vm.count(name) > 0) {
+    srsran::string_parse_list(vm[name].as<std::string>(), ',', list);
+  }
+}
 
-  std::vector<run_data> run_results;
-  size_t                nof_runs = run_param_list.nof_runs();
-  fmt::print("Running Benchmark\n");
-  for (size_t r = 0; r < nof_runs; ++r) {
-    run_params runparams = run_param_list.get_params(r);
+bench_args_t handle_args(int argc, char** argv)
+{
+  bench_args_t args;
+  std::string  cqi_trace_filename;
+
+  bpo::options_description options("Scheduler benchmark options");
+
+  // clang-format off
+  options.add_options()
+      ("mode",         bpo::value<std::string>(&args.mode)->default_value("test"), "test (rate test with the default parameters), benchmark (long run) or all (parameter sweep)")
+      ("nof_ttis",     bpo::value<uint32_t>(), "Number of TTIs of each run")
+      ("nof_prbs",     bpo::value<std::string>(), "Comma separated list of cell bandwidths in PRBs")
+      ("nof_ues",      bpo::value<std::string>(), "Comma separated list of UE counts")
+      ("nof_cc",       bpo::value<std::string>(), "Comma separated list of aggregated carriers per UE")
+      ("cqi",          bpo::value<std::string>(), "Comma separated list of fixed DL CQIs")
+      ("cqi_trace",    bpo::value<std::string>(&cqi_trace_filename), "File with one CQI per TTI. It overrides the fixed CQIs")
+      ("traffic",      bpo::value<std::string>(), "Comma separated list of traffic models: full_buffer, voip, web")
+      ("sched_policy", bpo::value<std::string>(), "Comma separated list of schedulers: time_rr, time_pf, freq_pf, time_qos")
+      ("max_latency",  bpo::value<double>(&args.max_q0_99_latency_usec), "Fail if the q0.99 TTI scheduling latency exceeds this value in usec")
+      ("help",         "Show this message")
+      ;
+  // clang-format on
+
+  bpo::positional_options_description p;
+  p.add("mode", 1);
+
+  bpo::variables_map vm;
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv).options(options).positional(p).run(), vm);
+    bpo::notify(vm);
+  } catch (bpo::error& e) {
+    fmt::print("{}\n", e.what());
+    exit(SRSRAN_ERROR);
+  }
 
-    mac_logger.info("\n### New run {} ###\n", r);
-    TESTASSERT(run_benchmark_scenario(runparams, run_results) == SRSRAN_SUCCESS);
+  if (vm.count("help")) {
+    fmt::print("Usage: {} [test|benchmark|all] [OPTIONS]\n\n{}\n", argv[0], options);
+    exit(0);
   }
 
-  print_benchmark_results(run_results);
+  // Default parameters of each mode, the command line options override them
+  run_params_range& range = args.run_param_list;
+  if (args.mode == "benchmark") {
+    range.nof_ttis     = 1000000;
+    range.nof_prbs     = {100};
+    range.cqi          = {15};
+    range.nof_ues      = {5};
+    range.sched_policy = {"time_pf"};
+  }
+  if (vm.count("nof_ttis") > 0) {
+    range.nof_ttis = vm["nof_ttis"].as<uint32_t>();
+  }
+  parse_param_list(vm, "nof_prbs", range.nof_prbs);
+  parse_param_list(vm, "nof_ues", range.nof_ues);
+  parse_param_list(vm, "nof_cc", range.nof_cc);
+  parse_param_list(vm, "cqi", range.cqi);
+  parse_param_list(vm, "sched_policy", range.sched_policy);
+  if (vm.count("traffic") > 0) {
+    std::vector<std::string> traffic_list;
+    parse_param_list(vm, "traffic", traffic_list);
+    range.traffic.resize(traffic_list.size());
+    for (uint32_t i = 0; i < traffic_list.size(); ++i) {
+      if (not parse_sched_traffic_type(traffic_list[i], range.traffic[i])) {
+        fmt::print("Invalid traffic model \"{}\"\n", traffic_list[i]);
+        exit(SRSRAN_ERROR);
+      }
+    }
+  }
+  if (not cqi_trace_filename.empty() and not cqi_trace_file.load(cqi_trace_filename)) {
+    fmt::print("Failed to read CQI trace {}\n", cqi_trace_filename);
+    exit(SRSRAN_ERROR);
+  }
+  if (std::any_of(range.nof_ues.begin(), range.nof_ues.end(), [](uint32_t n) { return n > SRSENB_MAX_UES; })) {
+    fmt::print("The eNB supports up to {} UEs\n", SRSENB_MAX_UES);
+    exit(SRSRAN_ERROR);
+  }
+  if (range.nof_runs() == 0) {
+    fmt::print("Empty list of run parameters\n");
+    exit(SRSRAN_ERROR);
+  }
 
-  return SRSRAN_SUCCESS;
+  return args;
 }
 
 } // namespace srsenb
 
 int main(int argc, char* argv[])
 {
+  srsenb::bench_args_t args = srsenb::handle_args(argc, argv);
+
   // Setup the log spy to intercept error and warning log entries.
   if (!srslog::install_custom_sink(
           srsran::log_sink_spy::name(),
@@ -418,15 +636,12 @@ int main(int argc, char* argv[])
   // Start the log backend.
   srslog::init();
 
-  bool run_benchmark = false;
-
-  if (argc == 1 or strcmp(argv[1], "test") == 0) {
+  if (args.mode == "test") {
     TESTASSERT(srsenb::run_rate_test() == SRSRAN_SUCCESS);
-  } else if (strcmp(argv[1], "benchmark") == 0) {
-    TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
   } else {
-    TESTASSERT(srsenb::run_all() == SRSRAN_SUCCESS);
+    fmt::print("Running {} param combinations\n", args.run_param_list.nof_runs());
+    TESTASSERT(srsenb::run_param_sweep(args.run_param_list, args.max_q0_99_latency_usec) == SRSRAN_SUCCESS);
   }
 
   return 0;
-}
\ No newline at end of file
+}
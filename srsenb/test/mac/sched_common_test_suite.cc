@@ -138,6 +138,10 @@ int test_pdsch_collisions(const sf_output_res_t& sf_out, uint32_t enb_cc_idx, co
 
   // Decode Data allocations, check collisions and fill cumulative mask
   for (uint32_t i = 0; i < dl_result.data.size(); ++i) {
+    if (dl_result.data[i].no_pdsch) {
+      // SPS release
+      continue;
+    }
     TESTASSERT(try_dl_mask_fill(dl_result.data[i].dci, "data") == SRSRAN_SUCCESS);
   }
 
@@ -244,6 +248,10 @@ int test_pdcch_collisions(const sf_output_res_t&                   sf_out,
     try_cce_fill(pusch.dci.location, "UL");
   }
   for (uint32_t i = 0; i < dl_result.data.size(); ++i) {
+    if (dl_result.data[i].no_pdcch) {
+      // SPS occasion
+      continue;
+    }
     try_cce_fill(dl_result.data[i].dci.location, "DL data");
   }
   for (uint32_t i = 0; i < dl_result.bc.size(); ++i) {
@@ -292,7 +300,7 @@ int test_dci_content_common(const sf_output_res_t& sf_out, uint32_t enb_cc_idx)
   for (uint32_t i = 0; i < dl_result.data.size(); ++i) {
     auto&    data = dl_result.data[i];
     uint16_t rnti = data.dci.rnti;
-    CONDERROR(data.tbs[0] == 0 and data.tbs[1] == 0, "Allocated DL data has empty TBS");
+    CONDERROR(data.tbs[0] == 0 and data.tbs[1] == 0 and not data.no_pdsch, "Allocated DL data has empty TBS");
     CONDERROR(alloc_rntis.count(rnti) > 0, "The user rnti=0x%x got allocated multiple times in DL", rnti);
     alloc_rntis.insert(data.dci.rnti);
     for (uint32_t tb = 0; tb < 2; ++tb) {
@@ -317,6 +317,47 @@ void test_ul_mcs_tbs_derivation()
   TESTASSERT_EQ(23, compute_tbs_mcs(100, 100 - 5).mcs);
 }
 
+void test_sps_dci_validation()
+{
+  sched_cell_params_t           cell_params;
+  sched_interface::cell_cfg_t   cell_cfg   = generate_default_cell_cfg(50);
+  sched_interface::sched_args_t sched_args = {};
+  cell_params.set_cfg(0, cell_cfg, sched_args);
+  prb_interval prbs{4, 10};
+
+  // TS 36.213 Table 9.2-1 - DL activation is signalled with HARQ pid 000, RV 00 and the MSB of the MCS set to 0
+  srsran_dci_dl_t dl_dci;
+  TESTASSERT(generate_dl_sps_activation_dci(dl_dci, 0x46, prbs, 9, cell_params));
+  TESTASSERT_EQ(SRSRAN_DCI_FORMAT1A, dl_dci.format);
+  TESTASSERT_EQ(0x46, dl_dci.rnti);
+  TESTASSERT_EQ(0, dl_dci.pid);
+  TESTASSERT_EQ(9, dl_dci.tb[0].mcs_idx);
+  TESTASSERT_EQ(0, dl_dci.tb[0].rv);
+  TESTASSERT(not dl_dci.tb[0].ndi);
+  TESTASSERT(prb_interval::riv_to_prbs(dl_dci.type2_alloc.riv, cell_params.nof_prb()) == prbs);
+  TESTASSERT(not generate_dl_sps_activation_dci(dl_dci, 0x46, prbs, MAX_SPS_MCS + 1, cell_params));
+
+  // TS 36.213 Table 9.2-1A - DL release is signalled with MCS 11111 and all the RIV bits set to 1
+  generate_dl_sps_release_dci(dl_dci, 0x46, cell_params);
+  TESTASSERT_EQ(SRSRAN_DCI_FORMAT1A, dl_dci.format);
+  TESTASSERT_EQ(0, dl_dci.pid);
+  TESTASSERT_EQ(31, dl_dci.tb[0].mcs_idx);
+  TESTASSERT_EQ(0, dl_dci.tb[0].rv);
+  uint32_t N = cell_params.nof_prb();
+  TESTASSERT_EQ((1U << (uint32_t)ceilf(log2f(N * (N + 1) / 2.0F))) - 1, dl_dci.type2_alloc.riv);
+
+  // TS 36.213 Table 9.2-1 - UL activation is signalled with TPC 00, cyclic shift DMRS 000 and MSB of the MCS set to 0
+  srsran_dci_ul_t ul_dci;
+  TESTASSERT(generate_ul_sps_activation_dci(ul_dci, 0x46, prbs, 15, cell_params));
+  TESTASSERT_EQ(SRSRAN_DCI_FORMAT0, ul_dci.format);
+  TESTASSERT_EQ(0, ul_dci.tpc_pusch);
+  TESTASSERT_EQ(0, ul_dci.n_dmrs);
+  TESTASSERT_EQ(15, ul_dci.tb.mcs_idx);
+  TESTASSERT(not ul_dci.tb.ndi);
+  TESTASSERT(prb_interval::riv_to_prbs(ul_dci.type2_alloc.riv, cell_params.nof_prb()) == prbs);
+  TESTASSERT(not generate_ul_sps_activation_dci(ul_dci, 0x46, prbs, MAX_SPS_MCS + 1, cell_params));
+}
+
 } // namespace srsenb
 
 int main()
@@ -333,6 +374,7 @@ int main()
   TESTASSERT(srsenb::test_mcs_tbs_consistency_all() == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_min_mcs_tbs_specific() == SRSRAN_SUCCESS);
   srsenb::test_ul_mcs_tbs_derivation();
+  srsenb::test_sps_dci_validation();
 
   printf("Success\n");
   return 0;
@@ -251,6 +251,50 @@ int test_6prbs()
   return SRSRAN_SUCCESS;
 }
 
+/// Many UEs competing for the PDCCH. The allocations must not collide, and a failed one must leave the previous
+/// allocations untouched
+int test_pdcch_many_ues()
+{
+  const uint32_t                   nof_ues = 16, aggr_idx = 2;
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::ue_cfg_t        ue_cfg   = generate_default_ue_cfg();
+  sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(100);
+  sched_interface::sched_args_t    sched_args{};
+  TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+  std::vector<std::unique_ptr<sched_ue> > ues;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    ues.emplace_back(new sched_ue{(uint16_t)(0x46 + i), cell_params, ue_cfg});
+  }
+
+  sf_cch_allocator                 pdcch;
+  sf_cch_allocator::alloc_result_t dci_result;
+  pdcch_mask_t                     mask_before, mask_after;
+  pdcch.init(cell_params[PCell_IDX]);
+
+  for (uint32_t t = 0; t < SRSRAN_NOF_SF_X_FRAME; ++t) {
+    pdcch.new_tti(tti_point{t});
+    for (auto& u : ues) {
+      pdcch.get_allocs(nullptr, &mask_before);
+      size_t nof_allocs = pdcch.nof_allocs();
+      if (not pdcch.alloc_dci(alloc_type_t::UL_DATA, aggr_idx, u.get(), true)) {
+        pdcch.get_allocs(nullptr, &mask_after);
+        TESTASSERT(pdcch.nof_allocs() == nof_allocs);
+        TESTASSERT(mask_before == mask_after);
+      }
+    }
+    TESTASSERT(pdcch.nof_allocs() > 0);
+
+    pdcch.get_allocs(&dci_result, &mask_after);
+    TESTASSERT(mask_after.count() == pdcch.nof_allocs() << aggr_idx);
+    for (const sf_cch_allocator::tree_node* node : dci_result) {
+      TESTASSERT(node->current_mask.count() == 1U << aggr_idx);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   srsenb::set_randseed(seed);
@@ -265,6 +309,7 @@ int main()
   TESTASSERT(test_pdcch_one_ue() == SRSRAN_SUCCESS);
   TESTASSERT(test_pdcch_ue_and_sibs() == SRSRAN_SUCCESS);
   TESTASSERT(test_6prbs() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcch_many_ues() == SRSRAN_SUCCESS);
 
   srslog::flush();
 
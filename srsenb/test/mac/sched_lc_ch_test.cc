@@ -197,6 +197,109 @@ int test_lc_ch_pbr_finite()
   return SRSRAN_SUCCESS;
 }
 
+int test_lc_ch_gbr_mbr()
+{
+  srsenb::lch_ue_manager          lch_handler{0x46};
+  sched_interface::dl_sched_pdu_t pdu;
+
+  srsenb::sched_interface::ue_cfg_t ue_cfg                     = generate_default_ue_cfg();
+  ue_cfg                                                       = generate_setup_ue_cfg(ue_cfg);
+  ue_cfg.ue_bearers[srb_to_lcid((lte_srb::srb1))]              = {};
+  ue_cfg.ue_bearers[srb_to_lcid((lte_srb::srb1))].direction    = mac_lc_ch_cfg_t::BOTH;
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb1))]              = {};
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb1))].direction    = mac_lc_ch_cfg_t::BOTH;
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb1))].priority     = 3;
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb2))]              = {};
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb2))].direction    = mac_lc_ch_cfg_t::BOTH;
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb2))].priority     = 5;
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb2))].bsd          = 50;  // msec
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb2))].gbr_dl       = 100; // kBps
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb2))].mbr_dl       = 200; // kBps
+  ue_cfg.ue_bearers[drb_to_lcid((lte_drb::drb2))].delay_budget = 100; // msec
+  lch_handler.set_cfg(ue_cfg);
+
+  lch_handler.dl_buffer_state(drb_to_lcid(lte_drb::drb1), 5000, 0);
+  lch_handler.dl_buffer_state(drb_to_lcid(lte_drb::drb2), 50000, 0);
+  for (uint32_t i = 0; i < 10; ++i) {
+    lch_handler.new_tti();
+  }
+  // DRB2 GBR tokens=1000 out of a bucket of 5000, and it waited 10 msec of its 100 msec delay budget
+  TESTASSERT(std::abs(lch_handler.get_dl_qos_urgency() - 0.2) < 1e-3);
+
+  // TEST1 - DRB2 has lower prio than DRB1, but it is below its GBR
+  TESTASSERT(test_pdu_alloc_successful(lch_handler, pdu, drb_to_lcid(lte_drb::drb2), 1000) == SRSRAN_SUCCESS);
+
+  // TEST2 - Once the GBR is met, DRB1 is served first
+  int nof_pending_bytes = lch_handler.get_dl_tx(drb_to_lcid(lte_drb::drb1));
+  TESTASSERT(test_newtx_until_empty(lch_handler, drb_to_lcid(lte_drb::drb1), 500) == nof_pending_bytes);
+
+  // TEST3 - DRB2 cannot exceed its MBR bucket (10000 bytes, 1000 already consumed)
+  TESTASSERT(lch_handler.get_dl_tx_mbr_limited(drb_to_lcid(lte_drb::drb2)) == 9000);
+  TESTASSERT(lch_handler.alloc_rlc_pdu(&pdu, 20000) == (int)add_rlc_overhead(drb_to_lcid(lte_drb::drb2), 9000));
+  TESTASSERT(lch_handler.get_dl_tx(drb_to_lcid(lte_drb::drb2)) == 40000);
+  TESTASSERT(lch_handler.get_max_prio_lcid() < 0);
+  TESTASSERT(not lch_handler.has_pending_dl_txs());
+
+  // TEST4 - A new TTI refills the MBR bucket with 200 bytes
+  lch_handler.new_tti();
+  TESTASSERT(test_pdu_alloc_successful(lch_handler, pdu, drb_to_lcid(lte_drb::drb2), 200) == SRSRAN_SUCCESS);
+  TESTASSERT(not lch_handler.has_pending_dl_txs());
+
+  // TEST5 - The urgency vanishes once the bearer has no data
+  lch_handler.dl_buffer_state(drb_to_lcid(lte_drb::drb2), 0, 0);
+  lch_handler.new_tti();
+  TESTASSERT(lch_handler.get_dl_qos_urgency() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_ul_presched_predictor()
+{
+  const uint32_t        rx_window = 8, period = 20, burst = 40;
+  ul_presched_predictor predictor{rx_window};
+  predictor.set_cfg(100, 2);
+  auto run = [&predictor](uint32_t nof_slots) {
+    for (uint32_t i = 0; i < nof_slots; ++i) {
+      TESTASSERT(predictor.get_presched_bytes() == 0);
+      predictor.new_slot();
+    }
+    return SRSRAN_SUCCESS;
+  };
+
+  // TEST1 - The period is confirmed after four periodic bursts reported by the UE via SR/BSR
+  for (uint32_t i = 0; i < 3; ++i) {
+    predictor.ul_data_rx(burst);
+    TESTASSERT(not predictor.is_armed());
+    TESTASSERT(run(period) == SRSRAN_SUCCESS);
+  }
+  predictor.ul_data_rx(burst);
+  TESTASSERT(predictor.is_armed());
+
+  // TEST2 - The proactive grant is due one period after the last burst, minus the PUSCH reception delay
+  TESTASSERT(run(period - rx_window) == SRSRAN_SUCCESS);
+  TESTASSERT(predictor.get_presched_bytes() == burst);
+  predictor.ul_newtx_alloc();
+
+  // TEST3 - The UE uses the grant, so the next one is probed one slot earlier
+  TESTASSERT(run(rx_window - 2) == SRSRAN_SUCCESS);
+  predictor.ul_data_rx(burst);
+  TESTASSERT(run(period - rx_window + 1) == SRSRAN_SUCCESS);
+  TESTASSERT(predictor.get_presched_bytes() == burst);
+  predictor.ul_newtx_alloc();
+
+  // TEST4 - The unused grants are delayed, and the pre-scheduling backs off after max_misses
+  TESTASSERT(run(rx_window + 1) == SRSRAN_SUCCESS);
+  TESTASSERT(predictor.is_armed());
+  TESTASSERT(run(period - rx_window + 1) == SRSRAN_SUCCESS);
+  TESTASSERT(predictor.get_presched_bytes() == burst);
+  predictor.ul_newtx_alloc();
+  TESTASSERT(run(rx_window + 1) == SRSRAN_SUCCESS);
+  TESTASSERT(not predictor.is_armed());
+  TESTASSERT(run(2 * period) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   srsenb::set_randseed(seed);
@@ -210,6 +313,8 @@ int main()
 
   TESTASSERT(test_lc_ch_pbr_infinity() == SRSRAN_SUCCESS);
   TESTASSERT(test_lc_ch_pbr_finite() == SRSRAN_SUCCESS);
+  TESTASSERT(test_lc_ch_gbr_mbr() == SRSRAN_SUCCESS);
+  TESTASSERT(test_ul_presched_predictor() == SRSRAN_SUCCESS);
 
   srslog::flush();
 
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "sched_test_common.h"
+#include "sched_test_utils.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/sched_recorder.h"
+#include "srsran/common/test_common.h"
+#include <cstdio>
+
+using namespace srsenb;
+
+uint32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+
+namespace {
+
+/// Simulator of a random UL/DL workload, whose calls to the scheduler are recorded
+class recorded_workload : public sched_sim_base
+{
+public:
+  using sched_sim_base::sched_sim_base;
+
+  void set_external_tti_events(const sim_ue_ctxt_t& ue_ctxt, ue_tti_events& pending_events) override
+  {
+    if (not ue_ctxt.conres_rx) {
+      return;
+    }
+    std::uniform_int_distribution<uint32_t> bytes_dist{0, 50000}, cqi_dist{5, 15};
+    if (randf() < 0.2) {
+      get_sched()->dl_rlc_buffer_state(ue_ctxt.rnti, 3, bytes_dist(get_rand_gen()), 0);
+    }
+    if (randf() < 0.2) {
+      get_sched()->ul_bsr(ue_ctxt.rnti, 1, bytes_dist(get_rand_gen()));
+    }
+    if (randf() < 0.1) {
+      get_sched()->dl_cqi_info(get_tti_rx().to_uint(), ue_ctxt.rnti, 0, cqi_dist(get_rand_gen()));
+    }
+  }
+};
+
+struct live_digests {
+  uint64_t dl = sched_digest_init;
+  uint64_t ul = sched_digest_init;
+};
+
+} // namespace
+
+int record_workload(const std::string& filename, live_digests& digests)
+{
+  sched_interface::sched_args_t           sched_args{};
+  std::vector<sched_interface::cell_cfg_t> cell_list{generate_default_cell_cfg(25)};
+  sched_interface::ue_cfg_t               ue_cfg = generate_default_ue_cfg();
+  rrc_dummy                               rrc;
+
+  sched sched_obj;
+  sched_obj.init(&rrc, sched_args);
+  sched_recorder recorder(sched_obj);
+  TESTASSERT(recorder.open(filename));
+
+  recorded_workload sim(&recorder, sched_args, cell_list);
+  dl_sched_res_list dl_result(cell_list.size());
+  ul_sched_res_list ul_result(cell_list.size());
+
+  uint16_t next_rnti = 0x46;
+  for (uint32_t count = 0; count < 2000; ++count) {
+    tti_point tti_rx = sim.get_tti_rx().is_valid() ? sim.get_tti_rx() + 1 : tti_point(0);
+    sim.new_tti(tti_rx);
+
+    // Add a few users, in PRACH TTIs
+    if (next_rnti < 0x46 + 4 and
+        srsran_prach_tti_opportunity_config_fdd(cell_list[0].prach_config, tti_rx.to_uint(), -1)) {
+      TESTASSERT(sim.add_user(next_rnti++, ue_cfg, 16) == SRSRAN_SUCCESS);
+    }
+
+    TESTASSERT(recorder.dl_sched(to_tx_dl(tti_rx).to_uint(), 0, dl_result[0]) == SRSRAN_SUCCESS);
+    TESTASSERT(recorder.ul_sched(to_tx_ul(tti_rx).to_uint(), 0, ul_result[0]) == SRSRAN_SUCCESS);
+    sched_result_digest(digests.dl, dl_result[0]);
+    sched_result_digest(digests.ul, ul_result[0]);
+
+    sf_output_res_t sf_out{sim.get_cell_params(), tti_rx, ul_result, dl_result};
+    sim.update(sf_out);
+  }
+  recorder.close();
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_replay(const std::string& filename, const live_digests& digests)
+{
+  sched_interface::sched_args_t sched_args{};
+  rrc_dummy                     rrc;
+
+  // Two replays must decide exactly as the live scheduler did
+  for (uint32_t i = 0; i < 2; ++i) {
+    sched sched_obj;
+    sched_obj.init(&rrc, sched_args);
+    sched_replay_stats_t stats;
+    TESTASSERT(sched_replay(filename, sched_obj, stats) == SRSRAN_SUCCESS);
+    TESTASSERT(stats.nof_dl_sched == 2000 and stats.nof_ul_sched == 2000);
+    TESTASSERT(stats.nof_calls > stats.nof_dl_sched + stats.nof_ul_sched);
+    TESTASSERT(stats.dl_digest == digests.dl);
+    TESTASSERT(stats.ul_digest == digests.ul);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_truncated_replay(const std::string& filename, const std::string& truncated_filename)
+{
+  FILE* in = fopen(filename.c_str(), "rb");
+  TESTASSERT(in != nullptr);
+  fseek(in, 0, SEEK_END);
+  long len = ftell(in);
+  fseek(in, 0, SEEK_SET);
+  std::vector<uint8_t> data(len);
+  TESTASSERT(fread(data.data(), len, 1, in) == 1);
+  fclose(in);
+
+  FILE* out = fopen(truncated_filename.c_str(), "wb");
+  TESTASSERT(out != nullptr);
+  TESTASSERT(fwrite(data.data(), len - 3, 1, out) == 1);
+  fclose(out);
+
+  sched_interface::sched_args_t sched_args{};
+  rrc_dummy                     rrc;
+  sched                         sched_obj;
+  sched_obj.init(&rrc, sched_args);
+  sched_replay_stats_t stats;
+  TESTASSERT(sched_replay(truncated_filename, sched_obj, stats) == SRSRAN_ERROR);
+
+  // Not a recording
+  data[0] ^= 0xffu;
+  out = fopen(truncated_filename.c_str(), "wb");
+  TESTASSERT(out != nullptr);
+  TESTASSERT(fwrite(data.data(), len, 1, out) == 1);
+  fclose(out);
+  sched sched_obj2;
+  sched_obj2.init(&rrc, sched_args);
+  TESTASSERT(sched_replay(truncated_filename, sched_obj2, stats) == SRSRAN_ERROR);
+  TESTASSERT(stats.nof_calls == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srsenb::set_randseed(seed);
+  srsran::console("This is the chosen seed: %u\n", seed);
+
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::none);
+  auto& test_log = srslog::fetch_basic_logger("TEST", false);
+  test_log.set_level(srslog::basic_levels::warning);
+
+  // Start the log backend.
+  srslog::init();
+
+  std::string filename           = "sched_recorder_test.rec";
+  std::string truncated_filename = "sched_recorder_test_truncated.rec";
+
+  live_digests digests;
+  TESTASSERT(record_workload(filename, digests) == SRSRAN_SUCCESS);
+  TESTASSERT(test_replay(filename, digests) == SRSRAN_SUCCESS);
+  TESTASSERT(test_truncated_replay(filename, truncated_filename) == SRSRAN_SUCCESS);
+  remove(filename.c_str());
+  remove(truncated_filename.c_str());
+
+  srslog::flush();
+
+  srsran::console("Success\n");
+}
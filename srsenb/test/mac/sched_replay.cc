@@ -0,0 +1,93 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+/**
+ * Replays a recording of the scheduler inputs, made with the [pcap] sched_filename option of the eNB, into a fresh
+ * scheduler. The digests of the scheduling decisions tell whether two scheduler builds or configurations decide alike
+ * for the same workload, and the time spent in dl_sched()/ul_sched() profiles them.
+ */
+
+#include "sched_test_common.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/sched_recorder.h"
+#include <boost/program_options.hpp>
+
+namespace bpo = boost::program_options;
+
+int main(int argc, char* argv[])
+{
+  std::string                           filename;
+  srsenb::sched_interface::sched_args_t sched_args;
+
+  bpo::options_description options("Scheduler replay options");
+
+  // clang-format off
+  options.add_options()
+      ("file",              bpo::value<std::string>(&filename), "Recording of the scheduler inputs")
+      ("sched_policy",      bpo::value<std::string>(&sched_args.sched_policy)->default_value(sched_args.sched_policy), "Scheduler policy: time_rr, time_pf, freq_pf, time_qos")
+      ("sched_policy_args", bpo::value<std::string>(&sched_args.sched_policy_args)->default_value(sched_args.sched_policy_args), "Scheduler policy arguments")
+      ("pdsch_mcs",         bpo::value<int>(&sched_args.pdsch_mcs)->default_value(sched_args.pdsch_mcs), "Fixed PDSCH MCS (-1 for dynamic)")
+      ("pusch_mcs",         bpo::value<int>(&sched_args.pusch_mcs)->default_value(sched_args.pusch_mcs), "Fixed PUSCH MCS (-1 for dynamic)")
+      ("help",              "Show this message")
+      ;
+  // clang-format on
+
+  bpo::positional_options_description p;
+  p.add("file", 1);
+
+  bpo::variables_map vm;
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv).options(options).positional(p).run(), vm);
+    bpo::notify(vm);
+  } catch (bpo::error& e) {
+    fmt::print("{}\n", e.what());
+    return SRSRAN_ERROR;
+  }
+
+  if (vm.count("help") or filename.empty()) {
+    fmt::print("Usage: {} FILE [OPTIONS]\n\n{}\n", argv[0], options);
+    return vm.count("help") ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+  }
+
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::warning);
+
+  // Start the log backend.
+  srslog::init();
+
+  srsenb::rrc_dummy rrc;
+  srsenb::sched     sched_obj;
+  sched_obj.init(&rrc, sched_args);
+
+  srsenb::sched_replay_stats_t stats;
+  int                          ret = srsenb::sched_replay(filename, sched_obj, stats);
+  srslog::flush();
+
+  uint32_t nof_ttis = std::max(stats.nof_dl_sched, stats.nof_ul_sched);
+  fmt::print("calls: {}, DL/UL sched calls: {}/{}\n", stats.nof_calls, stats.nof_dl_sched, stats.nof_ul_sched);
+  fmt::print("sched time: {:.3f} msec, {:.2f} usec per TTI\n",
+             stats.sched_time.count() / 1e6,
+             nof_ttis > 0 ? stats.sched_time.count() / 1e3 / nof_ttis : 0.0);
+  fmt::print("DL/UL digest: {:016x}/{:016x}\n", stats.dl_digest, stats.ul_digest);
+
+  return ret;
+}
@@ -89,11 +89,12 @@ void ue_sim::update_dl_harqs(const sf_output_res_t& sf_out)
   for (uint32_t cc = 0; cc < sf_out.cc_params.size(); ++cc) {
     for (uint32_t i = 0; i < sf_out.dl_cc_result[cc].data.size(); ++i) {
       const auto& data = sf_out.dl_cc_result[cc].data[i];
-      if (data.dci.rnti != ctxt.rnti) {
+      if (data.dci.rnti != ctxt.rnti or data.no_pdsch) {
+        // The SPS releases do not use a DL HARQ
         continue;
       }
       auto& h = ctxt.cc_list[data.dci.ue_cc_idx].dl_harqs[data.dci.pid];
-      if (h.nof_txs == 0 or h.ndi != data.dci.tb[0].ndi) {
+      if (h.is_newtx(data.dci.tb[0].ndi, data.sps_crnti)) {
         // It is newtx
         h.nof_retxs    = 0;
         h.ndi          = data.dci.tb[0].ndi;
@@ -105,6 +106,7 @@ void ue_sim::update_dl_harqs(const sf_output_res_t& sf_out)
         h.nof_retxs++;
       }
       h.active      = true;
+      h.is_sps      = data.sps_crnti != SRSRAN_INVALID_RNTI;
       h.last_tti_rx = sf_out.tti_rx;
       h.nof_txs++;
     }
@@ -154,7 +156,7 @@ void ue_sim::update_ul_harqs(const sf_output_res_t& sf_out)
       }
       pusch_found = true;
 
-      if (h.nof_txs == 0 or h.ndi != data.dci.tb.ndi) {
+      if (h.is_newtx(data.dci.tb.ndi, data.sps_crnti)) {
         // newtx
         h.nof_retxs    = 0;
         h.ndi          = data.dci.tb.ndi;
@@ -164,6 +166,7 @@ void ue_sim::update_ul_harqs(const sf_output_res_t& sf_out)
         h.nof_retxs++;
       }
       h.active      = true;
+      h.is_sps      = data.sps_crnti != SRSRAN_INVALID_RNTI;
       h.last_tti_rx = sf_out.tti_rx;
       h.riv         = data.dci.type2_alloc.riv;
       h.nof_txs++;
@@ -39,7 +39,18 @@ struct ue_harq_ctxt_t {
   uint32_t              riv       = 0;
   srsran_dci_location_t dci_loc   = {};
   uint32_t              tbs       = 0;
+  bool                  is_sps    = false;
   srsran::tti_point     last_tti_rx, first_tti_rx;
+
+  /// With the SPS C-RNTI, NDI=0 signals a newtx and NDI=1 a retx. The NDI is considered toggled after an SPS tx
+  /// (TS 36.321 Section 5.3.1)
+  bool is_newtx(bool new_ndi, uint16_t sps_crnti) const
+  {
+    if (sps_crnti != SRSRAN_INVALID_RNTI) {
+      return not new_ndi;
+    }
+    return nof_txs == 0 or ndi != new_ndi or is_sps;
+  }
 };
 struct ue_cc_ctxt_t {
   std::array<ue_harq_ctxt_t, SRSRAN_FDD_NOF_HARQ> dl_harqs;
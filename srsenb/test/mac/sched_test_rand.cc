@@ -169,7 +169,11 @@ int sched_tester::test_harqs()
 {
   /* check consistency of DL harq procedures and allocations */
   for (uint32_t i = 0; i < tti_info.dl_sched_result[CARRIER_IDX].data.size(); ++i) {
-    const auto&                 data = tti_info.dl_sched_result[CARRIER_IDX].data[i];
+    const auto& data = tti_info.dl_sched_result[CARRIER_IDX].data[i];
+    if (data.no_pdsch) {
+      // SPS releases do not use a DL HARQ
+      continue;
+    }
     uint32_t                    h_id = data.dci.pid;
     uint16_t                    rnti = data.dci.rnti;
     const srsenb::dl_harq_proc& h    = ue_db[rnti]->get_dl_harq(h_id, CARRIER_IDX);
@@ -226,6 +230,9 @@ int sched_tester::update_ue_stats()
   srsran::bounded_bitset<100, true> alloc_mask(sched_cell_params[CARRIER_IDX].cfg.cell.nof_prb);
   for (uint32_t i = 0; i < tti_info.dl_sched_result[CARRIER_IDX].data.size(); ++i) {
     auto& data = tti_info.dl_sched_result[CARRIER_IDX].data[i];
+    if (data.no_pdsch) {
+      continue;
+    }
     TESTASSERT(srsenb::extract_dl_prbmask(sched_cell_params[CARRIER_IDX].cfg.cell,
                                           tti_info.dl_sched_result[CARRIER_IDX].data[i].dci,
                                           alloc_mask) == SRSRAN_SUCCESS);
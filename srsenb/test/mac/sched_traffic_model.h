@@ -0,0 +1,229 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_TRAFFIC_MODEL_H
+#define SRSRAN_SCHED_TRAFFIC_MODEL_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Traffic, channel and latency helpers shared by the LTE and NR scheduler benchmarks
+ */
+
+namespace srsenb {
+
+enum class sched_traffic_type { full_buffer, voip, web };
+
+inline bool parse_sched_traffic_type(const std::string& str, sched_traffic_type& type)
+{
+  if (str == "full_buffer") {
+    type = sched_traffic_type::full_buffer;
+  } else if (str == "voip") {
+    type = sched_traffic_type::voip;
+  } else if (str == "web") {
+    type = sched_traffic_type::web;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+inline const char* to_string(sched_traffic_type type)
+{
+  switch (type) {
+    case sched_traffic_type::full_buffer:
+      return "full_buffer";
+    case sched_traffic_type::voip:
+      return "voip";
+    case sched_traffic_type::web:
+      return "web";
+  }
+  return "invalid";
+}
+
+/// Per-UE generator of the bytes arriving at the RLC of the DL and at the UE UL buffers every TTI/slot
+class sched_traffic_source
+{
+public:
+  /// Full buffer UEs are refilled to this value instead of following an arrival process
+  static const uint32_t full_buffer_bytes = 100000;
+
+  sched_traffic_source(sched_traffic_type type_, uint32_t seed) : type(type_), rgen(seed)
+  {
+    // Desynchronize the UEs so that the VoIP frames and the web pages do not arrive in the same TTI
+    voip_phase    = std::uniform_int_distribution<uint32_t>{0, voip_period - 1}(rgen);
+    next_web_page = std::uniform_int_distribution<uint32_t>{0, web_mean_reading_time}(rgen);
+  }
+
+  bool is_full_buffer() const { return type == sched_traffic_type::full_buffer; }
+
+  /// Computes the new DL and UL bytes of TTI/slot "count". Full buffer sources return zero arrivals
+  void step(uint32_t count, uint32_t& dl_bytes, uint32_t& ul_bytes)
+  {
+    dl_bytes = 0;
+    ul_bytes = 0;
+    switch (type) {
+      case sched_traffic_type::full_buffer:
+        break;
+      case sched_traffic_type::voip:
+        // AMR 12.2 with ROHC: talk spurts with one frame every 20 ms, and one SID frame every 160 ms while silent
+        if (count >= next_voip_toggle) {
+          voip_talking     = not voip_talking;
+          next_voip_toggle = count + exp_sample(voip_talking ? voip_mean_talk_time : voip_mean_silence_time);
+        }
+        if (voip_talking and (count + voip_phase) % voip_period == 0) {
+          dl_bytes = voip_frame_bytes;
+          ul_bytes = voip_frame_bytes;
+        } else if (not voip_talking and (count + voip_phase) % voip_sid_period == 0) {
+          dl_bytes = voip_sid_bytes;
+          ul_bytes = voip_sid_bytes;
+        }
+        break;
+      case sched_traffic_type::web:
+        // A page with truncated Pareto size is requested after an exponential reading time
+        if (count >= next_web_page) {
+          dl_bytes      = pareto_sample(web_min_page_bytes, web_max_page_bytes, web_pareto_alpha);
+          ul_bytes      = web_request_bytes;
+          next_web_page = count + exp_sample(web_mean_reading_time);
+        }
+        break;
+    }
+  }
+
+private:
+  static const uint32_t voip_period            = 20;
+  static const uint32_t voip_sid_period        = 160;
+  static const uint32_t voip_frame_bytes       = 40;
+  static const uint32_t voip_sid_bytes         = 15;
+  static const uint32_t voip_mean_talk_time    = 1000;
+  static const uint32_t voip_mean_silence_time = 1350;
+  static const uint32_t web_mean_reading_time  = 1000;
+  static const uint32_t web_min_page_bytes     = 4500;
+  static const uint32_t web_max_page_bytes     = 2000000;
+  static const uint32_t web_request_bytes      = 350;
+  static constexpr float web_pareto_alpha      = 1.1;
+
+  uint32_t exp_sample(uint32_t mean)
+  {
+    return 1 + static_cast<uint32_t>(std::exponential_distribution<float>{1.0F / mean}(rgen));
+  }
+  uint32_t pareto_sample(uint32_t min_val, uint32_t max_val, float alpha)
+  {
+    float u = std::uniform_real_distribution<float>{0.0F, 1.0F}(rgen);
+    float x = min_val / std::pow(1.0F - u, 1.0F / alpha);
+    return std::min(static_cast<uint32_t>(x), max_val);
+  }
+
+  sched_traffic_type         type;
+  std::default_random_engine rgen;
+  uint32_t                   voip_phase       = 0;
+  bool                       voip_talking     = false;
+  uint32_t                   next_voip_toggle = 0;
+  uint32_t                   next_web_page    = 0;
+};
+
+/// CQI seen by each UE. Without a trace all UEs report the fixed CQI, otherwise each UE reads the trace from its own
+/// offset, so that a single trace generates decorrelated channels
+class sched_cqi_trace
+{
+public:
+  explicit sched_cqi_trace(uint32_t fixed_cqi_ = 15) : fixed_cqi(fixed_cqi_) {}
+
+  /// Loads a trace of whitespace separated CQIs, one per TTI/slot. Returns false if the file is empty or unreadable
+  bool load(const std::string& filename)
+  {
+    std::ifstream f(filename);
+    uint32_t      cqi;
+    trace.clear();
+    while (f >> cqi) {
+      trace.push_back(std::min(cqi, 15U));
+    }
+    return not trace.empty();
+  }
+
+  bool     empty() const { return trace.empty(); }
+  uint32_t get_cqi(uint32_t ue_idx, uint32_t count) const
+  {
+    if (trace.empty()) {
+      return fixed_cqi;
+    }
+    return trace[(count + ue_idx * ue_trace_stride) % trace.size()];
+  }
+
+private:
+  static const uint32_t ue_trace_stride = 997;
+
+  uint32_t              fixed_cqi;
+  std::vector<uint32_t> trace;
+};
+
+/// Collects the scheduling time of every TTI/slot to report its percentiles
+class sched_latency_stats
+{
+public:
+  void reserve(size_t n) { samples.reserve(n); }
+  void push(uint64_t ns)
+  {
+    samples.push_back(ns);
+    sorted = false;
+  }
+  size_t size() const { return samples.size(); }
+
+  double mean_usec() const
+  {
+    if (samples.empty()) {
+      return 0;
+    }
+    double sum = 0;
+    for (uint64_t s : samples) {
+      sum += s;
+    }
+    return sum / samples.size() / 1000.0;
+  }
+
+  /// Percentile q in [0, 1] of the samples, in microseconds
+  double percentile_usec(double q)
+  {
+    if (samples.empty()) {
+      return 0;
+    }
+    if (not sorted) {
+      std::sort(samples.begin(), samples.end());
+      sorted = true;
+    }
+    size_t idx = std::min(static_cast<size_t>(q * samples.size()), samples.size() - 1);
+    return samples[idx] / 1000.0;
+  }
+
+private:
+  std::vector<uint64_t> samples;
+  bool                  sorted = true;
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_TRAFFIC_MODEL_H
@@ -87,13 +87,24 @@ int test_pdsch_grant(const sim_enb_ctxt_t&                   enb_ctxt,
   CONDERROR(pdsch.dci.ue_cc_idx != (uint32_t)std::distance(&ue_ctxt.ue_cfg.supported_cc_list.front(), cc_cfg),
             "Inconsistent enb_cc_idx -> ue_cc_idx mapping");
 
+  // TEST: SPS releases are signalled with the SPS C-RNTI, and do not carry a PDSCH
+  bool is_sps = pdsch.sps_crnti != SRSRAN_INVALID_RNTI;
+  if (pdsch.no_pdsch) {
+    CONDERROR(not is_sps or pdsch.no_pdcch, "DL SPS release must be signalled in the PDCCH with the SPS C-RNTI");
+    CONDERROR(pdsch.dci.tb[0].mcs_idx != 31, "Invalid MCS for DL SPS release");
+    return SRSRAN_SUCCESS;
+  }
+  CONDERROR(pdsch.no_pdcch and not is_sps, "Only the DL SPS occasions can skip the PDCCH");
+
   // TEST: DCI is consistent with current UE DL harq state
   auto&    h        = ue_ctxt.cc_list[pdsch.dci.ue_cc_idx].dl_harqs[pdsch.dci.pid];
   uint32_t nof_retx = get_nof_retx(pdsch.dci.tb[0].rv); // 0..3
-  if (h.nof_txs == 0 or h.ndi != pdsch.dci.tb[0].ndi) {
+  bool     is_newtx = h.is_newtx(pdsch.dci.tb[0].ndi, pdsch.sps_crnti);
+  if (is_newtx) {
     // It is newtx
     CONDERROR(nof_retx != 0, "Invalid rv index for new DL tx");
-    CONDERROR(h.active, "DL newtx for already active DL harq pid=%d", h.pid);
+    // SPS occasions flush the HARQ
+    CONDERROR(h.active and not is_sps, "DL newtx for already active DL harq pid=%d", h.pid);
   } else {
     // it is retx
     CONDERROR(get_rvidx(h.nof_retxs + 1) != (uint32_t)pdsch.dci.tb[0].rv, "Invalid rv index for retx");
@@ -108,7 +119,7 @@ int test_pdsch_grant(const sim_enb_ctxt_t&                   enb_ctxt,
   }
 
   // TEST: max coderate is not exceeded
-  if (h.nof_txs == 0 or h.ndi != pdsch.dci.tb[0].ndi) {
+  if (is_newtx) {
     // it is newtx
     srsran_pdsch_grant_t grant = {};
     srsran_dl_sf_cfg_t   dl_sf = {};
@@ -123,8 +134,8 @@ int test_pdsch_grant(const sim_enb_ctxt_t&                   enb_ctxt,
     CONDERROR(coderate > 0.932f * Qm, "Max coderate was exceeded");
   }
 
-  // TEST: PUCCH-ACK will not collide with SR
-  CONDERROR(not has_pusch_grant and is_pucch_sr_collision(ue_ctxt.ue_cfg.pucch_cfg,
+  // TEST: PUCCH-ACK will not collide with SR. The SPS occasions use the persistent PUCCH resource
+  CONDERROR(not has_pusch_grant and not pdsch.no_pdcch and is_pucch_sr_collision(ue_ctxt.ue_cfg.pucch_cfg,
                                                           to_tx_dl_ack(sf_out.tti_rx),
                                                           pdsch.dci.location.ncce + cell_params.cfg.n1pucch_an),
             "Collision detected between UE PUCCH-ACK and SR");
@@ -232,13 +243,16 @@ int test_ul_sched_result(const sim_enb_ctxt_t& enb_ctxt, const sf_output_res_t&
         // TEST: DCI is consistent with current UE UL harq state
         uint32_t nof_retx = get_nof_retx(pusch_ptr->dci.tb.rv); // 0..3
 
-        if (h.nof_txs == 0 or h.ndi != pusch_ptr->dci.tb.ndi) {
+        bool is_sps = pusch_ptr->sps_crnti != SRSRAN_INVALID_RNTI;
+        if (h.is_newtx(pusch_ptr->dci.tb.ndi, pusch_ptr->sps_crnti)) {
           // newtx
           CONDERROR(nof_retx != 0, "Invalid rv index for new UL tx");
           CONDERROR(pusch_ptr->current_tx_nb != 0, "UL HARQ retxs need to have been previously transmitted");
-          CONDERROR(not h_cleared, "New tx for already active UL HARQ");
-          CONDERROR(not pusch_ptr->needs_pdcch and ue.msg3_tti_rx.is_valid() and sf_out.tti_rx > ue.msg3_tti_rx,
-                    "In case of newtx, PDCCH allocation is required, unless it is Msg3");
+          // SPS occasions flush the HARQ
+          CONDERROR(not h_cleared and not is_sps, "New tx for already active UL HARQ");
+          CONDERROR(not pusch_ptr->needs_pdcch and not is_sps and ue.msg3_tti_rx.is_valid() and
+                        sf_out.tti_rx > ue.msg3_tti_rx,
+                    "In case of newtx, PDCCH allocation is required, unless it is Msg3 or an SPS occasion");
         } else {
           CONDERROR(pusch_ptr->current_tx_nb == 0, "UL retx has to have nof tx > 0");
           CONDERROR(h.nof_retxs >= max_nof_retxs, "UL max nof retxs exceeded");
@@ -51,7 +51,48 @@ void test_paging()
   }
 }
 
+void test_paging_record_aggregation()
+{
+  unsigned       paging_cycle = 32;
+  paging_manager pcch_manager{paging_cycle, 1};
+
+  // All UEs with the same ueid map to the same PO
+  unsigned ue_id = 4780;
+  for (unsigned i = 0; i < ASN1_RRC_MAX_PAGE_REC; ++i) {
+    if (i % 3 == 0) {
+      uint8_t imsi[] = {0, 0, 1, 0, 1, (uint8_t)(i % 10), 2, 3, 4, 5, 6, 7, 8, 9, 0};
+      TESTASSERT(pcch_manager.add_imsi_paging(ue_id, imsi));
+    } else {
+      uint8_t m_tmsi[] = {0x64, 0x04, (uint8_t)(i * 7), (uint8_t)i};
+      TESTASSERT(pcch_manager.add_tmsi_paging(ue_id, i, m_tmsi));
+    }
+  }
+  uint8_t m_tmsi[] = {0x64, 0x04, 0x00, 0x02};
+  TESTASSERT(not pcch_manager.add_tmsi_paging(ue_id, 10, m_tmsi));
+
+  // The incrementally encoded PDU must match the encoding of the full message
+  tti_point t{(ue_id % paging_cycle) * 10 + 9};
+  TESTASSERT(pcch_manager.pending_pcch_bytes(t) > 0);
+  bool read = pcch_manager.read_pdu_pcch(
+      t, [](srsran::const_byte_span pdu, const asn1::rrc::pcch_msg_s& msg, bool is_first_tx) {
+        TESTASSERT_EQ(ASN1_RRC_MAX_PAGE_REC, msg.msg.c1().paging().paging_record_list.size());
+        uint8_t       buf[256];
+        asn1::bit_ref bref(buf, sizeof(buf));
+        TESTASSERT(msg.pack(bref) == asn1::SRSASN_SUCCESS);
+        TESTASSERT_EQ((size_t)bref.distance_bytes(), pdu.size());
+        TESTASSERT(std::equal(pdu.begin(), pdu.end(), buf));
+
+        asn1::rrc::pcch_msg_s unpacked;
+        asn1::cbit_ref        cbref(pdu.data(), pdu.size());
+        TESTASSERT(unpacked.unpack(cbref) == asn1::SRSASN_SUCCESS);
+        TESTASSERT_EQ(ASN1_RRC_MAX_PAGE_REC, unpacked.msg.c1().paging().paging_record_list.size());
+        return true;
+      });
+  TESTASSERT(read);
+}
+
 int main()
 {
   test_paging();
+  test_paging_record_aggregation();
 }
\ No newline at end of file
@@ -45,14 +45,18 @@ public:
     last_rnti          = rnti;
     last_eps_bearer_id = eps_bearer_id;
   }
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t eps_bearer_id) override
+  std::vector<srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t eps_bearer_id) override
   {
     return std::move(buffered_pdus);
   }
   void send_status_report(uint16_t rnti) override {}
   void send_status_report(uint16_t rnti, uint32_t eps_bearer_id) override {}
 
-  void push_buffered_pdu(uint32_t sn, srsran::unique_byte_buffer_t pdu) { buffered_pdus[sn] = std::move(pdu); }
+  void push_buffered_pdu(uint32_t sn, srsran::unique_byte_buffer_t pdu)
+  {
+    pdu->md.pdcp_sn = sn;
+    buffered_pdus.push_back(std::move(pdu));
+  }
 
   void clear()
   {
@@ -62,7 +66,7 @@ public:
     last_rnti          = SRSRAN_INVALID_RNTI;
   }
 
-  std::map<uint32_t, srsran::unique_byte_buffer_t> buffered_pdus;
+  std::vector<srsran::unique_byte_buffer_t> buffered_pdus;
   srsran::unique_byte_buffer_t                     last_sdu;
   int                                              last_pdcp_sn       = -1;
   uint16_t                                         last_rnti          = SRSRAN_INVALID_RNTI;
@@ -215,6 +219,63 @@ void test_gtpu_tunnel_manager()
   TESTASSERT(after_tun->state == gtpu_tunnel_manager::tunnel_state::pdcp_active);
 }
 
+int test_gtpu_ul_batch()
+{
+  const char *       enb_addr_str = "127.0.1.3", *sgw_addr_str = "127.0.1.4";
+  struct sockaddr_in sgw_sockaddr = {};
+  srsran::net_utils::set_sockaddr(&sgw_sockaddr, sgw_addr_str, GTPU_PORT);
+  uint32_t       sgw_addr       = ntohl(sgw_sockaddr.sin_addr.s_addr);
+  uint16_t       rnti           = 0x46;
+  uint32_t       drb1_bearer_id = 5;
+  uint32_t       sgw_teidout    = 3;
+  const uint32_t N_pdus         = 100;
+
+  srsran::task_scheduler task_sched;
+  dummy_socket_manager   enb_rx_sockets, sgw_rx_sockets;
+  srsenb::gtpu           enb_gtpu(&task_sched, srslog::fetch_basic_logger("GTPU1"), &enb_rx_sockets);
+  srsenb::gtpu           sgw_gtpu(&task_sched, srslog::fetch_basic_logger("GTPU2"), &sgw_rx_sockets);
+  pdcp_tester            enb_pdcp, sgw_pdcp;
+  gtpu_args_t            gtpu_args;
+  gtpu_args.gtp_bind_addr  = enb_addr_str;
+  gtpu_args.mme_addr       = sgw_addr_str;
+  gtpu_args.nof_rx_sockets = 2;
+  TESTASSERT(enb_gtpu.init(gtpu_args, &enb_pdcp) == SRSRAN_SUCCESS);
+  // The second GTPU entity only provides the socket of the SPGW
+  gtpu_args.gtp_bind_addr  = sgw_addr_str;
+  gtpu_args.nof_rx_sockets = 1;
+  TESTASSERT(sgw_gtpu.init(gtpu_args, &sgw_pdcp) == SRSRAN_SUCCESS);
+  uint32_t addr_in;
+  TESTASSERT(enb_gtpu.add_bearer(rnti, drb1_bearer_id, sgw_addr, sgw_teidout, addr_in).has_value());
+
+  // TEST: The UL PDUs are buffered until the flush
+  std::vector<uint8_t> data_vec(10);
+  for (uint32_t i = 0; i < N_pdus; ++i) {
+    std::fill(data_vec.begin(), data_vec.end(), i);
+    enb_gtpu.write_pdu(rnti, drb1_bearer_id, encode_ipv4_packet(data_vec, 0, sgw_sockaddr, sgw_sockaddr));
+  }
+  // The batch was flushed once when it got full
+  uint32_t nof_rx = 0;
+  uint8_t  rx_buf[128];
+  while (recv(sgw_rx_sockets.s1u_fd, rx_buf, sizeof(rx_buf), MSG_DONTWAIT) > 0) {
+    nof_rx++;
+  }
+  TESTASSERT(nof_rx > 0 and nof_rx < N_pdus);
+
+  // TEST: The flush sends the remaining PDUs in order
+  enb_gtpu.flush_ul_pdus();
+  for (; nof_rx < N_pdus; ++nof_rx) {
+    srsran::unique_byte_buffer_t pdu = read_socket(sgw_rx_sockets.s1u_fd);
+    srsran::gtpu_header_t        header;
+    TESTASSERT(srsran::gtpu_read_header(pdu.get(), &header, srslog::fetch_basic_logger("GTPU")));
+    TESTASSERT(header.teid == sgw_teidout);
+    TESTASSERT(pdu->N_bytes == PDU_HEADER_SIZE + data_vec.size());
+    TESTASSERT(pdu->msg[PDU_HEADER_SIZE] == nof_rx);
+  }
+  TESTASSERT(recv(sgw_rx_sockets.s1u_fd, rx_buf, sizeof(rx_buf), MSG_DONTWAIT) < 0);
+
+  return SRSRAN_SUCCESS;
+}
+
 enum class tunnel_test_event { success, wait_end_marker_timeout, ue_removal_no_marker, reest_senb };
 
 int test_gtpu_direct_tunneling(tunnel_test_event event)
@@ -394,6 +455,7 @@ int main(int argc, char** argv)
   srsran::test_init(argc, argv);
 
   srsenb::test_gtpu_tunnel_manager();
+  TESTASSERT(srsenb::test_gtpu_ul_batch() == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::success) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::wait_end_marker_timeout) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::ue_removal_no_marker) == SRSRAN_SUCCESS);
@@ -29,11 +29,13 @@
 #define SRSEPC_HSS_H
 
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/ssl.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
 
+#include <fstream>
 #include <map>
 
 #define LTE_FDD_ENB_IND_HE_N_BITS 5
@@ -67,9 +69,15 @@ struct hss_ue_ctx_t {
   std::string        static_ip_addr;
 
   // Helper getters/setters
-  void set_sqn(const uint8_t* sqn_);
-  void set_last_rand(const uint8_t* rand_);
-  void get_last_rand(uint8_t* rand_);
+  void         set_sqn(const uint8_t* sqn_);
+  void         set_last_rand(const uint8_t* rand_);
+  void         get_last_rand(uint8_t* rand_);
+  aes_context* get_key_schedule();
+
+private:
+  // AES round keys of K, expanded on the first Milenage authentication of this UE
+  aes_context key_sched;
+  bool        key_sched_init = false;
 };
 
 class hss : public hss_interface_nas
@@ -114,9 +122,17 @@ private:
   bool          write_db_file(std::string db_file);
   hss_ue_ctx_t* get_ue_ctx(uint64_t imsi);
 
+  // SQN updates are appended to a log next to the .csv and folded into it by compaction
+  bool replay_db_log();
+  bool compact_db_file();
+  void log_ue_sqn(hss_ue_ctx_t* ue_ctx);
+
   std::string hex_string(uint8_t* hex, int size);
 
-  std::string db_file;
+  std::string   db_file;
+  std::string   db_log_file;
+  std::ofstream m_db_log;
+  uint32_t      db_log_records = 0;
 
   /*Logs*/
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("HSS");
@@ -141,5 +157,15 @@ inline void hss_ue_ctx_t::get_last_rand(uint8_t* last_rand_)
 {
   memcpy(last_rand_, last_rand, 16);
 }
+
+inline aes_context* hss_ue_ctx_t::get_key_schedule()
+{
+  if (not key_sched_init) {
+    mbedtls_aes_init(&key_sched);
+    aes_setkey_enc(&key_sched, key, 128);
+    key_sched_init = true;
+  }
+  return &key_sched;
+}
 } // namespace srsepc
 #endif // SRSEPC_HSS_H
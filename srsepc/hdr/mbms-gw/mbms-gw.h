@@ -33,7 +33,10 @@
 #include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
+#include "srsran/upper/gtpu.h"
+#include <array>
 #include <cstddef>
+#include <vector>
 
 namespace srsepc {
 
@@ -47,6 +50,7 @@ typedef struct {
   std::string m1u_multi_addr;
   std::string m1u_multi_if;
   int         m1u_multi_ttl;
+  std::string m1u_unicast_addrs; // Comma separated list of eNBs that receive a unicast copy of the M1-U traffic
 } mbms_gw_args_t;
 
 struct pseudo_hdr {
@@ -74,7 +78,12 @@ private:
 
   int      init_sgi_mb_if(mbms_gw_args_t* args);
   int      init_m1_u(mbms_gw_args_t* args);
-  void     handle_sgi_md_pdu(srsran::byte_buffer_t* msg);
+  /// Maximum number of packets read from the SGi-mb interface per wake-up
+  static const uint32_t MAX_BATCH_SIZE = 32;
+  /// Read the pending packets of the SGi-mb interface, up to MAX_BATCH_SIZE, and send them to all the M1-U destinations
+  void handle_sgi_mb_pdus();
+  bool handle_sgi_md_pdu(srsran::byte_buffer_t* msg);
+  void send_m1u_pdus(uint32_t nof_pdus);
   uint16_t in_cksum(uint16_t* iphdr, int count);
 
   /* Members */
@@ -86,7 +95,13 @@ private:
 
   bool               m_m1u_up;
   int                m_m1u;
+  bool               m_m1u_gso = false;
   struct sockaddr_in m_m1u_multi_addr;
+
+  // Each packet is sent from the same buffer to the multicast group and to every unicast eNB
+  std::vector<sockaddr_in>                                 m_m1u_dst_addrs;
+  srsran::gtpu_gpdu_header_template_t                      m_gpdu_hdr = {};
+  std::array<srsran::unique_byte_buffer_t, MAX_BATCH_SIZE> m_sgi_mb_pdus;
 };
 
 } // namespace srsepc
@@ -33,6 +33,7 @@
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/threads.h"
 #include <cstddef>
+#include <unordered_map>
 
 namespace srsepc {
 
@@ -71,14 +72,19 @@ private:
   s1ap*       m_s1ap;
   mme_gtpc*   m_mme_gtpc;
 
-  bool   m_running;
-  fd_set m_set;
+  bool m_running;
+  int  m_epoll_fd = -1;
 
-  // Timer map
-  std::vector<mme_timer_t> timers;
+  // Timers, indexed by the tag of their epoll event and by IMSI and type. The tag holds the fd in the lower 32 bits
+  // and a sequence number in the upper 32 bits, so that a stale event of a reused fd is not taken as an expiration
+  std::unordered_map<uint64_t, mme_timer_t> timers;
+  std::unordered_map<uint64_t, uint64_t>    timer_tag_by_imsi;
+  uint32_t                                  timer_seq = 0;
 
   // Timer Methods
-  void handle_timer_expire(int timer_fd);
+  void     handle_timer_expire(uint64_t tag);
+  void     del_nas_timer(std::unordered_map<uint64_t, mme_timer_t>::iterator it);
+  uint64_t timer_key(enum nas_timer_type type, uint64_t imsi) { return (imsi << 4u) | (uint64_t)type; }
 
   // Logs
   srslog::basic_logger& m_s1ap_logger = srslog::fetch_basic_logger("S1AP");
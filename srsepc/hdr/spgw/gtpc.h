@@ -22,12 +22,12 @@
 #define SRSEPC_GTPC_H
 
 #include "srsepc/hdr/spgw/spgw.h"
+#include "srsran/adt/bounded_bitset.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 
-#include <set>
 #include <sys/socket.h>
 #include <sys/un.h>
 
@@ -48,6 +48,7 @@ public:
   uint64_t  get_new_ctrl_teid();
   uint64_t  get_new_user_teid();
   in_addr_t get_new_ue_ipv4(uint64_t imsi);
+  void      release_ue_ipv4(uint64_t imsi, in_addr_t ue_ipv4);
 
   void handle_s11_pdu(srsran::byte_buffer_t* msg);
   bool send_s11_pdu(const srsran::gtpc_pdu& pdu);
@@ -90,8 +91,11 @@ public:
   std::map<uint32_t, spgw_tunnel_ctx*> m_teid_to_tunnel_ctx; // Map control TEID to tunnel ctx. Usefull to get
                                                              // reply ctrl TEID, UE IP, etc.
 
-  std::set<uint32_t>                 m_ue_ip_addr_pool;
-  std::map<uint64_t, struct in_addr> m_imsi_to_ip;
+  // UE address pool. Bit n is set if the n-th address after the SGi address is free
+  static const uint32_t                       MAX_UE_IP_POOL_SIZE = 256;
+  uint32_t                                    m_ue_ip_base        = 0; // SGi address, in host byte order
+  srsran::bounded_bitset<MAX_UE_IP_POOL_SIZE> m_ue_ip_free;
+  std::map<uint64_t, struct in_addr>          m_imsi_to_ip;
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("SPGW GTPC");
 };
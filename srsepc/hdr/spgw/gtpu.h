@@ -23,13 +23,19 @@
 #define SRSEPC_GTPU_H
 
 #include "srsepc/hdr/spgw/spgw.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/rwlock_guard.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
+#include "srsran/upper/gtpu.h"
+#include <array>
 #include <cstddef>
+#include <memory>
 #include <queue>
+#include <vector>
 
 namespace srsepc {
 
@@ -41,14 +47,22 @@ public:
   int  init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc);
   void stop();
 
-  int init_sgi(spgw_args_t* args);
-  int init_s1u(spgw_args_t* args);
-  int get_sgi();
-  int get_s1u();
+  int  init_sgi(spgw_args_t* args);
+  int  init_s1u(spgw_args_t* args);
+  void close_sgi();
+  void close_s1u();
+  int  get_sgi(uint32_t worker_idx);
+  int  get_s1u(uint32_t worker_idx);
 
-  void handle_sgi_pdu(srsran::unique_byte_buffer_t msg);
-  void handle_s1u_pdu(srsran::byte_buffer_t* msg);
-  void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
+  uint32_t get_nof_workers() const { return m_workers.size(); }
+
+  /// Maximum number of packets read from the SGi or the S1-U interfaces, and sent to the S1-U, per wake-up
+  static const uint32_t MAX_BATCH_SIZE = 32;
+
+  /// Read the pending packets of the worker's TUN queue, up to MAX_BATCH_SIZE, and send the resulting S1-U PDUs
+  void handle_sgi_pdus(uint32_t worker_idx);
+  /// Read the pending PDUs of the worker's S1-U socket with a single recvmmsg() call, up to MAX_BATCH_SIZE
+  void handle_s1u_pdus(uint32_t worker_idx);
 
   virtual in_addr_t get_s1u_addr();
 
@@ -58,32 +72,81 @@ public:
   virtual void send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
                                        std::queue<srsran::unique_byte_buffer_t>& pkt_queue);
 
+  /// Make the tunnel updates done since the last call visible to the user-plane workers. The S11 interface calls it
+  /// once per batch of GTP-C messages, before releasing the GTP-C mutex
+  void publish_tunnel_updates();
+
+private:
+  struct s1u_tx_pdu_t {
+    srsran::unique_byte_buffer_t pdu;
+    sockaddr_in                  addr;
+  };
+
+  /// Downlink user plane tunnel, with the eNB address and the G-PDU header precomputed
+  struct s1u_tunnel_t {
+    srsran::gtp_fteid_t                 enb_fteid;
+    sockaddr_in                         enb_addr;
+    srsran::gtpu_gpdu_header_template_t gpdu_hdr;
+  };
+  static s1u_tunnel_t make_s1u_tunnel(const srsran::gtp_fteid_t& enb_fteid);
+
+  /// State of a user-plane worker. Each worker reads its own queue of the TUN device and its own S1-U socket, so the
+  /// kernel spreads the flows over the workers. Only the tunnel tables and the GTP-C state are shared
+  struct up_worker_t {
+    int                                                      sgi = -1;
+    int                                                      s1u = -1;
+    std::vector<s1u_tx_pdu_t>                                s1u_tx_pdus;
+    std::array<srsran::unique_byte_buffer_t, MAX_BATCH_SIZE> s1u_rx_pdus;
+    bool                                                     s1u_gso = false;
+    bool                                                     s1u_gro = false;
+    std::vector<uint8_t>                                     s1u_gro_buf; // Received GRO messages, up to 64KB
+  };
+
+  /// Tunnel tables, looked up for every SGi packet. The user-plane workers read an immutable snapshot, taken once per
+  /// batch of packets. The S11 interface applies its updates to a private copy that replaces the snapshot when published
+  struct tunnel_table_t {
+    srsran::flat_hash_map<in_addr_t, s1u_tunnel_t> ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
+    srsran::flat_hash_map<in_addr_t, uint32_t>     ip_to_ctr_teid; // IP to control TEID map. Important to check if
+                                                                   // UE is attached without an active user-plane
+                                                                   // for downlink notifications.
+  };
+
+  int                                   open_sgi_queue(const std::string& if_name, bool multi_queue);
+  std::shared_ptr<const tunnel_table_t> get_tunnels();
+  tunnel_table_t&                       get_staged_tunnels();
+  bool                                  find_usr_tunnel(in_addr_t ue_ipv4, s1u_tunnel_t* usr_tunnel);
+  void                                  handle_s1u_gro_pdus(up_worker_t& worker);
+  void handle_sgi_pdu(up_worker_t& worker, const tunnel_table_t& tunnels, srsran::unique_byte_buffer_t msg);
+  void handle_s1u_pdu(up_worker_t& worker, srsran::byte_buffer_t* msg);
+  /// Queue a PDU for the worker's S1-U socket. The queued PDUs are sent with flush_s1u_pdus()
+  void send_s1u_pdu(up_worker_t& worker, const s1u_tunnel_t& tunnel, srsran::unique_byte_buffer_t msg);
+  void flush_s1u_pdus(up_worker_t& worker);
+
   spgw*                m_spgw;
   gtpc_interface_gtpu* m_gtpc;
 
-  bool m_sgi_up;
-  int  m_sgi;
-
+  bool        m_sgi_up;
   bool        m_s1u_up;
-  int         m_s1u;
   sockaddr_in m_s1u_addr;
 
-  std::map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
-  std::map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
-                                                             // UE is attached without an active user-plane
-                                                             // for downlink notifications.
+  std::vector<up_worker_t> m_workers;
+
+  // The lock only protects the replacement of the published snapshot, the tables are never modified once published
+  pthread_rwlock_t                      m_tunnel_rwlock;
+  std::shared_ptr<const tunnel_table_t> m_tunnels;
+  std::unique_ptr<tunnel_table_t>       m_staged_tunnels; // Pending updates, only accessed under the GTP-C mutex
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
 };
 
-inline int spgw::gtpu::get_sgi()
+inline int spgw::gtpu::get_sgi(uint32_t worker_idx)
 {
-  return m_sgi;
+  return m_workers[worker_idx].sgi;
 }
 
-inline int spgw::gtpu::get_s1u()
+inline int spgw::gtpu::get_s1u(uint32_t worker_idx)
 {
-  return m_s1u;
+  return m_workers[worker_idx].s1u;
 }
 
 inline in_addr_t spgw::gtpu::get_s1u_addr()
@@ -33,7 +33,10 @@
 #include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <vector>
 
 namespace srsepc {
 
@@ -46,6 +49,7 @@ typedef struct {
   std::string sgi_if_addr;
   std::string sgi_if_name;
   uint32_t    max_paging_queue;
+  uint32_t    nof_up_workers;
 } spgw_args_t;
 
 typedef struct spgw_tunnel_ctx {
@@ -64,6 +68,7 @@ class spgw : public srsran::thread
 {
   class gtpc;
   class gtpu;
+  class up_worker_thread;
 
 public:
   static spgw* get_instance(void);
@@ -80,6 +85,9 @@ private:
   spgw_tunnel_ctx_t* create_gtp_ctx(struct srsran::gtpc_create_session_request* cs_req);
   bool               delete_gtp_ctx(uint32_t ctrl_teid);
 
+  /// Maximum number of S11 messages handled per wake-up, before publishing their tunnel updates
+  static const uint32_t MAX_S11_BATCH_SIZE = 64;
+
   bool      m_running;
   mme_gtpc* m_mme_gtpc;
 
@@ -87,6 +95,12 @@ private:
   gtpc* m_gtpc;
   gtpu* m_gtpu;
 
+  // User-plane workers 1..N-1. Worker 0 runs in the SPGW thread, together with the S11 interface
+  std::vector<std::unique_ptr<up_worker_thread> > m_up_threads;
+
+  // The GTP-C state is accessed by the S11 interface and by the user-plane workers, to page the UEs
+  std::mutex m_gtpc_mutex;
+
   // Logs
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("SPGW");
 };
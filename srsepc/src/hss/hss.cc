@@ -77,7 +77,14 @@ int hss::init(hss_args_t* hss_args)
   mcc = hss_args->mcc;
   mnc = hss_args->mnc;
 
-  db_file = hss_args->db_file;
+  db_file     = hss_args->db_file;
+  db_log_file = db_file + ".log";
+
+  /*Apply the SQN updates left over from a previous run and start a new log*/
+  if (replay_db_log() == false or compact_db_file() == false) {
+    srsran::console("Error writing user database file %s\n", db_file.c_str());
+    return -1;
+  }
 
   m_logger.info("HSS Initialized. DB file %s, MCC: %d, MNC: %d", hss_args->db_file.c_str(), mcc, mnc);
   srsran::console("HSS Initialized.\n");
@@ -86,7 +93,10 @@ int hss::init(hss_args_t* hss_args)
 
 void hss::stop()
 {
-  write_db_file(db_file);
+  if (compact_db_file()) {
+    m_db_log.close();
+    remove(db_log_file.c_str());
+  }
   return;
 }
 
@@ -254,6 +264,66 @@ bool hss::write_db_file(std::string db_filename)
   return true;
 }
 
+bool hss::replay_db_log()
+{
+  std::ifstream log_file;
+
+  log_file.open(db_log_file.c_str(), std::ifstream::in);
+  if (!log_file.is_open()) {
+    return true;
+  }
+
+  // Each record is "IMSI,SQN". A torn last record from a crash is skipped.
+  uint32_t    nof_records = 0;
+  std::string line;
+  while (std::getline(log_file, line)) {
+    std::vector<std::string> split = srsran::split_string(line, ',');
+    if (split.size() != 2 or split[1].length() != 12) {
+      m_logger.warning("Skipping malformed record in DB log file %s", db_log_file.c_str());
+      continue;
+    }
+    hss_ue_ctx_t* ue_ctx = get_ue_ctx(strtoull(split[0].c_str(), nullptr, 10));
+    if (ue_ctx == nullptr) {
+      continue;
+    }
+    srsran::get_uint_vec_from_hex_str(split[1], ue_ctx->sqn, 6);
+    nof_records++;
+  }
+  m_logger.info("Applied %d SQN updates from DB log file %s", nof_records, db_log_file.c_str());
+  return true;
+}
+
+bool hss::compact_db_file()
+{
+  // Write the .csv aside and rename it, so that a crash never leaves a partially written database
+  std::string tmp_file = db_file + ".tmp";
+  if (write_db_file(tmp_file) == false or rename(tmp_file.c_str(), db_file.c_str()) != 0) {
+    m_logger.error("Error compacting DB file %s: %s", db_file.c_str(), strerror(errno));
+    return false;
+  }
+
+  m_db_log.close();
+  m_db_log.open(db_log_file.c_str(), std::ofstream::out | std::ofstream::trunc);
+  if (!m_db_log.is_open()) {
+    m_logger.error("Error opening DB log file %s", db_log_file.c_str());
+    return false;
+  }
+  db_log_records = 0;
+  return true;
+}
+
+void hss::log_ue_sqn(hss_ue_ctx_t* ue_ctx)
+{
+  m_db_log << std::setfill('0') << std::setw(15) << ue_ctx->imsi << "," << srsran::hex_string(ue_ctx->sqn, 6)
+           << std::endl;
+
+  // Compact once the log outgrows the .csv, so the cost per update stays constant
+  db_log_records++;
+  if (db_log_records >= std::max<size_t>(1024, 2 * m_imsi_to_ue_ctx.size())) {
+    compact_db_file();
+  }
+}
+
 bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
 {
 
@@ -274,6 +344,7 @@ bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, ui
       break;
   }
   increment_ue_sqn(ue_ctx);
+  log_ue_sqn(ue_ctx);
   return true;
 }
 
@@ -297,7 +368,8 @@ void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
 
   gen_rand(rand);
 
-  srsran::security_milenage_f2345(k, opc, rand, xres, ck, ik, ak);
+  // f1 and f2345 share the key schedule of K and the first AES output
+  srsran::security_milenage_f12345(ue_ctx->get_key_schedule(), opc, rand, sqn, amf, mac, xres, ck, ik, ak);
 
   m_logger.debug(k, 16, "User Key : ");
   m_logger.debug(opc, 16, "User OPc : ");
@@ -306,9 +378,6 @@ void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
   m_logger.debug(ck, 16, "User CK: ");
   m_logger.debug(ik, 16, "User IK: ");
   m_logger.debug(ak, 6, "User AK: ");
-
-  srsran::security_milenage_f1(k, opc, rand, sqn, amf, mac);
-
   m_logger.debug(sqn, 6, "User SQN : ");
   m_logger.debug(mac, 8, "User MAC : ");
 
@@ -472,6 +541,7 @@ bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
   }
 
   increment_seq_after_resync(ue_ctx);
+  log_ue_sqn(ue_ctx);
   return true;
 }
 
@@ -22,6 +22,7 @@
 #include "srsepc/hdr/mbms-gw/mbms-gw.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/network_utils.h"
+#include "srsran/common/string_helpers.h"
 #include "srsran/upper/gtpu.h"
 #include <algorithm>
 #include <fcntl.h>
@@ -193,6 +194,14 @@ int mbms_gw::init_sgi_mb_if(mbms_gw_args_t* args)
     return SRSRAN_ERROR_CANT_START;
   }
 
+  // The TUN device is non-blocking, so that all the pending packets can be read after each select()
+  if (fcntl(m_sgi_mb_if, F_SETFL, fcntl(m_sgi_mb_if, F_GETFL) | O_NONBLOCK) < 0) {
+    m_logger.error("Failed to set TUN device non-blocking: %s", strerror(errno));
+    close(m_sgi_mb_if);
+    close(sgi_mb_sock);
+    return SRSRAN_ERROR_CANT_START;
+  }
+
   m_sgi_mb_up = true;
   close(sgi_mb_sock);
   return SRSRAN_SUCCESS;
@@ -249,7 +258,31 @@ int mbms_gw::init_m1_u(mbms_gw_args_t* args)
     perror("inet_pton");
     return SRSRAN_ERROR_CANT_START;
   }
-  m_logger.info("Initialized M1-U");
+  m_m1u_dst_addrs.clear();
+  m_m1u_dst_addrs.push_back(m_m1u_multi_addr);
+
+  // eNBs without multicast connectivity get their own copy of each packet
+  std::vector<std::string> unicast_addrs;
+  srsran::string_parse_list(args->m1u_unicast_addrs, ',', unicast_addrs);
+  for (const std::string& unicast_addr : unicast_addrs) {
+    if (unicast_addr.empty()) {
+      continue;
+    }
+    struct sockaddr_in dst_addr = m_m1u_multi_addr;
+    if (inet_pton(AF_INET, unicast_addr.c_str(), &dst_addr.sin_addr.s_addr) != 1) {
+      m_logger.error("Invalid m1u_unicast_addrs entry: %s", unicast_addr.c_str());
+      srsran::console("Invalid m1u_unicast_addrs entry: %s\n", unicast_addr.c_str());
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_m1u_dst_addrs.push_back(dst_addr);
+  }
+
+  // The same GTP-U header is used for all the packets
+  m_gpdu_hdr = srsran::gtpu_make_gpdu_header_template(0xAAAA); // TODO Harcoded TEID for now
+  m_m1u_gso  = srsran::net_utils::udp_gso_supported(m_m1u);
+  m_logger.info("Initialized M1-U, %zd destinations, UDP GSO %s",
+                m_m1u_dst_addrs.size(),
+                m_m1u_gso ? "enabled" : "not supported");
 
   return SRSRAN_SUCCESS;
 }
@@ -257,66 +290,111 @@ int mbms_gw::init_m1_u(mbms_gw_args_t* args)
 void mbms_gw::run_thread()
 {
   // Mark the thread as running
-  m_running                        = true;
-  srsran::unique_byte_buffer_t msg = srsran::make_byte_buffer();
-  if (msg == nullptr) {
-    m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-    return;
+  m_running = true;
+  for (srsran::unique_byte_buffer_t& pdu : m_sgi_mb_pdus) {
+    pdu = srsran::make_byte_buffer();
+    if (pdu == nullptr) {
+      m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+      return;
+    }
   }
 
-  uint8_t seq = 0;
+  fd_set set;
   while (m_running) {
-    msg->clear();
-    int n;
-    do {
-      n = read(m_sgi_mb_if, msg->msg, SRSRAN_MAX_BUFFER_SIZE_BYTES);
-    } while (n == -1 && errno == EAGAIN);
-
+    FD_ZERO(&set);
+    FD_SET(m_sgi_mb_if, &set);
+    int n = select(m_sgi_mb_if + 1, &set, NULL, NULL, NULL);
     if (n < 0) {
-      m_logger.error("Error reading from TUN interface. Error: %s", strerror(errno));
-    } else {
-      msg->N_bytes = n;
-      handle_sgi_md_pdu(msg.get());
+      m_logger.error("Error from select: %s", strerror(errno));
+    } else if (n > 0) {
+      handle_sgi_mb_pdus();
     }
   }
   return;
 }
 
-void mbms_gw::handle_sgi_md_pdu(srsran::byte_buffer_t* msg)
+void mbms_gw::handle_sgi_mb_pdus()
 {
-  uint8_t               version;
-  srsran::gtpu_header_t header;
-
-  // Setup GTP-U header
-  header.flags        = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
-  header.message_type = GTPU_MSG_DATA_PDU;
-  header.length       = msg->N_bytes;
-  header.teid         = 0xAAAA; // TODO Harcoded TEID for now
+  size_t   buf_len  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  uint32_t nof_pdus = 0;
+  for (uint32_t i = 0; i < MAX_BATCH_SIZE; ++i) {
+    srsran::byte_buffer_t* msg = m_sgi_mb_pdus[nof_pdus].get();
+    msg->clear();
+    int n = read(m_sgi_mb_if, msg->msg, buf_len);
+    if (n <= 0) {
+      if (n < 0 and errno != EAGAIN and errno != EWOULDBLOCK) {
+        m_logger.error("Error reading from TUN interface. Error: %s", strerror(errno));
+      }
+      break;
+    }
+    msg->N_bytes = n;
+    if (handle_sgi_md_pdu(msg)) {
+      nof_pdus++;
+    }
+  }
+  send_m1u_pdus(nof_pdus);
+}
 
+bool mbms_gw::handle_sgi_md_pdu(srsran::byte_buffer_t* msg)
+{
   // Sanity Check IP packet
   if (msg->N_bytes < 20) {
     m_logger.error("IPv4 min len: %d, drop msg len %d", 20, msg->N_bytes);
-    return;
+    return false;
   }
 
   // IP Headers
   struct iphdr* iph = (struct iphdr*)msg->msg;
   if (iph->version != 4) {
     m_logger.info("IPv6 not supported yet.");
-    return;
+    return false;
   }
 
   // Write GTP-U header into packet
-  if (!srsran::gtpu_write_header(&header, msg, m_logger)) {
+  if (!srsran::gtpu_write_gpdu_header(m_gpdu_hdr, msg, m_logger)) {
     srsran::console("Error writing GTP-U header on PDU\n");
+    return false;
+  }
+  return true;
+}
+
+void mbms_gw::send_m1u_pdus(uint32_t nof_pdus)
+{
+  if (nof_pdus == 0) {
+    return;
+  }
+
+  // The datagrams are grouped by destination, so that a burst toward the same eNB may be sent as a UDP GSO message.
+  // All the copies of a packet point to the same buffer
+  const uint32_t                          max_datagrams = srsran::net_utils::max_send_datagrams;
+  std::array<struct iovec, max_datagrams> iovs;
+  std::array<sockaddr_in, max_datagrams>  addrs;
+  uint32_t                                nof_datagrams = 0;
+  uint32_t                                nof_sent      = 0;
+  for (const sockaddr_in& dst_addr : m_m1u_dst_addrs) {
+    for (uint32_t i = 0; i < nof_pdus; ++i) {
+      iovs[nof_datagrams].iov_base = m_sgi_mb_pdus[i]->msg;
+      iovs[nof_datagrams].iov_len  = m_sgi_mb_pdus[i]->N_bytes;
+      addrs[nof_datagrams]         = dst_addr;
+      if (++nof_datagrams == max_datagrams) {
+        nof_sent += srsran::net_utils::send_datagrams(m_m1u, iovs.data(), addrs.data(), nof_datagrams, m_m1u_gso);
+        nof_datagrams = 0;
+      }
+    }
+  }
+  if (nof_datagrams > 0) {
+    nof_sent += srsran::net_utils::send_datagrams(m_m1u, iovs.data(), addrs.data(), nof_datagrams, m_m1u_gso);
   }
 
-  int n = sendto(m_m1u, msg->msg, msg->N_bytes, 0, (sockaddr*)&m_m1u_multi_addr, sizeof(struct sockaddr));
-  if (n < 0) {
+  uint32_t nof_total = nof_pdus * m_m1u_dst_addrs.size();
+  if (nof_sent < nof_total) {
     srsran::console("Error writing to M1-U socket.\n");
-  } else {
-    m_logger.debug("Sent %d Bytes", msg->N_bytes);
   }
+  m_logger.debug("Sent %d/%d M1-U PDUs, %d packets to %zd destinations",
+                 nof_sent,
+                 nof_total,
+                 nof_pdus,
+                 m_m1u_dst_addrs.size());
 }
 
 } // namespace srsepc
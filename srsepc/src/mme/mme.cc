@@ -20,6 +20,7 @@
  */
 
 #include "srsepc/hdr/mme/mme.h"
+#include "srsran/common/epoll_helper.h"
 #include <arpa/inet.h>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
@@ -77,6 +78,14 @@ int mme::init(mme_args_t* args)
     exit(-1);
   }
 
+  /*Init event loop with the S1-MME and S11 sockets. NAS timers are added when started*/
+  m_epoll_fd = epoll_create1(0);
+  if (m_epoll_fd == -1 || add_epoll(m_s1ap->get_s1_mme(), m_epoll_fd) != SRSRAN_SUCCESS ||
+      add_epoll(m_mme_gtpc->get_s11(), m_epoll_fd) != SRSRAN_SUCCESS) {
+    srsran::console("Error initializing MME event loop\n");
+    exit(-1);
+  }
+
   /*Log successful initialization*/
   m_s1ap_logger.info("MME Initialized. MCC: 0x%x, MNC: 0x%x", args->s1ap_args.mcc, args->s1ap_args.mnc);
   srsran::console("MME Initialized. MCC: 0x%x, MNC: 0x%x\n", args->s1ap_args.mcc, args->s1ap_args.mnc);
@@ -91,6 +100,11 @@ void mme::stop()
     m_running = false;
     thread_cancel();
     wait_thread_finish();
+    while (!timers.empty()) {
+      del_nas_timer(timers.begin());
+    }
+    close(m_epoll_fd);
+    m_epoll_fd = -1;
   }
   return;
 }
@@ -118,28 +132,24 @@ void mme::run_thread()
   int s1mme = m_s1ap->get_s1_mme();
   int s11   = m_mme_gtpc->get_s11();
 
-  while (m_running) {
-    pdu->clear();
-    int max_fd = std::max(s1mme, s11);
-
-    FD_ZERO(&m_set);
-    FD_SET(s1mme, &m_set);
-    FD_SET(s11, &m_set);
-
-    // Add timers to select
-    for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
-      FD_SET(it->fd, &m_set);
-      max_fd = std::max(max_fd, it->fd);
-      m_s1ap_logger.debug("Adding Timer fd %d to fd_set", it->fd);
-    }
+  const int          max_events = 64;
+  struct epoll_event events[max_events];
 
+  while (m_running) {
     m_s1ap_logger.debug("Waiting for S1-MME or S11 Message");
-    int n = select(max_fd + 1, &m_set, NULL, NULL, NULL);
+    int n = epoll_wait(m_epoll_fd, events, max_events, -1);
     if (n == -1) {
-      m_s1ap_logger.error("Error from select");
-    } else if (n) {
-      // Handle S1-MME
-      if (FD_ISSET(s1mme, &m_set)) {
+      if (errno != EINTR) {
+        m_s1ap_logger.error("Error from epoll_wait: %s", strerror(errno));
+      }
+      continue;
+    }
+    // All the events returned by one call are handled before waiting again
+    for (int i = 0; i < n; ++i) {
+      uint64_t tag = events[i].data.u64;
+      if (tag == (uint64_t)s1mme) {
+        // Handle S1-MME
+        pdu->clear();
         rd_sz = sctp_recvmsg(s1mme, pdu->msg, sz, (struct sockaddr*)&enb_addr, &fromlen, &sri, &msg_flags);
         if (rd_sz == -1 && errno != EAGAIN) {
           m_s1ap_logger.error("Error reading from SCTP socket: %s", strerror(errno));
@@ -162,27 +172,15 @@ void mme::run_thread()
             m_s1ap->handle_s1ap_rx_pdu(pdu.get(), &sri);
           }
         }
-      }
-      // Handle S11
-      if (FD_ISSET(s11, &m_set)) {
+      } else if (tag == (uint64_t)s11) {
+        // Handle S11
+        pdu->clear();
         pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
         m_mme_gtpc->handle_s11_pdu(pdu.get());
+      } else {
+        // Handle NAS Timers
+        handle_timer_expire(tag);
       }
-      // Handle NAS Timers
-      for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end();) {
-        if (FD_ISSET(it->fd, &m_set)) {
-          m_s1ap_logger.info("Timer expired");
-          uint64_t exp;
-          rd_sz = read(it->fd, &exp, sizeof(uint64_t));
-          m_s1ap->expire_nas_timer(it->type, it->imsi);
-          close(it->fd);
-          timers.erase(it);
-        } else {
-          ++it;
-        }
-      }
-    } else {
-      m_s1ap_logger.debug("No data from select.");
     }
   }
   return;
@@ -195,45 +193,83 @@ bool mme::add_nas_timer(int timer_fd, nas_timer_type type, uint64_t imsi)
 {
   m_s1ap_logger.debug("Adding NAS timer to MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, timer_fd);
 
+  // A running timer of the same type and UE is replaced
+  std::unordered_map<uint64_t, uint64_t>::iterator tag_it = timer_tag_by_imsi.find(timer_key(type, imsi));
+  if (tag_it != timer_tag_by_imsi.end()) {
+    m_s1ap_logger.warning("Replacing running NAS timer. IMSI %" PRIu64 ", Type %d", imsi, type);
+    del_nas_timer(timers.find(tag_it->second));
+  }
+
+  // Sequence number 0 is left for the sockets
+  if (++timer_seq == 0) {
+    timer_seq = 1;
+  }
+  uint64_t           tag = ((uint64_t)timer_seq << 32u) | (uint32_t)timer_fd;
+  struct epoll_event ev  = {};
+  ev.data.u64            = tag;
+  ev.events              = EPOLLIN;
+  if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev) == -1) {
+    m_s1ap_logger.error("Could not add NAS timer to MME event loop. %s", strerror(errno));
+    close(timer_fd);
+    return false;
+  }
+
   mme_timer_t timer;
   timer.fd   = timer_fd;
   timer.type = type;
   timer.imsi = imsi;
 
-  timers.push_back(timer);
+  timers.insert(std::make_pair(tag, timer));
+  timer_tag_by_imsi[timer_key(type, imsi)] = tag;
   return true;
 }
 
 bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 {
-  std::vector<mme_timer_t>::iterator it;
-  for (it = timers.begin(); it != timers.end(); ++it) {
-    if (it->type == type && it->imsi == imsi) {
-      return true; // found timer
-    }
-  }
-  return false;
+  return timer_tag_by_imsi.count(timer_key(type, imsi)) > 0;
 }
 
 bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 {
-  std::vector<mme_timer_t>::iterator it;
-  for (it = timers.begin(); it != timers.end(); ++it) {
-    if (it->type == type && it->imsi == imsi) {
-      break; // found timer to remove
-    }
-  }
-  if (it == timers.end()) {
+  std::unordered_map<uint64_t, uint64_t>::iterator tag_it = timer_tag_by_imsi.find(timer_key(type, imsi));
+  if (tag_it == timer_tag_by_imsi.end()) {
     m_s1ap_logger.warning("Could not find timer to remove. IMSI %" PRIu64 ", Type %d", imsi, type);
     return false;
   }
 
   // removing timer
-  m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, it->fd);
-  FD_CLR(it->fd, &m_set);
-  close(it->fd);
-  timers.erase(it);
+  std::unordered_map<uint64_t, mme_timer_t>::iterator it = timers.find(tag_it->second);
+  m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, it->second.fd);
+  del_nas_timer(it);
   return true;
 }
 
+void mme::del_nas_timer(std::unordered_map<uint64_t, mme_timer_t>::iterator it)
+{
+  del_epoll(it->second.fd, m_epoll_fd);
+  close(it->second.fd);
+  timer_tag_by_imsi.erase(timer_key(it->second.type, it->second.imsi));
+  timers.erase(it);
+}
+
+void mme::handle_timer_expire(uint64_t tag)
+{
+  std::unordered_map<uint64_t, mme_timer_t>::iterator it = timers.find(tag);
+  if (it == timers.end()) {
+    // The timer was removed while handling a previous event of the same epoll_wait() call
+    m_s1ap_logger.debug("Ignoring event of removed NAS timer");
+    return;
+  }
+  m_s1ap_logger.info("Timer expired");
+  uint64_t exp;
+  if (read(it->second.fd, &exp, sizeof(uint64_t)) != sizeof(uint64_t)) {
+    m_s1ap_logger.warning("Error reading NAS timer. %s", strerror(errno));
+  }
+
+  // The timer is removed first, as the expiration may start a new one for the same UE
+  mme_timer_t timer = it->second;
+  del_nas_timer(it);
+  m_s1ap->expire_nas_timer(timer.type, timer.imsi);
+}
+
 } // namespace srsepc
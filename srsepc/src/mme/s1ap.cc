@@ -24,6 +24,7 @@
 #include "srsran/common/bcd_helpers.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/network_utils.h"
+#include <algorithm>
 #include <cmath>
 #include <inttypes.h> // for printing uint64_t
 #include <random>
@@ -115,8 +116,9 @@ void s1ap::stop()
     delete enb_it->second;
     m_active_enbs.erase(enb_it++);
   }
+  m_tac_to_enbs.clear();
 
-  std::map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
+  std::unordered_map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
   while (ue_it != m_imsi_to_nas_ctx.end()) {
     m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue_it->first);
     srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue_it->first);
@@ -229,6 +231,73 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
   return true;
 }
 
+bool s1ap::s1ap_tx_pdu(const s1ap_pdu_t& pdu, const std::vector<enb_ctx_t*>& enbs)
+{
+  if (enbs.empty()) {
+    return true;
+  }
+  m_logger.debug("Transmitting S1AP PDU to %zd eNBs", enbs.size());
+
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  if (buf == nullptr) {
+    m_logger.error("Fatal Error: Couldn't allocate buffer for S1AP PDU.");
+    return false;
+  }
+  asn1::bit_ref bref(buf->msg, buf->get_tailroom());
+  if (pdu.pack(bref) != asn1::SRSASN_SUCCESS) {
+    m_logger.error("Could not pack S1AP PDU correctly.");
+    return false;
+  }
+  buf->N_bytes = bref.distance_bytes();
+
+  // The same encoded PDU is sent to every association, a batch of messages per system call. Like sctp_send(), each
+  // message carries the association's sctp_sndrcvinfo as SCTP_SNDRCV ancillary data.
+  const uint32_t batch_size = 64;
+  struct iovec   iov        = {buf->msg, buf->N_bytes};
+  struct mmsghdr msgs[batch_size];
+  char           cmsg_bufs[batch_size][CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))];
+
+  bool success = true;
+  for (size_t offset = 0; offset < enbs.size();) {
+    uint32_t nof_msgs = std::min<size_t>(batch_size, enbs.size() - offset);
+    for (uint32_t i = 0; i < nof_msgs; i++) {
+      memset(&msgs[i], 0, sizeof(struct mmsghdr));
+      msgs[i].msg_hdr.msg_iov        = &iov;
+      msgs[i].msg_hdr.msg_iovlen     = 1;
+      msgs[i].msg_hdr.msg_control    = cmsg_bufs[i];
+      msgs[i].msg_hdr.msg_controllen = sizeof(cmsg_bufs[i]);
+
+      struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr);
+      cmsg->cmsg_level     = IPPROTO_SCTP;
+      cmsg->cmsg_type      = SCTP_SNDRCV;
+      cmsg->cmsg_len       = CMSG_LEN(sizeof(struct sctp_sndrcvinfo));
+      memcpy(CMSG_DATA(cmsg), &enbs[offset + i]->sri, sizeof(struct sctp_sndrcvinfo));
+    }
+
+    int n_sent = sendmmsg(m_s1mme, msgs, nof_msgs, MSG_NOSIGNAL);
+    if (n_sent == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      n_sent = 0;
+    }
+    if (m_pcap_enable) {
+      for (int i = 0; i < n_sent; i++) {
+        m_pcap.write_s1ap(buf->msg, buf->N_bytes);
+      }
+    }
+    offset += n_sent;
+    if ((uint32_t)n_sent < nof_msgs) {
+      // Skip the association that failed and carry on with the rest
+      m_logger.error("Failed to send S1AP PDU to eNB Id: 0x%x. Error: %s", enbs[offset]->enb_id, strerror(errno));
+      success = false;
+      offset++;
+    }
+  }
+
+  return success;
+}
+
 void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri)
 {
   // Save PCAP
@@ -320,6 +389,23 @@ void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinf
   m_active_enbs.insert(std::pair<uint16_t, enb_ctx_t*>(enb_ptr->enb_id, enb_ptr));
   m_sctp_to_enb_id.insert(std::pair<int32_t, uint16_t>(enb_sri->sinfo_assoc_id, enb_ptr->enb_id));
   m_enb_assoc_to_ue_ids.insert(std::pair<int32_t, std::set<uint32_t> >(enb_sri->sinfo_assoc_id, ue_set));
+  for (uint32_t i = 0; i < enb_ptr->nof_supported_ta && i < MAX_TA; i++) {
+    std::vector<enb_ctx_t*>& tac_enbs = m_tac_to_enbs[enb_ptr->tacs[i]];
+    if (std::find(tac_enbs.begin(), tac_enbs.end(), enb_ptr) == tac_enbs.end()) {
+      tac_enbs.push_back(enb_ptr);
+    }
+  }
+}
+
+const std::vector<enb_ctx_t*>& s1ap::find_enbs_from_tac(uint16_t tac)
+{
+  static const std::vector<enb_ctx_t*> no_enbs;
+
+  std::unordered_map<uint16_t, std::vector<enb_ctx_t*> >::const_iterator it = m_tac_to_enbs.find(tac);
+  if (it == m_tac_to_enbs.end()) {
+    return no_enbs;
+  }
+  return it->second;
 }
 
 enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
@@ -350,6 +436,13 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
   release_ues_ecm_ctx_in_enb(assoc_id);
 
   // Delete eNB
+  for (uint32_t i = 0; i < it_ctx->second->nof_supported_ta && i < MAX_TA; i++) {
+    std::vector<enb_ctx_t*>& tac_enbs = m_tac_to_enbs[it_ctx->second->tacs[i]];
+    tac_enbs.erase(std::remove(tac_enbs.begin(), tac_enbs.end(), it_ctx->second), tac_enbs.end());
+    if (tac_enbs.empty()) {
+      m_tac_to_enbs.erase(it_ctx->second->tacs[i]);
+    }
+  }
   delete it_ctx->second;
   m_active_enbs.erase(it_ctx);
   m_sctp_to_enb_id.erase(it_assoc);
@@ -359,13 +452,14 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
 // UE Context Management
 bool s1ap::add_nas_ctx_to_imsi_map(nas* nas_ctx)
 {
-  std::map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
+  std::unordered_map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
   if (ctx_it != m_imsi_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    std::unordered_map<uint32_t, nas*>::iterator ctx_it2 =
+        m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with IMSI does not match context identified by MME UE S1AP Id.");
       return false;
@@ -382,13 +476,15 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
     m_logger.error("Could not add UE context to MME UE S1AP map. MME UE S1AP ID 0 is not valid.");
     return false;
   }
-  std::map<uint32_t, nas*>::iterator ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+  std::unordered_map<uint32_t, nas*>::iterator ctx_it =
+      m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   if (ctx_it != m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. MME UE S1AP Id %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_emm_ctx.imsi != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    std::unordered_map<uint32_t, nas*>::iterator ctx_it2 =
+        m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with MME UE S1AP Id does not match context identified by IMSI.");
       return false;
@@ -418,7 +514,7 @@ bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 {
-  std::map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  std::unordered_map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
   if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -428,7 +524,7 @@ nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 {
-  std::map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
+  std::unordered_map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
   if (it == m_imsi_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -445,9 +541,9 @@ void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
     srsran::console("No UEs to be released\n");
   } else {
     while (ue_id != ues_in_enb->second.end()) {
-      std::map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
-      emm_ctx_t*                         emm_ctx = &nas_ctx->second->m_emm_ctx;
-      ecm_ctx_t*                         ecm_ctx = &nas_ctx->second->m_ecm_ctx;
+      std::unordered_map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
+      emm_ctx_t*                                   emm_ctx = &nas_ctx->second->m_emm_ctx;
+      ecm_ctx_t*                                   ecm_ctx = &nas_ctx->second->m_ecm_ctx;
 
       m_logger.info(
           "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
@@ -520,14 +616,14 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
 // UE Bearer Managment
 void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 {
-  std::map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
+  std::unordered_map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
   if (ue_ctx_it == m_imsi_to_nas_ctx.end()) {
     m_logger.error("Could not activate EPS bearer: Could not find UE context");
     return;
   }
   // Make sure NAS is active
-  uint32_t                           mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
-  std::map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  uint32_t                                     mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
+  std::unordered_map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
   if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("Could not activate EPS bearer: ECM context seems to be missing");
     return;
@@ -567,7 +663,7 @@ uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 
 uint64_t s1ap::find_imsi_from_m_tmsi(uint32_t m_tmsi)
 {
-  std::map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
+  std::unordered_map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
   if (it != m_tmsi_to_imsi.end()) {
     m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", it->second, m_tmsi);
     return it->second;
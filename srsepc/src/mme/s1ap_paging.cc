@@ -85,13 +85,15 @@ bool s1ap_paging::send_paging(uint64_t imsi, uint16_t erab_to_setup)
     return false;
   }
 
-  for (std::map<uint16_t, enb_ctx_t*>::iterator it = m_s1ap->m_active_enbs.begin(); it != m_s1ap->m_active_enbs.end();
-       it++) {
-    enb_ctx_t* enb_ctx = it->second;
-    if (!m_s1ap->s1ap_tx_pdu(tx_pdu, &enb_ctx->sri)) {
-      m_logger.error("Error paging to eNB. eNB Id: 0x%x.", enb_ctx->enb_id);
-      return false;
-    }
+  // Page the eNBs serving the TAI, encoding the PDU once for all of them
+  const std::vector<enb_ctx_t*>& enbs = m_s1ap->find_enbs_from_tac(tac);
+  if (enbs.empty()) {
+    m_logger.warning("No eNB serves TAC %d. Could not page UE -- IMSI %015" PRIu64 "", tac, imsi);
+    return false;
+  }
+  if (!m_s1ap->s1ap_tx_pdu(tx_pdu, enbs)) {
+    m_logger.error("Error paging to eNBs serving TAC %d.", tac);
+    return false;
   }
 
   return true;
@@ -481,6 +481,9 @@ bool spgw::gtpc::delete_gtpc_ctx(uint32_t ctrl_teid)
   // Remove Ctrl TEID from GTP-U Mapping
   m_gtpu->delete_gtpc_tunnel(tunnel_ctx->ue_ipv4);
 
+  // Return the UE IP to the pool
+  release_ue_ipv4(tunnel_ctx->imsi, tunnel_ctx->ue_ipv4);
+
   // Remove Ctrl TEID from IMSI to control TEID map
   m_imsi_to_ctr_teid.erase(tunnel_ctx->imsi);
 
@@ -561,17 +564,22 @@ int spgw::gtpc::init_ue_ip(spgw_args_t* args, const std::map<std::string, uint64
     }
   }
 
+  struct in_addr sgi_addr;
+  if (inet_pton(AF_INET, args->sgi_if_addr.c_str(), &sgi_addr.s_addr) != 1) {
+    m_logger.error("Invalid sgi_if_addr: %s", args->sgi_if_addr.c_str());
+    srsran::console("Invalid sgi_if_addr: %s\n", args->sgi_if_addr.c_str());
+    perror("inet_pton");
+    return SRSRAN_ERROR;
+  }
+  m_ue_ip_base = ntohl(sgi_addr.s_addr);
+  m_ue_ip_free.resize(MAX_UE_IP_POOL_SIZE);
+  m_ue_ip_free.reset();
+
   // XXX TODO add an upper bound to ip addr range via config, use 254 for now
   // first address is allocated to the epc tun interface, start w/next addr
   for (uint32_t n = 1; n < 254; ++n) {
     struct in_addr ue_addr;
-    if (inet_pton(AF_INET, args->sgi_if_addr.c_str(), &ue_addr.s_addr) != 1) {
-      m_logger.error("Invalid sgi_if_addr: %s", args->sgi_if_addr.c_str());
-      srsran::console("Invalid sgi_if_addr: %s\n", args->sgi_if_addr.c_str());
-      perror("inet_pton");
-      return SRSRAN_ERROR;
-    }
-    ue_addr.s_addr = ue_addr.s_addr + htonl(n);
+    ue_addr.s_addr = htonl(m_ue_ip_base + n);
 
     std::map<std::string, uint64_t>::const_iterator iter = ip_to_imsi.find(inet_ntoa(ue_addr));
     if (iter != ip_to_imsi.end()) {
@@ -579,7 +587,7 @@ int spgw::gtpc::init_ue_ip(spgw_args_t* args, const std::map<std::string, uint64
                      iter->first.c_str(),
                      iter->second);
     } else {
-      m_ue_ip_addr_pool.insert(ue_addr.s_addr);
+      m_ue_ip_free.set(n);
       m_logger.debug("SPGW: init_ue_ip ue ip addr %s is added to pool", inet_ntoa(ue_addr));
     }
   }
@@ -595,16 +603,31 @@ in_addr_t spgw::gtpc::get_new_ue_ipv4(uint64_t imsi)
     ue_addr = iter->second;
     m_logger.info("SPGW: get_new_ue_ipv4 static ip addr %s", inet_ntoa(ue_addr));
   } else {
-    if (m_ue_ip_addr_pool.empty()) {
+    int n = m_ue_ip_free.find_lowest(0, m_ue_ip_free.size());
+    if (n < 0) {
       m_logger.error("SPGW: ue address pool is empty");
       ue_addr.s_addr = 0;
     } else {
-      ue_addr.s_addr = *m_ue_ip_addr_pool.begin();
-      m_ue_ip_addr_pool.erase(ue_addr.s_addr);
+      m_ue_ip_free.reset(n);
+      ue_addr.s_addr = htonl(m_ue_ip_base + n);
       m_logger.info("SPGW: get_new_ue_ipv4 pool ip addr %s", inet_ntoa(ue_addr));
     }
   }
   return ue_addr.s_addr;
 }
 
+void spgw::gtpc::release_ue_ipv4(uint64_t imsi, in_addr_t ue_ipv4)
+{
+  // Static addresses are not part of the pool
+  if (ue_ipv4 == 0 || m_imsi_to_ip.count(imsi) > 0) {
+    return;
+  }
+  uint32_t n = ntohl(ue_ipv4) - m_ue_ip_base;
+  if (n >= m_ue_ip_free.size() || m_ue_ip_free.test(n)) {
+    m_logger.error("SPGW: ue ip addr 0x%x does not belong to the pool or is already free", ntohl(ue_ipv4));
+    return;
+  }
+  m_ue_ip_free.set(n);
+}
+
 } // namespace srsepc
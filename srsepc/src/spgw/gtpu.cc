@@ -44,13 +44,15 @@ namespace srsepc {
  *
  **************************************/
 
-spgw::gtpu::gtpu() : m_sgi_up(false), m_s1u_up(false)
+spgw::gtpu::gtpu() : m_sgi_up(false), m_s1u_up(false), m_tunnels(new tunnel_table_t)
 {
+  pthread_rwlock_init(&m_tunnel_rwlock, nullptr);
   return;
 }
 
 spgw::gtpu::~gtpu()
 {
+  pthread_rwlock_destroy(&m_tunnel_rwlock);
   return;
 }
 
@@ -62,6 +64,12 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
   m_spgw = spgw;
   m_gtpc = gtpc;
 
+  if (args->nof_up_workers < 1) {
+    srsran::console("Invalid number of SPGW user-plane workers: %d\n", args->nof_up_workers);
+    return SRSRAN_ERROR_CANT_START;
+  }
+  m_workers.resize(args->nof_up_workers);
+
   // Init SGi interface
   err = init_sgi(args);
   if (err != SRSRAN_SUCCESS) {
@@ -85,14 +93,63 @@ void spgw::gtpu::stop()
 {
   // Clean up SGi interface
   if (m_sgi_up) {
-    close(m_sgi);
+    close_sgi();
   }
-  // Clean up S1-U socket
+  // Clean up S1-U sockets
   if (m_s1u_up) {
-    close(m_s1u);
+    for (up_worker_t& worker : m_workers) {
+      flush_s1u_pdus(worker);
+    }
+    close_s1u();
+  }
+}
+
+void spgw::gtpu::close_sgi()
+{
+  for (up_worker_t& worker : m_workers) {
+    if (worker.sgi >= 0) {
+      close(worker.sgi);
+      worker.sgi = -1;
+    }
+  }
+}
+
+void spgw::gtpu::close_s1u()
+{
+  for (up_worker_t& worker : m_workers) {
+    if (worker.s1u >= 0) {
+      close(worker.s1u);
+      worker.s1u = -1;
+    }
   }
 }
 
+int spgw::gtpu::open_sgi_queue(const std::string& if_name, bool multi_queue)
+{
+  struct ifreq ifr;
+
+  // The TUN device is non-blocking, so that all the pending packets can be read after each select()
+  int fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+  m_logger.info("TUN file descriptor = %d", fd);
+  if (fd < 0) {
+    m_logger.error("Failed to open TUN device: %s", strerror(errno));
+    return -1;
+  }
+
+  // Each open() of a multi-queue TUN device with the same name attaches one more queue to it
+  memset(&ifr, 0, sizeof(ifr));
+  ifr.ifr_flags = IFF_TUN | IFF_NO_PI | (multi_queue ? IFF_MULTI_QUEUE : 0);
+  strncpy(ifr.ifr_ifrn.ifrn_name, if_name.c_str(), std::min(if_name.length(), (size_t)(IFNAMSIZ - 1)));
+  ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = '\0';
+
+  if (ioctl(fd, TUNSETIFF, &ifr) < 0) {
+    m_logger.error("Failed to set TUN device name: %s", strerror(errno));
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
 int spgw::gtpu::init_sgi(spgw_args_t* args)
 {
   struct ifreq ifr;
@@ -102,32 +159,26 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
     return SRSRAN_ERROR_ALREADY_STARTED;
   }
 
-  // Construct the TUN device
-  m_sgi = open("/dev/net/tun", O_RDWR);
-  m_logger.info("TUN file descriptor = %d", m_sgi);
-  if (m_sgi < 0) {
-    m_logger.error("Failed to open TUN device: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
+  // Construct the TUN device, with one queue per user-plane worker
+  for (up_worker_t& worker : m_workers) {
+    worker.sgi = open_sgi_queue(args->sgi_if_name, m_workers.size() > 1);
+    if (worker.sgi < 0) {
+      close_sgi();
+      return SRSRAN_ERROR_CANT_START;
+    }
   }
 
   memset(&ifr, 0, sizeof(ifr));
-  ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
   strncpy(
       ifr.ifr_ifrn.ifrn_name, args->sgi_if_name.c_str(), std::min(args->sgi_if_name.length(), (size_t)(IFNAMSIZ - 1)));
   ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = '\0';
 
-  if (ioctl(m_sgi, TUNSETIFF, &ifr) < 0) {
-    m_logger.error("Failed to set TUN device name: %s", strerror(errno));
-    close(m_sgi);
-    return SRSRAN_ERROR_CANT_START;
-  }
-
   // Bring up the interface
   sgi_sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (ioctl(sgi_sock, SIOCGIFFLAGS, &ifr) < 0) {
     m_logger.error("Failed to bring up socket: %s", strerror(errno));
     close(sgi_sock);
-    close(m_sgi);
+    close_sgi();
     return SRSRAN_ERROR_CANT_START;
   }
 
@@ -135,7 +186,7 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   if (ioctl(sgi_sock, SIOCSIFFLAGS, &ifr) < 0) {
     m_logger.error("Failed to set socket flags: %s", strerror(errno));
     close(sgi_sock);
-    close(m_sgi);
+    close_sgi();
     return SRSRAN_ERROR_CANT_START;
   }
 
@@ -150,7 +201,7 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   if (ioctl(sgi_sock, SIOCSIFADDR, &ifr) < 0) {
     m_logger.error(
         "Failed to set TUN interface IP. Address: %s, Error: %s", args->sgi_if_addr.c_str(), strerror(errno));
-    close(m_sgi);
+    close_sgi();
     close(sgi_sock);
     return SRSRAN_ERROR_CANT_START;
   }
@@ -162,7 +213,7 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   }
   if (ioctl(sgi_sock, SIOCSIFNETMASK, &ifr) < 0) {
     m_logger.error("Failed to set TUN interface Netmask. Error: %s", strerror(errno));
-    close(m_sgi);
+    close_sgi();
     close(sgi_sock);
     return SRSRAN_ERROR_CANT_START;
   }
@@ -175,44 +226,169 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
 
 int spgw::gtpu::init_s1u(spgw_args_t* args)
 {
-  // Open S1-U socket
-  m_s1u = socket(AF_INET, SOCK_DGRAM, 0);
-  if (m_s1u == -1) {
-    m_logger.error("Failed to open socket: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
-  }
-  m_s1u_up = true;
-
-  // Bind the socket
-  m_s1u_addr.sin_family      = AF_INET;
+  m_s1u_addr.sin_family = AF_INET;
   if (inet_pton(m_s1u_addr.sin_family, args->gtpu_bind_addr.c_str(), &m_s1u_addr.sin_addr.s_addr) != 1) {
     m_logger.error("Invalid gtpu_bind_addr: %s", args->gtpu_bind_addr.c_str());
     srsran::console("Invalid gtpu_bind_addr: %s\n", args->gtpu_bind_addr.c_str());
     return SRSRAN_ERROR_CANT_START;
   }
-  m_s1u_addr.sin_port        = htons(GTPU_RX_PORT);
-
-  if (bind(m_s1u, (struct sockaddr*)&m_s1u_addr, sizeof(struct sockaddr_in))) {
-    m_logger.error("Failed to bind socket: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
+  m_s1u_addr.sin_port = htons(GTPU_RX_PORT);
+
+  // Open one S1-U socket per user-plane worker. The sockets share the address with SO_REUSEPORT, and the kernel
+  // spreads the eNB flows over them
+  for (up_worker_t& worker : m_workers) {
+    worker.s1u = socket(AF_INET, SOCK_DGRAM, 0);
+    if (worker.s1u == -1) {
+      m_logger.error("Failed to open socket: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_s1u_up = true;
+
+    int enable = 1;
+    if (m_workers.size() > 1 and setsockopt(worker.s1u, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0) {
+      m_logger.error("Failed to set SO_REUSEPORT: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
+
+    // Bind the socket
+    if (bind(worker.s1u, (struct sockaddr*)&m_s1u_addr, sizeof(struct sockaddr_in))) {
+      m_logger.error("Failed to bind socket: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
+    worker.s1u_tx_pdus.reserve(MAX_BATCH_SIZE);
+    for (srsran::unique_byte_buffer_t& pdu : worker.s1u_rx_pdus) {
+      pdu = srsran::make_byte_buffer("spgw::gtpu::s1u_rx_pdu");
+      if (pdu == nullptr) {
+        m_logger.error("Failed to allocate the S1-U rx buffers");
+        return SRSRAN_ERROR_CANT_START;
+      }
+    }
+    worker.s1u_gso = srsran::net_utils::udp_gso_supported(worker.s1u);
+    worker.s1u_gro = srsran::net_utils::enable_udp_gro(worker.s1u);
+    if (worker.s1u_gro) {
+      worker.s1u_gro_buf.resize(UINT16_MAX);
+    }
+    m_logger.info("S1-U socket = %d, UDP GSO %s, UDP GRO %s",
+                  worker.s1u,
+                  worker.s1u_gso ? "enabled" : "not supported",
+                  worker.s1u_gro ? "enabled" : "not supported");
   }
-  m_logger.info("S1-U socket = %d", m_s1u);
   m_logger.info("S1-U IP = %s, Port = %d ", inet_ntoa(m_s1u_addr.sin_addr), ntohs(m_s1u_addr.sin_port));
 
   m_logger.info("Initialized S1-U interface");
   return SRSRAN_SUCCESS;
 }
 
-void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
+void spgw::gtpu::handle_sgi_pdus(uint32_t worker_idx)
+{
+  /*
+   * SGi messages may need to be queued when waiting for UE Paging procedure.
+   * For this reason, buffers for SGi pdus are allocated here and deallocated
+   * at the flush_s1u_pdus() when the PDU is sent, at handle_sgi_pdu() when the PDU is dropped or at
+   * gtpc::free_all_queued_packets, which is called when the Downlink Data Notification
+   * procedure fails (see handle_downlink_data_notification_acknowledgment and
+   * handle_downlink_data_notification_failure)
+   */
+  up_worker_t&                          worker  = m_workers[worker_idx];
+  size_t                                buf_len = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  std::shared_ptr<const tunnel_table_t> tunnels = get_tunnels();
+  for (uint32_t i = 0; i < MAX_BATCH_SIZE; ++i) {
+    srsran::unique_byte_buffer_t sgi_msg = srsran::make_byte_buffer("spgw::gtpu::sgi_msg");
+    if (sgi_msg == nullptr) {
+      m_logger.error("Failed to allocate buffer for SGi PDU");
+      break;
+    }
+    int n = read(worker.sgi, sgi_msg->msg, buf_len);
+    if (n <= 0) {
+      if (n < 0 and errno != EAGAIN and errno != EWOULDBLOCK) {
+        m_logger.error("Error reading from TUN interface: %s", strerror(errno));
+      }
+      break;
+    }
+    sgi_msg->N_bytes = n;
+    handle_sgi_pdu(worker, *tunnels, std::move(sgi_msg));
+  }
+  flush_s1u_pdus(worker);
+}
+
+void spgw::gtpu::handle_s1u_pdus(uint32_t worker_idx)
+{
+  up_worker_t& worker = m_workers[worker_idx];
+  if (worker.s1u_gro) {
+    handle_s1u_gro_pdus(worker);
+    return;
+  }
+
+  std::array<struct mmsghdr, MAX_BATCH_SIZE> msgs;
+  std::array<struct iovec, MAX_BATCH_SIZE>   iovs;
+  for (uint32_t i = 0; i < MAX_BATCH_SIZE; ++i) {
+    worker.s1u_rx_pdus[i]->clear();
+    iovs[i].iov_base           = worker.s1u_rx_pdus[i]->msg;
+    iovs[i].iov_len            = worker.s1u_rx_pdus[i]->get_tailroom();
+    msgs[i]                    = {};
+    msgs[i].msg_hdr.msg_iov    = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int n_recv = recvmmsg(worker.s1u, msgs.data(), MAX_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+  if (n_recv < 0) {
+    if (errno != EAGAIN and errno != EWOULDBLOCK) {
+      m_logger.error("Error reading from S1-U socket: %s", strerror(errno));
+    }
+    return;
+  }
+  for (int i = 0; i < n_recv; ++i) {
+    worker.s1u_rx_pdus[i]->N_bytes = msgs[i].msg_len;
+    handle_s1u_pdu(worker, worker.s1u_rx_pdus[i].get());
+  }
+}
+
+void spgw::gtpu::handle_s1u_gro_pdus(up_worker_t& worker)
+{
+  // Each message may hold several datagrams of the same flow, coalesced by the kernel and split every gro_size bytes
+  srsran::byte_buffer_t* pdu = worker.s1u_rx_pdus[0].get();
+  for (uint32_t i = 0; i < MAX_BATCH_SIZE; ++i) {
+    union {
+      char           buf[CMSG_SPACE(sizeof(int))];
+      struct cmsghdr align;
+    } ctrl;
+    struct iovec  iov = {worker.s1u_gro_buf.data(), worker.s1u_gro_buf.size()};
+    struct msghdr msg = {};
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = ctrl.buf;
+    msg.msg_controllen = sizeof(ctrl.buf);
+
+    ssize_t n_bytes = recvmsg(worker.s1u, &msg, MSG_DONTWAIT);
+    if (n_bytes < 0) {
+      if (errno != EAGAIN and errno != EWOULDBLOCK) {
+        m_logger.error("Error reading from S1-U socket: %s", strerror(errno));
+      }
+      return;
+    }
+    uint32_t gro_size = srsran::net_utils::get_udp_gro_size(&msg, n_bytes);
+    for (uint32_t offset = 0; offset < n_bytes; offset += gro_size) {
+      uint32_t len = std::min(gro_size, (uint32_t)n_bytes - offset);
+      pdu->clear();
+      if (len > pdu->get_tailroom()) {
+        m_logger.error("S1-U PDU too large. Bytes=%d", len);
+        continue;
+      }
+      memcpy(pdu->msg, &worker.s1u_gro_buf[offset], len);
+      pdu->N_bytes = len;
+      handle_s1u_pdu(worker, pdu);
+    }
+  }
+}
+
+void spgw::gtpu::handle_sgi_pdu(up_worker_t& worker, const tunnel_table_t& tunnels, srsran::unique_byte_buffer_t msg)
 {
   bool usr_found = false;
   bool ctr_found = false;
 
-  std::map<uint32_t, srsran::gtpc_f_teid_ie>::iterator gtpu_fteid_it;
-  std::map<in_addr_t, uint32_t>::iterator              gtpc_teid_it;
-  srsran::gtpc_f_teid_ie                               enb_fteid;
-  uint32_t                                             spgw_teid;
-  struct iphdr*                                        iph = (struct iphdr*)msg->msg;
+  s1u_tunnel_t  tunnel = {};
+  uint32_t      spgw_teid;
+  struct iphdr* iph = (struct iphdr*)msg->msg;
   m_logger.debug("Received SGi PDU. Bytes %d", msg->N_bytes);
 
   if (iph->version != 4) {
@@ -234,21 +410,27 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
 
   // Find user and control tunnel
-  gtpu_fteid_it = m_ip_to_usr_teid.find(iph->daddr);
-  if (gtpu_fteid_it != m_ip_to_usr_teid.end()) {
+  const s1u_tunnel_t* usr_tunnel = tunnels.ip_to_usr_teid.find(iph->daddr);
+  if (usr_tunnel != nullptr) {
     usr_found = true;
-    enb_fteid = gtpu_fteid_it->second;
+    tunnel    = *usr_tunnel;
   }
-  gtpc_teid_it = m_ip_to_ctr_teid.find(iph->daddr);
-  if (gtpc_teid_it != m_ip_to_ctr_teid.end()) {
+  const uint32_t* ctr_teid = tunnels.ip_to_ctr_teid.find(iph->daddr);
+  if (ctr_teid != nullptr) {
     ctr_found = true;
-    spgw_teid = gtpc_teid_it->second;
+    spgw_teid = *ctr_teid;
   }
 
   // Handle SGi packet
   if (usr_found == false && ctr_found == false) {
     m_logger.debug("Packet for unknown UE.");
   } else if (usr_found == false && ctr_found == true) {
+    // The GTP-C state is shared with the S11 interface, which may have set up the user plane tunnel since the lookup
+    std::lock_guard<std::mutex> lock(m_spgw->m_gtpc_mutex);
+    if (find_usr_tunnel(iph->daddr, &tunnel)) {
+      send_s1u_pdu(worker, tunnel, std::move(msg));
+      return;
+    }
     m_logger.debug("Packet for attached UE that is not ECM connected.");
     m_logger.debug("Triggering Donwlink Notification Requset.");
     m_gtpc->send_downlink_data_notification(spgw_teid);
@@ -257,18 +439,41 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   } else if (usr_found == true && ctr_found == false) {
     m_logger.error("User plane tunnel found without a control plane tunnel present.");
   } else {
-    send_s1u_pdu(enb_fteid, msg.get());
+    send_s1u_pdu(worker, tunnel, std::move(msg));
   }
 }
 
-void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
+bool spgw::gtpu::find_usr_tunnel(in_addr_t ue_ipv4, s1u_tunnel_t* usr_tunnel)
+{
+  std::shared_ptr<const tunnel_table_t> tunnels = get_tunnels();
+  const s1u_tunnel_t*                   tunnel  = tunnels->ip_to_usr_teid.find(ue_ipv4);
+  if (tunnel == nullptr) {
+    return false;
+  }
+  *usr_tunnel = *tunnel;
+  return true;
+}
+
+spgw::gtpu::s1u_tunnel_t spgw::gtpu::make_s1u_tunnel(const srsran::gtp_fteid_t& enb_fteid)
+{
+  s1u_tunnel_t tunnel;
+  tunnel.enb_fteid                = enb_fteid;
+  tunnel.enb_addr                 = {};
+  tunnel.enb_addr.sin_family      = AF_INET;
+  tunnel.enb_addr.sin_port        = htons(GTPU_RX_PORT);
+  tunnel.enb_addr.sin_addr.s_addr = enb_fteid.ipv4;
+  tunnel.gpdu_hdr                 = srsran::gtpu_make_gpdu_header_template(enb_fteid.teid);
+  return tunnel;
+}
+
+void spgw::gtpu::handle_s1u_pdu(up_worker_t& worker, srsran::byte_buffer_t* msg)
 {
   srsran::gtpu_header_t header;
   srsran::gtpu_read_header(msg, &header, m_logger);
 
   m_logger.debug("Received PDU from S1-U. Bytes=%d", msg->N_bytes);
   m_logger.debug("TEID 0x%x. Bytes=%d", header.teid, msg->N_bytes);
-  int n = write(m_sgi, msg->msg, msg->N_bytes);
+  int n = write(worker.sgi, msg->msg, msg->N_bytes);
   if (n < 0) {
     m_logger.error("Could not write to TUN interface.");
   } else {
@@ -277,59 +482,91 @@ void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
   return;
 }
 
-void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)
+void spgw::gtpu::send_s1u_pdu(up_worker_t& worker, const s1u_tunnel_t& tunnel, srsran::unique_byte_buffer_t msg)
 {
-  // Set eNB destination address
-  struct sockaddr_in enb_addr;
-  enb_addr.sin_family      = AF_INET;
-  enb_addr.sin_port        = htons(GTPU_RX_PORT);
-  enb_addr.sin_addr.s_addr = enb_fteid.ipv4;
-
-  // Setup GTP-U header
-  srsran::gtpu_header_t header;
-  header.flags        = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
-  header.message_type = GTPU_MSG_DATA_PDU;
-  header.length       = msg->N_bytes;
-  header.teid         = enb_fteid.teid;
-
   m_logger.debug("User plane tunnel found SGi PDU. Forwarding packet to S1-U.");
-  m_logger.debug("eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", inet_ntoa(enb_addr.sin_addr), enb_fteid.teid);
+  m_logger.debug(
+      "eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", inet_ntoa(tunnel.enb_addr.sin_addr), tunnel.enb_fteid.teid);
 
   // Write header into packet
-  int n;
-  if (!srsran::gtpu_write_header(&header, msg, m_logger)) {
+  if (!srsran::gtpu_write_gpdu_header(tunnel.gpdu_hdr, msg.get(), m_logger)) {
     m_logger.error("Error writing GTP-U header on PDU");
-    goto out;
+    return;
   }
 
-  // Send packet to destination
-  n = sendto(m_s1u, msg->msg, msg->N_bytes, 0, (struct sockaddr*)&enb_addr, sizeof(enb_addr));
-  if (n < 0) {
-    m_logger.error("Error sending packet to eNB");
-  } else if ((unsigned int)n != msg->N_bytes) {
-    m_logger.error("Mis-match between packet bytes and sent bytes: Sent: %d/%d", n, msg->N_bytes);
+  worker.s1u_tx_pdus.push_back({std::move(msg), tunnel.enb_addr});
+  if (worker.s1u_tx_pdus.size() >= MAX_BATCH_SIZE) {
+    flush_s1u_pdus(worker);
   }
+}
 
-out:
-  m_logger.debug("Deallocating packet after sending S1-U message");
-  return;
+void spgw::gtpu::flush_s1u_pdus(up_worker_t& worker)
+{
+  if (worker.s1u_tx_pdus.empty()) {
+    return;
+  }
+  static_assert(MAX_BATCH_SIZE <= srsran::net_utils::max_send_datagrams, "Batch too large for send_datagrams()");
+  std::array<struct iovec, MAX_BATCH_SIZE> iovs;
+  std::array<sockaddr_in, MAX_BATCH_SIZE>  addrs;
+  for (uint32_t i = 0; i < worker.s1u_tx_pdus.size(); ++i) {
+    iovs[i].iov_base = worker.s1u_tx_pdus[i].pdu->msg;
+    iovs[i].iov_len  = worker.s1u_tx_pdus[i].pdu->N_bytes;
+    addrs[i]         = worker.s1u_tx_pdus[i].addr;
+  }
+
+  // The PDUs of a burst toward the same eNB are sent as UDP GSO messages, if supported by the kernel
+  uint32_t nof_sent = srsran::net_utils::send_datagrams(
+      worker.s1u, iovs.data(), addrs.data(), worker.s1u_tx_pdus.size(), worker.s1u_gso);
+  m_logger.debug("Sent %d/%zd S1-U PDUs", nof_sent, worker.s1u_tx_pdus.size());
+  worker.s1u_tx_pdus.clear();
 }
 
 void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
                                          std::queue<srsran::unique_byte_buffer_t>& pkt_queue)
 {
   m_logger.debug("Sending all queued packets");
+  // Called by the S11 interface, so the packets are sent by the worker of the SPGW thread
+  up_worker_t&       worker = m_workers[0];
+  const s1u_tunnel_t tunnel = make_s1u_tunnel(dw_user_fteid);
   while (!pkt_queue.empty()) {
-    srsran::unique_byte_buffer_t msg = std::move(pkt_queue.front());
-    send_s1u_pdu(dw_user_fteid, msg.get());
+    send_s1u_pdu(worker, tunnel, std::move(pkt_queue.front()));
     pkt_queue.pop();
   }
+  flush_s1u_pdus(worker);
   return;
 }
 
 /*
  * Tunnel managment
  */
+std::shared_ptr<const spgw::gtpu::tunnel_table_t> spgw::gtpu::get_tunnels()
+{
+  srsran::rwlock_read_guard lock(m_tunnel_rwlock);
+  return m_tunnels;
+}
+
+spgw::gtpu::tunnel_table_t& spgw::gtpu::get_staged_tunnels()
+{
+  // The first update of a batch copies the published tables
+  if (m_staged_tunnels == nullptr) {
+    m_staged_tunnels.reset(new tunnel_table_t(*get_tunnels()));
+  }
+  return *m_staged_tunnels;
+}
+
+void spgw::gtpu::publish_tunnel_updates()
+{
+  if (m_staged_tunnels == nullptr) {
+    return;
+  }
+  std::shared_ptr<const tunnel_table_t> tunnels(m_staged_tunnels.release());
+  {
+    srsran::rwlock_write_guard lock(m_tunnel_rwlock);
+    std::swap(m_tunnels, tunnels);
+  }
+  // The previous tables are released here, or by the last worker still reading them
+}
+
 bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw_user_fteid, uint32_t up_ctrl_teid)
 {
   m_logger.info("Modifying GTP-U Tunnel.");
@@ -340,17 +577,16 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
   srsran::gtpu_ntoa(buffer, dw_user_fteid.ipv4);
   m_logger.info("Downlink eNB addr %s, U-TEID 0x%x", srsran::to_c_str(buffer), dw_user_fteid.teid);
   m_logger.info("Uplink C-TEID: 0x%x", up_ctrl_teid);
-  m_ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
-  m_ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
+  tunnel_table_t& tunnels = get_staged_tunnels();
+  tunnels.ip_to_usr_teid.insert_or_assign(ue_ipv4, make_s1u_tunnel(dw_user_fteid));
+  tunnels.ip_to_ctr_teid.insert_or_assign(ue_ipv4, up_ctrl_teid);
   return true;
 }
 
 bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 {
   // Remove GTP-U connections, if any.
-  if (m_ip_to_usr_teid.count(ue_ipv4)) {
-    m_ip_to_usr_teid.erase(ue_ipv4);
-  } else {
+  if (not get_staged_tunnels().ip_to_usr_teid.erase(ue_ipv4)) {
     m_logger.error("Could not find GTP-U Tunnel to delete.");
     return false;
   }
@@ -360,9 +596,7 @@ bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 bool spgw::gtpu::delete_gtpc_tunnel(in_addr_t ue_ipv4)
 {
   // Remove Ctrl TEID from IP mapping.
-  if (m_ip_to_ctr_teid.count(ue_ipv4)) {
-    m_ip_to_ctr_teid.erase(ue_ipv4);
-  } else {
+  if (not get_staged_tunnels().ip_to_ctr_teid.erase(ue_ipv4)) {
     m_logger.error("Could not find GTP-C Tunnel info to delete.");
     return false;
   }
@@ -24,6 +24,7 @@
 #include "srsepc/hdr/spgw/gtpc.h"
 #include "srsepc/hdr/spgw/gtpu.h"
 #include "srsran/upper/gtpu.h"
+#include <atomic>
 #include <inttypes.h> // for printing uint64_t
 
 namespace srsepc {
@@ -31,6 +32,65 @@ namespace srsepc {
 spgw*           spgw::m_instance    = NULL;
 pthread_mutex_t spgw_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+/**************************************
+ *
+ * User-plane worker thread, forwarding
+ * the packets of one TUN queue and one
+ * S1-U socket
+ *
+ **************************************/
+
+class spgw::up_worker_thread : public srsran::thread
+{
+public:
+  up_worker_thread(spgw::gtpu* gtpu_, uint32_t worker_idx_) :
+    thread("SPGW_UP" + std::to_string(worker_idx_)), gtpu(gtpu_), worker_idx(worker_idx_)
+  {}
+
+  void stop()
+  {
+    if (running) {
+      running = false;
+      thread_cancel();
+      wait_thread_finish();
+    }
+  }
+
+private:
+  void run_thread()
+  {
+    running = true;
+
+    int sgi = gtpu->get_sgi(worker_idx);
+    int s1u = gtpu->get_s1u(worker_idx);
+
+    fd_set set;
+    int    max_fd = std::max(s1u, sgi);
+    while (running) {
+      FD_ZERO(&set);
+      FD_SET(s1u, &set);
+      FD_SET(sgi, &set);
+
+      int n = select(max_fd + 1, &set, NULL, NULL, NULL);
+      if (n == -1) {
+        logger.error("Error from select");
+      } else if (n) {
+        if (FD_ISSET(sgi, &set)) {
+          gtpu->handle_sgi_pdus(worker_idx);
+        }
+        if (FD_ISSET(s1u, &set)) {
+          gtpu->handle_s1u_pdus(worker_idx);
+        }
+      }
+    }
+  }
+
+  spgw::gtpu*           gtpu;
+  uint32_t              worker_idx;
+  std::atomic<bool>     running = {false};
+  srslog::basic_logger& logger  = srslog::fetch_basic_logger("SPGW");
+};
+
 spgw::spgw() : m_running(false), thread("SPGW")
 {
   m_gtpc = new spgw::gtpc;
@@ -81,6 +141,12 @@ int spgw::init(spgw_args_t* args, const std::map<std::string, uint64_t>& ip_to_i
     return SRSRAN_ERROR_CANT_START;
   }
 
+  // Worker 0 runs in the SPGW thread
+  for (uint32_t i = 1; i < m_gtpu->get_nof_workers(); ++i) {
+    m_up_threads.emplace_back(new up_worker_thread(m_gtpu, i));
+    m_up_threads.back()->start();
+  }
+
   m_logger.info("SP-GW Initialized.");
   srsran::console("SP-GW Initialized.\n");
   return SRSRAN_SUCCESS;
@@ -93,6 +159,10 @@ void spgw::stop()
     thread_cancel();
     wait_thread_finish();
   }
+  for (std::unique_ptr<up_worker_thread>& up_thread : m_up_threads) {
+    up_thread->stop();
+  }
+  m_up_threads.clear();
 
   m_gtpu->stop();
   m_gtpc->stop();
@@ -103,16 +173,13 @@ void spgw::run_thread()
 {
   // Mark the thread as running
   m_running = true;
-  srsran::unique_byte_buffer_t sgi_msg, s1u_msg, s11_msg;
-  s1u_msg = srsran::make_byte_buffer("spgw::run_thread::s1u");
+  srsran::unique_byte_buffer_t s11_msg;
   s11_msg = srsran::make_byte_buffer("spgw::run_thread::s11");
 
-  struct sockaddr_in src_addr_in;
   struct sockaddr_un src_addr_un;
-  struct iphdr*      ip_pkt;
 
-  int sgi = m_gtpu->get_sgi();
-  int s1u = m_gtpu->get_s1u();
+  int sgi = m_gtpu->get_sgi(0);
+  int s1u = m_gtpu->get_s1u(0);
   int s11 = m_gtpc->get_s11();
 
   size_t buf_len = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
@@ -121,9 +188,6 @@ void spgw::run_thread()
   int    max_fd = std::max(s1u, sgi);
   max_fd        = std::max(max_fd, s11);
   while (m_running) {
-    s1u_msg->clear();
-    s11_msg->clear();
-
     FD_ZERO(&set);
     FD_SET(s1u, &set);
     FD_SET(sgi, &set);
@@ -133,31 +197,32 @@ void spgw::run_thread()
     if (n == -1) {
       m_logger.error("Error from select");
     } else if (n) {
+      // The user plane interfaces are drained in batches, to save one select() per packet
       if (FD_ISSET(sgi, &set)) {
-        /*
-         * SGi messages may need to be queued when waiting for UE Paging procedure.
-         * For this reason, buffers for SGi pdus are allocated here and deallocated
-         * at the gtpu::send_s1u_pdu() when the PDU is sent, at handle_sgi_pdu() when the PDU is dropped or at
-         * gtpc::free_all_queued_packets, which is called when the Downlink Data Notification
-         * procedure fails (see handle_downlink_data_notification_acknowledgment and
-         * handle_downlink_data_notification_failure)
-         */
         m_logger.debug("Message received at SPGW: SGi Message");
-        sgi_msg          = srsran::make_byte_buffer("spgw::run_thread::sgi_msg");
-        sgi_msg->N_bytes = read(sgi, sgi_msg->msg, buf_len);
-        m_gtpu->handle_sgi_pdu(std::move(sgi_msg));
+        m_gtpu->handle_sgi_pdus(0);
       }
       if (FD_ISSET(s1u, &set)) {
         m_logger.debug("Message received at SPGW: S1-U Message");
-        socklen_t addrlen = sizeof(src_addr_in);
-        s1u_msg->N_bytes  = recvfrom(s1u, s1u_msg->msg, buf_len, 0, (struct sockaddr*)&src_addr_in, &addrlen);
-        m_gtpu->handle_s1u_pdu(s1u_msg.get());
+        m_gtpu->handle_s1u_pdus(0);
       }
       if (FD_ISSET(s11, &set)) {
-        m_logger.debug("Message received at SPGW: S11 Message");
-        socklen_t addrlen = sizeof(src_addr_un);
-        s11_msg->N_bytes  = recvfrom(s11, s11_msg->msg, buf_len, 0, (struct sockaddr*)&src_addr_un, &addrlen);
-        m_gtpc->handle_s11_pdu(s11_msg.get());
+        // During a mass attach the pending GTP-C messages are handled in one go, and their tunnel updates are
+        // published to the user-plane workers at once
+        std::lock_guard<std::mutex> lock(m_gtpc_mutex);
+        for (uint32_t i = 0; i < MAX_S11_BATCH_SIZE; ++i) {
+          s11_msg->clear();
+          socklen_t addrlen = sizeof(src_addr_un);
+          ssize_t   n_bytes =
+              recvfrom(s11, s11_msg->msg, buf_len, i == 0 ? 0 : MSG_DONTWAIT, (struct sockaddr*)&src_addr_un, &addrlen);
+          if (n_bytes <= 0) {
+            break;
+          }
+          m_logger.debug("Message received at SPGW: S11 Message");
+          s11_msg->N_bytes = n_bytes;
+          m_gtpc->handle_s11_pdu(s11_msg.get());
+        }
+        m_gtpu->publish_tunnel_updates();
       }
     } else {
       m_logger.debug("No data from select.");
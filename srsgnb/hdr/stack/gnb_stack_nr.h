@@ -80,6 +80,7 @@ public:
 
   // Temporary GW interface
   void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) override;
+  void write_sdus(uint32_t lcid, std::vector<srsran::unique_byte_buffer_t> sdus) override;
   bool has_active_radio_bearer(uint32_t eps_bearer_id) override;
   bool switch_on();
   void tti_clock() override;
@@ -118,9 +119,11 @@ public:
     auto task = [this, rnti, lcid, pdcp_sn](srsran::unique_byte_buffer_t& sdu) {
       pdcp.write_sdu(rnti, lcid, std::move(sdu), pdcp_sn);
     };
-    gtpu_task_queue.push(std::bind(task, std::move(sdu)));
+    auto bound_task = std::bind(task, std::move(sdu));
+    static_assert(srsran::move_task_t::fits_small_buffer<decltype(bound_task)>(), "SDU task must not be allocated");
+    gtpu_task_queue.push(std::move(bound_task));
   }
-  std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) final
+  std::vector<srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) final
   {
     // TODO: make it thread-safe. For now, this function is unused
     return pdcp.get_buffered_pdus(rnti, lcid);
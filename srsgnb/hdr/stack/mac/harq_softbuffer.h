@@ -30,6 +30,7 @@ extern "C" {
 #include "srsran/phy/phch/sch_nr.h"
 #include "srsran/phy/utils/vector.h"
 }
+#include <vector>
 
 namespace srsenb {
 
@@ -82,7 +83,7 @@ public:
   explicit rx_harq_softbuffer(uint32_t nof_prb_)
   {
     // Note: for now we use same size regardless of nof_prb_
-    srsran_softbuffer_rx_init_guru(&buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
+    srsran_softbuffer_rx_init_guru_c(&buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
   }
   rx_harq_softbuffer(const rx_harq_softbuffer&) = delete;
   rx_harq_softbuffer(rx_harq_softbuffer&& other) noexcept
@@ -131,6 +132,9 @@ public:
   srsran::unique_pool_ptr<tx_harq_softbuffer> get_tx(uint32_t nof_prb);
   srsran::unique_pool_ptr<rx_harq_softbuffer> get_rx(uint32_t nof_prb);
 
+  /// Appends the occupancy of the TX and RX softbuffer pools of each initialized bandwidth
+  void get_metrics(std::vector<srsran::pool_metrics_t>& metrics) const;
+
   static harq_softbuffer_pool& get_instance()
   {
     static harq_softbuffer_pool pool;
@@ -58,9 +58,12 @@ public:
   void ul_crc_info(uint16_t rnti, uint32_t cc, uint32_t pid, bool crc) override;
   void ul_sr_info(uint16_t rnti) override;
   void ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr) override;
+  void ul_sdu_info(uint16_t rnti, uint32_t lcid, uint32_t nof_bytes) override;
   void dl_buffer_state(uint16_t rnti, uint32_t lcid, uint32_t newtx, uint32_t retx);
   void dl_mac_ce(uint16_t rnti, uint32_t ce_lcid) override;
   void dl_cqi_info(uint16_t rnti, uint32_t cc, uint32_t cqi_value);
+  void dl_pmi_info(uint16_t rnti, uint32_t cc, uint32_t ri_value, uint32_t pmi_value);
+  void ul_snr_info(uint16_t rnti, uint32_t cc, float snr_db);
 
   /// Called once per slot in a non-concurrent fashion
   void      slot_indication(slot_point slot_tx) override;
@@ -107,7 +107,12 @@ public:
                                   uint32_t                                aggr_idx,
                                   prb_interval                            interv,
                                   srsran::const_span<dl_sched_rar_info_t> pending_rars);
-  alloc_result alloc_pdsch(slot_ue& ue, uint32_t ss_id, const prb_grant& dl_grant);
+  /**
+   * @brief Allocates a UE PDSCH and its PDCCH and PUCCH resources
+   * @param mu_layer 0 for a single-user grant on free PRBs. Otherwise, the DMRS port of a MU-MIMO new transmission with
+   *                 DCI format 1_1, co-scheduled on the PRBs of a previous grant, which uses port 0
+   */
+  alloc_result alloc_pdsch(slot_ue& ue, uint32_t ss_id, const prb_grant& dl_grant, uint32_t mu_layer = 0);
   alloc_result alloc_pusch(slot_ue& ue, const prb_grant& grant);
 
   slot_point           get_pdcch_tti() const { return pdcch_slot; }
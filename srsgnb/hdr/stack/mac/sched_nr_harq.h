@@ -148,6 +148,10 @@ public:
   const dl_harq_proc& dl_harq(uint32_t pid) const { return dl_harqs[pid]; }
   const ul_harq_proc& ul_harq(uint32_t pid) const { return ul_harqs[pid]; }
 
+  /// Number of HARQs that were not empty at the start of the slot
+  uint32_t nof_busy_dl_harqs() const { return nof_busy_dl; }
+  uint32_t nof_busy_ul_harqs() const { return nof_busy_ul; }
+
   dl_harq_proc* find_pending_dl_retx()
   {
     return find_dl([this](const dl_harq_proc& h) { return h.has_pending_retx(slot_rx); });
@@ -183,6 +187,7 @@ private:
   srslog::basic_logger& logger;
 
   slot_point                slot_rx;
+  uint32_t                  nof_busy_dl = 0, nof_busy_ul = 0;
   std::vector<dl_harq_proc> dl_harqs;
   std::vector<ul_harq_proc> ul_harqs;
 };
@@ -57,6 +57,16 @@ inline bool is_rnti_type_valid_in_search_space(srsran_rnti_type_t rnti_type, srs
   return false;
 }
 
+/**
+ * @brief Squared correlation |w_a^H w_b|^2 of two rank 1 precoders of the Type I single-panel codebook with N2=1 and
+ * O1=4, TS 38.214 Section 5.2.2.2.1. A value of 0 means the precoders are orthogonal
+ * @param nof_ports Number of CSI-RS antenna ports, 2 or more
+ * @param pmi_a PMI of the first UE, packed as i11 * 4 + i2
+ * @param pmi_b PMI of the second UE, packed as i11 * 4 + i2
+ * @return the squared correlation, between 0 and 1
+ */
+float pmi_correlation(uint32_t nof_ports, uint32_t pmi_a, uint32_t pmi_b);
+
 /// Log UE state for slot being scheduled
 void log_sched_slot_ues(srslog::basic_logger& logger,
                         slot_point            pdcch_slot,
@@ -117,12 +117,17 @@ public:
 
   ///// Configuration /////
   struct sched_args_t {
-    bool        pdsch_enabled      = true;
-    bool        pusch_enabled      = true;
-    bool        auto_refill_buffer = false;
-    int         fixed_dl_mcs       = 28;
-    int         fixed_ul_mcs       = 28;
-    std::string logger_name        = "MAC-NR";
+    bool        pdsch_enabled          = true;
+    bool        pusch_enabled          = true;
+    bool        auto_refill_buffer     = false;
+    int         fixed_dl_mcs           = 28;
+    int         fixed_ul_mcs           = 28;
+    bool        mu_mimo_enabled        = false; ///< Co-schedule rank 1 UEs with low-correlation PMIs on the same PRBs
+    uint32_t    ul_presched_max_bytes  = 0; ///< Max size of the proactive UL grants of periodic traffic, 0 disables
+    uint32_t    ul_presched_max_misses = 2; ///< Unused proactive UL grants before the pre-scheduling backs off
+    std::string sched_policy           = "time_rr"; ///< "time_rr" or "time_pf"
+    std::string sched_policy_args      = "1";       ///< Fairness coefficient of "time_pf"
+    std::string logger_name            = "MAC-NR";
   };
 
   using ue_cc_cfg_t = sched_nr_ue_cc_cfg_t;
@@ -182,6 +187,7 @@ public:
   virtual void ul_crc_info(uint16_t rnti, uint32_t cc, uint32_t pid, bool crc)                  = 0;
   virtual void ul_sr_info(uint16_t rnti)                                                        = 0;
   virtual void ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)                             = 0;
+  virtual void ul_sdu_info(uint16_t rnti, uint32_t lcid, uint32_t nof_bytes)                     = 0;
 
   /**
    * Enqueue MAC CEs for DL transmission
@@ -43,6 +43,9 @@ using coreset_bitmap = srsran::bounded_bitset<SRSRAN_CORESET_FREQ_DOMAIN_RES_SIZ
 class coreset_region
 {
 public:
+  /// Maximum number of DFS nodes visited by a PDCCH allocation attempt, to bound the allocation time
+  static const uint32_t MAX_DFS_STEPS = 256;
+
   coreset_region(const bwp_params_t& bwp_cfg_, uint32_t coreset_id_, uint32_t slot_idx);
   void reset();
 
@@ -92,10 +95,12 @@ private:
   };
   using alloc_tree_dfs_t = std::vector<tree_node>;
   alloc_tree_dfs_t dfs_tree, saved_dfs_tree;
+  uint32_t         nof_dfs_steps = 0;
 
   srsran::span<const uint32_t> get_cce_loc_table(const alloc_record& record) const;
   bool                         alloc_dfs_node(const alloc_record& record, uint32_t dci_idx);
   bool                         get_next_dfs();
+  void                         backjump_dfs(const alloc_record& record);
 };
 
 using pdcch_dl_alloc_result = srsran::expected<pdcch_dl_t*, alloc_result>;
@@ -142,10 +147,14 @@ public:
    * @param ss_id Search space ID
    * @param aggr_idx Aggregation level index (0..4)
    * @param user UE object parameters
+   * @param dci_fmt DL DCI format, it must be supported by the search space
    * @return PDCCH object with dci context filled if the allocation was successful. nullptr otherwise
    */
-  pdcch_dl_alloc_result
-  alloc_dl_pdcch(srsran_rnti_type_t rnti_type, uint32_t ss_id, uint32_t aggr_idx, const ue_carrier_params_t& user);
+  pdcch_dl_alloc_result alloc_dl_pdcch(srsran_rnti_type_t         rnti_type,
+                                       uint32_t                   ss_id,
+                                       uint32_t                   aggr_idx,
+                                       const ue_carrier_params_t& user,
+                                       srsran_dci_format_nr_t     dci_fmt = srsran_dci_format_nr_1_0);
 
   /**
    * @brief Allocates RE space for UL DCI in PDCCH, avoiding in the process collisions with other PDCCH allocations
@@ -64,11 +64,13 @@ public:
   /// Verifies if the input arguments are valid for an RAR allocation and grant doesnt collide with other grants
   alloc_result is_rar_grant_valid(const prb_grant& grant) const;
 
-  /// Verifies if the input arguments are valid for an UE allocation and grant doesnt collide with other grants
+  /// Verifies if the input arguments are valid for an UE allocation and grant doesnt collide with other grants. A
+  /// co-scheduled (MU-MIMO) grant reuses the PRBs of previous UE grants, so the collision check is skipped
   alloc_result is_ue_grant_valid(const ue_carrier_params_t& ue,
                                  uint32_t                   ss_id,
                                  srsran_dci_format_nr_t     dci_fmt,
-                                 const prb_grant&           grant) const;
+                                 const prb_grant&           grant,
+                                 bool                       co_scheduled = false) const;
 
   /**
    * @brief Tries to allocate UE PDSCH grant. Ensures that there are no collisions with other previous PDSCH allocations
@@ -124,7 +126,8 @@ private:
   alloc_result is_grant_valid_common(srsran_search_space_type_t ss_type,
                                      srsran_dci_format_nr_t     dci_fmt,
                                      uint32_t                   coreset_id,
-                                     const prb_grant&           grant) const;
+                                     const prb_grant&           grant,
+                                     bool                       co_scheduled = false) const;
   pdsch_t&     alloc_pdsch_unchecked(uint32_t                   coreset_id,
                                      srsran_search_space_type_t ss_type,
                                      srsran_dci_format_nr_t     dci_fmt,
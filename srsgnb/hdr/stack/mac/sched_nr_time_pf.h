@@ -0,0 +1,106 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_TIME_PF_H
+#define SRSRAN_SCHED_NR_TIME_PF_H
+
+#include "sched_nr_time_rr.h"
+#include <array>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/**
+ * Proportional fair scheduler. The UEs are served in decreasing order of expected rate, derived from the DL CQI and
+ * the UL SINR, over average allocated rate, weighted by the QoS urgency of their bearers. Retransmissions go first.
+ * Each new transmission only gets the PRBs its pending data needs, so that several UEs share a slot
+ */
+class sched_nr_time_pf : public sched_nr_base
+{
+public:
+  explicit sched_nr_time_pf(const bwp_params_t& bwp_cfg_);
+
+  void sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+  void sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+
+private:
+  /// Nominal number of PDSCH/PUSCH REs of a PRB, used to turn spectral efficiencies into bytes per PRB
+  static const uint32_t nof_re_per_prb = SRSRAN_NRE * 11;
+  static const uint32_t nof_mcs        = 29;
+  static const int      min_snr_db     = -10;
+  static const int      max_snr_db     = 30;
+
+  /// Exponential average of the bytes allocated to a UE per slot in one direction
+  class avg_rate
+  {
+  public:
+    float get() const { return nof_samples == 0 ? 0 : avg; }
+    void  save_alloc(uint32_t alloc_bytes, float alpha);
+    //! Age the average with the slots the UE was not a candidate, as if nothing had been allocated in them
+    void save_idle_slots(uint32_t nof_slots, float alpha);
+
+    uint64_t last_slot_count = 0; ///< Last slot the UE was a candidate
+
+  private:
+    float    avg         = 0;
+    uint32_t nof_samples = 0;
+  };
+
+  struct ue_ctxt {
+    explicit ue_ctxt(uint16_t rnti_) : rnti(rnti_) {}
+
+    uint16_t rnti;
+    avg_rate dl_rate, ul_rate;
+
+    // MCS cached from the last CQI, so that it is only looked up when the UE reports a new one
+    uint32_t last_dl_cqi = 0;
+    int      dl_mcs      = 0;
+  };
+
+  struct ue_candidate {
+    ue_ctxt* ctxt;
+    slot_ue* ue;
+    bool     retx;
+    float    prio;
+  };
+
+  ue_ctxt& get_ue_ctxt(uint16_t rnti, uint64_t slot_count, bool dl);
+  void     sort_candidates();
+  int      get_dl_mcs(ue_ctxt& ctxt, const slot_ue& ue) const;
+  float    ul_bytes_per_prb(const slot_ue& ue) const;
+  float    pf_priority(float rate, float avg_rate, float qos_urgency) const;
+
+  float fairness_coeff = 1;
+
+  // Bytes per PRB of each MCS of the 64QAM table, and of each integer UL SINR in dB
+  std::array<float, nof_mcs>                     mcs_bytes_per_prb;
+  std::array<float, max_snr_db - min_snr_db + 1> snr_bytes_per_prb;
+
+  uint64_t dl_slot_count = 0, ul_slot_count = 0; ///< Slots scheduled, they do not wrap-around as slot_point
+
+  rnti_map_t<ue_ctxt>       ue_history_db;
+  std::vector<ue_candidate> candidates;
+};
+
+} // namespace sched_nr_impl
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_TIME_PF_H
@@ -28,6 +28,7 @@
 #include "sched_ue/ue_cfg_manager.h"
 #include "srsenb/hdr/stack/mac/common/base_ue_buffer_manager.h"
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
+#include "srsenb/hdr/stack/mac/common/ul_presched_predictor.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/move_callback.h"
 #include "srsran/adt/pool/cached_alloc.h"
@@ -50,11 +51,14 @@ public:
   using base_type::get_bsr_state;
   using base_type::get_dl_prio_tx;
   using base_type::get_dl_tx;
+  using base_type::get_dl_qos_urgency;
   using base_type::get_dl_tx_total;
+  using base_type::get_ul_qos_urgency;
   using base_type::is_bearer_active;
   using base_type::is_bearer_dl;
   using base_type::is_bearer_ul;
   using base_type::is_lcg_active;
+  using base_type::new_qos_period;
   using base_type::ul_bsr;
 
   int get_dl_tx_total() const;
@@ -83,6 +87,8 @@ public:
 struct ue_context_common {
   uint32_t pending_dl_bytes = 0;
   uint32_t pending_ul_bytes = 0;
+  float    dl_qos_urgency   = 0;
+  float    ul_qos_urgency   = 0;
 };
 
 class slot_ue;
@@ -108,7 +114,10 @@ public:
 
   // Channel state
   uint32_t dl_cqi = 1;
-  uint32_t ul_cqi = 0;
+  uint32_t ul_cqi    = 0;
+  float    ul_snr_db = 5;  ///< Average PUSCH SINR
+  uint32_t dl_ri     = 0;  ///< Wideband RI of the last CSI report, 0 for one layer
+  int      dl_pmi    = -1; ///< Wideband PMI of the last CSI report, -1 until it is reported
 
   harq_entity harq_ent;
 
@@ -147,6 +156,12 @@ public:
   /// UE state feedback
   void ul_bsr(uint32_t lcg, uint32_t bsr_val) { buffers.ul_bsr(lcg, bsr_val); }
   void ul_sr_info() { last_sr_slot = last_tx_slot - TX_ENB_DELAY; }
+  void ul_sdu_info(uint32_t lcid, uint32_t nof_bytes)
+  {
+    if (srsran::is_nr_drb(lcid)) {
+      ul_presched.ul_data_rx(nof_bytes);
+    }
+  }
 
   bool has_ca() const
   {
@@ -165,11 +180,16 @@ private:
 
   ue_cfg_manager ue_cfg;
 
+  /// Slots between a UL grant and the reception of its PUSCH data, with margin for the decoding and event processing
+  static const uint32_t ul_presched_rx_window = 2 * TX_ENB_DELAY + 4;
+
   slot_point        last_tx_slot;
   slot_point        last_sr_slot;
+  slot_point        last_presched_slot;
   ue_context_common common_ctxt;
 
-  ue_buffer_manager buffers;
+  ue_buffer_manager     buffers;
+  ul_presched_predictor ul_presched{ul_presched_rx_window};
 };
 
 class slot_ue
@@ -200,9 +220,13 @@ public:
   /// Channel Information Getters
   uint32_t dl_cqi() const { return ue->dl_cqi; }
   uint32_t ul_cqi() const { return ue->ul_cqi; }
+  float    ul_snr_db() const { return ue->ul_snr_db; }
+  uint32_t dl_ri() const { return ue->dl_ri; }
+  int      dl_pmi() const { return ue->dl_pmi; }
 
   // UE parameters common to all sectors
   uint32_t dl_bytes = 0, ul_bytes = 0;
+  float    dl_qos_urgency = 0, ul_qos_urgency = 0; ///< GBR deficit and delay budget urgency of the UE bearers
 
   // UE parameters that are sector specific
   bool          dl_active;
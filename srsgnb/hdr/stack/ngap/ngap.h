@@ -125,6 +125,9 @@ private:
 
   asn1::ngap::ng_setup_resp_s ngsetupresponse;
 
+  // Memory of the members of the last received PDU, so that decoding does not call malloc
+  asn1::decode_arena rx_pdu_arena;
+
   int  build_tai_cgi();
   bool connect_amf();
   bool setup_ng();
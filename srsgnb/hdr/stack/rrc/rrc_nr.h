@@ -31,6 +31,7 @@
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/task_scheduler.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/common/timeout.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
@@ -163,6 +164,10 @@ private:
   rnti_map_t<std::unique_ptr<ue> > users;
   bool                             running = false;
 
+  // Threads that pack the DL-DCCH messages of the UEs. The packed PDUs are returned to the stack thread
+  std::unique_ptr<srsran::task_thread_pool> pack_workers;
+  uint32_t                                  next_dl_dcch_seq = 0;
+
   /// Private Methods
   void handle_pdu(uint16_t rnti, uint32_t lcid, srsran::const_byte_span pdu);
   void handle_ul_ccch(uint16_t rnti, srsran::const_byte_span pdu);
@@ -69,6 +69,7 @@ struct rrc_nr_cfg_five_qi_t {
 struct rrc_nr_cfg_t {
   rrc_cell_list_nr_t cell_list;
   uint32_t           inactivity_timeout_ms = 100000;
+  uint32_t           nof_pack_workers      = 0; ///< Threads that pack the DL-DCCH messages (0 to pack them inline)
   uint32_t           enb_id;
   uint16_t           mcc;
   uint16_t           mnc;
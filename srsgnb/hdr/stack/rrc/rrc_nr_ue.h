@@ -105,6 +105,8 @@ public:
 private:
   int send_dl_ccch(const asn1::rrc_nr::dl_ccch_msg_s& dl_ccch_msg);
   int send_dl_dcch(srsran::nr_srb srb, const asn1::rrc_nr::dl_dcch_msg_s& dl_dcch_msg);
+  int send_dl_dcch_async(srsran::nr_srb srb, const asn1::rrc_nr::dl_dcch_msg_s& dl_dcch_msg);
+  void handle_dl_dcch_packed(uint32_t seq, srsran::unique_byte_buffer_t pdu);
 
   /** TS 38.331 - 5.3.3 RRC connection establishment */
   void send_rrc_setup();
@@ -192,6 +194,16 @@ private:
   asn1::rrc_nr::radio_bearer_cfg_s          radio_bearer_cfg, next_radio_bearer_cfg;
   std::vector<srsran::unique_byte_buffer_t> nas_pdu_queue;
 
+  // DL-DCCH messages being packed by the RRC pack workers, in order of transmission
+  struct pending_dl_dcch_t {
+    uint32_t                                           seq;
+    srsran::nr_srb                                     srb;
+    std::shared_ptr<const asn1::rrc_nr::dl_dcch_msg_s> msg;
+    srsran::unique_byte_buffer_t                       pdu;
+    bool                                               packed = false;
+  };
+  std::deque<pending_dl_dcch_t> pending_dl_dcch;
+
   // MAC controller
   sched_nr_interface::ue_cfg_t uecfg{};
 
@@ -24,6 +24,7 @@
 #include "srsenb/hdr/stack/upper/gtpu_pdcp_adapter.h"
 #include "srsgnb/hdr/stack/ngap/ngap.h"
 #include "srsran/common/network_utils.h"
+#include "srsran/common/thread_affinity.h"
 #include "srsran/srsran.h"
 #include <srsran/interfaces/enb_metrics_interface.h>
 
@@ -166,6 +167,7 @@ bool gnb_stack_nr::switch_on()
 
 void gnb_stack_nr::run_thread()
 {
+  srsran::apply_thread_affinity(srsran::thread_class_t::stack);
   while (running) {
     task_sched.run_next_task();
   }
@@ -180,6 +182,9 @@ void gnb_stack_nr::tti_clock_impl()
 {
   //  m_ngap->run_tti();
   task_sched.tic();
+  if (gtpu != nullptr) {
+    gtpu->flush_ul_pdus();
+  }
 }
 
 void gnb_stack_nr::process_pdus() {}
@@ -222,6 +227,13 @@ void gnb_stack_nr::write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu)
   // not implemented
 }
 
+void gnb_stack_nr::write_sdus(uint32_t lcid, std::vector<srsran::unique_byte_buffer_t> sdus)
+{
+  for (srsran::unique_byte_buffer_t& sdu : sdus) {
+    write_sdu(lcid, std::move(sdu));
+  }
+}
+
 bool gnb_stack_nr::has_active_radio_bearer(uint32_t eps_bearer_id)
 {
   return false;
@@ -68,4 +68,16 @@ srsran::unique_pool_ptr<rx_harq_softbuffer> harq_softbuffer_pool::get_rx(uint32_
   return rx_pool[idx]->make();
 }
 
+void harq_softbuffer_pool::get_metrics(std::vector<srsran::pool_metrics_t>& metrics) const
+{
+  for (size_t idx = 0; idx < SRSRAN_MAX_PRB_NR; ++idx) {
+    if (tx_pool[idx] == nullptr) {
+      continue;
+    }
+    std::string prb_suffix = "_" + std::to_string(idx + 1) + "prb";
+    metrics.push_back(tx_pool[idx]->get_metrics(("nr_harq_tx_softbuffer" + prb_suffix).c_str()));
+    metrics.push_back(rx_pool[idx]->get_metrics(("nr_harq_rx_softbuffer" + prb_suffix).c_str()));
+  }
+}
+
 } // namespace srsenb
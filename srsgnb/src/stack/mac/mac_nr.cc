@@ -95,6 +95,7 @@ private:
       if (subpdu.is_sdu()) {
         rrc->set_activity_user(rnti);
         rlc->write_pdu(rnti, subpdu.get_lcid(), subpdu.get_sdu(), subpdu.get_sdu_length());
+        sched->ul_sdu_info(rnti, subpdu.get_lcid(), subpdu.get_sdu_length());
       } else if (n != crnti_ce_pos) {
         if (process_ce_subpdu(rnti, subpdu) != SRSRAN_SUCCESS) {
           return SRSRAN_ERROR;
@@ -605,6 +606,9 @@ bool mac_nr::handle_uci_data(uint16_t rnti, const srsran_uci_cfg_nr_t& cfg_, con
 
     // 1. Pass CQI report to scheduler
     sched->dl_cqi_info(rnti, 0, value.csi->wideband_cri_ri_pmi_cqi.cqi);
+    if (cfg_.csi[i].nof_ports > 1) {
+      sched->dl_pmi_info(rnti, 0, value.csi->wideband_cri_ri_pmi_cqi.ri, value.csi->wideband_cri_ri_pmi_cqi.pmi);
+    }
 
     // 2. Save CQI report for metrics stats
     srsran::rwlock_read_guard rw_lock(rwmutex);
@@ -628,6 +632,9 @@ int mac_nr::pusch_info(const srsran_slot_cfg_t& slot_cfg, mac_interface_phy_nr::
   }
 
   sched->ul_crc_info(rnti, 0, pusch_info.pid, pusch_info.pusch_data.tb[0].crc);
+  if (std::isfinite(pusch_info.csi.snr_dB)) {
+    sched->ul_snr_info(rnti, 0, pusch_info.csi.snr_dB);
+  }
 
   // process only PDUs with CRC=OK
   if (pusch_info.pusch_data.tb[0].crc) {
@@ -490,6 +490,14 @@ void sched_nr::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
   });
 }
 
+void sched_nr::ul_sdu_info(uint16_t rnti, uint32_t lcid, uint32_t nof_bytes)
+{
+  pending_events->enqueue_ue_event("ul_sdu_info", rnti, [lcid, nof_bytes](ue& u, event_manager::logger& evlogger) {
+    u.ul_sdu_info(lcid, nof_bytes);
+    evlogger.push("0x{:x}: ul_sdu_info(lcid={}, nof_bytes={})", u.rnti, lcid, nof_bytes);
+  });
+}
+
 void sched_nr::dl_mac_ce(uint16_t rnti, uint32_t ce_lcid)
 {
   pending_events->enqueue_ue_event("dl_mac_ce", rnti, [ce_lcid](ue& u, event_manager::logger& event_logger) {
@@ -517,6 +525,26 @@ void sched_nr::dl_cqi_info(uint16_t rnti, uint32_t cc, uint32_t cqi_value)
   pending_events->enqueue_ue_cc_feedback("dl_cqi_info", rnti, cc, callback);
 }
 
+void sched_nr::dl_pmi_info(uint16_t rnti, uint32_t cc, uint32_t ri_value, uint32_t pmi_value)
+{
+  auto callback = [ri_value, pmi_value](ue_carrier& ue_cc, event_manager::logger& ev_logger) {
+    ue_cc.dl_ri  = ri_value;
+    ue_cc.dl_pmi = pmi_value;
+    ev_logger.push("0x{:x}: dl_pmi_info(ri={}, pmi={})", ue_cc.rnti, ue_cc.dl_ri, ue_cc.dl_pmi);
+  };
+  pending_events->enqueue_ue_cc_feedback("dl_pmi_info", rnti, cc, callback);
+}
+
+void sched_nr::ul_snr_info(uint16_t rnti, uint32_t cc, float snr_db)
+{
+  auto callback = [snr_db](ue_carrier& ue_cc, event_manager::logger& ev_logger) {
+    static const float alpha = 0.1;
+    ue_cc.ul_snr_db          = (1 - alpha) * ue_cc.ul_snr_db + alpha * snr_db;
+    ev_logger.push("0x{:x}: ul_snr_info(snr={:.1f}dB)", ue_cc.rnti, ue_cc.ul_snr_db);
+  };
+  pending_events->enqueue_ue_cc_feedback("ul_snr_info", rnti, cc, callback);
+}
+
 #define VERIFY_INPUT(cond, msg, ...)                                                                                   \
   do {                                                                                                                 \
     if (not(cond)) {                                                                                                   \
@@ -20,6 +20,7 @@
  */
 
 #include "srsgnb/hdr/stack/mac/sched_nr_bwp.h"
+#include "srsgnb/hdr/stack/mac/sched_nr_time_pf.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/string_helpers.h"
 
@@ -171,8 +172,18 @@ int ra_sched::dl_rach_info(const dl_sched_rar_info_t& rar_info)
 }
 
 bwp_manager::bwp_manager(const bwp_params_t& bwp_cfg) :
-  cfg(&bwp_cfg), ra(bwp_cfg), si(bwp_cfg), grid(bwp_cfg), data_sched(new sched_nr_time_rr())
-{}
+  cfg(&bwp_cfg), ra(bwp_cfg), si(bwp_cfg), grid(bwp_cfg)
+{
+  if (bwp_cfg.sched_cfg.sched_policy == "time_pf") {
+    data_sched.reset(new sched_nr_time_pf(bwp_cfg));
+  } else {
+    if (bwp_cfg.sched_cfg.sched_policy != "time_rr") {
+      bwp_cfg.logger.warning("Unknown NR scheduler policy \"%s\". Using \"time_rr\"",
+                             bwp_cfg.sched_cfg.sched_policy.c_str());
+    }
+    data_sched.reset(new sched_nr_time_rr());
+  }
+}
 
 } // namespace sched_nr_impl
 } // namespace srsenb
@@ -286,18 +286,29 @@ alloc_result bwp_slot_allocator::alloc_rar_and_msg3(uint16_t
 
 // ue is the UE (1 only) that will be allocated
 // func computes the grant allocation for this UE
-alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const prb_grant& dl_grant)
+alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const prb_grant& dl_grant, uint32_t mu_layer)
 {
-  static const uint32_t               aggr_idx  = 2;
-  static const srsran_dci_format_nr_t dci_fmt   = srsran_dci_format_nr_1_0;
-  static const srsran_rnti_type_t     rnti_type = srsran_rnti_type_c;
+  static const uint32_t           aggr_idx  = 2;
+  static const srsran_rnti_type_t rnti_type = srsran_rnti_type_c;
+
+  // The antenna ports field of the DCI format 1_1 selects the DMRS port of the co-scheduled UEs
+  const srsran_dci_format_nr_t dci_fmt = mu_layer > 0 ? srsran_dci_format_nr_1_1 : srsran_dci_format_nr_1_0;
 
   bwp_slot_grid& bwp_pdcch_slot = bwp_grid[ue.pdcch_slot];
   bwp_slot_grid& bwp_pdsch_slot = bwp_grid[ue.pdsch_slot];
   bwp_slot_grid& bwp_uci_slot   = bwp_grid[ue.uci_slot]; // UCI : UL control info
 
+  if (mu_layer > 0) {
+    // Only TS 38.212 Table 7.3.1.2.2-1 (DMRS type 1, single symbol), with four DMRS ports, is supported
+    if (mu_layer >= 4 or ue.h_dl == nullptr or not ue.h_dl->empty() or
+        ue->phy().pdsch.dmrs_type != srsran_dmrs_sch_type_1 or
+        ue->phy().pdsch.dmrs_max_length != srsran_dmrs_sch_len_1) {
+      return alloc_result::invalid_grant_params;
+    }
+  }
+
   // Verify there is space in PDSCH
-  alloc_result ret = bwp_pdcch_slot.pdschs.is_ue_grant_valid(ue.cfg(), ss_id, dci_fmt, dl_grant);
+  alloc_result ret = bwp_pdcch_slot.pdschs.is_ue_grant_valid(ue.cfg(), ss_id, dci_fmt, dl_grant, mu_layer > 0);
   if (ret != alloc_result::success) {
     return ret;
   }
@@ -320,7 +331,7 @@ alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const
   // TODO
 
   // Find space and allocate PDCCH
-  auto pdcch_result = bwp_pdcch_slot.pdcchs.alloc_dl_pdcch(rnti_type, ss_id, aggr_idx, ue.cfg());
+  auto pdcch_result = bwp_pdcch_slot.pdcchs.alloc_dl_pdcch(rnti_type, ss_id, aggr_idx, ue.cfg(), dci_fmt);
   if (pdcch_result.is_error()) {
     // Could not find space in PDCCH
     return pdcch_result.error();
@@ -328,6 +339,10 @@ alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const
   pdcch_dl_t& pdcch        = *pdcch_result.value();
   pdcch.dci_cfg            = ue->get_dci_cfg();
   pdcch.dci.pucch_resource = 0;
+  if (mu_layer > 0) {
+    // Values 3 to 6 map to DMRS ports 0 to 3 with two CDM groups without data, as the DCI format 1_0 PDSCH of port 0
+    pdcch.dci.ports = 3 + mu_layer;
+  }
   pdcch.dci.dai            = std::count_if(bwp_uci_slot.pending_acks.begin(),
                                 bwp_uci_slot.pending_acks.end(),
                                 [&ue](const harq_ack_t& p) { return p.res.rnti == ue->rnti; });
@@ -213,7 +213,9 @@ harq_entity::harq_entity(uint16_t rnti_, uint32_t nprb, uint32_t nof_harq_procs,
 
 void harq_entity::new_slot(slot_point slot_rx_)
 {
-  slot_rx = slot_rx_;
+  slot_rx     = slot_rx_;
+  nof_busy_dl = 0;
+  nof_busy_ul = 0;
   for (harq_proc& dl_h : dl_harqs) {
     if (dl_h.clear_if_maxretx(slot_rx)) {
       logger.info("SCHED: discarding rnti=0x%x, DL TB pid=%d. Cause: Maximum number of retx exceeded (%d)",
@@ -221,6 +223,7 @@ void harq_entity::new_slot(slot_point slot_rx_)
                   dl_h.pid,
                   dl_h.max_nof_retx());
     }
+    nof_busy_dl += dl_h.empty() ? 0 : 1;
   }
   for (harq_proc& ul_h : ul_harqs) {
     if (ul_h.clear_if_maxretx(slot_rx)) {
@@ -229,6 +232,7 @@ void harq_entity::new_slot(slot_point slot_rx_)
                   ul_h.pid,
                   ul_h.max_nof_retx());
     }
+    nof_busy_ul += ul_h.empty() ? 0 : 1;
   }
 }
 
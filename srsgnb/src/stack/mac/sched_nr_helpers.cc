@@ -24,12 +24,32 @@
 #include "srsgnb/hdr/stack/mac/sched_nr_harq.h"
 #include "srsgnb/hdr/stack/mac/sched_nr_ue.h"
 #include "srsran/common/string_helpers.h"
+#include <complex>
 
 namespace srsenb {
 namespace sched_nr_impl {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+float pmi_correlation(uint32_t nof_ports, uint32_t pmi_a, uint32_t pmi_b)
+{
+  // w(l,n) = [v_l; phi_n * v_l] / sqrt(2 * N1), with v_l[k] = exp(j * 2 * pi * l * k / (O1 * N1)) and phi_n = j^n
+  static const uint32_t O1 = 4;
+  uint32_t              N1 = std::max(nof_ports / 2, 1U);
+
+  uint32_t l_a = (pmi_a / 4) % (O1 * N1), n_a = pmi_a % 4;
+  uint32_t l_b = (pmi_b / 4) % (O1 * N1), n_b = pmi_b % 4;
+
+  // v_la^H * v_lb only depends on the beam difference
+  std::complex<float> beam_corr = 0;
+  for (uint32_t k = 0; k < N1; ++k) {
+    beam_corr += std::polar(1.0f, (float)(2 * M_PI * ((int)l_b - (int)l_a) * k / (O1 * N1)));
+  }
+  std::complex<float> phase_corr = 1.0f + std::polar(1.0f, (float)(M_PI / 2 * ((int)n_b - (int)n_a)));
+
+  return std::norm(beam_corr * phase_corr) / (4.0f * N1 * N1);
+}
+
 void log_sched_slot_ues(srslog::basic_logger& logger, slot_point pdcch_slot, uint32_t cc, const slot_ue_map_t& slot_ues)
 {
   if (not logger.debug.enabled() or slot_ues.empty()) {
@@ -99,6 +99,7 @@ bool coreset_region::alloc_pdcch(srsran_rnti_type_t         rnti_type,
                                  srsran_dci_ctx_t&          dci)
 {
   saved_dfs_tree.clear();
+  nof_dfs_steps = 0;
 
   alloc_record record;
   record.dci            = &dci;
@@ -120,10 +121,14 @@ bool coreset_region::alloc_pdcch(srsran_rnti_type_t         rnti_type,
     if (saved_dfs_tree.empty()) {
       saved_dfs_tree = dfs_tree;
     }
+    backjump_dfs(record);
   } while (get_next_dfs());
 
   // Revert steps to initial state, before dci record allocation was attempted
   dfs_tree.swap(saved_dfs_tree);
+  for (uint32_t i = 0; i < dfs_tree.size(); ++i) {
+    dci_list[i].dci->location = dfs_tree[i].dci_pos;
+  }
   return false;
 }
 
@@ -139,8 +144,8 @@ void coreset_region::rem_last_pdcch()
 bool coreset_region::get_next_dfs()
 {
   do {
-    if (dfs_tree.empty()) {
-      // If we reach root, the allocation failed
+    if (dfs_tree.empty() or nof_dfs_steps >= MAX_DFS_STEPS) {
+      // If we reach root or the search budget is exhausted, the allocation failed
       return false;
     }
     // Attempt to re-add last tree node, but with a higher node child index
@@ -155,8 +160,22 @@ bool coreset_region::get_next_dfs()
   return true;
 }
 
+/// Only the PDCCHs that overlap one of the CCE candidates of the failed PDCCH can free space for it, so the ones after
+/// the deepest of them are removed without trying their alternative positions
+void coreset_region::backjump_dfs(const alloc_record& record)
+{
+  coreset_bitmap cand_mask(nof_cces());
+  for (uint32_t ncce : get_cce_loc_table(record)) {
+    cand_mask.fill(ncce, std::min(ncce + (1U << record.aggr_idx), nof_cces()));
+  }
+  while (not dfs_tree.empty() and (dfs_tree.back().current_mask & cand_mask).none()) {
+    dfs_tree.pop_back();
+  }
+}
+
 bool coreset_region::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
 {
+  nof_dfs_steps++;
   alloc_tree_dfs_t& alloc_dfs = dfs_tree;
   // Get DCI Location Table
   auto cce_locs = get_cce_loc_table(record);
@@ -179,14 +198,13 @@ bool coreset_region::alloc_dfs_node(const alloc_record& record, uint32_t start_d
   for (; node.dci_pos_idx < cce_locs.size(); ++node.dci_pos_idx) {
     node.dci_pos.ncce = cce_locs[node.dci_pos_idx];
 
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
+    if (node.total_mask.any(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx))) {
       // there is a PDCCH collision. Try another CCE position
       continue;
     }
 
     // Allocation successful
+    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
     node.total_mask |= node.current_mask;
     alloc_dfs.push_back(node);
     record.dci->location = node.dci_pos;
@@ -279,9 +297,9 @@ pdcch_dl_alloc_result bwp_pdcch_allocator::alloc_si_pdcch(uint32_t ss_id, uint32
 pdcch_dl_alloc_result bwp_pdcch_allocator::alloc_dl_pdcch(srsran_rnti_type_t         rnti_type,
                                                           uint32_t                   ss_id,
                                                           uint32_t                   aggr_idx,
-                                                          const ue_carrier_params_t& user)
+                                                          const ue_carrier_params_t& user,
+                                                          srsran_dci_format_nr_t     dci_fmt)
 {
-  static const srsran_dci_format_nr_t dci_fmt = srsran_dci_format_nr_1_0; // TODO: make it configurable
   srsran_assert(rnti_type == srsran_rnti_type_c or rnti_type == srsran_rnti_type_tc,
                 "Invalid RNTI type=%s for UE-specific PDCCH",
                 srsran_rnti_type_str_short(rnti_type));
@@ -55,7 +55,8 @@ void pdsch_allocator::reset()
 alloc_result pdsch_allocator::is_grant_valid_common(srsran_search_space_type_t ss_type,
                                                     srsran_dci_format_nr_t     dci_fmt,
                                                     uint32_t                   coreset_id,
-                                                    const prb_grant&           grant) const
+                                                    const prb_grant&           grant,
+                                                    bool                       co_scheduled) const
 {
   // DL must be active in given slot
   if (not bwp_cfg.slots[slot_idx].is_dl) {
@@ -87,8 +88,8 @@ alloc_result pdsch_allocator::is_grant_valid_common(srsran_search_space_type_t s
     }
   }
 
-  // Grant PRBs do not collide with previous PDSCH allocations
-  if (dl_prbs.collides(grant)) {
+  // Grant PRBs do not collide with previous PDSCH allocations, unless they are shared on different DMRS ports
+  if (not co_scheduled and dl_prbs.collides(grant)) {
     log_alloc_failure(
         bwp_cfg.logger.debug, "Provided PRB grant={:x} collides with allocations previously made.", grant);
     return alloc_result::sch_collision;
@@ -122,7 +123,8 @@ alloc_result pdsch_allocator::is_rar_grant_valid(const prb_grant& grant) const
 alloc_result pdsch_allocator::is_ue_grant_valid(const ue_carrier_params_t& ue,
                                                 uint32_t                   ss_id,
                                                 srsran_dci_format_nr_t     dci_fmt,
-                                                const prb_grant&           grant) const
+                                                const prb_grant&           grant,
+                                                bool                       co_scheduled) const
 {
   const srsran_search_space_t* ss = ue.get_ss(ss_id);
   if (ss == nullptr) {
@@ -130,7 +132,7 @@ alloc_result pdsch_allocator::is_ue_grant_valid(const ue_carrier_params_t& ue,
     log_alloc_failure(bwp_cfg.logger.error, "rnti=0x%x,SearchSpaceId={} has not been configured.", ue.rnti, ss_id);
     return alloc_result::invalid_grant_params;
   }
-  alloc_result ret = is_grant_valid_common(ss->type, dci_fmt, ss->coreset_id, grant);
+  alloc_result ret = is_grant_valid_common(ss->type, dci_fmt, ss->coreset_id, grant, co_scheduled);
   if (ret != alloc_result::success) {
     return ret;
   }
@@ -0,0 +1,247 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/mac/sched_nr_time_pf.h"
+#include "srsgnb/hdr/stack/mac/sched_nr_helpers.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/// Coefficient of the exponential average of the allocated rates
+static const float avg_rate_alpha = 0.01;
+
+sched_nr_time_pf::sched_nr_time_pf(const bwp_params_t& bwp_cfg)
+{
+  if (not bwp_cfg.sched_cfg.sched_policy_args.empty()) {
+    fairness_coeff = std::stof(bwp_cfg.sched_cfg.sched_policy_args);
+  }
+
+  // The PDSCH and PUSCH of the UEs are sized with the 64QAM table, used by the fallback DCI formats
+  for (uint32_t mcs = 0; mcs < nof_mcs; ++mcs) {
+    double R  = srsran_ra_nr_R_from_mcs(
+        srsran_mcs_table_64qam, srsran_dci_format_nr_1_0, srsran_search_space_type_ue, srsran_rnti_type_c, mcs);
+    uint32_t Qm = srsran_mod_bits_x_symbol(srsran_ra_nr_mod_from_mcs(
+        srsran_mcs_table_64qam, srsran_dci_format_nr_1_0, srsran_search_space_type_ue, srsran_rnti_type_c, mcs));
+    mcs_bytes_per_prb[mcs] = std::isnan(R) ? 0 : (float)(R * Qm * nof_re_per_prb / 8);
+  }
+
+  // Shannon capacity with a 3 dB implementation loss, capped at the highest MCS
+  for (int snr_db = min_snr_db; snr_db <= max_snr_db; ++snr_db) {
+    float se = std::log2(1 + std::pow(10.0f, (snr_db - 3) / 10.0f));
+    snr_bytes_per_prb[snr_db - min_snr_db] = std::min(se * nof_re_per_prb / 8, mcs_bytes_per_prb[nof_mcs - 1]);
+  }
+
+  candidates.reserve(SRSENB_MAX_UES);
+}
+
+sched_nr_time_pf::ue_ctxt& sched_nr_time_pf::get_ue_ctxt(uint16_t rnti, uint64_t slot_count, bool dl)
+{
+  auto it = ue_history_db.find(rnti);
+  if (it == ue_history_db.end()) {
+    // An entry left by a released UE with the same index is overwritten
+    ue_history_db.overwrite(rnti, ue_ctxt{rnti});
+    it = ue_history_db.find(rnti);
+  }
+  avg_rate& rate = dl ? it->second.dl_rate : it->second.ul_rate;
+  if (rate.last_slot_count != 0 and rate.last_slot_count + 1 < slot_count) {
+    rate.save_idle_slots(slot_count - rate.last_slot_count - 1, avg_rate_alpha);
+  }
+  rate.last_slot_count = slot_count;
+  return it->second;
+}
+
+float sched_nr_time_pf::pf_priority(float rate, float avg_rate, float qos_urgency) const
+{
+  float prio = (avg_rate != 0) ? rate / std::pow(avg_rate, fairness_coeff)
+                               : (rate == 0 ? 0 : std::numeric_limits<float>::max());
+  return prio * (1 + qos_urgency);
+}
+
+void sched_nr_time_pf::sort_candidates()
+{
+  // Retransmissions first, then by decreasing priority
+  std::sort(candidates.begin(), candidates.end(), [](const ue_candidate& lhs, const ue_candidate& rhs) {
+    return (lhs.retx and not rhs.retx) or (lhs.retx == rhs.retx and lhs.prio > rhs.prio);
+  });
+}
+
+/// Number of PRBs that carry the given bytes, with some margin for the MAC subheaders
+static uint32_t required_prbs(uint32_t nof_bytes, float bytes_per_prb)
+{
+  static const uint32_t mac_overhead_bytes = 8;
+  if (bytes_per_prb <= 0) {
+    return 1;
+  }
+  return std::max(1U, (uint32_t)std::ceil((nof_bytes + mac_overhead_bytes) / bytes_per_prb));
+}
+
+/*****************************************************************
+ *                         Downlink
+ *****************************************************************/
+
+int sched_nr_time_pf::get_dl_mcs(ue_ctxt& ctxt, const slot_ue& ue) const
+{
+  if (ue->fixed_pdsch_mcs() >= 0) {
+    return std::min(ue->fixed_pdsch_mcs(), (int)nof_mcs - 1);
+  }
+  if (ue.dl_cqi() != ctxt.last_dl_cqi) {
+    int mcs          = srsran_ra_nr_cqi_to_mcs(ue.dl_cqi(),
+                                      ue.cfg().phy().csi.reports->cqi_table,
+                                      srsran_mcs_table_64qam,
+                                      srsran_dci_format_nr_1_0,
+                                      srsran_search_space_type_ue,
+                                      srsran_rnti_type_c);
+    ctxt.dl_mcs      = std::min(std::max(mcs, 0), (int)nof_mcs - 1);
+    ctxt.last_dl_cqi = ue.dl_cqi();
+  }
+  return ctxt.dl_mcs;
+}
+
+void sched_nr_time_pf::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  dl_slot_count++;
+
+  candidates.clear();
+  for (auto& u : ue_db) {
+    slot_ue& ue = u.second;
+    if (ue.h_dl == nullptr) {
+      continue;
+    }
+    bool retx = ue.h_dl->has_pending_retx(slot_alloc.get_tti_rx());
+    if (not retx and (ue.dl_bytes == 0 or not ue.h_dl->empty())) {
+      continue;
+    }
+    ue_ctxt& ctxt = get_ue_ctxt(ue->rnti, dl_slot_count, true);
+    float    rate =
+        srsran_ra_nr_cqi_to_se(ue.dl_cqi(), ue.cfg().phy().csi.reports->cqi_table) * nof_re_per_prb / 8;
+    candidates.push_back(ue_candidate{&ctxt, &ue, retx, pf_priority(rate, ctxt.dl_rate.get(), ue.dl_qos_urgency)});
+  }
+  sort_candidates();
+
+  for (ue_candidate& c : candidates) {
+    slot_ue& ue          = *c.ue;
+    uint32_t alloc_bytes = 0;
+    int      ss_id       = ue->find_ss_id(srsran_dci_format_nr_1_0);
+    if (ss_id >= 0) {
+      prb_grant prbs = ue.h_dl->prbs();
+      if (not c.retx) {
+        // Only the PRBs the pending data needs, the remaining ones are left to the next UEs
+        prb_bitmap   used_prbs = slot_alloc.occupied_dl_prbs(ue.pdsch_slot, ss_id, srsran_dci_format_nr_1_0);
+        uint32_t     nof_prbs  = required_prbs(ue.dl_bytes, mcs_bytes_per_prb[get_dl_mcs(*c.ctxt, ue)]);
+        prb_interval interv    = find_empty_interval_of_length(used_prbs, nof_prbs, 0);
+        if (interv.empty()) {
+          c.ctxt->dl_rate.save_alloc(0, avg_rate_alpha);
+          continue;
+        }
+        prbs = interv;
+      }
+      if (slot_alloc.alloc_pdsch(ue, ss_id, prbs) == alloc_result::success) {
+        alloc_bytes = ue.h_dl->tbs() / 8;
+      }
+    }
+    c.ctxt->dl_rate.save_alloc(alloc_bytes, avg_rate_alpha);
+  }
+}
+
+/*****************************************************************
+ *                         Uplink
+ *****************************************************************/
+
+float sched_nr_time_pf::ul_bytes_per_prb(const slot_ue& ue) const
+{
+  if (ue->fixed_pusch_mcs() >= 0) {
+    return mcs_bytes_per_prb[std::min(ue->fixed_pusch_mcs(), (int)nof_mcs - 1)];
+  }
+  int snr_db = std::min(std::max((int)std::round(ue.ul_snr_db()), min_snr_db), max_snr_db);
+  return snr_bytes_per_prb[snr_db - min_snr_db];
+}
+
+void sched_nr_time_pf::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  ul_slot_count++;
+
+  candidates.clear();
+  for (auto& u : ue_db) {
+    slot_ue& ue = u.second;
+    if (ue.h_ul == nullptr) {
+      continue;
+    }
+    bool retx = ue.h_ul->has_pending_retx(slot_alloc.get_tti_rx());
+    if (not retx and (ue.ul_bytes == 0 or not ue.h_ul->empty())) {
+      continue;
+    }
+    ue_ctxt& ctxt   = get_ue_ctxt(ue->rnti, ul_slot_count, false);
+    int      snr_db = std::min(std::max((int)std::round(ue.ul_snr_db()), min_snr_db), max_snr_db);
+    float    rate   = snr_bytes_per_prb[snr_db - min_snr_db];
+    candidates.push_back(ue_candidate{&ctxt, &ue, retx, pf_priority(rate, ctxt.ul_rate.get(), ue.ul_qos_urgency)});
+  }
+  sort_candidates();
+
+  for (ue_candidate& c : candidates) {
+    slot_ue&  ue          = *c.ue;
+    uint32_t  alloc_bytes = 0;
+    prb_grant prbs        = ue.h_ul->prbs();
+    if (not c.retx) {
+      uint32_t     nof_prbs = required_prbs(ue.ul_bytes, ul_bytes_per_prb(ue));
+      prb_interval interv   = find_empty_interval_of_length(slot_alloc.occupied_ul_prbs(ue.pusch_slot), nof_prbs, 0);
+      if (interv.empty()) {
+        c.ctxt->ul_rate.save_alloc(0, avg_rate_alpha);
+        continue;
+      }
+      prbs = interv;
+    }
+    if (slot_alloc.alloc_pusch(ue, prbs) == alloc_result::success) {
+      alloc_bytes = ue.h_ul->tbs() / 8;
+    }
+    c.ctxt->ul_rate.save_alloc(alloc_bytes, avg_rate_alpha);
+  }
+}
+
+/*****************************************************************
+ *                          UE history
+ *****************************************************************/
+
+void sched_nr_time_pf::avg_rate::save_alloc(uint32_t alloc_bytes, float alpha)
+{
+  if (nof_samples < 1 / alpha) {
+    // fast start
+    avg = avg + (alloc_bytes - avg) / (nof_samples + 1);
+  } else {
+    avg = (1 - alpha) * avg + alpha * alloc_bytes;
+  }
+  nof_samples++;
+}
+
+void sched_nr_time_pf::avg_rate::save_idle_slots(uint32_t nof_slots, float alpha)
+{
+  // The fast start samples are averaged one by one, the exponential average decays in a single step
+  for (; nof_slots > 0 and nof_samples < 1 / alpha; --nof_slots) {
+    save_alloc(0, alpha);
+  }
+  avg *= std::pow(1 - alpha, nof_slots);
+  nof_samples += nof_slots;
+}
+
+} // namespace sched_nr_impl
+} // namespace srsenb
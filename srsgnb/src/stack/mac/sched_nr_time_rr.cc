@@ -20,6 +20,7 @@
  */
 
 #include "srsgnb/hdr/stack/mac/sched_nr_time_rr.h"
+#include "srsgnb/hdr/stack/mac/sched_nr_helpers.h"
 
 namespace srsenb {
 namespace sched_nr_impl {
@@ -51,6 +52,77 @@ bool round_robin_apply(slot_ue_map_t& ue_db, uint32_t rr_count, Predicate p)
   return false;
 }
 
+/**
+ * @brief Finds the UE whose bearers are the most urgent (GBR deficit or delay budget), which is served ahead of the
+ * round-robin order
+ * @param urgency callable with signature "float(const slot_ue&)"
+ * @return nullptr if no UE has QoS urgency
+ */
+template <typename UrgencyFunc>
+slot_ue* find_most_urgent_ue(slot_ue_map_t& ue_db, UrgencyFunc urgency)
+{
+  slot_ue* chosen_ue   = nullptr;
+  float    max_urgency = 0;
+  for (auto& u : ue_db) {
+    float ue_urgency = urgency(u.second);
+    if (ue_urgency > max_urgency) {
+      max_urgency = ue_urgency;
+      chosen_ue   = &u.second;
+    }
+  }
+  return chosen_ue;
+}
+
+/// Maximum squared correlation between the precoders of co-scheduled UEs
+static const float max_mu_mimo_correlation = 0.25f;
+
+/// A UE can share its PRBs with other UEs when it reported one layer and a PMI
+static bool is_mu_mimo_candidate(const slot_ue& ue)
+{
+  return ue.dl_ri() == 0 and ue.dl_pmi() >= 0;
+}
+
+/**
+ * @brief MU-MIMO pairing stage. Co-schedules on the PRBs of a new DL transmission other rank 1 UEs whose reported
+ * precoders have a low correlation with the ones already in the group, each on its own DMRS port
+ * @param first_ue UE already allocated on the PRBs, it uses the DMRS port 0
+ * @param prbs PRBs of the first UE grant
+ */
+static void sched_dl_mu_users(slot_ue_map_t&      ue_db,
+                              bwp_slot_allocator& slot_alloc,
+                              const slot_ue&      first_ue,
+                              const prb_grant&    prbs)
+{
+  uint32_t nof_ports = slot_alloc.cfg.cell_cfg.carrier.max_mimo_layers;
+  // The DMRS configuration type 1 with a single symbol has four ports
+  uint32_t max_users = std::min(nof_ports, 4U);
+  if (not slot_alloc.cfg.sched_cfg.mu_mimo_enabled or max_users < 2 or not is_mu_mimo_candidate(first_ue)) {
+    return;
+  }
+
+  srsran::bounded_vector<const slot_ue*, 4> group;
+  group.push_back(&first_ue);
+  round_robin_apply(ue_db, slot_alloc.get_pdcch_tti().to_uint(), [&](slot_ue& ue) {
+    if (ue.dl_bytes == 0 or ue.h_dl == nullptr or not ue.h_dl->empty() or not is_mu_mimo_candidate(ue)) {
+      return false;
+    }
+    for (const slot_ue* paired : group) {
+      if (paired == &ue or
+          pmi_correlation(nof_ports, paired->dl_pmi(), ue.dl_pmi()) > max_mu_mimo_correlation) {
+        return false;
+      }
+    }
+    int ss_id = ue->find_ss_id(srsran_dci_format_nr_1_1);
+    if (ss_id < 0) {
+      return false;
+    }
+    if (slot_alloc.alloc_pdsch(ue, ss_id, prbs, group.size()) == alloc_result::success) {
+      group.push_back(&ue);
+    }
+    return group.size() == max_users;
+  });
+}
+
 void sched_nr_time_rr::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
 {
   // Start with retxs
@@ -68,7 +140,9 @@ void sched_nr_time_rr::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator&
   }
 
   // Move on to new txs
-  auto newtx_ue_function = [&slot_alloc](slot_ue& ue) {
+  slot_ue*  newtx_ue = nullptr;
+  prb_grant newtx_prbs;
+  auto      newtx_ue_function = [&slot_alloc, &newtx_ue, &newtx_prbs](slot_ue& ue) {
     if (ue.dl_bytes > 0 and ue.h_dl != nullptr and ue.h_dl->empty()) {
       int ss_id = ue->find_ss_id(srsran_dci_format_nr_1_0);
       if (ss_id < 0) {
@@ -77,12 +151,18 @@ void sched_nr_time_rr::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator&
       prb_grant    prbs = find_optimal_dl_grant(slot_alloc, ue, ss_id);
       alloc_result res  = slot_alloc.alloc_pdsch(ue, ss_id, prbs);
       if (res == alloc_result::success) {
+        newtx_ue   = &ue;
+        newtx_prbs = prbs;
         return true;
       }
     }
     return false;
   };
-  round_robin_apply(ue_db, slot_alloc.get_pdcch_tti().to_uint(), newtx_ue_function);
+  slot_ue* urgent_ue = find_most_urgent_ue(ue_db, [](const slot_ue& ue) { return ue.dl_qos_urgency; });
+  if ((urgent_ue != nullptr and newtx_ue_function(*urgent_ue)) or
+      round_robin_apply(ue_db, slot_alloc.get_pdcch_tti().to_uint(), newtx_ue_function)) {
+    sched_dl_mu_users(ue_db, slot_alloc, *newtx_ue, newtx_prbs);
+  }
 }
 
 void sched_nr_time_rr::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
@@ -101,7 +181,7 @@ void sched_nr_time_rr::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator&
   }
 
   // Move on to new txs
-  round_robin_apply(ue_db, slot_alloc.get_pdcch_tti().to_uint(), [&slot_alloc](slot_ue& ue) {
+  auto newtx_ue_function = [&slot_alloc](slot_ue& ue) {
     if (ue.ul_bytes > 0 and ue.h_ul != nullptr and ue.h_ul->empty()) {
       alloc_result res = slot_alloc.alloc_pusch(ue, prb_interval{0, slot_alloc.cfg.cfg.rb_width});
       if (res == alloc_result::success) {
@@ -109,7 +189,11 @@ void sched_nr_time_rr::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator&
       }
     }
     return false;
-  });
+  };
+  slot_ue* urgent_ue = find_most_urgent_ue(ue_db, [](const slot_ue& ue) { return ue.ul_qos_urgency; });
+  if (urgent_ue == nullptr or not newtx_ue_function(*urgent_ue)) {
+    round_robin_apply(ue_db, slot_alloc.get_pdcch_tti().to_uint(), newtx_ue_function);
+  }
 }
 
 } // namespace sched_nr_impl
@@ -71,8 +71,10 @@ bool ue_buffer_manager::pdu_builder::alloc_subpdus(uint32_t rem_bytes, sched_nr_
       return false;
     }
     if (pending_lcid_bytes > 0) {
-      rem_bytes -= std::min(rem_bytes, pending_lcid_bytes);
+      uint32_t alloc_bytes = std::min(rem_bytes, pending_lcid_bytes);
+      rem_bytes -= alloc_bytes;
       pdu.subpdus.push_back(lcid);
+      parent->consume_dl_qos_tokens(lcid, alloc_bytes);
     }
   }
 
@@ -90,19 +92,27 @@ slot_ue::slot_ue(ue_carrier& ue_, slot_point slot_tx_) : ue(&ue_), pdcch_slot(sl
   uint32_t k2       = ue->bwp_cfg.active_bwp().pusch_ra_list[0].K;
   pusch_slot        = pdcch_slot + k2;
 
+  // The HARQs are only searched if the UE has data or a HARQ that may need a retx. An idle UE is still a slot UE, as
+  // it may have UCI to transmit, but it does not cost a HARQ search in every slot
   dl_active = ue->cell_params.bwps[0].slots[pdsch_slot.slot_idx()].is_dl;
   if (dl_active) {
-    dl_bytes = ue->common_ctxt.pending_dl_bytes;
-    h_dl     = ue->harq_ent.find_pending_dl_retx();
-    if (h_dl == nullptr) {
+    dl_bytes       = ue->common_ctxt.pending_dl_bytes;
+    dl_qos_urgency = ue->common_ctxt.dl_qos_urgency;
+    if (ue->harq_ent.nof_busy_dl_harqs() > 0) {
+      h_dl = ue->harq_ent.find_pending_dl_retx();
+    }
+    if (h_dl == nullptr and dl_bytes > 0) {
       h_dl = ue->harq_ent.find_empty_dl_harq();
     }
   }
   ul_active = ue->cell_params.bwps[0].slots[pusch_slot.slot_idx()].is_ul;
   if (ul_active) {
-    ul_bytes = ue->common_ctxt.pending_ul_bytes;
-    h_ul     = ue->harq_ent.find_pending_ul_retx();
-    if (h_ul == nullptr) {
+    ul_bytes       = ue->common_ctxt.pending_ul_bytes;
+    ul_qos_urgency = ue->common_ctxt.ul_qos_urgency;
+    if (ue->harq_ent.nof_busy_ul_harqs() > 0) {
+      h_ul = ue->harq_ent.find_pending_ul_retx();
+    }
+    if (h_ul == nullptr and ul_bytes > 0) {
       h_ul = ue->harq_ent.find_empty_ul_harq();
     }
   }
@@ -178,6 +188,7 @@ ue::ue(uint16_t rnti_, const sched_nr_ue_cfg_t& uecfg, const sched_params_t& sch
   buffers(rnti_, srslog::fetch_basic_logger(sched_cfg_.sched_cfg.logger_name)),
   ue_cfg(uecfg.carriers[0].cc)
 {
+  ul_presched.set_cfg(sched_cfg.sched_cfg.ul_presched_max_bytes, sched_cfg.sched_cfg.ul_presched_max_misses);
   set_cfg(uecfg);
 }
 
@@ -229,6 +240,10 @@ void ue::new_slot(slot_point pdcch_slot)
     common_ctxt.pending_dl_bytes = 1000000;
     common_ctxt.pending_ul_bytes = 1000000;
   } else {
+    buffers.new_qos_period(1.0F / pdcch_slot.nof_slots_per_subframe());
+    ul_presched.new_slot();
+    common_ctxt.dl_qos_urgency   = buffers.get_dl_qos_urgency();
+    common_ctxt.ul_qos_urgency   = buffers.get_ul_qos_urgency();
     common_ctxt.pending_dl_bytes = buffers.get_dl_tx_total();
     common_ctxt.pending_ul_bytes = buffers.get_bsr();
     for (auto& ue_cc_cfg : ue_cfg.carriers) {
@@ -241,6 +256,11 @@ void ue::new_slot(slot_point pdcch_slot)
             if (last_sr_slot.valid() and cc->harq_ent.ul_harq(pid).harq_slot_tx() > last_sr_slot) {
               last_sr_slot.clear();
             }
+            if (last_presched_slot.valid() and cc->harq_ent.ul_harq(pid).harq_slot_tx() > last_presched_slot) {
+              // The pre-scheduled UL bytes were granted
+              ul_presched.ul_newtx_alloc();
+              last_presched_slot.clear();
+            }
           }
         }
       }
@@ -249,6 +269,13 @@ void ue::new_slot(slot_point pdcch_slot)
       // If unanswered SR is pending
       common_ctxt.pending_ul_bytes = 512;
     }
+    if (common_ctxt.pending_ul_bytes == 0) {
+      // Grant the periodic UL traffic before the UE has to send a SR
+      common_ctxt.pending_ul_bytes = ul_presched.get_presched_bytes();
+      if (common_ctxt.pending_ul_bytes > 0 and not last_presched_slot.valid()) {
+        last_presched_slot = pdcch_slot;
+      }
+    }
   }
 }
 
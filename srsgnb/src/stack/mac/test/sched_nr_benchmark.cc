@@ -0,0 +1,376 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsenb/test/mac/sched_traffic_model.h"
+#include "srsran/common/phy_cfg_nr_default.h"
+#include "srsran/common/string_helpers.h"
+#include "srsran/common/test_common.h"
+#include <boost/program_options.hpp>
+
+// shorten boost program options namespace
+namespace bpo = boost::program_options;
+
+namespace srsenb {
+
+/// DRB used by the traffic models
+static const uint32_t drb_lcid = 4, drb_lcg = 1;
+
+struct run_params {
+  uint32_t           nof_ues;
+  uint32_t           nof_cc;
+  uint32_t           nof_slots;
+  uint32_t           nof_workers;
+  uint32_t           cqi;
+  sched_traffic_type traffic;
+  std::string        phy_cfg;
+};
+
+struct run_params_range {
+  std::vector<uint32_t>           nof_ues     = {1, 16};
+  std::vector<uint32_t>           nof_cc      = {1};
+  uint32_t                        nof_slots   = 2000;
+  uint32_t                        nof_workers = 1;
+  std::vector<uint32_t>           cqi         = {15};
+  std::vector<sched_traffic_type> traffic     = {
+      sched_traffic_type::full_buffer, sched_traffic_type::voip, sched_traffic_type::web};
+  std::vector<std::string> phy_cfg = {"carrier=10MHz,duplex=FDD", "carrier=20MHz,duplex=6D+4U"};
+
+  size_t nof_runs() const { return nof_ues.size() * nof_cc.size() * cqi.size() * traffic.size() * phy_cfg.size(); }
+  run_params get_params(size_t idx) const
+  {
+    run_params r  = {};
+    r.nof_slots   = nof_slots;
+    r.nof_workers = nof_workers;
+    r.nof_ues     = nof_ues[idx % nof_ues.size()];
+    idx /= nof_ues.size();
+    r.nof_cc = nof_cc[idx % nof_cc.size()];
+    idx /= nof_cc.size();
+    r.cqi = cqi[idx % cqi.size()];
+    idx /= cqi.size();
+    r.traffic = traffic[idx % traffic.size()];
+    idx /= traffic.size();
+    r.phy_cfg = phy_cfg.at(idx);
+    return r;
+  }
+};
+
+/// CQI trace shared by all the runs. When empty, the UEs report the CQI of the run parameters
+static sched_cqi_trace cqi_trace_file{0};
+
+class sched_nr_bench_tester : public sched_nr_base_test_bench
+{
+public:
+  sched_nr_bench_tester(const run_params&                       params_,
+                        const sched_nr_interface::sched_args_t& sched_args,
+                        const std::vector<sched_nr_cell_cfg_t>& cells_cfg) :
+    sched_nr_base_test_bench(sched_args, cells_cfg, "Scheduler NR Benchmark", params_.nof_workers), params(params_)
+  {}
+
+  void add_traffic(uint16_t rnti, uint32_t ue_idx)
+  {
+    ue_traffic.emplace(rnti, ue_traffic_ctxt{ue_idx, sched_traffic_source{params.traffic, rnti}});
+  }
+
+  void set_external_slot_events(const sim_nr_ue_ctxt_t& ue_ctxt, ue_nr_slot_events& pending_events) override
+  {
+    auto&    traffic = ue_traffic.at(ue_ctxt.rnti);
+    uint32_t count   = pending_events.slot_rx.to_uint();
+
+    if (not traffic.source.is_full_buffer()) {
+      uint32_t new_dl_bytes, new_ul_bytes;
+      traffic.source.step(count, new_dl_bytes, new_ul_bytes);
+      if (new_dl_bytes > 0) {
+        add_rlc_dl_bytes(ue_ctxt.rnti, drb_lcid, new_dl_bytes);
+      }
+      traffic.ul_pending += new_ul_bytes;
+      if (new_ul_bytes > 0 or traffic.ul_changed) {
+        sched_ptr->ul_bsr(ue_ctxt.rnti, drb_lcg, traffic.ul_pending);
+      }
+      traffic.ul_changed = false;
+    }
+
+    uint32_t cqi = cqi_trace_file.empty() ? params.cqi : cqi_trace_file.get_cqi(traffic.ue_idx, count);
+    for (auto& cc_events : pending_events.cc_list) {
+      // if CQI is expected, replace it by the trace value
+      if (cc_events.cqi >= 0) {
+        cc_events.cqi = cqi;
+      }
+    }
+  }
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& enb_ctxt, srsran::const_span<cc_result_t> cc_out) override
+  {
+    if (not measuring) {
+      return;
+    }
+    latency.push(std::max_element(cc_out.begin(), cc_out.end(), [](const cc_result_t& lhs, const cc_result_t& rhs) {
+                   return lhs.cc_latency_ns < rhs.cc_latency_ns;
+                 })->cc_latency_ns.count());
+    nof_slots++;
+
+    for (auto& cc : cc_out) {
+      for (auto& pdsch : cc.res.dl->phy.pdsch) {
+        if (pdsch.sch.grant.rnti_type == srsran_rnti_type_c) {
+          dl_bytes += pdsch.sch.grant.tb[0].tbs / 8u;
+        }
+      }
+      for (auto& pusch : cc.res.ul->pusch) {
+        if (pusch.sch.grant.rnti_type != srsran_rnti_type_c) {
+          continue;
+        }
+        ul_bytes += pusch.sch.grant.tb[0].tbs / 8u;
+        auto it = ue_traffic.find(pusch.sch.grant.rnti);
+        if (it != ue_traffic.end() and pusch.sch.grant.tb[0].rv == 0) {
+          it->second.ul_pending -= std::min(it->second.ul_pending, pusch.sch.grant.tb[0].tbs / 8u);
+          it->second.ul_changed = true;
+        }
+      }
+    }
+  }
+
+  run_params          params;
+  bool                measuring = false;
+  uint32_t            nof_slots = 0;
+  uint64_t            dl_bytes = 0, ul_bytes = 0;
+  sched_latency_stats latency;
+
+private:
+  /// UL buffer of the UEs that follow a traffic model. The DL buffers are kept by the base test bench
+  struct ue_traffic_ctxt {
+    uint32_t             ue_idx;
+    sched_traffic_source source;
+    uint32_t             ul_pending = 0;
+    bool                 ul_changed = false;
+  };
+  std::map<uint16_t, ue_traffic_ctxt> ue_traffic;
+};
+
+struct run_data {
+  run_params params;
+  double     dl_mbps;
+  double     ul_mbps;
+  double     avg_latency_usec;
+  double     q0_5_latency_usec;
+  double     q0_9_latency_usec;
+  double     q0_99_latency_usec;
+  double     max_latency_usec;
+};
+
+run_data run_benchmark_scenario(const run_params& params)
+{
+  srsran::phy_cfg_nr_default_t::reference_cfg_t ref(params.phy_cfg);
+  srsran::phy_cfg_nr_t                          phy_cfg = srsran::phy_cfg_nr_default_t{ref};
+
+  sched_nr_interface::sched_args_t sched_args;
+  sched_args.auto_refill_buffer              = params.traffic == sched_traffic_type::full_buffer;
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(params.nof_cc, phy_cfg);
+
+  sched_nr_bench_tester tester(params, sched_args, cells_cfg);
+
+  sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(params.nof_cc, phy_cfg);
+  uecfg.lc_ch_to_add.emplace_back();
+  uecfg.lc_ch_to_add.back().lcid          = drb_lcid;
+  uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+  uecfg.lc_ch_to_add.back().cfg.group     = drb_lcg;
+
+  // Warm-up slots with the UEs already connected, so that the HARQs and the CQI reach steady state
+  uint32_t nof_warmup_slots = 100;
+  for (uint32_t count = 0; count < nof_warmup_slots + params.nof_slots; ++count) {
+    slot_point slot_rx(phy_cfg.carrier.scs, count % (1024 * SRSRAN_NSLOTS_PER_FRAME_NR(phy_cfg.carrier.scs)));
+    if (count == 9) {
+      for (uint32_t ue_idx = 0; ue_idx < params.nof_ues; ++ue_idx) {
+        uint16_t rnti = 0x4601 + ue_idx;
+        tester.add_traffic(rnti, ue_idx);
+        tester.user_cfg(rnti, uecfg);
+      }
+    }
+    tester.measuring = count >= nof_warmup_slots;
+    tester.run_slot(slot_rx + TX_ENB_DELAY);
+  }
+  tester.stop();
+
+  double meas_sec = 1e-3 / SRSRAN_NSLOTS_PER_SF_NR(phy_cfg.carrier.scs) * std::max(tester.nof_slots, 1U);
+
+  run_data r           = {};
+  r.params             = params;
+  r.dl_mbps            = tester.dl_bytes * 8 / meas_sec / 1e6;
+  r.ul_mbps            = tester.ul_bytes * 8 / meas_sec / 1e6;
+  r.avg_latency_usec   = tester.latency.mean_usec();
+  r.q0_5_latency_usec  = tester.latency.percentile_usec(0.5);
+  r.q0_9_latency_usec  = tester.latency.percentile_usec(0.9);
+  r.q0_99_latency_usec = tester.latency.percentile_usec(0.99);
+  r.max_latency_usec   = tester.latency.percentile_usec(1.0);
+  return r;
+}
+
+void print_benchmark_results(const std::vector<run_data>& run_results)
+{
+  srslog::flush();
+  fmt::print("run |                   phy cfg | Ncc | cqi |     traffic |  Nue | DL/UL [Mbps] | "
+             "latency mean/q0.5/q0.9/q0.99/max [usec]\n");
+  fmt::print("------------------------------------------------------------------------------------------------------"
+             "-----------------\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const run_data& r       = run_results[i];
+    std::string     cqi_str = cqi_trace_file.empty() ? std::to_string(r.params.cqi) : "trace";
+
+    fmt::print("{:>3d}{:>28}{:>6d}{:>6}{:>14}{:>7d}{:>9.2f}/{:>5.2f}{:>11.1f}/{:.1f}/{:.1f}/{:.1f}/{:.1f}\n",
+               i,
+               r.params.phy_cfg,
+               r.params.nof_cc,
+               cqi_str,
+               to_string(r.params.traffic),
+               r.params.nof_ues,
+               r.dl_mbps,
+               r.ul_mbps,
+               r.avg_latency_usec,
+               r.q0_5_latency_usec,
+               r.q0_9_latency_usec,
+               r.q0_99_latency_usec,
+               r.max_latency_usec);
+  }
+}
+
+int run_param_sweep(const run_params_range& run_param_list, double max_q0_99_latency_usec)
+{
+  std::vector<run_data> run_results;
+  for (size_t r = 0; r < run_param_list.nof_runs(); ++r) {
+    run_results.push_back(run_benchmark_scenario(run_param_list.get_params(r)));
+    TESTASSERT(run_results.back().params.traffic != sched_traffic_type::full_buffer or run_results.back().dl_mbps > 0);
+  }
+
+  print_benchmark_results(run_results);
+
+  // Fail if the q0.99 scheduling latency of any run exceeds the given budget
+  bool success = true;
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    if (max_q0_99_latency_usec > 0 and run_results[i].q0_99_latency_usec > max_q0_99_latency_usec) {
+      fmt::print("run {}: latency q0.99 above budget ({:.1f} > {:.1f}) usec\n",
+                 i,
+                 run_results[i].q0_99_latency_usec,
+                 max_q0_99_latency_usec);
+      success = false;
+    }
+  }
+  return success ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
+
+struct bench_args_t {
+  run_params_range run_param_list;
+  double           max_q0_99_latency_usec = 0;
+  std::string      mac_log_level;
+};
+
+template <typename T>
+void parse_param_list(const bpo::variables_map& vm, const char* name, char delimiter, std::vector<T>& list)
+{
+  if (vm.count(name) > 0) {
+    srsran::string_parse_list(vm[name].as<std::string>(), delimiter, list);
+  }
+}
+
+bench_args_t handle_args(int argc, char** argv)
+{
+  bench_args_t      args;
+  run_params_range& range = args.run_param_list;
+  std::string       cqi_trace_filename;
+
+  bpo::options_description options("Scheduler NR benchmark options");
+
+  // clang-format off
+  options.add_options()
+      ("nof_slots",     bpo::value<uint32_t>(&range.nof_slots), "Number of slots of each run")
+      ("nof_workers",   bpo::value<uint32_t>(&range.nof_workers), "Number of threads generating the carrier results")
+      ("nof_ues",       bpo::value<std::string>(), "Comma separated list of UE counts")
+      ("nof_cc",        bpo::value<std::string>(), "Comma separated list of aggregated carriers per UE")
+      ("cqi",           bpo::value<std::string>(), "Comma separated list of fixed DL CQIs")
+      ("cqi_trace",     bpo::value<std::string>(&cqi_trace_filename), "File with one CQI per slot. It overrides the fixed CQIs")
+      ("traffic",       bpo::value<std::string>(), "Comma separated list of traffic models: full_buffer, voip, web")
+      ("phy_cfg",       bpo::value<std::string>(), "Semicolon separated list of PHY reference configurations, e.g. carrier=20MHz,duplex=FDD")
+      ("max_latency",   bpo::value<double>(&args.max_q0_99_latency_usec), "Fail if the q0.99 slot scheduling latency exceeds this value in usec")
+      ("log.mac_level", bpo::value<std::string>(&args.mac_log_level)->default_value("error"), "MAC log level")
+      ("help",          "Show this message")
+      ;
+  // clang-format on
+
+  bpo::variables_map vm;
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv).options(options).run(), vm);
+    bpo::notify(vm);
+  } catch (bpo::error& e) {
+    srsran_terminate("%s", e.what());
+  }
+
+  if (vm.count("help")) {
+    fmt::print("Usage: {} [OPTIONS]\n\n{}\n", argv[0], options);
+    exit(0);
+  }
+
+  parse_param_list(vm, "nof_ues", ',', range.nof_ues);
+  parse_param_list(vm, "nof_cc", ',', range.nof_cc);
+  parse_param_list(vm, "cqi", ',', range.cqi);
+  parse_param_list(vm, "phy_cfg", ';', range.phy_cfg);
+  if (vm.count("traffic") > 0) {
+    std::vector<std::string> traffic_list;
+    parse_param_list(vm, "traffic", ',', traffic_list);
+    range.traffic.resize(traffic_list.size());
+    for (uint32_t i = 0; i < traffic_list.size(); ++i) {
+      if (not parse_sched_traffic_type(traffic_list[i], range.traffic[i])) {
+        srsran_terminate("Invalid traffic model \"%s\"", traffic_list[i].c_str());
+      }
+    }
+  }
+  if (not cqi_trace_filename.empty() and not cqi_trace_file.load(cqi_trace_filename)) {
+    srsran_terminate("Failed to read CQI trace %s", cqi_trace_filename.c_str());
+  }
+  if (std::any_of(range.nof_ues.begin(), range.nof_ues.end(), [](uint32_t n) { return n > SRSENB_MAX_UES; })) {
+    srsran_terminate("The gNB supports up to %d UEs", SRSENB_MAX_UES);
+  }
+  if (range.nof_runs() == 0 or range.nof_slots == 0 or range.nof_workers == 0) {
+    srsran_terminate("Empty list of run parameters");
+  }
+
+  return args;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  // Start the log backend.
+  srslog::init();
+
+  srsenb::bench_args_t args = srsenb::handle_args(argc, argv);
+
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::warning);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  mac_nr_logger.set_level(srslog::str_to_basic_level(args.mac_log_level));
+  auto& pool_logger = srslog::fetch_basic_logger("POOL");
+  pool_logger.set_level(srslog::basic_levels::debug);
+
+  fmt::print("Running {} param combinations\n", args.run_param_list.nof_runs());
+  TESTASSERT(srsenb::run_param_sweep(args.run_param_list, args.max_q0_99_latency_usec) == SRSRAN_SUCCESS);
+
+  return 0;
+}
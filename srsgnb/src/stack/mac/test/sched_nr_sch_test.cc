@@ -20,6 +20,7 @@
  */
 
 #include "sched_nr_cfg_generators.h"
+#include "srsgnb/hdr/stack/mac/sched_nr_helpers.h"
 #include "srsgnb/hdr/stack/mac/sched_nr_interface_utils.h"
 #include "srsgnb/hdr/stack/mac/sched_nr_sch.h"
 #include "srsran/common/test_common.h"
@@ -416,6 +417,46 @@ void test_multi_pdsch()
   TESTASSERT_EQ(0, pdsch_sched.occupied_prbs(2, srsran_dci_format_nr_1_0).count());
 }
 
+void test_co_scheduled_pdsch()
+{
+  srsran::test_delimit_logger delimiter{"Test Co-scheduled PDSCH Allocations"};
+
+  // Create Cell and UE configs
+  sched_nr_interface::sched_args_t   sched_args;
+  sched_nr_cell_cfg_t                cellcfg = get_cell_cfg();
+  sched_nr_impl::cell_config_manager cell_params{0, cellcfg, sched_args};
+  sched_nr_impl::ue_cfg_manager      uecfg{get_ue_cfg(cellcfg)};
+  const bwp_params_t&                bwp_params = cell_params.bwps[0];
+  ue_carrier_params_t                ue_cc{0x4601, bwp_params, uecfg};
+  ue_carrier_params_t                ue_cc2{0x4602, bwp_params, uecfg};
+
+  pdsch_list_t       pdschs;
+  pdsch_alloc_result alloc_res;
+
+  pdsch_allocator pdsch_sched(bwp_params, 0, pdschs);
+
+  pdcch_dl_t pdcch_ue;
+  pdcch_ue.dci.ctx = generate_dci_ctx(bwp_params.cfg.pdcch, 2, srsran_rnti_type_c, 0x4601);
+
+  uint32_t     ss_id     = 2;
+  prb_bitmap   used_prbs = pdsch_sched.occupied_prbs(ss_id, srsran_dci_format_nr_1_0);
+  prb_interval ue_grant  = find_empty_interval_of_length(used_prbs, 10, 0);
+  TESTASSERT_EQ(alloc_result::success, pdsch_sched.is_ue_grant_valid(ue_cc, ss_id, srsran_dci_format_nr_1_0, ue_grant));
+  alloc_res = pdsch_sched.alloc_ue_pdsch(ss_id, srsran_dci_format_nr_1_0, ue_grant, ue_cc, pdcch_ue.dci);
+  TESTASSERT(alloc_res.has_value());
+
+  // A second UE only fits in the same PRBs if it is spatially multiplexed with the first one
+  TESTASSERT_EQ(alloc_result::sch_collision,
+                pdsch_sched.is_ue_grant_valid(ue_cc2, ss_id, srsran_dci_format_nr_1_0, ue_grant));
+  TESTASSERT_EQ(alloc_result::success,
+                pdsch_sched.is_ue_grant_valid(ue_cc2, ss_id, srsran_dci_format_nr_1_0, ue_grant, true));
+
+  // Beam correlation of the 2-port Type I codebook
+  TESTASSERT(std::abs(pmi_correlation(2, 1, 1) - 1.0f) < 1e-3f);
+  TESTASSERT(pmi_correlation(2, 0, 2) < 1e-3f);
+  TESTASSERT(pmi_correlation(2, 0, 1) > pmi_correlation(2, 0, 2));
+}
+
 void test_multi_pusch()
 {
   srsran::test_delimit_logger delimiter{"Test Multiple PUSCH Allocations"};
@@ -492,5 +533,6 @@ int main()
   srsenb::test_ue_pdsch();
   srsenb::test_pdsch_fail();
   srsenb::test_multi_pdsch();
+  srsenb::test_co_scheduled_pdsch();
   srsenb::test_multi_pusch();
 }
\ No newline at end of file
@@ -403,10 +403,17 @@ bool ngap::handle_ngap_rx_pdu(srsran::byte_buffer_t* pdu)
   }
 
   // Unpack
-  ngap_pdu_c     rx_pdu;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
+  // The previous PDU was destroyed, its memory is reused. The handlers copy what they keep outside of the scope
+  rx_pdu_arena.reset();
+  ngap_pdu_c        rx_pdu;
+  asn1::cbit_ref    bref(pdu->msg, pdu->N_bytes);
+  asn1::SRSASN_CODE unpack_ret;
+  {
+    asn1::decode_arena_scope arena_scope(rx_pdu_arena);
+    unpack_ret = rx_pdu.unpack(bref);
+  }
 
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  if (unpack_ret != asn1::SRSASN_SUCCESS) {
     logger.error(pdu->msg, pdu->N_bytes, "Failed to unpack received PDU");
     cause_c cause;
     cause.set_protocol().value = cause_protocol_opts::transfer_syntax_error;
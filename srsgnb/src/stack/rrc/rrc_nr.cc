@@ -102,6 +102,10 @@ int rrc_nr::init(const rrc_nr_cfg_t&         cfg_,
   config_phy(); // if PHY is not yet initialized, config will be stored and applied on initialization
   config_mac();
 
+  if (cfg.nof_pack_workers > 0) {
+    pack_workers.reset(new srsran::task_thread_pool(cfg.nof_pack_workers));
+  }
+
   logger.info("Number of 5QI %d", cfg.five_qi_cfg.size());
   for (const std::pair<const uint32_t, rrc_nr_cfg_five_qi_t>& five_qi_cfg : cfg.five_qi_cfg) {
     logger.info("5QI configuration. 5QI=%d", five_qi_cfg.first);
@@ -132,6 +136,9 @@ void rrc_nr::stop()
   if (running) {
     running = false;
   }
+  if (pack_workers != nullptr) {
+    pack_workers->stop();
+  }
   users.clear();
 }
 
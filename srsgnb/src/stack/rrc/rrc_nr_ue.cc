@@ -159,6 +159,10 @@ int rrc_nr::ue::send_dl_ccch(const dl_ccch_msg_s& dl_ccch_msg)
 
 int rrc_nr::ue::send_dl_dcch(srsran::nr_srb srb, const asn1::rrc_nr::dl_dcch_msg_s& dl_dcch_msg)
 {
+  if (parent->pack_workers != nullptr) {
+    return send_dl_dcch_async(srb, dl_dcch_msg);
+  }
+
   // Allocate a new PDU buffer, pack the message and send to PDCP
   srsran::unique_byte_buffer_t pdu = parent->pack_into_pdu(dl_dcch_msg, __FUNCTION__);
   if (pdu == nullptr) {
@@ -172,6 +176,63 @@ int rrc_nr::ue::send_dl_dcch(srsran::nr_srb srb, const asn1::rrc_nr::dl_dcch_msg
   return SRSRAN_SUCCESS;
 }
 
+/// Packs the DL-DCCH message in the RRC pack workers. The PDUs are sent to PDCP in the stack thread, in the same
+/// order as the calls to this function, once they and all the earlier messages of the UE have been packed
+int rrc_nr::ue::send_dl_dcch_async(srsran::nr_srb srb, const asn1::rrc_nr::dl_dcch_msg_s& dl_dcch_msg)
+{
+  pending_dl_dcch.emplace_back();
+  pending_dl_dcch_t& pending = pending_dl_dcch.back();
+  pending.seq                = parent->next_dl_dcch_seq++;
+  pending.srb                = srb;
+  pending.msg                = std::make_shared<const dl_dcch_msg_s>(dl_dcch_msg);
+
+  rrc_nr*  rrc_ptr = parent;
+  uint16_t ue_rnti = rnti;
+  uint32_t seq     = pending.seq;
+  auto     msg     = pending.msg;
+  parent->pack_workers->push_task([rrc_ptr, ue_rnti, seq, msg]() {
+    srsran::unique_byte_buffer_t pdu = rrc_ptr->pack_into_pdu(*msg, "send_dl_dcch");
+    // Return the PDU to the stack thread. The UE may have been removed in the meantime
+    rrc_ptr->task_sched.notify_background_task_result([rrc_ptr, ue_rnti, seq, pdu = std::move(pdu)]() mutable {
+      auto ue_it = rrc_ptr->users.find(ue_rnti);
+      if (ue_it != rrc_ptr->users.end()) {
+        ue_it->second->handle_dl_dcch_packed(seq, std::move(pdu));
+      }
+    });
+  });
+  return SRSRAN_SUCCESS;
+}
+
+void rrc_nr::ue::handle_dl_dcch_packed(uint32_t seq, srsran::unique_byte_buffer_t pdu)
+{
+  auto it = std::find_if(pending_dl_dcch.begin(), pending_dl_dcch.end(), [seq](const pending_dl_dcch_t& p) {
+    return p.seq == seq;
+  });
+  if (it == pending_dl_dcch.end()) {
+    // The message belongs to a former UE context with the same RNTI
+    return;
+  }
+  it->pdu    = std::move(pdu);
+  it->packed = true;
+
+  // Send the packed messages that are not waiting for earlier ones
+  while (not pending_dl_dcch.empty() and pending_dl_dcch.front().packed) {
+    pending_dl_dcch_t& pending = pending_dl_dcch.front();
+    if (pending.pdu == nullptr) {
+      logger.error("Failed to send DL-DCCH.%s", pending.msg->msg.c1().type().to_string());
+      if (parent->ngap != nullptr) {
+        parent->ngap->user_release_request(rnti, asn1::ngap::cause_radio_network_opts::radio_res_not_available);
+      }
+    } else {
+      fmt::memory_buffer fmtbuf;
+      fmt::format_to(fmtbuf, "DL-DCCH.{}", pending.msg->msg.c1().type().to_string());
+      log_rrc_message(pending.srb, Tx, *pending.pdu.get(), *pending.msg, srsran::to_c_str(fmtbuf));
+      parent->pdcp->write_sdu(rnti, srsran::srb_to_lcid(pending.srb), std::move(pending.pdu));
+    }
+    pending_dl_dcch.pop_front();
+  }
+}
+
 int rrc_nr::ue::pack_secondary_cell_group_mac_cfg(asn1::rrc_nr::cell_group_cfg_s& cell_group_cfg_pack)
 {
   // mac-CellGroup-Config for BSR and SR
@@ -26,6 +26,7 @@
 #include "srsran/common/test_common.h"
 #include "srsran/interfaces/gnb_rrc_nr_interfaces.h"
 #include <iostream>
+#include <thread>
 
 using namespace asn1::rrc_nr;
 
@@ -143,27 +144,15 @@ int test_rrc_setup()
   return SRSRAN_SUCCESS;
 }
 
-void test_rrc_sa_connection()
+void generate_sa_rrc_cfg(rrc_nr_cfg_t& rrc_cfg_nr)
 {
-  srsran::test_delimit_logger test_logger{"SA RRCConnectionEstablishment"};
-
-  srsran::task_scheduler task_sched;
-  phy_nr_dummy           phy_obj;
-  mac_nr_dummy           mac_obj;
-  rlc_nr_rrc_tester      rlc_obj;
-  pdcp_nr_rrc_tester     pdcp_obj;
-  ngap_rrc_tester        ngap_obj;
-  enb_bearer_manager     bearer_mapper;
-
-  rrc_nr rrc_obj(&task_sched);
-
   // Dummy RLC/PDCP configs
   asn1::rrc_nr::rlc_cfg_c rlc_cfg;
   rlc_cfg.set_um_bi_dir();
   rlc_cfg.um_bi_dir().dl_um_rlc.t_reassembly = t_reassembly_e::ms50;
 
   // set cfg
-  rrc_nr_cfg_t rrc_cfg_nr = {};
+  rrc_cfg_nr = {};
   rrc_cfg_nr.cell_list.emplace_back();
   generate_default_nr_cell(rrc_cfg_nr.cell_list[0]);
   rrc_cfg_nr.cell_list[0].phy_cell.carrier.pci     = 500;
@@ -179,6 +168,24 @@ void test_rrc_sa_connection()
   srsran::string_to_mcc("001", &rrc_cfg_nr.mcc);
   srsran::string_to_mnc("01", &rrc_cfg_nr.mnc);
   set_derived_nr_cell_params(rrc_cfg_nr.is_standalone, rrc_cfg_nr.cell_list[0]);
+}
+
+void test_rrc_sa_connection()
+{
+  srsran::test_delimit_logger test_logger{"SA RRCConnectionEstablishment"};
+
+  srsran::task_scheduler task_sched;
+  phy_nr_dummy           phy_obj;
+  mac_nr_dummy           mac_obj;
+  rlc_nr_rrc_tester      rlc_obj;
+  pdcp_nr_rrc_tester     pdcp_obj;
+  ngap_rrc_tester        ngap_obj;
+  enb_bearer_manager     bearer_mapper;
+
+  rrc_nr rrc_obj(&task_sched);
+
+  rrc_nr_cfg_t rrc_cfg_nr;
+  generate_sa_rrc_cfg(rrc_cfg_nr);
 
   TESTASSERT(
       rrc_obj.init(rrc_cfg_nr, &phy_obj, &mac_obj, &rlc_obj, &pdcp_obj, &ngap_obj, nullptr, bearer_mapper, nullptr) ==
@@ -195,6 +202,54 @@ void test_rrc_sa_connection()
   test_rrc_nr_2nd_reconfiguration(task_sched, rrc_obj, pdcp_obj, ngap_obj, 0x4601);
 }
 
+/// The DL-DCCH messages packed by the RRC pack workers reach PDCP once the stack thread handles the result
+void test_rrc_sa_dl_dcch_pack_workers()
+{
+  srsran::test_delimit_logger test_logger{"SA DL-DCCH pack workers"};
+
+  srsran::task_scheduler task_sched;
+  phy_nr_dummy           phy_obj;
+  mac_nr_dummy           mac_obj;
+  rlc_nr_rrc_tester      rlc_obj;
+  pdcp_nr_rrc_tester     pdcp_obj;
+  ngap_rrc_tester        ngap_obj;
+  enb_bearer_manager     bearer_mapper;
+
+  rrc_nr rrc_obj(&task_sched);
+
+  rrc_nr_cfg_t rrc_cfg_nr;
+  generate_sa_rrc_cfg(rrc_cfg_nr);
+  rrc_cfg_nr.nof_pack_workers = 2;
+
+  TESTASSERT(
+      rrc_obj.init(rrc_cfg_nr, &phy_obj, &mac_obj, &rlc_obj, &pdcp_obj, &ngap_obj, nullptr, bearer_mapper, nullptr) ==
+      SRSRAN_SUCCESS);
+
+  TESTASSERT_SUCCESS(rrc_obj.add_user(0x4601, 0));
+  TESTASSERT_SUCCESS(rrc_obj.ue_set_security_cfg_key(0x4601, {}));
+
+  test_rrc_nr_connection_establishment(task_sched, rrc_obj, rlc_obj, mac_obj, ngap_obj, 0x4601);
+
+  TESTASSERT_SUCCESS(rrc_obj.start_security_mode_procedure(0x4601, nullptr));
+  TESTASSERT(pdcp_obj.last_sdu == nullptr);
+  for (uint32_t i = 0; i < 1000 and pdcp_obj.last_sdu == nullptr; ++i) {
+    task_sched.run_pending_tasks();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  TESTASSERT(pdcp_obj.last_sdu != nullptr);
+  TESTASSERT_EQ(0x4601, pdcp_obj.last_sdu_rnti);
+  TESTASSERT_EQ(srsran::srb_to_lcid(srsran::nr_srb::srb1), pdcp_obj.last_sdu_lcid);
+
+  dl_dcch_msg_s dl_dcch_msg;
+  {
+    asn1::cbit_ref bref{pdcp_obj.last_sdu->data(), pdcp_obj.last_sdu->size()};
+    TESTASSERT_SUCCESS(dl_dcch_msg.unpack(bref));
+  }
+  TESTASSERT_EQ(dl_dcch_msg_type_c::c1_c_::types_opts::security_mode_cmd, dl_dcch_msg.msg.c1().type().value);
+
+  rrc_obj.stop();
+}
+
 } // namespace srsenb
 
 int main(int argc, char** argv)
@@ -221,6 +276,7 @@ int main(int argc, char** argv)
   srsenb::test_sib_generation();
   TESTASSERT(srsenb::test_rrc_setup() == SRSRAN_SUCCESS);
   srsenb::test_rrc_sa_connection();
+  srsenb::test_rrc_sa_dl_dcch_pack_workers();
   TESTASSERT_EQ(0, spy->get_warning_counter());
   TESTASSERT_EQ(0, spy->get_error_counter());
 
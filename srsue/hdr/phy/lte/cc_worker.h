@@ -22,6 +22,7 @@
 #ifndef SRSUE_LTE_CC_WORKER_H
 #define SRSUE_LTE_CC_WORKER_H
 
+#include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/srsran.h"
 #include "srsue/hdr/phy/phy_common.h"
@@ -54,7 +55,8 @@ public:
 
   void set_uci_periodic_cqi(srsran_uci_data_t* uci_data);
 
-  bool work_dl_regular();
+  bool work_dl_regular(srsran::task_thread_pool* pdsch_pool = nullptr);
+  void wait_pdsch();
   bool work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg);
   bool work_ul(srsran_uci_data_t* uci_data);
 
@@ -83,6 +85,7 @@ private:
   int  decode_pdsch(srsran_pdsch_ack_resource_t            ack_resource,
                     mac_interface_phy_lte::tb_action_dl_t* action,
                     bool                                   acks[SRSRAN_MAX_CODEWORDS]);
+  void decode_pdsch_tb();
   int  decode_pmch(mac_interface_phy_lte::tb_action_dl_t* action, srsran_mbsfn_cfg_t* mbsfn_cfg);
   void new_mch_dl(mac_interface_phy_lte::tb_action_dl_t*);
   /* Methods for UL */
@@ -117,6 +120,14 @@ private:
   srsran_chest_dl_cfg_t chest_mbsfn_cfg   = {};
   srsran_chest_dl_cfg_t chest_default_cfg = {};
 
+  // PDSCH decoded by a helper thread, the worker waits for it before the ue_dl object is used again
+  mac_interface_phy_lte::mac_grant_dl_t pdsch_mac_grant    = {};
+  mac_interface_phy_lte::tb_action_dl_t pdsch_action       = {};
+  srsran_pdsch_ack_resource_t           pdsch_ack_resource = {};
+  bool                                  pdsch_pending      = false;
+  std::mutex                            pdsch_mutex;
+  std::condition_variable               pdsch_cvar;
+
   /* Objects for UL */
   srsran_ue_ul_t     ue_ul     = {};
   srsran_ue_ul_cfg_t ue_ul_cfg = {};
@@ -98,6 +98,9 @@ private:
   float prach_power = 0;
 
   srsran::phy_common_interface::worker_context_t context = {};
+
+  // Helper threads decoding the PDSCH of every carrier while the UL of TTI+4 is generated
+  std::unique_ptr<srsran::task_thread_pool> pdsch_pool;
 };
 
 } // namespace lte
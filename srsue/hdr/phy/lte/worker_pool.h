@@ -49,6 +49,13 @@ private:
   std::mutex                                       phy_cfg_mutex; ///< Protects configuration stash
   std::array<phy_cfg_stash_t, SRSRAN_MAX_CARRIERS> phy_cfg_stash; ///< Stores the latest worker configuration
 
+  // Worker autoscaling, the load is measured every period and the unneeded workers are parked
+  const static uint32_t autoscale_period_tti = 1000;
+  bool                  autoscale_enabled    = false;
+  uint32_t              autoscale_min        = 1;
+  float                 autoscale_load       = 0.7f;
+  uint32_t              autoscale_count      = 0;
+
 public:
   sf_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
 
@@ -22,9 +22,14 @@
 #ifndef SRSUE_CELL_SEARCH_H
 #define SRSUE_CELL_SEARCH_H
 
+#include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/interfaces/ue_nr_interfaces.h"
 #include "srsran/srsran.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace srsue {
 namespace nr {
@@ -34,12 +39,15 @@ public:
   struct args_t {
     double                      max_srate_hz;
     srsran_subcarrier_spacing_t ssb_min_scs = srsran_subcarrier_spacing_15kHz;
+    uint32_t                    max_nof_ssb = 1; ///< Maximum number of SSB frequencies searched in one capture
+    uint32_t                    nof_threads = 0; ///< Threads searching SSB frequencies in parallel (0 for none)
   };
 
   struct cfg_t {
     double                      srate_hz;
     double                      center_freq_hz;
     double                      ssb_freq_hz;
+    std::vector<double>         ssb_freq_hz_list; ///< Other SSB frequencies searched within the same capture
     srsran_subcarrier_spacing_t ssb_scs;
     srsran_ssb_pattern_t        ssb_pattern;
     srsran_duplex_mode_t        duplex_mode;
@@ -48,6 +56,7 @@ public:
   struct ret_t {
     enum { CELL_FOUND = 1, CELL_NOT_FOUND = 0, ERROR = -1 } result;
     srsran_ssb_search_res_t ssb_res;
+    double                  ssb_freq_hz; ///< SSB center frequency of the found cell
   };
 
   cell_search(srslog::basic_logger& logger);
@@ -59,8 +68,19 @@ public:
   ret_t run_slot(const cf_t* buffer, uint32_t slot_sz);
 
 private:
-  srslog::basic_logger&        logger;
-  srsran_ssb_t                 ssb    = {};
+  srslog::basic_logger&     logger;
+  std::vector<srsran_ssb_t> ssb;             ///< One SSB searcher for each SSB frequency in the capture
+  std::vector<double>       ssb_freq_hz;     ///< SSB center frequency of each configured searcher
+  std::vector<ret_t>        ssb_ret;         ///< Search result of each configured searcher
+  uint32_t                  nof_ssb     = 0; ///< Number of configured searchers
+  uint32_t                  nof_pending = 0; ///< Number of searchers running in the thread pool
+  std::mutex                pending_mutex;
+  std::condition_variable   pending_cvar;
+
+  // Searches the SSB frequencies other than the first one, the first is always searched by the calling thread
+  std::unique_ptr<srsran::task_thread_pool> pool;
+
+  void run_ssb(uint32_t idx, const cf_t* buffer, uint32_t nof_samples);
 };
 } // namespace nr
 } // namespace srsue
@@ -54,11 +54,15 @@ public:
     float                       pbch_dmrs_thr   = 0.0f; ///< PBCH DMRS correlation detection threshold (0 means auto)
     float                       cfo_alpha       = 0.0f; ///< CFO averaging alpha (0 means auto)
     int                         thread_priority = 1;
+    uint32_t                    max_nof_ssb     = 1; ///< Maximum SSB frequencies searched within the same capture
+    uint32_t                    nof_threads     = 0; ///< Threads for searching SSB frequencies in parallel
 
     cell_search::args_t get_cell_search() const
     {
       cell_search::args_t ret = {};
       ret.max_srate_hz        = srate_hz;
+      ret.max_nof_ssb         = max_nof_ssb;
+      ret.nof_threads         = nof_threads;
       return ret;
     }
 
@@ -45,6 +45,10 @@ private:
   srsran::phy_cfg_nr_t                     cfg{};
   std::vector<bool>                        pending_cfgs;
   std::mutex                               cfg_mutex;
+  uint32_t                                 autoscale_count = 0;
+
+  // The load is measured every period and the workers the load does not need are parked
+  const static uint32_t autoscale_period_tti = 1000;
 
 public:
   sf_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
@@ -174,6 +174,13 @@ public:
                           srsran_pdsch_ack_resource_t resource);
   bool get_dl_pending_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, srsran_pdsch_ack_cc_t* ack);
 
+  /**
+   * Marks the PDSCH of sf->tti as being decoded by a helper thread. get_dl_pending_ack() waits for its ACK until
+   * set_dl_ack_decoded() is called
+   */
+  void set_dl_ack_decoding(srsran_dl_sf_cfg_t* sf, uint32_t cc_idx);
+  void set_dl_ack_decoded(srsran_dl_sf_cfg_t* sf, uint32_t cc_idx);
+
   void worker_end(const worker_context_t& w_ctx, const bool& tx_enable, srsran::rf_buffer_t& buffer) override;
 
   void set_cell(const srsran_cell_t& c);
@@ -381,12 +388,14 @@ private:
 
   typedef struct {
     bool                        enable;
+    bool                        decoding; // The PDSCH is still being decoded by a helper thread
     uint8_t                     value[SRSRAN_MAX_CODEWORDS]; // 0/1 or 2 for DTX
     srsran_pdsch_ack_resource_t resource;
   } received_ack_t;
   srsran::circular_array<received_ack_t, TTIMOD_SZ> pending_dl_ack[SRSRAN_MAX_CARRIERS] = {};
   srsran::circular_array<uint32_t, TTIMOD_SZ>       pending_dl_dai[SRSRAN_MAX_CARRIERS] = {};
   std::mutex                                        pending_dl_ack_mutex;
+  std::condition_variable                           pending_dl_ack_cvar;
   std::mutex                                        pending_dl_grant_mutex;
 
   // Cross-carried grants scheduled from PCell
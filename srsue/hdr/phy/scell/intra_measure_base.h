@@ -113,8 +113,9 @@ public:
    * @param tti The current physical layer TTI, used for calculating the buffer write
    * @param data buffer with baseband IQ samples
    * @param nsamples number of samples to write
+   * @param rx_time Radio time of the first sample, optional
    */
-  void run_tti(uint32_t tti, cf_t* data, uint32_t nsamples);
+  void run_tti(uint32_t tti, cf_t* data, uint32_t nsamples, const srsran_timestamp_t& rx_time = {});
 
   /**
    * @brief Get EARFCN of this component
@@ -141,6 +142,8 @@ protected:
     uint32_t           meas_period_ms     = 200; ///< Minimum time between measurements
     uint32_t           trigger_tti_period = 0;   ///< Measurement TTI trigger period
     uint32_t           trigger_tti_offset = 0;   ///< Measurement TTI trigger offset
+    uint32_t           tti                = 0;   ///< TTI of the first sub-frame in the measurement buffer
+    srsran_timestamp_t rx_time            = {};  ///< Radio time of the first sample in the measurement buffer
     meas_itf&          new_cell_itf;
 
     explicit measure_context_t(meas_itf& new_cell_itf_) : new_cell_itf(new_cell_itf_) {}
@@ -23,6 +23,7 @@
 
 #include "intra_measure_base.h"
 #include "scell_recv.h"
+#include <map>
 #include <srsran/srsran.h>
 
 namespace srsue {
@@ -65,6 +66,16 @@ public:
    */
   uint32_t get_earfcn() const override { return current_earfcn; };
 
+  /**
+   * @brief Gets the frame timing of a neighbour cell, decoded from its MIB while measuring
+   * @param pci Physical cell identifier of the neighbour cell
+   * @param cell Provides the neighbour cell configuration, as signalled in its MIB
+   * @param sfn Provides the SFN of the frame starting at sf0_time
+   * @param sf0_time Provides the radio time at which the frame starts
+   * @return True if the frame timing of the cell is known, otherwise false
+   */
+  bool get_frame_timing(uint32_t pci, srsran_cell_t& cell, uint32_t& sfn, srsran_timestamp_t& sf0_time);
+
 private:
   /**
    * @brief Provides with the RAT to the base class
@@ -81,14 +92,54 @@ private:
    */
   bool measure_rat(const measure_context_t& context, std::vector<cf_t>& buffer, float rx_gain_offset) override;
 
+  /**
+   * @brief Measures a neighbour cell with the cell reference signals, tracking its timing when it is already known
+   * @param context Measurement context
+   * @param buffer Provides the baseband buffer to perform the measurements
+   * @param cell Cell to measure
+   * @return True if no error happens, otherwise false
+   */
+  bool measure_cell(const measure_context_t& context, std::vector<cf_t>& buffer, const srsran_cell_t& cell);
+
+  /**
+   * @brief Decodes the MIB of a neighbour cell found in the buffer and saves its frame timing
+   * @param context Measurement context
+   * @param buffer Provides the baseband buffer to perform the measurements
+   * @param cell Cell to decode
+   * @param peak_idx Start of a frame of the cell in the buffer
+   */
+  void decode_frame_timing(const measure_context_t& context,
+                           std::vector<cf_t>&       buffer,
+                           const srsran_cell_t&     cell,
+                           uint32_t                 peak_idx);
+
+  /// Frame timing of a neighbour cell
+  struct frame_timing_t {
+    srsran_cell_t      cell     = {};
+    uint32_t           sfn      = 0;
+    srsran_timestamp_t sf0_time = {};
+  };
+
   srslog::basic_logger& logger;
-  srsran_cell_t         serving_cell   = {};  ///< Current serving cell in the EARFCN, to avoid reporting it
-  std::atomic<uint32_t> current_earfcn = {0}; ///< Current EARFCN
+  srsran_cell_t         serving_cell   = {};    ///< Current serving cell in the EARFCN, to avoid reporting it
+  bool                  reset_tracking = false; ///< Set when the serving cell changes, protected by mutex
+  std::atomic<uint32_t> current_earfcn = {0};   ///< Current EARFCN
   std::mutex            mutex;
 
   /// LTE-based measuring objects
   scell_recv                 scell_rx;               ///< Secondary cell searcher
   srsran_refsignal_dl_sync_t refsignal_dl_sync = {}; ///< Reference signal based measurement
+
+  /// Neighbour cell tracking, only accessed from the measurement thread
+  const static uint32_t        FULL_SEARCH_PERIOD = 5;     ///< Measurements between full PSS/SSS searches
+  std::map<uint32_t, uint32_t> tracked_cells;              ///< Frame start of each PCI from the serving frame start
+  uint32_t                     meas_count         = 0;     ///< Measurements since the last full search
+  bool                         force_full_search  = false; ///< Set when a tracked cell is lost
+
+  /// Neighbour cell frame timing, written by the measurement thread and protected by mutex
+  std::map<uint32_t, frame_timing_t> frame_timings;
+  srsran_ue_mib_t                    ue_mib = {}; ///< Neighbour cell MIB decoder
+  std::vector<cf_t>                  mib_buffer;  ///< Neighbour cell subframe 0 for the MIB decoder
 };
 
 } // namespace scell
@@ -152,6 +152,12 @@ private:
    */
   void run_sfn_sync_state();
 
+  /**
+   * Derives the TTI of the subframe 0 just received from the frame timing of the target cell. Returns false if the
+   * subframe does not match the expected timing
+   */
+  bool set_tti_from_target_timing();
+
   /**
    * Cell camping state. Calls the PHCH workers to process subframes and maintains cell synchronization
    */
@@ -357,6 +363,13 @@ private:
   cell_safe cell;
 
   bool                                        force_camping_sfn_sync = false;
+
+  // Frame timing of the cell being selected, measured while camping on the previous cell. When valid, SFN
+  // synchronization only waits for subframe 0 instead of decoding the MIB
+  bool               target_timing_valid = false;
+  uint32_t           target_sfn          = 0;
+  srsran_timestamp_t target_sf0_time     = {};
+
   uint32_t                                    tti                    = 0;
   srsran_timestamp_t                          stack_tti_ts_new       = {};
   srsran_timestamp_t                          stack_tti_ts           = {};
@@ -374,6 +387,8 @@ private:
   const static int MAX_TTI_JUMP       = 1000; ///< Maximum time gap tolerance in RF stream metadata
   const uint8_t    SYNC_CC_IDX        = 0;    ///< From the sync POV, the CC idx is always the first
   const uint32_t   TIMEOUT_TO_IDLE_MS = 2000; ///< Timeout in milliseconds for transitioning to IDLE
+
+  const double TARGET_TIMING_TOLERANCE_MS = 1.0 / 64; ///< Maximum drift of the measured frame timing of a target cell
 };
 
 } // namespace srsue
@@ -155,6 +155,7 @@ private:
 
   /* Queue to dispatch stack tasks */
   srsran::task_multiqueue::queue_handle stack_task_dispatch_queue;
+  std::atomic<bool>                     pdus_dispatched{false}; ///< A task to process the DL PDUs is pending
 
   // pointer to MAC PCAP object
   srsran::mac_pcap* pcap = nullptr;
@@ -37,6 +37,7 @@ struct rrc_args_t {
   std::vector<uint32_t>                   supported_bands_nr;
   uint32_t                                nof_supported_bands;
   bool                                    support_ca;
+  bool                                    support_rohc;
   int                                     mbms_service_id;
   uint32_t                                mbms_service_port;
 };
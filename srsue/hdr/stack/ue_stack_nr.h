@@ -114,6 +114,7 @@ public:
 
   // Interface for GW
   void write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu) final;
+  void write_sdus(uint32_t eps_bearer_id, std::vector<srsran::unique_byte_buffer_t> sdus) final;
   bool has_active_radio_bearer(uint32_t eps_bearer_id) final { return true; /* TODO: add EPS to LCID mapping */ }
 
   // Interface for RRC
@@ -31,9 +31,11 @@
 #include "srsran/srslog/srslog.h"
 #include "tft_packet_filter.h"
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <net/if.h>
 #include <netinet/in.h>
+#include <vector>
 
 namespace srsue {
 
@@ -47,6 +49,8 @@ struct gw_args_t {
   std::string netns;
   std::string tun_dev_name;
   std::string tun_dev_netmask;
+  uint32_t    nof_tun_queues = 1;     // Queues of the TUN device, each one read by its own thread
+  bool        tun_napi       = false; // Deliver the DL packets to the kernel through NAPI, so that they go through GRO
 };
 
 class gw : public gw_interface_stack, public srsran::thread
@@ -76,6 +80,13 @@ public:
 private:
   static const int GW_THREAD_PRIO = -1;
 
+  // Maximum number of UL packets read from the TUN device that are handed over to the stack at once
+  static const uint32_t MAX_UL_BATCH = 32;
+  // UL packets up to this size, e.g. TCP ACKs, are copied to small byte buffers before being queued in the stack
+  static const uint32_t SMALL_UL_PDU_LEN = 128;
+
+  class tun_reader_thread;
+
   stack_interface_gw* stack = nullptr;
 
   gw_args_t args = {};
@@ -88,6 +99,10 @@ private:
   int32_t           sock       = 0;
   std::atomic<bool> if_up      = {false};
 
+  // Additional queues of the TUN device, when it has more than one
+  std::vector<int32_t>                              tun_queue_fds;
+  std::vector<std::unique_ptr<tun_reader_thread> > tun_readers;
+
   static const int NOT_ASSIGNED          = -1;
   int32_t          default_eps_bearer_id = NOT_ASSIGNED;
   std::mutex       gw_mutex;
@@ -102,6 +117,9 @@ private:
   std::chrono::high_resolution_clock::time_point metrics_tp; // stores time when last metrics have been taken
 
   void run_thread();
+  void run_tun_reader(int32_t fd);
+  void write_ul_batch(uint32_t eps_bearer_id, std::vector<srsran::unique_byte_buffer_t>& batch);
+  void stop_tun_readers();
   int  init_if(char* err_str);
   int  setup_if_addr4(uint32_t ip_addr, char* err_str);
   int  setup_if_addr6(uint8_t* ipv6_if_id, char* err_str);
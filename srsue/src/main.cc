@@ -22,6 +22,7 @@
 #include "srsran/common/common_helper.h"
 #include "srsran/common/config_file.h"
 #include "srsran/common/crash_handler.h"
+#include "srsran/common/thread_affinity.h"
 #include "srsran/common/metrics_hub.h"
 #include "srsran/common/multiqueue.h"
 #include "srsran/common/tsan_options.h"
@@ -104,6 +105,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("rf.device_args", bpo::value<string>(&args->rf.device_args)->default_value("auto"), "Front-end device arguments")
     ("rf.time_adv_nsamples", bpo::value<string>(&args->rf.time_adv_nsamples)->default_value("auto"), "Transmission time advance")
     ("rf.continuous_tx", bpo::value<string>(&args->rf.continuous_tx)->default_value("auto"), "Transmit samples continuously to the radio or on bursts (auto/yes/no). Default is auto (yes for UHD, no for rest)")
+    ("rf.rx_dc_correction", bpo::value<bool>(&args->rf.rx_dc_correction)->default_value(false), "Remove the receiver DC offset on the host")
+    ("rf.rx_iq_correction", bpo::value<bool>(&args->rf.rx_iq_correction)->default_value(false), "Compensate the receiver IQ imbalance on the host")
+    ("rf.rx_digital_agc", bpo::value<bool>(&args->rf.rx_digital_agc)->default_value(false), "Fast digital gain control of the received samples on the host")
+    ("rf.tx_coalesce", bpo::value<uint32_t>(&args->rf.tx_coalesce_max_sf)->default_value(0), "Maximum number of consecutive subframes sent together to the radio, 0 disables it")
 
     ("rf.bands.rx[0].min", bpo::value<float>(&args->rf.ch_rx_bands[0].min)->default_value(0), "Lower frequency boundary for CH0-RX")
     ("rf.bands.rx[0].max", bpo::value<float>(&args->rf.ch_rx_bands[0].max)->default_value(0), "Higher frequency boundary for CH0-RX")
@@ -148,6 +153,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("rrc.ue_category_dl",      bpo::value<int>(&args->stack.rrc.ue_category_dl)->default_value(-1),                              "UE Category DL v12 (valid values: 0, 4, 6, 7, 9 to 16)")
     ("rrc.ue_category_ul",      bpo::value<int>(&args->stack.rrc.ue_category_ul)->default_value(-1),                              "UE Category UL v12 (valid values: 0, 3, 5, 7, 8 and 13)")
     ("rrc.release",             bpo::value<uint32_t>(&args->stack.rrc.release)->default_value(SRSRAN_RELEASE_DEFAULT),            "UE Release (8 to 15)")
+    ("rrc.rohc_support",        bpo::value<bool>(&args->stack.rrc.support_rohc)->default_value(false),                            "Announce ROHC profiles 0x0001 and 0x0002. Their U-mode decompression is incomplete")
     ("rrc.mbms_service_id",     bpo::value<int32_t>(&args->stack.rrc.mbms_service_id)->default_value(-1),                         "MBMS service id for autostart (-1 means disabled)")
     ("rrc.mbms_service_port",   bpo::value<uint32_t>(&args->stack.rrc.mbms_service_port)->default_value(4321),                    "Port of the MBMS service")
     ("rrc.nr_measurement_pci",  bpo::value<uint32_t>(&args->stack.rrc_nr.sim_nr_meas_pci)->default_value(500),                    "NR PCI for the simulated NR measurement")
@@ -208,9 +214,12 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("gw.netns", bpo::value<string>(&args->gw.netns)->default_value(""), "Network namespace to for TUN device (empty for default netns)")
     ("gw.ip_devname", bpo::value<string>(&args->gw.tun_dev_name)->default_value("tun_srsue"), "Name of the tun_srsue device")
     ("gw.ip_netmask", bpo::value<string>(&args->gw.tun_dev_netmask)->default_value("255.255.255.0"), "Netmask of the tun_srsue device")
+    ("gw.nof_tun_queues", bpo::value<uint32_t>(&args->gw.nof_tun_queues)->default_value(1), "Number of queues of the tun_srsue device, each one read by its own thread")
+    ("gw.tun_napi", bpo::value<bool>(&args->gw.tun_napi)->default_value(false), "Write DL packets to the tun_srsue device through NAPI/GRO (requires CAP_NET_ADMIN)")
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),                 "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_threads",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_threads)->default_value(0),            "Number of fading and delay worker threads, 0 for none")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),            "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),           "SNR in dB")
     ("channel.dl.awgn.signal_power", bpo::value<float>(&args->phy.dl_channel_args.awgn_signal_power_dBfs)->default_value(0.0f), "Received signal power in decibels full scale (dBfs)")
@@ -231,6 +240,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_threads",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_threads)->default_value(0),             "Number of fading and delay worker threads, 0 for none")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Transmitted signal power in decibels full scale (dBfs)")
@@ -310,6 +320,22 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3),
      "Number of PHY threads")
 
+    ("phy.worker_autoscale",
+     bpo::value<bool>(&args->phy.worker_autoscale)->default_value(false),
+     "Park the PHY threads that are not needed for the measured processing load")
+
+    ("phy.worker_min_threads",
+     bpo::value<uint32_t>(&args->phy.worker_min_threads)->default_value(1),
+     "Minimum number of active PHY threads when autoscaling")
+
+    ("phy.worker_target_load",
+     bpo::value<float>(&args->phy.worker_target_load)->default_value(0.7),
+     "Target busy fraction of each active PHY thread when autoscaling")
+
+    ("phy.pdsch_decoder_threads",
+     bpo::value<uint32_t>(&args->phy.pdsch_decoder_threads)->default_value(0),
+     "Number of helper threads per PHY thread decoding the PDSCH while the UL is generated (0 disables it)")
+
     ("phy.equalizer_mode",
      bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"),
      "Equalizer mode")
@@ -385,6 +411,14 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<uint32_t>(&args->phy.estimator_fil_order)->default_value(4),
      "Sets the channel estimator smooth gaussian filter order (even values perform better).")
 
+    ("phy.chest_meas_period",
+     bpo::value<uint32_t>(&args->phy.chest_meas_period)->default_value(0),
+     "Period in subframes of the averaged RSRP, RSSI and noise measurements, full measurements when a CQI is reported. 0 measures every subframe.")
+
+    ("phy.chest_meas_ema_coeff",
+     bpo::value<float>(&args->phy.chest_meas_ema_coeff)->default_value(0.1f),
+     "EMA coefficient of the averaged channel measurements.")
+
     ("phy.snr_to_cqi_offset",
      bpo::value<float>(&args->phy.snr_to_cqi_offset)->default_value(0),
      "Sets an offset in the SNR to CQI table. This is used to adjust the reported CQI.")
@@ -442,6 +476,14 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
       bpo::value<bool>(&args->phy.nr_store_pdsch_ko)->default_value(false),
       "Dumps the PDSCH baseband samples into a file on KO reception.")
 
+    ("phy.nr.cell_search_max_nof_ssb",
+      bpo::value<uint32_t>(&args->phy.nr_cell_search_max_nof_ssb)->default_value(1),
+      "Maximum number of SSB frequencies searched in parallel within the same capture.")
+
+    ("phy.nr.pdcch_polar_list_size",
+      bpo::value<uint32_t>(&args->phy.nr_pdcch_polar_list_size)->default_value(0),
+      "PDCCH polar SC-list size, 4 or 8 for SC-list decoding with CRC-aided selection, 0 for SC decoding.")
+
     // UE simulation args
     ("sim.airplane_t_on_ms",
      bpo::value<int>(&args->stack.nas.sim.airplane_t_on_ms)->default_value(-1),
@@ -498,6 +540,23 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
 
     ;
 
+  // Affinity section, the CPU cores and NUMA node of each class of real-time threads
+  const std::vector<srsran::thread_class_t> affinity_classes = {srsran::thread_class_t::txrx,
+                                                                srsran::thread_class_t::phy_worker,
+                                                                srsran::thread_class_t::stack,
+                                                                srsran::thread_class_t::log};
+  std::vector<string>                       affinity_cores(affinity_classes.size());
+  std::vector<int>                          affinity_numa_node(affinity_classes.size());
+  std::vector<uint32_t>                     affinity_spin_us(affinity_classes.size());
+  for (uint32_t i = 0; i < affinity_classes.size(); i++) {
+    string name = srsran::to_string(affinity_classes[i]);
+    common.add_options()
+      (("affinity." + name + "_cores").c_str(), bpo::value<string>(&affinity_cores[i])->default_value(""), ("CPU cores of the " + name + " threads, e.g. 2-5,8. Empty leaves them to the kernel.").c_str())
+      (("affinity." + name + "_numa_node").c_str(), bpo::value<int>(&affinity_numa_node[i])->default_value(-1), ("NUMA node the " + name + " threads allocate their memory from (-1 for the default policy).").c_str())
+      (("affinity." + name + "_spin_us").c_str(), bpo::value<uint32_t>(&affinity_spin_us[i])->default_value(0), ("Time in microseconds the " + name + " threads busy-poll a handoff before sleeping (0 to sleep at once).").c_str())
+    ;
+  }
+
   // Positional options - config file location
   bpo::options_description position("Positional options");
   position.add_options()
@@ -573,6 +632,22 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     exit(1);
   }
 
+  // Configure the placement of the real-time threads
+  for (uint32_t i = 0; i < affinity_classes.size(); i++) {
+    if (affinity_numa_node[i] >= srsran::max_nof_numa_nodes) {
+      cout << "Error, invalid affinity." << srsran::to_string(affinity_classes[i]) << "_numa_node: "
+           << affinity_numa_node[i] << ". Valid nodes are 0 to " << srsran::max_nof_numa_nodes - 1
+           << ", or -1 for the default policy" << endl;
+      exit(1);
+    }
+    if (!srsran::set_thread_affinity(
+            affinity_classes[i], affinity_cores[i], affinity_numa_node[i], affinity_spin_us[i])) {
+      cout << "Error parsing affinity." << srsran::to_string(affinity_classes[i]) << "_cores: " << affinity_cores[i]
+           << endl;
+      exit(1);
+    }
+  }
+
   // Apply all_level to any unset layers
   if (vm.count("log.all_level")) {
     if (!vm.count("log.rf_level")) {
@@ -641,8 +716,8 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     }
   }
 
-  // Set sync queue capacity to 1 for ZMQ
-  if (args->rf.device_name == "zmq") {
+  // Set sync queue capacity to 1 for ZMQ, shared memory and IQ files
+  if (args->rf.device_name == "zmq" || args->rf.device_name == "shm" || args->rf.device_name == "iq") {
     args->stack.sync_queue_size = 1;
   } else {
     // use default size
@@ -749,8 +824,11 @@ int main(int argc, char* argv[])
   }
 #endif
 
-  // Start the log backend.
-  srslog::init();
+  // Start the log backend, its thread inherits the placement of the log class.
+  {
+    srsran::scoped_thread_affinity log_affinity(srsran::thread_class_t::log);
+    srslog::init();
+  }
 
   srslog::fetch_basic_logger("ALL").set_level(srslog::basic_levels::warning);
   srsran::log_args(argc, argv, "UE");
@@ -91,11 +91,44 @@ DECLARE_METRIC_LIST("neighbour_cell_list", mlist_neighbours, std::vector<mset_ne
 DECLARE_METRIC("emm_state", metric_emm_state, std::string, "");
 DECLARE_METRIC_SET("nas_container", mset_nas_container, metric_emm_state);
 
+/// RF device health containers.
+DECLARE_METRIC("value_us", metric_value_us, int32_t, "us");
+DECLARE_METRIC("count", metric_count, uint32_t, "");
+DECLARE_METRIC_SET("rf_bin_container", mset_rf_bin_container, metric_value_us, metric_count);
+DECLARE_METRIC("name", metric_hist_name, std::string, "");
+DECLARE_METRIC("max_us", metric_max_us, int64_t, "us");
+DECLARE_METRIC("avg_us", metric_avg_us, float, "us");
+DECLARE_METRIC_LIST("bin_list", mlist_rf_bins, std::vector<mset_rf_bin_container>);
+DECLARE_METRIC_SET("hist_container",
+                   mset_rf_hist_container,
+                   metric_hist_name,
+                   metric_count,
+                   metric_max_us,
+                   metric_avg_us,
+                   mlist_rf_bins);
+DECLARE_METRIC("device", metric_rf_device, uint32_t, "");
+DECLARE_METRIC("rx_gaps", metric_rx_gaps, uint32_t, "");
+DECLARE_METRIC("rx_gap_samples", metric_rx_gap_samples, int64_t, "");
+DECLARE_METRIC("tx_gaps", metric_tx_gaps, uint32_t, "");
+DECLARE_METRIC("tx_overlaps", metric_tx_overlaps, uint32_t, "");
+DECLARE_METRIC("tx_staged_max", metric_tx_staged_max, uint32_t, "");
+DECLARE_METRIC_LIST("hist_list", mlist_rf_hist, std::vector<mset_rf_hist_container>);
+DECLARE_METRIC_SET("rf_device_container",
+                   mset_rf_device_container,
+                   metric_rf_device,
+                   metric_rx_gaps,
+                   metric_rx_gap_samples,
+                   metric_tx_gaps,
+                   metric_tx_overlaps,
+                   metric_tx_staged_max,
+                   mlist_rf_hist);
+
 /// RF container.
 DECLARE_METRIC("rf_o", metric_rf_o, uint32_t, "");
 DECLARE_METRIC("rf_u", metric_rf_u, uint32_t, "");
 DECLARE_METRIC("rf_l", metric_rf_l, uint32_t, "");
-DECLARE_METRIC_SET("rf_container", mset_rf_container, metric_rf_o, metric_rf_u, metric_rf_l);
+DECLARE_METRIC_LIST("device_list", mlist_rf_devices, std::vector<mset_rf_device_container>);
+DECLARE_METRIC_SET("rf_container", mset_rf_container, metric_rf_o, metric_rf_u, metric_rf_l, mlist_rf_devices);
 
 /// System memory container.
 DECLARE_METRIC("proc_realmem_percent", metric_proc_rmem_percent, uint32_t, "");
@@ -139,6 +172,28 @@ using metric_context_t = srslog::build_context_type<metric_type_tag,
 
 } // namespace
 
+/// Fill a RF time histogram, the value of each bin is its lower edge.
+template <typename Hist>
+static void fill_rf_hist(std::vector<mset_rf_hist_container>& list, const std::string& name, const Hist& hist)
+{
+  if (hist.count == 0) {
+    return;
+  }
+  list.emplace_back();
+  auto& container = list.back();
+  container.write<metric_hist_name>(name);
+  container.write<metric_count>(hist.count);
+  container.write<metric_max_us>(hist.max_us);
+  container.write<metric_avg_us>((float)hist.total_us / hist.count);
+
+  auto& bin_list = container.get<mlist_rf_bins>();
+  for (uint32_t i = 0; i < Hist::nof_bins; i++) {
+    bin_list.emplace_back();
+    bin_list.back().write<metric_value_us>(Hist::bin_lower_us(i));
+    bin_list.back().write<metric_count>(hist.bins[i]);
+  }
+}
+
 /// Returns the current time in seconds with ms precision since UNIX epoch.
 static double get_time_stamp()
 {
@@ -222,6 +277,20 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
   ctx.get<mset_rf_container>().write<metric_rf_o>(metrics.rf.rf_o);
   ctx.get<mset_rf_container>().write<metric_rf_u>(metrics.rf.rf_u);
   ctx.get<mset_rf_container>().write<metric_rf_l>(metrics.rf.rf_l);
+  auto& device_list = ctx.get<mset_rf_container>().get<mlist_rf_devices>();
+  for (uint32_t i = 0, e = metrics.rf.dev.size(); i != e; ++i) {
+    device_list.emplace_back();
+    auto& device = device_list.back();
+    device.write<metric_rf_device>(i);
+    device.write<metric_rx_gaps>(metrics.rf.dev[i].rx_gaps);
+    device.write<metric_rx_gap_samples>(metrics.rf.dev[i].rx_gap_samples);
+    device.write<metric_tx_gaps>(metrics.rf.dev[i].tx_gaps);
+    device.write<metric_tx_overlaps>(metrics.rf.dev[i].tx_overlaps);
+    device.write<metric_tx_staged_max>(metrics.rf.dev[i].tx_staged_max);
+    fill_rf_hist(device.get<mlist_rf_hist>(), "rx_call", metrics.rf.dev[i].rx_call);
+    fill_rf_hist(device.get<mlist_rf_hist>(), "tx_call", metrics.rf.dev[i].tx_call);
+    fill_rf_hist(device.get<mlist_rf_hist>(), "tx_deadline", metrics.rf.dev[i].tx_deadline);
+  }
 
   // Fill system memory container.
   ctx.get<mset_sys_mem_container>().write<metric_proc_rmem_percent>(metrics.sys.process_realmem);
@@ -211,12 +211,8 @@ void cc_worker::set_tdd_config_nolock(srsran_tdd_config_t config)
  *
  */
 
-bool cc_worker::work_dl_regular()
+bool cc_worker::work_dl_regular(srsran::task_thread_pool* pdsch_pool)
 {
-  bool dl_ack[SRSRAN_MAX_CODEWORDS] = {};
-
-  mac_interface_phy_lte::tb_action_dl_t dl_action = {};
-
   bool found_dl_grant = false;
 
   if (!cell_initiated) {
@@ -226,8 +222,13 @@ bool cc_worker::work_dl_regular()
 
   sf_cfg_dl.sf_type = SRSRAN_SF_NORM;
 
-  // Set default channel estimation
+  // Set default channel estimation, measure on all the pilots if the subframe is used for a periodic CSI report
   ue_dl_cfg.chest_cfg = chest_default_cfg;
+  if (ue_dl_cfg.chest_cfg.meas_period > 0) {
+    ue_dl_cfg.chest_cfg.meas_full =
+        srsran_cqi_periodic_send(&ue_dl_cfg.cfg.cqi_report, TTI_TX(CURRENT_TTI), cell.frame_type) ||
+        srsran_cqi_periodic_ri_send(&ue_dl_cfg.cfg.cqi_report, TTI_TX(CURRENT_TTI), cell.frame_type);
+  }
 
   /* For TDD, when searching for SIB1, the ul/dl configuration is unknown and need to do blind search over
    * the possible mi values
@@ -291,25 +292,37 @@ bool cc_worker::work_dl_regular()
       ue_dl_cfg.cfg.pdsch.grant.tb[0].tbs = 0;
     }
     // Generate MAC grant
-    mac_interface_phy_lte::mac_grant_dl_t mac_grant = {};
-    dl_phy_to_mac_grant(&ue_dl_cfg.cfg.pdsch.grant, &dci_dl, &mac_grant);
+    pdsch_mac_grant = {};
+    dl_phy_to_mac_grant(&ue_dl_cfg.cfg.pdsch.grant, &dci_dl, &pdsch_mac_grant);
 
     // Save ACK resource configuration
-    srsran_pdsch_ack_resource_t ack_resource = {dci_dl.dai, dci_dl.location.ncce, grant_cc_idx, dci_dl.tpc_pucch};
+    pdsch_ack_resource = {dci_dl.dai, dci_dl.location.ncce, grant_cc_idx, dci_dl.tpc_pucch};
 
     // Send grant to MAC and get action for this TB, then call tb_decoded to unlock MAC
-    phy->stack->new_grant_dl(cc_idx, mac_grant, &dl_action);
+    pdsch_action = {};
+    phy->stack->new_grant_dl(cc_idx, pdsch_mac_grant, &pdsch_action);
 
-    // Decode PDSCH
-    decode_pdsch(ack_resource, &dl_action, dl_ack);
+    if (pdsch_pool != nullptr) {
+      // The PHICH shares the ue_dl object with the PDSCH decoder, decode it before handing the PDSCH over
+      decode_phich();
 
-    // Informs Stack about the decoding status, send NACK if cell is in process of re-selection
-    if (phy->cell_is_selecting) {
-      for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
-        dl_ack[i] = false;
+      {
+        std::lock_guard<std::mutex> lock(pdsch_mutex);
+        pdsch_pending = true;
       }
+      // The worker encoding the ACK waits for the decoding
+      phy->set_dl_ack_decoding(&sf_cfg_dl, cc_idx);
+      pdsch_pool->push_task([this]() {
+        decode_pdsch_tb();
+        phy->set_dl_ack_decoded(&sf_cfg_dl, cc_idx);
+        std::lock_guard<std::mutex> lock(pdsch_mutex);
+        pdsch_pending = false;
+        pdsch_cvar.notify_one();
+      });
+      return true;
     }
-    phy->stack->tb_decoded(cc_idx, mac_grant, dl_ack);
+
+    decode_pdsch_tb();
   }
 
   /* Decode PHICH */
@@ -318,6 +331,28 @@ bool cc_worker::work_dl_regular()
   return true;
 }
 
+void cc_worker::wait_pdsch()
+{
+  std::unique_lock<std::mutex> lock(pdsch_mutex);
+  pdsch_cvar.wait(lock, [this]() { return !pdsch_pending; });
+}
+
+void cc_worker::decode_pdsch_tb()
+{
+  bool dl_ack[SRSRAN_MAX_CODEWORDS] = {};
+
+  // Decode PDSCH
+  decode_pdsch(pdsch_ack_resource, &pdsch_action, dl_ack);
+
+  // Informs Stack about the decoding status, send NACK if cell is in process of re-selection
+  if (phy->cell_is_selecting) {
+    for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      dl_ack[i] = false;
+    }
+  }
+  phy->stack->tb_decoded(cc_idx, pdsch_mac_grant, dl_ack);
+}
+
 bool cc_worker::work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg)
 {
   mac_interface_phy_lte::tb_action_dl_t dl_action = {};
@@ -64,10 +64,16 @@ sf_worker::sf_worker(uint32_t max_prb, phy_common* phy_, srslog::basic_logger& l
   for (uint32_t r = 0; r < phy->args->nof_lte_carriers; r++) {
     cc_workers.push_back(new cc_worker(r, max_prb, phy, logger));
   }
+
+  if (phy->args->pdsch_decoder_threads > 0) {
+    pdsch_pool.reset(new srsran::task_thread_pool(phy->args->pdsch_decoder_threads));
+  }
 }
 
 sf_worker::~sf_worker()
 {
+  // Stop the helpers before the carriers they may be decoding are destroyed
+  pdsch_pool.reset();
   for (uint32_t r = 0; r < phy->args->nof_lte_carriers; r++) {
     delete cc_workers[r];
   }
@@ -182,7 +188,7 @@ void sf_worker::work_imp()
             cc_workers[0]->work_dl_mbsfn(mbsfn_cfg); // Don't do chest_ok in mbsfn since it trigger measurements
       } else {
         if (phy->cell_state.is_configured(carrier_idx)) {
-          rx_signal_ok = cc_workers[carrier_idx]->work_dl_regular();
+          rx_signal_ok = cc_workers[carrier_idx]->work_dl_regular(pdsch_pool.get());
         }
       }
     }
@@ -233,6 +239,14 @@ void sf_worker::work_imp()
   // Call worker_end to transmit the signal
   phy->worker_end(context, tx_signal_ready, tx_signal_ptr);
 
+  // The ACKs of this TTI are encoded by the worker of TTI+4, which waits for them in get_dl_pending_ack(). Here the
+  // decoding only needs to finish before the carriers are reused
+  if (pdsch_pool) {
+    for (cc_worker* w : cc_workers) {
+      w->wait_pdsch();
+    }
+  }
+
   if (rx_signal_ok) {
     update_measurements();
   }
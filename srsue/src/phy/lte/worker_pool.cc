@@ -19,6 +19,7 @@
  *
  */
 #include "srsue/hdr/phy/lte/worker_pool.h"
+#include <thread>
 
 namespace srsue {
 namespace lte {
@@ -55,16 +56,35 @@ worker_pool::worker_pool(uint32_t max_workers) :
 bool worker_pool::init(phy_common* common, int prio)
 {
   // Add workers to workers pool and start threads
-  for (uint32_t i = 0; i < common->args->nof_phy_threads; i++) {
+  pool.set_thread_class(srsran::thread_class_t::phy_worker);
+  workers.resize(common->args->nof_phy_threads);
+
+  // The workers are built in parallel, each one allocating its buffers and planning its FFTs for the maximum bandwidth.
+  // Each thread places the worker buffers and helper threads as the worker threads
+  std::vector<std::thread> init_threads;
+  init_threads.reserve(workers.size());
+  for (uint32_t i = 0; i < workers.size(); i++) {
     srslog::basic_logger& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i));
     log.set_level(srslog::str_to_basic_level(common->args->log.phy_level));
     log.set_hex_dump_max_size(common->args->log.phy_hex_limit);
 
-    auto w = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, log));
-    pool.init_worker(i, w.get(), prio, common->args->worker_cpu_mask);
-    workers.push_back(std::move(w));
+    init_threads.emplace_back([this, i, common, &log]() {
+      srsran::scoped_thread_affinity affinity(srsran::thread_class_t::phy_worker);
+      workers[i] = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, log));
+    });
+  }
+  for (auto& t : init_threads) {
+    t.join();
+  }
+
+  for (uint32_t i = 0; i < workers.size(); i++) {
+    pool.init_worker(i, workers[i].get(), prio, common->args->worker_cpu_mask);
   }
 
+  autoscale_enabled = common->args->worker_autoscale;
+  autoscale_min     = common->args->worker_min_threads;
+  autoscale_load    = common->args->worker_target_load;
+
   return true;
 }
 
@@ -75,6 +95,12 @@ void worker_pool::start_worker(sf_worker* w)
 
 sf_worker* worker_pool::wait_worker(uint32_t tti)
 {
+  // Adjust the number of active workers to the load measured in the last period
+  if (autoscale_enabled && ++autoscale_count >= autoscale_period_tti) {
+    autoscale_count = 0;
+    pool.autoscale(autoscale_min, autoscale_load);
+  }
+
   sf_worker* w = (sf_worker*)pool.wait_worker(tti);
   if (w == nullptr) {
     return w;
@@ -31,7 +31,11 @@ cell_search::cell_search(srslog::basic_logger& logger_) : logger(logger_) {}
 
 cell_search::~cell_search()
 {
-  srsran_ssb_free(&ssb);
+  // Stop the searchers before the SSB objects they may be using are freed
+  pool.reset();
+  for (srsran_ssb_t& q : ssb) {
+    srsran_ssb_free(&q);
+  }
 }
 
 bool cell_search::init(const args_t& args)
@@ -43,10 +47,21 @@ bool cell_search::init(const args_t& args)
   ssb_args.enable_search     = true;
   ssb_args.enable_decode     = true;
 
-  // Initialise SSB
-  if (srsran_ssb_init(&ssb, &ssb_args) < SRSRAN_SUCCESS) {
-    logger.error("Cell search: Error initiating SSB");
-    return false;
+  // Initialise an SSB object for every frequency that can be searched in the same capture
+  uint32_t max_nof_ssb = std::max(args.max_nof_ssb, 1U);
+  ssb.resize(max_nof_ssb);
+  ssb_freq_hz.resize(max_nof_ssb);
+  ssb_ret.resize(max_nof_ssb);
+  for (srsran_ssb_t& q : ssb) {
+    if (srsran_ssb_init(&q, &ssb_args) < SRSRAN_SUCCESS) {
+      logger.error("Cell search: Error initiating SSB");
+      return false;
+    }
+  }
+
+  // Searching a single frequency does not benefit from helper threads
+  if (max_nof_ssb > 1 and args.nof_threads > 0) {
+    pool.reset(new srsran::task_thread_pool(args.nof_threads));
   }
 
   return true;
@@ -54,36 +69,52 @@ bool cell_search::init(const args_t& args)
 
 bool cell_search::start(const cfg_t& cfg)
 {
-  // Prepare SSB configuration
-  srsran_ssb_cfg_t ssb_cfg = {};
-  ssb_cfg.srate_hz         = cfg.srate_hz;
-  ssb_cfg.center_freq_hz   = cfg.center_freq_hz;
-  ssb_cfg.ssb_freq_hz      = cfg.ssb_freq_hz;
-  ssb_cfg.scs              = cfg.ssb_scs;
-  ssb_cfg.pattern          = cfg.ssb_pattern;
-  ssb_cfg.duplex_mode      = cfg.duplex_mode;
-
-  // Print SSB configuration, helps debugging gNb and UE
-  if (logger.info.enabled()) {
-    std::array<char, 512> ssb_cfg_str = {};
-    srsran_ssb_cfg_to_str(&ssb_cfg, ssb_cfg_str.data(), (uint32_t)ssb_cfg_str.size());
-    logger.info("Cell search: Setting SSB configuration %s", ssb_cfg_str.data());
+  // Select the SSB frequencies to search, the first one is always the main SSB frequency
+  nof_ssb = 0;
+  std::vector<double> freq_list = {cfg.ssb_freq_hz};
+  freq_list.insert(freq_list.end(), cfg.ssb_freq_hz_list.begin(), cfg.ssb_freq_hz_list.end());
+  if (freq_list.size() > ssb.size()) {
+    logger.warning("Cell search: Searching only %zd of %zd SSB frequencies", ssb.size(), freq_list.size());
+    freq_list.resize(ssb.size());
   }
 
-  // Configure SSB
-  if (srsran_ssb_set_cfg(&ssb, &ssb_cfg) < SRSRAN_SUCCESS) {
-    logger.error("Cell search: Error setting SSB configuration");
-    return false;
+  for (double freq_hz : freq_list) {
+    // Prepare SSB configuration
+    srsran_ssb_cfg_t ssb_cfg = {};
+    ssb_cfg.srate_hz         = cfg.srate_hz;
+    ssb_cfg.center_freq_hz   = cfg.center_freq_hz;
+    ssb_cfg.ssb_freq_hz      = freq_hz;
+    ssb_cfg.scs              = cfg.ssb_scs;
+    ssb_cfg.pattern          = cfg.ssb_pattern;
+    ssb_cfg.duplex_mode      = cfg.duplex_mode;
+
+    // Print SSB configuration, helps debugging gNb and UE
+    if (logger.info.enabled()) {
+      std::array<char, 512> ssb_cfg_str = {};
+      srsran_ssb_cfg_to_str(&ssb_cfg, ssb_cfg_str.data(), (uint32_t)ssb_cfg_str.size());
+      logger.info("Cell search: Setting SSB configuration %s", ssb_cfg_str.data());
+    }
+
+    // Configure SSB, it generates the PSS correlation sequences shifted to the SSB frequency
+    if (srsran_ssb_set_cfg(&ssb[nof_ssb], &ssb_cfg) < SRSRAN_SUCCESS) {
+      logger.error("Cell search: Error setting SSB configuration");
+      return false;
+    }
+    ssb_freq_hz[nof_ssb] = freq_hz;
+    nof_ssb++;
   }
+
   return true;
 }
 
-cell_search::ret_t cell_search::run_slot(const cf_t* buffer, uint32_t slot_sz)
+void cell_search::run_ssb(uint32_t idx, const cf_t* buffer, uint32_t nof_samples)
 {
-  cell_search::ret_t ret = {};
+  ret_t& ret      = ssb_ret[idx];
+  ret             = {};
+  ret.ssb_freq_hz = ssb_freq_hz[idx];
 
   // Search for SSB
-  if (srsran_ssb_search(&ssb, buffer, slot_sz + ssb.ssb_sz, &ret.ssb_res) < SRSRAN_SUCCESS) {
+  if (srsran_ssb_search(&ssb[idx], buffer, nof_samples, &ret.ssb_res) < SRSRAN_SUCCESS) {
     logger.error("Error occurred searching SSB");
     ret.result = ret_t::ERROR;
   } else if (ret.ssb_res.measurements.snr_dB >= -10.0f and ret.ssb_res.pbch_msg.crc) {
@@ -92,6 +123,60 @@ cell_search::ret_t cell_search::run_slot(const cf_t* buffer, uint32_t slot_sz)
   } else {
     ret.result = ret_t::CELL_NOT_FOUND;
   }
+}
+
+cell_search::ret_t cell_search::run_slot(const cf_t* buffer, uint32_t slot_sz)
+{
+  cell_search::ret_t ret = {};
+  ret.result             = ret_t::ERROR;
+  if (nof_ssb == 0) {
+    return ret;
+  }
+
+  // All the SSB frequencies share the same sampling rate and numerology, hence the same SSB length
+  uint32_t nof_samples = slot_sz + ssb[0].ssb_sz;
+
+  // Hand over all the SSB frequencies but the first one to the thread pool
+  if (pool != nullptr) {
+    {
+      std::lock_guard<std::mutex> lock(pending_mutex);
+      nof_pending = nof_ssb - 1;
+    }
+    for (uint32_t idx = 1; idx < nof_ssb; idx++) {
+      pool->push_task([this, idx, buffer, nof_samples]() {
+        run_ssb(idx, buffer, nof_samples);
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        nof_pending--;
+        pending_cvar.notify_one();
+      });
+    }
+  }
+
+  // Search the first SSB frequency in the calling thread, or all of them if there is no thread pool
+  for (uint32_t idx = 0; idx < (pool != nullptr ? 1 : nof_ssb); idx++) {
+    run_ssb(idx, buffer, nof_samples);
+  }
+
+  // Wait for the thread pool to finish, the buffer is overwritten after returning
+  if (pool != nullptr) {
+    std::unique_lock<std::mutex> lock(pending_mutex);
+    while (nof_pending > 0) {
+      pending_cvar.wait(lock);
+    }
+  }
+
+  // Select the strongest found cell, report the first error or not found otherwise
+  ret.result = ret_t::CELL_NOT_FOUND;
+  for (uint32_t idx = 0; idx < nof_ssb; idx++) {
+    const ret_t& r = ssb_ret[idx];
+    if (r.result == ret_t::CELL_FOUND) {
+      if (ret.result != ret_t::CELL_FOUND or r.ssb_res.measurements.snr_dB > ret.ssb_res.measurements.snr_dB) {
+        ret = r;
+      }
+    } else if (r.result == ret_t::ERROR and ret.result == ret_t::CELL_NOT_FOUND) {
+      ret = r;
+    }
+  }
   return ret;
 }
 
@@ -55,6 +55,8 @@ bool worker_pool::init(const phy_args_nr_t& args, srsran::phy_common_interface&
   }
 
   // Add workers to workers pool and start threads
+  pool.set_thread_class(srsran::thread_class_t::phy_worker);
+  phy_state.dl_ul_semaphore.set_thread_class(srsran::thread_class_t::phy_worker);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}-NR", args.log.id_preamble, i));
     log.set_level(srslog::str_to_basic_level(args.log.phy_level));
@@ -62,6 +64,8 @@ bool worker_pool::init(const phy_args_nr_t& args, srsran::phy_common_interface&
 
     sf_worker* w = nullptr;
     {
+      // Place the worker buffers and helper threads created here as the worker threads
+      srsran::scoped_thread_affinity affinity(srsran::thread_class_t::phy_worker);
       std::lock_guard<std::mutex> lock(cfg_mutex);
       w = new sf_worker(common, phy_state, cfg, log);
     }
@@ -91,6 +95,13 @@ void worker_pool::start_worker(sf_worker* w)
 sf_worker* worker_pool::wait_worker(uint32_t tti)
 {
   logger.set_context(tti);
+
+  // Adjust the number of active workers to the load measured in the last period
+  if (phy_state.args.worker_autoscale && ++autoscale_count >= autoscale_period_tti) {
+    autoscale_count = 0;
+    pool.autoscale(phy_state.args.worker_min_threads, phy_state.args.worker_target_load);
+  }
+
   sf_worker* worker = (sf_worker*)pool.wait_worker(tti);
 
   uint32_t pci = 0;
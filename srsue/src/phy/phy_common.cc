@@ -60,6 +60,9 @@ void phy_common::init(phy_args_t*                  _args,
   insync_itf = _chest_loop;
   sr.reset();
 
+  // The PHY workers wait on the semaphore to transmit in order
+  semaphore.set_thread_class(srsran::thread_class_t::phy_worker);
+
   // Instantiate UL channel emulator
   if (args->ul_channel_args.enable) {
     ul_channel = srsran::channel_ptr(
@@ -106,6 +109,8 @@ void phy_common::set_ue_dl_cfg(srsran_ue_dl_cfg_t* ue_dl_cfg)
       args->interpolate_subframe_enabled ? SRSRAN_ESTIMATOR_ALG_INTERPOLATE : SRSRAN_ESTIMATOR_ALG_AVERAGE;
   chest_cfg->cfo_estimate_enable  = args->cfo_ref_mask != 0;
   chest_cfg->cfo_estimate_sf_mask = args->cfo_ref_mask;
+  chest_cfg->meas_period          = args->chest_meas_period;
+  chest_cfg->meas_ema_coeff       = args->chest_meas_ema_coeff;
 }
 
 void phy_common::set_pdsch_cfg(srsran_pdsch_cfg_t* pdsch_cfg)
@@ -443,6 +448,19 @@ void phy_common::set_dl_pending_ack(srsran_dl_sf_cfg_t*         sf,
   }
 }
 
+void phy_common::set_dl_ack_decoding(srsran_dl_sf_cfg_t* sf, uint32_t cc_idx)
+{
+  std::lock_guard<std::mutex> lock(pending_dl_ack_mutex);
+  pending_dl_ack[cc_idx][sf->tti].decoding = true;
+}
+
+void phy_common::set_dl_ack_decoded(srsran_dl_sf_cfg_t* sf, uint32_t cc_idx)
+{
+  std::lock_guard<std::mutex> lock(pending_dl_ack_mutex);
+  pending_dl_ack[cc_idx][sf->tti].decoding = false;
+  pending_dl_ack_cvar.notify_all();
+}
+
 void phy_common::set_rar_grant_tti(uint32_t tti)
 {
   rar_grant_tti = tti;
@@ -482,46 +500,24 @@ bool phy_common::get_dl_pending_grant(uint32_t tti, uint32_t cc_idx, uint32_t* g
   }
 }
 
-typedef struct {
-  uint32_t M;
-  uint32_t K[9];
-} das_index_t;
-
-// Downlink association set index, Table 10.1-1 36.213
-das_index_t das_table[7][10] = {
-    {{0, {}}, {0, {}}, {1, {6}}, {0, {}}, {1, {4}}, {0, {}}, {0, {}}, {1, {6}}, {0, {}}, {1, {4}}},
-    {{0, {}}, {0, {}}, {2, {7, 6}}, {1, {4}}, {0, {}}, {0, {}}, {0, {}}, {2, {7, 6}}, {1, {4}}, {0, {}}},
-    {{0, {}}, {0, {}}, {4, {8, 7, 4, 6}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}, {4, {8, 7, 4, 6}}, {0, {}}, {0, {}}},
-    {{0, {}}, {0, {}}, {3, {7, 6, 11}}, {2, {6, 5}}, {2, {5, 4}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}},
-    {{0, {}}, {0, {}}, {4, {12, 8, 7, 11}}, {4, {6, 5, 4, 7}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}, {0, {}}},
-    {{0, {}},
-     {0, {}},
-     {9, {13, 12, 9, 8, 7, 5, 4, 11, 6}},
-     {0, {}},
-     {0, {}},
-     {0, {}},
-     {0, {}},
-     {0, {}},
-     {0, {}},
-     {0, {}}},
-    {{0, {}}, {0, {}}, {1, {7}}, {1, {7}}, {1, {5}}, {0, {}}, {0, {}}, {1, {7}}, {1, {7}}, {0, {}}}};
-
 // SF->TTI at which ACK/NACK would be transmitted
 bool phy_common::get_dl_pending_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, srsran_pdsch_ack_cc_t* ack)
 {
-  std::lock_guard<std::mutex> lock(pending_dl_ack_mutex);
-  bool                        ret = false;
-  uint32_t                    M;
-  if (cell.frame_type == SRSRAN_FDD) {
-    M = 1;
-  } else {
-    M = das_table[sf->tdd_config.sf_config][sf->tti % 10].M;
+  std::unique_lock<std::mutex> lock(pending_dl_ack_mutex);
+  bool                         ret                                      = false;
+  uint32_t                     M                                        = 1;
+  uint32_t                     K[SRSRAN_MAX_TDD_DL_ASSOCIATION_SET_SIZE] = {FDD_HARQ_DELAY_UL_MS};
+  if (cell.frame_type != SRSRAN_FDD) {
+    M = srsran_tdd_dl_association_set(sf->tdd_config, sf->tti % 10, K);
   }
   for (uint32_t i = 0; i < M; i++) {
-    uint32_t k =
-        (cell.frame_type == SRSRAN_FDD) ? FDD_HARQ_DELAY_UL_MS : das_table[sf->tdd_config.sf_config][sf->tti % 10].K[i];
+    uint32_t        k           = K[i];
     uint32_t        pdsch_tti   = TTI_SUB(sf->tti, k + (FDD_HARQ_DELAY_DL_MS - FDD_HARQ_DELAY_UL_MS));
     received_ack_t& pending_ack = pending_dl_ack[cc_idx][pdsch_tti];
+
+    // The ACK is only known once the helper thread decoding the PDSCH is done
+    pending_dl_ack_cvar.wait(lock, [&pending_ack]() { return !pending_ack.decoding; });
+
     if (pending_ack.enable) {
       ack->m[i].present  = true;
       ack->m[i].k        = k;
@@ -926,6 +922,7 @@ void phy_common::reset()
     for (auto& i : pending_dl_ack) {
       i = {};
     }
+    pending_dl_ack_cvar.notify_all();
   }
   for (auto& i : pending_dl_dai) {
     i = {};
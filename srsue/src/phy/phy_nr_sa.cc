@@ -20,6 +20,7 @@
  */
 
 #include "srsue/hdr/phy/phy_nr_sa.h"
+#include "srsran/common/band_helper.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/srsran.h"
 
@@ -106,6 +107,8 @@ void phy_nr_sa::init_background()
   nr::sync_sa::args_t sync_args = {};
   sync_args.srate_hz            = args.srate_hz;
   sync_args.thread_priority     = args.slot_recv_thread_prio;
+  sync_args.max_nof_ssb         = args.max_nof_ssb_search;
+  sync_args.nof_threads         = args.nof_phy_threads;
   if (not sync.init(sync_args, stack, radio)) {
     logger.error("Error initialising SYNC");
     return;
@@ -178,6 +181,7 @@ bool phy_nr_sa::start_cell_search(const cell_search_args_t& req)
     cfg.srate_hz               = args.srate_hz;
     cfg.center_freq_hz         = req.center_freq_hz;
     cfg.ssb_freq_hz            = req.ssb_freq_hz;
+    cfg.ssb_freq_hz_list       = req.ssb_freq_hz_list;
     cfg.ssb_scs                = req.ssb_scs;
     cfg.ssb_pattern            = req.ssb_pattern;
     cfg.duplex_mode            = req.duplex_mode;
@@ -189,6 +193,7 @@ bool phy_nr_sa::start_cell_search(const cell_search_args_t& req)
     rrc_interface_phy_nr::cell_search_result_t rrc_cs_ret = {};
     rrc_cs_ret.cell_found                                 = ret.result == nr::cell_search::ret_t::CELL_FOUND;
     if (rrc_cs_ret.cell_found) {
+      rrc_cs_ret.ssb_arfcn    = srsran::srsran_band_helper().freq_to_nr_arfcn(ret.ssb_freq_hz);
       rrc_cs_ret.pci          = ret.ssb_res.N_id;
       rrc_cs_ret.pbch_msg     = ret.ssb_res.pbch_msg;
       rrc_cs_ret.measurements = ret.ssb_res.measurements;
@@ -141,7 +141,7 @@ void intra_measure_base::write(cf_t* data, uint32_t nsamples)
   }
 }
 
-void intra_measure_base::run_tti(uint32_t tti, cf_t* data, uint32_t nsamples)
+void intra_measure_base::run_tti(uint32_t tti, cf_t* data, uint32_t nsamples, const srsran_timestamp_t& rx_time)
 {
   logger.set_context(tti);
 
@@ -158,6 +158,10 @@ void intra_measure_base::run_tti(uint32_t tti, cf_t* data, uint32_t nsamples)
       if (receive_tti_trigger(tti)) {
         state.set_state(internal_state::receive);
         last_measure_tti = tti;
+        mutex.lock();
+        context.tti     = tti;
+        context.rx_time = rx_time;
+        mutex.unlock();
         srsran_ringbuffer_reset(&ring_buffer);
 
         // Write baseband to ensure measurement starts in the right TTI
@@ -36,6 +36,7 @@ intra_measure_lte::~intra_measure_lte()
 {
   scell_rx.deinit();
   srsran_refsignal_dl_sync_free(&refsignal_dl_sync);
+  srsran_ue_mib_free(&ue_mib);
 }
 
 void intra_measure_lte::init(uint32_t cc_idx, const args_t& args)
@@ -45,6 +46,12 @@ void intra_measure_lte::init(uint32_t cc_idx, const args_t& args)
   // Initialise Reference signal measurement
   srsran_refsignal_dl_sync_init(&refsignal_dl_sync, SRSRAN_CP_NORM);
 
+  // Initialise neighbour cell MIB decoder
+  mib_buffer.resize(SRSRAN_SF_LEN_PRB(SRSRAN_MAX_PRB));
+  if (srsran_ue_mib_init(&ue_mib, mib_buffer.data(), SRSRAN_MAX_PRB) < SRSRAN_SUCCESS) {
+    Log(error, "Error initiating MIB decoder");
+  }
+
   // Start scell
   scell_rx.init(args.len_ms);
 }
@@ -54,6 +61,8 @@ void intra_measure_lte::set_primary_cell(uint32_t earfcn, srsran_cell_t cell)
   {
     std::lock_guard<std::mutex> lock(mutex);
     serving_cell   = cell;
+    reset_tracking = true;
+    frame_timings.clear();
   }
   current_earfcn = earfcn;
   set_current_sf_len((uint32_t)SRSRAN_SF_LEN_PRB(cell.nof_prb));
@@ -67,10 +76,24 @@ bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vecto
   {
     std::lock_guard<std::mutex> lock(mutex);
     serving_cell_copy = serving_cell;
+    if (reset_tracking) {
+      // Tracked timings are relative to the previous serving cell
+      tracked_cells.clear();
+      reset_tracking = false;
+    }
   }
 
-  // Detect new cells using PSS/SSS
-  scell_rx.find_cells(buffer.data(), serving_cell_copy, context.meas_len_ms, cells_to_measure);
+  // Detect new cells using PSS/SSS. Cells found before are tracked, so the full search only runs periodically or when
+  // a tracked cell is lost
+  if (tracked_cells.empty() or force_full_search or meas_count >= FULL_SEARCH_PERIOD) {
+    scell_rx.find_cells(buffer.data(), serving_cell_copy, context.meas_len_ms, cells_to_measure);
+    meas_count        = 0;
+    force_full_search = false;
+  }
+  meas_count++;
+  for (const auto& tracked : tracked_cells) {
+    cells_to_measure.insert(tracked.first);
+  }
 
   // Initialise empty neighbour cell list
   std::vector<phy_meas_t> neighbour_cells = {};
@@ -86,14 +109,7 @@ bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vecto
     srsran_cell_t cell = serving_cell_copy;
     cell.id            = id;
 
-    if (srsran_refsignal_dl_sync_set_cell(&refsignal_dl_sync, cell) < SRSRAN_SUCCESS) {
-      Log(error, "Error setting refsignal DL cell");
-      return false;
-    }
-
-    if (srsran_refsignal_dl_sync_run(&refsignal_dl_sync, buffer.data(), context.meas_len_ms * context.sf_len) <
-        SRSRAN_SUCCESS) {
-      Log(error, "Error running refsignal DL measurements");
+    if (not measure_cell(context, buffer, cell)) {
       return false;
     }
 
@@ -126,5 +142,121 @@ bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vecto
   return true;
 }
 
+bool intra_measure_lte::measure_cell(const measure_context_t& context,
+                                     std::vector<cf_t>&       buffer,
+                                     const srsran_cell_t&     cell)
+{
+  uint32_t nsamples  = context.meas_len_ms * context.sf_len;
+  uint32_t frame_len = SRSRAN_NOF_SF_X_FRAME * context.sf_len;
+
+  // Samples from the serving cell frame start to the beginning of the buffer
+  uint32_t buffer_offset = (context.tti % SRSRAN_NOF_SF_X_FRAME) * context.sf_len;
+
+  if (srsran_refsignal_dl_sync_set_cell(&refsignal_dl_sync, cell) < SRSRAN_SUCCESS) {
+    Log(error, "Error setting refsignal DL cell");
+    return false;
+  }
+
+  // Correlate only around the last known timing of the cell, a few microseconds either side
+  std::map<uint32_t, uint32_t>::iterator it = tracked_cells.find(cell.id);
+  if (it != tracked_cells.end()) {
+    uint32_t hint = (it->second + frame_len - buffer_offset) % frame_len;
+    if (srsran_refsignal_dl_sync_track(&refsignal_dl_sync, buffer.data(), nsamples, hint, context.sf_len / 128) <
+        SRSRAN_SUCCESS) {
+      Log(error, "Error running refsignal DL measurements");
+      return false;
+    }
+  }
+
+  // Search the whole buffer if the cell is not tracked or its timing was lost
+  if (it == tracked_cells.end() or not refsignal_dl_sync.found) {
+    if (srsran_refsignal_dl_sync_run(&refsignal_dl_sync, buffer.data(), nsamples) < SRSRAN_SUCCESS) {
+      Log(error, "Error running refsignal DL measurements");
+      return false;
+    }
+  }
+
+  if (refsignal_dl_sync.found) {
+    tracked_cells[cell.id] = (refsignal_dl_sync.peak_index + buffer_offset) % frame_len;
+
+    // Cells keep their SFN relative to each other, so the MIB only needs decoding once while the cell is tracked
+    bool has_frame_timing = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      has_frame_timing = frame_timings.count(cell.id) > 0;
+    }
+    if (not has_frame_timing) {
+      decode_frame_timing(context, buffer, cell, refsignal_dl_sync.peak_index);
+    }
+  } else if (it != tracked_cells.end()) {
+    Log(debug, "Lost track of neighbour cell PCI=%03d", cell.id);
+    tracked_cells.erase(it);
+    force_full_search = true;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    frame_timings.erase(cell.id);
+  }
+
+  return true;
+}
+
+void intra_measure_lte::decode_frame_timing(const measure_context_t& context,
+                                            std::vector<cf_t>&       buffer,
+                                            const srsran_cell_t&     cell,
+                                            uint32_t                 peak_idx)
+{
+  // Without radio time the timing can not be related to other captures
+  if (srsran_timestamp_iszero(&context.rx_time)) {
+    return;
+  }
+
+  if (srsran_ue_mib_set_cell(&ue_mib, cell) < SRSRAN_SUCCESS) {
+    Log(error, "Error setting MIB decoder cell");
+    return;
+  }
+
+  // Try every subframe 0 of the cell in the buffer, the PBCH decoder combines them
+  uint32_t nsamples  = context.meas_len_ms * context.sf_len;
+  uint32_t frame_len = SRSRAN_NOF_SF_X_FRAME * context.sf_len;
+  for (uint32_t n = peak_idx % frame_len; n + context.sf_len <= nsamples; n += frame_len) {
+    srsran_vec_cf_copy(mib_buffer.data(), &buffer[n], context.sf_len);
+
+    uint8_t bch_payload[SRSRAN_BCH_PAYLOAD_LEN] = {};
+    int     sfn_offset                          = 0;
+    if (srsran_ue_mib_decode(&ue_mib, bch_payload, nullptr, &sfn_offset) != SRSRAN_UE_MIB_FOUND) {
+      continue;
+    }
+
+    frame_timing_t timing = {};
+    timing.cell           = cell;
+    srsran_pbch_mib_unpack(bch_payload, &timing.cell, &timing.sfn);
+    timing.sfn      = (timing.sfn + sfn_offset) % 1024;
+    timing.sf0_time = context.rx_time;
+    srsran_timestamp_add(&timing.sf0_time, 0, (double)n / (1000.0 * context.sf_len));
+
+    Log(debug, "Decoded MIB of neighbour cell PCI=%03d, SFN=%d", cell.id, timing.sfn);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    frame_timings[cell.id] = timing;
+    return;
+  }
+}
+
+bool intra_measure_lte::get_frame_timing(uint32_t            pci,
+                                         srsran_cell_t&      cell,
+                                         uint32_t&           sfn,
+                                         srsran_timestamp_t& sf0_time)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  std::map<uint32_t, frame_timing_t>::const_iterator it = frame_timings.find(pci);
+  if (it == frame_timings.end()) {
+    return false;
+  }
+  cell     = it->second.cell;
+  sfn      = it->second.sfn;
+  sf0_time = it->second.sf0_time;
+  return true;
+}
+
 } // namespace scell
 } // namespace srsue
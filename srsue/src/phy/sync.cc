@@ -21,6 +21,7 @@
 
 #include "srsue/hdr/phy/sync.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_affinity.h"
 #include "srsran/phy/channel/channel.h"
 #include "srsran/srsran.h"
 #include "srsue/hdr/phy/lte/sf_worker.h"
@@ -353,11 +354,24 @@ bool sync::cell_select_start(phy_cell_t new_cell)
   sfn_p.reset();
   search_p.reset();
 
-  // Reconfigure cell if necessary
-  cell.set_pci(new_cell.pci);
-  if (not set_cell(new_cell.cfo_hz)) {
-    Error("Cell Select: Reconfiguring cell");
-    goto clean_exit;
+  // Take the target frame timing measured in the background, before the measurements are reconfigured below
+  {
+    srsran_cell_t target_cell = cell.get();
+    target_timing_valid       = (int)new_cell.earfcn == current_earfcn and
+                          intra_freq_meas[0]->get_frame_timing(new_cell.pci, target_cell, target_sfn, target_sf0_time);
+
+    // Reconfigure cell if necessary
+    cell.set_pci(new_cell.pci);
+    if (not set_cell(new_cell.cfo_hz)) {
+      Error("Cell Select: Reconfiguring cell");
+      goto clean_exit;
+    }
+
+    // The MIB of the target must match the configured cell, the same check as in SFN synchronization
+    target_timing_valid = target_timing_valid and cell.equals(target_cell);
+    if (target_timing_valid) {
+      Info("Cell Select: Using measured frame timing of PCI=%d, SFN=%d", new_cell.pci, target_sfn);
+    }
   }
 
   /* Select new frequency if necessary */
@@ -437,7 +451,21 @@ void sync::run_cell_search_state()
 void sync::run_sfn_sync_state()
 {
   srsran_cell_t old_cell = cell.get();
-  switch (sfn_p.run_subframe(&old_cell, &tti, mib)) {
+
+  // Subframes received while acquiring the cell are not aligned to its subframe boundary yet
+  bool tracking = ue_sync.state == SF_TRACK;
+
+  switch (sfn_p.run_subframe(&old_cell, &tti, mib, target_timing_valid)) {
+    case sfn_sync::SFX0_FOUND:
+      if (tracking and set_tti_from_target_timing()) {
+        stack->in_sync();
+        phy_state.state_exit();
+      } else if (tracking) {
+        // Fall back to decoding the MIB
+        Info("SYNC:  Subframe 0 does not match the measured frame timing, decoding MIB");
+        target_timing_valid = false;
+      }
+      break;
     case sfn_sync::SFN_FOUND:
       if (!cell.equals(old_cell)) {
         srsran_cell_fprint(stdout, &old_cell, 0);
@@ -458,6 +486,25 @@ void sync::run_sfn_sync_state()
   }
 }
 
+bool sync::set_tti_from_target_timing()
+{
+  srsran_timestamp_t rx_time = {};
+  srsran_ue_sync_get_last_timestamp(&ue_sync, &rx_time);
+
+  // Subframes elapsed since the measured frame start, which must be a whole number of frames
+  srsran_timestamp_sub(&rx_time, target_sf0_time.full_secs, target_sf0_time.frac_secs);
+  double elapsed_ms = srsran_timestamp_real(&rx_time) * 1000.0;
+  double nof_sf     = round(elapsed_ms);
+  if (elapsed_ms < 0.0 or fabs(elapsed_ms - nof_sf) > TARGET_TIMING_TOLERANCE_MS or
+      (uint64_t)nof_sf % SRSRAN_NOF_SF_X_FRAME != 0) {
+    return false;
+  }
+
+  tti = (uint32_t)((10 * (uint64_t)target_sfn + (uint64_t)nof_sf) % 10240);
+  Info("SYNC:  DONE from measured frame timing, TTI=%d", tti);
+  return true;
+}
+
 void sync::run_camping_in_sync_state(lte::sf_worker*      lte_worker,
                                      nr::sf_worker*       nr_worker,
                                      srsran::rf_buffer_t& sync_buffer)
@@ -686,6 +733,8 @@ void sync::run_idle_state()
 
 void sync::run_thread()
 {
+  srsran::apply_thread_affinity(srsran::thread_class_t::txrx);
+
   while (running.load(std::memory_order_relaxed)) {
     phy_lib_logger.set_context(tti);
 
@@ -1012,7 +1061,8 @@ int sync::radio_recv_fnc(srsran::rf_buffer_t& data, srsran_timestamp_t* rx_time)
     std::lock_guard<std::mutex> lock(intra_freq_cfg_mutex);
     for (uint32_t i = 0; (uint32_t)i < intra_freq_meas.size(); i++) {
       // Feed the exact number of base-band samples for avoiding an invalid buffer read
-      intra_freq_meas[i]->run_tti(tti, data.get(i, 0, worker_com->args->nof_rx_ant), data.get_nof_samples());
+      intra_freq_meas[i]->run_tti(
+          tti, data.get(i, 0, worker_com->args->nof_rx_ant), data.get_nof_samples(), *rx_time);
 
       // Update RX gain
       intra_freq_meas[i]->set_rx_gain_offset(worker_com->get_rx_gain_offset());
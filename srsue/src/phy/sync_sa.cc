@@ -42,6 +42,9 @@ bool sync_sa::init(const args_t& args, stack_interface_phy_nr* stack_, srsran::r
   srate_hz = args.srate_hz;
   slot_sz  = (uint32_t)(args.srate_hz / 1000.0f);
 
+  // The PHY workers wait on the semaphore to transmit in order
+  tti_semaphore.set_thread_class(srsran::thread_class_t::phy_worker);
+
   // Initialise cell search internal object
   if (not searcher.init(args.get_cell_search())) {
     logger.error("Error initialising cell searcher");
@@ -125,7 +125,8 @@ void demux::push_pdu_temp_crnti(uint8_t* buff, uint32_t nof_bytes)
 
 /* Demultiplexing of logical channels and dissassemble of MAC CE
  * This function enqueues the packet and returns quickly because ACK
- * deadline is important here.
+ * deadline is important here. Only the MAC CEs with timing requirements are
+ * processed in the PHY worker, the SDUs are delivered to RLC by the stack thread.
  */
 void demux::push_pdu(uint8_t* buff, uint32_t nof_bytes, uint32_t tti)
 {
@@ -140,15 +141,23 @@ void demux::push_pdu(uint8_t* buff, uint32_t nof_bytes, uint32_t tti)
  */
 void demux::push_pdu_bcch(uint8_t* buff, uint32_t nof_bytes)
 {
-  pdus.push(buff, nof_bytes, srsran::pdu_queue::BCH);
+  // The BCCH buffer is reused by the next SI reception, so the stack thread gets a copy
+  uint8_t* bcch_pdu = request_buffer(nof_bytes);
+  if (bcch_pdu == nullptr) {
+    return;
+  }
+  memcpy(bcch_pdu, buff, nof_bytes);
+  pdus.push(bcch_pdu, nof_bytes, srsran::pdu_queue::BCH);
 }
 
 void demux::push_pdu_mch(uint8_t* buff, uint32_t nof_bytes)
 {
   uint8_t* mch_buffer_ptr = request_buffer(nof_bytes);
+  if (mch_buffer_ptr == nullptr) {
+    return;
+  }
   memcpy(mch_buffer_ptr, buff, nof_bytes);
   pdus.push(mch_buffer_ptr, nof_bytes, srsran::pdu_queue::MCH);
-  mch_buffer_ptr = NULL;
 }
 
 bool demux::process_pdus()
@@ -174,6 +183,7 @@ void demux::process_pdu(uint8_t* mac_pdu, uint32_t nof_bytes, srsran::pdu_queue:
       break;
     case srsran::pdu_queue::BCH:
       rlc->write_pdu_bcch_dlsch(mac_pdu, nof_bytes);
+      pdus.deallocate(mac_pdu);
       break;
     case srsran::pdu_queue::MCH:
       mch_mac_msg.init_rx(nof_bytes);
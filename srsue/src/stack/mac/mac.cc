@@ -463,15 +463,23 @@ void mac::new_grant_dl(uint32_t                               cc_idx,
 
 void mac::process_pdus()
 {
-  // dispatch work to stack thread
+  // dispatch work to stack thread, unless a task that has not started yet will already process the PDUs. The PDUs
+  // decoded by all the PHY workers in the meantime are processed in one batch
+  if (pdus_dispatched.exchange(true)) {
+    return;
+  }
   auto ret = stack_task_dispatch_queue.try_push([this]() {
+    pdus_dispatched.exchange(false);
     bool have_data = true;
     while (initialized.load(std::memory_order_relaxed) and have_data) {
       have_data = demux_unit.process_pdus();
     }
   });
-  if (ret.is_error() && initialized.load(std::memory_order_relaxed)) {
-    Warning("Failed to dispatch mac::%s task to stack thread", __func__);
+  if (ret.is_error()) {
+    pdus_dispatched.store(false);
+    if (initialized.load(std::memory_order_relaxed)) {
+      Warning("Failed to dispatch mac::%s task to stack thread", __func__);
+    }
   }
 }
 
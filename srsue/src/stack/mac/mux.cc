@@ -119,7 +119,7 @@ uint8_t* mux::pdu_get_nolock(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
   pdu_msg.init_tx(payload, pdu_sz, true);
 
   // MAC control element for C-RNTI or data from UL-CCCH
-  if (!allocate_sdu(0, &pdu_msg, pdu_sz)) {
+  if (!allocate_sdu(0, &pdu_msg, pdu_sz, rlc->get_buffer_state(0))) {
     if (pending_crnti_ce) {
       if (pdu_msg.new_subh()) {
         if (!pdu_msg.get()->set_c_rnti(pending_crnti_ce)) {
@@ -134,7 +134,8 @@ uint8_t* mux::pdu_get_nolock(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
   }
   pending_crnti_ce = 0;
 
-  // Calculate pending UL data per LCID and LCG as well as the total amount
+  // Calculate pending UL data per LCID and LCG as well as the total amount. These buffer states are queried once
+  // and then used for the whole prioritization
   bsr_proc::bsr_t bsr                = {}; // pending data per LCG
   int             total_pending_data = 0;
   int             last_sdu_len       = 0;
@@ -217,7 +218,7 @@ uint8_t* mux::pdu_get_nolock(srsran::byte_buffer_t* payload, uint32_t pdu_sz)
 
   for (auto& channel : logical_channels) {
     if (channel.sched_len != 0) {
-      uint32_t sdu_len = allocate_sdu(channel.lcid, &pdu_msg, channel.sched_len);
+      uint32_t sdu_len = allocate_sdu(channel.lcid, &pdu_msg, channel.sched_len, channel.buffer_len + channel.sched_len);
 
       // update BSR according to allocation (may be smaller than sched_len)
       bsr.buff_size[channel.lcg] -= sdu_len;
@@ -282,11 +283,12 @@ bool mux::sched_sdu(logical_channel_config_t* ch, int* sdu_space, int max_sdu_sz
   return false;
 }
 
-uint32_t mux::allocate_sdu(uint32_t lcid, srsran::sch_pdu* pdu_msg, int max_sdu_sz)
+// RLC writes the SDUs straight into the MAC PDU. buffer_state is the RLC buffer state of the LCID before the first
+// read, it is then updated with the bytes read instead of querying RLC again after every SDU
+uint32_t mux::allocate_sdu(uint32_t lcid, srsran::sch_pdu* pdu_msg, int max_sdu_sz, int32_t buffer_state)
 {
   uint32_t total_sdu_len = 0;
   int32_t  sdu_space     = max_sdu_sz;
-  int32_t  buffer_state  = rlc->get_buffer_state(lcid);
 
   while (buffer_state > 0 && sdu_space > 0) { // there is pending SDU to allocate
     int requested_sdu_len = SRSRAN_MIN(buffer_state, sdu_space);
@@ -305,8 +307,7 @@ uint32_t mux::allocate_sdu(uint32_t lcid, srsran::sch_pdu* pdu_msg, int max_sdu_
               pdu_msg->rem_size());
         sdu_space -= sdu_len;
         total_sdu_len += sdu_len;
-
-        buffer_state = rlc->get_buffer_state(lcid);
+        buffer_state -= sdu_len;
       } else {
         Debug("Couldn't allocate new SDU (buffer_state=%d, requested_sdu_len=%d, sdu_len=%d, sdu_space=%d, "
               "remaining=%d, get_sdu_space=%d)",
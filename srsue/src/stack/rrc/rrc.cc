@@ -1943,9 +1943,10 @@ void rrc::handle_ue_capability_enquiry(const ue_cap_enquiry_s& enquiry)
       ue_eutra_cap_s cap;
       cap.access_stratum_release = (access_stratum_release_e::options)(args.release - SRSRAN_RELEASE_MIN);
       cap.ue_category            = (uint8_t)((args.ue_category < 1 || args.ue_category > 5) ? 4 : args.ue_category);
-      cap.pdcp_params.max_num_rohc_context_sessions_present     = false;
-      cap.pdcp_params.supported_rohc_profiles.profile0x0001_r15 = false;
-      cap.pdcp_params.supported_rohc_profiles.profile0x0002_r15 = false;
+      // The ROHC decompressor does not handle every U-mode packet yet, the profiles are only announced on request
+      cap.pdcp_params.max_num_rohc_context_sessions_present     = args.support_rohc;
+      cap.pdcp_params.supported_rohc_profiles.profile0x0001_r15 = args.support_rohc;
+      cap.pdcp_params.supported_rohc_profiles.profile0x0002_r15 = args.support_rohc;
       cap.pdcp_params.supported_rohc_profiles.profile0x0003_r15 = false;
       cap.pdcp_params.supported_rohc_profiles.profile0x0004_r15 = false;
       cap.pdcp_params.supported_rohc_profiles.profile0x0006_r15 = false;
@@ -1953,6 +1954,7 @@ void rrc::handle_ue_capability_enquiry(const ue_cap_enquiry_s& enquiry)
       cap.pdcp_params.supported_rohc_profiles.profile0x0102_r15 = false;
       cap.pdcp_params.supported_rohc_profiles.profile0x0103_r15 = false;
       cap.pdcp_params.supported_rohc_profiles.profile0x0104_r15 = false;
+      cap.pdcp_params.max_num_rohc_context_sessions.value = pdcp_params_s::max_num_rohc_context_sessions_opts::cs16;
 
       cap.phy_layer_params.ue_specific_ref_sigs_supported = false;
       cap.phy_layer_params.ue_tx_ant_sel_supported        = false;
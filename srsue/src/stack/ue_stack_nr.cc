@@ -20,6 +20,7 @@
  */
 
 #include "srsue/hdr/stack/ue_stack_nr.h"
+#include "srsran/common/thread_affinity.h"
 #include "srsran/srsran.h"
 #include "srsue/hdr/stack/rrc_nr/rrc_nr.h"
 
@@ -154,6 +155,7 @@ bool ue_stack_nr::get_metrics(stack_metrics_t* metrics)
 
 void ue_stack_nr::run_thread()
 {
+  srsran::apply_thread_affinity(srsran::thread_class_t::stack);
   while (running) {
     task_sched.run_next_task();
   }
@@ -184,6 +186,22 @@ void ue_stack_nr::write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu)
   }
 }
 
+void ue_stack_nr::write_sdus(uint32_t lcid, std::vector<srsran::unique_byte_buffer_t> sdus)
+{
+  if (pdcp != nullptr) {
+    auto ret = gw_task_queue.try_push(std::bind(
+        [this, lcid](std::vector<srsran::unique_byte_buffer_t>& sdus) {
+          for (srsran::unique_byte_buffer_t& sdu : sdus) {
+            pdcp->write_sdu(lcid, std::move(sdu));
+          }
+        },
+        std::move(sdus)));
+    if (ret.is_error()) {
+      pdcp_logger.warning("GW SDUs with lcid=%d were discarded.", lcid);
+    }
+  }
+}
+
 /********************
  *  SYNC Interface
  *******************/
@@ -32,12 +32,33 @@
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
 namespace srsue {
 
+/// Reads the UL packets of one additional queue of the TUN device
+class gw::tun_reader_thread : public srsran::thread
+{
+public:
+  tun_reader_thread(gw* parent_, int32_t fd_, uint32_t idx) :
+    thread("GW_TUN" + std::to_string(idx)), parent(parent_), fd(fd_)
+  {}
+  void stop()
+  {
+    thread_cancel();
+    wait_thread_finish();
+  }
+
+private:
+  void run_thread() override { parent->run_tun_reader(fd); }
+
+  gw*     parent;
+  int32_t fd;
+};
+
 gw::gw(srslog::basic_logger& logger_) : thread("GW"), logger(logger_), tft_matcher(logger) {}
 
 int gw::init(const gw_args_t& args_, stack_interface_gw* stack_)
@@ -73,9 +94,21 @@ int gw::init(const gw_args_t& args_, stack_interface_gw* stack_)
 
 gw::~gw()
 {
+  stop_tun_readers();
   if (tun_fd > 0) {
     close(tun_fd);
   }
+  for (int32_t fd : tun_queue_fds) {
+    close(fd);
+  }
+}
+
+void gw::stop_tun_readers()
+{
+  for (auto& reader : tun_readers) {
+    reader->stop();
+  }
+  tun_readers.clear();
 }
 
 void gw::stop()
@@ -84,6 +117,7 @@ void gw::stop()
     run_enable = false;
     if (if_up) {
       if_up = false;
+      stop_tun_readers();
       if (running) {
         thread_cancel();
       }
@@ -200,7 +234,8 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
 {
   int err;
 
-  // Make sure the worker thread is terminated before spawning a new one.
+  // Make sure the worker threads are terminated before spawning new ones.
+  stop_tun_readers();
   if (running) {
     run_enable = false;
     thread_cancel();
@@ -221,9 +256,13 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
 
   default_eps_bearer_id = static_cast<int>(eps_bearer_id);
 
-  // Setup a thread to receive packets from the TUN device
+  // Setup a thread to receive packets from each queue of the TUN device
   run_enable = true;
   start(GW_THREAD_PRIO);
+  for (uint32_t i = 0; i < tun_queue_fds.size(); ++i) {
+    tun_readers.emplace_back(new tun_reader_thread(this, tun_queue_fds[i], i + 1));
+    tun_readers.back()->start(GW_THREAD_PRIO);
+  }
 
   return SRSRAN_SUCCESS;
 }
@@ -273,6 +312,13 @@ void gw::add_mch_port(uint32_t lcid, uint32_t port)
 /*    GW Receive    */
 /********************/
 void gw::run_thread()
+{
+  running = true;
+  run_tun_reader(tun_fd);
+  running = false;
+}
+
+void gw::run_tun_reader(int32_t fd)
 {
   uint32 idx     = 0;
   int32  N_bytes = 0;
@@ -283,22 +329,36 @@ void gw::run_thread()
     return;
   }
 
+  // Packets read for the same EPS bearer are handed over to the stack together, when the TUN queue is drained
+  std::vector<srsran::unique_byte_buffer_t> ul_batch;
+  uint32_t                                  ul_batch_eps_bearer_id = 0;
+
   const static uint32_t REGISTER_WAIT_TOUT = 40, SERVICE_WAIT_TOUT = 40; // 4 sec
   uint32_t              register_wait = 0, service_wait = 0;
 
-  logger.info("GW IP packet receiver thread run_enable");
+  logger.info("GW IP packet receiver thread run_enable, TUN fd=%d", fd);
 
-  running = true;
   while (run_enable) {
     // Read packet from TUN
     if (SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET > idx) {
-      N_bytes = read(tun_fd, &pdu->msg[idx], SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - idx);
+      N_bytes = read(fd, &pdu->msg[idx], SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - idx);
     } else {
       logger.error("GW pdu buffer full - gw receive thread exiting.");
       srsran::console("GW pdu buffer full - gw receive thread exiting.\n");
       break;
     }
-    logger.debug("Read %d bytes from TUN fd=%d, idx=%d", N_bytes, tun_fd, idx);
+
+    if (N_bytes < 0 and (errno == EAGAIN or errno == EWOULDBLOCK)) {
+      // Nothing left to read, hand over the pending packets and wait for the next ones
+      if (not ul_batch.empty()) {
+        std::lock_guard<std::mutex> lock(gw_mutex);
+        write_ul_batch(ul_batch_eps_bearer_id, ul_batch);
+      }
+      struct pollfd pfd = {fd, POLLIN, 0};
+      poll(&pfd, 1, -1);
+      continue;
+    }
+    logger.debug("Read %d bytes from TUN fd=%d, idx=%d", N_bytes, fd, idx);
 
     if (N_bytes <= 0) {
       logger.error("Failed to read from TUN interface - gw receive thread exiting.");
@@ -354,6 +414,12 @@ void gw::run_thread()
         uint8_t eps_bearer_id = default_eps_bearer_id;
         tft_matcher.check_tft_filter_match(pdu, eps_bearer_id);
 
+        // Keep the order of the packets of the other bearer
+        if (eps_bearer_id != ul_batch_eps_bearer_id) {
+          write_ul_batch(ul_batch_eps_bearer_id, ul_batch);
+          ul_batch_eps_bearer_id = eps_bearer_id;
+        }
+
         // Wait for service request if necessary
         while (run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT) {
           if (!service_wait) {
@@ -371,17 +437,31 @@ void gw::run_thread()
           break;
         }
 
-        // Send PDU directly to PDCP
-        pdu->set_timestamp();
+        // Queue PDU for PDCP. Small packets, e.g. TCP ACKs, are moved to a small buffer and the read buffer is reused
         ul_tput_bytes += pdu->N_bytes;
-        stack->write_sdu(eps_bearer_id, std::move(pdu));
-        do {
-          pdu = srsran::make_byte_buffer();
-          if (!pdu) {
-            logger.error("Fatal Error: Couldn't allocate PDU in run_thread().");
-            usleep(100000);
-          }
-        } while (!pdu);
+        srsran::unique_byte_buffer_t sdu;
+        if (pdu->N_bytes <= SMALL_UL_PDU_LEN) {
+          sdu = srsran::make_sized_byte_buffer(pdu->N_bytes);
+        }
+        if (sdu != nullptr) {
+          sdu->append_bytes(pdu->msg, pdu->N_bytes);
+          sdu->set_timestamp();
+          ul_batch.push_back(std::move(sdu));
+          pdu->clear();
+        } else {
+          pdu->set_timestamp();
+          ul_batch.push_back(std::move(pdu));
+          do {
+            pdu = srsran::make_byte_buffer();
+            if (!pdu) {
+              logger.error("Fatal Error: Couldn't allocate PDU in run_thread().");
+              usleep(100000);
+            }
+          } while (!pdu);
+        }
+        if (ul_batch.size() >= MAX_UL_BATCH) {
+          write_ul_batch(ul_batch_eps_bearer_id, ul_batch);
+        }
         idx = 0;
       } else {
         idx += N_bytes;
@@ -389,10 +469,19 @@ void gw::run_thread()
       }
     } // end of holdering gw_mutex
   }
-  running = false;
   logger.info("GW IP receiver thread exiting.");
 }
 
+void gw::write_ul_batch(uint32_t eps_bearer_id, std::vector<srsran::unique_byte_buffer_t>& batch)
+{
+  if (batch.size() == 1) {
+    stack->write_sdu(eps_bearer_id, std::move(batch[0]));
+  } else if (batch.size() > 1) {
+    stack->write_sdus(eps_bearer_id, std::move(batch));
+  }
+  batch.clear();
+}
+
 /**************************/
 /* TUN Interface Helpers  */
 /**************************/
@@ -430,6 +519,12 @@ int gw::init_if(char* err_str)
 
   memset(&ifr, 0, sizeof(ifr));
   ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+  if (args.nof_tun_queues > 1) {
+    ifr.ifr_flags |= IFF_MULTI_QUEUE;
+  }
+  if (args.tun_napi) {
+    ifr.ifr_flags |= IFF_NAPI;
+  }
   strncpy(
       ifr.ifr_ifrn.ifrn_name, args.tun_dev_name.c_str(), std::min(args.tun_dev_name.length(), (size_t)(IFNAMSIZ - 1)));
   ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = 0;
@@ -440,6 +535,32 @@ int gw::init_if(char* err_str)
     return SRSRAN_ERROR_CANT_START;
   }
 
+  // Attach the additional queues to the device. Each queue gets the packets of a set of flows
+  for (uint32_t i = 1; i < args.nof_tun_queues; ++i) {
+    struct ifreq queue_ifr = ifr;
+    int32_t      queue_fd  = open("/dev/net/tun", O_RDWR);
+    if (0 > queue_fd or 0 > ioctl(queue_fd, TUNSETIFF, &queue_ifr)) {
+      err_str = strerror(errno);
+      logger.error("Failed to attach queue %d to TUN device: %s", i, err_str);
+      if (queue_fd >= 0) {
+        close(queue_fd);
+      }
+      break;
+    }
+    tun_queue_fds.push_back(queue_fd);
+  }
+  logger.info("TUN device has %zd queues", tun_queue_fds.size() + 1);
+
+  // The reader threads drain their queue before handing the packets over to the stack
+  if (fcntl(tun_fd, F_SETFL, O_NONBLOCK)) {
+    logger.error("Failed to set non-blocking TUN device");
+    close(tun_fd);
+    return SRSRAN_ERROR_CANT_START;
+  }
+  for (int32_t fd : tun_queue_fds) {
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+  }
+
   // Bring up the interface
   sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (0 > ioctl(sock, SIOCGIFFLAGS, &ifr)) {
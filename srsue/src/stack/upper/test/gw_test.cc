@@ -32,6 +32,7 @@ public:
   bool is_registered() { return true; }
   bool start_service_request() { return true; };
   void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) { return; }
+  void write_sdus(uint32_t lcid, std::vector<srsran::unique_byte_buffer_t> sdus) { return; }
   bool has_active_radio_bearer(uint32_t eps_bearer_id) { return true; }
 };
 
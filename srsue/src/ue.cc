@@ -83,15 +83,20 @@ int ue::init(const all_args_t& args_)
     return SRSRAN_ERROR;
   }
 
-  srsue::phy_args_nr_t phy_args_nr = {};
-  phy_args_nr.max_nof_prb          = args.phy.nr_max_nof_prb;
-  phy_args_nr.rf_channel_offset    = args.phy.nof_lte_carriers;
-  phy_args_nr.nof_carriers         = args.phy.nof_nr_carriers;
-  phy_args_nr.nof_phy_threads      = args.phy.nof_phy_threads;
-  phy_args_nr.worker_cpu_mask      = args.phy.worker_cpu_mask;
-  phy_args_nr.log                  = args.phy.log;
-  phy_args_nr.store_pdsch_ko       = args.phy.nr_store_pdsch_ko;
-  phy_args_nr.srate_hz             = args.rf.srate_hz;
+  srsue::phy_args_nr_t phy_args_nr     = {};
+  phy_args_nr.max_nof_prb              = args.phy.nr_max_nof_prb;
+  phy_args_nr.rf_channel_offset        = args.phy.nof_lte_carriers;
+  phy_args_nr.nof_carriers             = args.phy.nof_nr_carriers;
+  phy_args_nr.nof_phy_threads          = args.phy.nof_phy_threads;
+  phy_args_nr.worker_cpu_mask          = args.phy.worker_cpu_mask;
+  phy_args_nr.worker_autoscale         = args.phy.worker_autoscale;
+  phy_args_nr.worker_min_threads       = args.phy.worker_min_threads;
+  phy_args_nr.worker_target_load       = args.phy.worker_target_load;
+  phy_args_nr.log                      = args.phy.log;
+  phy_args_nr.store_pdsch_ko           = args.phy.nr_store_pdsch_ko;
+  phy_args_nr.max_nof_ssb_search       = args.phy.nr_cell_search_max_nof_ssb;
+  phy_args_nr.dl.pdcch.polar_list_size = args.phy.nr_pdcch_polar_list_size;
+  phy_args_nr.srate_hz                 = args.rf.srate_hz;
 
   // init layers
   if (args.phy.nof_lte_carriers == 0) {